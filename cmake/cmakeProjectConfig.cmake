@@ -16,4 +16,8 @@
 # License-Filename: LICENSE
 include(CMakeFindDependencyMacro)
 find_dependency(olp-cpp-sdk-core)
+if(@OLP_SDK_USE_PLATFORM_CRYPTO@ AND NOT APPLE)
+    # The targets link OpenSSL::Crypto.
+    find_dependency(OpenSSL)
+endif()
 include("${CMAKE_CURRENT_LIST_DIR}/@PROJECT_NAME@-targets.cmake")
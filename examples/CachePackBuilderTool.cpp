@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "Examples.h"
+#include "Options.h"
+
+#include <olp/authentication/TokenProvider.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/cache/DefaultCache.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/geo/coordinates/GeoRectangle.h>
+#include <olp/dataservice/read/CachePackBuilder.h>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr auto usage =
+    "Builds an offline cache pack to be used as the protected cache.\n"
+    "usage is \n -i, --key-id \n\there.access.key.id \n -s, --key-secret "
+    "\n\there.access.key.secret \n"
+    " -c, --catalog \n\tCatalog HRN (HERE Resource Name). \n"
+    " -v, --catalog-version \n\tThe version of the catalog (optional, the "
+    "latest version is used by default). \n"
+    " -l, --layer-ids \n\tComma separated IDs of the versioned layers. \n"
+    " -r, --rectangle \n\tThe area in degrees [=south,west,north,east]. \n"
+    " -n, --min-level \n\tThe minimum tile level. \n"
+    " -x, --max-level \n\tThe maximum tile level. \n"
+    " -o, --output \n\tThe directory where the pack is written. \n"
+    " -d, --delta-from \n\tThe directory of the previous pack (optional, "
+    "the delta from it is written next to the output directory, with the "
+    ".delta suffix). \n"
+    " -h, --help \n\tShow usage";
+
+bool IsMatch(const std::string& name, const tools::Option& option) {
+  return name == option.short_name || name == option.long_name;
+}
+
+std::vector<std::string> Split(const std::string& value) {
+  std::vector<std::string> result;
+  std::stringstream ss(value);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      result.push_back(item);
+    }
+  }
+  return result;
+}
+
+template <typename Type>
+bool ParseValue(const std::string& value, Type& result) {
+  std::stringstream ss(value);
+  ss >> result;
+  return !ss.fail() && ss.eof();
+}
+
+bool ParseGeoRectangle(const std::string& value,
+                       olp::geo::GeoRectangle& rectangle) {
+  const auto items = Split(value);
+  if (items.size() != 4u) {
+    return false;
+  }
+
+  double degrees[4];
+  for (size_t i = 0; i < items.size(); ++i) {
+    if (!ParseValue(items[i], degrees[i])) {
+      return false;
+    }
+  }
+
+  rectangle = olp::geo::GeoRectangle(
+      olp::geo::GeoCoordinates::FromDegrees(degrees[0], degrees[1]),
+      olp::geo::GeoCoordinates::FromDegrees(degrees[2], degrees[3]));
+  return true;
+}
+
+int ArgumentError(const tools::Option& arg) {
+  std::cout << "option requires a valid argument -- '" << arg.short_name
+            << '\'' << " [" << arg.long_name << "] " << arg.description
+            << std::endl;
+  return -1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  AccessKey access_key{};
+  std::string catalog;
+  std::string delta_base;
+  olp::dataservice::read::CachePackRequest request;
+
+  const std::vector<std::string> arguments(argv + 1, argv + argc);
+  for (auto it = arguments.begin(); it != arguments.end(); ++it) {
+    if (IsMatch(*it, tools::kHelpOption)) {
+      std::cout << usage << std::endl;
+      return 0;
+    }
+
+    const auto& name = *it;
+    if (++it == arguments.end()) {
+      std::cout << usage << std::endl;
+      return -1;
+    }
+    const auto& value = *it;
+
+    if (IsMatch(name, tools::kKeyIdOption)) {
+      access_key.id = value;
+    } else if (IsMatch(name, tools::kKeySecretOption)) {
+      access_key.secret = value;
+    } else if (IsMatch(name, tools::kCatalogOption)) {
+      catalog = value;
+    } else if (IsMatch(name, tools::kCatalogVersionOption)) {
+      int64_t version = 0;
+      if (!ParseValue(value, version)) {
+        return ArgumentError(tools::kCatalogVersionOption);
+      }
+      request.WithVersion(version);
+    } else if (IsMatch(name, tools::kLayerIdsOption)) {
+      request.WithLayerIds(Split(value));
+    } else if (IsMatch(name, tools::kGeoRectangleOption)) {
+      olp::geo::GeoRectangle rectangle;
+      if (!ParseGeoRectangle(value, rectangle)) {
+        return ArgumentError(tools::kGeoRectangleOption);
+      }
+      request.WithGeoRectangle(rectangle);
+    } else if (IsMatch(name, tools::kMinLevelOption)) {
+      unsigned int level = 0;
+      if (!ParseValue(value, level)) {
+        return ArgumentError(tools::kMinLevelOption);
+      }
+      request.WithMinLevel(level);
+    } else if (IsMatch(name, tools::kMaxLevelOption)) {
+      unsigned int level = 0;
+      if (!ParseValue(value, level)) {
+        return ArgumentError(tools::kMaxLevelOption);
+      }
+      request.WithMaxLevel(level);
+    } else if (IsMatch(name, tools::kOutputOption)) {
+      request.WithOutputPath(value);
+    } else if (IsMatch(name, tools::kDeltaBaseOption)) {
+      delta_base = value;
+    } else {
+      std::cout << usage << std::endl;
+      return -1;
+    }
+  }
+
+  if (catalog.empty()) {
+    std::cout << "Please specify catalog. For more information use -h [--help]"
+              << std::endl;
+    return -1;
+  }
+
+  const auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+  std::shared_ptr<olp::thread::TaskScheduler> task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(
+          threads);
+  std::shared_ptr<olp::http::Network> http_client = olp::client::
+      OlpClientSettingsFactory::CreateDefaultNetworkRequestHandler();
+
+  const auto read_credentials_result =
+      olp::authentication::AuthenticationCredentials::ReadFromFile();
+  olp::authentication::Settings settings{
+      read_credentials_result.get_value_or({access_key.id, access_key.secret})};
+  settings.task_scheduler = task_scheduler;
+  settings.network_request_handler = http_client;
+
+  olp::client::AuthenticationSettings auth_settings;
+  auth_settings.provider =
+      olp::authentication::TokenProviderDefault(std::move(settings));
+
+  olp::client::OlpClientSettings client_settings;
+  client_settings.authentication_settings = auth_settings;
+  client_settings.task_scheduler = std::move(task_scheduler);
+  client_settings.network_request_handler = std::move(http_client);
+
+  olp::dataservice::read::CachePackBuilder builder(olp::client::HRN(catalog),
+                                                   client_settings);
+  auto response = builder.Build(request);
+  if (!response.IsSuccessful()) {
+    std::cout << "Failed to build the cache pack: "
+              << response.GetError().GetMessage() << std::endl;
+    return -1;
+  }
+
+  std::cout << "Cache pack of version " << response.GetResult().version
+            << " with " << response.GetResult().tile_count
+            << " tiles is written to " << request.GetOutputPath()
+            << std::endl;
+
+#ifdef OLP_SDK_ENABLE_DEFAULT_CACHE
+  if (!delta_base.empty()) {
+    const auto delta_path = request.GetOutputPath() + ".delta";
+    if (!olp::cache::DefaultCache::CreateProtectedCacheDelta(
+            delta_base, request.GetOutputPath(), delta_path)) {
+      std::cout << "Failed to write the delta from " << delta_base
+                << std::endl;
+      return -1;
+    }
+    std::cout << "Delta from " << delta_base << " is written to "
+              << delta_path << std::endl;
+  }
+#endif  // OLP_SDK_ENABLE_DEFAULT_CACHE
+  return 0;
+}
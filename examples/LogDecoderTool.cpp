@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "Options.h"
+
+#include <olp/core/logging/BinaryFileAppender.h>
+#include <olp/core/logging/MessageFormatter.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr auto usage =
+    "Prints the messages of a binary log file as text.\n"
+    "usage is \n -f, --file \n\tThe file written by the BinaryFileAppender. \n"
+    " -h, --help \n\tShow usage";
+
+bool IsMatch(const std::string& name, const tools::Option& option) {
+  return name == option.short_name || name == option.long_name;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string file_name;
+
+  const std::vector<std::string> arguments(argv + 1, argv + argc);
+  for (auto it = arguments.begin(); it != arguments.end(); ++it) {
+    if (IsMatch(*it, tools::kHelpOption)) {
+      std::cout << usage << std::endl;
+      return 0;
+    }
+
+    const auto& name = *it;
+    if (++it == arguments.end()) {
+      std::cout << usage << std::endl;
+      return -1;
+    }
+    const auto& value = *it;
+
+    if (IsMatch(name, tools::kLogFileOption)) {
+      file_name = value;
+    } else {
+      std::cout << usage << std::endl;
+      return -1;
+    }
+  }
+
+  if (file_name.empty()) {
+    std::cout << "Please specify file. For more information use -h [--help]"
+              << std::endl;
+    return -1;
+  }
+
+  const auto formatter = olp::logging::MessageFormatter::createDefault();
+  const auto decoded = olp::logging::BinaryFileAppender::decode(
+      file_name, [&](const olp::logging::LogMessage& message) {
+        std::cout << formatter.format(message) << '\n';
+      });
+  std::cout.flush();
+
+  if (!decoded) {
+    std::cout << "Failed to decode the binary log file " << file_name
+              << std::endl;
+    return -1;
+  }
+  return 0;
+}
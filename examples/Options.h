@@ -59,4 +59,29 @@ const Option kSubscriptionTypeOption{
 
 const Option kAllOption{"-a", "--all", "Run all examples."};
 
+const Option kLayerIdsOption{
+    "-l", "--layer-ids",
+    "Comma separated IDs of the versioned layers to store in the pack."};
+
+const Option kGeoRectangleOption{
+    "-r", "--rectangle",
+    "The area of the pack in degrees [=south,west,north,east]."};
+
+const Option kMinLevelOption{"-n", "--min-level",
+                             "The minimum tile level of the pack."};
+
+const Option kMaxLevelOption{"-x", "--max-level",
+                             "The maximum tile level of the pack."};
+
+const Option kOutputOption{"-o", "--output",
+                           "The directory where the pack is written."};
+
+const Option kDeltaBaseOption{
+    "-d", "--delta-from",
+    "[Optional] The directory of the previous pack, the delta from it is "
+    "written next to the pack."};
+
+const Option kLogFileOption{"-f", "--file",
+                            "The file written by the BinaryFileAppender."};
+
 }  // namespace tools
@@ -27,6 +27,10 @@
 #include <boost/optional.hpp>
 
 namespace olp {
+namespace cache {
+class KeyValueCache;
+}
+
 namespace http {
 class Network;
 }
@@ -78,6 +82,20 @@ struct AUTHENTICATION_API AuthenticationSettings {
    */
   size_t token_cache_limit{100u};
 
+  /**
+   * @brief The cache where the client tokens are persisted, or nullptr to
+   * keep them only in memory.
+   *
+   * The tokens are encrypted with AES-256-GCM with a key derived from the
+   * access key secret. A sign in with the same credentials and properties uses
+   * the persisted token if it is still valid, without a request to the
+   * authentication server.
+   *
+   * @note The tokens are persisted only if the SDK is built with
+   * `OLP_SDK_USE_PLATFORM_CRYPTO` on the platforms other than Apple.
+   */
+  std::shared_ptr<cache::KeyValueCache> persistent_token_cache{nullptr};
+
   /**
    * @brief Uses system system time in authentication requests rather than
    * requesting time from authentication server.
@@ -63,8 +63,10 @@ class AUTHENTICATION_API OLP_SDK_DEPRECATED("Will be removed by 10.2020.")
    * @brief Synchronously gets a token that is always fresh.
    *
    * If no token has been retrieved yet or the current token is expired or
-   * expires within five minutes, a new token is requested. Otherwise,
-   * the cached token is returned. This method is thread-safe.
+   * expires within the minimum validity, a new token is requested. Otherwise,
+   * the cached token is returned, and if it expires within twice the minimum
+   * validity, a new token is requested in the background. This method is
+   * thread-safe.
    * @note This method is blocked when a new token needs to be retrieved.
    * Therefore, the token should not be called from a time-sensitive thread (for
    * example, the UI thread).
@@ -89,8 +91,10 @@ class AUTHENTICATION_API OLP_SDK_DEPRECATED("Will be removed by 10.2020.")
    * @brief Synchronously gets a token that is always fresh.
    *
    * If no token has been retrieved yet or the current token is expired or
-   * expires within five minutes, a new token is requested. Otherwise,
-   * the cached token is returned. This method is thread-safe.
+   * expires within the minimum validity, a new token is requested. Otherwise,
+   * the cached token is returned, and if it expires within twice the minimum
+   * validity, a new token is requested in the background. This method is
+   * thread-safe.
    * @note This method is blocked when a new token needs to be retrieved.
    * Therefore, it should not be called from a time-sensitive thread (for
    * example, the UI thread).
@@ -112,8 +116,10 @@ class AUTHENTICATION_API OLP_SDK_DEPRECATED("Will be removed by 10.2020.")
    * @brief Asynchronously gets a token that is always fresh.
    *
    * If no token has been retrieved yet or the current token is expired or
-   * expires within five minutes, a new token is requested. Otherwise,
-   * the cached token is returned. This method is thread-safe.
+   * expires within the minimum validity, a new token is requested. Otherwise,
+   * the cached token is returned, and if it expires within twice the minimum
+   * validity, a new token is requested in the background. This method is
+   * thread-safe.
    *
    * @param callback The callback that contains the `TokenResponse` instance.
    * @param minimum_validity (Optional) Sets the minimum validity period of
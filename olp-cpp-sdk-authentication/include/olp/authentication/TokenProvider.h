@@ -38,6 +38,24 @@ namespace authentication {
 PORTING_PUSH_WARNINGS()
 PORTING_CLANG_GCC_DISABLE_WARNING("-Wdeprecated-declarations")
 
+namespace detail {
+/**
+ * @brief Gets the token shared by all the token providers with the same
+ * credentials, settings, and minimum validity.
+ *
+ * The token is requested and refreshed once for all of them. It is released
+ * when the last provider that uses it is destroyed.
+ *
+ * @param settings The settings used to request the token.
+ * @param minimum_validity The minimum validity of the token.
+ *
+ * @return The shared `AutoRefreshingToken` instance.
+ */
+AUTHENTICATION_API std::shared_ptr<AutoRefreshingToken> GetSharedToken(
+    Settings settings,
+    std::chrono::seconds minimum_validity = kDefaultMinimumValiditySeconds);
+}  // namespace detail
+
 /**
  * @brief Provides the authentication tokens if the HERE platform
  * user credentials are valid.
@@ -113,9 +131,8 @@ class TokenProvider {
     explicit TokenProviderImpl(Settings settings,
                                std::chrono::seconds minimum_validity)
         : minimum_validity_{minimum_validity},
-          token_(
-              TokenEndpoint(std::move(settings)).RequestAutoRefreshingToken()) {
-    }
+          token_(detail::GetSharedToken(std::move(settings),
+                                        minimum_validity)) {}
 
     /// @copydoc TokenProvider::operator()()
     std::string operator()() const {
@@ -140,13 +157,10 @@ class TokenProvider {
     }
 
     /// Get the token response from AutoRefreshingToken or request a new token
-    /// if expired or not present.
+    /// if expired or not present. The shared token requests it once for all
+    /// the consumers that need it at the same time.
     TokenResponse GetResponse() const {
-      /// Mutex is needed to prevent multiple authorization requests, that could
-      /// happen when the token is not yet available, and multiple consumers
-      /// requested it.
-      std::lock_guard<std::mutex> lock(request_mutex_);
-      return token_.GetToken(minimum_validity_);
+      return token_->GetToken(minimum_validity_);
     }
 
     /// Check if the available token response is valid, i.e. error code is 0.
@@ -159,8 +173,7 @@ class TokenProvider {
 
    private:
     std::chrono::seconds minimum_validity_{kDefaultMinimumValidity};
-    AutoRefreshingToken token_;
-    mutable std::mutex request_mutex_;
+    std::shared_ptr<AutoRefreshingToken> token_;
   };
 
   std::shared_ptr<TokenProviderImpl> impl_;
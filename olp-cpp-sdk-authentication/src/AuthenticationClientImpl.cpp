@@ -61,6 +61,10 @@ constexpr auto kTimestampEndpoint = "/timestamp";
 constexpr auto kIntrospectAppEndpoint = "/app/me";
 constexpr auto kDecisionEndpoint = "/decision/authorize";
 
+// The persisted token must be valid long enough to not be refreshed right
+// after it is loaded.
+constexpr auto kMinimumPersistedTokenValidity = std::chrono::seconds(300);
+
 // JSON fields
 constexpr auto kCountryCode = "countryCode";
 constexpr auto kDateOfBirth = "dob";
@@ -152,8 +156,21 @@ AuthenticationClientImpl::AuthenticationClientImpl(
           std::make_shared<SignInCacheType>(settings.token_cache_limit)),
       user_token_cache_(
           std::make_shared<SignInUserCacheType>(settings.token_cache_limit)),
+      persistent_token_cache_(
+          settings.persistent_token_cache &&
+                  PersistentTokenCache::IsSupported()
+              ? std::make_shared<PersistentTokenCache>(
+                    settings.persistent_token_cache,
+                    settings.token_endpoint_url)
+              : nullptr),
       settings_(std::move(settings)),
-      pending_requests_(std::make_shared<client::PendingRequests>()) {}
+      pending_requests_(std::make_shared<client::PendingRequests>()) {
+  if (settings_.persistent_token_cache && !persistent_token_cache_) {
+    OLP_SDK_LOG_WARNING(kLogTag,
+                        "The tokens are not persisted, the platform crypto "
+                        "library is not used");
+  }
+}
 
 AuthenticationClientImpl::~AuthenticationClientImpl() {
   pending_requests_->CancelAllAndWait();
@@ -208,49 +225,45 @@ SignInUserResult AuthenticationClientImpl::ParseUserAuthResponse(
 template <>
 boost::optional<SignInResult> AuthenticationClientImpl::FindInCache(
     const std::string& key) {
-  return client_token_cache_->locked(
-      [&](utils::LruCache<std::string, SignInResult>& cache) {
-        auto it = cache.Find(key);
-        return it != cache.end() ? boost::make_optional(it->value())
-                                 : boost::none;
-      });
+  return client_token_cache_->Find(key);
 }
 
 template <>
 boost::optional<SignInUserResult> AuthenticationClientImpl::FindInCache(
     const std::string& key) {
-  return user_token_cache_->locked(
-      [&](utils::LruCache<std::string, SignInUserResult>& cache) {
-        auto it = cache.Find(key);
-        return it != cache.end() ? boost::make_optional(it->value())
-                                 : boost::none;
-      });
+  return user_token_cache_->Find(key);
 }
 
 template <>
 void AuthenticationClientImpl::StoreInCache(const std::string& key,
                                             SignInResult response) {
-  // Cache the response
-  client_token_cache_->locked(
-      [&](utils::LruCache<std::string, SignInResult>& cache) {
-        return cache.InsertOrAssign(key, response);
-      });
+  client_token_cache_->InsertOrAssign(key, std::move(response));
 }
 
 template <>
 void AuthenticationClientImpl::StoreInCache(const std::string& key,
                                             SignInUserResult response) {
-  // Cache the response
-  user_token_cache_->locked(
-      [&](utils::LruCache<std::string, SignInUserResult>& cache) {
-        return cache.InsertOrAssign(key, response);
-      });
+  user_token_cache_->InsertOrAssign(key, std::move(response));
 }
 
 client::CancellationToken AuthenticationClientImpl::SignInClient(
     AuthenticationCredentials credentials, SignInProperties properties,
     SignInClientCallback callback) {
   auto task = [=](client::CancellationContext context) -> SignInClientResponse {
+    const auto request_body = GenerateClientBody(properties);
+
+    if (persistent_token_cache_) {
+      // The persisted token requested with the same properties is used
+      // without a request to the authentication server.
+      auto persisted = persistent_token_cache_->Load(
+          credentials, *request_body, kMinimumPersistedTokenValidity);
+      if (persisted) {
+        SignInResult result(std::move(persisted));
+        StoreInCache(credentials.GetKey(), result);
+        return result;
+      }
+    }
+
     if (!settings_.network_request_handler) {
       return client::ApiError::NetworkConnection(
           "Cannot sign in while offline");
@@ -276,8 +289,6 @@ client::CancellationToken AuthenticationClientImpl::SignInClient(
       }
     }
 
-    const auto request_body = GenerateClientBody(properties);
-
     SignInResult response;
 
     for (auto retry = 0; retry < kDefaultRetryCount; ++retry) {
@@ -322,6 +333,9 @@ client::CancellationToken AuthenticationClientImpl::SignInClient(
 
       if (status == http::HttpStatusCode::OK) {
         StoreInCache(credentials.GetKey(), response);
+        if (persistent_token_cache_) {
+          persistent_token_cache_->Put(credentials, *request_body, response);
+        }
       }
 
       break;
@@ -35,8 +35,8 @@
 #include "olp/core/http/HttpStatusCode.h"
 #include "olp/core/http/NetworkRequest.h"
 #include "olp/core/porting/make_unique.h"
-#include "olp/core/thread/Atomic.h"
-#include "olp/core/utils/LruCache.h"
+#include "olp/core/utils/ConcurrentLruCache.h"
+#include "PersistentTokenCache.h"
 
 namespace olp {
 namespace authentication {
@@ -62,12 +62,11 @@ enum class FederatedSignInType { FacebookSignIn, GoogleSignIn, ArcgisSignIn };
 class AuthenticationClientImpl final {
  public:
   /// The sign in cache alias type
-  using SignInCacheType =
-      thread::Atomic<utils::LruCache<std::string, SignInResult>>;
+  using SignInCacheType = utils::ConcurrentLruCache<std::string, SignInResult>;
 
   /// The sign in user cache alias type
   using SignInUserCacheType =
-      thread::Atomic<utils::LruCache<std::string, SignInUserResult>>;
+      utils::ConcurrentLruCache<std::string, SignInUserResult>;
 
   explicit AuthenticationClientImpl(AuthenticationSettings settings);
   ~AuthenticationClientImpl();
@@ -182,6 +181,7 @@ class AuthenticationClientImpl final {
 
   std::shared_ptr<SignInCacheType> client_token_cache_;
   std::shared_ptr<SignInUserCacheType> user_token_cache_;
+  std::shared_ptr<PersistentTokenCache> persistent_token_cache_;
   AuthenticationSettings settings_;
   std::shared_ptr<client::PendingRequests> pending_requests_;
   mutable std::mutex token_mutex_;
@@ -19,8 +19,10 @@
 
 #include "olp/authentication/AutoRefreshingToken.h"
 
+#include <atomic>
 #include <chrono>
 #include <iostream>
+#include <mutex>
 
 #include "olp/authentication/TokenEndpoint.h"
 #include "olp/core/client/CancellationToken.h"
@@ -29,15 +31,6 @@
 
 namespace {
 constexpr auto kLogTag = "authentication::AutoRefreshingToken";
-
-std::chrono::steady_clock::time_point ComputeRefreshTime(
-    std::chrono::seconds expires_in,
-    const std::chrono::seconds& minimum_validity) {
-  auto now = std::chrono::steady_clock::now();
-  auto expiry_time_chrono = now + expires_in;
-  return (expiry_time_chrono <= now) ? now
-                                     : (expiry_time_chrono - minimum_validity);
-}
 }  // namespace
 
 namespace olp {
@@ -45,116 +38,156 @@ namespace authentication {
 PORTING_PUSH_WARNINGS()
 PORTING_CLANG_GCC_DISABLE_WARNING("-Wdeprecated-declarations")
 
-struct AutoRefreshingToken::Impl {
+/*
+ * The current token is kept in an immutable state that is swapped atomically,
+ * so reading a valid token takes no lock. A token that expires within
+ * `minimum_validity` is not returned, the caller waits for a new one. Before
+ * that, when the token expires within twice `minimum_validity`, a single
+ * refresh is started in the background, so the callers usually get the new
+ * token without waiting.
+ */
+struct AutoRefreshingToken::Impl
+    : public std::enable_shared_from_this<AutoRefreshingToken::Impl> {
+  using Clock = std::chrono::steady_clock;
+
+  struct State {
+    TokenEndpoint::TokenResponse token;
+    Clock::time_point expire_at;
+  };
+
+  using StatePtr = std::shared_ptr<const State>;
+
   Impl(TokenEndpoint token_endpoint, TokenRequest token_request)
       : token_endpoint_(std::move(token_endpoint)),
         token_request_(std::move(token_request)),
-        current_token_(),
-        token_refresh_time_() {}
+        refreshing_(false) {}
 
   TokenEndpoint::TokenResponse GetToken(
       client::CancellationToken& cancellation_token,
       std::chrono::seconds minimum_validity) {
-    if (ForceRefresh(minimum_validity) || ShouldRefreshNow()) {
-      OLP_SDK_LOG_INFO_F(kLogTag, "Time to refresh token");
-      TryRefreshCurrentToken(cancellation_token, minimum_validity);
+    auto state = std::atomic_load(&state_);
+    if (!ForceRefresh(minimum_validity) && IsValid(state, minimum_validity)) {
+      RefreshInBackground(state, minimum_validity);
+      return state->token;
     }
 
-    // Return existing still valid token
-    return current_token_;
+    OLP_SDK_LOG_INFO_F(kLogTag, "Time to refresh token");
+
+    // Only one caller requests the new token, the others wait for it.
+    std::lock_guard<std::mutex> guard(token_mutex_);
+    auto current_state = std::atomic_load(&state_);
+    if (current_state != state && !ForceRefresh(minimum_validity) &&
+        IsValid(current_state, minimum_validity)) {
+      return current_state->token;
+    }
+
+    auto token =
+        token_endpoint_.RequestToken(cancellation_token, token_request_).get();
+    Store(token);
+    return token;
   }
 
   client::CancellationToken GetToken(const GetTokenCallback& callback,
                                      std::chrono::seconds minimum_validity) {
-    if (ForceRefresh(minimum_validity) || ShouldRefreshNow()) {
-      OLP_SDK_LOG_INFO_F(kLogTag, "Time to refresh token");
-      return TryRefreshCurrentToken(callback, minimum_validity);
+    auto state = std::atomic_load(&state_);
+    if (!ForceRefresh(minimum_validity) && IsValid(state, minimum_validity)) {
+      RefreshInBackground(state, minimum_validity);
+      callback(state->token);
+      return {};
     }
 
-    // Return existing still valid token
-    callback(current_token_);
-    return {};
+    OLP_SDK_LOG_INFO_F(kLogTag, "Time to refresh token");
+
+    std::weak_ptr<Impl> weak_self = shared_from_this();
+    return token_endpoint_.RequestToken(
+        token_request_,
+        [=](TokenEndpoint::TokenResponse response) {
+          if (auto self = weak_self.lock()) {
+            self->Store(response);
+          }
+          callback(response);
+        });
   }
 
  private:
-  bool ShouldRefreshNow() const {
-    return std::chrono::steady_clock::now() >= token_refresh_time_;
+  static bool ForceRefresh(const std::chrono::seconds& minimum_validity) {
+    return minimum_validity <= std::chrono::seconds(0);
   }
 
-  bool ForceRefresh(const std::chrono::seconds& minimum_validity) const {
-    return minimum_validity <= std::chrono::seconds(0);
+  /// Checks whether the token stays valid for at least `minimum_validity`.
+  static bool IsValid(const StatePtr& state,
+                      const std::chrono::seconds& minimum_validity) {
+    return state && Clock::now() + minimum_validity < state->expire_at;
   }
 
-  void TryRefreshCurrentToken(client::CancellationToken& cancellation_token,
-                              const std::chrono::seconds& minimum_validity) {
-    std::lock_guard<std::mutex> guard(token_mutex_);
-    current_token_ =
-        token_endpoint_.RequestToken(cancellation_token, token_request_).get();
+  /// Starts a single refresh if the token expires within twice
+  /// `minimum_validity`.
+  void RefreshInBackground(const StatePtr& state,
+                           const std::chrono::seconds& minimum_validity) {
+    if (Clock::now() + 2 * minimum_validity < state->expire_at ||
+        refreshing_.exchange(true)) {
+      return;
+    }
+
+    OLP_SDK_LOG_INFO_F(kLogTag, "Refreshing token in background");
+
+    std::weak_ptr<Impl> weak_self = shared_from_this();
+    token_endpoint_.RequestToken(
+        token_request_, [weak_self](TokenEndpoint::TokenResponse response) {
+          auto self = weak_self.lock();
+          if (!self) {
+            return;
+          }
 
-    if (!current_token_.IsSuccessful()) {
-      OLP_SDK_LOG_INFO_F(
-          kLogTag, "Token NOK, code=%d, error=%s",
-          static_cast<int>(current_token_.GetError().GetErrorCode()),
-          current_token_.GetError().GetMessage().c_str());
-    } else if (current_token_.GetResult().GetErrorResponse().code != 0) {
-      const auto& result = current_token_.GetResult();
+          // A failed refresh keeps the current token until it expires.
+          if (IsOk(response)) {
+            self->Store(response);
+          } else {
+            Log(response);
+          }
+          self->refreshing_.store(false);
+        });
+  }
+
+  void Store(const TokenEndpoint::TokenResponse& token) {
+    Log(token);
+
+    auto state = std::make_shared<State>();
+    state->token = token;
+    state->expire_at = Clock::now();
+    if (IsOk(token)) {
+      state->expire_at += token.GetResult().GetExpiresIn();
+    }
+    std::atomic_store(&state_, StatePtr(std::move(state)));
+  }
+
+  static bool IsOk(const TokenEndpoint::TokenResponse& token) {
+    return token.IsSuccessful() &&
+           token.GetResult().GetErrorResponse().code == 0;
+  }
+
+  static void Log(const TokenEndpoint::TokenResponse& token) {
+    if (!token.IsSuccessful()) {
+      OLP_SDK_LOG_INFO_F(kLogTag, "Token NOK, code=%d, error=%s",
+                         static_cast<int>(token.GetError().GetErrorCode()),
+                         token.GetError().GetMessage().c_str());
+    } else if (token.GetResult().GetErrorResponse().code != 0) {
+      const auto& result = token.GetResult();
       OLP_SDK_LOG_INFO_F(kLogTag, "Token NOK, status=%d, code=%d, error=%s",
                          static_cast<int>(result.GetHttpStatus()),
                          static_cast<int>(result.GetErrorResponse().code),
                          result.GetErrorResponse().message.c_str());
     } else {
-      auto expiry_time = current_token_.GetResult().GetExpiryTime();
+      auto expiry_time = token.GetResult().GetExpiryTime();
       OLP_SDK_LOG_INFO_F(kLogTag, "Token OK, expires=%s",
                          std::asctime(std::gmtime(&expiry_time)));
     }
-
-    token_refresh_time_ = ComputeRefreshTime(
-        current_token_.GetResult().GetExpiresIn(), minimum_validity);
   }
 
-  client::CancellationToken TryRefreshCurrentToken(
-      const GetTokenCallback& callback,
-      const std::chrono::seconds& minimum_validity) {
-    std::lock_guard<std::mutex> guard(token_mutex_);
-
-    // Avoid capturing this, but very risky as updating without lock
-    auto& current_token = current_token_;
-    auto& token_refresh_time = token_refresh_time_;
-
-    return token_endpoint_.RequestToken(
-        token_request_,
-        [&, callback, minimum_validity](TokenEndpoint::TokenResponse response) {
-          current_token = response;
-
-          if (!current_token.IsSuccessful()) {
-            OLP_SDK_LOG_INFO_F(
-                kLogTag, "Token NOK, code=%d, error=%s",
-                static_cast<int>(current_token.GetError().GetErrorCode()),
-                current_token.GetError().GetMessage().c_str());
-          } else if (current_token.GetResult().GetErrorResponse().code != 0) {
-            const auto& result = current_token.GetResult();
-            OLP_SDK_LOG_INFO_F(kLogTag,
-                               "Token NOK, status=%d code=%d, error=%s",
-                               static_cast<int>(result.GetHttpStatus()),
-                               static_cast<int>(result.GetErrorResponse().code),
-                               result.GetErrorResponse().message.c_str());
-          } else {
-            auto expiry_time = current_token.GetResult().GetExpiryTime();
-            OLP_SDK_LOG_INFO_F(kLogTag, "Token OK, expires=%s",
-                               std::asctime(std::gmtime(&expiry_time)));
-          }
-
-          token_refresh_time = ComputeRefreshTime(
-              current_token.GetResult().GetExpiresIn(), minimum_validity);
-          callback(response);
-        });
-  }
-
- private:
   TokenEndpoint token_endpoint_;
   TokenRequest token_request_;
-  TokenEndpoint::TokenResponse current_token_;
-  std::chrono::steady_clock::time_point token_refresh_time_;
+  StatePtr state_;
+  std::atomic<bool> refreshing_;
   std::mutex token_mutex_;
 };
 
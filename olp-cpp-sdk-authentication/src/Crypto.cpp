@@ -20,20 +20,66 @@
 #include <olp/authentication/Crypto.h>
 
 #include <algorithm>
+#include <cstring>
+
+#if defined(OLP_SDK_CRYPTO_COMMONCRYPTO)
+#include <CommonCrypto/CommonDigest.h>
+#include <CommonCrypto/CommonHMAC.h>
+#elif defined(OLP_SDK_CRYPTO_OPENSSL)
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#endif
 
 namespace olp {
 namespace authentication {
 
 namespace {
 
+#if defined(OLP_SDK_CRYPTO_COMMONCRYPTO)
+
+Crypto::Sha256Digest ComputeSha256(const unsigned char* data, size_t length) {
+  Crypto::Sha256Digest ret;
+  CC_SHA256(data, static_cast<CC_LONG>(length), ret.data());
+  return ret;
+}
+
+Crypto::Sha256Digest ComputeHmacSha256(const std::string& key,
+                                       const std::string& message) {
+  Crypto::Sha256Digest ret;
+  CCHmac(kCCHmacAlgSHA256, key.data(), key.size(), message.data(),
+         message.size(), ret.data());
+  return ret;
+}
+
+#elif defined(OLP_SDK_CRYPTO_OPENSSL)
+
+Crypto::Sha256Digest ComputeSha256(const unsigned char* data, size_t length) {
+  Crypto::Sha256Digest ret;
+  SHA256(data, length, ret.data());
+  return ret;
+}
+
+Crypto::Sha256Digest ComputeHmacSha256(const std::string& key,
+                                       const std::string& message) {
+  Crypto::Sha256Digest ret;
+  unsigned int length = static_cast<unsigned int>(ret.size());
+  HMAC(EVP_sha256(), key.data(), static_cast<int>(key.size()),
+       reinterpret_cast<const unsigned char*>(message.data()), message.size(),
+       ret.data(), &length);
+  return ret;
+}
+
+#else
+
 // SHA256 Algorithm from
 // https://csrc.nist.gov/csrc/media/publications/fips/180/4/final/documents/fips180-4-draft-aug2014.pdf
 
 #define SHA256_HASH_VALUE_LENGTH 8
 #define SHA256_CONSTANTS_LENGTH 64
-#define SHA256_LAST_CHUNK_LENGTH 64
+#define SHA256_CHUNK_LENGTH 64
 #define SHA256_MESSAGE_SCHEDULE_LENGTH 64
-#define SHA256_DIGEST_LENGTH 32
+#define SHA256_LENGTH_FIELD_SIZE 8
 
 #define ROTR(x, n) ((x >> n) | (x << (32 - n)))
 #define SHA256_CH(x, y, z) ((x & y) ^ (~x & z))
@@ -43,7 +89,7 @@ namespace {
 #define SHA256_SIGMA0(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ (x >> 3))
 #define SHA256_SIGMA1(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ (x >> 10))
 
-static uint32_t SHA256_K[SHA256_CONSTANTS_LENGTH] = {
+static const uint32_t SHA256_K[SHA256_CONSTANTS_LENGTH] = {
     0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
     0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
     0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
@@ -63,173 +109,170 @@ static uint32_t SHA256_K[SHA256_CONSTANTS_LENGTH] = {
 #define HMAC_OPAD_BYTE 0x5c
 #define HMAC_B 64
 
-std::vector<uint32_t> Sha256Init() {
-  std::vector<uint32_t> hashValue;
-  hashValue.push_back(0x6a09e667);
-  hashValue.push_back(0xbb67ae85);
-  hashValue.push_back(0x3c6ef372);
-  hashValue.push_back(0xa54ff53a);
-  hashValue.push_back(0x510e527f);
-  hashValue.push_back(0x9b05688c);
-  hashValue.push_back(0x1f83d9ab);
-  hashValue.push_back(0x5be0cd19);
-
-  return hashValue;
-}
-
-void Sha256Transform(const std::vector<unsigned char>& current_chunk,
-                     unsigned long start_index,
-                     std::vector<uint32_t>& hash_value) {
-  std::array<uint32_t, SHA256_MESSAGE_SCHEDULE_LENGTH> w;
-
-  for (int i = 0, j = 0; i < 16; i++, j += 4)
-    w[i] = (current_chunk[start_index + j] << 24) |
-           (current_chunk[start_index + j + 1] << 16) |
-           (current_chunk[start_index + j + 2] << 8) |
-           (current_chunk[start_index + j + 3]);
-  for (int i = 16; i < SHA256_MESSAGE_SCHEDULE_LENGTH; i++) {
-    w[i] = SHA256_SIGMA1(w[i - 2]) + w[i - 7] + SHA256_SIGMA0(w[i - 15]) +
-           w[i - 16];
-  }
-
-  std::array<uint32_t, SHA256_HASH_VALUE_LENGTH> working_var;
-  for (int i = 0; i < SHA256_HASH_VALUE_LENGTH; i++) {
-    working_var[i] = hash_value[i];
-  }
+/// Computes SHA-256 over the data passed to `Update`, without copying it
+/// unless it ends in the middle of a chunk.
+class Sha256 {
+ public:
+  Sha256()
+      : hash_value_{{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}} {}
+
+  void Update(const unsigned char* data, size_t length) {
+    total_length_ += length;
+
+    if (buffered_ > 0u) {
+      const auto count = std::min(length, SHA256_CHUNK_LENGTH - buffered_);
+      std::memcpy(buffer_.data() + buffered_, data, count);
+      buffered_ += count;
+      data += count;
+      length -= count;
+      if (buffered_ < SHA256_CHUNK_LENGTH) {
+        return;
+      }
+      Transform(buffer_.data());
+      buffered_ = 0u;
+    }
 
-  for (int i = 0; i < SHA256_MESSAGE_SCHEDULE_LENGTH; i++) {
-    uint32_t t1 = working_var[7] + SHA256_SUM1(working_var[4]) +
-                  SHA256_CH(working_var[4], working_var[5], working_var[6]) +
-                  SHA256_K[i] + w[i];
-    uint32_t t2 = SHA256_SUM0(working_var[0]) +
-                  SHA256_MAJ(working_var[0], working_var[1], working_var[2]);
-    working_var[7] = working_var[6];
-    working_var[6] = working_var[5];
-    working_var[5] = working_var[4];
-    working_var[4] = working_var[3] + t1;
-    working_var[3] = working_var[2];
-    working_var[2] = working_var[1];
-    working_var[1] = working_var[0];
-    working_var[0] = t1 + t2;
-  }
+    for (; length >= SHA256_CHUNK_LENGTH; length -= SHA256_CHUNK_LENGTH) {
+      Transform(data);
+      data += SHA256_CHUNK_LENGTH;
+    }
 
-  for (int i = 0; i < SHA256_HASH_VALUE_LENGTH; i++) {
-    hash_value[i] += working_var[i];
+    if (length > 0u) {
+      std::memcpy(buffer_.data(), data, length);
+      buffered_ = length;
+    }
   }
-}
 
-Crypto::Sha256Digest ComputeSha256(const std::vector<unsigned char>& src) {
-  auto hash_value = Sha256Init();
-  std::vector<std::vector<unsigned char> > chucks_to_process;
+  Crypto::Sha256Digest Final() {
+    const uint64_t bit_length = total_length_ * 8u;
 
-  const auto length = src.size();
-  const auto chunks_count = length / SHA256_LAST_CHUNK_LENGTH;
-  const auto last_chunk_size = length % SHA256_LAST_CHUNK_LENGTH;
-
-  std::vector<unsigned char> last_chunk;
-  if (last_chunk_size < 56) {
-    last_chunk.assign(src.begin() + (chunks_count * SHA256_LAST_CHUNK_LENGTH),
-                      src.end());
-    last_chunk.push_back(0x80);
-  } else {
-    // Not enough empty space left in the last chunk, need another one
-    std::vector<unsigned char> second_last_chunk;
-    second_last_chunk.assign(
-        src.begin() + (chunks_count * SHA256_LAST_CHUNK_LENGTH), src.end());
-    second_last_chunk.push_back(0x80);
-    auto chunkSize = second_last_chunk.size();
-    for (auto i = chunkSize; i < SHA256_LAST_CHUNK_LENGTH; i++) {
-      second_last_chunk.push_back(0);
+    // The padding is 0x80, zeros, and the message length, so that the
+    // message fills complete chunks.
+    buffer_[buffered_++] = 0x80;
+    if (buffered_ > SHA256_CHUNK_LENGTH - SHA256_LENGTH_FIELD_SIZE) {
+      std::fill(buffer_.begin() + buffered_, buffer_.end(), 0);
+      Transform(buffer_.data());
+      buffered_ = 0u;
+    }
+    std::fill(buffer_.begin() + buffered_,
+              buffer_.end() - SHA256_LENGTH_FIELD_SIZE, 0);
+    for (int i = 0; i < SHA256_LENGTH_FIELD_SIZE; i++) {
+      buffer_[SHA256_CHUNK_LENGTH - 1 - i] =
+          static_cast<unsigned char>(bit_length >> (i * 8));
+    }
+    Transform(buffer_.data());
+
+    Crypto::Sha256Digest ret;
+    for (int i = 0, j = 0; i < SHA256_HASH_VALUE_LENGTH; i++, j += 4) {
+      const uint32_t value = hash_value_[i];
+      ret[j + 0] = static_cast<unsigned char>(value >> 24);
+      ret[j + 1] = static_cast<unsigned char>(value >> 16);
+      ret[j + 2] = static_cast<unsigned char>(value >> 8);
+      ret[j + 3] = static_cast<unsigned char>(value);
     }
-    chucks_to_process.push_back(second_last_chunk);
+    return ret;
   }
 
-  for (auto i = last_chunk.size(); i < (SHA256_LAST_CHUNK_LENGTH - 8); i++) {
-    last_chunk.push_back(0);
-  }
-  uint64_t srcLength = length * 8;
-  for (int i = 8; i > 0; --i) {
-    last_chunk.push_back((srcLength >> ((i - 1) * 8)) & 0xff);
-  }
-  chucks_to_process.push_back(last_chunk);
+ private:
+  void Transform(const unsigned char* chunk) {
+    std::array<uint32_t, SHA256_MESSAGE_SCHEDULE_LENGTH> w;
 
-  for (auto i = 0UL; i < chunks_count; i++) {
-    Sha256Transform(src, i * SHA256_LAST_CHUNK_LENGTH, hash_value);
-  }
+    for (int i = 0, j = 0; i < 16; i++, j += 4) {
+      w[i] = (static_cast<uint32_t>(chunk[j]) << 24) |
+             (static_cast<uint32_t>(chunk[j + 1]) << 16) |
+             (static_cast<uint32_t>(chunk[j + 2]) << 8) |
+             static_cast<uint32_t>(chunk[j + 3]);
+    }
+    for (int i = 16; i < SHA256_MESSAGE_SCHEDULE_LENGTH; i++) {
+      w[i] = SHA256_SIGMA1(w[i - 2]) + w[i - 7] + SHA256_SIGMA0(w[i - 15]) +
+             w[i - 16];
+    }
 
-  for (const auto& chunk : chucks_to_process) {
-    Sha256Transform(chunk, 0, hash_value);
-  }
+    uint32_t a = hash_value_[0];
+    uint32_t b = hash_value_[1];
+    uint32_t c = hash_value_[2];
+    uint32_t d = hash_value_[3];
+    uint32_t e = hash_value_[4];
+    uint32_t f = hash_value_[5];
+    uint32_t g = hash_value_[6];
+    uint32_t h = hash_value_[7];
+
+    for (int i = 0; i < SHA256_MESSAGE_SCHEDULE_LENGTH; i++) {
+      const uint32_t t1 =
+          h + SHA256_SUM1(e) + SHA256_CH(e, f, g) + SHA256_K[i] + w[i];
+      const uint32_t t2 = SHA256_SUM0(a) + SHA256_MAJ(a, b, c);
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
 
-  Crypto::Sha256Digest ret;
-  for (int i = 0, j = 0; i < SHA256_HASH_VALUE_LENGTH; i++, j += 4) {
-    uint32_t value = hash_value[i];
-    auto v3 = (unsigned char)value;
-    auto v2 = (unsigned char)(value >>= 8);
-    auto v1 = (unsigned char)(value >>= 8);
-    ret[j + 0] = (unsigned char)(value >>= 8);
-    ret[j + 1] = v1;
-    ret[j + 2] = v2;
-    ret[j + 3] = v3;
+    hash_value_[0] += a;
+    hash_value_[1] += b;
+    hash_value_[2] += c;
+    hash_value_[3] += d;
+    hash_value_[4] += e;
+    hash_value_[5] += f;
+    hash_value_[6] += g;
+    hash_value_[7] += h;
   }
 
-  return ret;
-}
+  std::array<uint32_t, SHA256_HASH_VALUE_LENGTH> hash_value_;
+  std::array<unsigned char, SHA256_CHUNK_LENGTH> buffer_;
+  size_t buffered_{0u};
+  uint64_t total_length_{0u};
+};
 
-std::vector<unsigned char> ToUnsignedCharVector(const std::string& src) {
-  std::vector<unsigned char> ret(src.length());
-  std::transform(src.begin(), src.end(), ret.begin(),
-                 [](char c) { return static_cast<unsigned char>(c); });
-  return ret;
+Crypto::Sha256Digest ComputeSha256(const unsigned char* data, size_t length) {
+  Sha256 sha;
+  sha.Update(data, length);
+  return sha.Final();
 }
 
 Crypto::Sha256Digest ComputeHmacSha256(const std::string& key,
                                        const std::string& message) {
-  std::vector<unsigned char> k0;
-
   // Step 1 - 3
-  auto key_length = key.length();
-  std::vector<uint8_t> keyVec = ToUnsignedCharVector(key);
-  if (key_length <= HMAC_B) {
-    k0.assign(keyVec.begin(), keyVec.end());
+  std::array<unsigned char, HMAC_B> k0{};
+  const auto* key_data = reinterpret_cast<const unsigned char*>(key.data());
+  if (key.length() <= HMAC_B) {
+    std::copy(key_data, key_data + key.length(), k0.begin());
   } else {
-    auto new_key = ComputeSha256(keyVec);
-    key_length = new_key.size();
-    k0.assign(new_key.begin(), new_key.end());
-  }
-
-  for (auto i = key_length; i < HMAC_B; i++) {
-    k0.push_back(0);
+    const auto new_key = ComputeSha256(key_data, key.length());
+    std::copy(new_key.begin(), new_key.end(), k0.begin());
   }
 
-  // Step 4 - 5
-  std::vector<uint8_t> k0XORipad_msg;
-  for (int i = 0; i < HMAC_B; i++) {
-    k0XORipad_msg.push_back(k0[i] ^ HMAC_IPAD_BYTE);
-  }
-
-  std::vector<uint8_t> message_vec = ToUnsignedCharVector(message);
-  k0XORipad_msg.insert(k0XORipad_msg.end(), message_vec.begin(),
-                       message_vec.end());
-
-  // Step 6
-  auto hk0XORipad_msg = ComputeSha256(k0XORipad_msg);
-
-  // Step 7 - 8
-  std::vector<uint8_t> s8;
-  for (int i = 0; i < HMAC_B; i++) {
-    s8.push_back(k0[i] ^ HMAC_OPAD_BYTE);
-  }
+  // Step 4 - 6
+  std::array<unsigned char, HMAC_B> pad;
+  std::transform(k0.begin(), k0.end(), pad.begin(),
+                 [](unsigned char c) { return c ^ HMAC_IPAD_BYTE; });
+
+  Sha256 inner;
+  inner.Update(pad.data(), pad.size());
+  inner.Update(reinterpret_cast<const unsigned char*>(message.data()),
+               message.length());
+  const auto hk0XORipad_msg = inner.Final();
+
+  // Step 7 - 9
+  std::transform(k0.begin(), k0.end(), pad.begin(),
+                 [](unsigned char c) { return c ^ HMAC_OPAD_BYTE; });
+
+  Sha256 outer;
+  outer.Update(pad.data(), pad.size());
+  outer.Update(hk0XORipad_msg.data(), hk0XORipad_msg.size());
+  return outer.Final();
+}
 
-  s8.insert(s8.end(), hk0XORipad_msg.begin(), hk0XORipad_msg.end());
+#endif
 
-  // Step 9
-  return ComputeSha256(s8);
-}
 }  // namespace
 
 Crypto::Sha256Digest Crypto::Sha256(const std::vector<unsigned char>& content) {
-  return ComputeSha256(content);
+  return ComputeSha256(content.data(), content.size());
 }
 
 Crypto::Sha256Digest Crypto::HmacSha256(const std::string& key,
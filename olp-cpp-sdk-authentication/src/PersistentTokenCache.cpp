@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "PersistentTokenCache.h"
+
+#include <ctime>
+#include <memory>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include "Constants.h"
+#include "SignInResultImpl.h"
+#include "olp/authentication/Crypto.h"
+#include "olp/core/cache/KeyValueCache.h"
+#include "olp/core/http/HttpStatusCode.h"
+#include "olp/core/http/NetworkUtils.h"
+#include "olp/core/logging/Log.h"
+
+#if defined(OLP_SDK_CRYPTO_OPENSSL)
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#endif
+
+namespace olp {
+namespace authentication {
+
+namespace {
+constexpr auto kLogTag = "PersistentTokenCache";
+constexpr auto kTokenType = "tokenType";
+constexpr auto kUserId = "userId";
+constexpr auto kScope = "scope";
+constexpr auto kExpiryTime = "expiryTime";
+
+constexpr unsigned char kFormatVersion = 2u;
+constexpr size_t kNonceSize = 12u;
+constexpr size_t kTagSize = 16u;
+constexpr size_t kHeaderSize = 1u + kNonceSize;
+
+using Bytes = cache::KeyValueCache::ValueType;
+
+/// Derives the AES-256 key from the secret.
+Crypto::Sha256Digest DeriveKey(const AuthenticationCredentials& credentials) {
+  return Crypto::HmacSha256(credentials.GetSecret(), "olp-persistent-token");
+}
+
+std::string ToHex(const Crypto::Sha256Digest& digest) {
+  constexpr auto kDigits = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(digest.size() * 2u);
+  for (auto value : digest) {
+    hex.push_back(kDigits[value >> 4]);
+    hex.push_back(kDigits[value & 0x0Fu]);
+  }
+  return hex;
+}
+
+#if defined(OLP_SDK_CRYPTO_OPENSSL)
+
+using CipherContext =
+    std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+/// Encrypts the token with AES-256-GCM. The output is the format version, the
+/// nonce, the encrypted token, and the tag. The cache key is authenticated as
+/// well, so an entry can't be moved to another key.
+bool Seal(const Crypto::Sha256Digest& key, const std::string& aad,
+          const std::string& plain, Bytes& output) {
+  output.assign(kHeaderSize + plain.size() + kTagSize, 0u);
+  output[0] = kFormatVersion;
+  auto* nonce = output.data() + 1u;
+  auto* cipher = output.data() + kHeaderSize;
+  auto* tag = cipher + plain.size();
+
+  CipherContext context(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
+  int length = 0;
+  return context && RAND_bytes(nonce, kNonceSize) == 1 &&
+         EVP_EncryptInit_ex(context.get(), EVP_aes_256_gcm(), nullptr,
+                            nullptr, nullptr) == 1 &&
+         EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_SET_IVLEN,
+                             kNonceSize, nullptr) == 1 &&
+         EVP_EncryptInit_ex(context.get(), nullptr, nullptr, key.data(),
+                            nonce) == 1 &&
+         EVP_EncryptUpdate(context.get(), nullptr, &length,
+                           reinterpret_cast<const unsigned char*>(aad.data()),
+                           static_cast<int>(aad.size())) == 1 &&
+         EVP_EncryptUpdate(
+             context.get(), cipher, &length,
+             reinterpret_cast<const unsigned char*>(plain.data()),
+             static_cast<int>(plain.size())) == 1 &&
+         EVP_EncryptFinal_ex(context.get(), cipher + length, &length) == 1 &&
+         EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_GET_TAG, kTagSize,
+                             tag) == 1;
+}
+
+/// Decrypts the token, and fails if the entry was modified.
+bool Open(const Crypto::Sha256Digest& key, const std::string& aad,
+          const Bytes& input, std::string& plain) {
+  if (input.size() < kHeaderSize + kTagSize || input[0] != kFormatVersion) {
+    return false;
+  }
+
+  const auto* nonce = input.data() + 1u;
+  const auto* cipher = input.data() + kHeaderSize;
+  const auto cipher_size = input.size() - kHeaderSize - kTagSize;
+  Bytes tag(cipher + cipher_size, cipher + cipher_size + kTagSize);
+  Bytes output(cipher_size + 1u);
+
+  CipherContext context(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
+  int length = 0;
+  int final_length = 0;
+  const auto opened =
+      context &&
+      EVP_DecryptInit_ex(context.get(), EVP_aes_256_gcm(), nullptr, nullptr,
+                         nullptr) == 1 &&
+      EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_SET_IVLEN, kNonceSize,
+                          nullptr) == 1 &&
+      EVP_DecryptInit_ex(context.get(), nullptr, nullptr, key.data(),
+                         nonce) == 1 &&
+      EVP_DecryptUpdate(context.get(), nullptr, &length,
+                        reinterpret_cast<const unsigned char*>(aad.data()),
+                        static_cast<int>(aad.size())) == 1 &&
+      EVP_DecryptUpdate(context.get(), output.data(), &length, cipher,
+                        static_cast<int>(cipher_size)) == 1 &&
+      EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_SET_TAG, kTagSize,
+                          tag.data()) == 1 &&
+      EVP_DecryptFinal_ex(context.get(), output.data() + length,
+                          &final_length) == 1;
+  if (!opened) {
+    return false;
+  }
+
+  plain.assign(output.begin(), output.begin() + length + final_length);
+  return true;
+}
+
+#else
+
+// The authenticated encryption is taken from the platform crypto library,
+// the tokens are not persisted without it.
+bool Seal(const Crypto::Sha256Digest&, const std::string&, const std::string&,
+          Bytes&) {
+  return false;
+}
+
+bool Open(const Crypto::Sha256Digest&, const std::string&, const Bytes&,
+          std::string&) {
+  return false;
+}
+
+#endif
+
+std::string Serialize(const SignInResult& result) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key(Constants::ACCESS_TOKEN);
+  writer.String(result.GetAccessToken().c_str());
+  writer.Key(kTokenType);
+  writer.String(result.GetTokenType().c_str());
+  writer.Key(Constants::REFRESH_TOKEN);
+  writer.String(result.GetRefreshToken().c_str());
+  writer.Key(kUserId);
+  writer.String(result.GetUserIdentifier().c_str());
+  writer.Key(kScope);
+  writer.String(result.GetScope().c_str());
+  writer.Key(kExpiryTime);
+  writer.Int64(static_cast<int64_t>(result.GetExpiryTime()));
+  writer.EndObject();
+  return std::string(buffer.GetString(), buffer.GetSize());
+}
+}  // namespace
+
+bool PersistentTokenCache::IsSupported() {
+#if defined(OLP_SDK_CRYPTO_OPENSSL)
+  return true;
+#else
+  return false;
+#endif
+}
+
+PersistentTokenCache::PersistentTokenCache(
+    std::shared_ptr<cache::KeyValueCache> cache, std::string token_endpoint_url)
+    : cache_(std::move(cache)),
+      token_endpoint_url_(std::move(token_endpoint_url)) {}
+
+void PersistentTokenCache::Put(const AuthenticationCredentials& credentials,
+                               const RequestBody& request_body,
+                               const SignInResult& result) {
+  const auto expires_in = result.GetExpiryTime() - std::time(nullptr);
+  if (expires_in <= 0) {
+    return;
+  }
+
+  const auto key = CreateKey(credentials, request_body);
+  auto value = std::make_shared<Bytes>();
+  if (!Seal(DeriveKey(credentials), key, Serialize(result), *value)) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Failed to encrypt the token");
+    return;
+  }
+
+  if (!cache_->Put(key, value, expires_in)) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Failed to persist the token");
+  }
+}
+
+std::shared_ptr<SignInResultImpl> PersistentTokenCache::Load(
+    const AuthenticationCredentials& credentials,
+    const RequestBody& request_body, std::chrono::seconds minimum_validity) {
+  const auto key = CreateKey(credentials, request_body);
+  auto value = cache_->Get(key);
+  if (!value) {
+    return nullptr;
+  }
+
+  std::string plain;
+  if (!Open(DeriveKey(credentials), key, *value, plain)) {
+    OLP_SDK_LOG_WARNING(kLogTag, "The persisted token is not authentic");
+    return nullptr;
+  }
+
+  auto document = std::make_shared<rapidjson::Document>();
+  document->Parse(plain.data(), plain.size());
+  if (!document->IsObject() || !document->HasMember(kExpiryTime) ||
+      !(*document)[kExpiryTime].IsInt64()) {
+    return nullptr;
+  }
+
+  const auto expires_in =
+      (*document)[kExpiryTime].GetInt64() - std::time(nullptr);
+  if (expires_in < minimum_validity.count()) {
+    return nullptr;
+  }
+
+  document->RemoveMember(kExpiryTime);
+  document->AddMember(rapidjson::StringRef(Constants::EXPIRES_IN),
+                      static_cast<unsigned>(expires_in),
+                      document->GetAllocator());
+
+  OLP_SDK_LOG_DEBUG(kLogTag, "Using the persisted token");
+  return std::make_shared<SignInResultImpl>(
+      http::HttpStatusCode::OK,
+      http::HttpErrorToString(http::HttpStatusCode::OK), document);
+}
+
+std::string PersistentTokenCache::CreateKey(
+    const AuthenticationCredentials& credentials,
+    const RequestBody& request_body) const {
+  // The request body holds the sign in properties, e.g. the scope, so the
+  // tokens requested with other properties are kept apart.
+  return "authentication::" + token_endpoint_url_ +
+         "::" + credentials.GetKey() +
+         "::" + ToHex(Crypto::Sha256(request_body)) + "::token";
+}
+
+}  // namespace authentication
+}  // namespace olp
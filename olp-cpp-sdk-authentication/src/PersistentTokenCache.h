@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "olp/authentication/AuthenticationCredentials.h"
+#include "olp/authentication/SignInResult.h"
+
+namespace olp {
+namespace cache {
+class KeyValueCache;
+}  // namespace cache
+
+namespace authentication {
+class SignInResultImpl;
+
+/**
+ * @brief Persists the client tokens in the `KeyValueCache`, so that a new
+ * process can use a still valid token without signing in again.
+ *
+ * The tokens are encrypted with AES-256-GCM with a key derived from the access
+ * key secret, so they can be read only with the credentials that requested
+ * them. The authenticated encryption needs the platform crypto library, see
+ * `IsSupported`.
+ */
+class PersistentTokenCache final {
+ public:
+  /// The body of the sign in request that holds the sign in properties.
+  using RequestBody = std::vector<unsigned char>;
+
+  /// Checks whether the tokens can be persisted with this build.
+  static bool IsSupported();
+
+  PersistentTokenCache(std::shared_ptr<cache::KeyValueCache> cache,
+                       std::string token_endpoint_url);
+
+  /// Persists the token until it expires.
+  void Put(const AuthenticationCredentials& credentials,
+           const RequestBody& request_body, const SignInResult& result);
+
+  /**
+   * @brief Gets the persisted token that was requested with the same
+   * credentials and sign in properties.
+   *
+   * @return The token if it is valid for at least `minimum_validity` seconds,
+   * or null otherwise.
+   */
+  std::shared_ptr<SignInResultImpl> Load(
+      const AuthenticationCredentials& credentials,
+      const RequestBody& request_body, std::chrono::seconds minimum_validity);
+
+ private:
+  std::string CreateKey(const AuthenticationCredentials& credentials,
+                        const RequestBody& request_body) const;
+
+  std::shared_ptr<cache::KeyValueCache> cache_;
+  const std::string token_endpoint_url_;
+};
+
+}  // namespace authentication
+}  // namespace olp
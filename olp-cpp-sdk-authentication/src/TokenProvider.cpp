@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/authentication/TokenProvider.h"
+
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "olp/authentication/Crypto.h"
+
+namespace olp {
+namespace authentication {
+PORTING_PUSH_WARNINGS()
+PORTING_CLANG_GCC_DISABLE_WARNING("-Wdeprecated-declarations")
+
+namespace {
+/// Returns the hash of the settings that change the requested token, so the
+/// registry does not keep the secret and the proxy password.
+std::string CreateKey(const Settings& settings,
+                      std::chrono::seconds minimum_validity) {
+  std::ostringstream key;
+  key << settings.credentials.GetKey() << '\n'
+      << settings.credentials.GetSecret() << '\n'
+      << settings.token_endpoint_url << '\n'
+      << settings.network_request_handler.get() << '\n'
+      << settings.task_scheduler.get() << '\n'
+      << settings.use_system_time << '\n'
+      << minimum_validity.count();
+
+  if (settings.network_proxy_settings) {
+    const auto& proxy = *settings.network_proxy_settings;
+    key << '\n'
+        << static_cast<int>(proxy.GetType()) << '\n'
+        << proxy.GetHostname() << '\n'
+        << proxy.GetPort() << '\n'
+        << proxy.GetUsername() << '\n'
+        << proxy.GetPassword();
+  }
+
+  const auto content = key.str();
+  const auto digest = Crypto::Sha256(
+      std::vector<unsigned char>(content.begin(), content.end()));
+  return std::string(digest.begin(), digest.end());
+}
+}  // namespace
+
+namespace detail {
+std::shared_ptr<AutoRefreshingToken> GetSharedToken(
+    Settings settings, std::chrono::seconds minimum_validity) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::weak_ptr<AutoRefreshingToken>>
+      tokens;
+
+  const auto key = CreateKey(settings, minimum_validity);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& weak_token = tokens[key];
+  auto token = weak_token.lock();
+  if (!token) {
+    token = std::make_shared<AutoRefreshingToken>(
+        TokenEndpoint(std::move(settings)).RequestAutoRefreshingToken());
+    weak_token = token;
+
+    // Releases the tokens of the destroyed providers.
+    for (auto it = tokens.begin(); it != tokens.end();) {
+      it = it->second.expired() ? tokens.erase(it) : std::next(it);
+    }
+  }
+
+  return token;
+}
+}  // namespace detail
+
+PORTING_POP_WARNINGS()
+}  // namespace authentication
+}  // namespace olp
@@ -49,6 +49,17 @@ TEST(CryptoTest, Sha256) {
     const auto computedHashStr = ToString(computedHash);
     EXPECT_EQ(computedHashStr, expectedHash);
   }
+  {
+    SCOPED_TRACE("Sha256 with two chunks");
+    const auto expectedHash =
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1";
+
+    const std::string content =
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    const std::vector<unsigned char> bytes(std::begin(content),
+                                           std::end(content));
+    EXPECT_EQ(ToString(Crypto::Sha256(bytes)), expectedHash);
+  }
 }
 
 TEST(CryptoTest, HMACSha256) {
@@ -62,6 +73,16 @@ TEST(CryptoTest, HMACSha256) {
     const auto computedHashStr = ToString(computedHash);
     EXPECT_EQ(computedHashStr, expectedHash);
   }
+  {
+    SCOPED_TRACE("HMACSha256 with a key larger than the block");
+    const auto expectedHash =
+        "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54";
+
+    const std::string key(131u, '\xaa');
+    const std::string content =
+        "Test Using Larger Than Block-Size Key - Hash Key First";
+    EXPECT_EQ(ToString(Crypto::HmacSha256(key, content)), expectedHash);
+  }
 }
 
 }  // namespace
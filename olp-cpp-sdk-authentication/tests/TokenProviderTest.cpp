@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <olp/authentication/TokenProvider.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+
+PORTING_PUSH_WARNINGS()
+PORTING_CLANG_GCC_DISABLE_WARNING("-Wdeprecated-declarations")
+
+namespace {
+using olp::authentication::AuthenticationCredentials;
+using olp::authentication::Settings;
+using olp::authentication::detail::GetSharedToken;
+
+TEST(TokenProviderTest, SharedToken) {
+  const Settings settings(AuthenticationCredentials("key", "secret"));
+
+  {
+    SCOPED_TRACE("Same settings share the token");
+
+    auto token = GetSharedToken(settings);
+    EXPECT_EQ(token, GetSharedToken(settings));
+  }
+  {
+    SCOPED_TRACE("Different credentials do not share the token");
+
+    auto token = GetSharedToken(settings);
+    EXPECT_NE(token,
+              GetSharedToken(Settings(AuthenticationCredentials("key", "x"))));
+  }
+  {
+    SCOPED_TRACE("Different endpoints do not share the token");
+
+    auto other_settings = settings;
+    other_settings.token_endpoint_url = "https://example.com/oauth2/token";
+
+    auto token = GetSharedToken(settings);
+    EXPECT_NE(token, GetSharedToken(other_settings));
+  }
+  {
+    SCOPED_TRACE("Different minimum validities do not share the token");
+
+    auto token = GetSharedToken(settings, std::chrono::seconds(60));
+    EXPECT_EQ(token, GetSharedToken(settings, std::chrono::seconds(60)));
+    EXPECT_NE(token, GetSharedToken(settings, std::chrono::seconds(120)));
+  }
+  {
+    SCOPED_TRACE("Different task schedulers do not share the token");
+
+    auto other_settings = settings;
+    other_settings.task_scheduler =
+        olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(1u);
+
+    auto token = GetSharedToken(settings);
+    EXPECT_NE(token, GetSharedToken(other_settings));
+  }
+  {
+    SCOPED_TRACE("Released token is not reused");
+
+    std::weak_ptr<olp::authentication::AutoRefreshingToken> released =
+        GetSharedToken(settings);
+    EXPECT_TRUE(released.expired());
+  }
+}
+
+}  // namespace
+
+PORTING_POP_WARNINGS()
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace cache {
+
+/**
+ * @brief An interface for a codec that encodes values before they are written
+ * to the disk cache.
+ *
+ * Use codecs to compress values that compress well, for example, JSON
+ * metadata. Encoded values are prefixed with a small header that contains the
+ * codec ID, so a database that contains values encoded with different codecs
+ * and values that are not encoded can be read as long as all the codecs used
+ * are configured.
+ *
+ * Values are decoded by concurrent lookups, so `Decode` must be thread-safe.
+ *
+ * @see `CacheSettings::codecs`
+ */
+class CORE_API CacheCodec {
+ public:
+  virtual ~CacheCodec() = default;
+
+  /**
+   * @brief Gets the ID of the codec that is stored with every encoded value.
+   *
+   * The ID must be unique among the configured codecs and must not change
+   * between runs. The ID `0` is reserved for the values that are stored as
+   * is.
+   *
+   * @return The codec ID.
+   */
+  virtual std::uint8_t GetId() const = 0;
+
+  /**
+   * @brief Encodes the value.
+   *
+   * @param data The pointer to the value.
+   * @param size The size of the value.
+   * @param output The encoded value.
+   *
+   * @return True if the value is encoded; false if the value should be stored
+   * as is, for example, because it does not compress.
+   */
+  virtual bool Encode(const char* data, size_t size,
+                      std::string& output) const = 0;
+
+  /**
+   * @brief Decodes the value that was encoded with `Encode`.
+   *
+   * @param data The pointer to the encoded value.
+   * @param size The size of the encoded value.
+   * @param output The decoded value.
+   *
+   * @return True if the value is decoded; false otherwise.
+   */
+  virtual bool Decode(const char* data, size_t size,
+                      std::string& output) const = 0;
+};
+
+}  // namespace cache
+}  // namespace olp
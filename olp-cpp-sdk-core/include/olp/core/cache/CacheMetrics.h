@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace cache {
+
+/**
+ * @brief The counters of a single cache tier.
+ */
+struct CORE_API CacheTierMetrics {
+  /// The number of lookups that found a valid value.
+  uint64_t hits{0u};
+  /// The number of lookups that did not find a valid value.
+  uint64_t misses{0u};
+  /// The size of the values read on hits. Values that are stored in the memory
+  /// cache in the decoded form are not counted.
+  uint64_t bytes_read{0u};
+  /// The size of the values written.
+  uint64_t bytes_written{0u};
+  /// The number of values evicted to free space.
+  uint64_t evictions{0u};
+  /// The number of values found expired on lookup.
+  uint64_t expirations{0u};
+};
+
+/**
+ * @brief The latency histogram of a cache operation.
+ *
+ * The bucket `0` counts the operations that took less than 1 microsecond.
+ * The bucket `i` counts the operations that took from `2^(i-1)` to `2^i`
+ * microseconds, and the last bucket counts all the longer operations.
+ */
+struct CORE_API CacheLatencyHistogram {
+  /// The number of the histogram buckets.
+  static constexpr size_t kBucketCount = 24u;
+
+  /// The number of operations per bucket.
+  std::array<uint64_t, kBucketCount> buckets{};
+  /// The total number of operations.
+  uint64_t count{0u};
+  /// The total time spent in the operations.
+  std::chrono::microseconds total_time{0};
+};
+
+/**
+ * @brief A snapshot of the cache metrics.
+ *
+ * The memory tier does not report expirations and evictions, as the memory
+ * cache drops such values internally.
+ *
+ * @see `CacheSettings::collect_metrics`
+ */
+struct CORE_API CacheMetrics {
+  /// The memory cache counters.
+  CacheTierMetrics memory;
+  /// The mutable disk cache counters.
+  CacheTierMetrics mutable_disk;
+  /// The protected disk cache counters.
+  CacheTierMetrics protected_disk;
+  /// The counters of the mutable cache shared by another process. Only its
+  /// hits and misses are counted.
+  CacheTierMetrics shared_disk;
+  /// The latency of the single value `Get` calls.
+  CacheLatencyHistogram get_latency;
+  /// The latency of the single value `Put` calls.
+  CacheLatencyHistogram put_latency;
+};
+
+}  // namespace cache
+}  // namespace olp
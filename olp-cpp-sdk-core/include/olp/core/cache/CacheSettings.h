@@ -19,16 +19,26 @@
 
 #pragma once
 
+#include <chrono>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <olp/core/Config.h>
 
 #include <olp/core/CoreApi.h>
+#include <olp/core/cache/CacheCodec.h>
 
 #include <olp/core/porting/deprecated.h>
 #include <boost/optional.hpp>
 
 namespace olp {
+namespace client {
+class MemoryBudget;
+}  // namespace client
+
 namespace cache {
 
 #ifdef OLP_SDK_ENABLE_DEFAULT_CACHE
@@ -46,8 +56,20 @@ enum OpenOptions : unsigned char {
  * @brief Options for mutable cache eviction policy.
  */
 enum class EvictionPolicy : unsigned char {
-  kNone,             /*!< Disables eviction. */
-  kLeastRecentlyUsed /*!< Evict least recently used key/value. */
+  kNone,              /*!< Disables eviction. */
+  kLeastRecentlyUsed, /*!< Evict least recently used key/value. */
+  kCostAware /*!< Evict, among the least recently used key/values, the one
+                with the lowest re-fetch cost per byte, see
+                `RefetchCostScope`. */
+};
+
+/**
+ * @brief Options for memory cache admission policy.
+ */
+enum class AdmissionPolicy : unsigned char {
+  kNone,   /*!< Admits every key. */
+  kTinyLfu /*!< Admits a key only if it is used more often than the evicted
+              one. */
 };
 
 /**
@@ -59,6 +81,40 @@ enum class CompressionType {
                         storing. */
 };
 
+/**
+ * @brief Settings for the lookup performance of a disk cache.
+ */
+struct CORE_API DiskCacheTuning {
+  /**
+   * @brief Sets the number of bits per key of the bloom filter that is used to
+   * skip the storage files that do not contain a key.
+   *
+   * Higher values reduce the number of disk reads for the keys that are not in
+   * the cache at the cost of memory and disk space. If set to `0`, no bloom
+   * filter is used. The default value is `10`, which gives a false positive
+   * rate of about 1%.
+   */
+  size_t bloom_filter_bits_per_key = 10u;
+
+  /**
+   * @brief Sets the capacity (in bytes) of the cache of uncompressed storage
+   * blocks.
+   *
+   * If set to `0`, the default block cache of 8 MB is used.
+   */
+  size_t block_cache_size = 0u;
+
+  /**
+   * @brief Sets the approximate size (in bytes) of the uncompressed data
+   * stored in a storage block.
+   *
+   * Larger blocks improve bulk scans and compression, smaller blocks improve
+   * the lookup of single keys. The setting applies only to the storage files
+   * written after the change. The default value is 4 KB.
+   */
+  size_t block_size = 4u * 1024u;
+};
+
 /**
  * @brief Settings for memory and disk caching.
  */
@@ -101,6 +157,30 @@ struct CORE_API CacheSettings {
    */
   bool enforce_immediate_flush = true;
 
+  /**
+   * @brief Sets the maximum number of values that wait to be written to the
+   * mutable disk cache.
+   *
+   * If set to a value larger than `0`, the values are stored in the memory
+   * cache and in a queue of pending writes, and a dedicated thread writes the
+   * queue to the mutable disk cache in batches. Once the queue is full, the
+   * `Put` call that filled it writes the queue. Use `DefaultCache::Flush` to
+   * write all pending values; they are also written when the cache is closed.
+   *
+   * The default value is `0`, which writes every value to the disk cache
+   * immediately.
+   */
+  size_t write_behind_queue_size = 0u;
+
+  /**
+   * @brief Sets the maximum time that a value waits in the write-behind queue
+   * before the queue is written to the mutable disk cache.
+   *
+   * This parameter is used only if `#write_behind_queue_size` is larger than
+   * `0`. The default value is 1 second.
+   */
+  std::chrono::milliseconds write_behind_max_lag = std::chrono::seconds(1);
+
   /**
    * @brief Sets the maximum permissible size of one file in the storage (in
    * bytes).
@@ -109,6 +189,31 @@ struct CORE_API CacheSettings {
    */
   size_t max_file_size = 1024u * 1024u * 2u;
 
+  /**
+   * @brief Sets the maximum throughput of the mutable cache compaction that
+   * starts automatically (in bytes per second).
+   *
+   * The compaction starts once the storage exceeds `#max_disk_storage`. If
+   * set, the key ranges are compacted slice by slice with a pause after each
+   * slice, so that the compaction does not saturate the disk I/O and the
+   * reads are not starved. The default value is `0`, which compacts the whole
+   * storage at once.
+   */
+  uint64_t compaction_rate_limit = 0u;
+
+  /**
+   * @brief Sets the size (in bytes) from which the values of the mutable cache
+   * are stored in separate files.
+   *
+   * The storage keeps a small reference to the file instead of the value, so
+   * the large values are not rewritten by the compaction, and they can be
+   * written in chunks with `KeyValueCache::OpenWriter` while they are
+   * downloaded. The files are read through a memory mapping.
+   *
+   * The default value is `0`, which stores all values in the storage.
+   */
+  uint64_t large_value_threshold = 0u;
+
   /**
    * @brief Sets the upper limit of the memory data cache size (in bytes).
    *
@@ -116,6 +221,44 @@ struct CORE_API CacheSettings {
    */
   size_t max_memory_cache_size = 1024u * 1024u;
 
+  /**
+   * @brief Sets the number of independent shards of the memory data cache.
+   *
+   * Every shard has its own lock and an equal part of `#max_memory_cache_size`
+   * as its budget, and each key is always stored in the same shard. With more
+   * than one shard, memory cache hits are served without locking the whole
+   * cache, so concurrent reads scale with the number of threads. Note that a
+   * value larger than the budget of a single shard is not stored in memory.
+   *
+   * The default value is `1`, which keeps a single memory cache guarded by the
+   * cache lock.
+   */
+  size_t memory_cache_shards = 1u;
+
+  /**
+   * @brief Sets the admission policy of the memory data cache.
+   *
+   * With `AdmissionPolicy::kTinyLfu`, the recent access frequency of keys is
+   * estimated, and a new key that would evict the least recently used item is
+   * only stored in memory if it is accessed more often than that item. This
+   * keeps the frequently used data, like catalog and partition metadata, in
+   * memory while large amounts of tiles are prefetched.
+   *
+   * The default value is `AdmissionPolicy::kNone`, which is a pure LRU.
+   */
+  AdmissionPolicy memory_cache_admission = AdmissionPolicy::kNone;
+
+  /**
+   * @brief Sets the memory budget that shrinks the memory data cache.
+   *
+   * Under moderate memory pressure, the memory cache is shrunk to a quarter of
+   * `#max_memory_cache_size`, and under critical pressure it is cleared. The
+   * size is restored once the pressure is gone.
+   *
+   * The default value is `nullptr`, which keeps the memory cache size.
+   */
+  std::shared_ptr<client::MemoryBudget> memory_budget = nullptr;
+
   /**
    * @brief Sets the disk cache open options.
    */
@@ -131,6 +274,64 @@ struct CORE_API CacheSettings {
    */
   EvictionPolicy eviction_policy = EvictionPolicy::kLeastRecentlyUsed;
 
+  /**
+   * @brief Sets the flag to run the mutable cache eviction on a dedicated
+   * thread.
+   *
+   * If enabled, the `Put` call that fills the mutable cache above
+   * `#eviction_high_watermark` only wakes up the eviction thread, which then
+   * evicts the data portion by portion and releases the cache between the
+   * portions. The mutable cache might exceed the watermark until the eviction
+   * catches up. `DefaultCache::Size(uint64_t)` still evicts immediately.
+   *
+   * The default value is `false`, which evicts the data in the `Put` call.
+   */
+  bool background_eviction = false;
+
+  /**
+   * @brief Sets the fraction of `#max_disk_storage` that starts the eviction.
+   *
+   * The default value is `0.9`.
+   */
+  float eviction_high_watermark = 0.9f;
+
+  /**
+   * @brief Sets the fraction of `#max_disk_storage` that the eviction
+   * reduces the mutable cache to.
+   *
+   * The value is expected to be lower than `#eviction_high_watermark`. The
+   * default value is `0.85`.
+   */
+  float eviction_low_watermark = 0.85f;
+
+  /**
+   * @brief Sets the size quotas of key prefixes in the mutable cache.
+   *
+   * Every entry maps a key prefix, for example, a catalog HRN or
+   * `hrn::layer::`, to the maximum size in bytes that the keys with this
+   * prefix may take. A key is charged to the quota with the longest matching
+   * prefix. If a quota fills above `#eviction_high_watermark`, the least
+   * recently used keys of this quota are evicted down to
+   * `#eviction_low_watermark`, independently of the other data. This bounds
+   * the space taken by the volatile data and keeps the rest resident.
+   *
+   * The quotas only apply to the least recently used keys of the mutable
+   * cache, so they have no effect if `#max_disk_storage` is set to -1 or the
+   * eviction policy is `EvictionPolicy::kNone`. Protected keys are not
+   * charged. The default value is empty, which only applies
+   * `#max_disk_storage`.
+   */
+  std::map<std::string, uint64_t> prefix_quotas;
+
+  /**
+   * @brief Sets the flag to collect the cache metrics.
+   *
+   * If enabled, `DefaultCache::GetMetrics` returns the hit, miss, and size
+   * counters of every cache tier and the latency of `Get` and `Put`. The
+   * default value is `false`, which leaves all the metrics at zero.
+   */
+  bool collect_metrics = false;
+
   /**
    * @brief This flag sets the compression policy to be applied on the database.
    *
@@ -145,6 +346,23 @@ struct CORE_API CacheSettings {
    */
   CompressionType compression = CompressionType::kDefaultCompression;
 
+  /**
+   * @brief Sets the codecs that encode values before they are written to the
+   * mutable disk cache.
+   *
+   * Every entry maps a key pattern to a codec. A value is encoded with the
+   * codec of the first pattern that its key contains, for example,
+   * `::partition` or `::Data`. Set the codec to `nullptr` to store the values
+   * of the matching keys as is. The values of the keys that match no pattern
+   * are also stored as is.
+   *
+   * Values are decoded based on their header, so all codecs that were used to
+   * write a database must be configured to read it. The codecs can be
+   * combined with `#compression`, but it is usually worth disabling it for
+   * the values that are already compressed.
+   */
+  std::vector<std::pair<std::string, std::shared_ptr<CacheCodec>>> codecs;
+
   /**
    * @brief The path to the protected (read-only) cache.
    *
@@ -155,6 +373,49 @@ struct CORE_API CacheSettings {
    * the network state.
    */
   boost::optional<std::string> disk_path_protected = boost::none;
+
+  /**
+   * @brief The path to the mutable disk cache of another process that is read
+   * after the own caches.
+   *
+   * Several processes can share the data of one disk cache: one process opens
+   * the directory as its `disk_path_mutable` and writes to it, and the other
+   * processes set it as `disk_path_shared`. They read it without the storage
+   * lock, so they do not download and store the data that the writing process
+   * already has. The data that they download themselves is stored only in
+   * their own caches.
+   *
+   * The storage files of the shared cache change when the writing process
+   * writes to it, so the reading processes check it for changes at most once
+   * per `#shared_cache_refresh_interval`, and replace their view with a new one
+   * once it has changed. The reads are not blocked by the replacement.
+   *
+   * The processes can also share a memory-mapped protected cache: it is
+   * immutable, so any number of them can set it as `disk_path_protected`.
+   */
+  boost::optional<std::string> disk_path_shared = boost::none;
+
+  /**
+   * @brief Sets how often the cache set as `#disk_path_shared` is checked for
+   * the changes of the writing process.
+   *
+   * The default value is 1 second.
+   */
+  std::chrono::milliseconds shared_cache_refresh_interval =
+      std::chrono::seconds(1);
+
+  /**
+   * @brief Sets the lookup performance settings of the mutable disk cache.
+   */
+  DiskCacheTuning mutable_cache_tuning;
+
+  /**
+   * @brief Sets the lookup performance settings of the protected disk cache.
+   *
+   * As the protected cache is read-only, the block size is used only by the
+   * tools that create it.
+   */
+  DiskCacheTuning protected_cache_tuning;
 };
 
 #else
@@ -19,11 +19,14 @@
 
 #pragma once
 
+#include <chrono>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
 
 #include <olp/core/Config.h>
+#include "CacheMetrics.h"
 #include "CacheSettings.h"
 #include "KeyValueCache.h"
 
@@ -65,6 +68,36 @@ class CORE_API DefaultCache : public KeyValueCache {
     NotReady             /*!< The DefaultCache is closed. */
   };
 
+  /**
+   * @brief The mutable cache eviction statistics.
+   */
+  struct EvictionStatistics {
+    /// The number of evicted values.
+    uint64_t evicted_items{0u};
+    /// The evicted data size in bytes.
+    uint64_t evicted_bytes{0u};
+    /// The total time spent in the eviction.
+    std::chrono::milliseconds eviction_time{0};
+  };
+
+  /**
+   * @brief The result of the scheduled mutable cache compaction.
+   */
+  struct CompactionStatistics {
+    /// The number of compacted key ranges.
+    uint64_t compacted_ranges{0u};
+    /// The size of the compacted keys and values in bytes.
+    uint64_t compacted_bytes{0u};
+    /// The approximate storage size before the compaction in bytes.
+    uint64_t size_before{0u};
+    /// The approximate storage size after the compaction in bytes.
+    uint64_t size_after{0u};
+    /// The disk space reclaimed by the compaction in bytes.
+    uint64_t reclaimed_bytes{0u};
+    /// The total time spent in the compaction.
+    std::chrono::milliseconds compaction_time{0};
+  };
+
   /**
    * @brief The cache type.
    */
@@ -143,6 +176,132 @@ class CORE_API DefaultCache : public KeyValueCache {
    */
   void Compact();
 
+  /**
+   * @brief Asynchronously compacts the mutable cache storage in slices.
+   *
+   * Unlike `Compact`, the key ranges are compacted one by one on a dedicated
+   * thread without the cache lock, so the other operations continue in
+   * parallel. The thread waits after each slice to keep the compaction
+   * throughput below `bytes_per_second`. A new call stops the compaction that
+   * is still running, and so do `Clear` and closing the mutable cache, in
+   * which case the future holds the statistics of the compacted part.
+   *
+   * @param bytes_per_second The maximum number of compacted bytes per second,
+   * or `0` to compact as fast as possible.
+   *
+   * @return The future with the `CompactionStatistics` instance.
+   */
+  std::future<CompactionStatistics> ScheduleCompaction(
+      uint64_t bytes_per_second = 0u);
+
+  /**
+   * @brief Writes all values pending in the write-behind queue to the mutable
+   * cache.
+   *
+   * The values are pending only if `CacheSettings::write_behind_queue_size` is
+   * set. When this method returns, all values that were put before the call
+   * are written to the disk.
+   *
+   * @return True if the operation is successful; false otherwise.
+   */
+  bool Flush();
+
+  /**
+   * @brief Gets the eviction statistics of the mutable cache since the cache
+   * was created.
+   *
+   * @return The `EvictionStatistics` instance.
+   */
+  EvictionStatistics GetEvictionStatistics() const;
+
+  /**
+   * @brief Gets a snapshot of the cache metrics.
+   *
+   * The metrics are collected only if `CacheSettings::collect_metrics` is
+   * enabled.
+   *
+   * @return The `CacheMetrics` instance.
+   */
+  CacheMetrics GetMetrics() const;
+
+  /**
+   * @brief Sets all the cache metrics to zero.
+   */
+  void ResetMetrics();
+
+  /**
+   * @brief Exports the content of the mutable cache to a memory-mapped
+   * protected cache.
+   *
+   * The exported cache is a single immutable file that is mapped into memory
+   * when `path` is opened as `CacheSettings::disk_path_protected`. It is
+   * opened without the leveldb manifest replay, and its values are read
+   * without a copy by `GetView`. A protected cache directory that contains an
+   * exported file is always opened in this format.
+   *
+   * @param path The directory to write the protected cache to.
+   *
+   * @return True if the operation is successful; false otherwise.
+   */
+  bool ExportToProtectedCache(const std::string& path);
+
+  /**
+   * @brief Writes the difference between two exported protected caches.
+   *
+   * The delta holds the added, changed and removed keys only, so shipping it
+   * is much smaller than shipping the whole new cache. It is applied with
+   * `ApplyProtectedCacheDelta` to a cache that equals `base_path`.
+   *
+   * @param base_path The directory of the exported cache to update.
+   * @param target_path The directory of the exported updated cache.
+   * @param delta_path The path of the delta file to write.
+   *
+   * @return True if the operation is successful; false otherwise.
+   */
+  static bool CreateProtectedCacheDelta(const std::string& base_path,
+                                        const std::string& target_path,
+                                        const std::string& delta_path);
+
+  /**
+   * @brief Updates the memory-mapped protected cache with a delta.
+   *
+   * The updated cache is built next to the current one from the current
+   * cache and the delta, with sequential reads and writes, and is verified
+   * before it replaces the current one. Meanwhile, the reads are served from
+   * the current cache, and then the cache switches to the updated one
+   * atomically. The views returned before keep the previous cache mapped.
+   *
+   * @param delta_path The path of the delta created with
+   * `CreateProtectedCacheDelta`.
+   *
+   * @return True if the operation is successful; false if the protected cache
+   * is not a memory-mapped one or the delta is not for it, in which case the
+   * cache is not changed.
+   */
+  bool ApplyProtectedCacheDelta(const std::string& delta_path);
+
+  /**
+   * @brief Asynchronously loads the values with the given key prefixes from
+   * the disk caches into the memory cache.
+   *
+   * Call it right after `Open` to preload the data that is needed first, like
+   * the latest catalog version or the layer configurations. The keys are read
+   * in order without filling the leveldb block cache, and the values are
+   * stored in the memory cache until `byte_budget` is reached. A new call
+   * stops the warm-up that is still running, and so does `Close`.
+   *
+   * @param prefixes The key prefixes to load. An exact key is a prefix too.
+   * @param byte_budget The maximum size of the loaded values in bytes.
+   * @param decoder The decoder that `Get` uses for these keys, so that the
+   * memory cache holds the decoded values. Use `nullptr` for keys that are
+   * read as binary data.
+   *
+   * @return The future with the size of the loaded values in bytes.
+   */
+  std::future<uint64_t> WarmUp(const KeyListType& prefixes,
+                               uint64_t byte_budget,
+                               const Decoder& decoder = nullptr);
+
   /**
    * @brief Stores the key-value pair in the cache.
    *
@@ -187,6 +346,86 @@ class CORE_API DefaultCache : public KeyValueCache {
    */
   KeyValueCache::ValueTypePtr Get(const std::string& key) override;
 
+  /**
+   * @brief Gets a read-only view on the binary data from the cache.
+   *
+   * The value read from the disk cache is shared with the caller without
+   * copying it. Such values are not added to the memory cache, which makes
+   * this method a good fit for large values that are consumed once.
+   *
+   * @param key The key that is used to look for the binary data.
+   *
+   * @return The view on the binary data, or an empty view if the key is not
+   * found.
+   */
+  KeyValueCache::ValueView GetView(const std::string& key) override;
+
+  /**
+   * @brief Creates a writer that stores the binary data in chunks.
+   *
+   * If `CacheSettings::large_value_threshold` is set, the chunks are written
+   * to a separate file of the mutable cache as they come, and the value is
+   * not added to the memory cache. Otherwise, the chunks are collected and
+   * stored with `Put` on commit.
+   *
+   * @param key The key for the binary data.
+   * @param expiry The expiry time (in seconds) of the key-value pair.
+   *
+   * @return The writer of the value.
+   */
+  std::unique_ptr<ValueWriter> OpenWriter(
+      const std::string& key, time_t expiry = kDefaultExpiry) override;
+
+  /**
+   * @brief Stores the list of key and binary data pairs in the cache.
+   *
+   * The lock is taken once, and all values are written to the mutable disk
+   * cache with a single write batch.
+   *
+   * @param items The list of keys and binary data that should be stored.
+   * @param expiry The expiry time (in seconds) of all key-value pairs.
+   *
+   * @return True if all values are stored; false otherwise.
+   */
+  bool PutBatch(const KeyValueListType& items,
+                time_t expiry = kDefaultExpiry) override;
+
+  /**
+   * @brief Stores the list of keys and values of any type in the cache.
+   *
+   * The lock is taken once, and all values are written to the mutable disk
+   * cache with a single write batch.
+   *
+   * @param items The list of keys, values, and their encoders.
+   * @param expiry The expiry time (in seconds) of all key-value pairs.
+   *
+   * @return True if all values are stored; false otherwise.
+   */
+  bool PutBatch(const KeyEncodedValueListType& items,
+                time_t expiry = kDefaultExpiry) override;
+
+  /**
+   * @brief Gets the binary data for the list of keys from the cache.
+   *
+   * @param keys The keys that are used to look for the binary data.
+   *
+   * @return The binary data in the order of `keys`, with nullptr for the keys
+   * that are not found.
+   */
+  std::vector<ValueTypePtr> GetBatch(const KeyListType& keys) override;
+
+  /**
+   * @brief Gets the values for the list of keys from the cache.
+   *
+   * @param keys The keys that are used to look for the values.
+   * @param decoder Decodes the values from a string.
+   *
+   * @return The values in the order of `keys`, with empty values for the keys
+   * that are not found.
+   */
+  std::vector<boost::any> GetBatch(const KeyListType& keys,
+                                   const Decoder& decoder) override;
+
   /**
    * @brief Removes the key-value pair from the cache.
    *
@@ -215,6 +454,17 @@ class CORE_API DefaultCache : public KeyValueCache {
    */
   bool Contains(const std::string& key) const override;
 
+  /**
+   * @brief Checks if the keys are in the cache.
+   *
+   * Takes the cache lock once for all the keys.
+   *
+   * @param keys The keys to check.
+   *
+   * @return The flags in the order of `keys`, true for the cached keys.
+   */
+  std::vector<bool> ContainsBatch(const KeyListType& keys) const override;
+
   /**
    * @brief Protects keys from eviction.
    *
@@ -24,6 +24,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <olp/core/CoreApi.h>
@@ -63,6 +64,116 @@ class CORE_API KeyValueCache {
    */
   using KeyListType = std::vector<std::string>;
 
+  /**
+   * @brief Alias for the list of keys and binary data used by the batch
+   * operations.
+   */
+  using KeyValueListType = std::vector<std::pair<std::string, ValueTypePtr>>;
+
+  /**
+   * @brief A value of any type together with the encoder that encodes it
+   * into a string.
+   */
+  struct EncodedValue {
+    /// The value of any type.
+    boost::any value;
+    /// Encodes the value into a string.
+    Encoder encoder;
+  };
+
+  /**
+   * @brief Alias for the list of keys and encodable values used by the batch
+   * operations.
+   */
+  using KeyEncodedValueListType =
+      std::vector<std::pair<std::string, EncodedValue>>;
+
+  /**
+   * @brief A read-only view on the binary data stored in the cache.
+   *
+   * The view shares the ownership of the buffer that holds the data, so
+   * the data stays valid as long as the view or any of its copies exists.
+   * Depending on the cache implementation, the buffer can be the one the value
+   * was read into by the storage, which avoids copying the value.
+   */
+  class ValueView {
+   public:
+    ValueView() = default;
+
+    /**
+     * @brief Creates a view on the data owned by the `owner` buffer.
+     *
+     * @param owner The buffer that holds the data.
+     * @param data The pointer to the first byte of the data.
+     * @param size The size of the data.
+     */
+    ValueView(std::shared_ptr<const void> owner, const unsigned char* data,
+              size_t size)
+        : owner_(std::move(owner)), data_(data), size_(size) {}
+
+    /**
+     * @brief Creates a view on the whole value.
+     *
+     * @param value The value to share.
+     */
+    explicit ValueView(ValueTypePtr value)
+        : data_(value ? value->data() : nullptr),
+          size_(value ? value->size() : 0u) {
+      owner_ = std::move(value);
+    }
+
+    /// Gets the pointer to the first byte of the data.
+    const unsigned char* data() const { return data_; }
+
+    /// Gets the size of the data.
+    size_t size() const { return size_; }
+
+    /// Checks if the view has no data.
+    bool empty() const { return size_ == 0u; }
+
+    /// Checks if the view references a value.
+    explicit operator bool() const { return owner_ != nullptr; }
+
+    /// Copies the data into a new value.
+    ValueTypePtr ToValue() const {
+      return owner_ ? std::make_shared<ValueType>(data_, data_ + size_)
+                    : nullptr;
+    }
+
+   private:
+    std::shared_ptr<const void> owner_;
+    const unsigned char* data_{nullptr};
+    size_t size_{0u};
+  };
+
+  /**
+   * @brief Writes a value to the cache in chunks.
+   *
+   * The value is stored on `Commit`. It is discarded if the writer is
+   * destroyed before.
+   */
+  class ValueWriter {
+   public:
+    virtual ~ValueWriter() = default;
+
+    /**
+     * @brief Appends the chunk to the value.
+     *
+     * @param data The pointer to the first byte of the chunk.
+     * @param size The size of the chunk.
+     *
+     * @return True if the chunk is written; false otherwise.
+     */
+    virtual bool Append(const unsigned char* data, size_t size) = 0;
+
+    /**
+     * @brief Stores the value.
+     *
+     * @return True if the value is stored; false otherwise.
+     */
+    virtual bool Commit() = 0;
+  };
+
   virtual ~KeyValueCache() = default;
 
   /**
@@ -109,6 +220,144 @@ class CORE_API KeyValueCache {
    */
   virtual ValueTypePtr Get(const std::string& key) = 0;
 
+  /**
+   * @brief Gets a read-only view on the binary data from the cache.
+   *
+   * Unlike `Get`, the implementation may avoid copying the value by sharing
+   * the buffer it was read into. The default implementation wraps the result
+   * of `Get`.
+   *
+   * @param key The key that is used to look for the binary data.
+   *
+   * @return The view on the binary data, or an empty view if the key is not
+   * found.
+   */
+  virtual ValueView GetView(const std::string& key) {
+    return ValueView(Get(key));
+  }
+
+  /**
+   * @brief Creates a writer that stores the binary data in chunks.
+   *
+   * The implementation may write the chunks to the storage as they come,
+   * without holding the whole value in memory. The default implementation
+   * collects the chunks and calls `Put` on commit. The writer must not
+   * outlive the cache.
+   *
+   * @param key The key for the binary data.
+   * @param expiry The expiry time (in seconds) of the key-value pair.
+   *
+   * @return The writer of the value.
+   */
+  virtual std::unique_ptr<ValueWriter> OpenWriter(
+      const std::string& key, time_t expiry = kDefaultExpiry) {
+    class BufferedWriter final : public ValueWriter {
+     public:
+      BufferedWriter(KeyValueCache& cache, std::string key, time_t expiry)
+          : cache_(cache),
+            key_(std::move(key)),
+            expiry_(expiry),
+            value_(std::make_shared<ValueType>()) {}
+
+      bool Append(const unsigned char* data, size_t size) override {
+        value_->insert(value_->end(), data, data + size);
+        return true;
+      }
+
+      bool Commit() override { return cache_.Put(key_, value_, expiry_); }
+
+     private:
+      KeyValueCache& cache_;
+      std::string key_;
+      time_t expiry_;
+      ValueTypePtr value_;
+    };
+
+    return std::unique_ptr<ValueWriter>(new BufferedWriter(*this, key, expiry));
+  }
+
+  /**
+   * @brief Stores the list of key and binary data pairs in the cache.
+   *
+   * The implementation may store all values with a single storage write. The
+   * default implementation calls `Put` for each pair.
+   *
+   * @param items The list of keys and binary data that should be stored.
+   * @param expiry The expiry time (in seconds) of all key-value pairs.
+   *
+   * @return True if all values are stored; false otherwise.
+   */
+  virtual bool PutBatch(const KeyValueListType& items,
+                        time_t expiry = kDefaultExpiry) {
+    bool result = true;
+    for (const auto& item : items) {
+      result = Put(item.first, item.second, expiry) && result;
+    }
+    return result;
+  }
+
+  /**
+   * @brief Stores the list of keys and values of any type in the cache.
+   *
+   * The implementation may store all values with a single storage write. The
+   * default implementation calls `Put` for each item.
+   *
+   * @param items The list of keys, values, and their encoders.
+   * @param expiry The expiry time (in seconds) of all key-value pairs.
+   *
+   * @return True if all values are stored; false otherwise.
+   */
+  virtual bool PutBatch(const KeyEncodedValueListType& items,
+                        time_t expiry = kDefaultExpiry) {
+    bool result = true;
+    for (const auto& item : items) {
+      result = Put(item.first, item.second.value, item.second.encoder,
+                   expiry) &&
+               result;
+    }
+    return result;
+  }
+
+  /**
+   * @brief Gets the binary data for the list of keys from the cache.
+   *
+   * The default implementation calls `Get` for each key.
+   *
+   * @param keys The keys that are used to look for the binary data.
+   *
+   * @return The binary data in the order of `keys`, with nullptr for the keys
+   * that are not found.
+   */
+  virtual std::vector<ValueTypePtr> GetBatch(const KeyListType& keys) {
+    std::vector<ValueTypePtr> values;
+    values.reserve(keys.size());
+    for (const auto& key : keys) {
+      values.push_back(Get(key));
+    }
+    return values;
+  }
+
+  /**
+   * @brief Gets the values for the list of keys from the cache.
+   *
+   * The default implementation calls `Get` for each key.
+   *
+   * @param keys The keys that are used to look for the values.
+   * @param decoder Decodes the values from a string.
+   *
+   * @return The values in the order of `keys`, with empty values for the keys
+   * that are not found.
+   */
+  virtual std::vector<boost::any> GetBatch(const KeyListType& keys,
+                                           const Decoder& decoder) {
+    std::vector<boost::any> values;
+    values.reserve(keys.size());
+    for (const auto& key : keys) {
+      values.push_back(Get(key, decoder));
+    }
+    return values;
+  }
+
   /**
    * @brief Removes the key-value pair from the cache.
    *
@@ -140,6 +389,24 @@ class CORE_API KeyValueCache {
     return false;
   }
 
+  /**
+   * @brief Checks if the keys are in the cache.
+   *
+   * The default implementation calls `Contains` for each key.
+   *
+   * @param keys The keys to check.
+   *
+   * @return The flags in the order of `keys`, true for the cached keys.
+   */
+  virtual std::vector<bool> ContainsBatch(const KeyListType& keys) const {
+    std::vector<bool> result;
+    result.reserve(keys.size());
+    for (const auto& key : keys) {
+      result.push_back(Contains(key));
+    }
+    return result;
+  }
+
   /**
    * @brief Protects keys from eviction.
    *
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace cache {
+
+/**
+ * @brief Sets the cost of fetching again the values put to the cache on the
+ * current thread while the scope is alive.
+ *
+ * The cost is the time it took to download the value. `DefaultCache` with
+ * the `EvictionPolicy::kCostAware` eviction policy keeps the values that are
+ * expensive to fetch again longer than the ones that are cheap. The scopes
+ * can be nested, the innermost cost applies. The previous cost is restored on
+ * destruction.
+ */
+class CORE_API RefetchCostScope final {
+ public:
+  /**
+   * @brief Sets the re-fetch cost of the current thread.
+   *
+   * @param[in] cost The time it took to download the values.
+   */
+  explicit RefetchCostScope(std::chrono::milliseconds cost);
+
+  /**
+   * @brief Restores the previous re-fetch cost of the current thread.
+   */
+  ~RefetchCostScope();
+
+  RefetchCostScope(const RefetchCostScope&) = delete;
+  RefetchCostScope& operator=(const RefetchCostScope&) = delete;
+
+  /**
+   * @brief Gets the re-fetch cost of the current thread.
+   *
+   * @return The cost of the innermost scope, or zero if there is none and the
+   * cost is unknown.
+   */
+  static std::chrono::milliseconds GetCurrentCost();
+
+ private:
+  std::chrono::milliseconds previous_cost_;
+};
+
+}  // namespace cache
+}  // namespace olp
@@ -30,6 +30,7 @@
 #include <olp/core/client/HRN.h>
 #include <olp/core/client/OlpClient.h>
 #include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/client/model/Api.h>
 
 namespace olp {
 namespace client {
@@ -43,6 +44,8 @@ class CORE_API ApiLookupClient final {
   /// Alias for the parameters and responses.
   using LookupApiResponse = ApiResponse<OlpClient, ApiError>;
   using LookupApiCallback = std::function<void(LookupApiResponse)>;
+  using LookupAllResponse = ApiResponse<Apis, ApiError>;
+  using LookupAllCallback = std::function<void(LookupAllResponse)>;
 
   explicit ApiLookupClient(const HRN& catalog,
                            const OlpClientSettings& settings);
@@ -91,6 +94,41 @@ class CORE_API ApiLookupClient final {
                               const std::string& service_version,
                               FetchOptions options, LookupApiCallback callback);
 
+  /**
+   * @brief Gets the APIs of all the services of the catalog sync with one
+   * request.
+   *
+   * The services are stored in the `cache` of the `OlpClientSettings`
+   * instance and in the client, so the following `LookupApi` calls do not
+   * need the network. Call it at startup for the catalogs that are read
+   * first, and share the cache with the layer clients to remove the lookup
+   * round trips from the first requests. The platform APIs, like `config`,
+   * are not included.
+   *
+   * @param context The `CancellationContext` instance that is used to cancel
+   * the request.
+   *
+   * @note If the catalog endpoint provider provides a static URL for this
+   * catalog, no request is sent, and the response contains no APIs.
+   *
+   * @return `LookupAllResponse` that contains the APIs of the catalog or an
+   * error.
+   */
+  LookupAllResponse LookupAll(CancellationContext context);
+
+  /**
+   * @brief Gets the APIs of all the services of the catalog async with one
+   * request.
+   *
+   * @param callback The function callback used to receive the
+   * `LookupAllResponse` instance.
+   *
+   * @see `LookupAll(CancellationContext)` for more details.
+   *
+   * @return The method used to call or to cancel the request.
+   */
+  CancellationToken LookupAll(LookupAllCallback callback);
+
  private:
   std::shared_ptr<ApiLookupClientImpl> impl_;
 };
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <olp/core/Config.h>
+
+#if defined(OLP_SDK_ENABLE_COROUTINES) && defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <olp/core/client/ApiError.h>
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/CancellationToken.h>
+#include <olp/core/thread/TaskScheduler.h>
+
+namespace olp {
+namespace client {
+
+/**
+ * @brief Awaits the response of an asynchronous SDK call in a C++20
+ * coroutine.
+ *
+ * The call is started when the awaitable is awaited, and the coroutine is
+ * resumed on the task scheduler when the callback is called, so no thread is
+ * blocked while the call is in progress. Cancel the call with the
+ * `CancellationContext` instance; the coroutine is then resumed with the
+ * `ErrorCode::Cancelled` error.
+ *
+ * Available when the SDK is built with `OLP_SDK_ENABLE_COROUTINES` and the
+ * code using it is compiled as C++20.
+ *
+ * @tparam ResponseType The `ApiResponse` type of the call.
+ */
+template <typename ResponseType>
+class Awaitable {
+ public:
+  /// Alias for the callback of the call.
+  using Callback = std::function<void(ResponseType)>;
+  /// Alias for the function that starts the call with the callback.
+  using StartFunc = std::function<CancellationToken(Callback)>;
+
+  /**
+   * @brief Creates the `Awaitable` instance.
+   *
+   * @param start The function that starts the call.
+   * @param task_scheduler The task scheduler that resumes the coroutine, or
+   * nullptr to resume it on the thread that calls the callback.
+   * @param context The context that cancels the call.
+   */
+  Awaitable(StartFunc start,
+            std::shared_ptr<thread::TaskScheduler> task_scheduler,
+            CancellationContext context = CancellationContext())
+      : start_(std::move(start)),
+        task_scheduler_(std::move(task_scheduler)),
+        context_(std::move(context)),
+        state_(std::make_shared<State>()) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    auto state = state_;
+    state->handle = handle;
+    auto task_scheduler = task_scheduler_;
+
+    auto callback = [state, task_scheduler](ResponseType response) {
+      state->response.emplace(std::move(response));
+      // The callback may come before `await_suspend` returns, then the
+      // coroutine is not suspended and continues on its own.
+      if (state->completed.exchange(true)) {
+        Resume(state, task_scheduler);
+      }
+    };
+
+    auto start = start_;
+    context_.ExecuteOrCancelled(
+        [&]() { return start(callback); },
+        [&]() { callback(ResponseType(ApiError::Cancelled())); });
+
+    return !state->completed.exchange(true);
+  }
+
+  ResponseType await_resume() { return std::move(*state_->response); }
+
+ private:
+  struct State {
+    std::coroutine_handle<> handle;
+    std::optional<ResponseType> response;
+    std::atomic<bool> completed{false};
+  };
+
+  static void Resume(
+      const std::shared_ptr<State>& state,
+      const std::shared_ptr<thread::TaskScheduler>& task_scheduler) {
+    if (!task_scheduler) {
+      state->handle.resume();
+      return;
+    }
+
+    auto handle = state->handle;
+    task_scheduler->ScheduleTask([handle]() { handle.resume(); });
+  }
+
+  StartFunc start_;
+  std::shared_ptr<thread::TaskScheduler> task_scheduler_;
+  CancellationContext context_;
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace client
+}  // namespace olp
+
+#endif  // OLP_SDK_ENABLE_COROUTINES && __cpp_impl_coroutine
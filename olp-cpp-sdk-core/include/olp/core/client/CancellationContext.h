@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -33,7 +34,9 @@ namespace client {
  * @brief A wrapper that manages the cancellation state of an asynchronous
  * operation in a thread-safe way.
  *
- * All public APIs are thread-safe.
+ * All public APIs are thread-safe. `IsCancelled()` and the calls of
+ * `ExecuteOrCancelled()` without an operation function do not lock, so they
+ * are cheap enough to be called at every step of a short operation.
  *
  * This class is both movable and copyable.
  */
@@ -102,8 +105,10 @@ class CORE_API CancellationContext {
     CancellationToken sub_operation_cancel_token_{};
     /**
      * @brief The flag that is set to `true` for `CancelOperation()`.
+     *
+     * It is only set while `mutex_` is held, but can be read without it.
      */
-    bool is_cancelled_{false};
+    std::atomic<bool> is_cancelled_{false};
   };
 
   /**
@@ -32,20 +32,23 @@ inline bool CancellationContext::ExecuteOrCancelled(
     return true;
   }
 
-  std::lock_guard<std::recursive_mutex> lock(impl_->mutex_);
+  // The cancellation is final, so the flag is checked without the lock first.
+  if (!impl_->is_cancelled_.load(std::memory_order_acquire)) {
+    if (!execute_fn) {
+      return true;
+    }
 
-  if (impl_->is_cancelled_) {
-    if (cancel_fn) {
-      cancel_fn();
+    std::lock_guard<std::recursive_mutex> lock(impl_->mutex_);
+    if (!impl_->is_cancelled_.load(std::memory_order_relaxed)) {
+      impl_->sub_operation_cancel_token_ = execute_fn();
+      return true;
     }
-    return false;
   }
 
-  if (execute_fn) {
-    impl_->sub_operation_cancel_token_ = execute_fn();
+  if (cancel_fn) {
+    cancel_fn();
   }
-
-  return true;
+  return false;
 }
 
 inline void CancellationContext::CancelOperation() {
@@ -54,13 +57,13 @@ inline void CancellationContext::CancelOperation() {
   }
 
   std::lock_guard<std::recursive_mutex> lock(impl_->mutex_);
-  if (impl_->is_cancelled_) {
+  if (impl_->is_cancelled_.load(std::memory_order_relaxed)) {
     return;
   }
 
+  impl_->is_cancelled_.store(true, std::memory_order_release);
   impl_->sub_operation_cancel_token_.Cancel();
   impl_->sub_operation_cancel_token_ = CancellationToken();
-  impl_->is_cancelled_ = true;
 }
 
 inline bool CancellationContext::IsCancelled() const {
@@ -68,8 +71,7 @@ inline bool CancellationContext::IsCancelled() const {
     return false;
   }
 
-  std::lock_guard<std::recursive_mutex> lock(impl_->mutex_);
-  return impl_->is_cancelled_;
+  return impl_->is_cancelled_.load(std::memory_order_acquire);
 }
 
 inline size_t CancellationContextHash::operator()(
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace client {
+
+/**
+ * @brief Sets the deadline of the requests sent on the current thread while
+ * the scope is alive.
+ *
+ * `OlpClient` does not wait for a response or retry a request after the
+ * deadline, so all the stages of an operation, such as the API lookup, the
+ * metadata and the data requests, finish by the same deadline. The scopes can
+ * be nested, the earliest deadline applies. The previous deadline is restored
+ * on destruction.
+ */
+class CORE_API DeadlineScope final {
+ public:
+  /// The clock of the deadlines.
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Sets the deadline of the current thread.
+   *
+   * @param[in] deadline The deadline, it is ignored if a previous scope has
+   * an earlier one.
+   */
+  explicit DeadlineScope(Clock::time_point deadline);
+
+  /**
+   * @brief Restores the previous deadline of the current thread.
+   */
+  ~DeadlineScope();
+
+  DeadlineScope(const DeadlineScope&) = delete;
+  DeadlineScope& operator=(const DeadlineScope&) = delete;
+
+  /**
+   * @brief Gets the deadline of the current thread.
+   *
+   * @return The earliest deadline of the scopes, or `Clock::time_point::max()`
+   * if there is none.
+   */
+  static Clock::time_point GetCurrentDeadline();
+
+ private:
+  Clock::time_point previous_deadline_;
+};
+
+}  // namespace client
+}  // namespace olp
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -124,6 +126,8 @@ class CORE_API HRN {
    *
    * Example: `hrn:partition:service:region:account:resource`
    *
+   * The string is built once when the HRN is parsed.
+   *
    * @return The `HRN` string that has the `hrn:` prefix.
    */
   std::string ToString() const;
@@ -131,12 +135,24 @@ class CORE_API HRN {
   /**
    * @brief Converts this HRN to a string catalog ID.
    *
+   * The string is built once when the HRN is parsed.
+   *
    * @note Only relevant if the HRN has `ServiceType == Data`.
    *
    * @return The catalog ID that has the `hrn:` prefix.
    */
   std::string ToCatalogHRNString() const;
 
+  /**
+   * @brief Returns the hash of this HRN.
+   *
+   * The hash is computed once when the HRN is parsed, and the equal HRNs
+   * have the same hash.
+   *
+   * @return The hash of this HRN.
+   */
+  std::size_t GetHash() const { return hash_; }
+
   /**
    * @brief Returns the partitions of this HRN.
    *
@@ -217,6 +233,12 @@ class CORE_API HRN {
   const std::string& GetPipelineId() const { return pipeline_id_; }
 
  private:
+  /// Parses the fields of the HRN from the string.
+  void Parse(const std::string& input);
+
+  /// Builds the string form of the HRN from its fields.
+  std::string BuildString() const;
+
   /// The partition of the HRN. Must be valid when `ServiceType == Data` or when
   /// `ServiceType == Pipeline`.
   std::string partition_;
@@ -248,7 +270,33 @@ class CORE_API HRN {
   /// The pipeline ID. Valid if `HRNServiceType == Pipeline`. Must be valid if
   /// `ServiceType == Schema`.
   std::string pipeline_id_;
+
+  /// The string form of the HRN, or empty if it is not parsed.
+  std::string string_;
+
+  /// The catalog string form of the HRN. Valid if `ServiceType == Data`.
+  std::string catalog_string_;
+
+  /// The hash of the string form of the HRN.
+  std::size_t hash_{0u};
 };
 
 }  // namespace client
 }  // namespace olp
+
+namespace std {
+
+///@brief The specialization of `std::hash`.
+template <>
+struct hash<olp::client::HRN> {
+  /**
+   * @brief The hash function for HRNs.
+   *
+   * Uses the precomputed hash (`HRN::GetHash()`).
+   */
+  std::size_t operator()(const olp::client::HRN& hrn) const {
+    return hrn.GetHash();
+  }
+};
+
+}  // namespace std
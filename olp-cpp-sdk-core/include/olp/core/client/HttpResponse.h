@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -117,6 +118,24 @@ class CORE_API HttpResponse {
         response(std::move(response)),
         headers(std::move(headers)) {}
 
+  /**
+   * @brief Creates the `HttpResponse` instance with the body stored in a byte
+   * buffer.
+   *
+   * The buffer is shared with the copies of the response and is not
+   * accessible through the `response` stream.
+   *
+   * @param status The HTTP status.
+   * @param response The response body.
+   * @param headers Response headers.
+   */
+  HttpResponse(int status,
+               std::shared_ptr<std::vector<unsigned char>> response,
+               http::Headers headers)
+      : status(status),
+        headers(std::move(headers)),
+        response_buffer_(std::move(response)) {}
+
   /**
    * @brief Copy constructor.
    *
@@ -126,7 +145,14 @@ class CORE_API HttpResponse {
    * @param other The instance of `HttpStatus` to copy from.
    */
   HttpResponse(const HttpResponse& other)
-      : status(other.status), headers(other.headers) {
+      : status(other.status),
+        headers(other.headers),
+        response_buffer_(other.response_buffer_) {
+    if (response_buffer_) {
+      // The body is in the shared buffer, the stream is empty.
+      return;
+    }
+
     response << other.response.rdbuf();
     if (!response.good()) {
       // Depending on the users handling of the stringstream it might be that
@@ -148,8 +174,11 @@ class CORE_API HttpResponse {
   HttpResponse& operator=(const HttpResponse& other) {
     if (this != &other) {
       status = other.status;
-      response << other.response.rdbuf();
+      if (!other.response_buffer_) {
+        response << other.response.rdbuf();
+      }
       headers = other.headers;
+      response_buffer_ = other.response_buffer_;
     }
 
     return *this;
@@ -165,6 +194,11 @@ class CORE_API HttpResponse {
    * @param output Reference to a vector.
    */
   void GetResponse(std::vector<unsigned char>& output) {
+    if (response_buffer_) {
+      output = *response_buffer_;
+      return;
+    }
+
     response.seekg(0, std::ios::end);
     const auto pos = response.tellg();
     if (pos > 0) {
@@ -180,7 +214,32 @@ class CORE_API HttpResponse {
    *
    * @param output Reference to a string.
    */
-  void GetResponse(std::string& output) { output = response.str(); }
+  void GetResponse(std::string& output) {
+    if (response_buffer_) {
+      output.assign(response_buffer_->begin(), response_buffer_->end());
+      return;
+    }
+
+    output = response.str();
+  }
+
+  /**
+   * @brief Gets the `HttpResponse` content as a byte buffer.
+   *
+   * Does not copy the content if the response was created with a byte
+   * buffer.
+   *
+   * @return The response content.
+   */
+  std::shared_ptr<std::vector<unsigned char>> GetResponseBuffer() {
+    if (response_buffer_) {
+      return response_buffer_;
+    }
+
+    auto output = std::make_shared<std::vector<unsigned char>>();
+    GetResponse(*output);
+    return output;
+  }
 
   /**
    * @brief Return the const reference to the response headers.
@@ -233,6 +292,7 @@ class CORE_API HttpResponse {
 
  private:
   NetworkStatistics network_statistics_;
+  std::shared_ptr<std::vector<unsigned char>> response_buffer_;
 };
 
 }  // namespace client
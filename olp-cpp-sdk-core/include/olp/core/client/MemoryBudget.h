@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace client {
+
+/// The memory pressure reported by `MemoryBudget`.
+enum class MemoryPressure {
+  kNone,      ///< The usage is below 75% of the limit.
+  kModerate,  ///< The usage is at least 75% of the limit.
+  kCritical   ///< The limit is reached or the system is low on memory.
+};
+
+/**
+ * @brief Limits the memory used by all the components that share it.
+ *
+ * The components reserve the memory of their buffers, e.g. the in-flight
+ * response bodies, and register to receive the memory pressure changes. Under
+ * pressure, the prefetch downloads fewer tiles at the same time, the memory
+ * cache is shrunk, and the requests are not hedged.
+ *
+ * Call `OnLowMemory` from the low memory notification of the operating
+ * system to release the memory at once.
+ *
+ * Set the instance to `OlpClientSettings::memory_budget` and
+ * `CacheSettings::memory_budget`.
+ */
+class CORE_API MemoryBudget final {
+ public:
+  /// The identifier of a registered consumer.
+  using ConsumerId = uint64_t;
+
+  /**
+   * @brief Called when the memory pressure changes.
+   *
+   * The callback is called on the thread that changed the usage and must not
+   * reserve or release memory.
+   */
+  using PressureCallback = std::function<void(MemoryPressure)>;
+
+  /**
+   * @brief Creates the `MemoryBudget` instance.
+   *
+   * @param limit The memory limit (in bytes), or 0 to report the pressure
+   * only on `OnLowMemory`.
+   */
+  explicit MemoryBudget(uint64_t limit);
+
+  /// Gets the memory limit (in bytes).
+  uint64_t GetLimit() const;
+
+  /// Gets the reserved memory (in bytes).
+  uint64_t GetUsage() const;
+
+  /// Gets the current memory pressure.
+  MemoryPressure GetPressure() const;
+
+  /**
+   * @brief Reserves memory.
+   *
+   * The memory is always reserved, even above the limit, as the caller
+   * already holds it; the pressure tells the components to use less.
+   *
+   * @param bytes The number of bytes.
+   */
+  void Reserve(uint64_t bytes);
+
+  /**
+   * @brief Releases the reserved memory.
+   *
+   * @param bytes The number of bytes.
+   */
+  void Release(uint64_t bytes);
+
+  /**
+   * @brief Registers a consumer of the memory pressure changes.
+   *
+   * @param callback The callback that receives the new pressure.
+   *
+   * @return The identifier to unregister the consumer.
+   */
+  ConsumerId Register(PressureCallback callback);
+
+  /**
+   * @brief Unregisters the consumer.
+   *
+   * The callback is not called after this method returns.
+   *
+   * @param id The identifier returned by `Register`.
+   */
+  void Unregister(ConsumerId id);
+
+  /**
+   * @brief Notifies the consumers that the system is low on memory.
+   *
+   * The pressure is critical until the usage changes next time.
+   */
+  void OnLowMemory();
+
+ private:
+  MemoryPressure ComputePressure() const;
+  void Update(MemoryPressure pressure, bool force);
+
+  const uint64_t limit_;
+
+  mutable std::mutex mutex_;
+  uint64_t usage_;
+  MemoryPressure pressure_;
+  ConsumerId next_id_;
+  std::map<ConsumerId, PressureCallback> consumers_;
+
+  // Serializes the notifications, so the consumers see the changes in order
+  // and `Unregister` waits for the running callbacks.
+  std::recursive_mutex notify_mutex_;
+};
+
+}  // namespace client
+}  // namespace olp
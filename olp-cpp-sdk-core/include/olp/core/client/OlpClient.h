@@ -28,6 +28,7 @@
 #include <olp/core/CoreApi.h>
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/http/Network.h>
 
 namespace olp {
 namespace client {
@@ -145,6 +146,105 @@ class CORE_API OlpClient {
                        RequestBodyType post_body, std::string content_type,
                        CancellationContext context) const;
 
+  /**
+   * @brief Executes the HTTP request through the network stack in a blocking
+   * way.
+   *
+   * If `buffer_response` is set, the body of a successful response is written
+   * directly into a byte buffer that is reserved from the `Content-Length`
+   * header. The body is then accessible only through the `GetResponse` and
+   * `GetResponseBuffer` methods of `HttpResponse`, and not through the
+   * `response` stream.
+   *
+   * @param path The path that is appended to the base URL.
+   * @param method Select one of the following methods: `GET`, `POST`, `DELETE`,
+   * or `PUT`.
+   * @param query_params The parameters that are appended to the URL path.
+   * @param header_params The headers used to customize the request.
+   * @param form_params For the `POST` request, populate `form_params` or
+   * `post_body`, but not both.
+   * @param post_body For the `POST` request, populate `form_params` or
+   * `post_body`, but not both. This data must not be modified until
+   * the request is completed.
+   * @param content_type The content type for the `post_body` or `form_params`.
+   * @param context The `CancellationContext` instance that is used to cancel
+   * the request.
+   * @param buffer_response Stores the response body in a byte buffer.
+   *
+   * @return The `HttpResponse` instance.
+   */
+  HttpResponse CallApi(std::string path, std::string method,
+                       ParametersType query_params,
+                       ParametersType header_params, ParametersType form_params,
+                       RequestBodyType post_body, std::string content_type,
+                       CancellationContext context, bool buffer_response) const;
+
+  /**
+   * @brief Executes the HTTP request through the network stack in a blocking
+   * way and passes the response body to the callback as it arrives.
+   *
+   * The body is not kept in the response, so the memory used by the request
+   * is bounded by the size of the network chunks. `data_callback` receives
+   * each chunk with its offset in the body. When the request is retried, the
+   * body is passed again from offset 0. The body of a failed response is
+   * passed as well, so discard the received chunks if the response status is
+   * not successful. The requests with a data callback are not hedged.
+   *
+   * @param path The path that is appended to the base URL.
+   * @param method Select one of the following methods: `GET`, `POST`, `DELETE`,
+   * or `PUT`.
+   * @param query_params The parameters that are appended to the URL path.
+   * @param header_params The headers used to customize the request.
+   * @param form_params For the `POST` request, populate `form_params` or
+   * `post_body`, but not both.
+   * @param post_body For the `POST` request, populate `form_params` or
+   * `post_body`, but not both. This data must not be modified until
+   * the request is completed.
+   * @param content_type The content type for the `post_body` or `form_params`.
+   * @param context The `CancellationContext` instance that is used to cancel
+   * the request.
+   * @param data_callback The callback that receives the chunks of the body on
+   * the network thread.
+   *
+   * @return The `HttpResponse` instance without the body.
+   */
+  HttpResponse CallApi(std::string path, std::string method,
+                       ParametersType query_params,
+                       ParametersType header_params, ParametersType form_params,
+                       RequestBodyType post_body, std::string content_type,
+                       CancellationContext context,
+                       http::Network::DataCallback data_callback) const;
+
+  /**
+   * @brief Executes the HTTP request through the network stack in a blocking
+   * way and streams the request body from the callback.
+   *
+   * The network reads the body directly from `body_source`, so the body does
+   * not have to be serialized into a buffer first. When the request is
+   * retried, the body is read again from offset 0.
+   *
+   * @param path The path that is appended to the base URL.
+   * @param method Select one of the following methods: `POST` or `PUT`.
+   * @param query_params The parameters that are appended to the URL path.
+   * @param header_params The headers used to customize the request.
+   * @param body_source The callback that reads the request body on the
+   * network thread.
+   * @param body_size The size of the body, or
+   * `http::NetworkRequest::kUnknownBodySize` to send it with the chunked
+   * transfer encoding.
+   * @param content_type The content type of the body.
+   * @param context The `CancellationContext` instance that is used to cancel
+   * the request.
+   *
+   * @return The `HttpResponse` instance.
+   */
+  HttpResponse CallApi(std::string path, std::string method,
+                       ParametersType query_params,
+                       ParametersType header_params,
+                       http::NetworkRequest::BodySourceCallback body_source,
+                       std::int64_t body_size, std::string content_type,
+                       CancellationContext context) const;
+
  private:
   class OlpClientImpl;
   std::shared_ptr<OlpClientImpl> impl_;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -47,6 +48,11 @@ class Network;
 }  // namespace http
 
 namespace client {
+class MemoryBudget;
+class PendingUrlRequests;
+class RetryBudget;
+class Tracer;
+
 /**
  * @brief The type alias of the asynchronous network callback.
  *
@@ -201,6 +207,44 @@ struct CORE_API RetrySettings {
    * @brief Evaluates responses to determine if the retry should be attempted.
    */
   RetryCondition retry_condition = DefaultRetryCondition;
+
+  /**
+   * @brief Resumes the interrupted downloads with `Range` requests.
+   *
+   * When a buffered `GET` request fails with a network error after a part of
+   * the body is received, the next attempt only requests the missing bytes.
+   * Such requests are retried even if `retry_condition` does not accept the
+   * network errors.
+   */
+  bool resume_downloads = false;
+
+  /**
+   * @brief The percentile of the recent times to the first response byte
+   * after which a stalled `GET` request is sent once more.
+   *
+   * The response of the request that completes first is used, and the other
+   * request is cancelled. This reduces the tail latency of the interactive
+   * requests, e.g. `GetData` for a tile, at the cost of some duplicated
+   * traffic. The requests are hedged once enough times are collected by the
+   * `OlpClient` instance. Set to 0 to disable hedging.
+   */
+  unsigned int hedge_percentile = 0u;
+
+  /**
+   * @brief The minimum delay (in milliseconds) before a request is hedged.
+   */
+  int min_hedge_delay = 50;
+
+  /**
+   * @brief The retry budget and the circuit breakers shared by the clients.
+   *
+   * When the failures spike, the requests are not retried once the budget is
+   * spent, and the requests to the failing hosts fail immediately with the
+   * `HttpStatusCode::SERVICE_UNAVAILABLE` status.
+   *
+   * If `nullptr` is set, the requests are retried `max_attempts` times.
+   */
+  std::shared_ptr<RetryBudget> retry_budget = nullptr;
 };
 
 /**
@@ -258,6 +302,16 @@ struct CORE_API ApiLookupSettings {
    * `lookup_endpoint_provider` is not called additionally.
    */
   CatalogEndpointProvider catalog_endpoint_provider = nullptr;
+
+  /**
+   * @brief Resolves the hosts of all the APIs returned by the API Lookup
+   * Service in the background.
+   *
+   * The hosts are passed to `Network::PreResolve` as soon as the lookup
+   * response is received, so the first requests to the returned services do
+   * not wait for the DNS lookup.
+   */
+  bool pre_resolve_hosts = false;
 };
 
 /**
@@ -324,6 +378,81 @@ struct CORE_API OlpClientSettings {
    * volatile or versioned, and which is stored in cache.
    */
   std::chrono::seconds default_cache_expiration = std::chrono::seconds::max();
+
+  /**
+   * @brief The time the expired API lookup results and catalog configurations
+   * are still used while they are refreshed in the background.
+   *
+   * If an entry expired less than `max_staleness` ago, the request uses it
+   * right away and starts one refresh in the background instead of waiting
+   * for the network. This removes the latency spikes when the entries expire.
+   * It applies to the `OnlineIfNotFound` requests only. Set to 0 to disable
+   * it. By default, it is disabled.
+   */
+  std::chrono::seconds max_staleness = std::chrono::seconds(0);
+
+  /**
+   * @brief The size of the ranged chunks (in bytes) in which the buffered
+   * downloads are fetched in parallel.
+   *
+   * The first chunk is requested alone to learn the body size, and the
+   * remaining chunks are requested at the same time on the `task_scheduler`
+   * threads and the calling thread. They are conditional on the `ETag` of the
+   * first chunk, and the download starts again once if the resource changes
+   * in between. Servers that do not support the `Range` requests return the
+   * whole body in the first response. Set to 0 to download the body with one
+   * request.
+   */
+  uint64_t download_chunk_size = 0u;
+
+  /**
+   * @brief The registry of the pending requests that merges the identical
+   * requests sent at the same time.
+   *
+   * The clients that use the same registry send one network request for the
+   * identical in-flight `GET` requests and pass the response to every caller.
+   * Create it with `OlpClientSettingsFactory::CreatePendingRequests` and set
+   * it to the settings of all the clients, e.g. all the layer clients of a
+   * catalog. The requests with different credentials are not merged.
+   *
+   * If `nullptr` is set, each `OlpClient` instance merges only its own
+   * requests.
+   */
+  std::shared_ptr<PendingUrlRequests> pending_requests = nullptr;
+
+  /**
+   * @brief The tracer that receives the spans of the requests.
+   *
+   * The clients trace the requests, the catalog version resolution, the
+   * partition lookups, the cache checks, and the network requests, so the
+   * time of one request can be followed across the threads.
+   *
+   * If `nullptr` is set, nothing is traced.
+   */
+  std::shared_ptr<Tracer> tracer = nullptr;
+
+  /**
+   * @brief The memory budget shared by the clients.
+   *
+   * The in-flight response bodies are reserved in the budget. Under memory
+   * pressure, the requests are not hedged, and the prefetch downloads fewer
+   * tiles at the same time. Set the same instance to
+   * `CacheSettings::memory_budget` to shrink the memory cache as well.
+   *
+   * If `nullptr` is set, the memory is not limited.
+   */
+  std::shared_ptr<MemoryBudget> memory_budget = nullptr;
+
+  /**
+   * @brief The maximum size of the decoded quad trees of the versioned layers
+   * that are kept in memory, in bytes.
+   *
+   * The decoded trees are shared by the clients that use the same `cache`,
+   * and the size of the clients that decode a tree of the `cache` first
+   * applies. The default size fits a few hundred trees of the usual size.
+   * Set to 0 to decode the quad tree on every tile request.
+   */
+  size_t quad_tree_memory_cache_size = 16u * 1024u * 1024u;
 };
 
 }  // namespace client
@@ -33,6 +33,7 @@ struct CacheSettings;
 }  // namespace cache
 
 namespace client {
+class PendingUrlRequests;
 struct OlpClientSettings;
 
 /**
@@ -91,6 +92,17 @@ class CORE_API OlpClientSettingsFactory final {
   static std::unique_ptr<cache::KeyValueCache> CreateDefaultCache(
       cache::CacheSettings settings);
 
+  /**
+   * @brief Creates the registry of the pending requests that can be shared
+   * by several clients.
+   *
+   * Set the returned instance to the `OlpClientSettings::pending_requests`
+   * member of the clients that should merge their identical requests.
+   *
+   * @return The `PendingUrlRequests` instance.
+   */
+  static std::shared_ptr<PendingUrlRequests> CreatePendingRequests();
+
   /**
    * @brief This function helps you prewarm the connection to the
    * provided host.
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -33,6 +34,10 @@ namespace client {
 
 /**
  * @brief A container for requests that have not finished yet.
+ *
+ * The requests are spread over several shards by their hash, so the tasks
+ * that are inserted and removed from different threads rarely wait for each
+ * other.
  */
 class CORE_API PendingRequests final {
  public:
@@ -77,8 +82,17 @@ class CORE_API PendingRequests final {
 
  private:
   using ContextMap = std::unordered_set<TaskContext, TaskContextHash>;
-  ContextMap task_contexts_;
-  mutable std::mutex task_contexts_lock_;
+
+  struct Shard {
+    ContextMap task_contexts;
+    mutable std::mutex task_contexts_lock;
+  };
+
+  static constexpr size_t kShardCount = 16u;
+
+  Shard& GetShard(const TaskContext& task_context);
+
+  std::array<Shard, kShardCount> shards_;
 };
 
 }  // namespace client
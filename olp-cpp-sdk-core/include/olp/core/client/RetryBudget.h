@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace client {
+
+/**
+ * @brief Limits the retries and the requests to the failing hosts of all the
+ * clients that share it.
+ *
+ * The retries are taken from a token bucket that holds up to `max_retries`
+ * tokens and is refilled at the same rate over `window`, so during an outage
+ * the requests fail fast instead of retrying and sleeping in the backdown.
+ *
+ * The circuit breaker of a host opens after `failure_threshold` consecutive
+ * failures: the requests to the host fail immediately for `open_duration`.
+ * After that one request is let through to probe the host, and its success
+ * closes the breaker.
+ *
+ * Set the instance to `RetrySettings::retry_budget` of the clients.
+ */
+class CORE_API RetryBudget final {
+ public:
+  /**
+   * @brief Creates the `RetryBudget` instance.
+   *
+   * @param max_retries The number of retries allowed in the window, or 0 for
+   * no limit.
+   * @param window The time in which the retries are refilled.
+   * @param failure_threshold The number of consecutive failures that opens
+   * the circuit breaker of a host, or 0 to disable the circuit breaker.
+   * @param open_duration The time during which the requests to the host with
+   * the open circuit breaker fail immediately.
+   */
+  RetryBudget(size_t max_retries, std::chrono::milliseconds window,
+              size_t failure_threshold,
+              std::chrono::milliseconds open_duration);
+
+  /**
+   * @brief Takes one retry from the budget.
+   *
+   * @return True if the request can be retried; false if the budget is spent.
+   */
+  bool TryRetry();
+
+  /**
+   * @brief Checks whether the request can be sent to the host of the URL.
+   *
+   * @param url The URL of the request.
+   *
+   * @return False if the circuit breaker of the host is open; true otherwise.
+   */
+  bool AllowRequest(const std::string& url);
+
+  /**
+   * @brief Records the result of a request to the host of the URL.
+   *
+   * @param url The URL of the request.
+   * @param failed True if the host failed to serve the request, e.g. with a
+   * server or a network error.
+   */
+  void OnResult(const std::string& url, bool failed);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct HostState {
+    size_t failures{0u};
+    Clock::time_point open_until{};
+  };
+
+  const double max_retries_;
+  const std::chrono::duration<double> window_;
+  const size_t failure_threshold_;
+  const std::chrono::milliseconds open_duration_;
+
+  std::mutex mutex_;
+  double tokens_;
+  Clock::time_point refilled_at_;
+  std::unordered_map<std::string, HostState> hosts_;
+};
+
+}  // namespace client
+}  // namespace olp
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -28,6 +29,8 @@
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/CancellationToken.h>
 #include <olp/core/client/Condition.h>
+#include <olp/core/client/TaskContinuation.h>
+#include <olp/core/utils/InlineFunction.h>
 
 namespace olp {
 namespace client {
@@ -63,12 +66,83 @@ class CORE_API TaskContext {
     return task;
   }
 
+  /**
+   * @brief Creates the `TaskContext` instance that runs the provided chain
+   * of stages.
+   *
+   * `Execute` only starts the first stage, and the callback is invoked from
+   * the thread that reports the response of the last stage.
+   *
+   * @param continuation The chain of stages that should be executed.
+   * @param callback Is invoked once the response of the last stage is
+   * available or the task is cancelled.
+   * @param context The `CancellationContext` instance.
+   * @param scheduler Runs the stages which responses arrive on other threads,
+   * or `nullptr` to run them on the reporting thread.
+   * @param priority The priority of the scheduled stages.
+   *
+   * @return The `TaskContext` instance that can be used to run or cancel
+   * the task.
+   */
+  template <typename Response, typename Callback>
+  static TaskContext Create(
+      TaskContinuation<Response> continuation, Callback callback,
+      client::CancellationContext context = client::CancellationContext(),
+      std::shared_ptr<thread::TaskScheduler> scheduler = nullptr,
+      uint32_t priority = thread::NORMAL) {
+    TaskContext task;
+    task.impl_ = std::make_shared<TaskContinuationImpl<Response>>(
+        std::move(continuation), std::move(callback), std::move(context),
+        TaskContinuationEnvironment{client::CancellationContext(),
+                                    std::move(scheduler), priority});
+    return task;
+  }
+
+  /**
+   * @brief Starts a chain of asynchronous stages.
+   *
+   * Add the next stages with `TaskContinuation::Then`, and run the chain
+   * with `Create`.
+   *
+   * @param stage The first stage. Reports its response to the callback.
+   *
+   * @return The `TaskContinuation` instance.
+   */
+  template <typename Response>
+  static TaskContinuation<Response> Then(
+      std::function<void(client::CancellationContext,
+                         std::function<void(Response)>)>
+          stage) {
+    // The stage is shared by the copies of the chain, so the state it
+    // captures is not copied with them.
+    using Stage = decltype(stage);
+    auto shared_stage = std::make_shared<const Stage>(std::move(stage));
+    return TaskContinuation<Response>(
+        [shared_stage](const TaskContinuationEnvironment& environment,
+                       std::function<void(Response)> callback) {
+          detail::TaskStageScope stage_scope;
+          (*shared_stage)(environment.context, std::move(callback));
+        });
+  }
+
   /**
    * @brief Checks for the cancellation, executes the task, and calls
    * the callback with the result or error.
    */
   void Execute() const { impl_->Execute(); }
 
+  /**
+   * @brief Executes the task and notifies once it is finished.
+   *
+   * Unlike `Execute`, does not assume that the task is finished when the
+   * call returns, which is not the case for a chain of stages.
+   *
+   * @param on_finished Is invoked after the callback of the task.
+   */
+  void Execute(utils::InlineFunction<void()> on_finished) const {
+    impl_->ExecuteAndNotify(std::move(on_finished));
+  }
+
   /**
    * @brief Cancels the operation and waits for the notification.
    *
@@ -140,6 +214,18 @@ class CORE_API TaskContext {
      */
     virtual void Execute() = 0;
 
+    /**
+     * @brief Executes the task and calls `on_finished` once it is finished.
+     *
+     * @param on_finished Is invoked after the callback of the task.
+     */
+    virtual void ExecuteAndNotify(utils::InlineFunction<void()> on_finished) {
+      Execute();
+      if (on_finished) {
+        on_finished();
+      }
+    }
+
     /**
      * @brief Cancels the operation and waits for the notification.
      *
@@ -170,9 +256,10 @@ class CORE_API TaskContext {
   class TaskContextImpl : public Impl {
    public:
     /// The task that produces the `Response` instance.
-    using ExecuteFunc = std::function<Response(client::CancellationContext)>;
+    using ExecuteFunc =
+        utils::InlineFunction<Response(client::CancellationContext)>;
     /// Consumes the `Response` instance.
-    using UserCallback = std::function<void(Response)>;
+    using UserCallback = utils::InlineFunction<void(Response)>;
 
     /**
      * @brief Creates the `TaskContextImpl` instance.
@@ -307,6 +394,153 @@ class CORE_API TaskContext {
     std::atomic<State> state_;
   };
 
+  /**
+   * @brief Implements the `Impl` interface for a chain of stages.
+   *
+   * The task is finished when the last stage reports its response, which may
+   * happen on another thread after `Execute` returns.
+   *
+   * @tparam Response The response type of the last stage.
+   */
+  template <typename Response>
+  class TaskContinuationImpl
+      : public Impl,
+        public std::enable_shared_from_this<TaskContinuationImpl<Response>> {
+   public:
+    /// Consumes the `Response` instance.
+    using UserCallback = utils::InlineFunction<void(Response)>;
+
+    /**
+     * @brief Creates the `TaskContinuationImpl` instance.
+     *
+     * @param continuation The chain of stages that should be executed.
+     * @param callback Is invoked once the response of the last stage is
+     * available or the task is cancelled.
+     * @param context The `CancellationContext` instance.
+     * @param environment The scheduler and priority of the stages.
+     */
+    TaskContinuationImpl(TaskContinuation<Response> continuation,
+                         UserCallback callback,
+                         client::CancellationContext context,
+                         TaskContinuationEnvironment environment)
+        : continuation_(new TaskContinuation<Response>(
+              std::move(continuation))),
+          callback_(std::move(callback)),
+          context_(std::move(context)),
+          environment_(std::move(environment)),
+          state_{State::PENDING},
+          finished_{false} {
+      environment_.context = context_;
+    }
+
+    void Execute() override { ExecuteAndNotify(nullptr); }
+
+    void ExecuteAndNotify(
+        utils::InlineFunction<void()> on_finished) override {
+      State expected_state = State::PENDING;
+
+      if (!state_.compare_exchange_strong(expected_state, State::IN_PROGRESS)) {
+        if (on_finished) {
+          on_finished();
+        }
+        return;
+      }
+
+      std::unique_ptr<TaskContinuation<Response>> continuation;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        continuation = std::move(continuation_);
+        on_finished_ = std::move(on_finished);
+      }
+
+      if (!continuation || context_.IsCancelled()) {
+        Finish(client::ApiError(client::ErrorCode::Cancelled, "Cancelled"));
+        return;
+      }
+
+      // The chain keeps the task alive until the last stage reports.
+      auto self = this->shared_from_this();
+      continuation->Start(environment_, [self](Response response) {
+        self->Finish(std::move(response));
+      });
+    }
+
+    bool BlockingCancel(std::chrono::milliseconds timeout) override {
+      if (state_.load() == State::COMPLETED) {
+        return true;
+      }
+
+      if (!context_.IsCancelled()) {
+        context_.CancelOperation();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        continuation_.reset();
+      }
+
+      return condition_.Wait(timeout);
+    }
+
+    client::CancellationToken CancelToken() override {
+      auto context = context_;
+      return client::CancellationToken(
+          [context]() mutable { context.CancelOperation(); });
+    }
+
+   private:
+    enum class State { PENDING, IN_PROGRESS, COMPLETED };
+
+    void Finish(Response response) {
+      if (finished_.exchange(true)) {
+        return;
+      }
+
+      UserCallback callback = nullptr;
+      utils::InlineFunction<void()> on_finished = nullptr;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback = std::move(callback_);
+        on_finished = std::move(on_finished_);
+      }
+
+      Response user_response =
+          client::ApiError(client::ErrorCode::Cancelled, "Cancelled");
+
+      // Same as for a single task, a timeout is reported even if the
+      // operation was cancelled in the meantime.
+      if (!context_.IsCancelled() ||
+          (!response.IsSuccessful() &&
+           response.GetError().GetErrorCode() == ErrorCode::RequestTimeout)) {
+        user_response = std::move(response);
+      }
+
+      context_.ExecuteOrCancelled([]() { return CancellationToken(); });
+
+      if (callback) {
+        callback(std::move(user_response));
+      }
+      callback = nullptr;
+
+      condition_.Notify();
+      state_.store(State::COMPLETED);
+
+      if (on_finished) {
+        on_finished();
+      }
+    }
+
+    std::mutex mutex_;
+    std::unique_ptr<TaskContinuation<Response>> continuation_;
+    UserCallback callback_;
+    utils::InlineFunction<void()> on_finished_;
+    client::CancellationContext context_;
+    TaskContinuationEnvironment environment_;
+    client::Condition condition_;
+    std::atomic<State> state_;
+    std::atomic<bool> finished_;
+  };
+
   /// The `Impl` instance.
   std::shared_ptr<Impl> impl_;
 };
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include <olp/core/client/ApiError.h>
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/Tracer.h>
+#include <olp/core/http/RequestPriorityScope.h>
+#include <olp/core/thread/TaskScheduler.h>
+
+namespace olp {
+namespace client {
+
+/**
+ * @brief The environment shared by the stages of a running
+ * `TaskContinuation` chain.
+ */
+struct CORE_API TaskContinuationEnvironment {
+  /// The `CancellationContext` instance of the chain.
+  CancellationContext context;
+  /// Runs the stages which responses arrive on other threads, or `nullptr`
+  /// to run them on the reporting thread.
+  std::shared_ptr<thread::TaskScheduler> scheduler;
+  /// The priority of the scheduled stages and of their network requests.
+  uint32_t priority;
+};
+
+namespace detail {
+/// Marks the current thread as running a stage, so the stages reported
+/// synchronously continue inline. Marking it as not running schedules the
+/// stages reported for other chains.
+class TaskStageScope final {
+ public:
+  explicit TaskStageScope(bool running = true) : previous_(Running()) {
+    Running() = running;
+  }
+  ~TaskStageScope() { Running() = previous_; }
+
+  TaskStageScope(const TaskStageScope&) = delete;
+  TaskStageScope& operator=(const TaskStageScope&) = delete;
+
+  static bool& Running() {
+    static thread_local bool running = false;
+    return running;
+  }
+
+ private:
+  const bool previous_;
+};
+}  // namespace detail
+
+/**
+ * @brief A chain of the asynchronous stages started with `TaskContext::Then`.
+ *
+ * A stage starts its operation and reports the response to the given
+ * callback, for example, from the callback of an asynchronous
+ * `OlpClient::CallApi` call. The next stage gets the result of the previous
+ * one and starts when the response arrives. If a stage reports on the thread
+ * that runs it, the next stage runs inline; otherwise, it is scheduled as a
+ * new task with the chain priority. An error response or a cancellation
+ * skips the remaining stages.
+ *
+ * Only the stages that report from an asynchronous callback release the
+ * worker thread while they wait for the network. A stage that makes
+ * synchronous calls blocks the worker, the same as a regular task.
+ *
+ * Use `TaskContext::Create` to run the chain as a task.
+ *
+ * @tparam Response The `ApiResponse` type of the last stage.
+ */
+template <typename Response>
+class TaskContinuation {
+ public:
+  /// Consumes the response of the stage.
+  using Callback = std::function<void(Response)>;
+
+  /// Runs the stages of the chain and reports the response of the last one.
+  using StartFunc =
+      std::function<void(const TaskContinuationEnvironment&, Callback)>;
+
+  /**
+   * @brief Creates the `TaskContinuation` instance.
+   *
+   * @param start Runs the stages of the chain.
+   */
+  explicit TaskContinuation(StartFunc start) : start_(std::move(start)) {}
+
+  /**
+   * @brief Adds the next stage to the chain.
+   *
+   * @param stage Gets the result of the previous stage and reports its
+   * response to the callback.
+   *
+   * @return The `TaskContinuation` instance that ends with the new stage.
+   */
+  template <typename NextResponse>
+  TaskContinuation<NextResponse> Then(
+      std::function<void(CancellationContext, typename Response::ResultType,
+                         std::function<void(NextResponse)>)>
+          stage) const {
+    using Result = typename Response::ResultType;
+    using NextCallback = std::function<void(NextResponse)>;
+    using Stage = decltype(stage);
+
+    // The stage is shared by the copies of the chain and of its callbacks, so
+    // the state it captures is not copied with them.
+    auto shared_stage = std::make_shared<const Stage>(std::move(stage));
+    auto start = start_;
+    return TaskContinuation<NextResponse>(
+        [start, shared_stage](const TaskContinuationEnvironment& environment,
+                              NextCallback callback) {
+          start(environment, [=](Response response) {
+            if (!response.IsSuccessful()) {
+              callback(response.GetError());
+              return;
+            }
+
+            auto result = std::make_shared<Result>(response.MoveResult());
+            auto run = [=]() {
+              if (environment.context.IsCancelled()) {
+                callback(ApiError(ErrorCode::Cancelled, "Cancelled"));
+                return;
+              }
+              detail::TaskStageScope stage_scope;
+              (*shared_stage)(environment.context, std::move(*result),
+                              callback);
+            };
+
+            if (!environment.scheduler || detail::TaskStageScope::Running()) {
+              run();
+              return;
+            }
+
+            const auto priority = environment.priority;
+            auto span = SpanScope::GetCurrentSpan();
+            environment.scheduler->ScheduleTask(
+                [=]() {
+                  http::RequestPriorityScope priority_scope(priority);
+                  SpanScope span_scope(span);
+                  run();
+                },
+                priority);
+          });
+        });
+  }
+
+  /**
+   * @brief Runs the stages of the chain.
+   *
+   * @param environment The environment of the chain.
+   * @param callback Gets the response of the last stage.
+   */
+  void Start(const TaskContinuationEnvironment& environment,
+             Callback callback) const {
+    start_(environment, std::move(callback));
+  }
+
+ private:
+  StartFunc start_;
+};
+
+}  // namespace client
+}  // namespace olp
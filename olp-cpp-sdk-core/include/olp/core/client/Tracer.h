@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace client {
+
+/**
+ * @brief A traced operation, for example, a network request.
+ *
+ * Implement it together with `Tracer` to forward the spans to a tracing
+ * library, for example, as OpenTelemetry spans. The attribute keys follow the
+ * OpenTelemetry conventions where they exist, like `http.url`.
+ */
+class CORE_API Span {
+ public:
+  virtual ~Span() = default;
+
+  /**
+   * @brief Sets an attribute of the span.
+   *
+   * @param key The attribute key.
+   * @param value The attribute value.
+   */
+  virtual void SetAttribute(const std::string& key,
+                            const std::string& value) = 0;
+
+  /**
+   * @brief Ends the span.
+   *
+   * It is called once, possibly on another thread than the one that started
+   * the span.
+   */
+  virtual void End() = 0;
+};
+
+/**
+ * @brief Starts the spans of the traced operations.
+ *
+ * Set it to `OlpClientSettings::tracer` to trace the requests of the clients.
+ * Without a tracer, the tracing costs a null pointer check.
+ */
+class CORE_API Tracer {
+ public:
+  virtual ~Tracer() = default;
+
+  /**
+   * @brief Starts a span.
+   *
+   * @param name The name of the operation.
+   * @param parent The parent span, or `nullptr` for a root span.
+   *
+   * @return The started span, or `nullptr` to not trace the operation.
+   */
+  virtual std::shared_ptr<Span> StartSpan(
+      const std::string& name, const std::shared_ptr<Span>& parent) = 0;
+};
+
+/**
+ * @brief Starts a span as a child of the current span of the thread.
+ *
+ * @param tracer The tracer, or `nullptr` if tracing is disabled.
+ * @param name The name of the operation.
+ *
+ * @return The started span, or `nullptr` if tracing is disabled.
+ */
+CORE_API std::shared_ptr<Span> StartSpan(const std::shared_ptr<Tracer>& tracer,
+                                         const char* name);
+
+/**
+ * @brief Makes a span the parent of the spans started on the current thread
+ * while the scope is alive.
+ *
+ * The tasks capture the current span when they are scheduled and restore it
+ * when they run, so the spans of one request form a tree across threads.
+ * The scopes can be nested, the previous span is restored on destruction.
+ */
+class CORE_API SpanScope final {
+ public:
+  /**
+   * @brief Sets the current span of the thread.
+   *
+   * @param span The span, or `nullptr` to start root spans.
+   */
+  explicit SpanScope(std::shared_ptr<Span> span);
+
+  /**
+   * @brief Restores the previous span of the thread.
+   */
+  ~SpanScope();
+
+  SpanScope(const SpanScope&) = delete;
+  SpanScope& operator=(const SpanScope&) = delete;
+
+  /**
+   * @brief Gets the current span of the thread.
+   *
+   * @return The span of the innermost scope, or `nullptr` if there is none.
+   */
+  static std::shared_ptr<Span> GetCurrentSpan();
+
+ private:
+  std::shared_ptr<Span> previous_span_;
+};
+
+/**
+ * @brief Traces the operation of a code block.
+ *
+ * Starts a span as a child of the current span, makes it current, and ends
+ * it on destruction. Does nothing if the tracer is `nullptr`.
+ */
+class CORE_API ScopedSpan final {
+ public:
+  /**
+   * @brief Starts the span.
+   *
+   * @param tracer The tracer, or `nullptr` if tracing is disabled.
+   * @param name The name of the operation.
+   */
+  ScopedSpan(const std::shared_ptr<Tracer>& tracer, const char* name);
+
+  /**
+   * @brief Ends the span and restores the previous current span.
+   */
+  ~ScopedSpan();
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+  /**
+   * @brief Checks whether the operation is traced.
+   *
+   * Use it to skip building the attribute values when tracing is disabled.
+   *
+   * @return True if the span is started.
+   */
+  bool IsTraced() const { return span_ != nullptr; }
+
+  /**
+   * @brief Sets an attribute of the span if the operation is traced.
+   *
+   * @param key The attribute key.
+   * @param value The attribute value.
+   */
+  void SetAttribute(const std::string& key, const std::string& value);
+
+ private:
+  std::shared_ptr<Span> span_;
+  std::unique_ptr<SpanScope> scope_;
+};
+
+}  // namespace client
+}  // namespace olp
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <olp/core/CoreApi.h>
+#include <olp/core/client/ApiError.h>
+#include <olp/core/client/ApiNoResult.h>
+#include <olp/core/client/ApiResponse.h>
+#include <olp/core/client/CancellationToken.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettings.h>
+
+namespace olp {
+namespace client {
+
+/// The response of `Warmup`, an error if one of the API lookups failed.
+using WarmupResponse = ApiResponse<ApiNoResult, ApiError>;
+
+/// The callback of `Warmup`.
+using WarmupCallback = std::function<void(WarmupResponse)>;
+
+/**
+ * @brief Prepares the network and the caches for the first requests to the
+ * catalogs.
+ *
+ * Otherwise, the first request waits for the access token, the API lookup,
+ * the DNS lookup and the TLS handshake one after another. The warm-up starts
+ * the connections to the lookup hosts while the access token is acquired,
+ * then looks up the APIs of all the catalogs in parallel, stores them in
+ * the `cache` of the settings, and connects to the returned hosts with
+ * `http::Network::PreResolve`.
+ *
+ * Call it at startup with the settings that the clients of the catalogs use,
+ * so the clients share the cache and the network with the warm-up. The
+ * connections are established if the network keeps a DNS cache, see
+ * `http::NetworkInitializationSettings::dns_cache_timeout`. Without the
+ * task scheduler, the warm-up runs on the calling thread.
+ *
+ * @param catalogs The HRNs of the catalogs.
+ * @param settings The settings of the clients of the catalogs.
+ * @param callback The callback that is called when the APIs of all the
+ * catalogs are looked up.
+ *
+ * @return The token that cancels the warm-up.
+ */
+CORE_API CancellationToken Warmup(const std::vector<HRN>& catalogs,
+                                  const OlpClientSettings& settings,
+                                  WarmupCallback callback);
+
+/**
+ * @brief Prepares the network and the caches for the first requests to the
+ * catalogs.
+ *
+ * @param catalogs The HRNs of the catalogs.
+ * @param settings The settings of the clients of the catalogs.
+ *
+ * @see `Warmup(const std::vector<HRN>&, const OlpClientSettings&,
+ * WarmupCallback)` for more details.
+ *
+ * @return `CancellableFuture` that contains the `WarmupResponse` instance.
+ */
+CORE_API CancellableFuture<WarmupResponse> Warmup(
+    const std::vector<HRN>& catalogs, const OlpClientSettings& settings);
+
+}  // namespace client
+}  // namespace olp
@@ -21,9 +21,10 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <rapidjson/document.h>
-#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/memorystream.h>
 
 #include "ParserWrapper.h"
 
@@ -40,20 +41,94 @@ inline T parse(const std::string& json) {
   return result;
 }
 
+/// Copies the content of the stream from its read position.
+inline std::string read_remaining(std::stringstream& json_stream) {
+  std::string buffer = json_stream.str();
+  const auto position = json_stream.tellg();
+  if (position > 0) {
+    buffer.erase(0, static_cast<size_t>(position));
+  }
+  return buffer;
+}
+
+/**
+ * @brief Parses the remaining content of the stream into the model.
+ *
+ * The content is parsed in situ from a single contiguous buffer, and the DOM
+ * lives in a per-call arena that starts on the stack, so small responses are
+ * parsed without allocating a node per value.
+ */
 template <typename T>
 inline T parse(std::stringstream& json_stream, bool& res) {
   res = false;
-  rapidjson::Document doc;
-  rapidjson::IStreamWrapper stream(json_stream);
-  doc.ParseStream(stream);
+  std::string buffer = read_remaining(json_stream);
+
+  char arena[4096];
+  rapidjson::MemoryPoolAllocator<> allocator(arena, sizeof(arena));
+  rapidjson::Document doc(&allocator);
+  doc.ParseInsitu(&buffer[0]);
   T result{};
-  if (doc.IsObject() || doc.IsArray()) {
+  if (!doc.HasParseError() && (doc.IsObject() || doc.IsArray())) {
+    from_json(doc, result);
+    res = true;
+  }
+  return result;
+}
+
+/**
+ * @brief Parses the remaining content of the stream with a SAX handler.
+ *
+ * The values are passed to the handler while reading, so no DOM is built.
+ * The strings passed to the handler are only valid until the call returns.
+ *
+ * @return True if the content is a valid JSON accepted by the handler.
+ */
+template <typename Handler>
+inline bool parse_sax(std::stringstream& json_stream, Handler& handler) {
+  std::string buffer = read_remaining(json_stream);
+  rapidjson::InsituStringStream stream(&buffer[0]);
+  rapidjson::Reader reader;
+  return !reader.Parse<rapidjson::kParseInsituFlag>(stream, handler).IsError();
+}
+
+/**
+ * @brief Parses the content of the byte buffer into the model.
+ *
+ * The buffer is read in place and is not modified, so it can be shared, e.g.
+ * with the `HttpResponse` it comes from.
+ */
+template <typename T>
+inline T parse(const std::vector<unsigned char>& json, bool& res) {
+  res = false;
+
+  char arena[4096];
+  rapidjson::MemoryPoolAllocator<> allocator(arena, sizeof(arena));
+  rapidjson::Document doc(&allocator);
+  doc.Parse(reinterpret_cast<const char*>(json.data()), json.size());
+  T result{};
+  if (!doc.HasParseError() && (doc.IsObject() || doc.IsArray())) {
     from_json(doc, result);
     res = true;
   }
   return result;
 }
 
+/**
+ * @brief Parses the content of the byte buffer with a SAX handler.
+ *
+ * The buffer is read in place and is not modified.
+ *
+ * @return True if the content is a valid JSON accepted by the handler.
+ */
+template <typename Handler>
+inline bool parse_sax(const std::vector<unsigned char>& json,
+                      Handler& handler) {
+  rapidjson::MemoryStream stream(reinterpret_cast<const char*>(json.data()),
+                                 json.size());
+  rapidjson::Reader reader;
+  return !reader.Parse(stream, handler).IsError();
+}
+
 template <typename T>
 inline T parse(std::stringstream& json_stream) {
   bool res = true;
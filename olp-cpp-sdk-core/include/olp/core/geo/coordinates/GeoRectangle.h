@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <olp/core/CoreApi.h>
 #include <olp/core/geo/coordinates/GeoCoordinates.h>
 
@@ -118,6 +120,31 @@ class CORE_API GeoRectangle {
    */
   bool Overlaps(const GeoRectangle& rectangle) const;
 
+  /**
+   * @brief Checks which of the points the rectangle contains.
+   *
+   * The bounds of the rectangle are resolved once for all the points, so it
+   * is cheaper than calling `Contains` per point.
+   *
+   * @param points The points to check.
+   *
+   * @return For each point, true if the rectangle contains it; false
+   * otherwise.
+   */
+  std::vector<bool> ContainsBatch(
+      const std::vector<GeoCoordinates>& points) const;
+
+  /**
+   * @brief Checks which of the rectangles overlap this rectangle.
+   *
+   * @param rectangles The other rectangles.
+   *
+   * @return For each rectangle, true if it overlaps this rectangle; false
+   * otherwise.
+   */
+  std::vector<bool> OverlapsBatch(
+      const std::vector<GeoRectangle>& rectangles) const;
+
   /**
    * @brief Checks whether two rectangles are equal.
    * 
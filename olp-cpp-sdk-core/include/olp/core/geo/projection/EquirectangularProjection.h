@@ -52,6 +52,14 @@ class CORE_API EquirectangularProjection final : public IProjection {
 
   bool Unproject(const WorldCoordinates& world_point,
                  GeoCoordinates3d& geo_point) const override;
+
+  bool ProjectPoints(const double* latitudes, const double* longitudes,
+                     const double* altitudes, std::size_t count, double* x,
+                     double* y, double* z) const override;
+
+  bool UnprojectPoints(const double* x, const double* y, const double* z,
+                       std::size_t count, double* latitudes,
+                       double* longitudes, double* altitudes) const override;
 };
 }  // namespace geo
 
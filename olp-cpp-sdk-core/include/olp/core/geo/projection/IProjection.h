@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <olp/core/geo/Types.h>
 
 namespace olp {
@@ -73,6 +75,46 @@ class CORE_API IProjection {
    */
   virtual bool Unproject(const WorldCoordinates& world_point,
                          GeoCoordinates3d& geo_point) const = 0;
+
+  /**
+   * @brief Projects the points given as separate coordinate arrays.
+   *
+   * The default implementation calls `Project()` for each point. The
+   * projections override it with a loop that has no virtual call per point.
+   *
+   * @param latitudes The latitudes in radians.
+   * @param longitudes The longitudes in radians.
+   * @param altitudes The altitudes in meters.
+   * @param count The number of the points.
+   * @param x The output for the `X` world coordinates.
+   * @param y The output for the `Y` world coordinates.
+   * @param z The output for the `Z` world coordinates.
+   *
+   * @return True if all the points are projected; false otherwise.
+   */
+  virtual bool ProjectPoints(const double* latitudes, const double* longitudes,
+                             const double* altitudes, std::size_t count,
+                             double* x, double* y, double* z) const;
+
+  /**
+   * @brief Unprojects the points given as separate coordinate arrays.
+   *
+   * The default implementation calls `Unproject()` for each point.
+   *
+   * @param x The `X` world coordinates.
+   * @param y The `Y` world coordinates.
+   * @param z The `Z` world coordinates.
+   * @param count The number of the points.
+   * @param latitudes The output for the latitudes in radians.
+   * @param longitudes The output for the longitudes in radians.
+   * @param altitudes The output for the altitudes in meters.
+   *
+   * @return True if all the points are unprojected; false otherwise.
+   */
+  virtual bool UnprojectPoints(const double* x, const double* y,
+                               const double* z, std::size_t count,
+                               double* latitudes, double* longitudes,
+                               double* altitudes) const;
 };
 
 }  // namespace geo
@@ -44,6 +44,21 @@ class CORE_API HalfQuadTreeSubdivisionScheme final : public ISubdivisionScheme {
   math::Size2u GetSubdivisionAt(unsigned level) const override;
 
   math::Size2u GetLevelSize(unsigned level) const override;
+
+  /**
+   * @brief Gets the number of the child tiles of a tile at the level, which
+   * is two at level 0 and four.
+   *
+   * Unlike `GetSubdivisionAt()`, it is known at compile time, so
+   * `TileTreeTraverseT` can use it without a virtual call.
+   *
+   * @param level The level of the parent tile.
+   *
+   * @return The number of the child tiles.
+   */
+  static constexpr unsigned ChildCountAt(unsigned level) {
+    return level == 0u ? 2u : 4u;
+  }
 };
 
 }  // namespace geo
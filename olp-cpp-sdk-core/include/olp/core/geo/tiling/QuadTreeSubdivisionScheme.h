@@ -43,6 +43,19 @@ class CORE_API QuadTreeSubdivisionScheme final : public ISubdivisionScheme {
   math::Size2u GetSubdivisionAt(unsigned level) const override;
 
   math::Size2u GetLevelSize(unsigned level) const override;
+
+  /**
+   * @brief Gets the number of the child tiles of a tile at the level, which
+   * is four.
+   *
+   * Unlike `GetSubdivisionAt()`, it is known at compile time, so
+   * `TileTreeTraverseT` can use it without a virtual call.
+   *
+   * @param level The level of the parent tile.
+   *
+   * @return The number of the child tiles.
+   */
+  static constexpr unsigned ChildCountAt(unsigned /*level*/) { return 4u; }
 };
 
 }  // namespace geo
@@ -528,6 +528,49 @@ CORE_API boost::optional<std::uint32_t> GetMaxTileKeyLevel(
 CORE_API boost::optional<std::uint32_t> GetNearestAvailableTileKeyLevel(
     const TileKeyLevels& levels, const std::uint32_t reference_level);
 
+/**
+ * @brief Converts the tile keys to 64-bit Morton codes.
+ *
+ * The same as calling `TileKey::ToQuadKey64()` for each key, but without
+ * the per-call overhead, so the loop can be vectorized.
+ *
+ * @param tile_keys The tile keys to convert.
+ * @param count The number of the tile keys.
+ * @param quad_keys The output for `count` 64-bit Morton codes.
+ */
+CORE_API void ToQuadKeys64(const TileKey* tile_keys, size_t count,
+                           std::uint64_t* quad_keys);
+
+/**
+ * @brief Converts the 64-bit Morton codes to tile keys.
+ *
+ * @param quad_keys The 64-bit Morton codes to convert.
+ * @param count The number of the Morton codes.
+ * @param tile_keys The output for `count` tile keys.
+ */
+CORE_API void FromQuadKeys64(const std::uint64_t* quad_keys, size_t count,
+                             TileKey* tile_keys);
+
+/**
+ * @brief Converts the tile keys to HERE tile code strings.
+ *
+ * @param tile_keys The tile keys to convert.
+ * @param count The number of the tile keys.
+ * @param here_tiles The output for `count` HERE tile code strings.
+ */
+CORE_API void ToHereTiles(const TileKey* tile_keys, size_t count,
+                          std::string* here_tiles);
+
+/**
+ * @brief Converts the HERE tile code strings to tile keys.
+ *
+ * @param here_tiles The HERE tile code strings to convert.
+ * @param count The number of the strings.
+ * @param tile_keys The output for `count` tile keys.
+ */
+CORE_API void FromHereTiles(const std::string* here_tiles, size_t count,
+                            TileKey* tile_keys);
+
 /**
  * @brief The stream operator to print or serialize the given tile key.
  */
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 
 #include <olp/core/geo/coordinates/GeoCoordinates.h>
@@ -33,6 +34,9 @@ namespace geo {
  */
 class CORE_API TileKeyUtils {
  public:
+  /// The callback that receives the tile keys one by one.
+  using TileKeyCallback = std::function<void(const TileKey&)>;
+
   /**
    * @brief Gets the key of the tile that contains geographic coordinates.
    *
@@ -62,6 +66,84 @@ class CORE_API TileKeyUtils {
       const ITilingScheme& tiling_scheme, const GeoRectangle& geo_rectangle,
       const std::uint32_t level);
 
+  /**
+   * @brief Passes the keys of the tiles that overlap with a geographic
+   * rectangle to the callback.
+   *
+   * Unlike the overload that returns a container, it does not keep all the
+   * tile keys in memory, which matters for large rectangles at high levels.
+   *
+   * @param[in] tiling_scheme The tiling scheme.
+   * @param[in] geo_rectangle The rectangle for which to find overlapping tile
+   * keys.
+   * @param[in] level The level of the tile key.
+   * @param[in] callback Called for each tile key in the row-major order.
+   */
+  static void GeoRectangleToTileKeys(const ITilingScheme& tiling_scheme,
+                                     const GeoRectangle& geo_rectangle,
+                                     const std::uint32_t level,
+                                     const TileKeyCallback& callback);
+
+  /**
+   * @brief Checks which of the tiles overlap with a geographic rectangle.
+   *
+   * A tile overlaps with the rectangle if `GeoRectangleToTileKeys` returns it
+   * for the rectangle at the level of the tile, also when the rectangle
+   * crosses the date line. The tile range of each level is calculated once,
+   * so the tiles are checked without any geographic calculation, which
+   * suits culling many tiles, for example, the cached ones.
+   *
+   * @param[in] tiling_scheme The tiling scheme.
+   * @param[in] tile_keys The tile keys to check.
+   * @param[in] geo_rectangle The rectangle.
+   *
+   * @return For each tile key, true if the tile overlaps with the rectangle;
+   * false otherwise.
+   */
+  static std::vector<bool> OverlapsGeoRectangle(
+      const ITilingScheme& tiling_scheme, const std::vector<TileKey>& tile_keys,
+      const GeoRectangle& geo_rectangle);
+
+  /**
+   * @brief Gets the smallest set of tiles between two levels that covers the
+   * same area as the tiles at `max_level` overlapping with a geographic
+   * rectangle.
+   *
+   * The tiles in the middle of the rectangle are replaced by their ancestors
+   * down to `min_level`, so only the tiles at the edges of the rectangle are
+   * on `max_level`.
+   *
+   * @param[in] tiling_scheme The tiling scheme. Its tiles must have four
+   * children each, as in the quadtree and half quadtree schemes.
+   * @param[in] geo_rectangle The rectangle to cover.
+   * @param[in] min_level The lowest level of the returned tiles.
+   * @param[in] max_level The highest level of the returned tiles.
+   *
+   * @return The covering tile keys. If the tiles cannot be calculated, an empty
+   * container is returned.
+   */
+  static std::vector<TileKey> GeoRectangleToCoveringTileKeys(
+      const ITilingScheme& tiling_scheme, const GeoRectangle& geo_rectangle,
+      const std::uint32_t min_level, const std::uint32_t max_level);
+
+  /**
+   * @brief Passes the keys of the tiles that overlap with a geographic
+   * polygon to the callback.
+   *
+   * The tiles are found row by row with a scanline, so the polygon may be
+   * concave. It must not cross the international date line.
+   *
+   * @param[in] tiling_scheme The tiling scheme.
+   * @param[in] polygon The vertices of the polygon. The last vertex is
+   * connected to the first one.
+   * @param[in] level The level of the tile key.
+   * @param[in] callback Called for each tile key in the row-major order.
+   */
+  static void GeoPolygonToTileKeys(const ITilingScheme& tiling_scheme,
+                                   const std::vector<GeoCoordinates>& polygon,
+                                   const std::uint32_t level,
+                                   const TileKeyCallback& callback);
+
   /**
    * @brief Gets the tile key that is a relative of a given parent.
    *
@@ -98,5 +180,21 @@ class CORE_API TileKeyUtils {
 math::AlignedBox3d CORE_API CalculateTileBox(const ITilingScheme& tiling_scheme,
                                              const TileKey& tile_key);
 
+/**
+ * @brief Calculates the space boxes of tiles.
+ *
+ * The world extent and the tile size of each level are calculated once for
+ * all the tiles, so it is cheaper than `CalculateTileBox` for many tiles, for
+ * example, all the visible tiles of a frame.
+ *
+ * @param[in] tiling_scheme The tiling scheme.
+ * @param[in] tile_keys The tile keys.
+ *
+ * @return The tile boxes in the order of the tile keys.
+ */
+std::vector<math::AlignedBox3d> CORE_API
+CalculateTileBoxes(const ITilingScheme& tiling_scheme,
+                   const std::vector<TileKey>& tile_keys);
+
 }  // namespace geo
 }  // namespace olp
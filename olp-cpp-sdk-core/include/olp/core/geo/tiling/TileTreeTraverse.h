@@ -18,7 +18,11 @@
  */
 #pragma once
 
+#include <cstdint>
+
 #include <olp/core/geo/Types.h>
+#include <olp/core/geo/tiling/SubTiles.h>
+#include <olp/core/geo/tiling/TileKey.h>
 
 namespace olp {
 namespace geo {
@@ -53,5 +57,39 @@ class CORE_API TileTreeTraverse {
   const ISubdivisionScheme& sub_division_scheme_;
 };
 
+/**
+ * @brief A container of subtiles for a tile with the subdivision scheme
+ * known at compile time.
+ *
+ * The same as `TileTreeTraverse`, but `SubNodes()` is inlined without a
+ * virtual call.
+ *
+ * @tparam SubdivisionScheme The subdivision scheme with a static
+ * `ChildCountAt()` method, like `QuadTreeSubdivisionScheme` and
+ * `HalfQuadTreeSubdivisionScheme`.
+ */
+template <typename SubdivisionScheme>
+class TileTreeTraverseT {
+ public:
+  /// An alias for the tile key.
+  using Node = TileKey;
+  /// An alias for the child tiles.
+  using NodeContainer = SubTiles;
+
+  /**
+   * @brief Creates a container of subtiles for a tile.
+   *
+   * @param node The tile key.
+   *
+   * @return The container of subtiles.
+   */
+  NodeContainer SubNodes(const Node& node) const {
+    const unsigned sub_tile_count =
+        SubdivisionScheme::ChildCountAt(node.Level());
+    const std::uint16_t sub_tile_mask = ~(~0u << sub_tile_count);
+    return NodeContainer(node, 1, sub_tile_mask);
+  }
+};
+
 }  // namespace geo
 }  // namespace olp
@@ -19,15 +19,19 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <olp/core/CoreApi.h>
 #include <olp/core/http/NetworkRequest.h>
 #include <olp/core/http/NetworkResponse.h>
 #include <olp/core/http/NetworkTypes.h>
+#include <olp/core/thread/ThreadAffinity.h>
 
 namespace olp {
 /// Provides a platform specific network abstraction layer.
@@ -60,10 +64,16 @@ class CORE_API Network {
     uint64_t bytes_downloaded{0ull};
     /// The total bytes uploaded, including the size of headers and payload.
     uint64_t bytes_uploaded{0ull};
+    /// The total size of the downloaded payload after the content decoding.
+    /// Compare it with `bytes_downloaded` to see the compression savings.
+    uint64_t bytes_decoded{0ull};
     /// The total number of requests made by network.
     uint32_t total_requests{0u};
     /// The total number of requests that failed.
     uint32_t total_failed{0u};
+    /// The sum of the request timings. Divide them by `total_requests` to get
+    /// the average time of each phase.
+    NetworkTimings timings;
   };
 
   virtual ~Network() = default;
@@ -129,6 +139,150 @@ class CORE_API Network {
    * @return The statistic for the requested bucket.
    */
   virtual Statistics GetStatistics(uint8_t bucket_id = 0);
+
+  /**
+   * @brief Gets the statistics of the tagged requests.
+   *
+   * The requests are tagged with `NetworkRequest::WithTag`. The requests
+   * without a tag are accounted only in the buckets.
+   *
+   * By default, it returns an empty map.
+   *
+   * @return The statistics of each tag that was used.
+   */
+  virtual std::map<std::string, Statistics> GetTaggedStatistics();
+
+  /**
+   * @brief Limits the download and upload rate of the requests sent while
+   * the bucket is current.
+   *
+   * The requests wait in the queue while the bucket is over the limit.
+   * Requires `NetworkInitializationSettings::request_scheduling`, other
+   * networks ignore it.
+   *
+   * @param[in] bucket_id The bucket ID.
+   * @param[in] bytes_per_second The maximum rate, or 0 for no limit.
+   */
+  virtual void SetBandwidthLimit(uint8_t bucket_id, uint64_t bytes_per_second);
+
+  /**
+   * @brief Resolves the hosts of the URLs in the background.
+   *
+   * The resolved addresses are kept in the DNS cache of the network, so the
+   * following requests to these hosts do not wait for the DNS lookup. The
+   * hosts that are already resolved are skipped until their cache entries
+   * expire.
+   *
+   * By default, it does nothing.
+   *
+   * @param[in] urls The URLs which hosts are resolved.
+   */
+  virtual void PreResolve(const std::vector<std::string>& urls);
+
+  /**
+   * @brief Changes the priority of a request that waits in the queue.
+   *
+   * Requires `NetworkInitializationSettings::request_scheduling`, other
+   * networks ignore it. The requests that are already sent keep their
+   * priority.
+   *
+   * @param[in] id The ID of the request.
+   * @param[in] priority The new priority of the request.
+   */
+  virtual void SetPriority(RequestId id, uint32_t priority);
+};
+
+/**
+ * @brief The policy used to distribute the requests between the network
+ * threads.
+ */
+enum class NetworkShardingPolicy : unsigned char {
+  kRoundRobin, /*!< Picks the threads one after another. */
+  kHost /*!< Sends all requests to the same host from one thread, so they
+           share its connections. */
+};
+
+/**
+ * @brief The settings used to create the default `Network` implementation.
+ *
+ * Only `max_requests_count` is used by the platform implementations that do
+ * not use cURL, except WinHTTP, which also uses `worker_count` and
+ * `max_host_connections`, and iOS, which also uses `background_session_id`.
+ */
+struct CORE_API NetworkInitializationSettings {
+  /// The maximum number of requests that can be sent simultaneously.
+  size_t max_requests_count = 30u;
+
+  /// Enables HTTP/2 and multiplexes the parallel requests to the same host
+  /// over a single connection. The requests fall back to HTTP/1.1 if the
+  /// server does not support HTTP/2.
+  bool http2_multiplexing = false;
+
+  /// The maximum number of connections to a single host, or 0 for no limit.
+  /// The requests above the limit wait for a free connection. Also used by
+  /// WinHTTP.
+  size_t max_host_connections = 0u;
+
+  /// The maximum number of simultaneously open connections, or 0 for no
+  /// limit.
+  size_t max_total_connections = 0u;
+
+  /// The maximum number of the idle connections that are kept open for
+  /// reuse, or 0 to use the cURL default.
+  size_t max_cached_connections = 0u;
+
+  /// The number of the network threads. Each thread runs its own event loop
+  /// and handles a part of the requests, so a slow callback of one request
+  /// does not stall the requests on the other threads. The
+  /// `max_requests_count` limit is split between the threads. With WinHTTP,
+  /// it is the number of the threads that complete the requests and run
+  /// their callbacks.
+  size_t worker_count = 1u;
+
+  /// The policy used to distribute the requests between the network threads.
+  NetworkShardingPolicy sharding_policy = NetworkShardingPolicy::kRoundRobin;
+
+  /// The time in seconds the resolved host addresses are kept in the DNS
+  /// cache. The expired hosts are resolved again on the next request or
+  /// `PreResolve` call. Use -1 to keep the addresses forever, or 0 to disable
+  /// the cache.
+  int dns_cache_timeout = 60;
+
+  /// Queues the requests in the network and sends them in the order of
+  /// `NetworkRequest::GetPriority`, so the interactive requests do not wait
+  /// behind the bulk transfers. It also enables `Network::SetBandwidthLimit`.
+  bool request_scheduling = false;
+
+  /// The maximum number of simultaneous requests with the priority below
+  /// `thread::NORMAL`, e.g. prefetch requests, or 0 for no separate limit.
+  /// The rest of `max_requests_count` is kept for the other requests. Only
+  /// used with `request_scheduling`.
+  size_t max_low_priority_requests = 0u;
+
+  /// The maximum number of simultaneous requests to the same host, or 0 for
+  /// no separate limit. A slow host, e.g. the blob service during a large
+  /// download, then cannot take every slot from the requests to the other
+  /// services. Unlike `max_host_connections`, the waiting requests are sent
+  /// in the priority order. Only used with `request_scheduling`.
+  size_t max_requests_per_host = 0u;
+
+  /// The maximum time the requests with the priority below `thread::NORMAL`,
+  /// e.g. prefetch, cache refresh and telemetry requests, are held back, or 0
+  /// to send them right away. The held back requests are sent together in a
+  /// burst, or along with the next request of a higher priority, so the
+  /// mobile radio is woken up less often. Only used with
+  /// `request_scheduling`.
+  std::chrono::milliseconds low_priority_batching_interval{0};
+
+  /// The CPUs the cURL event loop threads run on. With `pin_each_thread`,
+  /// every one of the `worker_count` threads gets its own CPU.
+  thread::ThreadAffinitySettings event_loop_affinity;
+
+  /// The identifier of the iOS background URL session that downloads the
+  /// requests with `NetworkSettings::GetBackgroundDownload`, or empty to send
+  /// them in the regular session. The identifier must be unique in the
+  /// application. Only used on iOS.
+  std::string background_session_id;
 };
 
 /**
@@ -137,5 +291,13 @@ class CORE_API Network {
 CORE_API std::shared_ptr<Network> CreateDefaultNetwork(
     size_t max_requests_count);
 
+/**
+ * @brief Creates a default `Network` implementation.
+ *
+ * @param[in] settings The network initialization settings.
+ */
+CORE_API std::shared_ptr<Network> CreateDefaultNetwork(
+    NetworkInitializationSettings settings);
+
 }  // namespace http
 }  // namespace olp
@@ -19,13 +19,16 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include <olp/core/CoreApi.h>
 #include <olp/core/http/NetworkSettings.h>
+#include <olp/core/thread/TaskScheduler.h>
 
 namespace olp {
 namespace http {
@@ -38,6 +41,26 @@ class CORE_API NetworkRequest final {
   /// The short type alias for the HTTP request body.
   using RequestBodyType = std::shared_ptr<const std::vector<std::uint8_t>>;
 
+  /**
+   * @brief Reads a part of the request body.
+   *
+   * The callback is called on the network thread and can be called again
+   * with an already read offset if the body is sent again, e.g. on redirect.
+   *
+   * @param[in] offset The offset in the body to read from.
+   * @param[out] buffer The buffer to read the data to.
+   * @param[in] size The size of the buffer.
+   *
+   * @return The number of bytes read, 0 at the end of the body, or a negative
+   * value if the body cannot be read and the request must fail.
+   */
+  using BodySourceCallback = std::function<std::int64_t(
+      std::uint64_t offset, std::uint8_t* buffer, std::size_t size)>;
+
+  /// The size of the body source with an unknown size. Such bodies are sent
+  /// with the chunked transfer encoding.
+  static const std::int64_t kUnknownBodySize;
+
   /// The HTTP method, as specified at https://tools.ietf.org/html/rfc2616.
   enum class HttpVerb {
     GET = 0,     ///< The GET method (RFC2616, section-9.3).
@@ -129,6 +152,47 @@ class CORE_API NetworkRequest final {
    */
   NetworkRequest& WithBody(RequestBodyType body);
 
+  /**
+   * @brief Gets the callback that streams the request body.
+   *
+   * @return The body source callback, or an empty callback if the body is set
+   * with `WithBody`.
+   */
+  const BodySourceCallback& GetBodySource() const;
+
+  /**
+   * @brief Gets the size of the body streamed by the body source.
+   *
+   * @return The body size or `kUnknownBodySize`.
+   */
+  std::int64_t GetBodySourceSize() const;
+
+  /**
+   * @brief Sets the callback that streams the request body.
+   *
+   * Use it to send large bodies without keeping them in memory. The body
+   * source takes precedence over the body set with `WithBody`.
+   *
+   * @param[in] source The body source callback.
+   * @param[in] size The body size, or `kUnknownBodySize`.
+   *
+   * @return A reference to *this.
+   */
+  NetworkRequest& WithBodySource(BodySourceCallback source,
+                                 std::int64_t size = kUnknownBodySize);
+
+  /**
+   * @brief Streams the request body from a file.
+   *
+   * The file is opened when the method is called and stays open until the
+   * request is destroyed. If the file cannot be opened, the request fails.
+   *
+   * @param[in] path The path to the file.
+   *
+   * @return A reference to *this.
+   */
+  NetworkRequest& WithBodyFile(const std::string& path);
+
   /**
    * @brief Gets the network settings for this request.
    *
@@ -145,6 +209,48 @@ class CORE_API NetworkRequest final {
    */
   NetworkRequest& WithSettings(NetworkSettings settings);
 
+  /**
+   * @brief Gets the priority of the request.
+   *
+   * @return The request priority.
+   */
+  uint32_t GetPriority() const;
+
+  /**
+   * @brief Sets the priority of the request.
+   *
+   * The network that schedules the requests sends the requests with higher
+   * priority first. The other implementations ignore it.
+   *
+   * @param[in] priority The request priority, uses the same values as
+   * `thread::Priority`.
+   *
+   * @return A reference to *this.
+   */
+  NetworkRequest& WithPriority(uint32_t priority);
+
+  /**
+   * @brief Gets the traffic accounting tag of the request.
+   *
+   * @return The request tag, or an empty string if the request has no tag.
+   */
+  const std::string& GetTag() const;
+
+  /**
+   * @brief Sets the traffic accounting tag of the request.
+   *
+   * The default network aggregates the statistics of the requests with the
+   * same tag, see `Network::GetTaggedStatistics`. Unlike the statistics
+   * buckets, the tag belongs to the request, so the concurrent callers are
+   * accounted separately. Compose the tag from the parts that you want to
+   * group by, for example, `"<component>/<layer>/<billing tag>"`.
+   *
+   * @param[in] tag The request tag.
+   *
+   * @return A reference to *this.
+   */
+  NetworkRequest& WithTag(std::string tag);
+
  private:
   /// The HTTP request method.
   HttpVerb verb_{HttpVerb::GET};
@@ -154,8 +260,16 @@ class CORE_API NetworkRequest final {
   Headers headers_;
   /// The body of the HTTP request.
   RequestBodyType body_;
+  /// The callback that streams the body of the HTTP request.
+  BodySourceCallback body_source_;
+  /// The size of the body streamed by `body_source_`.
+  std::int64_t body_source_size_{kUnknownBodySize};
   /// The network settings for this request.
   NetworkSettings settings_{};
+  /// The priority of the request.
+  uint32_t priority_{thread::NORMAL};
+  /// The traffic accounting tag of the request.
+  std::string tag_;
 };
 
 }  // namespace http
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include <olp/core/CoreApi.h>
@@ -26,6 +27,27 @@
 
 namespace olp {
 namespace http {
+
+/**
+ * @brief The time spent in the phases of the network request.
+ *
+ * The phases that were skipped are zero, e.g. the DNS lookup, the connection,
+ * and the TLS handshake when an open connection is reused.
+ */
+struct CORE_API NetworkTimings {
+  /// The duration of the DNS lookup.
+  std::chrono::microseconds dns{0};
+  /// The duration of the TCP connection setup.
+  std::chrono::microseconds connect{0};
+  /// The duration of the TLS handshake.
+  std::chrono::microseconds tls{0};
+  /// The time from the start of the request until the first response byte.
+  /// Subtract the durations above to get the time spent on the server.
+  std::chrono::microseconds time_to_first_byte{0};
+  /// The total time of the request, including the redirects.
+  std::chrono::microseconds total{0};
+};
+
 /**
  * @brief A network response abstraction for the HTTP request.
  */
@@ -126,6 +148,41 @@ class CORE_API NetworkResponse final {
    */
   NetworkResponse& WithBytesDownloaded(uint64_t bytes_downloaded);
 
+  /**
+   * @brief Gets the size of the response payload after the content decoding.
+   *
+   * Unlike `GetBytesDownloaded`, it does not include the headers and equals
+   * the payload size on the wire if the response is not compressed.
+   *
+   * @return The number of the decoded payload bytes.
+   */
+  uint64_t GetBytesDecoded() const;
+
+  /**
+   * @brief Sets the size of the response payload after the content decoding.
+   *
+   * @param[in] bytes_decoded The number of the decoded payload bytes.
+   *
+   * @return A reference to *this.
+   */
+  NetworkResponse& WithBytesDecoded(uint64_t bytes_decoded);
+
+  /**
+   * @brief Gets the time spent in the phases of the network request.
+   *
+   * @return The request timings.
+   */
+  const NetworkTimings& GetTimings() const;
+
+  /**
+   * @brief Sets the time spent in the phases of the network request.
+   *
+   * @param[in] timings The request timings.
+   *
+   * @return A reference to *this.
+   */
+  NetworkResponse& WithTimings(NetworkTimings timings);
+
  private:
   /// The associated request ID.
   RequestId request_id_{0};
@@ -137,6 +194,10 @@ class CORE_API NetworkResponse final {
   uint64_t bytes_uploaded_;
   /// The number of bytes downloaded during the network request.
   uint64_t bytes_downloaded_;
+  /// The number of the decoded payload bytes.
+  uint64_t bytes_decoded_{0};
+  /// The time spent in the phases of the network request.
+  NetworkTimings timings_;
 };
 
 }  // namespace http
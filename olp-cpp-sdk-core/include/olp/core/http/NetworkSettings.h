@@ -21,6 +21,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include <olp/core/CoreApi.h>
 #include <olp/core/http/NetworkProxySettings.h>
@@ -98,6 +99,121 @@ class CORE_API NetworkSettings final {
    */
   NetworkSettings& WithProxySettings(NetworkProxySettings settings);
 
+  /**
+   * @brief Gets the TCP keep-alive idle time in seconds.
+   *
+   * @return The time the connection stays idle before the keep-alive probes
+   * are sent.
+   */
+  int GetTcpKeepAliveIdle() const;
+
+  /**
+   * @brief Sets the TCP keep-alive idle time in seconds.
+   *
+   * The keep-alive probes keep the idle connections open, so that they can be
+   * reused by the next requests to the same host without a new TLS handshake.
+   *
+   * @param[in] idle The time the connection stays idle before the keep-alive
+   * probes are sent. Set it to 0 to disable the keep-alive probes.
+   *
+   * @return A reference to *this.
+   */
+  NetworkSettings& WithTcpKeepAliveIdle(int idle);
+
+  /**
+   * @brief Gets the interval between the TCP keep-alive probes in seconds.
+   *
+   * @return The interval between the TCP keep-alive probes in seconds.
+   */
+  int GetTcpKeepAliveInterval() const;
+
+  /**
+   * @brief Sets the interval between the TCP keep-alive probes in seconds.
+   *
+   * @param[in] interval The interval between the TCP keep-alive probes in
+   * seconds.
+   *
+   * @return A reference to *this.
+   */
+  NetworkSettings& WithTcpKeepAliveInterval(int interval);
+
+  /**
+   * @brief Gets the content encodings accepted for the response.
+   *
+   * @return The value of the `Accept-Encoding` header, or an empty string for
+   * the platform default.
+   */
+  const std::string& GetAcceptEncoding() const;
+
+  /**
+   * @brief Sets the content encodings accepted for the response.
+   *
+   * The compressed responses are decoded by the network implementation, so
+   * the payload and the data callback always receive the decoded data. Only
+   * the encodings supported by the platform can be used, e.g. `gzip` and
+   * `deflate` with cURL built with zlib, and `br` with cURL built with
+   * brotli. Use `identity` to disable the compression.
+   *
+   * By default, cURL and WinHttp accept all the encodings they support.
+   * Android accepts either the `HttpURLConnection` default `gzip` or
+   * `identity`. iOS always uses the `NSURLSession` defaults.
+   *
+   * @param[in] encodings The value of the `Accept-Encoding` header, e.g.
+   * "gzip, br", or an empty string for the platform default.
+   *
+   * @return A reference to *this.
+   */
+  NetworkSettings& WithAcceptEncoding(std::string encodings);
+
+  /**
+   * @brief Checks whether the response is downloaded in the background.
+   *
+   * @return True if the response is downloaded in the background; false
+   * otherwise.
+   */
+  bool GetBackgroundDownload() const;
+
+  /**
+   * @brief Downloads the response in the background.
+   *
+   * The response is written to a temporary file while the transfer runs, and
+   * the file is passed to the payload and the data callback in large blocks
+   * when the download completes. The download continues while the
+   * application is suspended.
+   *
+   * Only used on iOS for the `GET` requests without a proxy, when the network
+   * is created with `NetworkInitializationSettings::background_session_id`.
+   * The other requests are sent as usual.
+   *
+   * @param[in] background_download True to download the response in the
+   * background.
+   *
+   * @return A reference to *this.
+   */
+  NetworkSettings& WithBackgroundDownload(bool background_download);
+
+  /**
+   * @brief Gets the names of the response headers passed to the header
+   * callback.
+   *
+   * @return The header names, or an empty list if all the headers are passed.
+   */
+  const std::vector<std::string>& GetResponseHeaderFilter() const;
+
+  /**
+   * @brief Passes only the listed response headers to the header callback.
+   *
+   * The names are compared case-insensitively. The cURL backend skips the
+   * other headers before creating their strings, so the responses with many
+   * headers cost less when only a few of them are used.
+   *
+   * @param[in] names The header names, or an empty list to pass all the
+   * headers.
+   *
+   * @return A reference to *this.
+   */
+  NetworkSettings& WithResponseHeaderFilter(std::vector<std::string> names);
+
  private:
   /// The maximum number of retries for the HTTP request.
   std::size_t retries_{3};
@@ -107,6 +223,16 @@ class CORE_API NetworkSettings final {
   int transfer_timeout_{30};
   /// The network proxy settings.
   NetworkProxySettings proxy_settings_;
+  /// The TCP keep-alive idle time in seconds.
+  int tcp_keep_alive_idle_{120};
+  /// The interval between the TCP keep-alive probes in seconds.
+  int tcp_keep_alive_interval_{60};
+  /// The accepted content encodings.
+  std::string accept_encoding_;
+  /// Downloads the response in the background.
+  bool background_download_{false};
+  /// The response headers passed to the header callback, empty for all.
+  std::vector<std::string> response_header_filter_;
 };
 
 }  // namespace http
@@ -21,6 +21,7 @@
 
 #include <string>
 
+#include <olp/core/http/NetworkRequest.h>
 #include <olp/core/http/NetworkTypes.h>
 
 namespace olp {
@@ -96,6 +97,42 @@ class CORE_API NetworkUtils {
    * @return The user agent or an empty string if there is no user agent.
    */
   static std::string ExtractUserAgent(Headers& headers);
+
+  /**
+   * @brief Gets the host part of the URL.
+   *
+   * @param url The URL.
+   *
+   * @return The host with the port, or the part of the URL before the path if
+   * the URL has no scheme.
+   */
+  static std::string GetHost(const std::string& url);
+
+  /**
+   * @brief Reads the whole request body.
+   *
+   * Used by the platform implementations that cannot stream the body from
+   * the body source.
+   *
+   * @param request The request.
+   * @param body The request body, or nullptr if the body source fails.
+   *
+   * @return True if the body is read; false otherwise.
+   */
+  static bool ReadBody(const NetworkRequest& request,
+                       NetworkRequest::RequestBodyType& body);
+
+  /**
+   * @brief Replaces the body source of the request with the body it reads.
+   *
+   * Does nothing if the request has no body source.
+   *
+   * @param request The request.
+   *
+   * @return True if the request has no body source or the body is read;
+   * false otherwise.
+   */
+  static bool BufferBodySource(NetworkRequest& request);
 };  // The `NetworkUtils` class.
 
 /**
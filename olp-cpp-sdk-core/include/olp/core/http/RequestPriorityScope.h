@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <olp/core/CoreApi.h>
+#include <olp/core/http/NetworkTypes.h>
+
+namespace olp {
+namespace http {
+
+class Network;
+
+/**
+ * @brief A request priority that can be raised while the requests sent with
+ * it wait in the network queue.
+ *
+ * `OlpClient` registers the requests that it sends in a `RequestPriorityScope`
+ * of the handle, and `Promote` changes their priority with
+ * `Network::SetPriority`. It lets a request that waits for the result of a
+ * low priority task raise the priority of that task.
+ */
+class CORE_API RequestPriorityHandle final {
+ public:
+  /**
+   * @brief Creates the `RequestPriorityHandle` instance.
+   *
+   * @param[in] priority The initial priority, uses the same values as
+   * `thread::Priority`.
+   */
+  explicit RequestPriorityHandle(uint32_t priority);
+
+  RequestPriorityHandle(const RequestPriorityHandle&) = delete;
+  RequestPriorityHandle& operator=(const RequestPriorityHandle&) = delete;
+
+  /**
+   * @brief Gets the current priority.
+   *
+   * @return The initial priority, or the highest promoted one.
+   */
+  uint32_t GetPriority() const;
+
+  /**
+   * @brief Raises the priority of the handle and of its queued requests.
+   *
+   * The priorities lower than the current one are ignored.
+   *
+   * @param[in] priority The new priority.
+   */
+  void Promote(uint32_t priority);
+
+  /**
+   * @brief Registers a sent request, so it is promoted with the handle.
+   *
+   * @param[in] network The network that sent the request.
+   * @param[in] id The ID of the request.
+   * @param[in] priority The priority that the request was sent with.
+   *
+   * @return The key of the registration for `RemoveRequest`.
+   */
+  uint64_t AddRequest(std::shared_ptr<Network> network, RequestId id,
+                      uint32_t priority);
+
+  /**
+   * @brief Removes the registration of a completed request.
+   *
+   * @param[in] key The key returned by `AddRequest`.
+   */
+  void RemoveRequest(uint64_t key);
+
+ private:
+  struct SentRequest {
+    std::shared_ptr<Network> network;
+    RequestId id;
+  };
+
+  mutable std::mutex mutex_;
+  uint32_t priority_;
+  uint64_t next_key_{0u};
+  std::map<uint64_t, SentRequest> requests_;
+};
+
+/**
+ * @brief Sets the priority of the network requests created on the current
+ * thread while the scope is alive.
+ *
+ * `OlpClient` applies the current priority to the requests it sends, so the
+ * tasks scheduled with a priority send their requests with the same priority.
+ * The scopes can be nested, the previous priority is restored on destruction.
+ */
+class CORE_API RequestPriorityScope final {
+ public:
+  /**
+   * @brief Sets the priority of the current thread.
+   *
+   * @param[in] priority The request priority, uses the same values as
+   * `thread::Priority`.
+   */
+  explicit RequestPriorityScope(uint32_t priority);
+
+  /**
+   * @brief Sets the priority handle of the current thread.
+   *
+   * The requests get the current priority of the handle and are registered
+   * with it.
+   *
+   * @param[in] handle The priority handle.
+   */
+  explicit RequestPriorityScope(std::shared_ptr<RequestPriorityHandle> handle);
+
+  /**
+   * @brief Restores the previous priority of the current thread.
+   */
+  ~RequestPriorityScope();
+
+  RequestPriorityScope(const RequestPriorityScope&) = delete;
+  RequestPriorityScope& operator=(const RequestPriorityScope&) = delete;
+
+  /**
+   * @brief Gets the priority of the current thread.
+   *
+   * @return The priority of the innermost scope, or `thread::NORMAL` if
+   * there is none.
+   */
+  static uint32_t GetCurrentPriority();
+
+  /**
+   * @brief Gets the priority handle of the current thread.
+   *
+   * @return The handle of the innermost scope, or null if that scope has no
+   * handle.
+   */
+  static std::shared_ptr<RequestPriorityHandle> GetCurrentHandle();
+
+ private:
+  uint32_t previous_priority_;
+  const std::shared_ptr<RequestPriorityHandle>* previous_handle_;
+  std::shared_ptr<RequestPriorityHandle> handle_;
+};
+
+}  // namespace http
+}  // namespace olp
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <olp/core/CoreApi.h>
+#include <olp/core/logging/Appender.h>
+
+namespace olp {
+namespace logging {
+/**
+ * @brief Appender for writing compact binary records to a memory-mapped file.
+ *
+ * The messages are not formatted as text. Each record holds the time, the
+ * thread ID, the level, the message, and the IDs of the tag, the file and
+ * the function. The names behind the IDs are written once, when they are
+ * first used. The file grows as needed, and, as it is memory-mapped, the
+ * records written before a crash are kept.
+ *
+ * Use `decode` or the `log-decoder` tool to read the file.
+ */
+class CORE_API BinaryFileAppender : public IAppender {
+ public:
+  /**
+   * @brief Constructs a binary file appender.
+   *
+   * The file is replaced if it exists.
+   *
+   * @param fileName The name of the file to write to.
+   * @param capacity The initial size of the file in bytes.
+   */
+  explicit BinaryFileAppender(const std::string& fileName,
+                              std::size_t capacity = 16u * 1024u * 1024u);
+
+  /// Unmaps the file and truncates it to the written records.
+  ~BinaryFileAppender() override;
+
+  /**
+   * @brief Returns whether or not the file is mapped and can be written to.
+   * @return True if this is valid.
+   */
+  bool isValid() const;
+
+  /**
+   * @brief Gets the name of the file this was created with.
+   * @return The file name.
+   */
+  inline const std::string& getFileName() const;
+
+  IAppender& append(const LogMessage& message) override;
+
+  /**
+   * @brief Reads the messages of a file written by `BinaryFileAppender`.
+   *
+   * @param fileName The name of the file to read.
+   * @param callback Called for every message in the written order. The
+   * strings of the message are valid only during the call.
+   *
+   * @return False if the file cannot be read or is not a binary log file.
+   */
+  static bool decode(const std::string& fileName,
+                     const std::function<void(const LogMessage&)>& callback);
+
+ private:
+  class MappedFile;
+
+  std::uint32_t getTagId(const char* tag);
+  std::uint32_t getNameId(const char* name);
+  void writeName(std::uint32_t id, const char* name, std::size_t size);
+  char* reserve(std::size_t size);
+
+  std::string m_fileName;
+  std::unique_ptr<MappedFile> m_file;
+  std::size_t m_offset;
+  std::unordered_map<std::string, std::uint32_t> m_tagIds;
+  std::unordered_map<const char*, std::uint32_t> m_nameIds;
+  std::uint32_t m_nextId;
+
+  BinaryFileAppender(const BinaryFileAppender&) = delete;
+  BinaryFileAppender& operator=(const BinaryFileAppender&) = delete;
+};
+
+inline const std::string& BinaryFileAppender::getFileName() const {
+  return m_fileName;
+}
+
+}  // namespace logging
+}  // namespace olp
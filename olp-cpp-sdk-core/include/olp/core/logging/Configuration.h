@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -66,6 +67,17 @@ class CORE_API Configuration {
    */
   using AppenderList = std::vector<AppenderWithLogLevel>;
 
+  /**
+   * @brief What the asynchronous logging does when its queue is full.
+   */
+  enum class OverflowPolicy {
+    /// The logging thread waits until the queue has space for the message.
+    Block,
+    /// The message is dropped, and the number of the dropped messages is
+    /// reported later as a warning.
+    Drop
+  };
+
   /**
    * @brief Creates a default configuration by adding the DebugAppender and the
    * ConsoleAppender as appenders.
@@ -99,8 +111,35 @@ class CORE_API Configuration {
    */
   inline const AppenderList& getAppenders() const;
 
+  /**
+   * @brief Enables the asynchronous logging.
+   *
+   * The messages are queued, and a background thread writes them to the
+   * appenders, so the logging threads do not wait for the appenders.
+   *
+   * @param queueSize The maximum number of the queued messages, rounded up to
+   * a power of two, or 0 to write the messages synchronously.
+   * @param policy What to do when the queue is full.
+   */
+  inline Configuration& setAsync(std::size_t queueSize,
+                                 OverflowPolicy policy = OverflowPolicy::Drop);
+
+  /**
+   * @brief Gets the size of the asynchronous logging queue.
+   * @return The queue size, or 0 if the messages are written synchronously.
+   */
+  inline std::size_t getAsyncQueueSize() const;
+
+  /**
+   * @brief Gets what the asynchronous logging does when its queue is full.
+   * @return The overflow policy.
+   */
+  inline OverflowPolicy getOverflowPolicy() const;
+
  private:
   AppenderList m_appenders;
+  std::size_t m_asyncQueueSize{0};
+  OverflowPolicy m_overflowPolicy{OverflowPolicy::Drop};
 };
 
 inline bool Configuration::isValid() const { return !m_appenders.empty(); }
@@ -123,5 +162,20 @@ inline auto Configuration::getAppenders() const -> const AppenderList& {
   return m_appenders;
 }
 
+inline Configuration& Configuration::setAsync(std::size_t queueSize,
+                                              OverflowPolicy policy) {
+  m_asyncQueueSize = queueSize;
+  m_overflowPolicy = policy;
+  return *this;
+}
+
+inline std::size_t Configuration::getAsyncQueueSize() const {
+  return m_asyncQueueSize;
+}
+
+inline auto Configuration::getOverflowPolicy() const -> OverflowPolicy {
+  return m_overflowPolicy;
+}
+
 }  // namespace logging
 }  // namespace olp
@@ -19,7 +19,10 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <fstream>
+#include <functional>
 #include <string>
 #include <utility>
 
@@ -31,9 +34,28 @@ namespace olp {
 namespace logging {
 /**
  * @brief Appender for printing to a file.
+ *
+ * The file can be rotated when it reaches a size or an age. The current file
+ * is then renamed to `<file name>.1`, the older backups are shifted to the
+ * next index, and the backups beyond the maximum count are removed. The
+ * rotated file can be compressed with a user-provided function.
+ *
+ * By default, every message is written and flushed immediately. With a write
+ * buffer, the messages are flushed when the buffer is full or the flush
+ * interval has passed. Both are checked when a message is appended.
  */
 class CORE_API FileAppender : public IAppender {
  public:
+  /**
+   * @brief Compresses a rotated file.
+   *
+   * It is called with the path of the rotated file and the path to write the
+   * compressed file to, and returns true on success. The rotated file is then
+   * removed.
+   */
+  using Compressor =
+      std::function<bool(const std::string& from, const std::string& to)>;
+
   /**
    * @brief Constructs a file appender.
    * @param fileName The name of the file to write to.
@@ -75,14 +97,106 @@ class CORE_API FileAppender : public IAppender {
    */
   inline FileAppender& setMessageFormatter(MessageFormatter formatter);
 
+  /**
+   * @brief Sets the size after which the file is rotated.
+   * @param bytes The maximum file size in bytes, or 0 to not rotate by size.
+   */
+  inline FileAppender& setMaxFileSize(std::size_t bytes);
+
+  /**
+   * @brief Gets the size after which the file is rotated.
+   * @return The maximum file size in bytes, or 0 if not rotated by size.
+   */
+  inline std::size_t getMaxFileSize() const;
+
+  /**
+   * @brief Sets the time after which the file is rotated.
+   * @param interval The maximum age of the file, or 0 to not rotate by time.
+   */
+  inline FileAppender& setRotationInterval(std::chrono::seconds interval);
+
+  /**
+   * @brief Gets the time after which the file is rotated.
+   * @return The maximum age of the file, or 0 if not rotated by time.
+   */
+  inline std::chrono::seconds getRotationInterval() const;
+
+  /**
+   * @brief Sets the number of the rotated files to keep.
+   * @param count The number of the backups, or 0 to discard the rotated file.
+   */
+  inline FileAppender& setMaxBackupFiles(std::size_t count);
+
+  /**
+   * @brief Gets the number of the rotated files to keep.
+   * @return The number of the backups.
+   */
+  inline std::size_t getMaxBackupFiles() const;
+
+  /**
+   * @brief Sets the function that compresses the rotated files.
+   * @param compressor The compression function, or nullptr to not compress.
+   * @param extension The extension added to the name of the compressed file,
+   * for example, ".gz".
+   */
+  inline FileAppender& setCompressor(Compressor compressor,
+                                     std::string extension);
+
+  /**
+   * @brief Sets the size of the write buffer.
+   * @param bytes The buffer size in bytes, or 0 to flush every message.
+   */
+  inline FileAppender& setBufferSize(std::size_t bytes);
+
+  /**
+   * @brief Gets the size of the write buffer.
+   * @return The buffer size in bytes, or 0 if every message is flushed.
+   */
+  inline std::size_t getBufferSize() const;
+
+  /**
+   * @brief Sets how long the buffered messages can wait to be written.
+   * @param interval The flush interval.
+   */
+  inline FileAppender& setFlushInterval(std::chrono::milliseconds interval);
+
+  /**
+   * @brief Gets how long the buffered messages can wait to be written.
+   * @return The flush interval.
+   */
+  inline std::chrono::milliseconds getFlushInterval() const;
+
+  /**
+   * @brief Writes the buffered messages to the file.
+   */
+  void flush();
+
   IAppender& append(const LogMessage& message) override;
 
  private:
+  using Clock = std::chrono::steady_clock;
+
+  void rotate(Clock::time_point now);
+  std::string getBackupName(std::size_t index) const;
+
   std::string m_fileName;
   bool m_appendFile;
   MessageFormatter m_formatter;
   std::ofstream m_stream;
 
+  std::size_t m_maxFileSize{0};
+  std::chrono::seconds m_rotationInterval{0};
+  std::size_t m_maxBackupFiles{5};
+  Compressor m_compressor;
+  std::string m_compressedExtension;
+  std::size_t m_bufferSize{0};
+  std::chrono::milliseconds m_flushInterval{1000};
+
+  std::string m_buffer;
+  std::size_t m_fileSize{0};
+  Clock::time_point m_openedAt;
+  Clock::time_point m_flushedAt;
+
   FileAppender(const FileAppender&) = delete;
   FileAppender& operator=(const FileAppender&) = delete;
 };
@@ -103,5 +217,57 @@ inline FileAppender& FileAppender::setMessageFormatter(
   return *this;
 }
 
+inline FileAppender& FileAppender::setMaxFileSize(std::size_t bytes) {
+  m_maxFileSize = bytes;
+  return *this;
+}
+
+inline std::size_t FileAppender::getMaxFileSize() const {
+  return m_maxFileSize;
+}
+
+inline FileAppender& FileAppender::setRotationInterval(
+    std::chrono::seconds interval) {
+  m_rotationInterval = interval;
+  return *this;
+}
+
+inline std::chrono::seconds FileAppender::getRotationInterval() const {
+  return m_rotationInterval;
+}
+
+inline FileAppender& FileAppender::setMaxBackupFiles(std::size_t count) {
+  m_maxBackupFiles = count;
+  return *this;
+}
+
+inline std::size_t FileAppender::getMaxBackupFiles() const {
+  return m_maxBackupFiles;
+}
+
+inline FileAppender& FileAppender::setCompressor(Compressor compressor,
+                                                 std::string extension) {
+  m_compressor = std::move(compressor);
+  m_compressedExtension = std::move(extension);
+  return *this;
+}
+
+inline FileAppender& FileAppender::setBufferSize(std::size_t bytes) {
+  m_bufferSize = bytes;
+  return *this;
+}
+
+inline std::size_t FileAppender::getBufferSize() const { return m_bufferSize; }
+
+inline FileAppender& FileAppender::setFlushInterval(
+    std::chrono::milliseconds interval) {
+  m_flushInterval = interval;
+  return *this;
+}
+
+inline std::chrono::milliseconds FileAppender::getFlushInterval() const {
+  return m_flushInterval;
+}
+
 }  // namespace logging
 }  // namespace olp
@@ -49,6 +49,32 @@
 #define OLP_SDK_LOG_FUNCTION_SIGNATURE __FUNCTION__
 #endif
 
+/**
+ * @brief The lowest log level that is compiled in, as the integer value of
+ * `olp::logging::Level`.
+ *
+ * The `OLP_SDK_LOG_*` statements below this level are removed by the
+ * compiler, including the evaluation of their messages. Defaults to
+ * `Level::Trace`, or to `Level::Info` if `LOGGING_DISABLE_DEBUG_LEVEL` is
+ * defined.
+ */
+#ifndef OLP_SDK_LOG_MIN_LEVEL
+#ifdef LOGGING_DISABLE_DEBUG_LEVEL
+#define OLP_SDK_LOG_MIN_LEVEL 2
+#else
+#define OLP_SDK_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+/**
+ * @brief Checks whether the log statements of a level are compiled in.
+ *
+ * It is a macro and not a function, so the translation units built with
+ * different `OLP_SDK_LOG_MIN_LEVEL` values do not share its definition.
+ */
+#define OLP_SDK_LOG_IS_COMPILED_IN(level) \
+  (static_cast<int>(level) >= OLP_SDK_LOG_MIN_LEVEL)
+
 /**
  * @brief Log a message using C++ style streams.
  *
@@ -244,7 +270,8 @@
  */
 #define OLP_SDK_LOG(level, tag, message)              \
   do {                                                \
-    if (::olp::logging::Log::isEnabled(level, tag)) { \
+    if (OLP_SDK_LOG_IS_COMPILED_IN(level) &&          \
+        ::olp::logging::Log::isEnabled(level, tag)) { \
       OLP_SDK_DO_LOG(level, tag, message);            \
     }                                                 \
   }                                                   \
@@ -325,7 +352,8 @@
  */
 #define OLP_SDK_LOG_F(level, tag, ...)                \
   do {                                                \
-    if (::olp::logging::Log::isEnabled(level, tag)) { \
+    if (OLP_SDK_LOG_IS_COMPILED_IN(level) &&          \
+        ::olp::logging::Log::isEnabled(level, tag)) { \
       OLP_SDK_DO_LOG_F(level, tag, __VA_ARGS__);      \
     }                                                 \
   }                                                   \
@@ -493,6 +521,19 @@ class CORE_API Log {
    */
   static bool isEnabled(Level level, const std::string& tag);
 
+  /**
+   * @brief Returns whether or not a log tag is enabled for a specific level.
+   *
+   * The tag is registered on the first call, the later calls with the same
+   * tag string check its level without the lock, so it is meant for the
+   * static tags, like the string literals.
+   *
+   * @param tag Tag for the logging component.
+   * @param level The log level.
+   * @return Whether or not the log is enabled.
+   */
+  static bool isEnabled(Level level, const char* tag);
+
   /**
    * @brief Logs a message to the registered appenders. Outputting to a specific
    * appender is dependant on whether the appender is enabled for this specific
@@ -509,6 +550,15 @@ class CORE_API Log {
                          const std::string& message, const char* file,
                          unsigned int line, const char* function,
                          const char* fullFunction);
+
+  /**
+   * @brief Waits until the messages logged so far are written to the
+   * appenders.
+   *
+   * Only the asynchronous logging queues the messages, see
+   * `Configuration::setAsync`. Otherwise, the messages are already written.
+   */
+  static void flush();
 };
 
 }  // namespace logging
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace thread {
+
+/**
+ * @brief A bounded lock-free multi-producer multi-consumer FIFO queue with
+ * the `SyncQueue` interface.
+ *
+ * The elements are stored in a ring buffer, and `Push` and `Pull` do not take
+ * a lock while the queue is neither empty nor full, so it scales better than
+ * `SyncQueueFifo` with many producers. `Push` waits while the queue is full,
+ * and `Pull` sleeps while the queue is empty. Use it when the elements do not
+ * need priorities.
+ *
+ * @tparam T The queue item that should be stored inside the buffer.
+ */
+template <typename T>
+class CORE_API LockFreeSyncQueue final {
+ public:
+  /**
+   * @brief Creates the `LockFreeSyncQueue` instance.
+   *
+   * @param capacity The maximum number of the queued elements. It is rounded
+   * up to a power of two.
+   */
+  explicit LockFreeSyncQueue(size_t capacity = 1024u);
+  ~LockFreeSyncQueue();
+
+  /// Non-copyable, non-movable
+  LockFreeSyncQueue(const LockFreeSyncQueue&) = delete;
+  /// Non-copyable, non-movable
+  LockFreeSyncQueue& operator=(const LockFreeSyncQueue&) = delete;
+  /// Non-copyable, non-movable
+  LockFreeSyncQueue(LockFreeSyncQueue&&) = delete;
+  /// Non-copyable, non-movable
+  LockFreeSyncQueue& operator=(LockFreeSyncQueue&&) = delete;
+
+  /**
+   * @brief Checks whether this `LockFreeSyncQueue` instance is empty.
+   *
+   * @return True if this `LockFreeSyncQueue` instance is empty; false
+   * otherwise.
+   */
+  bool Empty() const;
+
+  /**
+   * @brief Closes this `LockFreeSyncQueue` instance, deletes all the queued
+   * elements, and blocks you from pulling any elements from the queue.
+   */
+  void Close();
+
+  /**
+   * @brief Pulls one element from the `LockFreeSyncQueue` instance.
+   *
+   * @param element The element pulled from the queue.
+   *
+   * @return True if the pull was successful; false if the `LockFreeSyncQueue`
+   * instance was closed. Once closed, the `LockFreeSyncQueue` instance does
+   * not open again.
+   */
+  bool Pull(T& element);
+
+  /**
+   * @brief Forwards the passed element into the `LockFreeSyncQueue` instance.
+   *
+   * @param element The rvalue reference to the element.
+   */
+  void Push(T&& element);
+
+  /**
+   * @brief Copies the passed element into the `LockFreeSyncQueue` instance.
+   *
+   * @param element The const lvalue reference to the element.
+   */
+  void Push(const T& element);
+
+  /**
+   * @brief Forwards the passed element into the `LockFreeSyncQueue` instance
+   * unless the queue is full or closed.
+   *
+   * @param element The rvalue reference to the element. It is not moved from
+   * if the push fails.
+   *
+   * @return True if the element was pushed; false otherwise.
+   */
+  bool TryPush(T&& element);
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  /// The cache line size, keeps the positions on separate lines.
+  static constexpr size_t kCacheLineSize = 64u;
+
+  bool TryEnqueue(T&& element);
+  bool TryPull(T& element);
+  void NotifyPush();
+
+  /// The ring buffer.
+  std::unique_ptr<Cell[]> buffer_;
+  const size_t mask_;
+  /// The position of the next pushed element.
+  alignas(kCacheLineSize) std::atomic<size_t> push_position_;
+  /// The position of the next pulled element.
+  alignas(kCacheLineSize) std::atomic<size_t> pull_position_;
+  /// Marks this queue as closed.
+  alignas(kCacheLineSize) std::atomic<bool> closed_;
+  /// The number of threads sleeping in `Pull`.
+  std::atomic<size_t> waiting_;
+  /// Mutex and condition to sleep while the queue is empty.
+  std::mutex mutex_;
+  std::condition_variable ready_;
+};
+
+}  // namespace thread
+}  // namespace olp
+
+#include "LockFreeSyncQueue.inl"
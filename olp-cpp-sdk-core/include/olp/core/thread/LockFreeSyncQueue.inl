@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <thread>
+
+namespace olp {
+namespace thread {
+
+namespace detail {
+/// The number of attempts to pull before sleeping.
+constexpr int kLockFreeQueueSpins = 64;
+
+inline size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 2u;
+  while (result < value) {
+    result <<= 1u;
+  }
+  return result;
+}
+}  // namespace detail
+
+template <typename T>
+LockFreeSyncQueue<T>::LockFreeSyncQueue(size_t capacity)
+    : buffer_(new Cell[detail::RoundUpToPowerOfTwo(capacity)]),
+      mask_(detail::RoundUpToPowerOfTwo(capacity) - 1u),
+      push_position_(0u),
+      pull_position_(0u),
+      closed_(false),
+      waiting_(0u) {
+  for (size_t idx = 0u; idx <= mask_; ++idx) {
+    buffer_[idx].sequence.store(idx, std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+LockFreeSyncQueue<T>::~LockFreeSyncQueue() {
+  Close();
+}
+
+template <typename T>
+bool LockFreeSyncQueue<T>::Empty() const {
+  return pull_position_.load(std::memory_order_acquire) >=
+         push_position_.load(std::memory_order_acquire);
+}
+
+template <typename T>
+void LockFreeSyncQueue<T>::Close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_.store(true);
+  }
+  ready_.notify_all();
+
+  T element;
+  while (TryPull(element)) {
+  }
+}
+
+template <typename T>
+bool LockFreeSyncQueue<T>::Pull(T& element) {
+  for (int spin = 0; spin < detail::kLockFreeQueueSpins; ++spin) {
+    if (closed_.load()) {
+      return false;
+    }
+    if (TryPull(element)) {
+      return true;
+    }
+    std::this_thread::yield();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  ++waiting_;
+  bool pulled = false;
+  ready_.wait(lock, [&]() {
+    // Pairs with the fence in `NotifyPush`, so either the pusher sees the
+    // waiting thread or the thread sees the pushed element.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (closed_.load()) {
+      return true;
+    }
+    pulled = TryPull(element);
+    return pulled;
+  });
+  --waiting_;
+  return pulled && !closed_.load();
+}
+
+template <typename T>
+void LockFreeSyncQueue<T>::Push(T&& element) {
+  while (!closed_.load()) {
+    if (TryEnqueue(std::move(element))) {
+      NotifyPush();
+      return;
+    }
+    // The queue is full, wait for the consumers.
+    std::this_thread::yield();
+  }
+}
+
+template <typename T>
+void LockFreeSyncQueue<T>::Push(const T& element) {
+  T copy(element);
+  Push(std::move(copy));
+}
+
+template <typename T>
+bool LockFreeSyncQueue<T>::TryPush(T&& element) {
+  if (closed_.load() || !TryEnqueue(std::move(element))) {
+    return false;
+  }
+  NotifyPush();
+  return true;
+}
+
+template <typename T>
+bool LockFreeSyncQueue<T>::TryEnqueue(T&& element) {
+  auto position = push_position_.load(std::memory_order_relaxed);
+  Cell* cell;
+  for (;;) {
+    cell = &buffer_[position & mask_];
+    const auto sequence = cell->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence) -
+                      static_cast<std::ptrdiff_t>(position);
+    if (diff == 0) {
+      if (push_position_.compare_exchange_weak(position, position + 1u,
+                                               std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      position = push_position_.load(std::memory_order_relaxed);
+    }
+  }
+
+  new (&cell->storage) T(std::move(element));
+  cell->sequence.store(position + 1u, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool LockFreeSyncQueue<T>::TryPull(T& element) {
+  auto position = pull_position_.load(std::memory_order_relaxed);
+  Cell* cell;
+  for (;;) {
+    cell = &buffer_[position & mask_];
+    const auto sequence = cell->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence) -
+                      static_cast<std::ptrdiff_t>(position + 1u);
+    if (diff == 0) {
+      if (pull_position_.compare_exchange_weak(position, position + 1u,
+                                               std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      position = pull_position_.load(std::memory_order_relaxed);
+    }
+  }
+
+  auto* stored = reinterpret_cast<T*>(&cell->storage);
+  element = std::move(*stored);
+  stored->~T();
+  cell->sequence.store(position + mask_ + 1u, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+void LockFreeSyncQueue<T>::NotifyPush() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting_.load() > 0u) {
+    // Lock to not miss a thread that is going to sleep.
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    ready_.notify_one();
+  }
+}
+
+}  // namespace thread
+}  // namespace olp
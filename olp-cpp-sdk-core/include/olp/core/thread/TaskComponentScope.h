@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace thread {
+
+/**
+ * @brief Tags the tasks scheduled on the current thread with the SDK
+ * component while the scope is alive.
+ *
+ * The tag is reported to the `TaskSchedulerListener` instance, and the tasks
+ * run with the tag of the task that scheduled them. The scopes can be nested,
+ * the previous tag is restored on destruction.
+ */
+class CORE_API TaskComponentScope final {
+ public:
+  /**
+   * @brief Sets the component of the current thread.
+   *
+   * @param[in] component The component name. It must outlive the tasks, e.g.
+   * a string literal.
+   */
+  explicit TaskComponentScope(const char* component);
+
+  /**
+   * @brief Restores the previous component of the current thread.
+   */
+  ~TaskComponentScope();
+
+  TaskComponentScope(const TaskComponentScope&) = delete;
+  TaskComponentScope& operator=(const TaskComponentScope&) = delete;
+
+  /**
+   * @brief Gets the component of the current thread.
+   *
+   * @return The component of the innermost scope, or an empty string if there
+   * is none.
+   */
+  static const char* GetCurrentComponent();
+
+ private:
+  const char* previous_component_;
+};
+
+}  // namespace thread
+}  // namespace olp
@@ -19,10 +19,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/CancellationContext.h>
+#include <olp/core/thread/TaskComponentScope.h>
+#include <olp/core/thread/TaskSchedulerListener.h>
+#include <olp/core/utils/InlineFunction.h>
 #include <olp/core/utils/WarningWorkarounds.h>
 
 namespace olp {
@@ -43,8 +51,13 @@ enum Priority : uint32_t { LOW = 100, NORMAL = 500, HIGH = 1000 };
  */
 class CORE_API TaskScheduler {
  public:
-  /// Alias for the abstract interface input.
-  using CallFuncType = std::function<void()>;
+  /**
+   * @brief Alias for the abstract interface input.
+   *
+   * A move-only callable that keeps small lambdas inline, so scheduling
+   * a task usually does not allocate.
+   */
+  using CallFuncType = utils::InlineFunction<void()>;
 
   virtual ~TaskScheduler() = default;
 
@@ -56,7 +69,9 @@ class CORE_API TaskScheduler {
    * @param[in] func The callable target that should be added to the scheduling
    * pipeline.
    */
-  void ScheduleTask(CallFuncType&& func) { EnqueueTask(std::move(func)); }
+  void ScheduleTask(CallFuncType&& func) {
+    EnqueueTask(Instrument(std::move(func), NORMAL));
+  }
 
   /**
    * @brief Schedules the asynchronous task.
@@ -67,7 +82,94 @@ class CORE_API TaskScheduler {
    * executes earlier.
    */
   void ScheduleTask(CallFuncType&& func, uint32_t priority) {
-    EnqueueTask(std::move(func), priority);
+    EnqueueTask(Instrument(std::move(func), priority), priority);
+  }
+
+  /**
+   * @brief Schedules the batch of asynchronous tasks.
+   *
+   * Use it instead of calling `ScheduleTask` in a loop: the scheduler may
+   * enqueue the whole batch at once and wake up only as many threads as
+   * there are tasks.
+   *
+   * @param[in] funcs The callable targets that should be added to the
+   * scheduling pipeline.
+   * @param[in] priority The priority of the tasks. Tasks with higher priority
+   * executes earlier.
+   */
+  void ScheduleTasks(std::vector<CallFuncType>&& funcs,
+                     uint32_t priority = NORMAL) {
+    for (auto& func : funcs) {
+      func = Instrument(std::move(func), priority);
+    }
+    EnqueueTasks(std::move(funcs), priority);
+  }
+
+  /**
+   * @brief Schedules the asynchronous task to run after the delay.
+   *
+   * Use it instead of sleeping in a task, e.g. for the backdown between
+   * the request retries or the periodic jobs, so that the delay does not
+   * block a thread.
+   *
+   * @param[in] func The callable target that should be added to the scheduling
+   * pipeline.
+   * @param[in] delay The time after which the task is scheduled.
+   * @param[in] priority The priority of the task. Tasks with higher priority
+   * executes earlier.
+   */
+  void ScheduleTaskAfter(CallFuncType&& func, std::chrono::milliseconds delay,
+                         uint32_t priority = NORMAL) {
+    EnqueueDelayedTask(Instrument(std::move(func), priority, delay), delay,
+                       priority);
+  }
+
+  /**
+   * @brief Schedules the asynchronous task to run at the time point.
+   *
+   * @param[in] func The callable target that should be added to the scheduling
+   * pipeline.
+   * @param[in] time The time at which the task is scheduled. The task is
+   * scheduled immediately if the time point is in the past.
+   * @param[in] priority The priority of the task. Tasks with higher priority
+   * executes earlier.
+   */
+  void ScheduleTaskAt(CallFuncType&& func,
+                      std::chrono::steady_clock::time_point time,
+                      uint32_t priority = NORMAL) {
+    const auto delay = std::max(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            time - std::chrono::steady_clock::now()),
+        std::chrono::milliseconds::zero());
+    EnqueueDelayedTask(Instrument(std::move(func), priority, delay), delay,
+                       priority);
+  }
+
+  /**
+   * @brief Schedules the asynchronous cancellable task to run after the delay.
+   *
+   * @param[in] func The callable target that should be added to the scheduling
+   * pipeline. It has the same signature as the one passed to the cancellable
+   * `ScheduleTask` method.
+   * @param[in] delay The time after which the task is scheduled.
+   *
+   * @return Returns the \c CancellationContext copy to the caller. The task is
+   * not called if it is cancelled before the delay expires.
+   */
+  template <class Function, typename std::enable_if<!std::is_convertible<
+                                decltype(std::declval<Function>()),
+                                CallFuncType>::value>::type* = nullptr>
+  client::CancellationContext ScheduleTaskAfter(
+      Function&& func, std::chrono::milliseconds delay) {
+    client::CancellationContext context;
+    auto task = [func, context]() {
+      if (!context.IsCancelled()) {
+        func(context);
+      };
+    };
+    EnqueueDelayedTask(Instrument(std::move(task), NORMAL, delay), delay,
+                       NORMAL);
+    return context;
   }
 
   /**
@@ -97,10 +199,20 @@ class CORE_API TaskScheduler {
         func(context);
       };
     };
-    EnqueueTask(std::move(task));
+    EnqueueTask(Instrument(std::move(task), NORMAL));
     return context;
   }
 
+  /**
+   * @brief Sets the listener that receives the events of the tasks scheduled
+   * after the call.
+   *
+   * @param[in] listener The listener, or nullptr to stop reporting.
+   */
+  void SetListener(std::shared_ptr<TaskSchedulerListener> listener) {
+    std::atomic_store(&listener_, std::move(listener));
+  }
+
  protected:
   /**
    * @brief The abstract enqueue task interface that is implemented by
@@ -139,6 +251,89 @@ class CORE_API TaskScheduler {
     OLP_SDK_CORE_UNUSED(priority);
     EnqueueTask(std::forward<CallFuncType>(func));
   }
+
+  /**
+   * @brief The enqueue batch interface that is implemented by the subclass.
+   *
+   * Implement this method in the subclass to enqueue the tasks at once, for
+   * example, under one lock. The default implementation enqueues the tasks
+   * one by one. The tasks should keep their order within the priority group.
+   *
+   * @param[in] funcs The rvalue reference of the tasks that should be
+   * enqueued. Move the tasks into your queue. Once this method is called, you
+   * own the tasks.
+   * @param[in] priority The priority of the tasks. Tasks with higher priority
+   * executes earlier.
+   */
+  virtual void EnqueueTasks(std::vector<CallFuncType>&& funcs,
+                            uint32_t priority) {
+    for (auto& func : funcs) {
+      EnqueueTask(std::move(func), priority);
+    }
+  }
+
+  /**
+   * @brief The enqueue delayed task interface that is implemented by the
+   * subclass.
+   *
+   * Implement this method in the subclass to run the task after the delay
+   * without blocking a thread, e.g. with a timer. The default implementation
+   * enqueues a task that sleeps for the delay and then runs the task.
+   *
+   * @param[in] func The rvalue reference of the task that should be enqueued.
+   * Move this task into your queue. No internal references are
+   * kept. Once this method is called, you own the task.
+   * @param[in] delay The time after which the task is scheduled.
+   * @param[in] priority The priority of the task. Tasks with higher priority
+   * executes earlier.
+   */
+  virtual void EnqueueDelayedTask(CallFuncType&& func,
+                                  std::chrono::milliseconds delay,
+                                  uint32_t priority) {
+    auto task = std::make_shared<CallFuncType>(std::move(func));
+    EnqueueTask(
+        [task, delay]() {
+          std::this_thread::sleep_for(delay);
+          (*task)();
+        },
+        priority);
+  }
+
+ private:
+  /// Wraps the task to report its events to the listener.
+  CallFuncType Instrument(
+      CallFuncType&& func, uint32_t priority,
+      std::chrono::milliseconds delay = std::chrono::milliseconds::zero()) {
+    auto listener = std::atomic_load(&listener_);
+    if (!listener) {
+      return std::move(func);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    const TaskInfo info{priority, TaskComponentScope::GetCurrentComponent()};
+    listener->OnTaskQueued(info);
+
+    const auto queued_at = Clock::now() + delay;
+    auto task = std::make_shared<CallFuncType>(std::move(func));
+    return [listener, info, queued_at, task]() {
+      const auto started_at = Clock::now();
+      listener->OnTaskStarted(
+          info, duration_cast<microseconds>(std::max(started_at, queued_at) -
+                                            queued_at));
+      {
+        // The tasks scheduled by the task have the same component.
+        TaskComponentScope component_scope(info.component);
+        (*task)();
+      }
+      listener->OnTaskFinished(
+          info, duration_cast<microseconds>(Clock::now() - started_at));
+    };
+  }
+
+  std::shared_ptr<TaskSchedulerListener> listener_;
 };
 
 }  // namespace thread
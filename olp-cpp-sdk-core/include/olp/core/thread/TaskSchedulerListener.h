@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace thread {
+
+/// The task details reported to the `TaskSchedulerListener` instance.
+struct CORE_API TaskInfo {
+  /// The priority of the task.
+  uint32_t priority;
+  /// The SDK component that scheduled the task, see `TaskComponentScope`.
+  const char* component;
+};
+
+/**
+ * @brief Receives the events of the tasks scheduled on a `TaskScheduler`
+ * instance.
+ *
+ * The methods are called on the scheduling and the worker threads, so they
+ * must be thread-safe and fast. The tasks dropped by the scheduler are not
+ * reported as started.
+ */
+class CORE_API TaskSchedulerListener {
+ public:
+  virtual ~TaskSchedulerListener() = default;
+
+  /**
+   * @brief Called when the task is scheduled.
+   *
+   * @param info The task details.
+   */
+  virtual void OnTaskQueued(const TaskInfo& info) = 0;
+
+  /**
+   * @brief Called when the task starts.
+   *
+   * @param info The task details.
+   * @param wait_time The time the task waited in the queue. For the delayed
+   * tasks, the time since the task was due.
+   */
+  virtual void OnTaskStarted(const TaskInfo& info,
+                             std::chrono::microseconds wait_time) = 0;
+
+  /**
+   * @brief Called when the task finishes.
+   *
+   * @param info The task details.
+   * @param run_time The time the task ran.
+   */
+  virtual void OnTaskFinished(const TaskInfo& info,
+                              std::chrono::microseconds run_time) = 0;
+};
+
+}  // namespace thread
+}  // namespace olp
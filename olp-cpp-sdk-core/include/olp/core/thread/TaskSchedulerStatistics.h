@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <olp/core/CoreApi.h>
+#include <olp/core/thread/TaskSchedulerListener.h>
+
+namespace olp {
+namespace thread {
+
+/**
+ * @brief Collects the queue depth per priority and the wait and run time
+ * histograms per component of the scheduled tasks.
+ *
+ * Set it with `TaskScheduler::SetListener` and read it with
+ * `GetStatistics`, e.g. to find out whether the tasks wait for a free thread
+ * or for the network.
+ */
+class CORE_API TaskSchedulerStatistics final : public TaskSchedulerListener {
+ public:
+  /// The time histogram.
+  struct CORE_API Histogram {
+    /// The number of times in each bucket, see `GetBucketBounds`.
+    std::vector<uint64_t> counts;
+    /// The number of times.
+    uint64_t count{0u};
+    /// The sum of times.
+    std::chrono::microseconds total{0};
+    /// The maximum time.
+    std::chrono::microseconds max{0};
+  };
+
+  /// The statistics of the tasks of a component.
+  struct CORE_API ComponentStatistics {
+    /// The time the tasks waited in the queue.
+    Histogram wait_time;
+    /// The time the tasks ran.
+    Histogram run_time;
+  };
+
+  /// The collected statistics.
+  struct CORE_API Statistics {
+    /// The number of queued tasks per priority.
+    std::map<uint32_t, uint64_t> queue_depth;
+    /// The statistics per component, an empty name for the untagged tasks.
+    std::map<std::string, ComponentStatistics> components;
+  };
+
+  /**
+   * @brief Gets the upper bounds of the histogram buckets.
+   *
+   * The last bucket of a histogram counts the times above the last bound.
+   *
+   * @return The bucket bounds.
+   */
+  static std::vector<std::chrono::microseconds> GetBucketBounds();
+
+  /**
+   * @brief Gets the collected statistics.
+   *
+   * @return The copy of the statistics.
+   */
+  Statistics GetStatistics() const;
+
+  /**
+   * @brief Resets the histograms. The queue depth is kept.
+   */
+  void ResetHistograms();
+
+  /// Implements the `OnTaskQueued` method of the `TaskSchedulerListener`
+  /// class.
+  void OnTaskQueued(const TaskInfo& info) override;
+
+  /// Implements the `OnTaskStarted` method of the `TaskSchedulerListener`
+  /// class.
+  void OnTaskStarted(const TaskInfo& info,
+                     std::chrono::microseconds wait_time) override;
+
+  /// Implements the `OnTaskFinished` method of the `TaskSchedulerListener`
+  /// class.
+  void OnTaskFinished(const TaskInfo& info,
+                      std::chrono::microseconds run_time) override;
+
+ private:
+  mutable std::mutex mutex_;
+  Statistics statistics_;
+};
+
+}  // namespace thread
+}  // namespace olp
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace thread {
+
+/**
+ * @brief The CPUs that the SDK threads run on.
+ *
+ * On Linux, the memory that a thread allocates first is placed on the NUMA
+ * node of the CPU it runs on, so pinning the threads to the CPUs of one node
+ * keeps their data on that node. Pinning is only supported on Linux and
+ * Android, and ignored on the other platforms.
+ */
+struct CORE_API ThreadAffinitySettings {
+  /// The CPUs the threads may run on, or empty to use `numa_node`.
+  std::vector<size_t> cpus;
+
+  /// The NUMA node whose CPUs the threads may run on, used when `cpus` is
+  /// empty. Set to a negative value to not pin the threads.
+  int numa_node = -1;
+
+  /// Pins every thread to a single CPU of the set, in the round-robin order,
+  /// instead of letting it run on any CPU of the set.
+  bool pin_each_thread = false;
+};
+
+}  // namespace thread
+}  // namespace olp
@@ -19,18 +19,82 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
 #include <thread>
 #include <vector>
 
 #include <olp/core/thread/TaskScheduler.h>
+#include <olp/core/thread/ThreadAffinity.h>
 
 namespace olp {
 namespace thread {
 
+/**
+ * @brief The priority lanes of the `ThreadPoolTaskScheduler` instance.
+ *
+ * The lane threads are taken from the thread pool. By default, all threads
+ * run the tasks strictly in the priority order.
+ */
+struct CORE_API PriorityLanesSettings {
+  /**
+   * @brief The number of threads that only run the tasks with the
+   * `Priority::HIGH` priority or higher, so the interactive tasks do not wait
+   * for the bulk tasks.
+   *
+   * At least one thread of the pool runs all the tasks. Set to 0 to disable
+   * the lane.
+   */
+  size_t high_priority_threads = 0u;
+
+  /**
+   * @brief The number of threads that run the tasks with a priority below
+   * `Priority::NORMAL` first, so the bulk tasks, like prefetch, keep a share
+   * of the pool.
+   *
+   * The threads run the other tasks when there are no low priority tasks. Set
+   * to 0 to disable the lane.
+   */
+  size_t low_priority_threads = 0u;
+
+  /**
+   * @brief The time after which a waiting task runs before the tasks with a
+   * higher priority.
+   *
+   * It bounds the latency of the low priority tasks under a continuous stream
+   * of the high priority tasks. Set to 0 to disable the aging.
+   */
+  std::chrono::milliseconds max_task_wait{0};
+};
+
+/**
+ * @brief The elastic mode of the `ThreadPoolTaskScheduler` instance.
+ *
+ * The pool starts extra threads when there are more queued tasks than idle
+ * threads, for example, when all threads are blocked by synchronous requests,
+ * and stops them after they are idle for some time.
+ */
+struct CORE_API ElasticPoolSettings {
+  /**
+   * @brief The maximum number of threads, including the threads that always
+   * run.
+   *
+   * Set to 0 or to a value not above the thread count to disable the elastic
+   * mode.
+   */
+  size_t max_thread_count = 0u;
+
+  /// The time after which an idle extra thread stops.
+  std::chrono::milliseconds idle_timeout{std::chrono::seconds(10)};
+};
+
 /**
  * @brief An implementation of the `TaskScheduler` instance that uses a thread
  * pool.
  *
+ * The tasks are run in the priority order, and optionally with the priority
+ * lanes and aging configured with `PriorityLanesSettings`. The pool can grow
+ * up to the limit set with `ElasticPoolSettings`.
  */
 class CORE_API ThreadPoolTaskScheduler final : public TaskScheduler {
  public:
@@ -42,7 +106,22 @@ class CORE_API ThreadPoolTaskScheduler final : public TaskScheduler {
   explicit ThreadPoolTaskScheduler(size_t thread_count = 1u);
 
   /**
-   * @brief Closes the `SyncQueue` instance and joins threads.
+   * @brief Creates the `ThreadPoolTaskScheduler` object with the priority
+   * lanes.
+   *
+   * @param thread_count The number of threads initialized in the thread pool.
+   * The threads run until the scheduler is destroyed.
+   * @param lanes The priority lanes settings.
+   * @param elastic The elastic mode settings.
+   * @param affinity The CPUs the threads run on.
+   */
+  ThreadPoolTaskScheduler(
+      size_t thread_count, PriorityLanesSettings lanes,
+      ElasticPoolSettings elastic = ElasticPoolSettings(),
+      ThreadAffinitySettings affinity = ThreadAffinitySettings());
+
+  /**
+   * @brief Closes the task queue and joins threads.
    */
   ~ThreadPoolTaskScheduler() override;
 
@@ -81,13 +160,48 @@ class CORE_API ThreadPoolTaskScheduler final : public TaskScheduler {
   void EnqueueTask(TaskScheduler::CallFuncType&& func,
                    uint32_t priority) override;
 
+  /**
+   * @brief Overrides the base class method to enqueue the tasks under one
+   * lock and wake up at most one thread per task.
+   *
+   * @param funcs The rvalue reference of the tasks that should be enqueued.
+   * @param priority The priority of the tasks. Tasks with higher priority
+   * executes earlier.
+   */
+  void EnqueueTasks(std::vector<TaskScheduler::CallFuncType>&& funcs,
+                    uint32_t priority) override;
+
+  /**
+   * @brief Overrides the base class method to enqueue tasks on a timer thread
+   * and execute them on the next free thread from the thread pool after the
+   * delay.
+   *
+   * The timer thread is started with the first delayed task.
+   *
+   * @param func The rvalue reference of the task that should be enqueued.
+   * Move this task into your queue. No internal references are
+   * kept. Once this method is called, you own the task.
+   * @param delay The time after which the task is scheduled.
+   * @param priority The priority of the task. Tasks with higher priority
+   * executes earlier.
+   */
+  void EnqueueDelayedTask(TaskScheduler::CallFuncType&& func,
+                          std::chrono::milliseconds delay,
+                          uint32_t priority) override;
+
  private:
   class QueueImpl;
+  class TimerImpl;
+  class ElasticImpl;
 
   /// Thread pool created in constructor.
   std::vector<std::thread> thread_pool_;
-  /// SyncQueue used to manage tasks.
+  /// Queue used to manage tasks.
   std::unique_ptr<QueueImpl> queue_;
+  /// Timer that enqueues the delayed tasks.
+  std::unique_ptr<TimerImpl> timer_;
+  /// Extra threads of the elastic mode.
+  std::unique_ptr<ElasticImpl> elastic_;
 };
 
 }  // namespace thread
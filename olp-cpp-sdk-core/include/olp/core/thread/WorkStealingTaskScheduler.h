@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <olp/core/thread/TaskScheduler.h>
+
+namespace olp {
+namespace thread {
+
+/**
+ * @brief An implementation of the `TaskScheduler` instance that uses a thread
+ * pool with a task queue per thread.
+ *
+ * The tasks enqueued from a pool thread, for example, the tasks that a
+ * running task spawns, go to the queue of that thread, and the other tasks
+ * are spread over the queues. A thread runs the task with the highest
+ * priority from its own queue, and when its queue is empty, it steals the
+ * task with the highest priority from the other queues. This avoids the
+ * contention on a single queue when many small tasks are scheduled.
+ */
+class CORE_API WorkStealingTaskScheduler final : public TaskScheduler {
+ public:
+  /**
+   * @brief Creates the `WorkStealingTaskScheduler` object with one thread.
+   *
+   * @param thread_count The number of threads initialized in the thread pool.
+   */
+  explicit WorkStealingTaskScheduler(size_t thread_count = 1u);
+
+  /**
+   * @brief Drops the pending tasks and joins threads.
+   */
+  ~WorkStealingTaskScheduler() override;
+
+  /// Non-copyable, non-movable
+  WorkStealingTaskScheduler(const WorkStealingTaskScheduler&) = delete;
+  /// Non-copyable, non-movable
+  WorkStealingTaskScheduler& operator=(const WorkStealingTaskScheduler&) =
+      delete;
+  /// Non-copyable, non-movable
+  WorkStealingTaskScheduler(WorkStealingTaskScheduler&&) = delete;
+  /// Non-copyable, non-movable
+  WorkStealingTaskScheduler& operator=(WorkStealingTaskScheduler&&) = delete;
+
+ protected:
+  /**
+   * @brief Overrides the base class method to enqueue tasks with the
+   * Priority::NORMAL priority.
+   *
+   * @param func The rvalue reference of the task that should be enqueued.
+   */
+  void EnqueueTask(TaskScheduler::CallFuncType&& func) override;
+
+  /**
+   * @brief Overrides the base class method to enqueue tasks in the queue of
+   * the current pool thread or, if called from another thread, in the next
+   * queue.
+   *
+   * @param func The rvalue reference of the task that should be enqueued.
+   * @param priority The priority of the task. Tasks with higher priority
+   * executes earlier.
+   */
+  void EnqueueTask(TaskScheduler::CallFuncType&& func,
+                   uint32_t priority) override;
+
+  /**
+   * @brief Overrides the base class method to enqueue the tasks in one queue
+   * under its lock and wake up at most one sleeping thread per task, so the
+   * woken threads steal the rest of the batch.
+   *
+   * @param funcs The rvalue reference of the tasks that should be enqueued.
+   * @param priority The priority of the tasks. Tasks with higher priority
+   * executes earlier.
+   */
+  void EnqueueTasks(std::vector<TaskScheduler::CallFuncType>&& funcs,
+                    uint32_t priority) override;
+
+  /**
+   * @brief Overrides the base class method to enqueue tasks on a timer thread
+   * and execute them on the pool after the delay.
+   *
+   * @param func The rvalue reference of the task that should be enqueued.
+   * @param delay The time after which the task is scheduled.
+   * @param priority The priority of the task. Tasks with higher priority
+   * executes earlier.
+   */
+  void EnqueueDelayedTask(TaskScheduler::CallFuncType&& func,
+                          std::chrono::milliseconds delay,
+                          uint32_t priority) override;
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace thread
+}  // namespace olp
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <olp/core/utils/LruCache.h>
+
+namespace olp {
+namespace utils {
+
+/**
+ * @brief A thread-safe key-value LRU cache.
+ *
+ * The keys are distributed by their hash over several `LruCache` shards, each
+ * of them with its own lock, so the concurrent lookups of the different keys
+ * rarely wait for each other. The shards share the maximum size equally and
+ * evict their values independently, so the least recently used value of the
+ * whole cache is not always evicted first.
+ *
+ * @tparam Key The cache key type.
+ * @tparam Value The cache value type. It is copied out of the cache on lookup.
+ * @tparam CacheCostFunc The cache cost functor.
+ * @tparam Hash The hash function that selects the shard of a key.
+ * @tparam Compare The comparison function of the keys within a shard.
+ */
+template <typename Key, typename Value,
+          typename CacheCostFunc = CacheCost<Value>,
+          typename Hash = std::hash<Key>, typename Compare = std::less<Key>>
+class ConcurrentLruCache {
+ public:
+  /// The default number of the shards.
+  static constexpr std::size_t kDefaultShardCount = 16u;
+
+  /**
+   * @brief Creates a `ConcurrentLruCache` instance.
+   *
+   * @param max_size The maximum size of values this cache can keep.
+   * @param shard_count The number of the shards. It is reduced when the
+   * maximum size is too small to give every shard at least one value.
+   * @param cache_cost_func The function this cache uses to compute the
+   * caching cost of each cached value.
+   */
+  explicit ConcurrentLruCache(std::size_t max_size,
+                              std::size_t shard_count = kDefaultShardCount,
+                              CacheCostFunc cache_cost_func = CacheCostFunc()) {
+    shard_count = std::max<std::size_t>(
+        1u, std::min(shard_count, std::max<std::size_t>(max_size, 1u)));
+    const auto shard_size = (max_size + shard_count - 1u) / shard_count;
+
+    shards_.reserve(shard_count);
+    for (std::size_t i = 0u; i < shard_count; ++i) {
+      shards_.emplace_back(new Shard(shard_size, cache_cost_func));
+    }
+  }
+
+  ConcurrentLruCache(const ConcurrentLruCache&) = delete;
+  ConcurrentLruCache& operator=(const ConcurrentLruCache&) = delete;
+
+  /**
+   * @brief Finds a value in the cache.
+   *
+   * @note This function promotes the value if found.
+   *
+   * @param key The key to find.
+   *
+   * @return The copy of the value if found; `boost::none` otherwise.
+   */
+  boost::optional<Value> Find(const Key& key) {
+    auto& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.cache.Find(key);
+    if (it == shard.cache.end()) {
+      return boost::none;
+    }
+    return it->value();
+  }
+
+  /**
+   * @brief Inserts a key-value pair in the cache or updates an existing
+   * key-value pair.
+   *
+   * @param key The key to add.
+   * @param value The value to add.
+   *
+   * @return True if the value is in the cache; false if its cost exceeds the
+   * size of the shard.
+   */
+  template <typename _Value>
+  bool InsertOrAssign(Key key, _Value&& value) {
+    auto& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.InsertOrAssign(std::move(key),
+                                      std::forward<_Value>(value))
+               .first != shard.cache.end();
+  }
+
+  /**
+   * @brief Updates a value in the cache under the lock of its shard.
+   *
+   * The function gets a copy of the cached value, or a default-constructed
+   * value if the key is not in the cache, and the result is stored back.
+   *
+   * @param key The key to update.
+   * @param function The function that takes a `Value&` and changes it.
+   *
+   * @return The updated value.
+   */
+  template <typename Function>
+  Value Update(const Key& key, Function function) {
+    auto& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.cache.Find(key);
+    Value value = it != shard.cache.end() ? it->value() : Value();
+    function(value);
+    shard.cache.InsertOrAssign(key, value);
+    return value;
+  }
+
+  /**
+   * @brief Removes a key from the cache.
+   *
+   * @param key The key to remove.
+   *
+   * @return True if the key was in the cache; false otherwise.
+   */
+  bool Erase(const Key& key) {
+    auto& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.Erase(key);
+  }
+
+  /// Removes all items from the cache.
+  void Clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->cache.Clear();
+    }
+  }
+
+  /// Gets the current size of the cache.
+  std::size_t Size() const {
+    std::size_t size = 0u;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      size += shard->cache.Size();
+    }
+    return size;
+  }
+
+ private:
+  struct Shard {
+    Shard(std::size_t max_size, CacheCostFunc cache_cost_func)
+        : cache(max_size, std::move(cache_cost_func)) {}
+
+    mutable std::mutex mutex;
+    LruCache<Key, Value, CacheCostFunc, Compare> cache;
+  };
+
+  Shard& GetShard(const Key& key) {
+    return *shards_[Hash()(key) % shards_.size()];
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+template <typename Key, typename Value, typename CacheCostFunc,
+          typename Hash, typename Compare>
+constexpr std::size_t ConcurrentLruCache<Key, Value, CacheCostFunc, Hash,
+                                         Compare>::kDefaultShardCount;
+
+}  // namespace utils
+}  // namespace olp
@@ -0,0 +1,492 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include <olp/core/utils/LruCache.h>
+
+namespace olp {
+namespace utils {
+
+/**
+ * @brief A generic key-value LRU cache with hashed keys.
+ *
+ * It has the interface of `LruCache`, but keeps the elements in a hash map,
+ * so the lookups and the insertions take constant time. The LRU chain links
+ * the map nodes directly. The keys are not ordered, so `EraseRange` visits all
+ * the elements.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The value type.
+ * @tparam CacheCostFunc The cache cost functor. It returns a non-zero value
+ * for any given object.
+ * @tparam Hash The hash function of the keys.
+ * @tparam KeyEqual The equality function of the keys.
+ * @tparam Alloc The allocator of the map nodes, for example, `PoolAllocator`.
+ */
+template <typename Key, typename Value,
+          typename CacheCostFunc = CacheCost<Value>,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          template <typename> class Alloc = std::allocator>
+class HashLruCache {
+  struct Bucket;
+  using Node = std::pair<const Key, Bucket>;
+  using MapType = std::unordered_map<Key, Bucket, Hash, KeyEqual, Alloc<Node>>;
+
+ public:
+  /// An alias for the eviction function.
+  using EvictionFunction = std::function<void(const Key&, Value&&)>;
+
+  /// An alias for the cache allocator type.
+  using AllocType = Alloc<Node>;
+
+  /// An element of the cache.
+  class ValueType {
+   public:
+    /// Gets the key of the element.
+    const Key& key() const { return node_->first; }
+
+    /// Gets the value of the element.
+    const Value& value() const { return node_->second.value_; }
+
+   protected:
+    /// The map node of the element.
+    const Node* node_{nullptr};
+  };
+
+  /// A constant iterator that goes from the most to the least recently used
+  /// element.
+  class const_iterator : public ValueType {
+   public:
+    /// The iterator category.
+    using iterator_category = std::bidirectional_iterator_tag;
+    /// The difference type.
+    using difference_type = std::ptrdiff_t;
+    /// The value type.
+    using value_type = ValueType;
+    /// The constant reference to the value type.
+    using reference = const value_type&;
+    /// The constant pointer to the value type.
+    using pointer = const value_type*;
+
+    /// Creates an iterator that points to the end.
+    const_iterator() = default;
+
+    /// Checks whether both iterators point to the same element.
+    bool operator==(const const_iterator& other) const {
+      return this->node_ == other.node_;
+    }
+
+    /// Checks whether the iterators point to different elements.
+    bool operator!=(const const_iterator& other) const {
+      return this->node_ != other.node_;
+    }
+
+    /// Moves to the next less recently used element.
+    const_iterator& operator++() {
+      this->node_ = this->node_->second.next_;
+      return *this;
+    }
+
+    /// Moves to the next less recently used element.
+    const_iterator operator++(int) {
+      auto old = *this;
+      ++*this;
+      return old;
+    }
+
+    /// Moves to the next more recently used element.
+    const_iterator& operator--() {
+      this->node_ = this->node_->second.previous_;
+      return *this;
+    }
+
+    /// Moves to the next more recently used element.
+    const_iterator operator--(int) {
+      auto old = *this;
+      --*this;
+      return old;
+    }
+
+    /// Gets the element.
+    reference operator*() const { return *this; }
+
+    /// Gets the pointer to the element.
+    pointer operator->() const { return this; }
+
+   private:
+    friend class HashLruCache;
+
+    explicit const_iterator(const Node* node) { this->node_ = node; }
+  };
+
+  /**
+   * @brief Creates a `HashLruCache` instance.
+   *
+   * @param max_size The maximum size of values this cache can keep.
+   * @param cache_cost_func The function this cache uses to compute the
+   * caching cost of each cached value.
+   * @param alloc The allocator for the cache.
+   */
+  explicit HashLruCache(std::size_t max_size = 0u,
+                        CacheCostFunc cache_cost_func = CacheCostFunc(),
+                        const AllocType& alloc = AllocType())
+      : cache_cost_func_(std::move(cache_cost_func)),
+        map_(0u, Hash(), KeyEqual(), alloc),
+        max_size_(max_size) {}
+
+  HashLruCache(const HashLruCache&) = delete;
+  HashLruCache& operator=(const HashLruCache&) = delete;
+
+  /// The move constructor. The nodes move with the map, so the LRU chain
+  /// stays valid.
+  HashLruCache(HashLruCache&& other) noexcept
+      : eviction_callback_(std::move(other.eviction_callback_)),
+        cache_cost_func_(std::move(other.cache_cost_func_)),
+        map_(std::move(other.map_)),
+        first_(other.first_),
+        last_(other.last_),
+        max_size_(other.max_size_),
+        size_(other.size_) {
+    other.Reset();
+  }
+
+  /// The move assignment operator.
+  HashLruCache& operator=(HashLruCache&& other) noexcept {
+    eviction_callback_ = std::move(other.eviction_callback_);
+    cache_cost_func_ = std::move(other.cache_cost_func_);
+    map_ = std::move(other.map_);
+    first_ = other.first_;
+    last_ = other.last_;
+    max_size_ = other.max_size_;
+    size_ = other.size_;
+    other.Reset();
+    return *this;
+  }
+
+  /**
+   * @brief Inserts a key-value pair in the cache.
+   *
+   * @note If the key already exists in the cache, it is promoted, but its
+   * value is not updated. To update the existing values, use
+   * `InsertOrAssign` instead.
+   *
+   * @param key The key to add.
+   * @param value The value to add.
+   *
+   * @return The same as `LruCache::Insert`.
+   */
+  template <typename _Key, typename _Value>
+  std::pair<const_iterator, bool> Insert(_Key&& key, _Value&& value) {
+    Bucket bucket{nullptr, nullptr, std::forward<_Value>(value)};
+    const auto cost = cache_cost_func_(bucket.value_);
+    if (cost > max_size_) {
+      return std::make_pair(end(), false);
+    }
+
+    auto result = map_.emplace(std::forward<_Key>(key), std::move(bucket));
+    auto* node = &*result.first;
+    if (result.second) {
+      Link(node, cost);
+    } else {
+      Promote(node);
+    }
+    return std::make_pair(const_iterator{node}, result.second);
+  }
+
+  /**
+   * @brief Inserts a key-value pair in the cache or updates an existing
+   * key-value pair.
+   *
+   * @param key The key to add.
+   * @param value The value to add.
+   *
+   * @return The same as `LruCache::InsertOrAssign`.
+   */
+  template <typename _Value>
+  std::pair<const_iterator, bool> InsertOrAssign(Key key, _Value&& value) {
+    auto it = map_.find(key);
+    if (it != map_.end()) {
+      auto* node = &*it;
+      const auto old_cost = cache_cost_func_(node->second.value_);
+      node->second.value_ = std::forward<_Value>(value);
+      size_ += cache_cost_func_(node->second.value_) - old_cost;
+      Promote(node);
+      Evict();
+      return std::make_pair(const_iterator{node}, false);
+    }
+
+    Bucket bucket{nullptr, nullptr, std::forward<_Value>(value)};
+    const auto cost = cache_cost_func_(bucket.value_);
+    if (cost > max_size_) {
+      return std::make_pair(end(), false);
+    }
+
+    auto* node = &*map_.emplace(std::move(key), std::move(bucket)).first;
+    Link(node, cost);
+    return std::make_pair(const_iterator{node}, true);
+  }
+
+  /**
+   * @brief Removes a key from the cache.
+   *
+   * @param key The key to remove.
+   *
+   * @return True if the key exists and is removed; false otherwise.
+   */
+  bool Erase(const Key& key) {
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return false;
+    }
+
+    Erase(it, false);
+    return true;
+  }
+
+  /**
+   * @brief Removes the element of the iterator from the cache.
+   *
+   * @param it The iterator of the element. It moves to the next element.
+   *
+   * @return The iterator of the next element.
+   */
+  const_iterator Erase(const_iterator& it) {
+    auto current = it++;
+    Erase(map_.find(current->key()), false);
+    return it;
+  }
+
+  /**
+   * @brief Removes the keys of a range from the cache.
+   *
+   * Unlike `LruCache::EraseRange`, all the elements are visited, and
+   * `in_range` only filters them.
+   *
+   * @note The eviction callback is not called for the removed items.
+   *
+   * @param in_range The function that takes a key and returns true if the key
+   * belongs to the range.
+   * @param remove The function that takes a key and a value and returns true
+   * if the item should be removed.
+   *
+   * @return The number of removed items.
+   */
+  template <typename InRange, typename Remove>
+  std::size_t EraseRange(const Key& /*from*/, InRange in_range,
+                         Remove remove) {
+    std::size_t count = 0u;
+    for (auto it = map_.begin(); it != map_.end();) {
+      auto current = it++;
+      if (in_range(current->first) &&
+          remove(current->first, current->second.value_)) {
+        Erase(current, false);
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  /// Gets the current size of the cache.
+  std::size_t Size() const { return size_; }
+
+  /// Gets the maximum size of the cache.
+  std::size_t GetMaxSize() const { return max_size_; }
+
+  /**
+   * @brief Sets the new maximum size of the cache.
+   *
+   * @param max_size The new maximum size. The least recently used elements
+   * are evicted if the cache is bigger.
+   */
+  void Resize(std::size_t max_size) {
+    max_size_ = max_size;
+    Evict();
+  }
+
+  /**
+   * @brief Reserves the map buckets for the number of the elements.
+   *
+   * @param count The expected number of the elements.
+   */
+  void Reserve(std::size_t count) { map_.reserve(count); }
+
+  /**
+   * @brief Finds a value in the cache and promotes it.
+   *
+   * @param key The key to find.
+   *
+   * @return The iterator of the value if found; `end()` otherwise.
+   */
+  const_iterator Find(const Key& key) {
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return end();
+    }
+
+    Promote(&*it);
+    return const_iterator{&*it};
+  }
+
+  /**
+   * @brief Finds a value in the cache without promoting it.
+   *
+   * @param key The key to find.
+   *
+   * @return The iterator of the value if found; `end()` otherwise.
+   */
+  const_iterator FindNoPromote(const Key& key) const {
+    auto it = map_.find(key);
+    return it == map_.end() ? end() : const_iterator{&*it};
+  }
+
+  /**
+   * @brief Finds a value in the cache and promotes it.
+   *
+   * @param key The key to find.
+   * @param null_value The value to return if the key is not in the cache.
+   *
+   * @return The value if found; `null_value` otherwise.
+   */
+  const Value& Find(const Key& key, const Value& null_value) {
+    auto it = Find(key);
+    return it == end() ? null_value : it.value();
+  }
+
+  /// Returns an iterator to the most recently used element.
+  const_iterator begin() const { return const_iterator{first_}; }
+
+  /// Returns an iterator to the end.
+  const_iterator end() const { return const_iterator{}; }
+
+  /// Returns an iterator to the least recently used element.
+  const_iterator rbegin() const { return const_iterator{last_}; }
+
+  /// Returns an iterator to the end of the reverse iteration.
+  const_iterator rend() const { return const_iterator{}; }
+
+  /// Removes all the elements, but keeps the eviction callback and the
+  /// maximum size.
+  void Clear() {
+    map_.clear();
+    first_ = last_ = nullptr;
+    size_ = 0u;
+  }
+
+  /**
+   * @brief Sets a function that is invoked when a value is evicted.
+   *
+   * @note The function must not modify the cache.
+   *
+   * @param func The function to be called on eviction, or `nullptr`.
+   */
+  void SetEvictionCallback(EvictionFunction func) {
+    eviction_callback_ = std::move(func);
+  }
+
+ private:
+  struct Bucket {
+    Node* next_;
+    Node* previous_;
+    Value value_;
+  };
+
+  void Reset() {
+    first_ = last_ = nullptr;
+    size_ = 0u;
+  }
+
+  void Link(Node* node, std::size_t cost) {
+    node->second.next_ = first_;
+    if (first_) {
+      first_->second.previous_ = node;
+    } else {
+      last_ = node;
+    }
+    first_ = node;
+    size_ += cost;
+    Evict();
+  }
+
+  void Unlink(Node* node) {
+    auto& bucket = node->second;
+    if (bucket.next_) {
+      bucket.next_->second.previous_ = bucket.previous_;
+    } else {
+      last_ = bucket.previous_;
+    }
+    if (bucket.previous_) {
+      bucket.previous_->second.next_ = bucket.next_;
+    } else {
+      first_ = bucket.next_;
+    }
+    bucket.next_ = bucket.previous_ = nullptr;
+  }
+
+  void Promote(Node* node) {
+    if (node == first_) {
+      return;
+    }
+
+    Unlink(node);
+    node->second.next_ = first_;
+    first_->second.previous_ = node;
+    first_ = node;
+  }
+
+  void Erase(typename MapType::iterator it, bool do_eviction_callback) {
+    auto* node = &*it;
+    const auto cost = cache_cost_func_(node->second.value_);
+    Unlink(node);
+
+    if (do_eviction_callback && eviction_callback_) {
+      eviction_callback_(node->first, std::move(node->second.value_));
+    }
+
+    map_.erase(it);
+    size_ -= cost;
+  }
+
+  void Evict() {
+    while (size_ > max_size_) {
+      assert(last_ != nullptr);
+      Erase(map_.find(last_->first), true);
+    }
+  }
+
+  EvictionFunction eviction_callback_;
+  CacheCostFunc cache_cost_func_;
+  MapType map_;
+  Node* first_{nullptr};
+  Node* last_{nullptr};
+  std::size_t max_size_{0u};
+  std::size_t size_{0u};
+};
+
+}  // namespace utils
+}  // namespace olp
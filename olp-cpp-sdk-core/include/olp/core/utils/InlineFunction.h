@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace olp {
+namespace utils {
+
+/// The default size of the buffer that keeps the callable inline.
+static constexpr size_t kInlineFunctionCapacity = 64u;
+
+template <typename Signature, size_t Capacity = kInlineFunctionCapacity>
+class InlineFunction;
+
+/**
+ * @brief A move-only replacement of `std::function` that keeps the callable
+ * in an inline buffer.
+ *
+ * The callables that fit into `Capacity` bytes and can be moved without
+ * exceptions, for example, the lambdas that capture a few shared pointers,
+ * are stored without a heap allocation. The bigger ones are allocated on
+ * the heap, the same as with `std::function`. Unlike `std::function`, the
+ * callable does not need to be copyable.
+ *
+ * @tparam Result The result type of the callable.
+ * @tparam Args The argument types of the callable.
+ * @tparam Capacity The size of the inline buffer in bytes.
+ */
+template <typename Result, typename... Args, size_t Capacity>
+class InlineFunction<Result(Args...), Capacity> {
+  template <typename Function, typename = void>
+  struct IsCallable : std::false_type {};
+
+  template <typename Function>
+  struct IsCallable<
+      Function,
+      typename std::enable_if<
+          std::is_void<Result>::value ||
+          std::is_convertible<
+              decltype(std::declval<Function&>()(std::declval<Args>()...)),
+              Result>::value>::type> : std::true_type {};
+
+ public:
+  /// Creates an empty `InlineFunction` instance.
+  InlineFunction() noexcept = default;
+
+  /// Creates an empty `InlineFunction` instance.
+  InlineFunction(std::nullptr_t) noexcept {}  // NOLINT
+
+  /**
+   * @brief Creates the `InlineFunction` instance from the callable.
+   *
+   * @param function The callable. An empty `std::function` or a null
+   * function pointer creates an empty instance.
+   */
+  template <
+      typename Function,
+      typename Decayed = typename std::decay<Function>::type,
+      typename std::enable_if<!std::is_same<Decayed, InlineFunction>::value &&
+                              IsCallable<Decayed>::value>::type* = nullptr>
+  InlineFunction(Function&& function) {  // NOLINT
+    if (IsEmpty(function)) {
+      return;
+    }
+
+    Store<Decayed>(std::forward<Function>(function),
+                   std::integral_constant<bool, IsInline<Decayed>()>());
+  }
+
+  InlineFunction(InlineFunction&& other) noexcept { MoveFrom(other); }
+
+  InlineFunction& operator=(InlineFunction&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  InlineFunction& operator=(std::nullptr_t) noexcept {
+    Reset();
+    return *this;
+  }
+
+  InlineFunction(const InlineFunction&) = delete;
+  InlineFunction& operator=(const InlineFunction&) = delete;
+
+  ~InlineFunction() { Reset(); }
+
+  /// Checks whether the instance has a callable.
+  explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+  /**
+   * @brief Calls the callable.
+   *
+   * @throws std::bad_function_call if the instance is empty.
+   */
+  Result operator()(Args... args) const {
+    if (!ops_) {
+      throw std::bad_function_call();
+    }
+    return ops_->invoke(const_cast<Storage*>(&storage_),
+                        std::forward<Args>(args)...);
+  }
+
+ private:
+  using Storage = typename std::aligned_storage<Capacity>::type;
+
+  struct Ops {
+    Result (*invoke)(Storage*, Args&&...);
+    void (*move)(Storage* from, Storage* to);
+    void (*destroy)(Storage*);
+  };
+
+  template <typename Function>
+  static constexpr bool IsInline() {
+    return sizeof(Function) <= sizeof(Storage) &&
+           alignof(Storage) % alignof(Function) == 0 &&
+           std::is_nothrow_move_constructible<Function>::value;
+  }
+
+  template <typename Function>
+  static bool IsEmpty(const Function&) {
+    return false;
+  }
+
+  template <typename Signature>
+  static bool IsEmpty(const std::function<Signature>& function) {
+    return !function;
+  }
+
+  template <typename Function>
+  static bool IsEmpty(Function* function) {
+    return function == nullptr;
+  }
+
+  /// Calls the callable and discards its result, as `Result` is void.
+  template <typename Function>
+  static Result Call(Function& function, std::true_type /*is_void*/,
+                     Args&&... args) {
+    function(std::forward<Args>(args)...);
+  }
+
+  template <typename Function>
+  static Result Call(Function& function, std::false_type /*is_void*/,
+                     Args&&... args) {
+    return function(std::forward<Args>(args)...);
+  }
+
+  /// Keeps the callable in the buffer.
+  template <typename Function>
+  struct InlineOps {
+    static Function* Get(Storage* storage) {
+      return reinterpret_cast<Function*>(storage);
+    }
+
+    static Result Invoke(Storage* storage, Args&&... args) {
+      return Call(*Get(storage), std::is_void<Result>(),
+                  std::forward<Args>(args)...);
+    }
+
+    static void Move(Storage* from, Storage* to) {
+      new (to) Function(std::move(*Get(from)));
+      Get(from)->~Function();
+    }
+
+    static void Destroy(Storage* storage) { Get(storage)->~Function(); }
+
+    static const Ops* Table() {
+      static const Ops ops{&Invoke, &Move, &Destroy};
+      return &ops;
+    }
+  };
+
+  /// Keeps the pointer to the heap allocated callable in the buffer.
+  template <typename Function>
+  struct HeapOps {
+    static Function*& Get(Storage* storage) {
+      return *reinterpret_cast<Function**>(storage);
+    }
+
+    static Result Invoke(Storage* storage, Args&&... args) {
+      return Call(*Get(storage), std::is_void<Result>(),
+                  std::forward<Args>(args)...);
+    }
+
+    static void Move(Storage* from, Storage* to) {
+      new (to) Function*(Get(from));
+      Get(from) = nullptr;
+    }
+
+    static void Destroy(Storage* storage) { delete Get(storage); }
+
+    static const Ops* Table() {
+      static const Ops ops{&Invoke, &Move, &Destroy};
+      return &ops;
+    }
+  };
+
+  template <typename Function, typename Value>
+  void Store(Value&& function, std::true_type /*is_inline*/) {
+    new (&storage_) Function(std::forward<Value>(function));
+    ops_ = InlineOps<Function>::Table();
+  }
+
+  template <typename Function, typename Value>
+  void Store(Value&& function, std::false_type /*is_inline*/) {
+    new (&storage_) Function*(new Function(std::forward<Value>(function)));
+    ops_ = HeapOps<Function>::Table();
+  }
+
+  void MoveFrom(InlineFunction& other) noexcept {
+    if (other.ops_) {
+      other.ops_->move(&other.storage_, &storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() noexcept {
+    if (ops_) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  Storage storage_;
+  const Ops* ops_{nullptr};
+};
+
+}  // namespace utils
+}  // namespace olp
@@ -348,6 +348,38 @@ class LruCache {
     return it;
   }
 
+  /**
+   * @brief Removes a contiguous range of keys from the cache.
+   *
+   * Visits the items in the key order, starting from the first key that is
+   * not less than `from`, and stops at the first key for which `in_range`
+   * returns false. This way, only the keys in the range are visited.
+   *
+   * @note The eviction callback is not called for the removed items.
+   *
+   * @param from The first key of the range.
+   * @param in_range The function that takes a key and returns true if the key
+   * belongs to the range.
+   * @param remove The function that takes a key and a value and returns true
+   * if the item should be removed.
+   *
+   * @return The number of removed items.
+   */
+  template <typename InRange, typename Remove>
+  std::size_t EraseRange(const Key& from, InRange in_range, Remove remove) {
+    std::size_t count = 0u;
+    auto it = map_.lower_bound(from);
+    while (it != map_.end() && in_range(it->first)) {
+      auto current = it++;
+      if (remove(current->first, current->second.value_)) {
+        Erase(current, false);
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
   /**
    * @brief Gets the current size of the cache.
    *
@@ -748,7 +780,7 @@ inline typename LruCache<Key, Value, CacheCostFunc, Compare,
                          Alloc>::const_iterator&
 LruCache<Key, Value, CacheCostFunc, Compare, Alloc>::const_iterator::
 operator--() {
-  this->m_it = this->m_it->second.m_previous;
+  this->m_it = this->m_it->second.previous_;
   return *this;
 }
 
@@ -759,7 +791,7 @@ inline
     LruCache<Key, Value, CacheCostFunc, Compare, Alloc>::const_iterator::
     operator--(int) {
   typename MapType::const_iterator old_value = this->m_it;
-  this->m_it = this->m_it->second.m_previous;
+  this->m_it = this->m_it->second.previous_;
   return const_iterator{old_value};
 }
 
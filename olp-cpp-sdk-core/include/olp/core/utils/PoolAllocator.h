@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace olp {
+namespace utils {
+
+/**
+ * @brief Keeps the freed single-object allocations of the `PoolAllocator`
+ * copies for reuse.
+ *
+ * The memory is taken from the system in chunks and is returned only when
+ * the pool is destroyed, so the node based containers stop calling the
+ * system allocator once they reach their usual size.
+ *
+ * @note The pool is not thread-safe. It must be used by a single container,
+ * which is already protected by a lock when shared between threads.
+ */
+class NodePool {
+ public:
+  /// The number of the blocks taken from the system at once.
+  static constexpr std::size_t kBlocksPerChunk = 256u;
+
+  NodePool() = default;
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  ~NodePool() {
+    for (auto chunk : chunks_) {
+      ::operator delete(chunk);
+    }
+  }
+
+  /**
+   * @brief Allocates a block of the given size.
+   *
+   * @param size The size of the block in bytes.
+   *
+   * @return The pointer to the block.
+   */
+  void* Allocate(std::size_t size) {
+    auto& list = GetFreeList(size);
+    if (!list.head) {
+      Grow(list);
+    }
+
+    auto block = list.head;
+    list.head = block->next;
+    return block;
+  }
+
+  /**
+   * @brief Returns a block to the pool.
+   *
+   * @param pointer The pointer returned by `Allocate`.
+   * @param size The size that was passed to `Allocate`.
+   */
+  void Deallocate(void* pointer, std::size_t size) {
+    auto& list = GetFreeList(size);
+    auto block = static_cast<FreeBlock*>(pointer);
+    block->next = list.head;
+    list.head = block;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct FreeList {
+    std::size_t block_size;
+    FreeBlock* head;
+  };
+
+  static std::size_t BlockSize(std::size_t size) {
+    constexpr auto kAlignment = alignof(std::max_align_t);
+    size = size < sizeof(FreeBlock) ? sizeof(FreeBlock) : size;
+    return (size + kAlignment - 1u) / kAlignment * kAlignment;
+  }
+
+  // A container allocates only a few different node sizes, so a linear
+  // search is the fastest.
+  FreeList& GetFreeList(std::size_t size) {
+    const auto block_size = BlockSize(size);
+    for (auto& list : free_lists_) {
+      if (list.block_size == block_size) {
+        return list;
+      }
+    }
+    free_lists_.push_back(FreeList{block_size, nullptr});
+    return free_lists_.back();
+  }
+
+  void Grow(FreeList& list) {
+    auto chunk =
+        static_cast<char*>(::operator new(list.block_size * kBlocksPerChunk));
+    chunks_.push_back(chunk);
+    for (std::size_t i = kBlocksPerChunk; i > 0u; --i) {
+      auto block = reinterpret_cast<FreeBlock*>(chunk + (i - 1u) *
+                                                            list.block_size);
+      block->next = list.head;
+      list.head = block;
+    }
+  }
+
+  std::vector<FreeList> free_lists_;
+  std::vector<void*> chunks_;
+};
+
+/**
+ * @brief An allocator that takes the single objects from a `NodePool`.
+ *
+ * Suits the node based containers, such as the map of the `LruCache`, which
+ * allocate each element separately. The arrays are allocated by the system
+ * allocator. All the copies of the allocator, including the rebound ones,
+ * share the pool.
+ *
+ * @tparam T The allocated type.
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  /// The allocated type.
+  using value_type = T;
+
+  /// The containers take over the pool with the elements.
+  using propagate_on_container_move_assignment = std::true_type;
+  /// The containers take over the pool with the elements.
+  using propagate_on_container_swap = std::true_type;
+
+  /// Creates an allocator with a new pool.
+  PoolAllocator() : pool_(std::make_shared<NodePool>()) {}
+
+  /// Creates an allocator that shares the pool of the other one.
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) noexcept  // NOLINT
+      : pool_(other.pool_) {}
+
+  /**
+   * @brief Allocates the memory for the objects.
+   *
+   * @param count The number of the objects.
+   *
+   * @return The pointer to the memory.
+   */
+  T* allocate(std::size_t count) {
+    if (count == 1u) {
+      return static_cast<T*>(pool_->Allocate(sizeof(T)));
+    }
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+  }
+
+  /**
+   * @brief Releases the memory of the objects.
+   *
+   * @param pointer The pointer returned by `allocate`.
+   * @param count The number of the objects passed to `allocate`.
+   */
+  void deallocate(T* pointer, std::size_t count) noexcept {
+    if (count == 1u) {
+      pool_->Deallocate(pointer, sizeof(T));
+    } else {
+      ::operator delete(pointer);
+    }
+  }
+
+  /// Checks whether both allocators share the pool.
+  template <typename U>
+  bool operator==(const PoolAllocator<U>& other) const noexcept {
+    return pool_ == other.pool_;
+  }
+
+  /// Checks whether the allocators use different pools.
+  template <typename U>
+  bool operator!=(const PoolAllocator<U>& other) const noexcept {
+    return pool_ != other.pool_;
+  }
+
+ private:
+  template <typename>
+  friend class PoolAllocator;
+
+  std::shared_ptr<NodePool> pool_;
+};
+
+}  // namespace utils
+}  // namespace olp
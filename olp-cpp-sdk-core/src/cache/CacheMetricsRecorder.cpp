@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "CacheMetricsRecorder.h"
+
+namespace olp {
+namespace cache {
+
+namespace {
+constexpr auto kRelaxed = std::memory_order_relaxed;
+
+void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+  counter.fetch_add(value, kRelaxed);
+}
+
+size_t GetBucket(uint64_t microseconds) {
+  size_t bucket = 0u;
+  while (microseconds > 0u &&
+         bucket + 1u < CacheLatencyHistogram::kBucketCount) {
+    microseconds >>= 1u;
+    ++bucket;
+  }
+  return bucket;
+}
+}  // namespace
+
+constexpr size_t CacheLatencyHistogram::kBucketCount;
+
+CacheMetricsRecorder::ScopedTimer::ScopedTimer(CacheMetricsRecorder& recorder,
+                                               Operation operation)
+    : recorder_(recorder), operation_(operation) {
+  if (recorder_.IsEnabled()) {
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+CacheMetricsRecorder::ScopedTimer::~ScopedTimer() {
+  if (recorder_.IsEnabled()) {
+    recorder_.RecordLatency(operation_,
+                            std::chrono::steady_clock::now() - start_);
+  }
+}
+
+CacheMetricsRecorder::CacheMetricsRecorder(bool enabled) : enabled_(enabled) {
+  Reset();
+}
+
+void CacheMetricsRecorder::RecordHit(Tier tier, size_t bytes) {
+  if (!enabled_) {
+    return;
+  }
+
+  auto& counters = GetTier(tier);
+  Add(counters.hits, 1u);
+  Add(counters.bytes_read, bytes);
+}
+
+void CacheMetricsRecorder::RecordMiss(Tier tier) {
+  if (enabled_) {
+    Add(GetTier(tier).misses, 1u);
+  }
+}
+
+void CacheMetricsRecorder::RecordWrite(Tier tier, size_t bytes) {
+  if (enabled_) {
+    Add(GetTier(tier).bytes_written, bytes);
+  }
+}
+
+void CacheMetricsRecorder::RecordEvictions(Tier tier, uint64_t count) {
+  if (enabled_) {
+    Add(GetTier(tier).evictions, count);
+  }
+}
+
+void CacheMetricsRecorder::RecordExpiration(Tier tier) {
+  if (enabled_) {
+    Add(GetTier(tier).expirations, 1u);
+  }
+}
+
+void CacheMetricsRecorder::RecordLatency(
+    Operation operation, std::chrono::steady_clock::duration duration) {
+  if (!enabled_) {
+    return;
+  }
+
+  const auto microseconds = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+  auto& histogram = histograms_[static_cast<size_t>(operation)];
+  Add(histogram.buckets[GetBucket(microseconds)], 1u);
+  Add(histogram.count, 1u);
+  Add(histogram.total_time_us, microseconds);
+}
+
+CacheMetrics CacheMetricsRecorder::GetMetrics() const {
+  auto copy_tier = [](const TierCounters& counters) {
+    CacheTierMetrics metrics;
+    metrics.hits = counters.hits.load(kRelaxed);
+    metrics.misses = counters.misses.load(kRelaxed);
+    metrics.bytes_read = counters.bytes_read.load(kRelaxed);
+    metrics.bytes_written = counters.bytes_written.load(kRelaxed);
+    metrics.evictions = counters.evictions.load(kRelaxed);
+    metrics.expirations = counters.expirations.load(kRelaxed);
+    return metrics;
+  };
+
+  auto copy_histogram = [](const Histogram& histogram) {
+    CacheLatencyHistogram metrics;
+    for (size_t i = 0u; i < metrics.buckets.size(); ++i) {
+      metrics.buckets[i] = histogram.buckets[i].load(kRelaxed);
+    }
+    metrics.count = histogram.count.load(kRelaxed);
+    metrics.total_time = std::chrono::microseconds(
+        histogram.total_time_us.load(kRelaxed));
+    return metrics;
+  };
+
+  CacheMetrics metrics;
+  metrics.memory = copy_tier(tiers_[static_cast<size_t>(Tier::kMemory)]);
+  metrics.mutable_disk = copy_tier(tiers_[static_cast<size_t>(Tier::kMutable)]);
+  metrics.protected_disk =
+      copy_tier(tiers_[static_cast<size_t>(Tier::kProtected)]);
+  metrics.shared_disk = copy_tier(tiers_[static_cast<size_t>(Tier::kShared)]);
+  metrics.get_latency =
+      copy_histogram(histograms_[static_cast<size_t>(Operation::kGet)]);
+  metrics.put_latency =
+      copy_histogram(histograms_[static_cast<size_t>(Operation::kPut)]);
+  return metrics;
+}
+
+void CacheMetricsRecorder::Reset() {
+  for (auto& counters : tiers_) {
+    counters.hits.store(0u, kRelaxed);
+    counters.misses.store(0u, kRelaxed);
+    counters.bytes_read.store(0u, kRelaxed);
+    counters.bytes_written.store(0u, kRelaxed);
+    counters.evictions.store(0u, kRelaxed);
+    counters.expirations.store(0u, kRelaxed);
+  }
+
+  for (auto& histogram : histograms_) {
+    for (auto& bucket : histogram.buckets) {
+      bucket.store(0u, kRelaxed);
+    }
+    histogram.count.store(0u, kRelaxed);
+    histogram.total_time_us.store(0u, kRelaxed);
+  }
+}
+
+CacheMetricsRecorder::TierCounters& CacheMetricsRecorder::GetTier(Tier tier) {
+  return tiers_[static_cast<size_t>(tier)];
+}
+
+}  // namespace cache
+}  // namespace olp
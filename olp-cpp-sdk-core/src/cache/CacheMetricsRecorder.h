@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <olp/core/cache/CacheMetrics.h>
+
+namespace olp {
+namespace cache {
+
+/// Collects the `CacheMetrics` of the default cache. All the methods are
+/// thread safe and do nothing when the recorder is disabled.
+class CacheMetricsRecorder {
+ public:
+  /// The cache tier.
+  enum class Tier { kMemory, kMutable, kProtected, kShared };
+
+  /// The measured operation.
+  enum class Operation { kGet, kPut };
+
+  /// Records the latency of an operation from its creation to its destruction.
+  class ScopedTimer {
+   public:
+    ScopedTimer(CacheMetricsRecorder& recorder, Operation operation);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+   private:
+    CacheMetricsRecorder& recorder_;
+    Operation operation_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  explicit CacheMetricsRecorder(bool enabled);
+
+  bool IsEnabled() const { return enabled_; }
+
+  void RecordHit(Tier tier, size_t bytes);
+  void RecordMiss(Tier tier);
+  void RecordWrite(Tier tier, size_t bytes);
+  void RecordEvictions(Tier tier, uint64_t count);
+  void RecordExpiration(Tier tier);
+  void RecordLatency(Operation operation,
+                     std::chrono::steady_clock::duration duration);
+
+  /// Returns a snapshot of the counters.
+  CacheMetrics GetMetrics() const;
+
+  /// Sets all the counters to zero.
+  void Reset();
+
+ private:
+  using Counter = std::atomic<uint64_t>;
+
+  struct TierCounters {
+    Counter hits;
+    Counter misses;
+    Counter bytes_read;
+    Counter bytes_written;
+    Counter evictions;
+    Counter expirations;
+  };
+
+  struct Histogram {
+    std::array<Counter, CacheLatencyHistogram::kBucketCount> buckets;
+    Counter count;
+    Counter total_time_us;
+  };
+
+  TierCounters& GetTier(Tier tier);
+
+  const bool enabled_;
+  std::array<TierCounters, 4u> tiers_;
+  std::array<Histogram, 2u> histograms_;
+};
+
+}  // namespace cache
+}  // namespace olp
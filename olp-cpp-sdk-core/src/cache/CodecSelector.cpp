@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "CodecSelector.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "olp/core/logging/Log.h"
+
+namespace {
+constexpr auto kLogTag = "CodecSelector";
+
+// The header of an encoded value is the magic followed by the codec ID.
+constexpr char kCodecMagic[] = {'\0', 'O', 'L', 'C'};
+constexpr auto kCodecMagicSize = sizeof(kCodecMagic);
+constexpr auto kHeaderSize = kCodecMagicSize + 1u;
+// The ID of the values that are stored as is, but start with the magic.
+constexpr std::uint8_t kEscapedId = 0u;
+
+bool HasMagic(const char* data, size_t size) {
+  return size >= kCodecMagicSize &&
+         std::memcmp(data, kCodecMagic, kCodecMagicSize) == 0;
+}
+
+void AddHeader(std::uint8_t id, const char* data, size_t size,
+               std::string& output) {
+  output.clear();
+  output.reserve(kHeaderSize + size);
+  output.append(kCodecMagic, kCodecMagicSize);
+  output.push_back(static_cast<char>(id));
+  output.append(data, size);
+}
+}  // namespace
+
+namespace olp {
+namespace cache {
+
+CodecSelector::CodecSelector(KeyCodecs codecs)
+    : codecs_(std::move(codecs)),
+      has_codecs_(std::any_of(
+          codecs_.begin(), codecs_.end(),
+          [](const KeyCodecs::value_type& codec) { return codec.second; })) {}
+
+bool CodecSelector::HasCodecs() const { return has_codecs_; }
+
+bool CodecSelector::Encode(const std::string& key, const char* data,
+                           size_t size, std::string& output) const {
+  const auto* codec = FindCodec(key);
+  std::string encoded;
+  if (!codec || !codec->Encode(data, size, encoded)) {
+    return Escape(data, size, output);
+  }
+
+  AddHeader(codec->GetId(), encoded.data(), encoded.size(), output);
+  return true;
+}
+
+bool CodecSelector::Escape(const char* data, size_t size,
+                           std::string& output) const {
+  if (!has_codecs_ || !HasMagic(data, size)) {
+    return false;
+  }
+
+  AddHeader(kEscapedId, data, size, output);
+  return true;
+}
+
+CodecSelector::DecodeResult CodecSelector::Decode(const char* data,
+                                                  size_t size,
+                                                  std::string& output) const {
+  if (!has_codecs_ || size < kHeaderSize || !HasMagic(data, size)) {
+    return DecodeResult::kNotEncoded;
+  }
+
+  const auto id = static_cast<std::uint8_t>(data[kCodecMagicSize]);
+  if (id == kEscapedId) {
+    output.assign(data + kHeaderSize, size - kHeaderSize);
+    return DecodeResult::kDecoded;
+  }
+
+  const auto* codec = FindCodec(id);
+  if (!codec) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Decode: codec is not configured, id=%u",
+                          static_cast<unsigned>(id));
+    return DecodeResult::kFailed;
+  }
+
+  if (!codec->Decode(data + kHeaderSize, size - kHeaderSize, output)) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Decode: failed, id=%u",
+                          static_cast<unsigned>(id));
+    return DecodeResult::kFailed;
+  }
+
+  return DecodeResult::kDecoded;
+}
+
+const CacheCodec* CodecSelector::FindCodec(const std::string& key) const {
+  for (const auto& codec : codecs_) {
+    if (key.find(codec.first) != std::string::npos) {
+      return codec.second.get();
+    }
+  }
+
+  return nullptr;
+}
+
+const CacheCodec* CodecSelector::FindCodec(std::uint8_t id) const {
+  for (const auto& codec : codecs_) {
+    if (codec.second && codec.second->GetId() == id) {
+      return codec.second.get();
+    }
+  }
+
+  return nullptr;
+}
+
+}  // namespace cache
+}  // namespace olp
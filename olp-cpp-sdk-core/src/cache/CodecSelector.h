@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <olp/core/cache/CacheCodec.h>
+
+namespace olp {
+namespace cache {
+
+/// Selects the codec for a key and adds or parses the header of the encoded
+/// values.
+class CodecSelector {
+ public:
+  using KeyCodecs =
+      std::vector<std::pair<std::string, std::shared_ptr<CacheCodec>>>;
+
+  /// The result of the decode operation.
+  enum class DecodeResult {
+    /// The value has no header and is used as is.
+    kNotEncoded,
+    /// The value is decoded to the output.
+    kDecoded,
+    /// The codec is not configured or failed to decode the value.
+    kFailed
+  };
+
+  explicit CodecSelector(KeyCodecs codecs);
+
+  /// Returns true if there is at least one codec configured.
+  bool HasCodecs() const;
+
+  /// Encodes the value with the codec of the key and adds the header, or
+  /// escapes it if it is not encoded. Returns false if the value should be
+  /// stored as is.
+  bool Encode(const std::string& key, const char* data, size_t size,
+              std::string& output) const;
+
+  /// Adds the header of the values stored as is if the value starts with the
+  /// header magic, so it is not taken for an encoded value. Returns false if
+  /// the value should be stored as is.
+  bool Escape(const char* data, size_t size, std::string& output) const;
+
+  /// Decodes the value if it has a header. The values are used as is when no
+  /// codec is configured.
+  DecodeResult Decode(const char* data, size_t size,
+                      std::string& output) const;
+
+ private:
+  const CacheCodec* FindCodec(const std::string& key) const;
+
+  const CacheCodec* FindCodec(std::uint8_t id) const;
+
+  KeyCodecs codecs_;
+  bool has_codecs_;
+};
+
+}  // namespace cache
+}  // namespace olp
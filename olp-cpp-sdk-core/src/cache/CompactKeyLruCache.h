@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <olp/core/utils/HashLruCache.h>
+#include <olp/core/utils/PoolAllocator.h>
+#include "KeyPrefixTable.h"
+
+namespace olp {
+namespace cache {
+
+/// The LRU cache of the `DefaultCacheImpl` mutable cache keys. It has the
+/// interface of the `utils::LruCache` for the string keys, but keeps them as
+/// a `CompactKey`, so the long prefixes of millions of keys are stored once.
+template <typename Value>
+class CompactKeyLruCache {
+  using LruType =
+      utils::HashLruCache<CompactKey, Value, utils::CacheCost<Value>,
+                          CompactKeyHash, std::equal_to<CompactKey>,
+                          utils::PoolAllocator>;
+
+ public:
+  /// A constant iterator that goes from the most to the least recently used
+  /// element, and restores the keys on access.
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = const_iterator;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+
+    const_iterator() = default;
+
+    /// Returns the restored key of the element.
+    std::string key() const { return prefixes_->Expand(it_.key()); }
+
+    /// Returns the value of the element.
+    const Value& value() const { return it_.value(); }
+
+    bool operator==(const const_iterator& other) const {
+      return it_ == other.it_;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return it_ != other.it_;
+    }
+
+    const_iterator& operator++() {
+      ++it_;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      auto old = *this;
+      ++it_;
+      return old;
+    }
+
+    const_iterator& operator--() {
+      --it_;
+      return *this;
+    }
+
+    const_iterator operator--(int) {
+      auto old = *this;
+      --it_;
+      return old;
+    }
+
+    reference operator*() const { return *this; }
+
+    pointer operator->() const { return this; }
+
+   private:
+    friend class CompactKeyLruCache;
+
+    const_iterator(typename LruType::const_iterator it,
+                   const KeyPrefixTable* prefixes)
+        : it_(it), prefixes_(prefixes) {}
+
+    typename LruType::const_iterator it_;
+    const KeyPrefixTable* prefixes_{nullptr};
+  };
+
+  explicit CompactKeyLruCache(size_t max_size) : lru_(max_size) {}
+
+  /// Inserts or updates the value of the key.
+  template <typename _Value>
+  std::pair<const_iterator, bool> InsertOrAssign(const std::string& key,
+                                                 _Value&& value) {
+    auto result = lru_.InsertOrAssign(prefixes_.Compress(key),
+                                      std::forward<_Value>(value));
+    return std::make_pair(Wrap(result.first), result.second);
+  }
+
+  /// Finds the key and promotes it.
+  const_iterator Find(const std::string& key) {
+    return Wrap(lru_.Find(prefixes_.Find(key)));
+  }
+
+  /// Finds the key without promoting it.
+  const_iterator FindNoPromote(const std::string& key) const {
+    return Wrap(lru_.FindNoPromote(prefixes_.Find(key)));
+  }
+
+  /// Removes the key, returns false if it is not in the cache.
+  bool Erase(const std::string& key) { return lru_.Erase(prefixes_.Find(key)); }
+
+  /// Removes the element of the iterator, which moves to the next element.
+  const_iterator Erase(const_iterator& it) {
+    lru_.Erase(it.it_);
+    return it;
+  }
+
+  /**
+   * @brief Removes the keys with the prefix.
+   *
+   * @param prefix The key prefix.
+   * @param remove The function that takes a key and a value and returns true
+   * if the element should be removed.
+   *
+   * @return The number of the removed elements.
+   */
+  template <typename Remove>
+  size_t ErasePrefix(const std::string& prefix, Remove remove) {
+    return lru_.EraseRange(
+        CompactKey{},
+        [&](const CompactKey& key) {
+          return prefixes_.StartsWith(key, prefix);
+        },
+        [&](const CompactKey& key, const Value& value) {
+          return remove(prefixes_.Expand(key), value);
+        });
+  }
+
+  /// Converts the key for the indexes that refer to the elements.
+  CompactKey ToCompactKey(const std::string& key) {
+    return prefixes_.Compress(key);
+  }
+
+  /// Restores the key converted by `ToCompactKey`.
+  std::string ToKey(const CompactKey& key) const {
+    return prefixes_.Expand(key);
+  }
+
+  /// Returns the number of the elements.
+  size_t Size() const { return lru_.Size(); }
+
+  /// Reserves the space for the number of the elements.
+  void Reserve(size_t count) { lru_.Reserve(count); }
+
+  /// Removes all the elements. The interned prefixes are kept, so the compact
+  /// keys of the indexes stay valid.
+  void Clear() { lru_.Clear(); }
+
+  const_iterator begin() const { return Wrap(lru_.begin()); }
+  const_iterator end() const { return Wrap(lru_.end()); }
+  const_iterator rbegin() const { return Wrap(lru_.rbegin()); }
+  const_iterator rend() const { return Wrap(lru_.rend()); }
+
+ private:
+  const_iterator Wrap(typename LruType::const_iterator it) const {
+    return const_iterator(it, &prefixes_);
+  }
+
+  KeyPrefixTable prefixes_;
+  LruType lru_;
+};
+
+}  // namespace cache
+}  // namespace olp
@@ -43,6 +43,42 @@ bool DefaultCache::Clear() { return impl_->Clear(); }
 
 void DefaultCache::Compact() { return impl_->Compact(); }
 
+std::future<DefaultCache::CompactionStatistics>
+DefaultCache::ScheduleCompaction(uint64_t bytes_per_second) {
+  return impl_->ScheduleCompaction(bytes_per_second);
+}
+
+bool DefaultCache::Flush() { return impl_->Flush(); }
+
+DefaultCache::EvictionStatistics DefaultCache::GetEvictionStatistics() const {
+  return impl_->GetEvictionStatistics();
+}
+
+CacheMetrics DefaultCache::GetMetrics() const { return impl_->GetMetrics(); }
+
+void DefaultCache::ResetMetrics() { impl_->ResetMetrics(); }
+
+bool DefaultCache::ExportToProtectedCache(const std::string& path) {
+  return impl_->ExportToProtectedCache(path);
+}
+
+bool DefaultCache::CreateProtectedCacheDelta(const std::string& base_path,
+                                             const std::string& target_path,
+                                             const std::string& delta_path) {
+  return DefaultCacheImpl::CreateProtectedCacheDelta(base_path, target_path,
+                                                     delta_path);
+}
+
+bool DefaultCache::ApplyProtectedCacheDelta(const std::string& delta_path) {
+  return impl_->ApplyProtectedCacheDelta(delta_path);
+}
+
+std::future<uint64_t> DefaultCache::WarmUp(const KeyListType& prefixes,
+                                           uint64_t byte_budget,
+                                           const Decoder& decoder) {
+  return impl_->WarmUp(prefixes, byte_budget, decoder);
+}
+
 bool DefaultCache::Put(const std::string& key, const boost::any& value,
                        const Encoder& encoder, time_t expiry) {
   return impl_->Put(key, value, encoder, expiry);
@@ -61,6 +97,35 @@ KeyValueCache::ValueTypePtr DefaultCache::Get(const std::string& key) {
   return impl_->Get(key);
 }
 
+KeyValueCache::ValueView DefaultCache::GetView(const std::string& key) {
+  return impl_->GetView(key);
+}
+
+std::unique_ptr<KeyValueCache::ValueWriter> DefaultCache::OpenWriter(
+    const std::string& key, time_t expiry) {
+  auto writer = impl_->OpenWriter(key, expiry);
+  return writer ? std::move(writer) : KeyValueCache::OpenWriter(key, expiry);
+}
+
+bool DefaultCache::PutBatch(const KeyValueListType& items, time_t expiry) {
+  return impl_->PutBatch(items, expiry);
+}
+
+bool DefaultCache::PutBatch(const KeyEncodedValueListType& items,
+                            time_t expiry) {
+  return impl_->PutBatch(items, expiry);
+}
+
+std::vector<KeyValueCache::ValueTypePtr> DefaultCache::GetBatch(
+    const KeyListType& keys) {
+  return impl_->GetBatch(keys);
+}
+
+std::vector<boost::any> DefaultCache::GetBatch(const KeyListType& keys,
+                                               const Decoder& decoder) {
+  return impl_->GetBatch(keys, decoder);
+}
+
 bool DefaultCache::Remove(const std::string& key) { return impl_->Remove(key); }
 
 bool DefaultCache::RemoveKeysWithPrefix(const std::string& prefix) {
@@ -71,6 +136,10 @@ bool DefaultCache::Contains(const std::string& key) const {
   return impl_->Contains(key);
 }
 
+std::vector<bool> DefaultCache::ContainsBatch(const KeyListType& keys) const {
+  return impl_->ContainsBatch(keys);
+}
+
 bool DefaultCache::Protect(const KeyValueCache::KeyListType& keys) {
   return impl_->Protect(keys);
 }
@@ -22,29 +22,50 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "olp/core/cache/RefetchCostScope.h"
 #include "olp/core/logging/Log.h"
 #include "olp/core/porting/make_unique.h"
 
 namespace {
 using CacheType = olp::cache::DefaultCache::CacheType;
+using Tier = olp::cache::CacheMetricsRecorder::Tier;
+using Operation = olp::cache::CacheMetricsRecorder::Operation;
 
 constexpr auto kLogTag = "DefaultCache";
 constexpr auto kExpirySuffix = "::expiry";
 constexpr auto kProtectedKeys = "internal::protected::protected_data";
 constexpr auto kInternalKeysPrefix = "internal::";
+constexpr auto kLruCheckpointKey = "internal::lru::checkpoint";
+constexpr uint32_t kLruCheckpointVersion = 2u;
+// version, data size, LRU flag and the number of entries.
+constexpr auto kLruCheckpointHeaderSize = 4u + 8u + 1u + 8u;
+// key size, value size, expiry and re-fetch cost, followed by the key.
+constexpr auto kLruCheckpointEntrySize = 4u + 8u + 8u + 4u;
 constexpr auto kMaxDiskSize = std::uint64_t(-1);
-constexpr auto kMinDiskUsedThreshold = 0.85f;
-constexpr auto kMaxDiskUsedThreshold = 0.9f;
 constexpr auto kEvictionPortion = 1024u * 1024u;  // 1 MB
+constexpr auto kWarmUpPortion = 256u;              // keys
+// The number of the least recently used keys the cost-aware eviction picks
+// the victim from.
+constexpr auto kCostAwareEvictionWindow = 32u;
+// The re-fetch cost of the values put without a RefetchCostScope.
+constexpr auto kDefaultRefetchCost = 100u;  // ms
 
 // current epoch time contains 10 digits.
 constexpr auto kExpiryValueSize = 10;
 const auto kExpirySuffixLength = strlen(kExpirySuffix);
 
+uint32_t CurrentRefetchCost() {
+  const auto cost = olp::cache::RefetchCostScope::GetCurrentCost().count();
+  return static_cast<uint32_t>(std::min<int64_t>(
+      std::max<int64_t>(cost, 0), std::numeric_limits<uint32_t>::max()));
+}
+
 std::string CreateExpiryKey(const std::string& key) {
   return key + kExpirySuffix;
 }
@@ -57,8 +78,18 @@ bool IsExpiryValid(time_t expiry) {
   return expiry < olp::cache::KeyValueCache::kDefaultExpiry;
 }
 
-time_t GetRemainingExpiryTime(const std::string& key,
-                              olp::cache::DiskCache& disk_cache) {
+// The size of the key, the value and the expiry, as counted by the eviction.
+uint64_t GetLruEntrySize(const std::string& key, size_t value_size,
+                         time_t expiry) {
+  uint64_t size = key.size() + value_size;
+  if (IsExpiryValid(expiry)) {
+    size += key.size() + kExpirySuffixLength + kExpiryValueSize;
+  }
+  return size;
+}
+
+template <typename Cache>
+time_t GetRemainingExpiryTime(const std::string& key, Cache& disk_cache) {
   auto expiry_key = CreateExpiryKey(key);
   auto expiry = olp::cache::KeyValueCache::kDefaultExpiry;
   auto expiry_value = disk_cache.Get(expiry_key);
@@ -98,6 +129,13 @@ leveldb::CompressionType GetCompression(
              : leveldb::kSnappyCompression;
 }
 
+void ApplyTuning(const olp::cache::DiskCacheTuning& tuning,
+                 olp::cache::StorageSettings& storage_settings) {
+  storage_settings.bloom_filter_bits_per_key = tuning.bloom_filter_bits_per_key;
+  storage_settings.block_cache_size = tuning.block_cache_size;
+  storage_settings.block_size = tuning.block_size;
+}
+
 olp::cache::StorageSettings CreateStorageSettings(
     const olp::cache::CacheSettings& settings) {
   olp::cache::StorageSettings storage_settings;
@@ -106,6 +144,9 @@ olp::cache::StorageSettings CreateStorageSettings(
   storage_settings.enforce_immediate_flush = settings.enforce_immediate_flush;
   storage_settings.max_file_size = settings.max_file_size;
   storage_settings.compression = GetCompression(settings.compression);
+  storage_settings.compaction_rate_limit = settings.compaction_rate_limit;
+  storage_settings.large_value_threshold = settings.large_value_threshold;
+  ApplyTuning(settings.mutable_cache_tuning, storage_settings);
 
   return storage_settings;
 }
@@ -119,6 +160,96 @@ int64_t GetElapsedTime(std::chrono::steady_clock::time_point start) {
 bool IsInternalKey(const std::string& key) {
   return key.find(kInternalKeysPrefix) == 0u;
 }
+
+template <typename Type>
+void AppendCheckpointValue(std::string& buffer, Type value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename Type>
+bool ReadCheckpointValue(const char*& data, const char* end, Type& value) {
+  if (static_cast<size_t>(end - data) < sizeof(value)) {
+    return false;
+  }
+
+  memcpy(&value, data, sizeof(value));
+  data += sizeof(value);
+  return true;
+}
+
+void AssignPendingValue(const olp::cache::KeyValueCache::ValueTypePtr& binary,
+                        const std::string& encoded,
+                        olp::cache::KeyValueCache::ValueTypePtr& value) {
+  value = binary ? binary
+                 : std::make_shared<olp::cache::KeyValueCache::ValueType>(
+                       encoded.begin(), encoded.end());
+}
+
+void AssignPendingValue(const olp::cache::KeyValueCache::ValueTypePtr& binary,
+                        const std::string& encoded,
+                        std::shared_ptr<std::string>& value) {
+  value = binary ? std::make_shared<std::string>(binary->begin(), binary->end())
+                 : std::make_shared<std::string>(encoded);
+}
+
+void AssignDecodedValue(std::string decoded,
+                        olp::cache::KeyValueCache::ValueTypePtr& value) {
+  value = std::make_shared<olp::cache::KeyValueCache::ValueType>(
+      decoded.begin(), decoded.end());
+}
+
+void AssignDecodedValue(std::string decoded,
+                        std::shared_ptr<std::string>& value) {
+  value = std::make_shared<std::string>(std::move(decoded));
+}
+
+std::unique_ptr<olp::cache::InMemoryCache> CreateMemoryCache(
+    const olp::cache::CacheSettings& settings) {
+  if (settings.max_memory_cache_size == 0) {
+    return nullptr;
+  }
+
+  using olp::cache::InMemoryCache;
+  return std::make_unique<InMemoryCache>(
+      settings.max_memory_cache_size, InMemoryCache::DefaultCacheCost(),
+      InMemoryCache::DefaultTimeProvider(), settings.memory_cache_shards,
+      settings.memory_cache_admission ==
+          olp::cache::AdmissionPolicy::kTinyLfu);
+}
+/// Writes the chunks to a separate file of the mutable cache and stores the
+/// reference to it on commit.
+class LargeValueWriter final
+    : public olp::cache::KeyValueCache::ValueWriter {
+ public:
+  LargeValueWriter(olp::cache::DefaultCacheImpl& cache,
+                   std::unique_ptr<olp::cache::LargeValueStore::Writer> writer,
+                   std::string key, time_t expiry)
+      : cache_(cache),
+        writer_(std::move(writer)),
+        key_(std::move(key)),
+        expiry_(expiry) {}
+
+  bool Append(const unsigned char* data, size_t size) override {
+    return writer_ &&
+           writer_->Append(reinterpret_cast<const char*>(data), size);
+  }
+
+  bool Commit() override {
+    std::string reference;
+    if (!writer_ || !writer_->Finish(reference)) {
+      return false;
+    }
+
+    writer_.reset();
+    return cache_.PutLargeValue(key_, reference, expiry_);
+  }
+
+ private:
+  olp::cache::DefaultCacheImpl& cache_;
+  std::unique_ptr<olp::cache::LargeValueStore::Writer> writer_;
+  std::string key_;
+  time_t expiry_;
+};
 }  // namespace
 
 namespace olp {
@@ -127,22 +258,53 @@ namespace cache {
 DefaultCacheImpl::DefaultCacheImpl(CacheSettings settings)
     : settings_(std::move(settings)),
       is_open_(false),
-      memory_cache_(nullptr),
+      memory_cache_(CreateMemoryCache(settings_)),
       mutable_cache_(nullptr),
       mutable_cache_lru_(nullptr),
       protected_cache_(nullptr),
+      mapped_protected_cache_(nullptr),
       mutable_cache_data_size_(0),
-      eviction_portion_(kEvictionPortion) {}
+      eviction_portion_(kEvictionPortion),
+      write_in_flight_(false),
+      write_behind_stop_(false),
+      eviction_requested_(false),
+      eviction_stop_(false),
+      warm_up_stop_(false),
+      compaction_stop_(false),
+      codecs_(settings_.codecs),
+      metrics_(settings_.collect_metrics),
+      memory_consumer_id_(0u) {
+  for (const auto& quota : settings_.prefix_quotas) {
+    prefix_quotas_[quota.first] = {quota.second, 0u};
+  }
+
+  if (settings_.memory_budget && memory_cache_) {
+    memory_consumer_id_ = settings_.memory_budget->Register(
+        [this](client::MemoryPressure pressure) {
+          OnMemoryPressure(pressure);
+        });
+    OnMemoryPressure(settings_.memory_budget->GetPressure());
+  }
+}
 
 DefaultCache::StorageOpenResult DefaultCacheImpl::Open() {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  // Opening again recreates the mutable cache.
+  std::lock_guard<std::mutex> compaction_lock(compaction_lock_);
+  StopCompaction();
+
+  auto lock = LockForWrite();
   is_open_ = true;
-  return SetupStorage();
+  auto result = SetupStorage();
+  if (settings_.disk_path_mutable) {
+    StartWriteBehind();
+    StartEviction();
+  }
+  return result;
 }
 
 DefaultCache::StorageOpenResult DefaultCacheImpl::Open(
     DefaultCache::CacheType type) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  auto lock = LockForWrite();
   if (!is_open_) {
     return DefaultCache::NotReady;
   }
@@ -162,11 +324,13 @@ DefaultCache::StorageOpenResult DefaultCacheImpl::Open(
       memory_cache_->Clear();
     }
 
+    StartWriteBehind();
+    StartEviction();
     return SetupMutableCache();
   }
 
   // DefaultCache::CacheType::kProtected case
-  if (protected_cache_) {
+  if (protected_cache_ || mapped_protected_cache_) {
     return DefaultCache::Success;
   }
 
@@ -183,33 +347,74 @@ DefaultCache::StorageOpenResult DefaultCacheImpl::Open(
   return SetupProtectedCache();
 }
 
-DefaultCacheImpl::~DefaultCacheImpl() { Close(); }
+DefaultCacheImpl::~DefaultCacheImpl() {
+  if (settings_.memory_budget && memory_cache_) {
+    settings_.memory_budget->Unregister(memory_consumer_id_);
+  }
+  Close();
+}
 
 void DefaultCacheImpl::Close() {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  StopWarmUp();
+  std::lock_guard<std::mutex> compaction_lock(compaction_lock_);
+  StopCompaction();
+  StopWriteBehind();
+  StopEviction();
+
+  std::lock_guard<MutexType> lock(cache_lock_);
   if (!is_open_) {
     return;
   }
 
-  memory_cache_.reset();
+  WritePendingWrites();
+  if (memory_cache_) {
+    memory_cache_->Clear();
+  }
   DestroyCache(DefaultCache::CacheType::kMutable);
   DestroyCache(DefaultCache::CacheType::kProtected);
+  shared_cache_.reset();
   is_open_ = false;
 }
 
+void DefaultCacheImpl::OnMemoryPressure(client::MemoryPressure pressure) {
+  const auto max_size = settings_.max_memory_cache_size;
+  switch (pressure) {
+    case client::MemoryPressure::kNone:
+      memory_cache_->Resize(max_size);
+      break;
+    case client::MemoryPressure::kModerate:
+      memory_cache_->Resize(max_size / 4u);
+      break;
+    case client::MemoryPressure::kCritical:
+      memory_cache_->Resize(0u);
+      break;
+  }
+}
+
 bool DefaultCacheImpl::Close(DefaultCache::CacheType type) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  std::lock_guard<std::mutex> compaction_lock(compaction_lock_);
+  if (type == DefaultCache::CacheType::kMutable) {
+    StopCompaction();
+  }
+
+  auto lock = LockForWrite();
   if (!is_open_) {
     return false;
   }
 
+  if (type == DefaultCache::CacheType::kMutable) {
+    WritePendingWrites();
+  }
   DestroyCache(type);
 
   return true;
 }
 
 bool DefaultCacheImpl::Clear() {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  std::lock_guard<std::mutex> compaction_lock(compaction_lock_);
+  StopCompaction();
+
+  auto lock = LockForWrite();
   if (!is_open_) {
     return false;
   }
@@ -221,6 +426,7 @@ bool DefaultCacheImpl::Clear() {
   if (mutable_cache_lru_) {
     mutable_cache_lru_->Clear();
   }
+  ClearLruIndexes();
 
   if (mutable_cache_) {
     mutable_cache_data_size_ = 0;
@@ -233,29 +439,130 @@ bool DefaultCacheImpl::Clear() {
 }
 
 void DefaultCacheImpl::Compact() {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  auto lock = LockForWrite();
   if (mutable_cache_) {
+    WritePendingWrites();
     mutable_cache_->Compact();
   }
 }
 
+std::future<DefaultCache::CompactionStatistics>
+DefaultCacheImpl::ScheduleCompaction(uint64_t bytes_per_second) {
+  // Only one compaction runs at a time.
+  std::lock_guard<std::mutex> compaction_lock(compaction_lock_);
+  StopCompaction();
+
+  std::promise<DefaultCache::CompactionStatistics> promise;
+  auto future = promise.get_future();
+
+  auto lock = LockForWrite();
+  if (!is_open_ || !mutable_cache_ || compaction_thread_.joinable()) {
+    promise.set_value({});
+    return future;
+  }
+
+  WritePendingWrites();
+  compaction_stop_ = false;
+  compaction_thread_ = std::thread(&DefaultCacheImpl::CompactionLoop, this,
+                                   bytes_per_second, std::move(promise));
+  return future;
+}
+
+void DefaultCacheImpl::StopCompaction() {
+  {
+    std::lock_guard<MutexType> lock(cache_lock_);
+    compaction_stop_ = true;
+  }
+  compaction_cv_.notify_all();
+
+  if (compaction_thread_.joinable()) {
+    compaction_thread_.join();
+  }
+}
+
+void DefaultCacheImpl::CompactionLoop(
+    uint64_t bytes_per_second,
+    std::promise<DefaultCache::CompactionStatistics> promise) {
+  const auto start = std::chrono::steady_clock::now();
+  DefaultCache::CompactionStatistics statistics;
+
+  {
+    ReadLock lock(cache_lock_);
+    if (mutable_cache_) {
+      statistics.size_before = mutable_cache_->Size();
+    }
+  }
+
+  // Leveldb compactions are thread-safe, so the slices are compacted without
+  // the lock. The methods that destroy the mutable cache stop the compaction
+  // first and hold the compaction lock, so it is not restarted meanwhile.
+  std::string cursor;
+  auto has_more = true;
+  while (has_more) {
+    const auto slice_start = std::chrono::steady_clock::now();
+    DiskCache* mutable_cache = nullptr;
+    {
+      ReadLock lock(cache_lock_);
+      if (compaction_stop_ || !mutable_cache_) {
+        break;
+      }
+      mutable_cache = mutable_cache_.get();
+    }
+
+    uint64_t slice_size = 0u;
+    has_more = mutable_cache->CompactSlice(
+        cursor, DiskCache::kCompactionSliceSize, slice_size);
+
+    if (slice_size > 0u) {
+      ++statistics.compacted_ranges;
+      statistics.compacted_bytes += slice_size;
+    }
+
+    const auto delay =
+        DiskCache::GetCompactionDelay(slice_size, bytes_per_second) -
+        (std::chrono::steady_clock::now() - slice_start);
+    std::unique_lock<MutexType> lock(cache_lock_);
+    if (compaction_cv_.wait_for(lock, delay,
+                                [this] { return compaction_stop_; })) {
+      break;
+    }
+  }
+
+  {
+    ReadLock lock(cache_lock_);
+    if (mutable_cache_) {
+      statistics.size_after = mutable_cache_->Size();
+    }
+  }
+
+  if (statistics.size_before > statistics.size_after) {
+    statistics.reclaimed_bytes = statistics.size_before - statistics.size_after;
+  }
+  statistics.compaction_time =
+      std::chrono::milliseconds(GetElapsedTime(start));
+
+  OLP_SDK_LOG_INFO_F(kLogTag,
+                     "ScheduleCompaction: ranges=%" PRIu64
+                     ", compacted=%" PRIu64 ", reclaimed=%" PRIu64
+                     ", time=%" PRId64 " ms",
+                     statistics.compacted_ranges, statistics.compacted_bytes,
+                     statistics.reclaimed_bytes, GetElapsedTime(start));
+  promise.set_value(statistics);
+}
+
 bool DefaultCacheImpl::Put(const std::string& key, const boost::any& value,
                            const Encoder& encoder, time_t expiry) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  CacheMetricsRecorder::ScopedTimer timer(metrics_, Operation::kPut);
+  auto lock = LockForWrite();
   if (!is_open_) {
     return false;
   }
 
   auto encoded_item = encoder();
-  if (memory_cache_) {
-    const auto size = encoded_item.size();
-    const bool result = memory_cache_->Put(
-        key, value, GetExpiryForMemoryCache(key, expiry), size);
-    if (!result && size > settings_.max_memory_cache_size && !mutable_cache_) {
-      OLP_SDK_LOG_INFO_F(kLogTag,
-                         "Failed to store value in memory cache %s, size %d",
-                         key.c_str(), static_cast<int>(size));
-    }
+  PutMemoryCache(key, value, expiry, encoded_item.size());
+
+  if (IsWriteBehindEnabled()) {
+    return EnqueueWrite(key, nullptr, std::move(encoded_item), expiry);
   }
 
   return PutMutableCache(key, encoded_item, expiry);
@@ -268,20 +575,16 @@ bool DefaultCacheImpl::Put(const std::string& key,
     return false;
   }
 
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  CacheMetricsRecorder::ScopedTimer timer(metrics_, Operation::kPut);
+  auto lock = LockForWrite();
   if (!is_open_) {
     return false;
   }
 
-  if (memory_cache_) {
-    const auto size = value->size();
-    const bool result = memory_cache_->Put(
-        key, value, GetExpiryForMemoryCache(key, expiry), size);
-    if (!result && size > settings_.max_memory_cache_size && !mutable_cache_) {
-      OLP_SDK_LOG_INFO_F(kLogTag,
-                         "Failed to store value in memory cache %s, size %d",
-                         key.c_str(), static_cast<int>(size));
-    }
+  PutMemoryCache(key, value, expiry, value->size());
+
+  if (IsWriteBehindEnabled()) {
+    return EnqueueWrite(key, value, std::string(), expiry);
   }
 
   leveldb::Slice slice(reinterpret_cast<const char*>(value->data()),
@@ -289,30 +592,226 @@ bool DefaultCacheImpl::Put(const std::string& key,
   return PutMutableCache(key, slice, expiry);
 }
 
+bool DefaultCacheImpl::PutBatch(const KeyValueCache::KeyValueListType& items,
+                                time_t expiry) {
+  const auto cost = CurrentRefetchCost();
+  std::vector<MutableCacheItem> batch_items;
+  batch_items.reserve(items.size());
+  for (const auto& item : items) {
+    const auto& value = item.second;
+    if (!value) {
+      return false;
+    }
+    batch_items.push_back(
+        {&item.first,
+         leveldb::Slice(reinterpret_cast<const char*>(value->data()),
+                        value->size()),
+         expiry, cost});
+  }
+
+  auto lock = LockForWrite();
+  if (!is_open_) {
+    return false;
+  }
+
+  for (const auto& item : items) {
+    PutMemoryCache(item.first, item.second, expiry, item.second->size());
+  }
+
+  if (IsWriteBehindEnabled()) {
+    bool result = true;
+    for (const auto& item : items) {
+      result = EnqueueWrite(item.first, item.second, std::string(), expiry) &&
+               result;
+    }
+    return result;
+  }
+
+  return PutMutableCache(batch_items);
+}
+
+bool DefaultCacheImpl::PutBatch(
+    const KeyValueCache::KeyEncodedValueListType& items, time_t expiry) {
+  auto lock = LockForWrite();
+  if (!is_open_) {
+    return false;
+  }
+
+  std::vector<std::string> encoded_items;
+  encoded_items.reserve(items.size());
+  for (const auto& item : items) {
+    encoded_items.push_back(item.second.encoder());
+    PutMemoryCache(item.first, item.second.value, expiry,
+                   encoded_items.back().size());
+  }
+
+  if (IsWriteBehindEnabled()) {
+    bool result = true;
+    for (size_t i = 0; i < items.size(); ++i) {
+      result = EnqueueWrite(items[i].first, nullptr,
+                            std::move(encoded_items[i]), expiry) &&
+               result;
+    }
+    return result;
+  }
+
+  const auto cost = CurrentRefetchCost();
+  std::vector<MutableCacheItem> batch_items;
+  batch_items.reserve(items.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    batch_items.push_back({&items[i].first, encoded_items[i], expiry, cost});
+  }
+
+  return PutMutableCache(batch_items);
+}
+
+void DefaultCacheImpl::PutMemoryCache(const std::string& key,
+                                      const boost::any& value, time_t expiry,
+                                      size_t size) {
+  if (!memory_cache_) {
+    return;
+  }
+
+  const bool result = memory_cache_->Put(
+      key, value, GetExpiryForMemoryCache(key, expiry), size);
+  if (result) {
+    metrics_.RecordWrite(Tier::kMemory, size);
+  } else if (size > settings_.max_memory_cache_size && !mutable_cache_) {
+    OLP_SDK_LOG_INFO_F(kLogTag,
+                       "Failed to store value in memory cache %s, size %d",
+                       key.c_str(), static_cast<int>(size));
+  }
+}
+
 boost::any DefaultCacheImpl::Get(const std::string& key,
                                  const Decoder& decoder) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
-  if (!is_open_) {
-    return boost::any();
+  CacheMetricsRecorder::ScopedTimer timer(metrics_, Operation::kGet);
+  if (IsMemoryCacheSharded()) {
+    auto value = GetFromMemoryCache(key);
+    if (!value.empty()) {
+      return value;
+    }
+  }
+
+  bool expired = false;
+  boost::any value;
+  {
+    ReadLock lock(cache_lock_);
+    if (!is_open_) {
+      return boost::any();
+    }
+
+    value = GetUnlocked(key, decoder, expired);
+  }
+
+  if (expired) {
+    PurgeExpiredKey(key);
+  }
+  MaybeApplyLruPromotions();
+  return value;
+}
+
+KeyValueCache::ValueTypePtr DefaultCacheImpl::Get(const std::string& key) {
+  CacheMetricsRecorder::ScopedTimer timer(metrics_, Operation::kGet);
+  if (IsMemoryCacheSharded()) {
+    auto value = GetFromMemoryCache(key);
+    if (!value.empty()) {
+      return boost::any_cast<KeyValueCache::ValueTypePtr>(value);
+    }
+  }
+
+  bool expired = false;
+  KeyValueCache::ValueTypePtr value;
+  {
+    ReadLock lock(cache_lock_);
+    if (!is_open_) {
+      return nullptr;
+    }
+
+    value = GetUnlocked(key, expired);
   }
 
+  if (expired) {
+    PurgeExpiredKey(key);
+  }
+  MaybeApplyLruPromotions();
+  return value;
+}
+
+std::vector<KeyValueCache::ValueTypePtr> DefaultCacheImpl::GetBatch(
+    const DefaultCache::KeyListType& keys) {
+  std::vector<KeyValueCache::ValueTypePtr> values(keys.size());
+  std::vector<bool> expired(keys.size(), false);
+  {
+    ReadLock lock(cache_lock_);
+    if (!is_open_) {
+      return values;
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+      bool key_expired = false;
+      values[i] = GetUnlocked(keys[i], key_expired);
+      expired[i] = key_expired;
+    }
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (expired[i]) {
+      PurgeExpiredKey(keys[i]);
+    }
+  }
+  MaybeApplyLruPromotions();
+  return values;
+}
+
+std::vector<boost::any> DefaultCacheImpl::GetBatch(
+    const DefaultCache::KeyListType& keys, const Decoder& decoder) {
+  std::vector<boost::any> values(keys.size());
+  std::vector<bool> expired(keys.size(), false);
+  {
+    ReadLock lock(cache_lock_);
+    if (!is_open_) {
+      return values;
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+      bool key_expired = false;
+      values[i] = GetUnlocked(keys[i], decoder, key_expired);
+      expired[i] = key_expired;
+    }
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (expired[i]) {
+      PurgeExpiredKey(keys[i]);
+    }
+  }
+  MaybeApplyLruPromotions();
+  return values;
+}
+
+boost::any DefaultCacheImpl::GetUnlocked(const std::string& key,
+                                         const Decoder& decoder,
+                                         bool& expired) {
   if (memory_cache_) {
     auto value = memory_cache_->Get(key);
     if (!value.empty()) {
+      RecordMemoryHit(value);
       PromoteKeyLru(key);
       return value;
     }
+    metrics_.RecordMiss(Tier::kMemory);
   }
 
-  auto disc_cache = GetFromDiscCache(key);
+  std::shared_ptr<std::string> value = nullptr;
+  time_t expiry = KeyValueCache::kDefaultExpiry;
 
-  if (disc_cache) {
-    auto decoded_item = decoder(disc_cache->first);
+  auto result = GetFromDiskCache(key, value, expiry, expired);
+  if (result && value) {
+    auto decoded_item = decoder(*value);
     if (memory_cache_) {
-      auto expiry = disc_cache->second;
       memory_cache_->Put(key, decoded_item,
-                         GetExpiryForMemoryCache(key, expiry),
-                         disc_cache->first.size());
+                         GetExpiryForMemoryCache(key, expiry), value->size());
     }
     return decoded_item;
   }
@@ -320,24 +819,22 @@ boost::any DefaultCacheImpl::Get(const std::string& key,
   return boost::any();
 }
 
-KeyValueCache::ValueTypePtr DefaultCacheImpl::Get(const std::string& key) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
-  if (!is_open_) {
-    return nullptr;
-  }
-
+KeyValueCache::ValueTypePtr DefaultCacheImpl::GetUnlocked(
+    const std::string& key, bool& expired) {
   if (memory_cache_) {
     auto value = memory_cache_->Get(key);
     if (!value.empty()) {
+      RecordMemoryHit(value);
       PromoteKeyLru(key);
       return boost::any_cast<KeyValueCache::ValueTypePtr>(value);
     }
+    metrics_.RecordMiss(Tier::kMemory);
   }
 
   KeyValueCache::ValueTypePtr value = nullptr;
   time_t expiry = KeyValueCache::kDefaultExpiry;
 
-  auto result = GetFromDiskCache(key, value, expiry);
+  auto result = GetFromDiskCache(key, value, expiry, expired);
   if (result && value) {
     if (memory_cache_) {
       memory_cache_->Put(key, value, GetExpiryForMemoryCache(key, expiry),
@@ -349,8 +846,131 @@ KeyValueCache::ValueTypePtr DefaultCacheImpl::Get(const std::string& key) {
   return nullptr;
 }
 
+KeyValueCache::ValueView DefaultCacheImpl::GetView(const std::string& key) {
+  const bool memory_cache_sharded = IsMemoryCacheSharded();
+  if (memory_cache_sharded) {
+    auto value = GetFromMemoryCache(key);
+    auto* data = boost::any_cast<KeyValueCache::ValueTypePtr>(&value);
+    if (data && *data) {
+      return KeyValueCache::ValueView(*data);
+    }
+    metrics_.RecordMiss(Tier::kMemory);
+  }
+
+  bool expired = false;
+  KeyValueCache::ValueView view;
+  {
+    ReadLock lock(cache_lock_);
+    if (!is_open_) {
+      return {};
+    }
+
+    view = GetViewUnlocked(key, expired);
+  }
+
+  if (expired) {
+    PurgeExpiredKey(key);
+  }
+  MaybeApplyLruPromotions();
+  return view;
+}
+
+KeyValueCache::ValueView DefaultCacheImpl::GetViewUnlocked(
+    const std::string& key, bool& expired) {
+  if (memory_cache_ && !IsMemoryCacheSharded()) {
+    auto value = memory_cache_->Get(key);
+    auto* data = boost::any_cast<KeyValueCache::ValueTypePtr>(&value);
+    if (data && *data) {
+      metrics_.RecordHit(Tier::kMemory, (*data)->size());
+      PromoteKeyLru(key);
+      return KeyValueCache::ValueView(*data);
+    }
+    metrics_.RecordMiss(Tier::kMemory);
+  }
+
+  // Values of the memory-mapped protected cache are shared with the caller
+  // without a copy, unless they need to be decoded.
+  if (mapped_protected_cache_) {
+    auto view = mapped_protected_cache_->GetView(key);
+    if (view && !view.empty() &&
+        GetRemainingExpiryTime(key, *mapped_protected_cache_) > 0) {
+      auto decoded = std::make_shared<std::string>();
+      const auto result = codecs_.Decode(
+          reinterpret_cast<const char*>(view.data()), view.size(), *decoded);
+      if (result == CodecSelector::DecodeResult::kNotEncoded) {
+        metrics_.RecordHit(Tier::kProtected, view.size());
+        return view;
+      } else if (result == CodecSelector::DecodeResult::kDecoded) {
+        const auto* data =
+            reinterpret_cast<const unsigned char*>(decoded->data());
+        const auto size = decoded->size();
+        metrics_.RecordHit(Tier::kProtected, size);
+        return KeyValueCache::ValueView(std::move(decoded), data, size);
+      }
+    }
+  }
+
+  // The buffer leveldb reads the value into is shared with the caller. It is
+  // not added to the memory cache, as that would require a copy.
+  std::shared_ptr<std::string> value = nullptr;
+  time_t expiry = KeyValueCache::kDefaultExpiry;
+
+  auto result = GetFromDiskCache(key, value, expiry, expired);
+  if (result && value) {
+    const auto* data = reinterpret_cast<const unsigned char*>(value->data());
+    const auto size = value->size();
+    return KeyValueCache::ValueView(std::move(value), data, size);
+  }
+
+  return {};
+}
+
+std::unique_ptr<KeyValueCache::ValueWriter> DefaultCacheImpl::OpenWriter(
+    const std::string& key, time_t expiry) {
+  std::unique_ptr<LargeValueStore::Writer> writer;
+  {
+    ReadLock lock(cache_lock_);
+    if (!is_open_ || !mutable_cache_ || !mutable_cache_->HasLargeValues()) {
+      return nullptr;
+    }
+
+    writer = mutable_cache_->NewLargeValueWriter(key);
+  }
+
+  if (!writer) {
+    return nullptr;
+  }
+
+  return std::make_unique<LargeValueWriter>(*this, std::move(writer), key,
+                                            expiry);
+}
+
+bool DefaultCacheImpl::PutLargeValue(const std::string& key,
+                                     const std::string& reference,
+                                     time_t expiry) {
+  CacheMetricsRecorder::ScopedTimer timer(metrics_, Operation::kPut);
+  auto lock = LockForWrite();
+  if (!is_open_ || !mutable_cache_) {
+    // The temporary file is removed when the cache is opened again.
+    return false;
+  }
+
+  // The value is not kept in memory, so the older values are dropped.
+  if (memory_cache_) {
+    memory_cache_->Remove(key);
+  }
+  pending_writes_.erase(key);
+
+  if (!PutMutableCache(key, reference, expiry)) {
+    mutable_cache_->DiscardLargeValue(reference);
+    return false;
+  }
+
+  return true;
+}
+
 bool DefaultCacheImpl::Remove(const std::string& key) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  auto lock = LockForWrite();
 
   if (!is_open_) {
     return false;
@@ -370,6 +990,8 @@ bool DefaultCacheImpl::Remove(const std::string& key) {
     memory_cache_->Remove(key);
   }
 
+  pending_writes_.erase(key);
+
   RemoveKeyLru(key);
 
   if (mutable_cache_) {
@@ -383,7 +1005,7 @@ bool DefaultCacheImpl::Remove(const std::string& key) {
 }
 
 bool DefaultCacheImpl::RemoveKeysWithPrefix(const std::string& key) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  auto lock = LockForWrite();
 
   if (!is_open_) {
     return false;
@@ -397,6 +1019,15 @@ bool DefaultCacheImpl::RemoveKeysWithPrefix(const std::string& key) {
     memory_cache_->RemoveKeysWithPrefix(key, filter);
   }
 
+  for (auto it = pending_writes_.begin(); it != pending_writes_.end();) {
+    const auto& pending_key = it->first;
+    if (pending_key.compare(0, key.size(), key) == 0 && !filter(pending_key)) {
+      it = pending_writes_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
   // No need to check here for protected key as these are not added to LRU from
   // the start
   RemoveKeysWithPrefixLru(key);
@@ -412,16 +1043,49 @@ bool DefaultCacheImpl::RemoveKeysWithPrefix(const std::string& key) {
 }
 
 bool DefaultCacheImpl::Contains(const std::string& key) const {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  const bool memory_cache_sharded = IsMemoryCacheSharded();
+  if (memory_cache_sharded && is_open_ && memory_cache_->Contains(key)) {
+    return true;
+  }
+
+  ReadLock lock(cache_lock_);
   if (!is_open_) {
     return false;
   }
 
-  if (memory_cache_ && memory_cache_->Contains(key)) {
+  return ContainsUnlocked(key);
+}
+
+std::vector<bool> DefaultCacheImpl::ContainsBatch(
+    const DefaultCache::KeyListType& keys) const {
+  std::vector<bool> result(keys.size(), false);
+  const bool memory_cache_sharded = IsMemoryCacheSharded();
+
+  ReadLock lock(cache_lock_);
+  if (!is_open_) {
+    return result;
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    result[i] = (memory_cache_sharded && memory_cache_->Contains(keys[i])) ||
+                ContainsUnlocked(keys[i]);
+  }
+  return result;
+}
+
+bool DefaultCacheImpl::ContainsUnlocked(const std::string& key) const {
+  if (memory_cache_ && !IsMemoryCacheSharded() &&
+      memory_cache_->Contains(key)) {
     return true;
   }
 
-  // if lru exist check if key is there
+  const auto* pending_write = FindPendingWrite(key);
+  if (pending_write) {
+    return pending_write->expiry >
+           olp::cache::InMemoryCache::DefaultTimeProvider()();
+  }
+
+  // if lru exist check if key is there
   if (mutable_cache_lru_) {
     auto it = mutable_cache_lru_->FindNoPromote(key);
     if (it != mutable_cache_lru_->end()) {
@@ -444,6 +1108,15 @@ bool DefaultCacheImpl::Contains(const std::string& key) const {
     return (GetRemainingExpiryTime(key, *protected_cache_) > 0);
   }
 
+  if (mapped_protected_cache_ && mapped_protected_cache_->Contains(key)) {
+    return (GetRemainingExpiryTime(key, *mapped_protected_cache_) > 0);
+  }
+
+  auto shared_cache = shared_cache_ ? shared_cache_->Get() : nullptr;
+  if (shared_cache && shared_cache->Contains(key)) {
+    return (GetRemainingExpiryTime(key, *shared_cache) > 0);
+  }
+
   return false;
 }
 
@@ -463,6 +1136,7 @@ bool DefaultCacheImpl::AddKeyLru(std::string key, const leveldb::Slice& value) {
     auto iterator = mutable_cache_lru_->FindNoPromote(key);
     if (iterator != mutable_cache_lru_->end()) {
       props = iterator->value();
+      RemoveLruIndex(key, props);
     }
 
     if (expiration_key) {
@@ -472,10 +1146,11 @@ bool DefaultCacheImpl::AddKeyLru(std::string key, const leveldb::Slice& value) {
       std::string timestamp(value.data(), value.size());
       props.expiry = std::stol(timestamp.c_str());
     } else {
-      props.size = value.size();
+      props.size = mutable_cache_->GetValueSize(value);
     }
 
-    auto result = mutable_cache_lru_->InsertOrAssign(key, props);
+    AddLruIndex(key, props);
+    auto result = mutable_cache_lru_->InsertOrAssign(std::move(key), props);
     return result.second;
   }
   return false;
@@ -486,14 +1161,24 @@ void DefaultCacheImpl::InitializeLru() {
     return;
   }
   mutable_cache_data_size_ = 0;
+  ClearLruIndexes();
   if (mutable_cache_ && settings_.max_disk_storage != kMaxDiskSize &&
-      settings_.eviction_policy == EvictionPolicy::kLeastRecentlyUsed) {
+      settings_.eviction_policy != EvictionPolicy::kNone) {
     mutable_cache_lru_ =
         std::make_unique<DiskLruCache>(settings_.max_disk_storage);
     OLP_SDK_LOG_INFO_F(kLogTag, "Initializing mutable lru cache.");
   }
 
   const auto start = std::chrono::steady_clock::now();
+  if (LoadLruCheckpoint()) {
+    OLP_SDK_LOG_INFO_F(kLogTag,
+                       "Cache initialized from checkpoint, items=%zu, "
+                       "time=%" PRId64 " ms",
+                       mutable_cache_lru_ ? mutable_cache_lru_->Size() : 0u,
+                       GetElapsedTime(start));
+    return;
+  }
+
   auto count = 0u;
   auto it = mutable_cache_->NewIterator(leveldb::ReadOptions());
 
@@ -502,7 +1187,8 @@ void DefaultCacheImpl::InitializeLru() {
     const auto& value = it->value();
 
     // Here we count both expiry keys and regular keys
-    mutable_cache_data_size_ += key.size() + value.size();
+    mutable_cache_data_size_ +=
+        key.size() + mutable_cache_->GetValueSize(value);
     if (AddKeyLru(key, value)) {
       ++count;
     }
@@ -513,61 +1199,327 @@ void DefaultCacheImpl::InitializeLru() {
       count, GetElapsedTime(start));
 }
 
+void DefaultCacheImpl::StoreLruCheckpoint(leveldb::WriteBatch& batch) const {
+  // The entries are stored from the most to the least recently used.
+  std::string entries;
+  uint64_t count = 0u;
+  if (mutable_cache_lru_) {
+    for (const auto& entry : *mutable_cache_lru_) {
+      const auto& key = entry.key();
+      AppendCheckpointValue(entries, static_cast<uint32_t>(key.size()));
+      entries.append(key);
+      AppendCheckpointValue(entries,
+                            static_cast<uint64_t>(entry.value().size));
+      AppendCheckpointValue(entries,
+                            static_cast<int64_t>(entry.value().expiry));
+      AppendCheckpointValue(entries, entry.value().cost);
+      ++count;
+    }
+  }
+
+  std::string checkpoint;
+  checkpoint.reserve(kLruCheckpointHeaderSize + entries.size());
+  AppendCheckpointValue(checkpoint, kLruCheckpointVersion);
+  AppendCheckpointValue(checkpoint, mutable_cache_data_size_);
+  AppendCheckpointValue(checkpoint,
+                        static_cast<uint8_t>(mutable_cache_lru_ ? 1u : 0u));
+  AppendCheckpointValue(checkpoint, count);
+  checkpoint.append(entries);
+
+  batch.Put(kLruCheckpointKey, checkpoint);
+}
+
+bool DefaultCacheImpl::LoadLruCheckpoint() {
+  std::shared_ptr<std::string> checkpoint;
+  if (!mutable_cache_->Get(kLruCheckpointKey, checkpoint) || !checkpoint) {
+    return false;
+  }
+
+  // The checkpoint is only valid until the next write, so it is removed
+  // before any write happens and stored again on close. A cache that was not
+  // closed properly has no checkpoint and gets scanned.
+  uint64_t removed_size = 0u;
+  if (!mutable_cache_->Remove(kLruCheckpointKey, removed_size)) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Failed to remove the lru checkpoint");
+    return false;
+  }
+
+  const char* data = checkpoint->data();
+  const char* end = data + checkpoint->size();
+
+  uint32_t version = 0u;
+  uint64_t data_size = 0u;
+  uint8_t has_lru = 0u;
+  uint64_t count = 0u;
+  if (!ReadCheckpointValue(data, end, version) ||
+      version != kLruCheckpointVersion ||
+      !ReadCheckpointValue(data, end, data_size) ||
+      !ReadCheckpointValue(data, end, has_lru) ||
+      !ReadCheckpointValue(data, end, count)) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Invalid lru checkpoint header");
+    return false;
+  }
+
+  // The cache was used without LRU before, the order is unknown.
+  if (mutable_cache_lru_ && !has_lru) {
+    return false;
+  }
+
+  struct CheckpointEntry {
+    const char* key;
+    uint32_t key_size;
+    ValueProperties props;
+  };
+
+  std::vector<CheckpointEntry> entries;
+  if (mutable_cache_lru_) {
+    entries.reserve(static_cast<size_t>(
+        std::min<uint64_t>(count, (end - data) / kLruCheckpointEntrySize)));
+  }
+
+  for (uint64_t i = 0u; i < count; ++i) {
+    CheckpointEntry entry;
+    uint64_t size = 0u;
+    int64_t expiry = 0;
+    if (!ReadCheckpointValue(data, end, entry.key_size) ||
+        static_cast<size_t>(end - data) < entry.key_size) {
+      OLP_SDK_LOG_WARNING(kLogTag, "Truncated lru checkpoint");
+      return false;
+    }
+
+    entry.key = data;
+    data += entry.key_size;
+    if (!ReadCheckpointValue(data, end, size) ||
+        !ReadCheckpointValue(data, end, expiry) ||
+        !ReadCheckpointValue(data, end, entry.props.cost)) {
+      OLP_SDK_LOG_WARNING(kLogTag, "Truncated lru checkpoint");
+      return false;
+    }
+
+    entry.props.size = static_cast<size_t>(size);
+    entry.props.expiry = static_cast<time_t>(expiry);
+    if (mutable_cache_lru_) {
+      entries.push_back(entry);
+    }
+  }
+
+  // Insert from the least recently used, so the order is restored.
+  if (mutable_cache_lru_) {
+    mutable_cache_lru_->Reserve(entries.size());
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+      std::string key(it->key, it->key_size);
+      AddLruIndex(key, it->props);
+      mutable_cache_lru_->InsertOrAssign(std::move(key), it->props);
+    }
+  }
+
+  mutable_cache_data_size_ = data_size;
+  return true;
+}
+
 bool DefaultCacheImpl::RemoveKeyLru(const std::string& key) {
   if (mutable_cache_lru_) {
-    return mutable_cache_lru_->Erase(key);
+    auto it = mutable_cache_lru_->FindNoPromote(key);
+    if (it == mutable_cache_lru_->end()) {
+      return false;
+    }
+
+    RemoveLruIndex(key, it->value());
+    mutable_cache_lru_->Erase(it);
+    return true;
   }
   return false;
 }
 
-void DefaultCacheImpl::RemoveKeysWithPrefixLru(const std::string& key) {
-  if (!mutable_cache_lru_) {
-    return;
+void DefaultCacheImpl::AddLruIndex(const std::string& key,
+                                   const ValueProperties& props) {
+  if (IsExpiryValid(props.expiry)) {
+    expiry_index_.emplace(props.expiry, mutable_cache_lru_->ToCompactKey(key));
   }
 
-  for (auto it = mutable_cache_lru_->begin();
-       it != mutable_cache_lru_->end();) {
-    auto const& element_key = it.key();
-    if (element_key.size() >= key.size() &&
-        std::equal(key.begin(), key.end(), element_key.begin())) {
-      it = mutable_cache_lru_->Erase(it);
-      continue;
+  auto quota = FindPrefixQuota(key);
+  if (quota) {
+    quota->size += GetLruEntrySize(key, props.size, props.expiry);
+  }
+}
+
+void DefaultCacheImpl::RemoveLruIndex(const std::string& key,
+                                      const ValueProperties& props) {
+  if (IsExpiryValid(props.expiry)) {
+    expiry_index_.erase(
+        std::make_pair(props.expiry, mutable_cache_lru_->ToCompactKey(key)));
+  }
+
+  RemoveQuotaUsage(key, props);
+}
+
+void DefaultCacheImpl::ClearLruIndexes() {
+  expiry_index_.clear();
+  for (auto& quota : prefix_quotas_) {
+    quota.second.size = 0u;
+  }
+}
+
+DefaultCacheImpl::PrefixQuota* DefaultCacheImpl::FindPrefixQuota(
+    const std::string& key) {
+  PrefixQuota* result = nullptr;
+  size_t prefix_size = 0u;
+  for (auto& quota : prefix_quotas_) {
+    const auto& prefix = quota.first;
+    if ((!result || prefix.size() > prefix_size) &&
+        key.compare(0, prefix.size(), prefix) == 0) {
+      result = &quota.second;
+      prefix_size = prefix.size();
+    }
+  }
+  return result;
+}
+
+void DefaultCacheImpl::RemoveQuotaUsage(const std::string& key,
+                                        const ValueProperties& props) {
+  auto quota = FindPrefixQuota(key);
+  if (quota) {
+    quota->size -= std::min(quota->size,
+                            GetLruEntrySize(key, props.size, props.expiry));
+  }
+}
+
+std::vector<DefaultCacheImpl::PrefixQuota*> DefaultCacheImpl::GetOverQuotas() {
+  std::vector<PrefixQuota*> result;
+  for (auto& quota : prefix_quotas_) {
+    if (quota.second.size >=
+        settings_.eviction_high_watermark * quota.second.max_size) {
+      result.push_back(&quota.second);
     }
+  }
+  return result;
+}
 
-    ++it;
+void DefaultCacheImpl::RemoveKeysWithPrefixLru(const std::string& key) {
+  if (!mutable_cache_lru_) {
+    return;
   }
+
+  mutable_cache_lru_->ErasePrefix(
+      key, [&](const std::string& element_key, const ValueProperties& props) {
+        RemoveLruIndex(element_key, props);
+        return true;
+      });
 }
 
 bool DefaultCacheImpl::PromoteKeyLru(const std::string& key) {
   if (mutable_cache_lru_) {
-    auto it = mutable_cache_lru_->Find(key);
+    // The promotion is applied later, with the cache lock held exclusively.
+    lru_promotions_.Add(key);
+    auto it = mutable_cache_lru_->FindNoPromote(key);
     return it != mutable_cache_lru_->end() || protected_keys_.IsProtected(key);
   }
 
   return true;
 }
 
+void DefaultCacheImpl::ApplyLruPromotions() {
+  if (lru_promotions_.Size() == 0u) {
+    return;
+  }
+
+  auto keys = lru_promotions_.Drain();
+  if (!mutable_cache_lru_) {
+    return;
+  }
+
+  for (const auto& key : keys) {
+    mutable_cache_lru_->Find(key);
+  }
+}
+
+void DefaultCacheImpl::PromoteBufferedKeys() {
+  std::lock_guard<MutexType> lock(cache_lock_);
+  ApplyLruPromotions();
+}
+
+void DefaultCacheImpl::MaybeApplyLruPromotions() {
+  if (lru_promotions_.Size() < lru_promotions_.Capacity() / 2u) {
+    return;
+  }
+
+  // Only applied if no one else holds the cache lock, the next lookup retries.
+  std::unique_lock<MutexType> lock(cache_lock_, std::try_to_lock);
+  if (lock.owns_lock()) {
+    ApplyLruPromotions();
+  }
+}
+
+void DefaultCacheImpl::PurgeExpiredKey(const std::string& key) {
+  auto lock = LockForWrite();
+  if (!is_open_ || !mutable_cache_ || protected_keys_.IsProtected(key) ||
+      FindPendingWrite(key)) {
+    return;
+  }
+
+  // The key could be updated since it was found expired.
+  time_t expiry = KeyValueCache::kDefaultExpiry;
+  if (mutable_cache_lru_) {
+    auto it = mutable_cache_lru_->FindNoPromote(key);
+    if (it == mutable_cache_lru_->end()) {
+      return;
+    }
+    expiry = it->value().expiry;
+    if (IsExpiryValid(expiry)) {
+      expiry -= olp::cache::InMemoryCache::DefaultTimeProvider()();
+    }
+  } else {
+    expiry = GetRemainingExpiryTime(key, *mutable_cache_);
+  }
+
+  if (expiry > 0) {
+    return;
+  }
+
+  uint64_t removed_data_size = 0u;
+  PurgeDiskItem(key, *mutable_cache_, removed_data_size);
+  mutable_cache_data_size_ -= removed_data_size;
+  RemoveKeyLru(key);
+}
+
 uint64_t DefaultCacheImpl::MaybeEvictData() {
+  if (settings_.background_eviction) {
+    if (mutable_cache_ && mutable_cache_lru_ &&
+        (mutable_cache_data_size_ >=
+             settings_.eviction_high_watermark * settings_.max_disk_storage ||
+         !GetOverQuotas().empty())) {
+      eviction_requested_ = true;
+      eviction_cv_.notify_one();
+    }
+    return 0;
+  }
+
+  return EvictData();
+}
+
+uint64_t DefaultCacheImpl::EvictData() {
   if (!mutable_cache_ || !mutable_cache_lru_) {
     return 0;
   }
 
-  const auto max_size = kMaxDiskUsedThreshold * settings_.max_disk_storage;
-  if (mutable_cache_data_size_ < max_size) {
+  ApplyLruPromotions();
+
+  const auto over_quotas = GetOverQuotas();
+  const auto max_size =
+      settings_.eviction_high_watermark * settings_.max_disk_storage;
+  if (mutable_cache_data_size_ < max_size && over_quotas.empty()) {
     return 0;
   }
 
   const auto start = std::chrono::steady_clock::now();
-  int64_t left_to_evict =
-      mutable_cache_data_size_ -
-      std::llroundl(settings_.max_disk_storage * kMinDiskUsedThreshold);
   uint64_t evicted = 0u;
   auto count = 0u;
 
   const auto call_evict_method =
       [&](std::function<EvictionResult(DefaultCacheImpl*, leveldb::WriteBatch&,
                                        uint64_t)>
-              evict_method) {
+              evict_method,
+          int64_t& left_to_evict) {
         EvictionResult eviction_result;
         uint64_t current_eviction_target;
 
@@ -604,15 +1556,45 @@ uint64_t DefaultCacheImpl::MaybeEvictData() {
                  left_to_evict > 0);
       };
 
-  // Evict expired data first
-  call_evict_method(std::mem_fn(&DefaultCacheImpl::EvictExpiredDataPortion));
+  // Evict the quotas above the high watermark first, only their keys are
+  // evicted, so the other data stays resident.
+  for (auto quota : over_quotas) {
+    int64_t left_to_evict =
+        quota->size -
+        std::llroundl(quota->max_size * settings_.eviction_low_watermark);
+    if (left_to_evict > 0) {
+      auto cursor = mutable_cache_lru_->rbegin();
+      call_evict_method(
+          [quota, &cursor](DefaultCacheImpl* self, leveldb::WriteBatch& batch,
+                           uint64_t target_eviction_size) {
+            return self->EvictQuotaDataPortion(batch, *quota,
+                                               target_eviction_size, cursor);
+          },
+          left_to_evict);
+    }
+  }
+
+  // The keys of the quotas count towards the whole mutable cache size too.
+  if (mutable_cache_data_size_ - evicted >= max_size) {
+    int64_t left_to_evict =
+        mutable_cache_data_size_ - evicted -
+        std::llroundl(settings_.max_disk_storage *
+                      settings_.eviction_low_watermark);
 
-  // If after expired data eviction the desired size isn't reached yet, eviction
-  // of not expired data is required.
-  if (left_to_evict > 0) {
-    call_evict_method(std::mem_fn(&DefaultCacheImpl::EvictDataPortion));
+    // Evict expired data first
+    call_evict_method(
+        std::mem_fn(&DefaultCacheImpl::EvictExpiredDataPortion),
+        left_to_evict);
+
+    // If after expired data eviction the desired size isn't reached yet,
+    // eviction of not expired data is required.
+    if (left_to_evict > 0) {
+      call_evict_method(std::mem_fn(&DefaultCacheImpl::EvictDataPortion),
+                        left_to_evict);
+    }
   }
 
+  UpdateEvictionStatistics({count, evicted}, start);
   OLP_SDK_LOG_INFO_F(kLogTag,
                      "Evicted from mutable cache, items=%" PRId32
                      ", time=%" PRId64 "ms, size=%" PRIu64,
@@ -621,28 +1603,218 @@ uint64_t DefaultCacheImpl::MaybeEvictData() {
   return evicted;
 }
 
+DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictPortion(
+    uint64_t target_eviction_size, PrefixQuota* quota,
+    std::string* quota_cursor) {
+  ApplyLruPromotions();
+  auto batch = std::make_unique<leveldb::WriteBatch>();
+  auto cursor = mutable_cache_lru_->rbegin();
+  if (quota_cursor && !quota_cursor->empty()) {
+    auto it = mutable_cache_lru_->FindNoPromote(*quota_cursor);
+    if (it != mutable_cache_lru_->end()) {
+      cursor = it;
+    }
+  }
+
+  auto result =
+      quota ? EvictQuotaDataPortion(*batch, *quota, target_eviction_size,
+                                    cursor)
+            : EvictExpiredDataPortion(*batch, target_eviction_size);
+  if (quota && quota_cursor) {
+    *quota_cursor =
+        cursor != mutable_cache_lru_->rend() ? cursor->key() : std::string();
+  }
+  if (!quota && result.size < target_eviction_size) {
+    const auto lru_result =
+        EvictDataPortion(*batch, target_eviction_size - result.size);
+    result.count += lru_result.count;
+    result.size += lru_result.size;
+  }
+
+  if (result.count == 0u) {
+    return result;
+  }
+
+  const auto apply_result = mutable_cache_->ApplyBatch(std::move(batch));
+  if (!apply_result.IsSuccessful()) {
+    OLP_SDK_LOG_WARNING_F(
+        kLogTag,
+        "EvictPortion(): failed to apply batch, error_code=%d, "
+        "error_message=%s",
+        static_cast<int>(apply_result.GetError().GetErrorCode()),
+        apply_result.GetError().GetMessage().c_str());
+    return {0u, 0u};
+  }
+
+  mutable_cache_data_size_ -= result.size;
+  return result;
+}
+
+void DefaultCacheImpl::UpdateEvictionStatistics(
+    const EvictionResult& result,
+    std::chrono::steady_clock::time_point start) {
+  metrics_.RecordEvictions(Tier::kMutable, result.count);
+  eviction_statistics_.evicted_items += result.count;
+  eviction_statistics_.evicted_bytes += result.size;
+  eviction_statistics_.eviction_time += std::chrono::milliseconds(
+      GetElapsedTime(start));
+}
+
+DefaultCache::EvictionStatistics DefaultCacheImpl::GetEvictionStatistics()
+    const {
+  ReadLock lock(cache_lock_);
+  return eviction_statistics_;
+}
+
+CacheMetrics DefaultCacheImpl::GetMetrics() const {
+  return metrics_.GetMetrics();
+}
+
+void DefaultCacheImpl::ResetMetrics() { metrics_.Reset(); }
+
+void DefaultCacheImpl::RecordMemoryHit(const boost::any& value) {
+  const auto* data = boost::any_cast<KeyValueCache::ValueTypePtr>(&value);
+  metrics_.RecordHit(Tier::kMemory, data && *data ? (*data)->size() : 0u);
+}
+
+void DefaultCacheImpl::StartEviction() {
+  if (!settings_.background_eviction || eviction_thread_.joinable()) {
+    return;
+  }
+
+  eviction_stop_ = false;
+  eviction_requested_ = false;
+  eviction_thread_ = std::thread(&DefaultCacheImpl::EvictionLoop, this);
+}
+
+void DefaultCacheImpl::StopEviction() {
+  {
+    std::lock_guard<MutexType> lock(cache_lock_);
+    eviction_stop_ = true;
+  }
+  eviction_cv_.notify_all();
+
+  if (eviction_thread_.joinable()) {
+    eviction_thread_.join();
+  }
+}
+
+void DefaultCacheImpl::EvictionLoop() {
+  std::unique_lock<MutexType> lock(cache_lock_);
+  while (!eviction_stop_) {
+    if (!eviction_requested_) {
+      eviction_cv_.wait(lock);
+      continue;
+    }
+
+    eviction_requested_ = false;
+    const auto start = std::chrono::steady_clock::now();
+    EvictionResult evicted{0u, 0u};
+
+    // The quotas above the high watermark are evicted first, the quota
+    // entries are never removed, so the pointers stay valid.
+    auto over_quotas = GetOverQuotas();
+
+    // The LRU iterators are invalidated once the lock is released, so the
+    // quota eviction resumes at the first key the previous portion did not
+    // visit instead of scanning the LRU tail again.
+    std::map<const PrefixQuota*, std::string> quota_cursors;
+
+    // The cache lock is released between the portions, so that the puts and
+    // gets do not wait for the whole eviction. The mutable cache is not
+    // compacted explicitly, leveldb compacts the deleted data in background.
+    while (!eviction_stop_ && mutable_cache_ && mutable_cache_lru_) {
+      // The keys of an in-flight write are added to the LRU once written.
+      if (write_in_flight_) {
+        write_in_flight_cv_.wait(lock);
+        continue;
+      }
+
+      PrefixQuota* quota = nullptr;
+      int64_t left_to_evict = 0;
+      while (!over_quotas.empty()) {
+        quota = over_quotas.back();
+        left_to_evict = static_cast<int64_t>(quota->size) -
+                        std::llroundl(quota->max_size *
+                                      settings_.eviction_low_watermark);
+        if (left_to_evict > 0) {
+          break;
+        }
+        over_quotas.pop_back();
+        quota = nullptr;
+      }
+
+      if (!quota) {
+        const auto low_watermark = std::llroundl(
+            settings_.max_disk_storage * settings_.eviction_low_watermark);
+        left_to_evict =
+            static_cast<int64_t>(mutable_cache_data_size_) - low_watermark;
+        if (left_to_evict <= 0) {
+          break;
+        }
+      }
+
+      std::string* quota_cursor = quota ? &quota_cursors[quota] : nullptr;
+      const bool resumed = quota_cursor && !quota_cursor->empty();
+      const auto result =
+          EvictPortion(std::min<uint64_t>(left_to_evict, eviction_portion_),
+                       quota, quota_cursor);
+      if (result.size == 0u) {
+        if (quota) {
+          // The cursor key could be promoted meanwhile, which skips the keys
+          // left, so the tail is scanned once more before giving up.
+          if (!resumed) {
+            over_quotas.pop_back();
+          }
+          quota_cursor->clear();
+          continue;
+        }
+        break;
+      }
+
+      evicted.count += result.count;
+      evicted.size += result.size;
+
+      lock.unlock();
+      std::this_thread::yield();
+      lock.lock();
+    }
+
+    if (evicted.count > 0u) {
+      UpdateEvictionStatistics(evicted, start);
+      OLP_SDK_LOG_INFO_F(kLogTag,
+                         "Evicted from mutable cache in background, "
+                         "items=%" PRIu32 ", time=%" PRId64
+                         "ms, size=%" PRIu64,
+                         evicted.count, GetElapsedTime(start), evicted.size);
+    }
+  }
+}
+
 DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictExpiredDataPortion(
     leveldb::WriteBatch& batch, uint64_t target_eviction_size) {
   uint64_t evicted = 0u;
   auto count = 0u;
   const auto current_time = olp::cache::InMemoryCache::DefaultTimeProvider()();
 
-  // Protected elements are not stored in lru, so do not need to check
-  for (auto it = mutable_cache_lru_->begin();
-       it != mutable_cache_lru_->end() && evicted < target_eviction_size;) {
-    const auto& key = it->key();
-    const auto& properties = it->value();
-
-    const bool expired = (properties.expiry - current_time) <= 0;
-
-    if (!expired) {
-      ++it;
+  // The expiry index is ordered by the expiry time, so only expired elements
+  // are visited. Protected elements are not stored in lru, so do not need to
+  // check.
+  for (auto index_it = expiry_index_.begin();
+       index_it != expiry_index_.end() && index_it->first <= current_time &&
+       evicted < target_eviction_size;) {
+    const auto key = mutable_cache_lru_->ToKey(index_it->second);
+    auto it = mutable_cache_lru_->FindNoPromote(key);
+    if (it == mutable_cache_lru_->end() ||
+        it->value().expiry != index_it->first) {
+      // The element was changed or removed from lru without the index.
+      index_it = expiry_index_.erase(index_it);
       continue;
     }
 
     // Remove the key
     batch.Delete(key);
-    evicted += key.size() + properties.size;
+    evicted += key.size() + it->value().size;
 
     // Remove the key's expiry
     auto expiry_key = CreateExpiryKey(key);
@@ -655,7 +1827,9 @@ DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictExpiredDataPortion(
       memory_cache_->Remove(key);
     }
 
-    it = mutable_cache_lru_->Erase(it);
+    RemoveQuotaUsage(key, it->value());
+    mutable_cache_lru_->Erase(it);
+    index_it = expiry_index_.erase(index_it);
   }
 
   OLP_SDK_LOG_DEBUG_F(kLogTag,
@@ -665,13 +1839,60 @@ DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictExpiredDataPortion(
   return {count, evicted};
 }
 
+DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictQuotaDataPortion(
+    leveldb::WriteBatch& batch, PrefixQuota& quota,
+    uint64_t target_eviction_size, DiskLruCache::const_iterator& cursor) {
+  uint64_t evicted = 0u;
+  auto count = 0u;
+
+  // The keys of the other prefixes are skipped, so that only the over-quota
+  // keys are evicted, from the least recently used. The skipped keys are not
+  // visited again by the next portions.
+  while (cursor != mutable_cache_lru_->rend() &&
+         evicted < target_eviction_size) {
+    const auto victim = cursor--;
+    if (FindPrefixQuota(victim->key()) != &quota) {
+      continue;
+    }
+
+    const auto& key = victim->key();
+    const auto& properties = victim->value();
+
+    // Remove the key
+    evicted += key.size() + properties.size;
+    batch.Delete(key);
+
+    // Remove the key's expiry
+    if (IsExpiryValid(properties.expiry)) {
+      const auto expiry_key = CreateExpiryKey(key);
+      evicted += expiry_key.size() + kExpiryValueSize;
+      batch.Delete(expiry_key);
+    }
+
+    ++count;
+
+    if (memory_cache_) {
+      memory_cache_->Remove(key);
+    }
+
+    RemoveLruIndex(key, properties);
+    mutable_cache_lru_->Erase(key);
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag,
+                      "EvictQuotaDataPortion(): Evicted successfully, "
+                      "count=%u, evicted=%" PRIu64,
+                      count, evicted);
+  return {count, evicted};
+}
+
 DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictDataPortion(
     leveldb::WriteBatch& batch, uint64_t target_eviction_size) {
   uint64_t evicted = 0u;
   auto count = 0u;
 
   // Protected elements are not stored in lru, so do not need to check
-  for (auto it = mutable_cache_lru_->rbegin();
+  for (auto it = NextEvictionVictim();
        it != mutable_cache_lru_->rend() && evicted < target_eviction_size;) {
     const auto& key = it->key();
     const auto& properties = it->value();
@@ -693,8 +1914,9 @@ DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictDataPortion(
       memory_cache_->Remove(it->key());
     }
 
+    RemoveLruIndex(key, properties);
     mutable_cache_lru_->Erase(it);
-    it = mutable_cache_lru_->rbegin();
+    it = NextEvictionVictim();
   }
 
   OLP_SDK_LOG_DEBUG_F(
@@ -704,6 +1926,36 @@ DefaultCacheImpl::EvictionResult DefaultCacheImpl::EvictDataPortion(
   return {count, evicted};
 }
 
+DefaultCacheImpl::DiskLruCache::const_iterator
+DefaultCacheImpl::NextEvictionVictim() const {
+  auto victim = mutable_cache_lru_->rbegin();
+  if (settings_.eviction_policy != EvictionPolicy::kCostAware) {
+    return victim;
+  }
+
+  // GreedyDual-Size: the recency comes from the window, within it the value
+  // that is the cheapest to fetch again per stored byte goes first.
+  const auto cost_per_byte = [](const DiskLruCache::const_iterator& it) {
+    const auto cost = it->value().cost ? it->value().cost : kDefaultRefetchCost;
+    return static_cast<double>(cost) /
+           static_cast<double>(it->key().size() + it->value().size + 1u);
+  };
+
+  auto victim_cost = 0.0;
+  auto it = victim;
+  for (auto i = 0u; i < kCostAwareEvictionWindow &&
+                    it != mutable_cache_lru_->rend();
+       ++i, --it) {
+    const auto it_cost = cost_per_byte(it);
+    if (i == 0u || it_cost < victim_cost) {
+      victim = it;
+      victim_cost = it_cost;
+    }
+  }
+
+  return victim;
+}
+
 int64_t DefaultCacheImpl::MaybeUpdatedProtectedKeys(
     leveldb::WriteBatch& batch) {
   if (protected_keys_.IsDirty()) {
@@ -729,70 +1981,589 @@ int64_t DefaultCacheImpl::MaybeUpdatedProtectedKeys(
 bool DefaultCacheImpl::PutMutableCache(const std::string& key,
                                        const leveldb::Slice& value,
                                        time_t expiry) {
+  return PutMutableCache(std::vector<MutableCacheItem>{
+      {&key, value, expiry, CurrentRefetchCost()}});
+}
+
+bool DefaultCacheImpl::PutMutableCache(
+    const std::vector<MutableCacheItem>& items) {
   if (!mutable_cache_) {
     return true;
   }
 
-  // can't put new item if cache is full and eviction disabled
-  const auto item_size = value.size();
-  const auto expected_size = mutable_cache_data_size_ + item_size + key.size() +
-                             key.size() + kExpirySuffixLength +
-                             kExpiryValueSize;
-  if (!mutable_cache_lru_ && expected_size > settings_.max_disk_storage) {
+  MutableCacheWrite write;
+  if (!BuildMutableCacheWrite(items, write)) {
     return false;
   }
 
-  uint64_t added_data_size = 0u;
-  auto batch = std::make_unique<leveldb::WriteBatch>();
-  batch->Put(key, value);
-  added_data_size += key.size() + item_size;
+  auto removed_data_size = MaybeEvictData();
+  auto updated_data_size = MaybeUpdatedProtectedKeys(*write.batch);
 
-  if (IsExpiryValid(expiry)) {
-    expiry += olp::cache::InMemoryCache::DefaultTimeProvider()();
-    added_data_size += StoreExpiry(key, *batch, expiry);
-  }
-
-  auto removed_data_size = MaybeEvictData();
-  auto updated_data_size = MaybeUpdatedProtectedKeys(*batch);
-
-  auto result = mutable_cache_->ApplyBatch(std::move(batch));
+  auto result = mutable_cache_->ApplyBatch(std::move(write.batch));
   if (!result.IsSuccessful()) {
     return false;
   }
-  mutable_cache_data_size_ += added_data_size;
+  metrics_.RecordWrite(Tier::kMutable, write.added_values_size);
+  mutable_cache_data_size_ += write.added_data_size;
   mutable_cache_data_size_ -= removed_data_size;
   mutable_cache_data_size_ += updated_data_size;
 
-  // do not add protected keys to lru
-  if (mutable_cache_lru_ && !protected_keys_.IsProtected(key)) {
+  return AddMutableCacheWriteLru(write);
+}
+
+bool DefaultCacheImpl::BuildMutableCacheWrite(
+    const std::vector<MutableCacheItem>& input_items,
+    MutableCacheWrite& write) const {
+  // The encoded values replace the input values, sizes are calculated on the
+  // encoded values as they are the ones stored on the disk.
+  write.items = input_items;
+  if (codecs_.HasCodecs()) {
+    write.encoded_values.resize(write.items.size());
+    for (size_t i = 0; i < write.items.size(); ++i) {
+      auto& item = write.items[i];
+      // The references to the large values written in chunks are not
+      // encoded.
+      if (!mutable_cache_->IsLargeValue(item.value) &&
+          codecs_.Encode(*item.key, item.value.data(), item.value.size(),
+                         write.encoded_values[i])) {
+        item.value = write.encoded_values[i];
+      }
+    }
+  }
+  const auto& items = write.items;
+
+  // can't put new items if cache is full and eviction disabled
+  if (!mutable_cache_lru_) {
+    auto expected_size = mutable_cache_data_size_;
+    for (const auto& item : items) {
+      expected_size += mutable_cache_->GetValueSize(item.value) +
+                       item.key->size() + item.key->size() +
+                       kExpirySuffixLength + kExpiryValueSize;
+    }
+    if (expected_size > settings_.max_disk_storage) {
+      return false;
+    }
+  }
+
+  const auto time_now = olp::cache::InMemoryCache::DefaultTimeProvider()();
+  write.expiries.reserve(items.size());
+
+  if (!write.batch) {
+    write.batch = std::make_unique<leveldb::WriteBatch>();
+  }
+  auto& batch = *write.batch;
+  for (const auto& item : items) {
+    batch.Put(*item.key, item.value);
+    const auto value_size = mutable_cache_->GetValueSize(item.value);
+    write.added_data_size += item.key->size() + value_size;
+    write.added_values_size += value_size;
+
+    auto expiry = item.expiry;
+    if (IsExpiryValid(expiry)) {
+      expiry += time_now;
+      write.added_data_size += StoreExpiry(*item.key, batch, expiry);
+    }
+    write.expiries.push_back(expiry);
+  }
+
+  return true;
+}
+
+bool DefaultCacheImpl::AddMutableCacheWriteLru(
+    const MutableCacheWrite& write) {
+  if (!mutable_cache_lru_) {
+    return true;
+  }
+
+  const auto& items = write.items;
+  bool lru_result = true;
+  for (size_t i = 0; i < items.size(); ++i) {
+    // do not add protected keys to lru
+    const auto& key = *items[i].key;
+    if (protected_keys_.IsProtected(key)) {
+      continue;
+    }
+
+    auto existing = mutable_cache_lru_->FindNoPromote(key);
+    if (existing != mutable_cache_lru_->end()) {
+      RemoveLruIndex(key, existing->value());
+    }
+
     ValueProperties props;
-    props.size = item_size;
-    props.expiry = expiry;
+    props.size = mutable_cache_->GetValueSize(items[i].value);
+    props.expiry = write.expiries[i];
+    props.cost = items[i].cost;
+    AddLruIndex(key, props);
     const auto result = mutable_cache_lru_->InsertOrAssign(key, props);
     if (result.first == mutable_cache_lru_->end() && !result.second) {
       OLP_SDK_LOG_WARNING_F(
           kLogTag, "Failed to store value in mutable LRU cache, key %s",
           key.c_str());
+      lru_result = false;
+    }
+  }
+
+  return lru_result;
+}
+
+bool DefaultCacheImpl::Flush() {
+  auto lock = LockForWrite();
+  if (!is_open_) {
+    return false;
+  }
+
+  return WritePendingWrites();
+}
+
+bool DefaultCacheImpl::IsWriteBehindEnabled() const {
+  return settings_.write_behind_queue_size > 0u && mutable_cache_;
+}
+
+bool DefaultCacheImpl::EnqueueWrite(const std::string& key,
+                                    KeyValueCache::ValueTypePtr binary,
+                                    std::string encoded, time_t expiry) {
+  if (IsExpiryValid(expiry)) {
+    expiry += olp::cache::InMemoryCache::DefaultTimeProvider()();
+  }
+
+  if (pending_writes_.empty()) {
+    pending_writes_since_ = std::chrono::steady_clock::now();
+    write_behind_cv_.notify_one();
+  }
+
+  auto& pending_write = pending_writes_[key];
+  pending_write.binary = std::move(binary);
+  pending_write.encoded = std::move(encoded);
+  pending_write.expiry = expiry;
+  pending_write.cost = CurrentRefetchCost();
+
+  // The queue is bounded, once it is full the caller writes it.
+  if (pending_writes_.size() >= settings_.write_behind_queue_size) {
+    return WritePendingWrites();
+  }
+
+  return true;
+}
+
+bool DefaultCacheImpl::WritePendingWrites() {
+  if (pending_writes_.empty()) {
+    return true;
+  }
+
+  const auto items = ToMutableCacheItems(pending_writes_);
+  const bool result = PutMutableCache(items);
+  if (!result) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "Failed to write pending values to the mutable "
+                          "cache, count=%d",
+                          static_cast<int>(items.size()));
+  }
+
+  pending_writes_.clear();
+  return result;
+}
+
+std::vector<DefaultCacheImpl::MutableCacheItem>
+DefaultCacheImpl::ToMutableCacheItems(
+    const std::unordered_map<std::string, PendingWrite>& writes) const {
+  const auto time_now = olp::cache::InMemoryCache::DefaultTimeProvider()();
+  std::vector<MutableCacheItem> items;
+  items.reserve(writes.size());
+
+  for (const auto& pending : writes) {
+    const auto& pending_write = pending.second;
+    const auto& binary = pending_write.binary;
+    const auto value =
+        binary ? leveldb::Slice(reinterpret_cast<const char*>(binary->data()),
+                                binary->size())
+               : leveldb::Slice(pending_write.encoded);
+    const auto expiry = IsExpiryValid(pending_write.expiry)
+                            ? pending_write.expiry - time_now
+                            : pending_write.expiry;
+    items.push_back({&pending.first, value, expiry, pending_write.cost});
+  }
+
+  return items;
+}
+
+bool DefaultCacheImpl::WriteInFlight(std::unique_lock<MutexType>& lock) {
+  if (pending_writes_.empty() || !mutable_cache_) {
+    return WritePendingWrites();
+  }
+
+  // The nodes of the in-flight writes stay untouched until the write is
+  // done: the lookups only read them and every other operation waits.
+  in_flight_writes_.swap(pending_writes_);
+  write_in_flight_ = true;
+
+  const auto items = ToMutableCacheItems(in_flight_writes_);
+  MutableCacheWrite write;
+  write.batch = std::make_unique<leveldb::WriteBatch>();
+  const auto removed_data_size = MaybeEvictData();
+  const auto updated_data_size = MaybeUpdatedProtectedKeys(*write.batch);
+
+  lock.unlock();
+  const bool built = BuildMutableCacheWrite(items, write);
+  bool result = built;
+  if (built || updated_data_size != 0) {
+    result = mutable_cache_->ApplyBatch(std::move(write.batch))
+                 .IsSuccessful() &&
+             result;
+  }
+  lock.lock();
+
+  if (result) {
+    metrics_.RecordWrite(Tier::kMutable, write.added_values_size);
+    mutable_cache_data_size_ += write.added_data_size;
+    mutable_cache_data_size_ -= removed_data_size;
+    mutable_cache_data_size_ += updated_data_size;
+    result = AddMutableCacheWriteLru(write);
+  } else {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "Failed to write pending values to the mutable "
+                          "cache, count=%d",
+                          static_cast<int>(items.size()));
+  }
+
+  in_flight_writes_.clear();
+  write_in_flight_ = false;
+  write_in_flight_cv_.notify_all();
+  return result;
+}
+
+std::unique_lock<DefaultCacheImpl::MutexType> DefaultCacheImpl::LockForWrite() {
+  std::unique_lock<MutexType> lock(cache_lock_);
+  write_in_flight_cv_.wait(lock, [this] { return !write_in_flight_; });
+  return lock;
+}
+
+const DefaultCacheImpl::PendingWrite* DefaultCacheImpl::FindPendingWrite(
+    const std::string& key) const {
+  auto it = pending_writes_.find(key);
+  if (it != pending_writes_.end()) {
+    return &it->second;
+  }
+
+  it = in_flight_writes_.find(key);
+  return it != in_flight_writes_.end() ? &it->second : nullptr;
+}
+
+void DefaultCacheImpl::StartWriteBehind() {
+  if (settings_.write_behind_queue_size == 0u ||
+      write_behind_thread_.joinable()) {
+    return;
+  }
+
+  write_behind_stop_ = false;
+  write_behind_thread_ = std::thread(&DefaultCacheImpl::WriteBehindLoop, this);
+}
+
+void DefaultCacheImpl::StopWriteBehind() {
+  {
+    std::lock_guard<MutexType> lock(cache_lock_);
+    write_behind_stop_ = true;
+  }
+  write_behind_cv_.notify_all();
+
+  if (write_behind_thread_.joinable()) {
+    write_behind_thread_.join();
+  }
+}
+
+void DefaultCacheImpl::WriteBehindLoop() {
+  std::unique_lock<MutexType> lock(cache_lock_);
+  while (!write_behind_stop_) {
+    if (pending_writes_.empty()) {
+      write_behind_cv_.wait(lock);
+      continue;
+    }
+
+    const auto deadline =
+        pending_writes_since_ + settings_.write_behind_max_lag;
+    if (std::chrono::steady_clock::now() < deadline) {
+      write_behind_cv_.wait_until(lock, deadline);
+      continue;
+    }
+
+    WriteInFlight(lock);
+  }
+}
+
+std::future<uint64_t> DefaultCacheImpl::WarmUp(
+    const DefaultCache::KeyListType& prefixes, uint64_t byte_budget,
+    const Decoder& decoder) {
+  // Only one warm-up runs at a time.
+  StopWarmUp();
+
+  std::promise<uint64_t> promise;
+  auto future = promise.get_future();
+
+  std::lock_guard<MutexType> lock(cache_lock_);
+  if (!is_open_ || !memory_cache_ || prefixes.empty() || byte_budget == 0u ||
+      warm_up_thread_.joinable()) {
+    promise.set_value(0u);
+    return future;
+  }
+
+  warm_up_stop_ = false;
+  warm_up_thread_ = std::thread(&DefaultCacheImpl::WarmUpLoop, this, prefixes,
+                                byte_budget, decoder, std::move(promise));
+  return future;
+}
+
+void DefaultCacheImpl::StopWarmUp() {
+  {
+    std::lock_guard<MutexType> lock(cache_lock_);
+    warm_up_stop_ = true;
+  }
+
+  if (warm_up_thread_.joinable()) {
+    warm_up_thread_.join();
+  }
+}
+
+void DefaultCacheImpl::WarmUpLoop(DefaultCache::KeyListType prefixes,
+                                  uint64_t byte_budget, Decoder decoder,
+                                  std::promise<uint64_t> promise) {
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t loaded = 0u;
+
+  // The protected cache goes first, as its values hide the mutable ones.
+  const DefaultCache::CacheType types[] = {DefaultCache::CacheType::kProtected,
+                                           DefaultCache::CacheType::kMutable};
+  for (const auto& prefix : prefixes) {
+    for (const auto type : types) {
+      // The cache lock is released between the portions, so that the puts and
+      // gets do not wait for the whole warm-up.
+      auto cursor = prefix;
+      auto has_more = true;
+      while (has_more) {
+        std::lock_guard<MutexType> lock(cache_lock_);
+        if (warm_up_stop_ || !is_open_ || loaded >= byte_budget) {
+          break;
+        }
+
+        has_more = WarmUpPortion(type, prefix, decoder, byte_budget, cursor,
+                                 loaded);
+      }
+    }
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag,
+                     "WarmUp: loaded=%" PRIu64 ", time=%" PRId64 " ms", loaded,
+                     GetElapsedTime(start));
+  promise.set_value(loaded);
+}
+
+bool DefaultCacheImpl::WarmUpPortion(DefaultCache::CacheType type,
+                                     const std::string& prefix,
+                                     const Decoder& decoder,
+                                     uint64_t byte_budget, std::string& cursor,
+                                     uint64_t& loaded) {
+  auto* disk_cache = type == DefaultCache::CacheType::kMutable
+                         ? mutable_cache_.get()
+                         : protected_cache_.get();
+  if (!disk_cache) {
+    return false;
+  }
+
+  // The warm-up reads every value once, no need to keep them in the leveldb
+  // memory cache.
+  leveldb::ReadOptions options;
+  options.fill_cache = false;
+  auto it = disk_cache->NewIterator(options);
+  if (!it) {
+    return false;
+  }
+
+  const leveldb::Slice prefix_slice(prefix);
+  it->Seek(cursor);
+  for (auto count = 0u; it->Valid() && count < kWarmUpPortion;
+       it->Next(), ++count) {
+    if (!it->key().starts_with(prefix_slice)) {
+      return false;
+    }
+
+    auto key = it->key().ToString();
+    // The next portion starts from the first key after this one.
+    cursor = key + '\0';
+
+    if (IsInternalKey(key) || IsExpiryKey(key) ||
+        memory_cache_->Contains(key)) {
+      continue;
+    }
+
+    WarmUpKey(type, *disk_cache, key, it->value(), decoder, byte_budget,
+              loaded);
+    if (loaded >= byte_budget) {
       return false;
     }
   }
 
+  return it->Valid();
+}
+
+bool DefaultCacheImpl::WarmUpKey(DefaultCache::CacheType type,
+                                 DiskCache& disk_cache, const std::string& key,
+                                 const leveldb::Slice& data,
+                                 const Decoder& decoder, uint64_t byte_budget,
+                                 uint64_t& loaded) {
+  // The pending writes are newer than the disk cache.
+  if (data.empty() || FindPendingWrite(key)) {
+    return false;
+  }
+
+  // The expired keys are left to the eviction.
+  const auto expiry = GetRemainingExpiryTime(key, disk_cache);
+  if (expiry <= 0 && (type == DefaultCache::CacheType::kProtected ||
+                      !protected_keys_.IsProtected(key))) {
+    return false;
+  }
+
+  KeyValueCache::ValueTypePtr value =
+      std::make_shared<KeyValueCache::ValueType>(data.data(),
+                                                 data.data() + data.size());
+  if (!DecodeValue(value)) {
+    return false;
+  }
+
+  const auto size = value->size();
+  if (loaded + size > byte_budget) {
+    return false;
+  }
+
+  boost::any item = value;
+  if (decoder) {
+    item = decoder(std::string(value->begin(), value->end()));
+  }
+
+  if (!memory_cache_->Put(key, item, GetExpiryForMemoryCache(key, expiry),
+                          size)) {
+    return false;
+  }
+
+  metrics_.RecordWrite(Tier::kMemory, size);
+  loaded += size;
+  return true;
+}
+
+bool DefaultCacheImpl::ExportToProtectedCache(const std::string& path) {
+  auto lock = LockForWrite();
+  if (!is_open_ || !mutable_cache_) {
+    return false;
+  }
+
+  WritePendingWrites();
+
+  const auto start = std::chrono::steady_clock::now();
+  MappedCacheWriter writer(path);
+  if (!writer.Open()) {
+    return false;
+  }
+
+  // The iterator returns the keys sorted as the writer expects them.
+  auto count = 0u;
+  auto it = mutable_cache_->NewIterator(leveldb::ReadOptions());
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    auto key = it->key().ToString();
+    if (IsInternalKey(key)) {
+      continue;
+    }
+
+    // The large values are exported from their files.
+    auto value = it->value();
+    const auto large_value = mutable_cache_->GetLargeValue(value);
+    if (large_value) {
+      value = leveldb::Slice(reinterpret_cast<const char*>(large_value.data()),
+                             large_value.size());
+    }
+
+    if (!writer.Add(key, value.data(), value.size())) {
+      OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to export key %s", key.c_str());
+      return false;
+    }
+    ++count;
+  }
+
+  if (!writer.Finish()) {
+    return false;
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag,
+                     "Exported protected cache, items=%" PRIu32
+                     ", time=%" PRId64 " ms",
+                     count, GetElapsedTime(start));
+  return true;
+}
+
+bool DefaultCacheImpl::CreateProtectedCacheDelta(
+    const std::string& base_path, const std::string& target_path,
+    const std::string& delta_path) {
+  return MappedCacheDelta::Create(base_path, target_path, delta_path);
+}
+
+bool DefaultCacheImpl::ApplyProtectedCacheDelta(const std::string& delta_path) {
+  std::lock_guard<std::mutex> apply_delta_lock(apply_delta_lock_);
+  std::string path;
+  {
+    ReadLock lock(cache_lock_);
+    if (!is_open_ || !mapped_protected_cache_) {
+      return false;
+    }
+    path = settings_.disk_path_protected.get();
+  }
+
+  // The updated file is built without the lock, the reads are served from
+  // the current file meanwhile.
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::string> changed_keys;
+  if (!MappedCacheDelta::Apply(path, delta_path, changed_keys)) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to apply delta %s to %s",
+                        delta_path.c_str(), path.c_str());
+    return false;
+  }
+
+  auto mapped_cache = std::make_unique<MappedCache>();
+  if (!mapped_cache->Open(path)) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to map updated protected cache %s",
+                        path.c_str());
+    return false;
+  }
+
+  auto lock = LockForWrite();
+  if (!is_open_) {
+    return false;
+  }
+
+  mapped_protected_cache_ = std::move(mapped_cache);
+  if (memory_cache_) {
+    for (const auto& key : changed_keys) {
+      memory_cache_->Remove(key);
+    }
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag,
+                     "Updated protected cache, changes=%zu, time=%" PRId64
+                     " ms",
+                     changed_keys.size(), GetElapsedTime(start));
   return true;
 }
 
 DefaultCache::StorageOpenResult DefaultCacheImpl::SetupStorage() {
   auto result = DefaultCache::Success;
 
-  memory_cache_.reset();
+  if (memory_cache_) {
+    memory_cache_->Clear();
+  }
   mutable_cache_.reset();
   mutable_cache_lru_.reset();
+  ClearLruIndexes();
   protected_cache_.reset();
+  mapped_protected_cache_.reset();
+  shared_cache_.reset();
   protected_keys_ = ProtectedKeyList();
   mutable_cache_data_size_ = 0;
-
-  if (settings_.max_memory_cache_size > 0) {
-    memory_cache_.reset(new InMemoryCache(settings_.max_memory_cache_size));
-  }
+  pending_writes_.clear();
 
   if (settings_.disk_path_mutable) {
     result = SetupMutableCache();
@@ -802,10 +2573,59 @@ DefaultCache::StorageOpenResult DefaultCacheImpl::SetupStorage() {
     result = SetupProtectedCache();
   }
 
+  if (settings_.disk_path_shared) {
+    result = SetupSharedCache();
+  }
+
   return result;
 }
 
+DefaultCache::StorageOpenResult DefaultCacheImpl::SetupSharedCache() {
+  const auto& shared_path = settings_.disk_path_shared.get();
+  if (settings_.disk_path_mutable &&
+      settings_.disk_path_mutable.get() == shared_path) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "The shared cache %s is the mutable cache",
+                        shared_path.c_str());
+
+    settings_.disk_path_shared = boost::none;
+    return DefaultCache::OpenDiskPathFailure;
+  }
+
+  // The settings are the ones of the writing process, the size limit applies
+  // only to writing.
+  auto storage_settings = CreateStorageSettings(settings_);
+  storage_settings.max_disk_storage = DiskCache::kSizeMax;
+
+  shared_cache_ = std::make_unique<SharedCacheView>(
+      shared_path, storage_settings, settings_.shared_cache_refresh_interval);
+  if (!shared_cache_->Open()) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to open the shared cache %s",
+                        shared_path.c_str());
+
+    shared_cache_.reset();
+    settings_.disk_path_shared = boost::none;
+    return DefaultCache::OpenDiskPathFailure;
+  }
+
+  return DefaultCache::Success;
+}
+
 DefaultCache::StorageOpenResult DefaultCacheImpl::SetupProtectedCache() {
+  const auto& protected_path = settings_.disk_path_protected.get();
+  if (MappedCache::Exists(protected_path)) {
+    mapped_protected_cache_ = std::make_unique<MappedCache>();
+    if (!mapped_protected_cache_->Open(protected_path)) {
+      OLP_SDK_LOG_ERROR_F(kLogTag, "Failed to map protected cache %s",
+                          protected_path.c_str());
+
+      mapped_protected_cache_.reset();
+      settings_.disk_path_protected = boost::none;
+      return DefaultCache::OpenDiskPathFailure;
+    }
+
+    return DefaultCache::Success;
+  }
+
   protected_cache_ = std::make_unique<DiskCache>();
 
   // Storage settings for protected cache are different. We want to specify the
@@ -813,6 +2633,7 @@ DefaultCache::StorageOpenResult DefaultCacheImpl::SetupProtectedCache() {
   // to repair the cache.
   StorageSettings protected_storage_settings;
   protected_storage_settings.max_file_size = 32 * 1024 * 1024;
+  ApplyTuning(settings_.protected_cache_tuning, protected_storage_settings);
 
   auto status = protected_cache_->Open(
       settings_.disk_path_protected.get(), settings_.disk_path_protected.get(),
@@ -861,80 +2682,200 @@ DefaultCache::StorageOpenResult DefaultCacheImpl::SetupMutableCache() {
 
 void DefaultCacheImpl::DestroyCache(DefaultCache::CacheType type) {
   if (type == DefaultCache::CacheType::kMutable) {
-    if (mutable_cache_ && protected_keys_.IsDirty()) {
+    if (mutable_cache_) {
       auto batch = std::make_unique<leveldb::WriteBatch>();
-      MaybeUpdatedProtectedKeys(*batch);
+      mutable_cache_data_size_ += MaybeUpdatedProtectedKeys(*batch);
+      ApplyLruPromotions();
+      StoreLruCheckpoint(*batch);
       auto result = mutable_cache_->ApplyBatch(std::move(batch));
-      OLP_SDK_LOG_INFO_F(kLogTag,
-                         "Close(): store list of protected keys, result=%s",
-                         result.IsSuccessful() ? "true" : "false");
+      OLP_SDK_LOG_INFO_F(
+          kLogTag,
+          "Close(): store list of protected keys and lru checkpoint, result=%s",
+          result.IsSuccessful() ? "true" : "false");
     }
 
     mutable_cache_.reset();
     mutable_cache_lru_.reset();
+    ClearLruIndexes();
     protected_keys_ = ProtectedKeyList();
     mutable_cache_data_size_ = 0;
   } else {
     protected_cache_.reset();
+    mapped_protected_cache_.reset();
   }
 }
 
+template <typename ValuePtr>
 bool DefaultCacheImpl::GetFromDiskCache(const std::string& key,
-                                        KeyValueCache::ValueTypePtr& value,
-                                        time_t& expiry) {
+                                        ValuePtr& value, time_t& expiry,
+                                        bool& expired) {
   // Make sure we do not get a dirty entry
   value = nullptr;
   expiry = KeyValueCache::kDefaultExpiry;
+  expired = false;
 
-  if (protected_cache_) {
-    auto result = protected_cache_->Get(key, value);
-    if (result && value && !value->empty()) {
-      expiry = GetRemainingExpiryTime(key, *protected_cache_);
-      if (expiry > 0) {
-        return true;
+  if (GetFromProtectedCache(key, value, expiry)) {
+    return true;
+  }
+
+  // Pending writes are newer than the values in the mutable cache.
+  const auto* pending = FindPendingWrite(key);
+  if (pending) {
+    const auto& pending_write = *pending;
+    expiry = pending_write.expiry;
+    if (IsExpiryValid(expiry)) {
+      expiry -= olp::cache::InMemoryCache::DefaultTimeProvider()();
+      if (expiry <= 0) {
+        metrics_.RecordExpiration(Tier::kMutable);
+        metrics_.RecordMiss(Tier::kMutable);
+        return false;
       }
-      value = nullptr;
     }
+
+    AssignPendingValue(pending_write.binary, pending_write.encoded, value);
+    metrics_.RecordHit(Tier::kMutable, value->size());
+    return true;
   }
 
   if (mutable_cache_) {
-    expiry = GetRemainingExpiryTime(key, *mutable_cache_);
-
-    if (expiry > 0 || protected_keys_.IsProtected(key)) {
-      // Entry didn't expire yet, we can still use it
-      if (!PromoteKeyLru(key)) {
+    const bool is_protected = protected_keys_.IsProtected(key);
+    if (mutable_cache_lru_ && !is_protected) {
+      // The LRU holds the expiry of all the keys that are not protected, so
+      // there is no need to read the expiry from the disk.
+      auto it = mutable_cache_lru_->FindNoPromote(key);
+      if (it == mutable_cache_lru_->end()) {
         // If not found in LRU or not protected no need to look in disk cache
         // either.
         OLP_SDK_LOG_DEBUG_F(kLogTag,
                             "Key not found in LRU, and not protected, key='%s'",
                             key.c_str());
-        return false;
+        metrics_.RecordMiss(Tier::kMutable);
+        return GetFromSharedCache(key, value, expiry);
+      }
+
+      expiry = it->value().expiry;
+      lru_promotions_.Add(key);
+
+      if (IsExpiryValid(expiry)) {
+        expiry -= olp::cache::InMemoryCache::DefaultTimeProvider()();
       }
+    } else {
+      expiry = GetRemainingExpiryTime(key, *mutable_cache_);
+    }
 
+    if (expiry > 0 || is_protected) {
+      // Entry didn't expire yet, we can still use it
       auto result = mutable_cache_->Get(key, value);
-      return result && value;
+      if (result && value && DecodeValue(value)) {
+        metrics_.RecordHit(Tier::kMutable, value->size());
+        return true;
+      }
+
+      metrics_.RecordMiss(Tier::kMutable);
+      return GetFromSharedCache(key, value, expiry);
     }
 
-    // Data expired in cache -> remove, but not protected keys
-    uint64_t removed_data_size = 0u;
-    PurgeDiskItem(key, *mutable_cache_, removed_data_size);
-    mutable_cache_data_size_ -= removed_data_size;
-    RemoveKeyLru(key);
+    // Data expired in cache, the caller removes it with the exclusive lock.
+    expired = true;
+    metrics_.RecordExpiration(Tier::kMutable);
+    metrics_.RecordMiss(Tier::kMutable);
+  }
+
+  return GetFromSharedCache(key, value, expiry);
+}
+
+template <typename ValuePtr>
+bool DefaultCacheImpl::GetFromSharedCache(const std::string& key,
+                                          ValuePtr& value, time_t& expiry) {
+  value = nullptr;
+  expiry = KeyValueCache::kDefaultExpiry;
+
+  auto shared_cache = shared_cache_ ? shared_cache_->Get() : nullptr;
+  if (!shared_cache) {
+    return false;
+  }
+
+  // The writing process removes the expired values itself.
+  expiry = GetRemainingExpiryTime(key, *shared_cache);
+  if (expiry > 0 && shared_cache->Get(key, value) && value &&
+      DecodeValue(value)) {
+    metrics_.RecordHit(Tier::kShared, value->size());
+    return true;
   }
 
+  metrics_.RecordMiss(Tier::kShared);
+  value = nullptr;
+  expiry = KeyValueCache::kDefaultExpiry;
   return false;
 }
 
-boost::optional<std::pair<std::string, time_t>>
-DefaultCacheImpl::GetFromDiscCache(const std::string& key) {
-  KeyValueCache::ValueTypePtr value = nullptr;
-  time_t expiry = KeyValueCache::kDefaultExpiry;
-  auto result = GetFromDiskCache(key, value, expiry);
-  if (result && value) {
-    return std::make_pair(std::string(value->begin(), value->end()), expiry);
+template <typename ValuePtr>
+bool DefaultCacheImpl::GetFromProtectedCache(const std::string& key,
+                                             ValuePtr& value, time_t& expiry) {
+  bool result = false;
+  if (protected_cache_) {
+    result = protected_cache_->Get(key, value);
+  } else if (mapped_protected_cache_) {
+    result = mapped_protected_cache_->Get(key, value);
+  }
+
+  if (result && value && !value->empty() && DecodeValue(value)) {
+    expiry = protected_cache_
+                 ? GetRemainingExpiryTime(key, *protected_cache_)
+                 : GetRemainingExpiryTime(key, *mapped_protected_cache_);
+    if (expiry > 0) {
+      metrics_.RecordHit(Tier::kProtected, value->size());
+      return true;
+    }
+    metrics_.RecordExpiration(Tier::kProtected);
+  }
+
+  if (protected_cache_ || mapped_protected_cache_) {
+    metrics_.RecordMiss(Tier::kProtected);
   }
 
-  return boost::none;
+  value = nullptr;
+  expiry = KeyValueCache::kDefaultExpiry;
+  return false;
+}
+
+template <typename ValuePtr>
+bool DefaultCacheImpl::DecodeValue(ValuePtr& value) const {
+  std::string decoded;
+  const auto result =
+      codecs_.Decode(reinterpret_cast<const char*>(value->data()),
+                     value->size(), decoded);
+  if (result == CodecSelector::DecodeResult::kDecoded) {
+    AssignDecodedValue(std::move(decoded), value);
+  } else if (result == CodecSelector::DecodeResult::kFailed) {
+    value = nullptr;
+    return false;
+  }
+
+  return true;
+}
+
+boost::any DefaultCacheImpl::GetFromMemoryCache(const std::string& key) {
+  if (!is_open_) {
+    return boost::any();
+  }
+
+  auto value = memory_cache_->Get(key);
+  if (!value.empty()) {
+    RecordMemoryHit(value);
+    // The LRU promotion is best effort here: a hit must not wait for the cache
+    // lock, the key is promoted again by one of the next uncontended hits.
+    ReadLock lock(cache_lock_, std::try_to_lock);
+    if (lock.owns_lock()) {
+      PromoteKeyLru(key);
+    }
+  }
+
+  return value;
+}
+
+bool DefaultCacheImpl::IsMemoryCacheSharded() const {
+  return memory_cache_ && memory_cache_->ShardCount() > 1u;
 }
 
 std::string DefaultCacheImpl::GetExpiryKey(const std::string& key) const {
@@ -942,7 +2883,7 @@ std::string DefaultCacheImpl::GetExpiryKey(const std::string& key) const {
 }
 
 bool DefaultCacheImpl::Protect(const DefaultCache::KeyListType& keys) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  auto lock = LockForWrite();
   if (!mutable_cache_) {
     return false;
   }
@@ -966,7 +2907,7 @@ bool DefaultCacheImpl::Protect(const DefaultCache::KeyListType& keys) {
 }
 
 bool DefaultCacheImpl::Release(const DefaultCache::KeyListType& keys) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  auto lock = LockForWrite();
   if (!mutable_cache_) {
     return false;
   }
@@ -1009,7 +2950,7 @@ bool DefaultCacheImpl::Release(const DefaultCache::KeyListType& keys) {
 }
 
 bool DefaultCacheImpl::IsProtected(const std::string& key) const {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  ReadLock lock(cache_lock_);
   return protected_keys_.IsProtected(key);
 }
 
@@ -1031,11 +2972,15 @@ uint64_t DefaultCacheImpl::Size(CacheType type) const {
     return mutable_cache_data_size_;
   }
 
+  if (mapped_protected_cache_) {
+    return mapped_protected_cache_->Size();
+  }
+
   return protected_cache_ ? protected_cache_->Size() : 0;
 }
 
 uint64_t DefaultCacheImpl::Size(uint64_t new_size) {
-  std::lock_guard<std::mutex> lock(cache_lock_);
+  auto lock = LockForWrite();
 
   if (!is_open_ || !mutable_cache_ || !mutable_cache_lru_) {
     return 0u;
@@ -1049,7 +2994,8 @@ uint64_t DefaultCacheImpl::Size(uint64_t new_size) {
 
   settings_.max_disk_storage = new_size;
 
-  const auto evicted = MaybeEvictData();
+  WritePendingWrites();
+  const auto evicted = EvictData();
 
   mutable_cache_data_size_ -= evicted;
   mutable_cache_->Compact();
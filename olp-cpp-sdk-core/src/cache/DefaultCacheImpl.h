@@ -20,14 +20,32 @@
 #pragma once
 
 #include "olp/core/cache/DefaultCache.h"
-
+#include "olp/core/client/MemoryBudget.h"
+#include "olp/core/porting/shared_mutex.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "CacheMetricsRecorder.h"
+#include "CodecSelector.h"
+#include "CompactKeyLruCache.h"
 #include "DiskCache.h"
 #include "InMemoryCache.h"
+#include "MappedCache.h"
+#include "PromotionBuffer.h"
 #include "ProtectedKeyList.h"
+#include "SharedCacheView.h"
 
 namespace olp {
 namespace cache {
@@ -48,6 +66,9 @@ class DefaultCacheImpl {
 
   void Compact();
 
+  std::future<DefaultCache::CompactionStatistics> ScheduleCompaction(
+      uint64_t bytes_per_second);
+
   bool Put(const std::string& key, const KeyValueCache::ValueTypePtr value,
            time_t expiry);
 
@@ -58,11 +79,52 @@ class DefaultCacheImpl {
 
   DefaultCache::ValueTypePtr Get(const std::string& key);
 
+  KeyValueCache::ValueView GetView(const std::string& key);
+
+  /// Returns null if the large values are not stored in separate files.
+  std::unique_ptr<KeyValueCache::ValueWriter> OpenWriter(
+      const std::string& key, time_t expiry);
+
+  /// Stores the reference to a large value written in chunks.
+  bool PutLargeValue(const std::string& key, const std::string& reference,
+                     time_t expiry);
+
+  bool PutBatch(const KeyValueCache::KeyValueListType& items, time_t expiry);
+
+  bool PutBatch(const KeyValueCache::KeyEncodedValueListType& items,
+                time_t expiry);
+
+  std::vector<KeyValueCache::ValueTypePtr> GetBatch(
+      const DefaultCache::KeyListType& keys);
+
+  std::vector<boost::any> GetBatch(const DefaultCache::KeyListType& keys,
+                                   const Decoder& decoder);
+
+  bool Flush();
+
+  DefaultCache::EvictionStatistics GetEvictionStatistics() const;
+
+  CacheMetrics GetMetrics() const;
+
+  void ResetMetrics();
+
+  bool ExportToProtectedCache(const std::string& path);
+
+  static bool CreateProtectedCacheDelta(const std::string& base_path,
+                                        const std::string& target_path,
+                                        const std::string& delta_path);
+
+  bool ApplyProtectedCacheDelta(const std::string& delta_path);
+
+  std::future<uint64_t> WarmUp(const DefaultCache::KeyListType& prefixes,
+                               uint64_t byte_budget, const Decoder& decoder);
+
   bool Remove(const std::string& key);
 
   bool RemoveKeysWithPrefix(const std::string& key);
 
   bool Contains(const std::string& key) const;
+  std::vector<bool> ContainsBatch(const DefaultCache::KeyListType& keys) const;
   bool Protect(const DefaultCache::KeyListType& keys);
   bool Release(const DefaultCache::KeyListType& keys);
   bool IsProtected(const std::string& key) const;
@@ -75,11 +137,13 @@ class DefaultCacheImpl {
   struct ValueProperties {
     size_t size{0ull};
     time_t expiry{KeyValueCache::kDefaultExpiry};
+    /// The re-fetch cost in milliseconds, 0 if unknown.
+    uint32_t cost{0u};
   };
 
   /// The LRU cache definition using the leveldb keys as key and the value size
   /// as value.
-  using DiskLruCache = utils::LruCache<std::string, ValueProperties>;
+  using DiskLruCache = CompactKeyLruCache<ValueProperties>;
 
   /// Returns LRU mutable cache, used for tests.
   const std::unique_ptr<DiskLruCache>& GetMutableCacheLru() const {
@@ -107,7 +171,58 @@ class DefaultCacheImpl {
   /// Sets eviction portion, used for tests.
   void SetEvictionPortion(uint64_t size);
 
+  /// Applies the buffered LRU promotions, used for tests.
+  void PromoteBufferedKeys();
+
  private:
+  using MutexType = std::shared_mutex;
+  using ReadLock = std::shared_lock<MutexType>;
+
+  /// A value to be stored in the mutable cache.
+  struct MutableCacheItem {
+    const std::string* key;
+    leveldb::Slice value;
+    time_t expiry;
+    /// The re-fetch cost in milliseconds, 0 if unknown.
+    uint32_t cost;
+  };
+
+  /// A value waiting to be written to the mutable cache in the write-behind
+  /// mode. Either the binary or the encoded value is set.
+  struct PendingWrite {
+    KeyValueCache::ValueTypePtr binary;
+    std::string encoded;
+    /// The absolute expiry time.
+    time_t expiry{KeyValueCache::kDefaultExpiry};
+    /// The re-fetch cost in milliseconds, 0 if unknown.
+    uint32_t cost{0u};
+  };
+
+  /// A mutable cache write batch with the sizes it adds once applied.
+  struct MutableCacheWrite {
+    std::vector<MutableCacheItem> items;
+    /// The encoded values the items refer to.
+    std::vector<std::string> encoded_values;
+    /// The absolute expiry times of the items.
+    std::vector<time_t> expiries;
+    std::unique_ptr<leveldb::WriteBatch> batch;
+    uint64_t added_data_size{0u};
+    uint64_t added_values_size{0u};
+  };
+
+  /// The keys of the LRU mutable cache that have an expiry, ordered by the
+  /// absolute expiry time.
+  using ExpiryIndex = std::set<std::pair<time_t, CompactKey>>;
+
+  /// The size limit of a key prefix and the size of its LRU keys.
+  struct PrefixQuota {
+    uint64_t max_size;
+    uint64_t size;
+  };
+
+  /// The prefix quotas by the key prefix, the entries are never removed.
+  using PrefixQuotas = std::map<std::string, PrefixQuota>;
+
   /// Represents intermediate eviction result.
   struct EvictionResult {
     /// Number of evicted elements.
@@ -122,19 +237,122 @@ class DefaultCacheImpl {
   /// Initializes LRU mutable cache if possible.
   void InitializeLru();
 
+  /// Adds the data size and the LRU order to the batch, so that the next
+  /// InitializeLru() call does not need to scan the whole mutable cache.
+  void StoreLruCheckpoint(leveldb::WriteBatch& batch) const;
+
+  /// Restores the data size and the LRU order from the checkpoint and removes
+  /// it. Returns false if there is no valid checkpoint.
+  bool LoadLruCheckpoint();
+
   /// Removes key from the mutable lru cache;
   bool RemoveKeyLru(const std::string& key);
 
+  /// Adds the LRU key to the expiry index if the expiry is valid and charges
+  /// it to its prefix quota.
+  void AddLruIndex(const std::string& key, const ValueProperties& props);
+
+  /// Removes the LRU key from the expiry index and its prefix quota.
+  void RemoveLruIndex(const std::string& key, const ValueProperties& props);
+
+  /// Clears the expiry index and the used size of the prefix quotas.
+  void ClearLruIndexes();
+
+  /// Returns the quota with the longest prefix of the key, or nullptr.
+  PrefixQuota* FindPrefixQuota(const std::string& key);
+
+  /// Removes the LRU key from its prefix quota.
+  void RemoveQuotaUsage(const std::string& key, const ValueProperties& props);
+
+  /// Returns the quotas that are above the high watermark.
+  std::vector<PrefixQuota*> GetOverQuotas();
+
   /// Removes all keys with specified prefix from LRU mutable cache.
   void RemoveKeysWithPrefixLru(const std::string& key);
 
   /// Returns true if key is found in the LRU or protected cache, false -
-  /// otherwise.
+  /// otherwise. The key is only added to the promotion buffer, so it can be
+  /// called with the cache lock held shared.
   bool PromoteKeyLru(const std::string& key);
 
-  /// Returns evicted data size.
+  /// Promotes the buffered keys in the LRU, expects the cache lock to be held
+  /// exclusively.
+  void ApplyLruPromotions();
+
+  /// Applies the buffered promotions if the buffer is half full and the cache
+  /// lock is free, must be called without the cache lock.
+  void MaybeApplyLruPromotions();
+
+  /// Returns evicted data size. Only wakes up the eviction thread and returns
+  /// 0 if the background eviction is enabled.
   uint64_t MaybeEvictData();
 
+  /// Evicts the data if the mutable cache is above the high watermark,
+  /// returns evicted data size.
+  uint64_t EvictData();
+
+  /// Evicts up to the target size, expired data first, with a single write
+  /// batch and updates the mutable cache data size. If the quota is given,
+  /// only the keys charged to it are evicted. The quota eviction resumes at
+  /// the `quota_cursor` key if it is still in the LRU, and stores there the
+  /// first key not visited, or an empty string once the LRU is visited.
+  EvictionResult EvictPortion(uint64_t target_eviction_size,
+                              PrefixQuota* quota = nullptr,
+                              std::string* quota_cursor = nullptr);
+
+  /// Adds the eviction result to the eviction statistics.
+  void UpdateEvictionStatistics(
+      const EvictionResult& result,
+      std::chrono::steady_clock::time_point start);
+
+  /// Records the memory cache hit, the size is known only for binary values.
+  void RecordMemoryHit(const boost::any& value);
+
+  /// Starts the eviction thread if the background eviction is enabled.
+  void StartEviction();
+
+  /// Stops the eviction thread, must be called without the cache lock.
+  void StopEviction();
+
+  /// The eviction thread loop, evicts the data portion by portion and
+  /// releases the cache lock between the portions.
+  void EvictionLoop();
+
+  /// Shrinks the memory cache under the memory pressure and restores it
+  /// afterwards.
+  void OnMemoryPressure(client::MemoryPressure pressure);
+
+  /// Stops the warm-up thread, must be called without the cache lock.
+  void StopWarmUp();
+
+  /// Stops the compaction thread, must be called with `compaction_lock_` held
+  /// and without the cache lock.
+  void StopCompaction();
+
+  /// The compaction thread loop, compacts the mutable cache slice by slice
+  /// and only holds the cache lock shared while a slice is compacted.
+  void CompactionLoop(uint64_t bytes_per_second,
+                      std::promise<DefaultCache::CompactionStatistics> promise);
+
+  /// The warm-up thread loop, loads the keys portion by portion and releases
+  /// the cache lock between the portions.
+  void WarmUpLoop(DefaultCache::KeyListType prefixes, uint64_t byte_budget,
+                  Decoder decoder, std::promise<uint64_t> promise);
+
+  /// Loads a portion of the keys with the prefix from the disk cache of the
+  /// given type into the memory cache, starting from `cursor`. Returns false
+  /// when there are no more keys to load.
+  bool WarmUpPortion(DefaultCache::CacheType type, const std::string& prefix,
+                     const Decoder& decoder, uint64_t byte_budget,
+                     std::string& cursor, uint64_t& loaded);
+
+  /// Loads one key read by the warm-up iterator into the memory cache. The
+  /// key is not promoted and the read is not recorded in the metrics.
+  bool WarmUpKey(DefaultCache::CacheType type, DiskCache& disk_cache,
+                 const std::string& key, const leveldb::Slice& data,
+                 const Decoder& decoder, uint64_t byte_budget,
+                 uint64_t& loaded);
+
   /// Returns number of evicted elements, evicted data size and a flag indicatin
   /// if eviction limit reached. If the flag is true, another
   /// EvictExpiredDataPortion call is needed to continue eviction.
@@ -148,6 +366,19 @@ class DefaultCacheImpl {
   EvictionResult EvictDataPortion(leveldb::WriteBatch& batch,
                                   uint64_t target_eviction_size);
 
+  /// Picks the next key to evict: the least recently used one, or with the
+  /// cost-aware policy the one with the lowest re-fetch cost per byte among
+  /// the least recently used ones.
+  DiskLruCache::const_iterator NextEvictionVictim() const;
+
+  /// Evicts the least recently used keys charged to the quota, expired or
+  /// not, up to the target size. The scan starts at `cursor` and leaves it
+  /// at the first key not visited, so the next portion continues from there.
+  EvictionResult EvictQuotaDataPortion(leveldb::WriteBatch& batch,
+                                       PrefixQuota& quota,
+                                       uint64_t target_eviction_size,
+                                       DiskLruCache::const_iterator& cursor);
+
   /// Returns changed data size.
   int64_t MaybeUpdatedProtectedKeys(leveldb::WriteBatch& batch);
 
@@ -155,32 +386,172 @@ class DefaultCacheImpl {
   bool PutMutableCache(const std::string& key, const leveldb::Slice& value,
                        time_t expiry);
 
+  /// Puts all items into the mutable cache with a single write batch.
+  bool PutMutableCache(const std::vector<MutableCacheItem>& items);
+
+  /// Encodes the items and adds them to the write batch. Returns false if
+  /// the items do not fit into the cache. Does not modify the cache state, so
+  /// the writer thread calls it without the cache lock.
+  bool BuildMutableCacheWrite(const std::vector<MutableCacheItem>& items,
+                              MutableCacheWrite& write) const;
+
+  /// Adds the keys of an applied write to the LRU.
+  bool AddMutableCacheWriteLru(const MutableCacheWrite& write);
+
+  /// Returns true if mutable cache writes are deferred to the writer thread.
+  bool IsWriteBehindEnabled() const;
+
+  /// Adds the value to the pending writes, writes them if the queue is full.
+  bool EnqueueWrite(const std::string& key, KeyValueCache::ValueTypePtr binary,
+                    std::string encoded, time_t expiry);
+
+  /// Writes all pending writes to the mutable cache with a single write batch.
+  bool WritePendingWrites();
+
+  /// Converts the pending writes to the mutable cache items referring to them.
+  std::vector<MutableCacheItem> ToMutableCacheItems(
+      const std::unordered_map<std::string, PendingWrite>& writes) const;
+
+  /// Starts the writer thread if the write-behind mode is enabled.
+  void StartWriteBehind();
+
+  /// Stops the writer thread, must be called without the cache lock.
+  void StopWriteBehind();
+
+  /// The writer thread loop, writes the pending writes once the oldest of them
+  /// is older than `CacheSettings::write_behind_max_lag`.
+  void WriteBehindLoop();
+
+  /// Moves the pending writes to the in-flight writes and applies them with
+  /// the lock released. The lookups still find the in-flight writes, the
+  /// other operations wait for them in `LockForWrite`.
+  bool WriteInFlight(std::unique_lock<MutexType>& lock);
+
+  /// Takes the cache lock exclusively once the writer thread has no write in
+  /// flight.
+  std::unique_lock<MutexType> LockForWrite();
+
+  /// Returns the pending or in-flight write of the key, if any. Expects the
+  /// cache lock to be held at least shared.
+  const PendingWrite* FindPendingWrite(const std::string& key) const;
+
+  /// Puts the value into the memory cache, if there is one.
+  void PutMemoryCache(const std::string& key, const boost::any& value,
+                      time_t expiry, size_t size);
+
+  /// Checks the caches except the sharded memory cache, expects the cache
+  /// lock to be held at least shared.
+  bool ContainsUnlocked(const std::string& key) const;
+
+  /// Looks up the memory and disk caches, expects the cache lock to be held
+  /// at least shared. Sets `expired` if the key expired in the mutable cache,
+  /// so that it can be purged with PurgeExpiredKey.
+  boost::any GetUnlocked(const std::string& key, const Decoder& decoder,
+                         bool& expired);
+
+  /// Looks up the memory and disk caches, expects the cache lock to be held
+  /// at least shared.
+  KeyValueCache::ValueTypePtr GetUnlocked(const std::string& key,
+                                          bool& expired);
+
+  /// Looks up the caches for a view, expects the cache lock to be held at
+  /// least shared.
+  KeyValueCache::ValueView GetViewUnlocked(const std::string& key,
+                                           bool& expired);
+
+  /// Removes the key from the mutable cache if it is still expired, takes the
+  /// cache lock exclusively.
+  void PurgeExpiredKey(const std::string& key);
+
   DefaultCache::StorageOpenResult SetupStorage();
 
   DefaultCache::StorageOpenResult SetupProtectedCache();
 
   DefaultCache::StorageOpenResult SetupMutableCache();
 
+  DefaultCache::StorageOpenResult SetupSharedCache();
+
   void DestroyCache(DefaultCache::CacheType type);
 
-  bool GetFromDiskCache(const std::string& key,
-                        KeyValueCache::ValueTypePtr& value, time_t& expiry);
+  /// Looks up the memory cache without taking the cache lock. Used only when
+  /// the memory cache is sharded.
+  boost::any GetFromMemoryCache(const std::string& key);
+
+  /// Reads the value from the protected cache of either format.
+  template <typename ValuePtr>
+  bool GetFromProtectedCache(const std::string& key, ValuePtr& value,
+                             time_t& expiry);
+
+  /// Reads the value from the mutable cache of another process.
+  template <typename ValuePtr>
+  bool GetFromSharedCache(const std::string& key, ValuePtr& value,
+                          time_t& expiry);
+
+  /// Returns true if memory cache lookups bypass the cache lock.
+  bool IsMemoryCacheSharded() const;
+
+  /// Reads the value from the protected or mutable disk cache. The value type
+  /// is either KeyValueCache::ValueTypePtr or std::shared_ptr<std::string>.
+  /// Doesn't modify the cache, sets `expired` if the key expired in the
+  /// mutable cache instead of removing it.
+  template <typename ValuePtr>
+  bool GetFromDiskCache(const std::string& key, ValuePtr& value,
+                        time_t& expiry, bool& expired);
 
-  boost::optional<std::pair<std::string, time_t>> GetFromDiscCache(
-      const std::string& key);
+  /// Decodes the value read from the disk cache if it is encoded. Returns
+  /// false if the value cannot be decoded.
+  template <typename ValuePtr>
+  bool DecodeValue(ValuePtr& value) const;
 
   time_t GetExpiryForMemoryCache(const std::string& key, const time_t& expiry) const;
 
   CacheSettings settings_;
-  bool is_open_;
-  std::unique_ptr<InMemoryCache> memory_cache_;
+  std::atomic<bool> is_open_;
+  /// Created once and only cleared afterwards, so that sharded lookups can
+  /// access it without the cache lock.
+  const std::unique_ptr<InMemoryCache> memory_cache_;
   std::unique_ptr<DiskCache> mutable_cache_;
   std::unique_ptr<DiskLruCache> mutable_cache_lru_;
+  ExpiryIndex expiry_index_;
+  PrefixQuotas prefix_quotas_;
   std::unique_ptr<DiskCache> protected_cache_;
+  std::unique_ptr<MappedCache> mapped_protected_cache_;
+  /// Serializes the delta applies, as they write the same temporary file.
+  std::mutex apply_delta_lock_;
+  std::unique_ptr<SharedCacheView> shared_cache_;
   uint64_t mutable_cache_data_size_;
   ProtectedKeyList protected_keys_;
-  mutable std::mutex cache_lock_;
+  /// Held shared by the lookups and exclusively by everything else.
+  mutable MutexType cache_lock_;
+  /// The LRU hits of the lookups, which do not modify the LRU themselves.
+  PromotionBuffer lru_promotions_;
   uint64_t eviction_portion_;
+  std::unordered_map<std::string, PendingWrite> pending_writes_;
+  std::chrono::steady_clock::time_point pending_writes_since_;
+  /// The pending writes the writer thread applies without the cache lock.
+  std::unordered_map<std::string, PendingWrite> in_flight_writes_;
+  bool write_in_flight_;
+  std::condition_variable_any write_in_flight_cv_;
+  std::condition_variable_any write_behind_cv_;
+  std::thread write_behind_thread_;
+  bool write_behind_stop_;
+  std::condition_variable_any eviction_cv_;
+  std::thread eviction_thread_;
+  bool eviction_requested_;
+  bool eviction_stop_;
+  DefaultCache::EvictionStatistics eviction_statistics_;
+  std::thread warm_up_thread_;
+  bool warm_up_stop_;
+  /// Serializes starting and stopping the compaction thread. Held by the
+  /// methods that destroy the mutable cache, so that no compaction starts
+  /// until they are done.
+  std::mutex compaction_lock_;
+  std::condition_variable_any compaction_cv_;
+  std::thread compaction_thread_;
+  bool compaction_stop_;
+  CodecSelector codecs_;
+  CacheMetricsRecorder metrics_;
+  client::MemoryBudget::ConsumerId memory_consumer_id_;
 };
 
 }  // namespace cache
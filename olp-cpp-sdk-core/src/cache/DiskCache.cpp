@@ -19,12 +19,16 @@
 
 #include "DiskCache.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <iterator>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <leveldb/cache.h>
 #include <leveldb/db.h>
 #include <leveldb/filter_policy.h>
 #include <leveldb/iterator.h>
@@ -47,6 +51,30 @@ leveldb::Slice ToLeveldbSlice(const std::string& slice) {
   return leveldb::Slice(slice);
 }
 
+std::string GetLargeValuesPath(const std::string& data_path) {
+  return data_path + "/" + LargeValueStore::kDirectoryName;
+}
+
+/// Collects the operations of a batch, the slices point into the batch.
+class BatchOperations : public leveldb::WriteBatch::Handler {
+ public:
+  struct Operation {
+    leveldb::Slice key;
+    leveldb::Slice value;
+    bool is_put;
+  };
+
+  void Put(const leveldb::Slice& key, const leveldb::Slice& value) override {
+    operations.push_back({key, value, true});
+  }
+
+  void Delete(const leveldb::Slice& key) override {
+    operations.push_back({key, leveldb::Slice(), false});
+  }
+
+  std::vector<Operation> operations;
+};
+
 static bool RepairCache(const std::string& data_path) {
   // first
   auto status = leveldb::RepairDB(data_path, leveldb::Options());
@@ -68,6 +96,9 @@ static bool RepairCache(const std::string& data_path) {
   }
   OLP_SDK_LOG_WARNING(
       kLogTag, "RepairCache: destroyed corrupted database - " << data_path);
+
+  // The references to the large values are destroyed with the database.
+  olp::utils::Dir::Remove(GetLargeValuesPath(data_path));
   return true;
 }
 
@@ -130,12 +161,19 @@ void DiskCache::LevelDBLogger::Logv(const char* format, va_list ap) {
 }
 
 void DiskCache::Close() {
+  {
+    std::lock_guard<std::mutex> lock(compaction_mutex_);
+    compaction_stop_ = true;
+  }
+  compaction_cv_.notify_all();
+
   if (compaction_thread_.joinable()) {
     compaction_thread_.join();
   }
 
   database_.reset();
   filter_policy_.reset();
+  block_cache_.reset();
 }
 
 bool DiskCache::Clear() {
@@ -159,6 +197,81 @@ void DiskCache::Compact() {
   }
 }
 
+bool DiskCache::CompactSlice(std::string& cursor, uint64_t slice_size,
+                             uint64_t& compacted_size) {
+  if (!database_) {
+    OLP_SDK_LOG_ERROR(kLogTag, "CompactSlice: Database is not initialized");
+    return false;
+  }
+
+  // The keys are only scanned to find the end of the range.
+  leveldb::ReadOptions options;
+  options.verify_checksums = check_crc_;
+  options.fill_cache = false;
+  std::unique_ptr<leveldb::Iterator> it(database_->NewIterator(options));
+  it->Seek(cursor);
+  if (!it->Valid()) {
+    return false;
+  }
+
+  uint64_t size = 0u;
+  std::string end;
+  for (; it->Valid() && size < slice_size; it->Next()) {
+    size += it->key().size() + it->value().size();
+    if (size >= slice_size) {
+      end = it->key().ToString();
+    }
+  }
+
+  // Release the iterator first, so that it does not keep the compacted files.
+  const auto has_more = it->Valid();
+  it.reset();
+
+  const leveldb::Slice begin_slice(cursor);
+  const leveldb::Slice end_slice(end);
+  database_->CompactRange(cursor.empty() ? nullptr : &begin_slice,
+                          has_more ? &end_slice : nullptr);
+
+  cursor = end + '\0';
+  compacted_size += size;
+  return has_more;
+}
+
+std::chrono::microseconds DiskCache::GetCompactionDelay(
+    uint64_t size, uint64_t bytes_per_second) {
+  if (bytes_per_second == 0u) {
+    return std::chrono::microseconds(0);
+  }
+
+  return std::chrono::microseconds(size * 1000000u / bytes_per_second);
+}
+
+void DiskCache::CompactThrottled() {
+  OLP_SDK_LOG_INFO(kLogTag, "Compacting database in slices started");
+
+  std::string cursor;
+  uint64_t compacted_size = 0u;
+  auto has_more = true;
+  while (has_more) {
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t slice_size = 0u;
+    has_more = CompactSlice(cursor, kCompactionSliceSize, slice_size);
+    compacted_size += slice_size;
+
+    const auto delay =
+        GetCompactionDelay(slice_size, compaction_rate_limit_) -
+        (std::chrono::steady_clock::now() - start);
+    std::unique_lock<std::mutex> lock(compaction_mutex_);
+    if (compaction_cv_.wait_for(lock, delay,
+                                [this] { return compaction_stop_; })) {
+      break;
+    }
+  }
+
+  OLP_SDK_LOG_INFO(kLogTag, "Compacting database in slices finished, size="
+                                << compacted_size);
+}
+
 OpenResult DiskCache::Open(const std::string& data_path,
                            const std::string& versioned_data_path,
                            StorageSettings settings, OpenOptions options) {
@@ -171,10 +284,30 @@ OpenResult DiskCache::Open(const std::string& data_path,
   }
 
   enforce_immediate_flush_ = settings.enforce_immediate_flush;
+  compaction_rate_limit_ = settings.compaction_rate_limit;
+  {
+    std::lock_guard<std::mutex> lock(compaction_mutex_);
+    compaction_stop_ = false;
+  }
 
   max_size_ = settings.max_disk_storage;
+  is_read_only_ = is_read_only;
+
+  // The references written with a threshold are resolved even if it is
+  // disabled now.
+  const auto large_values_path = GetLargeValuesPath(versioned_data_path);
+  large_value_threshold_ =
+      is_read_only ? 0u : settings.large_value_threshold;
+  large_values_enabled_ = large_value_threshold_ > 0u ||
+                          olp::utils::Dir::Exists(large_values_path);
+  large_values_.Open(large_values_path);
+  if (!is_read_only && large_values_enabled_) {
+    RemoveTemporaryLargeValues(large_values_path);
+  }
+
   auto open_options = CreateOpenOptions(settings, is_read_only);
   filter_policy_.reset(open_options.filter_policy);
+  block_cache_.reset(open_options.block_cache);
 
   if (!is_read_only) {
     // Remove other DBs only if provided the versioned path - do nothing
@@ -184,8 +317,7 @@ OpenResult DiskCache::Open(const std::string& data_path,
 
     if (max_size_ != kSizeMax) {
       environment_ = std::make_unique<DiskCacheSizeLimitEnv>(
-          DiskCacheEnv::Env(), versioned_data_path,
-          settings.enforce_immediate_flush);
+          DiskCacheEnv::Env(), settings.enforce_immediate_flush);
       open_options.env = environment_.get();
     } else {
       open_options.env = DiskCacheEnv::Env();
@@ -217,11 +349,12 @@ OpenResult DiskCache::Open(const std::string& data_path,
   }
 
   // If the database is r/w and corrupted, attempt to repair & reopen
-  if ((status.IsCorruption() || status.IsIOError()) &&
+  if ((status.IsCorruption() || status.IsIOError()) && !is_read_only &&
       RepairCache(versioned_data_path) == true) {
     status = leveldb::DB::Open(open_options, versioned_data_path, &db);
     if (status.ok()) {
       database_.reset(db);
+      ResetEnvironmentSize();
       return OpenResult::Repaired;
     }
   }
@@ -236,6 +369,7 @@ OpenResult DiskCache::Open(const std::string& data_path,
   }
 
   database_.reset(db);
+  ResetEnvironmentSize();
   return OpenResult::Success;
 }
 
@@ -245,6 +379,14 @@ bool DiskCache::Put(const std::string& key, leveldb::Slice slice) {
     return false;
   }
 
+  // The batch moves a large value to a separate file and removes the file of
+  // the replaced one.
+  if (large_values_enabled_) {
+    auto batch = std::make_unique<leveldb::WriteBatch>();
+    batch->Put(key, slice);
+    return ApplyBatch(std::move(batch)).IsSuccessful();
+  }
+
   leveldb::WriteOptions write_options;
   write_options.sync = enforce_immediate_flush_;
 
@@ -265,9 +407,19 @@ boost::optional<std::string> DiskCache::Get(const std::string& key) {
   std::string res;
   leveldb::ReadOptions options;
   options.verify_checksums = check_crc_;
-  return database_->Get(options, ToLeveldbSlice(key), &res).ok()
-             ? boost::optional<std::string>(std::move(res))
-             : boost::none;
+  if (!database_->Get(options, ToLeveldbSlice(key), &res).ok()) {
+    return boost::none;
+  }
+
+  if (IsLargeValue(res)) {
+    const auto view = large_values_.Map(res.data(), res.size());
+    if (!view) {
+      return boost::none;
+    }
+    res.assign(reinterpret_cast<const char*>(view.data()), view.size());
+  }
+
+  return res;
 }
 
 bool DiskCache::Get(const std::string& key,
@@ -285,7 +437,11 @@ bool DiskCache::Get(const std::string& key,
   iterator->Seek(key);
   if (iterator->Valid() && iterator->key() == key) {
     auto slice_value = iterator->value();
-    if (!slice_value.empty()) {
+    if (IsLargeValue(slice_value)) {
+      const auto view =
+          large_values_.Map(slice_value.data(), slice_value.size());
+      value = view.empty() ? nullptr : view.ToValue();
+    } else if (!slice_value.empty()) {
       value = std::make_shared<KeyValueCache::ValueType>(
           slice_value.data(), slice_value.data() + slice_value.size());
     }
@@ -294,6 +450,32 @@ bool DiskCache::Get(const std::string& key,
   return true;
 }
 
+bool DiskCache::Get(const std::string& key,
+                    std::shared_ptr<std::string>& value) {
+  if (!database_) {
+    OLP_SDK_LOG_ERROR(kLogTag, "Get: Database is not initialized");
+    return false;
+  }
+
+  value = nullptr;
+  leveldb::ReadOptions options;
+  options.verify_checksums = check_crc_;
+
+  auto buffer = std::make_shared<std::string>();
+  const auto status =
+      database_->Get(options, ToLeveldbSlice(key), buffer.get());
+  if (status.ok() && IsLargeValue(*buffer)) {
+    const auto view = large_values_.Map(buffer->data(), buffer->size());
+    buffer->assign(reinterpret_cast<const char*>(view.data()), view.size());
+  }
+
+  if (status.ok() && !buffer->empty()) {
+    value = std::move(buffer);
+  }
+
+  return status.ok() || status.IsNotFound();
+}
+
 bool DiskCache::Contains(const std::string& key) {
   if (!database_) {
     OLP_SDK_LOG_ERROR(kLogTag, "Get: Database is not initialized");
@@ -315,11 +497,16 @@ bool DiskCache::Remove(const std::string& key, uint64_t& removed_data_size) {
   }
 
   uint64_t data_size = 0u;
+  std::string reference;
   auto it = NewIterator({});
   it->Seek(key);
   if (it->Valid() && it->key() == key) {
-    data_size = key.size() + it->value().size();
+    data_size = key.size() + GetValueSize(it->value());
+    if (IsLargeValue(it->value())) {
+      reference = it->value().ToString();
+    }
   }
+  it.reset();
 
   leveldb::WriteOptions write_options;
   write_options.sync = enforce_immediate_flush_;
@@ -327,6 +514,9 @@ bool DiskCache::Remove(const std::string& key, uint64_t& removed_data_size) {
   auto result = database_->Delete(write_options, key).ok();
   if (result) {
     removed_data_size = data_size;
+    if (!reference.empty()) {
+      large_values_.Remove(reference.data(), reference.size());
+    }
   }
 
   return result;
@@ -363,6 +553,12 @@ DiskCache::OperationOutcome DiskCache::ApplyBatch(
       }
 
       compaction_thread_ = std::thread([this]() {
+        if (compaction_rate_limit_ != 0u) {
+          CompactThrottled();
+          compacting_ = false;
+          return;
+        }
+
         OLP_SDK_LOG_INFO(kLogTag, "Compacting database started");
         database_->CompactRange(nullptr, nullptr);
         compacting_ = false;
@@ -371,6 +567,16 @@ DiskCache::OperationOutcome DiskCache::ApplyBatch(
     }
   }
 
+  std::vector<std::string> published;
+  std::vector<std::string> replaced;
+  if (large_values_enabled_) {
+    batch = StoreLargeValues(*batch, published, replaced);
+    if (!batch) {
+      return client::ApiError(client::ErrorCode::InternalFailure,
+                              "Failed to store the large values");
+    }
+  }
+
   leveldb::WriteOptions write_options;
   write_options.sync = enforce_immediate_flush_;
 
@@ -378,8 +584,22 @@ DiskCache::OperationOutcome DiskCache::ApplyBatch(
   if (!status.ok()) {
     OLP_SDK_LOG_WARNING(kLogTag,
                         "ApplyBatch: failed, status=" << status.ToString());
+    for (const auto& reference : published) {
+      large_values_.Discard(reference);
+    }
     return GetApiError(status);
   }
+
+  for (const auto& reference : published) {
+    large_values_.Publish(reference);
+  }
+  // The unchanged values keep their files.
+  for (const auto& reference : replaced) {
+    if (std::find(published.begin(), published.end(), reference) ==
+        published.end()) {
+      large_values_.Remove(reference.data(), reference.size());
+    }
+  }
   return NoError{};
 }
 
@@ -423,7 +643,7 @@ bool DiskCache::RemoveKeysWithPrefix(const std::string& prefix,
     }
 
     batch->Delete(key);
-    data_size += iterator->value().size() + key.size();
+    data_size += GetValueSize(iterator->value()) + key.size();
   }
 
   auto result = ApplyBatch(std::move(batch));
@@ -437,13 +657,15 @@ bool DiskCache::RemoveKeysWithPrefix(const std::string& prefix,
 
 leveldb::Status DiskCache::InitializeDB(const StorageSettings& settings,
                                         const std::string& path) const {
-  // NOTE: FilterPolicy should be deleted after DB
+  // NOTE: FilterPolicy and block cache should be deleted after DB
   std::unique_ptr<const leveldb::FilterPolicy> filter_policy;
+  std::unique_ptr<leveldb::Cache> block_cache;
   std::unique_ptr<leveldb::DB> database;
   leveldb::DB* db = nullptr;
 
   auto open_options = CreateOpenOptions(settings, false);
   filter_policy.reset(open_options.filter_policy);
+  block_cache.reset(open_options.block_cache);
 
   auto status = leveldb::DB::Open(open_options, path, &db);
   database.reset(db);
@@ -457,7 +679,16 @@ leveldb::Options DiskCache::CreateOpenOptions(const StorageSettings& settings,
   options.compression = settings.compression;
   options.info_log = leveldb_logger_.get();
   options.write_buffer_size = settings.max_chunk_size;
-  options.filter_policy = leveldb::NewBloomFilterPolicy(10);
+  if (settings.bloom_filter_bits_per_key > 0u) {
+    options.filter_policy = leveldb::NewBloomFilterPolicy(
+        static_cast<int>(settings.bloom_filter_bits_per_key));
+  }
+  if (settings.block_cache_size > 0u) {
+    options.block_cache = leveldb::NewLRUCache(settings.block_cache_size);
+  }
+  if (settings.block_size > 0u) {
+    options.block_size = settings.block_size;
+  }
   options.create_if_missing = !is_read_only;
   options.reuse_logs = is_read_only;
 
@@ -469,11 +700,136 @@ leveldb::Options DiskCache::CreateOpenOptions(const StorageSettings& settings,
 }
 
 uint64_t DiskCache::Size() const {
+  // The read-only database does not change, so its size is taken once, when
+  // it is opened.
+  if (is_read_only_ && environment_) {
+    return environment_->Size();
+  }
+  return ApproximateSize();
+}
+
+uint64_t DiskCache::ApproximateSize() const {
   uint64_t result{0u};
   leveldb::Range range{"0", "z"};
   database_->GetApproximateSizes(&range, 1, &result);
   return result;
 }
 
+std::unique_ptr<LargeValueStore::Writer> DiskCache::NewLargeValueWriter(
+    const std::string& key) {
+  return HasLargeValues() ? large_values_.NewWriter(key) : nullptr;
+}
+
+void DiskCache::DiscardLargeValue(const std::string& reference) {
+  large_values_.Discard(reference);
+}
+
+uint64_t DiskCache::GetValueSize(const leveldb::Slice& value) const {
+  return IsLargeValue(value)
+             ? LargeValueStore::GetValueSize(value.data(), value.size())
+             : value.size();
+}
+
+KeyValueCache::ValueView DiskCache::GetLargeValue(
+    const leveldb::Slice& value) const {
+  return IsLargeValue(value) ? large_values_.Map(value.data(), value.size())
+                             : KeyValueCache::ValueView();
+}
+
+bool DiskCache::IsLargeValue(const leveldb::Slice& value) const {
+  return large_values_enabled_ &&
+         LargeValueStore::IsReference(value.data(), value.size());
+}
+
+std::unique_ptr<leveldb::WriteBatch> DiskCache::StoreLargeValues(
+    const leveldb::WriteBatch& batch, std::vector<std::string>& published,
+    std::vector<std::string>& replaced) {
+  BatchOperations operations;
+  batch.Iterate(&operations);
+
+  leveldb::ReadOptions options;
+  options.fill_cache = false;
+
+  // The keys written by this batch and their references, if any. The
+  // stored value is only replaced by the first operation on the key.
+  std::unordered_map<std::string, std::string> batch_references;
+
+  auto result = std::make_unique<leveldb::WriteBatch>();
+  for (const auto& operation : operations.operations) {
+    auto key = operation.key.ToString();
+    auto batch_it = batch_references.find(key);
+    if (batch_it != batch_references.end()) {
+      if (!batch_it->second.empty()) {
+        large_values_.Discard(batch_it->second);
+        published.erase(
+            std::find(published.begin(), published.end(), batch_it->second));
+      }
+    } else {
+      std::string stored;
+      if (database_->Get(options, operation.key, &stored).ok() &&
+          IsLargeValue(stored)) {
+        replaced.push_back(std::move(stored));
+      }
+    }
+
+    if (!operation.is_put) {
+      result->Delete(operation.key);
+      batch_references[key].clear();
+      continue;
+    }
+
+    // The references of the values written in chunks are stored as is.
+    std::string reference;
+    if (IsLargeValue(operation.value)) {
+      reference = operation.value.ToString();
+    } else if (HasLargeValues() &&
+               operation.value.size() >= large_value_threshold_ &&
+               !large_values_.Write(key, operation.value.data(),
+                                    operation.value.size(), reference)) {
+      OLP_SDK_LOG_ERROR(kLogTag, "ApplyBatch: failed to store large value");
+      for (const auto& discarded : published) {
+        large_values_.Discard(discarded);
+      }
+      published.clear();
+      replaced.clear();
+      return nullptr;
+    }
+
+    if (reference.empty()) {
+      result->Put(operation.key, operation.value);
+    } else {
+      result->Put(operation.key, reference);
+      published.push_back(reference);
+    }
+    batch_references[key] = std::move(reference);
+  }
+
+  return result;
+}
+
+void DiskCache::RemoveTemporaryLargeValues(const std::string& path) {
+  std::vector<std::string> files;
+  if (!DiskCacheEnv::Env()->GetChildren(path, &files).ok()) {
+    return;
+  }
+
+  const std::string suffix = LargeValueStore::kTemporarySuffix;
+  for (const auto& file : files) {
+    if (file.size() > suffix.size() &&
+        file.compare(file.size() - suffix.size(), suffix.size(), suffix) ==
+            0) {
+      std::remove((path + "/" + file).c_str());
+    }
+  }
+}
+
+void DiskCache::ResetEnvironmentSize() {
+  // The approximate size comes from the table metadata that the database
+  // keeps in memory, so the directory is not walked.
+  if (environment_) {
+    environment_->ResetSize(ApproximateSize());
+  }
+}
+
 }  // namespace cache
 }  // namespace olp
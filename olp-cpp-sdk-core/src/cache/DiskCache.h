@@ -21,6 +21,8 @@
 
 #include <time.h>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <limits>
 #include <map>
@@ -31,6 +33,7 @@
 #include <tuple>
 #include <vector>
 
+#include <leveldb/cache.h>
 #include <leveldb/env.h>
 #include <leveldb/iterator.h>
 #include <leveldb/options.h>
@@ -40,6 +43,7 @@
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/ApiResponse.h>
+#include "LargeValueStore.h"
 
 namespace leveldb {
 class DB;
@@ -82,6 +86,23 @@ struct StorageSettings {
   /// Compression type to be applied on the data before storing it.
   leveldb::CompressionType compression =
       leveldb::CompressionType::kSnappyCompression;
+
+  /// Bloom filter bits per key, no filter is used if set to 0.
+  size_t bloom_filter_bits_per_key = 10u;
+
+  /// Block cache capacity in bytes, leveldb default is used if set to 0.
+  size_t block_cache_size = 0u;
+
+  /// Approximate size of the uncompressed data per block in bytes.
+  size_t block_size = 4u * 1024u;
+
+  /// The maximum throughput of the automatic compaction in bytes per second,
+  /// the whole storage is compacted at once if set to 0.
+  uint64_t compaction_rate_limit = 0u;
+
+  /// The values of at least this size in bytes are stored in separate files
+  /// instead of the database, none are if set to 0.
+  uint64_t large_value_threshold = 0u;
 };
 
 /**
@@ -91,6 +112,10 @@ class DiskCache {
  public:
   static constexpr uint64_t kSizeMax = std::numeric_limits<uint64_t>::max();
 
+  /// The approximate size of the keys and values compacted at once by the
+  /// incremental compaction.
+  static constexpr uint64_t kCompactionSliceSize = 1024u * 1024u;
+
   /// No error type
   using NoError = client::ApiNoResult;
 
@@ -121,6 +146,19 @@ class DiskCache {
   /// take a very long time, so use with care.
   void Compact();
 
+  /// Compacts the key range that starts at `cursor` and holds about
+  /// `slice_size` bytes of keys and values, the empty cursor starts at the
+  /// first key. Sets the cursor to the start of the next range and adds the
+  /// size of the range to `compacted_size`. Returns false if there are no
+  /// more keys to compact.
+  bool CompactSlice(std::string& cursor, uint64_t slice_size,
+                    uint64_t& compacted_size);
+
+  /// Returns the time it takes to compact `size` bytes at the given rate, or
+  /// zero if the rate is not limited.
+  static std::chrono::microseconds GetCompactionDelay(
+      uint64_t size, uint64_t bytes_per_second);
+
   OperationOutcome OpenError() const { return error_; }
 
   bool Put(const std::string& key, leveldb::Slice slice);
@@ -131,6 +169,10 @@ class DiskCache {
 
   bool Get(const std::string& key, KeyValueCache::ValueTypePtr& value);
 
+  /// Reads the value into a new string buffer without any intermediate copy.
+  /// The buffer is null if the key is not found or the value is empty.
+  bool Get(const std::string& key, std::shared_ptr<std::string>& value);
+
   /// Remove single key/value from DB.
   bool Remove(const std::string& key, uint64_t& removed_data_size);
 
@@ -150,10 +192,33 @@ class DiskCache {
   /// Check if cache contains data with the key.
   bool Contains(const std::string& key);
 
-  /// Gets size of the database: approximate for read-write, more-or-less
-  /// precise for read-only
+  /// Gets size of the database: approximate for read-write, taken once on
+  /// open for read-only.
   uint64_t Size() const;
 
+  /// Returns true if the large values are stored in separate files.
+  bool HasLargeValues() const { return large_value_threshold_ > 0u; }
+
+  /// Creates a writer of a large value of the key, the reference it returns
+  /// is stored with `Put` or `ApplyBatch`. Returns null if the large values
+  /// are not stored in separate files.
+  std::unique_ptr<LargeValueStore::Writer> NewLargeValueWriter(
+      const std::string& key);
+
+  /// Removes the file of a reference that was not stored.
+  void DiscardLargeValue(const std::string& reference);
+
+  /// Returns true if the stored value is a reference to a large value.
+  bool IsLargeValue(const leveldb::Slice& value) const;
+
+  /// Gets the size of the stored value, which is the size of the referenced
+  /// value for a large value.
+  uint64_t GetValueSize(const leveldb::Slice& value) const;
+
+  /// Maps the value if the stored value is a reference, returns an empty
+  /// view otherwise.
+  KeyValueCache::ValueView GetLargeValue(const leveldb::Slice& value) const;
+
  private:
   /// Initialize empty db, so it can be used as protected cache.
   leveldb::Status InitializeDB(const StorageSettings& settings,
@@ -163,18 +228,52 @@ class DiskCache {
   leveldb::Options CreateOpenOptions(const StorageSettings& settings,
                                      bool is_read_only) const;
 
+  /// Compacts the whole storage slice by slice, waits between the slices to
+  /// stay below the compaction rate limit. Stops when the cache is closed.
+  void CompactThrottled();
+
+  /// Gets the approximate size of the database tables.
+  uint64_t ApproximateSize() const;
+
+  /// Sets the environment size to the size of the opened database.
+  void ResetEnvironmentSize();
+
+  /// Moves the large values of the batch to separate files. Returns the
+  /// batch to write, the references to publish once it is written, and the
+  /// references it replaces.
+  std::unique_ptr<leveldb::WriteBatch> StoreLargeValues(
+      const leveldb::WriteBatch& batch, std::vector<std::string>& published,
+      std::vector<std::string>& replaced);
+
+  /// Removes the temporary files of the values that were never stored.
+  void RemoveTemporaryLargeValues(const std::string& path);
+
   std::string disk_cache_path_;
   std::unique_ptr<leveldb::DB> database_;
   std::unique_ptr<const leveldb::FilterPolicy> filter_policy_;
+  std::unique_ptr<leveldb::Cache> block_cache_;
   std::unique_ptr<SizeCountingEnv> environment_;
   std::unique_ptr<LevelDBLogger> leveldb_logger_;
   uint64_t max_size_{kSizeMax};
   bool check_crc_{false};
+  bool is_read_only_{false};
   bool enforce_immediate_flush_{false};
   /// Used to sync database_->CompactRange() calls.
   std::atomic<bool> compacting_{false};
   /// Used to asynchronously call database_->CompactRange().
   std::thread compaction_thread_;
+  /// The automatic compaction rate limit in bytes per second.
+  uint64_t compaction_rate_limit_{0u};
+  /// Used to stop the throttled compaction when the cache is closed.
+  std::mutex compaction_mutex_;
+  std::condition_variable compaction_cv_;
+  bool compaction_stop_{false};
+  /// The values of at least this size are moved to separate files.
+  uint64_t large_value_threshold_{0u};
+  /// True if the references to the large values are resolved, also the ones
+  /// written before the threshold was disabled.
+  bool large_values_enabled_{false};
+  LargeValueStore large_values_;
   OperationOutcome error_;
 };
 
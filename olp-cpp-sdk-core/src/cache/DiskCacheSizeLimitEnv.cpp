@@ -32,32 +32,12 @@ bool IsLogFile(const std::string& name) {
                       log_suffix) == 0;
 }
 
-char PathSeparator() {
-#ifdef WIN32
-  return '\\';
-#else
-  return '/';
-#endif
-}
-
 }  // namespace
 
 DiskCacheSizeLimitEnv::DiskCacheSizeLimitEnv(leveldb::Env* env,
-                                             const std::string& base_path,
                                              bool enforce_strict_data_save)
     : SizeCountingEnv(env),
-      enforce_strict_data_save_(enforce_strict_data_save) {
-  std::vector<std::string> children;
-  if (target()->GetChildren(base_path, &children).ok()) {
-    for (const std::string& child : children) {
-      uint64_t size;
-      std::string full_path(base_path + PathSeparator() + child);
-      if (target()->GetFileSize(full_path, &size).ok()) {
-        total_size_ += size;
-      }
-    }
-  }
-}
+      enforce_strict_data_save_(enforce_strict_data_save) {}
 
 leveldb::Status DiskCacheSizeLimitEnv::NewWritableFile(
     const std::string& f, leveldb::WritableFile** r) {
@@ -78,14 +58,24 @@ leveldb::Status DiskCacheSizeLimitEnv::NewWritableFile(
 leveldb::Status DiskCacheSizeLimitEnv::DeleteFile(const std::string& f) {
   uint64_t size = 0;
   if (target()->GetFileSize(f, &size).ok()) {
-    total_size_ -= size;
+    SubtractSize(size);
   }
   return target()->DeleteFile(f);
 }
 
-void DiskCacheSizeLimitEnv::AddSize(size_t size) { total_size_ += size; }
+void DiskCacheSizeLimitEnv::AddSize(uint64_t size) {
+  size_.fetch_add(size, std::memory_order_relaxed);
+}
 
-uint64_t DiskCacheSizeLimitEnv::Size() const { return total_size_.load(); }
+void DiskCacheSizeLimitEnv::SubtractSize(uint64_t size) {
+  // The files created before the size was reset are not counted, so the size
+  // must not wrap around when they are deleted.
+  auto current = size_.load(std::memory_order_relaxed);
+  while (!size_.compare_exchange_weak(current,
+                                      current > size ? current - size : 0u,
+                                      std::memory_order_relaxed)) {
+  }
+}
 
 }  // namespace cache
 }  // namespace olp
@@ -19,20 +19,23 @@
 
 #pragma once
 
-#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <string>
 
 #include "SizeCountingEnv.h"
 
 namespace olp {
 namespace cache {
 
+/// Counts the size of the database files from the file events: the written
+/// bytes are added when a file is flushed, and the size of a deleted file is
+/// subtracted. The size of the existing files is set with `ResetSize` once
+/// the database is opened.
 class DiskCacheSizeLimitEnv : public SizeCountingEnv {
  public:
   // Initialize an EnvWrapper that delegates all calls to *t
-  DiskCacheSizeLimitEnv(leveldb::Env* env, const std::string& base_path,
-                        bool enforce_strict_data_save);
+  DiskCacheSizeLimitEnv(leveldb::Env* env, bool enforce_strict_data_save);
   ~DiskCacheSizeLimitEnv() override = default;
 
   leveldb::Status NewWritableFile(const std::string& f,
@@ -40,12 +43,11 @@ class DiskCacheSizeLimitEnv : public SizeCountingEnv {
 
   leveldb::Status DeleteFile(const std::string& f) override;
 
-  void AddSize(size_t size);
-
-  uint64_t Size() const override;
+  void AddSize(uint64_t size);
 
  private:
-  std::atomic<uint64_t> total_size_{0};
+  void SubtractSize(uint64_t size);
+
   bool enforce_strict_data_save_{false};
 };
 
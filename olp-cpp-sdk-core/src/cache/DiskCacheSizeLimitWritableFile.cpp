@@ -27,10 +27,14 @@ DiskCacheSizeLimitWritableFile::DiskCacheSizeLimitWritableFile(
     DiskCacheSizeLimitEnv* owner, leveldb::WritableFile* file)
     : owner_(owner), file_(file) {}
 
+DiskCacheSizeLimitWritableFile::~DiskCacheSizeLimitWritableFile() {
+  PublishSize();
+}
+
 leveldb::Status DiskCacheSizeLimitWritableFile::Append(
     const leveldb::Slice& data) {
   if (file_) {
-    owner_->AddSize(data.size());
+    pending_size_ += data.size();
     return file_->Append(data);
   }
   return leveldb::Status::OK();
@@ -38,6 +42,7 @@ leveldb::Status DiskCacheSizeLimitWritableFile::Append(
 
 leveldb::Status DiskCacheSizeLimitWritableFile::Close() {
   if (file_) {
+    PublishSize();
     return file_->Close();
   }
   return leveldb::Status::OK();
@@ -45,6 +50,7 @@ leveldb::Status DiskCacheSizeLimitWritableFile::Close() {
 
 leveldb::Status DiskCacheSizeLimitWritableFile::Flush() {
   if (file_) {
+    PublishSize();
     return file_->Flush();
   }
   return leveldb::Status::OK();
@@ -52,10 +58,18 @@ leveldb::Status DiskCacheSizeLimitWritableFile::Flush() {
 
 leveldb::Status DiskCacheSizeLimitWritableFile::Sync() {
   if (file_) {
+    PublishSize();
     return file_->Sync();
   }
   return leveldb::Status::OK();
 }
 
+void DiskCacheSizeLimitWritableFile::PublishSize() {
+  if (pending_size_ != 0u) {
+    owner_->AddSize(pending_size_);
+    pending_size_ = 0u;
+  }
+}
+
 }  // namespace cache
 }  // namespace olp
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include <leveldb/env.h>
@@ -31,7 +32,7 @@ class DiskCacheSizeLimitWritableFile : public leveldb::WritableFile {
  public:
   DiskCacheSizeLimitWritableFile(DiskCacheSizeLimitEnv* owner,
                                  leveldb::WritableFile* file);
-  ~DiskCacheSizeLimitWritableFile() override = default;
+  ~DiskCacheSizeLimitWritableFile() override;
 
   leveldb::Status Append(const leveldb::Slice& data) override;
 
@@ -42,8 +43,14 @@ class DiskCacheSizeLimitWritableFile : public leveldb::WritableFile {
   leveldb::Status Sync() override;
 
  private:
+  /// Adds the bytes appended since the last call to the owner size.
+  void PublishSize();
+
   DiskCacheSizeLimitEnv* owner_{nullptr};
   std::unique_ptr<leveldb::WritableFile> file_;
+  /// The bytes appended and not yet added to the owner, the file is written
+  /// by one thread, so the shared counter is updated once per flush only.
+  uint64_t pending_size_{0u};
 };
 
 }  // namespace cache
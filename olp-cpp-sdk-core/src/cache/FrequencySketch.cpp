@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "FrequencySketch.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace olp {
+namespace cache {
+namespace {
+constexpr size_t kMinWidth = 64u;
+constexpr size_t kMaxWidth = 1u << 24;
+
+size_t NextPowerOfTwo(size_t value) {
+  size_t result = kMinWidth;
+  while (result < value && result < kMaxWidth) {
+    result <<= 1;
+  }
+  return result;
+}
+
+// Derives an independent hash for every row from a single key hash.
+size_t Rehash(size_t hash, size_t row) {
+  uint64_t value =
+      static_cast<uint64_t>(hash) + 0x9e3779b97f4a7c15ull * (row + 1u);
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+  return static_cast<size_t>(value ^ (value >> 31));
+}
+}  // namespace
+
+constexpr size_t FrequencySketch::kDepth;
+constexpr uint8_t FrequencySketch::kMaxFrequency;
+
+FrequencySketch::FrequencySketch(size_t capacity)
+    : counters_(NextPowerOfTwo(capacity) * kDepth, 0u),
+      width_mask_(NextPowerOfTwo(capacity) - 1u),
+      sample_size_(10u * (width_mask_ + 1u)),
+      additions_(0u) {}
+
+void FrequencySketch::Increment(const std::string& key) {
+  const auto hash = std::hash<std::string>{}(key);
+  bool incremented = false;
+  for (size_t row = 0u; row < kDepth; ++row) {
+    auto& counter = counters_[Index(hash, row)];
+    if (counter < kMaxFrequency) {
+      ++counter;
+      incremented = true;
+    }
+  }
+
+  if (incremented && ++additions_ >= sample_size_) {
+    Age();
+  }
+}
+
+uint8_t FrequencySketch::Frequency(const std::string& key) const {
+  const auto hash = std::hash<std::string>{}(key);
+  uint8_t frequency = kMaxFrequency;
+  for (size_t row = 0u; row < kDepth; ++row) {
+    frequency = std::min(frequency, counters_[Index(hash, row)]);
+  }
+  return frequency;
+}
+
+void FrequencySketch::Clear() {
+  std::fill(counters_.begin(), counters_.end(), 0u);
+  additions_ = 0u;
+}
+
+size_t FrequencySketch::Index(size_t hash, size_t row) const {
+  return row * (width_mask_ + 1u) + (Rehash(hash, row) & width_mask_);
+}
+
+void FrequencySketch::Age() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  additions_ /= 2u;
+}
+
+}  // namespace cache
+}  // namespace olp
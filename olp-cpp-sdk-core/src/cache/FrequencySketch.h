@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace olp {
+namespace cache {
+
+/// Estimates the access frequency of keys with a count-min sketch of small
+/// saturating counters. Every `sample_size` recorded accesses all counters are
+/// halved, so the estimation follows the recent popularity of a key. The class
+/// is not thread safe.
+class FrequencySketch {
+ public:
+  /// Creates a sketch, which is sized for about `capacity` distinct keys.
+  explicit FrequencySketch(size_t capacity);
+
+  /// Records an access of the key.
+  void Increment(const std::string& key);
+
+  /// Returns the estimated number of recent accesses of the key.
+  uint8_t Frequency(const std::string& key) const;
+
+  /// Resets all counters.
+  void Clear();
+
+ private:
+  static constexpr size_t kDepth = 4u;
+  static constexpr uint8_t kMaxFrequency = 15u;
+
+  size_t Index(size_t hash, size_t row) const;
+  void Age();
+
+  std::vector<uint8_t> counters_;
+  size_t width_mask_;
+  size_t sample_size_;
+  size_t additions_;
+};
+
+}  // namespace cache
+}  // namespace olp
@@ -19,29 +19,71 @@
 
 #include "InMemoryCache.h"
 
+#include <algorithm>
+
 namespace olp {
 namespace cache {
 namespace {
 inline bool HasExpiry(time_t expiry_seconds) {
   return (expiry_seconds != InMemoryCache::kExpiryMax);
 }
+
+size_t GetShardMaxSize(size_t max_size, size_t shard_count, size_t index) {
+  if (max_size == InMemoryCache::kSizeMax) {
+    return max_size;
+  }
+
+  // Spread the remainder over the first shards so the sum of all shard
+  // budgets is exactly max_size.
+  return max_size / shard_count + (index < max_size % shard_count ? 1u : 0u);
+}
+
+// The admission filter has to track more keys than fit into the shard, an
+// average item is assumed to cost 1 KB.
+constexpr size_t kAverageItemCost = 1024u;
+
+std::unique_ptr<FrequencySketch> CreateFrequencySketch(size_t max_size,
+                                                       bool admission_filter) {
+  // Without an upper bound nothing is evicted, so everything is admitted.
+  if (!admission_filter || max_size == InMemoryCache::kSizeMax) {
+    return nullptr;
+  }
+  return std::unique_ptr<FrequencySketch>(
+      new FrequencySketch(max_size / kAverageItemCost));
+}
 }  // namespace
 
-InMemoryCache::InMemoryCache(size_t max_size, ModelCacheCostFunc cache_cost,
-                             TimeProvider time_provider)
-    : item_tuples_(max_size, std::move(cache_cost)),
-      time_provider_(std::move(time_provider)) {
-  item_tuples_.SetEvictionCallback(
+InMemoryCache::Shard::Shard(size_t max_size, ModelCacheCostFunc cache_cost,
+                            bool admission_filter)
+    : item_tuples(max_size, cache_cost),
+      cache_cost(cache_cost),
+      frequencies(CreateFrequencySketch(max_size, admission_filter)) {
+  item_tuples.SetEvictionCallback(
       [this](const std::string& key, ItemTuple&& value) {
         OnEviction(key, std::move(value));
       });
 }
 
+InMemoryCache::InMemoryCache(size_t max_size, ModelCacheCostFunc cache_cost,
+                             TimeProvider time_provider, size_t shard_count,
+                             bool admission_filter)
+    : time_provider_(std::move(time_provider)) {
+  shard_count = std::max<size_t>(shard_count, 1u);
+  shards_.reserve(shard_count);
+  for (size_t index = 0; index < shard_count; ++index) {
+    shards_.emplace_back(
+        new Shard(GetShardMaxSize(max_size, shard_count, index), cache_cost,
+                  admission_filter));
+  }
+}
+
 bool InMemoryCache::Put(const std::string& key, const boost::any& item,
                         time_t expire_seconds, size_t size) {
-  std::lock_guard<std::mutex> lock{mutex_};
+  auto& shard = GetShard(key);
+  std::lock_guard<std::mutex> lock{shard.mutex};
 
-  PurgeExpired();
+  const auto time_now = time_provider_();
+  shard.PurgeExpired(time_now);
 
   bool expires = HasExpiry(expire_seconds);
   if (expires) {
@@ -49,25 +91,34 @@ bool InMemoryCache::Put(const std::string& key, const boost::any& item,
     if (expire_seconds <= 0) {
       return false;
     }
-    expire_seconds += time_provider_();
+    expire_seconds += time_now;
   }
 
   auto item_tuple = std::make_tuple(key, expire_seconds, item, size);
-  auto ret = item_tuples_.InsertOrAssign(key, item_tuple);
+  if (!shard.Admit(key, item_tuple)) {
+    return false;
+  }
+
+  auto ret = shard.item_tuples.InsertOrAssign(key, item_tuple);
   if (ret.second && expires) {
-    item_expiries_[expire_seconds].push_back(item_tuple);
+    shard.item_expiries[expire_seconds].push_back(item_tuple);
   }
 
   return ret.second;
 }
 
 boost::any InMemoryCache::Get(const std::string& key) {
-  std::lock_guard<std::mutex> lock{mutex_};
-  auto it = item_tuples_.Find(key);
-  if (it != item_tuples_.end()) {
+  auto& shard = GetShard(key);
+  std::lock_guard<std::mutex> lock{shard.mutex};
+  if (shard.frequencies) {
+    shard.frequencies->Increment(key);
+  }
+
+  auto it = shard.item_tuples.Find(key);
+  if (it != shard.item_tuples.end()) {
     auto expiry_time = std::get<1>(it.value());
     if (expiry_time < time_provider_()) {
-      PurgeExpired(expiry_time);
+      shard.PurgeExpiredBucket(expiry_time);
       return {};
     }
 
@@ -78,45 +129,59 @@ boost::any InMemoryCache::Get(const std::string& key) {
 }
 
 size_t InMemoryCache::Size() const {
-  std::lock_guard<std::mutex> lock{mutex_};
-  return item_tuples_.Size();
+  size_t size = 0u;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock{shard->mutex};
+    size += shard->item_tuples.Size();
+  }
+  return size;
 }
 
 void InMemoryCache::Clear() {
-  std::lock_guard<std::mutex> lock{mutex_};
-  item_expiries_.clear();
-  item_tuples_.Clear();
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock{shard->mutex};
+    shard->item_expiries.clear();
+    shard->item_tuples.Clear();
+  }
+}
+
+void InMemoryCache::Resize(size_t max_size) {
+  const auto shard_count = shards_.size();
+  for (size_t index = 0; index < shard_count; ++index) {
+    auto& shard = *shards_[index];
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    shard.item_tuples.Resize(GetShardMaxSize(max_size, shard_count, index));
+  }
 }
 
 bool InMemoryCache::Remove(const std::string& key) {
-  std::lock_guard<std::mutex> lock{mutex_};
-  return item_tuples_.Erase(key);
+  auto& shard = GetShard(key);
+  std::lock_guard<std::mutex> lock{shard.mutex};
+  return shard.item_tuples.Erase(key);
 }
 
 void InMemoryCache::RemoveKeysWithPrefix(const std::string& key_prefix,
                                          const RemoveFilterFunc& filter) {
-  std::lock_guard<std::mutex> lock{mutex_};
-
-  for (auto it = item_tuples_.begin(); it != item_tuples_.end();) {
-    if (it->key().substr(0, key_prefix.length()) == key_prefix) {
-      // Check if this key is not protected, and if it is do not remove
-      if (filter && filter(it->key())) {
-        ++it;
-        continue;
-      }
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock{shard->mutex};
 
-      // we allow concurrent modifications.
-      it = item_tuples_.Erase(it);
-    } else {
-      ++it;
-    }
+    shard->item_tuples.EraseRange(
+        key_prefix,
+        [&](const std::string& key) {
+          return key.compare(0, key_prefix.size(), key_prefix) == 0;
+        },
+        [&](const std::string& key, const ItemTuple&) {
+          // Check if this key is not protected, and if it is do not remove
+          return !filter || !filter(key);
+        });
   }
 }
 
 bool InMemoryCache::Contains(const std::string& key) const {
-  std::lock_guard<std::mutex> lock{mutex_};
-  auto it = item_tuples_.FindNoPromote(key);
-  if (it != item_tuples_.end()) {
+  const auto& shard = GetShard(key);
+  std::lock_guard<std::mutex> lock{shard.mutex};
+  auto it = shard.item_tuples.FindNoPromote(key);
+  if (it != shard.item_tuples.end()) {
     auto expiry_time = std::get<1>(it.value());
     return (expiry_time > time_provider_());
   }
@@ -124,12 +189,38 @@ bool InMemoryCache::Contains(const std::string& key) const {
   return false;
 }
 
-bool InMemoryCache::PurgeExpired() {
+InMemoryCache::Shard& InMemoryCache::GetShard(const std::string& key) const {
+  if (shards_.size() == 1u) {
+    return *shards_.front();
+  }
+
+  return *shards_[std::hash<std::string>{}(key) % shards_.size()];
+}
+
+bool InMemoryCache::Shard::Admit(const std::string& key,
+                                 const ItemTuple& value) {
+  if (!frequencies) {
+    return true;
+  }
+
+  frequencies->Increment(key);
+
+  // Updates and items which fit without an eviction are always admitted.
+  if (item_tuples.Size() + cache_cost(value) <= item_tuples.GetMaxSize() ||
+      item_tuples.FindNoPromote(key) != item_tuples.end() ||
+      item_tuples.Size() == 0u) {
+    return true;
+  }
+
+  const auto& victim = item_tuples.rbegin().key();
+  return frequencies->Frequency(key) > frequencies->Frequency(victim);
+}
+
+bool InMemoryCache::Shard::PurgeExpired(time_t time_now) {
   bool ret = true;
   std::vector<time_t> expired_keys;
-  const auto time_now = time_provider_();
 
-  for (const auto& item : item_expiries_) {
+  for (const auto& item : item_expiries) {
     if (item.first < time_now) {
       expired_keys.push_back(item.first);
     } else {
@@ -139,26 +230,27 @@ bool InMemoryCache::PurgeExpired() {
   }
 
   for (auto& key : expired_keys) {
-    ret &= PurgeExpired(key);
+    ret &= PurgeExpiredBucket(key);
   }
 
   return ret;
 }
 
-bool InMemoryCache::PurgeExpired(time_t expire_time) {
+bool InMemoryCache::Shard::PurgeExpiredBucket(time_t expire_time) {
   bool ret = true;
-  for (auto& item : item_expiries_[expire_time]) {
-    ret &= item_tuples_.Erase(std::get<0>(item));
+  for (auto& item : item_expiries[expire_time]) {
+    ret &= item_tuples.Erase(std::get<0>(item));
   }
 
-  item_expiries_.erase(expire_time);
+  item_expiries.erase(expire_time);
   return ret;
 }
 
-void InMemoryCache::OnEviction(const std::string& key, ItemTuple&& value) {
+void InMemoryCache::Shard::OnEviction(const std::string& key,
+                                      ItemTuple&& value) {
   time_t expiry = std::get<1>(value);
   if (HasExpiry(expiry)) {
-    auto item = item_expiries_[expiry];
+    auto item = item_expiries[expiry];
     for (auto it = item.begin(); it != item.end(); it++) {
       if (std::get<0>(*it) == key) {
         item.erase(it);
@@ -166,8 +258,8 @@ void InMemoryCache::OnEviction(const std::string& key, ItemTuple&& value) {
       }
     }
 
-    if (item_expiries_[expiry].size() == 0) {
-      item_expiries_.erase(expiry);
+    if (item_expiries[expiry].size() == 0) {
+      item_expiries.erase(expiry);
     }
   }
 }
@@ -22,20 +22,34 @@
 #include <chrono>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
 
-#include <olp/core/utils/LruCache.h>
+#include <olp/core/utils/HashLruCache.h>
+#include <olp/core/utils/PoolAllocator.h>
 #include <boost/any.hpp>
 
+#include "FrequencySketch.h"
+
 namespace olp {
 namespace cache {
 
 /**
  * @brief In-memory cache that implements a LRU and a time based eviction
  * policy.
+ *
+ * The cache can be split into several independent shards. Each shard has its
+ * own lock, LRU list and an equal part of the total cost budget. A key is
+ * always assigned to the same shard based on its hash, so concurrent
+ * operations on different keys rarely contend on the same lock.
+ *
+ * Optionally, a new key is only admitted when it would evict the least
+ * recently used item and it is accessed more frequently than that item
+ * (TinyLFU). This keeps the frequently used items from being flushed by
+ * a scan of keys that are used only once.
  */
 class InMemoryCache {
  public:
@@ -68,7 +82,8 @@ class InMemoryCache {
 
   InMemoryCache(size_t max_size = kSizeMax,
                 ModelCacheCostFunc cache_cost = DefaultCacheCost(),
-                TimeProvider time_provider = DefaultTimeProvider());
+                TimeProvider time_provider = DefaultTimeProvider(),
+                size_t shard_count = 1u, bool admission_filter = false);
 
   bool Put(const std::string& key, const boost::any& item,
            time_t expire_seconds = kExpiryMax, size_t = 1u);
@@ -82,15 +97,37 @@ class InMemoryCache {
                             const RemoveFilterFunc& filter = nullptr);
   bool Contains(const std::string& key) const;
 
+  /// Sets the new maximum size, the least recently used items are evicted.
+  void Resize(size_t max_size);
+
+  /// Returns the number of shards the cache is split into.
+  size_t ShardCount() const { return shards_.size(); }
+
  protected:
-  bool PurgeExpired();
-  bool PurgeExpired(time_t expire_time);
-  void OnEviction(const std::string& key, ItemTuple&& value);
+  /// A part of the cache guarded by its own lock.
+  struct Shard {
+    Shard(size_t max_size, ModelCacheCostFunc cache_cost,
+          bool admission_filter);
+
+    bool Admit(const std::string& key, const ItemTuple& value);
+    bool PurgeExpired(time_t time_now);
+    bool PurgeExpiredBucket(time_t expire_time);
+    void OnEviction(const std::string& key, ItemTuple&& value);
+
+    mutable std::mutex mutex;
+    utils::HashLruCache<std::string, ItemTuple, ModelCacheCostFunc,
+                        std::hash<std::string>, std::equal_to<std::string>,
+                        utils::PoolAllocator>
+        item_tuples;
+    std::map<time_t, ItemTuples> item_expiries;
+    ModelCacheCostFunc cache_cost;
+    std::unique_ptr<FrequencySketch> frequencies;
+  };
+
+  Shard& GetShard(const std::string& key) const;
 
  private:
-  mutable std::mutex mutex_;
-  utils::LruCache<std::string, ItemTuple, ModelCacheCostFunc> item_tuples_;
-  std::map<time_t, ItemTuples> item_expiries_;
+  std::vector<std::unique_ptr<Shard>> shards_;
   TimeProvider time_provider_;
 };
 }  // namespace cache
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "KeyPrefixTable.h"
+
+namespace olp {
+namespace cache {
+
+namespace {
+constexpr auto kSeparator = "::";
+constexpr size_t kSeparatorLength = 2u;
+constexpr size_t kPrefixSeparators = 3u;
+constexpr uint32_t kNotFound = static_cast<uint32_t>(-1);
+}  // namespace
+
+constexpr uint32_t KeyPrefixTable::kNoPrefix;
+constexpr size_t KeyPrefixTable::kMaxPrefixes;
+
+KeyPrefixTable::KeyPrefixTable() : prefixes_(1u) {}
+
+CompactKey KeyPrefixTable::Compress(const std::string& key) {
+  const auto length = PrefixLength(key);
+  if (length == 0u) {
+    return {kNoPrefix, key};
+  }
+
+  const auto hash = Hash(key.data(), length);
+  auto id = FindPrefix(key, length, hash);
+  if (id == kNotFound) {
+    // A different prefix with the same hash keeps its keys whole.
+    if (prefixes_.size() >= kMaxPrefixes || ids_.count(hash) != 0u) {
+      return {kNoPrefix, key};
+    }
+
+    id = static_cast<uint32_t>(prefixes_.size());
+    prefixes_.emplace_back(key, 0u, length);
+    ids_.emplace(hash, id);
+  }
+
+  return {id, key.substr(length)};
+}
+
+CompactKey KeyPrefixTable::Find(const std::string& key) const {
+  const auto length = PrefixLength(key);
+  if (length == 0u) {
+    return {kNoPrefix, key};
+  }
+
+  const auto id = FindPrefix(key, length, Hash(key.data(), length));
+  if (id == kNotFound) {
+    return {kNoPrefix, key};
+  }
+
+  return {id, key.substr(length)};
+}
+
+std::string KeyPrefixTable::Expand(const CompactKey& key) const {
+  const auto& prefix = prefixes_[key.prefix];
+  std::string result;
+  result.reserve(prefix.size() + key.suffix.size());
+  result.append(prefix).append(key.suffix);
+  return result;
+}
+
+bool KeyPrefixTable::StartsWith(const CompactKey& key,
+                                const std::string& prefix) const {
+  const auto& key_prefix = prefixes_[key.prefix];
+  if (prefix.size() <= key_prefix.size()) {
+    return key_prefix.compare(0, prefix.size(), prefix) == 0;
+  }
+
+  return prefix.compare(0, key_prefix.size(), key_prefix) == 0 &&
+         key.suffix.compare(0, prefix.size() - key_prefix.size(), prefix,
+                            key_prefix.size(), std::string::npos) == 0;
+}
+
+size_t KeyPrefixTable::PrefixLength(const std::string& key) {
+  size_t length = 0u;
+  size_t separators = 0u;
+  auto pos = key.find(kSeparator);
+  while (pos != std::string::npos) {
+    length = pos + kSeparatorLength;
+    if (++separators == kPrefixSeparators) {
+      break;
+    }
+    pos = key.find(kSeparator, length);
+  }
+  return length;
+}
+
+uint64_t KeyPrefixTable::Hash(const char* data, size_t size) {
+  // FNV-1a
+  uint64_t hash = 0xCBF29CE484222325ull;
+  for (size_t i = 0u; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 0x100000001B3ull;
+  }
+  return hash;
+}
+
+uint32_t KeyPrefixTable::FindPrefix(const std::string& key, size_t length,
+                                    uint64_t hash) const {
+  auto it = ids_.find(hash);
+  if (it == ids_.end()) {
+    return kNotFound;
+  }
+
+  const auto& prefix = prefixes_[it->second];
+  if (prefix.size() != length || key.compare(0, length, prefix) != 0) {
+    return kNotFound;
+  }
+
+  return it->second;
+}
+
+}  // namespace cache
+}  // namespace olp
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace olp {
+namespace cache {
+
+/// A cache key split into the identifier of an interned prefix and the rest of
+/// the key.
+struct CompactKey {
+  uint32_t prefix;
+  std::string suffix;
+
+  bool operator==(const CompactKey& other) const {
+    return prefix == other.prefix && suffix == other.suffix;
+  }
+
+  bool operator<(const CompactKey& other) const {
+    return prefix < other.prefix ||
+           (prefix == other.prefix && suffix < other.suffix);
+  }
+};
+
+/// Hashes the `CompactKey`.
+struct CompactKeyHash {
+  size_t operator()(const CompactKey& key) const {
+    return std::hash<std::string>()(key.suffix) ^
+           (static_cast<size_t>(key.prefix) *
+            static_cast<size_t>(0x9E3779B97F4A7C15ull));
+  }
+};
+
+/// Interns the key prefixes, which repeat in most of the keys, so the keys can
+/// be kept as a `CompactKey`. The prefix of a key ends after its third `::`,
+/// which covers the catalog HRN and the layer of the SDK keys. The prefixes
+/// are never released, so the identifiers stay valid, and the number of them
+/// is limited. The keys whose prefix does not fit into the table are kept
+/// whole, with the empty prefix. The class is not thread safe.
+class KeyPrefixTable {
+ public:
+  /// The identifier of the empty prefix.
+  static constexpr uint32_t kNoPrefix = 0u;
+
+  /// The maximum number of the interned prefixes.
+  static constexpr size_t kMaxPrefixes = 4096u;
+
+  KeyPrefixTable();
+
+  /// Converts the key, interning its prefix when it is new.
+  CompactKey Compress(const std::string& key);
+
+  /// Converts the key without interning. The result equals the one of
+  /// `Compress` for any key that was compressed before.
+  CompactKey Find(const std::string& key) const;
+
+  /// Restores the key.
+  std::string Expand(const CompactKey& key) const;
+
+  /// Checks whether the restored key starts with the prefix.
+  bool StartsWith(const CompactKey& key, const std::string& prefix) const;
+
+  /// Returns the number of the interned prefixes, including the empty one.
+  size_t Size() const { return prefixes_.size(); }
+
+ private:
+  static size_t PrefixLength(const std::string& key);
+  static uint64_t Hash(const char* data, size_t size);
+
+  uint32_t FindPrefix(const std::string& key, size_t length,
+                      uint64_t hash) const;
+
+  std::vector<std::string> prefixes_;
+  std::unordered_map<uint64_t, uint32_t> ids_;
+};
+
+}  // namespace cache
+}  // namespace olp
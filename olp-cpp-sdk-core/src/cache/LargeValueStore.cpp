@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "LargeValueStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include "MappedFile.h"
+#include "olp/core/logging/Log.h"
+#include "olp/core/utils/Dir.h"
+
+namespace {
+constexpr auto kLogTag = "LargeValueStore";
+
+// The reference is the magic, the value size and the file name.
+constexpr char kReferenceMagic[] = {'\0', 'O', 'L', 'V'};
+constexpr auto kReferenceMagicSize = sizeof(kReferenceMagic);
+constexpr auto kNameSize = 16u;
+constexpr auto kReferenceSize = kReferenceMagicSize + 8u + kNameSize;
+
+// The files are spread over the subdirectories named by the first digits.
+constexpr auto kSubdirectoryNameSize = 2u;
+
+// The names are the FNV-1a hash of the key and the value.
+constexpr uint64_t kHashOffset = 14695981039346656037ull;
+constexpr uint64_t kHashPrime = 1099511628211ull;
+
+uint64_t Hash(uint64_t hash, const char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= kHashPrime;
+  }
+  return hash;
+}
+
+uint64_t HashKey(const std::string& key) {
+  // The size of the key is hashed as well, so the key and the value cannot
+  // be shifted against each other.
+  auto hash = Hash(kHashOffset, key.data(), key.size());
+  const auto size = static_cast<uint64_t>(key.size());
+  return Hash(hash, reinterpret_cast<const char*>(&size), sizeof(size));
+}
+
+std::string MakeName(uint64_t id) {
+  static const char kDigits[] = "0123456789abcdef";
+  std::string name(kNameSize, '0');
+  for (size_t i = 0; i < kNameSize; ++i) {
+    name[kNameSize - 1u - i] = kDigits[(id >> (4u * i)) & 0xfu];
+  }
+  return name;
+}
+
+std::string MakeReference(uint64_t size, const std::string& name) {
+  std::string reference(kReferenceMagic, kReferenceMagicSize);
+  for (size_t i = 0; i < sizeof(size); ++i) {
+    reference.push_back(static_cast<char>((size >> (8u * i)) & 0xffu));
+  }
+  reference.append(name);
+  return reference;
+}
+
+int64_t GetFileSize(const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  return file ? static_cast<int64_t>(file.tellg()) : -1;
+}
+
+uint64_t DecodeSize(const char* data) {
+  uint64_t size = 0u;
+  for (size_t i = 0; i < sizeof(size); ++i) {
+    size |= static_cast<uint64_t>(
+                static_cast<unsigned char>(data[kReferenceMagicSize + i]))
+            << (8u * i);
+  }
+  return size;
+}
+}  // namespace
+
+namespace olp {
+namespace cache {
+
+LargeValueStore::Writer::Writer(const LargeValueStore& store,
+                                std::string path, uint64_t hash)
+    : store_(store), path_(std::move(path)), hash_(hash) {
+  file_.open(path_, std::ios::binary | std::ios::trunc);
+}
+
+LargeValueStore::Writer::~Writer() {
+  if (file_.is_open()) {
+    file_.close();
+    std::remove(path_.c_str());
+  }
+}
+
+bool LargeValueStore::Writer::Append(const char* data, size_t size) {
+  if (!file_.is_open()) {
+    return false;
+  }
+
+  file_.write(data, size);
+  hash_ = Hash(hash_, data, size);
+  size_ += size;
+  return static_cast<bool>(file_);
+}
+
+bool LargeValueStore::Writer::Finish(std::string& reference) {
+  if (!file_.is_open()) {
+    return false;
+  }
+
+  // A file that is not completely written after a crash has a different size
+  // than the reference, so it is never read.
+  file_.close();
+  if (!file_) {
+    std::remove(path_.c_str());
+    return false;
+  }
+
+  const auto name = MakeName(hash_);
+  reference = MakeReference(size_, name);
+  if (store_.IsPublished(reference)) {
+    std::remove(path_.c_str());
+    return true;
+  }
+
+  // Another writer of the same value may have finished already.
+  const auto temporary_path = store_.GetTemporaryPath(name);
+  std::remove(temporary_path.c_str());
+  if (std::rename(path_.c_str(), temporary_path.c_str()) != 0) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Finish: failed to rename file, path=%s",
+                        path_.c_str());
+    std::remove(path_.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+LargeValueStore::LargeValueStore()
+    : next_id_(static_cast<uint64_t>(
+          std::chrono::system_clock::now().time_since_epoch().count())) {}
+
+bool LargeValueStore::IsReference(const char* data, size_t size) {
+  return size == kReferenceSize &&
+         std::memcmp(data, kReferenceMagic, kReferenceMagicSize) == 0;
+}
+
+uint64_t LargeValueStore::GetValueSize(const char* data, size_t size) {
+  return IsReference(data, size) ? DecodeSize(data) : size;
+}
+
+void LargeValueStore::Open(std::string directory) {
+  directory_ = std::move(directory);
+}
+
+std::unique_ptr<LargeValueStore::Writer> LargeValueStore::NewWriter(
+    const std::string& key) {
+  if (directory_.empty()) {
+    return nullptr;
+  }
+
+  if (!utils::Dir::Exists(directory_) && !utils::Dir::Create(directory_)) {
+    OLP_SDK_LOG_ERROR_F(kLogTag,
+                        "NewWriter: failed to create directory, path=%s",
+                        directory_.c_str());
+    return nullptr;
+  }
+
+  // The value is written under a unique ID until its hash is known. The IDs
+  // start at the current time, so they are unique across the runs, the
+  // existing files are skipped anyway.
+  std::string path;
+  do {
+    path = GetTemporaryPath(MakeName(next_id_.fetch_add(1u)));
+  } while (utils::Dir::FileExists(path));
+
+  std::unique_ptr<Writer> writer(new Writer(*this, path, HashKey(key)));
+  if (!writer->file_.is_open()) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "NewWriter: failed to create file, path=%s",
+                        writer->path_.c_str());
+    return nullptr;
+  }
+
+  return writer;
+}
+
+bool LargeValueStore::Write(const std::string& key, const char* data,
+                            size_t size, std::string& reference) {
+  // The unchanged value of the key is not written again.
+  reference = MakeReference(size, MakeName(Hash(HashKey(key), data, size)));
+  if (IsPublished(reference)) {
+    return true;
+  }
+
+  auto writer = NewWriter(key);
+  return writer && writer->Append(data, size) && writer->Finish(reference);
+}
+
+bool LargeValueStore::Publish(const std::string& reference) {
+  const auto path = GetPath(reference.data(), reference.size());
+  if (path.empty()) {
+    return false;
+  }
+
+  // The same value of the key is stored already.
+  if (IsPublished(reference)) {
+    Discard(reference);
+    return true;
+  }
+
+  const auto separator = path.rfind('/');
+  const auto subdirectory = path.substr(0, separator);
+  if (!utils::Dir::Exists(subdirectory) && !utils::Dir::Create(subdirectory)) {
+    OLP_SDK_LOG_ERROR_F(kLogTag,
+                        "Publish: failed to create directory, path=%s",
+                        subdirectory.c_str());
+    return false;
+  }
+
+  // The file of the same name may be left incomplete after a crash.
+  const auto temporary_path = GetTemporaryPath(path.substr(separator + 1u));
+  std::remove(path.c_str());
+  if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Publish: failed to rename file, path=%s",
+                        path.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+void LargeValueStore::Discard(const std::string& reference) {
+  if (!directory_.empty() &&
+      IsReference(reference.data(), reference.size())) {
+    const auto name = reference.substr(kReferenceSize - kNameSize);
+    std::remove(GetTemporaryPath(name).c_str());
+  }
+}
+
+void LargeValueStore::Remove(const char* data, size_t size) {
+  const auto path = GetPath(data, size);
+  if (!path.empty() && std::remove(path.c_str()) != 0) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Remove: failed to remove file, path=%s",
+                          path.c_str());
+  }
+}
+
+KeyValueCache::ValueView LargeValueStore::Map(const char* data,
+                                              size_t size) const {
+  const auto path = GetPath(data, size);
+  if (path.empty()) {
+    return {};
+  }
+
+  auto file = MappedFile::Open(path);
+  if (!file || file->Size() != DecodeSize(data)) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Map: missing or corrupted file, path=%s",
+                          path.c_str());
+    return {};
+  }
+
+  const auto* file_data = reinterpret_cast<const unsigned char*>(file->Data());
+  const auto file_size = static_cast<size_t>(file->Size());
+  return KeyValueCache::ValueView(std::move(file), file_data, file_size);
+}
+
+std::string LargeValueStore::GetPath(const char* data, size_t size) const {
+  if (directory_.empty() || !IsReference(data, size)) {
+    return {};
+  }
+
+  const std::string name(data + kReferenceSize - kNameSize, kNameSize);
+  return directory_ + "/" + name.substr(0, kSubdirectoryNameSize) + "/" +
+         name;
+}
+
+std::string LargeValueStore::GetTemporaryPath(const std::string& name) const {
+  return directory_ + "/" + name + kTemporarySuffix;
+}
+
+bool LargeValueStore::IsPublished(const std::string& reference) const {
+  const auto path = GetPath(reference.data(), reference.size());
+  return !path.empty() &&
+         GetFileSize(path) ==
+             static_cast<int64_t>(DecodeSize(reference.data()));
+}
+
+}  // namespace cache
+}  // namespace olp
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <olp/core/cache/KeyValueCache.h>
+
+namespace olp {
+namespace cache {
+
+/**
+ * @brief Stores the large values of the disk cache in separate files.
+ *
+ * The disk cache stores a small reference instead of the value: the magic,
+ * the value size, and the file name. Keeping the large values out of the
+ * database avoids rewriting them on every compaction, and removing a value
+ * is a file unlink.
+ *
+ * The directory is content-addressed: the file name is the hash of the key
+ * and the value, and the files are spread over subdirectories by the first
+ * two digits of the name. A value that is stored again with the same key
+ * keeps its file, so it is not written again. The files of different keys
+ * are never shared, so a file is removed together with its reference.
+ *
+ * A value is written in chunks to a temporary file, and the file gets its
+ * final name with `Publish` once the reference is stored. The values are read
+ * back through a memory mapping.
+ */
+class LargeValueStore {
+ public:
+  /// Writes a value in chunks to a temporary file.
+  class Writer {
+   public:
+    ~Writer();
+
+    /// Appends the chunk to the file, returns false if it cannot be written.
+    bool Append(const char* data, size_t size);
+
+    /// Closes the file and returns the reference of the value. The temporary
+    /// file is removed with `Discard` from now on.
+    bool Finish(std::string& reference);
+
+   private:
+    friend class LargeValueStore;
+
+    Writer(const LargeValueStore& store, std::string path, uint64_t hash);
+
+    const LargeValueStore& store_;
+    std::string path_;
+    std::ofstream file_;
+    uint64_t hash_;
+    uint64_t size_{0u};
+  };
+
+  /// The name of the directory of the files in the disk cache directory.
+  static constexpr auto kDirectoryName = "large_values";
+
+  /// The suffix of the files that are not published yet.
+  static constexpr auto kTemporarySuffix = ".tmp";
+
+  LargeValueStore();
+
+  /// Returns true if the data is a reference to a large value.
+  static bool IsReference(const char* data, size_t size);
+
+  /// Returns the size of the referenced value, or `size` if the data is not
+  /// a reference.
+  static uint64_t GetValueSize(const char* data, size_t size);
+
+  /// Sets the directory of the files, it is created with the first value.
+  void Open(std::string directory);
+
+  /// Creates a writer of a new value of the key, or returns null on failure.
+  std::unique_ptr<Writer> NewWriter(const std::string& key);
+
+  /// Writes the whole value of the key, unless its file exists already.
+  /// Returns false on failure.
+  bool Write(const std::string& key, const char* data, size_t size,
+             std::string& reference);
+
+  /// Gives the file of the stored reference its final name. The file that
+  /// exists already is kept.
+  bool Publish(const std::string& reference);
+
+  /// Removes the file of the reference that was not stored.
+  void Discard(const std::string& reference);
+
+  /// Removes the file of the published reference.
+  void Remove(const char* data, size_t size);
+
+  /// Maps the referenced value, returns an empty view if the file is missing
+  /// or has a different size.
+  KeyValueCache::ValueView Map(const char* data, size_t size) const;
+
+ private:
+  /// Returns the path of the referenced file, or an empty path.
+  std::string GetPath(const char* data, size_t size) const;
+
+  /// Returns the path of the temporary file of the name.
+  std::string GetTemporaryPath(const std::string& name) const;
+
+  /// Returns true if the file of the reference exists and has its size.
+  bool IsPublished(const std::string& reference) const;
+
+  std::string directory_;
+  std::atomic<uint64_t> next_id_;
+};
+
+}  // namespace cache
+}  // namespace olp
@@ -0,0 +1,662 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "MappedCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "MappedFile.h"
+#include "olp/core/logging/Log.h"
+#include "olp/core/utils/Dir.h"
+
+namespace {
+constexpr auto kLogTag = "MappedCache";
+
+constexpr char kMagic[] = {'O', 'L', 'P', 'C', 'M', 'A', 'P', '1'};
+constexpr size_t kMagicSize = sizeof(kMagic);
+// magic, count, index offset, keys offset, file size
+constexpr size_t kHeaderSize = kMagicSize + 4u * sizeof(uint64_t);
+// value offset, key offset, key size, value size
+constexpr size_t kIndexEntrySize =
+    2u * sizeof(uint64_t) + 2u * sizeof(uint32_t);
+
+constexpr char kDeltaMagic[] = {'O', 'L', 'P', 'C', 'D', 'L', 'T', '1'};
+constexpr size_t kDeltaMagicSize = sizeof(kDeltaMagic);
+// magic, base hash, target hash
+constexpr size_t kDeltaHeaderSize = kDeltaMagicSize + 2u * sizeof(uint64_t);
+constexpr char kPutRecord = 'P';
+constexpr char kRemoveRecord = 'R';
+constexpr char kEndRecord = 'E';
+
+// The storages are identified by the FNV-1a hash of the keys and values.
+constexpr uint64_t kHashOffset = 14695981039346656037ull;
+constexpr uint64_t kHashPrime = 1099511628211ull;
+
+void PutFixed32(std::string& dst, uint32_t value) {
+  for (size_t i = 0; i < sizeof(value); ++i) {
+    dst.push_back(static_cast<char>((value >> (8u * i)) & 0xffu));
+  }
+}
+
+void PutFixed64(std::string& dst, uint64_t value) {
+  for (size_t i = 0; i < sizeof(value); ++i) {
+    dst.push_back(static_cast<char>((value >> (8u * i)) & 0xffu));
+  }
+}
+
+uint32_t DecodeFixed32(const char* src) {
+  uint32_t value = 0u;
+  for (size_t i = 0; i < sizeof(value); ++i) {
+    value |= static_cast<uint32_t>(static_cast<unsigned char>(src[i]))
+             << (8u * i);
+  }
+  return value;
+}
+
+uint64_t DecodeFixed64(const char* src) {
+  uint64_t value = 0u;
+  for (size_t i = 0; i < sizeof(value); ++i) {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(src[i]))
+             << (8u * i);
+  }
+  return value;
+}
+
+int CompareKeys(const char* lhs, size_t lhs_size, const char* rhs,
+                size_t rhs_size) {
+  const auto result = std::memcmp(lhs, rhs, std::min(lhs_size, rhs_size));
+  if (result != 0) {
+    return result;
+  }
+  if (lhs_size == rhs_size) {
+    return 0;
+  }
+  return lhs_size < rhs_size ? -1 : 1;
+}
+
+int CompareKeys(const char* lhs, size_t lhs_size, const std::string& rhs) {
+  return CompareKeys(lhs, lhs_size, rhs.data(), rhs.size());
+}
+
+std::string GetFilePath(const std::string& directory) {
+  return directory + "/" + olp::cache::MappedCache::kFileName;
+}
+
+uint64_t Hash(uint64_t hash, const char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= kHashPrime;
+  }
+  return hash;
+}
+
+uint64_t HashEntry(uint64_t hash, const char* key, size_t key_size,
+                   const char* value, size_t value_size) {
+  // The sizes are hashed as well, so the keys and the values cannot be
+  // shifted against each other.
+  std::string sizes;
+  PutFixed32(sizes, static_cast<uint32_t>(key_size));
+  PutFixed32(sizes, static_cast<uint32_t>(value_size));
+  hash = Hash(hash, sizes.data(), sizes.size());
+  hash = Hash(hash, key, key_size);
+  return Hash(hash, value, value_size);
+}
+
+struct DeltaRecord {
+  char type{kEndRecord};
+  std::string key;
+  std::string value;
+};
+
+bool ReadFixed32(std::istream& stream, uint32_t& value) {
+  char buffer[sizeof(uint32_t)];
+  if (!stream.read(buffer, sizeof(buffer))) {
+    return false;
+  }
+  value = DecodeFixed32(buffer);
+  return true;
+}
+
+bool ReadString(std::istream& stream, std::string& value) {
+  uint32_t size = 0u;
+  if (!ReadFixed32(stream, size)) {
+    return false;
+  }
+  value.resize(size);
+  return size == 0u || static_cast<bool>(stream.read(&value[0], size));
+}
+
+/// Reads the next record, returns false if the delta is truncated or
+/// corrupted.
+bool ReadRecord(std::istream& stream, DeltaRecord& record) {
+  if (!stream.get(record.type)) {
+    return false;
+  }
+
+  switch (record.type) {
+    case kPutRecord:
+      return ReadString(stream, record.key) &&
+             ReadString(stream, record.value);
+    case kRemoveRecord:
+      record.value.clear();
+      return ReadString(stream, record.key);
+    case kEndRecord:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void WriteRecord(std::ostream& stream, char type, const char* key,
+                 size_t key_size, const char* value, size_t value_size) {
+  std::string record(1u, type);
+  PutFixed32(record, static_cast<uint32_t>(key_size));
+  record.append(key, key_size);
+  if (type == kPutRecord) {
+    PutFixed32(record, static_cast<uint32_t>(value_size));
+  }
+  stream.write(record.data(), record.size());
+  if (type == kPutRecord) {
+    stream.write(value, value_size);
+  }
+}
+}  // namespace
+
+namespace olp {
+namespace cache {
+
+MappedCache::MappedCache() = default;
+
+MappedCache::~MappedCache() = default;
+
+bool MappedCache::Exists(const std::string& directory) {
+  return utils::Dir::FileExists(GetFilePath(directory));
+}
+
+bool MappedCache::Open(const std::string& directory) {
+  Close();
+
+  const auto path = GetFilePath(directory);
+  auto file = MappedFile::Open(path);
+  if (!file) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Open: failed to map file, path=%s",
+                        path.c_str());
+    return false;
+  }
+
+  const auto* data = file->Data();
+  const auto size = file->Size();
+  if (size < kHeaderSize || std::memcmp(data, kMagic, kMagicSize) != 0) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Open: invalid header, path=%s",
+                        path.c_str());
+    return false;
+  }
+
+  const auto* header = data + kMagicSize;
+  const auto count = DecodeFixed64(header);
+  const auto index_offset = DecodeFixed64(header + sizeof(uint64_t));
+  const auto keys_offset = DecodeFixed64(header + 2u * sizeof(uint64_t));
+  const auto file_size = DecodeFixed64(header + 3u * sizeof(uint64_t));
+
+  if (file_size != size || keys_offset < kHeaderSize ||
+      index_offset < keys_offset || index_offset > size ||
+      count > (size - index_offset) / kIndexEntrySize) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Open: invalid layout, path=%s",
+                        path.c_str());
+    return false;
+  }
+
+  file_ = std::move(file);
+  count_ = count;
+  index_offset_ = index_offset;
+  keys_offset_ = keys_offset;
+  return true;
+}
+
+void MappedCache::Close() {
+  file_.reset();
+  count_ = 0u;
+  index_offset_ = 0u;
+  keys_offset_ = 0u;
+}
+
+bool MappedCache::Find(const std::string& key, const char*& data,
+                       size_t& size) const {
+  if (!file_) {
+    return false;
+  }
+
+  uint64_t first = 0u;
+  uint64_t last = count_;
+
+  while (first < last) {
+    const auto middle = first + (last - first) / 2u;
+    Entry entry;
+    if (!At(middle, entry)) {
+      return false;
+    }
+
+    const auto result = CompareKeys(entry.key, entry.key_size, key);
+    if (result == 0) {
+      data = entry.value;
+      size = entry.value_size;
+      return true;
+    }
+
+    if (result < 0) {
+      first = middle + 1u;
+    } else {
+      last = middle;
+    }
+  }
+
+  return false;
+}
+
+boost::optional<std::string> MappedCache::Get(const std::string& key) const {
+  const char* data = nullptr;
+  size_t size = 0u;
+  if (!Find(key, data, size)) {
+    return boost::none;
+  }
+
+  return std::string(data, size);
+}
+
+bool MappedCache::Get(const std::string& key,
+                      KeyValueCache::ValueTypePtr& value) const {
+  const char* data = nullptr;
+  size_t size = 0u;
+  if (!Find(key, data, size)) {
+    value = nullptr;
+    return false;
+  }
+
+  value = std::make_shared<KeyValueCache::ValueType>(data, data + size);
+  return true;
+}
+
+bool MappedCache::Get(const std::string& key,
+                      std::shared_ptr<std::string>& value) const {
+  const char* data = nullptr;
+  size_t size = 0u;
+  if (!Find(key, data, size)) {
+    value = nullptr;
+    return false;
+  }
+
+  value = std::make_shared<std::string>(data, size);
+  return true;
+}
+
+KeyValueCache::ValueView MappedCache::GetView(const std::string& key) const {
+  const char* data = nullptr;
+  size_t size = 0u;
+  if (!Find(key, data, size)) {
+    return {};
+  }
+
+  return KeyValueCache::ValueView(
+      file_, reinterpret_cast<const unsigned char*>(data), size);
+}
+
+bool MappedCache::Contains(const std::string& key) const {
+  const char* data = nullptr;
+  size_t size = 0u;
+  return Find(key, data, size);
+}
+
+uint64_t MappedCache::Size() const { return file_ ? file_->Size() : 0u; }
+
+uint64_t MappedCache::Count() const { return count_; }
+
+bool MappedCache::At(uint64_t position, Entry& entry) const {
+  if (!file_ || position >= count_) {
+    return false;
+  }
+
+  const auto* file_data = file_->Data();
+  const auto* index = file_data + index_offset_ + position * kIndexEntrySize;
+  const auto value_offset = DecodeFixed64(index);
+  const auto key_offset = keys_offset_ + DecodeFixed64(index + 8u);
+  const auto key_size = DecodeFixed32(index + 16u);
+  const auto value_size = DecodeFixed32(index + 20u);
+
+  if (key_offset + key_size > index_offset_ ||
+      value_offset + value_size > keys_offset_) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "At: corrupted entry, index=%llu",
+                        static_cast<unsigned long long>(position));
+    return false;
+  }
+
+  entry.key = file_data + key_offset;
+  entry.key_size = key_size;
+  entry.value = file_data + value_offset;
+  entry.value_size = value_size;
+  return true;
+}
+
+MappedCacheWriter::MappedCacheWriter(std::string directory)
+    : directory_(std::move(directory)),
+      temp_path_(GetFilePath(directory_) + ".tmp") {}
+
+MappedCacheWriter::~MappedCacheWriter() {
+  if (file_.is_open()) {
+    file_.close();
+    std::remove(temp_path_.c_str());
+  }
+}
+
+bool MappedCacheWriter::Open() {
+  if (!utils::Dir::Exists(directory_) && !utils::Dir::Create(directory_)) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Open: failed to create directory, path=%s",
+                        directory_.c_str());
+    return false;
+  }
+
+  file_.open(temp_path_, std::ios::binary | std::ios::trunc);
+  if (!file_) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Open: failed to create file, path=%s",
+                        temp_path_.c_str());
+    return false;
+  }
+
+  // The header is written on Finish.
+  const std::string header(kHeaderSize, '\0');
+  file_.write(header.data(), header.size());
+  return static_cast<bool>(file_);
+}
+
+bool MappedCacheWriter::Add(const std::string& key, const char* data,
+                            size_t size) {
+  if (!file_.is_open() || (count_ > 0u && key <= last_key_) ||
+      key.size() > UINT32_MAX || size > UINT32_MAX) {
+    return false;
+  }
+
+  PutFixed64(index_, kHeaderSize + values_size_);
+  PutFixed64(index_, keys_.size());
+  PutFixed32(index_, static_cast<uint32_t>(key.size()));
+  PutFixed32(index_, static_cast<uint32_t>(size));
+  keys_.append(key);
+
+  file_.write(data, size);
+  values_size_ += size;
+  last_key_ = key;
+  ++count_;
+  return static_cast<bool>(file_);
+}
+
+bool MappedCacheWriter::Finish() {
+  if (!file_.is_open()) {
+    return false;
+  }
+
+  const uint64_t keys_offset = kHeaderSize + values_size_;
+  const uint64_t index_offset = keys_offset + keys_.size();
+  const uint64_t file_size = index_offset + index_.size();
+
+  std::string header(kMagic, kMagicSize);
+  PutFixed64(header, count_);
+  PutFixed64(header, index_offset);
+  PutFixed64(header, keys_offset);
+  PutFixed64(header, file_size);
+
+  file_.write(keys_.data(), keys_.size());
+  file_.write(index_.data(), index_.size());
+  file_.seekp(0);
+  file_.write(header.data(), header.size());
+  file_.close();
+  if (file_.fail() || !MappedFile::Sync(temp_path_)) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Finish: failed to write file, path=%s",
+                        temp_path_.c_str());
+    std::remove(temp_path_.c_str());
+    return false;
+  }
+
+  // The readers see either the old or the new file, also after a crash.
+  const auto path = GetFilePath(directory_);
+  if (!MappedFile::Replace(temp_path_, path)) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Finish: failed to replace file, path=%s",
+                        path.c_str());
+    std::remove(temp_path_.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+bool MappedCacheDelta::Create(const std::string& base_directory,
+                              const std::string& target_directory,
+                              const std::string& delta_path) {
+  MappedCache base;
+  MappedCache target;
+  if (!base.Open(base_directory) || !target.Open(target_directory)) {
+    return false;
+  }
+
+  std::ofstream file(delta_path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Create: failed to create file, path=%s",
+                        delta_path.c_str());
+    return false;
+  }
+
+  // The header is written when the hashes are known.
+  const std::string placeholder(kDeltaHeaderSize, '\0');
+  file.write(placeholder.data(), placeholder.size());
+
+  auto base_hash = kHashOffset;
+  auto target_hash = kHashOffset;
+  uint64_t changes = 0u;
+  uint64_t base_position = 0u;
+  uint64_t target_position = 0u;
+  MappedCache::Entry base_entry;
+  MappedCache::Entry target_entry;
+
+  while (base_position < base.Count() || target_position < target.Count()) {
+    const bool has_base = base_position < base.Count();
+    const bool has_target = target_position < target.Count();
+    if ((has_base && !base.At(base_position, base_entry)) ||
+        (has_target && !target.At(target_position, target_entry))) {
+      file.close();
+      std::remove(delta_path.c_str());
+      return false;
+    }
+
+    auto order = 0;
+    if (!has_base) {
+      order = 1;
+    } else if (!has_target) {
+      order = -1;
+    } else {
+      order = CompareKeys(base_entry.key, base_entry.key_size,
+                          target_entry.key, target_entry.key_size);
+    }
+
+    if (order <= 0) {
+      base_hash = HashEntry(base_hash, base_entry.key, base_entry.key_size,
+                            base_entry.value, base_entry.value_size);
+      ++base_position;
+    }
+    if (order >= 0) {
+      target_hash =
+          HashEntry(target_hash, target_entry.key, target_entry.key_size,
+                    target_entry.value, target_entry.value_size);
+      ++target_position;
+    }
+
+    if (order < 0) {
+      WriteRecord(file, kRemoveRecord, base_entry.key, base_entry.key_size,
+                  nullptr, 0u);
+      ++changes;
+    } else if (order > 0 || base_entry.value_size != target_entry.value_size ||
+               std::memcmp(base_entry.value, target_entry.value,
+                           target_entry.value_size) != 0) {
+      WriteRecord(file, kPutRecord, target_entry.key, target_entry.key_size,
+                  target_entry.value, target_entry.value_size);
+      ++changes;
+    }
+  }
+
+  file.put(kEndRecord);
+
+  std::string header(kDeltaMagic, kDeltaMagicSize);
+  PutFixed64(header, base_hash);
+  PutFixed64(header, target_hash);
+  file.seekp(0);
+  file.write(header.data(), header.size());
+  file.close();
+  if (file.fail()) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Create: failed to write file, path=%s",
+                        delta_path.c_str());
+    std::remove(delta_path.c_str());
+    return false;
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag, "Created delta, path=%s, changes=%llu",
+                     delta_path.c_str(),
+                     static_cast<unsigned long long>(changes));
+  return true;
+}
+
+bool MappedCacheDelta::Apply(const std::string& directory,
+                             const std::string& delta_path,
+                             std::vector<std::string>& changed_keys) {
+  MappedCache base;
+  if (!base.Open(directory)) {
+    return false;
+  }
+
+  std::ifstream file(delta_path, std::ios::binary);
+  char header[kDeltaHeaderSize];
+  if (!file || !file.read(header, sizeof(header)) ||
+      std::memcmp(header, kDeltaMagic, kDeltaMagicSize) != 0) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Apply: invalid delta, path=%s",
+                        delta_path.c_str());
+    return false;
+  }
+  const auto expected_base_hash = DecodeFixed64(header + kDeltaMagicSize);
+  const auto expected_target_hash =
+      DecodeFixed64(header + kDeltaMagicSize + sizeof(uint64_t));
+
+  MappedCacheWriter writer(directory);
+  if (!writer.Open()) {
+    return false;
+  }
+
+  auto base_hash = kHashOffset;
+  auto target_hash = kHashOffset;
+  uint64_t position = 0u;
+  MappedCache::Entry entry;
+  DeltaRecord record;
+  if (!ReadRecord(file, record)) {
+    return false;
+  }
+
+  changed_keys.clear();
+  while (true) {
+    const bool has_entry = position < base.Count();
+    const bool has_record = record.type != kEndRecord;
+    if (!has_entry && !has_record) {
+      break;
+    }
+    if (has_entry && !base.At(position, entry)) {
+      return false;
+    }
+
+    auto order = 0;
+    if (!has_entry) {
+      order = 1;
+    } else if (!has_record) {
+      order = -1;
+    } else {
+      order = CompareKeys(entry.key, entry.key_size, record.key);
+    }
+
+    if (order <= 0) {
+      base_hash = HashEntry(base_hash, entry.key, entry.key_size, entry.value,
+                            entry.value_size);
+      ++position;
+    }
+
+    // The base entries without a record are copied.
+    if (order < 0) {
+      target_hash = HashEntry(target_hash, entry.key, entry.key_size,
+                              entry.value, entry.value_size);
+      if (!writer.Add(std::string(entry.key, entry.key_size), entry.value,
+                      entry.value_size)) {
+        return false;
+      }
+      continue;
+    }
+
+    if (record.type == kRemoveRecord && order != 0) {
+      OLP_SDK_LOG_ERROR_F(kLogTag, "Apply: removed key not found, key=%s",
+                          record.key.c_str());
+      return false;
+    }
+
+    if (record.type == kPutRecord) {
+      target_hash =
+          HashEntry(target_hash, record.key.data(), record.key.size(),
+                    record.value.data(), record.value.size());
+      if (!writer.Add(record.key, record.value.data(), record.value.size())) {
+        return false;
+      }
+    }
+
+    changed_keys.push_back(std::move(record.key));
+    if (!ReadRecord(file, record)) {
+      OLP_SDK_LOG_ERROR_F(kLogTag, "Apply: truncated delta, path=%s",
+                          delta_path.c_str());
+      return false;
+    }
+  }
+
+  if (base_hash != expected_base_hash) {
+    OLP_SDK_LOG_ERROR_F(kLogTag,
+                        "Apply: the delta is not for this storage, path=%s",
+                        directory.c_str());
+    return false;
+  }
+  if (target_hash != expected_target_hash) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Apply: the result does not match, path=%s",
+                        directory.c_str());
+    return false;
+  }
+
+  // The previous file stays mapped by the opened instances.
+  base.Close();
+  if (!writer.Finish()) {
+    return false;
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag, "Applied delta, path=%s, changes=%zu",
+                     directory.c_str(), changed_keys.size());
+  return true;
+}
+
+}  // namespace cache
+}  // namespace olp
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <olp/core/cache/KeyValueCache.h>
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace cache {
+
+class MappedFile;
+
+/**
+ * @brief An immutable, memory-mapped key-value storage used as the protected
+ * cache.
+ *
+ * The storage is a single file with the following layout, all numbers are
+ * little-endian:
+ * - header: magic, entry count, index offset, keys offset, file size;
+ * - values region: the values in key order;
+ * - keys region: the keys in key order;
+ * - index: for each key, the value offset, the key offset, the key size and
+ * the value size.
+ *
+ * Opening the storage maps the file and validates the header only, lookups
+ * use a binary search over the index. The storage is created by
+ * `MappedCacheWriter`.
+ */
+class MappedCache {
+ public:
+  /// The name of the storage file in the cache directory.
+  static constexpr auto kFileName = "protected.mapped";
+
+  /// A key and its value in the mapped file.
+  struct Entry {
+    const char* key{nullptr};
+    size_t key_size{0u};
+    const char* value{nullptr};
+    size_t value_size{0u};
+  };
+
+  MappedCache();
+  ~MappedCache();
+
+  /// Returns true if the directory contains a storage file.
+  static bool Exists(const std::string& directory);
+
+  /// Maps the storage file of the directory, returns false on failure.
+  bool Open(const std::string& directory);
+
+  void Close();
+
+  /// Gets a copy of the value.
+  boost::optional<std::string> Get(const std::string& key) const;
+
+  /// Gets a copy of the value, returns false if the key is not found.
+  bool Get(const std::string& key, KeyValueCache::ValueTypePtr& value) const;
+
+  /// Gets a copy of the value, returns false if the key is not found.
+  bool Get(const std::string& key, std::shared_ptr<std::string>& value) const;
+
+  /// Gets a view on the mapped value, the view keeps the file mapped.
+  KeyValueCache::ValueView GetView(const std::string& key) const;
+
+  bool Contains(const std::string& key) const;
+
+  /// Returns the size of the storage file.
+  uint64_t Size() const;
+
+  /// Returns the number of the entries.
+  uint64_t Count() const;
+
+  /// Gets the entry at the position in the key order, returns false if the
+  /// entry is corrupted.
+  bool At(uint64_t position, Entry& entry) const;
+
+ private:
+  /// Returns true and the position of the value if the key is found.
+  bool Find(const std::string& key, const char*& data, size_t& size) const;
+
+  std::shared_ptr<const MappedFile> file_;
+  uint64_t count_{0u};
+  uint64_t index_offset_{0u};
+  uint64_t keys_offset_{0u};
+};
+
+/**
+ * @brief Writes the storage file of `MappedCache`.
+ *
+ * The keys must be added in the ascending byte-wise order, which is the order
+ * of the leveldb iterator. The values are streamed to a temporary file, and
+ * the file replaces the storage file on `Finish`.
+ */
+class MappedCacheWriter {
+ public:
+  explicit MappedCacheWriter(std::string directory);
+  ~MappedCacheWriter();
+
+  /// Creates the temporary file, returns false on failure.
+  bool Open();
+
+  /// Adds the key and value, returns false if the key is not in order or the
+  /// value cannot be written.
+  bool Add(const std::string& key, const char* data, size_t size);
+
+  /// Writes the keys and index and replaces the storage file. The file is
+  /// replaced atomically where the platform allows it.
+  bool Finish();
+
+ private:
+  std::string directory_;
+  std::string temp_path_;
+  std::ofstream file_;
+  std::string keys_;
+  std::string index_;
+  std::string last_key_;
+  uint64_t count_{0u};
+  uint64_t values_size_{0u};
+};
+
+/**
+ * @brief Updates a `MappedCache` storage to a newer version with the
+ * difference between the versions, instead of with a whole new storage.
+ *
+ * The delta is a single file with the following layout, all numbers are
+ * little-endian:
+ * - header: magic, hash of the base storage, hash of the target storage;
+ * - records in key order: `P`, key size, key, value size and value for the
+ * added and changed keys, `R`, key size and key for the removed keys;
+ * - the end record `E`.
+ *
+ * The hashes are computed over the keys and values, so the delta is applied
+ * only to the storage it was created from, and the result is verified before
+ * it replaces the storage. Both steps read the storages and the delta in key
+ * order, so the I/O is sequential.
+ */
+class MappedCacheDelta {
+ public:
+  /**
+   * @brief Writes the delta between the storages of the directories.
+   *
+   * @param base_directory The directory of the storage to update.
+   * @param target_directory The directory of the updated storage.
+   * @param delta_path The path of the delta file to write.
+   *
+   * @return True if the delta is written; false otherwise.
+   */
+  static bool Create(const std::string& base_directory,
+                     const std::string& target_directory,
+                     const std::string& delta_path);
+
+  /**
+   * @brief Builds the updated storage from the storage of the directory and
+   * the delta, and replaces the storage with it.
+   *
+   * The opened instances of the storage keep reading the previous file.
+   *
+   * @param directory The directory of the storage to update.
+   * @param delta_path The path of the delta file.
+   * @param changed_keys The added, changed and removed keys.
+   *
+   * @return True if the storage is updated; false otherwise, in which case
+   * the storage is not changed.
+   */
+  static bool Apply(const std::string& directory,
+                    const std::string& delta_path,
+                    std::vector<std::string>& changed_keys);
+};
+
+}  // namespace cache
+}  // namespace olp
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "MappedFile.h"
+
+#include <cstdio>
+
+#if !defined(_WIN32) || defined(__MINGW32__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace olp {
+namespace cache {
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+std::shared_ptr<const MappedFile> MappedFile::Open(const std::string& path) {
+  std::shared_ptr<MappedFile> file(new MappedFile());
+  // The delete sharing lets the file be replaced while it is mapped.
+  file->file_ = CreateFileA(path.c_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file->file_ == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file->file_, &size) || size.QuadPart == 0) {
+    return nullptr;
+  }
+
+  file->mapping_ =
+      CreateFileMappingA(file->file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!file->mapping_) {
+    return nullptr;
+  }
+
+  file->data_ = static_cast<const char*>(
+      MapViewOfFile(file->mapping_, FILE_MAP_READ, 0, 0, 0));
+  if (!file->data_) {
+    return nullptr;
+  }
+
+  file->size_ = static_cast<uint64_t>(size.QuadPart);
+  return file;
+}
+
+bool MappedFile::Sync(const std::string& path) {
+  const auto file =
+      CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  const bool result = FlushFileBuffers(file) != 0;
+  CloseHandle(file);
+  return result;
+}
+
+bool MappedFile::Replace(const std::string& source,
+                         const std::string& target) {
+  return MoveFileExA(source.c_str(), target.c_str(),
+                     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+MappedFile::~MappedFile() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_) {
+    CloseHandle(mapping_);
+  }
+  if (file_ != INVALID_HANDLE_VALUE) {
+    CloseHandle(file_);
+  }
+}
+#else
+std::shared_ptr<const MappedFile> MappedFile::Open(const std::string& path) {
+  const auto fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  std::shared_ptr<const MappedFile> result;
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+    const auto size = static_cast<size_t>(file_stat.st_size);
+    auto* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data != MAP_FAILED) {
+      std::shared_ptr<MappedFile> file(new MappedFile());
+      file->data_ = static_cast<const char*>(data);
+      file->size_ = size;
+      result = std::move(file);
+    }
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  return result;
+}
+
+bool MappedFile::Sync(const std::string& path) {
+  const auto fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  const bool result = fsync(fd) == 0;
+  close(fd);
+  return result;
+}
+
+bool MappedFile::Replace(const std::string& source,
+                         const std::string& target) {
+  if (rename(source.c_str(), target.c_str()) != 0) {
+    return false;
+  }
+
+  // The rename is durable once the directory is flushed, which not every
+  // file system supports, so it is done on the best effort basis.
+  const auto separator = target.find_last_of('/');
+  Sync(separator == std::string::npos ? "." : target.substr(0, separator + 1));
+  return true;
+}
+
+MappedFile::~MappedFile() {
+  if (data_) {
+    munmap(const_cast<char*>(data_), static_cast<size_t>(size_));
+  }
+}
+#endif
+
+}  // namespace cache
+}  // namespace olp
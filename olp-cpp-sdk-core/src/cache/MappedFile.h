@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+namespace olp {
+namespace cache {
+
+/// Read-only memory mapping of a whole file.
+class MappedFile {
+ public:
+  /// Maps the file, returns null if the file cannot be mapped or is empty.
+  static std::shared_ptr<const MappedFile> Open(const std::string& path);
+
+  /// Flushes the contents of the file to the disk.
+  static bool Sync(const std::string& path);
+
+  /// Replaces the target file with the source file atomically, also when the
+  /// target file is mapped, and flushes the directory entry to the disk.
+  static bool Replace(const std::string& source, const std::string& target);
+
+  ~MappedFile();
+
+  const char* Data() const { return data_; }
+  uint64_t Size() const { return size_; }
+
+ private:
+  MappedFile() = default;
+
+  const char* data_{nullptr};
+  uint64_t size_{0u};
+#if defined(_WIN32) && !defined(__MINGW32__)
+  HANDLE file_{INVALID_HANDLE_VALUE};
+  HANDLE mapping_{nullptr};
+#endif
+};
+
+}  // namespace cache
+}  // namespace olp
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "PromotionBuffer.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+namespace olp {
+namespace cache {
+
+constexpr size_t PromotionBuffer::kDefaultStripeCount;
+constexpr size_t PromotionBuffer::kDefaultStripeCapacity;
+
+PromotionBuffer::PromotionBuffer(size_t stripe_count, size_t stripe_capacity)
+    : stripe_capacity_(stripe_capacity), size_(0u) {
+  stripe_count = std::max<size_t>(stripe_count, 1u);
+  stripes_.reserve(stripe_count);
+  for (size_t index = 0u; index < stripe_count; ++index) {
+    stripes_.emplace_back(new Stripe);
+  }
+}
+
+bool PromotionBuffer::Add(const std::string& key) {
+  const auto index =
+      std::hash<std::thread::id>{}(std::this_thread::get_id()) %
+      stripes_.size();
+  auto& stripe = *stripes_[index];
+
+  std::lock_guard<std::mutex> lock(stripe.mutex);
+  if (stripe.keys.size() >= stripe_capacity_) {
+    return false;
+  }
+
+  stripe.keys.push_back(key);
+  size_.fetch_add(1u, std::memory_order_relaxed);
+  return true;
+}
+
+std::vector<std::string> PromotionBuffer::Drain() {
+  std::vector<std::string> result;
+  for (auto& stripe : stripes_) {
+    std::vector<std::string> keys;
+    {
+      std::lock_guard<std::mutex> lock(stripe->mutex);
+      keys.swap(stripe->keys);
+    }
+
+    size_.fetch_sub(keys.size(), std::memory_order_relaxed);
+    result.insert(result.end(), std::make_move_iterator(keys.begin()),
+                  std::make_move_iterator(keys.end()));
+  }
+
+  return result;
+}
+
+size_t PromotionBuffer::Size() const {
+  return size_.load(std::memory_order_relaxed);
+}
+
+size_t PromotionBuffer::Capacity() const {
+  return stripes_.size() * stripe_capacity_;
+}
+
+}  // namespace cache
+}  // namespace olp
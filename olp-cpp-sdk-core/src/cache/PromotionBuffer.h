@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace olp {
+namespace cache {
+
+/// Collects the keys of the LRU hits, so that the LRU is promoted in batches by
+/// the thread that holds the cache lock exclusively. The buffer is split into
+/// stripes with their own locks, and a thread always adds to the stripe
+/// chosen by its ID, so the hits of different threads rarely contend. A full
+/// stripe drops new keys, a lost promotion only makes the LRU order less
+/// precise.
+class PromotionBuffer {
+ public:
+  static constexpr size_t kDefaultStripeCount = 16u;
+  static constexpr size_t kDefaultStripeCapacity = 128u;
+
+  explicit PromotionBuffer(size_t stripe_count = kDefaultStripeCount,
+                           size_t stripe_capacity = kDefaultStripeCapacity);
+
+  /// Adds the key, returns false if the stripe is full and the key is dropped.
+  bool Add(const std::string& key);
+
+  /// Moves out all the buffered keys. The keys of each stripe are in the order
+  /// they were added.
+  std::vector<std::string> Drain();
+
+  /// Returns the approximate number of buffered keys.
+  size_t Size() const;
+
+  /// Returns the number of keys the buffer can hold.
+  size_t Capacity() const;
+
+ private:
+  struct Stripe {
+    std::mutex mutex;
+    std::vector<std::string> keys;
+  };
+
+  std::vector<std::unique_ptr<Stripe>> stripes_;
+  size_t stripe_capacity_;
+  std::atomic<size_t> size_;
+};
+
+}  // namespace cache
+}  // namespace olp
@@ -30,11 +30,53 @@
 namespace {
 constexpr auto kLogTag = "ProtectedKeyList";
 
+// The binary format starts with a zero byte, which can't start the legacy zero
+// separated format, followed by the format version. Each key is stored as the
+// length of the prefix shared with the previous key, the length of the rest
+// of the key and the rest of the key itself. The lengths are varints.
+constexpr unsigned char kBinaryFormatVersion = 1u;
+constexpr size_t kBinaryHeaderSize = 2u;
+
 class ReadBuffer : public std::basic_streambuf<char> {
  public:
   ReadBuffer(char* p, size_t l) { setg(p, p, p + l); }
 };
 
+void AppendVarint(std::vector<unsigned char>& value, size_t number) {
+  while (number >= 0x80u) {
+    value.emplace_back(static_cast<unsigned char>(number | 0x80u));
+    number >>= 7;
+  }
+  value.emplace_back(static_cast<unsigned char>(number));
+}
+
+bool ReadVarint(const std::vector<unsigned char>& value, size_t& offset,
+                size_t& number) {
+  number = 0u;
+  for (size_t shift = 0u; shift < sizeof(size_t) * 8u; shift += 7u) {
+    if (offset >= value.size()) {
+      return false;
+    }
+    const auto byte = value[offset++];
+    number |= static_cast<size_t>(byte & 0x7fu) << shift;
+    if ((byte & 0x80u) == 0u) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t SharedPrefixLength(const std::string& lhs, const std::string& rhs) {
+  const auto length = std::min(lhs.size(), rhs.size());
+  return std::mismatch(lhs.begin(), lhs.begin() + length, rhs.begin()).first -
+         lhs.begin();
+}
+
+bool IsBinaryFormat(const std::vector<unsigned char>& value) {
+  return value.size() >= kBinaryHeaderSize && value[0] == '\0' &&
+         value[1] == kBinaryFormatVersion;
+}
+
 }  // namespace
 
 namespace olp {
@@ -48,31 +90,71 @@ bool ProtectedKeyList::Deserialize(KeyValueCache::ValueTypePtr value) {
     return false;
   }
 
-  ReadBuffer buf(reinterpret_cast<char*>(value->data()), value->size());
-  std::istream stream(&buf);
+  if (IsBinaryFormat(*value)) {
+    if (!DeserializeBinary(*value)) {
+      protected_data_.clear();
+      return false;
+    }
+  } else {
+    ReadBuffer buf(reinterpret_cast<char*>(value->data()), value->size());
+    std::istream stream(&buf);
 
-  for (std::string str; std::getline(stream, str, '\0');) {
-    protected_data_.insert(str);
+    for (std::string str; std::getline(stream, str, '\0');) {
+      protected_data_.insert(str);
+    }
   }
+
   dirty_ = false;
   size_written_ = value->size();
   return true;
 }
 
+bool ProtectedKeyList::DeserializeBinary(
+    const std::vector<unsigned char>& value) {
+  auto hint = protected_data_.end();
+  std::string key;
+  size_t offset = kBinaryHeaderSize;
+  while (offset < value.size()) {
+    size_t shared = 0u;
+    size_t length = 0u;
+    if (!ReadVarint(value, offset, shared) ||
+        !ReadVarint(value, offset, length) || shared > key.size() ||
+        length > value.size() - offset) {
+      OLP_SDK_LOG_WARNING(kLogTag, "Deserialize: corrupted protected keys");
+      return false;
+    }
+
+    key.resize(shared);
+    key.append(reinterpret_cast<const char*>(value.data()) + offset, length);
+    offset += length;
+
+    // Keys are stored in order, so each key is inserted at the end.
+    hint = protected_data_.insert(hint, key);
+    ++hint;
+  }
+
+  return true;
+}
+
 KeyValueCache::ValueTypePtr ProtectedKeyList::Serialize() {
   auto value = std::make_shared<std::vector<unsigned char>>();
-  auto size = 0;
-  for (const auto& key : protected_data_) {
-    size += key.length() + 1;
-  }
-  if (size > 0) {
+  if (!protected_data_.empty()) {
+    // Reserve for the worst case with no shared prefixes.
+    auto size = kBinaryHeaderSize;
+    for (const auto& key : protected_data_) {
+      size += key.length() + 2u;
+    }
     value->reserve(size);
+    value->emplace_back('\0');
+    value->emplace_back(kBinaryFormatVersion);
 
+    const std::string* previous = nullptr;
     for (const auto& key : protected_data_) {
-      value->insert(value->end(), key.begin(), key.end());
-      if (key.back() != '\0') {
-        value->emplace_back('\0');
-      }
+      const auto shared = previous ? SharedPrefixLength(*previous, key) : 0u;
+      AppendVarint(*value, shared);
+      AppendVarint(*value, key.size() - shared);
+      value->insert(value->end(), key.begin() + shared, key.end());
+      previous = &key;
     }
   }
   dirty_ = false;
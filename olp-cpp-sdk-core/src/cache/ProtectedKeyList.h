@@ -21,6 +21,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include <olp/core/cache/KeyValueCache.h>
 
@@ -72,6 +73,8 @@ class ProtectedKeyList {
     }
   };
 
+  bool DeserializeBinary(const std::vector<unsigned char>& value);
+
   bool IsPrefix(const std::string& prefix, const std::string& key) const;
 
   bool IsEqualOrPrefix(const std::string& prefix, const std::string& key) const;
@@ -68,5 +68,9 @@ leveldb::Status ReadOnlyEnv::RenameFile(const std::string& /* s */,
   return {};
 }
 
+leveldb::Status ReadOnlyEnv::DeleteFile(const std::string& /* f */) {
+  return {};
+}
+
 }  // namespace cache
 }  // namespace olp
@@ -42,6 +42,9 @@ class ReadOnlyEnv : public SizeCountingEnv {
 
   leveldb::Status RenameFile(const std::string& s,
                              const std::string& t) override;
+
+  // The files may belong to another process that writes to the database.
+  leveldb::Status DeleteFile(const std::string& f) override;
 };
 
 }  // namespace cache
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/cache/RefetchCostScope.h"
+
+namespace olp {
+namespace cache {
+
+namespace {
+thread_local std::chrono::milliseconds current_cost{0};
+}  // namespace
+
+RefetchCostScope::RefetchCostScope(std::chrono::milliseconds cost)
+    : previous_cost_(current_cost) {
+  current_cost = cost;
+}
+
+RefetchCostScope::~RefetchCostScope() { current_cost = previous_cost_; }
+
+std::chrono::milliseconds RefetchCostScope::GetCurrentCost() {
+  return current_cost;
+}
+
+}  // namespace cache
+}  // namespace olp
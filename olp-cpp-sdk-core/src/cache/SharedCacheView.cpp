@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "SharedCacheView.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <leveldb/env.h>
+#include "DiskCacheEnv.h"
+#include "olp/core/logging/Log.h"
+
+namespace olp {
+namespace cache {
+
+namespace {
+constexpr auto kLogTag = "SharedCacheView";
+constexpr auto kLogSuffix = ".log";
+
+bool IsLogFile(const std::string& name) {
+  const auto suffix_length = std::char_traits<char>::length(kLogSuffix);
+  return name.size() > suffix_length &&
+         name.compare(name.size() - suffix_length, suffix_length,
+                      kLogSuffix) == 0;
+}
+
+/// The log files are numbered, the longer name has the greater number.
+bool IsNewerLog(const std::string& name, const std::string& other) {
+  return name.size() > other.size() ||
+         (name.size() == other.size() && name > other);
+}
+}  // namespace
+
+SharedCacheView::SharedCacheView(std::string path, StorageSettings settings,
+                                 std::chrono::milliseconds refresh_interval)
+    : path_{std::move(path)},
+      settings_{std::move(settings)},
+      refresh_interval_{refresh_interval},
+      next_refresh_{0} {}
+
+bool SharedCacheView::Open() {
+  std::lock_guard<std::mutex> lock(refresh_mutex_);
+  const auto next_refresh = Clock::now() + refresh_interval_;
+  next_refresh_.store(next_refresh.time_since_epoch().count());
+  return Refresh();
+}
+
+std::shared_ptr<DiskCache> SharedCacheView::Get() {
+  const auto now = Clock::now().time_since_epoch().count();
+  auto next_refresh = next_refresh_.load(std::memory_order_relaxed);
+  if (now >= next_refresh &&
+      next_refresh_.compare_exchange_strong(
+          next_refresh, now + refresh_interval_.count())) {
+    // The other readers use the current snapshot meanwhile.
+    std::unique_lock<std::mutex> lock(refresh_mutex_, std::try_to_lock);
+    if (lock.owns_lock()) {
+      Refresh();
+    }
+  }
+
+  return std::atomic_load(&cache_);
+}
+
+bool SharedCacheView::Refresh() {
+  auto stamp = ReadStamp();
+  if (stamp.empty() || stamp == stamp_) {
+    return true;
+  }
+
+  auto cache = std::make_shared<DiskCache>();
+  const auto result =
+      cache->Open(path_, path_, settings_, OpenOptions::ReadOnly);
+  if (result == OpenResult::Fail) {
+    // The writing process may have replaced the files while they were read,
+    // the next refresh tries again.
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Failed to open the shared cache %s",
+                          path_.c_str());
+    return false;
+  }
+
+  stamp_ = std::move(stamp);
+  std::atomic_store(&cache_, std::move(cache));
+  return true;
+}
+
+std::string SharedCacheView::ReadStamp() const {
+  auto* env = DiskCacheEnv::Env();
+
+  std::string stamp;
+  if (!leveldb::ReadFileToString(env, path_ + "/CURRENT", &stamp).ok() ||
+      stamp.empty()) {
+    return {};
+  }
+
+  // CURRENT holds the name of the manifest and a new line.
+  uint64_t size = 0u;
+  const auto manifest = stamp.substr(0, stamp.find('\n'));
+  if (env->GetFileSize(path_ + "/" + manifest, &size).ok()) {
+    stamp.append(std::to_string(size));
+  }
+
+  std::vector<std::string> files;
+  if (!env->GetChildren(path_, &files).ok()) {
+    return stamp;
+  }
+
+  std::string log;
+  for (const auto& file : files) {
+    if (IsLogFile(file) && IsNewerLog(file, log)) {
+      log = file;
+    }
+  }
+
+  if (!log.empty() && env->GetFileSize(path_ + "/" + log, &size).ok()) {
+    stamp.append(" ").append(log).append(" ").append(std::to_string(size));
+  }
+
+  return stamp;
+}
+
+}  // namespace cache
+}  // namespace olp
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "DiskCache.h"
+
+namespace olp {
+namespace cache {
+
+/**
+ * @brief Reads the mutable disk cache of another process.
+ *
+ * The cache is opened read-only, without the lock that the writing process
+ * holds, so the view is a snapshot of the cache at the time it is opened.
+ * Once the refresh interval passes, one of the readers compares the storage
+ * files with the ones of the snapshot and opens a new snapshot if the writing
+ * process changed them. The snapshots are replaced atomically, the readers
+ * that still use the previous one keep it until they are done.
+ */
+class SharedCacheView final {
+ public:
+  SharedCacheView(std::string path, StorageSettings settings,
+                  std::chrono::milliseconds refresh_interval);
+
+  /// Opens the first snapshot, returns false if the cache exists and cannot
+  /// be opened. A cache that does not exist yet is opened once it is created.
+  bool Open();
+
+  /// Gets the current snapshot, refreshed first if it is due. Returns null if
+  /// there is no cache to read yet.
+  std::shared_ptr<DiskCache> Get();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /// Opens a new snapshot if the storage files changed since the last one.
+  bool Refresh();
+
+  /// Identifies the state of the storage files: the current manifest, its
+  /// size and the size of the newest log. Empty if there is no cache.
+  std::string ReadStamp() const;
+
+  const std::string path_;
+  const StorageSettings settings_;
+  const Clock::duration refresh_interval_;
+  /// Accessed with the atomic functions only.
+  std::shared_ptr<DiskCache> cache_;
+  std::atomic<Clock::rep> next_refresh_;
+  /// Held by the reader that refreshes the snapshot.
+  std::mutex refresh_mutex_;
+  std::string stamp_;
+};
+
+}  // namespace cache
+}  // namespace olp
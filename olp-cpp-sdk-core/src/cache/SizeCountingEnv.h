@@ -19,16 +19,30 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 #include <leveldb/env.h>
 
 namespace olp {
 namespace cache {
 
+/// Keeps the size of the database files, so it can be read without walking
+/// the directory or asking the database.
 class SizeCountingEnv : public leveldb::EnvWrapper {
  public:
   explicit SizeCountingEnv(leveldb::Env* env) : leveldb::EnvWrapper(env) {}
 
-  virtual uint64_t Size() const { return 0; }
+  /// Gets the size of the database files.
+  uint64_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  /// Replaces the size, used to set the size of the opened database.
+  void ResetSize(uint64_t size) {
+    size_.store(size, std::memory_order_relaxed);
+  }
+
+ protected:
+  std::atomic<uint64_t> size_{0u};
 };
 
 }  // namespace cache
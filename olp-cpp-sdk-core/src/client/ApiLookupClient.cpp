@@ -45,5 +45,14 @@ CancellationToken ApiLookupClient::LookupApi(const std::string& service,
                           std::move(callback));
 }
 
+ApiLookupClient::LookupAllResponse ApiLookupClient::LookupAll(
+    CancellationContext context) {
+  return impl_->LookupAll(std::move(context));
+}
+
+CancellationToken ApiLookupClient::LookupAll(LookupAllCallback callback) {
+  return impl_->LookupAll(std::move(callback));
+}
+
 }  // namespace client
 }  // namespace olp
@@ -19,6 +19,8 @@
 
 #include "ApiLookupClientImpl.h"
 
+#include <vector>
+
 #include <olp/core/client/HRN.h>
 #include <olp/core/logging/Log.h>
 #include "client/api/PlatformApi.h"
@@ -32,6 +34,7 @@ namespace {
 constexpr auto kLogTag = "ApiLookupClientImpl";
 constexpr time_t kLookupApiDefaultExpiryTime = 3600;
 constexpr time_t kLookupApiShortExpiryTime = 300;
+constexpr size_t kCachedClientsLimit = 64u;
 
 std::string FindApi(const Apis& apis, const std::string& service,
                     const std::string& version) {
@@ -78,6 +81,20 @@ ApiLookupClient::LookupApiResponse ServiceNotAvailable() {
                   "Service/Version not available for given HRN");
 }
 
+void PreResolveHosts(const Apis& apis, const OlpClientSettings& settings) {
+  if (!settings.api_lookup_settings.pre_resolve_hosts ||
+      !settings.network_request_handler) {
+    return;
+  }
+
+  std::vector<std::string> urls;
+  urls.reserve(apis.size());
+  for (const auto& api : apis) {
+    urls.push_back(api.GetBaseUrl());
+  }
+  settings.network_request_handler->PreResolve(urls);
+}
+
 std::string ClientCacheKey(const std::string& service,
                            const std::string& service_version) {
   return service + service_version;
@@ -88,10 +105,20 @@ ApiLookupClientImpl::ApiLookupClientImpl(const HRN& catalog,
                                          const OlpClientSettings& settings)
     : catalog_(catalog),
       catalog_string_(catalog_.ToString()),
-      settings_(settings) {
+      settings_(settings),
+      cached_clients_(kCachedClientsLimit),
+      refresh_state_(std::make_shared<RefreshState>()),
+      resources_refresh_pending_(false),
+      platform_refresh_pending_(false) {
   auto provider = settings_.api_lookup_settings.lookup_endpoint_provider;
   const auto& base_url = provider(catalog_.GetPartition());
   lookup_client_ = CreateClient(base_url, settings_);
+  refresh_state_->owner = this;
+}
+
+ApiLookupClientImpl::~ApiLookupClientImpl() {
+  std::lock_guard<std::mutex> lock(refresh_state_->mutex);
+  refresh_state_->owner = nullptr;
 }
 
 ApiLookupClient::LookupApiResponse ApiLookupClientImpl::LookupApi(
@@ -109,6 +136,11 @@ ApiLookupClient::LookupApiResponse ApiLookupClientImpl::LookupApi(
     } else if (options == CacheOnly) {
       return NotFoundInCacheError();
     }
+
+    client = GetStaleClient(service, service_version);
+    if (client) {
+      return *client;
+    }
   }
 
   PlatformApi::ApisResponse api_response;
@@ -128,6 +160,8 @@ ApiLookupClient::LookupApiResponse ApiLookupClientImpl::LookupApi(
   }
 
   const auto& api_result = api_response.GetResult();
+  PreResolveHosts(api_result.first, settings_);
+
   if (options != OnlineOnly && options != CacheWithUpdate) {
     PutToDiskCache(api_result);
   }
@@ -170,6 +204,12 @@ CancellationToken ApiLookupClientImpl::LookupApi(
       callback(NotFoundInCacheError());
       return CancellationToken();
     }
+
+    client = GetStaleClient(service, service_version);
+    if (client) {
+      callback(*client);
+      return CancellationToken();
+    }
   }
 
   PlatformApi::ApisCallback lookup_callback =
@@ -184,6 +224,8 @@ CancellationToken ApiLookupClientImpl::LookupApi(
     }
 
     const auto& api_result = response.GetResult();
+    PreResolveHosts(api_result.first, settings_);
+
     if (options != OnlineOnly && options != CacheWithUpdate) {
       PutToDiskCache(api_result);
     }
@@ -214,42 +256,100 @@ CancellationToken ApiLookupClientImpl::LookupApi(
                                lookup_callback);
 }
 
-OlpClient ApiLookupClientImpl::CreateAndCacheClient(
-    const std::string& base_url, const std::string& cache_key,
-    boost::optional<time_t> expiration) {
-  std::lock_guard<std::mutex> lock(cached_clients_mutex_);
-  ClientWithExpiration& client_with_expiration = cached_clients_[cache_key];
+ApiLookupClient::LookupAllResponse ApiLookupClientImpl::LookupAll(
+    CancellationContext context) {
+  if (!GetStaticUrl(catalog_, settings_).GetBaseUrl().empty()) {
+    return Apis{};
+  }
 
-  const auto current_base_url = client_with_expiration.client.GetBaseUrl();
-  if (current_base_url.empty()) {
-    client_with_expiration.client.SetSettings(settings_);
+  auto api_response =
+      ResourcesApi::GetApis(lookup_client_, catalog_string_, context);
+  if (!api_response.IsSuccessful()) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "LookupAll() unsuccessful, hrn='%s', error='%s'",
+                          catalog_string_.c_str(),
+                          api_response.GetError().GetMessage().c_str());
+    return api_response.GetError();
+  }
+
+  return CacheAll(api_response.GetResult());
+}
+
+CancellationToken ApiLookupClientImpl::LookupAll(
+    ApiLookupClient::LookupAllCallback callback) {
+  if (!GetStaticUrl(catalog_, settings_).GetBaseUrl().empty()) {
+    callback(Apis{});
+    return CancellationToken();
   }
-  if (current_base_url != base_url) {
-    client_with_expiration.client.SetBaseUrl(base_url);
+
+  return ResourcesApi::GetApis(
+      lookup_client_, catalog_string_,
+      [=](ResourcesApi::ApisResponse response) {
+        if (!response.IsSuccessful()) {
+          OLP_SDK_LOG_WARNING_F(
+              kLogTag, "LookupAll() unsuccessful, hrn='%s', error='%s'",
+              catalog_string_.c_str(),
+              response.GetError().GetMessage().c_str());
+          callback(response.GetError());
+          return;
+        }
+
+        callback(CacheAll(response.GetResult()));
+      });
+}
+
+ApiLookupClient::LookupAllResponse ApiLookupClientImpl::CacheAll(
+    const ApisResult& apis_result) {
+  const auto& apis = apis_result.first;
+  PreResolveHosts(apis, settings_);
+
+  for (const auto& api : apis) {
+    CreateAndCacheClient(api.GetBaseUrl(),
+                         ClientCacheKey(api.GetApi(), api.GetVersion()),
+                         apis_result.second);
   }
+  PutToDiskCache(apis_result);
 
-  client_with_expiration.expire_at =
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Cached %zu services, hrn='%s'", apis.size(),
+                      catalog_string_.c_str());
+  return apis;
+}
+
+OlpClient ApiLookupClientImpl::CreateAndCacheClient(
+    const std::string& base_url, const std::string& cache_key,
+    boost::optional<time_t> expiration) {
+  const auto expire_at =
       std::chrono::steady_clock::now() +
       std::chrono::seconds(expiration.value_or(kLookupApiDefaultExpiryTime));
-  return client_with_expiration.client;
+
+  return cached_clients_
+      .Update(cache_key,
+              [&](ClientWithExpiration& client_with_expiration) {
+                auto& client = client_with_expiration.client;
+                const auto current_base_url = client.GetBaseUrl();
+                if (current_base_url.empty()) {
+                  client.SetSettings(settings_);
+                }
+                if (current_base_url != base_url) {
+                  client.SetBaseUrl(base_url);
+                }
+                client_with_expiration.expire_at = expire_at;
+              })
+      .client;
 }
 
 boost::optional<OlpClient> ApiLookupClientImpl::GetCachedClient(
     const std::string& service, const std::string& service_version) {
   const std::string key = ClientCacheKey(service, service_version);
 
-  {
-    std::lock_guard<std::mutex> lock(cached_clients_mutex_);
-    const auto client_it = cached_clients_.find(key);
-    if (client_it != cached_clients_.end()) {
-      const ClientWithExpiration& client_with_expiration = client_it->second;
-      if (client_with_expiration.expire_at > std::chrono::steady_clock::now()) {
-        OLP_SDK_LOG_DEBUG_F(
-            kLogTag, "LookupApi(%s/%s) found in client cache, hrn='%s'",
-            service.c_str(), service_version.c_str(), catalog_string_.c_str());
-        return client_with_expiration.client;
-      }
-    }
+  const auto client_with_expiration = cached_clients_.Find(key);
+  if (client_with_expiration &&
+      client_with_expiration->expire_at > std::chrono::steady_clock::now()) {
+    OLP_SDK_LOG_DEBUG_F(kLogTag,
+                        "LookupApi(%s/%s) found in client cache, hrn='%s'",
+                        service.c_str(), service_version.c_str(),
+                        catalog_string_.c_str());
+    return client_with_expiration->client;
   }
 
   repository::ApiCacheRepository cache_repository_(catalog_, settings_.cache);
@@ -272,6 +372,69 @@ boost::optional<OlpClient> ApiLookupClientImpl::GetCachedClient(
   return CreateAndCacheClient(*base_url, key, kLookupApiShortExpiryTime);
 }
 
+boost::optional<OlpClient> ApiLookupClientImpl::GetStaleClient(
+    const std::string& service, const std::string& service_version) {
+  if (settings_.max_staleness.count() <= 0) {
+    return boost::none;
+  }
+
+  const auto client_with_expiration =
+      cached_clients_.Find(ClientCacheKey(service, service_version));
+  if (!client_with_expiration ||
+      client_with_expiration->expire_at + settings_.max_staleness <
+          std::chrono::steady_clock::now()) {
+    return boost::none;
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag,
+                      "LookupApi(%s/%s) found expired client, refreshing, "
+                      "hrn='%s'",
+                      service.c_str(), service_version.c_str(),
+                      catalog_string_.c_str());
+  RefreshInBackground(service);
+  return client_with_expiration->client;
+}
+
+void ApiLookupClientImpl::RefreshInBackground(const std::string& service) {
+  // The config service is a platform API, the others are the catalog APIs.
+  const bool platform = service == "config";
+  auto& pending =
+      platform ? platform_refresh_pending_ : resources_refresh_pending_;
+  if (pending.exchange(true)) {
+    return;
+  }
+
+  auto refresh_state = refresh_state_;
+  PlatformApi::ApisCallback callback =
+      [refresh_state, platform](PlatformApi::ApisResponse response) {
+        std::lock_guard<std::mutex> lock(refresh_state->mutex);
+        auto owner = refresh_state->owner;
+        if (!owner) {
+          return;
+        }
+
+        auto& pending = platform ? owner->platform_refresh_pending_
+                                 : owner->resources_refresh_pending_;
+        pending.store(false);
+
+        if (!response.IsSuccessful()) {
+          OLP_SDK_LOG_WARNING_F(
+              kLogTag, "Background refresh unsuccessful, hrn='%s', error='%s'",
+              owner->catalog_string_.c_str(),
+              response.GetError().GetMessage().c_str());
+          return;
+        }
+
+        owner->CacheAll(response.GetResult());
+      };
+
+  if (platform) {
+    PlatformApi::GetApis(lookup_client_, callback);
+  } else {
+    ResourcesApi::GetApis(lookup_client_, catalog_string_, callback);
+  }
+}
+
 void ApiLookupClientImpl::PutToDiskCache(const ApisResult& available_services) {
   repository::ApiCacheRepository cache_repository_(catalog_, settings_.cache);
   for (const auto& service_api : available_services.first) {
@@ -19,8 +19,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiLookupClient.h>
@@ -31,6 +33,7 @@
 #include <olp/core/client/OlpClient.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/client/model/Api.h>
+#include <olp/core/utils/ConcurrentLruCache.h>
 
 namespace olp {
 namespace client {
@@ -39,6 +42,8 @@ class ApiLookupClientImpl {
  public:
   ApiLookupClientImpl(const HRN& catalog, const OlpClientSettings& settings);
 
+  ~ApiLookupClientImpl();
+
   ApiLookupClient::LookupApiResponse LookupApi(
       const std::string& service, const std::string& service_version,
       FetchOptions options, CancellationContext context);
@@ -48,6 +53,10 @@ class ApiLookupClientImpl {
                               FetchOptions options,
                               ApiLookupClient::LookupApiCallback callback);
 
+  ApiLookupClient::LookupAllResponse LookupAll(CancellationContext context);
+
+  CancellationToken LookupAll(ApiLookupClient::LookupAllCallback callback);
+
  protected:
   using ApisResult = std::pair<Apis, boost::optional<time_t>>;
 
@@ -63,15 +72,35 @@ class ApiLookupClientImpl {
   boost::optional<OlpClient> GetCachedClient(
       const std::string& service, const std::string& service_version);
 
+  /// Gets the client that expired less than `max_staleness` ago, and starts
+  /// the refresh of the APIs in the background.
+  boost::optional<OlpClient> GetStaleClient(const std::string& service,
+                                            const std::string& service_version);
+
+  void RefreshInBackground(const std::string& service);
+
   void PutToDiskCache(const ApisResult& available_services);
 
+  /// Stores the clients of all the services in the cache and returns them.
+  ApiLookupClient::LookupAllResponse CacheAll(const ApisResult& apis_result);
+
   const HRN& catalog_;
   const std::string catalog_string_;
   const OlpClientSettings& settings_;
   OlpClient lookup_client_;
 
-  std::mutex cached_clients_mutex_;
-  std::unordered_map<std::string, ClientWithExpiration> cached_clients_;
+  utils::ConcurrentLruCache<std::string, ClientWithExpiration> cached_clients_;
+
+  /// Lets the background refresh outlive the client: the callback uses the
+  /// client under the mutex only if the owner is still set.
+  struct RefreshState {
+    std::mutex mutex;
+    ApiLookupClientImpl* owner;
+  };
+
+  std::shared_ptr<RefreshState> refresh_state_;
+  std::atomic<bool> resources_refresh_pending_;
+  std::atomic<bool> platform_refresh_pending_;
 };
 
 }  // namespace client
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "DataCallbackStream.h"
+
+#include <utility>
+
+namespace olp {
+namespace client {
+
+DataCallbackStream::DataCallbackStream(http::Network::DataCallback callback)
+    : std::ostream(nullptr), buffer_(std::move(callback)) {
+  rdbuf(&buffer_);
+}
+
+DataCallbackStream::~DataCallbackStream() = default;
+
+DataCallbackStream::Buffer::Buffer(http::Network::DataCallback callback)
+    : callback_{std::move(callback)}, position_{0u} {}
+
+DataCallbackStream::Buffer::int_type DataCallbackStream::Buffer::overflow(
+    int_type c) {
+  if (traits_type::eq_int_type(c, traits_type::eof())) {
+    return traits_type::not_eof(c);
+  }
+
+  const auto value = traits_type::to_char_type(c);
+  return xsputn(&value, 1) == 1 ? c : traits_type::eof();
+}
+
+std::streamsize DataCallbackStream::Buffer::xsputn(const char* s,
+                                                   std::streamsize n) {
+  if (n <= 0) {
+    return 0;
+  }
+
+  const auto size = static_cast<size_t>(n);
+  if (callback_) {
+    callback_(reinterpret_cast<const std::uint8_t*>(s), position_, size);
+  }
+  position_ += size;
+  return n;
+}
+
+DataCallbackStream::Buffer::pos_type DataCallbackStream::Buffer::seekoff(
+    off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+  // The passed data is not kept, so the end is the current position.
+  if (dir == std::ios_base::beg) {
+    return seekpos(pos_type(off), which);
+  }
+  return seekpos(pos_type(static_cast<off_type>(position_) + off), which);
+}
+
+DataCallbackStream::Buffer::pos_type DataCallbackStream::Buffer::seekpos(
+    pos_type pos, std::ios_base::openmode which) {
+  const auto offset = static_cast<off_type>(pos);
+  if (!(which & std::ios_base::out) || offset < 0) {
+    return pos_type(off_type(-1));
+  }
+
+  // The backends seek back to the start when a request is restarted, the
+  // callback receives the data again from that offset.
+  position_ = static_cast<uint64_t>(offset);
+  return pos;
+}
+
+}  // namespace client
+}  // namespace olp
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+
+#include <olp/core/http/Network.h>
+
+namespace olp {
+namespace client {
+
+/// The output stream that passes the response body to a data callback
+/// instead of keeping it, so the body can be processed as it arrives.
+class DataCallbackStream : public std::ostream {
+ public:
+  explicit DataCallbackStream(http::Network::DataCallback callback);
+  ~DataCallbackStream() override;
+
+ private:
+  class Buffer : public std::streambuf {
+   public:
+    explicit Buffer(http::Network::DataCallback callback);
+
+   protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+   private:
+    http::Network::DataCallback callback_;
+    uint64_t position_;
+  };
+
+  Buffer buffer_;
+};
+
+}  // namespace client
+}  // namespace olp
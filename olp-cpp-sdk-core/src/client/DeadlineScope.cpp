@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/client/DeadlineScope.h"
+
+#include <algorithm>
+
+namespace olp {
+namespace client {
+
+namespace {
+thread_local DeadlineScope::Clock::time_point current_deadline =
+    DeadlineScope::Clock::time_point::max();
+}  // namespace
+
+DeadlineScope::DeadlineScope(Clock::time_point deadline)
+    : previous_deadline_(current_deadline) {
+  current_deadline = std::min(current_deadline, deadline);
+}
+
+DeadlineScope::~DeadlineScope() { current_deadline = previous_deadline_; }
+
+DeadlineScope::Clock::time_point DeadlineScope::GetCurrentDeadline() {
+  return current_deadline;
+}
+
+}  // namespace client
+}  // namespace olp
@@ -19,7 +19,7 @@
 
 #include "olp/core/client/HRN.h"
 
-#include <sstream>
+#include <functional>
 
 #include <olp/core/logging/Log.h>
 #include <olp/core/porting/make_unique.h>
@@ -31,6 +31,8 @@ constexpr auto kDataTag = "data";
 constexpr auto kPipelineTag = "pipeline";
 constexpr auto kSchemaTag = "schema";
 constexpr auto kHrnTag = "hrn:";
+constexpr size_t kHrnTagSize = 4u;
+constexpr size_t kMaxSeparatorsCount = 8u;
 constexpr char kSeparator = ':';
 }  // namespace
 
@@ -38,48 +40,80 @@ namespace olp {
 namespace client {
 
 std::string HRN::ToString() const {
-  std::ostringstream ret;
-  const auto generic_part =
-      kSeparator + region_ + kSeparator + account_ + kSeparator;
-  ret << kHrnTag << partition_ << kSeparator;
+  return string_.empty() ? BuildString() : string_;
+}
+
+std::string HRN::ToCatalogHRNString() const {
+  if (service_ != ServiceType::Data) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "ToCatalogHRNString: ServiceType != Data");
+    return {};
+  }
+
+  return catalog_string_;
+}
+
+std::string HRN::BuildString() const {
+  std::string ret;
+  ret.reserve(kHrnTagSize + partition_.size() + region_.size() +
+              account_.size() + catalog_id_.size() + layer_id_.size() +
+              group_id_.size() + schema_name_.size() + version_.size() +
+              pipeline_id_.size() + kMaxSeparatorsCount);
+
+  ret.append(kHrnTag).append(partition_).append(1, kSeparator);
+  switch (service_) {
+    case ServiceType::Data:
+      ret.append(kDataTag);
+      break;
+    case ServiceType::Schema:
+      ret.append(kSchemaTag);
+      break;
+    case ServiceType::Pipeline:
+      ret.append(kPipelineTag);
+      break;
+    default:
+      break;
+  }
+
+  ret.append(1, kSeparator).append(region_).append(1, kSeparator);
+  ret.append(account_).append(1, kSeparator);
 
   switch (service_) {
     case ServiceType::Data: {
-      ret << kDataTag << generic_part << catalog_id_;
+      ret.append(catalog_id_);
       if (!layer_id_.empty()) {
-        ret << kSeparator << layer_id_;
+        ret.append(1, kSeparator).append(layer_id_);
       }
       break;
     }
     case ServiceType::Schema: {
-      ret << kSchemaTag << generic_part << group_id_ << kSeparator
-          << schema_name_ << kSeparator << version_;
+      ret.append(group_id_).append(1, kSeparator).append(schema_name_);
+      ret.append(1, kSeparator).append(version_);
       break;
     }
     case ServiceType::Pipeline: {
-      ret << kPipelineTag << generic_part << pipeline_id_;
+      ret.append(pipeline_id_);
       break;
     }
-    default: {
-      ret << generic_part;
+    default:
       break;
-    }
   }
 
-  return ret.str();
+  return ret;
 }
 
-std::string HRN::ToCatalogHRNString() const {
-  if (service_ != ServiceType::Data) {
-    OLP_SDK_LOG_WARNING_F(kLogTag, "ToCatalogHRNString: ServiceType != Data");
-    return {};
+HRN::HRN(const std::string& input) {
+  Parse(input);
+
+  string_ = BuildString();
+  hash_ = std::hash<std::string>()(string_);
+  if (service_ == ServiceType::Data) {
+    // The catalog string is the string form without the layer ID.
+    catalog_string_ = string_.substr(
+        0, string_.size() - (layer_id_.empty() ? 0u : layer_id_.size() + 1u));
   }
-
-  return kHrnTag + partition_ + kSeparator + kDataTag + kSeparator + region_ +
-         kSeparator + account_ + kSeparator + catalog_id_;
 }
 
-HRN::HRN(const std::string& input) {
+void HRN::Parse(const std::string& input) {
   Tokenizer tokenizer(input, kSeparator);
 
   // Must start with "hrn:"
@@ -153,6 +187,12 @@ HRN::HRN(const std::string& input) {
 }
 
 bool HRN::operator==(const HRN& rhs) const {
+  // The equal HRNs have the same hash, so most of the different ones are
+  // rejected without comparing the fields.
+  if (hash_ != rhs.hash_) {
+    return false;
+  }
+
   // Common sections need to match for all types
   if (partition_ != rhs.partition_ || service_ != rhs.service_ ||
       region_ != rhs.region_ || account_ != rhs.account_) {
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/client/MemoryBudget.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace olp {
+namespace client {
+
+MemoryBudget::MemoryBudget(uint64_t limit)
+    : limit_{limit},
+      usage_{0u},
+      pressure_{MemoryPressure::kNone},
+      next_id_{0u} {}
+
+uint64_t MemoryBudget::GetLimit() const { return limit_; }
+
+uint64_t MemoryBudget::GetUsage() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return usage_;
+}
+
+MemoryPressure MemoryBudget::GetPressure() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pressure_;
+}
+
+void MemoryBudget::Reserve(uint64_t bytes) {
+  MemoryPressure pressure;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    usage_ += bytes;
+    pressure = ComputePressure();
+  }
+  Update(pressure, false);
+}
+
+void MemoryBudget::Release(uint64_t bytes) {
+  MemoryPressure pressure;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    usage_ -= std::min(usage_, bytes);
+    pressure = ComputePressure();
+  }
+  Update(pressure, false);
+}
+
+MemoryBudget::ConsumerId MemoryBudget::Register(PressureCallback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto id = next_id_++;
+  consumers_.emplace(id, std::move(callback));
+  return id;
+}
+
+void MemoryBudget::Unregister(ConsumerId id) {
+  std::lock_guard<std::recursive_mutex> notify_lock(notify_mutex_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  consumers_.erase(id);
+}
+
+void MemoryBudget::OnLowMemory() { Update(MemoryPressure::kCritical, true); }
+
+MemoryPressure MemoryBudget::ComputePressure() const {
+  if (limit_ == 0u) {
+    return MemoryPressure::kNone;
+  }
+  if (usage_ >= limit_) {
+    return MemoryPressure::kCritical;
+  }
+  // Compare in the integer space: usage >= 0.75 * limit.
+  if (usage_ >= limit_ - limit_ / 4u) {
+    return MemoryPressure::kModerate;
+  }
+  return MemoryPressure::kNone;
+}
+
+void MemoryBudget::Update(MemoryPressure pressure, bool force) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pressure_ == pressure && !force) {
+      return;
+    }
+    pressure_ = pressure;
+  }
+
+  std::lock_guard<std::recursive_mutex> notify_lock(notify_mutex_);
+  std::vector<PressureCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Another thread could change the pressure meanwhile, the consumers
+    // always receive the latest one.
+    pressure = pressure_;
+    callbacks.reserve(consumers_.size());
+    for (const auto& consumer : consumers_) {
+      callbacks.push_back(consumer.second);
+    }
+  }
+
+  for (const auto& callback : callbacks) {
+    callback(pressure);
+  }
+}
+
+}  // namespace client
+}  // namespace olp
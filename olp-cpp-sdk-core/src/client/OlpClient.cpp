@@ -19,25 +19,53 @@
 
 #include "olp/core/client/OlpClient.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <chrono>
+#include <condition_variable>
 #include <future>
+#include <mutex>
 #include <sstream>
 #include <thread>
+#include <vector>
 
+#include "DataCallbackStream.h"
 #include "PendingUrlRequests.h"
+#include "ResponseBufferStream.h"
 #include "olp/core/client/Condition.h"
+#include "olp/core/client/DeadlineScope.h"
 #include "olp/core/client/ErrorCode.h"
+#include "olp/core/client/MemoryBudget.h"
+#include "olp/core/client/RetryBudget.h"
+#include "olp/core/client/Tracer.h"
 #include "olp/core/http/HttpStatusCode.h"
 #include "olp/core/http/NetworkConstants.h"
+#include "olp/core/http/RequestPriorityScope.h"
 #include "olp/core/logging/Log.h"
 #include "olp/core/porting/shared_mutex.h"
 #include "olp/core/thread/Atomic.h"
+#include "olp/core/thread/TaskComponentScope.h"
+#include "olp/core/thread/TaskScheduler.h"
 #include "olp/core/utils/Url.h"
 
 namespace {
 constexpr auto kLogTag = "OlpClient";
 constexpr auto kApiKeyParam = "apiKey=";
+constexpr auto kContentLengthHeader = "Content-Length";
+constexpr auto kContentRangeHeader = "Content-Range";
+constexpr auto kRangeHeader = "Range";
+constexpr auto kIfRangeHeader = "If-Range";
+constexpr auto kETagHeader = "ETag";
+constexpr auto kLastModifiedHeader = "Last-Modified";
+constexpr auto kIfMatchHeader = "If-Match";
+constexpr auto kIfUnmodifiedSinceHeader = "If-Unmodified-Since";
+constexpr size_t kMaxParallelChunks = 4u;
+constexpr size_t kMaxChunkedDownloads = 2u;
+constexpr size_t kMinFirstByteSamples = 20u;
+constexpr size_t kMaxFirstByteSamples = 100u;
 
 struct RequestSettings {
   explicit RequestSettings(const int initial_backdown_period_ms,
@@ -94,6 +122,20 @@ bool StatusSuccess(int status) {
   return status >= 0 && status < http::HttpStatusCode::BAD_REQUEST;
 }
 
+/// Returns true if the host failed to serve the request, such failures open
+/// its circuit breaker.
+bool IsHostFailure(int status) {
+  return status == http::HttpStatusCode::TOO_MANY_REQUESTS ||
+         status >= http::HttpStatusCode::INTERNAL_SERVER_ERROR ||
+         status == static_cast<int>(http::ErrorCode::IO_ERROR) ||
+         status == static_cast<int>(http::ErrorCode::TIMEOUT_ERROR);
+}
+
+HttpResponse CircuitOpenResponse() {
+  return {http::HttpStatusCode::SERVICE_UNAVAILABLE,
+          "Circuit breaker is open, the host is failing."};
+}
+
 bool CaseInsensitiveCompare(const std::string& str1, const std::string& str2) {
   return (str1.size() == str2.size()) &&
          std::equal(str1.begin(), str1.end(), str2.begin(),
@@ -103,6 +145,128 @@ bool CaseInsensitiveCompare(const std::string& str1, const std::string& str2) {
                     });
 }
 
+const std::string* FindHeader(const http::Headers& headers,
+                              const std::string& name) {
+  auto it = std::find_if(headers.begin(), headers.end(),
+                         [&](const http::Header& header) {
+                           return CaseInsensitiveCompare(header.first, name);
+                         });
+  return it != headers.end() ? &it->second : nullptr;
+}
+
+/// The part of the body requested by a download, the last byte is included.
+struct ByteRange {
+  uint64_t first;
+  boost::optional<uint64_t> last;
+};
+
+bool IsDownload(const http::NetworkRequest& request) {
+  return request.GetVerb() == http::NetworkRequest::HttpVerb::GET &&
+         !FindHeader(request.GetHeaders(), kRangeHeader);
+}
+
+std::string FormatRange(uint64_t first, boost::optional<uint64_t> last) {
+  auto range = "bytes=" + std::to_string(first) + "-";
+  if (last) {
+    range += std::to_string(*last);
+  }
+  return range;
+}
+
+/// Returns the first byte of the received body, which is 0 for the responses
+/// without the `Content-Range` header, and the total size of the resource
+/// if the server reports it.
+uint64_t GetBodyOffset(const http::Headers& headers,
+                       uint64_t* total = nullptr) {
+  // Content-Range: bytes <first>-<last>/<total or *>
+  const auto* content_range = FindHeader(headers, kContentRangeHeader);
+  if (!content_range || content_range->compare(0, 6, "bytes ") != 0) {
+    return 0u;
+  }
+
+  const char* begin = content_range->c_str() + 6;
+  char* end = nullptr;
+  const auto first = std::strtoull(begin, &end, 10);
+  if (total) {
+    const auto* slash = std::strchr(end, '/');
+    *total = slash ? std::strtoull(slash + 1, nullptr, 10) : 0u;
+  }
+  return end != begin ? first : 0u;
+}
+
+/// Keeps the body received by the interrupted attempts of a download.
+class DownloadProgress {
+ public:
+  explicit DownloadProgress(ByteRange range)
+      : range_{range},
+        received_{std::make_shared<std::vector<unsigned char>>()} {}
+
+  /// Adds the range of the missing bytes to the next attempt.
+  void PrepareRequest(http::NetworkRequest& request) const {
+    const auto first = range_.first + received_->size();
+    if (first > 0u || range_.last) {
+      request.WithHeader(kRangeHeader, FormatRange(first, range_.last));
+    }
+    if (!received_->empty() && !validator_.empty()) {
+      request.WithHeader(kIfRangeHeader, validator_);
+    }
+  }
+
+  /// Keeps the body of the interrupted attempt, returns true if it continues
+  /// the download.
+  bool Interrupted(const http::Headers& headers, ResponseBufferStream& stream) {
+    auto body = stream.ReleaseBuffer();
+    if (!body || body->empty()) {
+      return false;
+    }
+
+    const auto offset = GetBodyOffset(headers);
+    if (offset == range_.first + received_->size()) {
+      received_->insert(received_->end(), body->begin(), body->end());
+    } else if (offset == range_.first) {
+      received_ = std::move(body);
+    } else {
+      received_->clear();
+      return false;
+    }
+
+    const auto* validator = FindHeader(headers, kETagHeader);
+    if (!validator) {
+      validator = FindHeader(headers, kLastModifiedHeader);
+    }
+    validator_ = validator ? *validator : std::string();
+    return true;
+  }
+
+  /// Prepends the bytes received before to the successful response.
+  HttpResponse Complete(HttpResponse response) const {
+    auto body = response.GetResponseBuffer();
+    if (received_->empty() ||
+        GetBodyOffset(response.GetHeaders()) !=
+            range_.first + received_->size()) {
+      // The server sent the requested range from the beginning.
+      return response;
+    }
+
+    auto result = std::make_shared<std::vector<unsigned char>>();
+    result->reserve(received_->size() + body->size());
+    result->insert(result->end(), received_->begin(), received_->end());
+    result->insert(result->end(), body->begin(), body->end());
+
+    const auto status = range_.first > 0u || range_.last
+                            ? http::HttpStatusCode::PARTIAL_CONTENT
+                            : http::HttpStatusCode::OK;
+    HttpResponse complete{status, std::move(result), response.GetHeaders()};
+    complete.SetNetworkStatistics(response.GetNetworkStatistics());
+    return complete;
+  }
+
+ private:
+  ByteRange range_;
+  ResponseBufferStream::BufferType received_;
+  std::string validator_;
+};
+
 RequestSettingsPtr GetRequestSettings(const RetrySettings& retry_settings) {
   return std::make_shared<RequestSettings>(
       retry_settings.initial_backdown_period, retry_settings.timeout);
@@ -172,17 +336,48 @@ void ExecuteSingleRequest(const std::shared_ptr<http::Network>& network,
   pending_request->ExecuteOrCancelled(make_request, cancelled_func);
 }
 
+std::string GetPendingKey(const http::NetworkRequest& request) {
+  // The registry may be shared by the clients with different credentials, so
+  // the requests are only merged when they are sent with the same token.
+  auto key = request.GetUrl();
+  const auto& headers = request.GetHeaders();
+  auto it = std::find_if(headers.begin(), headers.end(),
+                         [](const http::Header& header) {
+                           return header.first == http::kAuthorizationHeader;
+                         });
+  if (it != headers.end()) {
+    key.append("\n").append(it->second);
+  }
+  return key;
+}
+
 NetworkCallbackType GetRetryCallback(
     bool merge, const RequestSettingsPtr& settings,
     const RetrySettings& retry_settings,
     const std::shared_ptr<http::Network>& network,
+    const std::shared_ptr<thread::TaskScheduler>& task_scheduler,
     const PendingUrlRequestsPtr& pending_requests,
     const PendingUrlRequestPtr& pending_request,
     const NetworkRequestPtr& request) {
   return [=](const http::RequestId request_id, HttpResponse response) mutable {
     ++settings->current_try;
 
-    if (CheckRetryCondition(*settings, retry_settings, response)) {
+    auto complete = [=](HttpResponse response) {
+      if (merge) {
+        pending_requests->OnRequestCompleted(
+            request_id, GetPendingKey(*request), std::move(response));
+      } else {
+        pending_request->OnRequestCompleted(std::move(response));
+      }
+    };
+
+    const auto& retry_budget = retry_settings.retry_budget;
+    if (retry_budget && !pending_request->IsCancelled()) {
+      retry_budget->OnResult(request->GetUrl(), IsHostFailure(response.status));
+    }
+
+    if (CheckRetryCondition(*settings, retry_settings, response) ||
+        (retry_budget && !retry_budget->TryRetry())) {
       // Response is either successull or retries count/time expired
       if (pending_request->GetRequestId() != request_id) {
         OLP_SDK_LOG_WARNING_F(
@@ -193,41 +388,43 @@ NetworkCallbackType GetRetryCallback(
         return;
       }
 
-      if (merge) {
-        const auto& url = request->GetUrl();
-        pending_requests->OnRequestCompleted(request_id, url,
-                                             std::move(response));
-      } else {
-        pending_request->OnRequestCompleted(std::move(response));
-      }
+      complete(std::move(response));
       return;
     }
 
-    const auto start = std::chrono::steady_clock::now();
-
-    // TODO: Do not block thread but instead implement an event queue that will
-    // trigger next retry once the time expired!
     const auto actual_wait_time =
         std::min(settings->current_backdown_period,
                  settings->max_wait_time - settings->accumulated_wait_time);
-    std::this_thread::sleep_for(actual_wait_time);
-
     settings->accumulated_wait_time += actual_wait_time;
     settings->current_backdown_period =
         CalculateNextWaitTime(retry_settings, settings->current_try);
 
-    OLP_SDK_LOG_DEBUG(
-        kLogTag, "retry_callback - retrigger after sleep, actual_wait_time="
-                     << actual_wait_time.count() << "ms, slept="
-                     << std::chrono::duration_cast<std::chrono::milliseconds>(
-                            std::chrono::steady_clock::now() - start)
-                            .count()
-                     << "ms");
-
-    ExecuteSingleRequest(
-        network, pending_request, *request,
-        GetRetryCallback(merge, settings, retry_settings, network,
-                         pending_requests, pending_request, request));
+    auto retry = [=]() {
+      if (retry_budget && !retry_budget->AllowRequest(request->GetUrl())) {
+        complete(CircuitOpenResponse());
+        return;
+      }
+
+      ExecuteSingleRequest(
+          network, pending_request, *request,
+          GetRetryCallback(merge, settings, retry_settings, network,
+                           task_scheduler, pending_requests, pending_request,
+                           request));
+    };
+
+    OLP_SDK_LOG_DEBUG(kLogTag, "retry_callback - retrigger after "
+                                   << actual_wait_time.count() << "ms");
+
+    if (task_scheduler) {
+      // The backdown does not block a thread, the retry is scheduled instead.
+      thread::TaskComponentScope component_scope("OlpClient");
+      task_scheduler->ScheduleTaskAfter(std::move(retry), actual_wait_time,
+                                        request->GetPriority());
+      return;
+    }
+
+    std::this_thread::sleep_for(actual_wait_time);
+    retry();
   };
 }
 
@@ -251,56 +448,293 @@ http::NetworkRequest::HttpVerb GetHttpVerb(const std::string& verb) {
   return http::NetworkRequest::HttpVerb::GET;
 }
 
+/// Keeps the recent times to the first response byte, used to compute the
+/// delay after which a stalled request is hedged.
+class FirstByteTimes {
+ public:
+  void Add(std::chrono::milliseconds time) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (times_.size() < kMaxFirstByteSamples) {
+      times_.push_back(time);
+    } else {
+      times_[next_] = time;
+    }
+    next_ = (next_ + 1u) % kMaxFirstByteSamples;
+  }
+
+  /// Returns the percentile of the recent times, or `boost::none` while there
+  /// are too few of them.
+  boost::optional<std::chrono::milliseconds> Percentile(
+      unsigned int percentile) const {
+    std::vector<std::chrono::milliseconds> times;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (times_.size() < kMinFirstByteSamples) {
+        return boost::none;
+      }
+      times = times_;
+    }
+
+    const auto index =
+        std::min<size_t>(times.size() * percentile / 100u, times.size() - 1u);
+    std::nth_element(times.begin(), times.begin() + index, times.end());
+    return times[index];
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::chrono::milliseconds> times_;
+  size_t next_{0u};
+};
+
+/// Returns the delay after which the request is sent once more if no response
+/// byte arrived, or `boost::none` if the request is not hedged.
+boost::optional<std::chrono::milliseconds> GetHedgeDelay(
+    const http::NetworkRequest& request, const RetrySettings& retry_settings,
+    const FirstByteTimes* first_byte_times,
+    const MemoryBudget* memory_budget) {
+  if (!first_byte_times ||
+      request.GetVerb() != http::NetworkRequest::HttpVerb::GET) {
+    return boost::none;
+  }
+
+  // The hedged request needs one more response buffer.
+  if (memory_budget &&
+      memory_budget->GetPressure() != MemoryPressure::kNone) {
+    return boost::none;
+  }
+
+  auto delay = first_byte_times->Percentile(retry_settings.hedge_percentile);
+  if (!delay) {
+    return boost::none;
+  }
+  return std::max(*delay,
+                  std::chrono::milliseconds(retry_settings.min_hedge_delay));
+}
+
+/// Keeps a sent request registered with the priority handle of the thread,
+/// so it can be promoted while it waits in the network queue.
+class PriorityRegistration final {
+ public:
+  PriorityRegistration(std::shared_ptr<http::Network> network,
+                       const http::NetworkRequest& request, http::RequestId id)
+      : handle_(http::RequestPriorityScope::GetCurrentHandle()) {
+    if (handle_) {
+      key_ = handle_->AddRequest(std::move(network), id,
+                                 request.GetPriority());
+    }
+  }
+
+  ~PriorityRegistration() {
+    if (handle_) {
+      handle_->RemoveRequest(key_);
+    }
+  }
+
+  PriorityRegistration(const PriorityRegistration&) = delete;
+  PriorityRegistration& operator=(const PriorityRegistration&) = delete;
+
+ private:
+  std::shared_ptr<http::RequestPriorityHandle> handle_;
+  uint64_t key_{0u};
+};
+
 HttpResponse SendRequest(const http::NetworkRequest& request,
                          const olp::client::OlpClientSettings& settings,
                          const olp::client::RetrySettings& retry_settings,
-                         client::CancellationContext context) {
-  struct ResponseData {
-    Condition condition;
+                         client::CancellationContext context,
+                         std::shared_ptr<ResponseBufferStream> response_buffer,
+                         std::shared_ptr<FirstByteTimes> first_byte_times,
+                         std::shared_ptr<DataCallbackStream> data_stream) {
+  // A hedged request is sent twice, each attempt receives its own body.
+  struct Attempt {
+    std::shared_ptr<ResponseBufferStream> buffer;
+    std::shared_ptr<DataCallbackStream> stream;
+    std::shared_ptr<std::stringstream> body =
+        std::make_shared<std::stringstream>();
     http::NetworkResponse response{kCancelledErrorResponse};
     http::Headers headers;
+    http::RequestId request_id{PendingUrlRequest::kInvalidRequestId};
+    bool completed{false};
+    uint64_t reserved_bytes{0u};
+  };
+
+  struct ResponseData {
+    ~ResponseData() {
+      if (memory_budget) {
+        memory_budget->Release(attempts[0].reserved_bytes +
+                               attempts[1].reserved_bytes);
+      }
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    Attempt attempts[2];
+    size_t started{0u};
+    bool responded{false};
+    bool cancelled{false};
+    int winner{-1};
+    std::shared_ptr<MemoryBudget> memory_budget;
   };
 
+  // The streamed body can't be raced, both attempts would pass their chunks
+  // to the same callback.
+  if (retry_settings.hedge_percentile == 0u || data_stream) {
+    first_byte_times = nullptr;
+  }
+
   auto response_data = std::make_shared<ResponseData>();
-  auto response_body = std::make_shared<std::stringstream>();
-  http::SendOutcome outcome{http::ErrorCode::CANCELLED_ERROR};
-  const auto timeout = std::chrono::seconds(retry_settings.timeout);
-
-  context.ExecuteOrCancelled(
-      [&]() {
-        outcome = settings.network_request_handler->Send(
-            request, response_body,
-            [response_data](http::NetworkResponse response) {
-              response_data->response = std::move(response);
-              response_data->condition.Notify();
-            },
-            [response_data](std::string key, std::string value) {
-              response_data->headers.emplace_back(std::move(key),
-                                                  std::move(value));
-            });
-
-        if (!outcome.IsSuccessful()) {
-          OLP_SDK_LOG_WARNING_F(kLogTag,
-                                "SendRequest: sending request failed, url=%s",
-                                request.GetUrl().c_str());
-          return CancellationToken();
-        }
+  response_data->attempts[0].buffer = response_buffer;
+  response_data->attempts[0].stream = data_stream;
+  response_data->memory_budget = settings.memory_budget;
+  auto network = settings.network_request_handler;
+  const auto start = std::chrono::steady_clock::now();
+  // The deadline of the operation shortens the timeout of the request.
+  const auto deadline =
+      std::min(start + std::chrono::seconds(retry_settings.timeout),
+               DeadlineScope::GetCurrentDeadline());
+
+  auto send = [&](size_t index) {
+    const auto& attempt = response_data->attempts[index];
+    std::shared_ptr<std::ostream> payload = attempt.body;
+    if (attempt.buffer) {
+      payload = attempt.buffer;
+    } else if (attempt.stream) {
+      payload = attempt.stream;
+    }
 
-        auto request_handler = settings.network_request_handler;
-        auto request_id = outcome.GetRequestId();
+    return network->Send(
+        request, payload,
+        [=](http::NetworkResponse response) {
+          std::lock_guard<std::mutex> lock(response_data->mutex);
+          auto& attempts = response_data->attempts;
+          attempts[index].response = std::move(response);
+          attempts[index].completed = true;
+          response_data->responded = true;
+
+          // The first successful attempt wins. If all of them failed, the
+          // first one is used so the resumed downloads find its body.
+          const bool all_completed =
+              attempts[0].completed &&
+              (response_data->started < 2u || attempts[1].completed);
+          if (response_data->winner < 0) {
+            if (attempts[index].response.GetStatus() >= 0) {
+              response_data->winner = static_cast<int>(index);
+            } else if (all_completed) {
+              response_data->winner = 0;
+            }
+          }
+          response_data->condition.notify_all();
+        },
+        [=](std::string key, std::string value) {
+          const bool content_length =
+              CaseInsensitiveCompare(key, kContentLengthHeader);
+          const uint64_t length =
+              content_length ? std::strtoull(value.c_str(), nullptr, 10) : 0u;
+
+          {
+            std::lock_guard<std::mutex> lock(response_data->mutex);
+            auto& attempt = response_data->attempts[index];
+            if (index == 0u && attempt.headers.empty() && first_byte_times) {
+              first_byte_times->Add(
+                  std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start));
+            }
+            if (attempt.buffer && content_length) {
+              attempt.buffer->Reserve(length);
+            }
+            attempt.reserved_bytes += length;
+            attempt.headers.emplace_back(std::move(key), std::move(value));
+            response_data->responded = true;
+            response_data->condition.notify_all();
+          }
 
-        return CancellationToken([=]() {
-          request_handler->Cancel(request_id);
-          response_data->condition.Notify();
+          // The budget may notify its consumers, so it is called without the
+          // lock.
+          if (response_data->memory_budget && length > 0u) {
+            response_data->memory_budget->Reserve(length);
+          }
         });
-      },
-      [&]() { response_data->condition.Notify(); });
+  };
+
+  http::SendOutcome outcome{http::ErrorCode::CANCELLED_ERROR};
+  context.ExecuteOrCancelled([&]() {
+    outcome = send(0u);
+    if (!outcome.IsSuccessful()) {
+      OLP_SDK_LOG_WARNING_F(kLogTag,
+                            "SendRequest: sending request failed, url=%s",
+                            request.GetUrl().c_str());
+      return CancellationToken();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(response_data->mutex);
+      response_data->attempts[0].request_id = outcome.GetRequestId();
+      response_data->started = 1u;
+    }
+
+    return CancellationToken([=]() {
+      std::vector<http::RequestId> request_ids;
+      {
+        std::lock_guard<std::mutex> lock(response_data->mutex);
+        response_data->cancelled = true;
+        for (size_t i = 0u; i < response_data->started; ++i) {
+          request_ids.push_back(response_data->attempts[i].request_id);
+        }
+        response_data->condition.notify_all();
+      }
+
+      for (const auto request_id : request_ids) {
+        network->Cancel(request_id);
+      }
+    });
+  });
 
   if (!outcome.IsSuccessful()) {
     return ToHttpResponse(outcome);
   }
 
-  if (!response_data->condition.Wait(timeout)) {
+  PriorityRegistration priority_registration(network, request,
+                                             outcome.GetRequestId());
+
+  std::unique_lock<std::mutex> lock(response_data->mutex);
+  const auto hedge_delay =
+      GetHedgeDelay(request, retry_settings, first_byte_times.get(),
+                    settings.memory_budget.get());
+  if (hedge_delay && start + *hedge_delay < deadline &&
+      !response_data->condition.wait_until(lock, start + *hedge_delay, [&] {
+        return response_data->responded || response_data->cancelled;
+      })) {
+    OLP_SDK_LOG_DEBUG_F(kLogTag,
+                        "SendRequest: no response after %lld ms, hedging "
+                        "request %" PRIu64,
+                        static_cast<long long>(hedge_delay->count()),
+                        outcome.GetRequestId());
+
+    if (response_buffer) {
+      response_data->attempts[1].buffer =
+          std::make_shared<ResponseBufferStream>();
+    }
+
+    lock.unlock();
+    auto hedge_outcome = send(1u);
+    lock.lock();
+
+    if (hedge_outcome.IsSuccessful()) {
+      response_data->attempts[1].request_id = hedge_outcome.GetRequestId();
+      response_data->started = 2u;
+      if (response_data->cancelled) {
+        lock.unlock();
+        network->Cancel(hedge_outcome.GetRequestId());
+        lock.lock();
+      }
+    }
+  }
+
+  if (!response_data->condition.wait_until(lock, deadline, [&] {
+        return response_data->winner >= 0 || response_data->cancelled;
+      })) {
+    lock.unlock();
     OLP_SDK_LOG_WARNING_F(kLogTag, "Request %" PRIu64 " timed out!",
                           outcome.GetRequestId());
     context.CancelOperation();
@@ -311,11 +745,46 @@ HttpResponse SendRequest(const http::NetworkRequest& request,
     return ToHttpResponse(kCancelledErrorResponse);
   }
 
-  HttpResponse response{response_data->response.GetStatus(),
-                        std::move(*response_body),
-                        std::move(response_data->headers)};
+  // Cancel the attempt that lost the race.
+  const auto winner = static_cast<size_t>(response_data->winner);
+  auto attempt = std::move(response_data->attempts[winner]);
+  const auto& loser = response_data->attempts[1u - winner];
+  const bool cancel_loser = response_data->started == 2u && !loser.completed;
+  const auto loser_id = loser.request_id;
+  lock.unlock();
+
+  if (cancel_loser) {
+    network->Cancel(loser_id);
+  }
+
+  const auto status = attempt.response.GetStatus();
+  if (attempt.buffer && StatusSuccess(status)) {
+    HttpResponse response{status, attempt.buffer->ReleaseBuffer(),
+                          std::move(attempt.headers)};
+    response.SetNetworkStatistics(GetStatistics(attempt.response));
+    return response;
+  }
+
+  if (attempt.buffer && status < 0) {
+    // The partial body stays in the buffer, so the download can be resumed.
+    HttpResponse response{status,
+                          std::stringstream(attempt.response.GetError()),
+                          std::move(attempt.headers)};
+    response.SetNetworkStatistics(GetStatistics(attempt.response));
+    return response;
+  }
+
+  if (attempt.buffer) {
+    // The error bodies are expected in the response stream.
+    const auto buffer = attempt.buffer->ReleaseBuffer();
+    attempt.body->write(reinterpret_cast<const char*>(buffer->data()),
+                        buffer->size());
+  }
+
+  HttpResponse response{status, std::move(*attempt.body),
+                        std::move(attempt.headers)};
 
-  response.SetNetworkStatistics(GetStatistics(response_data->response));
+  response.SetNetworkStatistics(GetStatistics(attempt.response));
 
   return response;
 }
@@ -352,7 +821,10 @@ class OlpClient::OlpClientImpl {
                        ParametersType query_params,
                        ParametersType header_params, ParametersType form_params,
                        RequestBodyType post_body, std::string content_type,
-                       CancellationContext context) const;
+                       CancellationContext context, bool buffer_response,
+                       http::Network::DataCallback data_callback,
+                       http::NetworkRequest::BodySourceCallback body_source,
+                       std::int64_t body_source_size) const;
 
   std::shared_ptr<http::NetworkRequest> CreateRequest(
       const std::string& path, const std::string& method,
@@ -362,6 +834,25 @@ class OlpClient::OlpClientImpl {
   void AddBearer(bool query_empty, http::NetworkRequest& request) const;
 
  private:
+  /// Sends the request and retries it according to the retry settings. The
+  /// downloads with a range are resumed if `resume_downloads` is set. The
+  /// body is passed to `data_callback` instead of the response if it is set.
+  HttpResponse SendWithRetries(
+      const http::NetworkRequest& request, CancellationContext context,
+      bool buffer_response, boost::optional<ByteRange> range,
+      http::Network::DataCallback data_callback = nullptr) const;
+
+  /// Downloads the body in the ranged chunks of `download_chunk_size` bytes,
+  /// and starts again if the resource changes during the download.
+  HttpResponse DownloadInChunks(const http::NetworkRequest& request,
+                                CancellationContext context) const;
+
+  /// Downloads the chunks of one version of the resource, sets `changed` if
+  /// the resource changed after the first chunk.
+  HttpResponse DownloadChunks(const http::NetworkRequest& request,
+                              CancellationContext context,
+                              bool& changed) const;
+
   using MutexType = std::shared_mutex;
   using ReadLock = std::shared_lock<MutexType>;
 
@@ -369,16 +860,21 @@ class OlpClient::OlpClientImpl {
   ParametersType default_headers_;
   OlpClientSettings settings_;
   PendingUrlRequestsPtr pending_requests_;
+  std::shared_ptr<FirstByteTimes> first_byte_times_;
 };
 
 OlpClient::OlpClientImpl::OlpClientImpl()
-    : pending_requests_{std::make_shared<PendingUrlRequests>()} {}
+    : pending_requests_{std::make_shared<PendingUrlRequests>()},
+      first_byte_times_{std::make_shared<FirstByteTimes>()} {}
 
 OlpClient::OlpClientImpl::OlpClientImpl(const OlpClientSettings& settings,
                                         std::string base_url)
     : base_url_{std::move(base_url)},
       settings_{settings},
-      pending_requests_{std::make_shared<PendingUrlRequests>()} {}
+      pending_requests_{settings.pending_requests
+                            ? settings.pending_requests
+                            : std::make_shared<PendingUrlRequests>()},
+      first_byte_times_{std::make_shared<FirstByteTimes>()} {}
 
 void OlpClient::OlpClientImpl::SetBaseUrl(const std::string& base_url) {
   base_url_.lockedAssign(base_url);
@@ -396,6 +892,9 @@ OlpClient::OlpClientImpl::GetMutableDefaultHeaders() {
 void OlpClient::OlpClientImpl::SetSettings(const OlpClientSettings& settings) {
   // I would not expect that settings change during lifetime of the instance.
   settings_ = settings;
+  if (settings.pending_requests) {
+    pending_requests_ = settings.pending_requests;
+  }
 }
 
 void OlpClient::OlpClientImpl::AddBearer(bool query_empty,
@@ -427,7 +926,8 @@ std::shared_ptr<http::NetworkRequest> OlpClient::OlpClientImpl::CreateRequest(
   auto network_request = std::make_shared<http::NetworkRequest>(
       utils::Url::Construct(GetBaseUrl(), path, query_params));
 
-  network_request->WithVerb(GetHttpVerb(method));
+  network_request->WithVerb(GetHttpVerb(method))
+      .WithPriority(http::RequestPriorityScope::GetCurrentPriority());
 
   for (const auto& header : default_headers_) {
     network_request->WithHeader(header.first, header.second);
@@ -477,11 +977,31 @@ CancellationToken OlpClient::OlpClientImpl::CallApi(
 
   AddBearer(query_params.empty(), *network_request);
 
+  const auto& retry_budget = settings_.retry_settings.retry_budget;
+  if (retry_budget && !retry_budget->AllowRequest(network_request->GetUrl())) {
+    callback(CircuitOpenResponse());
+    return CancellationToken();
+  }
+
   PendingUrlRequestPtr request_ptr = nullptr;
   auto& pending_requests = pending_requests_;
   const auto& url = network_request->GetUrl();
+  const auto key = GetPendingKey(*network_request);
   CancellationToken cancellation_token;
 
+  // The span ends when the response is passed to the caller.
+  auto traced_callback = callback;
+  auto span = StartSpan(settings_.tracer, "olp.http.request");
+  if (span) {
+    span->SetAttribute("http.method", method);
+    span->SetAttribute("http.url", url);
+    traced_callback = [span, callback](HttpResponse response) {
+      span->SetAttribute("http.status_code", std::to_string(response.status));
+      span->End();
+      callback(std::move(response));
+    };
+  }
+
   // Only merge same request in case there is no body as a body can alter the
   // outcome of the request and may not match the response of a request with a
   // different body.
@@ -492,11 +1012,14 @@ CancellationToken OlpClient::OlpClientImpl::CallApi(
   if (merge) {
     // Add callback and prepare CancellationToken
     auto call_id =
-        pending_requests->Append(url, std::move(callback), request_ptr);
+        pending_requests->Append(key, std::move(traced_callback), request_ptr);
     cancellation_token =
-        CancellationToken([=] { pending_requests->Cancel(url, call_id); });
+        CancellationToken([=] { pending_requests->Cancel(key, call_id); });
 
     if (IsPending(request_ptr)) {
+      if (span) {
+        span->SetAttribute("olp.coalesced", "true");
+      }
       // Network call is already triggered, we only need to append our
       // callback Cancels this callback; internally once all pending callbacks
       // are cancelled the Network call will be automatically cancelled also
@@ -508,7 +1031,7 @@ CancellationToken OlpClient::OlpClientImpl::CallApi(
     request_ptr = std::make_shared<PendingUrlRequest>();
 
     // Add callback and prepare CancellationToken
-    auto call_id = request_ptr->Append(std::move(callback));
+    auto call_id = request_ptr->Append(std::move(traced_callback));
     cancellation_token =
         CancellationToken([=] { request_ptr->Cancel(call_id); });
   }
@@ -528,7 +1051,8 @@ CancellationToken OlpClient::OlpClientImpl::CallApi(
   ExecuteSingleRequest(
       network, request_ptr, *network_request,
       GetRetryCallback(merge, request_settings, retry_settings, network,
-                       pending_requests, request_ptr, network_request));
+                       settings_.task_scheduler, pending_requests, request_ptr,
+                       network_request));
 
   return cancellation_token;
 }
@@ -539,12 +1063,17 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
     OlpClient::ParametersType header_params,
     OlpClient::ParametersType /*forms_params*/,
     OlpClient::RequestBodyType post_body, std::string content_type,
-    CancellationContext context) const {
+    CancellationContext context, bool buffer_response,
+    http::Network::DataCallback data_callback,
+    http::NetworkRequest::BodySourceCallback body_source,
+    std::int64_t body_source_size) const {
   if (!settings_.network_request_handler) {
     return HttpResponse(static_cast<int>(olp::http::ErrorCode::OFFLINE_ERROR),
                         "Network request handler is empty.");
   }
 
+  ScopedSpan span(settings_.tracer, "olp.http.request");
+
   const auto& retry_settings = settings_.retry_settings;
   auto network_settings =
       http::NetworkSettings()
@@ -558,7 +1087,9 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
 
   network_request.WithVerb(GetHttpVerb(method))
       .WithBody(std::move(post_body))
-      .WithSettings(std::move(network_settings));
+      .WithBodySource(std::move(body_source), body_source_size)
+      .WithSettings(std::move(network_settings))
+      .WithPriority(http::RequestPriorityScope::GetCurrentPriority());
 
   for (const auto& header : default_headers_) {
     network_request.WithHeader(header.first, header.second);
@@ -585,13 +1116,100 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
     network_request.WithHeader(http::kContentTypeHeader, content_type);
   }
 
+  AddBearer(query_params.empty(), network_request);
+
+  if (span.IsTraced()) {
+    span.SetAttribute("http.method", method);
+    span.SetAttribute("http.url", network_request.GetUrl());
+  }
+
+  HttpResponse response;
+  if (data_callback) {
+    // The streamed body is not kept, so the downloads are restarted instead
+    // of resumed.
+    response = SendWithRetries(network_request, std::move(context), false,
+                               boost::none, std::move(data_callback));
+  } else if (buffer_response && settings_.download_chunk_size > 0u &&
+             IsDownload(network_request)) {
+    response = DownloadInChunks(network_request, std::move(context));
+  } else {
+    boost::optional<ByteRange> range;
+    if (buffer_response && IsDownload(network_request)) {
+      range = ByteRange{0u, boost::none};
+    }
+
+    response = SendWithRetries(network_request, std::move(context),
+                               buffer_response, range);
+  }
+
+  if (span.IsTraced()) {
+    span.SetAttribute("http.status_code", std::to_string(response.status));
+    span.SetAttribute(
+        "olp.bytes_downloaded",
+        std::to_string(response.GetNetworkStatistics().GetBytesDownloaded()));
+  }
+  return response;
+}
+
+HttpResponse OlpClient::OlpClientImpl::SendWithRetries(
+    const http::NetworkRequest& request, CancellationContext context,
+    bool buffer_response, boost::optional<ByteRange> range,
+    http::Network::DataCallback data_callback) const {
+  const auto& retry_settings = settings_.retry_settings;
   auto backdown_period =
       std::chrono::milliseconds(retry_settings.initial_backdown_period);
 
-  AddBearer(query_params.empty(), network_request);
+  boost::optional<DownloadProgress> progress;
+  if (range && retry_settings.resume_downloads) {
+    progress.emplace(*range);
+  }
 
-  auto response =
-      SendRequest(network_request, settings_, retry_settings, context);
+  const auto& retry_budget = retry_settings.retry_budget;
+  if (retry_budget && !retry_budget->AllowRequest(request.GetUrl())) {
+    return CircuitOpenResponse();
+  }
+
+  // The request is not sent or retried after the deadline of the operation.
+  const auto deadline = DeadlineScope::GetCurrentDeadline();
+  if (std::chrono::steady_clock::now() >= deadline) {
+    return ToHttpResponse(kTimeoutErrorResponse);
+  }
+
+  // Set when the last attempt was interrupted after receiving a part of the
+  // body, such attempts are always retried.
+  bool interrupted = false;
+  auto send = [&]() {
+    auto attempt = request;
+    if (progress) {
+      progress->PrepareRequest(attempt);
+    } else if (range && (range->first > 0u || range->last)) {
+      attempt.WithHeader(kRangeHeader, FormatRange(range->first, range->last));
+    }
+
+    auto response_buffer =
+        buffer_response ? std::make_shared<ResponseBufferStream>() : nullptr;
+    auto data_stream =
+        data_callback ? std::make_shared<DataCallbackStream>(data_callback)
+                      : nullptr;
+    auto response = SendRequest(attempt, settings_, retry_settings, context,
+                                response_buffer, first_byte_times_,
+                                std::move(data_stream));
+    if (retry_budget && !context.IsCancelled()) {
+      retry_budget->OnResult(request.GetUrl(), IsHostFailure(response.status));
+    }
+
+    interrupted = false;
+    if (progress && StatusSuccess(response.status)) {
+      return progress->Complete(std::move(response));
+    }
+    if (progress && response.status < 0 && !context.IsCancelled()) {
+      interrupted =
+          progress->Interrupted(response.GetHeaders(), *response_buffer);
+    }
+    return response;
+  };
+
+  auto response = send();
 
   NetworkStatistics accumulated_statistics = response.GetNetworkStatistics();
 
@@ -607,15 +1225,27 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
       return response;
     }
 
-    if (!retry_settings.retry_condition(response)) {
+    if (!interrupted && !retry_settings.retry_condition(response)) {
       return response;
     }
 
+    if (retry_budget && !retry_budget->TryRetry()) {
+      OLP_SDK_LOG_WARNING_F(kLogTag, "Retry budget is spent, url=%s",
+                            request.GetUrl().c_str());
+      break;
+    }
+
     // do the periodical sleep and check for cancellation status in between.
     auto duration_to_sleep =
         std::min(backdown_period, max_wait_time - accumulated_wait_time);
     accumulated_wait_time += duration_to_sleep;
 
+    if (std::chrono::steady_clock::now() + duration_to_sleep >= deadline) {
+      OLP_SDK_LOG_DEBUG_F(kLogTag, "No retry before the deadline, url=%s",
+                          request.GetUrl().c_str());
+      break;
+    }
+
     while (duration_to_sleep.count() > 0 && !context.IsCancelled()) {
       const auto sleep_ms =
           std::min(std::chrono::milliseconds(1000), duration_to_sleep);
@@ -624,7 +1254,10 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
     }
 
     backdown_period = CalculateNextWaitTime(retry_settings, i);
-    response = SendRequest(network_request, settings_, retry_settings, context);
+    if (retry_budget && !retry_budget->AllowRequest(request.GetUrl())) {
+      break;
+    }
+    response = send();
 
     // In case we retry, accumulate the stats
     accumulated_statistics += response.GetNetworkStatistics();
@@ -635,6 +1268,194 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
   return response;
 }
 
+HttpResponse OlpClient::OlpClientImpl::DownloadInChunks(
+    const http::NetworkRequest& request, CancellationContext context) const {
+  NetworkStatistics statistics;
+  HttpResponse response;
+  for (size_t download = 0u; download < kMaxChunkedDownloads; ++download) {
+    bool changed = false;
+    response = DownloadChunks(request, context, changed);
+    statistics += response.GetNetworkStatistics();
+    if (!changed || context.IsCancelled()) {
+      break;
+    }
+    OLP_SDK_LOG_DEBUG_F(kLogTag,
+                        "Resource changed during the download, url=%s",
+                        request.GetUrl().c_str());
+  }
+
+  response.SetNetworkStatistics(statistics);
+  return response;
+}
+
+HttpResponse OlpClient::OlpClientImpl::DownloadChunks(
+    const http::NetworkRequest& request, CancellationContext context,
+    bool& changed) const {
+  const auto chunk_size = settings_.download_chunk_size;
+  auto response =
+      SendWithRetries(request, context, true, ByteRange{0u, chunk_size - 1u});
+
+  uint64_t total = 0u;
+  const auto* content_range =
+      FindHeader(response.GetHeaders(), kContentRangeHeader);
+  if (!StatusSuccess(response.status) || !content_range) {
+    // The server does not support the ranges and sent the whole body.
+    return response;
+  }
+
+  if (GetBodyOffset(response.GetHeaders(), &total) != 0u ||
+      total <= chunk_size) {
+    if (response.status == http::HttpStatusCode::PARTIAL_CONTENT &&
+        response.GetResponseBuffer()->size() == total) {
+      response.status = http::HttpStatusCode::OK;
+    }
+    return response;
+  }
+
+  // The other chunks must come from the same version of the resource. The
+  // server answers 412 to the conditional requests if the resource changed.
+  // The weak ETags never match in If-Match, so they are only compared.
+  auto chunk_request = request;
+  const auto* etag_header = FindHeader(response.GetHeaders(), kETagHeader);
+  const auto etag = etag_header ? *etag_header : std::string();
+  const auto* last_modified =
+      FindHeader(response.GetHeaders(), kLastModifiedHeader);
+  if (!etag.empty() && etag.compare(0, 2, "W/") != 0) {
+    chunk_request.WithHeader(kIfMatchHeader, etag);
+  } else if (etag.empty() && last_modified) {
+    chunk_request.WithHeader(kIfUnmodifiedSinceHeader, *last_modified);
+  }
+
+  const auto chunks_count =
+      static_cast<size_t>((total + chunk_size - 1u) / chunk_size);
+
+  // The scheduled tasks may start after the download completes, so they
+  // share the state and only use the client while they download a chunk.
+  struct State {
+    explicit State(size_t count) : chunks(count), contexts(count) {}
+
+    std::vector<HttpResponse> chunks;
+    std::vector<CancellationContext> contexts;
+    std::mutex mutex;
+    std::condition_variable idle;
+    size_t next_chunk = 1u;
+    size_t active = 0u;
+  };
+  auto state = std::make_shared<State>(chunks_count);
+  state->chunks[0] = std::move(response);
+
+  const bool started = context.ExecuteOrCancelled([&]() {
+    return CancellationToken([state]() {
+      for (auto& chunk_context : state->contexts) {
+        chunk_context.CancelOperation();
+      }
+    });
+  });
+  if (!started) {
+    return ToHttpResponse(kCancelledErrorResponse);
+  }
+
+  auto download = [this, state, chunk_request, chunks_count, chunk_size,
+                   total]() {
+    while (true) {
+      size_t index = 0u;
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        index = state->next_chunk++;
+        if (index >= chunks_count) {
+          return;
+        }
+        ++state->active;
+      }
+
+      const auto first = index * chunk_size;
+      const auto last = std::min(first + chunk_size, total) - 1u;
+      auto chunk = SendWithRetries(chunk_request, state->contexts[index], true,
+                                   ByteRange{first, last});
+
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->chunks[index] = std::move(chunk);
+      if (--state->active == 0u) {
+        state->idle.notify_all();
+      }
+    }
+  };
+
+  // The calling thread downloads the chunks too, so the download completes
+  // even if the scheduler does not start the tasks.
+  const auto& task_scheduler = settings_.task_scheduler;
+  const auto workers_count = std::min(kMaxParallelChunks, chunks_count - 1u);
+  if (task_scheduler && workers_count > 1u) {
+    std::vector<thread::TaskScheduler::CallFuncType> tasks;
+    for (size_t worker = 1u; worker < workers_count; ++worker) {
+      tasks.emplace_back(download);
+    }
+    thread::TaskComponentScope component_scope("OlpClient");
+    task_scheduler->ScheduleTasks(std::move(tasks), request.GetPriority());
+  }
+  download();
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->idle.wait(lock, [&]() { return state->active == 0u; });
+  }
+
+  auto& chunks = state->chunks;
+  auto body = std::make_shared<std::vector<unsigned char>>();
+  body->reserve(static_cast<size_t>(total));
+  NetworkStatistics statistics;
+  for (auto& chunk : chunks) {
+    statistics += chunk.GetNetworkStatistics();
+    if (context.IsCancelled()) {
+      continue;
+    }
+
+    uint64_t chunk_total = total;
+    GetBodyOffset(chunk.GetHeaders(), &chunk_total);
+    const auto* chunk_etag = FindHeader(chunk.GetHeaders(), kETagHeader);
+    if (chunk.status == http::HttpStatusCode::PRECONDITION_FAILED ||
+        (StatusSuccess(chunk.status) &&
+         (chunk_total != total ||
+          (chunk_etag && !etag.empty() && *chunk_etag != etag)))) {
+      changed = true;
+      HttpResponse error{http::HttpStatusCode::PRECONDITION_FAILED,
+                         "The resource changed during the download"};
+      error.SetNetworkStatistics(statistics);
+      return error;
+    }
+
+    if (!StatusSuccess(chunk.status)) {
+      chunk.SetNetworkStatistics(statistics);
+      return chunk;
+    }
+
+    const auto chunk_body = chunk.GetResponseBuffer();
+    if (chunk_body->size() != std::min(chunk_size, total - body->size())) {
+      HttpResponse error{static_cast<int>(http::ErrorCode::IO_ERROR),
+                         "Unexpected size of the ranged chunk"};
+      error.SetNetworkStatistics(statistics);
+      return error;
+    }
+    body->insert(body->end(), chunk_body->begin(), chunk_body->end());
+  }
+
+  if (context.IsCancelled()) {
+    return ToHttpResponse(kCancelledErrorResponse);
+  }
+
+  auto headers = chunks[0].GetHeaders();
+  headers.erase(std::remove_if(headers.begin(), headers.end(),
+                               [](const http::Header& header) {
+                                 return CaseInsensitiveCompare(
+                                     header.first, kContentRangeHeader);
+                               }),
+                headers.end());
+
+  HttpResponse result{http::HttpStatusCode::OK, std::move(body),
+                      std::move(headers)};
+  result.SetNetworkStatistics(statistics);
+  return result;
+}
+
 OlpClient::OlpClient() : impl_(std::make_shared<OlpClientImpl>()){};
 OlpClient::OlpClient(const OlpClientSettings& settings, std::string base_url)
     : impl_(std::make_shared<OlpClientImpl>(settings, std::move(base_url))) {}
@@ -678,7 +1499,51 @@ HttpResponse OlpClient::CallApi(std::string path, std::string method,
   return impl_->CallApi(std::move(path), std::move(method),
                         std::move(query_params), std::move(header_params),
                         std::move(form_params), std::move(post_body),
-                        std::move(content_type), std::move(context));
+                        std::move(content_type), std::move(context),
+                        false, nullptr, nullptr,
+                        http::NetworkRequest::kUnknownBodySize);
+}
+
+HttpResponse OlpClient::CallApi(std::string path, std::string method,
+                                ParametersType query_params,
+                                ParametersType header_params,
+                                ParametersType form_params,
+                                RequestBodyType post_body,
+                                std::string content_type,
+                                CancellationContext context,
+                                bool buffer_response) const {
+  return impl_->CallApi(std::move(path), std::move(method),
+                        std::move(query_params), std::move(header_params),
+                        std::move(form_params), std::move(post_body),
+                        std::move(content_type), std::move(context),
+                        buffer_response, nullptr, nullptr,
+                        http::NetworkRequest::kUnknownBodySize);
+}
+
+HttpResponse OlpClient::CallApi(
+    std::string path, std::string method, ParametersType query_params,
+    ParametersType header_params, ParametersType form_params,
+    RequestBodyType post_body, std::string content_type,
+    CancellationContext context,
+    http::Network::DataCallback data_callback) const {
+  return impl_->CallApi(std::move(path), std::move(method),
+                        std::move(query_params), std::move(header_params),
+                        std::move(form_params), std::move(post_body),
+                        std::move(content_type), std::move(context), false,
+                        std::move(data_callback), nullptr,
+                        http::NetworkRequest::kUnknownBodySize);
+}
+
+HttpResponse OlpClient::CallApi(
+    std::string path, std::string method, ParametersType query_params,
+    ParametersType header_params,
+    http::NetworkRequest::BodySourceCallback body_source,
+    std::int64_t body_size, std::string content_type,
+    CancellationContext context) const {
+  return impl_->CallApi(std::move(path), std::move(method),
+                        std::move(query_params), std::move(header_params), {},
+                        nullptr, std::move(content_type), std::move(context),
+                        false, nullptr, std::move(body_source), body_size);
 }
 
 }  // namespace client
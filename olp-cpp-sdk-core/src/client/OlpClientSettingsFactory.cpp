@@ -19,6 +19,7 @@
 
 #include "olp/core/client/OlpClientSettingsFactory.h"
 
+#include "PendingUrlRequests.h"
 #include "olp/core/Config.h"
 #include "olp/core/cache/CacheSettings.h"
 #include "olp/core/cache/DefaultCache.h"
@@ -68,6 +69,11 @@ OlpClientSettingsFactory::CreateDefaultCache(cache::CacheSettings settings) {
 #endif // OLP_SDK_ENABLE_DEFAULT_CACHE
 }
 
+std::shared_ptr<PendingUrlRequests>
+OlpClientSettingsFactory::CreatePendingRequests() {
+  return std::make_shared<PendingUrlRequests>();
+}
+
 void OlpClientSettingsFactory::PrewarmConnection(
     const OlpClientSettings& settings, const std::string& url,
     http::Network::Callback callback) {
@@ -29,15 +29,19 @@ namespace {
 constexpr auto kLogTag = "PendingRequests";
 }
 
+constexpr size_t PendingRequests::kShardCount;
+
 bool PendingRequests::CancelAll() {
-  ContextMap contexts;
-  {
-    std::lock_guard<std::mutex> lock(task_contexts_lock_);
-    contexts = task_contexts_;
-  }
+  for (auto& shard : shards_) {
+    ContextMap contexts;
+    {
+      std::lock_guard<std::mutex> lock(shard.task_contexts_lock);
+      contexts = shard.task_contexts;
+    }
 
-  for (auto context : contexts) {
-    context.CancelToken().Cancel();
+    for (auto context : contexts) {
+      context.CancelToken().Cancel();
+    }
   }
 
   return true;
@@ -46,15 +50,18 @@ bool PendingRequests::CancelAll() {
 bool PendingRequests::CancelAllAndWait() {
   CancelAll();
 
-  ContextMap contexts;
-  {
-    std::lock_guard<std::mutex> lock(task_contexts_lock_);
-    contexts = std::move(task_contexts_);
-  }
+  for (auto& shard : shards_) {
+    ContextMap contexts;
+    {
+      std::lock_guard<std::mutex> lock(shard.task_contexts_lock);
+      contexts = std::move(shard.task_contexts);
+      shard.task_contexts.clear();
+    }
 
-  for (auto context : contexts) {
-    if (!context.BlockingCancel()) {
-      OLP_SDK_LOG_WARNING(kLogTag, "Timeout, when waiting on BlockingCancel");
+    for (auto context : contexts) {
+      if (!context.BlockingCancel()) {
+        OLP_SDK_LOG_WARNING(kLogTag, "Timeout, when waiting on BlockingCancel");
+      }
     }
   }
 
@@ -62,18 +69,32 @@ bool PendingRequests::CancelAllAndWait() {
 }
 
 void PendingRequests::Insert(TaskContext task_context) {
-  std::lock_guard<std::mutex> lock(task_contexts_lock_);
-  task_contexts_.insert(task_context);
+  auto& shard = GetShard(task_context);
+  std::lock_guard<std::mutex> lock(shard.task_contexts_lock);
+  shard.task_contexts.insert(std::move(task_context));
 }
 
 void PendingRequests::Remove(TaskContext task_context) {
-  std::lock_guard<std::mutex> lock(task_contexts_lock_);
-  task_contexts_.erase(task_context);
+  auto& shard = GetShard(task_context);
+  std::lock_guard<std::mutex> lock(shard.task_contexts_lock);
+  shard.task_contexts.erase(task_context);
 }
 
 size_t PendingRequests::GetTaskCount() const {
-  std::lock_guard<std::mutex> lock(task_contexts_lock_);
-  return task_contexts_.size();
+  size_t count = 0u;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.task_contexts_lock);
+    count += shard.task_contexts.size();
+  }
+  return count;
+}
+
+PendingRequests::Shard& PendingRequests::GetShard(
+    const TaskContext& task_context) {
+  // The hash is the address of the task, mix the bits above the allocation
+  // alignment.
+  const auto hash = TaskContextHash()(task_context) >> 4u;
+  return shards_[(hash ^ (hash >> 4u) ^ (hash >> 8u)) % kShardCount];
 }
 
 }  // namespace client
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "ResponseBufferStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace olp {
+namespace client {
+
+namespace {
+// Limits the memory reserved up front for a wrong or malicious header.
+constexpr uint64_t kMaxReservedSize = 64ull * 1024ull * 1024ull;
+}  // namespace
+
+ResponseBufferStream::ResponseBufferStream() : std::ostream(nullptr) {
+  rdbuf(&buffer_);
+}
+
+ResponseBufferStream::~ResponseBufferStream() = default;
+
+void ResponseBufferStream::Reserve(uint64_t size) {
+  buffer_.data->reserve(
+      static_cast<size_t>(std::min(size, kMaxReservedSize)));
+}
+
+ResponseBufferStream::BufferType ResponseBufferStream::ReleaseBuffer() {
+  return std::move(buffer_.data);
+}
+
+ResponseBufferStream::Buffer::Buffer()
+    : data{std::make_shared<std::vector<unsigned char>>()}, position_{0u} {}
+
+ResponseBufferStream::Buffer::int_type ResponseBufferStream::Buffer::overflow(
+    int_type c) {
+  if (traits_type::eq_int_type(c, traits_type::eof())) {
+    return traits_type::not_eof(c);
+  }
+
+  const auto value = traits_type::to_char_type(c);
+  return xsputn(&value, 1) == 1 ? c : traits_type::eof();
+}
+
+std::streamsize ResponseBufferStream::Buffer::xsputn(const char* s,
+                                                     std::streamsize n) {
+  if (!data || n <= 0) {
+    return 0;
+  }
+
+  const auto size = static_cast<size_t>(n);
+  const auto end = position_ + size;
+  if (end > data->size()) {
+    data->resize(end);
+  }
+
+  std::memcpy(data->data() + position_, s, size);
+  position_ = end;
+  return n;
+}
+
+ResponseBufferStream::Buffer::pos_type ResponseBufferStream::Buffer::seekoff(
+    off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+  if (!data || !(which & std::ios_base::out)) {
+    return pos_type(off_type(-1));
+  }
+
+  off_type base = 0;
+  if (dir == std::ios_base::cur) {
+    base = static_cast<off_type>(position_);
+  } else if (dir == std::ios_base::end) {
+    base = static_cast<off_type>(data->size());
+  }
+
+  return seekpos(pos_type(base + off), which);
+}
+
+ResponseBufferStream::Buffer::pos_type ResponseBufferStream::Buffer::seekpos(
+    pos_type pos, std::ios_base::openmode which) {
+  const auto offset = static_cast<off_type>(pos);
+  if (!data || !(which & std::ios_base::out) || offset < 0 ||
+      static_cast<size_t>(offset) > data->size()) {
+    return pos_type(off_type(-1));
+  }
+
+  position_ = static_cast<size_t>(offset);
+  return pos;
+}
+
+}  // namespace client
+}  // namespace olp
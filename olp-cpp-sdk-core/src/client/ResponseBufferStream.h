@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace olp {
+namespace client {
+
+/// The output stream that writes the response body directly into a growable
+/// byte buffer, so it can be moved into the `HttpResponse` without copies.
+class ResponseBufferStream : public std::ostream {
+ public:
+  /// The byte buffer type.
+  using BufferType = std::shared_ptr<std::vector<unsigned char>>;
+
+  ResponseBufferStream();
+  ~ResponseBufferStream() override;
+
+  /// Reserves the buffer for the expected body size, e.g. from the
+  /// `Content-Length` header.
+  void Reserve(uint64_t size);
+
+  /// Moves the buffer out of the stream, the stream must not be used after.
+  BufferType ReleaseBuffer();
+
+ private:
+  class Buffer : public std::streambuf {
+   public:
+    Buffer();
+
+    BufferType data;
+
+   protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+   private:
+    size_t position_;
+  };
+
+  Buffer buffer_;
+};
+
+}  // namespace client
+}  // namespace olp
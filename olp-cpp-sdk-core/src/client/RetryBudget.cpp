@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/client/RetryBudget.h"
+
+#include <algorithm>
+
+#include "olp/core/http/NetworkUtils.h"
+
+namespace olp {
+namespace client {
+
+RetryBudget::RetryBudget(size_t max_retries, std::chrono::milliseconds window,
+                         size_t failure_threshold,
+                         std::chrono::milliseconds open_duration)
+    : max_retries_{static_cast<double>(max_retries)},
+      window_{window},
+      failure_threshold_{failure_threshold},
+      open_duration_{open_duration},
+      tokens_{static_cast<double>(max_retries)},
+      refilled_at_{Clock::now()} {}
+
+bool RetryBudget::TryRetry() {
+  if (max_retries_ == 0.0) {
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto now = Clock::now();
+  if (window_.count() > 0.0) {
+    const std::chrono::duration<double> elapsed = now - refilled_at_;
+    tokens_ = std::min(max_retries_, tokens_ + max_retries_ * elapsed.count() /
+                                                   window_.count());
+  }
+  refilled_at_ = now;
+
+  if (tokens_ < 1.0) {
+    return false;
+  }
+  tokens_ -= 1.0;
+  return true;
+}
+
+bool RetryBudget::AllowRequest(const std::string& url) {
+  if (failure_threshold_ == 0u) {
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = hosts_.find(http::NetworkUtils::GetHost(url));
+  if (it == hosts_.end() || it->second.failures < failure_threshold_) {
+    return true;
+  }
+
+  const auto now = Clock::now();
+  if (now < it->second.open_until) {
+    return false;
+  }
+
+  // Let one request probe the host, the others wait for its result.
+  it->second.open_until = now + open_duration_;
+  return true;
+}
+
+void RetryBudget::OnResult(const std::string& url, bool failed) {
+  if (failure_threshold_ == 0u) {
+    return;
+  }
+
+  const auto host = http::NetworkUtils::GetHost(url);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!failed) {
+    hosts_.erase(host);
+    return;
+  }
+
+  auto& state = hosts_[host];
+  if (++state.failures == failure_threshold_) {
+    state.open_until = Clock::now() + open_duration_;
+  }
+}
+
+}  // namespace client
+}  // namespace olp
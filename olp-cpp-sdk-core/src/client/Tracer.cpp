@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/client/Tracer.h"
+
+#include <utility>
+
+namespace olp {
+namespace client {
+
+namespace {
+thread_local std::shared_ptr<Span> current_span;
+}  // namespace
+
+std::shared_ptr<Span> StartSpan(const std::shared_ptr<Tracer>& tracer,
+                                const char* name) {
+  if (!tracer) {
+    return nullptr;
+  }
+  return tracer->StartSpan(name, current_span);
+}
+
+SpanScope::SpanScope(std::shared_ptr<Span> span)
+    : previous_span_(std::move(current_span)) {
+  current_span = std::move(span);
+}
+
+SpanScope::~SpanScope() { current_span = std::move(previous_span_); }
+
+std::shared_ptr<Span> SpanScope::GetCurrentSpan() { return current_span; }
+
+ScopedSpan::ScopedSpan(const std::shared_ptr<Tracer>& tracer,
+                       const char* name)
+    : span_(StartSpan(tracer, name)) {
+  if (span_) {
+    scope_.reset(new SpanScope(span_));
+  }
+}
+
+ScopedSpan::~ScopedSpan() {
+  if (span_) {
+    scope_.reset();
+    span_->End();
+  }
+}
+
+void ScopedSpan::SetAttribute(const std::string& key,
+                              const std::string& value) {
+  if (span_) {
+    span_->SetAttribute(key, value);
+  }
+}
+
+}  // namespace client
+}  // namespace olp
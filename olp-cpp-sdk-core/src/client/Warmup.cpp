@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/client/Warmup.h"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <boost/optional.hpp>
+
+#include "olp/core/client/ApiLookupClient.h"
+#include "olp/core/client/CancellationContext.h"
+#include "olp/core/logging/Log.h"
+#include "olp/core/thread/TaskScheduler.h"
+
+namespace olp {
+namespace client {
+
+namespace {
+constexpr auto kLogTag = "Warmup";
+
+/// Collects the results of the API lookups.
+struct WarmupState {
+  std::mutex mutex;
+  size_t pending_lookups{0u};
+  boost::optional<ApiError> error;
+  WarmupCallback callback;
+};
+
+void Schedule(const OlpClientSettings& settings, std::function<void()> task) {
+  if (settings.task_scheduler) {
+    settings.task_scheduler->ScheduleTask(std::move(task), thread::HIGH);
+  } else {
+    task();
+  }
+}
+
+void LookupApis(const HRN& catalog, const OlpClientSettings& settings,
+                CancellationContext context,
+                const std::shared_ptr<WarmupState>& state) {
+  ApiLookupClient lookup_client(catalog, settings);
+  auto response = lookup_client.LookupAll(context);
+
+  // With `pre_resolve_hosts`, the lookup client connects to the hosts itself.
+  if (response.IsSuccessful() && settings.network_request_handler &&
+      !settings.api_lookup_settings.pre_resolve_hosts) {
+    std::vector<std::string> urls;
+    urls.reserve(response.GetResult().size());
+    for (const auto& api : response.GetResult()) {
+      urls.push_back(api.GetBaseUrl());
+    }
+    settings.network_request_handler->PreResolve(urls);
+  }
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  if (!response.IsSuccessful() && !state->error) {
+    state->error = response.GetError();
+  }
+
+  if (--state->pending_lookups > 0u) {
+    return;
+  }
+
+  auto callback = std::move(state->callback);
+  auto error = std::move(state->error);
+  lock.unlock();
+
+  if (error) {
+    callback(std::move(*error));
+  } else {
+    callback(ApiNoResult{});
+  }
+}
+}  // namespace
+
+CancellationToken Warmup(const std::vector<HRN>& catalogs,
+                         const OlpClientSettings& settings,
+                         WarmupCallback callback) {
+  if (catalogs.empty()) {
+    callback(ApiNoResult{});
+    return CancellationToken();
+  }
+
+  // The TLS handshakes with the lookup hosts run while the token is acquired.
+  const auto& lookup_provider =
+      settings.api_lookup_settings.lookup_endpoint_provider;
+  if (settings.network_request_handler && lookup_provider) {
+    std::vector<std::string> urls;
+    urls.reserve(catalogs.size());
+    for (const auto& catalog : catalogs) {
+      urls.push_back(lookup_provider(catalog.GetPartition()));
+    }
+    settings.network_request_handler->PreResolve(urls);
+  }
+
+  auto state = std::make_shared<WarmupState>();
+  state->pending_lookups = catalogs.size();
+  state->callback = std::move(callback);
+
+  CancellationContext context;
+
+  Schedule(settings, [=]() {
+    // The token is acquired once, before the lookups that need it, so the
+    // parallel lookups do not request it each.
+    const auto& authentication = settings.authentication_settings;
+    if (authentication && !authentication->api_key_provider &&
+        authentication->provider && !context.IsCancelled()) {
+      if (authentication->provider().empty()) {
+        OLP_SDK_LOG_WARNING(kLogTag, "Warmup: no access token acquired");
+      }
+    }
+
+    for (const auto& catalog : catalogs) {
+      Schedule(settings,
+               [=]() { LookupApis(catalog, settings, context, state); });
+    }
+  });
+
+  return CancellationToken([context]() mutable { context.CancelOperation(); });
+}
+
+CancellableFuture<WarmupResponse> Warmup(const std::vector<HRN>& catalogs,
+                                         const OlpClientSettings& settings) {
+  auto promise = std::make_shared<std::promise<WarmupResponse>>();
+  auto cancel_token =
+      Warmup(catalogs, settings, [promise](WarmupResponse response) {
+        promise->set_value(std::move(response));
+      });
+  return CancellableFuture<WarmupResponse>(std::move(cancel_token),
+                                           std::move(promise));
+}
+
+}  // namespace client
+}  // namespace olp
@@ -20,11 +20,37 @@
 #include "olp/core/geo/coordinates/GeoRectangle.h"
 
 #include <algorithm>
+#include <initializer_list>
 
 #include "olp/core/math/Math.h"
 
 namespace olp {
 namespace geo {
+namespace {
+
+/// Checks whether a longitude is in the range, the range crosses the date
+/// line if west is greater than east.
+bool ContainsLongitude(double west, double east, double longitude) {
+  if (east >= west) {
+    return longitude >= west && longitude <= east;
+  }
+  return longitude >= west || longitude <= east;
+}
+
+/// Checks whether two longitude ranges given by the west bound and the span
+/// overlap, also when one of them crosses the date line.
+bool OverlapsLongitude(double west, double span, double other_west,
+                       double other_span) {
+  for (const double shift : {-math::two_pi, 0.0, math::two_pi}) {
+    const double shifted_west = other_west + shift;
+    if (west < shifted_west + other_span && shifted_west < west + span) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
 
 /** Constructs an empty rectangle. */
 GeoRectangle::GeoRectangle()
@@ -86,15 +112,24 @@ bool GeoRectangle::Contains(const GeoCoordinates& point) const {
       point.GetLatitude() > north_east_.GetLatitude())
     return false;
 
+  return ContainsLongitude(south_west_.GetLongitude(),
+                           north_east_.GetLongitude(), point.GetLongitude());
+}
+
+std::vector<bool> GeoRectangle::ContainsBatch(
+    const std::vector<GeoCoordinates>& points) const {
+  const double south = south_west_.GetLatitude();
+  const double north = north_east_.GetLatitude();
   const double west = south_west_.GetLongitude();
   const double east = north_east_.GetLongitude();
 
-  if (east > west) {
-    return point.GetLongitude() >= west && point.GetLongitude() <= east;
+  std::vector<bool> result(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto& point = points[i];
+    result[i] = point.GetLatitude() >= south && point.GetLatitude() <= north &&
+                ContainsLongitude(west, east, point.GetLongitude());
   }
-
-  // this code handles rectangle crossing 180 meridian
-  return point.GetLongitude() >= east || point.GetLongitude() <= west;
+  return result;
 }
 
 bool GeoRectangle::Overlaps(const GeoRectangle& rectangle) const {
@@ -103,21 +138,28 @@ bool GeoRectangle::Overlaps(const GeoRectangle& rectangle) const {
     return false;
   }
 
-  double west = south_west_.GetLongitude();
-  double east = north_east_.GetLongitude();
-
-  if (west >= east) {
-    east = west + LatitudeSpan();
-  }
-
-  double rectangle_west = rectangle.south_west_.GetLongitude();
-  double rectangle_east = rectangle.north_east_.GetLongitude();
+  return OverlapsLongitude(south_west_.GetLongitude(), LongitudeSpan(),
+                           rectangle.south_west_.GetLongitude(),
+                           rectangle.LongitudeSpan());
+}
 
-  if (rectangle_west >= rectangle_east) {
-    rectangle_east = rectangle_west + rectangle.LatitudeSpan();
+std::vector<bool> GeoRectangle::OverlapsBatch(
+    const std::vector<GeoRectangle>& rectangles) const {
+  const double south = south_west_.GetLatitude();
+  const double north = north_east_.GetLatitude();
+  const double west = south_west_.GetLongitude();
+  const double span = LongitudeSpan();
+
+  std::vector<bool> result(rectangles.size());
+  for (size_t i = 0; i < rectangles.size(); ++i) {
+    const auto& rectangle = rectangles[i];
+    result[i] = south < rectangle.north_east_.GetLatitude() &&
+                rectangle.south_west_.GetLatitude() < north &&
+                OverlapsLongitude(west, span,
+                                  rectangle.south_west_.GetLongitude(),
+                                  rectangle.LongitudeSpan());
   }
-
-  return !(west >= rectangle_east || rectangle_west >= east);
+  return result;
 }
 
 GeoRectangle GeoRectangle::BooleanUnion(const GeoRectangle& other) const {
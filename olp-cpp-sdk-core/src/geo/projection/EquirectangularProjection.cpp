@@ -19,6 +19,8 @@
 
 #include "olp/core/geo/projection/EquirectangularProjection.h"
 
+#include <algorithm>
+
 #include "olp/core/geo/Types.h"
 #include "olp/core/geo/coordinates/GeoCoordinates3d.h"
 #include "olp/core/geo/coordinates/GeoRectangle.h"
@@ -66,5 +68,34 @@ bool EquirectangularProjection::Unproject(const WorldCoordinates& world_point,
   return true;
 }
 
+bool EquirectangularProjection::ProjectPoints(const double* latitudes,
+                                              const double* longitudes,
+                                              const double* altitudes,
+                                              std::size_t count, double* x,
+                                              double* y, double* z) const {
+  // Plain arithmetic on the separate arrays, which the compiler vectorizes.
+  for (std::size_t index = 0; index < count; ++index) {
+    x[index] = (longitudes[index] + math::pi) * kGeoToWorldScale;
+  }
+  for (std::size_t index = 0; index < count; ++index) {
+    y[index] = (latitudes[index] + math::half_pi) * kGeoToWorldScale;
+  }
+  std::copy(altitudes, altitudes + count, z);
+  return true;
+}
+
+bool EquirectangularProjection::UnprojectPoints(
+    const double* x, const double* y, const double* z, std::size_t count,
+    double* latitudes, double* longitudes, double* altitudes) const {
+  for (std::size_t index = 0; index < count; ++index) {
+    latitudes[index] = y[index] * kWorldToGeoScale - math::half_pi;
+  }
+  for (std::size_t index = 0; index < count; ++index) {
+    longitudes[index] = x[index] * kWorldToGeoScale - math::pi;
+  }
+  std::copy(z, z + count, altitudes);
+  return true;
+}
+
 }  // namespace geo
 }  // namespace olp
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/geo/projection/IProjection.h"
+
+#include "olp/core/geo/coordinates/GeoCoordinates3d.h"
+#include "olp/core/math/Vector.h"
+
+namespace olp {
+namespace geo {
+
+bool IProjection::ProjectPoints(const double* latitudes,
+                                const double* longitudes,
+                                const double* altitudes, std::size_t count,
+                                double* x, double* y, double* z) const {
+  bool result = true;
+  for (std::size_t index = 0; index < count; ++index) {
+    WorldCoordinates world_point;
+    result &= Project(GeoCoordinates3d(latitudes[index], longitudes[index],
+                                       altitudes[index]),
+                      world_point);
+    x[index] = world_point.x;
+    y[index] = world_point.y;
+    z[index] = world_point.z;
+  }
+  return result;
+}
+
+bool IProjection::UnprojectPoints(const double* x, const double* y,
+                                  const double* z, std::size_t count,
+                                  double* latitudes, double* longitudes,
+                                  double* altitudes) const {
+  bool result = true;
+  for (std::size_t index = 0; index < count; ++index) {
+    GeoCoordinates3d geo_point;
+    result &= Unproject(WorldCoordinates(x[index], y[index], z[index]),
+                        geo_point);
+    latitudes[index] = geo_point.GetLatitude();
+    longitudes[index] = geo_point.GetLongitude();
+    altitudes[index] = geo_point.GetAltitude();
+  }
+  return result;
+}
+
+}  // namespace geo
+}  // namespace olp
@@ -19,6 +19,8 @@
 
 #include <olp/core/geo/projection/WebMercatorProjection.h>
 
+#include <algorithm>
+
 #include <olp/core/geo/coordinates/GeoCoordinates.h>
 #include <olp/core/geo/coordinates/GeoCoordinates3d.h>
 #include <olp/core/geo/coordinates/GeoRectangle.h>
@@ -53,19 +55,39 @@ double projectClampLatitude(double latitude) {
 // TODO: Clamping makes the projection non-invertible
 double unprojectLatitude(double y) { return 2.0 * atan(exp(pi * y)) - half_pi; }
 
-Vector3d toWorld(const GeoCoordinates3d& geo_coords) {
-  const GeoCoordinates normalized = geo_coords.GetGeoCoordinates().Normalized();
+// The point versions work on plain doubles, so that the batch loops do not
+// create the coordinate objects.
+void toWorld(double latitude, double longitude, double& x, double& y) {
+  // The same as GeoCoordinates::Normalized().
+  if (!isnan(latitude) && !isnan(longitude)) {
+    latitude = Clamp(latitude, -half_pi, half_pi);
+    longitude = Wrap(longitude, -pi, pi);
+  }
+
+  const double c = EarthConstants::EquatorialCircumference();
+  x = (longitude + pi) / (2 * pi) * c;
+  y = (0.5 * (projectClampLatitude(latitude) + 1)) * c;
+}
+
+void toGeodetic(double x, double y, double& latitude, double& longitude) {
   const double c = EarthConstants::EquatorialCircumference();
+  latitude = unprojectLatitude(2 * (y / c - 0.5));
+  longitude = (2 * (x / c) - 1) * pi;
+}
 
-  return {(normalized.GetLongitude() + pi) / (2 * pi) * c,
-          (0.5 * (projectClampLatitude(normalized.GetLatitude()) + 1)) * c,
-          geo_coords.GetAltitude()};
+Vector3d toWorld(const GeoCoordinates3d& geo_coords) {
+  Vector3d point;
+  toWorld(geo_coords.GetLatitude(), geo_coords.GetLongitude(), point.x,
+          point.y);
+  point.z = geo_coords.GetAltitude();
+  return point;
 }
 
 GeoCoordinates3d toGeodetic(const Vector3d& point) {
-  const double c = EarthConstants::EquatorialCircumference();
-  return {unprojectLatitude(2 * (point.y / c - 0.5)),
-          (2 * (point.x / c) - 1) * pi, point.z};
+  double latitude;
+  double longitude;
+  toGeodetic(point.x, point.y, latitude, longitude);
+  return {latitude, longitude, point.z};
 }
 }  // namespace
 
@@ -96,5 +118,30 @@ bool WebMercatorProjection::Unproject(const WorldCoordinates& world_point,
   return true;
 }
 
+bool WebMercatorProjection::ProjectPoints(const double* latitudes,
+                                          const double* longitudes,
+                                          const double* altitudes,
+                                          std::size_t count, double* x,
+                                          double* y, double* z) const {
+  for (std::size_t index = 0; index < count; ++index) {
+    toWorld(latitudes[index], longitudes[index], x[index], y[index]);
+  }
+  std::copy(altitudes, altitudes + count, z);
+  return true;
+}
+
+bool WebMercatorProjection::UnprojectPoints(const double* x, const double* y,
+                                            const double* z,
+                                            std::size_t count,
+                                            double* latitudes,
+                                            double* longitudes,
+                                            double* altitudes) const {
+  for (std::size_t index = 0; index < count; ++index) {
+    toGeodetic(x[index], y[index], latitudes[index], longitudes[index]);
+  }
+  std::copy(z, z + count, altitudes);
+  return true;
+}
+
 }  // namespace geo
 }  // namespace olp
@@ -19,8 +19,15 @@
 
 #include "olp/core/geo/tiling/TileKeyUtils.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "olp/core/geo/coordinates/GeoCoordinates.h"
 #include "olp/core/geo/coordinates/GeoCoordinates3d.h"
 #include "olp/core/geo/coordinates/GeoRectangle.h"
@@ -33,6 +40,152 @@
 
 namespace olp {
 namespace geo {
+namespace {
+
+/// The tiles of a level that overlap a rectangle. The maximum column may
+/// exceed the column count if the rectangle crosses the date line.
+struct TileRange {
+  std::uint32_t min_row;
+  std::uint32_t max_row;
+  std::uint32_t min_column;
+  std::uint32_t max_column;
+  std::uint32_t column_count;
+  std::uint32_t row_count;
+};
+
+/// A point in the tile units of a level.
+struct TilePoint {
+  double x;
+  double y;
+};
+
+boost::optional<TileRange> GetTileRange(const ITilingScheme& tiling_scheme,
+                                        const GeoRectangle& geo_rectangle,
+                                        std::uint32_t level) {
+  if (geo_rectangle.IsEmpty()) {
+    return boost::none;
+  }
+
+  GeoCoordinates south_west = geo_rectangle.SouthWest();
+  GeoCoordinates north_east = geo_rectangle.NorthEast();
+
+  // Clamp at the poles and wrap around the international date line.
+  south_west.SetLongitude(
+      math::Wrap(south_west.GetLongitude(), -math::pi, math::pi));
+  south_west.SetLatitude(
+      math::Clamp(south_west.GetLatitude(), -math::half_pi, math::half_pi));
+
+  north_east.SetLongitude(
+      math::Wrap(north_east.GetLongitude(), -math::pi, math::pi));
+  north_east.SetLatitude(
+      math::Clamp(north_east.GetLatitude(), -math::half_pi, math::half_pi));
+
+  const TileKey min_tile_key =
+      TileKeyUtils::GeoCoordinatesToTileKey(tiling_scheme, south_west, level);
+  const TileKey max_tile_key =
+      TileKeyUtils::GeoCoordinatesToTileKey(tiling_scheme, north_east, level);
+
+  const auto& level_size =
+      tiling_scheme.GetSubdivisionScheme().GetLevelSize(level);
+
+  TileRange range;
+  range.min_row = min_tile_key.Row();
+  range.max_row = max_tile_key.Row();
+  range.min_column = min_tile_key.Column();
+  range.max_column = max_tile_key.Column();
+  range.column_count = level_size.Width();
+  range.row_count = level_size.Height();
+
+  // wrap around case
+  if (south_west.GetLongitude() > north_east.GetLongitude()) {
+    if (range.max_column != range.min_column) {
+      range.max_column += range.column_count;
+    } else {
+      range.max_column += range.column_count - 1;
+    }
+  }
+
+  return range;
+}
+
+void ForEachTileKey(const TileRange& range, std::uint32_t level,
+                    const TileKeyUtils::TileKeyCallback& callback) {
+  for (uint32_t row = range.min_row; row <= range.max_row; ++row) {
+    for (uint32_t column = range.min_column; column <= range.max_column;
+         ++column) {
+      callback(
+          TileKey::FromRowColumnLevel(row, column % range.column_count, level));
+    }
+  }
+}
+
+/// Adds the tile if all of its children at the range level are in the
+/// range, otherwise adds its children that overlap the range.
+void AddCoveringTileKeys(const TileRange& range, std::uint32_t level,
+                         const TileKey& tile_key, std::vector<TileKey>& keys) {
+  const auto delta = level - tile_key.Level();
+  const std::int64_t first_row = std::int64_t{tile_key.Row()} << delta;
+  const std::int64_t last_row =
+      std::min<std::int64_t>(((std::int64_t{tile_key.Row()} + 1) << delta) - 1,
+                             range.row_count - 1);
+  const std::int64_t first_column = std::int64_t{tile_key.Column()} << delta;
+  const std::int64_t last_column =
+      ((std::int64_t{tile_key.Column()} + 1) << delta) - 1;
+
+  if (first_row > last_row || last_row < range.min_row ||
+      first_row > range.max_row) {
+    return;
+  }
+
+  // The columns past the date line are checked shifted by a world width.
+  bool overlaps = false;
+  bool contained = false;
+  for (int wrap = 0; wrap < 2; ++wrap) {
+    const std::int64_t shift = wrap * std::int64_t{range.column_count};
+    const std::int64_t min_column = range.min_column - shift;
+    const std::int64_t max_column = range.max_column - shift;
+    overlaps |= first_column <= max_column && last_column >= min_column;
+    contained |= first_column >= min_column && last_column <= max_column;
+  }
+
+  if (!overlaps) {
+    return;
+  }
+
+  contained &= first_row >= range.min_row && last_row <= range.max_row;
+  if (contained || delta == 0) {
+    keys.push_back(tile_key);
+    return;
+  }
+
+  for (std::uint8_t index = 0; index < 4; ++index) {
+    AddCoveringTileKeys(range, level, tile_key.GetChild(index), keys);
+  }
+}
+
+bool ProjectToTiles(const ITilingScheme& tiling_scheme,
+                    const GeoCoordinates& coordinates, std::uint32_t level,
+                    TilePoint& point) {
+  WorldCoordinates world_point;
+  const IProjection& projection = tiling_scheme.GetProjection();
+  if (!projection.Project(GeoCoordinates3d(coordinates, 0), world_point)) {
+    return false;
+  }
+
+  const auto& level_size =
+      tiling_scheme.GetSubdivisionScheme().GetLevelSize(level);
+  const WorldAlignedBox world_box = projection.WorldExtent(0, 0);
+  const auto& world_size = world_box.Size();
+  const auto& world_box_min = world_box.Minimum();
+
+  point.x = level_size.Width() * (world_point.x - world_box_min.x) /
+            world_size.x;
+  point.y = level_size.Height() * (world_point.y - world_box_min.y) /
+            world_size.y;
+  return true;
+}
+
+}  // namespace
 
 TileKey TileKeyUtils::GeoCoordinatesToTileKey(
     const ITilingScheme& tiling_scheme, const GeoCoordinates& geo_point,
@@ -74,55 +227,194 @@ TileKey TileKeyUtils::GeoCoordinatesToTileKey(
 std::vector<TileKey> TileKeyUtils::GeoRectangleToTileKeys(
     const ITilingScheme& tiling_scheme, const GeoRectangle& geo_rectangle,
     const std::uint32_t level) {
-  if (geo_rectangle.IsEmpty()) {
-    return std::vector<TileKey>();
+  std::vector<TileKey> keys;
+  const auto range = GetTileRange(tiling_scheme, geo_rectangle, level);
+  if (!range) {
+    return keys;
   }
 
-  GeoCoordinates south_west = geo_rectangle.SouthWest();
-  GeoCoordinates north_east = geo_rectangle.NorthEast();
-
-  // Clamp at the poles and wrap around the international date line.
-  south_west.SetLongitude(
-      math::Wrap(south_west.GetLongitude(), -math::pi, math::pi));
-  south_west.SetLatitude(
-      math::Clamp(south_west.GetLatitude(), -math::half_pi, math::half_pi));
+  keys.reserve(static_cast<size_t>(range->max_row - range->min_row + 1) *
+               (range->max_column - range->min_column + 1));
+  ForEachTileKey(*range, level,
+                 [&](const TileKey& key) { keys.push_back(key); });
+  return keys;
+}
 
-  north_east.SetLongitude(
-      math::Wrap(north_east.GetLongitude(), -math::pi, math::pi));
-  north_east.SetLatitude(
-      math::Clamp(north_east.GetLatitude(), -math::half_pi, math::half_pi));
+void TileKeyUtils::GeoRectangleToTileKeys(const ITilingScheme& tiling_scheme,
+                                          const GeoRectangle& geo_rectangle,
+                                          const std::uint32_t level,
+                                          const TileKeyCallback& callback) {
+  const auto range = GetTileRange(tiling_scheme, geo_rectangle, level);
+  if (range) {
+    ForEachTileKey(*range, level, callback);
+  }
+}
 
-  const TileKey min_tile_key =
-      GeoCoordinatesToTileKey(tiling_scheme, south_west, level);
-  const TileKey max_tile_key =
-      GeoCoordinatesToTileKey(tiling_scheme, north_east, level);
+std::vector<bool> TileKeyUtils::OverlapsGeoRectangle(
+    const ITilingScheme& tiling_scheme, const std::vector<TileKey>& tile_keys,
+    const GeoRectangle& geo_rectangle) {
+  // The ranges are calculated on the first tile of the level.
+  std::array<boost::optional<TileRange>, TileKey::LevelCount> ranges;
+  TileKeyLevels resolved_levels;
 
-  const uint32_t column_count =
-      tiling_scheme.GetSubdivisionScheme().GetLevelSize(level).Width();
+  std::vector<bool> result(tile_keys.size());
+  for (size_t i = 0; i < tile_keys.size(); ++i) {
+    const auto& tile_key = tile_keys[i];
+    const auto level = tile_key.Level();
+    if (!tile_key.IsValid()) {
+      continue;
+    }
 
-  const uint32_t min_column = min_tile_key.Column();
-  uint32_t max_column = max_tile_key.Column();
+    if (!resolved_levels.test(level)) {
+      ranges[level] = GetTileRange(tiling_scheme, geo_rectangle, level);
+      resolved_levels.set(level);
+    }
 
-  // wrap around case
-  if (south_west.GetLongitude() > north_east.GetLongitude()) {
-    if (max_column != min_column) {
-      max_column += column_count;
-    } else {
-      max_column += column_count - 1;
+    const auto& range = ranges[level];
+    if (!range || tile_key.Row() < range->min_row ||
+        tile_key.Row() > range->max_row) {
+      continue;
     }
+
+    // The columns past the date line are checked shifted by a world width.
+    const auto column = tile_key.Column();
+    result[i] =
+        (column >= range->min_column && column <= range->max_column) ||
+        (column + range->column_count >= range->min_column &&
+         column + range->column_count <= range->max_column);
   }
+  return result;
+}
 
+std::vector<TileKey> TileKeyUtils::GeoRectangleToCoveringTileKeys(
+    const ITilingScheme& tiling_scheme, const GeoRectangle& geo_rectangle,
+    const std::uint32_t min_level, const std::uint32_t max_level) {
   std::vector<TileKey> keys;
-  for (uint32_t row = min_tile_key.Row(); row <= max_tile_key.Row(); ++row) {
-    for (uint32_t column = min_column; column <= max_column; ++column) {
-      keys.push_back(
-          TileKey::FromRowColumnLevel(row, column % column_count, level));
+  if (min_level > max_level) {
+    return keys;
+  }
+
+  const auto range = GetTileRange(tiling_scheme, geo_rectangle, max_level);
+  if (!range) {
+    return keys;
+  }
+
+  const auto& subdivision_scheme = tiling_scheme.GetSubdivisionScheme();
+  const std::uint32_t delta = max_level - min_level;
+  const std::uint32_t column_count =
+      subdivision_scheme.GetLevelSize(min_level).Width();
+  const std::uint32_t min_column = range->min_column >> delta;
+  // The range spans at most once around the world, but its both ends may
+  // fall into the same tile at the lower level.
+  const std::uint32_t max_column =
+      std::min(range->max_column >> delta, min_column + column_count - 1);
+
+  for (std::uint32_t row = range->min_row >> delta;
+       row <= (range->max_row >> delta); ++row) {
+    for (std::uint32_t column = min_column; column <= max_column; ++column) {
+      AddCoveringTileKeys(
+          *range, max_level,
+          TileKey::FromRowColumnLevel(row, column % column_count, min_level),
+          keys);
     }
   }
 
   return keys;
 }
 
+void TileKeyUtils::GeoPolygonToTileKeys(
+    const ITilingScheme& tiling_scheme,
+    const std::vector<GeoCoordinates>& polygon, const std::uint32_t level,
+    const TileKeyCallback& callback) {
+  if (polygon.size() < 3) {
+    return;
+  }
+
+  const auto& level_size =
+      tiling_scheme.GetSubdivisionScheme().GetLevelSize(level);
+  const auto column_count = level_size.Width();
+  const auto row_count = level_size.Height();
+
+  std::vector<TilePoint> points;
+  points.reserve(polygon.size());
+  for (const auto& coordinates : polygon) {
+    TilePoint point;
+    if (!ProjectToTiles(tiling_scheme, coordinates, level, point)) {
+      return;
+    }
+    points.push_back(point);
+  }
+
+  auto min_y = points.front().y;
+  auto max_y = points.front().y;
+  for (const auto& point : points) {
+    min_y = std::min(min_y, point.y);
+    max_y = std::max(max_y, point.y);
+  }
+
+  const auto first_row = static_cast<std::uint32_t>(std::max(min_y, 0.0));
+  const auto last_row = std::min(
+      row_count - 1, static_cast<std::uint32_t>(std::max(max_y, 0.0)));
+
+  std::vector<std::pair<double, double>> spans;
+  std::vector<double> crossings;
+  for (std::uint32_t row = first_row; row <= last_row; ++row) {
+    const double band_min = row;
+    const double band_max = row + 1.0;
+    const double middle = row + 0.5;
+
+    // A point of the polygon inside the row either is on the edge clipped to
+    // the row, or can be connected to the middle line without crossing an
+    // edge, so it is inside of a span of the middle line.
+    spans.clear();
+    crossings.clear();
+    for (size_t index = 0; index < points.size(); ++index) {
+      const auto& a = points[index];
+      const auto& b = points[(index + 1) % points.size()];
+      const auto edge_min_y = std::min(a.y, b.y);
+      const auto edge_max_y = std::max(a.y, b.y);
+      if (edge_max_y < band_min || edge_min_y > band_max) {
+        continue;
+      }
+
+      if (a.y == b.y) {
+        spans.emplace_back(std::min(a.x, b.x), std::max(a.x, b.x));
+        continue;
+      }
+
+      const auto x_at = [&](double y) {
+        return a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+      };
+      const auto x1 = x_at(std::max(edge_min_y, band_min));
+      const auto x2 = x_at(std::min(edge_max_y, band_max));
+      spans.emplace_back(std::min(x1, x2), std::max(x1, x2));
+
+      if ((a.y > middle) != (b.y > middle)) {
+        crossings.push_back(x_at(middle));
+      }
+    }
+
+    std::sort(crossings.begin(), crossings.end());
+    for (size_t index = 0; index + 1 < crossings.size(); index += 2) {
+      spans.emplace_back(crossings[index], crossings[index + 1]);
+    }
+
+    std::sort(spans.begin(), spans.end());
+    std::int64_t next_column = 0;
+    for (const auto& span : spans) {
+      const auto first = std::max<std::int64_t>(
+          next_column, static_cast<std::int64_t>(std::floor(span.first)));
+      const auto last = std::min<std::int64_t>(
+          column_count - 1, static_cast<std::int64_t>(std::floor(span.second)));
+      for (auto column = first; column <= last; ++column) {
+        callback(TileKey::FromRowColumnLevel(
+            row, static_cast<std::uint32_t>(column), level));
+      }
+      next_column = std::max(next_column, last + 1);
+    }
+  }
+}
+
 geo::TileKey TileKeyUtils::GetRelativeSubTileKey(const geo::TileKey& key,
                                                  std::uint32_t parent_level) {
   auto origin_key =
@@ -161,5 +453,44 @@ math::AlignedBox3d CalculateTileBox(const ITilingScheme& tiling_scheme,
   return {min, max};
 }
 
+std::vector<math::AlignedBox3d> CalculateTileBoxes(
+    const ITilingScheme& tiling_scheme, const std::vector<TileKey>& tile_keys) {
+  static constexpr double kZeroAlt = 0;
+  const auto& subdiv_scheme = tiling_scheme.GetSubdivisionScheme();
+  const auto& projection = tiling_scheme.GetProjection();
+
+  const auto world_bounds = projection.WorldExtent(kZeroAlt, kZeroAlt);
+  const auto world_min = world_bounds.Minimum();
+  const auto world_size = world_bounds.Size();
+
+  // The tile sizes are calculated on the first tile of the level.
+  std::array<WorldCoordinates, TileKey::LevelCount> tile_sizes;
+  tile_sizes.fill(WorldCoordinates(0.0));
+
+  std::vector<math::AlignedBox3d> boxes;
+  boxes.reserve(tile_keys.size());
+  for (const auto& tile_key : tile_keys) {
+    const auto level = tile_key.Level();
+    if (level >= TileKey::LevelCount) {
+      boxes.push_back(CalculateTileBox(tiling_scheme, tile_key));
+      continue;
+    }
+
+    auto& tile_size = tile_sizes[level];
+    if (tile_size.x == 0.0) {
+      const auto level_size = subdiv_scheme.GetLevelSize(level);
+      tile_size = WorldCoordinates{world_size.x / level_size.Width(),
+                                   world_size.y / level_size.Height(), 0};
+    }
+
+    const auto min =
+        world_min + WorldCoordinates{tile_key.Column() * tile_size.x,
+                                     tile_key.Row() * tile_size.y, 0};
+    boxes.emplace_back(min, min + tile_size);
+  }
+
+  return boxes;
+}
+
 }  // namespace geo
 }  // namespace olp
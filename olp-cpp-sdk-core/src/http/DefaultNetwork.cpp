@@ -26,6 +26,13 @@
 
 namespace olp {
 namespace http {
+namespace {
+bool IsFailed(const NetworkResponse& response) {
+  const auto status = response.GetStatus();
+  return status < HttpStatusCode::OK || status >= HttpStatusCode::BAD_REQUEST;
+}
+}  // namespace
+
 DefaultNetwork::DefaultNetwork(std::shared_ptr<Network> network)
     : current_statistics_bucket_{0}, network_{std::move(network)} {}
 
@@ -35,27 +42,62 @@ SendOutcome DefaultNetwork::Send(NetworkRequest request, Payload payload,
                                  Callback callback,
                                  HeaderCallback header_callback,
                                  DataCallback data_callback) {
+  std::shared_ptr<const DefaultHeaders> defaults;
   {
+    std::lock_guard<std::mutex> lock(default_headers_mutex_);
+    defaults = default_headers_;
+  }
+
+  if (defaults) {
     auto& request_headers = request.GetMutableHeaders();
+    request_headers.reserve(request_headers.size() +
+                            defaults->headers.size() + 1u);
+    AppendUserAgent(*defaults, request_headers);
+    AppendDefaultHeaders(*defaults, request_headers);
+  }
 
-    std::unique_lock<std::mutex> lock(default_headers_mutex_);
-    AppendUserAgent(request_headers);
-    AppendDefaultHeaders(request_headers);
+  // Backends that cannot filter the response headers themselves pass all of
+  // them, so the filter is applied here as well.
+  const auto& header_filter = request.GetSettings().GetResponseHeaderFilter();
+  if (header_callback && !header_filter.empty()) {
+    header_callback = [header_filter, header_callback](
+                          const std::string& key, const std::string& value) {
+      const bool accepted = std::any_of(
+          header_filter.begin(), header_filter.end(),
+          [&](const std::string& name) {
+            return NetworkUtils::CaseInsensitiveCompare(key, name);
+          });
+      if (accepted) {
+        header_callback(key, value);
+      }
+    };
   }
 
   const auto bucket_id = current_statistics_bucket_.load();
+  const auto tag_counters =
+      request.GetTag().empty() ? nullptr : GetTagCounters(request.GetTag());
 
   auto user_callback = [=](NetworkResponse response) {
+    if (tag_counters) {
+      AddResponse(*tag_counters, response);
+    }
+
     LockStatistics(bucket_id, [&](Statistics& stats) {
-      const auto status = response.GetStatus();
-      if (status < HttpStatusCode::OK ||
-          status >= HttpStatusCode::BAD_REQUEST) {
+      if (IsFailed(response)) {
         stats.total_failed++;
       }
 
       stats.total_requests++;
       stats.bytes_downloaded += response.GetBytesDownloaded();
       stats.bytes_uploaded += response.GetBytesUploaded();
+      stats.bytes_decoded += response.GetBytesDecoded();
+
+      const auto& timings = response.GetTimings();
+      stats.timings.dns += timings.dns;
+      stats.timings.connect += timings.connect;
+      stats.timings.tls += timings.tls;
+      stats.timings.time_to_first_byte += timings.time_to_first_byte;
+      stats.timings.total += timings.total;
     });
 
     if (callback) {
@@ -70,14 +112,34 @@ SendOutcome DefaultNetwork::Send(NetworkRequest request, Payload payload,
 
 void DefaultNetwork::Cancel(RequestId id) { network_->Cancel(id); }
 
+void DefaultNetwork::PreResolve(const std::vector<std::string>& urls) {
+  network_->PreResolve(urls);
+}
+
+void DefaultNetwork::SetPriority(RequestId id, uint32_t priority) {
+  network_->SetPriority(id, priority);
+}
+
 void DefaultNetwork::SetDefaultHeaders(Headers headers) {
-  std::unique_lock<std::mutex> lock(default_headers_mutex_);
-  default_headers_ = std::move(headers);
-  user_agent_ = NetworkUtils::ExtractUserAgent(default_headers_);
+  auto defaults = std::make_shared<DefaultHeaders>();
+  defaults->user_agent = NetworkUtils::ExtractUserAgent(headers);
+  defaults->headers = std::move(headers);
+  if (defaults->headers.empty() && defaults->user_agent.empty()) {
+    defaults.reset();
+  }
+
+  std::lock_guard<std::mutex> lock(default_headers_mutex_);
+  default_headers_ = std::move(defaults);
 }
 
 void DefaultNetwork::SetCurrentBucket(uint8_t bucket_id) {
   current_statistics_bucket_.store(bucket_id);
+  network_->SetCurrentBucket(bucket_id);
+}
+
+void DefaultNetwork::SetBandwidthLimit(uint8_t bucket_id,
+                                       uint64_t bytes_per_second) {
+  network_->SetBandwidthLimit(bucket_id, bytes_per_second);
 }
 
 DefaultNetwork::Statistics DefaultNetwork::GetStatistics(uint8_t bucket_id) {
@@ -87,8 +149,33 @@ DefaultNetwork::Statistics DefaultNetwork::GetStatistics(uint8_t bucket_id) {
   return result;
 }
 
-void DefaultNetwork::AppendUserAgent(Headers& request_headers) const {
-  if (user_agent_.empty()) {
+std::map<std::string, DefaultNetwork::Statistics>
+DefaultNetwork::GetTaggedStatistics() {
+  std::map<std::string, Statistics> result;
+  std::lock_guard<std::mutex> lock(tags_mutex_);
+  for (const auto& tag : tags_) {
+    const auto& counters = *tag.second;
+    auto& stats = result[tag.first];
+    stats.bytes_downloaded = counters.bytes_downloaded.load();
+    stats.bytes_uploaded = counters.bytes_uploaded.load();
+    stats.bytes_decoded = counters.bytes_decoded.load();
+    stats.total_requests = counters.total_requests.load();
+    stats.total_failed = counters.total_failed.load();
+    stats.timings.dns = std::chrono::microseconds(counters.dns_us.load());
+    stats.timings.connect =
+        std::chrono::microseconds(counters.connect_us.load());
+    stats.timings.tls = std::chrono::microseconds(counters.tls_us.load());
+    stats.timings.time_to_first_byte =
+        std::chrono::microseconds(counters.time_to_first_byte_us.load());
+    stats.timings.total = std::chrono::microseconds(counters.total_us.load());
+  }
+  return result;
+}
+
+void DefaultNetwork::AppendUserAgent(const DefaultHeaders& defaults,
+                                     Headers& request_headers) {
+  const auto& user_agent = defaults.user_agent;
+  if (user_agent.empty()) {
     return;
   }
   auto user_agent_it =
@@ -99,15 +186,47 @@ void DefaultNetwork::AppendUserAgent(Headers& request_headers) const {
                    });
 
   if (user_agent_it != std::end(request_headers)) {
-    user_agent_it->second.append(" ").append(user_agent_);
+    user_agent_it->second.append(" ").append(user_agent);
   } else {
-    request_headers.emplace_back(kUserAgentHeader, user_agent_);
+    request_headers.emplace_back(kUserAgentHeader, user_agent);
   }
 }
 
-void DefaultNetwork::AppendDefaultHeaders(Headers& request_headers) const {
-  request_headers.insert(request_headers.end(), default_headers_.begin(),
-                         default_headers_.end());
+void DefaultNetwork::AppendDefaultHeaders(const DefaultHeaders& defaults,
+                                          Headers& request_headers) {
+  request_headers.insert(request_headers.end(), defaults.headers.begin(),
+                         defaults.headers.end());
+}
+
+void DefaultNetwork::AddResponse(TagCounters& counters,
+                                 const NetworkResponse& response) {
+  const auto order = std::memory_order_relaxed;
+  if (IsFailed(response)) {
+    counters.total_failed.fetch_add(1u, order);
+  }
+
+  counters.total_requests.fetch_add(1u, order);
+  counters.bytes_downloaded.fetch_add(response.GetBytesDownloaded(), order);
+  counters.bytes_uploaded.fetch_add(response.GetBytesUploaded(), order);
+  counters.bytes_decoded.fetch_add(response.GetBytesDecoded(), order);
+
+  const auto& timings = response.GetTimings();
+  counters.dns_us.fetch_add(timings.dns.count(), order);
+  counters.connect_us.fetch_add(timings.connect.count(), order);
+  counters.tls_us.fetch_add(timings.tls.count(), order);
+  counters.time_to_first_byte_us.fetch_add(
+      timings.time_to_first_byte.count(), order);
+  counters.total_us.fetch_add(timings.total.count(), order);
+}
+
+std::shared_ptr<DefaultNetwork::TagCounters> DefaultNetwork::GetTagCounters(
+    const std::string& tag) {
+  std::lock_guard<std::mutex> lock(tags_mutex_);
+  auto& counters = tags_[tag];
+  if (!counters) {
+    counters = std::make_shared<TagCounters>();
+  }
+  return counters;
 }
 
 void DefaultNetwork::LockStatistics(uint8_t bucket_id,
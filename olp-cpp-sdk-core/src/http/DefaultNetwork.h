@@ -20,8 +20,12 @@
 #pragma once
 
 #include <atomic>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <olp/core/CoreApi.h>
 #include <olp/core/http/Network.h>
@@ -64,9 +68,50 @@ class DefaultNetwork final : public Network {
   /// Implements the `GetStatistics` method of the `Network` class.
   Statistics GetStatistics(uint8_t bucket_id) override;
 
+  /// Implements the `GetTaggedStatistics` method of the `Network` class.
+  std::map<std::string, Statistics> GetTaggedStatistics() override;
+
+  /// Implements the `SetBandwidthLimit` method of the `Network` class.
+  void SetBandwidthLimit(uint8_t bucket_id, uint64_t bytes_per_second) override;
+
+  /// Implements the `PreResolve` method of the `Network` class.
+  void PreResolve(const std::vector<std::string>& urls) override;
+
+  /// Implements the `SetPriority` method of the `Network` class.
+  void SetPriority(RequestId id, uint32_t priority) override;
+
  private:
-  void AppendUserAgent(Headers& request_headers) const;
-  void AppendDefaultHeaders(Headers& request_headers) const;
+  /// The default headers, replaced as a whole, so the requests share them
+  /// without holding the lock while the headers are appended.
+  struct DefaultHeaders {
+    Headers headers;
+    std::string user_agent;
+  };
+
+  static void AppendUserAgent(const DefaultHeaders& defaults,
+                              Headers& request_headers);
+  static void AppendDefaultHeaders(const DefaultHeaders& defaults,
+                                   Headers& request_headers);
+
+  /// The statistics of a tag. The counters are updated without a lock when
+  /// the requests complete, the lock is only taken to find them on `Send`.
+  struct TagCounters {
+    std::atomic<uint64_t> bytes_downloaded{0u};
+    std::atomic<uint64_t> bytes_uploaded{0u};
+    std::atomic<uint64_t> bytes_decoded{0u};
+    std::atomic<uint32_t> total_requests{0u};
+    std::atomic<uint32_t> total_failed{0u};
+    std::atomic<int64_t> dns_us{0};
+    std::atomic<int64_t> connect_us{0};
+    std::atomic<int64_t> tls_us{0};
+    std::atomic<int64_t> time_to_first_byte_us{0};
+    std::atomic<int64_t> total_us{0};
+  };
+
+  static void AddResponse(TagCounters& counters,
+                          const NetworkResponse& response);
+
+  std::shared_ptr<TagCounters> GetTagCounters(const std::string& tag);
 
   void LockStatistics(uint8_t bucket_id,
                       std::function<void(Statistics&)> callback);
@@ -76,9 +121,11 @@ class DefaultNetwork final : public Network {
   using BucketsContainer = std::unordered_map<uint8_t, Statistics>;
   thread::Atomic<BucketsContainer> buckets_;
 
+  std::mutex tags_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<TagCounters>> tags_;
+
   std::mutex default_headers_mutex_;
-  Headers default_headers_;
-  std::string user_agent_;
+  std::shared_ptr<const DefaultHeaders> default_headers_;
 
   std::shared_ptr<Network> network_;
 };
@@ -19,8 +19,14 @@
 
 #include "olp/core/http/Network.h"
 
+#include <utility>
+#include <vector>
+
 #include "http/DefaultNetwork.h"
+#include "http/NetworkScheduler.h"
+#include "http/ShardedNetwork.h"
 #include "olp/core/utils/WarningWorkarounds.h"
+#include "thread/ThreadUtils.h"
 
 #ifdef OLP_SDK_NETWORK_HAS_CURL
 #include "curl/NetworkCurl.h"
@@ -36,16 +42,39 @@ namespace olp {
 namespace http {
 
 namespace {
-std::shared_ptr<Network> CreateDefaultNetworkImpl(size_t max_requests_count) {
+std::shared_ptr<Network> CreateDefaultNetworkImpl(
+    NetworkInitializationSettings settings) {
+  const auto max_requests_count = settings.max_requests_count;
   OLP_SDK_CORE_UNUSED(max_requests_count);
 #ifdef OLP_SDK_NETWORK_HAS_CURL
-  return std::make_shared<NetworkCurl>(max_requests_count);
+  if (settings.worker_count <= 1u) {
+    return std::make_shared<NetworkCurl>(std::move(settings));
+  }
+
+  // Every shard runs its own thread and cURL multi handle.
+  const auto worker_count = settings.worker_count;
+  settings.max_requests_count =
+      (max_requests_count + worker_count - 1u) / worker_count;
+
+  std::vector<std::shared_ptr<Network>> shards;
+  shards.reserve(worker_count);
+  for (size_t i = 0u; i < worker_count; ++i) {
+    auto shard_settings = settings;
+    if (settings.event_loop_affinity.pin_each_thread) {
+      shard_settings.event_loop_affinity.cpus =
+          thread::GetThreadCpus(settings.event_loop_affinity, i);
+      shard_settings.event_loop_affinity.pin_each_thread = false;
+    }
+    shards.push_back(std::make_shared<NetworkCurl>(std::move(shard_settings)));
+  }
+  return std::make_shared<ShardedNetwork>(std::move(shards),
+                                          settings.sharding_policy);
 #elif OLP_SDK_NETWORK_HAS_ANDROID
   return std::make_shared<NetworkAndroid>(max_requests_count);
 #elif OLP_SDK_NETWORK_HAS_IOS
-  return std::make_shared<OLPNetworkIOS>(max_requests_count);
+  return std::make_shared<OLPNetworkIOS>(std::move(settings));
 #elif OLP_SDK_NETWORK_HAS_WINHTTP
-  return std::make_shared<NetworkWinHttp>(max_requests_count);
+  return std::make_shared<NetworkWinHttp>(std::move(settings));
 #else
   static_assert(false, "No default network implementation provided");
 #endif
@@ -60,8 +89,38 @@ Network::Statistics Network::GetStatistics(uint8_t /*bucket_id*/) {
   return Network::Statistics{};
 }
 
+std::map<std::string, Network::Statistics> Network::GetTaggedStatistics() {
+  return {};
+}
+
+void Network::SetBandwidthLimit(uint8_t /*bucket_id*/,
+                                uint64_t /*bytes_per_second*/) {}
+
+void Network::PreResolve(const std::vector<std::string>& /*urls*/) {}
+
+void Network::SetPriority(RequestId /*id*/, uint32_t /*priority*/) {}
+
 std::shared_ptr<Network> CreateDefaultNetwork(size_t max_requests_count) {
-  auto network = CreateDefaultNetworkImpl(max_requests_count);
+  NetworkInitializationSettings settings;
+  settings.max_requests_count = max_requests_count;
+  return CreateDefaultNetwork(std::move(settings));
+}
+
+std::shared_ptr<Network> CreateDefaultNetwork(
+    NetworkInitializationSettings settings) {
+  const auto request_scheduling = settings.request_scheduling;
+  const auto max_requests_count = settings.max_requests_count;
+  const auto max_low_priority_requests = settings.max_low_priority_requests;
+  const auto max_requests_per_host = settings.max_requests_per_host;
+  const auto low_priority_batching_interval =
+      settings.low_priority_batching_interval;
+
+  auto network = CreateDefaultNetworkImpl(std::move(settings));
+  if (network && request_scheduling) {
+    network = std::make_shared<NetworkScheduler>(
+        std::move(network), max_requests_count, max_low_priority_requests,
+        max_requests_per_host, low_priority_batching_interval);
+  }
   if (network) {
     return std::make_shared<DefaultNetwork>(network);
   }
@@ -18,9 +18,15 @@
  */
 #include "olp/core/http/NetworkRequest.h"
 
+#include <fstream>
+#include <mutex>
+#include <utility>
+
 namespace olp {
 namespace http {
 
+const std::int64_t NetworkRequest::kUnknownBodySize = -1;
+
 NetworkRequest::NetworkRequest(std::string url) : url_{std::move(url)} {}
 
 const Headers& NetworkRequest::GetHeaders() const { return headers_; }
@@ -35,6 +41,15 @@ NetworkRequest::RequestBodyType NetworkRequest::GetBody() const {
   return body_;
 }
 
+const NetworkRequest::BodySourceCallback& NetworkRequest::GetBodySource()
+    const {
+  return body_source_;
+}
+
+std::int64_t NetworkRequest::GetBodySourceSize() const {
+  return body_source_size_;
+}
+
 const NetworkSettings& NetworkRequest::GetSettings() const { return settings_; }
 
 NetworkRequest& NetworkRequest::WithHeader(std::string name,
@@ -58,10 +73,63 @@ NetworkRequest& NetworkRequest::WithBody(RequestBodyType body) {
   return *this;
 }
 
+NetworkRequest& NetworkRequest::WithBodySource(BodySourceCallback source,
+                                               std::int64_t size) {
+  body_source_ = std::move(source);
+  body_source_size_ = body_source_ ? size : kUnknownBodySize;
+  return *this;
+}
+
+NetworkRequest& NetworkRequest::WithBodyFile(const std::string& path) {
+  struct File {
+    std::mutex mutex;
+    std::ifstream stream;
+  };
+
+  auto file = std::make_shared<File>();
+  file->stream.open(path, std::ios::binary | std::ios::ate);
+  if (!file->stream.is_open()) {
+    return WithBodySource(
+        [](std::uint64_t, std::uint8_t*, std::size_t) -> std::int64_t {
+          return -1;
+        });
+  }
+
+  const std::int64_t size = file->stream.tellg();
+  return WithBodySource(
+      [file](std::uint64_t offset, std::uint8_t* buffer,
+             std::size_t buffer_size) -> std::int64_t {
+        std::lock_guard<std::mutex> lock(file->mutex);
+        file->stream.clear();
+        file->stream.seekg(static_cast<std::streamoff>(offset));
+        file->stream.read(reinterpret_cast<char*>(buffer),
+                          static_cast<std::streamsize>(buffer_size));
+        if (file->stream.bad()) {
+          return -1;
+        }
+        return file->stream.gcount();
+      },
+      size);
+}
+
 NetworkRequest& NetworkRequest::WithSettings(NetworkSettings settings) {
   settings_ = std::move(settings);
   return *this;
 }
 
+uint32_t NetworkRequest::GetPriority() const { return priority_; }
+
+NetworkRequest& NetworkRequest::WithPriority(uint32_t priority) {
+  priority_ = priority;
+  return *this;
+}
+
+const std::string& NetworkRequest::GetTag() const { return tag_; }
+
+NetworkRequest& NetworkRequest::WithTag(std::string tag) {
+  tag_ = std::move(tag);
+  return *this;
+}
+
 }  // namespace http
 }  // namespace olp
@@ -65,5 +65,19 @@ NetworkResponse& NetworkResponse::WithBytesDownloaded(
   return *this;
 }
 
+uint64_t NetworkResponse::GetBytesDecoded() const { return bytes_decoded_; }
+
+NetworkResponse& NetworkResponse::WithBytesDecoded(uint64_t bytes_decoded) {
+  bytes_decoded_ = bytes_decoded;
+  return *this;
+}
+
+const NetworkTimings& NetworkResponse::GetTimings() const { return timings_; }
+
+NetworkResponse& NetworkResponse::WithTimings(NetworkTimings timings) {
+  timings_ = timings;
+  return *this;
+}
+
 }  // namespace http
 }  // namespace olp
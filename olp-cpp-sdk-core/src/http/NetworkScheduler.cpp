@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "NetworkScheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "olp/core/http/NetworkUtils.h"
+#include "olp/core/thread/TaskScheduler.h"
+
+namespace olp {
+namespace http {
+
+namespace {
+constexpr auto kInvalidRequestId =
+    static_cast<RequestId>(RequestIdConstants::RequestIdInvalid);
+}  // namespace
+
+NetworkScheduler::NetworkScheduler(std::shared_ptr<Network> network,
+                                   size_t max_requests_count,
+                                   size_t max_low_priority_requests,
+                                   size_t max_requests_per_host,
+                                   std::chrono::milliseconds batching_interval)
+    : network_{std::move(network)},
+      max_requests_count_{std::max<size_t>(max_requests_count, 1u)},
+      max_low_priority_requests_{max_low_priority_requests},
+      max_requests_per_host_{max_requests_per_host},
+      batching_interval_{std::max(batching_interval,
+                                  std::chrono::milliseconds(0))},
+      current_bucket_{0u},
+      stopped_{false},
+      next_request_id_{
+          static_cast<RequestId>(RequestIdConstants::RequestIdMin)},
+      low_priority_count_{0u},
+      bursting_{false},
+      deferred_since_{Clock::time_point::max()} {
+  thread_ = std::thread(&NetworkScheduler::Run, this);
+}
+
+NetworkScheduler::~NetworkScheduler() {
+  std::deque<QueuedRequest> queue;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    queue.swap(queue_);
+  }
+  condition_.notify_all();
+  thread_.join();
+
+  for (auto& request : queue) {
+    if (request.callback) {
+      request.callback(
+          NetworkResponse()
+              .WithRequestId(request.id)
+              .WithStatus(static_cast<int>(ErrorCode::OFFLINE_ERROR))
+              .WithError("Offline: network is deinitialized"));
+    }
+  }
+
+  // The network may still complete the active requests while it is being
+  // destroyed, so release it before the other members.
+  network_.reset();
+}
+
+SendOutcome NetworkScheduler::Send(NetworkRequest request, Payload payload,
+                                   Callback callback,
+                                   HeaderCallback header_callback,
+                                   DataCallback data_callback) {
+  RequestId request_id;
+  auto host = NetworkUtils::GetHost(request.GetUrl());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    request_id = NextRequestId();
+    queue_.push_back(QueuedRequest{request_id, current_bucket_.load(),
+                                   std::move(host), std::move(request),
+                                   std::move(payload),
+                                   std::move(callback),
+                                   std::move(header_callback),
+                                   std::move(data_callback)});
+  }
+  condition_.notify_one();
+  return SendOutcome(request_id);
+}
+
+void NetworkScheduler::Cancel(RequestId id) {
+  Callback callback;
+  RequestId network_id = kInvalidRequestId;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto queued = std::find_if(
+        queue_.begin(), queue_.end(),
+        [&](const QueuedRequest& request) { return request.id == id; });
+    if (queued != queue_.end()) {
+      callback = std::move(queued->callback);
+      queue_.erase(queued);
+    } else {
+      auto it = active_.find(id);
+      if (it == active_.end()) {
+        return;
+      }
+
+      if (it->second.network_id == kInvalidRequestId) {
+        // The request is being sent, it is cancelled as soon as `Send` returns.
+        it->second.cancelled = true;
+        return;
+      }
+      network_id = it->second.network_id;
+    }
+  }
+
+  if (network_id != kInvalidRequestId) {
+    network_->Cancel(network_id);
+  } else if (callback) {
+    callback(NetworkResponse()
+                 .WithRequestId(id)
+                 .WithStatus(static_cast<int>(ErrorCode::CANCELLED_ERROR))
+                 .WithError("Cancelled"));
+  }
+}
+
+void NetworkScheduler::SetCurrentBucket(uint8_t bucket_id) {
+  current_bucket_.store(bucket_id);
+}
+
+void NetworkScheduler::SetBandwidthLimit(uint8_t bucket_id,
+                                         uint64_t bytes_per_second) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes_per_second == 0u) {
+      buckets_.erase(bucket_id);
+    } else {
+      auto& bucket = buckets_[bucket_id];
+      if (bucket.bytes_per_second == 0u) {
+        bucket.tokens = static_cast<double>(bytes_per_second);
+        bucket.refilled_at = Clock::now();
+      }
+      bucket.bytes_per_second = bytes_per_second;
+    }
+  }
+  condition_.notify_one();
+}
+
+void NetworkScheduler::PreResolve(const std::vector<std::string>& urls) {
+  network_->PreResolve(urls);
+}
+
+void NetworkScheduler::SetPriority(RequestId id, uint32_t priority) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto queued = std::find_if(
+        queue_.begin(), queue_.end(),
+        [&](const QueuedRequest& request) { return request.id == id; });
+    if (queued == queue_.end()) {
+      return;
+    }
+    queued->request.WithPriority(priority);
+  }
+  condition_.notify_one();
+}
+
+void NetworkScheduler::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopped_) {
+    auto wake_up = Clock::time_point::max();
+    auto next = PickNext(Clock::now(), wake_up);
+    if (next == queue_.end()) {
+      if (wake_up == Clock::time_point::max()) {
+        condition_.wait(lock);
+      } else {
+        condition_.wait_until(lock, wake_up);
+      }
+      continue;
+    }
+
+    auto request = std::move(*next);
+    queue_.erase(next);
+
+    const bool low_priority = IsLowPriority(request.request);
+    if (low_priority) {
+      ++low_priority_count_;
+    }
+    ++host_counts_[request.host];
+    active_[request.id] = ActiveRequest{kInvalidRequestId, request.bucket_id,
+                                        request.host, low_priority, false};
+
+    lock.unlock();
+    Dispatch(std::move(request));
+    lock.lock();
+  }
+}
+
+std::deque<NetworkScheduler::QueuedRequest>::iterator
+NetworkScheduler::PickNext(Clock::time_point now, Clock::time_point& wake_up) {
+  if (active_.size() >= max_requests_count_) {
+    return queue_.end();
+  }
+
+  const bool low_priority_full =
+      max_low_priority_requests_ > 0u &&
+      low_priority_count_ >= max_low_priority_requests_;
+
+  // The held back requests go with the other requests, as the radio is
+  // active for them anyway.
+  bool defer_low_priority = false;
+  if (batching_interval_ > Clock::duration::zero() && !bursting_) {
+    if (active_.size() > low_priority_count_ ||
+        (deferred_since_ != Clock::time_point::max() &&
+         now - deferred_since_ >= batching_interval_)) {
+      bursting_ = true;
+    } else {
+      defer_low_priority = true;
+    }
+  }
+
+  // The queue keeps the sending order, so the first request wins within the
+  // same priority.
+  bool has_low_priority = false;
+  auto next = queue_.end();
+  for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+    const bool low_priority = IsLowPriority(it->request);
+    has_low_priority = has_low_priority || low_priority;
+
+    if (next != queue_.end() &&
+        it->request.GetPriority() <= next->request.GetPriority()) {
+      continue;
+    }
+
+    if (low_priority && (low_priority_full || defer_low_priority)) {
+      continue;
+    }
+
+    if (max_requests_per_host_ > 0u) {
+      auto host_it = host_counts_.find(it->host);
+      if (host_it != host_counts_.end() &&
+          host_it->second >= max_requests_per_host_) {
+        continue;
+      }
+    }
+
+    auto bucket_it = buckets_.find(it->bucket_id);
+    if (bucket_it != buckets_.end()) {
+      auto& bucket = bucket_it->second;
+      const auto rate = static_cast<double>(bucket.bytes_per_second);
+      const std::chrono::duration<double> elapsed = now - bucket.refilled_at;
+      bucket.tokens = std::min(rate, bucket.tokens + rate * elapsed.count());
+      bucket.refilled_at = now;
+
+      if (bucket.tokens <= 0.0) {
+        const std::chrono::duration<double> refill_time(-bucket.tokens / rate);
+        wake_up = std::min(
+            wake_up, now + std::chrono::duration_cast<Clock::duration>(
+                               refill_time + std::chrono::milliseconds(1)));
+        continue;
+      }
+    }
+
+    next = it;
+  }
+
+  if (defer_low_priority && has_low_priority) {
+    if (deferred_since_ == Clock::time_point::max()) {
+      deferred_since_ = now;
+    }
+    wake_up = std::min(wake_up, deferred_since_ + batching_interval_);
+  } else if (bursting_ && !has_low_priority) {
+    bursting_ = false;
+    deferred_since_ = Clock::time_point::max();
+  }
+
+  return next;
+}
+
+void NetworkScheduler::Dispatch(QueuedRequest request) {
+  const auto id = request.id;
+  auto callback = std::move(request.callback);
+
+  auto outcome = network_->Send(
+      std::move(request.request), std::move(request.payload),
+      [=](NetworkResponse response) {
+        Complete(id, std::move(response), callback);
+      },
+      std::move(request.header_callback), std::move(request.data_callback));
+
+  if (!outcome.IsSuccessful()) {
+    const auto error = outcome.GetErrorCode();
+    Complete(id,
+             NetworkResponse()
+                 .WithStatus(static_cast<int>(error))
+                 .WithError(ErrorCodeToString(error)),
+             callback);
+    return;
+  }
+
+  bool cancelled = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = active_.find(id);
+    if (it != active_.end()) {
+      it->second.network_id = outcome.GetRequestId();
+      cancelled = it->second.cancelled;
+    }
+  }
+
+  if (cancelled) {
+    network_->Cancel(outcome.GetRequestId());
+  }
+}
+
+void NetworkScheduler::Complete(RequestId id, NetworkResponse response,
+                                Callback callback) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = active_.find(id);
+    if (it != active_.end()) {
+      if (it->second.low_priority) {
+        --low_priority_count_;
+      }
+
+      auto host_it = host_counts_.find(it->second.host);
+      if (host_it != host_counts_.end() && --host_it->second == 0u) {
+        host_counts_.erase(host_it);
+      }
+
+      auto bucket_it = buckets_.find(it->second.bucket_id);
+      if (bucket_it != buckets_.end()) {
+        bucket_it->second.tokens -= static_cast<double>(
+            response.GetBytesDownloaded() + response.GetBytesUploaded());
+      }
+      active_.erase(it);
+    }
+  }
+  condition_.notify_one();
+
+  if (callback) {
+    response.WithRequestId(id);
+    callback(std::move(response));
+  }
+}
+
+bool NetworkScheduler::IsLowPriority(const NetworkRequest& request) const {
+  return request.GetPriority() < thread::NORMAL;
+}
+
+RequestId NetworkScheduler::NextRequestId() {
+  const auto id = next_request_id_;
+  if (next_request_id_ ==
+      static_cast<RequestId>(RequestIdConstants::RequestIdMax)) {
+    next_request_id_ =
+        static_cast<RequestId>(RequestIdConstants::RequestIdMin);
+  } else {
+    ++next_request_id_;
+  }
+  return id;
+}
+
+}  // namespace http
+}  // namespace olp
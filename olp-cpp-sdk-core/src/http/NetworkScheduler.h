@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <olp/core/CoreApi.h>
+#include <olp/core/http/Network.h>
+
+namespace olp {
+namespace http {
+
+/**
+ * @brief Queues the requests and sends them to another `Network` instance in
+ * the priority order.
+ *
+ * At most `max_requests_count` requests are sent at the same time, and at
+ * most `max_low_priority_requests` of them with the priority below
+ * `thread::NORMAL`, and at most `max_requests_per_host` to the same host, so a
+ * slow host does not block the requests to the other hosts. The requests
+ * waiting for a slot are sent in the priority order as well. The buckets with
+ * a bandwidth limit use a token bucket:
+ * the transferred bytes are taken from it when a request completes, and the
+ * requests of the bucket wait until it is refilled.
+ *
+ * With a batching interval, the low priority requests are held back and sent
+ * in bursts, so the mobile radio is not kept active by background requests
+ * spread over time. A burst starts once the oldest waiting request waited for
+ * the interval, or earlier when another request is being sent anyway, and
+ * lasts until no low priority request is left in the queue.
+ */
+class NetworkScheduler final : public Network {
+ public:
+  /**
+   * @brief Creates the `NetworkScheduler` instance.
+   *
+   * @param network The `Network` instance that sends the requests.
+   * @param max_requests_count The maximum number of the requests sent at the
+   * same time.
+   * @param max_low_priority_requests The maximum number of the low priority
+   * requests sent at the same time, or 0 for no separate limit.
+   * @param max_requests_per_host The maximum number of the requests sent to
+   * the same host at the same time, or 0 for no separate limit.
+   * @param batching_interval The maximum time the low priority requests are
+   * held back to be sent in a burst, or 0 to send them right away.
+   */
+  NetworkScheduler(std::shared_ptr<Network> network, size_t max_requests_count,
+                   size_t max_low_priority_requests,
+                   size_t max_requests_per_host,
+                   std::chrono::milliseconds batching_interval =
+                       std::chrono::milliseconds(0));
+  ~NetworkScheduler() override;
+
+  /// Implements the `Send` method of the `Network` class.
+  SendOutcome Send(NetworkRequest request, Payload payload, Callback callback,
+                   HeaderCallback header_callback = nullptr,
+                   DataCallback data_callback = nullptr) override;
+
+  /// Implements the `Cancel` method of the `Network` class.
+  void Cancel(RequestId id) override;
+
+  /// Implements the `SetCurrentBucket` method of the `Network` class.
+  void SetCurrentBucket(uint8_t bucket_id) override;
+
+  /// Implements the `SetBandwidthLimit` method of the `Network` class.
+  void SetBandwidthLimit(uint8_t bucket_id, uint64_t bytes_per_second) override;
+
+  /// Implements the `PreResolve` method of the `Network` class.
+  void PreResolve(const std::vector<std::string>& urls) override;
+
+  /// Implements the `SetPriority` method of the `Network` class.
+  void SetPriority(RequestId id, uint32_t priority) override;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct QueuedRequest {
+    RequestId id;
+    uint8_t bucket_id;
+    std::string host;
+    NetworkRequest request;
+    Payload payload;
+    Callback callback;
+    HeaderCallback header_callback;
+    DataCallback data_callback;
+  };
+
+  struct ActiveRequest {
+    RequestId network_id;
+    uint8_t bucket_id;
+    std::string host;
+    bool low_priority;
+    bool cancelled;
+  };
+
+  struct Bucket {
+    uint64_t bytes_per_second{0u};
+    double tokens{0.0};
+    Clock::time_point refilled_at{};
+  };
+
+  void Run();
+
+  /// Picks the next request that can be sent, or returns the end of the
+  /// queue and the time when a limited bucket has tokens again.
+  std::deque<QueuedRequest>::iterator PickNext(Clock::time_point now,
+                                               Clock::time_point& wake_up);
+
+  void Dispatch(QueuedRequest request);
+
+  void Complete(RequestId id, NetworkResponse response, Callback callback);
+
+  bool IsLowPriority(const NetworkRequest& request) const;
+
+  RequestId NextRequestId();
+
+  std::shared_ptr<Network> network_;
+  const size_t max_requests_count_;
+  const size_t max_low_priority_requests_;
+  const size_t max_requests_per_host_;
+  const Clock::duration batching_interval_;
+  std::atomic<uint8_t> current_bucket_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stopped_;
+  RequestId next_request_id_;
+  std::deque<QueuedRequest> queue_;
+  std::unordered_map<RequestId, ActiveRequest> active_;
+  size_t low_priority_count_;
+  std::unordered_map<std::string, size_t> host_counts_;
+  std::unordered_map<uint8_t, Bucket> buckets_;
+  /// Set while the held back low priority requests are sent.
+  bool bursting_;
+  /// When the oldest held back low priority request was queued.
+  Clock::time_point deferred_since_;
+
+  std::thread thread_;
+};
+
+}  // namespace http
+}  // namespace olp
@@ -19,6 +19,8 @@
 
 #include "olp/core/http/NetworkSettings.h"
 
+#include <utility>
+
 namespace olp {
 namespace http {
 
@@ -55,5 +57,53 @@ NetworkSettings& NetworkSettings::WithProxySettings(
   return *this;
 }
 
+int NetworkSettings::GetTcpKeepAliveIdle() const {
+  return tcp_keep_alive_idle_;
+}
+
+NetworkSettings& NetworkSettings::WithTcpKeepAliveIdle(int idle) {
+  tcp_keep_alive_idle_ = idle;
+  return *this;
+}
+
+int NetworkSettings::GetTcpKeepAliveInterval() const {
+  return tcp_keep_alive_interval_;
+}
+
+NetworkSettings& NetworkSettings::WithTcpKeepAliveInterval(int interval) {
+  tcp_keep_alive_interval_ = interval;
+  return *this;
+}
+
+const std::string& NetworkSettings::GetAcceptEncoding() const {
+  return accept_encoding_;
+}
+
+NetworkSettings& NetworkSettings::WithAcceptEncoding(std::string encodings) {
+  accept_encoding_ = std::move(encodings);
+  return *this;
+}
+
+bool NetworkSettings::GetBackgroundDownload() const {
+  return background_download_;
+}
+
+NetworkSettings& NetworkSettings::WithBackgroundDownload(
+    bool background_download) {
+  background_download_ = background_download;
+  return *this;
+}
+
+const std::vector<std::string>& NetworkSettings::GetResponseHeaderFilter()
+    const {
+  return response_header_filter_;
+}
+
+NetworkSettings& NetworkSettings::WithResponseHeaderFilter(
+    std::vector<std::string> names) {
+  response_header_filter_ = std::move(names);
+  return *this;
+}
+
 }  // namespace http
 }  // namespace olp
@@ -20,6 +20,9 @@
 #include "olp/core/http/NetworkUtils.h"
 
 #include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "olp/core/http/NetworkConstants.h"
 
@@ -90,6 +93,65 @@ std::string NetworkUtils::ExtractUserAgent(Headers& headers) {
   return user_agent;
 }
 
+std::string NetworkUtils::GetHost(const std::string& url) {
+  const auto scheme_end = url.find("://");
+  const auto host_begin =
+      scheme_end == std::string::npos ? 0u : scheme_end + 3u;
+  const auto host_end = url.find_first_of("/?#", host_begin);
+  return url.substr(host_begin, host_end == std::string::npos
+                                    ? std::string::npos
+                                    : host_end - host_begin);
+}
+
+bool NetworkUtils::ReadBody(const NetworkRequest& request,
+                            NetworkRequest::RequestBodyType& body) {
+  const auto& source = request.GetBodySource();
+  if (!source) {
+    body = request.GetBody();
+    return true;
+  }
+
+  // Reads in chunks since the body size is not always known.
+  constexpr std::size_t kChunkSize = 64u * 1024u;
+  auto data = std::make_shared<std::vector<std::uint8_t>>();
+  const auto size = request.GetBodySourceSize();
+  if (size > 0) {
+    data->reserve(static_cast<std::size_t>(size));
+  }
+
+  while (true) {
+    const auto offset = data->size();
+    data->resize(offset + kChunkSize);
+    const auto read = source(offset, data->data() + offset, kChunkSize);
+    if (read < 0) {
+      body = nullptr;
+      return false;
+    }
+
+    data->resize(offset + static_cast<std::size_t>(read));
+    if (read == 0) {
+      break;
+    }
+  }
+
+  body = std::move(data);
+  return true;
+}
+
+bool NetworkUtils::BufferBodySource(NetworkRequest& request) {
+  if (!request.GetBodySource()) {
+    return true;
+  }
+
+  NetworkRequest::RequestBodyType body;
+  if (!ReadBody(request, body)) {
+    return false;
+  }
+
+  request.WithBody(std::move(body)).WithBodySource(nullptr);
+  return true;
+}
+
 std::string HttpErrorToString(int http_status) {
   switch (http_status) {
     case 100:
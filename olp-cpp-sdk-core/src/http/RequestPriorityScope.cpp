@@ -0,0 +1,103 @@
+#include "olp/core/http/RequestPriorityScope.h"
+
+#include <utility>
+#include <vector>
+
+#include "olp/core/http/Network.h"
+#include "olp/core/thread/TaskScheduler.h"
+
+namespace olp {
+namespace http {
+
+namespace {
+thread_local uint32_t current_priority = thread::NORMAL;
+thread_local const std::shared_ptr<RequestPriorityHandle>* current_handle =
+    nullptr;
+}  // namespace
+
+RequestPriorityHandle::RequestPriorityHandle(uint32_t priority)
+    : priority_(priority) {}
+
+uint32_t RequestPriorityHandle::GetPriority() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return priority_;
+}
+
+void RequestPriorityHandle::Promote(uint32_t priority) {
+  std::vector<SentRequest> requests;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (priority <= priority_) {
+      return;
+    }
+
+    priority_ = priority;
+    requests.reserve(requests_.size());
+    for (const auto& request : requests_) {
+      requests.push_back(request.second);
+    }
+  }
+
+  // The network may complete the requests right away, so it is called
+  // without the lock.
+  for (const auto& request : requests) {
+    request.network->SetPriority(request.id, priority);
+  }
+}
+
+uint64_t RequestPriorityHandle::AddRequest(std::shared_ptr<Network> network,
+                                           RequestId id, uint32_t priority) {
+  uint64_t key;
+  uint32_t promoted_priority;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    key = next_key_++;
+    requests_[key] = SentRequest{network, id};
+    promoted_priority = priority_;
+  }
+
+  // The handle may be promoted while the request is being sent.
+  if (promoted_priority > priority) {
+    network->SetPriority(id, promoted_priority);
+  }
+  return key;
+}
+
+void RequestPriorityHandle::RemoveRequest(uint64_t key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  requests_.erase(key);
+}
+
+RequestPriorityScope::RequestPriorityScope(uint32_t priority)
+    : previous_priority_(current_priority), previous_handle_(current_handle) {
+  current_priority = priority;
+  current_handle = nullptr;
+}
+
+RequestPriorityScope::RequestPriorityScope(
+    std::shared_ptr<RequestPriorityHandle> handle)
+    : previous_priority_(current_priority),
+      previous_handle_(current_handle),
+      handle_(std::move(handle)) {
+  if (handle_) {
+    current_priority = handle_->GetPriority();
+    current_handle = &handle_;
+  }
+}
+
+RequestPriorityScope::~RequestPriorityScope() {
+  current_priority = previous_priority_;
+  current_handle = previous_handle_;
+}
+
+uint32_t RequestPriorityScope::GetCurrentPriority() {
+  return current_handle ? (*current_handle)->GetPriority() : current_priority;
+}
+
+std::shared_ptr<RequestPriorityHandle>
+RequestPriorityScope::GetCurrentHandle() {
+  return current_handle ? *current_handle : nullptr;
+}
+
+}  // namespace http
+}  // namespace olp
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "ShardedNetwork.h"
+
+#include <functional>
+#include <utility>
+
+#include "olp/core/http/NetworkUtils.h"
+
+namespace olp {
+namespace http {
+
+ShardedNetwork::ShardedNetwork(std::vector<std::shared_ptr<Network>> shards,
+                               NetworkShardingPolicy policy)
+    : shards_{std::move(shards)},
+      policy_{policy},
+      next_shard_{0u},
+      next_request_id_{
+          static_cast<RequestId>(RequestIdConstants::RequestIdMin)} {}
+
+ShardedNetwork::~ShardedNetwork() {
+  // The shards may still complete the pending requests while they are being
+  // destroyed, so release them before the requests map.
+  shards_.clear();
+}
+
+SendOutcome ShardedNetwork::Send(NetworkRequest request, Payload payload,
+                                 Callback callback,
+                                 HeaderCallback header_callback,
+                                 DataCallback data_callback) {
+  if (shards_.empty()) {
+    return SendOutcome(ErrorCode::OFFLINE_ERROR);
+  }
+
+  const auto preferred_shard = GetPreferredShard(request);
+
+  RequestId request_id;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    request_id = NextRequestId();
+    requests_[request_id] = ShardRequest{
+        preferred_shard,
+        static_cast<RequestId>(RequestIdConstants::RequestIdInvalid), false};
+  }
+
+  auto shard_callback = [=](NetworkResponse response) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      requests_.erase(request_id);
+    }
+
+    if (callback) {
+      response.WithRequestId(request_id);
+      callback(std::move(response));
+    }
+  };
+
+  // Falls back to the other shards when the preferred one is overloaded.
+  SendOutcome outcome(ErrorCode::NETWORK_OVERLOAD_ERROR);
+  for (size_t attempt = 0u; attempt < shards_.size(); ++attempt) {
+    const auto shard = (preferred_shard + attempt) % shards_.size();
+    if (attempt > 0u) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      requests_[request_id].shard = shard;
+    }
+
+    outcome = shards_[shard]->Send(request, payload, shard_callback,
+                                   header_callback, data_callback);
+    if (outcome.IsSuccessful()) {
+      bool cancelled = false;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = requests_.find(request_id);
+        if (it != requests_.end()) {
+          it->second.id = outcome.GetRequestId();
+          cancelled = it->second.cancelled;
+        }
+      }
+
+      if (cancelled) {
+        shards_[shard]->Cancel(outcome.GetRequestId());
+      }
+      return SendOutcome(request_id);
+    }
+
+    if (outcome.GetErrorCode() != ErrorCode::NETWORK_OVERLOAD_ERROR) {
+      break;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  requests_.erase(request_id);
+  return outcome;
+}
+
+void ShardedNetwork::Cancel(RequestId id) {
+  std::shared_ptr<Network> shard;
+  RequestId shard_request_id;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = requests_.find(id);
+    if (it == requests_.end()) {
+      return;
+    }
+
+    if (it->second.id ==
+        static_cast<RequestId>(RequestIdConstants::RequestIdInvalid)) {
+      // The request is being sent, it is cancelled as soon as `Send` returns.
+      it->second.cancelled = true;
+      return;
+    }
+
+    shard = shards_[it->second.shard];
+    shard_request_id = it->second.id;
+  }
+
+  shard->Cancel(shard_request_id);
+}
+
+void ShardedNetwork::PreResolve(const std::vector<std::string>& urls) {
+  if (shards_.empty()) {
+    return;
+  }
+
+  if (policy_ != NetworkShardingPolicy::kHost) {
+    // Any shard may send the next request, and each has its own DNS cache.
+    for (auto& shard : shards_) {
+      shard->PreResolve(urls);
+    }
+    return;
+  }
+
+  std::vector<std::vector<std::string>> shard_urls(shards_.size());
+  for (const auto& url : urls) {
+    const auto host = NetworkUtils::GetHost(url);
+    shard_urls[std::hash<std::string>()(host) % shards_.size()].push_back(url);
+  }
+
+  for (size_t shard = 0u; shard < shards_.size(); ++shard) {
+    if (!shard_urls[shard].empty()) {
+      shards_[shard]->PreResolve(shard_urls[shard]);
+    }
+  }
+}
+
+size_t ShardedNetwork::GetPreferredShard(const NetworkRequest& request) {
+  if (policy_ == NetworkShardingPolicy::kHost) {
+    const auto host = NetworkUtils::GetHost(request.GetUrl());
+    return std::hash<std::string>()(host) % shards_.size();
+  }
+
+  return next_shard_.fetch_add(1u) % shards_.size();
+}
+
+RequestId ShardedNetwork::NextRequestId() {
+  do {
+    const auto id = next_request_id_;
+    if (next_request_id_ ==
+        static_cast<RequestId>(RequestIdConstants::RequestIdMax)) {
+      next_request_id_ =
+          static_cast<RequestId>(RequestIdConstants::RequestIdMin);
+    } else {
+      ++next_request_id_;
+    }
+
+    if (requests_.find(id) == requests_.end()) {
+      return id;
+    }
+  } while (true);
+}
+
+}  // namespace http
+}  // namespace olp
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <olp/core/CoreApi.h>
+#include <olp/core/http/Network.h>
+
+namespace olp {
+namespace http {
+
+/**
+ * @brief Distributes the requests between several `Network` instances.
+ *
+ * Each shard is expected to run its own event loop, so the slow callbacks of
+ * one request do not stall the requests handled by the other shards.
+ */
+class ShardedNetwork final : public Network {
+ public:
+  /**
+   * @brief Creates the `ShardedNetwork` instance.
+   *
+   * @param shards The `Network` instances that handle the requests.
+   * @param policy The policy used to pick a shard for a request.
+   */
+  ShardedNetwork(std::vector<std::shared_ptr<Network>> shards,
+                 NetworkShardingPolicy policy);
+  ~ShardedNetwork() override;
+
+  /// Implements the `Send` method of the `Network` class.
+  SendOutcome Send(NetworkRequest request, Payload payload, Callback callback,
+                   HeaderCallback header_callback = nullptr,
+                   DataCallback data_callback = nullptr) override;
+
+  /// Implements the `Cancel` method of the `Network` class.
+  void Cancel(RequestId id) override;
+
+  /// Implements the `PreResolve` method of the `Network` class.
+  void PreResolve(const std::vector<std::string>& urls) override;
+
+ private:
+  struct ShardRequest {
+    size_t shard;
+    RequestId id;
+    bool cancelled;
+  };
+
+  size_t GetPreferredShard(const NetworkRequest& request);
+
+  RequestId NextRequestId();
+
+  std::vector<std::shared_ptr<Network>> shards_;
+  const NetworkShardingPolicy policy_;
+  std::atomic<size_t> next_shard_;
+
+  std::mutex mutex_;
+  RequestId next_request_id_;
+  std::unordered_map<RequestId, ShardRequest> requests_;
+};
+
+}  // namespace http
+}  // namespace olp
@@ -37,6 +37,9 @@ import java.net.URL;
 import java.net.URLConnection;
 import java.net.UnknownHostException;
 import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.ReadableByteChannel;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
@@ -56,6 +59,18 @@ public class HttpClient {
   public static final int CANCELLED_ERROR = -5;
   public static final int TIMEOUT_ERROR = -7;
   public static final int THREAD_POOL_SIZE = 8;
+  // The size of the buffer that passes the received data to the native side
+  public static final int DATA_BUFFER_SIZE = 64 * 1024;
+
+  // The direct buffers are read by the native side without copying, one per
+  // executor thread
+  private static final ThreadLocal<ByteBuffer> dataBuffer =
+      new ThreadLocal<ByteBuffer>() {
+        @Override
+        protected ByteBuffer initialValue() {
+          return ByteBuffer.allocateDirect(DATA_BUFFER_SIZE);
+        }
+      };
 
   // The raw pointer to the C++ NetworkAndroid class
   private long nativePtr;
@@ -431,15 +446,25 @@ public class HttpClient {
                 }
               }
               int len;
-              byte[] buffer = new byte[8 * 1024];
+              final ReadableByteChannel channel = Channels.newChannel(in);
+              final ByteBuffer buffer = dataBuffer.get();
+              buffer.clear();
 
-              while ((len = in.read(buffer)) >= 0) {
+              // The data is passed to the native side once the buffer is full
+              while ((len = channel.read(buffer)) >= 0) {
                 checkCancelled();
-                dataCallback(request.requestId(), buffer, len);
+                if (!buffer.hasRemaining()) {
+                  dataCallback(request.requestId(), buffer, buffer.position());
+                  buffer.clear();
+                }
                 if(!downloadContentSizePresent){
                     downloadContentSize += len;
                 }
               }
+              if (buffer.position() > 0) {
+                dataCallback(request.requestId(), buffer, buffer.position());
+                buffer.clear();
+              }
             }
             // Error handling:
             catch (FileNotFoundException e) {
@@ -632,7 +657,7 @@ public class HttpClient {
   private synchronized native void completeRequest(
       long requestId, int status, int uploadedBytes, int downloadedBytes, String error, String contentType);
   // Callback for data received
-  private synchronized native void dataCallback(long requestId, byte[] data, int len);
+  private synchronized native void dataCallback(long requestId, ByteBuffer data, int len);
   // Callback set date and offset
   private synchronized native void dateAndOffsetCallback(long requestId, long date, long offset);
   // Callback set date and offset
@@ -28,6 +28,7 @@
 
 #include "olp/core/context/Context.h"
 #include "olp/core/http/HttpStatusCode.h"
+#include "olp/core/http/NetworkUtils.h"
 #include "olp/core/logging/Log.h"
 #include "olp/core/porting/make_unique.h"
 
@@ -116,7 +117,7 @@ Java_com_here_olp_network_HttpClient_dateAndOffsetCallback(
 extern "C" OLP_SDK_NETWORK_ANDROID_EXPORT void JNICALL
 Java_com_here_olp_network_HttpClient_dataCallback(JNIEnv* env, jobject obj,
                                                   jlong request_id,
-                                                  jbyteArray data, jint len) {
+                                                  jobject data, jint len) {
   auto network = olp::http::GetNetworkAndroidNativePtr(env, obj);
   if (!network) {
     OLP_SDK_LOG_WARNING(
@@ -387,7 +388,7 @@ bool NetworkAndroid::Initialize() {
          (void*)&Java_com_here_olp_network_HttpClient_headersCallback},
         {"dateAndOffsetCallback", "(JJJ)V",
          (void*)&Java_com_here_olp_network_HttpClient_dateAndOffsetCallback},
-        {"dataCallback", "(J[BI)V",
+        {"dataCallback", "(JLjava/nio/ByteBuffer;I)V",
          (void*)&Java_com_here_olp_network_HttpClient_dataCallback},
         {"completeRequest", "(JIIILjava/lang/String;Ljava/lang/String;)V",
          (void*)&Java_com_here_olp_network_HttpClient_completeRequest},
@@ -621,7 +622,7 @@ void NetworkAndroid::DateAndOffsetCallback(JNIEnv* env, RequestId request_id,
 }
 
 void NetworkAndroid::DataReceived(JNIEnv* env, RequestId request_id,
-                                  jbyteArray data, int len) {
+                                  jobject data, int len) {
   std::shared_ptr<RequestData> request;
 
   {
@@ -642,7 +643,14 @@ void NetworkAndroid::DataReceived(JNIEnv* env, RequestId request_id,
   OLP_SDK_LOG_TRACE(
       kLogTag, "Received " << len << " bytes for request_id=" << request_id);
 
-  jbyte* jdata = env->GetByteArrayElements(data, NULL);
+  // The data is in a direct buffer, so it is read in place.
+  auto jdata = static_cast<const char*>(env->GetDirectBufferAddress(data));
+  if (!jdata || env->GetDirectBufferCapacity(data) < len) {
+    OLP_SDK_LOG_ERROR(kLogTag, "DataReceived failed - invalid buffer, "
+                               << "request_id=" << request_id);
+    return;
+  }
+
   if (auto payload = request->payload) {
     if (payload->tellp() != std::streampos(request->count)) {
       payload->seekp(request->count);
@@ -653,15 +661,13 @@ void NetworkAndroid::DataReceived(JNIEnv* env, RequestId request_id,
       }
     }
 
-    payload->write(reinterpret_cast<const char*>(jdata), len);
+    payload->write(jdata, len);
   }
 
   if (request->data_callback)
-    request->data_callback(reinterpret_cast<uint8_t*>(jdata),
+    request->data_callback(reinterpret_cast<const uint8_t*>(jdata),
                            request->offset + request->count, len);
 
-  env->ReleaseByteArrayElements(data, jdata, 0);
-
   request->count += len;
 }
 
@@ -869,7 +875,8 @@ void NetworkAndroid::SelfRun() {
                      .WithStatus(response_data.status)
                      .WithError(response_data.error)
                      .WithBytesUploaded(response_data.uploaded_bytes)
-                     .WithBytesDownloaded(response_data.downloaded_bytes));
+                     .WithBytesDownloaded(response_data.downloaded_bytes)
+                     .WithBytesDecoded(response_data.count));
       }
     }
   }
@@ -888,6 +895,19 @@ SendOutcome NetworkAndroid::Send(NetworkRequest request,
     return SendOutcome(ErrorCode::OFFLINE_ERROR);
   }
 
+  // The body is passed to Java as a byte array.
+  if (!NetworkUtils::BufferBodySource(request)) {
+    OLP_SDK_LOG_ERROR(kLogTag, "Send failed - can't read the body, url="
+                                   << request.GetUrl());
+    return SendOutcome(ErrorCode::IO_ERROR);
+  }
+
+  // HttpURLConnection negotiates and decodes gzip unless the header is set,
+  // so only the identity encoding can be requested.
+  if (request.GetSettings().GetAcceptEncoding() == "identity") {
+    request.WithHeader("Accept-Encoding", "identity");
+  }
+
   utils::JNIThreadBinder env(gJavaVM);
   if (env.GetEnv() == nullptr) {
     OLP_SDK_LOG_ERROR(
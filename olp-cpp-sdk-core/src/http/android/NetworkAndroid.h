@@ -80,11 +80,11 @@ class NetworkAndroid : public Network {
    * @brief Data received to the given message
    * @param env - JNI environment for this thread
    * @param id - Unique Id of the message
-   * @param payload - Data
+   * @param payload - Direct `ByteBuffer` with the data
    * @param len - Length of the data
    * @param offset - Offset of the data
    */
-  void DataReceived(JNIEnv* env, RequestId request_id, jbyteArray payload,
+  void DataReceived(JNIEnv* env, RequestId request_id, jobject payload,
                     int len);
 
   /**
@@ -20,7 +20,9 @@
 #include "NetworkCurl.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <utility>
 
 #include <errno.h>
 #include <fcntl.h>
@@ -46,6 +48,13 @@
 #include "olp/core/logging/Log.h"
 #include "olp/core/porting/platform.h"
 #include "olp/core/utils/Dir.h"
+#include "thread/ThreadUtils.h"
+
+// curl_multi_poll() is available since Curl 7.66.0 and curl_multi_wakeup()
+// since Curl 7.68.0. Together they replace the pipe used to wake up the worker.
+#if LIBCURL_VERSION_NUM >= 0x074400
+#define OLP_SDK_NETWORK_HAS_MULTI_POLL
+#endif
 
 namespace olp {
 namespace http {
@@ -54,6 +63,38 @@ namespace {
 
 const char* kLogTag = "CURL";
 
+/// Guards `curl_global_init` and `curl_global_cleanup`, which are not
+/// thread-safe in the older Curl versions.
+std::mutex& GlobalInitMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+#ifdef OLP_SDK_NETWORK_HAS_MULTI_POLL
+// The maximum time the idle worker waits in curl_multi_poll, it is woken up
+// earlier on any event.
+constexpr int kIdlePollTimeoutMs = 60 * 1000;
+#endif
+
+/// Checks whether the response header name is in the filter, an empty filter
+/// accepts all the headers.
+bool IsHeaderAccepted(const std::vector<std::string>& filter,
+                      const char* name, size_t length) {
+  if (filter.empty()) {
+    return true;
+  }
+
+  return std::any_of(
+      filter.begin(), filter.end(), [&](const std::string& accepted) {
+        return accepted.size() == length &&
+               std::equal(accepted.begin(), accepted.end(), name,
+                          [](char lhs, char rhs) {
+                            return NetworkUtils::SimpleToUpper(lhs) ==
+                                   NetworkUtils::SimpleToUpper(rhs);
+                          });
+      });
+}
+
 #ifdef OLP_SDK_NETWORK_HAS_OPENSSL
 
 const auto curl_ca_bundle_name = "ca-bundle.crt";
@@ -169,6 +210,19 @@ static curl_code SslctxFunction(CURL* curl, void* sslctx, void*) {
 #endif
 #endif
 
+/**
+ * @brief Get the scheme and host part of the URL, e.g. "https://host:443".
+ * @param[in] url The URL.
+ * @return The scheme and host, or an empty string if the URL has no scheme.
+ */
+std::string GetSchemeAndHost(const std::string& url) {
+  const auto scheme_end = url.find("://");
+  if (scheme_end == std::string::npos) {
+    return {};
+  }
+  return url.substr(0, url.find_first_of("/?#", scheme_end + 3u));
+}
+
 /**
  * @brief CURL get upload/download data.
  * @param[in] handle CURL easy handle.
@@ -202,6 +256,62 @@ void GetTrafficData(CURL* handle, uint64_t& upload_bytes,
   }
 }
 
+/**
+ * @brief Get the time in microseconds from the start of the transfer until
+ * the given phase ends.
+ * @param[in] handle CURL easy handle.
+ * @param[in] info The CURLINFO time id.
+ * @return The time, or 0 if it is not available.
+ */
+int64_t GetTime(CURL* handle, CURLINFO info) {
+#if LIBCURL_VERSION_NUM >= 0x073d00
+  // The microsecond times are available since Curl 7.61.0
+  curl_off_t time = 0;
+  if (curl_easy_getinfo(handle, info, &time) == CURLE_OK && time > 0) {
+    return static_cast<int64_t>(time);
+  }
+#else
+  double time = 0.0;
+  if (curl_easy_getinfo(handle, info, &time) == CURLE_OK && time > 0.0) {
+    return static_cast<int64_t>(time * 1000000.0);
+  }
+#endif
+  return 0;
+}
+
+/**
+ * @brief CURL get the time spent in the request phases.
+ * @param[in] handle CURL easy handle.
+ * @return The request timings.
+ */
+NetworkTimings GetTimings(CURL* handle) {
+#if LIBCURL_VERSION_NUM >= 0x073d00
+  const auto dns = GetTime(handle, CURLINFO_NAMELOOKUP_TIME_T);
+  const auto connect = GetTime(handle, CURLINFO_CONNECT_TIME_T);
+  const auto tls = GetTime(handle, CURLINFO_APPCONNECT_TIME_T);
+  const auto first_byte = GetTime(handle, CURLINFO_STARTTRANSFER_TIME_T);
+  const auto total = GetTime(handle, CURLINFO_TOTAL_TIME_T);
+#else
+  const auto dns = GetTime(handle, CURLINFO_NAMELOOKUP_TIME);
+  const auto connect = GetTime(handle, CURLINFO_CONNECT_TIME);
+  const auto tls = GetTime(handle, CURLINFO_APPCONNECT_TIME);
+  const auto first_byte = GetTime(handle, CURLINFO_STARTTRANSFER_TIME);
+  const auto total = GetTime(handle, CURLINFO_TOTAL_TIME);
+#endif
+
+  // cURL reports the times from the start of the transfer.
+  NetworkTimings timings;
+  timings.dns = std::chrono::microseconds(dns);
+  timings.connect =
+      std::chrono::microseconds(std::max<int64_t>(connect - dns, 0));
+  // The TLS handshake time is 0 for the plain HTTP and reused connections.
+  timings.tls = std::chrono::microseconds(
+      tls > 0 ? std::max<int64_t>(tls - std::max(connect, dns), 0) : 0);
+  timings.time_to_first_byte = std::chrono::microseconds(first_byte);
+  timings.total = std::chrono::microseconds(total);
+  return timings;
+}
+
 int64_t GetElapsedTime(std::chrono::steady_clock::time_point start) {
   return std::chrono::duration_cast<std::chrono::milliseconds>(
              std::chrono::steady_clock::now() - start)
@@ -211,24 +321,28 @@ int64_t GetElapsedTime(std::chrono::steady_clock::time_point start) {
 }  // anonymous namespace
 
 NetworkCurl::NetworkCurl(size_t max_requests_count)
-    : handles_(max_requests_count),
-      static_handle_count_(
-          std::max(static_cast<size_t>(1u), max_requests_count / 4)) {
+    : NetworkCurl([max_requests_count]() {
+        NetworkInitializationSettings settings;
+        settings.max_requests_count = max_requests_count;
+        return settings;
+      }()) {}
+
+NetworkCurl::NetworkCurl(NetworkInitializationSettings settings)
+    : static_handle_count_(std::max(static_cast<size_t>(1u),
+                                    settings.max_requests_count / 4)),
+      settings_(std::move(settings)),
+      curl_initialized_(false) {
   OLP_SDK_LOG_TRACE(kLogTag, "Created NetworkCurl with address="
-                                 << this
-                                 << ", handles_count=" << max_requests_count);
-  auto error = curl_global_init(CURL_GLOBAL_ALL);
-  curl_initialized_ = (error == CURLE_OK);
-  if (!curl_initialized_) {
-    OLP_SDK_LOG_ERROR_F(kLogTag, "Error initializing Curl. Error: %i",
-                        static_cast<int>(error));
-  }
+                                 << this << ", handles_count="
+                                 << settings_.max_requests_count
+                                 << ", http2=" << settings_.http2_multiplexing);
 }
 
 NetworkCurl::~NetworkCurl() {
   OLP_SDK_LOG_TRACE(kLogTag, "Destroyed NetworkCurl object, this=" << this);
   Deinitialize();
   if (curl_initialized_) {
+    std::lock_guard<std::mutex> lock(GlobalInitMutex());
     curl_global_cleanup();
   }
   if (stderr_) {
@@ -238,17 +352,27 @@ NetworkCurl::~NetworkCurl() {
 
 bool NetworkCurl::Initialize() {
   std::lock_guard<std::mutex> init_lock(init_mutex_);
-  if (!curl_initialized_) {
-    OLP_SDK_LOG_ERROR(kLogTag, "Curl was not initialized.");
-    return false;
-  }
-
   if (state_ != WorkerState::STOPPED) {
     OLP_SDK_LOG_DEBUG(kLogTag, "Already initialized, this=" << this);
     return true;
   }
 
-#ifdef OLP_SDK_NETWORK_HAS_PIPE2
+  // Curl is initialized on the first request, so the processes that only
+  // read the cache do not load the TLS library.
+  if (!curl_initialized_) {
+    std::lock_guard<std::mutex> lock(GlobalInitMutex());
+    const auto error = curl_global_init(CURL_GLOBAL_ALL);
+    curl_initialized_ = (error == CURLE_OK);
+    if (!curl_initialized_) {
+      OLP_SDK_LOG_ERROR_F(kLogTag, "Error initializing Curl. Error: %i",
+                          static_cast<int>(error));
+      return false;
+    }
+  }
+
+#ifdef OLP_SDK_NETWORK_HAS_MULTI_POLL
+  // The worker is woken up with curl_multi_wakeup(), no pipe is needed.
+#elif defined OLP_SDK_NETWORK_HAS_PIPE2
   if (pipe2(pipe_, O_NONBLOCK)) {
     OLP_SDK_LOG_ERROR(kLogTag, "pipe2 failed, this=" << this);
     return false;
@@ -280,15 +404,60 @@ bool NetworkCurl::Initialize() {
     return false;
   }
 
+#if LIBCURL_VERSION_NUM >= 0x072b00
+  // Multiplex the transfers over HTTP/2 connections (since Curl 7.43.0)
+  if (settings_.http2_multiplexing) {
+    curl_multi_setopt(curl_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+  }
+#endif
+
+#if LIBCURL_VERSION_NUM >= 0x071e00
+  // Connection limits (since Curl 7.30.0)
+  if (settings_.max_host_connections > 0u) {
+    curl_multi_setopt(curl_, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      static_cast<long>(settings_.max_host_connections));
+  }
+  if (settings_.max_total_connections > 0u) {
+    curl_multi_setopt(curl_, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                      static_cast<long>(settings_.max_total_connections));
+  }
+#endif
+
+  if (settings_.max_cached_connections > 0u) {
+    curl_multi_setopt(curl_, CURLMOPT_MAXCONNECTS,
+                      static_cast<long>(settings_.max_cached_connections));
+  }
+
+  // The DNS cache and the TLS sessions are shared by all easy handles, the
+  // connection cache is already shared by the multi handle.
+  share_ = curl_share_init();
+  if (share_) {
+    curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, &NetworkCurl::LockShare);
+    curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, &NetworkCurl::UnlockShare);
+    curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  } else {
+    OLP_SDK_LOG_WARNING(kLogTag, "curl_share_init failed, this=" << this);
+  }
+
+#ifdef OLP_SDK_NETWORK_HAS_OPENSSL
+  // Resolved once, the easy handles keep the CA bundle between the requests.
+  ca_bundle_path_ = CaBundlePath();
+#endif
+
+  std::unique_lock<std::mutex> lock(event_mutex_);
+
   // handles setup
+  handles_.resize(settings_.max_requests_count);
   std::shared_ptr<NetworkCurl> that = shared_from_this();
   for (auto& handle : handles_) {
     handle.handle = nullptr;
     handle.in_use = false;
     handle.self = that;
   }
+  pre_resolve_handle_.self = that;
 
-  std::unique_lock<std::mutex> lock(event_mutex_);
   // start worker thread
   thread_ = std::thread(&NetworkCurl::Run, this);
 
@@ -311,12 +480,18 @@ void NetworkCurl::Deinitialize() {
   {
     std::lock_guard<std::mutex> lock(event_mutex_);
     state_ = WorkerState::STOPPING;
+#ifdef OLP_SDK_NETWORK_HAS_MULTI_POLL
+    if (curl_) {
+      curl_multi_wakeup(curl_);
+    }
+#endif
   }
 
   // We should not destroy this thread from itself
   if (thread_.get_id() != std::this_thread::get_id()) {
     event_condition_.notify_all();
-#if defined(OLP_SDK_NETWORK_HAS_PIPE) || defined(OLP_SDK_NETWORK_HAS_PIPE2)
+#if !defined(OLP_SDK_NETWORK_HAS_MULTI_POLL) && \
+    (defined(OLP_SDK_NETWORK_HAS_PIPE) || defined(OLP_SDK_NETWORK_HAS_PIPE2))
     char tmp = 1;
     if (write(pipe_[1], &tmp, 1) < 0) {
       OLP_SDK_LOG_INFO(kLogTag, __PRETTY_FUNCTION__
@@ -353,11 +528,29 @@ void NetworkCurl::Teardown() {
       handle.self.reset();
     }
 
+    pre_resolve_hosts_.clear();
+    if (pre_resolve_handle_.handle) {
+      if (!pre_resolve_host_.empty()) {
+        curl_multi_remove_handle(curl_, pre_resolve_handle_.handle);
+        pre_resolve_host_.clear();
+      }
+      curl_easy_cleanup(pre_resolve_handle_.handle);
+      pre_resolve_handle_.handle = nullptr;
+    }
+    pre_resolve_handle_.self.reset();
+
     // cURL teardown
     curl_multi_cleanup(curl_);
     curl_ = nullptr;
 
-#if (defined OLP_SDK_NETWORK_HAS_PIPE) || (defined OLP_SDK_NETWORK_HAS_PIPE2)
+    // The share is cleaned up after all the easy handles that use it.
+    if (share_) {
+      curl_share_cleanup(share_);
+      share_ = nullptr;
+    }
+
+#if !defined(OLP_SDK_NETWORK_HAS_MULTI_POLL) && \
+    ((defined OLP_SDK_NETWORK_HAS_PIPE) || (defined OLP_SDK_NETWORK_HAS_PIPE2))
     close(pipe_[0]);
     close(pipe_[1]);
 #endif
@@ -408,21 +601,7 @@ SendOutcome NetworkCurl::Send(NetworkRequest request,
     }
   }
 
-  RequestId request_id{
-      static_cast<RequestId>(RequestIdConstants::RequestIdMin)};
-  {
-    std::lock_guard<std::mutex> lock(event_mutex_);
-
-    request_id = request_id_counter_;
-    if (request_id_counter_ ==
-        static_cast<RequestId>(RequestIdConstants::RequestIdMax)) {
-      request_id_counter_ =
-          static_cast<RequestId>(RequestIdConstants::RequestIdMin);
-    } else {
-      request_id_counter_++;
-    }
-  }
-
+  const auto request_id = NextRequestId();
   auto error_status = SendImplementation(
       request, request_id, payload, std::move(header_callback),
       std::move(data_callback), std::move(callback));
@@ -434,6 +613,20 @@ SendOutcome NetworkCurl::Send(NetworkRequest request,
   return SendOutcome(error_status);
 }
 
+RequestId NetworkCurl::NextRequestId() {
+  std::lock_guard<std::mutex> lock(event_mutex_);
+
+  const auto request_id = request_id_counter_;
+  if (request_id_counter_ ==
+      static_cast<RequestId>(RequestIdConstants::RequestIdMax)) {
+    request_id_counter_ =
+        static_cast<RequestId>(RequestIdConstants::RequestIdMin);
+  } else {
+    request_id_counter_++;
+  }
+  return request_id;
+}
+
 ErrorCode NetworkCurl::SendImplementation(
     const NetworkRequest& request, RequestId id,
     const std::shared_ptr<std::ostream>& payload,
@@ -456,16 +649,19 @@ ErrorCode NetworkCurl::SendImplementation(
   OLP_SDK_LOG_DEBUG(
       kLogTag, "Send request with url=" << request.GetUrl() << ", id=" << id);
 
+  handle->body_source = request.GetBodySource();
+  handle->body_offset = 0u;
   handle->transfer_timeout = config.GetTransferTimeout();
   handle->ignore_offset = false;  // request.IgnoreOffset();
   handle->skip_content = false;   // config->SkipContentWhenError();
 
+  handle->header_filter = config.GetResponseHeaderFilter();
+
+  // cURL copies the lines, so one buffer is reused for all the headers.
+  std::string line;
   for (const auto& header : request.GetHeaders()) {
-    std::ostringstream sstrm;
-    sstrm << header.first;
-    sstrm << ": ";
-    sstrm << header.second;
-    handle->chunk = curl_slist_append(handle->chunk, sstrm.str().c_str());
+    line.assign(header.first).append(": ").append(header.second);
+    handle->chunk = curl_slist_append(handle->chunk, line.c_str());
   }
 
   if (verbose_) {
@@ -479,6 +675,13 @@ ErrorCode NetworkCurl::SendImplementation(
 
   const std::string& url = request.GetUrl();
   curl_easy_setopt(handle->handle, CURLOPT_URL, url.c_str());
+
+#if LIBCURL_VERSION_NUM >= 0x071500
+  // An empty string accepts all the encodings cURL is built with, the
+  // response is decoded before RxFunction.
+  curl_easy_setopt(handle->handle, CURLOPT_ACCEPT_ENCODING,
+                   config.GetAcceptEncoding().c_str());
+#endif
   auto verb = request.GetVerb();
   if (verb == NetworkRequest::HttpVerb::POST ||
       verb == NetworkRequest::HttpVerb::PUT ||
@@ -507,7 +710,13 @@ ErrorCode NetworkCurl::SendImplementation(
       verb != NetworkRequest::HttpVerb::HEAD) {
     // These can also be used to add body data to a CURLOPT_CUSTOMREQUEST
     // such as delete.
-    if (handle->body && !handle->body->empty()) {
+    if (handle->body_source) {
+      // The body is read by ReadFunction, with the chunked transfer encoding
+      // if the size is unknown.
+      curl_easy_setopt(handle->handle, CURLOPT_POST, 1L);
+      curl_easy_setopt(handle->handle, CURLOPT_POSTFIELDSIZE_LARGE,
+                       static_cast<curl_off_t>(request.GetBodySourceSize()));
+    } else if (handle->body && !handle->body->empty()) {
       curl_easy_setopt(handle->handle, CURLOPT_POSTFIELDSIZE,
                        handle->body->size());
       curl_easy_setopt(handle->handle, CURLOPT_POSTFIELDS,
@@ -542,55 +751,23 @@ ErrorCode NetworkCurl::SendImplementation(
     curl_easy_setopt(handle->handle, CURLOPT_HTTPHEADER, handle->chunk);
   }
 
-#ifdef OLP_SDK_NETWORK_HAS_OPENSSL
-  std::string curl_ca_bundle = "";
-  if (curl_ca_bundle.empty()) {
-    curl_ca_bundle = CaBundlePath();
-  }
-  if (!curl_ca_bundle.empty()) {
-    CURLcode error = curl_easy_setopt(handle->handle, CURLOPT_CAINFO,
-                                      curl_ca_bundle.c_str());
-    if (CURLE_OK != error) {
-      OLP_SDK_LOG_ERROR(kLogTag, "Send failed - curl_easy_setopt error="
-                                     << error << ", id=" << id);
-      return ErrorCode::UNKNOWN_ERROR;
-    }
-  }
-#endif
-
-  curl_easy_setopt(handle->handle, CURLOPT_SSL_VERIFYPEER, 1L);
-  curl_easy_setopt(handle->handle, CURLOPT_SSL_VERIFYHOST, 2L);
-#ifdef NETWORK_USE_TIMEPROVIDER
-  curl_easy_setopt(handle->handle, CURLOPT_SSL_CTX_FUNCTION, SslctxFunction);
-#endif
-
-  curl_easy_setopt(handle->handle, CURLOPT_FOLLOWLOCATION, 1L);
   curl_easy_setopt(handle->handle, CURLOPT_CONNECTTIMEOUT,
                    config.GetConnectionTimeout());
   curl_easy_setopt(handle->handle, CURLOPT_TIMEOUT,
                    config.GetTransferTimeout());
-  curl_easy_setopt(handle->handle, CURLOPT_WRITEFUNCTION,
-                   &NetworkCurl::RxFunction);
-  curl_easy_setopt(handle->handle, CURLOPT_WRITEDATA, handle);
-  curl_easy_setopt(handle->handle, CURLOPT_HEADERFUNCTION,
-                   &NetworkCurl::HeaderFunction);
-  curl_easy_setopt(handle->handle, CURLOPT_HEADERDATA, handle);
-  curl_easy_setopt(handle->handle, CURLOPT_FAILONERROR, 0);
-  if (stderr_ == nullptr) {
-    curl_easy_setopt(handle->handle, CURLOPT_STDERR, 0);
-  }
-  curl_easy_setopt(handle->handle, CURLOPT_ERRORBUFFER, handle->error_text);
-
-#if (LIBCURL_VERSION_MAJOR >= 7) && (LIBCURL_VERSION_MINOR >= 21)
-  curl_easy_setopt(handle->handle, CURLOPT_ACCEPT_ENCODING, "");
-  curl_easy_setopt(handle->handle, CURLOPT_TRANSFER_ENCODING, 1L);
-#endif
 
 #if (LIBCURL_VERSION_MAJOR >= 7) && (LIBCURL_VERSION_MINOR >= 25)
   // Enable keep-alive (since Curl 7.25.0)
-  curl_easy_setopt(handle->handle, CURLOPT_TCP_KEEPALIVE, 1L);
-  curl_easy_setopt(handle->handle, CURLOPT_TCP_KEEPIDLE, 120L);
-  curl_easy_setopt(handle->handle, CURLOPT_TCP_KEEPINTVL, 60L);
+  const auto keep_alive_idle = config.GetTcpKeepAliveIdle();
+  if (keep_alive_idle > 0) {
+    curl_easy_setopt(handle->handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle->handle, CURLOPT_TCP_KEEPIDLE,
+                     static_cast<long>(keep_alive_idle));
+    curl_easy_setopt(handle->handle, CURLOPT_TCP_KEEPINTVL,
+                     static_cast<long>(config.GetTcpKeepAliveInterval()));
+  } else {
+    curl_easy_setopt(handle->handle, CURLOPT_TCP_KEEPALIVE, 0L);
+  }
 #endif
 
   {
@@ -618,24 +795,132 @@ void NetworkCurl::Cancel(RequestId id) {
   OLP_SDK_LOG_WARNING(kLogTag, "Cancel non-existing request with id=" << id);
 }
 
+void NetworkCurl::PreResolve(const std::vector<std::string>& urls) {
+  if (settings_.dns_cache_timeout == 0) {
+    return;
+  }
+
+  if (!Initialized()) {
+    if (!Initialize()) {
+      OLP_SDK_LOG_WARNING(kLogTag,
+                          "PreResolve failed - network is uninitialized");
+      return;
+    }
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto expire_at =
+      settings_.dns_cache_timeout < 0
+          ? std::chrono::steady_clock::time_point::max()
+          : now + std::chrono::seconds(settings_.dns_cache_timeout);
+
+  for (const auto& url : urls) {
+    const auto host = GetSchemeAndHost(url);
+    if (host.empty()) {
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(resolved_hosts_mutex_);
+      auto& host_expire_at = resolved_hosts_[host];
+      if (host_expire_at > now) {
+        continue;
+      }
+      host_expire_at = expire_at;
+    }
+
+    OLP_SDK_LOG_DEBUG(kLogTag, "PreResolve host=" << host);
+
+    std::lock_guard<std::mutex> lock(event_mutex_);
+    pre_resolve_hosts_.push_back(host);
+    WakeUp();
+  }
+}
+
 void NetworkCurl::AddEvent(EventInfo::Type type, RequestHandle* handle) {
   events_.emplace_back(type, handle);
+  WakeUp();
+}
+
+void NetworkCurl::WakeUp() {
   event_condition_.notify_all();
 
-#if (defined OLP_SDK_NETWORK_HAS_PIPE) || (defined OLP_SDK_NETWORK_HAS_PIPE2)
+#ifdef OLP_SDK_NETWORK_HAS_MULTI_POLL
+  // Unblocks curl_multi_poll(), so that the event is handled immediately.
+  const auto mc = curl_ ? curl_multi_wakeup(curl_) : CURLM_BAD_HANDLE;
+  if (mc != CURLM_OK) {
+    OLP_SDK_LOG_WARNING(kLogTag, "WakeUp - curl_multi_wakeup failed, error="
+                                     << curl_multi_strerror(mc));
+  }
+#elif (defined OLP_SDK_NETWORK_HAS_PIPE) || \
+    (defined OLP_SDK_NETWORK_HAS_PIPE2)
   // Notify also trough the pipe so that we can unlock curl_multi_wait() if
   // the network thread is currently blocked there.
   char tmp = 1;
   if (write(pipe_[1], &tmp, 1) < 0) {
-    OLP_SDK_LOG_WARNING(kLogTag, "AddEvent - failed for id="
-                                     << handle->id << ", err=" << errno);
+    OLP_SDK_LOG_WARNING(kLogTag, "WakeUp - failed, err=" << errno);
   }
 #else
-  OLP_SDK_LOG_WARNING(kLogTag,
-                      "AddEvent for id=" << handle->id << " - no pipe");
+  OLP_SDK_LOG_WARNING(kLogTag, "WakeUp - no pipe");
 #endif
 }
 
+void NetworkCurl::StartNextPreResolve() {
+  if (!pre_resolve_host_.empty() || pre_resolve_hosts_.empty()) {
+    return;
+  }
+
+  if (!pre_resolve_handle_.handle) {
+    pre_resolve_handle_.handle = curl_easy_init();
+    if (!pre_resolve_handle_.handle) {
+      OLP_SDK_LOG_ERROR(kLogTag, "PreResolve - curl_easy_init failed");
+      return;
+    }
+    // The same options as the requests have, so that they can reuse the
+    // connection.
+    if (!SetupHandle(pre_resolve_handle_)) {
+      OLP_SDK_LOG_ERROR(kLogTag, "PreResolve - SetupHandle failed");
+      curl_easy_cleanup(pre_resolve_handle_.handle);
+      pre_resolve_handle_.handle = nullptr;
+      return;
+    }
+  }
+
+  pre_resolve_host_ = std::move(pre_resolve_hosts_.front());
+  pre_resolve_hosts_.pop_front();
+
+  const NetworkSettings defaults;
+  CURL* curl = pre_resolve_handle_.handle;
+  curl_easy_setopt(curl, CURLOPT_URL, pre_resolve_host_.c_str());
+  curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+  curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT,
+                   defaults.GetConnectionTimeout());
+  curl_easy_setopt(curl, CURLOPT_TIMEOUT, defaults.GetTransferTimeout());
+
+  const auto res = curl_multi_add_handle(curl_, curl);
+  if (res != CURLM_OK && res != CURLM_CALL_MULTI_PERFORM) {
+    OLP_SDK_LOG_WARNING(kLogTag, "PreResolve failed, host="
+                                     << pre_resolve_host_ << ", error="
+                                     << curl_multi_strerror(res));
+    CompletePreResolve(CURLE_COULDNT_CONNECT);
+  }
+}
+
+void NetworkCurl::CompletePreResolve(CURLcode result) {
+  OLP_SDK_LOG_DEBUG(kLogTag, "PreResolve completed, host="
+                                 << pre_resolve_host_ << ", result="
+                                 << curl_easy_strerror(result));
+
+  if (result != CURLE_OK) {
+    // The host is resolved again on the next call.
+    std::lock_guard<std::mutex> lock(resolved_hosts_mutex_);
+    resolved_hosts_.erase(pre_resolve_host_);
+  }
+
+  pre_resolve_host_.clear();
+  StartNextPreResolve();
+}
+
 NetworkCurl::RequestHandle* NetworkCurl::GetHandle(
     RequestId id, Network::Callback callback,
     Network::HeaderCallback header_callback,
@@ -656,7 +941,13 @@ NetworkCurl::RequestHandle* NetworkCurl::GetHandle(
                             "GetHandle - curl_easy_init failed, id=" << id);
           return nullptr;
         }
-        curl_easy_setopt(handle.handle, CURLOPT_NOSIGNAL, 1);
+        if (!SetupHandle(handle)) {
+          OLP_SDK_LOG_ERROR(kLogTag,
+                            "GetHandle - curl_easy_setopt failed, id=" << id);
+          curl_easy_cleanup(handle.handle);
+          handle.handle = nullptr;
+          return nullptr;
+        }
       }
       handle.in_use = true;
       handle.callback = callback;
@@ -683,13 +974,129 @@ NetworkCurl::RequestHandle* NetworkCurl::GetHandle(
   return nullptr;
 }
 
+void NetworkCurl::PreallocateHandles() {
+  // The handles are created one at a time, so the first requests are not
+  // blocked until all of them are set up.
+  for (size_t index = 0u; index < static_handle_count_; ++index) {
+    std::lock_guard<std::mutex> lock(event_mutex_);
+    if (!IsStarted() || index >= handles_.size()) {
+      return;
+    }
+
+    auto& handle = handles_[index];
+    if (handle.in_use || handle.handle) {
+      continue;
+    }
+
+    handle.handle = curl_easy_init();
+    if (!handle.handle) {
+      return;
+    }
+
+    if (!SetupHandle(handle)) {
+      curl_easy_cleanup(handle.handle);
+      handle.handle = nullptr;
+      return;
+    }
+  }
+}
+
+bool NetworkCurl::SetupHandle(RequestHandle& handle) {
+  // The options that are the same for all requests are only set once, the
+  // handle keeps them and its connection state between the requests.
+  CURL* curl = handle.handle;
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  if (share_) {
+    curl_easy_setopt(curl, CURLOPT_SHARE, share_);
+  }
+  curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT,
+                   static_cast<long>(settings_.dns_cache_timeout));
+
+#ifdef OLP_SDK_NETWORK_HAS_OPENSSL
+  if (!ca_bundle_path_.empty()) {
+    CURLcode error =
+        curl_easy_setopt(curl, CURLOPT_CAINFO, ca_bundle_path_.c_str());
+    if (CURLE_OK != error) {
+      OLP_SDK_LOG_ERROR(kLogTag,
+                        "SetupHandle - CURLOPT_CAINFO error=" << error);
+      return false;
+    }
+  }
+#endif
+
+  curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+  curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+#ifdef NETWORK_USE_TIMEPROVIDER
+  curl_easy_setopt(curl, CURLOPT_SSL_CTX_FUNCTION, SslctxFunction);
+#endif
+
+  curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &NetworkCurl::RxFunction);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &handle);
+  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION,
+                   &NetworkCurl::HeaderFunction);
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, &handle);
+  curl_easy_setopt(curl, CURLOPT_READFUNCTION, &NetworkCurl::ReadFunction);
+  curl_easy_setopt(curl, CURLOPT_READDATA, &handle);
+  curl_easy_setopt(curl, CURLOPT_SEEKFUNCTION, &NetworkCurl::SeekFunction);
+  curl_easy_setopt(curl, CURLOPT_SEEKDATA, &handle);
+  curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
+  if (stderr_ == nullptr) {
+    curl_easy_setopt(curl, CURLOPT_STDERR, 0);
+  }
+  curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, handle.error_text);
+
+#if (LIBCURL_VERSION_MAJOR >= 7) && (LIBCURL_VERSION_MINOR >= 21)
+  curl_easy_setopt(curl, CURLOPT_TRANSFER_ENCODING, 1L);
+#endif
+
+#if LIBCURL_VERSION_NUM >= 0x072f00
+  // Use HTTP/2 over TLS and wait for a connection that can be multiplexed
+  // instead of opening a new one (since Curl 7.47.0)
+  if (settings_.http2_multiplexing) {
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+  }
+#endif
+
+  return true;
+}
+
+void NetworkCurl::ResetRequestOptions(CURL* handle) {
+  // Resets the options SendImplementation sets only for some requests, all
+  // other per-request options are overwritten by the next request.
+  curl_easy_setopt(handle, CURLOPT_HTTPGET, 1L);
+  curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, static_cast<char*>(nullptr));
+  curl_easy_setopt(handle, CURLOPT_POSTFIELDS, static_cast<char*>(nullptr));
+  curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE, -1L);
+  curl_easy_setopt(handle, CURLOPT_HTTPHEADER,
+                   static_cast<struct curl_slist*>(nullptr));
+  curl_easy_setopt(handle, CURLOPT_PROXY, static_cast<char*>(nullptr));
+  curl_easy_setopt(handle, CURLOPT_PROXYPORT, 0L);
+  curl_easy_setopt(handle, CURLOPT_PROXYTYPE,
+                   static_cast<long>(CURLPROXY_HTTP));
+  curl_easy_setopt(handle, CURLOPT_PROXYUSERNAME, static_cast<char*>(nullptr));
+  curl_easy_setopt(handle, CURLOPT_PROXYPASSWORD, static_cast<char*>(nullptr));
+}
+
+void NetworkCurl::LockShare(CURL*, curl_lock_data data, curl_lock_access,
+                            void* user_data) {
+  auto* self = static_cast<NetworkCurl*>(user_data);
+  self->share_mutexes_[data].lock();
+}
+
+void NetworkCurl::UnlockShare(CURL*, curl_lock_data data, void* user_data) {
+  auto* self = static_cast<NetworkCurl*>(user_data);
+  self->share_mutexes_[data].unlock();
+}
+
 void NetworkCurl::ReleaseHandle(RequestHandle* handle) {
   std::lock_guard<std::mutex> lock(event_mutex_);
   ReleaseHandleUnlocked(handle);
 }
 
 void NetworkCurl::ReleaseHandleUnlocked(RequestHandle* handle) {
-  curl_easy_reset(handle->handle);
+  ResetRequestOptions(handle->handle);
   if (handle->chunk) {
     curl_slist_free_all(handle->chunk);
     handle->chunk = nullptr;
@@ -697,9 +1104,40 @@ void NetworkCurl::ReleaseHandleUnlocked(RequestHandle* handle) {
   handle->in_use = false;
   handle->callback = nullptr;
   handle->header_callback = nullptr;
+  handle->header_filter.clear();
   handle->data_callback = nullptr;
   handle->payload.reset();
   handle->body.reset();
+  handle->body_source = nullptr;
+}
+
+size_t NetworkCurl::ReadFunction(char* ptr, size_t size, size_t nmemb,
+                                 RequestHandle* handle) {
+  if (handle->cancelled || !handle->body_source) {
+    return CURL_READFUNC_ABORT;
+  }
+
+  const auto read = handle->body_source(
+      handle->body_offset, reinterpret_cast<uint8_t*>(ptr), size * nmemb);
+  if (read < 0) {
+    OLP_SDK_LOG_WARNING(kLogTag,
+                        "Reading the request body failed, id=" << handle->id
+                            << ", offset=" << handle->body_offset);
+    return CURL_READFUNC_ABORT;
+  }
+
+  handle->body_offset += static_cast<std::uint64_t>(read);
+  return static_cast<size_t>(read);
+}
+
+int NetworkCurl::SeekFunction(RequestHandle* handle, curl_off_t offset,
+                              int origin) {
+  if (origin != SEEK_SET || offset < 0) {
+    return CURL_SEEKFUNC_CANTSEEK;
+  }
+
+  handle->body_offset = static_cast<std::uint64_t>(offset);
+  return CURL_SEEKFUNC_OK;
 }
 
 size_t NetworkCurl::RxFunction(void* ptr, size_t size, size_t nmemb,
@@ -769,26 +1207,34 @@ size_t NetworkCurl::HeaderFunction(char* ptr, size_t size, size_t nitems,
   if (!that || !that->IsStarted() || handle->cancelled) {
     return len;
   }
+  if (!handle->header_callback) {
+    return len;
+  }
+
   size_t count = len;
   while ((count > 1) && ((ptr[count - 1] == '\n') || (ptr[count - 1] == '\r')))
     count--;
   if (count == 0) {
     return len;
   }
-  std::string str(ptr, count);
-  std::size_t pos = str.find(':');
-  if (pos == std::string::npos) {
+
+  // The strings are only created for the accepted headers.
+  const auto* colon = static_cast<const char*>(std::memchr(ptr, ':', count));
+  if (colon == nullptr) {
     return len;
   }
-  std::string key = str.substr(0, pos);
-  std::string value;
-  if (pos + 2 < str.size()) {
-    value = str.substr(pos + 2);
+  const auto pos = static_cast<size_t>(colon - ptr);
+  if (!IsHeaderAccepted(handle->header_filter, ptr, pos)) {
+    return len;
   }
 
-  if (handle->header_callback) {
-    handle->header_callback(key, value);
+  std::string key(ptr, pos);
+  std::string value;
+  if (pos + 2 < count) {
+    value.assign(ptr + pos + 2, count - pos - 2);
   }
+
+  handle->header_callback(key, value);
   return len;
 }
 
@@ -811,11 +1257,17 @@ void NetworkCurl::CompleteMessage(CURL* handle, CURLcode result) {
     uint64_t upload_bytes = 0;
     uint64_t download_bytes = 0;
     GetTrafficData(rhandle.handle, upload_bytes, download_bytes);
+    if (rhandle.body_source) {
+      // The request size does not include the streamed body.
+      upload_bytes += rhandle.body_offset;
+    }
 
     auto response = NetworkResponse()
                         .WithRequestId(rhandle.id)
                         .WithBytesDownloaded(download_bytes)
-                        .WithBytesUploaded(upload_bytes);
+                        .WithBytesDecoded(rhandle.count)
+                        .WithBytesUploaded(upload_bytes)
+                        .WithTimings(GetTimings(rhandle.handle));
 
     if (rhandle.cancelled) {
       response.WithStatus(static_cast<int>(ErrorCode::CANCELLED_ERROR))
@@ -886,12 +1338,16 @@ int NetworkCurl::GetHandleIndex(CURL* handle) {
 }
 
 void NetworkCurl::Run() {
+  thread::ApplyThreadAffinity(settings_.event_loop_affinity, 0u);
+
   {
     std::lock_guard<std::mutex> lock(event_mutex_);
     state_ = WorkerState::STARTED;
     event_condition_.notify_one();
   }
 
+  PreallocateHandles();
+
   while (IsStarted()) {
     //
     // First block handles user actions, i.e. adding or cancelling requests
@@ -936,6 +1392,10 @@ void NetworkCurl::Run() {
           lock.lock();
         }
       }
+
+      if (IsStarted()) {
+        StartNextPreResolve();
+      }
     }
 
     if (!IsStarted()) {
@@ -974,7 +1434,12 @@ void NetworkCurl::Run() {
         uint64_t download_bytes = 0;
         GetTrafficData(handle, upload_bytes, download_bytes);
 
-        if (msg->msg == CURLMSG_DONE) {
+        if (handle == pre_resolve_handle_.handle) {
+          const auto result =
+              msg->msg == CURLMSG_DONE ? msg->data.result : CURLE_RECV_ERROR;
+          curl_multi_remove_handle(curl_, handle);
+          CompletePreResolve(result);
+        } else if (msg->msg == CURLMSG_DONE) {
           curl_multi_remove_handle(curl_, handle);
           lock.unlock();
           CompleteMessage(handle, msg->data.result);
@@ -1021,6 +1486,20 @@ void NetworkCurl::Run() {
     //
     // Wait for next action or upload/download
     //
+#ifdef OLP_SDK_NETWORK_HAS_MULTI_POLL
+    {
+      // curl_multi_poll waits even if there are no transfers, until a socket
+      // is ready, a curl timeout expires, or AddEvent or Deinitialize call
+      // curl_multi_wakeup. So new requests are started without a delay and
+      // the idle worker does not wake up periodically.
+      int numfds = 0;
+      auto mc = curl_multi_poll(curl_, nullptr, 0, kIdlePollTimeoutMs, &numfds);
+      if (mc != CURLM_OK) {
+        OLP_SDK_LOG_INFO(kLogTag, " Run - curl_multi_poll failed, error="
+                                      << curl_multi_strerror(mc));
+      }
+    }
+#else
     {
       // NOTE: curl_multi_wait has a fatal flow in it and it was corrected by
       // curl_multi_poll in libcurl 7.66.0.
@@ -1082,6 +1561,7 @@ void NetworkCurl::Run() {
         // soon as curl_multi_wait tells us to do so.
       }
     }
+#endif
   }
 
   Teardown();
@@ -26,6 +26,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <curl/curl.h>
@@ -52,6 +53,13 @@ class NetworkCurl : public olp::http::Network,
    */
   explicit NetworkCurl(size_t max_requests_count);
 
+  /**
+   * @brief NetworkCurl constructor.
+   *
+   * @param[in] settings The network initialization settings.
+   */
+  explicit NetworkCurl(NetworkInitializationSettings settings);
+
   /**
    * @brief ~NetworkCurl destructor.
    */
@@ -89,6 +97,16 @@ class NetworkCurl : public olp::http::Network,
    */
   void Cancel(RequestId id) override;
 
+  /**
+   * @brief Implementation of PreResolve method from Network abstract class.
+   *
+   * Sends a `HEAD` request to every host on a dedicated handle, one host at
+   * a time. The addresses of the host are stored in the shared DNS cache, and
+   * its connection is kept in the connection cache of the multi handle, so
+   * the next request to the host does not connect again.
+   */
+  void PreResolve(const std::vector<std::string>& urls) override;
+
  private:
   /**
    * @brief Context of each individual network request.
@@ -96,10 +114,13 @@ class NetworkCurl : public olp::http::Network,
   struct RequestHandle {
     std::chrono::steady_clock::time_point send_time{};
     NetworkRequest::RequestBodyType body{};
+    NetworkRequest::BodySourceCallback body_source{};
+    std::uint64_t body_offset{};
     Network::Payload payload{};
     std::weak_ptr<NetworkCurl> self{};
     Callback callback{};
     HeaderCallback header_callback{};
+    std::vector<std::string> header_filter{};
     DataCallback data_callback{};
     std::uint64_t count{};
     std::uint64_t offset{};
@@ -161,6 +182,12 @@ class NetworkCurl : public olp::http::Network,
                                Network::DataCallback data_callback,
                                Network::Callback callback);
 
+  /**
+   * @brief Get the next unique request id.
+   * @return Request id.
+   */
+  RequestId NextRequestId();
+
   /**
    * @brief Initialize internal data structures, start worker thread.
    * @return @c true if initialized successfuly, @c false otherwise.
@@ -214,6 +241,37 @@ class NetworkCurl : public olp::http::Network,
                            Network::Payload payload,
                            NetworkRequest::RequestBodyType body);
 
+  /**
+   * @brief Set the options that are the same for all requests.
+   * @param[in] handle Request handle with a new CURL handle.
+   * @return @c true if the options are set, @c false otherwise.
+   */
+  bool SetupHandle(RequestHandle& handle);
+
+  /**
+   * @brief Creates the first `static_handle_count_` CURL handles on the
+   * worker thread, so the first requests do not create them.
+   */
+  void PreallocateHandles();
+
+  /**
+   * @brief Reset the per-request options, so that the handle can be reused
+   * without curl_easy_reset() and keeps its connection state.
+   * @param[in] handle CURL handle.
+   */
+  static void ResetRequestOptions(CURL* handle);
+
+  /**
+   * @brief Lock function of the shared DNS and TLS session caches.
+   */
+  static void LockShare(CURL* handle, curl_lock_data data,
+                        curl_lock_access access, void* user_data);
+
+  /**
+   * @brief Unlock function of the shared DNS and TLS session caches.
+   */
+  static void UnlockShare(CURL* handle, curl_lock_data data, void* user_data);
+
   /**
    * @brief Release handle after network request is done.
    * This method handles synchronization between caller's thread and worker
@@ -242,6 +300,18 @@ class NetworkCurl : public olp::http::Network,
   static size_t RxFunction(void* ptr, size_t size, size_t nmemb,
                            RequestHandle* handle);
 
+  /**
+   * @brief CURL callback that reads the request body from the body source.
+   */
+  static size_t ReadFunction(char* ptr, size_t size, size_t nmemb,
+                             RequestHandle* handle);
+
+  /**
+   * @brief CURL callback that rewinds the request body, e.g. on redirect.
+   */
+  static int SeekFunction(RequestHandle* handle, curl_off_t offset,
+                          int origin);
+
   /**
    * @brief CURL header callback.
    */
@@ -265,18 +335,42 @@ class NetworkCurl : public olp::http::Network,
    */
   void AddEvent(EventInfo::Type type, RequestHandle* handle);
 
+  /**
+   * @brief Wakes up the worker thread if it waits for the sockets.
+   */
+  void WakeUp();
+
+  /**
+   * @brief Starts the next pre-resolve transfer if none is running.
+   *
+   * Called by the worker thread with `event_mutex_` locked.
+   */
+  void StartNextPreResolve();
+
+  /**
+   * @brief Handles the completion of the pre-resolve transfer.
+   *
+   * Called by the worker thread with `event_mutex_` locked.
+   */
+  void CompletePreResolve(CURLcode result);
+
   /**
    * @brief Checks whether the worker thread is started.
    * @return @c true if the thread is started, @c false otherwise.
    */
   inline bool IsStarted() const;
 
-  /// Contexts for every network request.
+  /// Contexts for every network request, allocated on initialization.
   std::vector<RequestHandle> handles_;
 
-  /// Number of CURL easy handles that are always opened.
+  /// Number of CURL easy handles that are created in the background once the
+  /// network is initialized.
   const size_t static_handle_count_;
 
+  /// The HTTP/2 and connection settings applied to the multi handle and to
+  /// every request.
+  const NetworkInitializationSettings settings_;
+
   /// Condition variable used to notify worker thread on event.
   std::condition_variable event_condition_;
 
@@ -308,9 +402,38 @@ class NetworkCurl : public olp::http::Network,
   /// Queue of events passed to worker thread.
   std::deque<EventInfo> events_{};
 
+  /// The scheme and host pairs that wait for the pre-resolve handle.
+  std::deque<std::string> pre_resolve_hosts_{};
+
+  /// The host of the running pre-resolve transfer, empty if none is running.
+  std::string pre_resolve_host_;
+
+  /// Context of the pre-resolve transfers. It is not one of `handles_`, so
+  /// the pre-resolve never delays the requests.
+  RequestHandle pre_resolve_handle_;
+
   /// CURL multi handle. Shared among all network requests.
   CURLM* curl_{nullptr};
 
+  /// CURL share handle of the DNS and TLS session caches.
+  CURLSH* share_{nullptr};
+
+  /// Mutexes that guard the data of the share handle.
+  std::mutex share_mutexes_[CURL_LOCK_DATA_LAST];
+
+  /// The pre-resolved scheme and host pairs with the expiration time of their
+  /// DNS cache entries.
+  std::unordered_map<std::string, std::chrono::steady_clock::time_point>
+      resolved_hosts_;
+
+  /// Synchronization mutex of the pre-resolved hosts.
+  std::mutex resolved_hosts_mutex_;
+
+#ifdef OLP_SDK_NETWORK_HAS_OPENSSL
+  /// The CA bundle path, resolved on initialization.
+  std::string ca_bundle_path_;
+#endif
+
   /// Turn on and off verbose mode for CURL.
   bool verbose_{false};
 
@@ -320,13 +443,7 @@ class NetworkCurl : public olp::http::Network,
   /// UNIX Pipe used to notify sleeping worker thread during select() call.
   int pipe_[2]{};
 
-#ifdef OLP_SDK_NETWORK_HAS_OPENSSL
-  /// Mutexes that are used by OpenSSL to synchronize during concurrent
-  /// network transfer.
-  std::unique_ptr<std::mutex[]> ssl_mutexes_{};
-#endif
-
-  /// Stores value if `curl_global_init()` was successful on construction.
+  /// Stores value if `curl_global_init()` was successful on initialization.
   bool curl_initialized_;
 };
 
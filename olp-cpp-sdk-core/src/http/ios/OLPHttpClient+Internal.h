@@ -33,7 +33,7 @@
                      (const olp::http::NetworkProxySettings&)proxySettings
                           andHeaders:(NSDictionary*)headers;
 
-- (void)registerDataTask:(NSURLSessionDataTask*)dataTask
+- (void)registerDataTask:(NSURLSessionTask*)dataTask
              forHttpTask:(OLPHttpTask*)httpTask;
 
 @end
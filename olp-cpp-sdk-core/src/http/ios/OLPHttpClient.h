@@ -36,11 +36,19 @@ class NetworkProxySettings;
  */
 @interface OLPHttpClient : NSObject
 
+/// Initializes the client with the identifier of the background session used
+/// by the background downloads, or nil to disable them
+- (instancetype)initWithBackgroundSessionId:(NSString *)identifier;
+
 /// Creates a task with specific identifier with corresponding settings
 - (OLPHttpTask *)createTaskWithProxy:
                      (const olp::http::NetworkProxySettings &)proxySettings
                                andId:(olp::http::RequestId)identifier;
 
+/// Creates a task that downloads the response to a file in the background
+/// session, returns nil if the client has no background session
+- (OLPHttpTask *)createBackgroundTaskWithId:(olp::http::RequestId)identifier;
+
 /// Gets task by corresponding request id
 - (OLPHttpTask *)taskWithId:(olp::http::RequestId)identifier;
 
@@ -32,7 +32,8 @@ namespace {
 constexpr auto kLogTag = "OLPHttpClient";
 }  // namespace
 
-@interface OLPHttpClient ()<NSURLSessionDataDelegate>
+@interface OLPHttpClient ()<NSURLSessionDataDelegate,
+                            NSURLSessionDownloadDelegate>
 
 @property(nonatomic) NSMutableDictionary* tasks;
 
@@ -40,6 +41,8 @@ constexpr auto kLogTag = "OLPHttpClient";
 
 @property(nonatomic, readonly) NSURLSession* sharedUrlSession;
 
+@property(nonatomic, readonly) NSURLSession* backgroundUrlSession;
+
 @property(nonatomic, readonly) NSMutableDictionary* idTaskMap;
 
 @end
@@ -49,6 +52,10 @@ constexpr auto kLogTag = "OLPHttpClient";
 }
 
 - (instancetype)init {
+  return [self initWithBackgroundSessionId:nil];
+}
+
+- (instancetype)initWithBackgroundSessionId:(NSString*)identifier {
   self = [super init];
   if (self) {
     OLP_SDK_LOG_TRACE_F(kLogTag, "Created client=%p ", (__bridge void*)self);
@@ -59,6 +66,16 @@ constexpr auto kLogTag = "OLPHttpClient";
         [self urlSessionWithProxy:olp::http::NetworkProxySettings()
                        andHeaders:nil];
 
+    if (identifier.length) {
+      NSURLSessionConfiguration* config = [NSURLSessionConfiguration
+          backgroundSessionConfigurationWithIdentifier:identifier];
+      config.discretionary = NO;
+      _backgroundUrlSession =
+          [NSURLSession sessionWithConfiguration:config
+                                        delegate:self
+                                   delegateQueue:_delegateQueue];
+    }
+
     _tasks = [[NSMutableDictionary alloc] init];
     _idTaskMap = [[NSMutableDictionary alloc] init];
     _urlSessions = [[NSMutableDictionary alloc] init];
@@ -78,6 +95,7 @@ constexpr auto kLogTag = "OLPHttpClient";
                       (__bridge void*)self);
 
   [self.sharedUrlSession finishTasksAndInvalidate];
+  [self.backgroundUrlSession finishTasksAndInvalidate];
   [self.urlSessions
       enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL* stop) {
         NSURLSession* session = object;
@@ -85,6 +103,7 @@ constexpr auto kLogTag = "OLPHttpClient";
       }];
   [_delegateQueue cancelAllOperations];
   _sharedUrlSession = nil;
+  _backgroundUrlSession = nil;
   [self.urlSessions removeAllObjects];
 }
 
@@ -119,6 +138,25 @@ constexpr auto kLogTag = "OLPHttpClient";
   return task;
 }
 
+- (OLPHttpTask*)createBackgroundTaskWithId:(olp::http::RequestId)identifier {
+  NSURLSession* session = _backgroundUrlSession;
+  if (!session) {
+    return nil;
+  }
+
+  OLPHttpTask* task = [[OLPHttpTask alloc] initWithHttpClient:self
+                                                andURLSession:session
+                                                        andId:identifier];
+  task.downloadToFile = YES;
+
+  self.urlSessions[@(identifier)] = session;
+  @synchronized(self.tasks) {
+    self.tasks[@(identifier)] = task;
+  }
+
+  return task;
+}
+
 - (OLPHttpTask*)taskWithId:(olp::http::RequestId)identifier {
   OLPHttpTask* task;
   @synchronized(_tasks) {
@@ -249,6 +287,36 @@ constexpr auto kLogTag = "OLPHttpClient";
   }
 }
 
+#pragma mark - NSURLSessionDownloadDelegate
+
+- (void)URLSession:(NSURLSession*)session
+                 downloadTask:(NSURLSessionDownloadTask*)downloadTask
+    didFinishDownloadingToURL:(NSURL*)location {
+  if (!self.sharedUrlSession) {  // Cleanup called
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "didFinishDownloadingToURL failed - invalid session, "
+                          "task_id=%u",
+                          (unsigned int)downloadTask.taskIdentifier);
+    return;
+  }
+
+  @autoreleasepool {
+    OLPHttpTask* httpTask =
+        [self taskWithTaskIdentifier:downloadTask.taskIdentifier];
+    if ([httpTask isValid] && ![httpTask isCancelled]) {
+      // The file is removed when this method returns, so it is read here.
+      [httpTask didFinishDownloadingToURL:location
+                             withResponse:downloadTask.response];
+    } else {
+      OLP_SDK_LOG_WARNING_F(
+          kLogTag,
+          "didFinishDownloadingToURL failed - task can't be found or "
+          "cancelled, task_id=%u",
+          (unsigned int)downloadTask.taskIdentifier);
+    }
+  }
+}
+
 - (void)URLSession:(NSURLSession*)session
                    task:(NSURLSessionTask*)dataTask
     didReceiveChallenge:(NSURLAuthenticationChallenge*)challenge
@@ -430,7 +498,7 @@ constexpr auto kLogTag = "OLPHttpClient";
                                   delegateQueue:_delegateQueue];
 }
 
-- (void)registerDataTask:(NSURLSessionDataTask*)dataTask
+- (void)registerDataTask:(NSURLSessionTask*)dataTask
              forHttpTask:(OLPHttpTask*)httpTask {
   NSNumber* identifier = @(dataTask.taskIdentifier);
   @synchronized(_tasks) {
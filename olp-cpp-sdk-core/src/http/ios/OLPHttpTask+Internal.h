@@ -35,4 +35,7 @@
 
 - (void)didCompleteWithError:(NSError*)error;
 
+- (void)didFinishDownloadingToURL:(NSURL*)location
+                     withResponse:(NSURLResponse*)response;
+
 @end
@@ -80,10 +80,14 @@ typedef void (^OLPHttpTaskCompletionHandler)(NSError* error, uint64_t bytesDownl
 
 @property(nonatomic) std::shared_ptr<std::ostream> payload;
 
+/// Downloads the response to a file, which is read into the payload when the
+/// download completes
+@property(nonatomic) BOOL downloadToFile;
+
 // Readonly
 @property(nonatomic, readonly) olp::http::RequestId requestId;
 
-@property(nonatomic, readonly) NSURLSessionDataTask* dataTask;
+@property(nonatomic, readonly) NSURLSessionTask* dataTask;
 
 // Callbacks
 @property(nonatomic) olp::http::Network::Callback callback;
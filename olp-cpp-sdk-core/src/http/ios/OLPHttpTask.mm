@@ -26,6 +26,8 @@
 
 namespace {
 constexpr auto kLogTag = "OLPHttpTask";
+// The size of the blocks in which the downloaded file is read.
+constexpr NSUInteger kFileReadBlockSize = 1024 * 1024;
 }  // namespace
 
 #pragma mark - OLPHttpTaskResponseData
@@ -97,7 +99,11 @@ constexpr auto kLogTag = "OLPHttpTask";
 
   @synchronized(self) {
     if (!self.isCancelled) {
-      _dataTask = [_urlSession dataTaskWithRequest:request];
+      if (self.downloadToFile) {
+        _dataTask = [_urlSession downloadTaskWithRequest:request];
+      } else {
+        _dataTask = [_urlSession dataTaskWithRequest:request];
+      }
     }
   }
 
@@ -226,6 +232,42 @@ constexpr auto kLogTag = "OLPHttpTask";
   }
 }
 
+- (void)didFinishDownloadingToURL:(NSURL*)location
+                     withResponse:(NSURLResponse*)response {
+  OLP_SDK_LOG_TRACE_F(kLogTag,
+                      "didFinishDownloadingToURL, request_id=%llu, url=%s, "
+                      "task_id=%u",
+                      self.requestId, [self.url UTF8String],
+                      (unsigned int)self.dataTask.taskIdentifier);
+
+  // The download tasks do not report the response separately.
+  if (response) {
+    [self didReceiveResponse:response];
+  }
+
+  NSError* error = nil;
+  NSFileHandle* file = [NSFileHandle fileHandleForReadingFromURL:location
+                                                           error:&error];
+  if (!file) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "Can't open the downloaded file, request_id=%llu, "
+                          "error=%i",
+                          self.requestId, (int)error.code);
+    return;
+  }
+
+  while (!self.isCancelled) {
+    @autoreleasepool {
+      NSData* data = [file readDataOfLength:kFileReadBlockSize];
+      if (!data.length) {
+        break;
+      }
+      [self didReceiveData:data];
+    }
+  }
+  [file closeFile];
+}
+
 #pragma mark - Inquiry methods
 
 - (BOOL)isValid {
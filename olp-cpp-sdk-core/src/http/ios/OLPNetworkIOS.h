@@ -38,7 +38,7 @@ namespace http {
  */
 class OLPNetworkIOS : public olp::http::Network {
  public:
-  explicit OLPNetworkIOS(size_t max_requests_count);
+  explicit OLPNetworkIOS(NetworkInitializationSettings settings);
   ~OLPNetworkIOS();
 
   olp::http::SendOutcome Send(
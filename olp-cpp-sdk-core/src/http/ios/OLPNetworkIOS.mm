@@ -113,10 +113,16 @@ olp::http::ErrorCode ConvertNSURLErrorToNetworkErrorCode(NSInteger error_code) {
 
 #pragma mark - OLPNetworkIOS implementation
 
-OLPNetworkIOS::OLPNetworkIOS(size_t max_requests_count)
-    : max_requests_count_(max_requests_count) {
+OLPNetworkIOS::OLPNetworkIOS(NetworkInitializationSettings settings)
+    : max_requests_count_(settings.max_requests_count) {
   @autoreleasepool {
-    http_client_ = [[OLPHttpClient alloc] init];
+    NSString* background_session_id = nil;
+    if (!settings.background_session_id.empty()) {
+      background_session_id = [NSString
+          stringWithUTF8String:settings.background_session_id.c_str()];
+    }
+    http_client_ = [[OLPHttpClient alloc]
+        initWithBackgroundSessionId:background_session_id];
   }
 }
 
@@ -135,6 +141,13 @@ olp::http::SendOutcome OLPNetworkIOS::Send(
       return SendOutcome(ErrorCode::INVALID_URL_ERROR);
     }
 
+    // NSURLSession gets the body as NSData.
+    if (!NetworkUtils::BufferBodySource(request)) {
+      OLP_SDK_LOG_ERROR(kLogTag, "Send failed - can't read the body, url="
+                                     << request.GetUrl());
+      return SendOutcome(ErrorCode::IO_ERROR);
+    }
+
     // create new OLPHttpTask, if possible
     {
       std::lock_guard<std::mutex> lock(mutex_);
@@ -150,7 +163,16 @@ olp::http::SendOutcome OLPNetworkIOS::Send(
       olp::http::RequestId request_id = GenerateNextRequestId();
       const NetworkProxySettings& proxy_settings =
           request.GetSettings().GetProxySettings();
-      task = [http_client_ createTaskWithProxy:proxy_settings andId:request_id];
+      if (request.GetSettings().GetBackgroundDownload() &&
+          request.GetVerb() == NetworkRequest::HttpVerb::GET &&
+          proxy_settings.GetType() == NetworkProxySettings::Type::NONE) {
+        // Falls back to the regular session without the background one.
+        task = [http_client_ createBackgroundTaskWithId:request_id];
+      }
+      if (!task) {
+        task = [http_client_ createTaskWithProxy:proxy_settings
+                                           andId:request_id];
+      }
     }
     if (!task) {
       OLP_SDK_LOG_WARNING_F(kLogTag,
@@ -19,6 +19,7 @@
 
 #include "NetworkWinHttp.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <sstream>
@@ -35,6 +36,9 @@ namespace {
 
 constexpr int kNetworkUncompressionChunkSize = 1024 * 16;
 constexpr auto kRequestCompletionSleepTime = std::chrono::milliseconds(1);
+// The completion threads wake up at least this often to close the idle
+// connections.
+constexpr DWORD kCompletionWaitTimeMs = 30000;
 
 LPCSTR
 ErrorToString(DWORD err) {
@@ -236,12 +240,11 @@ namespace http {
 
 constexpr auto kLogTag = "WinHttp";
 
-NetworkWinHttp::NetworkWinHttp(size_t max_request_count)
-    : http_requests_(max_request_count),
+NetworkWinHttp::NetworkWinHttp(NetworkInitializationSettings settings)
+    : http_requests_(settings.max_requests_count),
       run_completion_thread_(true),
       http_session_(NULL),
-      thread_(INVALID_HANDLE_VALUE),
-      event_(INVALID_HANDLE_VALUE) {
+      completion_port_(NULL) {
   request_id_counter_.store(
       static_cast<RequestId>(RequestIdConstants::RequestIdMin));
 
@@ -254,20 +257,44 @@ NetworkWinHttp::NetworkWinHttp(size_t max_request_count)
     return;
   }
 
+  if (settings.max_host_connections > 0u) {
+    DWORD max_connections = static_cast<DWORD>(settings.max_host_connections);
+    WinHttpSetOption(http_session_, WINHTTP_OPTION_MAX_CONNS_PER_SERVER,
+                     &max_connections, sizeof(max_connections));
+    WinHttpSetOption(http_session_, WINHTTP_OPTION_MAX_CONNS_PER_1_0_SERVER,
+                     &max_connections, sizeof(max_connections));
+  }
+
   WinHttpSetStatusCallback(
       http_session_, (WINHTTP_STATUS_CALLBACK)&NetworkWinHttp::RequestCallback,
-      WINHTTP_CALLBACK_FLAG_ALL_COMPLETIONS | WINHTTP_CALLBACK_FLAG_HANDLES, 0);
+      WINHTTP_CALLBACK_FLAG_ALL_COMPLETIONS | WINHTTP_CALLBACK_FLAG_HANDLES |
+          WINHTTP_CALLBACK_FLAG_RESOLVE_NAME |
+          WINHTTP_CALLBACK_FLAG_CONNECT_TO_SERVER |
+          WINHTTP_CALLBACK_FLAG_SEND_REQUEST,
+      0);
 
-  event_ = CreateEvent(NULL, TRUE, FALSE, NULL);
+  const auto worker_count = std::max<size_t>(settings.worker_count, 1u);
+  completion_port_ = CreateIoCompletionPort(
+      INVALID_HANDLE_VALUE, NULL, 0, static_cast<DWORD>(worker_count));
+  if (!completion_port_) {
+    OLP_SDK_LOG_ERROR(kLogTag,
+                      "CreateIoCompletionPort failed " << GetLastError());
+  }
 
-  // Store the memory tracking state during initialization so that it can be
-  // used by the thread.
-  thread_ = CreateThread(NULL, 0, NetworkWinHttp::Run, this, 0, NULL);
-  SetThreadPriority(thread_, THREAD_PRIORITY_ABOVE_NORMAL);
+  for (size_t i = 0u; completion_port_ && i < worker_count; ++i) {
+    HANDLE thread = CreateThread(NULL, 0, NetworkWinHttp::Run, this, 0, NULL);
+    if (!thread) {
+      OLP_SDK_LOG_ERROR(kLogTag, "CreateThread failed " << GetLastError());
+      break;
+    }
+    SetThreadPriority(thread, THREAD_PRIORITY_ABOVE_NORMAL);
+    threads_.push_back(thread);
+  }
 
   OLP_SDK_LOG_TRACE(kLogTag, "Created NetworkWinHttp with address="
-                                 << this
-                                 << ", handles_count=" << max_request_count);
+                                 << this << ", handles_count="
+                                 << settings.max_requests_count
+                                 << ", threads_count=" << threads_.size());
 }
 
 NetworkWinHttp::~NetworkWinHttp() {
@@ -302,25 +329,38 @@ NetworkWinHttp::~NetworkWinHttp() {
     http_session_ = NULL;
   }
 
-  if (event_ != INVALID_HANDLE_VALUE) {
-    SetEvent(event_);
+  // Wake up every completion thread, the results still in the port are
+  // completed as offline below.
+  for (size_t i = 0u; i < threads_.size(); ++i) {
+    PostQueuedCompletionStatus(completion_port_, 0, 0, NULL);
   }
-  if (thread_ != INVALID_HANDLE_VALUE) {
-    if (GetCurrentThreadId() != GetThreadId(thread_)) {
-      WaitForSingleObject(thread_, INFINITE);
+  for (HANDLE thread : threads_) {
+    if (GetCurrentThreadId() != GetThreadId(thread)) {
+      WaitForSingleObject(thread, INFINITE);
     }
+    CloseHandle(thread);
+  }
+  threads_.clear();
+
+  if (completion_port_) {
+    DWORD bytes = 0;
+    ULONG_PTR key = 0;
+    LPOVERLAPPED overlapped = NULL;
+    while (GetQueuedCompletionStatus(completion_port_, &bytes, &key,
+                                     &overlapped, 0)) {
+      std::unique_ptr<std::shared_ptr<ResultData>> result(
+          reinterpret_cast<std::shared_ptr<ResultData>*>(key));
+      if (result) {
+        pending_results.push_back(*result);
+      }
+    }
+    CloseHandle(completion_port_);
+    completion_port_ = NULL;
   }
-  CloseHandle(event_);
-  CloseHandle(thread_);
-  thread_ = event_ = INVALID_HANDLE_VALUE;
 
   {
     std::unique_lock<std::recursive_mutex> lock(mutex_);
     http_connections_.clear();
-    while (!results_.empty()) {
-      pending_results.push_back(results_.front());
-      results_.pop();
-    }
   }
 
   for (auto& result : pending_results) {
@@ -343,6 +383,13 @@ SendOutcome NetworkWinHttp::Send(NetworkRequest request,
                                  Callback callback,
                                  HeaderCallback header_callback,
                                  DataCallback data_callback) {
+  // WinHttpSendRequest gets the whole body with the request.
+  if (!NetworkUtils::BufferBodySource(request)) {
+    OLP_SDK_LOG_ERROR(kLogTag, "Send failed - can't read the body, url="
+                                   << request.GetUrl());
+    return SendOutcome(ErrorCode::IO_ERROR);
+  }
+
   RequestId id = request_id_counter_.fetch_add(1);
 
   URL_COMPONENTS url_components;
@@ -516,10 +563,22 @@ SendOutcome NetworkWinHttp::Send(NetworkRequest request,
     }
   }
 
-  flags = WINHTTP_DECOMPRESSION_FLAG_ALL;
-  if (!WinHttpSetOption(http_request, WINHTTP_OPTION_DECOMPRESSION, &flags,
-                        sizeof(flags))) {
-    handle->no_compression = true;
+  // WinHttp negotiates and decodes all its encodings, only the identity
+  // encoding is handled separately.
+  const auto& accept_encoding = request.GetSettings().GetAcceptEncoding();
+  if (accept_encoding == "identity") {
+    if (!WinHttpAddRequestHeaders(http_request, L"Accept-Encoding: identity",
+                                  (DWORD)-1L, WINHTTP_ADDREQ_FLAG_ADD)) {
+      OLP_SDK_LOG_WARNING(kLogTag, "WinHttpAddRequestHeaders failed, url="
+                                       << request.GetUrl()
+                                       << ", error=" << GetLastError());
+    }
+  } else {
+    flags = WINHTTP_DECOMPRESSION_FLAG_ALL;
+    if (!WinHttpSetOption(http_request, WINHTTP_OPTION_DECOMPRESSION, &flags,
+                          sizeof(flags))) {
+      handle->no_compression = true;
+    }
   }
 
   const auto& extra_headers = request.GetHeaders();
@@ -634,6 +693,8 @@ void NetworkWinHttp::RequestCallback(HINTERNET, DWORD_PTR context, DWORD status,
       handle->Complete();
     }
   } else if (status == WINHTTP_CALLBACK_STATUS_HEADERS_AVAILABLE) {
+    request_result.headers_time = std::chrono::steady_clock::now();
+
     HeaderCallback callback = nullptr;
     {
       std::unique_lock<std::recursive_mutex> lock(network->mutex_);
@@ -877,6 +938,18 @@ void NetworkWinHttp::RequestCallback(HINTERNET, DWORD_PTR context, DWORD status,
                                        << ", error=" << GetLastError());
       handle->Complete();
     }
+  } else if (status == WINHTTP_CALLBACK_STATUS_RESOLVING_NAME) {
+    request_result.resolving_time = std::chrono::steady_clock::now();
+  } else if (status == WINHTTP_CALLBACK_STATUS_NAME_RESOLVED) {
+    request_result.resolved_time = std::chrono::steady_clock::now();
+  } else if (status == WINHTTP_CALLBACK_STATUS_CONNECTING_TO_SERVER) {
+    request_result.connecting_time = std::chrono::steady_clock::now();
+  } else if (status == WINHTTP_CALLBACK_STATUS_CONNECTED_TO_SERVER) {
+    request_result.connected_time = std::chrono::steady_clock::now();
+  } else if (status == WINHTTP_CALLBACK_STATUS_SENDING_REQUEST) {
+    request_result.sending_time = std::chrono::steady_clock::now();
+  } else if (status == WINHTTP_CALLBACK_STATUS_REQUEST_SENT) {
+    // Only the start of sending is measured.
   } else if (status == WINHTTP_CALLBACK_STATUS_HANDLE_CLOSING) {
     // Only now is it safe to free the handle
     // See
@@ -898,33 +971,50 @@ NetworkWinHttp::Run(LPVOID arg) {
 
 void NetworkWinHttp::CompletionThread() {
   while (run_completion_thread_) {
-    std::shared_ptr<ResultData> result;
-    {
-      if (run_completion_thread_ && results_.empty()) {
-        WaitForSingleObject(event_, 30000);  // Wait max 30 seconds
-        ResetEvent(event_);
-      }
-      if (!run_completion_thread_) {
-        continue;
+    DWORD bytes = 0;
+    ULONG_PTR key = 0;
+    LPOVERLAPPED overlapped = NULL;
+    GetQueuedCompletionStatus(completion_port_, &bytes, &key, &overlapped,
+                              kCompletionWaitTimeMs);
+
+    std::unique_ptr<std::shared_ptr<ResultData>> result(
+        reinterpret_cast<std::shared_ptr<ResultData>*>(key));
+    if (!run_completion_thread_) {
+      // Leave the result to the destructor, it completes it as offline.
+      if (result &&
+          PostQueuedCompletionStatus(completion_port_, 0,
+                                     reinterpret_cast<ULONG_PTR>(result.get()),
+                                     NULL)) {
+        result.release();
       }
+      break;
+    }
 
-      std::unique_lock<std::recursive_mutex> lock(mutex_);
-      if (!results_.empty()) {
-        result = results_.front();
-        results_.pop();
-      }
+    if (result) {
+      CompleteResult(*result);
     }
 
-    if (run_completion_thread_ && result) {
-      std::string str;
-      int status;
+    CloseIdleConnections();
+  }
+}
+
+void NetworkWinHttp::CompleteResult(const std::shared_ptr<ResultData>& result) {
+  Callback callback = nullptr;
+  NetworkResponse response;
+  {
+    // The completion threads can get the same result more than once, e.g.
+    // after the cancellation, so only the first one reports it.
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    std::swap(result->user_callback, callback);
+
+    if (callback) {
       if (result->offset == 0 &&
           result->status == HttpStatusCode::PARTIAL_CONTENT) {
         result->status = HttpStatusCode::OK;
       }
 
-      // Apply content length if present, else use number of bytes received with
-      // chunks.
+      // Apply content length if present, else use number of bytes received
+      // with chunks.
       if (result->content_length > 0) {
         result->bytes_downloaded += result->content_length;
       } else {
@@ -932,59 +1022,49 @@ void NetworkWinHttp::CompletionThread() {
       }
 
       if (result->completed) {
-        str = HttpErrorToString(result->status);
+        response.WithError(HttpErrorToString(result->status))
+            .WithStatus(result->status);
       } else {
-        str = ErrorToString(result->status);
+        response.WithError(ErrorToString(result->status))
+            .WithStatus(static_cast<int>(WinErrorToCode(result->status)));
       }
 
-      if (result->completed) {
-        status = result->status;
-      } else {
-        status = static_cast<int>(WinErrorToCode(result->status));
-      }
+      response.WithRequestId(result->request_id)
+          .WithBytesDownloaded(result->bytes_downloaded)
+          .WithBytesDecoded(result->count)
+          .WithBytesUploaded(result->bytes_uploaded)
+          .WithTimings(result->GetTimings());
+    }
+  }
 
-      if (result->user_callback) {
-        Callback callback = nullptr;
-        {
-          std::lock_guard<std::recursive_mutex> lock(mutex_);
-          // protect against multiple calls
-          std::swap(result->user_callback, callback);
-        }
-        // must call outside lock to prevent deadlock
-        callback(NetworkResponse()
-                     .WithError(str)
-                     .WithRequestId(result->request_id)
-                     .WithStatus(status)
-                     .WithBytesDownloaded(result->bytes_downloaded)
-                     .WithBytesUploaded(result->bytes_uploaded));
-      }
+  if (callback) {
+    // must call outside lock to prevent deadlock
+    callback(std::move(response));
+  }
 
-      if (result->completed) {
-        std::unique_lock<std::recursive_mutex> lock(mutex_);
-        auto request = FindHandle(result->request_id);
-        if (request) {
-          WinHttpCloseHandle(request->http_request);
-          request->http_request = NULL;
-        }
-      }
+  if (result->completed) {
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    auto request = FindHandle(result->request_id);
+    if (request) {
+      WinHttpCloseHandle(request->http_request);
+      request->http_request = NULL;
     }
+  }
+}
 
-    if (run_completion_thread_ && !http_connections_.empty()) {
-      // Check for timeouted connections
-      std::unique_lock<std::recursive_mutex> lock(mutex_);
-      std::vector<std::wstring> closed;
-      for (const auto& conn : http_connections_) {
-        constexpr auto five_minutes_ms = 1000 * 60 * 5;
-        if ((GetTickCount64() - conn.second->last_used) > five_minutes_ms) {
-          // This connection has not been used in 5 minutes
-          closed.push_back(conn.first);
-        }
-      }
-      for (const std::wstring& conn : closed) {
-        http_connections_.erase(conn);
-      }
+void NetworkWinHttp::CloseIdleConnections() {
+  std::unique_lock<std::recursive_mutex> lock(mutex_);
+  std::vector<std::wstring> closed;
+  for (const auto& conn : http_connections_) {
+    constexpr auto five_minutes_ms = 1000 * 60 * 5;
+    if ((GetTickCount64() - conn.second->last_used) > five_minutes_ms) {
+      // This connection has not been used in 5 minutes
+      closed.push_back(conn.first);
     }
   }
+  for (const std::wstring& conn : closed) {
+    http_connections_.erase(conn);
+  }
 }
 
 NetworkWinHttp::RequestData* NetworkWinHttp::GetHandle(
@@ -1037,7 +1117,30 @@ NetworkWinHttp::ResultData::ResultData(RequestId id, Callback callback,
       completed(false),
       cancelled(false),
       bytes_uploaded(0),
-      bytes_downloaded(0) {}
+      bytes_downloaded(0),
+      start_time(std::chrono::steady_clock::now()) {}
+
+NetworkTimings NetworkWinHttp::ResultData::GetTimings() const {
+  using std::chrono::microseconds;
+  const auto duration = [](std::chrono::steady_clock::time_point begin,
+                           std::chrono::steady_clock::time_point end) {
+    const std::chrono::steady_clock::time_point unset{};
+    if (begin == unset || end == unset || end < begin) {
+      return microseconds(0);
+    }
+    return std::chrono::duration_cast<microseconds>(end - begin);
+  };
+
+  NetworkTimings timings;
+  timings.dns = duration(resolving_time, resolved_time);
+  timings.connect = duration(connecting_time, connected_time);
+  // WinHttp does not report the TLS handshake, it happens between the
+  // connection and sending the request.
+  timings.tls = duration(connected_time, sending_time);
+  timings.time_to_first_byte = duration(start_time, headers_time);
+  timings.total = duration(start_time, end_time);
+  return timings;
+}
 
 NetworkWinHttp::ConnectionData::ConnectionData(HINTERNET http_connection)
     : http_connection(http_connection) {}
@@ -1086,9 +1189,21 @@ NetworkWinHttp::RequestData::~RequestData() {
 void NetworkWinHttp::RequestData::Complete() {
   {
     std::unique_lock<std::recursive_mutex> lock(self->mutex_);
-    self->results_.push(result_data);
+    result_data->end_time = std::chrono::steady_clock::now();
+  }
+
+  // The completion port keeps a reference to the result until a completion
+  // thread takes it.
+  auto result = new std::shared_ptr<ResultData>(result_data);
+  if (!self->completion_port_ ||
+      !PostQueuedCompletionStatus(self->completion_port_, 0,
+                                  reinterpret_cast<ULONG_PTR>(result), NULL)) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Failed to post the result, id="
+                                     << request_id
+                                     << ", completing it in place");
+    std::unique_ptr<std::shared_ptr<ResultData>> owned(result);
+    self->CompleteResult(*owned);
   }
-  SetEvent(self->event_);
 }
 
 void NetworkWinHttp::RequestData::FreeHandle() { self->FreeHandle(request_id); }
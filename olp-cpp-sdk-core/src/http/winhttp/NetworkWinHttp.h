@@ -28,11 +28,12 @@
 #endif
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace olp {
 namespace http {
@@ -42,7 +43,7 @@ namespace http {
  */
 class NetworkWinHttp : public Network {
  public:
-  explicit NetworkWinHttp(size_t max_request_count);
+  explicit NetworkWinHttp(NetworkInitializationSettings settings);
   ~NetworkWinHttp() override;
 
   // Non-copyable, non-movable
@@ -75,6 +76,18 @@ class NetworkWinHttp : public Network {
 
     std::uint64_t bytes_uploaded;
     std::uint64_t bytes_downloaded;
+
+    NetworkTimings GetTimings() const;
+
+    // The times of the request phases reported by the status callback.
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point resolving_time;
+    std::chrono::steady_clock::time_point resolved_time;
+    std::chrono::steady_clock::time_point connecting_time;
+    std::chrono::steady_clock::time_point connected_time;
+    std::chrono::steady_clock::time_point sending_time;
+    std::chrono::steady_clock::time_point headers_time;
+    std::chrono::steady_clock::time_point end_time;
   };
 
   struct ConnectionData {
@@ -134,17 +147,20 @@ class NetworkWinHttp : public Network {
   static DWORD WINAPI Run(LPVOID arg);
 
   void CompletionThread();
+  void CompleteResult(const std::shared_ptr<ResultData>& result);
+  void CloseIdleConnections();
 
   std::recursive_mutex mutex_;
   std::unordered_map<std::wstring, std::shared_ptr<ConnectionData>>
       http_connections_;
   std::vector<RequestData> http_requests_;
-  std::queue<std::shared_ptr<ResultData>> results_;
 
-  bool run_completion_thread_;
+  std::atomic<bool> run_completion_thread_;
   HINTERNET http_session_;
-  HANDLE thread_;
-  HANDLE event_;
+  // The completed results are posted to the completion port, and the
+  // completion threads run the user callbacks.
+  HANDLE completion_port_;
+  std::vector<HANDLE> threads_;
 
   std::atomic<RequestId> request_id_counter_;
 };
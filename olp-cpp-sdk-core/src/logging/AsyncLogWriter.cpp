@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "AsyncLogWriter.h"
+
+#include <string>
+#include <utility>
+
+#include "ThreadId.h"
+
+namespace olp {
+namespace logging {
+
+AsyncLogWriter::AsyncLogWriter(const Configuration& configuration)
+    : m_appenders(configuration.getAppenders()),
+      m_block(configuration.getOverflowPolicy() ==
+              Configuration::OverflowPolicy::Block),
+      m_queue(configuration.getAsyncQueueSize()),
+      m_dropped(0) {
+  m_thread = std::thread(&AsyncLogWriter::run, this);
+}
+
+AsyncLogWriter::~AsyncLogWriter() { stop(); }
+
+void AsyncLogWriter::push(Level level, const std::string& tag,
+                          const std::string& message, const char* file,
+                          unsigned int line, const char* function,
+                          const char* fullFunction) {
+  Record record;
+  record.level = level;
+  record.tag = tag;
+  record.message = message;
+  record.file = file;
+  record.line = line;
+  record.function = function;
+  record.fullFunction = fullFunction;
+  record.time = std::chrono::system_clock::now();
+  record.threadId = getThreadId();
+
+  if (m_block) {
+    m_queue.Push(std::move(record));
+  } else if (!m_queue.TryPush(std::move(record))) {
+    ++m_dropped;
+  }
+}
+
+void AsyncLogWriter::flush() {
+  std::future<void> flushed;
+  {
+    // The flush record is queued before the stop record, so the thread
+    // fulfils the promise before it stops.
+    std::lock_guard<std::mutex> lock(m_stopMutex);
+    if (m_stopped) {
+      return;
+    }
+
+    Record record;
+    record.flushed = std::make_shared<std::promise<void>>();
+    flushed = record.flushed->get_future();
+    m_queue.Push(std::move(record));
+  }
+  flushed.wait();
+}
+
+void AsyncLogWriter::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_stopMutex);
+    if (m_stopped) {
+      return;
+    }
+
+    m_stopped = true;
+    Record record;
+    record.stop = true;
+    m_queue.Push(std::move(record));
+  }
+  m_thread.join();
+  m_queue.Close();
+}
+
+void AsyncLogWriter::run() {
+  Record record;
+  while (m_queue.Pull(record)) {
+    if (record.flushed) {
+      record.flushed->set_value();
+      record.flushed.reset();
+    } else if (!record.stop) {
+      write(record);
+    }
+
+    if (m_queue.Empty()) {
+      reportDropped();
+    }
+
+    if (record.stop) {
+      return;
+    }
+  }
+}
+
+void AsyncLogWriter::write(const Record& record) const {
+  LogMessage logMessage;
+  logMessage.level = record.level;
+  logMessage.tag = record.tag.c_str();
+  logMessage.message = record.message.c_str();
+  logMessage.file = record.file;
+  logMessage.line = record.line;
+  logMessage.function = record.function;
+  logMessage.fullFunction = record.fullFunction;
+  logMessage.time = record.time;
+  logMessage.threadId = record.threadId;
+
+  for (const auto& appender_with_log_level : m_appenders) {
+    if (appender_with_log_level.isEnabled(logMessage.level))
+      appender_with_log_level.appender->append(logMessage);
+  }
+}
+
+void AsyncLogWriter::reportDropped() {
+  const auto dropped = m_dropped.exchange(0);
+  if (dropped == 0) {
+    return;
+  }
+
+  Record record;
+  record.level = Level::Warning;
+  record.tag = "Log";
+  record.message = std::to_string(dropped) +
+                   " log messages were dropped, the logging queue was full";
+  record.file = __FILE__;
+  record.line = __LINE__;
+  record.function = __FUNCTION__;
+  record.fullFunction = __FUNCTION__;
+  record.time = std::chrono::system_clock::now();
+  record.threadId = getThreadId();
+  write(record);
+}
+
+}  // namespace logging
+}  // namespace olp
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <olp/core/logging/Configuration.h>
+#include <olp/core/thread/LockFreeSyncQueue.h>
+
+namespace olp {
+namespace logging {
+
+/**
+ * @brief Writes the log messages to the appenders on a background thread.
+ *
+ * The messages are queued in a lock-free ring buffer, so the logging threads
+ * only copy the tag and the message. When the queue is full, the message is
+ * either dropped or the logging thread waits, depending on the overflow
+ * policy. The number of the dropped messages is written as a warning once the
+ * queue has space again.
+ */
+class AsyncLogWriter final {
+ public:
+  /**
+   * @brief Creates the writer and starts its thread.
+   *
+   * @param configuration The configuration with the appenders, the queue size
+   * and the overflow policy.
+   */
+  explicit AsyncLogWriter(const Configuration& configuration);
+
+  /// Writes the queued messages and stops the thread.
+  ~AsyncLogWriter();
+
+  AsyncLogWriter(const AsyncLogWriter&) = delete;
+  AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+  /**
+   * @brief Queues a message, see `Log::logMessage`.
+   */
+  void push(Level level, const std::string& tag, const std::string& message,
+            const char* file, unsigned int line, const char* function,
+            const char* fullFunction);
+
+  /**
+   * @brief Waits until the messages queued so far are written.
+   *
+   * Returns at once if the writer is stopped.
+   */
+  void flush();
+
+  /**
+   * @brief Writes the queued messages and stops the thread.
+   *
+   * The messages queued after this call are not written.
+   */
+  void stop();
+
+ private:
+  struct Record {
+    Level level{Level::Off};
+    std::string tag;
+    std::string message;
+    const char* file{nullptr};
+    unsigned int line{0};
+    const char* function{nullptr};
+    const char* fullFunction{nullptr};
+    std::chrono::time_point<std::chrono::system_clock> time{};
+    unsigned long threadId{0};
+    /// Set for the records that only mark the position of `flush`.
+    std::shared_ptr<std::promise<void>> flushed;
+    /// Set for the record that stops the thread.
+    bool stop{false};
+  };
+
+  void run();
+  void write(const Record& record) const;
+  void reportDropped();
+
+  const Configuration::AppenderList m_appenders;
+  const bool m_block;
+  olp::thread::LockFreeSyncQueue<Record> m_queue;
+  std::atomic<std::size_t> m_dropped;
+  /// Orders the flush records before the stop record.
+  std::mutex m_stopMutex;
+  bool m_stopped{false};
+  std::thread m_thread;
+};
+
+}  // namespace logging
+}  // namespace olp
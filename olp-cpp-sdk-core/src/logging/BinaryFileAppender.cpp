@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <olp/core/logging/BinaryFileAppender.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <olp/core/logging/LogMessage.h>
+#include <olp/core/utils/WarningWorkarounds.h>
+
+namespace olp {
+namespace logging {
+namespace {
+constexpr char kMagic[] = {'O', 'L', 'P', 'B', 'L', 'O', 'G', '1'};
+constexpr std::size_t kMagicSize = sizeof(kMagic);
+
+// The record types, a zero byte marks the end of the records.
+constexpr char kEndRecord = 0;
+constexpr char kNameRecord = 1;
+constexpr char kMessageRecord = 2;
+
+// type, id, size
+constexpr std::size_t kNameHeaderSize = 1u + 2u * sizeof(std::uint32_t);
+// type, time, thread ID, level, tag, file, line, function, full function,
+// message size
+constexpr std::size_t kMessageHeaderSize =
+    1u + 2u * sizeof(std::uint64_t) + 1u + 6u * sizeof(std::uint32_t);
+
+char* EncodeFixed32(char* dst, std::uint32_t value) {
+  for (std::size_t i = 0; i < sizeof(value); ++i) {
+    *dst++ = static_cast<char>((value >> (8u * i)) & 0xffu);
+  }
+  return dst;
+}
+
+char* EncodeFixed64(char* dst, std::uint64_t value) {
+  for (std::size_t i = 0; i < sizeof(value); ++i) {
+    *dst++ = static_cast<char>((value >> (8u * i)) & 0xffu);
+  }
+  return dst;
+}
+
+std::uint32_t DecodeFixed32(const char* src) {
+  std::uint32_t value = 0u;
+  for (std::size_t i = 0; i < sizeof(value); ++i) {
+    value |= static_cast<std::uint32_t>(static_cast<unsigned char>(src[i]))
+             << (8u * i);
+  }
+  return value;
+}
+
+std::uint64_t DecodeFixed64(const char* src) {
+  std::uint64_t value = 0u;
+  for (std::size_t i = 0; i < sizeof(value); ++i) {
+    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(src[i]))
+             << (8u * i);
+  }
+  return value;
+}
+}  // namespace
+
+/// Read-write memory mapping of a whole file that can grow.
+class BinaryFileAppender::MappedFile {
+ public:
+  static std::unique_ptr<MappedFile> Create(const std::string& path,
+                                            std::size_t size);
+  ~MappedFile();
+
+  char* Data() const { return data_; }
+  std::size_t Size() const { return size_; }
+
+  /// Remaps the file with the new size, the data pointer changes.
+  bool Resize(std::size_t size);
+
+  /// Unmaps the file and truncates it to the used size.
+  void Close(std::size_t used);
+
+ private:
+  MappedFile() = default;
+
+  bool Map(std::size_t size);
+  void Unmap();
+
+  char* data_{nullptr};
+  std::size_t size_{0u};
+#if defined(_WIN32) && !defined(__MINGW32__)
+  HANDLE file_{INVALID_HANDLE_VALUE};
+  HANDLE mapping_{nullptr};
+#else
+  int fd_{-1};
+#endif
+};
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+std::unique_ptr<BinaryFileAppender::MappedFile>
+BinaryFileAppender::MappedFile::Create(const std::string& path,
+                                       std::size_t size) {
+  std::unique_ptr<MappedFile> file(new MappedFile());
+  file->file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                            FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file->file_ == INVALID_HANDLE_VALUE || !file->Map(size)) {
+    return nullptr;
+  }
+  return file;
+}
+
+bool BinaryFileAppender::MappedFile::Map(std::size_t size) {
+  // The mapping extends the file to its size.
+  const auto size64 = static_cast<std::uint64_t>(size);
+  mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE,
+                                static_cast<DWORD>(size64 >> 32u),
+                                static_cast<DWORD>(size64), nullptr);
+  if (!mapping_) {
+    return false;
+  }
+
+  data_ =
+      static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, size));
+  if (!data_) {
+    return false;
+  }
+
+  size_ = size;
+  return true;
+}
+
+void BinaryFileAppender::MappedFile::Unmap() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+    data_ = nullptr;
+  }
+  if (mapping_) {
+    CloseHandle(mapping_);
+    mapping_ = nullptr;
+  }
+  size_ = 0u;
+}
+
+void BinaryFileAppender::MappedFile::Close(std::size_t used) {
+  Unmap();
+  if (file_ != INVALID_HANDLE_VALUE) {
+    LARGE_INTEGER end;
+    end.QuadPart = static_cast<LONGLONG>(used);
+    if (SetFilePointerEx(file_, end, nullptr, FILE_BEGIN)) {
+      SetEndOfFile(file_);
+    }
+    CloseHandle(file_);
+    file_ = INVALID_HANDLE_VALUE;
+  }
+}
+#else
+std::unique_ptr<BinaryFileAppender::MappedFile>
+BinaryFileAppender::MappedFile::Create(const std::string& path,
+                                       std::size_t size) {
+  std::unique_ptr<MappedFile> file(new MappedFile());
+  file->fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file->fd_ < 0 || !file->Map(size)) {
+    return nullptr;
+  }
+  return file;
+}
+
+bool BinaryFileAppender::MappedFile::Map(std::size_t size) {
+  if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+    return false;
+  }
+
+  auto* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  data_ = static_cast<char*>(data);
+  size_ = size;
+  return true;
+}
+
+void BinaryFileAppender::MappedFile::Unmap() {
+  if (data_) {
+    munmap(data_, size_);
+    data_ = nullptr;
+  }
+  size_ = 0u;
+}
+
+void BinaryFileAppender::MappedFile::Close(std::size_t used) {
+  Unmap();
+  if (fd_ >= 0) {
+    // The records end at the first zero byte, so the file stays readable if
+    // it is not truncated.
+    const auto result = ftruncate(fd_, static_cast<off_t>(used));
+    OLP_SDK_CORE_UNUSED(result);
+    close(fd_);
+    fd_ = -1;
+  }
+}
+#endif
+
+BinaryFileAppender::MappedFile::~MappedFile() { Close(size_); }
+
+bool BinaryFileAppender::MappedFile::Resize(std::size_t size) {
+  Unmap();
+  return Map(size);
+}
+
+BinaryFileAppender::BinaryFileAppender(const std::string& fileName,
+                                       std::size_t capacity)
+    : m_fileName(fileName),
+      m_file(MappedFile::Create(fileName, std::max(capacity, kMagicSize + 1u))),
+      m_offset(0u),
+      m_nextId(1u) {
+  if (m_file) {
+    std::memcpy(m_file->Data(), kMagic, kMagicSize);
+    m_offset = kMagicSize;
+  }
+}
+
+BinaryFileAppender::~BinaryFileAppender() {
+  if (m_file) {
+    m_file->Close(m_offset);
+  }
+}
+
+bool BinaryFileAppender::isValid() const { return m_file != nullptr; }
+
+IAppender& BinaryFileAppender::append(const LogMessage& message) {
+  if (!isValid()) return *this;
+
+  const auto tag = getTagId(message.tag);
+  const auto file = getNameId(message.file);
+  const auto function = getNameId(message.function);
+  const auto fullFunction = getNameId(message.fullFunction);
+  const auto size = message.message ? std::strlen(message.message) : 0u;
+
+  auto* dst = reserve(kMessageHeaderSize + size);
+  if (!dst) return *this;
+
+  const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      message.time.time_since_epoch());
+  *dst++ = kMessageRecord;
+  dst = EncodeFixed64(dst, static_cast<std::uint64_t>(time.count()));
+  dst = EncodeFixed64(dst, static_cast<std::uint64_t>(message.threadId));
+  *dst++ = static_cast<char>(message.level);
+  dst = EncodeFixed32(dst, tag);
+  dst = EncodeFixed32(dst, file);
+  dst = EncodeFixed32(dst, message.line);
+  dst = EncodeFixed32(dst, function);
+  dst = EncodeFixed32(dst, fullFunction);
+  dst = EncodeFixed32(dst, static_cast<std::uint32_t>(size));
+  if (size > 0u) {
+    std::memcpy(dst, message.message, size);
+  }
+  return *this;
+}
+
+std::uint32_t BinaryFileAppender::getTagId(const char* tag) {
+  if (!tag) {
+    return 0u;
+  }
+
+  // The tags can be temporary strings, so they are identified by content.
+  auto it = m_tagIds.find(tag);
+  if (it != m_tagIds.end()) {
+    return it->second;
+  }
+
+  const auto id = m_nextId++;
+  m_tagIds.emplace(tag, id);
+  writeName(id, tag, std::strlen(tag));
+  return id;
+}
+
+std::uint32_t BinaryFileAppender::getNameId(const char* name) {
+  if (!name) {
+    return 0u;
+  }
+
+  // The file and function names are string literals of the log macros, so
+  // they are identified by address.
+  auto it = m_nameIds.find(name);
+  if (it != m_nameIds.end()) {
+    return it->second;
+  }
+
+  const auto id = m_nextId++;
+  m_nameIds.emplace(name, id);
+  writeName(id, name, std::strlen(name));
+  return id;
+}
+
+void BinaryFileAppender::writeName(std::uint32_t id, const char* name,
+                                   std::size_t size) {
+  auto* dst = reserve(kNameHeaderSize + size);
+  if (!dst) return;
+
+  *dst++ = kNameRecord;
+  dst = EncodeFixed32(dst, id);
+  dst = EncodeFixed32(dst, static_cast<std::uint32_t>(size));
+  std::memcpy(dst, name, size);
+}
+
+char* BinaryFileAppender::reserve(std::size_t size) {
+  // Keep a zero byte after the records to mark their end.
+  const auto required = m_offset + size + 1u;
+  if (required > m_file->Size()) {
+    const auto new_size = std::max(required, 2u * m_file->Size());
+    if (!m_file->Resize(new_size)) {
+      m_file.reset();
+      return nullptr;
+    }
+  }
+
+  auto* dst = m_file->Data() + m_offset;
+  m_offset += size;
+  return dst;
+}
+
+bool BinaryFileAppender::decode(
+    const std::string& fileName,
+    const std::function<void(const LogMessage&)>& callback) {
+  std::ifstream stream(fileName, std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+
+  const std::vector<char> data((std::istreambuf_iterator<char>(stream)),
+                               std::istreambuf_iterator<char>());
+  if (data.size() < kMagicSize ||
+      std::memcmp(data.data(), kMagic, kMagicSize) != 0) {
+    return false;
+  }
+
+  std::unordered_map<std::uint32_t, std::string> names;
+  auto get_name = [&](std::uint32_t id) -> const char* {
+    auto it = names.find(id);
+    return it != names.end() ? it->second.c_str() : nullptr;
+  };
+
+  const auto* src = data.data() + kMagicSize;
+  const auto* end = data.data() + data.size();
+  while (src < end && *src != kEndRecord) {
+    const auto remaining = static_cast<std::size_t>(end - src);
+    if (*src == kNameRecord && remaining >= kNameHeaderSize) {
+      const auto id = DecodeFixed32(src + 1u);
+      const auto size = DecodeFixed32(src + 1u + sizeof(std::uint32_t));
+      if (size > remaining - kNameHeaderSize) {
+        return false;
+      }
+      names[id].assign(src + kNameHeaderSize, size);
+      src += kNameHeaderSize + size;
+    } else if (*src == kMessageRecord && remaining >= kMessageHeaderSize) {
+      const auto* field = src + 1u;
+      const auto time = DecodeFixed64(field);
+      const auto thread_id = DecodeFixed64(field + 8u);
+      const auto level = static_cast<unsigned char>(field[16u]);
+      field += 17u;
+      const auto tag = DecodeFixed32(field);
+      const auto file = DecodeFixed32(field + 4u);
+      const auto line = DecodeFixed32(field + 8u);
+      const auto function = DecodeFixed32(field + 12u);
+      const auto full_function = DecodeFixed32(field + 16u);
+      const auto size = DecodeFixed32(field + 20u);
+      if (size > remaining - kMessageHeaderSize) {
+        return false;
+      }
+
+      const std::string text(src + kMessageHeaderSize, size);
+      LogMessage message;
+      message.level = static_cast<Level>(level);
+      message.tag = get_name(tag);
+      message.message = text.c_str();
+      message.file = get_name(file);
+      message.line = line;
+      message.function = get_name(function);
+      message.fullFunction = get_name(full_function);
+      message.time = std::chrono::system_clock::time_point(
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(
+              std::chrono::nanoseconds(static_cast<std::int64_t>(time))));
+      message.threadId = static_cast<unsigned long>(thread_id);
+      callback(message);
+      src += kMessageHeaderSize + size;
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace logging
+}  // namespace olp
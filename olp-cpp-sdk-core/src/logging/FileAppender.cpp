@@ -20,6 +20,7 @@
 #include <olp/core/logging/FileAppender.h>
 #include <olp/core/logging/Format.h>
 #include <olp/core/porting/platform.h>
+#include <cstdio>
 #include <string>
 
 namespace olp {
@@ -35,18 +36,93 @@ FileAppender::FileAppender(const std::string& fileName, bool append,
   else
     mode |= std::ios_base::trunc;
   m_stream.open(fileName, mode);
+
+  if (append && m_stream.good()) {
+    m_stream.seekp(0, std::ios_base::end);
+    const auto position = m_stream.tellp();
+    if (position > 0) m_fileSize = static_cast<std::size_t>(position);
+  }
+  m_openedAt = m_flushedAt = Clock::now();
 }
 
-FileAppender::~FileAppender() {}
+FileAppender::~FileAppender() { flush(); }
 
 bool FileAppender::isValid() const { return m_stream.good(); }
 
+void FileAppender::flush() {
+  if (!isValid()) return;
+
+  if (!m_buffer.empty()) {
+    m_stream.write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+  }
+  m_stream.flush();
+  m_flushedAt = Clock::now();
+}
+
 IAppender& FileAppender::append(const LogMessage& message) {
   if (!isValid()) return *this;
 
-  m_stream << m_formatter.format(message) << std::endl;
+  auto line = m_formatter.format(message);
+  line.push_back('\n');
+
+  const auto now = Clock::now();
+  const bool size_exceeded = m_maxFileSize > 0 && m_fileSize > 0 &&
+                             m_fileSize + line.size() > m_maxFileSize;
+  const bool time_exceeded = m_rotationInterval.count() > 0 &&
+                             now - m_openedAt >= m_rotationInterval;
+  if (size_exceeded || time_exceeded) {
+    rotate(now);
+    if (!isValid()) return *this;
+  }
+
+  m_fileSize += line.size();
+  if (m_bufferSize == 0) {
+    m_stream << line;
+    m_stream.flush();
+    return *this;
+  }
+
+  m_buffer += line;
+  if (m_buffer.size() >= m_bufferSize || now - m_flushedAt >= m_flushInterval)
+    flush();
   return *this;
 }
 
+void FileAppender::rotate(Clock::time_point now) {
+  flush();
+  m_stream.close();
+
+  if (m_maxBackupFiles > 0) {
+    const auto& extension = m_compressedExtension;
+    const auto oldest = getBackupName(m_maxBackupFiles);
+    std::remove(oldest.c_str());
+    if (!extension.empty()) std::remove((oldest + extension).c_str());
+
+    for (auto index = m_maxBackupFiles - 1; index > 0; --index) {
+      const auto from = getBackupName(index);
+      const auto to = getBackupName(index + 1);
+      std::rename(from.c_str(), to.c_str());
+      if (!extension.empty())
+        std::rename((from + extension).c_str(), (to + extension).c_str());
+    }
+
+    const auto rotated = getBackupName(1);
+    std::rename(m_fileName.c_str(), rotated.c_str());
+    if (m_compressor && !extension.empty() &&
+        m_compressor(rotated, rotated + extension))
+      std::remove(rotated.c_str());
+  }
+
+  m_stream.clear();
+  m_stream.open(m_fileName, std::ios_base::out | std::ios_base::trunc);
+  m_fileSize = 0;
+  m_openedAt = now;
+}
+
+std::string FileAppender::getBackupName(std::size_t index) const {
+  return m_fileName + "." + std::to_string(index);
+}
+
 }  // namespace logging
 }  // namespace olp
@@ -19,17 +19,71 @@
 
 #include <olp/core/logging/Log.h>
 
+#include "AsyncLogWriter.h"
 #include "ThreadId.h"
 
 #include <olp/core/logging/Configuration.h>
 #include <olp/core/logging/FilterGroup.h>
 #include <olp/core/thread/Atomic.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
 namespace olp {
 namespace logging {
+namespace {
+// Copies of the levels that are read without the lock, so a disabled log
+// statement costs a relaxed load. They are constant-initialized, so they can
+// be read during the static initialization.
+
+// The default level.
+std::atomic<int> s_defaultLevel(static_cast<int>(Level::Debug));
+// The lowest level enabled for any tag.
+std::atomic<int> s_lowestLevel(static_cast<int>(Level::Debug));
+// Whether any tag has its own level.
+std::atomic<bool> s_hasTagLevels(false);
+
+// The tags checked by `isEnabled`, found by the address of the tag string.
+// The slots are only added under the lock and are never removed, so they are
+// read without it. The tag string is kept to detect a reused address.
+constexpr size_t kTagSlotCount = 512u;
+constexpr size_t kMaxTagLength = 47u;
+// The level of a tag that has no level of its own.
+constexpr int kNoTagLevel = -1;
+
+struct TagSlot {
+  std::atomic<const char*> key;
+  std::atomic<int> level;
+  char name[kMaxTagLength + 1];
+};
+
+TagSlot s_tagSlots[kTagSlotCount];
+
+size_t TagSlotIndex(const char* tag) {
+  return (reinterpret_cast<std::uintptr_t>(tag) >> 3) % kTagSlotCount;
+}
+
+TagSlot* FindTagSlot(const char* tag) {
+  const auto start = TagSlotIndex(tag);
+  for (size_t i = 0; i < kTagSlotCount; ++i) {
+    auto& slot = s_tagSlots[(start + i) % kTagSlotCount];
+    const char* key = slot.key.load(std::memory_order_acquire);
+    if (key == nullptr) {
+      return nullptr;
+    }
+    if (key == tag && std::strcmp(slot.name, tag) == 0) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
 class LogImpl {
  public:
   friend class olp::thread::Atomic<logging::LogImpl>;
@@ -59,29 +113,41 @@ class LogImpl {
   void clearLevel(const std::string& tag);
   void clearLevels();
 
-  bool isEnabled(Level level) const;
   bool isEnabled(Level level, const std::string& tag) const;
 
+  /// Adds the tag to the lock-free lookup, returns null if it does not fit.
+  TagSlot* registerTag(const char* tag) const;
+
   void logMessage(Level level, const std::string& tag,
                   const std::string& message, const char* file,
                   unsigned int line, const char* function,
                   const char* fullFunction);
 
+  std::shared_ptr<AsyncLogWriter> getAsyncWriter() const;
+
  private:
   LogImpl();
   template <class LogItem>
   void appendLogItem(const LogItem& log_item);
+  void updateLevels() const;
+  int tagLevel(const char* tag) const;
 
   Configuration m_configuration;
   std::unordered_map<std::string, Level> m_logLevels;
   Level m_defaultLevel;
+  std::shared_ptr<AsyncLogWriter> m_asyncWriter;
 };
 
 LogImpl::LogImpl()
     : m_configuration(Configuration::createDefault()),
       m_defaultLevel(Level::Debug) {}
 
-LogImpl::~LogImpl() { aliveStatus() = false; }
+LogImpl::~LogImpl() {
+  aliveStatus() = false;
+  if (m_asyncWriter) {
+    m_asyncWriter->stop();
+  }
+}
 
 bool& LogImpl::aliveStatus() {
   static bool s_alive = true;
@@ -98,7 +164,15 @@ olp::thread::Atomic<LogImpl>& LogImpl::getInstance() {
 bool LogImpl::configure(Configuration configuration) {
   const bool is_valid = configuration.isValid();
   if (is_valid) {
+    if (m_asyncWriter) {
+      m_asyncWriter->stop();
+      m_asyncWriter.reset();
+    }
+
     m_configuration = std::move(configuration);
+    if (m_configuration.getAsyncQueueSize() > 0) {
+      m_asyncWriter = std::make_shared<AsyncLogWriter>(m_configuration);
+    }
   }
 
   return is_valid;
@@ -106,7 +180,10 @@ bool LogImpl::configure(Configuration configuration) {
 
 Configuration LogImpl::getConfiguration() const { return m_configuration; }
 
-void LogImpl::setLevel(Level level) { m_defaultLevel = level; }
+void LogImpl::setLevel(Level level) {
+  m_defaultLevel = level;
+  updateLevels();
+}
 
 Level LogImpl::getLevel() const { return m_defaultLevel; }
 
@@ -117,6 +194,7 @@ void LogImpl::setLevel(Level level, const std::string& tag) {
   }
 
   m_logLevels[tag] = level;
+  updateLevels();
 }
 
 boost::optional<Level> LogImpl::getLevel(const std::string& tag) const {
@@ -133,14 +211,12 @@ void LogImpl::clearLevel(const std::string& tag) {
   if (tag.empty()) return;
 
   m_logLevels.erase(tag);
+  updateLevels();
 }
 
-void LogImpl::clearLevels() { m_logLevels.clear(); }
-
-bool LogImpl::isEnabled(Level level) const {
-  if (level == Level::Off) return false;
-
-  return static_cast<int>(level) >= static_cast<int>(m_defaultLevel);
+void LogImpl::clearLevels() {
+  m_logLevels.clear();
+  updateLevels();
 }
 
 bool LogImpl::isEnabled(Level level, const std::string& tag) const {
@@ -155,6 +231,35 @@ bool LogImpl::isEnabled(Level level, const std::string& tag) const {
   return static_cast<int>(level) >= static_cast<int>(targetLevel);
 }
 
+TagSlot* LogImpl::registerTag(const char* tag) const {
+  if (std::strlen(tag) > kMaxTagLength) {
+    return nullptr;
+  }
+
+  const auto start = TagSlotIndex(tag);
+  for (size_t i = 0; i < kTagSlotCount; ++i) {
+    auto& slot = s_tagSlots[(start + i) % kTagSlotCount];
+    const char* key = slot.key.load(std::memory_order_relaxed);
+    if (key == tag && std::strcmp(slot.name, tag) == 0) {
+      return &slot;
+    }
+
+    if (key == nullptr) {
+      std::strcpy(slot.name, tag);
+      slot.level.store(tagLevel(tag), std::memory_order_relaxed);
+      slot.key.store(tag, std::memory_order_release);
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+int LogImpl::tagLevel(const char* tag) const {
+  auto foundIter = m_logLevels.find(tag);
+  if (foundIter == m_logLevels.end()) return kNoTagLevel;
+  return static_cast<int>(foundIter->second);
+}
+
 void LogImpl::logMessage(Level level, const std::string& tag,
                          const std::string& message, const char* file,
                          unsigned int line, const char* function,
@@ -173,6 +278,29 @@ void LogImpl::logMessage(Level level, const std::string& tag,
   appendLogItem(logMessage);
 }
 
+std::shared_ptr<AsyncLogWriter> LogImpl::getAsyncWriter() const {
+  return m_asyncWriter;
+}
+
+void LogImpl::updateLevels() const {
+  auto lowest = static_cast<int>(m_defaultLevel);
+  for (const auto& tag_level : m_logLevels) {
+    lowest = std::min(lowest, static_cast<int>(tag_level.second));
+  }
+
+  s_defaultLevel.store(static_cast<int>(m_defaultLevel),
+                       std::memory_order_relaxed);
+  s_lowestLevel.store(lowest, std::memory_order_relaxed);
+  s_hasTagLevels.store(!m_logLevels.empty(), std::memory_order_relaxed);
+
+  for (auto& slot : s_tagSlots) {
+    if (slot.key.load(std::memory_order_relaxed) == nullptr) {
+      continue;
+    }
+    slot.level.store(tagLevel(slot.name), std::memory_order_relaxed);
+  }
+}
+
 template <class LogItem>
 void LogImpl::appendLogItem(const LogItem& log_item) {
   for (const auto& appender_with_log_level : m_configuration.getAppenders()) {
@@ -261,28 +389,95 @@ void Log::applyFilterGroup(const FilterGroup& filters) {
 }
 
 bool Log::isEnabled(Level level) {
-  if (!LogImpl::aliveStatus()) return false;
+  if (level == Level::Off ||
+      static_cast<int>(level) <
+          s_defaultLevel.load(std::memory_order_relaxed)) {
+    return false;
+  }
 
-  return LogImpl::getInstance().locked(
-      [level](const LogImpl& log) { return log.isEnabled(level); });
+  return LogImpl::aliveStatus();
 }
 
 bool Log::isEnabled(Level level, const std::string& tag) {
+  if (level == Level::Off ||
+      static_cast<int>(level) <
+          s_lowestLevel.load(std::memory_order_relaxed)) {
+    return false;
+  }
+
   if (!LogImpl::aliveStatus()) return false;
 
+  if (!s_hasTagLevels.load(std::memory_order_relaxed)) {
+    return static_cast<int>(level) >=
+           s_defaultLevel.load(std::memory_order_relaxed);
+  }
+
   return LogImpl::getInstance().locked(
       [level, &tag](const LogImpl& log) { return log.isEnabled(level, tag); });
 }
 
+bool Log::isEnabled(Level level, const char* tag) {
+  if (level == Level::Off ||
+      static_cast<int>(level) <
+          s_lowestLevel.load(std::memory_order_relaxed)) {
+    return false;
+  }
+
+  if (!LogImpl::aliveStatus()) return false;
+
+  if (!s_hasTagLevels.load(std::memory_order_relaxed)) {
+    return static_cast<int>(level) >=
+           s_defaultLevel.load(std::memory_order_relaxed);
+  }
+
+  auto* slot = FindTagSlot(tag);
+  if (!slot) {
+    slot = LogImpl::getInstance().locked(
+        [tag](const LogImpl& log) { return log.registerTag(tag); });
+  }
+
+  if (!slot) {
+    return isEnabled(level, std::string(tag));
+  }
+
+  auto tag_level = slot->level.load(std::memory_order_relaxed);
+  if (tag_level == kNoTagLevel) {
+    tag_level = s_defaultLevel.load(std::memory_order_relaxed);
+  }
+  return static_cast<int>(level) >= tag_level;
+}
+
 void Log::logMessage(Level level, const std::string& tag,
                      const std::string& message, const char* file,
                      unsigned int line, const char* function,
                      const char* fullFunction) {
   if (!LogImpl::aliveStatus()) return;
 
-  LogImpl::getInstance().locked([&](LogImpl& log) {
-    log.logMessage(level, tag, message, file, line, function, fullFunction);
-  });
+  // In the asynchronous mode the message is queued outside of the lock, so
+  // the logging threads do not wait for each other.
+  auto writer = LogImpl::getInstance().locked(
+      [&](LogImpl& log) -> std::shared_ptr<AsyncLogWriter> {
+        auto async_writer = log.getAsyncWriter();
+        if (!async_writer) {
+          log.logMessage(level, tag, message, file, line, function,
+                         fullFunction);
+        }
+        return async_writer;
+      });
+
+  if (writer) {
+    writer->push(level, tag, message, file, line, function, fullFunction);
+  }
+}
+
+void Log::flush() {
+  if (!LogImpl::aliveStatus()) return;
+
+  auto writer = LogImpl::getInstance().locked(
+      [](const LogImpl& log) { return log.getAsyncWriter(); });
+  if (writer) {
+    writer->flush();
+  }
 }
 
 }  // namespace logging
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/thread/TaskComponentScope.h"
+
+namespace olp {
+namespace thread {
+
+namespace {
+thread_local const char* current_component = "";
+}  // namespace
+
+TaskComponentScope::TaskComponentScope(const char* component)
+    : previous_component_(current_component) {
+  current_component = component != nullptr ? component : "";
+}
+
+TaskComponentScope::~TaskComponentScope() {
+  current_component = previous_component_;
+}
+
+const char* TaskComponentScope::GetCurrentComponent() {
+  return current_component;
+}
+
+}  // namespace thread
+}  // namespace olp
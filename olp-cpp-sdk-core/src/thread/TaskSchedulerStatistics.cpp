@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/thread/TaskSchedulerStatistics.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace olp {
+namespace thread {
+
+namespace {
+// The bounds in microseconds: from 100us up to 10s.
+constexpr int64_t kBucketBounds[] = {100,    1000,    5000,    10000,
+                                     50000,  100000,  500000,  1000000,
+                                     5000000, 10000000};
+constexpr size_t kBucketCount = sizeof(kBucketBounds) / sizeof(int64_t) + 1u;
+
+void Record(TaskSchedulerStatistics::Histogram& histogram,
+            std::chrono::microseconds time) {
+  if (histogram.counts.empty()) {
+    histogram.counts.resize(kBucketCount, 0u);
+  }
+
+  const auto bucket =
+      std::lower_bound(std::begin(kBucketBounds), std::end(kBucketBounds),
+                       time.count()) -
+      std::begin(kBucketBounds);
+  ++histogram.counts[bucket];
+  ++histogram.count;
+  histogram.total += time;
+  histogram.max = std::max(histogram.max, time);
+}
+}  // namespace
+
+std::vector<std::chrono::microseconds>
+TaskSchedulerStatistics::GetBucketBounds() {
+  return std::vector<std::chrono::microseconds>(std::begin(kBucketBounds),
+                                                std::end(kBucketBounds));
+}
+
+TaskSchedulerStatistics::Statistics TaskSchedulerStatistics::GetStatistics()
+    const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+void TaskSchedulerStatistics::ResetHistograms() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_.components.clear();
+}
+
+void TaskSchedulerStatistics::OnTaskQueued(const TaskInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++statistics_.queue_depth[info.priority];
+}
+
+void TaskSchedulerStatistics::OnTaskStarted(
+    const TaskInfo& info, std::chrono::microseconds wait_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto depth = statistics_.queue_depth.find(info.priority);
+  if (depth != statistics_.queue_depth.end() && --depth->second == 0u) {
+    statistics_.queue_depth.erase(depth);
+  }
+  Record(statistics_.components[info.component].wait_time, wait_time);
+}
+
+void TaskSchedulerStatistics::OnTaskFinished(
+    const TaskInfo& info, std::chrono::microseconds run_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Record(statistics_.components[info.component].run_time, run_time);
+}
+
+}  // namespace thread
+}  // namespace olp
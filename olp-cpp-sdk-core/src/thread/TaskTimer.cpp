@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "TaskTimer.h"
+
+#include "ThreadUtils.h"
+
+namespace olp {
+namespace thread {
+
+TaskTimer::TaskTimer(EnqueueFunc enqueue) : enqueue_(std::move(enqueue)) {}
+
+TaskTimer::~TaskTimer() { Close(); }
+
+void TaskTimer::Schedule(PrioritizedTask&& task,
+                         std::chrono::milliseconds delay) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) {
+      return;
+    }
+
+    tasks_.emplace(Clock::now() + delay, std::move(task));
+    if (!thread_.joinable()) {
+      thread_ = std::thread(&TaskTimer::Run, this);
+    }
+  }
+  condition_.notify_one();
+}
+
+void TaskTimer::Close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    tasks_.clear();
+  }
+  condition_.notify_one();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void TaskTimer::Run() {
+  SetCurrentThreadName("OLPSDKTIMER");
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!closed_) {
+    if (tasks_.empty()) {
+      condition_.wait(lock);
+      continue;
+    }
+
+    auto it = tasks_.begin();
+    // Copy the time, as `Close` may clear the tasks while waiting.
+    const auto due_time = it->first;
+    if (Clock::now() < due_time) {
+      condition_.wait_until(lock, due_time);
+      continue;
+    }
+
+    enqueue_(std::move(it->second));
+    tasks_.erase(it);
+  }
+}
+
+}  // namespace thread
+}  // namespace olp
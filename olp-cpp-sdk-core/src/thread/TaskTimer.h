@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "olp/core/thread/TaskScheduler.h"
+
+namespace olp {
+namespace thread {
+
+/// The task with its priority, as queued by the schedulers.
+struct PrioritizedTask {
+  TaskScheduler::CallFuncType function;
+  uint32_t priority;
+};
+
+/// Orders the tasks by priority.
+struct ComparePrioritizedTask {
+  bool operator()(const PrioritizedTask& lhs,
+                  const PrioritizedTask& rhs) const {
+    return lhs.priority < rhs.priority;
+  }
+};
+
+/**
+ * @brief Keeps the delayed tasks and passes them to the scheduler queue when
+ * they are due.
+ *
+ * The timer thread is started with the first task, and the tasks due at the
+ * same time keep the scheduling order.
+ */
+class TaskTimer {
+ public:
+  /// Enqueues the due task in the scheduler.
+  using EnqueueFunc = std::function<void(PrioritizedTask&&)>;
+
+  explicit TaskTimer(EnqueueFunc enqueue);
+
+  ~TaskTimer();
+
+  /// Schedules the task to be enqueued after the delay.
+  void Schedule(PrioritizedTask&& task, std::chrono::milliseconds delay);
+
+  /// Drops the pending tasks and joins the timer thread.
+  void Close();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  void Run();
+
+  EnqueueFunc enqueue_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::multimap<Clock::time_point, PrioritizedTask> tasks_;
+  bool closed_{false};
+  std::thread thread_;
+};
+
+}  // namespace thread
+}  // namespace olp
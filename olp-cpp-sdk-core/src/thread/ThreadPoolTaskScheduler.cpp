@@ -19,94 +19,358 @@
 
 #include "olp/core/thread/ThreadPoolTaskScheduler.h"
 
-#if defined(PORTING_PLATFORM_QNX)
-#include <process.h>
-#elif defined(PORTING_PLATFORM_MAC)
-#include <pthread.h>
-#elif defined(PORTING_PLATFORM_LINUX) || defined(PORTING_PLATFORM_ANDROID)
-#ifndef _GNU_SOURCE
-#define _GNU_SOURCE 1
-#endif
-#include <pthread.h>
-#endif
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "TaskTimer.h"
+#include "ThreadUtils.h"
 #include "olp/core/logging/Log.h"
 #include "olp/core/porting/make_unique.h"
-#include "olp/core/porting/platform.h"
-#include "olp/core/thread/SyncQueue.h"
-#include "olp/core/utils/WarningWorkarounds.h"
-#include "thread/PriorityQueueExtended.h"
 
 namespace olp {
 namespace thread {
 
 namespace {
 constexpr auto kLogTag = "ThreadPoolTaskScheduler";
+}  // namespace
 
-void SetCurrentThreadName(const std::string& thread_name) {
-  // Currently only supported for pthread users
-  OLP_SDK_CORE_UNUSED(thread_name);
-
-#if defined(PORTING_PLATFORM_MAC)
-  // Note that in Mac based systems the pthread_setname_np takes 1 argument
-  // only.
-  pthread_setname_np(thread_name.c_str());
-#elif defined(OLP_SDK_HAVE_PTHREAD_SETNAME_NP)  // Linux, Android, QNX
-  // QNX allows 100 but Linux only 16 so select min value and apply for both.
-  // If maximum length is exceeded on some systems, e.g. Linux, the name is not
-  // set at all. So better truncate it to have at least the minimum set.
-  constexpr size_t kMaxThreadNameLength = 16u;
-  std::string truncated_name = thread_name.substr(0, kMaxThreadNameLength - 1);
-  pthread_setname_np(pthread_self(), truncated_name.c_str());
-#endif  // OLP_SDK_HAVE_PTHREAD_SETNAME_NP
-}
+/// Which tasks a pool thread runs.
+enum class Lane { kAny, kHighPriority, kLowPriority };
 
-struct PrioritizedTask {
-  TaskScheduler::CallFuncType function;
-  uint32_t priority;
-};
+class ThreadPoolTaskScheduler::QueueImpl {
+ public:
+  using ElementType = PrioritizedTask;
+  using Clock = std::chrono::steady_clock;
+
+  QueueImpl(std::chrono::milliseconds max_task_wait, bool notify_all)
+      : max_task_wait_(max_task_wait), notify_all_(notify_all) {}
+
+  bool Pull(Lane lane, ElementType& element) {
+    return PullUntil(lane, element, Clock::time_point::max());
+  }
+
+  /// Pulls the task, or returns false when the queue is closed or no task
+  /// comes until the deadline.
+  bool PullUntil(Lane lane, ElementType& element,
+                 Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto next = by_priority_.end();
+    auto ready = [&]() {
+      if (closed_) {
+        return true;
+      }
+      next = PickNext(lane);
+      return next != by_priority_.end();
+    };
+
+    // The threads that run any task are counted as idle for the elastic
+    // pool.
+    const bool counted = lane != Lane::kHighPriority;
+    if (counted) {
+      ++idle_count_;
+    }
+    if (deadline == Clock::time_point::max()) {
+      ready_.wait(lock, ready);
+    } else {
+      ready_.wait_until(lock, deadline, ready);
+    }
+    if (counted) {
+      --idle_count_;
+    }
+
+    if (closed_ || next == by_priority_.end()) {
+      return false;
+    }
+
+    auto task = tasks_.find(next->second);
+    element = std::move(task->second.task);
+    tasks_.erase(task);
+    by_priority_.erase(next);
+    return true;
+  }
+
+  /// Pushes the task, and returns true when there are more tasks than idle
+  /// threads.
+  bool Push(ElementType&& element) {
+    bool busy = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_) {
+        return false;
+      }
+
+      const auto sequence = next_sequence_++;
+      by_priority_.emplace(element.priority, sequence);
+      tasks_.emplace(sequence, QueuedTask{std::move(element), Clock::now()});
+      busy = tasks_.size() > idle_count_;
+    }
+
+    // The lane threads may not accept the task, so wake up all of them.
+    if (notify_all_) {
+      ready_.notify_all();
+    } else {
+      ready_.notify_one();
+    }
+    return busy;
+  }
+
+  /// Pushes the tasks under one lock, and returns the number of the tasks
+  /// that exceed the idle threads.
+  size_t PushAll(std::vector<TaskScheduler::CallFuncType>&& funcs,
+                 uint32_t priority) {
+    size_t wake_up = 0u;
+    bool wake_up_all = false;
+    size_t excess = 0u;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_ || funcs.empty()) {
+        return 0u;
+      }
+
+      const auto enqueued_at = Clock::now();
+      for (auto& func : funcs) {
+        const auto sequence = next_sequence_++;
+        by_priority_.emplace(priority, sequence);
+        tasks_.emplace(sequence, QueuedTask{{std::move(func), priority},
+                                            enqueued_at});
+      }
+      wake_up = std::min(funcs.size(), idle_count_);
+      wake_up_all = notify_all_ || wake_up == idle_count_;
+      if (tasks_.size() > idle_count_) {
+        excess = std::min(funcs.size(), tasks_.size() - idle_count_);
+      }
+    }
+
+    if (wake_up_all) {
+      ready_.notify_all();
+    } else {
+      for (size_t idx = 0u; idx < wake_up; ++idx) {
+        ready_.notify_one();
+      }
+    }
+    return excess;
+  }
+
+  void Close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      tasks_.clear();
+      by_priority_.clear();
+    }
+    ready_.notify_all();
+  }
+
+ private:
+  /// The priority and the sequence number of the task.
+  using Key = std::pair<uint32_t, uint64_t>;
+
+  struct QueuedTask {
+    PrioritizedTask task;
+    Clock::time_point enqueued_at;
+  };
+
+  /// Orders by the higher priority, then by the sending order.
+  struct CompareKey {
+    bool operator()(const Key& lhs, const Key& rhs) const {
+      return lhs.first > rhs.first ||
+             (lhs.first == rhs.first && lhs.second < rhs.second);
+    }
+  };
+
+  using PriorityIndex = std::set<Key, CompareKey>;
+
+  PriorityIndex::iterator PickNext(Lane lane) {
+    if (by_priority_.empty()) {
+      return by_priority_.end();
+    }
 
-struct ComparePrioritizedTask {
-  bool operator()(const PrioritizedTask& lhs,
-                  const PrioritizedTask& rhs) const {
-    return lhs.priority < rhs.priority;
+    if (lane == Lane::kHighPriority) {
+      auto next = by_priority_.begin();
+      return next->first >= thread::HIGH ? next : by_priority_.end();
+    }
+
+    // The oldest task runs first when it waits for too long.
+    if (max_task_wait_.count() > 0) {
+      const auto& oldest = *tasks_.begin();
+      if (Clock::now() - oldest.second.enqueued_at >= max_task_wait_) {
+        return by_priority_.find(
+            Key(oldest.second.task.priority, oldest.first));
+      }
+    }
+
+    if (lane == Lane::kLowPriority) {
+      auto next = by_priority_.lower_bound(Key(thread::NORMAL - 1u, 0u));
+      if (next != by_priority_.end()) {
+        return next;
+      }
+    }
+
+    return by_priority_.begin();
   }
+
+  const std::chrono::milliseconds max_task_wait_;
+  const bool notify_all_;
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool closed_{false};
+  uint64_t next_sequence_{0u};
+  size_t idle_count_{0u};
+  /// The tasks in the sending order.
+  std::map<uint64_t, QueuedTask> tasks_;
+  PriorityIndex by_priority_;
 };
 
-}  // namespace
+class ThreadPoolTaskScheduler::TimerImpl : public TaskTimer {
+ public:
+  using TaskTimer::TaskTimer;
+};
 
-class ThreadPoolTaskScheduler::QueueImpl {
+class ThreadPoolTaskScheduler::ElasticImpl {
  public:
-  using ElementType = PrioritizedTask;
+  ElasticImpl(QueueImpl& queue, size_t thread_count,
+              ElasticPoolSettings settings, ThreadAffinitySettings affinity)
+      : queue_(queue),
+        affinity_(std::move(affinity)),
+        max_extra_threads_(settings.max_thread_count > thread_count
+                               ? settings.max_thread_count - thread_count
+                               : 0u),
+        idle_timeout_(settings.idle_timeout),
+        next_index_(thread_count) {}
+
+  /// Starts an extra thread if the limit allows.
+  void Grow() {
+    if (max_extra_threads_ == 0u) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) {
+      return;
+    }
 
-  bool Pull(ElementType& element) { return sync_queue_.Pull(element); }
+    for (const auto& id : finished_) {
+      auto it = threads_.find(id);
+      if (it != threads_.end()) {
+        it->second.join();
+        threads_.erase(it);
+      }
+    }
+    finished_.clear();
+
+    if (threads_.size() >= max_extra_threads_) {
+      return;
+    }
+
+    std::thread executor(&ElasticImpl::Run, this, next_index_++);
+    const auto id = executor.get_id();
+    threads_.emplace(id, std::move(executor));
+  }
 
-  void Push(ElementType&& element) { sync_queue_.Push(std::move(element)); }
+  /// Joins the extra threads. The queue must be closed before.
+  void Close() {
+    std::map<std::thread::id, std::thread> threads;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      threads.swap(threads_);
+    }
 
-  void Close() { sync_queue_.Close(); }
+    for (auto& thread : threads) {
+      thread.second.join();
+    }
+  }
 
  private:
-  using PriorityQueue =
-      PriorityQueueExtended<ElementType, ComparePrioritizedTask>;
-  SyncQueue<ElementType, PriorityQueue> sync_queue_;
+  void Run(size_t idx) {
+    // Set thread name for easy profiling and debugging
+    std::string thread_name = "OLPSDKPOOL_" + std::to_string(idx);
+    SetCurrentThreadName(thread_name);
+    ApplyThreadAffinity(affinity_, idx);
+    OLP_SDK_LOG_DEBUG_F(kLogTag, "Starting extra thread '%s'",
+                        thread_name.c_str());
+
+    for (;;) {
+      PrioritizedTask task;
+      if (!queue_.PullUntil(Lane::kAny, task,
+                            QueueImpl::Clock::now() + idle_timeout_)) {
+        break;
+      }
+      task.function();
+    }
+
+    OLP_SDK_LOG_DEBUG_F(kLogTag, "Stopping extra thread '%s'",
+                        thread_name.c_str());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!closed_) {
+      finished_.push_back(std::this_thread::get_id());
+    }
+  }
+
+  QueueImpl& queue_;
+  const ThreadAffinitySettings affinity_;
+  const size_t max_extra_threads_;
+  const std::chrono::milliseconds idle_timeout_;
+
+  std::mutex mutex_;
+  size_t next_index_;
+  bool closed_{false};
+  std::map<std::thread::id, std::thread> threads_;
+  std::vector<std::thread::id> finished_;
 };
 
-ThreadPoolTaskScheduler::ThreadPoolTaskScheduler(size_t thread_count) {
-  queue_ = std::make_unique<QueueImpl>();
+ThreadPoolTaskScheduler::ThreadPoolTaskScheduler(size_t thread_count)
+    : ThreadPoolTaskScheduler(thread_count, PriorityLanesSettings()) {}
+
+ThreadPoolTaskScheduler::ThreadPoolTaskScheduler(
+    size_t thread_count, PriorityLanesSettings lanes,
+    ElasticPoolSettings elastic, ThreadAffinitySettings affinity) {
+  // Keep at least one thread that runs all the tasks.
+  const size_t high_priority_threads =
+      thread_count > 0u
+          ? std::min(lanes.high_priority_threads, thread_count - 1u)
+          : 0u;
+  const size_t low_priority_threads = std::min(
+      lanes.low_priority_threads, thread_count - high_priority_threads);
+
+  queue_ = std::make_unique<QueueImpl>(lanes.max_task_wait,
+                                       high_priority_threads > 0u);
+  elastic_ = std::make_unique<ElasticImpl>(*queue_, thread_count,
+                                           std::move(elastic), affinity);
+  timer_ = std::make_unique<TimerImpl>([this](PrioritizedTask&& task) {
+    if (queue_->Push(std::move(task))) {
+      elastic_->Grow();
+    }
+  });
 
   thread_pool_.reserve(thread_count);
 
   for (size_t idx = 0; idx < thread_count; ++idx) {
-    std::thread executor([this, idx]() {
+    Lane lane = Lane::kAny;
+    if (idx < high_priority_threads) {
+      lane = Lane::kHighPriority;
+    } else if (idx < high_priority_threads + low_priority_threads) {
+      lane = Lane::kLowPriority;
+    }
+
+    std::thread executor([this, idx, lane, affinity]() {
       // Set thread name for easy profiling and debugging
       std::string thread_name = "OLPSDKPOOL_" + std::to_string(idx);
       SetCurrentThreadName(thread_name);
+      ApplyThreadAffinity(affinity, idx);
       OLP_SDK_LOG_INFO_F(kLogTag, "Starting thread '%s'", thread_name.c_str());
 
       for (;;) {
         PrioritizedTask task;
-        if (!queue_->Pull(task)) {
+        if (!queue_->Pull(lane, task)) {
           return;
         }
         task.function();
@@ -118,7 +382,9 @@ ThreadPoolTaskScheduler::ThreadPoolTaskScheduler(size_t thread_count) {
 }
 
 ThreadPoolTaskScheduler::~ThreadPoolTaskScheduler() {
+  timer_->Close();
   queue_->Close();
+  elastic_->Close();
   for (auto& thread : thread_pool_) {
     thread.join();
   }
@@ -126,12 +392,30 @@ ThreadPoolTaskScheduler::~ThreadPoolTaskScheduler() {
 }
 
 void ThreadPoolTaskScheduler::EnqueueTask(TaskScheduler::CallFuncType&& func) {
-  queue_->Push({std::move(func), thread::NORMAL});
+  if (queue_->Push({std::move(func), thread::NORMAL})) {
+    elastic_->Grow();
+  }
 }
 
 void ThreadPoolTaskScheduler::EnqueueTask(TaskScheduler::CallFuncType&& func,
                                           uint32_t priority) {
-  queue_->Push({std::move(func), priority});
+  if (queue_->Push({std::move(func), priority})) {
+    elastic_->Grow();
+  }
+}
+
+void ThreadPoolTaskScheduler::EnqueueTasks(
+    std::vector<TaskScheduler::CallFuncType>&& funcs, uint32_t priority) {
+  for (auto excess = queue_->PushAll(std::move(funcs), priority); excess > 0u;
+       --excess) {
+    elastic_->Grow();
+  }
+}
+
+void ThreadPoolTaskScheduler::EnqueueDelayedTask(
+    TaskScheduler::CallFuncType&& func, std::chrono::milliseconds delay,
+    uint32_t priority) {
+  timer_->Schedule({std::move(func), priority}, delay);
 }
 
 }  // namespace thread
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "ThreadUtils.h"
+
+#include "olp/core/porting/platform.h"
+
+#if defined(PORTING_PLATFORM_QNX)
+#include <process.h>
+#elif defined(PORTING_PLATFORM_MAC)
+#include <pthread.h>
+#elif defined(PORTING_PLATFORM_LINUX) || defined(PORTING_PLATFORM_ANDROID)
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE 1
+#endif
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <fstream>
+#include <sstream>
+
+#include "olp/core/logging/Log.h"
+#include "olp/core/utils/WarningWorkarounds.h"
+
+namespace olp {
+namespace thread {
+
+namespace {
+constexpr auto kLogTag = "ThreadUtils";
+
+/// Parses the CPU list of the kernel, e.g. "0-3,8,10-11".
+std::vector<size_t> ParseCpuList(const std::string& list) {
+  std::vector<size_t> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    size_t first = 0u;
+    size_t last = 0u;
+    char dash = 0;
+    std::stringstream range_stream(range);
+    if (!(range_stream >> first)) {
+      continue;
+    }
+    last = first;
+    if (range_stream >> dash >> last && dash != '-') {
+      continue;
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+bool SetCurrentThreadCpus(const std::vector<size_t>& cpus) {
+#if defined(PORTING_PLATFORM_LINUX) || defined(PORTING_PLATFORM_ANDROID)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  // The thread id 0 is the calling thread.
+  return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+#else
+  OLP_SDK_CORE_UNUSED(cpus);
+  return false;
+#endif
+}
+}  // namespace
+
+void SetCurrentThreadName(const std::string& thread_name) {
+  // Currently only supported for pthread users
+  OLP_SDK_CORE_UNUSED(thread_name);
+
+#if defined(PORTING_PLATFORM_MAC)
+  // Note that in Mac based systems the pthread_setname_np takes 1 argument
+  // only.
+  pthread_setname_np(thread_name.c_str());
+#elif defined(OLP_SDK_HAVE_PTHREAD_SETNAME_NP)  // Linux, Android, QNX
+  // QNX allows 100 but Linux only 16 so select min value and apply for both.
+  // If maximum length is exceeded on some systems, e.g. Linux, the name is not
+  // set at all. So better truncate it to have at least the minimum set.
+  constexpr size_t kMaxThreadNameLength = 16u;
+  std::string truncated_name = thread_name.substr(0, kMaxThreadNameLength - 1);
+  pthread_setname_np(pthread_self(), truncated_name.c_str());
+#endif  // OLP_SDK_HAVE_PTHREAD_SETNAME_NP
+}
+
+std::vector<size_t> GetNumaNodeCpus(size_t node) {
+#if defined(PORTING_PLATFORM_LINUX) || defined(PORTING_PLATFORM_ANDROID)
+  std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) +
+                     "/cpulist");
+  std::string list;
+  if (std::getline(file, list)) {
+    return ParseCpuList(list);
+  }
+#else
+  OLP_SDK_CORE_UNUSED(node);
+#endif
+  return {};
+}
+
+std::vector<size_t> GetThreadCpus(const ThreadAffinitySettings& settings,
+                                  size_t thread_index) {
+  auto cpus = settings.cpus;
+  if (cpus.empty() && settings.numa_node >= 0) {
+    cpus = GetNumaNodeCpus(static_cast<size_t>(settings.numa_node));
+  }
+
+  if (settings.pin_each_thread && !cpus.empty()) {
+    return {cpus[thread_index % cpus.size()]};
+  }
+  return cpus;
+}
+
+void ApplyThreadAffinity(const ThreadAffinitySettings& settings,
+                         size_t thread_index) {
+  if (settings.cpus.empty() && settings.numa_node < 0) {
+    return;
+  }
+
+  const auto cpus = GetThreadCpus(settings, thread_index);
+  if (cpus.empty() || !SetCurrentThreadCpus(cpus)) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Failed to set the affinity of the thread "
+                                     << thread_index << ", numa_node="
+                                     << settings.numa_node
+                                     << ", cpus=" << cpus.size());
+  }
+}
+
+}  // namespace thread
+}  // namespace olp
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "olp/core/thread/ThreadAffinity.h"
+
+namespace olp {
+namespace thread {
+
+/// Sets the name of the current thread for easy profiling and debugging.
+void SetCurrentThreadName(const std::string& thread_name);
+
+/// Gets the CPUs of the NUMA node, or an empty list if unknown.
+std::vector<size_t> GetNumaNodeCpus(size_t node);
+
+/// Gets the CPUs the thread with the index may run on, or an empty list if
+/// it is not pinned.
+std::vector<size_t> GetThreadCpus(const ThreadAffinitySettings& settings,
+                                  size_t thread_index);
+
+/// Pins the current thread with the index according to the settings, and
+/// logs a warning if it fails.
+void ApplyThreadAffinity(const ThreadAffinitySettings& settings,
+                         size_t thread_index);
+
+}  // namespace thread
+}  // namespace olp
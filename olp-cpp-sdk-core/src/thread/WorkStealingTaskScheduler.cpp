@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/thread/WorkStealingTaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TaskTimer.h"
+#include "ThreadUtils.h"
+#include "olp/core/logging/Log.h"
+#include "olp/core/porting/make_unique.h"
+#include "thread/PriorityQueueExtended.h"
+
+namespace olp {
+namespace thread {
+
+namespace {
+constexpr auto kLogTag = "WorkStealingTaskScheduler";
+}  // namespace
+
+class WorkStealingTaskScheduler::Impl {
+ public:
+  explicit Impl(size_t thread_count);
+  ~Impl();
+
+  void Push(PrioritizedTask&& task);
+
+  void PushAll(std::vector<TaskScheduler::CallFuncType>&& funcs,
+               uint32_t priority);
+
+  void PushDelayed(PrioritizedTask&& task, std::chrono::milliseconds delay);
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    PriorityQueueExtended<PrioritizedTask, ComparePrioritizedTask> queue;
+  };
+
+  void Run(size_t index);
+
+  /// Pops the task from the own queue or steals the task with the highest
+  /// priority from the other queues.
+  bool Pop(size_t index, PrioritizedTask& task);
+
+  bool WaitForTask();
+
+  /// The pool and the index of the worker on the current thread.
+  static thread_local const Impl* current_pool_;
+  static thread_local size_t current_index_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> next_worker_{0u};
+  std::atomic<size_t> pending_{0u};
+  std::atomic<size_t> sleeping_{0u};
+
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_condition_;
+  std::atomic<bool> closed_{false};
+
+  std::unique_ptr<TaskTimer> timer_;
+};
+
+thread_local const WorkStealingTaskScheduler::Impl*
+    WorkStealingTaskScheduler::Impl::current_pool_ = nullptr;
+thread_local size_t WorkStealingTaskScheduler::Impl::current_index_ = 0u;
+
+WorkStealingTaskScheduler::Impl::Impl(size_t thread_count) {
+  thread_count = std::max<size_t>(thread_count, 1u);
+  workers_.reserve(thread_count);
+  for (size_t idx = 0; idx < thread_count; ++idx) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+
+  timer_ = std::make_unique<TaskTimer>(
+      [this](PrioritizedTask&& task) { Push(std::move(task)); });
+
+  threads_.reserve(thread_count);
+  for (size_t idx = 0; idx < thread_count; ++idx) {
+    threads_.emplace_back(&Impl::Run, this, idx);
+  }
+}
+
+WorkStealingTaskScheduler::Impl::~Impl() {
+  timer_->Close();
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    closed_ = true;
+  }
+  sleep_condition_.notify_all();
+
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkStealingTaskScheduler::Impl::Push(PrioritizedTask&& task) {
+  const auto index = current_pool_ == this
+                         ? current_index_
+                         : next_worker_.fetch_add(1u) % workers_.size();
+  {
+    auto& worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queue.push(std::move(task));
+  }
+  ++pending_;
+
+  if (sleeping_.load() > 0u) {
+    // Lock to not miss a worker that is going to sleep.
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    sleep_condition_.notify_one();
+  }
+}
+
+void WorkStealingTaskScheduler::Impl::PushAll(
+    std::vector<TaskScheduler::CallFuncType>&& funcs, uint32_t priority) {
+  if (funcs.empty()) {
+    return;
+  }
+
+  const auto index = current_pool_ == this
+                         ? current_index_
+                         : next_worker_.fetch_add(1u) % workers_.size();
+  {
+    auto& worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    for (auto& func : funcs) {
+      worker.queue.push({std::move(func), priority});
+    }
+  }
+  pending_ += funcs.size();
+
+  const auto sleeping = sleeping_.load();
+  if (sleeping > 0u) {
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    if (funcs.size() >= sleeping) {
+      sleep_condition_.notify_all();
+    } else {
+      for (size_t idx = 0u; idx < funcs.size(); ++idx) {
+        sleep_condition_.notify_one();
+      }
+    }
+  }
+}
+
+void WorkStealingTaskScheduler::Impl::PushDelayed(
+    PrioritizedTask&& task, std::chrono::milliseconds delay) {
+  timer_->Schedule(std::move(task), delay);
+}
+
+void WorkStealingTaskScheduler::Impl::Run(size_t index) {
+  // Set thread name for easy profiling and debugging
+  std::string thread_name = "OLPSDKSTEAL_" + std::to_string(index);
+  SetCurrentThreadName(thread_name);
+  OLP_SDK_LOG_INFO_F(kLogTag, "Starting thread '%s'", thread_name.c_str());
+
+  current_pool_ = this;
+  current_index_ = index;
+
+  while (WaitForTask()) {
+    PrioritizedTask task;
+    if (Pop(index, task)) {
+      task.function();
+    }
+  }
+
+  current_pool_ = nullptr;
+}
+
+bool WorkStealingTaskScheduler::Impl::Pop(size_t index,
+                                          PrioritizedTask& task) {
+  {
+    auto& worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.queue.empty()) {
+      task = std::move(worker.queue.front());
+      worker.queue.pop();
+      --pending_;
+      return true;
+    }
+  }
+
+  // Steals from the queue with the highest priority task. The queues may
+  // change meanwhile, so the victim is locked again before the steal.
+  for (;;) {
+    Worker* victim = nullptr;
+    uint32_t victim_priority = 0u;
+    for (size_t offset = 1u; offset < workers_.size(); ++offset) {
+      auto& worker = *workers_[(index + offset) % workers_.size()];
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      if (!worker.queue.empty() &&
+          (victim == nullptr ||
+           worker.queue.front().priority > victim_priority)) {
+        victim = &worker;
+        victim_priority = worker.queue.front().priority;
+      }
+    }
+
+    if (victim == nullptr) {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(victim->mutex);
+    if (!victim->queue.empty()) {
+      task = std::move(victim->queue.front());
+      victim->queue.pop();
+      --pending_;
+      return true;
+    }
+  }
+}
+
+bool WorkStealingTaskScheduler::Impl::WaitForTask() {
+  if (closed_.load()) {
+    return false;
+  }
+  if (pending_.load() > 0u) {
+    return true;
+  }
+
+  std::unique_lock<std::mutex> lock(sleep_mutex_);
+  ++sleeping_;
+  sleep_condition_.wait(lock,
+                        [this] { return closed_ || pending_.load() > 0u; });
+  --sleeping_;
+  return !closed_;
+}
+
+WorkStealingTaskScheduler::WorkStealingTaskScheduler(size_t thread_count)
+    : impl_(std::make_unique<Impl>(thread_count)) {}
+
+WorkStealingTaskScheduler::~WorkStealingTaskScheduler() = default;
+
+void WorkStealingTaskScheduler::EnqueueTask(
+    TaskScheduler::CallFuncType&& func) {
+  impl_->Push({std::move(func), thread::NORMAL});
+}
+
+void WorkStealingTaskScheduler::EnqueueTask(TaskScheduler::CallFuncType&& func,
+                                            uint32_t priority) {
+  impl_->Push({std::move(func), priority});
+}
+
+void WorkStealingTaskScheduler::EnqueueTasks(
+    std::vector<TaskScheduler::CallFuncType>&& funcs, uint32_t priority) {
+  impl_->PushAll(std::move(funcs), priority);
+}
+
+void WorkStealingTaskScheduler::EnqueueDelayedTask(
+    TaskScheduler::CallFuncType&& func, std::chrono::milliseconds delay,
+    uint32_t priority) {
+  impl_->PushDelayed({std::move(func), priority}, delay);
+}
+
+}  // namespace thread
+}  // namespace olp
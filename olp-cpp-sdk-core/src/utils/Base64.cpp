@@ -20,64 +20,71 @@
 #include "olp/core/utils/Base64.h"
 
 #include <algorithm>
-
-// clang-format off
-// Do not change this order as throw_exception.hpp defines
-// boost::throw_exception needed by all other boost classes
-#include <boost/throw_exception.hpp>
-#include <boost/archive/iterators/base64_from_binary.hpp>
-#include <boost/archive/iterators/binary_from_base64.hpp>
-#include <boost/archive/iterators/transform_width.hpp>
-// clang-format on
+#include <array>
 
 namespace olp {
 namespace utils {
 
 namespace {
-bool NotBase64Symbol(char c) {
-  return !((c >= '/' && c <= '9') || (c >= 'A' && c <= 'Z') ||
-           (c >= 'a' && c <= 'z') || c == '+');
-}
-
-bool IsValidBase64(const std::string& string) {
-  const size_t length = string.size();
-  if (length == 0) {
-    // empty string is a valid base64
-    return true;
-  }
-
-  if (length % 4 != 0) {
-    return false;
-  }
-
-  // check for padding (only last two characters)
-  auto end_no_padding = string.end();
-  if (string[length - 1] == '=') {
-    end_no_padding = std::prev(end_no_padding);
-    if (string[length - 2] == '=') {
-      end_no_padding = std::prev(end_no_padding);
+constexpr char kEncodeTable[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kPadding = '=';
+constexpr uint8_t kInvalid = 0x80u;
+
+/// Maps the Base64 symbols to their 6-bit values, and the other characters to
+/// `kInvalid`.
+struct DecodeTable {
+  DecodeTable() {
+    values.fill(kInvalid);
+    for (uint8_t idx = 0u; idx < 64u; ++idx) {
+      values[static_cast<uint8_t>(kEncodeTable[idx])] = idx;
     }
   }
 
-  return std::find_if(string.begin(), end_no_padding, NotBase64Symbol) ==
-         end_no_padding;
+  std::array<uint8_t, 256> values;
+};
+
+const DecodeTable& GetDecodeTable() {
+  static const DecodeTable table;
+  return table;
 }
 }  // anonymous namespace
 
 std::string Base64Encode(const void* bytes, size_t size) {
-  namespace iterators = boost::archive::iterators;
-  using It = iterators::base64_from_binary<
-      iterators::transform_width<const uint8_t*, 6, 8> >;
-
   if (size == 0 || !bytes) {
     return {};
   }
 
-  const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes);
-  auto return_string = std::string(It(data), It(data + size));
-  return_string.append((3 - size % 3) % 3, '=');
+  const auto* data = static_cast<const uint8_t*>(bytes);
+  std::string result((size + 2u) / 3u * 4u, kPadding);
+  auto* out = &result[0];
+
+  // Encodes three bytes into four symbols at a time, without the per-symbol
+  // bookkeeping of the iterator adaptors.
+  const auto* const full_end = data + size / 3u * 3u;
+  for (; data != full_end; data += 3u, out += 4u) {
+    const uint32_t chunk = (static_cast<uint32_t>(data[0]) << 16) |
+                           (static_cast<uint32_t>(data[1]) << 8) | data[2];
+    out[0] = kEncodeTable[(chunk >> 18) & 0x3Fu];
+    out[1] = kEncodeTable[(chunk >> 12) & 0x3Fu];
+    out[2] = kEncodeTable[(chunk >> 6) & 0x3Fu];
+    out[3] = kEncodeTable[chunk & 0x3Fu];
+  }
 
-  return return_string;
+  const auto tail = size % 3u;
+  if (tail != 0u) {
+    uint32_t chunk = static_cast<uint32_t>(data[0]) << 16;
+    if (tail == 2u) {
+      chunk |= static_cast<uint32_t>(data[1]) << 8;
+    }
+    out[0] = kEncodeTable[(chunk >> 18) & 0x3Fu];
+    out[1] = kEncodeTable[(chunk >> 12) & 0x3Fu];
+    if (tail == 2u) {
+      out[2] = kEncodeTable[(chunk >> 6) & 0x3Fu];
+    }
+  }
+
+  return result;
 }
 
 std::string Base64Encode(const std::vector<uint8_t>& bytes) {
@@ -92,40 +99,71 @@ std::string Base64Encode(const std::string& bytes) {
 
 bool Base64Decode(const std::string& string, std::vector<std::uint8_t>& bytes,
                   bool write_null_bytes) {
-  namespace iterators = boost::archive::iterators;
-  using It = iterators::transform_width<
-      iterators::binary_from_base64<std::string::const_iterator>, 8, 6>;
-
   if (string.empty()) {
     bytes.clear();
     return true;
   }
 
-  // check for validity of the input as boost will throw an exception
-  if (!IsValidBase64(string)) {
+  const size_t length = string.size();
+  if (length % 4 != 0) {
     return false;
   }
 
-  const size_t length = string.size();
   // check for padding (only last two characters)
-  // we have checked string.empty() and IsValidBase64(), that means string has
-  // at least 4 bytes
-  std::string::const_iterator end_no_padding = string.end();
-  if (string[length - 1] == '=') {
-    end_no_padding = std::prev(end_no_padding);
-    if (string[length - 2] == '=') {
-      end_no_padding = std::prev(end_no_padding);
+  size_t symbols = length;
+  if (string[length - 1] == kPadding) {
+    --symbols;
+    if (string[length - 2] == kPadding) {
+      --symbols;
+    }
+  }
+
+  const auto& table = GetDecodeTable().values;
+  const auto* in = reinterpret_cast<const uint8_t*>(string.data());
+  std::vector<std::uint8_t> result(symbols * 3u / 4u);
+  auto* out = result.data();
+
+  // The invalid symbols are collected in `invalid` and checked once, so the
+  // loop has no branches.
+  uint8_t invalid = 0u;
+  const auto* const full_end = in + symbols / 4u * 4u;
+  for (; in != full_end; in += 4u, out += 3u) {
+    const uint8_t a = table[in[0]];
+    const uint8_t b = table[in[1]];
+    const uint8_t c = table[in[2]];
+    const uint8_t d = table[in[3]];
+    invalid |= a | b | c | d;
+
+    const uint32_t chunk = (static_cast<uint32_t>(a) << 18) |
+                           (static_cast<uint32_t>(b) << 12) |
+                           (static_cast<uint32_t>(c) << 6) | d;
+    out[0] = static_cast<uint8_t>(chunk >> 16);
+    out[1] = static_cast<uint8_t>(chunk >> 8);
+    out[2] = static_cast<uint8_t>(chunk);
+  }
+
+  const auto tail = symbols % 4u;
+  if (tail >= 2u) {
+    const uint8_t a = table[in[0]];
+    const uint8_t b = table[in[1]];
+    const uint8_t c = tail == 3u ? table[in[2]] : 0u;
+    invalid |= a | b | c;
+
+    out[0] = static_cast<uint8_t>((a << 2) | (b >> 4));
+    if (tail == 3u) {
+      out[1] = static_cast<uint8_t>((b << 4) | (c >> 2));
     }
   }
 
-  bytes.resize(length / 4 * 3);
-  auto it =
-      write_null_bytes
-          ? std::copy(It(std::begin(string)), It(end_no_padding), bytes.begin())
-          : std::copy_if(It(std::begin(string)), It(end_no_padding),
-                         bytes.begin(), [](char c) { return c != '\0'; });
-  bytes.resize(std::distance(bytes.begin(), it));
+  if ((invalid & kInvalid) != 0u) {
+    return false;
+  }
+
+  if (!write_null_bytes) {
+    result.erase(std::remove(result.begin(), result.end(), 0u), result.end());
+  }
 
+  bytes.swap(result);
   return true;
 }
 
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "CompactKeyLruCache.h"
+#include "KeyPrefixTable.h"
+
+namespace {
+using olp::cache::CompactKey;
+using olp::cache::CompactKeyLruCache;
+using olp::cache::KeyPrefixTable;
+
+const std::string kPrefix = "hrn:here:data::olp-here-test:catalog::layer::";
+
+TEST(KeyPrefixTableTest, Compress) {
+  KeyPrefixTable table;
+
+  const auto data_key = kPrefix + "handle::Data";
+  const auto compact = table.Compress(data_key);
+  EXPECT_NE(compact.prefix, KeyPrefixTable::kNoPrefix);
+  EXPECT_EQ(compact.suffix, "handle::Data");
+  EXPECT_EQ(table.Expand(compact), data_key);
+  EXPECT_TRUE(table.Find(data_key) == compact);
+
+  // The keys of the same catalog and layer share the prefix.
+  const auto partition_key = kPrefix + "23618402::3::partition";
+  EXPECT_EQ(table.Compress(partition_key).prefix, compact.prefix);
+  EXPECT_EQ(table.Size(), 2u);
+
+  // The shorter keys use the prefix up to their last separator.
+  const auto catalog_key = std::string("hrn:here:data::olp-here-test:catalog");
+  const auto catalog = table.Compress(catalog_key + "::catalog");
+  EXPECT_EQ(catalog.suffix, "catalog");
+  EXPECT_EQ(table.Expand(catalog), catalog_key + "::catalog");
+
+  const auto plain = table.Compress("plain");
+  EXPECT_EQ(plain.prefix, KeyPrefixTable::kNoPrefix);
+  EXPECT_EQ(table.Expand(plain), "plain");
+
+  // The unknown prefixes are not interned on lookup.
+  const auto unknown = table.Find("other::catalog::layer::key");
+  EXPECT_EQ(unknown.prefix, KeyPrefixTable::kNoPrefix);
+  EXPECT_EQ(unknown.suffix, "other::catalog::layer::key");
+}
+
+TEST(KeyPrefixTableTest, StartsWith) {
+  KeyPrefixTable table;
+  const auto key = table.Compress(kPrefix + "handle::Data");
+
+  EXPECT_TRUE(table.StartsWith(key, "hrn:here:data"));
+  EXPECT_TRUE(table.StartsWith(key, kPrefix));
+  EXPECT_TRUE(table.StartsWith(key, kPrefix + "hand"));
+  EXPECT_TRUE(table.StartsWith(key, kPrefix + "handle::Data"));
+  EXPECT_FALSE(table.StartsWith(key, kPrefix + "handle::Data2"));
+  EXPECT_FALSE(table.StartsWith(key, kPrefix + "other"));
+  EXPECT_FALSE(table.StartsWith(key, "hrn:here:data::other"));
+}
+
+TEST(KeyPrefixTableTest, Limit) {
+  KeyPrefixTable table;
+  for (size_t i = 0u; i < KeyPrefixTable::kMaxPrefixes; ++i) {
+    table.Compress("catalog" + std::to_string(i) + "::layer::key");
+  }
+  EXPECT_EQ(table.Size(), KeyPrefixTable::kMaxPrefixes);
+
+  const std::string key = "catalog::layer::key";
+  const auto compact = table.Compress(key);
+  EXPECT_EQ(compact.prefix, KeyPrefixTable::kNoPrefix);
+  EXPECT_TRUE(table.Find(key) == compact);
+  EXPECT_EQ(table.Expand(compact), key);
+}
+
+TEST(CompactKeyLruCacheTest, LruOrder) {
+  CompactKeyLruCache<int> cache(100u);
+  cache.InsertOrAssign(kPrefix + "a", 1);
+  cache.InsertOrAssign(kPrefix + "b", 2);
+  cache.InsertOrAssign("c", 3);
+
+  std::vector<std::string> keys;
+  for (const auto& entry : cache) {
+    keys.push_back(entry.key());
+  }
+  EXPECT_EQ(keys,
+            (std::vector<std::string>{"c", kPrefix + "b", kPrefix + "a"}));
+
+  cache.Find(kPrefix + "a");
+  EXPECT_EQ(cache.begin()->key(), kPrefix + "a");
+  EXPECT_EQ(cache.rbegin()->key(), kPrefix + "b");
+  EXPECT_EQ(cache.FindNoPromote(kPrefix + "b")->value(), 2);
+  EXPECT_EQ(cache.FindNoPromote(kPrefix + "d"), cache.end());
+
+  auto it = cache.rbegin();
+  cache.Erase(it);
+  EXPECT_EQ(it, cache.end());
+  EXPECT_TRUE(cache.Erase("c"));
+  EXPECT_EQ(cache.Size(), 1u);
+}
+
+TEST(CompactKeyLruCacheTest, ErasePrefix) {
+  CompactKeyLruCache<int> cache(100u);
+  for (int i = 0; i < 10; ++i) {
+    cache.InsertOrAssign(kPrefix + std::to_string(i), i);
+    cache.InsertOrAssign("other::" + std::to_string(i), i);
+  }
+
+  std::vector<std::string> removed;
+  EXPECT_EQ(cache.ErasePrefix(kPrefix + "1",
+                              [&](const std::string& key, int) {
+                                removed.push_back(key);
+                                return true;
+                              }),
+            1u);
+  EXPECT_EQ(removed, std::vector<std::string>{kPrefix + "1"});
+
+  EXPECT_EQ(cache.ErasePrefix("hrn:",
+                              [](const std::string&, int value) {
+                                return value % 2 == 0;
+                              }),
+            5u);
+  EXPECT_EQ(cache.Size(), 14u);
+
+  // The compact keys stay valid after the cache is cleared.
+  const auto compact = cache.ToCompactKey(kPrefix + "3");
+  cache.Clear();
+  EXPECT_EQ(cache.ToKey(compact), kPrefix + "3");
+  EXPECT_EQ(cache.begin(), cache.end());
+}
+}  // namespace
@@ -18,9 +18,14 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <thread>
 
 #include <cache/DefaultCacheImpl.h>
+#include <olp/core/cache/RefetchCostScope.h>
+#include <olp/core/client/MemoryBudget.h>
 #include <olp/core/utils/Dir.h>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -44,6 +49,32 @@ class DefaultCacheImplTest : public ::testing::Test {
       olp::utils::Dir::TempDirectory() + "/unittest";
 };
 
+// Reverses the value, refuses to encode values shorter than 2 bytes.
+class ReverseCodec : public cache::CacheCodec {
+ public:
+  explicit ReverseCodec(std::uint8_t id = 7u) : id_(id) {}
+
+  std::uint8_t GetId() const override { return id_; }
+
+  bool Encode(const char* data, size_t size,
+              std::string& output) const override {
+    if (size < 2u) {
+      return false;
+    }
+    output.assign(data, size);
+    std::reverse(output.begin(), output.end());
+    return true;
+  }
+
+  bool Decode(const char* data, size_t size,
+              std::string& output) const override {
+    return Encode(data, size, output);
+  }
+
+ private:
+  std::uint8_t id_;
+};
+
 class DefaultCacheImplHelper : public cache::DefaultCacheImpl {
  public:
   explicit DefaultCacheImplHelper(const cache::CacheSettings& settings)
@@ -75,6 +106,15 @@ class DefaultCacheImplHelper : public cache::DefaultCacheImpl {
     return !memory_cache->Get(key).empty();
   }
 
+  std::string GetMutableCacheRaw(const std::string& key) const {
+    const auto& disk_cache = GetCache(CacheType::kMutable);
+    if (!disk_cache) {
+      return {};
+    }
+
+    return disk_cache->Get(key).get_value_or({});
+  }
+
   bool ContainsMutableCache(const std::string& key) const {
     const auto& disk_cache = GetCache(CacheType::kMutable);
     if (!disk_cache) {
@@ -100,6 +140,7 @@ class DefaultCacheImplHelper : public cache::DefaultCacheImpl {
   }
 
   DiskLruCache::const_iterator BeginLru() {
+    PromoteBufferedKeys();
     const auto& lru_cache = GetMutableCacheLru();
     if (!lru_cache) {
       return DiskLruCache::const_iterator{};
@@ -274,6 +315,75 @@ TEST_F(DefaultCacheImplTest, LruCacheGetPromote) {
   }
 }
 
+TEST_F(DefaultCacheImplTest, LruCacheCheckpoint) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  constexpr auto checkpoint_key{"internal::lru::checkpoint"};
+  const std::vector<std::string> keys = {"somekey1", "somekey2", "somekey3"};
+  const std::string data_string{"this is key's data"};
+
+  auto lru_keys = [](DefaultCacheImplHelper& cache) {
+    std::vector<std::string> result;
+    for (auto it = cache.BeginLru(); it != cache.EndLru(); ++it) {
+      result.push_back(it->key());
+    }
+    return result;
+  };
+
+  std::vector<std::string> expected_keys;
+  uint64_t expected_size = 0u;
+  {
+    DefaultCacheImplHelper cache(settings);
+    cache.Open();
+    cache.Clear();
+    for (const auto& key : keys) {
+      cache.Put(key, data_string, [=]() { return data_string; }, 1000);
+    }
+    cache.Get(keys[0], [=](const std::string&) { return data_string; });
+
+    expected_keys = lru_keys(cache);
+    expected_size = cache.Size(CacheType::kMutable);
+    ASSERT_EQ(keys.size(), expected_keys.size());
+    EXPECT_EQ(keys[0], expected_keys.front());
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("Restore from checkpoint");
+
+    DefaultCacheImplHelper cache(settings);
+    cache.Open();
+
+    EXPECT_EQ(expected_keys, lru_keys(cache));
+    EXPECT_EQ(expected_size, cache.Size(CacheType::kMutable));
+    EXPECT_FALSE(cache.ContainsMutableCache(checkpoint_key));
+    EXPECT_TRUE(cache.Contains(keys[1]));
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("Invalid checkpoint falls back to scan");
+
+    {
+      cache::DiskCache disk_cache;
+      ASSERT_EQ(cache::OpenResult::Success,
+                disk_cache.Open(cache_path_, cache_path_,
+                                cache::StorageSettings(),
+                                cache::OpenOptions::Default));
+      ASSERT_TRUE(disk_cache.Put(checkpoint_key, "invalid"));
+    }
+
+    DefaultCacheImplHelper cache(settings);
+    cache.Open();
+
+    auto restored_keys = lru_keys(cache);
+    std::sort(restored_keys.begin(), restored_keys.end());
+    EXPECT_EQ(keys, restored_keys);
+    EXPECT_EQ(expected_size, cache.Size(CacheType::kMutable));
+    EXPECT_FALSE(cache.ContainsMutableCache(checkpoint_key));
+  }
+}
+
 TEST_F(DefaultCacheImplTest, LruCacheRemove) {
   cache::CacheSettings settings;
   settings.disk_path_mutable = olp::utils::Dir::TempDirectory() + "/unittest";
@@ -792,6 +902,62 @@ TEST_F(DefaultCacheImplTest, LruCacheEviction) {
   }
 }
 
+TEST_F(DefaultCacheImplTest, CostAwareEviction) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_memory_cache_size = 0u;
+  settings.max_disk_storage = 64u * 1024u;
+  settings.eviction_policy = cache::EvictionPolicy::kCostAware;
+  const std::string metadata(100u, 'm');
+  const std::string tile(1024u, 't');
+  const auto metadata_count = 4u;
+  const auto tiles_count = 200u;
+
+  {
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    cache.Clear();
+
+    {
+      cache::RefetchCostScope scope(std::chrono::milliseconds(500));
+      for (auto i = 0u; i < metadata_count; ++i) {
+        ASSERT_TRUE(cache.Put("meta::" + std::to_string(i), metadata,
+                              [=]() { return metadata; },
+                              (std::numeric_limits<time_t>::max)()));
+      }
+    }
+
+    cache::RefetchCostScope scope(std::chrono::milliseconds(10));
+    for (auto i = 0u; i < tiles_count; ++i) {
+      ASSERT_TRUE(cache.Put("tile::" + std::to_string(i), tile,
+                            [=]() { return tile; },
+                            (std::numeric_limits<time_t>::max)()));
+    }
+
+    SCOPED_TRACE("The cheap large values are evicted first");
+
+    EXPECT_GT(cache.GetEvictionStatistics().evicted_items, 0u);
+    EXPECT_FALSE(cache.ContainsMutableCache("tile::0"));
+    EXPECT_TRUE(cache.ContainsMutableCache(
+        "tile::" + std::to_string(tiles_count - 1u)));
+    for (auto i = 0u; i < metadata_count; ++i) {
+      EXPECT_TRUE(cache.ContainsMutableCache("meta::" + std::to_string(i)));
+    }
+    cache.Close();
+  }
+
+  {
+    SCOPED_TRACE("The costs are restored from the checkpoint");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    for (auto it = cache.BeginLru(); it != cache.EndLru(); ++it) {
+      const auto expected_cost = it->key().find("meta::") == 0u ? 500u : 10u;
+      EXPECT_EQ(expected_cost, it->value().cost);
+    }
+  }
+}
+
 TEST_F(DefaultCacheImplTest, ProtectTest) {
   const std::string key1_data_string = "this is key1's data";
   const std::string key2_data_string = "this is key2's data";
@@ -878,6 +1044,356 @@ TEST_F(DefaultCacheImplTest, ProtectTest) {
   }
 }
 
+TEST_F(DefaultCacheImplTest, ExpiryIndex) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_memory_cache_size = 0u;
+  settings.max_disk_storage = 1024u * 1024u;
+  const std::string data_string{"this is key's data"};
+  const auto encoder = [=]() { return data_string; };
+  const auto decoder = [](const std::string& value) { return value; };
+
+  DefaultCacheImplHelper cache(settings);
+  ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+  cache.Clear();
+
+  // The expiry of key3 is removed by the second put.
+  ASSERT_TRUE(cache.Put("key1", data_string, encoder, -1));
+  ASSERT_TRUE(cache.Put("key2", data_string, encoder, 1000));
+  ASSERT_TRUE(cache.Put("key3", data_string, encoder, -1));
+  ASSERT_TRUE(cache.Put("key3", data_string, encoder,
+                        (std::numeric_limits<time_t>::max)()));
+
+  {
+    SCOPED_TRACE("Expiry is taken from the LRU");
+
+    EXPECT_TRUE(cache.Get("key1", decoder).empty());
+    EXPECT_FALSE(cache.ContainsMutableCache("key1"));
+    EXPECT_FALSE(cache.Get("key2", decoder).empty());
+    EXPECT_FALSE(cache.Get("key3", decoder).empty());
+  }
+
+  {
+    SCOPED_TRACE("Only expired data is evicted");
+
+    ASSERT_TRUE(cache.Put("key1", data_string, encoder, -1));
+
+    // Evict a few bytes, which are taken from the expired key1.
+    const auto data_size = cache.Size(CacheType::kMutable);
+    cache.Size(static_cast<uint64_t>(data_size / 0.9));
+
+    EXPECT_FALSE(cache.ContainsMutableCache("key1"));
+    EXPECT_FALSE(cache.ContainsLru("key1"));
+    EXPECT_TRUE(cache.ContainsMutableCache("key2"));
+    EXPECT_TRUE(cache.ContainsMutableCache("key3"));
+    EXPECT_EQ(1u, cache.GetEvictionStatistics().evicted_items);
+  }
+}
+
+TEST_F(DefaultCacheImplTest, PrefixQuotas) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_memory_cache_size = 0u;
+  settings.max_disk_storage = 1024u * 1024u;
+  settings.prefix_quotas = {{"tiles::", 1000u},
+                            {"tiles::pinned::", 1024u * 1024u}};
+  const std::string data_string(100u, 'x');
+  const auto encoder = [=]() { return data_string; };
+  const auto tiles_count = 100u;
+  const auto other_count = 5u;
+
+  const auto count_tiles = [&](DefaultCacheImplHelper& cache) {
+    auto count = 0u;
+    for (auto i = 0u; i < tiles_count; ++i) {
+      if (cache.ContainsMutableCache("tiles::" + std::to_string(i))) {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  {
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    cache.Clear();
+
+    for (auto i = 0u; i < other_count; ++i) {
+      ASSERT_TRUE(cache.Put("meta::" + std::to_string(i), data_string,
+                            encoder, -1));
+      ASSERT_TRUE(cache.Put("tiles::pinned::" + std::to_string(i),
+                            data_string, encoder, -1));
+    }
+    for (auto i = 0u; i < tiles_count; ++i) {
+      ASSERT_TRUE(cache.Put("tiles::" + std::to_string(i), data_string,
+                            encoder, -1));
+    }
+
+    SCOPED_TRACE("Only the keys of the quota are evicted");
+
+    const auto count = count_tiles(cache);
+    EXPECT_GT(count, 0u);
+    EXPECT_LE(count * (data_string.size() + 8u), 1000u);
+    EXPECT_FALSE(cache.ContainsMutableCache("tiles::0"));
+    EXPECT_FALSE(cache.ContainsLru("tiles::0"));
+    EXPECT_TRUE(cache.ContainsMutableCache("tiles::99"));
+    for (auto i = 0u; i < other_count; ++i) {
+      EXPECT_TRUE(cache.ContainsMutableCache("meta::" + std::to_string(i)));
+      EXPECT_TRUE(
+          cache.ContainsMutableCache("tiles::pinned::" + std::to_string(i)));
+    }
+    EXPECT_EQ(tiles_count - count,
+              cache.GetEvictionStatistics().evicted_items);
+  }
+
+  {
+    SCOPED_TRACE("Quota usage is restored on open");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    const auto count = count_tiles(cache);
+
+    for (auto i = 0u; i < tiles_count; ++i) {
+      ASSERT_TRUE(cache.Put("tiles::" + std::to_string(i), data_string,
+                            encoder, -1));
+    }
+
+    EXPECT_LE(count_tiles(cache), count + 1u);
+    EXPECT_TRUE(cache.ContainsMutableCache("meta::0"));
+  }
+}
+
+TEST_F(DefaultCacheImplTest, ScheduleCompaction) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_memory_cache_size = 0u;
+  const auto data = std::make_shared<cache::KeyValueCache::ValueType>(
+      100u * 1024u, 'x');
+  const auto count = 25u;
+
+  DefaultCacheImplHelper cache(settings);
+  ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+  cache.Clear();
+  for (auto i = 0u; i < count; ++i) {
+    ASSERT_TRUE(cache.Put("key" + std::to_string(i), data, -1));
+  }
+
+  {
+    SCOPED_TRACE("All key ranges are compacted");
+
+    const auto statistics = cache.ScheduleCompaction(0u).get();
+    EXPECT_EQ(3u, statistics.compacted_ranges);
+    EXPECT_GE(statistics.compacted_bytes, count * data->size());
+    EXPECT_EQ(
+        statistics.reclaimed_bytes,
+        std::max(statistics.size_before, statistics.size_after) -
+            statistics.size_after);
+  }
+
+  {
+    SCOPED_TRACE("Compaction is throttled and stopped by close");
+
+    auto future = cache.ScheduleCompaction(1024u);
+    cache.Close();
+    ASSERT_EQ(std::future_status::ready,
+              future.wait_for(std::chrono::seconds(0)));
+    EXPECT_LE(future.get().compacted_ranges, 1u);
+  }
+
+  {
+    SCOPED_TRACE("Closed cache is not compacted");
+
+    const auto statistics = cache.ScheduleCompaction(0u).get();
+    EXPECT_EQ(0u, statistics.compacted_ranges);
+  }
+}
+
+TEST_F(DefaultCacheImplTest, WarmUp) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.collect_metrics = true;
+  const std::string data_string{"this is key's data"};
+  const auto data = std::make_shared<cache::KeyValueCache::ValueType>(
+      data_string.begin(), data_string.end());
+  const auto decoder = [](const std::string& value) { return value; };
+  const auto count = 3u;
+
+  {
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    cache.Clear();
+    for (auto i = 0u; i < count; ++i) {
+      ASSERT_TRUE(cache.Put("hot::" + std::to_string(i), data,
+                            (std::numeric_limits<time_t>::max)()));
+      ASSERT_TRUE(cache.Put("cold::" + std::to_string(i), data,
+                            (std::numeric_limits<time_t>::max)()));
+    }
+    ASSERT_TRUE(cache.Put("hot::expired", data, -1));
+    cache.Close();
+  }
+
+  DefaultCacheImplHelper cache(settings);
+  ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+
+  {
+    SCOPED_TRACE("Keys with the prefix are loaded into memory");
+
+    auto future = cache.WarmUp({"hot::"}, 1024u, nullptr);
+    EXPECT_EQ(count * data->size(), future.get());
+    for (auto i = 0u; i < count; ++i) {
+      EXPECT_TRUE(cache.ContainsMemoryCache("hot::" + std::to_string(i)));
+      EXPECT_FALSE(cache.ContainsMemoryCache("cold::" + std::to_string(i)));
+    }
+    EXPECT_FALSE(cache.ContainsMemoryCache("hot::expired"));
+
+    // The warm-up reads are not lookups.
+    EXPECT_EQ(0u, cache.GetMetrics().mutable_disk.hits);
+
+    const auto value = cache.Get("hot::0");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*data, *value);
+  }
+
+  {
+    SCOPED_TRACE("Byte budget is respected");
+
+    auto future = cache.WarmUp({"cold::"}, data->size(), decoder);
+    EXPECT_EQ(data->size(), future.get());
+    EXPECT_TRUE(cache.ContainsMemoryCache("cold::0"));
+    EXPECT_FALSE(cache.ContainsMemoryCache("cold::1"));
+
+    const auto value = cache.Get("cold::0", decoder);
+    ASSERT_FALSE(value.empty());
+    EXPECT_EQ(data_string, boost::any_cast<std::string>(value));
+  }
+
+  {
+    SCOPED_TRACE("Nothing is loaded once closed");
+
+    cache.Close();
+    EXPECT_EQ(0u, cache.WarmUp({"cold::"}, 1024u, nullptr).get());
+  }
+}
+
+TEST_F(DefaultCacheImplTest, ConcurrentLookups) {
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_memory_cache_size = 0u;
+  settings.max_disk_storage = 4u * 1024u * 1024u;
+  const auto key_count = 64;
+  const auto data = std::make_shared<cache::KeyValueCache::ValueType>(
+      cache::KeyValueCache::ValueType(100u, 'a'));
+  const auto decoder = [](const std::string& value) { return value; };
+
+  DefaultCacheImplHelper cache(settings);
+  ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+  cache.Clear();
+  for (auto i = 0; i < key_count; ++i) {
+    ASSERT_TRUE(cache.Put("key" + std::to_string(i), data,
+                          (std::numeric_limits<time_t>::max)()));
+  }
+  ASSERT_TRUE(cache.Put("expired", data, -1));
+
+  // Lookups run in parallel with each other and with the writes.
+  std::atomic<int> failures{0};
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t]() {
+      for (auto i = 0; i < 10 * key_count; ++i) {
+        const auto key = "key" + std::to_string((i + t) % key_count);
+        const auto value = cache.Get(key);
+        if (!value || *value != *data || !cache.Contains(key) ||
+            cache.Get(key, decoder).empty() || !cache.GetView(key)) {
+          ++failures;
+        }
+        if (cache.Get("expired")) {
+          ++failures;
+        }
+      }
+    });
+  }
+  threads.emplace_back([&]() {
+    for (auto i = 0; i < key_count; ++i) {
+      cache.Put("other" + std::to_string(i), data,
+                (std::numeric_limits<time_t>::max)());
+    }
+  });
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(0, failures.load());
+  EXPECT_FALSE(cache.ContainsMutableCache("expired"));
+  EXPECT_FALSE(cache.ContainsLru("expired"));
+}
+
+TEST_F(DefaultCacheImplTest, BackgroundEviction) {
+  const auto prefix = std::string("somekey");
+  const auto data_size = 1024u;
+  const std::vector<unsigned char> binary_data(data_size);
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_disk_storage = 2u * 1024u * 1024u;
+  settings.max_memory_cache_size = 0u;
+
+  const auto fill_cache = [&](DefaultCacheImplHelper& cache) {
+    const auto count = 3u * settings.max_disk_storage / (2u * data_size);
+    for (auto i = 0u; i < count; ++i) {
+      ASSERT_TRUE(cache.Put(
+          prefix + std::to_string(i),
+          std::make_shared<std::vector<unsigned char>>(binary_data),
+          (std::numeric_limits<time_t>::max)()));
+    }
+  };
+  const auto high_watermark =
+      settings.eviction_high_watermark * settings.max_disk_storage;
+
+  {
+    SCOPED_TRACE("Inline eviction statistics");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    cache.Clear();
+    fill_cache(cache);
+
+    const auto statistics = cache.GetEvictionStatistics();
+    EXPECT_GT(statistics.evicted_items, 0u);
+    EXPECT_GT(statistics.evicted_bytes, statistics.evicted_items * data_size);
+    EXPECT_LE(cache.Size(CacheType::kMutable), high_watermark);
+    EXPECT_FALSE(cache.ContainsMutableCache(prefix + "0"));
+    cache.Clear();
+  }
+
+  {
+    SCOPED_TRACE("Background eviction");
+
+    settings.background_eviction = true;
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    cache.Clear();
+    fill_cache(cache);
+
+    // The last eviction stops at the low watermark, the puts after it might
+    // fill the cache up to the high watermark again.
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (cache.Size(CacheType::kMutable) > high_watermark &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    EXPECT_LE(cache.Size(CacheType::kMutable), high_watermark);
+    EXPECT_GT(cache.GetEvictionStatistics().evicted_items, 0u);
+    EXPECT_FALSE(cache.ContainsMutableCache(prefix + "0"));
+    EXPECT_FALSE(cache.ContainsLru(prefix + "0"));
+
+    const auto last_key = prefix + std::to_string(
+        3u * settings.max_disk_storage / (2u * data_size) - 1u);
+    EXPECT_TRUE(cache.ContainsMutableCache(last_key));
+    cache.Close();
+  }
+}
+
 TEST_F(DefaultCacheImplTest, LruCacheEvictionWithProtected) {
   {
     SCOPED_TRACE("Protect and release keys, which suppose to be evicted");
@@ -1309,4 +1825,318 @@ TEST_F(DefaultCacheImplTest, ProtectedCacheSize) {
 
   EXPECT_LT(std::fabs(diff_percentage), acceptable_diff_percentage);
 }
+
+TEST_F(DefaultCacheImplTest, WriteBehind) {
+  const auto data = std::make_shared<cache::KeyValueCache::ValueType>(
+      cache::KeyValueCache::ValueType{1, 2, 3});
+  const auto decoder = [](const std::string& value) { return value; };
+
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_memory_cache_size = 0;
+  settings.write_behind_queue_size = 4;
+  settings.write_behind_max_lag = std::chrono::hours(1);
+
+  {
+    SCOPED_TRACE("Pending values are visible and written on flush");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+
+    ASSERT_TRUE(cache.Put("key1", data, cache::KeyValueCache::kDefaultExpiry));
+    ASSERT_TRUE(cache.Put("key2", std::string("value"),
+                          []() { return std::string("value"); },
+                          cache::KeyValueCache::kDefaultExpiry));
+    ASSERT_TRUE(cache.Put("expired_key", data, -1));
+    EXPECT_FALSE(cache.ContainsMutableCache("key1"));
+    EXPECT_FALSE(cache.ContainsMutableCache("key2"));
+
+    EXPECT_TRUE(cache.Contains("key1"));
+    EXPECT_FALSE(cache.Contains("expired_key"));
+    ASSERT_TRUE(cache.Get("key1"));
+    EXPECT_EQ(*data, *cache.Get("key1"));
+    EXPECT_EQ("value",
+              boost::any_cast<std::string>(cache.Get("key2", decoder)));
+    EXPECT_FALSE(cache.Get("expired_key"));
+
+    EXPECT_TRUE(cache.Remove("key2"));
+    EXPECT_FALSE(cache.Contains("key2"));
+
+    ASSERT_TRUE(cache.Flush());
+    EXPECT_TRUE(cache.ContainsMutableCache("key1"));
+    EXPECT_FALSE(cache.ContainsMutableCache("key2"));
+    EXPECT_TRUE(cache.ContainsLru("key1"));
+    EXPECT_EQ(*data, *cache.Get("key1"));
+  }
+
+  {
+    SCOPED_TRACE("Full queue is written by the caller");
+
+    settings.write_behind_queue_size = 3;
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+
+    ASSERT_TRUE(cache.Put("key1", data, cache::KeyValueCache::kDefaultExpiry));
+    ASSERT_TRUE(cache.Put("key2", data, cache::KeyValueCache::kDefaultExpiry));
+    EXPECT_FALSE(cache.ContainsMutableCache("key1"));
+    ASSERT_TRUE(cache.Put("key3", data, cache::KeyValueCache::kDefaultExpiry));
+    EXPECT_TRUE(cache.ContainsMutableCache("key1"));
+    EXPECT_TRUE(cache.ContainsMutableCache("key2"));
+    EXPECT_TRUE(cache.ContainsMutableCache("key3"));
+  }
+
+  {
+    SCOPED_TRACE("Pending values are written on close");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Put("key1", data, cache::KeyValueCache::kDefaultExpiry));
+    cache.Close();
+
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    EXPECT_TRUE(cache.ContainsMutableCache("key1"));
+  }
+
+  {
+    SCOPED_TRACE("Writer thread writes values after max lag");
+
+    settings.write_behind_max_lag = std::chrono::milliseconds(10);
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Put("key1", data, cache::KeyValueCache::kDefaultExpiry));
+
+    for (auto i = 0; i < 100 && !cache.ContainsMutableCache("key1"); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(cache.ContainsMutableCache("key1"));
+  }
+}
+
+TEST_F(DefaultCacheImplTest, Codecs) {
+  const std::string data = "partition data";
+  const auto binary_data = std::make_shared<cache::KeyValueCache::ValueType>(
+      data.begin(), data.end());
+  const auto expiry = cache::KeyValueCache::kDefaultExpiry;
+  const std::string partition_key = "hrn::layer::1::partition";
+  const std::string data_key = "hrn::layer::handle::Data";
+  const std::string short_key = "hrn::layer::2::partition";
+  const std::string unmatched_key = "hrn::catalog";
+
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_memory_cache_size = 0;
+  settings.codecs = {{"::Data", nullptr},
+                     {"::partition", std::make_shared<ReverseCodec>()}};
+
+  {
+    SCOPED_TRACE("Values are encoded based on the key");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+
+    ASSERT_TRUE(cache.Put(partition_key, binary_data, expiry));
+    ASSERT_TRUE(cache.Put(data_key, binary_data, expiry));
+    ASSERT_TRUE(cache.Put(unmatched_key, binary_data, expiry));
+    ASSERT_TRUE(cache.Put(
+        short_key, std::make_shared<cache::KeyValueCache::ValueType>(1, 'x'),
+        expiry));
+
+    const auto encoded = cache.GetMutableCacheRaw(partition_key);
+    EXPECT_NE(data, encoded);
+    EXPECT_EQ(std::string(data.rbegin(), data.rend()),
+              encoded.substr(encoded.size() - data.size()));
+    EXPECT_EQ(data, cache.GetMutableCacheRaw(data_key));
+    EXPECT_EQ(data, cache.GetMutableCacheRaw(unmatched_key));
+    EXPECT_EQ("x", cache.GetMutableCacheRaw(short_key));
+
+    ASSERT_TRUE(cache.Get(partition_key));
+    EXPECT_EQ(*binary_data, *cache.Get(partition_key));
+    const auto decoded = cache.Get(partition_key, [](const std::string& value) {
+      return value;
+    });
+    EXPECT_EQ(data, boost::any_cast<std::string>(decoded));
+    EXPECT_EQ(*binary_data, *cache.GetView(partition_key).ToValue());
+  }
+
+  {
+    SCOPED_TRACE("Encoded values need the codec to be read");
+
+    auto other_settings = settings;
+    other_settings.codecs = {
+        {"::partition", std::make_shared<ReverseCodec>(8u)}};
+    DefaultCacheImplHelper cache(other_settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+
+    EXPECT_FALSE(cache.Get(partition_key));
+    ASSERT_TRUE(cache.Get(data_key));
+    EXPECT_EQ(*binary_data, *cache.Get(data_key));
+  }
+
+  // The values that start with the header magic are not taken for the
+  // encoded values.
+  const std::string magic_data("\0OLC\x07" "atad", 9u);
+  const auto magic_binary_data =
+      std::make_shared<cache::KeyValueCache::ValueType>(magic_data.begin(),
+                                                        magic_data.end());
+
+  {
+    SCOPED_TRACE("Raw values with the magic are escaped");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+
+    ASSERT_TRUE(cache.Put(unmatched_key, magic_binary_data, expiry));
+    EXPECT_NE(magic_data, cache.GetMutableCacheRaw(unmatched_key));
+
+    ASSERT_TRUE(cache.Get(unmatched_key));
+    EXPECT_EQ(*magic_binary_data, *cache.Get(unmatched_key));
+  }
+
+  {
+    SCOPED_TRACE("Values are stored as is without codecs");
+
+    auto other_settings = settings;
+    other_settings.codecs.clear();
+    DefaultCacheImplHelper cache(other_settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+
+    ASSERT_TRUE(cache.Put(unmatched_key, magic_binary_data, expiry));
+    EXPECT_EQ(magic_data, cache.GetMutableCacheRaw(unmatched_key));
+
+    ASSERT_TRUE(cache.Get(unmatched_key));
+    EXPECT_EQ(*magic_binary_data, *cache.Get(unmatched_key));
+  }
+}
+
+TEST_F(DefaultCacheImplTest, MemoryBudget) {
+  const auto data = std::make_shared<cache::KeyValueCache::ValueType>(
+      100u, 'x');
+  const auto expiry = cache::KeyValueCache::kDefaultExpiry;
+  const std::string key = "hrn::layer::1::partition";
+
+  auto budget = std::make_shared<olp::client::MemoryBudget>(1000u);
+
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_memory_cache_size = 1000u;
+  settings.memory_budget = budget;
+
+  DefaultCacheImplHelper cache(settings);
+  ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+
+  ASSERT_TRUE(cache.Put(key, data, expiry));
+  EXPECT_TRUE(cache.ContainsMemoryCache(key));
+
+  {
+    SCOPED_TRACE("Critical pressure clears the memory cache");
+
+    budget->OnLowMemory();
+    EXPECT_FALSE(cache.ContainsMemoryCache(key));
+    ASSERT_TRUE(cache.Put(key, data, expiry));
+    EXPECT_FALSE(cache.ContainsMemoryCache(key));
+  }
+
+  {
+    SCOPED_TRACE("Moderate pressure shrinks the memory cache");
+
+    budget->Reserve(800u);
+    ASSERT_EQ(olp::client::MemoryPressure::kModerate, budget->GetPressure());
+    ASSERT_TRUE(cache.Put(key, data, expiry));
+    EXPECT_TRUE(cache.ContainsMemoryCache(key));
+
+    const auto large_data =
+        std::make_shared<cache::KeyValueCache::ValueType>(500u, 'x');
+    ASSERT_TRUE(cache.Put("large", large_data, expiry));
+    EXPECT_FALSE(cache.ContainsMemoryCache("large"));
+  }
+
+  {
+    SCOPED_TRACE("The size is restored without pressure");
+
+    budget->Release(800u);
+    const auto large_data =
+        std::make_shared<cache::KeyValueCache::ValueType>(500u, 'x');
+    ASSERT_TRUE(cache.Put("large", large_data, expiry));
+    EXPECT_TRUE(cache.ContainsMemoryCache("large"));
+  }
+}
+
+TEST_F(DefaultCacheImplTest, LargeValues) {
+  const std::string data(100u, 'x');
+  const auto binary_data = std::make_shared<cache::KeyValueCache::ValueType>(
+      data.begin(), data.end());
+  const auto expiry = cache::KeyValueCache::kDefaultExpiry;
+  const std::string key = "hrn::layer::handle::Data";
+  const std::string small_key = "hrn::layer::1::partition";
+  const auto large_values_path = cache_path_ + "/large_values";
+
+  cache::CacheSettings settings;
+  settings.disk_path_mutable = cache_path_;
+  settings.max_memory_cache_size = 0;
+  settings.large_value_threshold = 50u;
+
+  {
+    SCOPED_TRACE("Large values are stored in separate files");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+
+    ASSERT_TRUE(cache.Put(key, binary_data, expiry));
+    ASSERT_TRUE(cache.Put(
+        small_key, std::make_shared<cache::KeyValueCache::ValueType>(1, 'x'),
+        expiry));
+    EXPECT_EQ(data.size(), olp::utils::Dir::Size(large_values_path));
+    EXPECT_EQ(data, cache.GetMutableCacheRaw(key));
+    EXPECT_EQ("x", cache.GetMutableCacheRaw(small_key));
+
+    ASSERT_TRUE(cache.Get(key));
+    EXPECT_EQ(*binary_data, *cache.Get(key));
+    EXPECT_EQ(*binary_data, *cache.GetView(key).ToValue());
+  }
+
+  {
+    SCOPED_TRACE("Values are written in chunks");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+
+    auto writer = cache.OpenWriter(key, expiry);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(writer->Append(binary_data->data(), 60u));
+    ASSERT_TRUE(writer->Append(binary_data->data() + 60u, 40u));
+
+    // The value is only visible after the commit.
+    EXPECT_EQ(*binary_data, *cache.Get(key));
+    ASSERT_TRUE(writer->Commit());
+    EXPECT_EQ(*binary_data, *cache.Get(key));
+
+    // The unchanged value keeps its file.
+    EXPECT_EQ(data.size(), olp::utils::Dir::Size(large_values_path));
+  }
+
+  {
+    SCOPED_TRACE("Removed values remove their files");
+
+    DefaultCacheImplHelper cache(settings);
+    ASSERT_EQ(cache::DefaultCache::Success, cache.Open());
+
+    auto writer = cache.OpenWriter("discarded", expiry);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(writer->Append(binary_data->data(), binary_data->size()));
+    writer.reset();
+
+    ASSERT_TRUE(cache.Remove(key));
+    EXPECT_FALSE(cache.Get(key));
+    EXPECT_FALSE(cache.Get("discarded"));
+    EXPECT_EQ(0u, olp::utils::Dir::Size(large_values_path));
+  }
+}
 }  // namespace
@@ -19,10 +19,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <olp/core/cache/CacheSettings.h>
 #include <olp/core/cache/DefaultCache.h>
@@ -235,6 +239,350 @@ TEST(DefaultCacheTest, BasicInMemTest) {
   ASSERT_TRUE(cache.Clear());
 }
 
+TEST(DefaultCacheTest, ShardedInMemTest) {
+  olp::cache::CacheSettings settings;
+  settings.memory_cache_shards = 8u;
+  olp::cache::DefaultCache cache(settings);
+  ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+
+  const auto kKeys = 64;
+  for (auto i = 0; i < kKeys; ++i) {
+    auto data = std::make_shared<KeyValueCache::ValueType>(16, i);
+    ASSERT_TRUE(cache.Put("key" + std::to_string(i), data, kDefaultExpiry));
+  }
+
+  std::atomic<int> hits{0};
+  std::vector<std::thread> readers;
+  for (auto thread = 0; thread < 4; ++thread) {
+    readers.emplace_back([&]() {
+      for (auto i = 0; i < kKeys; ++i) {
+        auto value = cache.Get("key" + std::to_string(i));
+        if (value && value->size() == 16u && value->front() == i) {
+          ++hits;
+        }
+      }
+    });
+  }
+
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(4 * kKeys, hits.load());
+  EXPECT_TRUE(cache.Contains("key0"));
+  EXPECT_EQ(std::vector<bool>({true, false}),
+            cache.ContainsBatch({"key1", "missing_key"}));
+  EXPECT_TRUE(cache.Remove("key0"));
+  EXPECT_FALSE(cache.Get("key0"));
+
+  cache.Close();
+  EXPECT_FALSE(cache.Get("key1"));
+  EXPECT_FALSE(cache.Contains("key1"));
+}
+
+TEST(DefaultCacheTest, GetView) {
+  const auto binary_data = std::make_shared<KeyValueCache::ValueType>(
+      KeyValueCache::ValueType{1, 2, 3, 4, 5});
+
+  {
+    SCOPED_TRACE("Memory cache");
+
+    olp::cache::DefaultCache cache;
+    ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Put("key", binary_data, kDefaultExpiry));
+
+    auto view = cache.GetView("key");
+    ASSERT_TRUE(view);
+    EXPECT_EQ(binary_data->data(), view.data());
+    EXPECT_EQ(binary_data->size(), view.size());
+    EXPECT_FALSE(cache.GetView("missing_key"));
+  }
+
+  {
+    SCOPED_TRACE("Disk cache");
+
+    olp::cache::CacheSettings settings;
+    settings.max_memory_cache_size = 0;
+    settings.disk_path_mutable = kTempDirMutable;
+    olp::cache::DefaultCache cache(settings);
+    ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Put("key", binary_data, kDefaultExpiry));
+    ASSERT_TRUE(cache.Put("expired_key", binary_data, -1));
+
+    auto view = cache.GetView("key");
+    ASSERT_TRUE(view);
+    EXPECT_FALSE(cache.GetView("missing_key"));
+    EXPECT_FALSE(cache.GetView("expired_key"));
+
+    // The view owns the data, so it remains valid after the cache is closed.
+    ASSERT_TRUE(cache.Clear());
+    cache.Close();
+    ASSERT_EQ(binary_data->size(), view.size());
+    EXPECT_TRUE(std::equal(view.data(), view.data() + view.size(),
+                           binary_data->begin()));
+    EXPECT_EQ(*binary_data, *view.ToValue());
+  }
+}
+
+TEST(DefaultCacheTest, Batch) {
+  const auto binary_data = std::make_shared<KeyValueCache::ValueType>(
+      KeyValueCache::ValueType{1, 2, 3});
+  const KeyValueCache::KeyListType keys{"key1", "missing_key", "key2"};
+  const auto decoder = [](const std::string& data) { return data; };
+
+  olp::cache::CacheSettings settings;
+  settings.max_memory_cache_size = 0;
+  settings.disk_path_mutable = kTempDirMutable;
+  olp::cache::DefaultCache cache(settings);
+  ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+  ASSERT_TRUE(cache.Clear());
+
+  {
+    SCOPED_TRACE("Binary data");
+
+    ASSERT_TRUE(cache.PutBatch(
+        {{"key1", binary_data}, {"key2", binary_data}}, kDefaultExpiry));
+
+    const auto values = cache.GetBatch(keys);
+    ASSERT_EQ(keys.size(), values.size());
+    ASSERT_TRUE(values[0]);
+    EXPECT_EQ(*binary_data, *values[0]);
+    EXPECT_FALSE(values[1]);
+    ASSERT_TRUE(values[2]);
+    EXPECT_EQ(*binary_data, *values[2]);
+    EXPECT_EQ(std::vector<bool>({true, false, true}),
+              cache.ContainsBatch(keys));
+
+    EXPECT_FALSE(cache.PutBatch({{"key3", binary_data}, {"key4", nullptr}}));
+    EXPECT_FALSE(cache.Contains("key3"));
+  }
+
+  {
+    SCOPED_TRACE("Encoded values");
+
+    const std::string data1 = "data1";
+    const std::string data2 = "data2";
+    KeyValueCache::KeyEncodedValueListType items;
+    items.emplace_back("key1", KeyValueCache::EncodedValue{
+                                   data1, [&]() { return data1; }});
+    items.emplace_back("key2", KeyValueCache::EncodedValue{
+                                   data2, [&]() { return data2; }});
+    ASSERT_TRUE(cache.PutBatch(items, -1));
+
+    // Expired values are not returned.
+    auto values = cache.GetBatch(keys, decoder);
+    ASSERT_EQ(keys.size(), values.size());
+    EXPECT_TRUE(std::all_of(
+        values.begin(), values.end(),
+        [](const boost::any& value) { return value.empty(); }));
+
+    ASSERT_TRUE(cache.PutBatch(items, kDefaultExpiry));
+    values = cache.GetBatch(keys, decoder);
+    ASSERT_EQ(keys.size(), values.size());
+    EXPECT_EQ(data1, boost::any_cast<std::string>(values[0]));
+    EXPECT_TRUE(values[1].empty());
+    EXPECT_EQ(data2, boost::any_cast<std::string>(values[2]));
+  }
+
+  {
+    SCOPED_TRACE("Closed cache");
+
+    cache.Close();
+    EXPECT_FALSE(cache.PutBatch({{"key1", binary_data}}));
+    const auto values = cache.GetBatch(keys);
+    ASSERT_EQ(keys.size(), values.size());
+    EXPECT_TRUE(std::none_of(
+        values.begin(), values.end(),
+        [](const KeyValueCache::ValueTypePtr& value) { return value; }));
+    EXPECT_EQ(std::vector<bool>(keys.size(), false), cache.ContainsBatch(keys));
+  }
+}
+
+TEST(DefaultCacheTest, ExportToProtectedCache) {
+  const auto protected_path =
+      olp::utils::Dir::TempDirectory() + "/unittest_protected";
+  const auto binary_data = std::make_shared<KeyValueCache::ValueType>(
+      KeyValueCache::ValueType{1, 2, 3, 4, 5});
+  olp::utils::Dir::Remove(protected_path);
+
+  {
+    SCOPED_TRACE("Export the mutable cache");
+
+    olp::cache::CacheSettings settings;
+    settings.disk_path_mutable = kTempDirMutable;
+    olp::cache::DefaultCache cache(settings);
+    ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Put("key", binary_data, kDefaultExpiry));
+    ASSERT_TRUE(cache.Put("expiring_key", binary_data, 1000));
+    ASSERT_TRUE(cache.Put("expired_key", binary_data, -1));
+    ASSERT_TRUE(cache.Protect({"key"}));
+    ASSERT_TRUE(cache.ExportToProtectedCache(protected_path));
+    ASSERT_TRUE(cache.Clear());
+  }
+
+  {
+    SCOPED_TRACE("Read the memory-mapped protected cache");
+
+    olp::cache::CacheSettings settings;
+    settings.max_memory_cache_size = 0;
+    settings.disk_path_protected = protected_path;
+    olp::cache::DefaultCache cache(settings);
+    ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+    EXPECT_GT(cache.Size(olp::cache::DefaultCache::CacheType::kProtected), 0u);
+
+    EXPECT_TRUE(cache.Contains("key"));
+    EXPECT_TRUE(cache.Contains("expiring_key"));
+    EXPECT_FALSE(cache.Contains("expired_key"));
+    EXPECT_FALSE(cache.Contains("missing_key"));
+
+    auto value = cache.Get("expiring_key");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*binary_data, *value);
+    EXPECT_FALSE(cache.Get("expired_key"));
+
+    auto view = cache.GetView("key");
+    cache.Close();
+    ASSERT_TRUE(view);
+    EXPECT_EQ(*binary_data, *view.ToValue());
+  }
+
+  olp::utils::Dir::Remove(protected_path);
+}
+
+TEST(DefaultCacheTest, ApplyProtectedCacheDelta) {
+  const auto temp_path = olp::utils::Dir::TempDirectory();
+  const auto protected_path = temp_path + "/unittest_protected";
+  const auto target_path = temp_path + "/unittest_protected_target";
+  const auto delta_path = temp_path + "/unittest_protected.delta";
+  const auto old_data = std::make_shared<KeyValueCache::ValueType>(
+      KeyValueCache::ValueType{1, 2, 3});
+  const auto new_data = std::make_shared<KeyValueCache::ValueType>(
+      KeyValueCache::ValueType{4, 5, 6});
+  olp::utils::Dir::Remove(protected_path);
+  olp::utils::Dir::Remove(target_path);
+
+  {
+    SCOPED_TRACE("Export two versions of the protected cache");
+
+    olp::cache::CacheSettings settings;
+    settings.disk_path_mutable = kTempDirMutable;
+    olp::cache::DefaultCache cache(settings);
+    ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Put("changed", old_data, kDefaultExpiry));
+    ASSERT_TRUE(cache.Put("removed", old_data, kDefaultExpiry));
+    ASSERT_TRUE(cache.Put("unchanged", old_data, kDefaultExpiry));
+    ASSERT_TRUE(cache.ExportToProtectedCache(protected_path));
+
+    ASSERT_TRUE(cache.Put("added", new_data, kDefaultExpiry));
+    ASSERT_TRUE(cache.Put("changed", new_data, kDefaultExpiry));
+    ASSERT_TRUE(cache.Remove("removed"));
+    ASSERT_TRUE(cache.ExportToProtectedCache(target_path));
+    ASSERT_TRUE(cache.Clear());
+  }
+
+  ASSERT_TRUE(olp::cache::DefaultCache::CreateProtectedCacheDelta(
+      protected_path, target_path, delta_path));
+
+  {
+    SCOPED_TRACE("Update the opened protected cache");
+
+    olp::cache::CacheSettings settings;
+    settings.disk_path_protected = protected_path;
+    olp::cache::DefaultCache cache(settings);
+    ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+
+    // The value is in the memory cache as well after the read.
+    auto value = cache.Get("changed");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*old_data, *value);
+    auto view = cache.GetView("removed");
+
+    ASSERT_TRUE(cache.ApplyProtectedCacheDelta(delta_path));
+
+    value = cache.Get("changed");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*new_data, *value);
+    EXPECT_TRUE(cache.Contains("added"));
+    EXPECT_TRUE(cache.Contains("unchanged"));
+    EXPECT_FALSE(cache.Contains("removed"));
+
+    // The view keeps the previous cache mapped.
+    ASSERT_TRUE(view);
+    EXPECT_EQ(*old_data, *view.ToValue());
+
+    // The cache is not the base of the delta anymore.
+    EXPECT_FALSE(cache.ApplyProtectedCacheDelta(delta_path));
+    EXPECT_TRUE(cache.Contains("added"));
+  }
+
+  olp::utils::Dir::Remove(protected_path);
+  olp::utils::Dir::Remove(target_path);
+  std::remove(delta_path.c_str());
+}
+
+TEST(DefaultCacheTest, SharedCache) {
+  const auto binary_data = std::make_shared<KeyValueCache::ValueType>(
+      KeyValueCache::ValueType{1, 2, 3, 4, 5});
+
+  olp::cache::CacheSettings writer_settings;
+  writer_settings.disk_path_mutable = kTempDirMutable;
+  olp::cache::DefaultCache writer(writer_settings);
+  ASSERT_EQ(olp::cache::DefaultCache::Success, writer.Open());
+  ASSERT_TRUE(writer.Clear());
+  ASSERT_TRUE(writer.Put("key", binary_data, kDefaultExpiry));
+  ASSERT_TRUE(writer.Put("expired_key", binary_data, -1));
+
+  olp::cache::CacheSettings reader_settings;
+  reader_settings.max_memory_cache_size = 0;
+  reader_settings.disk_path_shared = kTempDirMutable;
+  reader_settings.shared_cache_refresh_interval = std::chrono::seconds(0);
+  reader_settings.collect_metrics = true;
+  olp::cache::DefaultCache reader(reader_settings);
+  ASSERT_EQ(olp::cache::DefaultCache::Success, reader.Open());
+
+  {
+    SCOPED_TRACE("Read the values of the writer");
+
+    auto value = reader.Get("key");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*binary_data, *value);
+    const auto metrics = reader.GetMetrics();
+    EXPECT_EQ(1u, metrics.shared_disk.hits);
+    EXPECT_EQ(0u, metrics.mutable_disk.hits);
+    EXPECT_TRUE(reader.Contains("key"));
+    EXPECT_FALSE(reader.Get("expired_key"));
+    EXPECT_FALSE(reader.Contains("expired_key"));
+    EXPECT_FALSE(reader.Get("new_key"));
+  }
+
+  {
+    SCOPED_TRACE("Read the values written after the reader is opened");
+
+    ASSERT_TRUE(writer.Put("new_key", binary_data, kDefaultExpiry));
+
+    auto value = reader.Get("new_key");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*binary_data, *value);
+  }
+
+  {
+    SCOPED_TRACE("The reader does not write to the shared cache");
+
+    const auto other_data = std::make_shared<KeyValueCache::ValueType>(
+        KeyValueCache::ValueType{6, 7, 8});
+    reader.Put("reader_key", other_data, kDefaultExpiry);
+    reader.Close();
+
+    EXPECT_FALSE(writer.Get("reader_key"));
+    EXPECT_EQ(*binary_data, *writer.Get("key"));
+  }
+
+  writer.Close();
+}
+
 TEST(DefaultCacheTest, MemSizeTest) {
   olp::cache::CacheSettings settings;
   settings.max_memory_cache_size = 30;
@@ -285,6 +633,113 @@ TEST(DefaultCacheTest, BasicDiskTest) {
   ASSERT_TRUE(cache.Clear());
 }
 
+TEST(DefaultCacheTest, DiskCacheTuning) {
+  olp::cache::CacheSettings settings;
+  settings.max_memory_cache_size = 0;
+  settings.disk_path_mutable = olp::utils::Dir::TempDirectory() + "/unittest";
+  settings.mutable_cache_tuning.bloom_filter_bits_per_key = 0u;
+  settings.mutable_cache_tuning.block_cache_size = 1024u * 1024u;
+  settings.mutable_cache_tuning.block_size = 16u * 1024u;
+  const auto decoder = [](const std::string& data) { return data; };
+  const std::string data{"this is key1's data"};
+
+  {
+    olp::cache::DefaultCache cache(settings);
+    ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Put("key1", data, [=]() { return data; },
+                          (std::numeric_limits<time_t>::max)()));
+  }
+
+  settings.mutable_cache_tuning = olp::cache::DiskCacheTuning();
+  settings.mutable_cache_tuning.bloom_filter_bits_per_key = 16u;
+  olp::cache::DefaultCache cache(settings);
+  ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+  auto value = cache.Get("key1", decoder);
+  ASSERT_FALSE(value.empty());
+  EXPECT_EQ(data, boost::any_cast<std::string>(value));
+  EXPECT_FALSE(cache.Contains("key2"));
+  ASSERT_TRUE(cache.Clear());
+}
+
+TEST(DefaultCacheTest, Metrics) {
+  olp::cache::CacheSettings settings;
+  settings.disk_path_mutable = kTempDirMutable;
+  settings.collect_metrics = true;
+  const auto binary = std::make_shared<KeyValueCache::ValueType>(10u, 'a');
+
+  {
+    SCOPED_TRACE("Disabled");
+
+    olp::cache::CacheSettings disabled_settings = settings;
+    disabled_settings.collect_metrics = false;
+    olp::cache::DefaultCache cache(disabled_settings);
+    ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Put("key1", binary, 100));
+    ASSERT_TRUE(cache.Get("key1") != nullptr);
+
+    const auto metrics = cache.GetMetrics();
+    EXPECT_EQ(0u, metrics.memory.hits);
+    EXPECT_EQ(0u, metrics.get_latency.count);
+  }
+
+  {
+    SCOPED_TRACE("Tiers");
+
+    olp::cache::DefaultCache cache(settings);
+    ASSERT_EQ(olp::cache::DefaultCache::Success, cache.Open());
+    ASSERT_TRUE(cache.Clear());
+    ASSERT_TRUE(cache.Put("key1", binary, 100));
+    ASSERT_TRUE(cache.Put("key2", binary, -1));
+
+    // Memory hit.
+    ASSERT_TRUE(cache.Get("key1") != nullptr);
+    // Memory and mutable miss.
+    ASSERT_TRUE(cache.Get("key3") == nullptr);
+    // Expired in the memory and mutable caches.
+    ASSERT_TRUE(cache.Get("key2") == nullptr);
+
+    auto metrics = cache.GetMetrics();
+    EXPECT_EQ(1u, metrics.memory.hits);
+    EXPECT_EQ(2u, metrics.memory.misses);
+    EXPECT_EQ(binary->size(), metrics.memory.bytes_read);
+    // The expired value is not stored in the memory cache.
+    EXPECT_EQ(binary->size(), metrics.memory.bytes_written);
+    EXPECT_EQ(0u, metrics.mutable_disk.hits);
+    EXPECT_EQ(2u, metrics.mutable_disk.misses);
+    EXPECT_EQ(1u, metrics.mutable_disk.expirations);
+    EXPECT_EQ(2u * binary->size(), metrics.mutable_disk.bytes_written);
+    EXPECT_EQ(0u, metrics.protected_disk.misses);
+    EXPECT_EQ(3u, metrics.get_latency.count);
+    EXPECT_EQ(2u, metrics.put_latency.count);
+
+    uint64_t bucket_total = 0u;
+    for (const auto count : metrics.get_latency.buckets) {
+      bucket_total += count;
+    }
+    EXPECT_EQ(metrics.get_latency.count, bucket_total);
+
+    // Mutable hit after the memory cache is dropped.
+    ASSERT_TRUE(cache.Close(CacheType::kMutable));
+    ASSERT_EQ(olp::cache::DefaultCache::Success,
+              cache.Open(CacheType::kMutable));
+    ASSERT_TRUE(cache.Get("key1") != nullptr);
+
+    metrics = cache.GetMetrics();
+    EXPECT_EQ(1u, metrics.mutable_disk.hits);
+    EXPECT_EQ(binary->size(), metrics.mutable_disk.bytes_read);
+
+    cache.ResetMetrics();
+    metrics = cache.GetMetrics();
+    EXPECT_EQ(0u, metrics.memory.hits);
+    EXPECT_EQ(0u, metrics.mutable_disk.hits);
+    EXPECT_EQ(0u, metrics.get_latency.count);
+    EXPECT_EQ(0u, metrics.get_latency.total_time.count());
+    ASSERT_TRUE(cache.Clear());
+  }
+}
+
 TEST(DefaultCacheTest, ExpiredTest) {
   olp::cache::CacheSettings settings;
   settings.max_memory_cache_size = 0;
@@ -112,6 +112,12 @@ TEST(InMemoryCacheTest, RemoveWithPrefix) {
   cache.RemoveKeysWithPrefix("doesnotexist");
   ASSERT_EQ(8u, cache.Size());  // "key2" .. "key3", "key5" .. "key9"
 
+  cache.RemoveKeysWithPrefix("key", [](const std::string& key) {
+    return key == Key(5);
+  });
+  ASSERT_EQ(1u, cache.Size());  // "key5"
+  ASSERT_TRUE(cache.Contains(Key(5)));
+
   cache.RemoveKeysWithPrefix("key");
   ASSERT_EQ(0u, cache.Size());
 }
@@ -416,4 +422,126 @@ TEST(InMemoryCacheTest, ClassBasedCustomCost) {
     ASSERT_EQ(0u, cache.Size());
   }
 }
+
+TEST(InMemoryCacheTest, Sharded) {
+  const size_t shard_count = 4u;
+  olp::cache::InMemoryCache cache(
+      100, EqualityCacheCost(),
+      olp::cache::InMemoryCache::DefaultTimeProvider(), shard_count);
+  ASSERT_EQ(shard_count, cache.ShardCount());
+
+  {
+    SCOPED_TRACE("Put and get across shards");
+
+    Populate(cache, 40);
+    EXPECT_EQ(40u, cache.Size());
+    for (int i = 0; i < 40; i++) {
+      auto value = cache.Get(Key(i));
+      ASSERT_FALSE(value.empty());
+      EXPECT_EQ(Value(i), boost::any_cast<std::string>(value));
+      EXPECT_TRUE(cache.Contains(Key(i)));
+    }
+  }
+
+  {
+    SCOPED_TRACE("Remove and prefix remove across shards");
+
+    EXPECT_TRUE(cache.Remove(Key(0)));
+    EXPECT_TRUE(cache.Get(Key(0)).empty());
+    EXPECT_EQ(39u, cache.Size());
+
+    cache.RemoveKeysWithPrefix("key1");
+    for (int i = 10; i < 20; i++) {
+      EXPECT_TRUE(cache.Get(Key(i)).empty());
+    }
+    EXPECT_TRUE(cache.Get(Key(1)).empty());
+    EXPECT_EQ(28u, cache.Size());
+  }
+
+  {
+    SCOPED_TRACE("Total size is limited");
+
+    cache.Clear();
+    EXPECT_EQ(0u, cache.Size());
+    Populate(cache, 1000);
+    EXPECT_LE(cache.Size(), 100u);
+  }
+}
+
+TEST(InMemoryCacheTest, ShardedBudget) {
+  using olp::cache::InMemoryCache;
+
+  {
+    SCOPED_TRACE("Every shard owns a part of the total budget");
+
+    auto cost_func = [](const ItemTuple& tuple) { return std::get<3>(tuple); };
+    InMemoryCache cache(10, cost_func, InMemoryCache::DefaultTimeProvider(),
+                        2u);
+    EXPECT_TRUE(cache.Put("small", Value(0), InMemoryCache::kExpiryMax, 5u));
+    EXPECT_FALSE(cache.Put("large", Value(1), InMemoryCache::kExpiryMax, 6u));
+    EXPECT_EQ(5u, cache.Size());
+  }
+
+  {
+    SCOPED_TRACE("Zero shards are treated as a single shard");
+
+    InMemoryCache cache(10, EqualityCacheCost(),
+                        InMemoryCache::DefaultTimeProvider(), 0u);
+    EXPECT_EQ(1u, cache.ShardCount());
+  }
+}
+
 }  // namespace
+
+TEST(InMemoryCacheTest, AdmissionFilter) {
+  const auto hot_count = 10;
+  const auto scan_count = 20;
+  const auto populate_hot = [&](olp::cache::InMemoryCache& cache) {
+    Populate(cache, hot_count);
+    for (int access = 0; access < 3; access++) {
+      for (int i = 0; i < hot_count; i++) {
+        ASSERT_FALSE(cache.Get(Key(i)).empty());
+      }
+    }
+  };
+
+  {
+    SCOPED_TRACE("Scan flushes the cache without the filter");
+
+    olp::cache::InMemoryCache cache(hot_count, EqualityCacheCost());
+    populate_hot(cache);
+    Populate(cache, scan_count, hot_count);
+    for (int i = 0; i < hot_count; i++) {
+      EXPECT_FALSE(cache.Contains(Key(i)));
+    }
+  }
+
+  {
+    SCOPED_TRACE("Scan doesn't flush the cache with the filter");
+
+    olp::cache::InMemoryCache cache(
+        hot_count, EqualityCacheCost(),
+        olp::cache::InMemoryCache::DefaultTimeProvider(), 1u, true);
+    populate_hot(cache);
+    for (int i = hot_count; i < hot_count + scan_count; i++) {
+      EXPECT_FALSE(cache.Put(Key(i), Value(i)));
+    }
+    for (int i = 0; i < hot_count; i++) {
+      EXPECT_TRUE(cache.Contains(Key(i)));
+    }
+
+    // Existing keys are always updated
+    cache.Put(Key(0), Value(1));
+    EXPECT_EQ(Value(1), boost::any_cast<std::string>(cache.Get(Key(0))));
+
+    // A key is admitted once it's used more often than the LRU item
+    const auto key = Key(hot_count + scan_count);
+    bool admitted = false;
+    for (int access = 0; access < 10 && !admitted; access++) {
+      admitted = cache.Put(key, Value(0));
+    }
+    EXPECT_TRUE(admitted);
+    EXPECT_TRUE(cache.Contains(key));
+    EXPECT_EQ(static_cast<size_t>(hot_count), cache.Size());
+  }
+}
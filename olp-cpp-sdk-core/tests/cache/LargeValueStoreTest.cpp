@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <cache/LargeValueStore.h>
+#include <olp/core/utils/Dir.h>
+
+namespace {
+namespace cache = olp::cache;
+
+const auto kTempDir =
+    olp::utils::Dir::TempDirectory() + "/large_values_unittest";
+
+std::string ToString(const cache::KeyValueCache::ValueView& view) {
+  return std::string(reinterpret_cast<const char*>(view.data()), view.size());
+}
+
+class LargeValueStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override { olp::utils::Dir::Remove(kTempDir); }
+  void TearDown() override { olp::utils::Dir::Remove(kTempDir); }
+};
+
+TEST_F(LargeValueStoreTest, WriteInChunks) {
+  cache::LargeValueStore store;
+  store.Open(kTempDir);
+
+  auto writer = store.NewWriter("key");
+  ASSERT_TRUE(writer);
+  ASSERT_TRUE(writer->Append("large ", 6u));
+  ASSERT_TRUE(writer->Append("value", 5u));
+
+  std::string reference;
+  ASSERT_TRUE(writer->Finish(reference));
+  writer.reset();
+
+  ASSERT_TRUE(
+      cache::LargeValueStore::IsReference(reference.data(), reference.size()));
+  EXPECT_EQ(11u, cache::LargeValueStore::GetValueSize(reference.data(),
+                                                      reference.size()));
+  EXPECT_FALSE(cache::LargeValueStore::IsReference("value", 5u));
+  EXPECT_EQ(5u, cache::LargeValueStore::GetValueSize("value", 5u));
+
+  {
+    SCOPED_TRACE("Not published value is not readable");
+    EXPECT_FALSE(store.Map(reference.data(), reference.size()));
+  }
+
+  ASSERT_TRUE(store.Publish(reference));
+  auto view = store.Map(reference.data(), reference.size());
+  ASSERT_TRUE(view);
+  EXPECT_EQ("large value", ToString(view));
+
+  {
+    SCOPED_TRACE("Removed value is not readable");
+    store.Remove(reference.data(), reference.size());
+    EXPECT_FALSE(store.Map(reference.data(), reference.size()));
+
+    // The mapping stays valid.
+    EXPECT_EQ("large value", ToString(view));
+  }
+}
+
+TEST_F(LargeValueStoreTest, DiscardValue) {
+  cache::LargeValueStore store;
+  store.Open(kTempDir);
+
+  std::string first;
+  std::string second;
+  ASSERT_TRUE(store.Write("key", "first", 5u, first));
+  ASSERT_TRUE(store.Write("key", "second", 6u, second));
+  EXPECT_NE(first, second);
+
+  store.Discard(first);
+  EXPECT_FALSE(store.Publish(first));
+  EXPECT_TRUE(store.Publish(second));
+  EXPECT_EQ("second", ToString(store.Map(second.data(), second.size())));
+
+  {
+    SCOPED_TRACE("Unfinished value is removed");
+    auto writer = store.NewWriter("key");
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(writer->Append("value", 5u));
+    writer.reset();
+
+    // Only the published value is left.
+    EXPECT_EQ(6u, olp::utils::Dir::Size(kTempDir));
+  }
+}
+
+TEST_F(LargeValueStoreTest, ContentAddressed) {
+  cache::LargeValueStore store;
+  store.Open(kTempDir);
+
+  std::string reference;
+  ASSERT_TRUE(store.Write("key", "value", 5u, reference));
+  ASSERT_TRUE(store.Publish(reference));
+
+  {
+    SCOPED_TRACE("Same value of the same key keeps its file");
+    std::string written;
+    ASSERT_TRUE(store.Write("key", "value", 5u, written));
+    EXPECT_EQ(reference, written);
+
+    auto writer = store.NewWriter("key");
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(writer->Append("val", 3u));
+    ASSERT_TRUE(writer->Append("ue", 2u));
+    ASSERT_TRUE(writer->Finish(written));
+    EXPECT_EQ(reference, written);
+
+    EXPECT_TRUE(store.Publish(written));
+    EXPECT_EQ(5u, olp::utils::Dir::Size(kTempDir));
+  }
+
+  {
+    SCOPED_TRACE("Same value of another key has its own file");
+    std::string other;
+    ASSERT_TRUE(store.Write("other", "value", 5u, other));
+    EXPECT_NE(reference, other);
+    ASSERT_TRUE(store.Publish(other));
+
+    store.Remove(other.data(), other.size());
+    EXPECT_FALSE(store.Map(other.data(), other.size()));
+    EXPECT_EQ("value", ToString(store.Map(reference.data(), reference.size())));
+  }
+}
+
+}  // namespace
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cache/MappedCache.h>
+#include <olp/core/utils/Dir.h>
+
+namespace {
+namespace cache = olp::cache;
+
+const auto kTempDir = olp::utils::Dir::TempDirectory() + "/mapped_unittest";
+
+const auto kBaseDir = kTempDir + "/base";
+const auto kTargetDir = kTempDir + "/target";
+const auto kDeltaPath = kTempDir + "/delta";
+
+class MappedCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override { olp::utils::Dir::Remove(kTempDir); }
+  void TearDown() override { olp::utils::Dir::Remove(kTempDir); }
+};
+
+void WriteStorage(const std::string& directory,
+                  const std::map<std::string, std::string>& values) {
+  cache::MappedCacheWriter writer(directory);
+  ASSERT_TRUE(writer.Open());
+  for (const auto& value : values) {
+    ASSERT_TRUE(
+        writer.Add(value.first, value.second.data(), value.second.size()));
+  }
+  ASSERT_TRUE(writer.Finish());
+}
+
+TEST_F(MappedCacheTest, WriteAndRead) {
+  {
+    cache::MappedCacheWriter writer(kTempDir);
+    ASSERT_TRUE(writer.Open());
+    ASSERT_TRUE(writer.Add("a", "value_a", 7u));
+    ASSERT_TRUE(writer.Add("b", "", 0u));
+    ASSERT_TRUE(writer.Add("c::key", "value_c", 7u));
+    EXPECT_FALSE(writer.Add("c::key", "value_c", 7u));
+    EXPECT_FALSE(writer.Add("aa", "value_aa", 8u));
+    ASSERT_TRUE(writer.Finish());
+  }
+
+  ASSERT_TRUE(cache::MappedCache::Exists(kTempDir));
+
+  cache::MappedCache mapped_cache;
+  ASSERT_TRUE(mapped_cache.Open(kTempDir));
+  EXPECT_GT(mapped_cache.Size(), 0u);
+
+  EXPECT_EQ(std::string("value_a"), mapped_cache.Get("a").get_value_or({}));
+  EXPECT_EQ(std::string("value_c"),
+            mapped_cache.Get("c::key").get_value_or({}));
+  EXPECT_TRUE(mapped_cache.Contains("b"));
+  EXPECT_FALSE(mapped_cache.Contains("aa"));
+  EXPECT_FALSE(mapped_cache.Contains("c"));
+  EXPECT_FALSE(mapped_cache.Get("d"));
+
+  cache::KeyValueCache::ValueTypePtr value;
+  ASSERT_TRUE(mapped_cache.Get("a", value));
+  EXPECT_EQ(std::string("value_a"), std::string(value->begin(), value->end()));
+
+  // The view keeps the file mapped after the cache is closed.
+  auto view = mapped_cache.GetView("c::key");
+  mapped_cache.Close();
+  EXPECT_FALSE(mapped_cache.Contains("a"));
+  ASSERT_TRUE(view);
+  EXPECT_EQ(std::string("value_c"),
+            std::string(reinterpret_cast<const char*>(view.data()),
+                        view.size()));
+}
+
+TEST_F(MappedCacheTest, InvalidFile) {
+  {
+    SCOPED_TRACE("Missing file");
+
+    cache::MappedCache mapped_cache;
+    EXPECT_FALSE(cache::MappedCache::Exists(kTempDir));
+    EXPECT_FALSE(mapped_cache.Open(kTempDir));
+  }
+
+  {
+    SCOPED_TRACE("Corrupted header");
+
+    ASSERT_TRUE(olp::utils::Dir::Create(kTempDir));
+    std::ofstream file(kTempDir + "/" + cache::MappedCache::kFileName,
+                       std::ios::binary);
+    file << "OLPCMAP1 not a valid header";
+    file.close();
+
+    cache::MappedCache mapped_cache;
+    EXPECT_TRUE(cache::MappedCache::Exists(kTempDir));
+    EXPECT_FALSE(mapped_cache.Open(kTempDir));
+    EXPECT_FALSE(mapped_cache.Contains("key"));
+  }
+}
+
+TEST_F(MappedCacheTest, Delta) {
+  const std::string large_value(64u * 1024u, 'v');
+  WriteStorage(kBaseDir, {{"added_later", ""},
+                          {"changed", "old"},
+                          {"removed", "value"},
+                          {"unchanged", large_value}});
+  WriteStorage(kTargetDir, {{"added", "new"},
+                            {"added_later", ""},
+                            {"changed", "new"},
+                            {"unchanged", large_value},
+                            {"z", "last"}});
+
+  ASSERT_TRUE(
+      cache::MappedCacheDelta::Create(kBaseDir, kTargetDir, kDeltaPath));
+
+  // The unchanged values are not in the delta.
+  std::ifstream delta(kDeltaPath, std::ios::binary | std::ios::ate);
+  EXPECT_LT(static_cast<uint64_t>(delta.tellg()), large_value.size());
+
+  cache::MappedCache previous;
+  ASSERT_TRUE(previous.Open(kBaseDir));
+
+  std::vector<std::string> changed_keys;
+  ASSERT_TRUE(
+      cache::MappedCacheDelta::Apply(kBaseDir, kDeltaPath, changed_keys));
+  EXPECT_EQ(std::vector<std::string>({"added", "changed", "removed", "z"}),
+            changed_keys);
+
+  cache::MappedCache updated;
+  ASSERT_TRUE(updated.Open(kBaseDir));
+  EXPECT_EQ(5u, updated.Count());
+  EXPECT_EQ(std::string("new"), updated.Get("added").get_value_or({}));
+  EXPECT_EQ(std::string("new"), updated.Get("changed").get_value_or({}));
+  EXPECT_EQ(large_value, updated.Get("unchanged").get_value_or({}));
+  EXPECT_EQ(std::string("last"), updated.Get("z").get_value_or({}));
+  EXPECT_TRUE(updated.Contains("added_later"));
+  EXPECT_FALSE(updated.Contains("removed"));
+
+  // The instance opened before keeps reading the previous file.
+  EXPECT_EQ(std::string("old"), previous.Get("changed").get_value_or({}));
+  EXPECT_TRUE(previous.Contains("removed"));
+
+  {
+    SCOPED_TRACE("Apply the delta again");
+
+    EXPECT_FALSE(
+        cache::MappedCacheDelta::Apply(kBaseDir, kDeltaPath, changed_keys));
+
+    cache::MappedCache unchanged;
+    ASSERT_TRUE(unchanged.Open(kBaseDir));
+    EXPECT_EQ(5u, unchanged.Count());
+    EXPECT_EQ(std::string("new"), unchanged.Get("changed").get_value_or({}));
+  }
+}
+
+TEST_F(MappedCacheTest, DeltaForAnotherStorage) {
+  WriteStorage(kBaseDir, {{"key", "value"}});
+  WriteStorage(kTargetDir, {{"key", "new_value"}});
+  ASSERT_TRUE(
+      cache::MappedCacheDelta::Create(kBaseDir, kTargetDir, kDeltaPath));
+
+  const auto other_dir = kTempDir + "/other";
+  WriteStorage(other_dir, {{"key", "other_value"}});
+
+  std::vector<std::string> changed_keys;
+  EXPECT_FALSE(
+      cache::MappedCacheDelta::Apply(other_dir, kDeltaPath, changed_keys));
+
+  cache::MappedCache other;
+  ASSERT_TRUE(other.Open(other_dir));
+  EXPECT_EQ(std::string("other_value"), other.Get("key").get_value_or({}));
+}
+}  // namespace
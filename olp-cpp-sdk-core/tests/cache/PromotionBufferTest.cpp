@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PromotionBuffer.h"
+
+namespace {
+using olp::cache::PromotionBuffer;
+
+TEST(PromotionBufferTest, AddAndDrain) {
+  PromotionBuffer buffer(1u, 3u);
+  EXPECT_EQ(3u, buffer.Capacity());
+
+  {
+    SCOPED_TRACE("Keys are drained in order");
+
+    EXPECT_TRUE(buffer.Add("key1"));
+    EXPECT_TRUE(buffer.Add("key2"));
+    EXPECT_EQ(2u, buffer.Size());
+    EXPECT_EQ((std::vector<std::string>{"key1", "key2"}), buffer.Drain());
+    EXPECT_EQ(0u, buffer.Size());
+    EXPECT_TRUE(buffer.Drain().empty());
+  }
+
+  {
+    SCOPED_TRACE("Full buffer drops new keys");
+
+    EXPECT_TRUE(buffer.Add("key1"));
+    EXPECT_TRUE(buffer.Add("key2"));
+    EXPECT_TRUE(buffer.Add("key3"));
+    EXPECT_FALSE(buffer.Add("key4"));
+    EXPECT_EQ(3u, buffer.Size());
+    EXPECT_EQ((std::vector<std::string>{"key1", "key2", "key3"}),
+              buffer.Drain());
+  }
+}
+
+TEST(PromotionBufferTest, ConcurrentAdd) {
+  const auto thread_count = 4u;
+  const auto key_count = 100u;
+  PromotionBuffer buffer(thread_count, thread_count * key_count);
+
+  std::vector<std::thread> threads;
+  for (auto t = 0u; t < thread_count; ++t) {
+    threads.emplace_back([&]() {
+      for (auto i = 0u; i < key_count; ++i) {
+        buffer.Add("key" + std::to_string(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(thread_count * key_count, buffer.Size());
+  EXPECT_EQ(thread_count * key_count, buffer.Drain().size());
+}
+
+}  // namespace
@@ -33,15 +33,16 @@ TEST(ProtectedKeyList, CanBeMoved) {
   EXPECT_TRUE(list_a.IsDirty());
   auto raw_data = list_a.Serialize();
   EXPECT_TRUE(raw_data.get());
-  EXPECT_EQ(raw_data->size(), 4);
+  // header, prefix and key lengths, key
+  EXPECT_EQ(raw_data->size(), 2 + 2 + 3);
   EXPECT_FALSE(list_a.IsDirty());
   EXPECT_EQ(list_a.Size(), raw_data->size());
   cache::ProtectedKeyList list_b(std::move(list_a));
-  EXPECT_EQ(list_b.Size(), 4);
+  EXPECT_EQ(list_b.Size(), 7);
   cache::ProtectedKeyList list_c;
   EXPECT_EQ(list_c.Size(), 0);
   list_c = std::move(list_b);
-  EXPECT_EQ(list_c.Size(), 4);
+  EXPECT_EQ(list_c.Size(), 7);
 }
 
 TEST(ProtectedKeyList, Protect) {
@@ -57,7 +58,7 @@ TEST(ProtectedKeyList, Protect) {
       EXPECT_TRUE(protected_keys.IsDirty());
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
-      EXPECT_EQ(raw_data->size(), 6);
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 5);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_EQ(protected_keys.Size(), raw_data->size());
       protected_keys = cache::ProtectedKeyList();
@@ -70,7 +71,7 @@ TEST(ProtectedKeyList, Protect) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // previous key was removed, so size is smaller
-      EXPECT_EQ(raw_data->size(), 5);
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_TRUE(protected_keys.IsProtected("key:1"));
       protected_keys = cache::ProtectedKeyList();
@@ -84,7 +85,7 @@ TEST(ProtectedKeyList, Protect) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // size didn't change
-      EXPECT_EQ(raw_data->size(), 5);
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_TRUE(protected_keys.IsProtected("key:1"));
       protected_keys = cache::ProtectedKeyList();
@@ -100,7 +101,7 @@ TEST(ProtectedKeyList, Protect) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // size changed
-      EXPECT_EQ(raw_data->size(), 5 + 11);
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4 + 2 + 10);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_TRUE(protected_keys.IsProtected("some_key:1"));
       protected_keys = cache::ProtectedKeyList();
@@ -119,7 +120,8 @@ TEST(ProtectedKeyList, Protect) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // size changed
-      EXPECT_EQ(raw_data->size(), 5 + 11 + 11 * 5);
+      // "some_key:" is shared, so only one character is stored per key
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4 + 2 + 10 + 3 * 5);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_TRUE(protected_keys.IsProtected("some_key:2"));
       EXPECT_FALSE(protected_keys.IsProtected("some_key:7"));
@@ -141,7 +143,8 @@ TEST(ProtectedKeyList, Protect) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // size didn't change
-      EXPECT_EQ(raw_data->size(), 5 + 11 + 11 * 5);
+      // "some_key:" is shared, so only one character is stored per key
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4 + 2 + 10 + 3 * 5);
       EXPECT_FALSE(protected_keys.IsDirty());
       // this key is protected by prefix
       EXPECT_TRUE(protected_keys.IsProtected("key:7"));
@@ -168,7 +171,7 @@ TEST(ProtectedKeyList, Release) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // 6 keys and prefix
-      EXPECT_EQ(raw_data->size(), 6 * 11 + 5);
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4 + 2 + 10 + 3 * 5);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_EQ(protected_keys.Size(), raw_data->size());
       // this key is protected by prefix
@@ -184,7 +187,7 @@ TEST(ProtectedKeyList, Release) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // 5 keys and prefix
-      EXPECT_EQ(raw_data->size(), 5 * 11 + 5);
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4 + 2 + 10 + 3 * 4);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_EQ(protected_keys.Size(), raw_data->size());
       // key not longer protected
@@ -199,7 +202,7 @@ TEST(ProtectedKeyList, Release) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // 5 keys and prefix
-      EXPECT_EQ(raw_data->size(), 3 * 11 + 5);
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4 + 2 + 10 + 3 * 2);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_EQ(protected_keys.Size(), raw_data->size());
       // key not longer protected
@@ -213,7 +216,7 @@ TEST(ProtectedKeyList, Release) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // 5 keys and prefix
-      EXPECT_EQ(raw_data->size(), 5);
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_EQ(protected_keys.Size(), raw_data->size());
       // key not longer protected
@@ -229,7 +232,7 @@ TEST(ProtectedKeyList, Release) {
       auto raw_data = protected_keys.Serialize();
       EXPECT_TRUE(raw_data.get());
       // 5 keys and prefix
-      EXPECT_EQ(raw_data->size(), 5);
+      EXPECT_EQ(raw_data->size(), 2 + 2 + 4);
       EXPECT_FALSE(protected_keys.IsDirty());
       EXPECT_EQ(protected_keys.Size(), raw_data->size());
       // key still protected
@@ -238,4 +241,70 @@ TEST(ProtectedKeyList, Release) {
   }
 }
 
+TEST(ProtectedKeyList, Deserialize) {
+  auto cb = [](const std::string&) {};
+  const std::vector<std::string> keys = {"key:", "some_key:1", "some_key:2",
+                                         "some_key:30"};
+
+  {
+    SCOPED_TRACE("Binary format");
+    cache::ProtectedKeyList source;
+    source.Protect(keys, cb);
+    auto raw_data = source.Serialize();
+
+    cache::ProtectedKeyList protected_keys;
+    EXPECT_TRUE(protected_keys.Deserialize(raw_data));
+    EXPECT_FALSE(protected_keys.IsDirty());
+    EXPECT_EQ(protected_keys.Size(), raw_data->size());
+    EXPECT_EQ(protected_keys.Count(), keys.size());
+    for (const auto& key : keys) {
+      EXPECT_TRUE(protected_keys.IsProtected(key));
+    }
+    EXPECT_TRUE(protected_keys.IsProtected("key:1"));
+    EXPECT_FALSE(protected_keys.IsProtected("some_key:3"));
+  }
+
+  {
+    SCOPED_TRACE("Legacy zero separated format");
+    auto raw_data = std::make_shared<std::vector<unsigned char>>();
+    for (const auto& key : keys) {
+      raw_data->insert(raw_data->end(), key.begin(), key.end());
+      raw_data->emplace_back('\0');
+    }
+
+    cache::ProtectedKeyList protected_keys;
+    EXPECT_TRUE(protected_keys.Deserialize(raw_data));
+    EXPECT_EQ(protected_keys.Count(), keys.size());
+    for (const auto& key : keys) {
+      EXPECT_TRUE(protected_keys.IsProtected(key));
+    }
+
+    // Written back in the binary format
+    EXPECT_TRUE(protected_keys.Protect({"other_key"}, cb));
+    cache::ProtectedKeyList converted;
+    EXPECT_TRUE(converted.Deserialize(protected_keys.Serialize()));
+    EXPECT_EQ(converted.Count(), keys.size() + 1u);
+    EXPECT_TRUE(converted.IsProtected("some_key:30"));
+    EXPECT_TRUE(converted.IsProtected("other_key"));
+  }
+
+  {
+    SCOPED_TRACE("Corrupted binary format");
+    cache::ProtectedKeyList source;
+    source.Protect(keys, cb);
+    auto raw_data = source.Serialize();
+    // The last key is truncated
+    raw_data->resize(raw_data->size() - 1u);
+    // The shared prefix is longer than the previous key
+    auto corrupted = std::make_shared<std::vector<unsigned char>>(
+        std::vector<unsigned char>{'\0', 1u, 5u, 1u, 'a'});
+
+    cache::ProtectedKeyList protected_keys;
+    EXPECT_FALSE(protected_keys.Deserialize(raw_data));
+    EXPECT_EQ(protected_keys.Count(), 0u);
+    EXPECT_FALSE(protected_keys.Deserialize(corrupted));
+    EXPECT_EQ(protected_keys.Count(), 0u);
+  }
+}
+
 }  // namespace
@@ -17,6 +17,9 @@
  * License-Filename: LICENSE
  */
 
+#include <atomic>
+#include <future>
+
 #include <gmock/gmock.h>
 #include <matchers/NetworkUrlMatchers.h>
 #include <mocks/CacheMock.h>
@@ -988,4 +991,189 @@ TEST_F(ApiLookupClientImplTest, CustomCatalogProviderAsync) {
   }
 }
 
+TEST_F(ApiLookupClientImplTest, LookupAll) {
+  const std::string catalog =
+      "hrn:here:data::olp-here-test:hereos-internal-test-v2";
+  const auto catalog_hrn = client::HRN::FromString(catalog);
+  const std::string lookup_url =
+      "https://api-lookup.data.api.platform.here.com/lookup/v1/resources/" +
+      catalog + "/apis";
+  const time_t expiry = 13;
+  const olp::http::Header header = {"Cache-Control",
+                                    "max-age=" + std::to_string(expiry)};
+
+  {
+    SCOPED_TRACE("All services cached with one request");
+
+    EXPECT_CALL(*network_, Send(IsGetRequest(lookup_url), _, _, _, _))
+        .Times(1)
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     kResponseLookupResource, {header}));
+    EXPECT_CALL(*cache_, Put(_, _, _, expiry))
+        .Times(3)
+        .WillRepeatedly(Return(true));
+
+    client::CancellationContext context;
+    client::ApiLookupClientImpl client(catalog_hrn, settings_);
+    auto response = client.LookupAll(context);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().size(), 3u);
+
+    // The clients are cached, neither the network nor the cache are used.
+    auto pipelines = client.LookupApi("pipelines", "v2",
+                                      client::FetchOptions::CacheOnly, context);
+    ASSERT_TRUE(pipelines.IsSuccessful());
+    EXPECT_EQ(pipelines.GetResult().GetBaseUrl(),
+              "https://pipelines.api.platform.sit.here.com/pipeline-service");
+
+    auto random_service = client.LookupApi(
+        "random_service", "v8", client::FetchOptions::CacheOnly, context);
+    ASSERT_TRUE(random_service.IsSuccessful());
+    EXPECT_EQ(random_service.GetResult().GetBaseUrl(), kConfigBaseUrl);
+    testing::Mock::VerifyAndClearExpectations(network_.get());
+    testing::Mock::VerifyAndClearExpectations(cache_.get());
+  }
+
+  {
+    SCOPED_TRACE("Network error");
+
+    EXPECT_CALL(*network_, Send(IsGetRequest(lookup_url), _, _, _, _))
+        .Times(1)
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::FORBIDDEN),
+                                     "Forbidden"));
+    EXPECT_CALL(*cache_, Put(_, _, _, _)).Times(0);
+
+    client::CancellationContext context;
+    client::ApiLookupClientImpl client(catalog_hrn, settings_);
+    auto response = client.LookupAll(context);
+
+    EXPECT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetHttpStatusCode(),
+              olp::http::HttpStatusCode::FORBIDDEN);
+    testing::Mock::VerifyAndClearExpectations(network_.get());
+    testing::Mock::VerifyAndClearExpectations(cache_.get());
+  }
+
+  {
+    SCOPED_TRACE("Static url catalog");
+
+    EXPECT_CALL(*network_, Send(_, _, _, _, _)).Times(0);
+    EXPECT_CALL(*cache_, Put(_, _, _, _)).Times(0);
+
+    client::ApiLookupSettings lookup_settings;
+    lookup_settings.catalog_endpoint_provider = [](const client::HRN&) {
+      return "https://some-lookup-url.com/lookup/v1";
+    };
+    settings_.api_lookup_settings = lookup_settings;
+
+    client::CancellationContext context;
+    client::ApiLookupClientImpl client(catalog_hrn, settings_);
+    auto response = client.LookupAll(context);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_TRUE(response.GetResult().empty());
+    testing::Mock::VerifyAndClearExpectations(network_.get());
+    testing::Mock::VerifyAndClearExpectations(cache_.get());
+  }
+}
+
+TEST_F(ApiLookupClientImplTest, LookupAllAsync) {
+  const std::string catalog =
+      "hrn:here:data::olp-here-test:hereos-internal-test-v2";
+  const auto catalog_hrn = client::HRN::FromString(catalog);
+  const std::string lookup_url =
+      "https://api-lookup.data.api.platform.here.com/lookup/v1/resources/" +
+      catalog + "/apis";
+
+  EXPECT_CALL(*network_, Send(IsGetRequest(lookup_url), _, _, _, _))
+      .Times(1)
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kResponseLookupResource));
+  EXPECT_CALL(*cache_, Put(_, _, _, _)).Times(3).WillRepeatedly(Return(true));
+
+  std::promise<client::ApiLookupClient::LookupAllResponse> promise;
+  auto future = promise.get_future();
+  client::ApiLookupClientImpl client(catalog_hrn, settings_);
+  client.LookupAll(
+      [&promise](client::ApiLookupClient::LookupAllResponse response) {
+        promise.set_value(std::move(response));
+      });
+
+  auto response = future.get();
+
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().size(), 3u);
+
+  client::CancellationContext context;
+  auto pipelines = client.LookupApi("pipelines", "v1",
+                                    client::FetchOptions::CacheOnly, context);
+  EXPECT_TRUE(pipelines.IsSuccessful());
+  testing::Mock::VerifyAndClearExpectations(network_.get());
+  testing::Mock::VerifyAndClearExpectations(cache_.get());
+}
+
+TEST_F(ApiLookupClientImplTest, StaleWhileRevalidate) {
+  const std::string catalog =
+      "hrn:here:data::olp-here-test:hereos-internal-test-v2";
+  const auto catalog_hrn = client::HRN::FromString(catalog);
+  const std::string service_name = "random_service";
+  const std::string service_version = "v8";
+  const std::string stale_url = "https://stale.url";
+  const std::string cache_key =
+      catalog + "::" + service_name + "::" + service_version + "::api";
+  const std::string lookup_url =
+      "https://api-lookup.data.api.platform.here.com/lookup/v1/resources/" +
+      catalog + "/apis";
+
+  settings_.max_staleness = std::chrono::seconds(60);
+
+  // The disk cache does not have the expired API anymore.
+  EXPECT_CALL(*cache_, Get(cache_key, _))
+      .WillRepeatedly(Return(boost::any()));
+  EXPECT_CALL(*network_, Send(IsGetRequest(lookup_url), _, _, _, _))
+      .Times(1)
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kResponseLookupResource));
+
+  std::promise<void> refreshed;
+  std::atomic<int> puts{0};
+  EXPECT_CALL(*cache_, Put(_, _, _, _))
+      .Times(3)
+      .WillRepeatedly(testing::Invoke(
+          [&](const std::string&, const boost::any&,
+              const olp::cache::Encoder&, time_t) {
+            if (++puts == 3) {
+              refreshed.set_value();
+            }
+            return true;
+          }));
+
+  ApiLookupClientImplTestable client(catalog_hrn, settings_);
+  client.CreateAndCacheClient(stale_url, service_name + service_version, 0);
+
+  client::CancellationContext context;
+  auto response =
+      client.LookupApi(service_name, service_version,
+                       client::FetchOptions::OnlineIfNotFound, context);
+
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().GetBaseUrl(), stale_url);
+
+  ASSERT_EQ(refreshed.get_future().wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+
+  response = client.LookupApi(service_name, service_version,
+                              client::FetchOptions::OnlineIfNotFound, context);
+
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().GetBaseUrl(), kConfigBaseUrl);
+  testing::Mock::VerifyAndClearExpectations(network_.get());
+  testing::Mock::VerifyAndClearExpectations(cache_.get());
+}
+
 }  // namespace
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <olp/core/client/Awaitable.h>
+
+#if defined(OLP_SDK_ENABLE_COROUTINES) && defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <future>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <olp/core/client/ApiResponse.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+
+namespace {
+namespace client = olp::client;
+
+using Response = client::ApiResponse<std::string, client::ApiError>;
+using Callback = std::function<void(Response)>;
+
+/// The coroutine that sets the promise when it finishes.
+struct Task {
+  struct promise_type {
+    Task get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+Task Await(client::Awaitable<Response> awaitable,
+           std::promise<Response>& result) {
+  result.set_value(co_await awaitable);
+}
+
+TEST(AwaitableTest, ResumesOnScheduler) {
+  auto scheduler = std::make_shared<olp::thread::ThreadPoolTaskScheduler>(1u);
+  std::thread call_thread;
+
+  std::promise<Response> result;
+  Await(client::Awaitable<Response>(
+            [&](Callback callback) {
+              call_thread = std::thread(
+                  [callback]() { callback(Response(std::string("data"))); });
+              return client::CancellationToken();
+            },
+            scheduler),
+        result);
+
+  auto response = result.get_future().get();
+  call_thread.join();
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ("data", response.GetResult());
+}
+
+TEST(AwaitableTest, SynchronousCallback) {
+  std::promise<Response> result;
+  Await(client::Awaitable<Response>(
+            [](Callback callback) {
+              callback(Response(std::string("cached")));
+              return client::CancellationToken();
+            },
+            nullptr),
+        result);
+
+  auto future = result.get_future();
+  ASSERT_EQ(std::future_status::ready,
+            future.wait_for(std::chrono::seconds(0)));
+  EXPECT_EQ("cached", future.get().GetResult());
+}
+
+TEST(AwaitableTest, Cancel) {
+  client::CancellationContext context;
+  Callback pending_callback;
+
+  std::promise<Response> result;
+  Await(client::Awaitable<Response>(
+            [&](Callback callback) {
+              pending_callback = callback;
+              return client::CancellationToken([&]() {
+                pending_callback(Response(client::ApiError::Cancelled()));
+              });
+            },
+            nullptr, context),
+        result);
+
+  context.CancelOperation();
+  auto response = result.get_future().get();
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(client::ErrorCode::Cancelled, response.GetError().GetErrorCode());
+}
+
+}  // namespace
+
+#endif  // OLP_SDK_ENABLE_COROUTINES && __cpp_impl_coroutine
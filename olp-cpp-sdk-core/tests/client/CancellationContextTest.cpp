@@ -17,6 +17,10 @@
  * License-Filename: LICENSE
  */
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <olp/core/client/CancellationContext.h>
@@ -52,3 +56,53 @@ TEST(CancellationContextTest, MoveAndCancelOperation) {
   EXPECT_FALSE(context.IsCancelled());
   EXPECT_TRUE(context_move.IsCancelled());
 }
+
+TEST(CancellationContextTest, ExecuteOrCancelledWithoutOperation) {
+  CancellationContext context;
+  int cancel_calls = 0;
+  auto cancel_fn = [&]() { ++cancel_calls; };
+
+  EXPECT_TRUE(context.ExecuteOrCancelled(nullptr, cancel_fn));
+  EXPECT_EQ(cancel_calls, 0);
+
+  context.CancelOperation();
+  EXPECT_FALSE(context.ExecuteOrCancelled(nullptr, cancel_fn));
+  EXPECT_EQ(cancel_calls, 1);
+}
+
+TEST(CancellationContextTest, CancelSubOperationConcurrently) {
+  CancellationContext context;
+  std::atomic<int> executed{0};
+  std::atomic<int> cancelled{0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&]() {
+      while (!context.IsCancelled()) {
+        context.ExecuteOrCancelled([&]() {
+          ++executed;
+          return olp::client::CancellationToken([&]() { ++cancelled; });
+        });
+      }
+    });
+  }
+
+  while (executed.load() == 0) {
+    std::this_thread::yield();
+  }
+  context.CancelOperation();
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Only the last stored sub-operation is cancelled, and nothing is executed
+  // after the cancellation.
+  EXPECT_EQ(cancelled.load(), 1);
+  const auto executed_after_cancel = executed.load();
+  EXPECT_FALSE(context.ExecuteOrCancelled([&]() {
+    ++executed;
+    return olp::client::CancellationToken();
+  }));
+  EXPECT_EQ(executed.load(), executed_after_cancel);
+}
@@ -17,6 +17,8 @@
  * License-Filename: LICENSE
  */
 
+#include <unordered_set>
+
 #include <olp/core/client/HRN.h>
 
 #include <gtest/gtest.h>
@@ -156,6 +158,30 @@ TEST(HRNTest, ToString) {
             "hrn:here:data:::test_pipeline");
 }
 
+TEST(HRNTest, ToCatalogHRNString) {
+  EXPECT_EQ(HRN("hrn:here:data:EU:test:hereos-internal-test-v2")
+                .ToCatalogHRNString(),
+            "hrn:here:data:EU:test:hereos-internal-test-v2");
+  EXPECT_EQ(HRN("hrn:here:data:EU:test:hereos-internal-test-v2:layer")
+                .ToCatalogHRNString(),
+            "hrn:here:data:EU:test:hereos-internal-test-v2");
+  EXPECT_EQ(HRN("hrn:here:pipeline:::test_pipeline").ToCatalogHRNString(), "");
+  EXPECT_EQ(HRN().ToString(), "hrn:::::");
+}
+
+TEST(HRNTest, Hash) {
+  const HRN catalog("hrn:here:data:::hereos-internal-test-v2");
+
+  EXPECT_EQ(catalog.GetHash(),
+            HRN("hrn:here:data:::hereos-internal-test-v2").GetHash());
+  EXPECT_NE(catalog.GetHash(),
+            HRN("hrn:here:data:::hereos-internal-test-v1").GetHash());
+
+  std::unordered_set<HRN> hrns{catalog};
+  EXPECT_EQ(hrns.count(HRN("hrn:here:data:::hereos-internal-test-v2")), 1u);
+  EXPECT_EQ(hrns.count(HRN("hrn:here:data:::hereos-internal-test-v1")), 0u);
+}
+
 TEST(HRNTest, Parsing) {
   {
     SCOPED_TRACE("Valid Catalog HRN");
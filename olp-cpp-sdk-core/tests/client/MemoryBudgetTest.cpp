@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <olp/core/client/MemoryBudget.h>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using olp::client::MemoryBudget;
+using olp::client::MemoryPressure;
+
+namespace {
+TEST(MemoryBudgetTest, PressureFollowsUsage) {
+  MemoryBudget budget(100u);
+  std::vector<MemoryPressure> changes;
+  budget.Register(
+      [&](MemoryPressure pressure) { changes.push_back(pressure); });
+
+  budget.Reserve(50u);
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kNone);
+  budget.Reserve(25u);
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kModerate);
+
+  // The memory is reserved above the limit as well.
+  budget.Reserve(50u);
+  EXPECT_EQ(budget.GetUsage(), 125u);
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kCritical);
+
+  budget.Release(100u);
+  EXPECT_EQ(budget.GetUsage(), 25u);
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kNone);
+
+  // Releasing more than reserved does not underflow.
+  budget.Release(100u);
+  EXPECT_EQ(budget.GetUsage(), 0u);
+
+  const std::vector<MemoryPressure> expected = {MemoryPressure::kModerate,
+                                                MemoryPressure::kCritical,
+                                                MemoryPressure::kNone};
+  EXPECT_EQ(changes, expected);
+}
+
+TEST(MemoryBudgetTest, OnLowMemory) {
+  MemoryBudget budget(100u);
+  std::vector<MemoryPressure> changes;
+  budget.Register(
+      [&](MemoryPressure pressure) { changes.push_back(pressure); });
+
+  budget.OnLowMemory();
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kCritical);
+
+  // Every notification is delivered, even without a change.
+  budget.OnLowMemory();
+
+  // The next usage change recomputes the pressure.
+  budget.Reserve(10u);
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kNone);
+
+  const std::vector<MemoryPressure> expected = {MemoryPressure::kCritical,
+                                                MemoryPressure::kCritical,
+                                                MemoryPressure::kNone};
+  EXPECT_EQ(changes, expected);
+}
+
+TEST(MemoryBudgetTest, Unregister) {
+  MemoryBudget budget(0u);
+  int calls = 0;
+  const auto id = budget.Register([&](MemoryPressure) { ++calls; });
+
+  // Without a limit only the low memory notifications are reported.
+  budget.Reserve(1000u);
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kNone);
+  budget.OnLowMemory();
+  EXPECT_EQ(calls, 1);
+
+  budget.Unregister(id);
+  budget.OnLowMemory();
+  EXPECT_EQ(calls, 1);
+}
+}  // namespace
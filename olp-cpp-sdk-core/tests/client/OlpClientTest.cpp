@@ -20,15 +20,19 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <future>
 #include <queue>
 #include <string>
 
 #include <olp/core/client/ApiError.h>
+#include <olp/core/client/DeadlineScope.h>
 #include <olp/core/client/OlpClient.h>
 #include <olp/core/client/OlpClientFactory.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/client/RetryBudget.h>
 
 #include <olp/core/http/Network.h>
 #include <olp/core/logging/Log.h>
@@ -1834,6 +1838,59 @@ TEST_F(OlpClientMergeTest, MergeMultipleCallbacks) {
   }
 }
 
+TEST_F(OlpClientMergeTest, MergeAcrossClients) {
+  const std::string path = "/layers/xyz/versions/1/quadkeys/23618402/depths/4";
+  const std::string base_url =
+      "https://api.platform.here.com/query/v1/catalogs/hrn:here:data:::dummy";
+  settings_.pending_requests =
+      olp::client::OlpClientSettingsFactory::CreatePendingRequests();
+  olp::client::OlpClient first_client(settings_, base_url);
+  olp::client::OlpClient second_client(settings_, base_url);
+  auto network = network_;
+
+  std::future<void> future;
+  auto wait_for_release = std::make_shared<std::promise<void>>();
+
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .WillOnce([&](olp::http::NetworkRequest /*request*/,
+                    olp::http::Network::Payload payload,
+                    olp::http::Network::Callback callback,
+                    olp::http::Network::HeaderCallback /*header_callback*/,
+                    olp::http::Network::DataCallback /*data_callback*/) {
+        future = std::async(std::launch::async, [=]() {
+          wait_for_release->get_future().get();
+
+          *payload << "content";
+          callback(olp::http::NetworkResponse()
+                       .WithStatus(http::HttpStatusCode::OK)
+                       .WithRequestId(5));
+        });
+
+        return olp::http::SendOutcome(5);
+      });
+
+  std::atomic<size_t> index{0u};
+  auto callback = [&](olp::client::HttpResponse response) {
+    ++index;
+    std::string response_payload;
+    response.GetResponse(response_payload);
+    EXPECT_EQ("content", response_payload);
+    EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+  };
+
+  // Both clients share the registry, so only one Network request is made
+  first_client.CallApi(path, "GET", {}, {}, {}, nullptr, "application/json",
+                       callback);
+  second_client.CallApi(path, "GET", {}, {}, {}, nullptr, "application/json",
+                        callback);
+
+  wait_for_release->set_value();
+  future.wait();
+
+  EXPECT_EQ(2u, index.load());
+  testing::Mock::VerifyAndClearExpectations(network.get());
+}
+
 TEST_F(OlpClientMergeTest, NoMergeMultipleCallbacks) {
   const std::string path = "/layers/xyz/versions/1/quadkeys/23618402/depths/4";
   client_.SetBaseUrl(
@@ -2050,4 +2107,511 @@ TEST_F(OlpClientMergeTest, NoMergeMultipleCallbacks) {
   }
 }
 
+TEST(OlpClientBufferTest, BufferedResponse) {
+  auto network = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  settings.retry_settings.max_attempts = 0;
+  olp::client::OlpClient client(settings, "https://example.com");
+
+  auto expect_send = [&](int status, std::string content) {
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([=](olp::http::NetworkRequest /*request*/,
+                      olp::http::Network::Payload payload,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback header_callback,
+                      olp::http::Network::DataCallback /*data_callback*/) {
+          header_callback("content-length", std::to_string(content.size()));
+          payload->write(content.data(), content.size());
+          // Rewrites the beginning of the body same as the network retries.
+          payload->seekp(0);
+          payload->write(content.data(), 1);
+          EXPECT_EQ(std::streampos(1), payload->tellp());
+          callback(olp::http::NetworkResponse().WithStatus(status));
+          return olp::http::SendOutcome(5);
+        });
+  };
+
+  {
+    SCOPED_TRACE("Successful response is stored in the buffer");
+    expect_send(http::HttpStatusCode::OK, "content");
+
+    auto response =
+        client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, true);
+    EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    EXPECT_TRUE(response.response.str().empty());
+
+    auto buffer = response.GetResponseBuffer();
+    ASSERT_TRUE(buffer);
+    EXPECT_EQ("content", std::string(buffer->begin(), buffer->end()));
+    EXPECT_GE(buffer->capacity(), 7u);
+
+    // The copies share the buffer.
+    auto copy = response;
+    EXPECT_EQ(buffer, copy.GetResponseBuffer());
+
+    std::string content;
+    copy.GetResponse(content);
+    EXPECT_EQ("content", content);
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+
+  {
+    SCOPED_TRACE("Error response is stored in the stream");
+    expect_send(http::HttpStatusCode::NOT_FOUND, "not found");
+
+    auto response =
+        client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, true);
+    EXPECT_EQ(http::HttpStatusCode::NOT_FOUND, response.GetStatus());
+    EXPECT_EQ("not found", response.response.str());
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+}
+
+std::string FindRequestHeader(const NetworkRequest& request,
+                              const std::string& name) {
+  for (const auto& header : request.GetHeaders()) {
+    if (header.first == name) {
+      return header.second;
+    }
+  }
+  return {};
+}
+
+TEST(OlpClientBufferTest, ResumeInterruptedDownload) {
+  auto network = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  settings.retry_settings.initial_backdown_period = 1;
+  settings.retry_settings.resume_downloads = true;
+  olp::client::OlpClient client(settings, "https://example.com");
+
+  testing::InSequence sequence;
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .WillOnce([](NetworkRequest request, olp::http::Network::Payload payload,
+                   olp::http::Network::Callback callback,
+                   olp::http::Network::HeaderCallback header_callback,
+                   olp::http::Network::DataCallback /*data_callback*/) {
+        EXPECT_TRUE(FindRequestHeader(request, "Range").empty());
+        header_callback("ETag", "\"tag\"");
+        *payload << "cont";
+        callback(olp::http::NetworkResponse().WithStatus(
+            static_cast<int>(http::ErrorCode::IO_ERROR)));
+        return olp::http::SendOutcome(5);
+      })
+      .WillOnce([](NetworkRequest request, olp::http::Network::Payload payload,
+                   olp::http::Network::Callback callback,
+                   olp::http::Network::HeaderCallback header_callback,
+                   olp::http::Network::DataCallback /*data_callback*/) {
+        EXPECT_EQ("bytes=4-", FindRequestHeader(request, "Range"));
+        EXPECT_EQ("\"tag\"", FindRequestHeader(request, "If-Range"));
+        header_callback("Content-Range", "bytes 4-6/7");
+        *payload << "ent";
+        callback(olp::http::NetworkResponse().WithStatus(
+            http::HttpStatusCode::PARTIAL_CONTENT));
+        return olp::http::SendOutcome(6);
+      });
+
+  auto response = client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, true);
+  EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+
+  std::string content;
+  response.GetResponse(content);
+  EXPECT_EQ("content", content);
+}
+
+TEST(OlpClientBufferTest, DownloadInChunks) {
+  auto network = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  settings.retry_settings.max_attempts = 0;
+  settings.download_chunk_size = 3u;
+  olp::client::OlpClient client(settings, "https://example.com");
+
+  const std::string body = "content";
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly(
+          [&](NetworkRequest request, olp::http::Network::Payload payload,
+              olp::http::Network::Callback callback,
+              olp::http::Network::HeaderCallback header_callback,
+              olp::http::Network::DataCallback /*data_callback*/) {
+            const auto range = FindRequestHeader(request, "Range");
+            const auto dash = range.find('-');
+            const auto first = std::stoul(range.substr(6, dash - 6));
+            const auto last = std::stoul(range.substr(dash + 1));
+            header_callback("Content-Range", "bytes " + std::to_string(first) +
+                                                 "-" + std::to_string(last) +
+                                                 "/7");
+            *payload << body.substr(first, last - first + 1);
+            callback(olp::http::NetworkResponse().WithStatus(
+                http::HttpStatusCode::PARTIAL_CONTENT));
+            return olp::http::SendOutcome(static_cast<int>(first + 1));
+          });
+
+  auto response = client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, true);
+  EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+
+  std::string content;
+  response.GetResponse(content);
+  EXPECT_EQ(body, content);
+}
+
+TEST(OlpClientBufferTest, DownloadInChunksRestartsWhenChanged) {
+  auto network = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  settings.task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(2u);
+  settings.retry_settings.max_attempts = 0;
+  settings.download_chunk_size = 2u;
+  olp::client::OlpClient client(settings, "https://example.com");
+
+  // The resource changes after the first chunk of the first download.
+  std::mutex mutex;
+  std::string body = "content";
+  std::string etag = "\"v1\"";
+  bool changed = false;
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .WillRepeatedly(
+          [&](NetworkRequest request, olp::http::Network::Payload payload,
+              olp::http::Network::Callback callback,
+              olp::http::Network::HeaderCallback header_callback,
+              olp::http::Network::DataCallback /*data_callback*/) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto range = FindRequestHeader(request, "Range");
+            const auto dash = range.find('-');
+            const auto first = std::stoul(range.substr(6, dash - 6));
+            const auto last = std::stoul(range.substr(dash + 1));
+            if (first == 0u) {
+              EXPECT_TRUE(FindRequestHeader(request, "If-Match").empty());
+            } else if (FindRequestHeader(request, "If-Match") != etag) {
+              callback(olp::http::NetworkResponse().WithStatus(
+                  http::HttpStatusCode::PRECONDITION_FAILED));
+              return olp::http::SendOutcome(static_cast<int>(first + 1));
+            }
+
+            header_callback("ETag", etag);
+            header_callback("Content-Range", "bytes " + std::to_string(first) +
+                                                 "-" + std::to_string(last) +
+                                                 "/7");
+            *payload << body.substr(first, last - first + 1);
+            callback(olp::http::NetworkResponse().WithStatus(
+                http::HttpStatusCode::PARTIAL_CONTENT));
+
+            if (!changed) {
+              changed = true;
+              body = "CONTENT";
+              etag = "\"v2\"";
+            }
+            return olp::http::SendOutcome(static_cast<int>(first + 1));
+          });
+
+  // The chunks of the first download fail the If-Match condition, and the
+  // whole body is downloaded again.
+  auto response = client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, true);
+  EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+
+  std::string content;
+  response.GetResponse(content);
+  EXPECT_EQ("CONTENT", content);
+}
+
+TEST(OlpClientBufferTest, StreamedResponse) {
+  auto network = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  settings.retry_settings.initial_backdown_period = 1;
+  olp::client::OlpClient client(settings, "https://example.com");
+
+  testing::InSequence sequence;
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .WillOnce([](NetworkRequest request, olp::http::Network::Payload payload,
+                   olp::http::Network::Callback callback,
+                   olp::http::Network::HeaderCallback /*header_callback*/,
+                   olp::http::Network::DataCallback /*data_callback*/) {
+        EXPECT_TRUE(FindRequestHeader(request, "Range").empty());
+        *payload << "unavailable";
+        callback(olp::http::NetworkResponse().WithStatus(
+            http::HttpStatusCode::SERVICE_UNAVAILABLE));
+        return olp::http::SendOutcome(5);
+      })
+      .WillOnce([](NetworkRequest /*request*/,
+                   olp::http::Network::Payload payload,
+                   olp::http::Network::Callback callback,
+                   olp::http::Network::HeaderCallback /*header_callback*/,
+                   olp::http::Network::DataCallback /*data_callback*/) {
+        *payload << "cont";
+        *payload << "ent";
+        callback(
+            olp::http::NetworkResponse().WithStatus(http::HttpStatusCode::OK));
+        return olp::http::SendOutcome(6);
+      });
+
+  std::vector<std::pair<uint64_t, std::string>> chunks;
+  auto response = client.CallApi(
+      {}, "GET", {}, {}, {}, nullptr, {}, {},
+      [&](const std::uint8_t* data, std::uint64_t offset, std::size_t length) {
+        chunks.emplace_back(
+            offset, std::string(reinterpret_cast<const char*>(data), length));
+      });
+  EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+  EXPECT_TRUE(response.response.str().empty());
+  EXPECT_TRUE(response.GetResponseBuffer()->empty());
+
+  // The retried request passes the body again from the start.
+  const std::vector<std::pair<uint64_t, std::string>> expected = {
+      {0u, "unavailable"}, {0u, "cont"}, {4u, "ent"}};
+  EXPECT_EQ(expected, chunks);
+}
+
+TEST(OlpClientBufferTest, StreamedRequestBody) {
+  auto network = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  settings.retry_settings.initial_backdown_period = 1;
+  olp::client::OlpClient client(settings, "https://example.com");
+
+  const std::string body = "content";
+  auto read_body = [](const NetworkRequest& request) {
+    std::string content(static_cast<size_t>(request.GetBodySourceSize()), 0);
+    request.GetBodySource()(0u, reinterpret_cast<std::uint8_t*>(&content[0]),
+                            content.size());
+    return content;
+  };
+
+  int attempt = 0;
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly([&](NetworkRequest request,
+                          olp::http::Network::Payload /*payload*/,
+                          olp::http::Network::Callback callback,
+                          olp::http::Network::HeaderCallback /*header_cb*/,
+                          olp::http::Network::DataCallback /*data_callback*/) {
+        // The retried request reads the body again from the start.
+        EXPECT_FALSE(request.GetBody());
+        EXPECT_EQ(body, read_body(request));
+        EXPECT_EQ("application/x-protobuf",
+                  FindRequestHeader(request, "Content-Type"));
+        callback(olp::http::NetworkResponse().WithStatus(
+            attempt++ == 0 ? http::HttpStatusCode::SERVICE_UNAVAILABLE
+                           : http::HttpStatusCode::OK));
+        return olp::http::SendOutcome(7);
+      });
+
+  auto response = client.CallApi(
+      {}, "POST", {}, {},
+      [&](std::uint64_t offset, std::uint8_t* buffer,
+          std::size_t size) -> std::int64_t {
+        const auto length = std::min<std::size_t>(size, body.size() - offset);
+        std::memcpy(buffer, body.data() + offset, length);
+        return static_cast<std::int64_t>(length);
+      },
+      static_cast<std::int64_t>(body.size()), "application/x-protobuf", {});
+  EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+}
+
+TEST(OlpClientHedgingTest, HedgeStalledRequest) {
+  auto network = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  settings.retry_settings.max_attempts = 0;
+  settings.retry_settings.hedge_percentile = 90u;
+  settings.retry_settings.min_hedge_delay = 10;
+  olp::client::OlpClient client(settings, "https://example.com");
+
+  auto respond = [](olp::http::Network::Payload payload,
+                    olp::http::Network::Callback callback,
+                    olp::http::Network::HeaderCallback header_callback,
+                    const std::string& content, olp::http::RequestId id) {
+    header_callback("content-length", std::to_string(content.size()));
+    *payload << content;
+    callback(olp::http::NetworkResponse()
+                 .WithStatus(http::HttpStatusCode::OK)
+                 .WithRequestId(id));
+  };
+
+  {
+    SCOPED_TRACE("Requests are not hedged until enough times are collected");
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .Times(20)
+        .WillRepeatedly(
+            [&](NetworkRequest /*request*/, olp::http::Network::Payload payload,
+                olp::http::Network::Callback callback,
+                olp::http::Network::HeaderCallback header_callback,
+                olp::http::Network::DataCallback /*data_callback*/) {
+              respond(payload, callback, header_callback, "fast", 1);
+              return olp::http::SendOutcome(1);
+            });
+
+    for (int i = 0; i < 20; ++i) {
+      auto response =
+          client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, false);
+      EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    }
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+
+  {
+    SCOPED_TRACE("Stalled request is hedged and cancelled");
+    olp::http::Network::Callback stalled_callback;
+
+    testing::InSequence sequence;
+    EXPECT_CALL(*network, Send(_, _, _, _, _))
+        .WillOnce([&](NetworkRequest /*request*/,
+                      olp::http::Network::Payload /*payload*/,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback /*header_callback*/,
+                      olp::http::Network::DataCallback /*data_callback*/) {
+          stalled_callback = std::move(callback);
+          return olp::http::SendOutcome(2);
+        })
+        .WillOnce([&](NetworkRequest /*request*/,
+                      olp::http::Network::Payload payload,
+                      olp::http::Network::Callback callback,
+                      olp::http::Network::HeaderCallback header_callback,
+                      olp::http::Network::DataCallback /*data_callback*/) {
+          respond(payload, callback, header_callback, "hedged", 3);
+          return olp::http::SendOutcome(3);
+        });
+    EXPECT_CALL(*network, Cancel(2)).WillOnce([&](olp::http::RequestId id) {
+      stalled_callback(
+          olp::http::NetworkResponse()
+              .WithStatus(static_cast<int>(http::ErrorCode::CANCELLED_ERROR))
+              .WithRequestId(id));
+    });
+
+    auto response =
+        client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, false);
+    EXPECT_EQ(http::HttpStatusCode::OK, response.GetStatus());
+    EXPECT_EQ("hedged", response.response.str());
+    testing::Mock::VerifyAndClearExpectations(network.get());
+  }
+}
+
+TEST(OlpClientRetryBudgetTest, FailFast) {
+  auto network = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  settings.retry_settings.max_attempts = 3;
+  settings.retry_settings.initial_backdown_period = 1;
+  settings.retry_settings.retry_condition =
+      [](const olp::client::HttpResponse&) { return true; };
+  settings.retry_settings.retry_budget =
+      std::make_shared<olp::client::RetryBudget>(
+          1u, std::chrono::hours(1), 3u, std::chrono::hours(1));
+  olp::client::OlpClient client(settings, "https://example.com");
+
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly(
+          [](NetworkRequest /*request*/,
+             olp::http::Network::Payload /*payload*/,
+             olp::http::Network::Callback callback,
+             olp::http::Network::HeaderCallback /*header_callback*/,
+             olp::http::Network::DataCallback /*data_callback*/) {
+            callback(olp::http::NetworkResponse().WithStatus(
+                http::HttpStatusCode::INTERNAL_SERVER_ERROR));
+            return olp::http::SendOutcome(5);
+          });
+
+  // The first request is retried once, the budget is spent then.
+  auto response = client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, false);
+  EXPECT_EQ(http::HttpStatusCode::INTERNAL_SERVER_ERROR, response.GetStatus());
+
+  // The third failure opens the circuit breaker of the host.
+  response = client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, false);
+  EXPECT_EQ(http::HttpStatusCode::INTERNAL_SERVER_ERROR, response.GetStatus());
+
+  response = client.CallApi({}, "GET", {}, {}, {}, nullptr, {}, {}, false);
+  EXPECT_EQ(http::HttpStatusCode::SERVICE_UNAVAILABLE, response.GetStatus());
+  testing::Mock::VerifyAndClearExpectations(network.get());
+}
+
+/// Runs the tasks immediately and records the delays.
+class DelayRecordingScheduler : public olp::thread::TaskScheduler {
+ public:
+  std::vector<std::chrono::milliseconds> delays;
+
+ protected:
+  void EnqueueTask(CallFuncType&& func) override { func(); }
+
+  void EnqueueDelayedTask(CallFuncType&& func, std::chrono::milliseconds delay,
+                          uint32_t /*priority*/) override {
+    delays.push_back(delay);
+    func();
+  }
+};
+
+TEST(OlpClientRetryTest, AsyncRetryIsScheduled) {
+  auto network = std::make_shared<NetworkMock>();
+  auto scheduler = std::make_shared<DelayRecordingScheduler>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  settings.task_scheduler = scheduler;
+  settings.retry_settings.max_attempts = 2;
+  settings.retry_settings.initial_backdown_period = 1000;
+  settings.retry_settings.backdown_strategy =
+      [](std::chrono::milliseconds period, size_t) { return period; };
+  settings.retry_settings.retry_condition =
+      [](const olp::client::HttpResponse&) { return true; };
+  olp::client::OlpClient client(settings, "https://example.com");
+
+  olp::http::RequestId request_id = 5;
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly(
+          [&](NetworkRequest /*request*/,
+              olp::http::Network::Payload /*payload*/,
+              olp::http::Network::Callback callback,
+              olp::http::Network::HeaderCallback /*header_callback*/,
+              olp::http::Network::DataCallback /*data_callback*/) {
+            const auto id = request_id++;
+            // Completes after `Send` returns, as the real networks do.
+            std::thread([=]() {
+              std::this_thread::sleep_for(kCallbackSleepTime);
+              callback(olp::http::NetworkResponse()
+                           .WithStatus(
+                               http::HttpStatusCode::SERVICE_UNAVAILABLE)
+                           .WithRequestId(id));
+            }).detach();
+            return olp::http::SendOutcome(id);
+          });
+
+  std::promise<HttpResponse> promise;
+  const auto start = std::chrono::steady_clock::now();
+  client.CallApi({}, "GET", {}, {}, {}, nullptr, {},
+                 [&](HttpResponse response) {
+                   promise.set_value(std::move(response));
+                 });
+
+  auto future = promise.get_future();
+  ASSERT_EQ(std::future_status::ready, future.wait_for(kCallbackWaitTime));
+  EXPECT_EQ(http::HttpStatusCode::SERVICE_UNAVAILABLE,
+            future.get().GetStatus());
+
+  // The backdown is left to the scheduler and does not block the thread.
+  EXPECT_EQ(std::vector<std::chrono::milliseconds>(
+                2u, std::chrono::milliseconds(1000)),
+            scheduler->delays);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  testing::Mock::VerifyAndClearExpectations(network.get());
+}
+
+TEST(OlpClientDeadlineTest, ExpiredDeadline) {
+  auto network = std::make_shared<testing::StrictMock<NetworkMock>>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+  olp::client::OlpClient client;
+  client.SetBaseUrl("https://here.com");
+  client.SetSettings(settings);
+
+  // The request is not sent after the deadline of the operation.
+  olp::client::DeadlineScope scope(std::chrono::steady_clock::now());
+  auto response = client.CallApi({}, "GET", {}, {}, {}, nullptr, {},
+                                 olp::client::CancellationContext{});
+  EXPECT_EQ(static_cast<int>(http::ErrorCode::TIMEOUT_ERROR),
+            response.GetStatus());
+}
+
 }  // namespace
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <olp/core/client/RetryBudget.h>
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using olp::client::RetryBudget;
+
+namespace {
+TEST(RetryBudgetTest, RetriesAreLimited) {
+  RetryBudget budget(2u, std::chrono::milliseconds(200), 0u,
+                     std::chrono::milliseconds(0));
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_FALSE(budget.TryRetry());
+
+  // The budget is refilled over the window.
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  EXPECT_TRUE(budget.TryRetry());
+}
+
+TEST(RetryBudgetTest, UnlimitedRetries) {
+  RetryBudget budget(0u, std::chrono::milliseconds(0), 0u,
+                     std::chrono::milliseconds(0));
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(budget.TryRetry());
+  }
+}
+
+TEST(RetryBudgetTest, CircuitBreaker) {
+  RetryBudget budget(0u, std::chrono::milliseconds(0), 2u,
+                     std::chrono::milliseconds(100));
+  const std::string url = "https://blob.example.com/data/1";
+  const std::string other_url = "https://lookup.example.com/apis";
+
+  budget.OnResult(url, true);
+  EXPECT_TRUE(budget.AllowRequest(url));
+
+  // A success resets the consecutive failures.
+  budget.OnResult(url, false);
+  budget.OnResult(url, true);
+  EXPECT_TRUE(budget.AllowRequest(url));
+
+  budget.OnResult(url, true);
+  EXPECT_FALSE(budget.AllowRequest("https://blob.example.com/data/2"));
+  EXPECT_TRUE(budget.AllowRequest(other_url));
+
+  // Only one request probes the host after the open time.
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  EXPECT_TRUE(budget.AllowRequest(url));
+  EXPECT_FALSE(budget.AllowRequest(url));
+
+  budget.OnResult(url, false);
+  EXPECT_TRUE(budget.AllowRequest(url));
+}
+}  // namespace
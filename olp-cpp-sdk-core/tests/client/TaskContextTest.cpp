@@ -19,9 +19,13 @@
 
 #include <olp/core/client/TaskContext.h>
 
+#include <future>
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/Condition.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
 
 namespace {
 
@@ -284,4 +288,134 @@ TEST(TaskContextTest, OLPSUP_10456) {
   EXPECT_FALSE(cancel_triggered);
 }
 
+using IntResponse = client::ApiResponse<int, client::ApiError>;
+using IntCallback = std::function<void(IntResponse)>;
+
+TEST(TaskContextTest, ContinuationSynchronous) {
+  auto scheduler = std::make_shared<olp::thread::ThreadPoolTaskScheduler>(1);
+  const auto thread_id = std::this_thread::get_id();
+  Response response;
+  int response_received = 0;
+
+  auto continuation =
+      TaskContext::Then<IntResponse>(
+          [](CancellationContext, IntCallback callback) { callback(2); })
+          .Then<Response>([&](CancellationContext, int value,
+                              Callback callback) {
+            // Reported synchronously, so no thread hop happens.
+            EXPECT_EQ(std::this_thread::get_id(), thread_id);
+            callback(std::string(value, 'a'));
+          });
+
+  TaskContext context = TaskContext::Create(
+      continuation,
+      [&](Response r) {
+        response = std::move(r);
+        response_received++;
+      },
+      CancellationContext(), scheduler);
+
+  bool finished = false;
+  context.Execute([&] { finished = true; });
+  context.Execute();
+
+  EXPECT_EQ(response_received, 1);
+  EXPECT_TRUE(finished);
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult(), "aa");
+}
+
+TEST(TaskContextTest, ContinuationError) {
+  bool second_stage_called = false;
+  Response response;
+
+  auto continuation =
+      TaskContext::Then<IntResponse>([](CancellationContext,
+                                        IntCallback callback) {
+        callback(ApiError(ErrorCode::NotFound, "test"));
+      }).Then<Response>([&](CancellationContext, int, Callback callback) {
+        second_stage_called = true;
+        callback(std::string());
+      });
+
+  TaskContext context = TaskContext::Create(
+      continuation, [&](Response r) { response = std::move(r); });
+  context.Execute();
+
+  EXPECT_FALSE(second_stage_called);
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetErrorCode(), ErrorCode::NotFound);
+}
+
+TEST(TaskContextTest, ContinuationAsynchronous) {
+  auto scheduler = std::make_shared<olp::thread::ThreadPoolTaskScheduler>(1);
+  std::thread network;
+  std::promise<std::thread::id> second_stage_thread;
+  std::promise<Response> response;
+
+  auto continuation =
+      TaskContext::Then<IntResponse>([&](CancellationContext,
+                                         IntCallback callback) {
+        // The response arrives later on another thread.
+        network = std::thread([callback] { callback(3); });
+      }).Then<Response>([&](CancellationContext, int value,
+                            Callback callback) {
+        second_stage_thread.set_value(std::this_thread::get_id());
+        callback(std::string(value, 'b'));
+      });
+
+  TaskContext context = TaskContext::Create(
+      continuation, [&](Response r) { response.set_value(std::move(r)); },
+      CancellationContext(), scheduler);
+
+  bool finished = false;
+  context.Execute([&] { finished = true; });
+
+  auto future = response.get_future();
+  ASSERT_EQ(future.wait_for(kWaitTime), std::future_status::ready);
+  network.join();
+
+  auto result = future.get();
+  ASSERT_TRUE(result.IsSuccessful());
+  EXPECT_EQ(result.GetResult(), "bbb");
+
+  // The second stage runs on the scheduler, not on the reporting thread.
+  const auto stage_thread = second_stage_thread.get_future().get();
+  EXPECT_NE(stage_thread, std::this_thread::get_id());
+  EXPECT_TRUE(context.BlockingCancel(kWaitTime));
+  EXPECT_TRUE(finished);
+}
+
+TEST(TaskContextTest, ContinuationCancel) {
+  IntCallback pending_callback;
+  bool second_stage_called = false;
+  Response response;
+
+  auto continuation =
+      TaskContext::Then<IntResponse>([&](CancellationContext context,
+                                         IntCallback callback) {
+        context.ExecuteOrCancelled([&]() {
+          pending_callback = callback;
+          return CancellationToken();
+        });
+      }).Then<Response>([&](CancellationContext, int, Callback callback) {
+        second_stage_called = true;
+        callback(std::string());
+      });
+
+  TaskContext context = TaskContext::Create(
+      continuation, [&](Response r) { response = std::move(r); });
+  context.Execute();
+  context.CancelToken().Cancel();
+
+  // The first stage ignores the cancellation and reports its result.
+  ASSERT_TRUE(pending_callback);
+  pending_callback(1);
+
+  EXPECT_FALSE(second_stage_called);
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetErrorCode(), ErrorCode::Cancelled);
+  EXPECT_TRUE(context.BlockingCancel(std::chrono::milliseconds{0}));
+}
+
 }  // namespace
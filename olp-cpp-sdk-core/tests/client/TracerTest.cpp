@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <olp/core/client/Tracer.h>
+
+namespace {
+using olp::client::ScopedSpan;
+using olp::client::Span;
+using olp::client::SpanScope;
+using olp::client::Tracer;
+
+struct RecordedSpan : public Span {
+  void SetAttribute(const std::string& key, const std::string& value) override {
+    attributes.emplace_back(key, value);
+  }
+  void End() override { ++end_count; }
+
+  std::string name;
+  std::shared_ptr<Span> parent;
+  std::vector<std::pair<std::string, std::string>> attributes;
+  int end_count = 0;
+};
+
+struct RecordingTracer : public Tracer {
+  std::shared_ptr<Span> StartSpan(
+      const std::string& name, const std::shared_ptr<Span>& parent) override {
+    auto span = std::make_shared<RecordedSpan>();
+    span->name = name;
+    span->parent = parent;
+    spans.push_back(span);
+    return span;
+  }
+
+  std::vector<std::shared_ptr<RecordedSpan>> spans;
+};
+
+TEST(TracerTest, NestedSpans) {
+  auto tracer = std::make_shared<RecordingTracer>();
+  {
+    ScopedSpan outer(tracer, "outer");
+    EXPECT_TRUE(outer.IsTraced());
+    outer.SetAttribute("key", "value");
+    {
+      ScopedSpan inner(tracer, "inner");
+      EXPECT_EQ(SpanScope::GetCurrentSpan(), tracer->spans.back());
+    }
+    EXPECT_EQ(SpanScope::GetCurrentSpan(), tracer->spans.front());
+  }
+  EXPECT_EQ(SpanScope::GetCurrentSpan(), nullptr);
+
+  ASSERT_EQ(tracer->spans.size(), 2u);
+  const auto& outer = tracer->spans[0];
+  const auto& inner = tracer->spans[1];
+  EXPECT_EQ(outer->name, "outer");
+  EXPECT_EQ(outer->parent, nullptr);
+  EXPECT_EQ(outer->end_count, 1);
+  ASSERT_EQ(outer->attributes.size(), 1u);
+  EXPECT_EQ(outer->attributes[0].first, "key");
+  EXPECT_EQ(inner->name, "inner");
+  EXPECT_EQ(inner->parent, outer);
+  EXPECT_EQ(inner->end_count, 1);
+}
+
+TEST(TracerTest, SpanScopeAcrossThreads) {
+  auto tracer = std::make_shared<RecordingTracer>();
+  auto root = olp::client::StartSpan(tracer, "root");
+  ASSERT_NE(root, nullptr);
+
+  std::shared_ptr<Span> captured;
+  {
+    SpanScope scope(root);
+    captured = SpanScope::GetCurrentSpan();
+  }
+
+  std::thread thread([&]() {
+    EXPECT_EQ(SpanScope::GetCurrentSpan(), nullptr);
+    SpanScope scope(captured);
+    ScopedSpan child(tracer, "child");
+  });
+  thread.join();
+
+  ASSERT_EQ(tracer->spans.size(), 2u);
+  EXPECT_EQ(tracer->spans[1]->parent, root);
+}
+
+TEST(TracerTest, NoTracer) {
+  std::shared_ptr<Tracer> tracer;
+  EXPECT_EQ(olp::client::StartSpan(tracer, "span"), nullptr);
+
+  ScopedSpan span(tracer, "span");
+  EXPECT_FALSE(span.IsTraced());
+  span.SetAttribute("key", "value");
+  EXPECT_EQ(SpanScope::GetCurrentSpan(), nullptr);
+}
+}  // namespace
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gmock/gmock.h>
+#include <matchers/NetworkUrlMatchers.h>
+#include <mocks/CacheMock.h>
+#include <mocks/NetworkMock.h>
+#include <olp/core/client/Warmup.h>
+
+namespace {
+namespace client = olp::client;
+namespace http = olp::http;
+
+using testing::_;
+
+constexpr auto kCatalog =
+    "hrn:here:data::olp-here-test:hereos-internal-test-v2";
+constexpr auto kLookupUrl =
+    "https://api-lookup.data.api.platform.here.com/lookup/v1/resources/"
+    "hrn:here:data::olp-here-test:hereos-internal-test-v2/apis";
+constexpr auto kResponseLookupResource =
+    R"jsonString([{"api":"blob","version":"v1","baseURL":"https://blob.data.api.platform.here.com/blobstore/v1/catalogs/hereos-internal-test-v2","parameters":{}},{"api":"query","version":"v1","baseURL":"https://query.data.api.platform.here.com/query/v1/catalogs/hereos-internal-test-v2","parameters":{}}])jsonString";
+
+class PreResolveNetworkMock : public NetworkMock {
+ public:
+  void PreResolve(const std::vector<std::string>& urls) override {
+    events.insert(events.end(), urls.begin(), urls.end());
+  }
+
+  std::vector<std::string> events;
+};
+
+class WarmupTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    network_ = std::make_shared<PreResolveNetworkMock>();
+    settings_.network_request_handler = network_;
+    settings_.cache = std::make_shared<testing::NiceMock<CacheMock>>();
+    settings_.retry_settings.max_attempts = 0;
+
+    client::AuthenticationSettings authentication_settings;
+    authentication_settings.provider = [this]() {
+      network_->events.emplace_back("token");
+      return "token";
+    };
+    settings_.authentication_settings = authentication_settings;
+  }
+
+  std::shared_ptr<PreResolveNetworkMock> network_;
+  client::OlpClientSettings settings_;
+};
+
+TEST_F(WarmupTest, Warmup) {
+  const std::vector<client::HRN> catalogs = {client::HRN(kCatalog)};
+
+  {
+    SCOPED_TRACE("Lookup hosts, token, lookup, then the service hosts");
+
+    EXPECT_CALL(*network_, Send(IsGetRequest(kLookupUrl), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            http::NetworkResponse().WithStatus(http::HttpStatusCode::OK),
+            kResponseLookupResource));
+
+    auto response = client::Warmup(catalogs, settings_).GetFuture().get();
+    EXPECT_TRUE(response.IsSuccessful());
+
+    // The lookup request gets the token acquired by the warm-up.
+    const std::vector<std::string> expected = {
+        "https://api-lookup.data.api.platform.here.com/lookup/v1",
+        "token",
+        "token",
+        "https://blob.data.api.platform.here.com/blobstore/v1/catalogs/"
+        "hereos-internal-test-v2",
+        "https://query.data.api.platform.here.com/query/v1/catalogs/"
+        "hereos-internal-test-v2"};
+    EXPECT_EQ(expected, network_->events);
+    testing::Mock::VerifyAndClearExpectations(network_.get());
+  }
+
+  {
+    SCOPED_TRACE("Lookup error");
+
+    network_->events.clear();
+    EXPECT_CALL(*network_, Send(IsGetRequest(kLookupUrl), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            http::NetworkResponse().WithStatus(
+                http::HttpStatusCode::FORBIDDEN),
+            "Forbidden"));
+
+    auto response = client::Warmup(catalogs, settings_).GetFuture().get();
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(http::HttpStatusCode::FORBIDDEN,
+              response.GetError().GetHttpStatusCode());
+    testing::Mock::VerifyAndClearExpectations(network_.get());
+  }
+
+  {
+    SCOPED_TRACE("No catalogs");
+
+    EXPECT_CALL(*network_, Send(_, _, _, _, _)).Times(0);
+    auto response = client::Warmup({}, settings_).GetFuture().get();
+    EXPECT_TRUE(response.IsSuccessful());
+  }
+}
+
+}  // namespace
@@ -87,6 +87,56 @@ TEST(GeoRectangleTest, Containment) {
       GeoRectangle(GeoCoordinates(0, 0), GeoCoordinates(0.05, 0.15))));
 }
 
+TEST(GeoRectangleTest, ContainmentAcrossDateLine) {
+  const GeoRectangle rectangle(GeoCoordinates::FromDegrees(-10, 170),
+                               GeoCoordinates::FromDegrees(10, -170));
+
+  EXPECT_TRUE(rectangle.Contains(GeoCoordinates::FromDegrees(0, 175)));
+  EXPECT_TRUE(rectangle.Contains(GeoCoordinates::FromDegrees(0, -175)));
+  EXPECT_FALSE(rectangle.Contains(GeoCoordinates::FromDegrees(0, 0)));
+  EXPECT_FALSE(rectangle.Contains(GeoCoordinates::FromDegrees(20, 175)));
+
+  EXPECT_TRUE(
+      rectangle.Overlaps(GeoRectangle(GeoCoordinates::FromDegrees(0, -175),
+                                      GeoCoordinates::FromDegrees(5, 0))));
+  EXPECT_TRUE(
+      rectangle.Overlaps(GeoRectangle(GeoCoordinates::FromDegrees(0, 175),
+                                      GeoCoordinates::FromDegrees(5, -175))));
+  EXPECT_FALSE(
+      rectangle.Overlaps(GeoRectangle(GeoCoordinates::FromDegrees(0, -160),
+                                      GeoCoordinates::FromDegrees(5, 160))));
+}
+
+TEST(GeoRectangleTest, BatchQueries) {
+  const GeoRectangle rectangle(GeoCoordinates::FromDegrees(-10, 170),
+                               GeoCoordinates::FromDegrees(10, -170));
+  const std::vector<GeoCoordinates> points = {
+      GeoCoordinates::FromDegrees(0, 175), GeoCoordinates::FromDegrees(0, 0),
+      GeoCoordinates::FromDegrees(-10, -170),
+      GeoCoordinates::FromDegrees(11, 180)};
+  const std::vector<GeoRectangle> rectangles = {
+      GeoRectangle(GeoCoordinates::FromDegrees(0, -175),
+                   GeoCoordinates::FromDegrees(5, 0)),
+      GeoRectangle(GeoCoordinates::FromDegrees(0, -160),
+                   GeoCoordinates::FromDegrees(5, 160)),
+      GeoRectangle(GeoCoordinates::FromDegrees(20, 175),
+                   GeoCoordinates::FromDegrees(30, 176)),
+      GeoRectangle()};
+
+  const auto contained = rectangle.ContainsBatch(points);
+  ASSERT_EQ(points.size(), contained.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(rectangle.Contains(points[i]), contained[i]);
+  }
+
+  const auto overlapping = rectangle.OverlapsBatch(rectangles);
+  ASSERT_EQ(rectangles.size(), overlapping.size());
+  for (size_t i = 0; i < rectangles.size(); ++i) {
+    EXPECT_EQ(rectangle.Overlaps(rectangles[i]), overlapping[i]);
+  }
+  EXPECT_EQ(std::vector<bool>({true, false, false, false}), overlapping);
+}
+
 TEST(GeoRectangleTest, BooleanUnion) {
   // Non-connected
   {
@@ -21,9 +21,13 @@
 #include "../testutil/CompareGeoCoordinates3d.h"
 #include <gtest/gtest.h>
 
+#include <vector>
+
+
 #include <olp/core/geo/coordinates/GeoRectangle.h>
 #include <olp/core/geo/projection/EarthConstants.h>
 #include <olp/core/geo/projection/WebMercatorProjection.h>
+#include <olp/core/math/Math.h>
 
 namespace olp {
 using namespace math;
@@ -72,5 +76,43 @@ TEST(WebMercatorProjectionTest, ProjectUnprojectPoint) {
                        WorldCoordinates(0.5 * r, 0.5 * r, -10));
 }
 
+TEST(WebMercatorProjectionTest, ProjectUnprojectPoints) {
+  const WebMercatorProjection projection;
+  const std::vector<double> latitudes = {0.0, Radians(52.5), Radians(-33.9),
+                                         Radians(89.0), Radians(-90.0)};
+  const std::vector<double> longitudes = {0.0, Radians(13.4), Radians(151.2),
+                                          Radians(-179.5), Radians(190.0)};
+  const std::vector<double> altitudes = {0.0, 34.0, -10.0, 100.0, 0.0};
+  const auto count = latitudes.size();
+
+  std::vector<double> x(count), y(count), z(count);
+  EXPECT_TRUE(projection.ProjectPoints(latitudes.data(), longitudes.data(),
+                                       altitudes.data(), count, x.data(),
+                                       y.data(), z.data()));
+
+  std::vector<double> latitudesOut(count), longitudesOut(count),
+      altitudesOut(count);
+  EXPECT_TRUE(projection.UnprojectPoints(
+      x.data(), y.data(), z.data(), count, latitudesOut.data(),
+      longitudesOut.data(), altitudesOut.data()));
+
+  // The batch results are the same as the ones of the point by point calls.
+  for (size_t index = 0; index < count; ++index) {
+    WorldCoordinates world;
+    EXPECT_TRUE(projection.Project(
+        GeoCoordinates3d(latitudes[index], longitudes[index], altitudes[index]),
+        world));
+    EXPECT_DOUBLE_EQ(world.x, x[index]);
+    EXPECT_DOUBLE_EQ(world.y, y[index]);
+    EXPECT_DOUBLE_EQ(world.z, z[index]);
+
+    GeoCoordinates3d geo;
+    EXPECT_TRUE(projection.Unproject(world, geo));
+    EXPECT_DOUBLE_EQ(geo.GetLatitude(), latitudesOut[index]);
+    EXPECT_DOUBLE_EQ(geo.GetLongitude(), longitudesOut[index]);
+    EXPECT_DOUBLE_EQ(geo.GetAltitude(), altitudesOut[index]);
+  }
+}
+
 }  // namespace geo
 }  // namespace olp
@@ -19,8 +19,11 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <olp/core/geo/tiling/HalfQuadTreeSubdivisionScheme.h>
 #include <olp/core/geo/tiling/QuadTreeSubdivisionScheme.h>
+#include <olp/core/geo/tiling/TileTreeTraverse.h>
 
 namespace olp {
 namespace geo {
@@ -73,5 +76,39 @@ TEST(SubdivisionScheme, Dimensions) {
   EXPECT_EQ(1U, halfQuadTreeSubdivisionScheme.GetLevelSize(1).Height());
 }
 
+template <typename SubdivisionScheme>
+void ExpectSameSubNodes() {
+  const SubdivisionScheme scheme;
+  const TileTreeTraverse traverse(scheme);
+  const TileTreeTraverseT<SubdivisionScheme> static_traverse;
+
+  for (const auto& tile : {TileKey::FromRowColumnLevel(0, 0, 0),
+                           TileKey::FromRowColumnLevel(0, 1, 1),
+                           TileKey::FromRowColumnLevel(5, 7, 4)}) {
+    SCOPED_TRACE(tile);
+    const auto& subdivision = scheme.GetSubdivisionAt(tile.Level());
+    EXPECT_EQ(subdivision.Width() * subdivision.Height(),
+              SubdivisionScheme::ChildCountAt(tile.Level()));
+
+    std::vector<TileKey> expected;
+    for (const auto& sub_tile : traverse.SubNodes(tile)) {
+      expected.push_back(sub_tile);
+    }
+    std::vector<TileKey> actual;
+    for (const auto& sub_tile : static_traverse.SubNodes(tile)) {
+      actual.push_back(sub_tile);
+    }
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST(SubdivisionScheme, StaticTraverse) {
+  static_assert(QuadTreeSubdivisionScheme::ChildCountAt(0) == 4u, "");
+  static_assert(HalfQuadTreeSubdivisionScheme::ChildCountAt(0) == 2u, "");
+
+  ExpectSameSubNodes<QuadTreeSubdivisionScheme>();
+  ExpectSameSubNodes<HalfQuadTreeSubdivisionScheme>();
+}
+
 }  // namespace geo
 }  // namespace olp
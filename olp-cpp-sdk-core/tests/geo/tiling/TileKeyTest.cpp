@@ -21,6 +21,8 @@
 
 #include <cmath>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <olp/core/geo/tiling/TileKey.h>
 
@@ -387,3 +389,40 @@ TEST(TileKeyTest, GetNearestAvailableTileKeyLevel) {
     EXPECT_EQ(10u, *level);
   }
 }
+
+TEST(TileKeyTest, QuadKey64MaxLevel) {
+  const auto tile = TileKey::FromRowColumnLevel(0x7FFFFFFF, 0x2AAAAAAA, 31);
+  const auto quad_key = tile.ToQuadKey64();
+
+  EXPECT_EQ(0x6EEEEEEEEEEEEEEEull, quad_key);
+  EXPECT_EQ(tile, TileKey::FromQuadKey64(quad_key));
+  EXPECT_EQ(TileKey::FromRowColumnLevel(0, 0, 0), TileKey::FromQuadKey64(0));
+}
+
+TEST(TileKeyTest, BatchConversion) {
+  const std::vector<TileKey> tiles = {
+      TileKey::FromRowColumnLevel(0, 0, 0),
+      TileKey::FromRowColumnLevel(1, 0, 1),
+      TileKey::FromRowColumnLevel(6481, 8800, 14),
+      TileKey::FromRowColumnLevel(0x7FFFFFFF, 0x7FFFFFFF, 31)};
+  const auto count = tiles.size();
+
+  std::vector<std::uint64_t> quad_keys(count);
+  ToQuadKeys64(tiles.data(), count, quad_keys.data());
+  std::vector<TileKey> from_quad_keys(count);
+  FromQuadKeys64(quad_keys.data(), count, from_quad_keys.data());
+
+  std::vector<std::string> here_tiles(count);
+  ToHereTiles(tiles.data(), count, here_tiles.data());
+  std::vector<TileKey> from_here_tiles(count);
+  FromHereTiles(here_tiles.data(), count, from_here_tiles.data());
+
+  for (size_t index = 0; index < count; ++index) {
+    SCOPED_TRACE(tiles[index]);
+    EXPECT_EQ(tiles[index].ToQuadKey64(), quad_keys[index]);
+    EXPECT_EQ(tiles[index].ToHereTile(), here_tiles[index]);
+  }
+  EXPECT_EQ(tiles, from_quad_keys);
+  EXPECT_EQ(tiles, from_here_tiles);
+  EXPECT_EQ("377894402", here_tiles[2]);
+}
@@ -22,10 +22,13 @@
 #include <olp/core/geo/tiling/TileKey.h>
 #include <olp/core/geo/tiling/TileKeyUtils.h>
 #include <olp/core/geo/tiling/TilingSchemeRegistry.h>
+#include <olp/core/math/AlignedBox.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <queue>
+#include <unordered_set>
 #include <vector>
 
 namespace olp {
@@ -187,6 +190,179 @@ TEST(TileKeyUtilsTest, GeoRectangleToTileKeysBoundaries) {
   }
 }
 
+TEST(TileKeyUtilsTest, GeoRectangleToTileKeysCallback) {
+  const HalfQuadTreeEquirectangularTilingScheme tilingScheme;
+  const GeoRectangle dateLineArea(GeoCoordinates::FromDegrees(-10.0, 179.9),
+                                  GeoCoordinates::FromDegrees(10.0, -179.9));
+
+  const auto expected =
+      TileKeyUtils::GeoRectangleToTileKeys(tilingScheme, dateLineArea, 12);
+  std::vector<TileKey> tileKeys;
+  TileKeyUtils::GeoRectangleToTileKeys(
+      tilingScheme, dateLineArea, 12,
+      [&](const TileKey& tileKey) { tileKeys.push_back(tileKey); });
+
+  EXPECT_FALSE(tileKeys.empty());
+  EXPECT_EQ(expected, tileKeys);
+}
+
+TEST(TileKeyUtilsTest, GeoRectangleToCoveringTileKeys) {
+  const HalfQuadTreeEquirectangularTilingScheme tilingScheme;
+  const std::uint32_t maxLevel = 12;
+
+  const std::vector<GeoRectangle> areas = {
+      GeoRectangle(GeoCoordinates::FromDegrees(52.3, 13.0),
+                   GeoCoordinates::FromDegrees(52.7, 13.8)),
+      GeoRectangle(GeoCoordinates::FromDegrees(-10.0, 170.0),
+                   GeoCoordinates::FromDegrees(10.0, -170.0)),
+      GeoRectangle(GeoCoordinates::FromDegrees(-5.0, -5.0),
+                   GeoCoordinates::FromDegrees(5.0, 5.0))};
+
+  for (const auto& area : areas) {
+    const auto tileKeys =
+        TileKeyUtils::GeoRectangleToTileKeys(tilingScheme, area, maxLevel);
+    const auto covering = TileKeyUtils::GeoRectangleToCoveringTileKeys(
+        tilingScheme, area, 1, maxLevel);
+    EXPECT_LT(covering.size(), tileKeys.size());
+
+    // Every tile of the rectangle is covered by exactly one covering tile,
+    // and the covering tiles contain no other tiles.
+    size_t coveredCount = 0;
+    for (const auto& tileKey : covering) {
+      EXPECT_GE(tileKey.Level(), 1u);
+      EXPECT_LE(tileKey.Level(), maxLevel);
+      const auto delta = maxLevel - tileKey.Level();
+      coveredCount += size_t{1} << (2 * delta);
+    }
+    const std::unordered_set<TileKey> coveringSet(covering.begin(),
+                                                  covering.end());
+    EXPECT_EQ(covering.size(), coveringSet.size());
+    for (const auto& tileKey : tileKeys) {
+      int count = 0;
+      for (auto level = 1u; level <= maxLevel; ++level) {
+        count += coveringSet.count(tileKey.ChangedLevelTo(level));
+      }
+      EXPECT_EQ(1, count);
+    }
+    EXPECT_EQ(tileKeys.size(), coveredCount);
+  }
+
+  EXPECT_TRUE(TileKeyUtils::GeoRectangleToCoveringTileKeys(
+                  tilingScheme, GeoRectangle(), 1, maxLevel)
+                  .empty());
+}
+
+TEST(TileKeyUtilsTest, CalculateTileBoxes) {
+  const HalfQuadTreeEquirectangularTilingScheme tiling_scheme;
+  const std::vector<TileKey> tile_keys = {
+      TileKey::FromRowColumnLevel(0, 0, 0),
+      TileKey::FromRowColumnLevel(5, 7, 4),
+      TileKey::FromRowColumnLevel(6, 7, 4),
+      TileKey::FromRowColumnLevel(1000, 2000, 12)};
+
+  const auto boxes = CalculateTileBoxes(tiling_scheme, tile_keys);
+
+  ASSERT_EQ(tile_keys.size(), boxes.size());
+  const auto expect_eq = [](const WorldCoordinates& expected,
+                            const WorldCoordinates& actual) {
+    EXPECT_EQ(expected.x, actual.x);
+    EXPECT_EQ(expected.y, actual.y);
+    EXPECT_EQ(expected.z, actual.z);
+  };
+  for (size_t i = 0; i < tile_keys.size(); ++i) {
+    const auto box = CalculateTileBox(tiling_scheme, tile_keys[i]);
+    expect_eq(box.Minimum(), boxes[i].Minimum());
+    expect_eq(box.Maximum(), boxes[i].Maximum());
+  }
+  EXPECT_TRUE(CalculateTileBoxes(tiling_scheme, {}).empty());
+}
+
+TEST(TileKeyUtilsTest, OverlapsGeoRectangle) {
+  const HalfQuadTreeEquirectangularTilingScheme tiling_scheme;
+  const GeoRectangle rectangle(GeoCoordinates::FromDegrees(-10, 170),
+                               GeoCoordinates::FromDegrees(10, -170));
+
+  std::vector<TileKey> tile_keys;
+  std::unordered_set<TileKey> expected;
+  for (std::uint32_t level = 3; level <= 5; ++level) {
+    const auto keys =
+        TileKeyUtils::GeoRectangleToTileKeys(tiling_scheme, rectangle, level);
+    expected.insert(keys.begin(), keys.end());
+    const auto level_size =
+        tiling_scheme.GetSubdivisionScheme().GetLevelSize(level);
+    for (std::uint32_t row = 0; row < level_size.Height(); ++row) {
+      for (std::uint32_t column = 0; column < level_size.Width(); ++column) {
+        tile_keys.push_back(TileKey::FromRowColumnLevel(row, column, level));
+      }
+    }
+  }
+  tile_keys.push_back(TileKey());
+
+  const auto overlapping =
+      TileKeyUtils::OverlapsGeoRectangle(tiling_scheme, tile_keys, rectangle);
+
+  ASSERT_EQ(tile_keys.size(), overlapping.size());
+  for (size_t i = 0; i < tile_keys.size(); ++i) {
+    EXPECT_EQ(expected.count(tile_keys[i]) > 0u, overlapping[i])
+        << tile_keys[i].ToHereTile();
+  }
+}
+
+TEST(TileKeyUtilsTest, GeoPolygonToTileKeys) {
+  const HalfQuadTreeEquirectangularTilingScheme tilingScheme;
+  const std::uint32_t level = 10;
+
+  auto collect = [&](const std::vector<GeoCoordinates>& polygon) {
+    std::vector<TileKey> tileKeys;
+    TileKeyUtils::GeoPolygonToTileKeys(
+        tilingScheme, polygon, level,
+        [&](const TileKey& tileKey) { tileKeys.push_back(tileKey); });
+    return tileKeys;
+  };
+
+  {
+    SCOPED_TRACE("Rectangle");
+    const auto tileKeys = collect({GeoCoordinates::FromDegrees(52.3, 13.0),
+                                   GeoCoordinates::FromDegrees(52.3, 13.8),
+                                   GeoCoordinates::FromDegrees(52.7, 13.8),
+                                   GeoCoordinates::FromDegrees(52.7, 13.0)});
+    const auto expected = TileKeyUtils::GeoRectangleToTileKeys(
+        tilingScheme,
+        GeoRectangle(GeoCoordinates::FromDegrees(52.3, 13.0),
+                     GeoCoordinates::FromDegrees(52.7, 13.8)),
+        level);
+    EXPECT_EQ(expected, tileKeys);
+  }
+
+  {
+    SCOPED_TRACE("Concave polygon");
+    // An U shape, the notch between 1 and 9 degrees of longitude above 1
+    // degree of latitude is outside.
+    const auto tileKeys = collect({GeoCoordinates::FromDegrees(0.1, 0.1),
+                                   GeoCoordinates::FromDegrees(0.1, 9.9),
+                                   GeoCoordinates::FromDegrees(9.9, 9.9),
+                                   GeoCoordinates::FromDegrees(9.9, 9.0),
+                                   GeoCoordinates::FromDegrees(1.0, 9.0),
+                                   GeoCoordinates::FromDegrees(1.0, 1.0),
+                                   GeoCoordinates::FromDegrees(9.9, 1.0),
+                                   GeoCoordinates::FromDegrees(9.9, 0.1)});
+    const auto notch = TileKeyUtils::GeoCoordinatesToTileKey(
+        tilingScheme, GeoCoordinates::FromDegrees(5.0, 5.0), level);
+    const auto arm = TileKeyUtils::GeoCoordinatesToTileKey(
+        tilingScheme, GeoCoordinates::FromDegrees(5.0, 9.5), level);
+    const auto base = TileKeyUtils::GeoCoordinatesToTileKey(
+        tilingScheme, GeoCoordinates::FromDegrees(0.5, 5.0), level);
+
+    EXPECT_EQ(0, std::count(tileKeys.begin(), tileKeys.end(), notch));
+    EXPECT_EQ(1, std::count(tileKeys.begin(), tileKeys.end(), arm));
+    EXPECT_EQ(1, std::count(tileKeys.begin(), tileKeys.end(), base));
+  }
+
+  EXPECT_TRUE(collect({GeoCoordinates::FromDegrees(1.0, 1.0),
+                       GeoCoordinates::FromDegrees(2.0, 2.0)})
+                  .empty());
+}
+
 struct TileKeyUtilsSubTileTest {
   TileKey parentTileKey;
   TileKey relativeSubtileKey;
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <http/DefaultNetwork.h>
+#include <mocks/NetworkMock.h>
+#include <olp/core/http/NetworkConstants.h>
+
+namespace {
+
+using namespace olp::http;
+using testing::_;
+
+constexpr RequestId kRequestId = 42;
+
+TEST(DefaultNetworkTest, DefaultHeaders) {
+  auto network = std::make_shared<NetworkMock>();
+  DefaultNetwork default_network(network);
+
+  Headers sent_headers;
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly([&](NetworkRequest request, Network::Payload,
+                          Network::Callback, Network::HeaderCallback,
+                          Network::DataCallback) {
+        sent_headers = request.GetHeaders();
+        return SendOutcome(kRequestId);
+      });
+
+  default_network.SetDefaultHeaders(
+      {{"x-default", "value"}, {kUserAgentHeader, "default-agent"}});
+
+  default_network.Send(NetworkRequest("https://example.com")
+                           .WithHeader(kUserAgentHeader, "request-agent"),
+                       nullptr, nullptr);
+  EXPECT_EQ(sent_headers,
+            Headers({{kUserAgentHeader, "request-agent default-agent"},
+                     {"x-default", "value"}}));
+
+  default_network.SetDefaultHeaders({});
+  default_network.Send(NetworkRequest("https://example.com"), nullptr,
+                       nullptr);
+  EXPECT_TRUE(sent_headers.empty());
+}
+
+TEST(DefaultNetworkTest, ResponseHeaderFilter) {
+  auto network = std::make_shared<NetworkMock>();
+  DefaultNetwork default_network(network);
+
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .WillOnce([&](NetworkRequest, Network::Payload, Network::Callback,
+                    Network::HeaderCallback header_callback,
+                    Network::DataCallback) {
+        header_callback("ETag", "1");
+        header_callback("content-length", "10");
+        header_callback("Server", "test");
+        return SendOutcome(kRequestId);
+      });
+
+  Headers received_headers;
+  auto request = NetworkRequest("https://example.com")
+                     .WithSettings(NetworkSettings().WithResponseHeaderFilter(
+                         {"Content-Length", "etag"}));
+  default_network.Send(
+      std::move(request), nullptr, nullptr,
+      [&](const std::string& key, const std::string& value) {
+        received_headers.emplace_back(key, value);
+      });
+
+  EXPECT_EQ(received_headers,
+            Headers({{"ETag", "1"}, {"content-length", "10"}}));
+}
+
+TEST(DefaultNetworkTest, TaggedStatistics) {
+  auto network = std::make_shared<NetworkMock>();
+  DefaultNetwork default_network(network);
+
+  std::vector<Network::Callback> callbacks;
+  EXPECT_CALL(*network, Send(_, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly([&](NetworkRequest, Network::Payload,
+                          Network::Callback callback, Network::HeaderCallback,
+                          Network::DataCallback) {
+        callbacks.push_back(std::move(callback));
+        return SendOutcome(kRequestId);
+      });
+
+  default_network.Send(
+      NetworkRequest("https://example.com").WithTag("read/layer-a"), nullptr,
+      nullptr);
+  default_network.Send(
+      NetworkRequest("https://example.com").WithTag("read/layer-b"), nullptr,
+      nullptr);
+  default_network.Send(NetworkRequest("https://example.com"), nullptr,
+                       nullptr);
+  ASSERT_EQ(callbacks.size(), 3u);
+
+  callbacks[0](NetworkResponse().WithStatus(200).WithBytesDownloaded(100));
+  callbacks[1](NetworkResponse().WithStatus(404).WithBytesDownloaded(10));
+  callbacks[2](NetworkResponse().WithStatus(200).WithBytesDownloaded(1));
+
+  const auto stats = default_network.GetTaggedStatistics();
+  ASSERT_EQ(stats.size(), 2u);
+
+  const auto& layer_a = stats.at("read/layer-a");
+  EXPECT_EQ(layer_a.total_requests, 1u);
+  EXPECT_EQ(layer_a.total_failed, 0u);
+  EXPECT_EQ(layer_a.bytes_downloaded, 100u);
+
+  const auto& layer_b = stats.at("read/layer-b");
+  EXPECT_EQ(layer_b.total_requests, 1u);
+  EXPECT_EQ(layer_b.total_failed, 1u);
+  EXPECT_EQ(layer_b.bytes_downloaded, 10u);
+
+  // The requests are still accounted in the current bucket.
+  EXPECT_EQ(default_network.GetStatistics(0).total_requests, 3u);
+}
+
+}  // namespace
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <http/NetworkScheduler.h>
+#include <mocks/NetworkMock.h>
+#include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/http/RequestPriorityScope.h>
+#include <olp/core/thread/TaskScheduler.h>
+
+namespace {
+
+using namespace olp::http;
+using testing::_;
+
+constexpr auto kWaitTimeout = std::chrono::milliseconds(5000);
+
+/// Records the requests sent by the scheduler and completes them on demand.
+class SentRequests {
+ public:
+  void Expect(NetworkMock& network) {
+    EXPECT_CALL(network, Send(_, _, _, _, _))
+        .WillRepeatedly([this](NetworkRequest request, Network::Payload,
+                               Network::Callback callback,
+                               Network::HeaderCallback,
+                               Network::DataCallback) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          urls_.push_back(request.GetUrl());
+          callbacks_.push_back(std::move(callback));
+          condition_.notify_all();
+          return SendOutcome(static_cast<RequestId>(urls_.size()));
+        });
+  }
+
+  bool WaitFor(size_t count,
+               std::chrono::milliseconds timeout = kWaitTimeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, timeout,
+                               [&] { return urls_.size() >= count; });
+  }
+
+  void Complete(size_t index, uint64_t bytes_downloaded = 0u) {
+    Network::Callback callback;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      callback = callbacks_[index];
+    }
+    callback(NetworkResponse()
+                 .WithStatus(HttpStatusCode::OK)
+                 .WithBytesDownloaded(bytes_downloaded));
+  }
+
+  std::vector<std::string> Urls() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return urls_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<std::string> urls_;
+  std::vector<Network::Callback> callbacks_;
+};
+
+NetworkRequest MakeRequest(const std::string& url, uint32_t priority) {
+  return NetworkRequest(url).WithPriority(priority);
+}
+
+TEST(NetworkSchedulerTest, PriorityOrder) {
+  auto network = std::make_shared<NetworkMock>();
+  SentRequests sent;
+  sent.Expect(*network);
+
+  NetworkScheduler scheduler(network, 1u, 0u, 0u);
+
+  ASSERT_TRUE(scheduler
+                  .Send(MakeRequest("first", olp::thread::NORMAL), nullptr,
+                        nullptr)
+                  .IsSuccessful());
+  ASSERT_TRUE(sent.WaitFor(1u));
+
+  scheduler.Send(MakeRequest("low", olp::thread::LOW), nullptr, nullptr);
+  scheduler.Send(MakeRequest("normal", olp::thread::NORMAL), nullptr, nullptr);
+  scheduler.Send(MakeRequest("high", olp::thread::HIGH), nullptr, nullptr);
+
+  for (size_t i = 0u; i < 3u; ++i) {
+    sent.Complete(i);
+    ASSERT_TRUE(sent.WaitFor(i + 2u));
+  }
+
+  EXPECT_EQ(std::vector<std::string>({"first", "high", "normal", "low"}),
+            sent.Urls());
+}
+
+TEST(NetworkSchedulerTest, LowPriorityLimit) {
+  auto network = std::make_shared<NetworkMock>();
+  SentRequests sent;
+  sent.Expect(*network);
+
+  NetworkScheduler scheduler(network, 3u, 1u, 0u);
+
+  scheduler.Send(MakeRequest("low1", olp::thread::LOW), nullptr, nullptr);
+  scheduler.Send(MakeRequest("low2", olp::thread::LOW), nullptr, nullptr);
+  ASSERT_TRUE(sent.WaitFor(1u));
+
+  // The interactive request is not blocked by the queued prefetch.
+  scheduler.Send(MakeRequest("normal", olp::thread::NORMAL), nullptr, nullptr);
+  ASSERT_TRUE(sent.WaitFor(2u));
+  EXPECT_EQ(std::vector<std::string>({"low1", "normal"}), sent.Urls());
+
+  sent.Complete(0u);
+  ASSERT_TRUE(sent.WaitFor(3u));
+  EXPECT_EQ("low2", sent.Urls().back());
+}
+
+TEST(NetworkSchedulerTest, HostLimit) {
+  auto network = std::make_shared<NetworkMock>();
+  SentRequests sent;
+  sent.Expect(*network);
+
+  NetworkScheduler scheduler(network, 3u, 0u, 1u);
+
+  scheduler.Send(MakeRequest("https://blob.com/1", olp::thread::NORMAL),
+                 nullptr, nullptr);
+  ASSERT_TRUE(sent.WaitFor(1u));
+  scheduler.Send(MakeRequest("https://blob.com/2", olp::thread::NORMAL),
+                 nullptr, nullptr);
+  scheduler.Send(MakeRequest("https://blob.com/3", olp::thread::HIGH), nullptr,
+                 nullptr);
+
+  // The request to another host is not blocked by the queued blob requests.
+  scheduler.Send(MakeRequest("https://metadata.com/1", olp::thread::NORMAL),
+                 nullptr, nullptr);
+  ASSERT_TRUE(sent.WaitFor(2u));
+  EXPECT_FALSE(sent.WaitFor(3u, std::chrono::milliseconds(100)));
+
+  // The waiting requests to the host are sent in the priority order.
+  sent.Complete(0u);
+  ASSERT_TRUE(sent.WaitFor(3u));
+  EXPECT_EQ(std::vector<std::string>({"https://blob.com/1",
+                                      "https://metadata.com/1",
+                                      "https://blob.com/3"}),
+            sent.Urls());
+}
+
+TEST(NetworkSchedulerTest, LowPriorityBatching) {
+  auto network = std::make_shared<NetworkMock>();
+  SentRequests sent;
+  sent.Expect(*network);
+
+  NetworkScheduler scheduler(network, 5u, 0u, 0u,
+                             std::chrono::milliseconds(300));
+
+  {
+    SCOPED_TRACE("Held back until the interval passes");
+
+    scheduler.Send(MakeRequest("low1", olp::thread::LOW), nullptr, nullptr);
+    scheduler.Send(MakeRequest("low2", olp::thread::LOW), nullptr, nullptr);
+    EXPECT_FALSE(sent.WaitFor(1u, std::chrono::milliseconds(100)));
+
+    ASSERT_TRUE(sent.WaitFor(2u));
+    EXPECT_EQ(std::vector<std::string>({"low1", "low2"}), sent.Urls());
+    sent.Complete(0u);
+    sent.Complete(1u);
+  }
+
+  {
+    SCOPED_TRACE("Sent along with a request of a higher priority");
+
+    scheduler.Send(MakeRequest("low3", olp::thread::LOW), nullptr, nullptr);
+    EXPECT_FALSE(sent.WaitFor(3u, std::chrono::milliseconds(100)));
+
+    scheduler.Send(MakeRequest("normal", olp::thread::NORMAL), nullptr,
+                   nullptr);
+    ASSERT_TRUE(sent.WaitFor(4u, std::chrono::milliseconds(100)));
+    EXPECT_EQ(std::vector<std::string>({"low1", "low2", "normal", "low3"}),
+              sent.Urls());
+  }
+}
+
+TEST(NetworkSchedulerTest, BandwidthLimit) {
+  auto network = std::make_shared<NetworkMock>();
+  SentRequests sent;
+  sent.Expect(*network);
+
+  NetworkScheduler scheduler(network, 5u, 0u, 0u);
+  scheduler.SetBandwidthLimit(1u, 1000u);
+
+  scheduler.SetCurrentBucket(1u);
+  scheduler.Send(MakeRequest("limited1", olp::thread::NORMAL), nullptr,
+                 nullptr);
+  ASSERT_TRUE(sent.WaitFor(1u));
+
+  // The transferred bytes exceed the tokens of the bucket by half a second.
+  const auto completed_at = std::chrono::steady_clock::now();
+  sent.Complete(0u, 1500u);
+
+  {
+    SCOPED_TRACE("The requests of the bucket wait until it is refilled");
+
+    scheduler.Send(MakeRequest("limited2", olp::thread::NORMAL), nullptr,
+                   nullptr);
+    EXPECT_FALSE(sent.WaitFor(2u, std::chrono::milliseconds(100)));
+  }
+
+  {
+    SCOPED_TRACE("The requests of the other buckets are not limited");
+
+    scheduler.SetCurrentBucket(0u);
+    scheduler.Send(MakeRequest("unlimited", olp::thread::NORMAL), nullptr,
+                   nullptr);
+    ASSERT_TRUE(sent.WaitFor(2u));
+    EXPECT_EQ("unlimited", sent.Urls().back());
+  }
+
+  {
+    SCOPED_TRACE("The request is sent once the bucket is refilled");
+
+    ASSERT_TRUE(sent.WaitFor(3u));
+    EXPECT_EQ("limited2", sent.Urls().back());
+    EXPECT_GE(std::chrono::steady_clock::now() - completed_at,
+              std::chrono::milliseconds(450));
+    sent.Complete(2u, 2000u);
+  }
+
+  {
+    SCOPED_TRACE("Removing the limit sends the waiting requests");
+
+    scheduler.SetCurrentBucket(1u);
+    scheduler.Send(MakeRequest("limited3", olp::thread::NORMAL), nullptr,
+                   nullptr);
+    EXPECT_FALSE(sent.WaitFor(4u, std::chrono::milliseconds(100)));
+
+    scheduler.SetBandwidthLimit(1u, 0u);
+    ASSERT_TRUE(sent.WaitFor(4u, std::chrono::milliseconds(100)));
+    EXPECT_EQ("limited3", sent.Urls().back());
+  }
+}
+
+TEST(NetworkSchedulerTest, PromoteQueued) {
+  auto network = std::make_shared<NetworkMock>();
+  SentRequests sent;
+  sent.Expect(*network);
+
+  auto scheduler = std::make_shared<NetworkScheduler>(network, 1u, 0u, 0u);
+
+  scheduler->Send(MakeRequest("first", olp::thread::NORMAL), nullptr, nullptr);
+  ASSERT_TRUE(sent.WaitFor(1u));
+
+  auto outcome =
+      scheduler->Send(MakeRequest("low", olp::thread::LOW), nullptr, nullptr);
+  ASSERT_TRUE(outcome.IsSuccessful());
+  scheduler->Send(MakeRequest("normal", olp::thread::NORMAL), nullptr,
+                  nullptr);
+
+  // The request waiting for the prefetch raises its priority.
+  RequestPriorityHandle handle(olp::thread::LOW);
+  const auto key =
+      handle.AddRequest(scheduler, outcome.GetRequestId(), olp::thread::LOW);
+  handle.Promote(olp::thread::HIGH);
+  EXPECT_EQ(olp::thread::HIGH, handle.GetPriority());
+
+  // The lower priorities are ignored.
+  handle.Promote(olp::thread::NORMAL);
+  EXPECT_EQ(olp::thread::HIGH, handle.GetPriority());
+  handle.RemoveRequest(key);
+
+  sent.Complete(0u);
+  ASSERT_TRUE(sent.WaitFor(2u));
+  sent.Complete(1u);
+  ASSERT_TRUE(sent.WaitFor(3u));
+  EXPECT_EQ(std::vector<std::string>({"first", "low", "normal"}), sent.Urls());
+}
+
+TEST(NetworkSchedulerTest, CancelQueued) {
+  auto network = std::make_shared<NetworkMock>();
+  SentRequests sent;
+  sent.Expect(*network);
+
+  NetworkScheduler scheduler(network, 1u, 0u, 0u);
+
+  scheduler.Send(MakeRequest("first", olp::thread::NORMAL), nullptr, nullptr);
+  ASSERT_TRUE(sent.WaitFor(1u));
+
+  int status = 0;
+  auto outcome = scheduler.Send(
+      MakeRequest("cancelled", olp::thread::NORMAL), nullptr,
+      [&](NetworkResponse response) { status = response.GetStatus(); });
+  ASSERT_TRUE(outcome.IsSuccessful());
+
+  scheduler.Cancel(outcome.GetRequestId());
+  EXPECT_EQ(static_cast<int>(ErrorCode::CANCELLED_ERROR), status);
+
+  sent.Complete(0u);
+  EXPECT_FALSE(sent.WaitFor(2u, std::chrono::milliseconds(100)));
+}
+
+}  // namespace
@@ -19,7 +19,10 @@
 
 #include <gtest/gtest.h>
 #include <olp/core/http/NetworkUtils.h>
+#include <cstdio>
+#include <fstream>
 #include <limits>
+#include <string>
 
 namespace {
 
@@ -145,4 +148,79 @@ TEST(NetworkUtilsTest, HttpErrorToString) {
   EXPECT_EQ("HTTP Version Not Supported", HttpErrorToString(505));
 }
 
+TEST(NetworkUtilsTest, GetHost) {
+  EXPECT_EQ("example.com", NetworkUtils::GetHost("https://example.com"));
+  EXPECT_EQ("example.com:8080",
+            NetworkUtils::GetHost("http://example.com:8080/path?a=b"));
+  EXPECT_EQ("example.com", NetworkUtils::GetHost("example.com/path"));
+  EXPECT_EQ("", NetworkUtils::GetHost(""));
+}
+
+TEST(NetworkUtilsTest, ReadBody) {
+  {
+    SCOPED_TRACE("Body without body source");
+    auto data = std::make_shared<std::vector<std::uint8_t>>(3u, 'a');
+    auto request = NetworkRequest("url").WithBody(data);
+
+    NetworkRequest::RequestBodyType body;
+    EXPECT_TRUE(NetworkUtils::ReadBody(request, body));
+    EXPECT_EQ(data, body);
+  }
+
+  {
+    SCOPED_TRACE("Body file");
+    const std::string path = "network_utils_test_body";
+    const std::string content(100u * 1024u + 7u, 'b');
+    std::ofstream(path, std::ios::binary) << content;
+
+    auto request = NetworkRequest("url").WithBodyFile(path);
+    EXPECT_EQ(static_cast<std::int64_t>(content.size()),
+              request.GetBodySourceSize());
+
+    NetworkRequest::RequestBodyType body;
+    EXPECT_TRUE(NetworkUtils::ReadBody(request, body));
+    ASSERT_TRUE(body);
+    EXPECT_EQ(content, std::string(body->begin(), body->end()));
+
+    // Reads at any offset, as needed to resend the body.
+    std::uint8_t buffer[4];
+    EXPECT_EQ(4, request.GetBodySource()(content.size() - 10u, buffer, 4u));
+    EXPECT_EQ(0, request.GetBodySource()(content.size(), buffer, 4u));
+    std::remove(path.c_str());
+  }
+
+  {
+    SCOPED_TRACE("Missing body file");
+    auto request = NetworkRequest("url").WithBodyFile("missing_body_file");
+    EXPECT_EQ(NetworkRequest::kUnknownBodySize, request.GetBodySourceSize());
+
+    NetworkRequest::RequestBodyType body;
+    EXPECT_FALSE(NetworkUtils::ReadBody(request, body));
+    EXPECT_FALSE(body);
+  }
+}
+
+TEST(NetworkUtilsTest, BufferBodySource) {
+  {
+    SCOPED_TRACE("Body file");
+    const std::string path = "network_utils_test_buffer_body";
+    const std::string content(10u, 'c');
+    std::ofstream(path, std::ios::binary) << content;
+
+    auto request = NetworkRequest("url").WithBodyFile(path);
+    EXPECT_TRUE(NetworkUtils::BufferBodySource(request));
+    EXPECT_FALSE(request.GetBodySource());
+    ASSERT_TRUE(request.GetBody());
+    EXPECT_EQ(content, std::string(request.GetBody()->begin(),
+                                   request.GetBody()->end()));
+    std::remove(path.c_str());
+  }
+
+  {
+    SCOPED_TRACE("Missing body file");
+    auto request = NetworkRequest("url").WithBodyFile("missing_body_file");
+    EXPECT_FALSE(NetworkUtils::BufferBodySource(request));
+  }
+}
+
 }  // namespace
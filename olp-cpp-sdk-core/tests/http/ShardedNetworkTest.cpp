@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <http/ShardedNetwork.h>
+#include <mocks/NetworkMock.h>
+#include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/http/NetworkUtils.h>
+
+namespace {
+
+using namespace olp::http;
+using testing::_;
+
+constexpr RequestId kShardRequestId = 42;
+
+NetworkRequest MakeRequest(const std::string& url) {
+  return NetworkRequest(url).WithVerb(NetworkRequest::HttpVerb::GET);
+}
+
+class PreResolveNetworkMock : public NetworkMock {
+ public:
+  void PreResolve(const std::vector<std::string>& urls) override {
+    resolved_urls.insert(resolved_urls.end(), urls.begin(), urls.end());
+  }
+
+  std::vector<std::string> resolved_urls;
+};
+
+void ExpectSend(NetworkMock& shard, int times,
+                std::vector<Network::Callback>* callbacks = nullptr) {
+  EXPECT_CALL(shard, Send(_, _, _, _, _))
+      .Times(times)
+      .WillRepeatedly(
+          [=](NetworkRequest, Network::Payload, Network::Callback callback,
+              Network::HeaderCallback, Network::DataCallback) {
+            if (callbacks) {
+              callbacks->push_back(std::move(callback));
+            }
+            return SendOutcome(kShardRequestId);
+          });
+}
+
+TEST(ShardedNetworkTest, RoundRobin) {
+  auto first = std::make_shared<NetworkMock>();
+  auto second = std::make_shared<NetworkMock>();
+  std::vector<Network::Callback> callbacks;
+  ExpectSend(*first, 2, &callbacks);
+  ExpectSend(*second, 2, &callbacks);
+
+  ShardedNetwork network({first, second}, NetworkShardingPolicy::kRoundRobin);
+
+  std::vector<RequestId> ids;
+  std::vector<RequestId> completed_ids;
+  for (int i = 0; i < 4; ++i) {
+    auto outcome = network.Send(
+        MakeRequest("https://example.com"), nullptr,
+        [&](NetworkResponse response) {
+          completed_ids.push_back(response.GetRequestId());
+        });
+    ASSERT_TRUE(outcome.IsSuccessful());
+    ids.push_back(outcome.GetRequestId());
+  }
+
+  // The shards use the same ids, but the outer ids are unique.
+  EXPECT_NE(ids[0], ids[1]);
+  EXPECT_NE(ids[1], ids[2]);
+
+  ASSERT_EQ(4u, callbacks.size());
+  for (auto& callback : callbacks) {
+    callback(NetworkResponse()
+                 .WithStatus(HttpStatusCode::OK)
+                 .WithRequestId(kShardRequestId));
+  }
+  EXPECT_EQ(4u, completed_ids.size());
+  for (const auto id : ids) {
+    EXPECT_NE(std::find(completed_ids.begin(), completed_ids.end(), id),
+              completed_ids.end());
+  }
+}
+
+TEST(ShardedNetworkTest, ByHost) {
+  auto first = std::make_shared<NetworkMock>();
+  auto second = std::make_shared<NetworkMock>();
+  std::vector<Network::Callback> first_callbacks;
+  std::vector<Network::Callback> second_callbacks;
+  EXPECT_CALL(*first, Send(_, _, _, _, _))
+      .WillRepeatedly(
+          [&](NetworkRequest, Network::Payload, Network::Callback callback,
+              Network::HeaderCallback, Network::DataCallback) {
+            first_callbacks.push_back(std::move(callback));
+            return SendOutcome(kShardRequestId);
+          });
+  EXPECT_CALL(*second, Send(_, _, _, _, _))
+      .WillRepeatedly(
+          [&](NetworkRequest, Network::Payload, Network::Callback callback,
+              Network::HeaderCallback, Network::DataCallback) {
+            second_callbacks.push_back(std::move(callback));
+            return SendOutcome(kShardRequestId);
+          });
+
+  ShardedNetwork network({first, second}, NetworkShardingPolicy::kHost);
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(network
+                    .Send(MakeRequest("https://example.com/path" +
+                                      std::to_string(i)),
+                          nullptr, nullptr)
+                    .IsSuccessful());
+  }
+
+  // All requests to the same host go to the same shard.
+  EXPECT_TRUE(first_callbacks.size() == 3u || second_callbacks.size() == 3u);
+}
+
+TEST(ShardedNetworkTest, OverloadFallback) {
+  auto first = std::make_shared<NetworkMock>();
+  auto second = std::make_shared<NetworkMock>();
+  EXPECT_CALL(*first, Send(_, _, _, _, _))
+      .WillRepeatedly(
+          [](NetworkRequest, Network::Payload, Network::Callback,
+             Network::HeaderCallback, Network::DataCallback) {
+            return SendOutcome(ErrorCode::NETWORK_OVERLOAD_ERROR);
+          });
+  ExpectSend(*second, 2);
+
+  ShardedNetwork network({first, second}, NetworkShardingPolicy::kRoundRobin);
+
+  {
+    SCOPED_TRACE("Overloaded shard is skipped");
+    EXPECT_TRUE(
+        network.Send(MakeRequest("https://example.com"), nullptr, nullptr)
+            .IsSuccessful());
+    EXPECT_TRUE(
+        network.Send(MakeRequest("https://example.com"), nullptr, nullptr)
+            .IsSuccessful());
+  }
+
+  {
+    SCOPED_TRACE("Other errors are returned");
+    EXPECT_CALL(*second, Send(_, _, _, _, _))
+        .WillRepeatedly(
+            [](NetworkRequest, Network::Payload, Network::Callback,
+               Network::HeaderCallback, Network::DataCallback) {
+              return SendOutcome(ErrorCode::INVALID_URL_ERROR);
+            });
+    auto outcome =
+        network.Send(MakeRequest("https://example.com"), nullptr, nullptr);
+    EXPECT_EQ(ErrorCode::INVALID_URL_ERROR, outcome.GetErrorCode());
+  }
+}
+
+TEST(ShardedNetworkTest, Cancel) {
+  auto shard = std::make_shared<NetworkMock>();
+  std::vector<Network::Callback> callbacks;
+  ExpectSend(*shard, 1, &callbacks);
+  EXPECT_CALL(*shard, Cancel(kShardRequestId)).Times(1);
+
+  ShardedNetwork network({shard}, NetworkShardingPolicy::kRoundRobin);
+
+  auto outcome =
+      network.Send(MakeRequest("https://example.com"), nullptr, nullptr);
+  ASSERT_TRUE(outcome.IsSuccessful());
+  network.Cancel(outcome.GetRequestId());
+
+  // The completed requests are not cancelled again.
+  ASSERT_EQ(1u, callbacks.size());
+  callbacks.front()(NetworkResponse().WithRequestId(kShardRequestId));
+  network.Cancel(outcome.GetRequestId());
+}
+
+TEST(ShardedNetworkTest, PreResolve) {
+  const std::vector<std::string> urls = {"https://first.example.com/path",
+                                         "https://second.example.com/path"};
+
+  {
+    SCOPED_TRACE("Round robin resolves on all shards");
+    auto first = std::make_shared<PreResolveNetworkMock>();
+    auto second = std::make_shared<PreResolveNetworkMock>();
+    ShardedNetwork network({first, second},
+                           NetworkShardingPolicy::kRoundRobin);
+
+    network.PreResolve(urls);
+    EXPECT_EQ(urls, first->resolved_urls);
+    EXPECT_EQ(urls, second->resolved_urls);
+  }
+
+  {
+    SCOPED_TRACE("By host resolves on the host shard");
+    auto first = std::make_shared<PreResolveNetworkMock>();
+    auto second = std::make_shared<PreResolveNetworkMock>();
+    ShardedNetwork network({first, second}, NetworkShardingPolicy::kHost);
+
+    network.PreResolve(urls);
+    EXPECT_EQ(urls.size(),
+              first->resolved_urls.size() + second->resolved_urls.size());
+    for (const auto& url : urls) {
+      const auto& shard =
+          std::hash<std::string>()(NetworkUtils::GetHost(url)) % 2u == 0u
+              ? first
+              : second;
+      EXPECT_NE(std::find(shard->resolved_urls.begin(),
+                          shard->resolved_urls.end(), url),
+                shard->resolved_urls.end());
+    }
+  }
+}
+
+}  // namespace
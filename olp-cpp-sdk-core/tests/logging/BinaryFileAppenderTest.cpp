@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <olp/core/logging/BinaryFileAppender.h>
+#include <olp/core/logging/Configuration.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/porting/platform.h>
+
+#ifdef PORTING_PLATFORM_WINDOWS
+#include <stdio.h>
+#define unlink _unlink
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+namespace logging = olp::logging;
+
+struct DecodedMessage {
+  logging::Level level;
+  std::string tag;
+  std::string message;
+  std::string file;
+  unsigned int line;
+  std::string function;
+};
+
+std::vector<DecodedMessage> Decode(const std::string& file_name) {
+  std::vector<DecodedMessage> messages;
+  EXPECT_TRUE(logging::BinaryFileAppender::decode(
+      file_name, [&](const logging::LogMessage& message) {
+        messages.push_back({message.level, message.tag, message.message,
+                            message.file, message.line, message.function});
+      }));
+  return messages;
+}
+
+TEST(BinaryFileAppenderTest, Default) {
+  {
+    SCOPED_TRACE("Create appender");
+    auto appender =
+        std::make_shared<logging::BinaryFileAppender>("test.bin", 64u);
+    ASSERT_TRUE(appender->isValid());
+    EXPECT_EQ("test.bin", appender->getFileName());
+
+    logging::Configuration configuration{};
+    configuration.addAppender(appender);
+    logging::Log::configure(configuration);
+    logging::Log::setLevel(logging::Level::Info);
+
+    // The file grows beyond its initial capacity.
+    for (int i = 0; i < 100; ++i) {
+      OLP_SDK_LOG_INFO("test", "test " << i);
+    }
+    OLP_SDK_LOG_WARNING(std::string("other"), "");
+
+    logging::Log::configure(logging::Configuration::createDefault());
+  }
+
+  {
+    SCOPED_TRACE("Check the log file content");
+    const auto messages = Decode("test.bin");
+    ASSERT_EQ(101u, messages.size());
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(logging::Level::Info, messages[i].level);
+      EXPECT_EQ("test", messages[i].tag);
+      EXPECT_EQ("test " + std::to_string(i), messages[i].message);
+      EXPECT_NE(std::string::npos,
+                messages[i].file.rfind("BinaryFileAppenderTest.cpp"));
+      EXPECT_LT(0u, messages[i].line);
+      EXPECT_FALSE(messages[i].function.empty());
+    }
+
+    EXPECT_EQ(logging::Level::Warning, messages.back().level);
+    EXPECT_EQ("other", messages.back().tag);
+    EXPECT_EQ("", messages.back().message);
+  }
+
+  ASSERT_EQ(0, unlink("test.bin"));
+}
+
+TEST(BinaryFileAppenderTest, InvalidFile) {
+  EXPECT_FALSE(logging::BinaryFileAppender::decode(
+      "missing.bin", [](const logging::LogMessage&) {}));
+
+  {
+    std::ofstream stream("test.txt");
+    stream << "Not a binary log";
+  }
+  EXPECT_FALSE(logging::BinaryFileAppender::decode(
+      "test.txt", [](const logging::LogMessage&) {}));
+  ASSERT_EQ(0, unlink("test.txt"));
+}
+
+}  // namespace
@@ -163,4 +163,92 @@ TEST(FileAppenderTest, Append) {
   }
 }
 
+std::vector<std::string> ReadLines(const std::string& file_name) {
+  std::ifstream stream(file_name);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(stream, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+bool FileExists(const std::string& file_name) {
+  return std::ifstream(file_name).good();
+}
+
+TEST(FileAppenderTest, Rotation) {
+  logging::MessageFormatter formatter({logging::MessageFormatter::Element(
+      logging::MessageFormatter::ElementType::Message)});
+
+  std::vector<std::string> compressed;
+  {
+    auto appender =
+        std::make_shared<logging::FileAppender>("test.txt", false, formatter);
+    ASSERT_TRUE(appender->isValid());
+
+    // Every file holds two messages of 7 bytes.
+    appender->setMaxFileSize(14).setMaxBackupFiles(2).setCompressor(
+        [&](const std::string& from, const std::string& to) {
+          compressed.push_back(from);
+          std::ofstream(to) << ReadLines(from).front();
+          return true;
+        },
+        ".z");
+    EXPECT_EQ(14u, appender->getMaxFileSize());
+    EXPECT_EQ(2u, appender->getMaxBackupFiles());
+
+    logging::Configuration configuration{};
+    configuration.addAppender(appender);
+    logging::Log::configure(configuration);
+    logging::Log::setLevel(logging::Level::Info);
+
+    for (int i = 0; i < 8; ++i) {
+      OLP_SDK_LOG_INFO("test", "test " << i);
+    }
+
+    logging::Log::configure(logging::Configuration::createDefault());
+  }
+
+  EXPECT_EQ(3u, compressed.size());
+  EXPECT_EQ(std::vector<std::string>({"test 6", "test 7"}),
+            ReadLines("test.txt"));
+  EXPECT_FALSE(FileExists("test.txt.1"));
+  EXPECT_EQ(std::vector<std::string>({"test 4"}), ReadLines("test.txt.1.z"));
+  EXPECT_EQ(std::vector<std::string>({"test 2"}), ReadLines("test.txt.2.z"));
+  EXPECT_FALSE(FileExists("test.txt.3.z"));
+
+  EXPECT_EQ(0, unlink("test.txt"));
+  EXPECT_EQ(0, unlink("test.txt.1.z"));
+  EXPECT_EQ(0, unlink("test.txt.2.z"));
+}
+
+TEST(FileAppenderTest, Buffer) {
+  logging::MessageFormatter formatter({logging::MessageFormatter::Element(
+      logging::MessageFormatter::ElementType::Message)});
+
+  {
+    logging::FileAppender appender("test.txt", false, formatter);
+    appender.setBufferSize(1024).setFlushInterval(std::chrono::hours(1));
+    EXPECT_EQ(1024u, appender.getBufferSize());
+    EXPECT_EQ(std::chrono::hours(1), appender.getFlushInterval());
+
+    logging::LogMessage message;
+    message.message = "test 1";
+    appender.append(message);
+    EXPECT_TRUE(ReadLines("test.txt").empty());
+
+    appender.flush();
+    EXPECT_EQ(std::vector<std::string>({"test 1"}), ReadLines("test.txt"));
+
+    message.message = "test 2";
+    appender.append(message);
+  }
+
+  // The buffered messages are written when the appender is destroyed.
+  EXPECT_EQ(std::vector<std::string>({"test 1", "test 2"}),
+            ReadLines("test.txt"));
+  EXPECT_EQ(0, unlink("test.txt"));
+}
+
 }  // namespace
@@ -18,9 +18,12 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <future>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <olp/core/logging/Configuration.h>
@@ -80,6 +83,56 @@ TEST(LogTest, Levels) {
       olp::logging::Log::isEnabled(olp::logging::Level::Debug, "test1"));
 }
 
+TEST(LogTest, RegisteredTagLevels) {
+  using olp::logging::Level;
+  using olp::logging::Log;
+
+  Log::setLevel(Level::Info);
+  Log::setLevel(Level::Warning, "registered");
+
+  // The first calls register the tags, the later ones use the registry.
+  const char* tag = "registered";
+  EXPECT_FALSE(Log::isEnabled(Level::Info, tag));
+  EXPECT_TRUE(Log::isEnabled(Level::Warning, tag));
+  EXPECT_TRUE(Log::isEnabled(Level::Info, "other"));
+  EXPECT_FALSE(Log::isEnabled(Level::Debug, "other"));
+
+  {
+    SCOPED_TRACE("The levels set later apply to the registered tags");
+
+    Log::setLevel(Level::Debug, tag);
+    EXPECT_TRUE(Log::isEnabled(Level::Debug, tag));
+    Log::setLevel(Level::Error, "other");
+    EXPECT_FALSE(Log::isEnabled(Level::Warning, "other"));
+    Log::clearLevel(tag);
+    EXPECT_FALSE(Log::isEnabled(Level::Debug, tag));
+    EXPECT_TRUE(Log::isEnabled(Level::Info, tag));
+  }
+
+  {
+    SCOPED_TRACE("A reused tag buffer is not mistaken for the old tag");
+
+    char buffer[16] = "other";
+    EXPECT_FALSE(Log::isEnabled(Level::Warning, buffer));
+    std::strcpy(buffer, "registered");
+    Log::setLevel(Level::Fatal, "registered");
+    EXPECT_FALSE(Log::isEnabled(Level::Error, buffer));
+    std::strcpy(buffer, "unknown");
+    EXPECT_TRUE(Log::isEnabled(Level::Info, buffer));
+  }
+
+  {
+    SCOPED_TRACE("The long tags are looked up with the lock");
+
+    const std::string long_tag(100u, 't');
+    Log::setLevel(Level::Error, long_tag);
+    EXPECT_FALSE(Log::isEnabled(Level::Warning, long_tag.c_str()));
+    EXPECT_TRUE(Log::isEnabled(Level::Error, long_tag.c_str()));
+  }
+
+  Log::clearLevels();
+}
+
 TEST(LogTest, DifferentLevelsForDifferentAppenders) {
   auto appender1 = std::make_shared<testing::MockAppender>();
   auto appender2 = std::make_shared<testing::MockAppender>();
@@ -667,4 +720,115 @@ TEST(LogTest, ReConfigure) {
             appender2->messages_[0].function_);
 }
 
+TEST(LogTest, Async) {
+  auto appender = std::make_shared<testing::MockAppender>();
+  olp::logging::Configuration configuration;
+  configuration.addAppender(appender).setAsync(16);
+  ASSERT_TRUE(olp::logging::Log::configure(configuration));
+  olp::logging::Log::setLevel(olp::logging::Level::Trace);
+
+  for (int i = 0; i < 100; ++i) {
+    OLP_SDK_LOG_INFO("async", "Message " << i);
+  }
+  olp::logging::Log::flush();
+
+  // The messages that did not fit into the queue are dropped, the others are
+  // written in order.
+  ASSERT_FALSE(appender->messages_.empty());
+  EXPECT_EQ("async", appender->messages_[0].tag_);
+  EXPECT_EQ("Message 0", appender->messages_[0].message_);
+  EXPECT_NE(std::string::npos,
+            appender->messages_[0].file_.rfind("LogTest.cpp"));
+
+  configuration.clear().addAppender(appender).setAsync(
+      16, olp::logging::Configuration::OverflowPolicy::Block);
+  ASSERT_TRUE(olp::logging::Log::configure(configuration));
+  appender->messages_.clear();
+
+  for (int i = 0; i < 100; ++i) {
+    OLP_SDK_LOG_INFO("async", "Message " << i);
+  }
+  olp::logging::Log::flush();
+
+  ASSERT_EQ(100U, appender->messages_.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ("Message " + std::to_string(i),
+              appender->messages_[i].message_);
+  }
+
+  configuration.setAsync(0);
+  EXPECT_TRUE(olp::logging::Log::configure(configuration));
+}
+
+TEST(LogTest, AsyncFlushWhileStopping) {
+  auto appender = std::make_shared<testing::MockAppender>();
+  olp::logging::Configuration configuration;
+  configuration.addAppender(appender).setAsync(16);
+  olp::logging::Log::setLevel(olp::logging::Level::Trace);
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(olp::logging::Log::configure(configuration));
+    std::thread flushing([] {
+      for (int j = 0; j < 100; ++j) {
+        OLP_SDK_LOG_INFO("async", "Message " << j);
+        olp::logging::Log::flush();
+      }
+    });
+
+    // Stops the writer while the other thread flushes, the flush must not
+    // wait forever.
+    configuration.setAsync(0);
+    EXPECT_TRUE(olp::logging::Log::configure(configuration));
+    flushing.join();
+    configuration.setAsync(16);
+  }
+
+  configuration.setAsync(0);
+  EXPECT_TRUE(olp::logging::Log::configure(configuration));
+}
+
+TEST(LogTest, AsyncDropped) {
+  // Blocks the writing thread on the first message.
+  class BlockingAppender : public testing::MockAppender {
+   public:
+    olp::logging::IAppender& append(
+        const olp::logging::LogMessage& message) override {
+      if (messages_.empty()) {
+        entered_.set_value();
+        released_.get_future().wait();
+      }
+      return MockAppender::append(message);
+    }
+
+    std::promise<void> entered_;
+    std::promise<void> released_;
+  };
+
+  auto appender = std::make_shared<BlockingAppender>();
+  auto entered = appender->entered_.get_future();
+  olp::logging::Configuration configuration;
+  configuration.addAppender(appender).setAsync(2);
+  ASSERT_TRUE(olp::logging::Log::configure(configuration));
+  olp::logging::Log::setLevel(olp::logging::Level::Trace);
+
+  OLP_SDK_LOG_INFO("async", "Message 0");
+  entered.wait();
+  for (int i = 1; i < 10; ++i) {
+    OLP_SDK_LOG_INFO("async", "Message " << i);
+  }
+  appender->released_.set_value();
+  olp::logging::Log::flush();
+
+  ASSERT_EQ(4U, appender->messages_.size());
+  EXPECT_EQ("Message 0", appender->messages_[0].message_);
+  EXPECT_EQ("Message 1", appender->messages_[1].message_);
+  EXPECT_EQ("Message 2", appender->messages_[2].message_);
+  EXPECT_EQ(olp::logging::Level::Warning, appender->messages_[3].level_);
+  EXPECT_EQ("7 log messages were dropped, the logging queue was full",
+            appender->messages_[3].message_);
+
+  configuration.setAsync(0);
+  EXPECT_TRUE(olp::logging::Log::configure(configuration));
+}
+
 }  // namespace
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#ifdef OLP_SDK_LOG_MIN_LEVEL
+#undef OLP_SDK_LOG_MIN_LEVEL
+#endif
+#define OLP_SDK_LOG_MIN_LEVEL 3  // compile in the warnings and above
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include <olp/core/logging/Configuration.h>
+#include <olp/core/logging/Log.h>
+#include "MockAppender.h"
+
+namespace {
+
+using namespace olp::logging;
+using namespace testing;
+
+std::string Evaluated(int& count, const char* message) {
+  ++count;
+  return message;
+}
+
+TEST(MinLevelLoggingTest, LevelsBelowMinimumRemoved) {
+  static_assert(!OLP_SDK_LOG_IS_COMPILED_IN(Level::Info),
+                "Info should be removed");
+  static_assert(OLP_SDK_LOG_IS_COMPILED_IN(Level::Warning),
+                "Warning should be kept");
+
+  auto appender = std::make_shared<MockAppender>();
+  Configuration configuration;
+  configuration.addAppender(appender);
+  EXPECT_TRUE(Log::configure(configuration));
+  Log::setLevel(Level::Trace);
+
+  int evaluated = 0;
+  OLP_SDK_LOG_TRACE("trace", Evaluated(evaluated, "Trace message"));
+  OLP_SDK_LOG_DEBUG("debug", Evaluated(evaluated, "Debug message"));
+  OLP_SDK_LOG_INFO("info", Evaluated(evaluated, "Info message"));
+  OLP_SDK_LOG_INFO_F("info", "%s", Evaluated(evaluated, "Info").c_str());
+  EXPECT_EQ(0, evaluated);
+  EXPECT_TRUE(appender->messages_.empty());
+
+  OLP_SDK_LOG_WARNING("warning", Evaluated(evaluated, "Warning message"));
+  OLP_SDK_LOG_ERROR_F("error", "%s", Evaluated(evaluated, "Error").c_str());
+  EXPECT_EQ(2, evaluated);
+
+  // Log levels insuppressible by the minimum level
+  OLP_SDK_LOG_CRITICAL_INFO("info", "Critical info message");
+
+  ASSERT_EQ(3U, appender->messages_.size());
+  EXPECT_EQ("Warning message", appender->messages_[0].message_);
+  EXPECT_EQ("Error", appender->messages_[1].message_);
+  EXPECT_EQ("Critical info message", appender->messages_[2].message_);
+}
+
+TEST(MinLevelLoggingTest, RuntimeLevels) {
+  Log::clearLevels();
+  Log::setLevel(Level::Error);
+  EXPECT_FALSE(Log::isEnabled(Level::Warning));
+  EXPECT_FALSE(Log::isEnabled(Level::Warning, "tag"));
+  EXPECT_TRUE(Log::isEnabled(Level::Error, "tag"));
+
+  Log::setLevel(Level::Info, "tag");
+  EXPECT_TRUE(Log::isEnabled(Level::Warning, "tag"));
+  EXPECT_FALSE(Log::isEnabled(Level::Warning, "other"));
+  EXPECT_FALSE(Log::isEnabled(Level::Debug, "tag"));
+
+  Log::clearLevel("tag");
+  EXPECT_FALSE(Log::isEnabled(Level::Warning, "tag"));
+
+  Log::setLevel(Level::Off);
+  EXPECT_FALSE(Log::isEnabled(Level::Fatal));
+  EXPECT_FALSE(Log::isEnabled(Level::Off, "tag"));
+}
+
+}  // namespace
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <olp/core/thread/LockFreeSyncQueue.h>
+
+namespace {
+using SharedQueueType = std::shared_ptr<std::string>;
+using LockFreeQueueShared = olp::thread::LockFreeSyncQueue<SharedQueueType>;
+
+TEST(LockFreeSyncQueueTest, PushAndPull) {
+  LockFreeQueueShared queue;
+  EXPECT_TRUE(queue.Empty());
+
+  auto first = std::make_shared<std::string>("first");
+  queue.Push(std::move(first));
+  EXPECT_FALSE(first) << "string should be moved";
+
+  const auto second = std::make_shared<std::string>("second");
+  queue.Push(second);
+  EXPECT_TRUE(second);
+  EXPECT_FALSE(queue.Empty());
+
+  SharedQueueType element;
+  ASSERT_TRUE(queue.Pull(element));
+  EXPECT_EQ("first", *element);
+  ASSERT_TRUE(queue.Pull(element));
+  EXPECT_EQ("second", *element);
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(LockFreeSyncQueueTest, Close) {
+  LockFreeQueueShared queue;
+
+  auto string = std::make_shared<std::string>("close");
+  std::weak_ptr<std::string> weak = string;
+  queue.Push(std::move(string));
+  ASSERT_TRUE(weak.lock());
+
+  queue.Close();
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_FALSE(weak.lock());
+
+  {
+    SCOPED_TRACE("Push and pull on closed queue");
+    queue.Push(std::make_shared<std::string>("value"));
+    EXPECT_TRUE(queue.Empty());
+
+    SharedQueueType element;
+    EXPECT_FALSE(queue.Pull(element));
+    EXPECT_FALSE(element);
+  }
+}
+
+TEST(LockFreeSyncQueueTest, TryPush) {
+  LockFreeQueueShared queue(2u);
+
+  EXPECT_TRUE(queue.TryPush(std::make_shared<std::string>("first")));
+  EXPECT_TRUE(queue.TryPush(std::make_shared<std::string>("second")));
+
+  auto third = std::make_shared<std::string>("third");
+  EXPECT_FALSE(queue.TryPush(std::move(third)));
+  EXPECT_TRUE(third) << "string should not be moved";
+
+  SharedQueueType element;
+  ASSERT_TRUE(queue.Pull(element));
+  EXPECT_EQ("first", *element);
+  EXPECT_TRUE(queue.TryPush(std::move(third)));
+
+  queue.Close();
+  EXPECT_FALSE(queue.TryPush(std::make_shared<std::string>("closed")));
+}
+
+TEST(LockFreeSyncQueueTest, CloseWakesUpConsumers) {
+  LockFreeQueueShared queue;
+
+  std::atomic<bool> pulled(true);
+  std::thread consumer([&]() {
+    SharedQueueType element;
+    pulled = queue.Pull(element);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  queue.Close();
+  consumer.join();
+  EXPECT_FALSE(pulled.load());
+}
+
+TEST(LockFreeSyncQueueTest, ConcurrentUsage) {
+  constexpr size_t kProducers = 4u;
+  constexpr size_t kConsumers = 4u;
+  constexpr size_t kElements = 10000u;
+
+  // The small capacity makes the producers wait for the consumers.
+  olp::thread::LockFreeSyncQueue<size_t> queue(16u);
+  std::atomic<size_t> sum(0u);
+  std::atomic<size_t> count(0u);
+
+  std::vector<std::thread> consumers;
+  for (size_t idx = 0u; idx < kConsumers; ++idx) {
+    consumers.emplace_back([&]() {
+      size_t element = 0u;
+      while (queue.Pull(element)) {
+        sum += element;
+        ++count;
+      }
+    });
+  }
+
+  std::vector<std::thread> producers;
+  for (size_t idx = 0u; idx < kProducers; ++idx) {
+    producers.emplace_back([&]() {
+      for (size_t element = 1u; element <= kElements; ++element) {
+        queue.Push(std::move(element));
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  while (count.load() < kProducers * kElements) {
+    std::this_thread::yield();
+  }
+  queue.Close();
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+
+  EXPECT_EQ(kProducers * kElements * (kElements + 1u) / 2u, sum.load());
+}
+
+}  // namespace
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <future>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <olp/core/thread/TaskComponentScope.h>
+#include <olp/core/thread/TaskSchedulerStatistics.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+
+namespace {
+using olp::thread::TaskComponentScope;
+using olp::thread::TaskScheduler;
+using olp::thread::TaskSchedulerStatistics;
+using olp::thread::ThreadPoolTaskScheduler;
+
+namespace chrono = std::chrono;
+
+constexpr chrono::milliseconds kWait{1000};
+
+TEST(TaskSchedulerStatisticsTest, Histograms) {
+  auto statistics = std::make_shared<TaskSchedulerStatistics>();
+  auto scheduler = std::make_shared<ThreadPoolTaskScheduler>(1u);
+  scheduler->SetListener(statistics);
+
+  std::promise<void> block_promise;
+  auto block_future = block_promise.get_future();
+  std::promise<void> nested_done;
+
+  {
+    TaskComponentScope component_scope("Test");
+    scheduler->ScheduleTask(
+        [&]() { block_future.wait_for(kWait); }, olp::thread::HIGH);
+    scheduler->ScheduleTask([&]() {
+      EXPECT_EQ(std::string("Test"), TaskComponentScope::GetCurrentComponent());
+      // The nested task gets the component of the task.
+      scheduler->ScheduleTask([&]() { nested_done.set_value(); });
+    });
+  }
+  EXPECT_EQ(std::string(), TaskComponentScope::GetCurrentComponent());
+
+  {
+    SCOPED_TRACE("Queue depth");
+    const auto stats = statistics->GetStatistics();
+    ASSERT_EQ(1u, stats.queue_depth.count(olp::thread::NORMAL));
+    EXPECT_EQ(1u, stats.queue_depth.at(olp::thread::NORMAL));
+  }
+
+  block_promise.set_value();
+  ASSERT_EQ(std::future_status::ready,
+            nested_done.get_future().wait_for(kWait));
+  scheduler.reset();
+
+  const auto stats = statistics->GetStatistics();
+  EXPECT_TRUE(stats.queue_depth.empty());
+  ASSERT_EQ(1u, stats.components.count("Test"));
+
+  const auto& component = stats.components.at("Test");
+  EXPECT_EQ(3u, component.wait_time.count);
+  EXPECT_EQ(3u, component.run_time.count);
+  ASSERT_EQ(TaskSchedulerStatistics::GetBucketBounds().size() + 1u,
+            component.run_time.counts.size());
+  EXPECT_GE(component.run_time.max, chrono::microseconds(0));
+
+  statistics->ResetHistograms();
+  EXPECT_TRUE(statistics->GetStatistics().components.empty());
+}
+
+}  // namespace
@@ -17,7 +17,10 @@
  * License-Filename: LICENSE
  */
 
+#include <future>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -279,3 +282,211 @@ TEST(ThreadPoolTaskSchedulerTest, Move) {
   thread_pool.reset();
   testing::Mock::VerifyAndClearExpectations(&mockop);
 }
+
+TEST(ThreadPoolTaskSchedulerTest, DelayedTasks) {
+  auto thread_pool = std::make_shared<ThreadPool>(1);
+  TaskScheduler& scheduler = *thread_pool;
+
+  std::mutex mutex;
+  std::vector<int> order;
+  std::promise<void> done;
+  const auto start = chrono::steady_clock::now();
+  auto push = [&](int value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(value);
+    if (order.size() == 3u) {
+      done.set_value();
+    }
+  };
+
+  scheduler.ScheduleTaskAfter([&]() { push(2); }, 2 * kSleep);
+  scheduler.ScheduleTaskAfter([&]() { push(1); }, kSleep);
+
+  // The delayed tasks do not block the thread pool.
+  scheduler.ScheduleTask([&]() { push(0); });
+
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(chrono::milliseconds(kMaxWaitMs)));
+  EXPECT_GE(chrono::steady_clock::now() - start, 2 * kSleep);
+  EXPECT_EQ(std::vector<int>({0, 1, 2}), order);
+
+  // The pending delayed tasks are dropped.
+  scheduler.ScheduleTaskAfter([&]() { push(3); }, chrono::hours(1));
+  thread_pool.reset();
+}
+
+TEST(ThreadPoolTaskSchedulerTest, TimedTasks) {
+  auto thread_pool = std::make_shared<ThreadPool>(1);
+  TaskScheduler& scheduler = *thread_pool;
+
+  std::promise<void> at_done;
+  scheduler.ScheduleTaskAt([&]() { at_done.set_value(); },
+                           chrono::steady_clock::now() + kSleep);
+  EXPECT_EQ(std::future_status::timeout,
+            at_done.get_future().wait_for(chrono::milliseconds(0)));
+
+  std::atomic<bool> cancelled_called(false);
+  auto context = scheduler.ScheduleTaskAfter(
+      [&](const CancellationContext&) { cancelled_called = true; }, kSleep);
+  context.CancelOperation();
+
+  std::promise<void> after_done;
+  scheduler.ScheduleTaskAfter(
+      [&](const CancellationContext&) { after_done.set_value(); }, 2 * kSleep);
+  ASSERT_EQ(std::future_status::ready,
+            after_done.get_future().wait_for(chrono::milliseconds(kMaxWaitMs)));
+  EXPECT_FALSE(cancelled_called.load());
+  thread_pool.reset();
+}
+
+TEST(ThreadPoolTaskSchedulerTest, HighPriorityLane) {
+  olp::thread::PriorityLanesSettings lanes;
+  lanes.high_priority_threads = 1u;
+  auto thread_pool = std::make_shared<ThreadPool>(2u, lanes);
+  TaskScheduler& scheduler = *thread_pool;
+
+  std::promise<void> block_promise;
+  auto block_future = block_promise.get_future().share();
+  std::promise<void> blocked;
+
+  // The lane thread does not take the normal task, so it blocks the other
+  // thread.
+  scheduler.ScheduleTask([&, block_future]() {
+    blocked.set_value();
+    block_future.wait_for(chrono::milliseconds(kMaxWaitMs));
+  });
+  ASSERT_EQ(std::future_status::ready,
+            blocked.get_future().wait_for(chrono::milliseconds(kMaxWaitMs)));
+
+  std::atomic<bool> normal_done(false);
+  scheduler.ScheduleTask([&]() { normal_done = true; });
+
+  std::promise<void> high_done;
+  scheduler.ScheduleTask([&]() { high_done.set_value(); },
+                         olp::thread::HIGH);
+
+  EXPECT_EQ(std::future_status::ready,
+            high_done.get_future().wait_for(chrono::milliseconds(kMaxWaitMs)));
+  EXPECT_FALSE(normal_done.load());
+
+  block_promise.set_value();
+  thread_pool.reset();
+}
+
+TEST(ThreadPoolTaskSchedulerTest, Aging) {
+  olp::thread::PriorityLanesSettings lanes;
+  lanes.max_task_wait = kSleep;
+  auto thread_pool = std::make_shared<ThreadPool>(1u, lanes);
+  TaskScheduler& scheduler = *thread_pool;
+
+  std::promise<void> block_promise;
+  auto block_future = block_promise.get_future();
+  scheduler.ScheduleTask(
+      [&]() { block_future.wait_for(chrono::milliseconds(kMaxWaitMs)); });
+
+  std::mutex mutex;
+  std::vector<uint32_t> order;
+  std::promise<void> done;
+  auto push = [&](uint32_t priority) {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(priority);
+    if (order.size() == 2u) {
+      done.set_value();
+    }
+  };
+
+  scheduler.ScheduleTask([&]() { push(olp::thread::LOW); }, olp::thread::LOW);
+  std::this_thread::sleep_for(2 * kSleep);
+  scheduler.ScheduleTask([&]() { push(olp::thread::HIGH); },
+                         olp::thread::HIGH);
+  block_promise.set_value();
+
+  // The low priority task waited for too long, so it runs first.
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(chrono::milliseconds(kMaxWaitMs)));
+  EXPECT_EQ(std::vector<uint32_t>({olp::thread::LOW, olp::thread::HIGH}),
+            order);
+}
+
+TEST(ThreadPoolTaskSchedulerTest, ElasticPool) {
+  olp::thread::ElasticPoolSettings elastic;
+  elastic.max_thread_count = 3u;
+  elastic.idle_timeout = kSleep;
+  auto thread_pool = std::make_shared<ThreadPool>(
+      1u, olp::thread::PriorityLanesSettings(), elastic);
+  TaskScheduler& scheduler = *thread_pool;
+
+  std::promise<void> block_promise;
+  auto block_future = block_promise.get_future().share();
+  std::atomic<uint32_t> started(0u);
+  std::promise<void> all_started;
+
+  // The blocked tasks do not wait for each other, the pool grows instead.
+  for (uint32_t idx = 0u; idx < 3u; ++idx) {
+    scheduler.ScheduleTask([&, block_future]() {
+      if (++started == 3u) {
+        all_started.set_value();
+      }
+      block_future.wait_for(chrono::milliseconds(kMaxWaitMs));
+    });
+  }
+
+  EXPECT_EQ(std::future_status::ready,
+            all_started.get_future().wait_for(
+                chrono::milliseconds(kMaxWaitMs)));
+  block_promise.set_value();
+
+  // The extra threads stop, and the pool grows again on demand.
+  std::this_thread::sleep_for(3 * kSleep);
+
+  std::promise<void> done;
+  scheduler.ScheduleTask([&]() { done.set_value(); });
+  EXPECT_EQ(std::future_status::ready,
+            done.get_future().wait_for(chrono::milliseconds(kMaxWaitMs)));
+}
+
+TEST(ThreadPoolTaskSchedulerTest, ScheduleTasks) {
+  auto thread_pool = std::make_shared<ThreadPool>(1u);
+  TaskScheduler& scheduler = *thread_pool;
+
+  std::promise<void> block_promise;
+  auto block_future = block_promise.get_future();
+  scheduler.ScheduleTask(
+      [&]() { block_future.wait_for(chrono::milliseconds(kMaxWaitMs)); },
+      olp::thread::HIGH);
+
+  std::mutex mutex;
+  std::vector<uint32_t> order;
+  std::promise<void> done;
+
+  std::vector<TaskScheduler::CallFuncType> batch;
+  for (uint32_t idx = 0u; idx < kNumTasks; ++idx) {
+    batch.emplace_back([&, idx]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(idx);
+      if (order.size() == kNumTasks + 1u) {
+        done.set_value();
+      }
+    });
+  }
+
+  // The batch keeps its order, and the tasks with a higher priority still
+  // run first.
+  scheduler.ScheduleTasks(std::move(batch), olp::thread::LOW);
+  scheduler.ScheduleTask(
+      [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(kNumTasks);
+      },
+      olp::thread::NORMAL);
+  block_promise.set_value();
+
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(chrono::milliseconds(kMaxWaitMs)));
+
+  std::vector<uint32_t> expected{kNumTasks};
+  for (uint32_t idx = 0u; idx < kNumTasks; ++idx) {
+    expected.push_back(idx);
+  }
+  EXPECT_EQ(expected, order);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <future>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <olp/core/porting/platform.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+#include "thread/ThreadUtils.h"
+
+#if defined(PORTING_PLATFORM_LINUX)
+#include <sched.h>
+#endif
+
+namespace {
+using olp::thread::ThreadAffinitySettings;
+
+TEST(ThreadUtilsTest, GetThreadCpus) {
+  {
+    SCOPED_TRACE("Not pinned");
+    EXPECT_TRUE(olp::thread::GetThreadCpus(ThreadAffinitySettings(), 0u)
+                    .empty());
+  }
+  {
+    SCOPED_TRACE("CPU set");
+    ThreadAffinitySettings settings;
+    settings.cpus = {2u, 3u};
+    EXPECT_EQ(settings.cpus, olp::thread::GetThreadCpus(settings, 1u));
+  }
+  {
+    SCOPED_TRACE("CPU per thread");
+    ThreadAffinitySettings settings;
+    settings.cpus = {2u, 3u};
+    settings.pin_each_thread = true;
+    EXPECT_EQ(std::vector<size_t>{2u},
+              olp::thread::GetThreadCpus(settings, 0u));
+    EXPECT_EQ(std::vector<size_t>{3u},
+              olp::thread::GetThreadCpus(settings, 1u));
+    EXPECT_EQ(std::vector<size_t>{2u},
+              olp::thread::GetThreadCpus(settings, 2u));
+  }
+}
+
+#if defined(PORTING_PLATFORM_LINUX)
+TEST(ThreadUtilsTest, PinPoolThreads) {
+  // The current CPU is allowed for the threads of the process.
+  const auto current_cpu = sched_getcpu();
+  ASSERT_GE(current_cpu, 0);
+
+  ThreadAffinitySettings affinity;
+  affinity.cpus = {static_cast<size_t>(current_cpu)};
+  olp::thread::ThreadPoolTaskScheduler scheduler(
+      1u, olp::thread::PriorityLanesSettings(),
+      olp::thread::ElasticPoolSettings(), affinity);
+
+  std::promise<int> cpu;
+  scheduler.ScheduleTask([&]() { cpu.set_value(sched_getcpu()); });
+  EXPECT_EQ(current_cpu, cpu.get_future().get());
+}
+
+TEST(ThreadUtilsTest, NumaNodeCpus) {
+  // Every Linux system has at least the node 0 if NUMA is reported.
+  const auto cpus = olp::thread::GetNumaNodeCpus(0u);
+  if (cpus.empty()) {
+    GTEST_SKIP() << "NUMA nodes are not reported";
+  }
+  EXPECT_EQ(0u, cpus.front());
+}
+#endif
+
+}  // namespace
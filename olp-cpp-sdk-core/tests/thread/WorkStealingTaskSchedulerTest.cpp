@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <olp/core/thread/WorkStealingTaskScheduler.h>
+
+namespace {
+using TaskScheduler = olp::thread::TaskScheduler;
+using WorkStealingTaskScheduler = olp::thread::WorkStealingTaskScheduler;
+
+namespace chrono = std::chrono;
+
+constexpr size_t kThreads{3u};
+constexpr uint32_t kNumTasks{30u};
+constexpr chrono::milliseconds kSleep{100};
+constexpr chrono::milliseconds kMaxWait{1000};
+
+TEST(WorkStealingTaskSchedulerTest, NestedTasks) {
+  auto scheduler = std::make_shared<WorkStealingTaskScheduler>(kThreads);
+  TaskScheduler& task_scheduler = *scheduler;
+
+  std::atomic<uint32_t> counter(0u);
+  std::promise<void> done;
+  constexpr uint32_t expected_tasks = kNumTasks * (kNumTasks + 1u);
+
+  auto count = [&]() {
+    if (++counter == expected_tasks) {
+      done.set_value();
+    }
+  };
+
+  // Every task spawns more tasks on its own worker queue.
+  for (uint32_t idx = 0u; idx < kNumTasks; ++idx) {
+    task_scheduler.ScheduleTask([&]() {
+      for (uint32_t nested = 0u; nested < kNumTasks; ++nested) {
+        task_scheduler.ScheduleTask(count);
+      }
+      count();
+    });
+  }
+
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(kMaxWait));
+  EXPECT_EQ(expected_tasks, counter.load());
+}
+
+TEST(WorkStealingTaskSchedulerTest, StealTasks) {
+  auto scheduler = std::make_shared<WorkStealingTaskScheduler>(2u);
+  TaskScheduler& task_scheduler = *scheduler;
+
+  std::promise<void> unblock;
+  auto unblock_future = unblock.get_future();
+  std::promise<void> stolen;
+
+  // The task queues the next one on its own worker and blocks it, so the
+  // other worker has to steal the task.
+  task_scheduler.ScheduleTask([&]() {
+    task_scheduler.ScheduleTask([&]() { stolen.set_value(); });
+    unblock_future.wait_for(kMaxWait);
+  });
+
+  EXPECT_EQ(std::future_status::ready,
+            stolen.get_future().wait_for(kMaxWait));
+  unblock.set_value();
+  scheduler.reset();
+}
+
+TEST(WorkStealingTaskSchedulerTest, Prioritization) {
+  auto scheduler = std::make_shared<WorkStealingTaskScheduler>(1u);
+  TaskScheduler& task_scheduler = *scheduler;
+
+  std::promise<void> block_promise;
+  auto block_future = block_promise.get_future();
+  task_scheduler.ScheduleTask([&]() { block_future.wait_for(kMaxWait); },
+                              std::numeric_limits<uint32_t>::max());
+
+  std::mutex mutex;
+  std::vector<uint32_t> order;
+  const olp::thread::Priority priorities[] = {
+      olp::thread::LOW, olp::thread::NORMAL, olp::thread::HIGH};
+  for (uint32_t idx = 0u; idx < kNumTasks; ++idx) {
+    const auto priority = priorities[idx % 3];
+    task_scheduler.ScheduleTask(
+        [&, priority]() {
+          std::lock_guard<std::mutex> lock(mutex);
+          order.push_back(priority);
+        },
+        priority);
+  }
+
+  block_promise.set_value();
+
+  std::promise<void> done;
+  task_scheduler.ScheduleTask([&]() { done.set_value(); }, 0u);
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(kMaxWait));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(kNumTasks, order.size());
+  EXPECT_TRUE(std::is_sorted(order.rbegin(), order.rend()));
+}
+
+TEST(WorkStealingTaskSchedulerTest, DelayedTasks) {
+  auto scheduler = std::make_shared<WorkStealingTaskScheduler>(kThreads);
+  TaskScheduler& task_scheduler = *scheduler;
+
+  std::promise<void> done;
+  const auto start = chrono::steady_clock::now();
+  task_scheduler.ScheduleTaskAfter([&]() { done.set_value(); }, kSleep);
+
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(kMaxWait));
+  EXPECT_GE(chrono::steady_clock::now() - start, kSleep);
+
+  // The pending delayed tasks are dropped.
+  task_scheduler.ScheduleTaskAfter([]() { FAIL(); }, chrono::hours(1));
+  scheduler.reset();
+}
+
+TEST(WorkStealingTaskSchedulerTest, ScheduleTasks) {
+  auto scheduler = std::make_shared<WorkStealingTaskScheduler>(kThreads);
+  TaskScheduler& task_scheduler = *scheduler;
+
+  std::atomic<uint32_t> counter(0u);
+  std::promise<void> done;
+
+  std::vector<TaskScheduler::CallFuncType> batch;
+  for (uint32_t idx = 0u; idx < kNumTasks; ++idx) {
+    batch.emplace_back([&]() {
+      if (++counter == kNumTasks) {
+        done.set_value();
+      }
+    });
+  }
+
+  // The batch lands in one queue, the other workers steal from it.
+  task_scheduler.ScheduleTasks(std::move(batch));
+
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(kMaxWait));
+  EXPECT_EQ(kNumTasks, counter.load());
+}
+
+}  // namespace
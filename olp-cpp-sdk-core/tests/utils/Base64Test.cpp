@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <olp/core/utils/Base64.h>
+
+namespace {
+using olp::utils::Base64Decode;
+using olp::utils::Base64Encode;
+
+TEST(Base64Test, Encode) {
+  EXPECT_EQ(Base64Encode(std::string()), "");
+  EXPECT_EQ(Base64Encode(std::string("f")), "Zg==");
+  EXPECT_EQ(Base64Encode(std::string("fo")), "Zm8=");
+  EXPECT_EQ(Base64Encode(std::string("foo")), "Zm9v");
+  EXPECT_EQ(Base64Encode(std::string("foob")), "Zm9vYg==");
+  EXPECT_EQ(Base64Encode(std::vector<uint8_t>{0xFB, 0xFF, 0x00}), "+/8A");
+}
+
+TEST(Base64Test, Decode) {
+  std::vector<uint8_t> bytes;
+
+  ASSERT_TRUE(Base64Decode("Zm9vYg==", bytes));
+  EXPECT_EQ(std::string(bytes.begin(), bytes.end()), "foob");
+
+  ASSERT_TRUE(Base64Decode("Zm8=", bytes));
+  EXPECT_EQ(std::string(bytes.begin(), bytes.end()), "fo");
+
+  ASSERT_TRUE(Base64Decode("+/8A", bytes));
+  EXPECT_EQ(bytes, (std::vector<uint8_t>{0xFB, 0xFF, 0x00}));
+
+  ASSERT_TRUE(Base64Decode("+/8A", bytes, false));
+  EXPECT_EQ(bytes, (std::vector<uint8_t>{0xFB, 0xFF}));
+
+  ASSERT_TRUE(Base64Decode("", bytes));
+  EXPECT_TRUE(bytes.empty());
+}
+
+TEST(Base64Test, DecodeInvalid) {
+  std::vector<uint8_t> bytes{1u};
+
+  EXPECT_FALSE(Base64Decode("Zm9", bytes));
+  EXPECT_FALSE(Base64Decode("Zm=v", bytes));
+  EXPECT_FALSE(Base64Decode("Z===", bytes));
+  EXPECT_FALSE(Base64Decode("Zm9!", bytes));
+  EXPECT_EQ(bytes, std::vector<uint8_t>{1u});
+}
+
+}  // namespace
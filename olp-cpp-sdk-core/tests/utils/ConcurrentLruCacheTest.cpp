@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <olp/core/utils/ConcurrentLruCache.h>
+
+namespace {
+using Cache = olp::utils::ConcurrentLruCache<std::string, int>;
+
+TEST(ConcurrentLruCacheTest, FindAndInsert) {
+  Cache cache(10u, 2u);
+
+  EXPECT_FALSE(cache.Find("key"));
+  EXPECT_TRUE(cache.InsertOrAssign("key", 1));
+  ASSERT_TRUE(cache.Find("key"));
+  EXPECT_EQ(*cache.Find("key"), 1);
+
+  EXPECT_TRUE(cache.InsertOrAssign("key", 2));
+  EXPECT_EQ(*cache.Find("key"), 2);
+  EXPECT_EQ(cache.Size(), 1u);
+
+  EXPECT_TRUE(cache.Erase("key"));
+  EXPECT_FALSE(cache.Erase("key"));
+  EXPECT_FALSE(cache.Find("key"));
+}
+
+TEST(ConcurrentLruCacheTest, Update) {
+  Cache cache(10u);
+
+  EXPECT_EQ(cache.Update("key", [](int& value) { value += 5; }), 5);
+  EXPECT_EQ(cache.Update("key", [](int& value) { value *= 2; }), 10);
+  EXPECT_EQ(*cache.Find("key"), 10);
+}
+
+TEST(ConcurrentLruCacheTest, Eviction) {
+  // A single shard evicts the least recently used value.
+  Cache cache(2u, 1u);
+  cache.InsertOrAssign("a", 1);
+  cache.InsertOrAssign("b", 2);
+  cache.Find("a");
+  cache.InsertOrAssign("c", 3);
+
+  EXPECT_TRUE(cache.Find("a"));
+  EXPECT_FALSE(cache.Find("b"));
+  EXPECT_TRUE(cache.Find("c"));
+
+  // The size is kept with several shards too.
+  Cache sharded(8u, 4u);
+  for (int i = 0; i < 100; ++i) {
+    sharded.InsertOrAssign(std::to_string(i), i);
+  }
+  EXPECT_LE(sharded.Size(), 8u);
+
+  sharded.Clear();
+  EXPECT_EQ(sharded.Size(), 0u);
+}
+
+TEST(ConcurrentLruCacheTest, ConcurrentAccess) {
+  Cache cache(1000u);
+  const int kThreads = 4;
+  const int kKeys = 200;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < kKeys; ++i) {
+        const auto key = std::to_string(i);
+        cache.Update(key, [](int& value) { ++value; });
+        cache.Find(key);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < kKeys; ++i) {
+    EXPECT_EQ(cache.Find(std::to_string(i)).value_or(0), kThreads);
+  }
+}
+}  // namespace
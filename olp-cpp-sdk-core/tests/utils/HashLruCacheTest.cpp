@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <olp/core/utils/HashLruCache.h>
+#include <olp/core/utils/PoolAllocator.h>
+
+namespace {
+using olp::utils::CacheCost;
+using olp::utils::HashLruCache;
+using olp::utils::PoolAllocator;
+
+template <typename Cache>
+std::vector<std::string> Keys(const Cache& cache) {
+  std::vector<std::string> keys;
+  for (const auto& entry : cache) {
+    keys.push_back(entry.key());
+  }
+  return keys;
+}
+
+template <typename Cache>
+class HashLruCacheTest : public ::testing::Test {};
+
+using CacheTypes = ::testing::Types<
+    HashLruCache<std::string, int>,
+    HashLruCache<std::string, int, CacheCost<int>, std::hash<std::string>,
+                 std::equal_to<std::string>, PoolAllocator>>;
+TYPED_TEST_SUITE(HashLruCacheTest, CacheTypes);
+
+TYPED_TEST(HashLruCacheTest, InsertAndFind) {
+  TypeParam cache(10u);
+
+  EXPECT_TRUE(cache.Insert("a", 1).second);
+  EXPECT_TRUE(cache.Insert("b", 2).second);
+  EXPECT_FALSE(cache.Insert("a", 3).second);
+  EXPECT_EQ(cache.Find("a").value(), 1);
+  EXPECT_EQ(cache.Find("c", -1), -1);
+
+  EXPECT_FALSE(cache.InsertOrAssign("a", 4).second);
+  EXPECT_EQ(cache.FindNoPromote("a").value(), 4);
+  EXPECT_EQ(cache.Size(), 2u);
+
+  EXPECT_TRUE(cache.Erase("a"));
+  EXPECT_FALSE(cache.Erase("a"));
+  EXPECT_EQ(cache.Find("a"), cache.end());
+  EXPECT_EQ(cache.Size(), 1u);
+}
+
+TYPED_TEST(HashLruCacheTest, LruOrder) {
+  TypeParam cache(3u);
+  std::vector<std::string> evicted;
+  cache.SetEvictionCallback(
+      [&](const std::string& key, int&&) { evicted.push_back(key); });
+
+  cache.InsertOrAssign("a", 1);
+  cache.InsertOrAssign("b", 2);
+  cache.InsertOrAssign("c", 3);
+  EXPECT_EQ(Keys(cache), (std::vector<std::string>{"c", "b", "a"}));
+
+  cache.Find("a");
+  cache.FindNoPromote("b");
+  EXPECT_EQ(Keys(cache), (std::vector<std::string>{"a", "c", "b"}));
+  EXPECT_EQ(cache.rbegin().key(), "b");
+
+  cache.InsertOrAssign("d", 4);
+  EXPECT_EQ(evicted, std::vector<std::string>{"b"});
+  EXPECT_EQ(Keys(cache), (std::vector<std::string>{"d", "a", "c"}));
+
+  // Walks from the least recently used element.
+  std::vector<std::string> reversed;
+  for (auto it = cache.rbegin(); it != cache.rend(); --it) {
+    reversed.push_back(it->key());
+  }
+  EXPECT_EQ(reversed, (std::vector<std::string>{"c", "a", "d"}));
+
+  cache.Resize(1u);
+  EXPECT_EQ(Keys(cache), std::vector<std::string>{"d"});
+}
+
+TYPED_TEST(HashLruCacheTest, EraseRange) {
+  TypeParam cache(100u);
+  for (int i = 0; i < 20; ++i) {
+    cache.InsertOrAssign((i % 2 ? "odd::" : "even::") + std::to_string(i), i);
+  }
+
+  const auto removed = cache.EraseRange(
+      "odd::",
+      [](const std::string& key) { return key.compare(0, 5, "odd::") == 0; },
+      [](const std::string&, int value) { return value != 19; });
+
+  EXPECT_EQ(removed, 9u);
+  EXPECT_EQ(cache.Size(), 11u);
+  EXPECT_NE(cache.FindNoPromote("odd::19"), cache.end());
+
+  auto it = cache.begin();
+  cache.Erase(it);
+  EXPECT_EQ(it, cache.begin());
+  EXPECT_EQ(cache.Size(), 10u);
+
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0u);
+  EXPECT_EQ(cache.begin(), cache.end());
+}
+
+TYPED_TEST(HashLruCacheTest, Move) {
+  TypeParam cache(10u);
+  cache.InsertOrAssign("a", 1);
+  cache.InsertOrAssign("b", 2);
+
+  TypeParam moved(std::move(cache));
+  EXPECT_EQ(Keys(moved), (std::vector<std::string>{"b", "a"}));
+
+  TypeParam assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(Keys(assigned), (std::vector<std::string>{"b", "a"}));
+  EXPECT_EQ(assigned.Size(), 2u);
+}
+
+TEST(PoolAllocatorTest, ReusesBlocks) {
+  PoolAllocator<int> allocator;
+  PoolAllocator<double> rebound(allocator);
+  EXPECT_TRUE(allocator == rebound);
+  EXPECT_FALSE(allocator == PoolAllocator<int>());
+
+  auto first = allocator.allocate(1u);
+  allocator.deallocate(first, 1u);
+  auto second = allocator.allocate(1u);
+  EXPECT_EQ(first, second);
+  allocator.deallocate(second, 1u);
+
+  auto array = allocator.allocate(4u);
+  allocator.deallocate(array, 4u);
+}
+}  // namespace
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <olp/core/utils/InlineFunction.h>
+
+namespace {
+using olp::utils::InlineFunction;
+
+TEST(InlineFunctionTest, Empty) {
+  InlineFunction<void()> function;
+  EXPECT_FALSE(function);
+  EXPECT_THROW(function(), std::bad_function_call);
+
+  std::function<void()> empty_std_function;
+  InlineFunction<void()> from_empty(empty_std_function);
+  EXPECT_FALSE(from_empty);
+
+  void (*null_pointer)() = nullptr;
+  InlineFunction<void()> from_null(null_pointer);
+  EXPECT_FALSE(from_null);
+}
+
+TEST(InlineFunctionTest, CallsAndMoves) {
+  auto value = std::make_shared<int>(1);
+  InlineFunction<int(int)> function = [value](int add) {
+    return *value + add;
+  };
+  ASSERT_TRUE(function);
+  EXPECT_EQ(3, function(2));
+
+  InlineFunction<int(int)> moved(std::move(function));
+  EXPECT_FALSE(function);  // NOLINT
+  EXPECT_EQ(4, moved(3));
+
+  function = std::move(moved);
+  EXPECT_EQ(5, function(4));
+
+  function = nullptr;
+  EXPECT_FALSE(function);
+  EXPECT_EQ(1, value.use_count());
+}
+
+TEST(InlineFunctionTest, MoveOnlyCallable) {
+  std::unique_ptr<std::string> text(new std::string("text"));
+  auto* raw = text.get();
+
+  struct Callable {
+    std::unique_ptr<std::string> text;
+    std::string operator()() const { return *text; }
+  };
+
+  InlineFunction<std::string()> function = Callable{std::move(text)};
+  InlineFunction<std::string()> moved = std::move(function);
+  EXPECT_EQ("text", moved());
+  EXPECT_EQ("text", *raw);
+}
+
+TEST(InlineFunctionTest, LargeCallable) {
+  // Does not fit into the buffer, so it is allocated on the heap.
+  std::array<int, 64> values{};
+  values[63] = 7;
+  auto counter = std::make_shared<int>(0);
+
+  InlineFunction<int()> function = [values, counter]() {
+    ++*counter;
+    return values[63];
+  };
+  InlineFunction<int()> moved = std::move(function);
+  EXPECT_EQ(7, moved());
+  EXPECT_EQ(1, *counter);
+
+  moved = nullptr;
+  EXPECT_EQ(1, counter.use_count());
+}
+
+TEST(InlineFunctionTest, VoidDiscardsResult) {
+  auto calls = 0;
+  InlineFunction<void()> function = [&calls]() { return ++calls; };
+  function();
+  EXPECT_EQ(1, calls);
+
+  // Does not fit into the buffer, so it is allocated on the heap.
+  std::array<int, 64> values{};
+  InlineFunction<void(int)> large = [values, &calls](int add) {
+    calls += add + values[0];
+    return calls;
+  };
+  large(2);
+  EXPECT_EQ(3, calls);
+}
+
+}  // namespace
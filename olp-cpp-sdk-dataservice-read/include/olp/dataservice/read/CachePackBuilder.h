@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include <olp/dataservice/read/CachePackRequest.h>
+#include <olp/dataservice/read/DataServiceReadApi.h>
+#include <olp/dataservice/read/Types.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief The result of the cache pack build.
+ */
+struct CachePackResult {
+  /// The catalog version of the pack.
+  int64_t version{0};
+  /// The number of tiles stored in the pack.
+  size_t tile_count{0u};
+};
+
+/// The response of the cache pack build.
+using CachePackResponse = Response<CachePackResult>;
+
+/**
+ * @brief Builds offline cache packs to be used as the protected cache.
+ *
+ * The builder prefetches the requested tiles of all layers in parallel into a
+ * temporary mutable cache, using the task scheduler and network of the
+ * settings. Then, it exports the cache as a memory-mapped protected cache in a
+ * single sorted pass, so the pack never needs a compaction.
+ *
+ * @note The builder requires the default cache implementation. The cache of
+ * the settings is not used.
+ */
+class DATASERVICE_READ_API CachePackBuilder final {
+ public:
+  /**
+   * @brief Creates the `CachePackBuilder` instance.
+   *
+   * @param catalog The HRN of the catalog.
+   * @param settings The `OlpClientSettings` instance used for the requests.
+   */
+  CachePackBuilder(client::HRN catalog, client::OlpClientSettings settings);
+
+  /**
+   * @brief Builds the cache pack.
+   *
+   * The call blocks until the pack is written, so it must not be called from
+   * a thread of the settings task scheduler.
+   *
+   * @param request The `CachePackRequest` instance that describes the pack.
+   * @param context The `CancellationContext` instance used to cancel the
+   * build.
+   *
+   * @return The `CachePackResult` instance or an error.
+   */
+  CachePackResponse Build(
+      const CachePackRequest& request,
+      client::CancellationContext context = client::CancellationContext());
+
+ private:
+  client::HRN catalog_;
+  client::OlpClientSettings settings_;
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <olp/core/geo/coordinates/GeoRectangle.h>
+#include <olp/dataservice/read/DataServiceReadApi.h>
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief Encapsulates the fields required to build an offline cache pack.
+ *
+ * The pack contains the tiles of the given layers that overlap with the
+ * geographic rectangle, from the minimum to the maximum tile level, and the
+ * metadata needed to read them.
+ */
+class DATASERVICE_READ_API CachePackRequest final {
+ public:
+  /**
+   * @brief Gets the IDs of the versioned layers to store in the pack.
+   *
+   * @return The layer IDs.
+   */
+  inline const std::vector<std::string>& GetLayerIds() const {
+    return layer_ids_;
+  }
+
+  /**
+   * @brief Sets the IDs of the versioned layers to store in the pack.
+   *
+   * @param layer_ids The layer IDs.
+   *
+   * @return A reference to the updated `CachePackRequest` instance.
+   */
+  inline CachePackRequest& WithLayerIds(std::vector<std::string> layer_ids) {
+    layer_ids_ = std::move(layer_ids);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the geographic rectangle of the pack.
+   *
+   * @return The geographic rectangle.
+   */
+  inline const geo::GeoRectangle& GetGeoRectangle() const {
+    return geo_rectangle_;
+  }
+
+  /**
+   * @brief Sets the geographic rectangle of the pack.
+   *
+   * @param geo_rectangle The geographic rectangle.
+   *
+   * @return A reference to the updated `CachePackRequest` instance.
+   */
+  inline CachePackRequest& WithGeoRectangle(geo::GeoRectangle geo_rectangle) {
+    geo_rectangle_ = std::move(geo_rectangle);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the minimum tile level to store in the pack.
+   *
+   * @return The minimum tile level.
+   */
+  inline unsigned int GetMinLevel() const { return min_level_; }
+
+  /**
+   * @brief Sets the minimum tile level to store in the pack.
+   *
+   * @param min_level The minimum tile level.
+   *
+   * @return A reference to the updated `CachePackRequest` instance.
+   */
+  inline CachePackRequest& WithMinLevel(unsigned int min_level) {
+    min_level_ = min_level;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the maximum tile level to store in the pack.
+   *
+   * @return The maximum tile level.
+   */
+  inline unsigned int GetMaxLevel() const { return max_level_; }
+
+  /**
+   * @brief Sets the maximum tile level to store in the pack.
+   *
+   * @param max_level The maximum tile level.
+   *
+   * @return A reference to the updated `CachePackRequest` instance.
+   */
+  inline CachePackRequest& WithMaxLevel(unsigned int max_level) {
+    max_level_ = max_level;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the catalog version of the pack.
+   *
+   * @return The catalog version, or `boost::none` if the latest version is
+   * used.
+   */
+  inline const boost::optional<int64_t>& GetVersion() const {
+    return version_;
+  }
+
+  /**
+   * @brief Sets the catalog version of the pack.
+   *
+   * If the version is not set, the latest catalog version is used for all
+   * layers.
+   *
+   * @param version The catalog version.
+   *
+   * @return A reference to the updated `CachePackRequest` instance.
+   */
+  inline CachePackRequest& WithVersion(boost::optional<int64_t> version) {
+    version_ = std::move(version);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the directory the pack is written to.
+   *
+   * @return The output directory.
+   */
+  inline const std::string& GetOutputPath() const { return output_path_; }
+
+  /**
+   * @brief Sets the directory the pack is written to.
+   *
+   * Use the directory as `CacheSettings::disk_path_protected` to read the
+   * pack.
+   *
+   * @param output_path The output directory.
+   *
+   * @return A reference to the updated `CachePackRequest` instance.
+   */
+  inline CachePackRequest& WithOutputPath(std::string output_path) {
+    output_path_ = std::move(output_path);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the billing tag to group billing records together.
+   *
+   * @return The `BillingTag` string or `boost::none` if the billing tag is not
+   * set.
+   */
+  inline const boost::optional<std::string>& GetBillingTag() const {
+    return billing_tag_;
+  }
+
+  /**
+   * @brief Sets the billing tag for the requests of the build.
+   *
+   * @param tag The `BillingTag` string or `boost::none`.
+   *
+   * @return A reference to the updated `CachePackRequest` instance.
+   */
+  inline CachePackRequest& WithBillingTag(boost::optional<std::string> tag) {
+    billing_tag_ = std::move(tag);
+    return *this;
+  }
+
+ private:
+  std::vector<std::string> layer_ids_;
+  geo::GeoRectangle geo_rectangle_;
+  unsigned int min_level_{1u};
+  unsigned int max_level_{1u};
+  boost::optional<int64_t> version_;
+  std::string output_path_;
+  boost::optional<std::string> billing_tag_;
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
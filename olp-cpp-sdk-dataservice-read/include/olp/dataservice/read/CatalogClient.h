@@ -23,6 +23,7 @@
 #include <memory>
 
 #include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/client/Warmup.h>
 #include <olp/core/geo/tiling/TileKey.h>
 #include <olp/core/porting/deprecated.h>
 #include <olp/dataservice/read/CatalogRequest.h>
@@ -30,6 +31,7 @@
 #include <olp/dataservice/read/DataRequest.h>
 #include <olp/dataservice/read/DataServiceReadApi.h>
 #include <olp/dataservice/read/PartitionsRequest.h>
+#include <olp/dataservice/read/TilesRequest.h>
 #include <olp/dataservice/read/Types.h>
 #include <olp/dataservice/read/VersionsRequest.h>
 
@@ -87,6 +89,33 @@ class DATASERVICE_READ_API CatalogClient final {
    */
   bool CancelPendingRequests();
 
+  /**
+   * @brief Prepares the network and the caches for the first requests to the
+   * catalog.
+   *
+   * Acquires the access token, looks up the APIs of the catalog, and connects
+   * to their hosts, so the first request does not wait for these steps. Call
+   * it at startup, before the first request.
+   *
+   * @param callback The callback that is invoked when the warm-up is done.
+   *
+   * @see `client::Warmup` for more details.
+   *
+   * @return A token that can be used to cancel the warm-up.
+   */
+  client::CancellationToken Warmup(client::WarmupCallback callback);
+
+  /**
+   * @brief Prepares the network and the caches for the first requests to the
+   * catalog.
+   *
+   * @see `Warmup(client::WarmupCallback)` for more details.
+   *
+   * @return `CancellableFuture` that contains the `client::WarmupResponse`
+   * instance. You can also use `CancellableFuture` to cancel the warm-up.
+   */
+  client::CancellableFuture<client::WarmupResponse> Warmup();
+
   /**
    * @brief Gets the catalog configuration asynchronously.
    *
@@ -168,7 +197,52 @@ class DATASERVICE_READ_API CatalogClient final {
   client::CancellableFuture<VersionsResponse> ListVersions(
       VersionsRequest request);
 
+  /**
+   * @brief Gets the same tiles from several versioned layers of the catalog.
+   *
+   * The catalog version is resolved once for all the layers, the quad trees
+   * of the layers are requested in parallel, and the data is downloaded with
+   * a bounded number of parallel requests. The data of each tile of each
+   * layer is passed to `tile_callback` as soon as it arrives, one call at a
+   * time.
+   *
+   * @param request The `TilesRequest` instance that contains the layers,
+   * the tiles, and the other request parameters.
+   * @param tile_callback The `TileDataCallback` object that is invoked once
+   * for each tile of each layer with the data or an error.
+   * @param callback The `TilesResponseCallback` object that is invoked when
+   * all the tiles are handled, or with an error if the request failed as a
+   * whole.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetTiles(TilesRequest request,
+                                     TileDataCallback tile_callback,
+                                     TilesResponseCallback callback);
+
+  /**
+   * @brief Gets the same tiles from several versioned layers of the catalog.
+   *
+   * @see `GetTiles(TilesRequest, TileDataCallback, TilesResponseCallback)`
+   * for details.
+   *
+   * @param request The `TilesRequest` instance that contains the layers,
+   * the tiles, and the other request parameters.
+   * @param tile_callback The `TileDataCallback` object that is invoked once
+   * for each tile of each layer with the data or an error.
+   *
+   * @return `CancellableFuture` that contains the `TilesResponse` instance
+   * that is ready when all the tiles are handled. You can also use
+   * `CancellableFuture` to cancel this request.
+   */
+  client::CancellableFuture<TilesResponse> GetTiles(
+      TilesRequest request, TileDataCallback tile_callback);
+
  private:
+  friend class StreamLayerClient;
+  friend class VersionedLayerClient;
+  friend class VolatileLayerClient;
+
   std::unique_ptr<CatalogClientImpl> impl_;
 };
 
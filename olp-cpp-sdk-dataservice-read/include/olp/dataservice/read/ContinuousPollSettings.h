@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief Configures the continuous polling of a stream layer subscription.
+ *
+ * @see `StreamLayerClient::StartPolling`
+ */
+struct ContinuousPollSettings {
+  /**
+   * @brief The maximum number of the batches that are received and not
+   * acknowledged yet.
+   *
+   * The next batch is polled while the previous one is handled. When the
+   * limit is reached, the polling waits for an acknowledgement, so a slow
+   * handler does not accumulate the messages in memory.
+   */
+  size_t max_pending_batches{2u};
+
+  /// The delay of the next poll after a poll without messages.
+  std::chrono::milliseconds empty_poll_delay{std::chrono::milliseconds(500)};
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -132,6 +132,61 @@ class DATASERVICE_READ_API PrefetchPartitionsRequest final {
     return *this;
   }
 
+  /**
+   * @brief Gets the number of the partitions queried in one metadata request.
+   *
+   * The default chunk size is 100, which is also the maximum.
+   *
+   * @return The number of the partitions queried in one request.
+   */
+  inline size_t GetQueryChunkSize() const { return query_chunk_size_; }
+
+  /**
+   * @brief Sets the number of the partitions queried in one metadata request.
+   *
+   * The data of the partitions is downloaded as soon as their chunk is
+   * queried, so smaller chunks start the downloads earlier. The values above
+   * 100 are lowered to 100, and 0 is treated as 1.
+   *
+   * @param query_chunk_size The number of the partitions queried in one
+   * request.
+   *
+   * @return A reference to the updated `PrefetchPartitionsRequest` instance.
+   */
+  inline PrefetchPartitionsRequest& WithQueryChunkSize(
+      size_t query_chunk_size) {
+    query_chunk_size_ = query_chunk_size;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the maximum number of the metadata requests in flight.
+   *
+   * The default is 4.
+   *
+   * @return The maximum number of the metadata requests in flight, or 0 if
+   * the number is not limited.
+   */
+  inline size_t GetMaxParallelQueries() const { return max_parallel_queries_; }
+
+  /**
+   * @brief Sets the maximum number of the metadata requests in flight.
+   *
+   * The next chunk is queried when one of the requests completes, so the
+   * downloads of the queried partitions do not wait behind the remaining
+   * metadata requests.
+   *
+   * @param max_parallel_queries The maximum number of the metadata requests
+   * in flight, or 0 to send all of them at once.
+   *
+   * @return A reference to the updated `PrefetchPartitionsRequest` instance.
+   */
+  inline PrefetchPartitionsRequest& WithMaxParallelQueries(
+      size_t max_parallel_queries) {
+    max_parallel_queries_ = max_parallel_queries;
+    return *this;
+  }
+
   /**
    * @brief Creates a readable format for the request.
    *
@@ -161,6 +216,8 @@ class DATASERVICE_READ_API PrefetchPartitionsRequest final {
   PartitionIds partition_ids_;
   boost::optional<std::string> billing_tag_;
   uint32_t priority_{thread::LOW};
+  size_t query_chunk_size_{100u};
+  size_t max_parallel_queries_{4u};
 };
 
 }  // namespace read
@@ -24,6 +24,8 @@
 #include <utility>
 #include <vector>
 
+#include <olp/core/geo/coordinates/GeoCoordinates.h>
+#include <olp/core/geo/coordinates/GeoRectangle.h>
 #include <olp/core/geo/tiling/TileKey.h>
 #include <olp/core/porting/deprecated.h>
 #include <olp/core/thread/TaskScheduler.h>
@@ -43,6 +45,10 @@ namespace read {
  * keys above the minimum tile level are downloaded from the minimum to maximum
  * tile level. The tile keys above the maximum tile level are recursively
  * downloaded down to the maximum tile level.
+ *
+ * Instead of or in addition to the tile keys, you can set an area: a
+ * rectangle, a polygon, or a corridor along a path. The tiles from the
+ * minimum to maximum tile level that intersect the area are downloaded.
  */
 class DATASERVICE_READ_API PrefetchTilesRequest final {
  public:
@@ -201,6 +207,228 @@ class DATASERVICE_READ_API PrefetchTilesRequest final {
     return *this;
   }
 
+  /**
+   * @brief Gets the point that the tiles closest to are downloaded first.
+   *
+   * @note Experimental. API may change.
+   *
+   * @return The focus point, if it is set.
+   */
+  inline const boost::optional<geo::GeoCoordinates>& GetFocusPoint() const {
+    return focus_point_;
+  }
+
+  /**
+   * @brief Sets the point that the tiles closest to are downloaded first.
+   *
+   * When the focus point or the maximum number of the downloads in flight is
+   * set, the tiles of a quad tree are downloaded as soon as the quad tree is
+   * resolved instead of after all of the quad trees.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param focus_point The focus point.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithFocusPoint(
+      boost::optional<geo::GeoCoordinates> focus_point) {
+    focus_point_ = std::move(focus_point);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the maximum number of the tile downloads in flight.
+   *
+   * @note Experimental. API may change.
+   *
+   * @return The maximum number of the downloads, or 0 for no limit.
+   */
+  inline size_t GetMaxInFlightDownloads() const {
+    return max_in_flight_downloads_;
+  }
+
+  /**
+   * @brief Sets the maximum number of the tile downloads in flight.
+   *
+   * The other tiles wait, so the tiles closest to the focus point that are
+   * found later still overtake them.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param max_in_flight_downloads The maximum number of the downloads, or 0
+   * for no limit.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithMaxInFlightDownloads(
+      size_t max_in_flight_downloads) {
+    max_in_flight_downloads_ = max_in_flight_downloads;
+    return *this;
+  }
+
+  /**
+   * @brief Checks whether the number of the tile downloads in flight adapts
+   * to the network.
+   *
+   * @note Experimental. API may change.
+   *
+   * @return True if the number of the downloads adapts; false otherwise.
+   */
+  inline bool GetAdaptiveDownloads() const { return adaptive_downloads_; }
+
+  /**
+   * @brief Adapts the number of the tile downloads in flight to the network.
+   *
+   * The prefetch starts with a few downloads and adds more while the
+   * throughput grows. It halves them when the download latency grows, or
+   * when the server responds with the 429 or 5xx HTTP status. The number
+   * stays within `GetMaxInFlightDownloads()` when it is set.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param adaptive_downloads True to adapt the number of the downloads.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithAdaptiveDownloads(bool adaptive_downloads) {
+    adaptive_downloads_ = adaptive_downloads;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the rectangle that the prefetched tiles intersect.
+   *
+   * @note Experimental. API may change.
+   *
+   * @return The rectangle, if it is set.
+   */
+  inline const boost::optional<geo::GeoRectangle>& GetGeoRectangle() const {
+    return geo_rectangle_;
+  }
+
+  /**
+   * @brief Sets the rectangle that the prefetched tiles intersect.
+   *
+   * Requires the minimum and maximum tile levels.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param geo_rectangle The rectangle.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithGeoRectangle(
+      boost::optional<geo::GeoRectangle> geo_rectangle) {
+    geo_rectangle_ = std::move(geo_rectangle);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the polygon that the prefetched tiles intersect.
+   *
+   * @note Experimental. API may change.
+   *
+   * @return The vertices of the polygon, or an empty vector if it is not set.
+   */
+  inline const std::vector<geo::GeoCoordinates>& GetPolygon() const {
+    return polygon_;
+  }
+
+  /**
+   * @brief Sets the polygon that the prefetched tiles intersect.
+   *
+   * The polygon is closed from the last to the first vertex, and it must not
+   * cross the antimeridian. Requires the minimum and maximum tile levels.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param polygon The vertices of the polygon.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithPolygon(
+      std::vector<geo::GeoCoordinates> polygon) {
+    polygon_ = std::move(polygon);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the path of the corridor that the prefetched tiles intersect.
+   *
+   * @note Experimental. API may change.
+   *
+   * @return The points of the path, or an empty vector if it is not set.
+   */
+  inline const std::vector<geo::GeoCoordinates>& GetCorridorPath() const {
+    return corridor_path_;
+  }
+
+  /**
+   * @brief Gets the distance from the path to the edge of the corridor.
+   *
+   * @note Experimental. API may change.
+   *
+   * @return The distance in meters.
+   */
+  inline double GetCorridorRadius() const { return corridor_radius_; }
+
+  /**
+   * @brief Sets the corridor along a path, like a route, that the prefetched
+   * tiles intersect.
+   *
+   * The path must not cross the antimeridian. Requires the minimum and
+   * maximum tile levels.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param path The points of the path.
+   * @param radius The distance from the path to the edge of the corridor in
+   * meters.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithCorridor(
+      std::vector<geo::GeoCoordinates> path, double radius) {
+    corridor_path_ = std::move(path);
+    corridor_radius_ = radius;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the ID that the progress of the prefetch is saved under.
+   *
+   * @note Experimental. API may change.
+   *
+   * @return The resume ID or `boost::none` if the prefetch is not resumable.
+   */
+  inline const boost::optional<std::string>& GetResumeId() const {
+    return resume_id_;
+  }
+
+  /**
+   * @brief Makes the prefetch resumable.
+   *
+   * The prefetch saves the quad trees whose tiles are all downloaded in the
+   * cache under this ID. When the prefetch is interrupted, for example, by the
+   * application shutdown, the next prefetch with the same ID skips these quad
+   * trees, and the tiles that are already in the cache are not downloaded
+   * again. The saved progress is removed once all the tiles are downloaded.
+   *
+   * Use a new ID when any other parameter of the request changes.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param resume_id The ID of the prefetch or `boost::none`.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithResumeId(
+      boost::optional<std::string> resume_id) {
+    resume_id_ = std::move(resume_id);
+    return *this;
+  }
+
   /**
    * @brief Creates a readable format for the request.
    *
@@ -212,6 +440,13 @@ class DATASERVICE_READ_API PrefetchTilesRequest final {
     std::stringstream out;
     out << layer_id << "[" << GetMinLevel() << "/" << GetMaxLevel() << "]"
         << "(" << GetTileKeys().size() << ")";
+    if (GetGeoRectangle() || !GetPolygon().empty() ||
+        !GetCorridorPath().empty()) {
+      out << "<area>";
+    }
+    if (GetResumeId()) {
+      out << "#" << GetResumeId().get();
+    }
     if (GetBillingTag()) {
       out << "$" << GetBillingTag().get();
     }
@@ -226,6 +461,14 @@ class DATASERVICE_READ_API PrefetchTilesRequest final {
   boost::optional<std::string> billing_tag_;
   bool data_aggregation_enabled_{false};
   uint32_t priority_{thread::LOW};
+  boost::optional<geo::GeoCoordinates> focus_point_;
+  size_t max_in_flight_downloads_{0};
+  bool adaptive_downloads_{false};
+  boost::optional<geo::GeoRectangle> geo_rectangle_;
+  std::vector<geo::GeoCoordinates> polygon_;
+  std::vector<geo::GeoCoordinates> corridor_path_;
+  double corridor_radius_{0.0};
+  boost::optional<std::string> resume_id_;
 };
 
 }  // namespace read
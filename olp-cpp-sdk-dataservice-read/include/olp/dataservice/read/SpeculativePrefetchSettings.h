@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <olp/core/thread/TaskScheduler.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief Configures the speculative prefetch of the neighbor tiles.
+ *
+ * When it is enabled, each successful `GetData(TileRequest)` call schedules a
+ * low-priority task that downloads the data of the neighbor tiles on the same
+ * level to the cache. Only the neighbors whose partitions are already known
+ * from the cached quadtree are downloaded, and the task of the previous tile
+ * is cancelled when the next one is served.
+ */
+struct SpeculativePrefetchSettings {
+  /// Enables the speculative prefetch.
+  bool enabled{false};
+
+  /// The maximum number of bytes downloaded for the neighbors of one tile.
+  uint64_t byte_budget{1024u * 1024u};
+
+  /**
+   * @brief Prefetches only the neighbors in the direction of the movement.
+   *
+   * The direction is taken from the previous requested tile when it is
+   * adjacent to the current one. Otherwise, all neighbors are prefetched.
+   */
+  bool follow_direction{false};
+
+  /**
+   * @brief The priority of the prefetch task and its network requests.
+   *
+   * Keep it below `thread::NORMAL`, so the requests are limited by the network
+   * scheduler and do not compete with the foreground ones.
+   */
+  uint32_t priority{thread::LOW};
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <olp/core/client/ApiNoResult.h>
+#include <olp/core/client/CancellationToken.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include <olp/dataservice/read/ContinuousPollSettings.h>
+#include <olp/dataservice/read/DataServiceReadApi.h>
+#include <olp/dataservice/read/SubscribeRequest.h>
+#include <olp/dataservice/read/Types.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+class StreamConsumerGroupImpl;
+
+/// The response of the subscription or unsubscription of a consumer group.
+using ConsumerGroupResponse = Response<client::ApiNoResult>;
+/// The subscription or unsubscription callback of a consumer group.
+using ConsumerGroupResponseCallback = Callback<client::ApiNoResult>;
+
+/**
+ * @brief The messages handler of a consumer group.
+ *
+ * It gets the index of the consumer that polled the messages, the messages,
+ * and the acknowledgement that commits their offsets.
+ */
+using ConsumerGroupMessagesHandler =
+    std::function<void(size_t, MessagesResult, PollAcknowledgement)>;
+
+/**
+ * @brief Consumes a stream layer with several parallel subscriptions.
+ *
+ * All consumers subscribe in the parallel mode under the same consumer ID, so
+ * the service distributes the partitions of the layer among them. Each
+ * consumer polls its subscription continuously on its own task scheduler, so
+ * the messages are handled on several threads.
+ *
+ * Each consumer commits the offsets of its own partitions. When the service
+ * moves a partition to another consumer, the messages of the partition that
+ * the group already handled are not passed to the handler again.
+ */
+class DATASERVICE_READ_API StreamConsumerGroup final {
+ public:
+  /**
+   * @brief Creates the `StreamConsumerGroup` instance.
+   *
+   * @param catalog The HRN of the catalog that contains the stream layer.
+   * @param layer_id The ID of the stream layer.
+   * @param settings The `OlpClientSettings` instance. Its task scheduler is
+   * not used, each consumer creates its own one.
+   * @param consumers_count The number of the parallel subscriptions.
+   */
+  StreamConsumerGroup(client::HRN catalog, std::string layer_id,
+                      client::OlpClientSettings settings,
+                      size_t consumers_count);
+
+  /// A copy constructor.
+  StreamConsumerGroup(const StreamConsumerGroup& other) = delete;
+
+  /// A copy assignment operator.
+  StreamConsumerGroup& operator=(const StreamConsumerGroup& other) = delete;
+
+  ~StreamConsumerGroup();
+
+  /**
+   * @brief Gets the number of the consumers in the group.
+   *
+   * @return The number of the consumers.
+   */
+  size_t GetConsumersCount() const;
+
+  /**
+   * @brief Subscribes all consumers of the group.
+   *
+   * The subscription mode of the request is ignored, the consumers always
+   * subscribe in the parallel mode.
+   *
+   * @param request The `SubscribeRequest` instance. The consumer ID is
+   * required.
+   * @param callback The `ConsumerGroupResponseCallback` object that is invoked
+   * when all consumers are subscribed, or with the first error.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken Subscribe(SubscribeRequest request,
+                                      ConsumerGroupResponseCallback callback);
+
+  /**
+   * @brief Polls the messages of all consumers continuously.
+   *
+   * @see `StreamLayerClient::StartPolling` for the details of the polling of
+   * each consumer. The batches of one consumer are passed to the handler one
+   * by one, and the batches of different consumers concurrently.
+   *
+   * @param settings The `ContinuousPollSettings` instance used by each
+   * consumer.
+   * @param handler The `ConsumerGroupMessagesHandler` object that is invoked
+   * for each batch of messages.
+   * @param callback The `ContinuousPollResponseCallback` object that is
+   * invoked when all consumers stop polling, with the first error. When one
+   * consumer stops, the other consumers are stopped as well.
+   *
+   * @return A token that can be used to stop the polling.
+   */
+  client::CancellationToken StartPolling(
+      ContinuousPollSettings settings, ConsumerGroupMessagesHandler handler,
+      ContinuousPollResponseCallback callback);
+
+  /**
+   * @brief Unsubscribes all consumers of the group.
+   *
+   * @param callback The `ConsumerGroupResponseCallback` object that is invoked
+   * when all consumers are unsubscribed, or with the first error.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken Unsubscribe(ConsumerGroupResponseCallback callback);
+
+ private:
+  std::unique_ptr<StreamConsumerGroupImpl> impl_;
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -26,6 +26,7 @@
 #include <olp/core/client/CancellationToken.h>
 #include <olp/core/client/HRN.h>
 #include <olp/core/client/OlpClientSettings.h>
+#include <olp/dataservice/read/ContinuousPollSettings.h>
 #include <olp/dataservice/read/DataServiceReadApi.h>
 #include <olp/dataservice/read/SeekRequest.h>
 #include <olp/dataservice/read/SubscribeRequest.h>
@@ -35,6 +36,7 @@
 namespace olp {
 namespace dataservice {
 namespace read {
+class CatalogClient;
 class StreamLayerClientImpl;
 
 /**
@@ -107,6 +109,19 @@ class DATASERVICE_READ_API StreamLayerClient final {
   StreamLayerClient(client::HRN catalog, std::string layer_id,
                     client::OlpClientSettings settings);
 
+  /**
+   * @brief Creates the `StreamLayerClient` instance that shares the API
+   * lookup cache and the in-flight requests with the other layer clients of
+   * the same `CatalogClient` instance.
+   *
+   * @param catalog_client The `CatalogClient` instance of the catalog that
+   * contains the stream layer. The layer client keeps the shared state alive.
+   * @param layer_id The ID of the layer that the client uses for
+   * requests.
+   */
+  StreamLayerClient(const CatalogClient& catalog_client,
+                    std::string layer_id);
+
   /// Movable, non-copyable
   StreamLayerClient(const StreamLayerClient& other) = delete;
   StreamLayerClient(StreamLayerClient&& other) noexcept;
@@ -201,6 +216,40 @@ class DATASERVICE_READ_API StreamLayerClient final {
   client::CancellableFuture<DataResponse> GetData(
       const model::Message& message);
 
+  /**
+   * @brief Downloads the data of several messages concurrently.
+   *
+   * Use this method instead of `GetData(Message)` for the messages of one
+   * `Poll` call to avoid a round trip per message. The data of at most four
+   * messages is downloaded at the same time, and the concurrent downloads of
+   * the same data handle are shared. The embedded data is returned as is.
+   *
+   * @param messages The `Messages` instance that was retrieved using the `Poll`
+   * method.
+   * @param callback The `MessagesDataResponseCallback` object that is invoked
+   * when the data of all messages is downloaded. It gets a `DataResponse` per
+   * message, in the order of the messages.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetData(const model::Messages& messages,
+                                    MessagesDataResponseCallback callback);
+
+  /**
+   * @brief Downloads the data of several messages concurrently.
+   *
+   * @see `GetData(const model::Messages&, MessagesDataResponseCallback)` for
+   * more details.
+   *
+   * @param messages The `Messages` instance that was retrieved using the `Poll`
+   * method.
+   *
+   * @return `CancellableFuture` that contains a `DataResponse` per message or
+   * an error. You can also use `CancellableFuture` to cancel this request.
+   */
+  client::CancellableFuture<MessagesDataResponse> GetData(
+      const model::Messages& messages);
+
   /**
    * @brief Reads messages from a stream layer and commits successfully
    * consumed messages before returning them to you.
@@ -229,6 +278,33 @@ class DATASERVICE_READ_API StreamLayerClient final {
    */
   client::CancellableFuture<PollResponse> Poll();
 
+  /**
+   * @brief Polls the messages continuously and passes them to the handler.
+   *
+   * Unlike `Poll`, the next batch of messages is already requested while the
+   * handler processes the previous one. The batches are passed to the handler
+   * one by one, in the order they are received. The offsets of a batch are
+   * committed when the handler calls the acknowledgement, and only then the
+   * next batch is passed to the handler. When `max_pending_batches` batches
+   * are not acknowledged, the polling waits until the handler catches up.
+   *
+   * Only possible if subscribed successfully, and the settings of the client
+   * must have a task scheduler.
+   *
+   * @param settings The `ContinuousPollSettings` instance.
+   * @param handler The `PollMessagesHandler` object that is invoked for each
+   * batch of messages. It is invoked on a worker thread, and the
+   * acknowledgement can be called from any thread.
+   * @param callback The `ContinuousPollResponseCallback` object that is
+   * invoked once, when the polling stops because of an error or it is
+   * cancelled.
+   *
+   * @return A token that can be used to stop the polling.
+   */
+  client::CancellationToken StartPolling(
+      ContinuousPollSettings settings, PollMessagesHandler handler,
+      ContinuousPollResponseCallback callback);
+
   /**
    * @brief Allows changing the data stream reading offset.
    *
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <utility>
 
@@ -153,11 +154,71 @@ class DATASERVICE_READ_API SubscribeRequest final {
     return consumer_properties_;
   }
 
+  /**
+   * @brief (Optional) Saves the committed offsets of the subscription.
+   *
+   * The offsets committed by `Poll` and the continuous polling are saved in
+   * the cache under this ID, and the next subscription with the same ID
+   * continues after them. This way, the messages are not consumed again
+   * after the application restarts, even if the subscription expires. The
+   * cache of the client settings is used.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param checkpoint_id The ID of the saved offsets or `boost::none`.
+   *
+   * @return A reference to the updated `SubscribeRequest` instance.
+   */
+  inline SubscribeRequest& WithCheckpointId(
+      boost::optional<std::string> checkpoint_id) {
+    checkpoint_id_ = std::move(checkpoint_id);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the ID of the saved offsets of the subscription.
+   *
+   * @return The checkpoint ID or `boost::none` if the offsets are not saved.
+   */
+  inline const boost::optional<std::string>& GetCheckpointId() const {
+    return checkpoint_id_;
+  }
+
+  /**
+   * @brief Sets how often the committed offsets are saved.
+   *
+   * The commits in between are merged, and the latest offsets are saved
+   * when the client unsubscribes or is destroyed. The messages committed
+   * after the last save can be consumed again after a crash.
+   *
+   * The default value is 1 second.
+   *
+   * @param interval The minimum interval between the saves.
+   *
+   * @return A reference to the updated `SubscribeRequest` instance.
+   */
+  inline SubscribeRequest& WithCheckpointInterval(
+      std::chrono::milliseconds interval) {
+    checkpoint_interval_ = interval;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the minimum interval between the saves of the offsets.
+   *
+   * @return The checkpoint interval.
+   */
+  inline std::chrono::milliseconds GetCheckpointInterval() const {
+    return checkpoint_interval_;
+  }
+
  private:
   SubscriptionMode subscription_mode_{SubscriptionMode::kSerial};
   boost::optional<SubscriptionId> subscription_id_;
   boost::optional<std::string> consumer_id_;
   boost::optional<ConsumerProperties> consumer_properties_;
+  boost::optional<std::string> checkpoint_id_;
+  std::chrono::milliseconds checkpoint_interval_{std::chrono::seconds(1)};
 };
 
 }  // namespace read
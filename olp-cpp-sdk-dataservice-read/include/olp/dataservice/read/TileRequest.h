@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -149,6 +150,92 @@ class DATASERVICE_READ_API TileRequest final {
     return *this;
   }
 
+  /**
+   * @brief Checks whether the gzip-compressed data is decompressed.
+   *
+   * @return True if the data is returned decompressed; false otherwise.
+   */
+  inline bool GetDecompression() const { return decompression_; }
+
+  /**
+   * @brief Sets whether the gzip-compressed data is decompressed.
+   *
+   * When enabled, the data stored with the gzip compression is decompressed
+   * on the task scheduler thread before the callback is invoked, so the
+   * callback receives ready-to-use data. The cache keeps the compressed data.
+   * The data that is not gzip-compressed is returned as it is.
+   *
+   * @note The decompression requires the SDK built with zlib. Otherwise, the
+   * request fails with `ErrorCode::PreconditionFailed` when the data is
+   * compressed.
+   *
+   * @param decompression Whether to decompress the data.
+   *
+   * @return A reference to the updated `TileRequest` instance.
+   */
+  inline TileRequest& WithDecompression(bool decompression) {
+    decompression_ = decompression;
+    return *this;
+  }
+
+  /**
+   * @brief Checks whether the data is verified with the partition checksum.
+   *
+   * @return True if the data is verified; false otherwise.
+   */
+  inline bool GetChecksumVerification() const { return checksum_verification_; }
+
+  /**
+   * @brief Sets whether the data is verified with the partition checksum.
+   *
+   * When enabled and the partition metadata has a SHA-1 checksum, the
+   * downloaded data is verified before it is written to the cache, and
+   * the request fails with `ErrorCode::Unknown` if the data does not match.
+   * The data found in the cache is not verified again. The partitions with
+   * no checksum, or with a checksum of another algorithm, are not verified.
+   *
+   * @param checksum_verification Whether to verify the data.
+   *
+   * @return A reference to the updated `TileRequest` instance.
+   */
+  inline TileRequest& WithChecksumVerification(bool checksum_verification) {
+    checksum_verification_ = checksum_verification;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the end-to-end deadline of the request.
+   *
+   * @return The deadline, or `boost::none` if the request has none.
+   */
+  inline const boost::optional<std::chrono::steady_clock::time_point>&
+  GetDeadline() const {
+    return deadline_;
+  }
+
+  /**
+   * @brief Sets the end-to-end deadline of the request.
+   *
+   * All the stages of the request, such as the API lookup, the catalog
+   * version, the metadata and the data requests, finish by the deadline:
+   * their requests are not waited for or retried after it. If the deadline
+   * is missed, the data found in the cache is returned instead of the error,
+   * from the last cached catalog version if the version is not resolved.
+   * The expired cache entries are not returned.
+   *
+   * @note Only the `GetData` methods of `VersionedLayerClient` apply the
+   * deadline.
+   *
+   * @param deadline The time point by which the request is completed.
+   *
+   * @return A reference to the updated `TileRequest` instance.
+   */
+  inline TileRequest& WithDeadline(
+      std::chrono::steady_clock::time_point deadline) {
+    deadline_ = deadline;
+    return *this;
+  }
+
   /**
    * @brief Creates a readable format for the request.
    *
@@ -171,6 +258,9 @@ class DATASERVICE_READ_API TileRequest final {
   geo::TileKey tile_key_;
   FetchOptions fetch_option_{OnlineIfNotFound};
   uint32_t priority_{thread::NORMAL};
+  bool decompression_{false};
+  bool checksum_verification_{false};
+  boost::optional<std::chrono::steady_clock::time_point> deadline_;
 };
 
 }  // namespace read
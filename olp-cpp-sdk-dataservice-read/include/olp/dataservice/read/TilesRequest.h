@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <olp/core/geo/tiling/TileKey.h>
+#include <olp/core/thread/TaskScheduler.h>
+#include <olp/dataservice/read/DataServiceReadApi.h>
+#include <olp/dataservice/read/FetchOptions.h>
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief Encapsulates the fields required to request the same tiles from
+ * several versioned layers of one catalog.
+ *
+ * Each tile is requested from each layer. The catalog version is resolved
+ * once for all of them.
+ */
+class DATASERVICE_READ_API TilesRequest final {
+ public:
+  /**
+   * @brief Gets the IDs of the versioned layers.
+   *
+   * @return The layer IDs.
+   */
+  inline const std::vector<std::string>& GetLayerIds() const {
+    return layer_ids_;
+  }
+
+  /**
+   * @brief Sets the IDs of the versioned layers from which the tiles are
+   * requested.
+   *
+   * @param layer_ids The layer IDs.
+   *
+   * @return A reference to the updated `TilesRequest` instance.
+   */
+  inline TilesRequest& WithLayerIds(std::vector<std::string> layer_ids) {
+    layer_ids_ = std::move(layer_ids);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the tile keys.
+   *
+   * @return The tile keys.
+   */
+  inline const std::vector<geo::TileKey>& GetTileKeys() const {
+    return tile_keys_;
+  }
+
+  /**
+   * @brief Sets the tile keys that are requested from each layer.
+   *
+   * @param tile_keys The tile keys.
+   *
+   * @return A reference to the updated `TilesRequest` instance.
+   */
+  inline TilesRequest& WithTileKeys(std::vector<geo::TileKey> tile_keys) {
+    tile_keys_ = std::move(tile_keys);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the catalog version of the request.
+   *
+   * @return The catalog version or `boost::none` if the latest version is
+   * used.
+   */
+  inline const boost::optional<int64_t>& GetCatalogVersion() const {
+    return catalog_version_;
+  }
+
+  /**
+   * @brief Sets the catalog version of the request.
+   *
+   * If the version is not set, the latest version is requested once and
+   * shared with the layer clients created from the same `CatalogClient`
+   * instance.
+   *
+   * @param catalog_version The catalog version or `boost::none`.
+   *
+   * @return A reference to the updated `TilesRequest` instance.
+   */
+  inline TilesRequest& WithCatalogVersion(
+      boost::optional<int64_t> catalog_version) {
+    catalog_version_ = std::move(catalog_version);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the billing tag to group billing records together.
+   *
+   * @return The `BillingTag` string or `boost::none` if the billing tag is not
+   * set.
+   */
+  inline const boost::optional<std::string>& GetBillingTag() const {
+    return billing_tag_;
+  }
+
+  /**
+   * @brief Sets the billing tag for the request.
+   *
+   * @param tag The `BillingTag` string or `boost::none`.
+   *
+   * @return A reference to the updated `TilesRequest` instance.
+   */
+  inline TilesRequest& WithBillingTag(boost::optional<std::string> tag) {
+    billing_tag_ = std::move(tag);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the fetch option that controls how requests are handled.
+   *
+   * The default option is `OnlineIfNotFound` that queries the network if
+   * the requested resource is not in the cache.
+   *
+   * @return The fetch option.
+   */
+  inline FetchOptions GetFetchOption() const { return fetch_option_; }
+
+  /**
+   * @brief Sets the fetch option that you can use to set the source from
+   * which data should be fetched.
+   *
+   * @param fetch_option The `FetchOption` enum.
+   *
+   * @return A reference to the updated `TilesRequest` instance.
+   */
+  inline TilesRequest& WithFetchOption(FetchOptions fetch_option) {
+    fetch_option_ = fetch_option;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the request priority.
+   *
+   * The default priority is `Priority::NORMAL`.
+   *
+   * @return The request priority.
+   */
+  inline uint32_t GetPriority() const { return priority_; }
+
+  /**
+   * @brief Sets the priority of the request.
+   *
+   * @param priority The priority of the request.
+   *
+   * @return A reference to the updated `TilesRequest` instance.
+   */
+  inline TilesRequest& WithPriority(uint32_t priority) {
+    priority_ = priority;
+    return *this;
+  }
+
+ private:
+  std::vector<std::string> layer_ids_;
+  std::vector<geo::TileKey> tile_keys_;
+  boost::optional<int64_t> catalog_version_;
+  boost::optional<std::string> billing_tag_;
+  FetchOptions fetch_option_{OnlineIfNotFound};
+  uint32_t priority_{thread::NORMAL};
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -19,17 +19,22 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include <olp/core/client/ApiError.h>
+#include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/ApiResponse.h>
 
 #include <olp/dataservice/read/AggregatedDataResult.h>
 #include <olp/dataservice/read/PrefetchPartitionsResult.h>
 #include <olp/dataservice/read/PrefetchStatus.h>
 #include <olp/dataservice/read/model/Catalog.h>
+#include <olp/dataservice/read/model/CompactPartitions.h>
 #include <olp/dataservice/read/model/Data.h>
 #include <olp/dataservice/read/model/Messages.h>
 #include <olp/dataservice/read/model/Partitions.h>
@@ -71,6 +76,20 @@ using PartitionsResponse = Response<PartitionsResult>;
 /// The callback type of the partition metadata response.
 using PartitionsResponseCallback = Callback<PartitionsResult>;
 
+/// The alias type of the compact partition metadata result.
+using CompactPartitionsResult = model::CompactPartitions;
+/// The compact partition metadata response type.
+using CompactPartitionsResponse = Response<CompactPartitionsResult>;
+/// The callback type of the compact partition metadata response.
+using CompactPartitionsResponseCallback = Callback<CompactPartitionsResult>;
+
+/// The callback type that receives the partitions of a stream in chunks.
+using PartitionsChunkCallback = std::function<void(PartitionsResult)>;
+/// The partitions stream response type.
+using PartitionsStreamResponse = Response<client::ApiNoResult>;
+/// The callback type of the partitions stream response.
+using PartitionsStreamResponseCallback = Callback<client::ApiNoResult>;
+
 /// The `Data` alias type.
 using DataResult = model::Data;
 /// The data response alias.
@@ -78,6 +97,15 @@ using DataResponse = Response<DataResult>;
 /// The callback type of the data response.
 using DataResponseCallback = Callback<DataResult>;
 
+/// The callback type that receives the data of a stream in chunks, with the
+/// offset of each chunk in the data.
+using DataChunkCallback = std::function<void(
+    const std::uint8_t* data, std::uint64_t offset, std::size_t length)>;
+/// The data stream response type.
+using DataStreamResponse = Response<client::ApiNoResult>;
+/// The callback type of the data stream response.
+using DataStreamResponseCallback = Callback<client::ApiNoResult>;
+
 /// The aggregated data response alias.
 using AggregatedDataResponse = Response<AggregatedDataResult>;
 /// The callback type of the aggregated data response.
@@ -91,6 +119,9 @@ using PrefetchTilesResponse = Response<PrefetchTilesResult>;
 using PrefetchTilesResponseCallback = Callback<PrefetchTilesResult>;
 /// The callback type for the prefetch status update.
 using PrefetchStatusCallback = std::function<void(PrefetchStatus)>;
+/// The callback type of the result of a prefetched tile.
+using PrefetchTileResultCallback =
+    std::function<void(const PrefetchTileResult&)>;
 
 /// The prefetch partitions response type.
 using PrefetchPartitionsResponse = Response<PrefetchPartitionsResult>;
@@ -119,6 +150,23 @@ using PollResponse = Response<MessagesResult>;
 /// The poll completion callback type of the stream layer client.
 using PollResponseCallback = Callback<MessagesResult>;
 
+/// The data responses of the messages, in the order of the messages.
+using MessagesDataResult = std::vector<DataResponse>;
+/// The batch get data response type of the stream layer client.
+using MessagesDataResponse = Response<MessagesDataResult>;
+/// The batch get data completion callback type of the stream layer client.
+using MessagesDataResponseCallback = Callback<MessagesDataResult>;
+
+/// Acknowledges that the messages of a continuous poll are processed.
+using PollAcknowledgement = std::function<void()>;
+/// The messages handler type of the continuous polling.
+using PollMessagesHandler =
+    std::function<void(MessagesResult, PollAcknowledgement)>;
+/// The response type of the continuous polling, returned when it stops.
+using ContinuousPollResponse = Response<client::ApiNoResult>;
+/// The completion callback type of the continuous polling.
+using ContinuousPollResponseCallback = Callback<client::ApiNoResult>;
+
 /** @brief The alias of the seek response result.
  *
  * The status of the HTTP request.
@@ -138,6 +186,14 @@ using VersionsResponseCallback = Callback<VersionsResult>;
 
 /// The list of tile keys.
 using TileKeys = std::vector<geo::TileKey>;
+
+/// The callback type of the data of one tile of one layer.
+using TileDataCallback = std::function<void(
+    const std::string& layer_id, const geo::TileKey& tile, DataResponse)>;
+/// The response type of the multi-layer tiles request.
+using TilesResponse = Response<client::ApiNoResult>;
+/// The completion callback type of the multi-layer tiles request.
+using TilesResponseCallback = Callback<client::ApiNoResult>;
 }  // namespace read
 }  // namespace dataservice
 }  // namespace olp
@@ -28,19 +28,24 @@
 #include <olp/core/client/CancellationToken.h>
 #include <olp/core/client/HRN.h>
 #include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/geo/Types.h>
+#include <olp/dataservice/read/CatalogVersionRequest.h>
 #include <olp/dataservice/read/DataRequest.h>
 #include <olp/dataservice/read/DataServiceReadApi.h>
 #include <olp/dataservice/read/PartitionsRequest.h>
 #include <olp/dataservice/read/PrefetchPartitionsRequest.h>
 #include <olp/dataservice/read/PrefetchTileResult.h>
 #include <olp/dataservice/read/PrefetchTilesRequest.h>
+#include <olp/dataservice/read/SpeculativePrefetchSettings.h>
 #include <olp/dataservice/read/TileRequest.h>
 #include <olp/dataservice/read/Types.h>
+#include <olp/dataservice/read/VersionedLayerReadSession.h>
 #include <boost/optional.hpp>
 
 namespace olp {
 namespace dataservice {
 namespace read {
+class CatalogClient;
 class VersionedLayerClientImpl;
 
 // clang-format off
@@ -126,6 +131,27 @@ class DATASERVICE_READ_API VersionedLayerClient final {
                        boost::optional<int64_t> catalog_version,
                        client::OlpClientSettings settings);
 
+  /**
+   * @brief Creates the `VersionedLayerClient` instance that shares the API
+   * lookup cache, the in-flight requests, and the resolved catalog version
+   * with the other layer clients of the same `CatalogClient` instance.
+   *
+   * If no catalog version is specified, all the layer clients created from
+   * the `CatalogClient` instance use the version that is resolved first.
+   *
+   * @param catalog_client The `CatalogClient` instance of the catalog that
+   * contains the versioned layer. The layer client keeps the shared state
+   * alive.
+   * @param layer_id The layer ID of the versioned layer from which you want to
+   * get data.
+   * @param catalog_version The version of the catalog from which you want
+   * to get data. If no version is specified, the last available version is
+   * used instead.
+   */
+  VersionedLayerClient(const CatalogClient& catalog_client,
+                       std::string layer_id,
+                       boost::optional<int64_t> catalog_version);
+
   /// Movable, non-copyable
   VersionedLayerClient(const VersionedLayerClient& other) = delete;
   VersionedLayerClient(VersionedLayerClient&& other) noexcept;
@@ -141,6 +167,35 @@ class DATASERVICE_READ_API VersionedLayerClient final {
    */
   bool CancelPendingRequests();
 
+  /**
+   * @brief Opens a read session pinned to the latest catalog version.
+   *
+   * The latest version is resolved once with the fetch option and the billing
+   * tag of the request, and the requests of the session use it without
+   * looking it up again. The version of this client is not changed.
+   *
+   * @param request The `CatalogVersionRequest` instance that contains
+   * the parameters of the version lookup.
+   * @param callback The `ReadSessionCallback` object that is invoked with the
+   * opened session or an error.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken OpenReadSession(CatalogVersionRequest request,
+                                            ReadSessionCallback callback);
+
+  /**
+   * @brief Opens a read session pinned to the latest catalog version.
+   *
+   * @param request The `CatalogVersionRequest` instance that contains
+   * the parameters of the version lookup.
+   *
+   * @return `CancellableFuture` that contains the `ReadSessionResponse`
+   * instance or an error.
+   */
+  client::CancellableFuture<ReadSessionResponse> OpenReadSession(
+      CatalogVersionRequest request);
+
   /**
    * @brief Fetches data asynchronously using a partition ID or data handle.
    *
@@ -181,6 +236,36 @@ class DATASERVICE_READ_API VersionedLayerClient final {
    */
   client::CancellableFuture<DataResponse> GetData(DataRequest data_request);
 
+  /**
+   * @brief Fetches data asynchronously using a partition ID or data handle,
+   * and passes it to the callback in chunks as it is downloaded.
+   *
+   * Unlike `GetData`, the data is not buffered into `model::Data`, so it can
+   * be decoded before the download completes. With the `OnlineOnly` fetch
+   * option, the memory used by the request is bounded by the size of the
+   * network chunks. With the other fetch options, the data is also collected
+   * to store it in the cache once it is downloaded, and a cached blob is
+   * passed as one chunk.
+   *
+   * If the download is retried, the data is passed again from offset 0. If
+   * the `callback` receives an error, the chunks passed so far must be
+   * discarded, as they may contain the error body or unverified data.
+   *
+   * @param data_request The `DataRequest` instance that contains a complete set
+   * of request parameters.
+   * @note CacheWithUpdate fetch option and the decompression are not
+   * supported.
+   * @param chunk_callback The `DataChunkCallback` object that is invoked for
+   * each chunk of data. It is invoked on a network thread.
+   * @param callback The `DataStreamResponseCallback` object that is invoked
+   * when all chunks are delivered or an error is encountered.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken StreamData(DataRequest data_request,
+                                       DataChunkCallback chunk_callback,
+                                       DataStreamResponseCallback callback);
+
   /**
    * @brief Fetches data asynchronously using a TileKey.
    *
@@ -228,6 +313,19 @@ class DATASERVICE_READ_API VersionedLayerClient final {
    */
   client::CancellableFuture<DataResponse> GetData(TileRequest request);
 
+  /**
+   * @brief Configures the speculative prefetch of the neighbor tiles.
+   *
+   * After `GetData(TileRequest)` serves a tile, the data of its neighbors is
+   * downloaded to the cache in the background, within the byte budget of
+   * the settings. The neighbors are only downloaded when their partitions
+   * are known from the cached quadtree, so no metadata requests are sent.
+   *
+   * @param settings The `SpeculativePrefetchSettings` instance. Disabling the
+   * prefetch cancels the running prefetch task.
+   */
+  void SetSpeculativePrefetch(SpeculativePrefetchSettings settings);
+
   /**
    * @brief Fetches data of a tile or its closest ancestor.
    *
@@ -295,6 +393,70 @@ class DATASERVICE_READ_API VersionedLayerClient final {
   client::CancellableFuture<PartitionsResponse> GetPartitions(
       PartitionsRequest partitions_request);
 
+  /**
+   * @brief Fetches a list of generic layer partitions asynchronously and keeps
+   * only the requested fields.
+   *
+   * The partitions are stored in columns, so the result uses much less memory
+   * than `PartitionsResult` for layers with lots of partitions.
+   *
+   * @param partitions_request The `PartitionsRequest` instance that contains
+   * a complete set of request parameters.
+   * @param fields The partition fields to keep, a combination of
+   * `model::CompactPartitions::Fields` values. The partition ID is always kept.
+   * @param callback The `CompactPartitionsResponseCallback` object that is
+   * invoked if the list of partitions is available or an error is encountered.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetCompactPartitions(
+      PartitionsRequest partitions_request, uint32_t fields,
+      CompactPartitionsResponseCallback callback);
+
+  /**
+   * @brief Fetches a list of generic layer partitions asynchronously and keeps
+   * only the requested fields.
+   *
+   * The partitions are stored in columns, so the result uses much less memory
+   * than `PartitionsResult` for layers with lots of partitions.
+   *
+   * @param partitions_request The `PartitionsRequest` instance that contains
+   * a complete set of request parameters.
+   * @param fields The partition fields to keep, a combination of
+   * `model::CompactPartitions::Fields` values. The partition ID is always kept.
+   *
+   * @return `CancellableFuture` that contains the `CompactPartitionsResponse`
+   * instance with data or an error. You can also use `CancellableFuture` to
+   * cancel this request.
+   */
+  client::CancellableFuture<CompactPartitionsResponse> GetCompactPartitions(
+      PartitionsRequest partitions_request, uint32_t fields);
+
+  /**
+   * @brief Fetches a list of partitions of the given generic layer in chunks
+   * asynchronously.
+   *
+   * Unlike `GetPartitions`, the list is downloaded in byte ranges, and the
+   * partitions of each range are passed to `chunk_callback` as soon as they
+   * are parsed. The whole list is never kept in memory, so use this method for
+   * layers with lots of partitions. The size of the ranges is
+   * `OlpClientSettings::download_chunk_size`, or 4 MB if it is not set.
+   *
+   * @param partitions_request The `PartitionsRequest` instance that contains
+   * a complete set of request parameters.
+   * @note CacheWithUpdate fetch option is not supported.
+   * @param chunk_callback The `PartitionsChunkCallback` object that is invoked
+   * for each chunk of partitions. It is invoked on a worker thread.
+   * @param callback The `PartitionsStreamResponseCallback` object that is
+   * invoked when all chunks are delivered or an error is encountered.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken StreamPartitions(
+      PartitionsRequest partitions_request,
+      PartitionsChunkCallback chunk_callback,
+      PartitionsStreamResponseCallback callback);
+
   /**
    * @brief Prefetches a set of tiles asynchronously.
    *
@@ -324,6 +486,33 @@ class DATASERVICE_READ_API VersionedLayerClient final {
       PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
       PrefetchStatusCallback status_callback = nullptr);
 
+  /**
+   * @brief Prefetches a set of tiles asynchronously and reports the result of
+   * each tile as soon as it is fetched.
+   *
+   * Works like the other `PrefetchTiles` methods, but the tile results are not
+   * kept until the prefetch completes, so large prefetches need less memory.
+   * The `PrefetchTilesResult` instance passed to `callback` is empty; use
+   * `status_callback` to get the number of the fetched tiles.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param request The `PrefetchTilesRequest` instance that contains
+   * a complete set of request parameters.
+   * @param tile_callback The `PrefetchTileResultCallback` object that is
+   * invoked every time a tile is fetched. It is not invoked concurrently.
+   * @param callback The `PrefetchTilesResponseCallback` object that is invoked
+   * when the prefetch completes or an error is encountered.
+   * @param status_callback The `PrefetchStatusCallback` object that is invoked
+   * every time a tile is fetched.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken PrefetchTiles(
+      PrefetchTilesRequest request, PrefetchTileResultCallback tile_callback,
+      PrefetchTilesResponseCallback callback,
+      PrefetchStatusCallback status_callback = nullptr);
+
   /**
    * @brief Prefetches a set of tiles asynchronously.
    *
@@ -454,6 +643,76 @@ class DATASERVICE_READ_API VersionedLayerClient final {
    */
   bool IsCached(const geo::TileKey& tile, bool aggregated = false) const;
 
+  /**
+   * @brief Gets the partition data from the cache on the calling thread.
+   *
+   * Unlike `GetData` with `CacheOnly`, no task is scheduled, so a cache hit
+   * costs no thread switch. Use `GetData` if the data is not cached.
+   *
+   * @param partition_id The partition ID.
+   *
+   * @note Before calling the API, specify a layer version. You can set it using
+   * the constructor or after the first online request.
+   *
+   * @return `DataResponse` that contains the cached data, or the `NotFound`
+   * error if the data is not cached.
+   */
+  DataResponse GetCachedData(const std::string& partition_id) const;
+
+  /**
+   * @brief Gets the tile data from the cache on the calling thread.
+   *
+   * Unlike `GetData` with `CacheOnly`, no task is scheduled, so a cache hit
+   * costs no thread switch. Use `GetData` if the data is not cached.
+   *
+   * @param tile The tile key.
+   *
+   * @note Before calling the API, specify a layer version. You can set it using
+   * the constructor or after the first online request.
+   *
+   * @return `DataResponse` that contains the cached data, or the `NotFound`
+   * error if the data is not cached.
+   */
+  DataResponse GetCachedData(const geo::TileKey& tile) const;
+
+  /**
+   * @brief Gets the cached tiles from a list of tiles.
+   *
+   * The same as calling `IsCached()` for each tile, but each quadtree is read
+   * from the cache only once for all the tiles it contains.
+   *
+   * @param tiles The tile keys.
+   * @param aggregated The aggregated flag, used to specify whether the tiles
+   * are aggregated or not.
+   *
+   * @note Before calling the API, specify a layer version. You can set it using
+   * the constructor or after the first online request.
+   *
+   * @return The tiles which data is cached, in the order of `tiles`.
+   */
+  TileKeys GetCachedTiles(const TileKeys& tiles, bool aggregated = false) const;
+
+  /**
+   * @brief Gets the cached tiles of a level that overlap with a geographic
+   * rectangle.
+   *
+   * The tiles of the rectangle are checked one by one without building the
+   * list of all of them, so the rectangle may contain many tiles.
+   *
+   * @param area The geographic rectangle.
+   * @param level The level of the tiles.
+   * @param aggregated The aggregated flag, used to specify whether the tiles
+   * are aggregated or not.
+   *
+   * @note Before calling the API, specify a layer version. You can set it using
+   * the constructor or after the first online request.
+   *
+   * @return The tiles which data is cached. The number of the cached tiles is
+   * the size of the result.
+   */
+  TileKeys GetCachedTiles(const geo::GeoRectangle& area, std::uint32_t level,
+                          bool aggregated = false) const;
+
   /**
    * @brief Protects tile keys from eviction.
    *
@@ -500,6 +759,47 @@ class DATASERVICE_READ_API VersionedLayerClient final {
    */
   bool Release(const TileKeys& tiles);
 
+  /**
+   * @brief Protects the tiles of the area from eviction.
+   *
+   * Works as `Protect` for the tiles, but finds the tiles in the cached
+   * quadtrees of the area, so you do not need to list them. The quadtrees
+   * are looked up with the same roots as `PrefetchTiles` uses for the area and
+   * levels, so protect the area that you prefetched.
+   *
+   * @note Before calling the API, specify a layer version. You can set it using
+   * the constructor or after the first online request.
+   *
+   * @param area The area which tiles are protected.
+   * @param min_level The minimum level of the protected tiles.
+   * @param max_level The maximum level of the protected tiles.
+   *
+   * @return True if some keys were successfully added to the protected list;
+   * false otherwise.
+   */
+  bool Protect(const geo::GeoRectangle& area, std::uint32_t min_level,
+               std::uint32_t max_level);
+
+  /**
+   * @brief Removes the tiles of the area from protection.
+   *
+   * Works as `Release` for the tiles, but finds the tiles in the cached
+   * quadtrees of the area, so you do not need to list them. A quadtree stays
+   * protected while it has protected tiles outside of the area or levels.
+   *
+   * @note Before calling the API, specify a layer version. You can set it using
+   * the constructor or after the first online request.
+   *
+   * @param area The area which tiles are removed from protection.
+   * @param min_level The minimum level of the released tiles.
+   * @param max_level The maximum level of the released tiles.
+   *
+   * @return True if some keys were successfully removed from the protected
+   * list; false otherwise.
+   */
+  bool Release(const geo::GeoRectangle& area, std::uint32_t min_level,
+               std::uint32_t max_level);
+
  private:
   std::unique_ptr<VersionedLayerClientImpl> impl_;
 };
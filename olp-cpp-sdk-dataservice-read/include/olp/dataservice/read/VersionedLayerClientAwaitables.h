@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <olp/core/client/Awaitable.h>
+
+#if defined(OLP_SDK_ENABLE_COROUTINES) && defined(__cpp_impl_coroutine)
+
+#include <memory>
+#include <utility>
+
+#include <olp/dataservice/read/VersionedLayerClient.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief Awaits `VersionedLayerClient::GetData` in a C++20 coroutine.
+ *
+ * @param client The client. It must outlive the call.
+ * @param request The `DataRequest` instance.
+ * @param task_scheduler The task scheduler that resumes the coroutine,
+ * usually the one of the client settings.
+ * @param context The context that cancels the call.
+ *
+ * @return The awaitable `DataResponse` instance.
+ */
+inline client::Awaitable<DataResponse> AwaitData(
+    VersionedLayerClient& client, DataRequest request,
+    std::shared_ptr<thread::TaskScheduler> task_scheduler,
+    client::CancellationContext context = client::CancellationContext()) {
+  return client::Awaitable<DataResponse>(
+      [&client, request](DataResponseCallback callback) {
+        return client.GetData(request, std::move(callback));
+      },
+      std::move(task_scheduler), std::move(context));
+}
+
+/**
+ * @brief Awaits `VersionedLayerClient::GetPartitions` in a C++20 coroutine.
+ *
+ * @param client The client. It must outlive the call.
+ * @param request The `PartitionsRequest` instance.
+ * @param task_scheduler The task scheduler that resumes the coroutine,
+ * usually the one of the client settings.
+ * @param context The context that cancels the call.
+ *
+ * @return The awaitable `PartitionsResponse` instance.
+ */
+inline client::Awaitable<PartitionsResponse> AwaitPartitions(
+    VersionedLayerClient& client, PartitionsRequest request,
+    std::shared_ptr<thread::TaskScheduler> task_scheduler,
+    client::CancellationContext context = client::CancellationContext()) {
+  return client::Awaitable<PartitionsResponse>(
+      [&client, request](PartitionsResponseCallback callback) {
+        return client.GetPartitions(request, std::move(callback));
+      },
+      std::move(task_scheduler), std::move(context));
+}
+
+/**
+ * @brief Awaits `VersionedLayerClient::PrefetchTiles` in a C++20 coroutine.
+ *
+ * @param client The client. It must outlive the call.
+ * @param request The `PrefetchTilesRequest` instance.
+ * @param task_scheduler The task scheduler that resumes the coroutine,
+ * usually the one of the client settings.
+ * @param context The context that cancels the call.
+ * @param status_callback The optional prefetch progress callback.
+ *
+ * @return The awaitable `PrefetchTilesResponse` instance.
+ */
+inline client::Awaitable<PrefetchTilesResponse> AwaitPrefetchTiles(
+    VersionedLayerClient& client, PrefetchTilesRequest request,
+    std::shared_ptr<thread::TaskScheduler> task_scheduler,
+    client::CancellationContext context = client::CancellationContext(),
+    PrefetchStatusCallback status_callback = nullptr) {
+  return client::Awaitable<PrefetchTilesResponse>(
+      [&client, request,
+       status_callback](PrefetchTilesResponseCallback callback) {
+        return client.PrefetchTiles(request, std::move(callback),
+                                    status_callback);
+      },
+      std::move(task_scheduler), std::move(context));
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
+
+#endif  // OLP_SDK_ENABLE_COROUTINES && __cpp_impl_coroutine
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <olp/core/client/ApiResponse.h>
+#include <olp/core/client/CancellationToken.h>
+#include <olp/dataservice/read/DataRequest.h>
+#include <olp/dataservice/read/DataServiceReadApi.h>
+#include <olp/dataservice/read/PartitionsRequest.h>
+#include <olp/dataservice/read/PrefetchTilesRequest.h>
+#include <olp/dataservice/read/TileRequest.h>
+#include <olp/dataservice/read/Types.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+class VersionedLayerClient;
+class VersionedLayerClientImpl;
+
+/**
+ * @brief Reads a versioned layer at one catalog version.
+ *
+ * The version is resolved once when the session is opened with
+ * `VersionedLayerClient::OpenReadSession`, and all the requests of the
+ * session use it without looking it up again. The session shares the cache,
+ * the API lookup, and the in-flight requests with the client that opened it.
+ *
+ * To find out whether the catalog has a newer version, call
+ * `CheckForNewerVersion`, and open a new session when it is the case.
+ */
+class DATASERVICE_READ_API VersionedLayerReadSession final {
+ public:
+  /// Movable, non-copyable
+  VersionedLayerReadSession(const VersionedLayerReadSession& other) = delete;
+  VersionedLayerReadSession(VersionedLayerReadSession&& other) noexcept;
+  VersionedLayerReadSession& operator=(
+      const VersionedLayerReadSession& other) = delete;
+  VersionedLayerReadSession& operator=(
+      VersionedLayerReadSession&& other) noexcept;
+
+  ~VersionedLayerReadSession();
+
+  /**
+   * @brief Gets the catalog version that the session reads.
+   *
+   * @return The pinned catalog version.
+   */
+  int64_t GetVersion() const;
+
+  /**
+   * @brief Cancels all the active and pending requests of the session.
+   *
+   * @return True if the request is successful; false otherwise.
+   */
+  bool CancelPendingRequests();
+
+  /**
+   * @brief Fetches data of the pinned version using a partition ID or data
+   * handle.
+   *
+   * Works as `VersionedLayerClient::GetData`.
+   *
+   * @param data_request The `DataRequest` instance that contains a complete set
+   * of request parameters.
+   * @param callback The `DataResponseCallback` object that is invoked if
+   * the `DataResult` object is available or an error is encountered.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetData(DataRequest data_request,
+                                    DataResponseCallback callback);
+
+  /**
+   * @brief Fetches data of the pinned version using a partition ID or data
+   * handle.
+   *
+   * @param data_request The `DataRequest` instance that contains a complete set
+   * of request parameters.
+   *
+   * @return `CancellableFuture` that contains the `DataResponse` instance
+   * or an error.
+   */
+  client::CancellableFuture<DataResponse> GetData(DataRequest data_request);
+
+  /**
+   * @brief Fetches data of a tile of the pinned version.
+   *
+   * Works as `VersionedLayerClient::GetData` for tiles.
+   *
+   * @param request The `TileRequest` instance that contains a complete set
+   * of request parameters.
+   * @param callback The `DataResponseCallback` object that is invoked if
+   * the `DataResult` object is available or an error is encountered.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetData(TileRequest request,
+                                    DataResponseCallback callback);
+
+  /**
+   * @brief Fetches data of a tile of the pinned version.
+   *
+   * @param request The `TileRequest` instance that contains a complete set
+   * of request parameters.
+   *
+   * @return `CancellableFuture` that contains the `DataResponse` instance
+   * or an error.
+   */
+  client::CancellableFuture<DataResponse> GetData(TileRequest request);
+
+  /**
+   * @brief Fetches the partitions metadata of the pinned version.
+   *
+   * @param partitions_request The `PartitionsRequest` instance that contains
+   * a complete set of request parameters.
+   * @param callback The `PartitionsResponseCallback` object that is invoked if
+   * the list of partitions is available or an error is encountered.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetPartitions(PartitionsRequest partitions_request,
+                                          PartitionsResponseCallback callback);
+
+  /**
+   * @brief Fetches the partitions metadata of the pinned version.
+   *
+   * @param partitions_request The `PartitionsRequest` instance that contains
+   * a complete set of request parameters.
+   *
+   * @return `CancellableFuture` that contains the `PartitionsResponse`
+   * instance or an error.
+   */
+  client::CancellableFuture<PartitionsResponse> GetPartitions(
+      PartitionsRequest partitions_request);
+
+  /**
+   * @brief Prefetches the tiles of the pinned version into the cache.
+   *
+   * Works as `VersionedLayerClient::PrefetchTiles`.
+   *
+   * @param request The `PrefetchTilesRequest` instance that contains
+   * a complete set of request parameters.
+   * @param callback The `PrefetchTilesResponseCallback` object that is invoked
+   * when the prefetch is finished.
+   * @param status_callback The `PrefetchStatusCallback` object that is invoked
+   * every time a tile is fetched.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken PrefetchTiles(
+      PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+      PrefetchStatusCallback status_callback = nullptr);
+
+  /**
+   * @brief Prefetches the tiles of the pinned version into the cache.
+   *
+   * @param request The `PrefetchTilesRequest` instance that contains
+   * a complete set of request parameters.
+   * @param status_callback The `PrefetchStatusCallback` object that is invoked
+   * every time a tile is fetched.
+   *
+   * @return `CancellableFuture` that contains the `PrefetchTilesResponse`
+   * instance or an error.
+   */
+  client::CancellableFuture<PrefetchTilesResponse> PrefetchTiles(
+      PrefetchTilesRequest request,
+      PrefetchStatusCallback status_callback = nullptr);
+
+  /**
+   * @brief Gets the latest catalog version online.
+   *
+   * Sends one request, the other requests of the session are not affected.
+   * When the result is greater than `GetVersion`, the catalog has a newer
+   * version.
+   *
+   * @param callback The `CatalogVersionCallback` object that is invoked with
+   * the latest catalog version or an error.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken CheckForNewerVersion(
+      CatalogVersionCallback callback);
+
+ private:
+  friend class VersionedLayerClient;
+
+  VersionedLayerReadSession(std::shared_ptr<VersionedLayerClientImpl> impl,
+                            int64_t version);
+
+  std::shared_ptr<VersionedLayerClientImpl> impl_;
+  int64_t version_;
+};
+
+/// The read session result type.
+using ReadSessionResult = std::shared_ptr<VersionedLayerReadSession>;
+/// The read session response type.
+using ReadSessionResponse = Response<ReadSessionResult>;
+/// The read session response callback type.
+using ReadSessionCallback = Callback<ReadSessionResult>;
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -36,6 +36,7 @@
 namespace olp {
 namespace dataservice {
 namespace read {
+class CatalogClient;
 class VolatileLayerClientImpl;
 
 // clang-format off
@@ -92,6 +93,19 @@ class DATASERVICE_READ_API VolatileLayerClient final {
   VolatileLayerClient(client::HRN catalog, std::string layer_id,
                       client::OlpClientSettings settings);
 
+  /**
+   * @brief Creates the `VolatileLayerClient` instance that shares the API
+   * lookup cache and the in-flight requests with the other layer clients of
+   * the same `CatalogClient` instance.
+   *
+   * @param catalog_client The `CatalogClient` instance of the catalog that
+   * contains the volatile layer. The layer client keeps the shared state alive.
+   * @param layer_id The layer ID of the volatile layer from which you want to
+   * get data.
+   */
+  VolatileLayerClient(const CatalogClient& catalog_client,
+                      std::string layer_id);
+
   /// Movable, non-copyable
   VolatileLayerClient(const VolatileLayerClient& other) = delete;
   VolatileLayerClient(VolatileLayerClient&& other) noexcept;
@@ -141,6 +155,45 @@ class DATASERVICE_READ_API VolatileLayerClient final {
   olp::client::CancellableFuture<PartitionsResponse> GetPartitions(
       PartitionsRequest request);
 
+  /**
+   * @brief Fetches a list of volatile layer partitions asynchronously and keeps
+   * only the requested fields.
+   *
+   * The partitions are stored in columns, so the result uses much less memory
+   * than `PartitionsResult` for layers with lots of partitions.
+   *
+   * @param request The `PartitionsRequest` instance that contains
+   * a complete set of request parameters.
+   * @param fields The partition fields to keep, a combination of
+   * `model::CompactPartitions::Fields` values. The partition ID is always kept.
+   * @param callback The `CompactPartitionsResponseCallback` object that is
+   * invoked if the list of partitions is available or an error is encountered.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetCompactPartitions(
+      PartitionsRequest request, uint32_t fields,
+      CompactPartitionsResponseCallback callback);
+
+  /**
+   * @brief Fetches a list of volatile layer partitions asynchronously and keeps
+   * only the requested fields.
+   *
+   * The partitions are stored in columns, so the result uses much less memory
+   * than `PartitionsResult` for layers with lots of partitions.
+   *
+   * @param request The `PartitionsRequest` instance that contains
+   * a complete set of request parameters.
+   * @param fields The partition fields to keep, a combination of
+   * `model::CompactPartitions::Fields` values. The partition ID is always kept.
+   *
+   * @return `CancellableFuture` that contains the `CompactPartitionsResponse`
+   * instance with data or an error. You can also use `CancellableFuture` to
+   * cancel this request.
+   */
+  olp::client::CancellableFuture<CompactPartitionsResponse>
+  GetCompactPartitions(PartitionsRequest request, uint32_t fields);
+
   /**
    * @brief Fetches data asynchronously using a partition ID or data handle.
    *
@@ -220,6 +273,29 @@ class DATASERVICE_READ_API VolatileLayerClient final {
   client::CancellationToken PrefetchTiles(
       PrefetchTilesRequest request, PrefetchTilesResponseCallback callback);
 
+  /**
+   * @brief Prefetches a set of tiles asynchronously and reports the result of
+   * each tile as soon as it is fetched.
+   *
+   * Works like the other `PrefetchTiles` methods, but the tile results are not
+   * kept until the prefetch completes, so large prefetches need less memory.
+   * The `PrefetchTilesResult` instance passed to `callback` is empty.
+   *
+   * @note Experimental. API may change.
+   *
+   * @param request The `PrefetchTilesRequest` instance that contains
+   * a complete set of request parameters.
+   * @param tile_callback The `PrefetchTileResultCallback` object that is
+   * invoked every time a tile is fetched. It is not invoked concurrently.
+   * @param callback The `PrefetchTilesResponseCallback` object that is invoked
+   * when the prefetch completes or an error is encountered.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken PrefetchTiles(
+      PrefetchTilesRequest request, PrefetchTileResultCallback tile_callback,
+      PrefetchTilesResponseCallback callback);
+
   /**
    * @brief Prefetches a set of tiles asynchronously.
    *
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/utility/string_ref.hpp>
+
+#include <olp/dataservice/read/DataServiceReadApi.h>
+#include <olp/dataservice/read/model/Partitions.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace model {
+
+class CompactPartitions;
+
+/**
+ * @brief A read-only view of a partition stored in `CompactPartitions`.
+ *
+ * The view refers to the storage of the `CompactPartitions` instance, so it
+ * must not outlive it. The fields that were not projected are empty.
+ */
+class DATASERVICE_READ_API PartitionView {
+ public:
+  /**
+   * @brief Gets the partition ID.
+   *
+   * @return The partition ID.
+   */
+  boost::string_ref GetPartition() const;
+
+  /**
+   * @brief Gets the handle that can be used to retrieve the partition data.
+   *
+   * @return The data handle, or an empty string if it was not projected.
+   */
+  boost::string_ref GetDataHandle() const;
+
+  /**
+   * @brief Gets the partition checksum.
+   *
+   * @return The checksum, or none if it is not set or was not projected.
+   */
+  boost::optional<boost::string_ref> GetChecksum() const;
+
+  /**
+   * @brief Gets the size of the non-compressed partition data in bytes.
+   *
+   * @return The data size, or none if it is not set or was not projected.
+   */
+  boost::optional<int64_t> GetDataSize() const;
+
+  /**
+   * @brief Gets the size of the compressed partition data in bytes.
+   *
+   * @return The compressed data size, or none if it is not set or was not
+   * projected.
+   */
+  boost::optional<int64_t> GetCompressedDataSize() const;
+
+  /**
+   * @brief Gets the partition CRC.
+   *
+   * @return The CRC, or none if it is not set or was not projected.
+   */
+  boost::optional<boost::string_ref> GetCrc() const;
+
+  /**
+   * @brief Gets the catalog version when the partition was last changed.
+   *
+   * @return The version, or none if it is not set or was not projected.
+   */
+  boost::optional<int64_t> GetVersion() const;
+
+  /**
+   * @brief Copies the projected fields to a new `Partition` instance.
+   *
+   * @return The `Partition` instance.
+   */
+  Partition Materialize() const;
+
+ private:
+  friend class CompactPartitions;
+
+  PartitionView(const CompactPartitions* partitions, size_t index)
+      : partitions_(partitions), index_(index) {}
+
+  const CompactPartitions* partitions_;
+  size_t index_;
+};
+
+/**
+ * @brief A collection of layer partitions stored in columns.
+ *
+ * Each projected field is stored in one column: the strings of all
+ * partitions share one buffer, and the numbers share one array. Compared to
+ * `Partitions`, this needs a few allocations in total instead of several
+ * allocations per partition, and the fields that were not projected take no
+ * memory at all. Use `operator[]` to access a partition without copying it.
+ */
+class DATASERVICE_READ_API CompactPartitions {
+ public:
+  /// The partition fields that can be projected.
+  enum Fields : uint32_t {
+    kPartition = 1u << 0,
+    kDataHandle = 1u << 1,
+    kChecksum = 1u << 2,
+    kDataSize = 1u << 3,
+    kCompressedDataSize = 1u << 4,
+    kCrc = 1u << 5,
+    kVersion = 1u << 6,
+    kAllFields = (1u << 7) - 1u
+  };
+
+  /**
+   * @brief Creates an empty `CompactPartitions` instance.
+   *
+   * @param fields The fields to store, a combination of `Fields` values. The
+   * partition ID is always stored.
+   */
+  explicit CompactPartitions(uint32_t fields = kAllFields);
+
+  /**
+   * @brief Creates the `CompactPartitions` instance from the partitions.
+   *
+   * @param partitions The partitions to store.
+   * @param fields The fields to store, a combination of `Fields` values. The
+   * partition ID is always stored.
+   */
+  explicit CompactPartitions(const Partitions& partitions,
+                             uint32_t fields = kAllFields);
+
+  /**
+   * @brief Adds the projected fields of the partition to the collection.
+   *
+   * @param partition The partition to add.
+   */
+  void Append(const Partition& partition);
+
+  /**
+   * @brief Reserves the memory for the partitions.
+   *
+   * @param count The number of partitions.
+   */
+  void Reserve(size_t count);
+
+  /**
+   * @brief Gets the fields that are stored.
+   *
+   * @return The combination of `Fields` values.
+   */
+  uint32_t GetFields() const { return fields_; }
+
+  /**
+   * @brief Gets the number of partitions.
+   *
+   * @return The number of partitions.
+   */
+  size_t GetSize() const { return size_; }
+
+  /**
+   * @brief Checks whether the collection has no partitions.
+   *
+   * @return True if there are no partitions; false otherwise.
+   */
+  bool IsEmpty() const { return size_ == 0u; }
+
+  /**
+   * @brief Gets a view of the partition.
+   *
+   * @param index The index of the partition, less than `GetSize()`.
+   *
+   * @return The `PartitionView` instance.
+   */
+  PartitionView operator[](size_t index) const {
+    return PartitionView(this, index);
+  }
+
+ private:
+  friend class PartitionView;
+
+  struct StringColumn {
+    void Append(const std::string* value);
+    boost::optional<boost::string_ref> Get(size_t index) const;
+
+    std::string pool;
+    std::vector<uint32_t> ends;
+    std::vector<bool> present;
+  };
+
+  struct IntColumn {
+    void Append(const boost::optional<int64_t>& value);
+    boost::optional<int64_t> Get(size_t index) const;
+
+    std::vector<int64_t> values;
+    std::vector<bool> present;
+  };
+
+  uint32_t fields_;
+  size_t size_;
+  StringColumn partition_;
+  StringColumn data_handle_;
+  StringColumn checksum_;
+  StringColumn crc_;
+  IntColumn data_size_;
+  IntColumn compressed_data_size_;
+  IntColumn version_;
+};
+
+}  // namespace model
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
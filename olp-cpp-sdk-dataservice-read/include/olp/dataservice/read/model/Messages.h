@@ -250,6 +250,12 @@ class DATASERVICE_READ_API Messages final {
    * @return The vector of messages consumed from \ref `StreamLayerClient`.
    */
   const std::vector<Message>& GetMessages() const { return messages_; }
+  /**
+   * @brief Gets a mutable reference to the vector of messages.
+   *
+   * @return The mutable reference to the vector of messages.
+   */
+  std::vector<Message>& GetMutableMessages() { return messages_; }
   /**
    * @brief Sets the vector of messages.
    *
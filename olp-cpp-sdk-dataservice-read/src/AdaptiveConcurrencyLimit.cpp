@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "AdaptiveConcurrencyLimit.h"
+
+#include <algorithm>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+// The weight of the latest latency in the smoothed latency.
+constexpr double kLatencySmoothing = 0.2;
+// The smoothed latency that is this many times the lowest one means that the
+// requests are queued somewhere on the way.
+constexpr double kLatencyGrowthFactor = 2.0;
+}  // namespace
+
+AdaptiveConcurrencyLimit::AdaptiveConcurrencyLimit(size_t initial_limit,
+                                                   size_t max_limit)
+    : max_limit_(std::max<size_t>(max_limit, 1u)),
+      limit_(std::min(std::max<size_t>(initial_limit, 1u), max_limit_)) {}
+
+void AdaptiveConcurrencyLimit::OnCompleted(Clock::time_point now,
+                                           Clock::duration latency,
+                                           bool overloaded) {
+  const auto latency_seconds =
+      std::chrono::duration_cast<std::chrono::duration<double>>(latency)
+          .count();
+  if (smoothed_latency_ == 0.0) {
+    smoothed_latency_ = latency_seconds;
+  } else {
+    smoothed_latency_ +=
+        kLatencySmoothing * (latency_seconds - smoothed_latency_);
+  }
+  if (min_latency_ == 0.0 || latency_seconds < min_latency_) {
+    min_latency_ = latency_seconds;
+  }
+
+  if (decrease_holdoff_ > 0) {
+    --decrease_holdoff_;
+  }
+
+  const bool latency_grew =
+      min_latency_ > 0.0 &&
+      smoothed_latency_ > min_latency_ * kLatencyGrowthFactor;
+
+  if (overloaded || latency_grew) {
+    if (decrease_holdoff_ == 0) {
+      Decrease();
+      StartWindow(now);
+    }
+    return;
+  }
+
+  if (window_start_ == Clock::time_point{}) {
+    // The first completion starts the first window.
+    StartWindow(now);
+    return;
+  }
+
+  if (++window_completed_ < limit_) {
+    return;
+  }
+
+  const std::chrono::duration<double> window_duration = now - window_start_;
+  const auto throughput =
+      window_duration.count() > 0.0
+          ? static_cast<double>(window_completed_) / window_duration.count()
+          : last_throughput_;
+
+  if (throughput >= last_throughput_ && limit_ < max_limit_) {
+    ++limit_;
+  }
+
+  last_throughput_ = throughput;
+  StartWindow(now);
+}
+
+void AdaptiveConcurrencyLimit::Decrease() {
+  // The requests sent with the old limit complete before the new limit has
+  // any effect.
+  decrease_holdoff_ = limit_;
+  limit_ = std::max<size_t>(limit_ / 2, 1u);
+  last_throughput_ = 0.0;
+
+  // Forget the latency of the queued requests, so it does not decrease the
+  // limit again.
+  smoothed_latency_ = min_latency_;
+}
+
+void AdaptiveConcurrencyLimit::StartWindow(Clock::time_point now) {
+  window_start_ = now;
+  window_completed_ = 0;
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief Adapts the number of the requests in flight to the network with an
+ * additive increase, multiplicative decrease (AIMD) controller.
+ *
+ * The completed requests are counted in windows of `GetLimit()` requests. The
+ * limit grows by one after each window whose throughput is not lower than the
+ * one of the previous window, and is halved when the server is overloaded or
+ * the smoothed latency grows to twice the lowest one seen. After a decrease,
+ * the requests that were already in flight do not decrease it again.
+ */
+class AdaptiveConcurrencyLimit {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Creates the `AdaptiveConcurrencyLimit` instance.
+   *
+   * @param initial_limit The limit to start with.
+   * @param max_limit The highest limit.
+   */
+  AdaptiveConcurrencyLimit(size_t initial_limit, size_t max_limit);
+
+  /// Gets the current number of the requests allowed in flight.
+  size_t GetLimit() const { return limit_; }
+
+  /**
+   * @brief Updates the limit with a completed request.
+   *
+   * @param now The time of the completion.
+   * @param latency The time that the request took.
+   * @param overloaded True if the server reported that it is overloaded, for
+   * example, with the 429 or 5xx HTTP status.
+   */
+  void OnCompleted(Clock::time_point now, Clock::duration latency,
+                   bool overloaded);
+
+ private:
+  void Decrease();
+
+  void StartWindow(Clock::time_point now);
+
+  const size_t max_limit_;
+  size_t limit_;
+
+  /// The completions left until the requests sent before the last decrease
+  /// are complete.
+  size_t decrease_holdoff_{0};
+
+  double smoothed_latency_{0.0};
+  double min_latency_{0.0};
+
+  Clock::time_point window_start_{};
+  size_t window_completed_{0};
+  double last_throughput_{0.0};
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
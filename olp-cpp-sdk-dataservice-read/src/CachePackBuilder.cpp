@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/dataservice/read/CachePackBuilder.h"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <olp/core/cache/DefaultCache.h>
+#include <olp/core/geo/tiling/TileKeyUtils.h>
+#include <olp/core/geo/tiling/TilingSchemeRegistry.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/porting/make_unique.h>
+#include <olp/core/utils/Dir.h>
+#include <olp/core/utils/WarningWorkarounds.h>
+#include <olp/dataservice/read/CatalogClient.h>
+#include <olp/dataservice/read/CatalogVersionRequest.h>
+#include <olp/dataservice/read/PrefetchTileResult.h>
+#include <olp/dataservice/read/PrefetchTilesRequest.h>
+#include <olp/dataservice/read/VersionedLayerClient.h>
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+constexpr auto kLogTag = "CachePackBuilder";
+constexpr auto kBuildDirectory = "/build";
+
+boost::optional<client::ApiError> ValidateRequest(
+    const CachePackRequest& request) {
+  if (request.GetLayerIds().empty()) {
+    return client::ApiError(client::ErrorCode::InvalidArgument,
+                            "Layer IDs are empty");
+  }
+  if (request.GetOutputPath().empty()) {
+    return client::ApiError(client::ErrorCode::InvalidArgument,
+                            "Output path is empty");
+  }
+  if (request.GetGeoRectangle().IsEmpty()) {
+    return client::ApiError(client::ErrorCode::InvalidArgument,
+                            "Geo rectangle is empty");
+  }
+  if (request.GetMinLevel() > request.GetMaxLevel()) {
+    return client::ApiError(client::ErrorCode::InvalidArgument,
+                            "Min level is greater than max level");
+  }
+  return boost::none;
+}
+}  // namespace
+
+CachePackBuilder::CachePackBuilder(client::HRN catalog,
+                                   client::OlpClientSettings settings)
+    : catalog_(std::move(catalog)), settings_(std::move(settings)) {}
+
+CachePackResponse CachePackBuilder::Build(const CachePackRequest& request,
+                                          client::CancellationContext context) {
+  auto validation_error = ValidateRequest(request);
+  if (validation_error) {
+    return *validation_error;
+  }
+
+  if (context.IsCancelled()) {
+    return client::ApiError::Cancelled();
+  }
+
+#ifdef OLP_SDK_ENABLE_DEFAULT_CACHE
+  const auto build_path = request.GetOutputPath() + kBuildDirectory;
+  if (!olp::utils::Dir::Create(build_path)) {
+    return client::ApiError(client::ErrorCode::Unknown,
+                            "Failed to create " + build_path);
+  }
+
+  // The pack is exported from a temporary mutable cache, which must keep
+  // everything prefetched. Write-behind batches the many small tile writes.
+  cache::CacheSettings cache_settings;
+  cache_settings.disk_path_mutable = build_path;
+  cache_settings.max_disk_storage = static_cast<uint64_t>(-1);
+  cache_settings.max_memory_cache_size = 0u;
+  cache_settings.enforce_immediate_flush = false;
+  cache_settings.write_behind_queue_size = 1024u;
+
+  auto cache = std::make_shared<cache::DefaultCache>(cache_settings);
+  if (cache->Open() != cache::DefaultCache::Success) {
+    olp::utils::Dir::Remove(build_path);
+    return client::ApiError(client::ErrorCode::Unknown,
+                            "Failed to open the cache at " + build_path);
+  }
+
+  auto remove_build_cache = [&]() {
+    cache->Close();
+    olp::utils::Dir::Remove(build_path);
+  };
+
+  auto settings = settings_;
+  settings.cache = cache;
+
+  auto version = request.GetVersion();
+  if (!version) {
+    CatalogClient catalog_client(catalog_, settings);
+    auto future = catalog_client.GetLatestVersion(
+        CatalogVersionRequest().WithBillingTag(request.GetBillingTag()));
+    if (!context.ExecuteOrCancelled([&]() {
+          return future.GetCancellationToken();
+        })) {
+      remove_build_cache();
+      return client::ApiError::Cancelled();
+    }
+
+    auto response = future.GetFuture().get();
+    if (!response.IsSuccessful()) {
+      remove_build_cache();
+      return response.GetError();
+    }
+    version = response.GetResult().GetVersion();
+  }
+
+  const auto tile_keys = geo::TileKeyUtils::GeoRectangleToTileKeys(
+      geo::HalfQuadTreeIdentityTilingScheme(), request.GetGeoRectangle(),
+      request.GetMinLevel());
+
+  OLP_SDK_LOG_INFO_F(kLogTag,
+                     "Build started, catalog=%s, version=%lld, layers=%zu, "
+                     "root_tiles=%zu",
+                     catalog_.ToCatalogHRNString().c_str(),
+                     static_cast<long long>(*version),
+                     request.GetLayerIds().size(), tile_keys.size());
+
+  // All layers are prefetched concurrently, each prefetch downloads its tiles
+  // in parallel on the task scheduler.
+  std::vector<std::unique_ptr<VersionedLayerClient>> clients;
+  std::vector<std::future<PrefetchTilesResponse>> futures;
+  std::vector<client::CancellationToken> tokens;
+  for (const auto& layer_id : request.GetLayerIds()) {
+    clients.emplace_back(std::make_unique<VersionedLayerClient>(
+        catalog_, layer_id, version, settings));
+
+    auto future = clients.back()->PrefetchTiles(
+        PrefetchTilesRequest()
+            .WithTileKeys(tile_keys)
+            .WithMinLevel(request.GetMinLevel())
+            .WithMaxLevel(request.GetMaxLevel())
+            .WithBillingTag(request.GetBillingTag()));
+    tokens.emplace_back(future.GetCancellationToken());
+    futures.emplace_back(future.GetFuture());
+  }
+
+  const bool cancelled = !context.ExecuteOrCancelled([&]() {
+    return client::CancellationToken([tokens]() {
+      for (const auto& token : tokens) {
+        token.Cancel();
+      }
+    });
+  });
+  if (cancelled) {
+    for (const auto& token : tokens) {
+      token.Cancel();
+    }
+  }
+
+  CachePackResult result;
+  result.version = *version;
+  boost::optional<client::ApiError> error;
+  for (auto& future : futures) {
+    auto response = future.get();
+    if (!response.IsSuccessful()) {
+      error = response.GetError();
+      continue;
+    }
+    for (const auto& tile : response.GetResult()) {
+      if (tile && tile->IsSuccessful()) {
+        ++result.tile_count;
+      }
+    }
+  }
+
+  if (cancelled || context.IsCancelled()) {
+    remove_build_cache();
+    return client::ApiError::Cancelled();
+  }
+
+  if (error) {
+    remove_build_cache();
+    return *error;
+  }
+
+  const bool exported = cache->ExportToProtectedCache(request.GetOutputPath());
+  remove_build_cache();
+  if (!exported) {
+    return client::ApiError(client::ErrorCode::Unknown,
+                            "Failed to export the pack to " +
+                                request.GetOutputPath());
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag, "Build finished, tiles=%zu, path=%s",
+                     result.tile_count, request.GetOutputPath().c_str());
+  return result;
+#else
+  OLP_SDK_CORE_UNUSED(context);
+  OLP_SDK_LOG_WARNING(kLogTag, "Build requires the default cache");
+  return client::ApiError(client::ErrorCode::PreconditionFailed,
+                          "The default cache is disabled");
+#endif  // OLP_SDK_ENABLE_DEFAULT_CACHE
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
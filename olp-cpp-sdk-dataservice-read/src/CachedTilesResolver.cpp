@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "CachedTilesResolver.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+constexpr auto kQuadTreeDepth = 4u;
+}  // namespace
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+CachedTilesResolver::CachedTilesResolver(
+    const client::HRN& catalog, const std::string& layer_id, int64_t version,
+    const client::OlpClientSettings& settings)
+    : layer_id_(layer_id),
+      version_(version),
+      data_cache_repository_(catalog, settings.cache),
+      partitions_cache_repository_(catalog, layer_id_, settings.cache) {}
+
+bool CachedTilesResolver::IsCached(const geo::TileKey& tile, bool aggregated) {
+  const auto data_handle = FindDataHandle(tile, aggregated);
+  return data_handle &&
+         data_cache_repository_.IsCached(layer_id_, data_handle.value());
+}
+
+boost::optional<model::Data> CachedTilesResolver::GetData(
+    const geo::TileKey& tile, bool aggregated) {
+  const auto data_handle = FindDataHandle(tile, aggregated);
+  if (!data_handle) {
+    return boost::none;
+  }
+  return data_cache_repository_.Get(layer_id_, data_handle.value());
+}
+
+const read::QuadTreeIndex* CachedTilesResolver::FindQuadTree(
+    const geo::TileKey& tile) {
+  const auto max_depth = std::min<std::uint32_t>(tile.Level(), kQuadTreeDepth);
+  for (auto depth = 0u; depth <= max_depth; ++depth) {
+    const auto root = tile.ChangedLevelBy(-static_cast<int>(depth));
+    auto it = quad_trees_.find(root);
+    if (it != quad_trees_.end()) {
+      return &it->second;
+    }
+
+    if (roots_without_quad_tree_.count(root) != 0) {
+      continue;
+    }
+
+    read::QuadTreeIndex quad_tree;
+    if (partitions_cache_repository_.Get(root, kQuadTreeDepth, version_,
+                                         quad_tree)) {
+      return &quad_trees_.emplace(root, std::move(quad_tree)).first->second;
+    }
+    roots_without_quad_tree_.insert(root);
+  }
+  return nullptr;
+}
+
+boost::optional<std::string> CachedTilesResolver::FindDataHandle(
+    const geo::TileKey& tile, bool aggregated) {
+  const auto* quad_tree = FindQuadTree(tile);
+  if (!quad_tree) {
+    return boost::none;
+  }
+
+  const auto data = quad_tree->Find(tile, aggregated);
+  if (!data) {
+    return boost::none;
+  }
+  return data->data_handle;
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
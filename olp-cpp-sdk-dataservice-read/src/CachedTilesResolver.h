@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/geo/tiling/TileKey.h>
+#include <olp/dataservice/read/Types.h>
+#include "repositories/DataCacheRepository.h"
+#include "repositories/PartitionsCacheRepository.h"
+#include "repositories/QuadTreeIndex.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/// Finds the cached tiles of a layer version. Keeps the quad trees read from
+/// the cache and the roots without a quad tree, so each quad tree is read
+/// once for all the tiles it contains.
+class CachedTilesResolver {
+ public:
+  CachedTilesResolver(const client::HRN& catalog, const std::string& layer_id,
+                      int64_t version,
+                      const client::OlpClientSettings& settings);
+
+  /// Returns true if the data of the tile is in the cache.
+  bool IsCached(const geo::TileKey& tile, bool aggregated);
+
+  /// Returns the data of the tile if it is in the cache.
+  boost::optional<model::Data> GetData(const geo::TileKey& tile,
+                                       bool aggregated);
+
+ private:
+  const read::QuadTreeIndex* FindQuadTree(const geo::TileKey& tile);
+
+  boost::optional<std::string> FindDataHandle(const geo::TileKey& tile,
+                                              bool aggregated);
+
+  const std::string& layer_id_;
+  const int64_t version_;
+  repository::DataCacheRepository data_cache_repository_;
+  repository::PartitionsCacheRepository partitions_cache_repository_;
+  std::unordered_map<geo::TileKey, read::QuadTreeIndex> quad_trees_;
+  std::unordered_set<geo::TileKey> roots_without_quad_tree_;
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -42,6 +42,15 @@ bool CatalogClient::CancelPendingRequests() {
   return impl_->CancelPendingRequests();
 }
 
+client::CancellationToken CatalogClient::Warmup(
+    client::WarmupCallback callback) {
+  return impl_->Warmup(std::move(callback));
+}
+
+client::CancellableFuture<client::WarmupResponse> CatalogClient::Warmup() {
+  return impl_->Warmup();
+}
+
 client::CancellationToken CatalogClient::GetCatalog(
     CatalogRequest request, CatalogResponseCallback callback) {
   return impl_->GetCatalog(std::move(request), std::move(callback));
@@ -71,6 +80,18 @@ client::CancellableFuture<VersionsResponse> CatalogClient::ListVersions(
     VersionsRequest request) {
   return impl_->ListVersions(std::move(request));
 }
+
+client::CancellationToken CatalogClient::GetTiles(
+    TilesRequest request, TileDataCallback tile_callback,
+    TilesResponseCallback callback) {
+  return impl_->GetTiles(std::move(request), std::move(tile_callback),
+                         std::move(callback));
+}
+
+client::CancellableFuture<TilesResponse> CatalogClient::GetTiles(
+    TilesRequest request, TileDataCallback tile_callback) {
+  return impl_->GetTiles(std::move(request), std::move(tile_callback));
+}
 }  // namespace read
 }  // namespace dataservice
 }  // namespace olp
@@ -19,15 +19,20 @@
 
 #include "CatalogClientImpl.h"
 
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include <olp/core/cache/DefaultCache.h>
-#include <olp/core/client/OlpClientSettingsFactory.h>
 #include <olp/core/client/PendingRequests.h>
 #include <olp/core/logging/Log.h>
+#include <olp/dataservice/read/TileRequest.h>
 
 #include "Common.h"
+#include "DependencyResolverHelpers.h"
 #include "repositories/CatalogRepository.h"
+#include "repositories/DataRepository.h"
+#include "repositories/PartitionsRepository.h"
 
 namespace olp {
 namespace dataservice {
@@ -35,18 +40,26 @@ namespace read {
 
 namespace {
 constexpr auto kLogTag = "CatalogClientImpl";
-}
+constexpr auto kBlobService = "blob";
+constexpr auto kQuadTreeDepth = 4u;
+constexpr size_t kMaxParallelDownloads = 4u;
+
+/// A tile of a layer, and its data handle when it is resolved.
+struct TileItem {
+  size_t layer_index;
+  geo::TileKey tile;
+  std::string data_handle;
+};
+}  // namespace
 
 CatalogClientImpl::CatalogClientImpl(client::HRN catalog,
                                      client::OlpClientSettings settings)
-    : catalog_(std::move(catalog)),
-      settings_(std::move(settings)),
-      lookup_client_(catalog_, settings_),
-      task_sink_(settings_.task_scheduler) {
-  if (!settings_.cache) {
-    settings_.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
-  }
-}
+    : context_(std::make_shared<CatalogContext>(std::move(catalog),
+                                                std::move(settings))),
+      catalog_(context_->GetCatalog()),
+      settings_(context_->GetSettings()),
+      lookup_client_(context_->GetLookupClient()),
+      task_sink_(settings_.task_scheduler) {}
 
 bool CatalogClientImpl::CancelPendingRequests() {
   OLP_SDK_LOG_TRACE(kLogTag, "CancelPendingRequests");
@@ -54,6 +67,17 @@ bool CatalogClientImpl::CancelPendingRequests() {
   return true;
 }
 
+client::CancellationToken CatalogClientImpl::Warmup(
+    client::WarmupCallback callback) {
+  // The APIs are stored in the cache of the context settings, where the lookup
+  // client of this catalog finds them.
+  return client::Warmup({catalog_}, settings_, std::move(callback));
+}
+
+client::CancellableFuture<client::WarmupResponse> CatalogClientImpl::Warmup() {
+  return client::Warmup({catalog_}, settings_);
+}
+
 client::CancellationToken CatalogClientImpl::GetCatalog(
     CatalogRequest request, CatalogResponseCallback callback) {
   auto schedule_get_catalog = [&](CatalogRequest request,
@@ -92,14 +116,10 @@ client::CancellationToken CatalogClientImpl::GetLatestVersion(
   OLP_SDK_LOG_TRACE_F(kLogTag, "GetCatalog '%s'", request.CreateKey().c_str());
   auto schedule_get_latest_version = [&](CatalogVersionRequest request,
                                          CatalogVersionCallback callback) {
-    auto catalog = catalog_;
-    auto settings = settings_;
-    auto lookup_client = lookup_client_;
+    auto catalog_context = context_;
 
     auto get_latest_version_task = [=](client::CancellationContext context) {
-      repository::CatalogRepository repository(catalog, settings,
-                                               lookup_client);
-      return repository.GetLatestVersion(request, std::move(context));
+      return catalog_context->GetLatestVersion(request, context);
     };
 
     return task_sink_.AddTask(std::move(get_latest_version_task),
@@ -147,6 +167,159 @@ client::CancellableFuture<VersionsResponse> CatalogClientImpl::ListVersions(
   return client::CancellableFuture<VersionsResponse>(std::move(cancel_token),
                                                      std::move(promise));
 }
+client::CancellationToken CatalogClientImpl::GetTiles(
+    TilesRequest request, TileDataCallback tile_callback,
+    TilesResponseCallback callback) {
+  auto catalog_context = context_;
+  auto catalog = catalog_;
+  auto settings = settings_;
+  auto lookup_client = lookup_client_;
+
+  auto get_tiles_task = [=](client::CancellationContext context)
+      -> TilesResponse {
+    if (request.GetFetchOption() == CacheWithUpdate) {
+      return client::ApiError(
+          client::ErrorCode::InvalidArgument,
+          "CacheWithUpdate option can not be used for versioned layer");
+    }
+
+    const auto& layer_ids = request.GetLayerIds();
+    const auto& tiles = request.GetTileKeys();
+
+    // The tile callback is called from several threads, one call at a time.
+    std::mutex callback_mutex;
+    auto report = [&](const TileItem& item, DataResponse response) {
+      std::lock_guard<std::mutex> lock(callback_mutex);
+      if (tile_callback) {
+        tile_callback(layer_ids[item.layer_index], item.tile,
+                      std::move(response));
+      }
+    };
+
+    TileKeys valid_tiles;
+    valid_tiles.reserve(tiles.size());
+    for (const auto& tile : tiles) {
+      if (tile.IsValid()) {
+        valid_tiles.push_back(tile);
+        continue;
+      }
+      for (size_t layer = 0u; layer < layer_ids.size(); ++layer) {
+        report({layer, tile, {}}, client::ApiError(
+                                      client::ErrorCode::InvalidArgument,
+                                      "Tile key is invalid"));
+      }
+    }
+
+    if (layer_ids.empty() || valid_tiles.empty()) {
+      return client::ApiNoResult();
+    }
+
+    int64_t version = 0;
+    if (request.GetCatalogVersion()) {
+      version = request.GetCatalogVersion().get();
+    } else {
+      auto version_response = catalog_context->GetVersion(
+          request.GetBillingTag(), request.GetFetchOption(), context);
+      if (!version_response.IsSuccessful()) {
+        return version_response.GetError();
+      }
+      version = version_response.GetResult().GetVersion();
+    }
+
+    // The tiles that cannot share a quad tree are resolved in parallel, and
+    // the tiles of one group share the decoded quad trees in memory.
+    const auto groups = GroupTilesByQuadTree(valid_tiles, kQuadTreeDepth);
+    std::vector<std::pair<size_t, const TileKeys*>> group_items;
+    group_items.reserve(layer_ids.size() * groups.size());
+    for (size_t layer = 0u; layer < layer_ids.size(); ++layer) {
+      for (const auto& group : groups) {
+        group_items.emplace_back(layer, &group);
+      }
+    }
+
+    std::vector<client::CancellationContext> group_contexts(
+        group_items.size());
+    std::vector<client::CancellationContext> download_contexts(
+        layer_ids.size() * valid_tiles.size());
+    const bool started = context.ExecuteOrCancelled([&]() {
+      return client::CancellationToken(
+          [group_contexts, download_contexts]() mutable {
+            for (auto* contexts : {&group_contexts, &download_contexts}) {
+              for (auto& item_context : *contexts) {
+                item_context.CancelOperation();
+              }
+            }
+          });
+    });
+    if (!started) {
+      return client::ApiError::Cancelled();
+    }
+
+    std::vector<std::vector<TileItem>> resolved(group_items.size());
+    ParallelFor(
+        group_items.size(), settings.task_scheduler, [&](size_t index) {
+          const auto layer = group_items[index].first;
+          repository::PartitionsRepository repository(
+              catalog, layer_ids[layer], settings, lookup_client);
+          for (const auto& tile : *group_items[index].second) {
+            auto partition = repository.GetTile(
+                TileRequest()
+                    .WithTileKey(tile)
+                    .WithBillingTag(request.GetBillingTag())
+                    .WithFetchOption(request.GetFetchOption()),
+                version, group_contexts[index]);
+            if (!partition.IsSuccessful()) {
+              report({layer, tile, {}}, partition.GetError());
+              continue;
+            }
+            resolved[index].push_back(
+                {layer, tile, partition.GetResult().GetDataHandle()});
+          }
+        });
+
+    std::vector<TileItem> downloads;
+    for (auto& items : resolved) {
+      std::move(items.begin(), items.end(), std::back_inserter(downloads));
+    }
+
+    repository::DataRepository repository(catalog, settings, lookup_client);
+    ParallelFor(
+        downloads.size(), settings.task_scheduler,
+        [&](size_t index) {
+          const auto& item = downloads[index];
+          auto response = repository.GetBlobData(
+              layer_ids[item.layer_index], kBlobService,
+              DataRequest()
+                  .WithDataHandle(item.data_handle)
+                  .WithBillingTag(request.GetBillingTag())
+                  .WithFetchOption(request.GetFetchOption()),
+              download_contexts[index]);
+          report(item, std::move(response));
+        },
+        kMaxParallelDownloads);
+
+    if (context.IsCancelled()) {
+      return client::ApiError::Cancelled();
+    }
+    return client::ApiNoResult();
+  };
+
+  return task_sink_.AddTask(std::move(get_tiles_task), std::move(callback),
+                            request.GetPriority());
+}
+
+client::CancellableFuture<TilesResponse> CatalogClientImpl::GetTiles(
+    TilesRequest request, TileDataCallback tile_callback) {
+  auto promise = std::make_shared<std::promise<TilesResponse>>();
+  auto cancel_token = GetTiles(
+      std::move(request), std::move(tile_callback),
+      [promise](TilesResponse response) {
+        promise->set_value(std::move(response));
+      });
+  return client::CancellableFuture<TilesResponse>(std::move(cancel_token),
+                                                  std::move(promise));
+}
+
 }  // namespace read
 }  // namespace dataservice
 }  // namespace olp
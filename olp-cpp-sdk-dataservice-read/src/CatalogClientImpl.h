@@ -26,11 +26,14 @@
 #include <olp/core/client/CancellationToken.h>
 #include <olp/core/client/HRN.h>
 #include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/client/Warmup.h>
 #include <olp/dataservice/read/CatalogRequest.h>
 #include <olp/dataservice/read/CatalogVersionRequest.h>
+#include <olp/dataservice/read/TilesRequest.h>
 #include <olp/dataservice/read/Types.h>
 #include <olp/dataservice/read/VersionsRequest.h>
 
+#include "CatalogContext.h"
 #include "TaskSink.h"
 
 namespace olp {
@@ -50,8 +53,15 @@ class CatalogClientImpl final {
  public:
   CatalogClientImpl(client::HRN catalog, client::OlpClientSettings settings);
 
+  /// The context that the layer clients created from this client share.
+  const std::shared_ptr<CatalogContext>& GetContext() const { return context_; }
+
   bool CancelPendingRequests();
 
+  client::CancellationToken Warmup(client::WarmupCallback callback);
+
+  client::CancellableFuture<client::WarmupResponse> Warmup();
+
   client::CancellationToken GetCatalog(CatalogRequest request,
                                        CatalogResponseCallback callback);
 
@@ -69,7 +79,15 @@ class CatalogClientImpl final {
   client::CancellableFuture<VersionsResponse> ListVersions(
       VersionsRequest request);
 
+  client::CancellationToken GetTiles(TilesRequest request,
+                                     TileDataCallback tile_callback,
+                                     TilesResponseCallback callback);
+
+  client::CancellableFuture<TilesResponse> GetTiles(
+      TilesRequest request, TileDataCallback tile_callback);
+
  private:
+  std::shared_ptr<CatalogContext> context_;
   client::HRN catalog_;
   client::OlpClientSettings settings_;
   client::ApiLookupClient lookup_client_;
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "CatalogContext.h"
+
+#include <condition_variable>
+#include <utility>
+
+#include <olp/core/cache/DefaultCache.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/client/Tracer.h>
+#include <olp/dataservice/read/CatalogVersionRequest.h>
+
+#include "repositories/CatalogRepository.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+constexpr int64_t kInvalidVersion = -1;
+
+client::OlpClientSettings WithSharedState(client::OlpClientSettings settings) {
+  if (!settings.cache) {
+    settings.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
+  }
+  if (!settings.pending_requests) {
+    settings.pending_requests =
+        client::OlpClientSettingsFactory::CreatePendingRequests();
+  }
+  return settings;
+}
+}  // namespace
+
+struct CatalogContext::VersionFlight {
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool done{false};
+  boost::optional<CatalogVersionResponse> response;
+  std::chrono::steady_clock::time_point expires_at;
+};
+
+constexpr std::chrono::milliseconds CatalogContext::kLatestVersionTtl;
+
+CatalogContext::CatalogContext(client::HRN catalog,
+                               client::OlpClientSettings settings)
+    : catalog_(std::move(catalog)),
+      settings_(WithSharedState(std::move(settings))),
+      lookup_client_(catalog_, settings_),
+      version_(kInvalidVersion) {}
+
+CatalogVersionResponse CatalogContext::GetVersion(
+    boost::optional<std::string> billing_tag, const FetchOptions& fetch_options,
+    const client::CancellationContext& context) {
+  auto version = version_.load();
+  if (version == kInvalidVersion) {
+    std::lock_guard<std::mutex> lock(version_mutex_);
+    version = version_.load();
+    if (version == kInvalidVersion) {
+      client::ScopedSpan span(settings_.tracer, "olp.read.ResolveVersion");
+
+      CatalogVersionRequest request;
+      request.WithBillingTag(std::move(billing_tag));
+      request.WithFetchOption(fetch_options);
+
+      auto response = GetLatestVersion(request, context);
+      if (!response.IsSuccessful()) {
+        return response;
+      }
+
+      version_.store(response.GetResult().GetVersion());
+      return response;
+    }
+  }
+
+  model::VersionResponse response;
+  response.SetVersion(version);
+  return response;
+}
+
+CatalogVersionResponse CatalogContext::GetLatestVersion(
+    const CatalogVersionRequest& request,
+    const client::CancellationContext& context) {
+  repository::CatalogRepository repository(catalog_, settings_,
+                                           lookup_client_);
+  if (request.GetFetchOption() == CacheOnly) {
+    return repository.GetLatestVersion(request, context);
+  }
+
+  const VersionFlightKey key(request.GetBillingTag(),
+                             request.GetFetchOption());
+  std::shared_ptr<VersionFlight> flight;
+  bool leader = false;
+  {
+    std::lock_guard<std::mutex> lock(flights_mutex_);
+    auto& entry = version_flights_[key];
+    if (entry) {
+      std::lock_guard<std::mutex> flight_lock(entry->mutex);
+      if (!entry->done) {
+        flight = entry;
+      } else if (std::chrono::steady_clock::now() < entry->expires_at) {
+        return *entry->response;
+      }
+    }
+
+    if (!flight) {
+      entry = std::make_shared<VersionFlight>();
+      flight = entry;
+      leader = true;
+    }
+  }
+
+  if (!leader) {
+    auto response = Wait(flight, context);
+    if (response) {
+      return std::move(*response);
+    }
+    return repository.GetLatestVersion(request, context);
+  }
+
+  auto response = repository.GetLatestVersion(request, context);
+  Complete(key, flight, response);
+  return response;
+}
+
+boost::optional<CatalogVersionResponse> CatalogContext::Wait(
+    const std::shared_ptr<VersionFlight>& flight,
+    client::CancellationContext context) {
+  // The context cancels its token under its own lock, so the waiting
+  // predicate checks a flag instead of the context.
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+  if (!context.ExecuteOrCancelled([&]() {
+        return client::CancellationToken([cancelled, flight]() {
+          std::lock_guard<std::mutex> lock(flight->mutex);
+          cancelled->store(true);
+          flight->condition.notify_all();
+        });
+      })) {
+    return CatalogVersionResponse(client::ApiError::Cancelled());
+  }
+
+  std::unique_lock<std::mutex> lock(flight->mutex);
+  flight->condition.wait(
+      lock, [&]() { return flight->done || cancelled->load(); });
+
+  if (!flight->done) {
+    return CatalogVersionResponse(client::ApiError::Cancelled());
+  }
+  return flight->response;
+}
+
+void CatalogContext::Complete(const VersionFlightKey& key,
+                              const std::shared_ptr<VersionFlight>& flight,
+                              const CatalogVersionResponse& response) {
+  const bool cancelled =
+      !response.IsSuccessful() &&
+      response.GetError().GetErrorCode() == client::ErrorCode::Cancelled;
+
+  // Only the successful responses are reused, the errors are shared with the
+  // waiting requests only, and the cancelled request is sent by them again.
+  if (!response.IsSuccessful()) {
+    std::lock_guard<std::mutex> lock(flights_mutex_);
+    auto it = version_flights_.find(key);
+    if (it != version_flights_.end() && it->second == flight) {
+      version_flights_.erase(it);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(flight->mutex);
+  if (!cancelled) {
+    flight->response = response;
+  }
+  flight->expires_at = std::chrono::steady_clock::now() + kLatestVersionTtl;
+  flight->done = true;
+  flight->condition.notify_all();
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
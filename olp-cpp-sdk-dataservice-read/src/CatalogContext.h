@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <olp/core/client/ApiLookupClient.h>
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include <olp/dataservice/read/FetchOptions.h>
+#include <olp/dataservice/read/Types.h>
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+class CatalogVersionRequest;
+
+/**
+ * @brief The state that all the clients of one catalog share.
+ *
+ * The `CatalogClient` instance creates the context, and the layer clients
+ * created from it use the same API lookup cache, the same registry of the
+ * in-flight requests, and the same resolved catalog version.
+ *
+ * The concurrent latest version requests of the clients share one request,
+ * and its result is reused for `kLatestVersionTtl` to absorb the bursts.
+ */
+class CatalogContext final {
+ public:
+  CatalogContext(client::HRN catalog, client::OlpClientSettings settings);
+
+  CatalogContext(const CatalogContext&) = delete;
+  CatalogContext& operator=(const CatalogContext&) = delete;
+
+  const client::HRN& GetCatalog() const { return catalog_; }
+
+  /// The settings with the cache and the pending requests set.
+  const client::OlpClientSettings& GetSettings() const { return settings_; }
+
+  /// The lookup client, its copies share the cached API endpoints.
+  const client::ApiLookupClient& GetLookupClient() const {
+    return lookup_client_;
+  }
+
+  /// How long a latest version response is reused.
+  static constexpr std::chrono::milliseconds kLatestVersionTtl{1000};
+
+  /// Resolves the latest catalog version once for all the clients. The
+  /// concurrent calls wait for the first request instead of sending their own.
+  CatalogVersionResponse GetVersion(boost::optional<std::string> billing_tag,
+                                    const FetchOptions& fetch_options,
+                                    const client::CancellationContext& context);
+
+  /// Gets the latest catalog version like
+  /// `CatalogRepository::GetLatestVersion`, but the concurrent requests with
+  /// the same billing tag and fetch option wait for the first one, and its
+  /// response is reused for `kLatestVersionTtl`.
+  CatalogVersionResponse GetLatestVersion(
+      const CatalogVersionRequest& request,
+      const client::CancellationContext& context);
+
+ private:
+  struct VersionFlight;
+  using VersionFlightKey =
+      std::pair<boost::optional<std::string>, FetchOptions>;
+
+  /// Waits for the response of the flight, returns `boost::none` if its
+  /// request is cancelled and has to be sent by the caller.
+  boost::optional<CatalogVersionResponse> Wait(
+      const std::shared_ptr<VersionFlight>& flight,
+      client::CancellationContext context);
+
+  void Complete(const VersionFlightKey& key,
+                const std::shared_ptr<VersionFlight>& flight,
+                const CatalogVersionResponse& response);
+
+  const client::HRN catalog_;
+  client::OlpClientSettings settings_;
+  const client::ApiLookupClient lookup_client_;
+  std::mutex version_mutex_;
+  std::atomic<int64_t> version_;
+  std::mutex flights_mutex_;
+  std::map<VersionFlightKey, std::shared_ptr<VersionFlight>> version_flights_;
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
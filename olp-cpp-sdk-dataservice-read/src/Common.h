@@ -23,6 +23,7 @@
 #include <olp/core/client/PendingRequests.h>
 #include <olp/core/thread/TaskScheduler.h>
 #include <olp/dataservice/read/FetchOptions.h>
+#include <olp/dataservice/read/Types.h>
 
 namespace olp {
 namespace dataservice {
@@ -61,6 +62,29 @@ inline client::CancellationToken ScheduleFetch(TaskScheduler&& schedule_task,
                        std::forward<Callback>(callback));
 }
 
+/*
+ * @brief Wraps the compact partitions callback, so it can be passed to the
+ * `GetPartitions` methods.
+ * @param fields The fields to keep, a combination of
+ * `model::CompactPartitions::Fields` values.
+ * @param callback Operation callback specified by the user.
+ * @return The partitions callback that converts the result and releases the
+ * full partitions before it calls the user callback.
+ */
+inline PartitionsResponseCallback ToCompactPartitionsCallback(
+    uint32_t fields, CompactPartitionsResponseCallback callback) {
+  return [=](PartitionsResponse response) {
+    if (!response.IsSuccessful()) {
+      callback(response.GetError());
+      return;
+    }
+
+    model::CompactPartitions partitions(response.GetResult(), fields);
+    response = PartitionsResponse();
+    callback(std::move(partitions));
+  };
+}
+
 }  // namespace read
 }  // namespace dataservice
 }  // namespace olp
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/dataservice/read/model/CompactPartitions.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace model {
+
+boost::string_ref PartitionView::GetPartition() const {
+  return partitions_->partition_.Get(index_).value_or(boost::string_ref());
+}
+
+boost::string_ref PartitionView::GetDataHandle() const {
+  return partitions_->data_handle_.Get(index_).value_or(boost::string_ref());
+}
+
+boost::optional<boost::string_ref> PartitionView::GetChecksum() const {
+  return partitions_->checksum_.Get(index_);
+}
+
+boost::optional<int64_t> PartitionView::GetDataSize() const {
+  return partitions_->data_size_.Get(index_);
+}
+
+boost::optional<int64_t> PartitionView::GetCompressedDataSize() const {
+  return partitions_->compressed_data_size_.Get(index_);
+}
+
+boost::optional<boost::string_ref> PartitionView::GetCrc() const {
+  return partitions_->crc_.Get(index_);
+}
+
+boost::optional<int64_t> PartitionView::GetVersion() const {
+  return partitions_->version_.Get(index_);
+}
+
+Partition PartitionView::Materialize() const {
+  Partition partition;
+  partition.SetPartition(GetPartition().to_string());
+  partition.SetDataHandle(GetDataHandle().to_string());
+  if (auto checksum = GetChecksum()) {
+    partition.SetChecksum(checksum->to_string());
+  }
+  partition.SetDataSize(GetDataSize());
+  partition.SetCompressedDataSize(GetCompressedDataSize());
+  if (auto crc = GetCrc()) {
+    partition.SetCrc(crc->to_string());
+  }
+  partition.SetVersion(GetVersion());
+  return partition;
+}
+
+void CompactPartitions::StringColumn::Append(const std::string* value) {
+  present.push_back(value != nullptr);
+  if (value) {
+    pool.append(*value);
+  }
+  ends.push_back(static_cast<uint32_t>(pool.size()));
+}
+
+boost::optional<boost::string_ref> CompactPartitions::StringColumn::Get(
+    size_t index) const {
+  if (index >= present.size() || !present[index]) {
+    return boost::none;
+  }
+
+  const size_t begin = index > 0u ? ends[index - 1u] : 0u;
+  return boost::string_ref(pool.data() + begin, ends[index] - begin);
+}
+
+void CompactPartitions::IntColumn::Append(
+    const boost::optional<int64_t>& value) {
+  present.push_back(static_cast<bool>(value));
+  values.push_back(value.value_or(0));
+}
+
+boost::optional<int64_t> CompactPartitions::IntColumn::Get(
+    size_t index) const {
+  if (index >= present.size() || !present[index]) {
+    return boost::none;
+  }
+  return values[index];
+}
+
+CompactPartitions::CompactPartitions(uint32_t fields)
+    : fields_((fields & kAllFields) | kPartition), size_(0u) {}
+
+CompactPartitions::CompactPartitions(const Partitions& partitions,
+                                     uint32_t fields)
+    : CompactPartitions(fields) {
+  const auto& items = partitions.GetPartitions();
+  Reserve(items.size());
+  for (const auto& partition : items) {
+    Append(partition);
+  }
+}
+
+void CompactPartitions::Append(const Partition& partition) {
+  partition_.Append(&partition.GetPartition());
+  if (fields_ & kDataHandle) {
+    data_handle_.Append(&partition.GetDataHandle());
+  }
+  if (fields_ & kChecksum) {
+    checksum_.Append(partition.GetChecksum().get_ptr());
+  }
+  if (fields_ & kDataSize) {
+    data_size_.Append(partition.GetDataSize());
+  }
+  if (fields_ & kCompressedDataSize) {
+    compressed_data_size_.Append(partition.GetCompressedDataSize());
+  }
+  if (fields_ & kCrc) {
+    crc_.Append(partition.GetCrc().get_ptr());
+  }
+  if (fields_ & kVersion) {
+    version_.Append(partition.GetVersion());
+  }
+  ++size_;
+}
+
+void CompactPartitions::Reserve(size_t count) {
+  partition_.ends.reserve(count);
+  if (fields_ & kDataHandle) {
+    data_handle_.ends.reserve(count);
+  }
+  if (fields_ & kChecksum) {
+    checksum_.ends.reserve(count);
+  }
+  if (fields_ & kDataSize) {
+    data_size_.values.reserve(count);
+  }
+  if (fields_ & kCompressedDataSize) {
+    compressed_data_size_.values.reserve(count);
+  }
+  if (fields_ & kCrc) {
+    crc_.ends.reserve(count);
+  }
+  if (fields_ & kVersion) {
+    version_.values.reserve(count);
+  }
+}
+
+}  // namespace model
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "DataDecompressor.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifdef OLP_SDK_READ_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#include <olp/core/logging/Log.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+constexpr auto kLogTag = "DataDecompressor";
+constexpr unsigned char kGzipMagic[] = {0x1f, 0x8b};
+
+#ifdef OLP_SDK_READ_HAS_ZLIB
+// Limits the preallocation, the size in the gzip trailer is not trusted.
+constexpr size_t kMaxInitialSize = 64u * 1024u * 1024u;
+constexpr size_t kMinChunkSize = 16u * 1024u;
+
+size_t ExpectedSize(const std::vector<unsigned char>& input) {
+  // The last 4 bytes of a gzip member are the size of the uncompressed data
+  // modulo 2^32, little-endian.
+  const auto size = input.size();
+  const size_t expected = static_cast<size_t>(input[size - 4]) |
+                          static_cast<size_t>(input[size - 3]) << 8 |
+                          static_cast<size_t>(input[size - 2]) << 16 |
+                          static_cast<size_t>(input[size - 1]) << 24;
+  return std::min(std::max(expected, size), kMaxInitialSize);
+}
+
+DataResponse Inflate(const std::vector<unsigned char>& input) {
+  z_stream stream{};
+  // 16 + MAX_WBITS accepts the gzip header and trailer.
+  if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+    return client::ApiError(client::ErrorCode::Unknown,
+                            "Failed to initialize the decompression");
+  }
+
+  auto output = std::make_shared<std::vector<unsigned char>>();
+  output->resize(ExpectedSize(input));
+
+  stream.next_in = const_cast<Bytef*>(input.data());
+  stream.avail_in = static_cast<uInt>(input.size());
+
+  int result = Z_OK;
+  size_t produced = 0u;
+  while (result != Z_STREAM_END) {
+    if (produced == output->size()) {
+      output->resize(output->size() + std::max(output->size(), kMinChunkSize));
+    }
+
+    stream.next_out = output->data() + produced;
+    stream.avail_out = static_cast<uInt>(output->size() - produced);
+
+    result = inflate(&stream, Z_NO_FLUSH);
+    produced = output->size() - stream.avail_out;
+
+    if (result == Z_BUF_ERROR && stream.avail_in == 0u) {
+      break;
+    }
+    if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+      break;
+    }
+  }
+  inflateEnd(&stream);
+
+  if (result != Z_STREAM_END) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Failed to decompress data, error=%d",
+                          result);
+    return client::ApiError(client::ErrorCode::Unknown,
+                            "Failed to decompress the data");
+  }
+
+  output->resize(produced);
+  return model::Data(std::move(output));
+}
+#endif
+}  // namespace
+
+bool IsGzipCompressed(const model::Data& data) {
+  // The header is 10 bytes and the trailer is 8 bytes.
+  return data && data->size() >= 18u && (*data)[0] == kGzipMagic[0] &&
+         (*data)[1] == kGzipMagic[1];
+}
+
+DataResponse DecompressData(DataResponse response) {
+  if (!response.IsSuccessful() || !IsGzipCompressed(response.GetResult())) {
+    return response;
+  }
+
+#ifdef OLP_SDK_READ_HAS_ZLIB
+  return Inflate(*response.GetResult());
+#else
+  OLP_SDK_LOG_WARNING(kLogTag, "Decompression is not supported, no zlib");
+  return client::ApiError(client::ErrorCode::PreconditionFailed,
+                          "The SDK is built without the decompression support");
+#endif
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
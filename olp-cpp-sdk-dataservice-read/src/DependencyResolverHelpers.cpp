@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "DependencyResolverHelpers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+struct ParallelForState {
+  ParallelForState(size_t count, std::function<void(size_t)> func)
+      : count(count), func(std::move(func)) {}
+
+  void Run() {
+    size_t index;
+    while ((index = next.fetch_add(1u)) < count) {
+      func(index);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (++finished == count) {
+        condition.notify_all();
+      }
+    }
+  }
+
+  const size_t count;
+  const std::function<void(size_t)> func;
+  std::atomic<size_t> next{0u};
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t finished{0u};
+};
+}  // namespace
+
+std::vector<TileKeys> GroupTilesByQuadTree(const TileKeys& tiles,
+                                           std::uint32_t quad_tree_depth) {
+  std::vector<TileKeys> groups;
+  if (tiles.empty()) {
+    return groups;
+  }
+
+  // A quad tree of a tile has the root at most `quad_tree_depth` levels above
+  // it. Tiles with different ancestors on the level above all the roots
+  // cannot share a quad tree.
+  const auto min_level =
+      std::min_element(tiles.begin(), tiles.end(),
+                       [](const geo::TileKey& lhs, const geo::TileKey& rhs) {
+                         return lhs.Level() < rhs.Level();
+                       })
+          ->Level();
+  const auto group_level =
+      min_level > quad_tree_depth ? min_level - quad_tree_depth : 0u;
+
+  std::map<geo::TileKey, size_t> group_indexes;
+  for (const auto& tile : tiles) {
+    auto result = group_indexes.emplace(tile.ChangedLevelTo(group_level),
+                                        groups.size());
+    if (result.second) {
+      groups.emplace_back();
+    }
+    groups[result.first->second].push_back(tile);
+  }
+  return groups;
+}
+
+void ParallelFor(size_t count,
+                 const std::shared_ptr<thread::TaskScheduler>& task_scheduler,
+                 const std::function<void(size_t)>& func,
+                 size_t max_workers) {
+  const size_t threads =
+      max_workers > 0u ? max_workers
+                       : std::max(std::thread::hardware_concurrency(), 1u);
+  if (!task_scheduler || count < 2u || threads < 2u) {
+    for (size_t index = 0u; index < count; ++index) {
+      func(index);
+    }
+    return;
+  }
+
+  // The calling thread takes part in the work, so the call completes even
+  // when the scheduler threads are busy. The tasks that start after all the
+  // indexes are taken just return.
+  auto state = std::make_shared<ParallelForState>(count, func);
+  std::vector<thread::TaskScheduler::CallFuncType> tasks;
+  const auto workers = std::min(count, threads) - 1u;
+  tasks.reserve(workers);
+  for (size_t i = 0u; i < workers; ++i) {
+    tasks.emplace_back([state]() { state->Run(); });
+  }
+  task_scheduler->ScheduleTasks(std::move(tasks));
+
+  state->Run();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->condition.wait(lock, [&]() { return state->finished == count; });
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <olp/core/geo/tiling/TileKey.h>
+#include <olp/core/thread/TaskScheduler.h>
+#include <olp/dataservice/read/Types.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/// Splits the tiles into the groups that cannot share a quad tree of the
+/// `quad_tree_depth` depth, so the groups can be resolved independently. The
+/// tiles keep their order within a group.
+std::vector<TileKeys> GroupTilesByQuadTree(const TileKeys& tiles,
+                                           std::uint32_t quad_tree_depth);
+
+/// Calls `func` for each index below `count` on the scheduler threads and on
+/// the calling thread, and returns when all the calls are finished. Without a
+/// scheduler, all the calls are made on the calling thread. At most
+/// `max_workers` calls run at the same time, 0 is for the number of hardware
+/// threads.
+void ParallelFor(size_t count,
+                 const std::shared_ptr<thread::TaskScheduler>& task_scheduler,
+                 const std::function<void(size_t)>& func,
+                 size_t max_workers = 0u);
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
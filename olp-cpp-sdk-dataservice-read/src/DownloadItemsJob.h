@@ -62,6 +62,34 @@ class DownloadItemsJob {
   void Initialize(size_t items_count, client::NetworkStatistics statistics) {
     download_task_count_ = total_download_task_count_ = items_count;
     accumulated_statistics_ = statistics;
+    adding_completed_ = true;
+  }
+
+  /// Adds the items found by a query when the downloads start before all the
+  /// queries are complete, instead of `Initialize`.
+  void AddItems(size_t items_count,
+                const client::NetworkStatistics& statistics) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    download_task_count_ += items_count;
+    total_download_task_count_ += items_count;
+    accumulated_statistics_ += statistics;
+  }
+
+  /// Removes the added items that are not downloaded.
+  void RemoveItems(size_t items_count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    download_task_count_ -= items_count;
+    total_download_task_count_ -= items_count;
+    CompleteIfDone();
+  }
+
+  /// Completes the job when the added items are downloaded, or with the error
+  /// when it is set.
+  void CompleteAdding(boost::optional<client::ApiError> error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    adding_completed_ = true;
+    error_ = std::move(error);
+    CompleteIfDone();
   }
 
   ExtendedDataResponse Download(const std::string& data_handle,
@@ -95,13 +123,8 @@ class DownloadItemsJob {
           GetAccumulatedBytes(accumulated_statistics_)});
     }
 
-    if (!--download_task_count_) {
-      OLP_SDK_LOG_DEBUG_F("DownloadItemsJob",
-                          "Download complete, succeeded=%zu, failed=%zu",
-                          requests_succeeded_, requests_failed_);
-
-      OnPrefetchCompleted(std::move(prefetch_result_));
-    }
+    --download_task_count_;
+    CompleteIfDone();
   }
 
   void OnPrefetchCompleted(Response<PrefetchResult> result) {
@@ -110,6 +133,22 @@ class DownloadItemsJob {
   }
 
  private:
+  void CompleteIfDone() {
+    if (download_task_count_ || !adding_completed_) {
+      return;
+    }
+
+    OLP_SDK_LOG_DEBUG_F("DownloadItemsJob",
+                        "Download complete, succeeded=%zu, failed=%zu",
+                        requests_succeeded_, requests_failed_);
+
+    if (error_) {
+      OnPrefetchCompleted(std::move(*error_));
+    } else {
+      OnPrefetchCompleted(std::move(prefetch_result_));
+    }
+  }
+
   DownloadFunc download_;
   AppendResultFunc<ItemType, PrefetchResult> append_result_;
   Callback<PrefetchResult> user_callback_;
@@ -120,6 +159,8 @@ class DownloadItemsJob {
   size_t requests_failed_{0};
   client::NetworkStatistics accumulated_statistics_;
   PrefetchResult prefetch_result_;
+  bool adding_completed_{false};
+  boost::optional<client::ApiError> error_;
   std::mutex mutex_;
 };
 
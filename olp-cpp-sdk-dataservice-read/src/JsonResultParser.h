@@ -24,21 +24,30 @@
 #include <utility>
 
 #include <olp/core/client/ApiError.h>
+#include <olp/core/client/HttpResponse.h>
 #include <olp/core/generated/parser/JsonParser.h>
 #include <olp/core/logging/Log.h>
 
 namespace olp {
 namespace parser {
 
+/// Parses the body of the response, a body stored in a byte buffer is read in
+/// place.
+template <typename T>
+inline T parse(client::HttpResponse& response, bool& res) {
+  const auto buffer = response.GetResponseBuffer();
+  return parse<T>(*buffer, res);
+}
+
 template <typename OutputResult,
           typename ParsingType = typename OutputResult::ResultType,
-          typename... AdditionalArgs>
+          typename Input, typename... AdditionalArgs>
 typename std::enable_if<
     std::is_constructible<ParsingType, ParsingType, AdditionalArgs...>::value,
     OutputResult>::type
-parse_result(std::stringstream& json_stream, const AdditionalArgs&... args) {
+parse_result(Input& json, const AdditionalArgs&... args) {
   bool res = true;
-  auto obj = parse<ParsingType>(json_stream, res);
+  auto obj = parse<ParsingType>(json, res);
 
   if (res) {
     return ParsingType(std::move(obj), args...);
@@ -50,13 +59,13 @@ parse_result(std::stringstream& json_stream, const AdditionalArgs&... args) {
 
 template <typename OutputResult,
           typename ParsingType = typename OutputResult::ResultType,
-          typename... AdditionalArgs>
+          typename Input, typename... AdditionalArgs>
 typename std::enable_if<
     !std::is_constructible<ParsingType, ParsingType, AdditionalArgs...>::value,
     OutputResult>::type
-parse_result(std::stringstream& json_stream, const AdditionalArgs&... args) {
+parse_result(Input& json, const AdditionalArgs&... args) {
   bool res = true;
-  auto obj = parse<ParsingType>(json_stream, res);
+  auto obj = parse<ParsingType>(json, res);
 
   if (res) {
     return OutputResult({std::move(obj), args...});
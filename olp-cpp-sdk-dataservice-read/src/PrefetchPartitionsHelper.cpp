@@ -20,91 +20,295 @@
 #include "PrefetchPartitionsHelper.h"
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include <olp/core/client/CancellationContext.h>
-#include <olp/core/client/PendingRequests.h>
 #include <olp/core/logging/Log.h>
 #include <olp/dataservice/read/Types.h>
-#include "Common.h"
-#include "DownloadItemsJob.h"
-#include "ExtendedApiResponse.h"
 #include "ExtendedApiResponseHelpers.h"
-#include "QueryPartitionsJob.h"
 #include "TaskSink.h"
-#include "repositories/PartitionsRepository.h"
 
 namespace olp {
 namespace dataservice {
 namespace read {
 namespace {
-const size_t kQueryPartitionsMaxSize = 100u;
+constexpr auto kLogTag = "PrefetchJob";
+
+client::ApiError Cancelled() {
+  return client::ApiError(client::ErrorCode::Cancelled, "Cancelled");
 }
+}  // namespace
+
+constexpr size_t PrefetchPartitionsHelper::kMaxQueryChunkSize;
 
 void PrefetchPartitionsHelper::Prefetch(
     std::shared_ptr<DownloadJob> download_job,
-    std::vector<std::string> partitions, QueryFunc query, TaskSink& task_sink,
-    uint32_t priority, client::CancellationContext execution_context) {
-  auto query_job = std::make_shared<QueryPartitionsJob>(
-      std::move(query), nullptr, download_job, task_sink, execution_context,
+    std::vector<std::string> partitions, QueryFunc query, Settings settings,
+    TaskSink& task_sink, uint32_t priority,
+    client::CancellationContext execution_context) {
+  auto helper = std::make_shared<PrefetchPartitionsHelper>(
+      std::move(download_job), std::move(query), settings, task_sink,
       priority);
+  helper->Start(std::move(partitions), execution_context);
+}
+
+PrefetchPartitionsHelper::PrefetchPartitionsHelper(
+    std::shared_ptr<DownloadJob> download_job, QueryFunc query,
+    Settings settings, TaskSink& task_sink, uint32_t priority)
+    : download_job_(std::move(download_job)),
+      query_(std::move(query)),
+      settings_(settings),
+      task_sink_(task_sink),
+      priority_(priority) {}
+
+void PrefetchPartitionsHelper::Start(
+    std::vector<std::string> partitions,
+    client::CancellationContext execution_context) {
+  const auto partitions_count = partitions.size();
+  const size_t chunk_size = std::max<size_t>(
+      std::min(settings_.query_chunk_size, kMaxQueryChunkSize), 1u);
+
+  for (auto it = partitions.begin(); it != partitions.end();) {
+    const auto size = std::min(
+        chunk_size, static_cast<size_t>(std::distance(it, partitions.end())));
+    pending_queries_.emplace_back(std::make_move_iterator(it),
+                                  std::make_move_iterator(it + size));
+    std::advance(it, size);
+  }
+  queries_count_ = queries_left_ = pending_queries_.size();
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Starting queries, requests=%zu",
+                      queries_count_);
 
-  size_t query_size = partitions.size() / kQueryPartitionsMaxSize;
-  query_size += (partitions.size() % kQueryPartitionsMaxSize > 0) ? 1 : 0;
+  // All the requested partitions are counted from the start, so the status
+  // shows the progress of the whole prefetch.
+  download_job_->AddItems(partitions_count, client::NetworkStatistics());
 
-  query_job->Initialize(query_size);
+  if (pending_queries_.empty()) {
+    download_job_->CompleteAdding(boost::none);
+    return;
+  }
 
-  OLP_SDK_LOG_DEBUG_F("PrefetchJob", "Starting queries, requests=%zu",
-                      query_size);
+  auto self = shared_from_this();
 
   execution_context.ExecuteOrCancelled(
       [&]() {
-        VectorOfTokens tokens;
-        tokens.reserve(query_size);
-
-        for (auto p_it = partitions.begin(); p_it != partitions.end();) {
-          const size_t batch_size = std::min(
-              kQueryPartitionsMaxSize,
-              static_cast<size_t>(std::distance(p_it, partitions.end())));
-          std::vector<std::string> elements(
-              std::make_move_iterator(p_it),
-              std::make_move_iterator(p_it + batch_size));
-
-          std::advance(p_it, batch_size);
-
-          auto query_partition_func =
-              [query_job](client::CancellationContext context,
-                          std::vector<std::string>& partitions) {
-                return query_job->Query(std::move(partitions), context);
-              };
-
-          auto token = task_sink.AddTaskChecked(
-              std::bind(std::move(query_partition_func), std::placeholders::_1,
-                        std::move(elements)),
-              [query_job](PartitionsDataHandleExtendedResponse response) {
-                query_job->CompleteQuery(std::move(response));
-              },
-              priority);
-
-          if (!token) {
-            query_job->CompleteQuery(
-                client::ApiError(client::ErrorCode::Cancelled, "Cancelled"));
-          } else {
-            tokens.emplace_back(*token);
-          }
+        std::vector<client::TaskContext> tasks;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          tasks = TakeQueries();
         }
 
-        return CreateToken(std::move(tokens));
+        Schedule(std::move(tasks));
+
+        // The tasks are scheduled later, so the token cancels the tasks known
+        // at the time of the cancellation.
+        return client::CancellationToken([=]() { self->Cancel(); });
       },
       [&]() {
-        download_job->OnPrefetchCompleted(
-            {{client::ErrorCode::Cancelled, "Cancelled"}});
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          cancelled_ = true;
+          DropQueries();
+        }
+        download_job_->OnPrefetchCompleted(Cancelled());
       });
 }
 
+void PrefetchPartitionsHelper::CompleteQuery(
+    size_t chunk_size, PartitionsDataHandleExtendedResponse response) {
+  std::vector<client::TaskContext> tasks;
+  size_t removed = 0;
+  bool queries_completed = false;
+  boost::optional<client::ApiError> error;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --queries_in_flight_;
+
+    download_job_->AddItems(0, GetNetworkStatistics(response));
+
+    if (!response.IsSuccessful()) {
+      if (response.GetError().GetErrorCode() == client::ErrorCode::Cancelled) {
+        cancelled_ = true;
+      } else {
+        ++failed_queries_;
+        if (!error_) {
+          error_ = response.GetError();
+        }
+      }
+      removed = chunk_size;
+    } else if (cancelled_) {
+      removed = chunk_size;
+    } else {
+      auto partitions = response.MoveResult();
+      // The partitions that are not found are not downloaded.
+      if (partitions.size() < chunk_size) {
+        removed = chunk_size - partitions.size();
+      } else if (partitions.size() > chunk_size) {
+        download_job_->AddItems(partitions.size() - chunk_size,
+                                client::NetworkStatistics());
+      }
+      tasks = CreateDownloads(std::move(partitions));
+    }
+
+    if (cancelled_) {
+      removed += DropQueries();
+    }
+
+    queries_completed = (--queries_left_ == 0);
+    if (queries_completed) {
+      error = GetError();
+      OLP_SDK_LOG_DEBUG_F(kLogTag, "Queries complete, failed=%zu",
+                          failed_queries_);
+    }
+
+    auto queries = TakeQueries();
+    std::move(queries.begin(), queries.end(), std::back_inserter(tasks));
+  }
+
+  Schedule(std::move(tasks));
+
+  if (removed) {
+    download_job_->RemoveItems(removed);
+  }
+
+  if (queries_completed) {
+    download_job_->CompleteAdding(std::move(error));
+  }
+}
+
+void PrefetchPartitionsHelper::Cancel() {
+  VectorOfTokens tokens;
+  size_t dropped = 0;
+  bool queries_completed = false;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_ = true;
+    const auto left = queries_left_;
+    dropped = DropQueries();
+    queries_completed = left > 0 && queries_left_ == 0;
+    tokens.swap(tokens_);
+  }
+
+  for (const auto& token : tokens) {
+    token.Cancel();
+  }
+
+  if (dropped) {
+    download_job_->RemoveItems(dropped);
+  }
+
+  // No query is in flight to complete the prefetch.
+  if (queries_completed) {
+    download_job_->CompleteAdding(Cancelled());
+  }
+}
+
+std::vector<client::TaskContext> PrefetchPartitionsHelper::TakeQueries() {
+  std::vector<client::TaskContext> tasks;
+  if (cancelled_) {
+    return tasks;
+  }
+
+  auto self = shared_from_this();
+  const auto limit = settings_.max_parallel_queries;
+
+  while (!pending_queries_.empty() &&
+         (limit == 0 || queries_in_flight_ < limit)) {
+    auto partitions = std::move(pending_queries_.front());
+    pending_queries_.pop_front();
+    const auto chunk_size = partitions.size();
+
+    auto query = [self](client::CancellationContext context,
+                        std::vector<std::string>& partitions) {
+      return self->query_(std::move(partitions), context);
+    };
+
+    tasks.emplace_back(client::TaskContext::Create(
+        std::bind(std::move(query), std::placeholders::_1,
+                  std::move(partitions)),
+        [self, chunk_size](PartitionsDataHandleExtendedResponse response) {
+          self->CompleteQuery(chunk_size, std::move(response));
+        }));
+    tokens_.emplace_back(tasks.back().CancelToken());
+    ++queries_in_flight_;
+  }
+
+  return tasks;
+}
+
+std::vector<client::TaskContext> PrefetchPartitionsHelper::CreateDownloads(
+    PartitionDataHandleResult partitions) {
+  std::vector<client::TaskContext> tasks;
+  tasks.reserve(partitions.size());
+
+  auto download_job = download_job_;
+  for (auto& partition : partitions) {
+    const auto partition_id = std::move(partition.first);
+    const auto data_handle = std::move(partition.second);
+
+    tasks.emplace_back(client::TaskContext::Create(
+        [=](client::CancellationContext context) {
+          return download_job->Download(data_handle, context);
+        },
+        [=](ExtendedDataResponse response) {
+          download_job->CompleteItem(partition_id, std::move(response));
+        }));
+    tokens_.emplace_back(tasks.back().CancelToken());
+  }
+
+  return tasks;
+}
+
+size_t PrefetchPartitionsHelper::DropQueries() {
+  size_t dropped = 0;
+  for (const auto& partitions : pending_queries_) {
+    dropped += partitions.size();
+  }
+  queries_left_ -= pending_queries_.size();
+  pending_queries_.clear();
+  return dropped;
+}
+
+boost::optional<client::ApiError> PrefetchPartitionsHelper::GetError() const {
+  if (cancelled_) {
+    return Cancelled();
+  }
+
+  // Return error only if all fails.
+  if (failed_queries_ == queries_count_) {
+    return error_;
+  }
+
+  return boost::none;
+}
+
+void PrefetchPartitionsHelper::Schedule(
+    std::vector<client::TaskContext> tasks) {
+  if (tasks.empty()) {
+    return;
+  }
+
+  if (task_sink_.AddTasks(tasks, priority_)) {
+    return;
+  }
+
+  // The sink is closed, so the tasks never run: cancel the prefetch and run
+  // them here to report the partitions as cancelled.
+  Cancel();
+
+  for (const auto& task : tasks) {
+    task.Execute();
+  }
+}
+
 }  // namespace read
 }  // namespace dataservice
 }  // namespace olp
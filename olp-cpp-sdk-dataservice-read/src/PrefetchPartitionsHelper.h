@@ -19,11 +19,23 @@
 
 #pragma once
 
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
 #include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/TaskContext.h>
 #include <olp/dataservice/read/Types.h>
 #include "Common.h"
 #include "DownloadItemsJob.h"
-#include "QueryPartitionsJob.h"
+#include "ExtendedApiResponse.h"
+#include "QueryMetadataJob.h"
 
 namespace olp {
 namespace dataservice {
@@ -31,17 +43,91 @@ namespace read {
 
 class TaskSink;
 
-class PrefetchPartitionsHelper {
+using PartitionDataHandleResult =
+    std::vector<std::pair<std::string, std::string>>;
+using PartitionsDataHandleExtendedResponse =
+    ExtendedApiResponse<PartitionDataHandleResult, client::ApiError,
+                        client::NetworkStatistics>;
+
+/**
+ * @brief Queries the partitions in chunks and downloads the partitions of
+ * each chunk as soon as it is queried.
+ *
+ * At most `max_parallel_queries` chunks are queried at the same time, the
+ * next one when a query completes, so the downloads do not wait behind the
+ * remaining queries. The status counts all the requested partitions from the
+ * start, and the ones that are not found are removed from it.
+ *
+ * The prefetch fails only when all the queries fail.
+ */
+class PrefetchPartitionsHelper
+    : public std::enable_shared_from_this<PrefetchPartitionsHelper> {
  public:
   using DownloadJob = DownloadItemsJob<std::string, PrefetchPartitionsResult,
                                        PrefetchPartitionsStatus>;
   using QueryFunc = QueryItemsFunc<std::string, std::vector<std::string>,
                                    PartitionsDataHandleExtendedResponse>;
 
+  /// The maximum number of the partitions in one query.
+  static constexpr size_t kMaxQueryChunkSize = 100u;
+
+  struct Settings {
+    /// The number of the partitions in one query, up to `kMaxQueryChunkSize`.
+    size_t query_chunk_size{kMaxQueryChunkSize};
+    /// The maximum number of the queries in flight, or 0 for no limit.
+    size_t max_parallel_queries{0};
+  };
+
   static void Prefetch(std::shared_ptr<DownloadJob> download_job,
                        std::vector<std::string> partitions, QueryFunc query,
-                       TaskSink& task_sink, uint32_t priority,
+                       Settings settings, TaskSink& task_sink,
+                       uint32_t priority,
                        client::CancellationContext execution_context);
+
+  PrefetchPartitionsHelper(std::shared_ptr<DownloadJob> download_job,
+                           QueryFunc query, Settings settings,
+                           TaskSink& task_sink, uint32_t priority);
+
+ private:
+  void Start(std::vector<std::string> partitions,
+             client::CancellationContext execution_context);
+
+  void CompleteQuery(size_t chunk_size,
+                     PartitionsDataHandleExtendedResponse response);
+
+  void Cancel();
+
+  /// Creates the query tasks that fit the limit. Requires the lock.
+  std::vector<client::TaskContext> TakeQueries();
+
+  /// Creates the download tasks of the queried partitions. Requires the lock.
+  std::vector<client::TaskContext> CreateDownloads(
+      PartitionDataHandleResult partitions);
+
+  /// Drops the chunks that are not queried yet and returns the number of
+  /// their partitions. Requires the lock.
+  size_t DropQueries();
+
+  /// Returns the error the prefetch completes with. Requires the lock.
+  boost::optional<client::ApiError> GetError() const;
+
+  void Schedule(std::vector<client::TaskContext> tasks);
+
+  std::shared_ptr<DownloadJob> download_job_;
+  QueryFunc query_;
+  const Settings settings_;
+  TaskSink& task_sink_;
+  const uint32_t priority_;
+
+  std::mutex mutex_;
+  std::deque<std::vector<std::string>> pending_queries_;
+  size_t queries_count_{0};
+  size_t queries_left_{0};
+  size_t queries_in_flight_{0};
+  size_t failed_queries_{0};
+  bool cancelled_{false};
+  boost::optional<client::ApiError> error_;
+  VectorOfTokens tokens_;
 };
 
 }  // namespace read
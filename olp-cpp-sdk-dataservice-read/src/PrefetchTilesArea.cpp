@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "PrefetchTilesArea.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <olp/core/geo/projection/EarthConstants.h>
+#include <olp/core/geo/tiling/TileKeyUtils.h>
+#include <olp/core/geo/tiling/TilingSchemeRegistry.h>
+#include <olp/core/math/AlignedBox.h>
+#include <olp/core/math/Math.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+PrefetchTilesArea::PrefetchTilesArea(const PrefetchTilesRequest& request) {
+  const auto& rectangle = request.GetGeoRectangle();
+  if (rectangle && !rectangle->IsEmpty()) {
+    const auto south_west = rectangle->SouthWest();
+    const auto north_east = rectangle->NorthEast();
+    const auto west = south_west.GetLongitude();
+    const auto east = north_east.GetLongitude();
+
+    if (west <= east) {
+      rectangles_.push_back(Box{west, south_west.GetLatitude(), east,
+                                north_east.GetLatitude()});
+    } else {
+      // The rectangle crosses the antimeridian.
+      rectangles_.push_back(Box{west, south_west.GetLatitude(), math::pi,
+                                north_east.GetLatitude()});
+      rectangles_.push_back(Box{-math::pi, south_west.GetLatitude(), east,
+                                north_east.GetLatitude()});
+    }
+  }
+
+  for (const auto& vertex : request.GetPolygon()) {
+    polygon_.push_back(Point{vertex.GetLongitude(), vertex.GetLatitude()});
+  }
+
+  // A polygon needs three vertices at least.
+  if (polygon_.size() < 3u) {
+    polygon_.clear();
+  }
+
+  for (const auto& point : request.GetCorridorPath()) {
+    corridor_.push_back(Point{point.GetLongitude(), point.GetLatitude()});
+  }
+
+  corridor_radius_ = std::max(request.GetCorridorRadius(), 0.0) /
+                     geo::EarthConstants::EquatorialRadius();
+}
+
+bool PrefetchTilesArea::IsEmpty() const {
+  return rectangles_.empty() && polygon_.empty() && corridor_.empty();
+}
+
+bool PrefetchTilesArea::Intersects(const geo::TileKey& tile) const {
+  const auto box = TileBox(tile);
+
+  for (const auto& rectangle : rectangles_) {
+    if (Overlaps(box, rectangle)) {
+      return true;
+    }
+  }
+
+  return PolygonIntersects(box) || CorridorIntersects(box);
+}
+
+PrefetchTilesArea::Box PrefetchTilesArea::TileBox(const geo::TileKey& tile) {
+  // The identity projection keeps the longitude and latitude in radians.
+  static const geo::HalfQuadTreeIdentityTilingScheme kTilingScheme;
+  const auto box = geo::CalculateTileBox(kTilingScheme, tile);
+  return Box{box.Minimum().x, box.Minimum().y, box.Maximum().x,
+             box.Maximum().y};
+}
+
+bool PrefetchTilesArea::Overlaps(const Box& lhs, const Box& rhs) {
+  // The tiles that only touch the area are skipped.
+  return lhs.west < rhs.east && rhs.west < lhs.east && lhs.south < rhs.north &&
+         rhs.south < lhs.north;
+}
+
+bool PrefetchTilesArea::SegmentIntersects(const Point& begin,
+                                          const Point& end, const Box& box) {
+  // Liang-Barsky clipping of the segment by the box.
+  const auto dx = end.x - begin.x;
+  const auto dy = end.y - begin.y;
+  double enter = 0.0;
+  double leave = 1.0;
+
+  auto clip = [&](double direction, double distance) {
+    if (direction == 0.0) {
+      return distance >= 0.0;
+    }
+
+    const auto t = distance / direction;
+    if (direction < 0.0) {
+      if (t > leave) {
+        return false;
+      }
+      enter = std::max(enter, t);
+    } else {
+      if (t < enter) {
+        return false;
+      }
+      leave = std::min(leave, t);
+    }
+    return true;
+  };
+
+  return clip(-dx, begin.x - box.west) && clip(dx, box.east - begin.x) &&
+         clip(-dy, begin.y - box.south) && clip(dy, box.north - begin.y);
+}
+
+bool PrefetchTilesArea::PolygonContains(const Point& point) const {
+  bool inside = false;
+  for (size_t i = 0, j = polygon_.size() - 1; i < polygon_.size(); j = i++) {
+    const auto& a = polygon_[i];
+    const auto& b = polygon_[j];
+    if ((a.y > point.y) != (b.y > point.y) &&
+        point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+bool PrefetchTilesArea::PolygonIntersects(const Box& box) const {
+  if (polygon_.empty()) {
+    return false;
+  }
+
+  // The tile inside of the polygon.
+  if (PolygonContains(Point{(box.west + box.east) / 2.0,
+                            (box.south + box.north) / 2.0})) {
+    return true;
+  }
+
+  // The edges crossing the tile, or the polygon inside of the tile.
+  for (size_t i = 0, j = polygon_.size() - 1; i < polygon_.size(); j = i++) {
+    if (SegmentIntersects(polygon_[j], polygon_[i], box)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool PrefetchTilesArea::CorridorIntersects(const Box& box) const {
+  if (corridor_.empty()) {
+    return false;
+  }
+
+  // Grows the tile by the radius instead of measuring the distance to the
+  // path, so the corners of the corridor are slightly wider.
+  const auto max_latitude = std::max(std::abs(box.south), std::abs(box.north));
+  const auto cos_latitude = std::cos(std::min(max_latitude, math::half_pi));
+  const auto longitude_radius =
+      corridor_radius_ < math::pi * cos_latitude
+          ? corridor_radius_ / cos_latitude
+          : math::two_pi;
+
+  const Box grown{box.west - longitude_radius, box.south - corridor_radius_,
+                  box.east + longitude_radius, box.north + corridor_radius_};
+
+  if (corridor_.size() == 1u) {
+    return SegmentIntersects(corridor_.front(), corridor_.front(), grown);
+  }
+
+  for (size_t i = 1; i < corridor_.size(); ++i) {
+    if (SegmentIntersects(corridor_[i - 1], corridor_[i], grown)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <olp/core/geo/tiling/TileKey.h>
+#include <olp/dataservice/read/PrefetchTilesRequest.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief The area of a tile prefetch request.
+ *
+ * Unites the rectangle, the polygon, and the corridor of the request. The
+ * tiles are compared as the longitude and latitude rectangles of the
+ * HERE tiling scheme.
+ */
+class PrefetchTilesArea {
+ public:
+  explicit PrefetchTilesArea(const PrefetchTilesRequest& request);
+
+  /// Returns true if the request has no area.
+  bool IsEmpty() const;
+
+  /// Checks if the tile intersects the area.
+  bool Intersects(const geo::TileKey& tile) const;
+
+ private:
+  /// A point in radians, `x` is the longitude.
+  struct Point {
+    double x;
+    double y;
+  };
+
+  /// A rectangle in radians.
+  struct Box {
+    double west;
+    double south;
+    double east;
+    double north;
+  };
+
+  static Box TileBox(const geo::TileKey& tile);
+
+  static bool Overlaps(const Box& lhs, const Box& rhs);
+
+  static bool SegmentIntersects(const Point& begin, const Point& end,
+                                const Box& box);
+
+  bool PolygonContains(const Point& point) const;
+
+  bool PolygonIntersects(const Box& box) const;
+
+  bool CorridorIntersects(const Box& box) const;
+
+  std::vector<Box> rectangles_;
+  std::vector<Point> polygon_;
+  std::vector<Point> corridor_;
+  double corridor_radius_{0.0};
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -31,6 +31,7 @@
 #include "DownloadItemsJob.h"
 #include "ExtendedApiResponse.h"
 #include "ExtendedApiResponseHelpers.h"
+#include "PrefetchTilesPipeline.h"
 #include "QueryMetadataJob.h"
 #include "TaskSink.h"
 #include "repositories/PrefetchTilesRepository.h"
@@ -69,29 +70,47 @@ class PrefetchTilesHelper {
     execution_context.ExecuteOrCancelled(
         [&]() {
           VectorOfTokens tokens;
+          tokens.reserve(roots.size());
+          std::vector<client::TaskContext> tasks;
+          tasks.reserve(roots.size());
 
-          auto transform_func = [&](geo::TileKey root) {
-            auto token = task_sink.AddTaskChecked(
+          for (const auto& root : roots) {
+            tasks.emplace_back(client::TaskContext::Create(
                 [=](client::CancellationContext context) {
                   return query_job->Query(root, context);
                 },
                 [=](repository::SubQuadsResponse response) {
                   query_job->CompleteQuery(std::move(response));
-                },
-                priority);
-            if (!token) {
+                }));
+            tokens.emplace_back(tasks.back().CancelToken());
+          }
+
+          // The queries are scheduled at once instead of one by one.
+          if (!task_sink.AddTasks(std::move(tasks), priority)) {
+            for (size_t idx = 0; idx < roots.size(); ++idx) {
               query_job->CompleteQuery(Canceled());
-              return client::CancellationToken();
             }
-            return *token;
-          };
+            return client::CancellationToken();
+          }
 
-          std::transform(std::begin(roots), std::end(roots),
-                         std::back_inserter(tokens), std::move(transform_func));
           return CreateToken(std::move(tokens));
         },
         [&]() { download_job->OnPrefetchCompleted(Canceled()); });
   }
+
+  /// Downloads the tiles of each quad tree as soon as it is resolved instead
+  /// of after all of them.
+  static void PrefetchPipelined(
+      std::shared_ptr<DownloadJob> download_job,
+      const std::vector<geo::TileKey>& roots, QueryFunc query,
+      FilterItemsFunc<repository::SubQuadsResult> filter,
+      PrefetchTilesPipeline::Settings settings, TaskSink& task_sink,
+      uint32_t priority, client::CancellationContext execution_context) {
+    auto pipeline = std::make_shared<PrefetchTilesPipeline>(
+        std::move(download_job), std::move(query), std::move(filter),
+        std::move(settings), task_sink, priority);
+    pipeline->Start(roots, execution_context);
+  }
 };
 
 }  // namespace read
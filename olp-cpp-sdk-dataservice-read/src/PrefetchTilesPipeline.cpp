@@ -0,0 +1,488 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "PrefetchTilesPipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <olp/core/geo/tiling/TileKeyUtils.h>
+#include <olp/core/geo/tiling/TilingSchemeRegistry.h>
+#include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/math/AlignedBox.h>
+#include <olp/core/math/Math.h>
+#include <olp/core/porting/make_unique.h>
+#include "ExtendedApiResponseHelpers.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+constexpr auto kLogTag = "PrefetchTilesPipeline";
+// The adaptive limit starts low and grows with the throughput.
+constexpr size_t kInitialAdaptiveDownloads = 4u;
+
+client::ApiError Cancelled() {
+  return client::ApiError(client::ErrorCode::Cancelled, "Cancelled");
+}
+
+std::vector<geo::TileKey> GetTileKeys(
+    const repository::SubQuadsResult& tiles) {
+  std::vector<geo::TileKey> keys;
+  keys.reserve(tiles.size());
+  for (const auto& tile : tiles) {
+    keys.push_back(tile.first);
+  }
+  return keys;
+}
+}  // namespace
+
+constexpr size_t PrefetchTilesPipeline::kMaxAdaptiveDownloads;
+
+PrefetchTilesPipeline::PrefetchTilesPipeline(
+    std::shared_ptr<DownloadJob> download_job, QueryFunc query,
+    FilterFunc filter, Settings settings, TaskSink& task_sink,
+    uint32_t priority)
+    : download_job_(std::move(download_job)),
+      query_(std::move(query)),
+      filter_(std::move(filter)),
+      settings_(std::move(settings)),
+      task_sink_(task_sink),
+      priority_(priority) {
+  if (settings_.adaptive_downloads) {
+    const auto max_limit = settings_.max_in_flight_downloads > 0
+                               ? settings_.max_in_flight_downloads
+                               : kMaxAdaptiveDownloads;
+    adaptive_limit_ = std::make_unique<AdaptiveConcurrencyLimit>(
+        kInitialAdaptiveDownloads, max_limit);
+  }
+}
+
+void PrefetchTilesPipeline::Start(
+    const std::vector<geo::TileKey>& roots,
+    client::CancellationContext execution_context) {
+  queries_left_ = roots.size();
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Starting queries, requests=%zu",
+                      roots.size());
+
+  auto self = shared_from_this();
+
+  execution_context.ExecuteOrCancelled(
+      [&]() {
+        std::vector<client::TaskContext> tasks;
+        tasks.reserve(roots.size());
+
+        for (const auto& root : roots) {
+          tasks.emplace_back(client::TaskContext::Create(
+              [=](client::CancellationContext context) {
+                return self->query_(root, context);
+              },
+              [=](repository::SubQuadsResponse response) {
+                self->CompleteQuery(root, std::move(response));
+              }));
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          for (const auto& task : tasks) {
+            tokens_.emplace_back(task.CancelToken());
+          }
+        }
+
+        // The queries are scheduled at once instead of one by one.
+        if (!task_sink_.AddTasks(std::move(tasks), priority_)) {
+          for (const auto& root : roots) {
+            CompleteQuery(root, Cancelled());
+          }
+          return client::CancellationToken();
+        }
+
+        // The downloads are scheduled later, so the token cancels the tasks
+        // known at the time of the cancellation.
+        return client::CancellationToken([=]() { self->Cancel(); });
+      },
+      [&]() { download_job_->OnPrefetchCompleted(Cancelled()); });
+}
+
+void PrefetchTilesPipeline::CompleteQuery(
+    const geo::TileKey& root, repository::SubQuadsResponse response) {
+  std::vector<client::TaskContext> tasks;
+  std::vector<geo::TileKey> completed_roots;
+  size_t dropped = 0;
+  bool queries_completed = false;
+  boost::optional<client::ApiError> error;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto statistics = GetNetworkStatistics(response);
+
+    if (!response.IsSuccessful()) {
+      if (response.GetError().GetErrorCode() == client::ErrorCode::Cancelled) {
+        cancelled_ = true;
+      } else if (!error_) {
+        // The old behavior: when one of the query requests fails, we fail
+        // the entire prefetch.
+        error_ = response.GetError();
+      }
+      dropped = DropDownloads();
+      download_job_->AddItems(0, statistics);
+    } else if (error_ || cancelled_) {
+      download_job_->AddItems(0, statistics);
+    } else if (settings_.filter_after_all_queries) {
+      auto tiles = response.MoveResult();
+      if (settings_.on_root_completed) {
+        resolved_roots_.emplace_back(root, GetTileKeys(tiles));
+      }
+      query_result_.insert(tiles.begin(), tiles.end());
+      query_statistics_ += statistics;
+    } else {
+      auto tiles = response.MoveResult();
+      if (filter_) {
+        tiles = filter_(std::move(tiles));
+      }
+      const auto tile_keys = GetTileKeys(tiles);
+      QueueDownloads(std::move(tiles), statistics);
+      TrackRoot(root, tile_keys, completed_roots);
+    }
+
+    queries_completed = (--queries_left_ == 0);
+
+    if (queries_completed) {
+      if (error_) {
+        error = error_;
+      } else if (cancelled_) {
+        error = Cancelled();
+      } else if (settings_.filter_after_all_queries) {
+        if (filter_) {
+          query_result_ = filter_(std::move(query_result_));
+        }
+        QueueDownloads(std::move(query_result_), query_statistics_);
+        query_result_.clear();
+
+        // The tiles removed by the filter are not downloaded, so the roots do
+        // not wait for them.
+        for (const auto& resolved_root : resolved_roots_) {
+          TrackRoot(resolved_root.first, resolved_root.second,
+                    completed_roots);
+        }
+        resolved_roots_.clear();
+      }
+
+      OLP_SDK_LOG_DEBUG_F(kLogTag, "Queries complete, downloads=%zu",
+                          queued_tiles_.size());
+    }
+
+    tasks = TakeDownloads();
+  }
+
+  ScheduleDownloads(std::move(tasks));
+
+  ReportCompletedRoots(completed_roots);
+
+  if (dropped) {
+    download_job_->RemoveItems(dropped);
+  }
+
+  if (queries_completed) {
+    download_job_->CompleteAdding(std::move(error));
+  }
+}
+
+void PrefetchTilesPipeline::CompleteDownload(
+    const geo::TileKey& tile,
+    AdaptiveConcurrencyLimit::Clock::time_point started,
+    ExtendedDataResponse response) {
+  std::vector<client::TaskContext> tasks;
+  std::vector<geo::TileKey> completed_roots;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --in_flight_;
+    if (adaptive_limit_) {
+      UpdateLimit(started, response);
+    }
+    TrackDownload(tile, response.IsSuccessful(), completed_roots);
+    tasks = TakeDownloads();
+  }
+
+  ScheduleDownloads(std::move(tasks));
+
+  // The roots are reported first, so they are saved before the prefetch
+  // completes.
+  ReportCompletedRoots(completed_roots);
+
+  download_job_->CompleteItem(tile, std::move(response));
+}
+
+void PrefetchTilesPipeline::UpdateLimit(
+    AdaptiveConcurrencyLimit::Clock::time_point started,
+    const ExtendedDataResponse& response) {
+  bool overloaded = false;
+
+  if (!response.IsSuccessful()) {
+    const auto status = response.GetError().GetHttpStatusCode();
+    overloaded = status == http::HttpStatusCode::TOO_MANY_REQUESTS ||
+                 (status >= http::HttpStatusCode::INTERNAL_SERVER_ERROR &&
+                  status < 600);
+    // The other errors, like the cancellation, say nothing about the network.
+    if (!overloaded) {
+      return;
+    }
+  } else if (GetNetworkStatistics(response).GetBytesDownloaded() == 0) {
+    // The tile was found in the cache.
+    return;
+  }
+
+  const auto now = AdaptiveConcurrencyLimit::Clock::now();
+  adaptive_limit_->OnCompleted(now, now - started, overloaded);
+}
+
+void PrefetchTilesPipeline::Cancel() {
+  VectorOfTokens tokens;
+  size_t dropped = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_ = true;
+    dropped = DropDownloads();
+    tokens.swap(tokens_);
+  }
+
+  for (const auto& token : tokens) {
+    token.Cancel();
+  }
+
+  if (dropped) {
+    download_job_->RemoveItems(dropped);
+  }
+}
+
+void PrefetchTilesPipeline::QueueDownloads(
+    repository::SubQuadsResult tiles,
+    const client::NetworkStatistics& statistics) {
+  size_t added = 0;
+
+  // The equally distant tiles are downloaded in the order of their keys, the
+  // hash map has no order of its own.
+  std::vector<repository::SubQuadsResult::value_type*> sorted_tiles;
+  sorted_tiles.reserve(tiles.size());
+  for (auto& tile : tiles) {
+    sorted_tiles.push_back(&tile);
+  }
+  std::sort(sorted_tiles.begin(), sorted_tiles.end(),
+            [](const repository::SubQuadsResult::value_type* lhs,
+               const repository::SubQuadsResult::value_type* rhs) {
+              return lhs->first < rhs->first;
+            });
+
+  for (auto* tile : sorted_tiles) {
+    // The quad trees of the neighbouring roots may share the tiles.
+    if (!queued_tiles_.insert(tile->first).second) {
+      continue;
+    }
+
+    if (settings_.on_root_completed) {
+      tile_roots_[tile->first];
+    }
+    pending_.push(PendingDownload{SquaredDistance(tile->first), sequence_++,
+                                  tile->first, std::move(tile->second)});
+    ++added;
+  }
+
+  download_job_->AddItems(added, statistics);
+}
+
+void PrefetchTilesPipeline::TrackRoot(
+    const geo::TileKey& root, const std::vector<geo::TileKey>& tiles,
+    std::vector<geo::TileKey>& completed_roots) {
+  if (!settings_.on_root_completed) {
+    return;
+  }
+
+  std::vector<std::vector<geo::TileKey>*> waiting;
+  for (const auto& tile : tiles) {
+    if (failed_tiles_.count(tile)) {
+      return;
+    }
+
+    // The tiles downloaded for the other roots are not tracked anymore.
+    auto it = tile_roots_.find(tile);
+    if (it != tile_roots_.end()) {
+      waiting.push_back(&it->second);
+    }
+  }
+
+  if (waiting.empty()) {
+    completed_roots.push_back(root);
+    return;
+  }
+
+  for (auto* roots : waiting) {
+    roots->push_back(root);
+  }
+  root_downloads_left_[root] = waiting.size();
+}
+
+void PrefetchTilesPipeline::TrackDownload(
+    const geo::TileKey& tile, bool successful,
+    std::vector<geo::TileKey>& completed_roots) {
+  auto it = tile_roots_.find(tile);
+  if (it == tile_roots_.end()) {
+    return;
+  }
+
+  const auto roots = std::move(it->second);
+  tile_roots_.erase(it);
+
+  if (!successful) {
+    failed_tiles_.insert(tile);
+  }
+
+  for (const auto& root : roots) {
+    auto left = root_downloads_left_.find(root);
+    if (left == root_downloads_left_.end()) {
+      continue;
+    }
+
+    if (!successful) {
+      root_downloads_left_.erase(left);
+    } else if (--left->second == 0) {
+      completed_roots.push_back(root);
+      root_downloads_left_.erase(left);
+    }
+  }
+}
+
+void PrefetchTilesPipeline::ReportCompletedRoots(
+    const std::vector<geo::TileKey>& roots) const {
+  for (const auto& root : roots) {
+    settings_.on_root_completed(root);
+  }
+}
+
+std::vector<client::TaskContext> PrefetchTilesPipeline::TakeDownloads() {
+  std::vector<client::TaskContext> tasks;
+  if (cancelled_) {
+    return tasks;
+  }
+
+  auto self = shared_from_this();
+  const auto limit = ApplyMemoryPressure(
+      adaptive_limit_ ? adaptive_limit_->GetLimit()
+                      : settings_.max_in_flight_downloads);
+
+  while (!pending_.empty() && (limit == 0 || in_flight_ < limit)) {
+    const auto& top = pending_.top();
+    const auto tile = top.tile;
+    const auto data_handle = top.data_handle;
+    pending_.pop();
+
+    // The completion runs after the download on the same thread.
+    auto started =
+        std::make_shared<AdaptiveConcurrencyLimit::Clock::time_point>();
+
+    tasks.emplace_back(client::TaskContext::Create(
+        [=](client::CancellationContext context) {
+          *started = AdaptiveConcurrencyLimit::Clock::now();
+          return self->download_job_->Download(data_handle, context);
+        },
+        [=](ExtendedDataResponse response) {
+          self->CompleteDownload(tile, *started, std::move(response));
+        }));
+    tokens_.emplace_back(tasks.back().CancelToken());
+    ++in_flight_;
+  }
+
+  return tasks;
+}
+
+size_t PrefetchTilesPipeline::ApplyMemoryPressure(size_t limit) const {
+  if (!settings_.memory_budget) {
+    return limit;
+  }
+
+  switch (settings_.memory_budget->GetPressure()) {
+    case client::MemoryPressure::kModerate:
+      return std::max<size_t>(
+          (limit == 0 ? kMaxAdaptiveDownloads : limit) / 2u, 1u);
+    case client::MemoryPressure::kCritical:
+      return 1u;
+    default:
+      return limit;
+  }
+}
+
+size_t PrefetchTilesPipeline::DropDownloads() {
+  const auto dropped = pending_.size();
+  pending_ = PendingQueue();
+  return dropped;
+}
+
+void PrefetchTilesPipeline::ScheduleDownloads(
+    std::vector<client::TaskContext> tasks) {
+  if (tasks.empty()) {
+    return;
+  }
+
+  if (task_sink_.AddTasks(tasks, priority_)) {
+    return;
+  }
+
+  // The sink is closed, so the tasks never run: cancel the prefetch and run
+  // them here to report the tiles as cancelled.
+  Cancel();
+
+  for (const auto& task : tasks) {
+    task.Execute();
+  }
+}
+
+double PrefetchTilesPipeline::SquaredDistance(const geo::TileKey& tile) const {
+  if (!settings_.focus_point) {
+    return 0.0;
+  }
+
+  // The identity projection keeps the longitude and latitude in radians.
+  static const geo::HalfQuadTreeIdentityTilingScheme kTilingScheme;
+  const auto box = geo::CalculateTileBox(kTilingScheme, tile);
+  const auto longitude = (box.Minimum().x + box.Maximum().x) / 2.0;
+  const auto latitude = (box.Minimum().y + box.Maximum().y) / 2.0;
+
+  const auto& focus = *settings_.focus_point;
+  auto delta_longitude = longitude - focus.GetLongitude();
+  if (delta_longitude > math::pi) {
+    delta_longitude -= math::two_pi;
+  } else if (delta_longitude < -math::pi) {
+    delta_longitude += math::two_pi;
+  }
+
+  const auto delta_latitude = latitude - focus.GetLatitude();
+  delta_longitude *= std::cos((latitude + focus.GetLatitude()) / 2.0);
+
+  return delta_longitude * delta_longitude + delta_latitude * delta_latitude;
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
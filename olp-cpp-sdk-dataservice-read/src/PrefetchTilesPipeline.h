@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/MemoryBudget.h>
+#include <olp/core/client/TaskContext.h>
+#include <olp/core/geo/coordinates/GeoCoordinates.h>
+#include <olp/core/geo/tiling/TileKey.h>
+#include <olp/dataservice/read/Types.h>
+#include "AdaptiveConcurrencyLimit.h"
+#include "DownloadItemsJob.h"
+#include "QueryMetadataJob.h"
+#include "TaskSink.h"
+#include "repositories/PrefetchTilesRepository.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief Downloads the tiles of a quad tree as soon as it is resolved.
+ *
+ * The tiles wait in a queue ordered by the distance to the focus point, and at
+ * most `max_in_flight_downloads` of them are downloaded at the same time, so
+ * the tiles closest to the focus point are downloaded first even when their
+ * quad tree is resolved last.
+ *
+ * With `adaptive_downloads`, the limit starts low and follows the network:
+ * it grows while the throughput does, and shrinks when the latency grows or
+ * the server is overloaded.
+ *
+ * When `on_root_completed` is set, it is called for each root whose tiles are
+ * all downloaded successfully.
+ */
+class PrefetchTilesPipeline
+    : public std::enable_shared_from_this<PrefetchTilesPipeline> {
+ public:
+  using DownloadJob =
+      DownloadItemsJob<geo::TileKey, PrefetchTilesResult, PrefetchStatus>;
+  using QueryFunc =
+      QueryItemsFunc<geo::TileKey, geo::TileKey, repository::SubQuadsResponse>;
+  using FilterFunc = FilterItemsFunc<repository::SubQuadsResult>;
+
+  struct Settings {
+    /// The point that the closest tiles to are downloaded first.
+    boost::optional<geo::GeoCoordinates> focus_point;
+    /// The maximum number of the downloads in flight, or 0 for no limit.
+    size_t max_in_flight_downloads{0};
+    /// Adapts the number of the downloads in flight to the network, up to
+    /// `max_in_flight_downloads`, or `kMaxAdaptiveDownloads` when it is 0.
+    bool adaptive_downloads{false};
+    /// Filters the tiles of all the quad trees at once, when the filter needs
+    /// all of them, and starts the downloads after the last query.
+    bool filter_after_all_queries{false};
+    /// Called when all the tiles of the root are downloaded successfully.
+    std::function<void(const geo::TileKey&)> on_root_completed;
+    /// Lowers the number of the downloads in flight under memory pressure.
+    std::shared_ptr<client::MemoryBudget> memory_budget;
+  };
+
+  /// The highest adaptive limit when the maximum is not set.
+  static constexpr size_t kMaxAdaptiveDownloads = 32u;
+
+  PrefetchTilesPipeline(std::shared_ptr<DownloadJob> download_job,
+                        QueryFunc query, FilterFunc filter, Settings settings,
+                        TaskSink& task_sink, uint32_t priority);
+
+  /// Queries the quad trees of the roots and downloads their tiles.
+  void Start(const std::vector<geo::TileKey>& roots,
+             client::CancellationContext execution_context);
+
+ private:
+  struct PendingDownload {
+    double distance;
+    size_t sequence;
+    geo::TileKey tile;
+    std::string data_handle;
+  };
+
+  /// Puts the closest tile on top, and the earliest found one between equally
+  /// distant tiles.
+  struct FartherThan {
+    bool operator()(const PendingDownload& lhs,
+                    const PendingDownload& rhs) const {
+      return lhs.distance > rhs.distance ||
+             (lhs.distance == rhs.distance && lhs.sequence > rhs.sequence);
+    }
+  };
+
+  using PendingQueue = std::priority_queue<PendingDownload,
+                                           std::vector<PendingDownload>,
+                                           FartherThan>;
+
+  void CompleteQuery(const geo::TileKey& root,
+                     repository::SubQuadsResponse response);
+
+  void CompleteDownload(const geo::TileKey& tile,
+                        AdaptiveConcurrencyLimit::Clock::time_point started,
+                        ExtendedDataResponse response);
+
+  /// Updates the adaptive limit with a completed download. Requires the lock.
+  void UpdateLimit(AdaptiveConcurrencyLimit::Clock::time_point started,
+                   const ExtendedDataResponse& response);
+
+  void Cancel();
+
+  /// Queues the new tiles and adds them to the download job. Requires the
+  /// lock.
+  void QueueDownloads(repository::SubQuadsResult tiles,
+                      const client::NetworkStatistics& statistics);
+
+  /// Makes the root wait for its tiles that are not downloaded yet, and adds
+  /// it to the completed roots when there are none. Requires the lock.
+  void TrackRoot(const geo::TileKey& root,
+                 const std::vector<geo::TileKey>& tiles,
+                 std::vector<geo::TileKey>& completed_roots);
+
+  /// Adds the roots that waited only for the tile to the completed roots.
+  /// Requires the lock.
+  void TrackDownload(const geo::TileKey& tile, bool successful,
+                     std::vector<geo::TileKey>& completed_roots);
+
+  void ReportCompletedRoots(const std::vector<geo::TileKey>& roots) const;
+
+  /// Creates the download tasks that fit the limit. Requires the lock.
+  std::vector<client::TaskContext> TakeDownloads();
+
+  /// Lowers the limit of the downloads in flight under memory pressure.
+  size_t ApplyMemoryPressure(size_t limit) const;
+
+  /// Drops the queued tiles and returns their number. Requires the lock.
+  size_t DropDownloads();
+
+  void ScheduleDownloads(std::vector<client::TaskContext> tasks);
+
+  double SquaredDistance(const geo::TileKey& tile) const;
+
+  std::shared_ptr<DownloadJob> download_job_;
+  QueryFunc query_;
+  FilterFunc filter_;
+  const Settings settings_;
+  TaskSink& task_sink_;
+  const uint32_t priority_;
+
+  std::mutex mutex_;
+  std::unique_ptr<AdaptiveConcurrencyLimit> adaptive_limit_;
+  size_t queries_left_{0};
+  size_t in_flight_{0};
+  size_t sequence_{0};
+  bool cancelled_{false};
+  boost::optional<client::ApiError> error_;
+  repository::SubQuadsResult query_result_;
+  client::NetworkStatistics query_statistics_;
+  std::unordered_set<geo::TileKey> queued_tiles_;
+  /// The roots waiting for each tile that is not downloaded yet.
+  std::unordered_map<geo::TileKey, std::vector<geo::TileKey>> tile_roots_;
+  /// The number of the tiles each root waits for.
+  std::unordered_map<geo::TileKey, size_t> root_downloads_left_;
+  std::unordered_set<geo::TileKey> failed_tiles_;
+  /// The tiles of the roots resolved before the filter.
+  std::vector<std::pair<geo::TileKey, std::vector<geo::TileKey>>>
+      resolved_roots_;
+  PendingQueue pending_;
+  VectorOfTokens tokens_;
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -20,9 +20,15 @@
 #include "ProtectDependencyResolver.h"
 
 #include <algorithm>
+#include <iterator>
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include "DependencyResolverHelpers.h"
+#include "PrefetchTilesArea.h"
+#include "repositories/PrefetchTilesRepository.h"
 
 namespace {
 constexpr auto kQuadTreeDepth = 4u;
@@ -37,64 +43,130 @@ ProtectDependencyResolver::ProtectDependencyResolver(
     const client::OlpClientSettings& settings)
     : layer_id_(layer_id),
       version_(version),
+      task_scheduler_(settings.task_scheduler),
       data_cache_repository_(catalog, settings.cache),
       partitions_cache_repository_(catalog, layer_id_, settings.cache),
-      quad_trees_(),
       keys_to_protect_() {}
 
 const cache::KeyValueCache::KeyListType&
 ProtectDependencyResolver::GetKeysToProtect(const TileKeys& tiles) {
   keys_to_protect_.clear();
+
+  const auto groups = GroupTilesByQuadTree(tiles, kQuadTreeDepth);
+  std::vector<GroupState> states(groups.size());
+  ParallelFor(groups.size(), task_scheduler_, [&](size_t index) {
+    ProcessGroup(groups[index], states[index]);
+  });
+
+  for (auto& state : states) {
+    std::move(state.keys_to_protect.begin(), state.keys_to_protect.end(),
+              std::back_inserter(keys_to_protect_));
+  }
+  return keys_to_protect_;
+}
+
+const cache::KeyValueCache::KeyListType&
+ProtectDependencyResolver::GetKeysToProtect(const geo::GeoRectangle& area,
+                                            std::uint32_t min_level,
+                                            std::uint32_t max_level) {
+  keys_to_protect_.clear();
+
+  const auto request = PrefetchTilesRequest()
+                           .WithGeoRectangle(area)
+                           .WithMinLevel(min_level)
+                           .WithMaxLevel(max_level);
+  const auto roots = repository::PrefetchTilesRepository::GetSlicedTiles(
+      request, min_level, max_level);
+  const std::vector<repository::RootTilesForRequest::value_type> root_list(
+      roots.begin(), roots.end());
+  const PrefetchTilesArea tiles_area(request);
+
+  std::vector<cache::KeyValueCache::KeyListType> keys(root_list.size());
+  ParallelFor(root_list.size(), task_scheduler_, [&](size_t index) {
+    const auto& root = root_list[index];
+    read::QuadTreeIndex cached_tree;
+    if (!partitions_cache_repository_.Get(root.first, root.second, version_,
+                                          cached_tree)) {
+      return;
+    }
+
+    auto& root_keys = keys[index];
+    for (const auto& data : cached_tree.GetIndexData()) {
+      const auto level = data.tile_key.Level();
+      if (level >= min_level && level <= max_level &&
+          tiles_area.Intersects(data.tile_key)) {
+        root_keys.emplace_back(
+            data_cache_repository_.CreateKey(layer_id_, data.data_handle));
+      }
+    }
+
+    if (!root_keys.empty()) {
+      root_keys.emplace_back(partitions_cache_repository_.CreateQuadKey(
+          root.first, root.second, version_));
+    }
+  });
+
+  for (auto& root_keys : keys) {
+    std::move(root_keys.begin(), root_keys.end(),
+              std::back_inserter(keys_to_protect_));
+  }
+  return keys_to_protect_;
+}
+
+void ProtectDependencyResolver::ProcessGroup(const TileKeys& tiles,
+                                             GroupState& state) {
   for (const auto& tile : tiles) {
-    auto it = FindQuad(tile);
-    if (it != quad_trees_.end()) {
+    auto it = FindQuad(tile, state);
+    if (it != state.quad_trees.end()) {
       // Quad tree for tile found. Get data handle for tile and add to list for
       // protection
-      AddDataHandle(tile, it->second);
+      AddDataHandle(tile, it->second, state);
     } else {
       // find tile in cache
-      ProcessTileKeyInCache(tile);
+      ProcessTileKeyInCache(tile, state);
     }
   }
-  return keys_to_protect_;
 }
 
 ProtectDependencyResolver::QuadsType::iterator
-ProtectDependencyResolver::FindQuad(const geo::TileKey& tile_key) {
+ProtectDependencyResolver::FindQuad(const geo::TileKey& tile_key,
+                                    GroupState& state) {
   auto max_depth = std::min<std::uint32_t>(tile_key.Level(), kQuadTreeDepth);
   for (auto i = 0u; i <= max_depth; ++i) {
     const auto& quad_root = tile_key.ChangedLevelBy(-i);
-    auto it = quad_trees_.find(quad_root);
-    if (it != quad_trees_.end()) {
+    auto it = state.quad_trees.find(quad_root);
+    if (it != state.quad_trees.end()) {
       return it;
     }
   }
-  return quad_trees_.end();
+  return state.quad_trees.end();
 }
 
 bool ProtectDependencyResolver::AddDataHandle(
-    const geo::TileKey& tile, const read::QuadTreeIndex& quad_tree) {
+    const geo::TileKey& tile, const read::QuadTreeIndex& quad_tree,
+    GroupState& state) {
   auto data = quad_tree.Find(tile, false);
   if (data) {
-    keys_to_protect_.emplace_back(
+    state.keys_to_protect.emplace_back(
         data_cache_repository_.CreateKey(layer_id_, data->data_handle));
     return true;
   }
   return false;
 }
 
-bool ProtectDependencyResolver::ProcessTileKeyInCache(
-    const geo::TileKey& tile) {
+bool ProtectDependencyResolver::ProcessTileKeyInCache(const geo::TileKey& tile,
+                                                      GroupState& state) {
   read::QuadTreeIndex cached_tree;
   if (partitions_cache_repository_.FindQuadTree(tile, version_, cached_tree) &&
-      AddDataHandle(tile, cached_tree)) {
+      AddDataHandle(tile, cached_tree, state)) {
     auto root_tile = cached_tree.GetRootTile();
     // add quad tree to list for protection
-    keys_to_protect_.emplace_back(partitions_cache_repository_.CreateQuadKey(
-        root_tile, kQuadTreeDepth, version_));
+    state.keys_to_protect.emplace_back(
+        partitions_cache_repository_.CreateQuadKey(root_tile, kQuadTreeDepth,
+                                                   version_));
     // save quad tree, because  there is could be more tiles to protect from
     // this quad
-    quad_trees_[root_tile] = std::move(cached_tree);
+    state.quad_trees[root_tile] = std::move(cached_tree);
     return true;
   }
   return false;
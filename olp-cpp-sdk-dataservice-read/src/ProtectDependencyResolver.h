@@ -19,13 +19,15 @@
 
 #pragma once
 
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/geo/Types.h>
+#include <olp/core/geo/coordinates/GeoRectangle.h>
 #include <olp/core/geo/tiling/TileKey.h>
+#include <olp/core/thread/TaskScheduler.h>
 #include "repositories/DataCacheRepository.h"
 #include "repositories/DataRepository.h"
 #include "repositories/PartitionsCacheRepository.h"
@@ -37,7 +39,8 @@ namespace read {
 
 /// Find quad trees for protected tiles. Add quad tree to list for protection.
 /// Save downloaded quads for future searches for tiles to protect, if quad tree
-/// not found look it to the cache.
+/// not found look it to the cache. The tiles that cannot share a quad tree are
+/// resolved in parallel on the task scheduler.
 class ProtectDependencyResolver {
  public:
   ProtectDependencyResolver(const client::HRN& catalog,
@@ -47,22 +50,41 @@ class ProtectDependencyResolver {
   const cache::KeyValueCache::KeyListType& GetKeysToProtect(
       const TileKeys& tiles);
 
+  /// Gets the keys of the quad trees cached for the area and the data of
+  /// their tiles that intersect the area on the levels from `min_level` to
+  /// `max_level`. The quad tree roots are the same as for the prefetch of the
+  /// area, so the tiles of the area are not enumerated.
+  const cache::KeyValueCache::KeyListType& GetKeysToProtect(
+      const geo::GeoRectangle& area, std::uint32_t min_level,
+      std::uint32_t max_level);
+
  private:
-  using QuadsType = std::map<geo::TileKey, read::QuadTreeIndex>;
+  using QuadsType = std::unordered_map<geo::TileKey, read::QuadTreeIndex>;
+
+  /// The quad trees loaded for a group of tiles and the keys found for it.
+  struct GroupState {
+    QuadsType quad_trees;
+    cache::KeyValueCache::KeyListType keys_to_protect;
+  };
+
+  void ProcessGroup(const TileKeys& tiles, GroupState& state);
 
-  QuadsType::iterator FindQuad(const geo::TileKey& tile_key);
+  QuadsType::iterator FindQuad(const geo::TileKey& tile_key,
+                               GroupState& state);
 
   bool AddDataHandle(const geo::TileKey& tile,
-                     const read::QuadTreeIndex& quad_tree);
+                     const read::QuadTreeIndex& quad_tree,
+                     GroupState& state);
 
-  bool ProcessTileKeyInCache(const geo::TileKey& tile);
+  bool ProcessTileKeyInCache(const geo::TileKey& tile,
+                             GroupState& state);
 
  private:
   const std::string& layer_id_;
   const int64_t version_;
+  std::shared_ptr<thread::TaskScheduler> task_scheduler_;
   repository::DataCacheRepository data_cache_repository_;
   repository::PartitionsCacheRepository partitions_cache_repository_;
-  std::map<geo::TileKey, read::QuadTreeIndex> quad_trees_;
   cache::KeyValueCache::KeyListType keys_to_protect_;
 };
 
@@ -143,31 +143,30 @@ class QueryMetadataJob {
       execution_context_.ExecuteOrCancelled(
           [&]() {
             VectorOfTokens tokens;
-            std::transform(
-                std::begin(query_result_), std::end(query_result_),
-                std::back_inserter(tokens),
-                [&](const typename QueryResponseType::ResultType::value_type&
-                        item) {
-                  const std::string& data_handle = item.second;
-                  const auto& item_key = item.first;
-
-                  auto result = task_sink_.AddTaskChecked(
-                      [=](client::CancellationContext context) {
-                        return download_job->Download(data_handle, context);
-                      },
-                      [=](ExtendedDataResponse response) {
-                        download_job->CompleteItem(item_key,
-                                                   std::move(response));
-                      },
-                      priority_);
-
-                  if (result) {
-                    return *result;
-                  }
-
-                  all_download_tasks_triggered = false;
-                  return client::CancellationToken();
-                });
+            tokens.reserve(query_result_.size());
+            std::vector<client::TaskContext> tasks;
+            tasks.reserve(query_result_.size());
+
+            for (const auto& item : query_result_) {
+              const std::string& data_handle = item.second;
+              const auto& item_key = item.first;
+
+              tasks.emplace_back(client::TaskContext::Create(
+                  [=](client::CancellationContext context) {
+                    return download_job->Download(data_handle, context);
+                  },
+                  [=](ExtendedDataResponse response) {
+                    download_job->CompleteItem(item_key, std::move(response));
+                  }));
+              tokens.emplace_back(tasks.back().CancelToken());
+            }
+
+            // The downloads are scheduled at once instead of one by one.
+            if (!task_sink_.AddTasks(std::move(tasks), priority_)) {
+              all_download_tasks_triggered = false;
+              return client::CancellationToken();
+            }
+
             return CreateToken(std::move(tokens));
           },
           [&]() {
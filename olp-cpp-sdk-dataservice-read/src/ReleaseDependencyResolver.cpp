@@ -20,9 +20,15 @@
 #include "ReleaseDependencyResolver.h"
 
 #include <algorithm>
+#include <iterator>
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include "DependencyResolverHelpers.h"
+#include "PrefetchTilesArea.h"
+#include "repositories/PrefetchTilesRepository.h"
 
 namespace {
 constexpr auto kQuadTreeDepth = 4u;
@@ -38,26 +44,97 @@ ReleaseDependencyResolver::ReleaseDependencyResolver(
     : layer_id_(layer_id),
       version_(version),
       cache_(settings.cache),
+      task_scheduler_(settings.task_scheduler),
       data_cache_repository_(catalog, settings.cache),
       partitions_cache_repository_(catalog, layer_id_, settings.cache),
-      quad_trees_with_protected_tiles_(),
       keys_to_release_() {}
 
 const cache::KeyValueCache::KeyListType&
 ReleaseDependencyResolver::GetKeysToRelease(const TileKeys& tiles) {
   keys_to_release_.clear();
-  for (const auto& tile : tiles) {
-    ProcessTileKey(tile);
+
+  const auto groups = GroupTilesByQuadTree(tiles, kQuadTreeDepth);
+  std::vector<GroupState> states(groups.size());
+  ParallelFor(groups.size(), task_scheduler_, [&](size_t index) {
+    for (const auto& tile : groups[index]) {
+      ProcessTileKey(tile, states[index]);
+    }
+  });
+
+  for (auto& state : states) {
+    std::move(state.keys_to_release.begin(), state.keys_to_release.end(),
+              std::back_inserter(keys_to_release_));
+  }
+  return keys_to_release_;
+}
+
+const cache::KeyValueCache::KeyListType&
+ReleaseDependencyResolver::GetKeysToRelease(const geo::GeoRectangle& area,
+                                            std::uint32_t min_level,
+                                            std::uint32_t max_level) {
+  keys_to_release_.clear();
+
+  const auto request = PrefetchTilesRequest()
+                           .WithGeoRectangle(area)
+                           .WithMinLevel(min_level)
+                           .WithMaxLevel(max_level);
+  const auto roots = repository::PrefetchTilesRepository::GetSlicedTiles(
+      request, min_level, max_level);
+  const std::vector<repository::RootTilesForRequest::value_type> root_list(
+      roots.begin(), roots.end());
+  const PrefetchTilesArea tiles_area(request);
+
+  std::vector<cache::KeyValueCache::KeyListType> keys(root_list.size());
+  ParallelFor(root_list.size(), task_scheduler_, [&](size_t index) {
+    const auto& root = root_list[index];
+    read::QuadTreeIndex cached_tree;
+    if (!partitions_cache_repository_.Get(root.first, root.second, version_,
+                                          cached_tree)) {
+      return;
+    }
+
+    auto& root_keys = keys[index];
+    bool other_tiles_protected = false;
+    for (const auto& data : cached_tree.GetIndexData()) {
+      auto tile_data_key =
+          data_cache_repository_.CreateKey(layer_id_, data.data_handle);
+      if (!cache_->IsProtected(tile_data_key)) {
+        continue;
+      }
+
+      const auto level = data.tile_key.Level();
+      if (level >= min_level && level <= max_level &&
+          tiles_area.Intersects(data.tile_key)) {
+        root_keys.emplace_back(std::move(tile_data_key));
+      } else {
+        other_tiles_protected = true;
+      }
+    }
+
+    // the quad tree stays protected while it has other protected tiles
+    auto quad_key = partitions_cache_repository_.CreateQuadKey(
+        root.first, root.second, version_);
+    if (!other_tiles_protected && cache_->IsProtected(quad_key)) {
+      root_keys.emplace_back(std::move(quad_key));
+    }
+  });
+
+  for (auto& root_keys : keys) {
+    std::move(root_keys.begin(), root_keys.end(),
+              std::back_inserter(keys_to_release_));
   }
   return keys_to_release_;
 }
 
-void ReleaseDependencyResolver::ProcessTileKey(const geo::TileKey& tile_key) {
+void ReleaseDependencyResolver::ProcessTileKey(const geo::TileKey& tile_key,
+                                               GroupState& state) {
   bool add_key = true;
+  auto& quad_trees = state.quad_trees_with_protected_tiles;
+  auto& keys_to_release = state.keys_to_release;
   auto process_tile = [&](const geo::TileKey& quad_root,
                           const geo::TileKey& tile) {
-    auto it = quad_trees_with_protected_tiles_.find(quad_root);
-    if (it != quad_trees_with_protected_tiles_.end()) {
+    auto it = quad_trees.find(quad_root);
+    if (it != quad_trees.end()) {
       // Quad tree for tile found. Get data handle for tile and add to list
       // to release
       auto tile_it = it->second.find(tile);
@@ -67,7 +144,7 @@ void ReleaseDependencyResolver::ProcessTileKey(const geo::TileKey& tile_key) {
         return true;
       }
       if (add_key) {
-        keys_to_release_.emplace_back(tile_it->second);
+        keys_to_release.emplace_back(tile_it->second);
         add_key = false;
       }
       // key added, we can remove this tile from map
@@ -75,9 +152,8 @@ void ReleaseDependencyResolver::ProcessTileKey(const geo::TileKey& tile_key) {
       if (it->second.empty()) {
         // no more protected tiles associated with this quad tree
         // can add key for quad tree to be released and remove from map
-        keys_to_release_.emplace_back(
-            partitions_cache_repository_.CreateQuadKey(
-                it->first, kQuadTreeDepth, version_));
+        keys_to_release.emplace_back(partitions_cache_repository_.CreateQuadKey(
+            it->first, kQuadTreeDepth, version_));
       }
       return true;
     }
@@ -90,7 +166,7 @@ void ReleaseDependencyResolver::ProcessTileKey(const geo::TileKey& tile_key) {
     // we found quad that can contain our tile
     if (!process_tile(quad_root, tile_key)) {
       // load quad_root from cache
-      ProcessQuadTreeCache(quad_root, tile_key, add_key);
+      ProcessQuadTreeCache(quad_root, tile_key, add_key, state);
     }
   }
 }
@@ -98,7 +174,7 @@ void ReleaseDependencyResolver::ProcessTileKey(const geo::TileKey& tile_key) {
 ReleaseDependencyResolver::TilesDataKeysType
 ReleaseDependencyResolver::CheckProtectedTilesInQuad(
     const read::QuadTreeIndex& cached_tree, const geo::TileKey& tile,
-    bool& add_data_handle_key) {
+    bool& add_data_handle_key, GroupState& state) {
   // check if quad tree has other protected keys, if not, add quad key to
   // release from protected list, othervise add all protected keys left
   // for this quad to map
@@ -111,7 +187,7 @@ ReleaseDependencyResolver::CheckProtectedTilesInQuad(
       if (ind.tile_key == tile) {
         // add key to release list
         if (add_data_handle_key) {
-          keys_to_release_.emplace_back(tile_data_key);
+          state.keys_to_release.emplace_back(tile_data_key);
           add_data_handle_key = false;
         }
       } else {
@@ -126,24 +202,26 @@ ReleaseDependencyResolver::CheckProtectedTilesInQuad(
 
 void ReleaseDependencyResolver::ProcessQuadTreeCache(
     const geo::TileKey& root_quad_key, const geo::TileKey& tile,
-    bool& add_data_handle_key) {
+    bool& add_data_handle_key, GroupState& state) {
   QuadTreeIndex cached_tree;
   if (partitions_cache_repository_.Get(root_quad_key, kQuadTreeDepth, version_,
                                        cached_tree)) {
-    TilesDataKeysType protected_keys =
-        CheckProtectedTilesInQuad(cached_tree, tile, add_data_handle_key);
+    TilesDataKeysType protected_keys = CheckProtectedTilesInQuad(
+        cached_tree, tile, add_data_handle_key, state);
     if (protected_keys.empty()) {
       // no other tiles are protected, can add quad tree to release list
-      keys_to_release_.emplace_back(partitions_cache_repository_.CreateQuadKey(
-          root_quad_key, kQuadTreeDepth, version_));
+      state.keys_to_release.emplace_back(
+          partitions_cache_repository_.CreateQuadKey(root_quad_key,
+                                                     kQuadTreeDepth, version_));
     }
     // add quad key with other protected keys dependent on this quad to
     // reduce future calls to cache
-    quad_trees_with_protected_tiles_[root_quad_key] = std::move(protected_keys);
+    state.quad_trees_with_protected_tiles[root_quad_key] =
+        std::move(protected_keys);
   } else {
     // add empty TilesDataKeysType to know that we already loaded this root from
     // cache
-    quad_trees_with_protected_tiles_[root_quad_key] = TilesDataKeysType();
+    state.quad_trees_with_protected_tiles[root_quad_key] = TilesDataKeysType();
   }
 }
 
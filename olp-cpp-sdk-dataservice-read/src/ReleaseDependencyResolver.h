@@ -25,7 +25,9 @@
 
 #include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/geo/Types.h>
+#include <olp/core/geo/coordinates/GeoRectangle.h>
 #include <olp/core/geo/tiling/TileKey.h>
+#include <olp/core/thread/TaskScheduler.h>
 #include "repositories/DataCacheRepository.h"
 #include "repositories/DataRepository.h"
 #include "repositories/PartitionsCacheRepository.h"
@@ -37,7 +39,8 @@ namespace read {
 
 /// group quad trees and protected tiles. Check if for each quad tree we want
 /// to release all protected keys associated, if true add this quad tree to
-/// released keys
+/// released keys. The tiles that cannot share a quad tree are resolved in
+/// parallel on the task scheduler.
 class ReleaseDependencyResolver {
  public:
   ReleaseDependencyResolver(const client::HRN& catalog,
@@ -47,26 +50,40 @@ class ReleaseDependencyResolver {
   const cache::KeyValueCache::KeyListType& GetKeysToRelease(
       const TileKeys& tiles);
 
+  /// Gets the protected keys of the data of the tiles that intersect the area
+  /// on the levels from `min_level` to `max_level`, and the keys of the quad
+  /// trees that have no other protected tiles left.
+  const cache::KeyValueCache::KeyListType& GetKeysToRelease(
+      const geo::GeoRectangle& area, std::uint32_t min_level,
+      std::uint32_t max_level);
+
  private:
   using TilesDataKeysType = std::map<geo::TileKey, std::string>;
   using QuadsType = std::map<geo::TileKey, TilesDataKeysType>;
 
-  void ProcessTileKey(const geo::TileKey& tile_key);
+  /// The quad trees loaded for a group of tiles and the keys found for it.
+  struct GroupState {
+    QuadsType quad_trees_with_protected_tiles;
+    cache::KeyValueCache::KeyListType keys_to_release;
+  };
+
+  void ProcessTileKey(const geo::TileKey& tile_key, GroupState& state);
 
-  TilesDataKeysType CheckProtectedTilesInQuad(const read::QuadTreeIndex& cached_tree,
-                                const geo::TileKey& tile,
-                                bool& add_data_handle_key);
+  TilesDataKeysType CheckProtectedTilesInQuad(
+      const read::QuadTreeIndex& cached_tree, const geo::TileKey& tile,
+      bool& add_data_handle_key, GroupState& state);
 
-  void ProcessQuadTreeCache(const geo::TileKey& root_quad_key, const geo::TileKey& tile,
-                            bool& add_data_handle_key);
+  void ProcessQuadTreeCache(const geo::TileKey& root_quad_key,
+                            const geo::TileKey& tile,
+                            bool& add_data_handle_key, GroupState& state);
 
  private:
   const std::string& layer_id_;
   const int64_t version_;
   std::shared_ptr<cache::KeyValueCache> cache_;
+  std::shared_ptr<thread::TaskScheduler> task_scheduler_;
   repository::DataCacheRepository data_cache_repository_;
   repository::PartitionsCacheRepository partitions_cache_repository_;
-  QuadsType quad_trees_with_protected_tiles_;
   cache::KeyValueCache::KeyListType keys_to_release_;
 };
 
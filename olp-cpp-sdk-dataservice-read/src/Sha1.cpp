@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "Sha1.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+
+#if defined(OLP_SDK_CRYPTO_COMMONCRYPTO)
+#include <CommonCrypto/CommonDigest.h>
+#elif defined(OLP_SDK_CRYPTO_OPENSSL)
+#include <openssl/sha.h>
+#endif
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+
+#if !defined(OLP_SDK_CRYPTO_COMMONCRYPTO) && !defined(OLP_SDK_CRYPTO_OPENSSL)
+
+// SHA-1 Algorithm from
+// https://csrc.nist.gov/csrc/media/publications/fips/180/4/final/documents/fips180-4-draft-aug2014.pdf
+
+constexpr size_t kChunkLength = 64u;
+constexpr size_t kLengthFieldSize = 8u;
+
+inline uint32_t RotateLeft(uint32_t x, int n) {
+  return (x << n) | (x >> (32 - n));
+}
+
+uint32_t ReadBigEndian(const unsigned char* data) {
+  return (static_cast<uint32_t>(data[0]) << 24) |
+         (static_cast<uint32_t>(data[1]) << 16) |
+         (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+class Sha1 {
+ public:
+  void Update(const unsigned char* data, size_t length) {
+    total_length_ += length;
+
+    if (buffered_ > 0u) {
+      const auto count = std::min(length, kChunkLength - buffered_);
+      std::memcpy(buffer_.data() + buffered_, data, count);
+      buffered_ += count;
+      data += count;
+      length -= count;
+      if (buffered_ < kChunkLength) {
+        return;
+      }
+      Transform(buffer_.data());
+      buffered_ = 0u;
+    }
+
+    for (; length >= kChunkLength; length -= kChunkLength) {
+      Transform(data);
+      data += kChunkLength;
+    }
+
+    if (length > 0u) {
+      std::memcpy(buffer_.data(), data, length);
+      buffered_ = length;
+    }
+  }
+
+  Sha1Digest Final() {
+    const uint64_t bit_length = total_length_ * 8u;
+
+    buffer_[buffered_++] = 0x80;
+    if (buffered_ > kChunkLength - kLengthFieldSize) {
+      std::fill(buffer_.begin() + buffered_, buffer_.end(), 0);
+      Transform(buffer_.data());
+      buffered_ = 0u;
+    }
+    std::fill(buffer_.begin() + buffered_, buffer_.end() - kLengthFieldSize,
+              0);
+    for (size_t i = 0; i < kLengthFieldSize; i++) {
+      buffer_[kChunkLength - 1 - i] =
+          static_cast<unsigned char>(bit_length >> (i * 8));
+    }
+    Transform(buffer_.data());
+
+    Sha1Digest ret;
+    for (size_t i = 0, j = 0; i < hash_value_.size(); i++, j += 4) {
+      const uint32_t value = hash_value_[i];
+      ret[j + 0] = static_cast<unsigned char>(value >> 24);
+      ret[j + 1] = static_cast<unsigned char>(value >> 16);
+      ret[j + 2] = static_cast<unsigned char>(value >> 8);
+      ret[j + 3] = static_cast<unsigned char>(value);
+    }
+    return ret;
+  }
+
+ private:
+  void Transform(const unsigned char* chunk) {
+    // The message schedule is kept in a 16 words ring.
+    std::array<uint32_t, 16> w;
+    for (size_t i = 0; i < w.size(); i++) {
+      w[i] = ReadBigEndian(chunk + i * 4);
+    }
+
+    uint32_t a = hash_value_[0];
+    uint32_t b = hash_value_[1];
+    uint32_t c = hash_value_[2];
+    uint32_t d = hash_value_[3];
+    uint32_t e = hash_value_[4];
+
+    for (size_t i = 0; i < 80; i++) {
+      if (i >= 16) {
+        w[i & 15] = RotateLeft(w[(i + 13) & 15] ^ w[(i + 8) & 15] ^
+                                   w[(i + 2) & 15] ^ w[i & 15],
+                               1);
+      }
+
+      uint32_t f;
+      uint32_t k;
+      if (i < 20) {
+        f = (b & c) | (~b & d);
+        k = 0x5a827999;
+      } else if (i < 40) {
+        f = b ^ c ^ d;
+        k = 0x6ed9eba1;
+      } else if (i < 60) {
+        f = (b & c) | (b & d) | (c & d);
+        k = 0x8f1bbcdc;
+      } else {
+        f = b ^ c ^ d;
+        k = 0xca62c1d6;
+      }
+
+      const uint32_t t = RotateLeft(a, 5) + f + e + k + w[i & 15];
+      e = d;
+      d = c;
+      c = RotateLeft(b, 30);
+      b = a;
+      a = t;
+    }
+
+    hash_value_[0] += a;
+    hash_value_[1] += b;
+    hash_value_[2] += c;
+    hash_value_[3] += d;
+    hash_value_[4] += e;
+  }
+
+  std::array<uint32_t, 5> hash_value_{
+      {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0}};
+  std::array<unsigned char, kChunkLength> buffer_;
+  size_t buffered_{0u};
+  uint64_t total_length_{0u};
+};
+
+#endif
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+}  // namespace
+
+Sha1Digest ComputeSha1(const unsigned char* data, size_t length) {
+#if defined(OLP_SDK_CRYPTO_COMMONCRYPTO)
+  Sha1Digest ret;
+  CC_SHA1(data, static_cast<CC_LONG>(length), ret.data());
+  return ret;
+#elif defined(OLP_SDK_CRYPTO_OPENSSL)
+  Sha1Digest ret;
+  SHA1(data, length, ret.data());
+  return ret;
+#else
+  Sha1 sha;
+  sha.Update(data, length);
+  return sha.Final();
+#endif
+}
+
+bool IsSha1Checksum(const std::string& checksum) {
+  return checksum.size() == 2 * std::tuple_size<Sha1Digest>::value &&
+         std::all_of(checksum.begin(), checksum.end(),
+                     [](char c) { return HexValue(c) >= 0; });
+}
+
+bool MatchesSha1Checksum(const model::Data& data, const std::string& checksum) {
+  if (!data || !IsSha1Checksum(checksum)) {
+    return false;
+  }
+
+  const auto digest = ComputeSha1(data->data(), data->size());
+  for (size_t i = 0; i < digest.size(); i++) {
+    const auto value =
+        HexValue(checksum[2 * i]) * 16 + HexValue(checksum[2 * i + 1]);
+    if (value != digest[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include <olp/dataservice/read/Types.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/// The SHA-1 digest.
+using Sha1Digest = std::array<unsigned char, 20>;
+
+/// Computes SHA-1 of the data. Uses the platform crypto library when the SDK
+/// is built with `OLP_SDK_USE_PLATFORM_CRYPTO`.
+Sha1Digest ComputeSha1(const unsigned char* data, size_t length);
+
+/// Checks whether the checksum is a hex encoded SHA-1 digest. The checksum of
+/// a partition is set by the publisher and may use another algorithm.
+bool IsSha1Checksum(const std::string& checksum);
+
+/// Checks whether the SHA-1 of the data matches the hex encoded checksum.
+bool MatchesSha1Checksum(const model::Data& data, const std::string& checksum);
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/dataservice/read/StreamConsumerGroup.h"
+
+#include <olp/core/porting/make_unique.h>
+#include "StreamConsumerGroupImpl.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+StreamConsumerGroup::StreamConsumerGroup(client::HRN catalog,
+                                         std::string layer_id,
+                                         client::OlpClientSettings settings,
+                                         size_t consumers_count)
+    : impl_(std::make_unique<StreamConsumerGroupImpl>(
+          std::move(catalog), std::move(layer_id), std::move(settings),
+          consumers_count)) {}
+
+StreamConsumerGroup::~StreamConsumerGroup() = default;
+
+size_t StreamConsumerGroup::GetConsumersCount() const {
+  return impl_->GetConsumersCount();
+}
+
+client::CancellationToken StreamConsumerGroup::Subscribe(
+    SubscribeRequest request, ConsumerGroupResponseCallback callback) {
+  return impl_->Subscribe(std::move(request), std::move(callback));
+}
+
+client::CancellationToken StreamConsumerGroup::StartPolling(
+    ContinuousPollSettings settings, ConsumerGroupMessagesHandler handler,
+    ContinuousPollResponseCallback callback) {
+  return impl_->StartPolling(std::move(settings), std::move(handler),
+                             std::move(callback));
+}
+
+client::CancellationToken StreamConsumerGroup::Unsubscribe(
+    ConsumerGroupResponseCallback callback) {
+  return impl_->Unsubscribe(std::move(callback));
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "StreamConsumerGroupImpl.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/porting/make_unique.h>
+#include <boost/optional.hpp>
+#include "StreamLayerClientImpl.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+constexpr auto kLogTag = "StreamConsumerGroupImpl";
+// One thread polls while the other one handles the previous batch.
+constexpr size_t kConsumerThreads = 2u;
+
+/// Joins the responses of the consumers and reports the first error once all
+/// consumers respond. When a consumer fails, the others are cancelled.
+class ConsumersJoin {
+ public:
+  ConsumersJoin(size_t count, Callback<client::ApiNoResult> callback)
+      : remaining_(count), callback_(std::move(callback)) {}
+
+  void AddToken(client::CancellationToken token) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!cancelled_) {
+        tokens_.push_back(std::move(token));
+        return;
+      }
+    }
+    token.Cancel();
+  }
+
+  void Cancel() {
+    std::vector<client::CancellationToken> tokens;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cancelled_ = true;
+      tokens.swap(tokens_);
+    }
+
+    for (auto& token : tokens) {
+      token.Cancel();
+    }
+  }
+
+  void Complete(boost::optional<client::ApiError> error) {
+    Callback<client::ApiNoResult> callback;
+    boost::optional<client::ApiError> first_error;
+    const bool failed = static_cast<bool>(error);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (error && !error_) {
+        error_ = std::move(error);
+      }
+
+      if (--remaining_ == 0u) {
+        callback = std::move(callback_);
+        first_error = error_;
+      }
+    }
+
+    if (failed) {
+      Cancel();
+    }
+
+    if (callback) {
+      if (first_error) {
+        callback(std::move(*first_error));
+      } else {
+        callback(client::ApiNoResult{});
+      }
+    }
+  }
+
+  client::CancellationToken GetToken(std::shared_ptr<ConsumersJoin> self) {
+    return client::CancellationToken([self]() { self->Cancel(); });
+  }
+
+ private:
+  std::mutex mutex_;
+  size_t remaining_;
+  Callback<client::ApiNoResult> callback_;
+  boost::optional<client::ApiError> error_;
+  std::vector<client::CancellationToken> tokens_;
+  bool cancelled_{false};
+};
+
+template <typename ResponseType>
+boost::optional<client::ApiError> GetError(const ResponseType& response) {
+  if (response.IsSuccessful()) {
+    return boost::none;
+  }
+  return response.GetError();
+}
+}  // namespace
+
+StreamConsumerGroupImpl::StreamConsumerGroupImpl(
+    client::HRN catalog, std::string layer_id,
+    client::OlpClientSettings settings, size_t consumers_count) {
+  consumers_count = std::max<size_t>(consumers_count, 1u);
+  consumers_.reserve(consumers_count);
+  for (size_t index = 0u; index < consumers_count; ++index) {
+    auto consumer_settings = settings;
+    consumer_settings.task_scheduler =
+        client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(
+            kConsumerThreads);
+    consumers_.push_back(std::make_unique<StreamLayerClientImpl>(
+        catalog, layer_id, std::move(consumer_settings)));
+  }
+}
+
+StreamConsumerGroupImpl::~StreamConsumerGroupImpl() = default;
+
+size_t StreamConsumerGroupImpl::GetConsumersCount() const {
+  return consumers_.size();
+}
+
+client::CancellationToken StreamConsumerGroupImpl::Subscribe(
+    SubscribeRequest request, ConsumerGroupResponseCallback callback) {
+  if (!request.GetConsumerId()) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Subscribe: consumer ID is missing");
+    callback(client::ApiError(client::ErrorCode::InvalidArgument,
+                              "Consumer ID is required for a consumer group",
+                              false));
+    return client::CancellationToken();
+  }
+
+  request.WithSubscriptionMode(SubscribeRequest::SubscriptionMode::kParallel);
+
+  auto join =
+      std::make_shared<ConsumersJoin>(consumers_.size(), std::move(callback));
+  for (auto& consumer : consumers_) {
+    join->AddToken(
+        consumer->Subscribe(request, [=](SubscribeResponse response) {
+          join->Complete(GetError(response));
+        }));
+  }
+
+  return join->GetToken(join);
+}
+
+client::CancellationToken StreamConsumerGroupImpl::StartPolling(
+    ContinuousPollSettings settings, ConsumerGroupMessagesHandler handler,
+    ContinuousPollResponseCallback callback) {
+  auto join =
+      std::make_shared<ConsumersJoin>(consumers_.size(), std::move(callback));
+  for (size_t index = 0u; index < consumers_.size(); ++index) {
+    auto consumer_handler = [=](MessagesResult messages,
+                                PollAcknowledgement acknowledgement) {
+      auto new_messages = FilterHandledMessages(std::move(messages));
+      if (new_messages.GetMessages().empty()) {
+        acknowledgement();
+        return;
+      }
+      handler(index, std::move(new_messages), std::move(acknowledgement));
+    };
+
+    // Any stop of a consumer stops the group, the cancellation as well.
+    join->AddToken(consumers_[index]->StartPolling(
+        settings, std::move(consumer_handler),
+        [=](ContinuousPollResponse response) {
+          join->Complete(GetError(response));
+        }));
+  }
+
+  return join->GetToken(join);
+}
+
+client::CancellationToken StreamConsumerGroupImpl::Unsubscribe(
+    ConsumerGroupResponseCallback callback) {
+  auto join =
+      std::make_shared<ConsumersJoin>(consumers_.size(), std::move(callback));
+  for (auto& consumer : consumers_) {
+    join->AddToken(consumer->Unsubscribe([=](UnsubscribeResponse response) {
+      join->Complete(GetError(response));
+    }));
+  }
+
+  return join->GetToken(join);
+}
+
+model::Messages StreamConsumerGroupImpl::FilterHandledMessages(
+    model::Messages messages) {
+  auto& messages_list = messages.GetMutableMessages();
+
+  std::lock_guard<std::mutex> lock(offsets_mutex_);
+  auto end = std::remove_if(
+      messages_list.begin(), messages_list.end(),
+      [&](const model::Message& message) {
+        const auto& offset = message.GetOffset();
+        auto result = handled_offsets_.emplace(offset.GetPartition(),
+                                               offset.GetOffset());
+        if (result.second) {
+          return false;
+        }
+
+        if (result.first->second >= offset.GetOffset()) {
+          return true;
+        }
+        result.first->second = offset.GetOffset();
+        return false;
+      });
+  messages_list.erase(end, messages_list.end());
+
+  return messages;
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
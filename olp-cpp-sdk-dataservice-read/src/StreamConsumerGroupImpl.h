@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <olp/core/client/CancellationToken.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include <olp/dataservice/read/StreamConsumerGroup.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+class StreamLayerClientImpl;
+
+class StreamConsumerGroupImpl final {
+ public:
+  StreamConsumerGroupImpl(client::HRN catalog, std::string layer_id,
+                          client::OlpClientSettings settings,
+                          size_t consumers_count);
+
+  ~StreamConsumerGroupImpl();
+
+  size_t GetConsumersCount() const;
+
+  client::CancellationToken Subscribe(SubscribeRequest request,
+                                      ConsumerGroupResponseCallback callback);
+
+  client::CancellationToken StartPolling(
+      ContinuousPollSettings settings, ConsumerGroupMessagesHandler handler,
+      ContinuousPollResponseCallback callback);
+
+  client::CancellationToken Unsubscribe(ConsumerGroupResponseCallback callback);
+
+ private:
+  /// Removes the messages that are already handled by the group, and
+  /// remembers the latest handled offset of each partition.
+  model::Messages FilterHandledMessages(model::Messages messages);
+
+  std::mutex offsets_mutex_;
+  std::unordered_map<int32_t, int64_t> handled_offsets_;
+  // The consumers wait for their tasks when destroyed, so they are destroyed
+  // first.
+  std::vector<std::unique_ptr<StreamLayerClientImpl>> consumers_;
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -20,6 +20,8 @@
 #include "olp/dataservice/read/StreamLayerClient.h"
 
 #include <olp/core/porting/make_unique.h>
+#include <olp/dataservice/read/CatalogClient.h>
+#include "CatalogClientImpl.h"
 #include "StreamLayerClientImpl.h"
 
 namespace olp {
@@ -31,6 +33,11 @@ StreamLayerClient::StreamLayerClient(client::HRN catalog, std::string layer_id,
     : impl_(std::make_unique<StreamLayerClientImpl>(
           std::move(catalog), std::move(layer_id), std::move(settings))) {}
 
+StreamLayerClient::StreamLayerClient(
+    const CatalogClient& catalog_client, std::string layer_id)
+    : impl_(std::make_unique<StreamLayerClientImpl>(
+          catalog_client.impl_->GetContext(), std::move(layer_id))) {}
+
 StreamLayerClient::StreamLayerClient(StreamLayerClient&& other) noexcept =
     default;
 
@@ -73,6 +80,16 @@ client::CancellableFuture<DataResponse> StreamLayerClient::GetData(
   return impl_->GetData(message);
 }
 
+client::CancellationToken StreamLayerClient::GetData(
+    const model::Messages& messages, MessagesDataResponseCallback callback) {
+  return impl_->GetData(messages, std::move(callback));
+}
+
+client::CancellableFuture<MessagesDataResponse> StreamLayerClient::GetData(
+    const model::Messages& messages) {
+  return impl_->GetData(messages);
+}
+
 client::CancellationToken StreamLayerClient::Poll(
     PollResponseCallback callback) {
   return impl_->Poll(callback);
@@ -82,6 +99,13 @@ client::CancellableFuture<PollResponse> StreamLayerClient::Poll() {
   return impl_->Poll();
 }
 
+client::CancellationToken StreamLayerClient::StartPolling(
+    ContinuousPollSettings settings, PollMessagesHandler handler,
+    ContinuousPollResponseCallback callback) {
+  return impl_->StartPolling(std::move(settings), std::move(handler),
+                             std::move(callback));
+}
+
 client::CancellationToken StreamLayerClient::Seek(
     SeekRequest request, SeekResponseCallback callback) {
   return impl_->Seek(std::move(request), std::move(callback));
@@ -19,18 +19,22 @@
 
 #include "StreamLayerClientImpl.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <set>
+#include <thread>
+#include <vector>
 
 #include <olp/core/cache/DefaultCache.h>
 #include <olp/core/client/CancellationContext.h>
-#include <olp/core/client/OlpClientSettingsFactory.h>
 #include <olp/core/logging/Log.h>
 #include <olp/core/porting/make_unique.h>
 #include <olp/core/thread/TaskScheduler.h>
 #include "Common.h"
 #include "generated/api/BlobApi.h"
 #include "generated/api/StreamApi.h"
+#include "repositories/DataRepository.h"
 
 namespace olp {
 namespace dataservice {
@@ -44,6 +48,7 @@ constexpr auto kStreamService = "stream";
 constexpr auto kStreamVersion = "v2";
 constexpr auto kBlobService = "blob";
 constexpr auto kBlobVersion = "v1";
+constexpr size_t kMaxParallelDownloads = 4u;
 
 std::string GetSubscriptionMode(SubscribeRequest::SubscriptionMode mode) {
   return mode == SubscribeRequest::SubscriptionMode::kSerial
@@ -53,20 +58,37 @@ std::string GetSubscriptionMode(SubscribeRequest::SubscriptionMode mode) {
 
 }  // namespace
 
-StreamLayerClientImpl::StreamLayerClientImpl(client::HRN catalog,
-                                             std::string layer_id,
-                                             client::OlpClientSettings settings)
-    : catalog_(std::move(catalog)),
+StreamLayerClientImpl::StreamLayerClientImpl(
+    client::HRN catalog, std::string layer_id,
+    client::OlpClientSettings settings)
+    : StreamLayerClientImpl(
+          std::make_shared<CatalogContext>(std::move(catalog),
+                                           std::move(settings)),
+          std::move(layer_id)) {}
+
+StreamLayerClientImpl::StreamLayerClientImpl(
+    std::shared_ptr<CatalogContext> context, std::string layer_id)
+    : context_(std::move(context)),
+      catalog_(context_->GetCatalog()),
       layer_id_(std::move(layer_id)),
-      settings_(std::move(settings)),
-      lookup_client_(catalog_, settings_),
-      task_sink_(settings_.task_scheduler) {
-  if (!settings_.cache) {
-    settings_.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
+      settings_(context_->GetSettings()),
+      lookup_client_(context_->GetLookupClient()),
+      task_sink_(settings_.task_scheduler) {}
+
+StreamLayerClientImpl::~StreamLayerClientImpl() {
+  std::vector<std::weak_ptr<ContinuousPoll>> continuous_polls;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    continuous_polls.swap(continuous_polls_);
   }
-}
 
-StreamLayerClientImpl::~StreamLayerClientImpl() = default;
+  for (auto& continuous_poll : continuous_polls) {
+    auto poll = continuous_poll.lock();
+    if (poll) {
+      FinishPolling(poll, client::ApiError::Cancelled());
+    }
+  }
+}
 
 bool StreamLayerClientImpl::CancelPendingRequests() {
   OLP_SDK_LOG_TRACE(kLogTag, "CancelPendingRequests");
@@ -124,16 +146,26 @@ client::CancellationToken StreamLayerClientImpl::Subscribe(
     }
 
     const auto subscripton_id = subscription.GetResult().GetSubscriptionId();
+    auto subscription_context = std::make_unique<StreamLayerClientContext>(
+        subscripton_id, subscription_mode, correlation_id,
+        std::make_shared<client::OlpClient>());
+
+    subscription_context->client->SetBaseUrl(
+        subscription.GetResult().GetNodeBaseURL());
+    subscription_context->client->SetSettings(settings_);
+
+    const auto& checkpoint_id = request.GetCheckpointId();
+    if (checkpoint_id && settings_.cache) {
+      subscription_context->checkpoint =
+          std::make_shared<repository::StreamOffsetsRepository>(
+              catalog_, layer_id_, *checkpoint_id,
+              request.GetCheckpointInterval(), settings_.cache);
+      ResumeFromCheckpoint(*subscription_context, context);
+    }
+
     {
       std::lock_guard<std::mutex> lock(mutex_);
-
-      client_context_ = std::make_unique<StreamLayerClientContext>(
-          subscripton_id, subscription_mode, correlation_id,
-          std::make_shared<client::OlpClient>());
-
-      client_context_->client->SetBaseUrl(
-          subscription.GetResult().GetNodeBaseURL());
-      client_context_->client->SetSettings(settings_);
+      client_context_ = std::move(subscription_context);
     }
 
     OLP_SDK_LOG_INFO_F(kLogTag,
@@ -170,6 +202,7 @@ client::CancellationToken StreamLayerClientImpl::Unsubscribe(
     std::string subscription_mode;
     std::string x_correlation_id;
     std::shared_ptr<client::OlpClient> client;
+    std::shared_ptr<repository::StreamOffsetsRepository> checkpoint;
 
     {
       std::lock_guard<std::mutex> lock(mutex_);
@@ -185,6 +218,11 @@ client::CancellationToken StreamLayerClientImpl::Unsubscribe(
       subscription_mode = client_context_->subscription_mode;
       x_correlation_id = client_context_->x_correlation_id;
       client = client_context_->client;
+      checkpoint = client_context_->checkpoint;
+    }
+
+    if (checkpoint) {
+      checkpoint->Flush();
     }
 
     OLP_SDK_LOG_INFO_F(kLogTag,
@@ -278,86 +316,249 @@ client::CancellableFuture<DataResponse> StreamLayerClientImpl::GetData(
                                                       std::move(promise));
 }
 
-client::CancellationToken StreamLayerClientImpl::Poll(
-    PollResponseCallback callback) {
-  auto poll_task = [=](client::CancellationContext context) -> PollResponse {
-    std::string subscription_id;
-    std::string subscription_mode;
-    std::string x_correlation_id;
-    std::shared_ptr<client::OlpClient> client;
-
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (!client_context_) {
-        OLP_SDK_LOG_WARNING_F(kLogTag,
-                              "Poll: unsuccessful, subscription missing");
+client::CancellationToken StreamLayerClientImpl::GetData(
+    const model::Messages& messages, MessagesDataResponseCallback callback) {
+  const auto& messages_list = messages.GetMessages();
+  auto get_data_task =
+      [=](client::CancellationContext context) -> MessagesDataResponse {
+    const auto messages_count = messages_list.size();
+    OLP_SDK_LOG_INFO_F(kLogTag, "GetData: started, messages=%zu",
+                       messages_count);
+
+    MessagesDataResult result(messages_count);
+    std::vector<client::CancellationContext> contexts(messages_count);
+
+    const bool started = context.ExecuteOrCancelled([&]() {
+      return client::CancellationToken([contexts]() mutable {
+        for (auto& message_context : contexts) {
+          message_context.CancelOperation();
+        }
+      });
+    });
+    if (!started) {
+      return client::ApiError::Cancelled();
+    }
 
-        return client::ApiError(client::ErrorCode::PreconditionFailed,
-                                "Subscription missing", false);
+    repository::DataRepository repository(catalog_, settings_,
+                                          lookup_client_);
+
+    std::atomic<size_t> next_message{0u};
+    auto download = [&]() {
+      for (auto index = next_message++; index < messages_count;
+           index = next_message++) {
+        const auto& message = messages_list[index];
+        const auto& data_handle = message.GetMetaData().GetDataHandle();
+        if (!data_handle) {
+          result[index] = message.GetData();
+          continue;
+        }
+
+        // The data is requested through the repository, so the concurrent
+        // downloads of the same data handle are shared.
+        result[index] = repository.GetBlobData(
+            layer_id_, kBlobService,
+            DataRequest()
+                .WithDataHandle(data_handle.value())
+                .WithFetchOption(OnlineIfNotFound),
+            contexts[index]);
       }
+    };
 
-      subscription_id = client_context_->subscription_id;
-      subscription_mode = client_context_->subscription_mode;
-      x_correlation_id = client_context_->x_correlation_id;
-      client = client_context_->client;
+    std::vector<std::thread> workers;
+    const auto workers_count =
+        std::min(kMaxParallelDownloads, messages_count);
+    for (size_t worker = 1u; worker < workers_count; ++worker) {
+      workers.emplace_back(download);
+    }
+    download();
+    for (auto& worker : workers) {
+      worker.join();
     }
 
-    OLP_SDK_LOG_INFO_F(kLogTag,
-                       "Poll: started, subscription_id=%s, "
-                       "subscription_mode=%s, x_correlation_id=%s",
-                       subscription_id.c_str(), subscription_mode.c_str(),
-                       x_correlation_id.c_str());
+    if (context.IsCancelled()) {
+      return client::ApiError::Cancelled();
+    }
+
+    OLP_SDK_LOG_INFO_F(kLogTag, "GetData: done, messages=%zu",
+                       messages_count);
+    return result;
+  };
+
+  return task_sink_.AddTask(std::move(get_data_task), std::move(callback),
+                            thread::NORMAL);
+}
 
-    auto data =
-        StreamApi::ConsumeData(*client, layer_id_, subscription_id,
-                               subscription_mode, context, x_correlation_id);
+client::CancellableFuture<MessagesDataResponse> StreamLayerClientImpl::GetData(
+    const model::Messages& messages) {
+  auto promise = std::make_shared<std::promise<MessagesDataResponse>>();
+  auto cancel_token =
+      GetData(messages, [promise](MessagesDataResponse response) {
+        promise->set_value(std::move(response));
+      });
 
-    if (!data.IsSuccessful()) {
-      OLP_SDK_LOG_WARNING_F(kLogTag, "Poll: couldn't consume data, error=%s",
-                            data.GetError().GetMessage().c_str());
-      return data.GetError();
+  return olp::client::CancellableFuture<MessagesDataResponse>(
+      std::move(cancel_token), std::move(promise));
+}
+
+PollResponse StreamLayerClientImpl::ConsumeMessages(
+    client::CancellationContext context) {
+  std::string subscription_id;
+  std::string subscription_mode;
+  std::string x_correlation_id;
+  std::shared_ptr<client::OlpClient> client;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!client_context_) {
+      OLP_SDK_LOG_WARNING_F(kLogTag,
+                            "Poll: unsuccessful, subscription missing");
+
+      return client::ApiError(client::ErrorCode::PreconditionFailed,
+                              "Subscription missing", false);
     }
 
-    auto res = data.MoveResult();
+    subscription_id = client_context_->subscription_id;
+    subscription_mode = client_context_->subscription_mode;
+    x_correlation_id = client_context_->x_correlation_id;
+    client = client_context_->client;
+  }
 
-    const auto& messages = res.GetMessages();
+  OLP_SDK_LOG_INFO_F(kLogTag,
+                     "Poll: started, subscription_id=%s, "
+                     "subscription_mode=%s, x_correlation_id=%s",
+                     subscription_id.c_str(), subscription_mode.c_str(),
+                     x_correlation_id.c_str());
 
-    if (messages.empty()) {
-      OLP_SDK_LOG_INFO_F(kLogTag, "Poll: done, no new messages received.");
-      return res;
+  auto data =
+      StreamApi::ConsumeData(*client, layer_id_, subscription_id,
+                             subscription_mode, context, x_correlation_id);
+
+  if (!data.IsSuccessful()) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Poll: couldn't consume data, error=%s",
+                          data.GetError().GetMessage().c_str());
+    return data.GetError();
+  }
+
+  return data.MoveResult();
+}
+
+StreamLayerClientImpl::CommitResponse StreamLayerClientImpl::CommitMessages(
+    const model::Messages& messages, client::CancellationContext context) {
+  std::string subscription_id;
+  std::string subscription_mode;
+  std::string x_correlation_id;
+  std::shared_ptr<client::OlpClient> client;
+  std::shared_ptr<repository::StreamOffsetsRepository> checkpoint;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!client_context_) {
+      OLP_SDK_LOG_WARNING_F(
+          kLogTag, "Poll: commit offsets unsuccessful, subscription missing");
+
+      return client::ApiError(client::ErrorCode::PreconditionFailed,
+                              "Subscription missing", false);
     }
 
-    // Get offsets for all partitions presented in messages.
-    struct Compare {
-      bool operator()(const model::StreamOffset& lhs,
-                      const model::StreamOffset& rhs) const {
-        return lhs.GetPartition() < rhs.GetPartition();
-      }
-    };
+    subscription_id = client_context_->subscription_id;
+    subscription_mode = client_context_->subscription_mode;
+    x_correlation_id = client_context_->x_correlation_id;
+    client = client_context_->client;
+    checkpoint = client_context_->checkpoint;
+  }
 
-    std::set<model::StreamOffset, Compare> stream_offsets;
+  // Get offsets for all partitions presented in messages.
+  struct Compare {
+    bool operator()(const model::StreamOffset& lhs,
+                    const model::StreamOffset& rhs) const {
+      return lhs.GetPartition() < rhs.GetPartition();
+    }
+  };
 
-    std::transform(messages.rbegin(), messages.rend(),
-                   std::inserter(stream_offsets, stream_offsets.end()),
-                   [](const model::Message& msg) { return msg.GetOffset(); });
+  std::set<model::StreamOffset, Compare> stream_offsets;
+
+  const auto& messages_list = messages.GetMessages();
+  std::transform(messages_list.rbegin(), messages_list.rend(),
+                 std::inserter(stream_offsets, stream_offsets.end()),
+                 [](const model::Message& msg) { return msg.GetOffset(); });
+
+  // Commit offsets
+  model::StreamOffsets offsets_request;
+  offsets_request.SetOffsets(std::vector<model::StreamOffset>(
+      stream_offsets.begin(), stream_offsets.end()));
+  auto commit_res = StreamApi::CommitOffsets(
+      *client, layer_id_, offsets_request, subscription_id, subscription_mode,
+      context, x_correlation_id);
+
+  if (!commit_res.IsSuccessful()) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "Poll: commit offsets unsuccessful, error=%s",
+                          commit_res.GetError().GetMessage().c_str());
+    return commit_res.GetError();
+  }
 
-    // Commit offsets
-    model::StreamOffsets offsets_request;
-    offsets_request.SetOffsets(std::vector<model::StreamOffset>(
-        stream_offsets.begin(), stream_offsets.end()));
-    auto commit_res = StreamApi::CommitOffsets(
-        *client, layer_id_, offsets_request, subscription_id, subscription_mode,
-        context, x_correlation_id);
+  if (checkpoint) {
+    checkpoint->Commit(offsets_request.GetOffsets());
+  }
 
-    if (!commit_res.IsSuccessful()) {
-      OLP_SDK_LOG_WARNING_F(kLogTag,
-                            "Poll: commit offsets unsuccessful, error=%s",
-                            commit_res.GetError().GetMessage().c_str());
-      return commit_res.GetError();
+  return client::ApiNoResult{};
+}
+
+void StreamLayerClientImpl::ResumeFromCheckpoint(
+    StreamLayerClientContext& subscription,
+    client::CancellationContext context) {
+  auto saved_offsets = subscription.checkpoint->Load();
+  if (saved_offsets.empty()) {
+    return;
+  }
+
+  // The saved offsets are the ones of the consumed messages, the reading
+  // continues with the next ones.
+  for (auto& offset : saved_offsets) {
+    offset.SetOffset(offset.GetOffset() + 1);
+  }
+
+  model::StreamOffsets seek_offsets;
+  seek_offsets.SetOffsets(std::move(saved_offsets));
+  const auto response = StreamApi::SeekToOffset(
+      *subscription.client, layer_id_, seek_offsets,
+      subscription.subscription_id, subscription.subscription_mode, context,
+      subscription.x_correlation_id);
+
+  // The subscription is usable without the checkpoint, it continues from the
+  // offsets the service has.
+  if (!response.IsSuccessful()) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "Subscribe: seek to saved offsets unsuccessful, "
+                          "error=%s",
+                          response.GetError().GetMessage().c_str());
+    return;
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag, "Subscribe: resumed, partitions=%zu",
+                     seek_offsets.GetOffsets().size());
+}
+
+client::CancellationToken StreamLayerClientImpl::Poll(
+    PollResponseCallback callback) {
+  auto poll_task = [=](client::CancellationContext context) -> PollResponse {
+    auto response = ConsumeMessages(context);
+    if (!response.IsSuccessful()) {
+      return response;
+    }
+
+    if (response.GetResult().GetMessages().empty()) {
+      OLP_SDK_LOG_INFO_F(kLogTag, "Poll: done, no new messages received.");
+      return response;
+    }
+
+    auto commit_response = CommitMessages(response.GetResult(), context);
+    if (!commit_response.IsSuccessful()) {
+      return commit_response.GetError();
     }
     OLP_SDK_LOG_INFO_F(kLogTag, "Poll: done, response is successful.");
 
-    return res;
+    return response;
   };
 
   return task_sink_.AddTask(std::move(poll_task), std::move(callback),
@@ -374,6 +575,181 @@ client::CancellableFuture<PollResponse> StreamLayerClientImpl::Poll() {
                                                         std::move(promise));
 }
 
+client::CancellationToken StreamLayerClientImpl::StartPolling(
+    ContinuousPollSettings settings, PollMessagesHandler handler,
+    ContinuousPollResponseCallback callback) {
+  if (!settings_.task_scheduler) {
+    // Without a task scheduler, each poll would run in the stack of the
+    // previous one.
+    OLP_SDK_LOG_WARNING(kLogTag, "StartPolling: task scheduler is missing");
+    callback(client::ApiError(client::ErrorCode::PreconditionFailed,
+                              "Continuous polling requires a task scheduler",
+                              false));
+    return client::CancellationToken();
+  }
+
+  auto poll = std::make_shared<ContinuousPoll>();
+  poll->settings = std::move(settings);
+  poll->settings.max_pending_batches =
+      std::max<size_t>(poll->settings.max_pending_batches, 1u);
+  poll->handler = std::move(handler);
+  poll->callback = std::move(callback);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    continuous_polls_.erase(
+        std::remove_if(continuous_polls_.begin(), continuous_polls_.end(),
+                       [](const std::weak_ptr<ContinuousPoll>& active_poll) {
+                         return active_poll.expired();
+                       }),
+        continuous_polls_.end());
+    continuous_polls_.push_back(poll);
+  }
+
+  SchedulePoll(poll, std::chrono::milliseconds::zero());
+
+  // The token only refers to the poll state, so it can be used after the
+  // client is destroyed.
+  return client::CancellationToken(
+      [poll]() { FinishPolling(poll, client::ApiError::Cancelled()); });
+}
+
+void StreamLayerClientImpl::SchedulePoll(const ContinuousPollPtr& poll,
+                                         std::chrono::milliseconds delay) {
+  client::CancellationContext poll_context;
+  {
+    std::lock_guard<std::mutex> lock(poll->mutex);
+    const auto pending_batches =
+        poll->batches.size() + (poll->handling ? 1u : 0u);
+    if (poll->finished || poll->polling ||
+        pending_batches >= poll->settings.max_pending_batches) {
+      return;
+    }
+
+    poll->polling = true;
+    poll->poll_context = poll_context;
+  }
+
+  auto poll_task = [=](client::CancellationContext context) {
+    if (delay > std::chrono::milliseconds::zero()) {
+      context.ExecuteOrCancelled([&]() {
+        return client::CancellationToken(
+            [poll]() { poll->condition.notify_all(); });
+      });
+
+      std::unique_lock<std::mutex> lock(poll->mutex);
+      poll->condition.wait_for(lock, delay, [&]() {
+        return poll->finished || context.IsCancelled();
+      });
+    }
+
+    OnMessagesPolled(poll, ConsumeMessages(context));
+  };
+
+  task_sink_.AddTask(std::move(poll_task), thread::NORMAL,
+                     std::move(poll_context));
+}
+
+void StreamLayerClientImpl::OnMessagesPolled(const ContinuousPollPtr& poll,
+                                             PollResponse response) {
+  if (!response.IsSuccessful()) {
+    FinishPolling(poll, response.GetError());
+    return;
+  }
+
+  auto messages = response.MoveResult();
+  const bool empty = messages.GetMessages().empty();
+  {
+    std::lock_guard<std::mutex> lock(poll->mutex);
+    poll->polling = false;
+    if (!empty && !poll->finished) {
+      poll->batches.push_back(std::move(messages));
+    }
+  }
+
+  DeliverMessages(poll);
+  SchedulePoll(poll, empty ? poll->settings.empty_poll_delay
+                           : std::chrono::milliseconds::zero());
+}
+
+void StreamLayerClientImpl::DeliverMessages(const ContinuousPollPtr& poll) {
+  auto messages = std::make_shared<model::Messages>();
+  {
+    std::lock_guard<std::mutex> lock(poll->mutex);
+    if (poll->finished || poll->handling || poll->batches.empty()) {
+      return;
+    }
+
+    *messages = std::move(poll->batches.front());
+    poll->batches.pop_front();
+    poll->handling = true;
+  }
+
+  auto commit_task = [=](client::CancellationContext context) {
+    auto response = CommitMessages(*messages, context);
+    if (!response.IsSuccessful()) {
+      FinishPolling(poll, response.GetError());
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(poll->mutex);
+      poll->handling = false;
+    }
+
+    DeliverMessages(poll);
+    SchedulePoll(poll, std::chrono::milliseconds::zero());
+  };
+
+  auto acknowledged = std::make_shared<std::atomic<bool>>(false);
+  PollAcknowledgement acknowledgement = [=]() {
+    if (acknowledged->exchange(true)) {
+      return;
+    }
+
+    // The client marks the polls finished before it is destroyed, so the
+    // commit is only scheduled while the client is alive.
+    std::lock_guard<std::mutex> lock(poll->mutex);
+    if (!poll->finished) {
+      task_sink_.AddTask(commit_task, thread::NORMAL,
+                         client::CancellationContext());
+    }
+  };
+
+  auto handler_task = [=](client::CancellationContext context) {
+    if (!context.IsCancelled()) {
+      poll->handler(*messages, acknowledgement);
+    }
+  };
+
+  task_sink_.AddTask(std::move(handler_task), thread::NORMAL,
+                     client::CancellationContext());
+}
+
+void StreamLayerClientImpl::FinishPolling(const ContinuousPollPtr& poll,
+                                          ContinuousPollResponse response) {
+  ContinuousPollResponseCallback callback;
+  client::CancellationContext poll_context;
+  {
+    std::lock_guard<std::mutex> lock(poll->mutex);
+    if (poll->finished) {
+      return;
+    }
+
+    poll->finished = true;
+    poll->batches.clear();
+    callback = std::move(poll->callback);
+    poll_context = poll->poll_context;
+  }
+
+  poll->condition.notify_all();
+  poll_context.CancelOperation();
+
+  if (callback) {
+    callback(std::move(response));
+  }
+}
+
 client::CancellationToken StreamLayerClientImpl::Seek(
     SeekRequest request, SeekResponseCallback callback) {
   auto seek_task = [=](client::CancellationContext context) -> SeekResponse {
@@ -19,19 +19,27 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <olp/core/client/ApiLookupClient.h>
 #include <olp/core/client/CancellationToken.h>
 #include <olp/core/client/HRN.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/client/PendingRequests.h>
+#include <olp/dataservice/read/ContinuousPollSettings.h>
 #include <olp/dataservice/read/SeekRequest.h>
 #include <olp/dataservice/read/SubscribeRequest.h>
 #include <olp/dataservice/read/Types.h>
 #include <olp/dataservice/read/model/Messages.h>
 
+#include "CatalogContext.h"
 #include "TaskSink.h"
+#include "repositories/StreamOffsetsRepository.h"
 
 namespace olp {
 namespace client {
@@ -46,6 +54,9 @@ class StreamLayerClientImpl {
   StreamLayerClientImpl(client::HRN catalog, std::string layer_id,
                         client::OlpClientSettings settings);
 
+  StreamLayerClientImpl(std::shared_ptr<CatalogContext> context,
+                        std::string layer_id);
+
   virtual ~StreamLayerClientImpl();
 
   virtual bool CancelPendingRequests();
@@ -67,9 +78,19 @@ class StreamLayerClientImpl {
   virtual client::CancellableFuture<DataResponse> GetData(
       const model::Message& message);
 
+  virtual client::CancellationToken GetData(
+      const model::Messages& messages, MessagesDataResponseCallback callback);
+
+  virtual client::CancellableFuture<MessagesDataResponse> GetData(
+      const model::Messages& messages);
+
   virtual client::CancellationToken Poll(PollResponseCallback callback);
   virtual client::CancellableFuture<PollResponse> Poll();
 
+  virtual client::CancellationToken StartPolling(
+      ContinuousPollSettings settings, PollMessagesHandler handler,
+      ContinuousPollResponseCallback callback);
+
   virtual client::CancellationToken Seek(SeekRequest request,
                                          SeekResponseCallback callback);
   virtual client::CancellableFuture<SeekResponse> Seek(SeekRequest request);
@@ -90,13 +111,56 @@ class StreamLayerClientImpl {
     std::string subscription_mode;
     std::string x_correlation_id;
     std::shared_ptr<client::OlpClient> client;
+    /// Saves the committed offsets, null if the request has no checkpoint
+    /// ID.
+    std::shared_ptr<repository::StreamOffsetsRepository> checkpoint;
+  };
+
+  /// The state of a continuous polling started with `StartPolling`.
+  struct ContinuousPoll {
+    ContinuousPollSettings settings;
+    PollMessagesHandler handler;
+    ContinuousPollResponseCallback callback;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    /// The received batches that are not passed to the handler yet.
+    std::deque<model::Messages> batches;
+    client::CancellationContext poll_context;
+    bool polling{false};
+    bool handling{false};
+    bool finished{false};
   };
 
+  using ContinuousPollPtr = std::shared_ptr<ContinuousPoll>;
+  using CommitResponse = Response<client::ApiNoResult>;
+
+  /// Consumes the next messages of the subscription.
+  PollResponse ConsumeMessages(client::CancellationContext context);
+
+  /// Seeks the new subscription to the offsets after the saved ones.
+  void ResumeFromCheckpoint(StreamLayerClientContext& subscription,
+                            client::CancellationContext context);
+
+  /// Commits the latest offsets of the partitions of the messages.
+  CommitResponse CommitMessages(const model::Messages& messages,
+                                client::CancellationContext context);
+
+  void SchedulePoll(const ContinuousPollPtr& poll,
+                    std::chrono::milliseconds delay);
+  void OnMessagesPolled(const ContinuousPollPtr& poll, PollResponse response);
+  void DeliverMessages(const ContinuousPollPtr& poll);
+
+  static void FinishPolling(const ContinuousPollPtr& poll,
+                            ContinuousPollResponse response);
+
+  std::shared_ptr<CatalogContext> context_;
   client::HRN catalog_;
   std::string layer_id_;
   client::OlpClientSettings settings_;
   std::mutex mutex_;
   std::unique_ptr<StreamLayerClientContext> client_context_;
+  std::vector<std::weak_ptr<ContinuousPoll>> continuous_polls_;
   client::ApiLookupClient lookup_client_;
   TaskSink task_sink_;
 };
@@ -19,36 +19,51 @@
 
 #include "TaskSink.h"
 
+#include <chrono>
+
+#include <olp/core/client/Tracer.h>
+#include <olp/core/http/RequestPriorityScope.h>
 #include <olp/core/logging/Log.h>
+#include <olp/core/thread/TaskComponentScope.h>
 
 namespace olp {
 namespace dataservice {
 namespace read {
 namespace {
 constexpr auto kLogTag = "TaskSink";
+
+constexpr auto kFinishTimeout = std::chrono::seconds(60);
 }
 
 TaskSink::TaskSink(std::shared_ptr<thread::TaskScheduler> task_scheduler)
     : task_scheduler_(std::move(task_scheduler)),
-      pending_requests_(std::make_shared<client::PendingRequests>()),
-      closed_(false) {}
+      state_(std::make_shared<State>()) {}
 
 TaskSink::~TaskSink() {
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    closed_ = true;
-    const auto task_count = pending_requests_->GetTaskCount();
-    if (task_count > 0) {
-      OLP_SDK_LOG_INFO_F(kLogTag, "Finishing, canceling %" PRIu64 " tasks.",
-                         static_cast<std::uint64_t>(task_count));
-    }
+  state_->closed.store(true);
+  const auto task_count = state_->task_count.load();
+  if (task_count > 0) {
+    OLP_SDK_LOG_INFO_F(kLogTag, "Finishing, canceling %" PRIu64 " tasks.",
+                       static_cast<std::uint64_t>(task_count));
+  }
+
+  CancelTasks();
+
+  // The queued tasks finish as cancelled when the scheduler starts them.
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  if (!state_->finished.wait_for(lock, kFinishTimeout, [&] {
+        return state_->task_count.load() == 0u;
+      })) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Timeout, when waiting on the tasks");
   }
-  // CancelAllAndWait method should be called without mutex, since potentially
-  // there might be new added tasks, it may result in deadlock.
-  pending_requests_->CancelAllAndWait();
 }
 
-void TaskSink::CancelTasks() { pending_requests_->CancelAll(); }
+void TaskSink::CancelTasks() {
+  // The tasks check the generation after they are added to the running ones,
+  // so each task is either cancelled here or cancels itself when it starts.
+  state_->cancel_generation.fetch_add(1u);
+  state_->running_tasks.CancelAll();
+}
 
 client::CancellationToken TaskSink::AddTask(
     std::function<void(client::CancellationContext)> func, uint32_t priority,
@@ -68,32 +83,99 @@ bool TaskSink::AddTaskImpl(client::TaskContext task, uint32_t priority) {
   if (task_scheduler_) {
     return ScheduleTask(std::move(task), priority);
   } else {
-    ExecuteTask(std::move(task));
+    ExecuteTask(std::move(task), priority);
     return true;
   }
 }
 
 bool TaskSink::ScheduleTask(client::TaskContext task, uint32_t priority) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  if (closed_) {
+  if (!AcquireTasks(1u)) {
     OLP_SDK_LOG_WARNING(
         kLogTag, "Attempt to add a task when the sink is already closed");
     return false;
   }
 
-  pending_requests_->Insert(task);
-  auto pending_requests = pending_requests_;
-  task_scheduler_->ScheduleTask(
-      [=] {
-        task.Execute();
-        pending_requests->Remove(task);
-      },
-      priority);
+  thread::TaskComponentScope component_scope(kLogTag);
+  task_scheduler_->ScheduleTask(MakeRunner(std::move(task), priority),
+                                priority);
 
   return true;
 }
 
-void TaskSink::ExecuteTask(client::TaskContext task) { task.Execute(); }
+bool TaskSink::AddTasks(std::vector<client::TaskContext> tasks,
+                        uint32_t priority) {
+  if (!task_scheduler_) {
+    for (auto& task : tasks) {
+      ExecuteTask(std::move(task), priority);
+    }
+    return true;
+  }
+
+  if (!AcquireTasks(tasks.size())) {
+    OLP_SDK_LOG_WARNING(
+        kLogTag, "Attempt to add tasks when the sink is already closed");
+    return false;
+  }
+
+  std::vector<thread::TaskScheduler::CallFuncType> funcs;
+  funcs.reserve(tasks.size());
+  for (auto& task : tasks) {
+    funcs.emplace_back(MakeRunner(std::move(task), priority));
+  }
+
+  thread::TaskComponentScope component_scope(kLogTag);
+  task_scheduler_->ScheduleTasks(std::move(funcs), priority);
+  return true;
+}
+
+thread::TaskScheduler::CallFuncType TaskSink::MakeRunner(
+    client::TaskContext task, uint32_t priority) const {
+  auto state = state_;
+  auto span = client::SpanScope::GetCurrentSpan();
+  const auto generation = state->cancel_generation.load();
+  return [=] {
+    state->running_tasks.Insert(task);
+    if (state->closed.load() ||
+        state->cancel_generation.load() != generation) {
+      task.CancelToken().Cancel();
+    }
+
+    // The requests of the task are sent with the task priority.
+    http::RequestPriorityScope priority_scope(priority);
+    // The spans of the task are children of the span that added it.
+    client::SpanScope span_scope(span);
+    // A chain of stages finishes after `Execute` returns.
+    task.Execute([=] {
+      state->running_tasks.Remove(task);
+      ReleaseTask(*state);
+    });
+  };
+}
+
+void TaskSink::ExecuteTask(client::TaskContext task, uint32_t priority) {
+  http::RequestPriorityScope priority_scope(priority);
+  task.Execute();
+}
+
+bool TaskSink::AcquireTasks(size_t count) {
+  // The count is increased first, so the destructor either waits for the
+  // tasks or they see that the sink is closed.
+  state_->task_count.fetch_add(count);
+  if (state_->closed.load()) {
+    for (size_t i = 0u; i < count; ++i) {
+      ReleaseTask(*state_);
+    }
+    return false;
+  }
+  return true;
+}
+
+void TaskSink::ReleaseTask(State& state) {
+  if (state.task_count.fetch_sub(1u) == 1u) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.finished.notify_all();
+  }
+}
 
 }  // namespace read
 }  // namespace dataservice
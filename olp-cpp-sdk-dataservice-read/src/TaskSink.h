@@ -19,6 +19,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <boost/optional.hpp>
 
 #include <olp/core/client/CancellationToken.h>
@@ -39,6 +45,8 @@ class TaskSink {
 
   ~TaskSink();
 
+  /// Cancels all the tasks added so far. The queued tasks are cancelled when
+  /// they are started, only the running ones are cancelled right away.
   void CancelTasks();
 
   client::CancellationToken AddTask(
@@ -67,17 +75,53 @@ class TaskSink {
     return context.CancelToken();
   }
 
+  /// Schedules the tasks at once, or returns false if the sink is closed.
+  bool AddTasks(std::vector<client::TaskContext> tasks, uint32_t priority);
+
+  template <typename Response, typename Callback>
+  client::CancellationToken AddContinuation(
+      client::TaskContinuation<Response> continuation, Callback callback,
+      uint32_t priority,
+      client::CancellationContext context = client::CancellationContext()) {
+    auto task = client::TaskContext::Create(
+        std::move(continuation), std::move(callback), std::move(context),
+        task_scheduler_, priority);
+    AddTaskImpl(task, priority);
+    return task.CancelToken();
+  }
+
  protected:
   bool AddTaskImpl(client::TaskContext task, uint32_t priority);
 
+  /// The state shared with the scheduled tasks, which may finish after the
+  /// sink is destroyed.
+  struct State {
+    /// Incremented on every `CancelTasks` call; the tasks scheduled before
+    /// are cancelled when they start.
+    std::atomic<uint64_t> cancel_generation{0u};
+    std::atomic<bool> closed{false};
+    /// The scheduled tasks that have not finished yet.
+    std::atomic<size_t> task_count{0u};
+    /// The tasks that are running right now.
+    client::PendingRequests running_tasks;
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+
   bool ScheduleTask(client::TaskContext task, uint32_t priority);
 
-  void ExecuteTask(client::TaskContext task);
+  thread::TaskScheduler::CallFuncType MakeRunner(client::TaskContext task,
+                                                 uint32_t priority) const;
+
+  void ExecuteTask(client::TaskContext task, uint32_t priority);
+
+  /// Reserves the tasks in the sink, or returns false if it is closed.
+  bool AcquireTasks(size_t count);
+
+  static void ReleaseTask(State& state);
 
   const std::shared_ptr<thread::TaskScheduler> task_scheduler_;
-  const std::shared_ptr<client::PendingRequests> pending_requests_;
-  std::mutex mutex_;
-  bool closed_;
+  const std::shared_ptr<State> state_;
 };
 
 }  // namespace read
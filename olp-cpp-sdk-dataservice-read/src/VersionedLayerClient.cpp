@@ -19,7 +19,11 @@
 
 #include "olp/dataservice/read/VersionedLayerClient.h"
 
+#include <future>
+
 #include <olp/core/porting/make_unique.h>
+#include <olp/dataservice/read/CatalogClient.h>
+#include "CatalogClientImpl.h"
 #include "VersionedLayerClientImpl.h"
 
 namespace olp {
@@ -34,6 +38,13 @@ VersionedLayerClient::VersionedLayerClient(
           std::move(catalog), std::move(layer_id), std::move(catalog_version),
           std::move(settings))) {}
 
+VersionedLayerClient::VersionedLayerClient(
+    const CatalogClient& catalog_client, std::string layer_id,
+    boost::optional<int64_t> catalog_version)
+    : impl_(std::make_unique<VersionedLayerClientImpl>(
+          catalog_client.impl_->GetContext(), std::move(layer_id),
+          std::move(catalog_version))) {}
+
 VersionedLayerClient::VersionedLayerClient(
     VersionedLayerClient&& other) noexcept = default;
 
@@ -46,6 +57,39 @@ bool VersionedLayerClient::CancelPendingRequests() {
   return impl_->CancelPendingRequests();
 }
 
+client::CancellationToken VersionedLayerClient::OpenReadSession(
+    CatalogVersionRequest request, ReadSessionCallback callback) {
+  auto context = impl_->GetContext();
+  auto layer_id = impl_->GetLayerId();
+
+  auto version_callback = [=](CatalogVersionResponse response) {
+    if (!response.IsSuccessful()) {
+      callback(response.GetError());
+      return;
+    }
+
+    const auto version = response.GetResult().GetVersion();
+    auto session_impl =
+        std::make_shared<VersionedLayerClientImpl>(context, layer_id, version);
+    callback(ReadSessionResult(
+        new VersionedLayerReadSession(std::move(session_impl), version)));
+  };
+
+  return impl_->GetLatestVersion(std::move(request),
+                                 std::move(version_callback));
+}
+
+client::CancellableFuture<ReadSessionResponse>
+VersionedLayerClient::OpenReadSession(CatalogVersionRequest request) {
+  auto promise = std::make_shared<std::promise<ReadSessionResponse>>();
+  auto cancel_token = OpenReadSession(
+      std::move(request), [promise](ReadSessionResponse response) {
+        promise->set_value(std::move(response));
+      });
+  return client::CancellableFuture<ReadSessionResponse>(
+      std::move(cancel_token), std::move(promise));
+}
+
 client::CancellationToken VersionedLayerClient::GetData(
     DataRequest data_request, DataResponseCallback callback) {
   return impl_->GetData(std::move(data_request), std::move(callback));
@@ -56,6 +100,13 @@ client::CancellableFuture<DataResponse> VersionedLayerClient::GetData(
   return impl_->GetData(std::move(data_request));
 }
 
+client::CancellationToken VersionedLayerClient::StreamData(
+    DataRequest data_request, DataChunkCallback chunk_callback,
+    DataStreamResponseCallback callback) {
+  return impl_->StreamData(std::move(data_request), std::move(chunk_callback),
+                           std::move(callback));
+}
+
 client::CancellationToken VersionedLayerClient::GetPartitions(
     PartitionsRequest partitions_request, PartitionsResponseCallback callback) {
   return impl_->GetPartitions(std::move(partitions_request),
@@ -67,6 +118,28 @@ VersionedLayerClient::GetPartitions(PartitionsRequest partitions_request) {
   return impl_->GetPartitions(std::move(partitions_request));
 }
 
+client::CancellationToken VersionedLayerClient::GetCompactPartitions(
+    PartitionsRequest partitions_request, uint32_t fields,
+    CompactPartitionsResponseCallback callback) {
+  return impl_->GetCompactPartitions(std::move(partitions_request), fields,
+                                     std::move(callback));
+}
+
+client::CancellableFuture<CompactPartitionsResponse>
+VersionedLayerClient::GetCompactPartitions(PartitionsRequest partitions_request,
+                                           uint32_t fields) {
+  return impl_->GetCompactPartitions(std::move(partitions_request), fields);
+}
+
+client::CancellationToken VersionedLayerClient::StreamPartitions(
+    PartitionsRequest partitions_request,
+    PartitionsChunkCallback chunk_callback,
+    PartitionsStreamResponseCallback callback) {
+  return impl_->StreamPartitions(std::move(partitions_request),
+                                 std::move(chunk_callback),
+                                 std::move(callback));
+}
+
 client::CancellationToken VersionedLayerClient::PrefetchTiles(
     PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
     PrefetchStatusCallback status_callback) {
@@ -74,6 +147,15 @@ client::CancellationToken VersionedLayerClient::PrefetchTiles(
                               std::move(status_callback));
 }
 
+client::CancellationToken VersionedLayerClient::PrefetchTiles(
+    PrefetchTilesRequest request, PrefetchTileResultCallback tile_callback,
+    PrefetchTilesResponseCallback callback,
+    PrefetchStatusCallback status_callback) {
+  return impl_->PrefetchTiles(std::move(request), std::move(callback),
+                              std::move(status_callback),
+                              std::move(tile_callback));
+}
+
 client::CancellableFuture<PrefetchTilesResponse>
 VersionedLayerClient::PrefetchTiles(PrefetchTilesRequest request,
                                     PrefetchStatusCallback status_callback) {
@@ -106,6 +188,11 @@ client::CancellableFuture<DataResponse> VersionedLayerClient::GetData(
   return impl_->GetData(std::move(request));
 }
 
+void VersionedLayerClient::SetSpeculativePrefetch(
+    SpeculativePrefetchSettings settings) {
+  impl_->SetSpeculativePrefetch(std::move(settings));
+}
+
 bool VersionedLayerClient::RemoveFromCache(const std::string& partition_id) {
   return impl_->RemoveFromCache(partition_id);
 }
@@ -133,6 +220,27 @@ bool VersionedLayerClient::IsCached(const geo::TileKey& tile,
   return impl_->IsCached(tile, aggregated);
 }
 
+DataResponse VersionedLayerClient::GetCachedData(
+    const std::string& partition_id) const {
+  return impl_->GetCachedData(partition_id);
+}
+
+DataResponse VersionedLayerClient::GetCachedData(
+    const geo::TileKey& tile) const {
+  return impl_->GetCachedData(tile);
+}
+
+TileKeys VersionedLayerClient::GetCachedTiles(const TileKeys& tiles,
+                                              bool aggregated) const {
+  return impl_->GetCachedTiles(tiles, aggregated);
+}
+
+TileKeys VersionedLayerClient::GetCachedTiles(const geo::GeoRectangle& area,
+                                              std::uint32_t level,
+                                              bool aggregated) const {
+  return impl_->GetCachedTiles(area, level, aggregated);
+}
+
 bool VersionedLayerClient::Protect(const TileKeys& tiles) {
   return impl_->Protect(tiles);
 }
@@ -141,6 +249,18 @@ bool VersionedLayerClient::Release(const TileKeys& tiles) {
   return impl_->Release(tiles);
 }
 
+bool VersionedLayerClient::Protect(const geo::GeoRectangle& area,
+                                   std::uint32_t min_level,
+                                   std::uint32_t max_level) {
+  return impl_->Protect(area, min_level, max_level);
+}
+
+bool VersionedLayerClient::Release(const geo::GeoRectangle& area,
+                                   std::uint32_t min_level,
+                                   std::uint32_t max_level) {
+  return impl_->Release(area, min_level, max_level);
+}
+
 }  // namespace read
 }  // namespace dataservice
 }  // namespace olp
@@ -20,6 +20,7 @@
 #include "VersionedLayerClientImpl.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <iterator>
 #include <map>
 #include <string>
@@ -28,24 +29,29 @@
 
 #include <olp/core/cache/DefaultCache.h>
 #include <olp/core/client/ApiNoResult.h>
-#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/client/DeadlineScope.h>
 #include <olp/core/client/PendingRequests.h>
 #include <olp/core/client/TaskContext.h>
+#include <olp/core/client/Tracer.h>
 #include <olp/core/context/Context.h>
+#include <olp/core/geo/tiling/TileKeyUtils.h>
+#include <olp/core/geo/tiling/TilingSchemeRegistry.h>
 #include <olp/core/logging/Log.h>
 #include <olp/core/thread/TaskScheduler.h>
-#include <olp/dataservice/read/CatalogVersionRequest.h>
+#include "CachedTilesResolver.h"
 #include "Common.h"
+#include "DataDecompressor.h"
 #include "ExtendedApiResponseHelpers.h"
 #include "PrefetchPartitionsHelper.h"
+#include "PrefetchTilesArea.h"
 #include "PrefetchTilesHelper.h"
 #include "ProtectDependencyResolver.h"
 #include "ReleaseDependencyResolver.h"
 #include "generated/api/QueryApi.h"
-#include "repositories/CatalogRepository.h"
 #include "repositories/DataCacheRepository.h"
 #include "repositories/DataRepository.h"
 #include "repositories/PartitionsRepository.h"
+#include "repositories/PrefetchCheckpointRepository.h"
 #include "repositories/PrefetchTilesRepository.h"
 
 namespace olp {
@@ -56,23 +62,95 @@ namespace {
 constexpr auto kLogTag = "VersionedLayerClientImpl";
 constexpr int64_t kInvalidVersion = -1;
 constexpr auto kQuadTreeDepth = 4;
+
+/// The blob of a version, or `boost::none` if it has to be downloaded again.
+struct VersionedBlob {
+  int64_t version{kInvalidVersion};
+  boost::optional<BlobApi::DataResponse> response;
+};
+using VersionedBlobResponse =
+    client::ApiResponse<VersionedBlob, client::ApiError>;
+
+/// Returns the neighbors on the level of the tile, the ones sharing an edge
+/// first. When `follow_direction` is set and the previous tile is adjacent,
+/// only the neighbors in the direction of the movement are returned.
+std::vector<geo::TileKey> NeighborTiles(
+    const geo::TileKey& tile, const boost::optional<geo::TileKey>& previous,
+    bool follow_direction) {
+  static const int kOffsets[][2] = {{0, 1},  {0, -1}, {1, 0},  {-1, 0},
+                                    {1, 1},  {1, -1}, {-1, 1}, {-1, -1}};
+
+  int64_t row_step = 0;
+  int64_t column_step = 0;
+  if (follow_direction && previous && previous->Level() == tile.Level()) {
+    row_step = static_cast<int64_t>(tile.Row()) - previous->Row();
+    column_step = static_cast<int64_t>(tile.Column()) - previous->Column();
+    if (std::abs(row_step) > 1 || std::abs(column_step) > 1) {
+      row_step = 0;
+      column_step = 0;
+    }
+  }
+  const bool directed = row_step != 0 || column_step != 0;
+
+  std::vector<geo::TileKey> neighbors;
+  neighbors.reserve(8u);
+  for (const auto& offset : kOffsets) {
+    if (directed && offset[0] * row_step + offset[1] * column_step <= 0) {
+      continue;
+    }
+
+    const auto row = static_cast<int64_t>(tile.Row()) + offset[0];
+    const auto column = static_cast<int64_t>(tile.Column()) + offset[1];
+    if (row < 0 || row >= tile.RowCount() || column < 0 ||
+        column >= tile.ColumnCount()) {
+      continue;
+    }
+
+    neighbors.push_back(geo::TileKey::FromRowColumnLevel(
+        static_cast<uint32_t>(row), static_cast<uint32_t>(column),
+        tile.Level()));
+  }
+
+  return neighbors;
+}
+
+client::DeadlineScope::Clock::time_point GetDeadline(
+    const boost::optional<client::DeadlineScope::Clock::time_point>&
+        deadline) {
+  return deadline ? *deadline : client::DeadlineScope::Clock::time_point::max();
+}
+
+/// Checks whether the request failed because it missed its deadline, so the
+/// cached data is returned instead.
+template <typename Request>
+bool IsDeadlineMissed(const Request& request, const client::ApiError& error) {
+  const auto& deadline = request.GetDeadline();
+  return deadline && request.GetFetchOption() != CacheOnly &&
+         error.GetErrorCode() != client::ErrorCode::Cancelled &&
+         client::DeadlineScope::Clock::now() >= *deadline;
+}
 }  // namespace
 
 VersionedLayerClientImpl::VersionedLayerClientImpl(
     client::HRN catalog, std::string layer_id,
     boost::optional<int64_t> catalog_version,
     client::OlpClientSettings settings)
-    : catalog_(std::move(catalog)),
+    : VersionedLayerClientImpl(
+          std::make_shared<CatalogContext>(std::move(catalog),
+                                           std::move(settings)),
+          std::move(layer_id), std::move(catalog_version)) {}
+
+VersionedLayerClientImpl::VersionedLayerClientImpl(
+    std::shared_ptr<CatalogContext> context, std::string layer_id,
+    boost::optional<int64_t> catalog_version)
+    : context_(std::move(context)),
+      catalog_(context_->GetCatalog()),
       layer_id_(std::move(layer_id)),
-      settings_(std::move(settings)),
+      settings_(context_->GetSettings()),
       catalog_version_(catalog_version ? catalog_version.get()
                                        : kInvalidVersion),
-      lookup_client_(catalog_, settings_),
-      task_sink_(settings_.task_scheduler) {
-  if (!settings_.cache) {
-    settings_.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
-  }
-}
+      lookup_client_(context_->GetLookupClient()),
+      task_sink_(settings_.task_scheduler) {}
 
 bool VersionedLayerClientImpl::CancelPendingRequests() {
   OLP_SDK_LOG_TRACE(kLogTag, "CancelPendingRequests");
@@ -122,38 +200,148 @@ VersionedLayerClientImpl::GetPartitions(PartitionsRequest partitions_request) {
                                                        std::move(promise));
 }
 
+client::CancellationToken VersionedLayerClientImpl::GetCompactPartitions(
+    PartitionsRequest request, uint32_t fields,
+    CompactPartitionsResponseCallback callback) {
+  auto partitions_callback =
+      ToCompactPartitionsCallback(fields, std::move(callback));
+  return GetPartitions(std::move(request), std::move(partitions_callback));
+}
+
+client::CancellableFuture<CompactPartitionsResponse>
+VersionedLayerClientImpl::GetCompactPartitions(PartitionsRequest request,
+                                               uint32_t fields) {
+  auto promise = std::make_shared<std::promise<CompactPartitionsResponse>>();
+  auto cancel_token =
+      GetCompactPartitions(std::move(request), fields,
+                           [promise](CompactPartitionsResponse response) {
+                             promise->set_value(std::move(response));
+                           });
+  return client::CancellableFuture<CompactPartitionsResponse>(
+      std::move(cancel_token), std::move(promise));
+}
+
+client::CancellationToken VersionedLayerClientImpl::StreamPartitions(
+    PartitionsRequest request, PartitionsChunkCallback chunk_callback,
+    PartitionsStreamResponseCallback callback) {
+  auto stream_task =
+      [this](PartitionsRequest partitions_request,
+             PartitionsChunkCallback partitions_chunk_callback,
+             client::CancellationContext context) -> PartitionsStreamResponse {
+    const auto fetch_option = partitions_request.GetFetchOption();
+    if (fetch_option == CacheWithUpdate) {
+      return client::ApiError(
+          client::ErrorCode::InvalidArgument,
+          "CacheWithUpdate option can not be used for versioned layer");
+    }
+
+    auto version_response =
+        GetVersion(partitions_request.GetBillingTag(), fetch_option, context);
+    if (!version_response.IsSuccessful()) {
+      return version_response.GetError();
+    }
+
+    const auto version = version_response.GetResult().GetVersion();
+
+    repository::PartitionsRepository repository(catalog_, layer_id_, settings_,
+                                                lookup_client_);
+    return repository.StreamVersionedPartitions(
+        partitions_request, version, partitions_chunk_callback, context);
+  };
+
+  return task_sink_.AddTask(
+      std::bind(stream_task, std::move(request), std::move(chunk_callback),
+                std::placeholders::_1),
+      std::move(callback), thread::NORMAL);
+}
+
 client::CancellationToken VersionedLayerClientImpl::GetData(
     DataRequest request, DataResponseCallback callback) {
   auto catalog = catalog_;
   auto layer_id = layer_id_;
   auto settings = settings_;
   auto lookup_client = lookup_client_;
+  const auto priority = request.GetPriority();
 
-  auto data_task =
-      [=](client::CancellationContext context) mutable -> DataResponse {
+  // Resolves the catalog version and then the data as separate stages. The
+  // repositories are synchronous, so the stages run inline on one worker and
+  // block it while they wait for the network. A request of a blob that
+  // another request downloads releases the worker instead, and the last stage
+  // is scheduled once that download completes.
+  auto version_stage = [=](client::CancellationContext context,
+                           std::function<void(CatalogVersionResponse)>
+                               version_callback) {
     if (request.GetFetchOption() == CacheWithUpdate) {
-      return {{client::ErrorCode::InvalidArgument,
-               "CacheWithUpdate option can not be used for versioned "
-               "layer"}};
+      version_callback(client::ApiError(
+          client::ErrorCode::InvalidArgument,
+          "CacheWithUpdate option can not be used for versioned layer"));
+      return;
     }
 
-    int64_t version = -1;
-    if (!request.GetDataHandle()) {
-      auto version_response = GetVersion(request.GetBillingTag(),
-                                         request.GetFetchOption(), context);
-      if (!version_response.IsSuccessful()) {
-        return version_response.GetError();
-      }
-      version = version_response.GetResult().GetVersion();
+    if (request.GetDataHandle()) {
+      model::VersionResponse no_version;
+      no_version.SetVersion(-1);
+      version_callback(std::move(no_version));
+      return;
     }
 
-    repository::DataRepository repository(
-        std::move(catalog), std::move(settings), std::move(lookup_client));
-    return repository.GetVersionedData(layer_id, request, version, context);
+    client::DeadlineScope deadline_scope(GetDeadline(request.GetDeadline()));
+    version_callback(GetVersionBeforeDeadline(request, context));
   };
 
-  return task_sink_.AddTask(std::move(data_task), std::move(callback),
-                            request.GetPriority());
+  auto blob_stage = [=](client::CancellationContext context,
+                        model::VersionResponse version,
+                        std::function<void(VersionedBlobResponse)>
+                            blob_callback) {
+    client::DeadlineScope deadline_scope(GetDeadline(request.GetDeadline()));
+    repository::DataRepository repository(catalog, settings, lookup_client);
+    const auto blob_version = version.GetVersion();
+    VersionedBlob blob;
+    blob.version = blob_version;
+    blob.response = repository.GetVersionedDataOrShare(
+        layer_id, request, blob_version, context,
+        [=](boost::optional<BlobApi::DataResponse> shared_response) {
+          VersionedBlob shared_blob;
+          shared_blob.version = blob_version;
+          shared_blob.response = std::move(shared_response);
+          blob_callback(std::move(shared_blob));
+        });
+    if (blob.response) {
+      blob_callback(std::move(blob));
+    }
+  };
+
+  auto data_stage = [=](client::CancellationContext context, VersionedBlob blob,
+                        std::function<void(DataResponse)> data_callback) {
+    client::DeadlineScope deadline_scope(GetDeadline(request.GetDeadline()));
+    repository::DataRepository repository(catalog, settings, lookup_client);
+    DataResponse response =
+        blob.response ? std::move(*blob.response)
+                      : repository.GetVersionedData(layer_id, request,
+                                                    blob.version, context);
+    if (!response.IsSuccessful() &&
+        IsDeadlineMissed(request, response.GetError())) {
+      auto cached_response = repository.GetVersionedData(
+          layer_id, DataRequest(request).WithFetchOption(CacheOnly),
+          blob.version, context);
+      if (cached_response.IsSuccessful()) {
+        response = std::move(cached_response);
+      }
+    }
+    if (request.GetDecompression()) {
+      response = DecompressData(std::move(response));
+    }
+    data_callback(std::move(response));
+  };
+
+  auto continuation =
+      client::TaskContext::Then<CatalogVersionResponse>(
+          std::move(version_stage))
+          .Then<VersionedBlobResponse>(std::move(blob_stage))
+          .Then<DataResponse>(std::move(data_stage));
+
+  return task_sink_.AddContinuation(std::move(continuation),
+                                    std::move(callback), priority);
 }
 
 client::CancellableFuture<DataResponse> VersionedLayerClientImpl::GetData(
@@ -167,6 +355,42 @@ client::CancellableFuture<DataResponse> VersionedLayerClientImpl::GetData(
                                                  std::move(promise));
 }
 
+client::CancellationToken VersionedLayerClientImpl::StreamData(
+    DataRequest request, DataChunkCallback chunk_callback,
+    DataStreamResponseCallback callback) {
+  auto stream_task =
+      [this](DataRequest data_request, DataChunkCallback data_chunk_callback,
+             client::CancellationContext context) -> DataStreamResponse {
+    const auto fetch_option = data_request.GetFetchOption();
+    if (fetch_option == CacheWithUpdate) {
+      return client::ApiError(
+          client::ErrorCode::InvalidArgument,
+          "CacheWithUpdate option can not be used for versioned layer");
+    }
+
+    int64_t version = -1;
+    if (!data_request.GetDataHandle()) {
+      auto version_response =
+          GetVersion(data_request.GetBillingTag(), fetch_option, context);
+      if (!version_response.IsSuccessful()) {
+        return version_response.GetError();
+      }
+      version = version_response.GetResult().GetVersion();
+    }
+
+    repository::DataRepository repository(catalog_, settings_,
+                                          lookup_client_);
+    return repository.StreamVersionedData(layer_id_, data_request, version,
+                                          data_chunk_callback, context);
+  };
+
+  const auto priority = request.GetPriority();
+  return task_sink_.AddTask(
+      std::bind(stream_task, std::move(request), std::move(chunk_callback),
+                std::placeholders::_1),
+      std::move(callback), priority);
+}
+
 client::CancellationToken VersionedLayerClientImpl::PrefetchPartitions(
     PrefetchPartitionsRequest request,
     PrefetchPartitionsResponseCallback callback,
@@ -284,9 +508,13 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchPartitions(
     auto download_job = std::make_shared<PrefetchPartitionsHelper::DownloadJob>(
         std::move(download), std::move(append_result),
         std::move(call_user_callback), std::move(status_callback));
+    PrefetchPartitionsHelper::Settings helper_settings;
+    helper_settings.query_chunk_size = request.GetQueryChunkSize();
+    helper_settings.max_parallel_queries = request.GetMaxParallelQueries();
+
     return PrefetchPartitionsHelper::Prefetch(
         std::move(download_job), request.GetPartitionIds(), std::move(query),
-        task_sink_, request.GetPriority(), context);
+        helper_settings, task_sink_, request.GetPriority(), context);
   };
   const auto priority = request.GetPriority();
   return task_sink_.AddTask(
@@ -311,7 +539,8 @@ VersionedLayerClientImpl::PrefetchPartitions(
 
 client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
     PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
-    PrefetchStatusCallback status_callback) {
+    PrefetchStatusCallback status_callback,
+    PrefetchTileResultCallback tile_callback) {
   using client::ApiError;
   using client::ErrorCode;
 
@@ -324,7 +553,8 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
           return;
         }
 
-        if (request.GetTileKeys().empty()) {
+        if (request.GetTileKeys().empty() &&
+            PrefetchTilesArea(request).IsEmpty()) {
           OLP_SDK_LOG_WARNING_F(
               kLogTag, "PrefetchTiles : invalid request, catalog=%s, layer=%s",
               catalog_.ToCatalogHRNString().c_str(), layer_id_.c_str());
@@ -369,8 +599,8 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
             catalog_, layer_id_, settings_, lookup_client_,
             request.GetBillingTag());
 
-        auto sliced_tiles = repository.GetSlicedTiles(request.GetTileKeys(),
-                                                      min_level, max_level);
+        auto sliced_tiles =
+            repository.GetSlicedTiles(request, min_level, max_level);
 
         if (sliced_tiles.empty()) {
           OLP_SDK_LOG_WARNING_F(kLogTag,
@@ -381,6 +611,30 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
           return;
         }
 
+        std::shared_ptr<repository::PrefetchCheckpointRepository> checkpoint;
+        if (request.GetResumeId()) {
+          checkpoint =
+              std::make_shared<repository::PrefetchCheckpointRepository>(
+                  catalog_, layer_id_, *request.GetResumeId(), version,
+                  settings_.cache);
+
+          // Skip the quad trees downloaded by the interrupted prefetch.
+          for (const auto& root : checkpoint->Load()) {
+            sliced_tiles.erase(root);
+          }
+
+          if (sliced_tiles.empty()) {
+            OLP_SDK_LOG_DEBUG_F(kLogTag,
+                                "PrefetchTiles: already completed, key=%s",
+                                key.c_str());
+            checkpoint->Clear();
+            callback(PrefetchTilesResult());
+            return;
+          }
+
+          checkpoint->SetRootsLeft(sliced_tiles.size());
+        }
+
         OLP_SDK_LOG_DEBUG_F(kLogTag, "PrefetchTiles, subquads=%zu, key=%s",
                             sliced_tiles.size(), key.c_str());
 
@@ -420,9 +674,8 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
             return BlobApi::DataResponse(
                 ApiError(ErrorCode::NotFound, "Not found"));
           }
-          repository::DataCacheRepository data_cache_repository(
-              catalog_, settings_.cache);
-          if (data_cache_repository.IsCached(layer_id_, data_handle)) {
+          // The filter checked the cache for all of the tiles at once.
+          if (repository.IsDataCached(data_handle)) {
             return BlobApi::DataResponse(nullptr);
           }
 
@@ -445,15 +698,18 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
               return root.first;
             });
 
-        auto append_result = [](ExtendedDataResponse response,
-                                geo::TileKey item,
-                                PrefetchTilesResult& prefetch_result) {
-          if (response.IsSuccessful()) {
-            prefetch_result.push_back(std::make_shared<PrefetchTileResult>(
-                item, PrefetchTileNoError()));
+        // The streamed results are not kept until the prefetch completes.
+        auto append_result = [=](ExtendedDataResponse response,
+                                 geo::TileKey item,
+                                 PrefetchTilesResult& prefetch_result) {
+          auto result = response.IsSuccessful()
+                            ? PrefetchTileResult(item, PrefetchTileNoError())
+                            : PrefetchTileResult(item, response.GetError());
+          if (tile_callback) {
+            tile_callback(result);
           } else {
-            prefetch_result.push_back(std::make_shared<PrefetchTileResult>(
-                item, response.GetError()));
+            prefetch_result.push_back(
+                std::make_shared<PrefetchTileResult>(std::move(result)));
           }
         };
 
@@ -461,6 +717,34 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
             std::move(download), std::move(append_result), std::move(callback),
             std::move(status_callback));
 
+        // The pipeline tracks the tiles of each quad tree, which the resumable
+        // prefetch needs.
+        if (request.GetFocusPoint() || request.GetMaxInFlightDownloads() > 0 ||
+            request.GetAdaptiveDownloads() || checkpoint ||
+            settings_.memory_budget) {
+          PrefetchTilesPipeline::Settings pipeline_settings;
+          pipeline_settings.focus_point = request.GetFocusPoint();
+          // Without a task scheduler the tasks run one by one on this thread,
+          // so there is nothing to limit.
+          pipeline_settings.max_in_flight_downloads =
+              settings_.task_scheduler ? request.GetMaxInFlightDownloads() : 0;
+          pipeline_settings.adaptive_downloads =
+              settings_.task_scheduler && request.GetAdaptiveDownloads();
+          pipeline_settings.filter_after_all_queries = request_only_input_tiles;
+          if (settings_.task_scheduler) {
+            pipeline_settings.memory_budget = settings_.memory_budget;
+          }
+          if (checkpoint) {
+            pipeline_settings.on_root_completed =
+                [=](const geo::TileKey& root) { checkpoint->Complete(root); };
+          }
+
+          return PrefetchTilesHelper::PrefetchPipelined(
+              std::move(download_job), std::move(roots), std::move(query),
+              std::move(filter), std::move(pipeline_settings), task_sink_,
+              request.GetPriority(), context);
+        }
+
         return PrefetchTilesHelper::Prefetch(
             std::move(download_job), std::move(roots), std::move(query),
             std::move(filter), task_sink_, request.GetPriority(), context);
@@ -481,6 +765,35 @@ VersionedLayerClientImpl::PrefetchTiles(
                                                           promise);
 }
 
+client::CancellationToken VersionedLayerClientImpl::GetLatestVersion(
+    CatalogVersionRequest request, CatalogVersionCallback callback) {
+  auto catalog_context = context_;
+
+  auto latest_version_task = [=](client::CancellationContext context) {
+    return catalog_context->GetLatestVersion(request, context);
+  };
+
+  return task_sink_.AddTask(std::move(latest_version_task),
+                            std::move(callback), thread::NORMAL);
+}
+
+template <typename Request>
+CatalogVersionResponse VersionedLayerClientImpl::GetVersionBeforeDeadline(
+    const Request& request, const client::CancellationContext& context) {
+  auto response =
+      GetVersion(request.GetBillingTag(), request.GetFetchOption(), context);
+  if (response.IsSuccessful() ||
+      !IsDeadlineMissed(request, response.GetError())) {
+    return response;
+  }
+
+  // The cached version is not kept as the version of the client, so the next
+  // requests resolve the latest one.
+  auto cached_response =
+      context_->GetVersion(request.GetBillingTag(), CacheOnly, context);
+  return cached_response.IsSuccessful() ? cached_response : response;
+}
+
 CatalogVersionResponse VersionedLayerClientImpl::GetVersion(
     boost::optional<std::string> billing_tag, const FetchOptions& fetch_options,
     const client::CancellationContext& context) {
@@ -491,13 +804,9 @@ CatalogVersionResponse VersionedLayerClientImpl::GetVersion(
     return response;
   }
 
-  CatalogVersionRequest request;
-  request.WithBillingTag(billing_tag);
-  request.WithFetchOption(fetch_options);
-
-  repository::CatalogRepository repository(catalog_, settings_, lookup_client_);
-  auto response = repository.GetLatestVersion(request, context);
-
+  // The layer clients of one catalog use the same version.
+  auto response =
+      context_->GetVersion(std::move(billing_tag), fetch_options, context);
   if (!response.IsSuccessful()) {
     return response;
   }
@@ -519,7 +828,8 @@ client::CancellationToken VersionedLayerClientImpl::GetData(
   auto settings = settings_;
   auto lookup_client = lookup_client_;
 
-  auto data_task = [=](client::CancellationContext context) -> DataResponse {
+  auto data_task = [=](const TileRequest& request,
+                       client::CancellationContext context) -> DataResponse {
     if (request.GetFetchOption() == CacheWithUpdate) {
       return {{client::ErrorCode::InvalidArgument,
                "CacheWithUpdate option can not be used for versioned layer"}};
@@ -529,20 +839,61 @@ client::CancellationToken VersionedLayerClientImpl::GetData(
       return {{client::ErrorCode::InvalidArgument, "Tile key is invalid"}};
     }
 
-    auto version_response =
-        GetVersion(request.GetBillingTag(), request.GetFetchOption(), context);
+    client::DeadlineScope deadline_scope(GetDeadline(request.GetDeadline()));
+    auto version_response = GetVersionBeforeDeadline(request, context);
     if (!version_response.IsSuccessful()) {
       return version_response.GetError();
     }
 
-    repository::DataRepository repository(
-        std::move(catalog), std::move(settings), std::move(lookup_client));
-    return repository.GetVersionedTile(
-        layer_id, request, version_response.GetResult().GetVersion(), context);
+    const auto version = version_response.GetResult().GetVersion();
+    repository::DataRepository repository(catalog, settings, lookup_client);
+    auto response =
+        repository.GetVersionedTile(layer_id, request, version, context);
+    if (!response.IsSuccessful() &&
+        IsDeadlineMissed(request, response.GetError())) {
+      auto cached_response = repository.GetVersionedTile(
+          layer_id, TileRequest(request).WithFetchOption(CacheOnly), version,
+          context);
+      if (cached_response.IsSuccessful()) {
+        response = std::move(cached_response);
+      }
+    }
+    if (request.GetDecompression()) {
+      response = DecompressData(std::move(response));
+    }
+    return response;
   };
 
-  return task_sink_.AddTask(std::move(data_task), std::move(callback),
-                            request.GetPriority());
+  const auto tile = request.GetTileKey();
+  const auto priority = request.GetPriority();
+
+  // The root span of the request, the version, quad tree and blob requests
+  // of the task are its children.
+  auto span = client::StartSpan(settings_.tracer, "olp.read.GetData");
+  if (span) {
+    span->SetAttribute("olp.layer", layer_id_);
+    span->SetAttribute("olp.tile", tile.ToHereTile());
+  }
+
+  auto data_callback = [=](const DataResponseCallback& callback,
+                           DataResponse response) {
+    const bool served = response.IsSuccessful();
+    if (span) {
+      span->SetAttribute("olp.success", served ? "true" : "false");
+      span->End();
+    }
+    callback(std::move(response));
+    if (served) {
+      PrefetchNeighbors(tile);
+    }
+  };
+
+  // The request and the callback are moved into the task, not copied.
+  client::SpanScope span_scope(span);
+  return task_sink_.AddTask(
+      std::bind(data_task, std::move(request), std::placeholders::_1),
+      std::bind(data_callback, std::move(callback), std::placeholders::_1),
+      priority);
 }
 
 client::CancellableFuture<DataResponse> VersionedLayerClientImpl::GetData(
@@ -556,6 +907,107 @@ client::CancellableFuture<DataResponse> VersionedLayerClientImpl::GetData(
                                                  std::move(promise));
 }
 
+void VersionedLayerClientImpl::SetSpeculativePrefetch(
+    SpeculativePrefetchSettings settings) {
+  std::lock_guard<std::mutex> lock(speculative_prefetch_mutex_);
+  if (!settings.enabled) {
+    speculative_prefetch_context_.CancelOperation();
+    speculative_prefetch_tile_ = boost::none;
+  }
+  speculative_prefetch_settings_ = std::move(settings);
+}
+
+void VersionedLayerClientImpl::PrefetchNeighbors(const geo::TileKey& tile) {
+  const auto version = catalog_version_.load();
+  if (version == kInvalidVersion) {
+    return;
+  }
+
+  SpeculativePrefetchSettings prefetch_settings;
+  std::vector<geo::TileKey> neighbors;
+  client::CancellationContext prefetch_context;
+  {
+    std::lock_guard<std::mutex> lock(speculative_prefetch_mutex_);
+    prefetch_settings = speculative_prefetch_settings_;
+    if (!prefetch_settings.enabled || prefetch_settings.byte_budget == 0u) {
+      return;
+    }
+
+    neighbors =
+        NeighborTiles(tile, speculative_prefetch_tile_,
+                      prefetch_settings.follow_direction);
+    speculative_prefetch_tile_ = tile;
+
+    // Only the neighbors of the last served tile are worth prefetching.
+    speculative_prefetch_context_.CancelOperation();
+    speculative_prefetch_context_ = prefetch_context;
+  }
+
+  if (neighbors.empty()) {
+    return;
+  }
+
+  auto catalog = catalog_;
+  auto layer_id = layer_id_;
+  auto settings = settings_;
+  auto lookup_client = lookup_client_;
+
+  auto prefetch_task = [=](client::CancellationContext context) {
+    repository::PartitionsRepository partitions_repository(
+        catalog, layer_id, settings, lookup_client);
+    repository::DataRepository data_repository(catalog, settings,
+                                               lookup_client);
+    repository::DataCacheRepository data_cache_repository(catalog,
+                                                          settings.cache);
+
+    auto budget = prefetch_settings.byte_budget;
+    for (const auto& neighbor : neighbors) {
+      if (context.IsCancelled() || budget == 0u) {
+        return;
+      }
+
+      // The partition is only looked up in the cached quadtree, the metadata
+      // is not requested for the speculative prefetch.
+      auto partition_response = partitions_repository.GetTile(
+          TileRequest().WithTileKey(neighbor).WithFetchOption(CacheOnly),
+          version, context);
+      if (!partition_response.IsSuccessful()) {
+        continue;
+      }
+
+      const auto& partition = partition_response.GetResult();
+      if (data_cache_repository.IsCached(layer_id,
+                                         partition.GetDataHandle())) {
+        continue;
+      }
+
+      const auto& data_size = partition.GetDataSize();
+      if (data_size && static_cast<uint64_t>(*data_size) > budget) {
+        continue;
+      }
+
+      auto data_response = data_repository.GetVersionedData(
+          layer_id,
+          DataRequest()
+              .WithDataHandle(partition.GetDataHandle())
+              .WithFetchOption(OnlineIfNotFound),
+          version, context);
+      if (!data_response.IsSuccessful() || !data_response.GetResult()) {
+        continue;
+      }
+
+      budget -= std::min<uint64_t>(budget, data_response.GetResult()->size());
+      OLP_SDK_LOG_DEBUG_F(kLogTag,
+                          "PrefetchNeighbors: prefetched tile='%s', hrn='%s'",
+                          neighbor.ToHereTile().c_str(),
+                          catalog.ToCatalogHRNString().c_str());
+    }
+  };
+
+  task_sink_.AddTask(std::move(prefetch_task), prefetch_settings.priority,
+                     std::move(prefetch_context));
+}
+
 bool VersionedLayerClientImpl::RemoveFromCache(
     const std::string& partition_id) {
   repository::PartitionsCacheRepository partitions_cache_repository(
@@ -648,21 +1100,98 @@ bool VersionedLayerClientImpl::IsCached(const geo::TileKey& tile,
     return false;
   }
 
-  read::QuadTreeIndex cached_tree;
+  return CachedTilesResolver(catalog_, layer_id_, version, settings_)
+      .IsCached(tile, aggregated);
+}
+
+DataResponse VersionedLayerClientImpl::GetCachedData(
+    const std::string& partition_id) {
+  auto version = catalog_version_.load();
+  if (version == kInvalidVersion) {
+    OLP_SDK_LOG_WARNING(
+        kLogTag, "Method GetCachedData failed, version is not initialized");
+    return {{client::ErrorCode::PreconditionFailed,
+             "Version is not initialized"}};
+  }
 
   auto cache = settings_.cache;
 
   repository::PartitionsCacheRepository partitions_repo(catalog_, layer_id_,
                                                         cache);
 
-  if (partitions_repo.FindQuadTree(tile, version, cached_tree)) {
-    auto data = cached_tree.Find(tile, aggregated);
+  std::string handle;
+  if (partitions_repo.GetPartitionHandle(partition_id, version, handle)) {
+    repository::DataCacheRepository data_repo(catalog_, cache);
+    auto data = data_repo.Get(layer_id_, handle);
     if (data) {
-      repository::DataCacheRepository data_repo(catalog_, cache);
-      return data_repo.IsCached(layer_id_, data->data_handle);
+      return std::move(data.value());
     }
   }
-  return false;
+  return {{client::ErrorCode::NotFound, "Partition data is not cached"}};
+}
+
+DataResponse VersionedLayerClientImpl::GetCachedData(const geo::TileKey& tile) {
+  auto version = catalog_version_.load();
+  if (version == kInvalidVersion) {
+    OLP_SDK_LOG_WARNING(
+        kLogTag, "Method GetCachedData failed, version is not initialized");
+    return {{client::ErrorCode::PreconditionFailed,
+             "Version is not initialized"}};
+  }
+
+  if (!tile.IsValid()) {
+    return {{client::ErrorCode::InvalidArgument, "Tile key is invalid"}};
+  }
+
+  auto data = CachedTilesResolver(catalog_, layer_id_, version, settings_)
+                  .GetData(tile, false);
+  if (!data) {
+    return {{client::ErrorCode::NotFound, "Tile data is not cached"}};
+  }
+
+  // Served tiles drive the speculative prefetch the same way as `GetData`.
+  PrefetchNeighbors(tile);
+  return std::move(data.value());
+}
+
+TileKeys VersionedLayerClientImpl::GetCachedTiles(const TileKeys& tiles,
+                                                  bool aggregated) {
+  TileKeys cached_tiles;
+  auto version = catalog_version_.load();
+  if (version == kInvalidVersion) {
+    OLP_SDK_LOG_WARNING(
+        kLogTag, "Method GetCachedTiles failed, version is not initialized");
+    return cached_tiles;
+  }
+
+  CachedTilesResolver resolver(catalog_, layer_id_, version, settings_);
+  std::copy_if(tiles.begin(), tiles.end(), std::back_inserter(cached_tiles),
+               [&](const geo::TileKey& tile) {
+                 return resolver.IsCached(tile, aggregated);
+               });
+  return cached_tiles;
+}
+
+TileKeys VersionedLayerClientImpl::GetCachedTiles(const geo::GeoRectangle& area,
+                                                  std::uint32_t level,
+                                                  bool aggregated) {
+  TileKeys cached_tiles;
+  auto version = catalog_version_.load();
+  if (version == kInvalidVersion) {
+    OLP_SDK_LOG_WARNING(
+        kLogTag, "Method GetCachedTiles failed, version is not initialized");
+    return cached_tiles;
+  }
+
+  CachedTilesResolver resolver(catalog_, layer_id_, version, settings_);
+  geo::TileKeyUtils::GeoRectangleToTileKeys(
+      geo::HalfQuadTreeIdentityTilingScheme(), area, level,
+      [&](const geo::TileKey& tile) {
+        if (resolver.IsCached(tile, aggregated)) {
+          cached_tiles.push_back(tile);
+        }
+      });
+  return cached_tiles;
 }
 
 client::CancellationToken VersionedLayerClientImpl::GetAggregatedData(
@@ -791,6 +1320,55 @@ bool VersionedLayerClientImpl::Release(const TileKeys& tiles) {
   return settings_.cache->Release(keys_to_release);
 }
 
+bool VersionedLayerClientImpl::Protect(const geo::GeoRectangle& area,
+                                       std::uint32_t min_level,
+                                       std::uint32_t max_level) {
+  if (!settings_.cache) {
+    return false;
+  }
+  auto version = catalog_version_.load();
+  if (version == kInvalidVersion) {
+    OLP_SDK_LOG_WARNING(kLogTag,
+                        "Method Protect failed, version is not initialized");
+    return false;
+  }
+
+  auto tiles_dependency_resolver =
+      ProtectDependencyResolver(catalog_, layer_id_, version, settings_);
+  const auto& keys_to_protect =
+      tiles_dependency_resolver.GetKeysToProtect(area, min_level, max_level);
+
+  if (keys_to_protect.empty()) {
+    return false;
+  }
+  return settings_.cache->Protect(keys_to_protect);
+}
+
+bool VersionedLayerClientImpl::Release(const geo::GeoRectangle& area,
+                                       std::uint32_t min_level,
+                                       std::uint32_t max_level) {
+  if (!settings_.cache) {
+    return false;
+  }
+  auto version = catalog_version_.load();
+  if (version == kInvalidVersion) {
+    OLP_SDK_LOG_WARNING(kLogTag,
+                        "Method Release failed, version is not initialized");
+    return false;
+  }
+
+  auto tiles_dependency_resolver =
+      ReleaseDependencyResolver(catalog_, layer_id_, version, settings_);
+  const auto& keys_to_release =
+      tiles_dependency_resolver.GetKeysToRelease(area, min_level, max_level);
+
+  if (keys_to_release.empty()) {
+    return false;
+  }
+
+  return settings_.cache->Release(keys_to_release);
+}
+
 }  // namespace read
 }  // namespace dataservice
 }  // namespace olp
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include <olp/core/client/ApiLookupClient.h>
 #include <olp/core/client/CancellationContext.h>
@@ -27,14 +28,17 @@
 #include <olp/core/client/HRN.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/client/PendingRequests.h>
+#include <olp/dataservice/read/CatalogVersionRequest.h>
 #include <olp/dataservice/read/DataRequest.h>
 #include <olp/dataservice/read/PartitionsRequest.h>
 #include <olp/dataservice/read/PrefetchPartitionsRequest.h>
 #include <olp/dataservice/read/PrefetchTileResult.h>
 #include <olp/dataservice/read/PrefetchTilesRequest.h>
+#include <olp/dataservice/read/SpeculativePrefetchSettings.h>
 #include <olp/dataservice/read/TileRequest.h>
 #include <olp/dataservice/read/Types.h>
 #include <boost/optional.hpp>
+#include "CatalogContext.h"
 #include "TaskSink.h"
 
 namespace olp {
@@ -54,8 +58,16 @@ class VersionedLayerClientImpl {
                            boost::optional<int64_t> catalog_version,
                            client::OlpClientSettings settings);
 
+  VersionedLayerClientImpl(std::shared_ptr<CatalogContext> context,
+                           std::string layer_id,
+                           boost::optional<int64_t> catalog_version);
+
   virtual ~VersionedLayerClientImpl() = default;
 
+  const std::shared_ptr<CatalogContext>& GetContext() const { return context_; }
+
+  const std::string& GetLayerId() const { return layer_id_; }
+
   virtual bool CancelPendingRequests();
 
   virtual client::CancellationToken GetData(DataRequest request,
@@ -64,6 +76,10 @@ class VersionedLayerClientImpl {
   virtual client::CancellableFuture<DataResponse> GetData(
       DataRequest data_request);
 
+  virtual client::CancellationToken StreamData(
+      DataRequest request, DataChunkCallback chunk_callback,
+      DataStreamResponseCallback callback);
+
   virtual client::CancellationToken GetData(TileRequest request,
                                             DataResponseCallback callback);
 
@@ -75,9 +91,21 @@ class VersionedLayerClientImpl {
   virtual client::CancellableFuture<PartitionsResponse> GetPartitions(
       PartitionsRequest partitions_request);
 
+  virtual client::CancellationToken GetCompactPartitions(
+      PartitionsRequest request, uint32_t fields,
+      CompactPartitionsResponseCallback callback);
+
+  virtual client::CancellableFuture<CompactPartitionsResponse>
+  GetCompactPartitions(PartitionsRequest request, uint32_t fields);
+
+  virtual client::CancellationToken StreamPartitions(
+      PartitionsRequest request, PartitionsChunkCallback chunk_callback,
+      PartitionsStreamResponseCallback callback);
+
   virtual client::CancellationToken PrefetchTiles(
       PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
-      PrefetchStatusCallback status_callback);
+      PrefetchStatusCallback status_callback,
+      PrefetchTileResultCallback tile_callback = nullptr);
 
   virtual client::CancellableFuture<PrefetchTilesResponse> PrefetchTiles(
       PrefetchTilesRequest request, PrefetchStatusCallback status_callback);
@@ -91,6 +119,8 @@ class VersionedLayerClientImpl {
   PrefetchPartitions(PrefetchPartitionsRequest request,
                      PrefetchPartitionsStatusCallback status_callback);
 
+  virtual void SetSpeculativePrefetch(SpeculativePrefetchSettings settings);
+
   virtual bool RemoveFromCache(const std::string& partition_id);
 
   virtual bool RemoveFromCache(const geo::TileKey& tile);
@@ -99,6 +129,17 @@ class VersionedLayerClientImpl {
 
   virtual bool IsCached(const geo::TileKey& tile, bool aggregated = false);
 
+  virtual DataResponse GetCachedData(const std::string& partition_id);
+
+  virtual DataResponse GetCachedData(const geo::TileKey& tile);
+
+  virtual TileKeys GetCachedTiles(const TileKeys& tiles,
+                                  bool aggregated = false);
+
+  virtual TileKeys GetCachedTiles(const geo::GeoRectangle& area,
+                                  std::uint32_t level,
+                                  bool aggregated = false);
+
   virtual client::CancellationToken GetAggregatedData(
       TileRequest request, AggregatedDataResponseCallback callback);
 
@@ -109,16 +150,41 @@ class VersionedLayerClientImpl {
 
   virtual bool Release(const TileKeys& tiles);
 
+  virtual bool Protect(const geo::GeoRectangle& area, std::uint32_t min_level,
+                       std::uint32_t max_level);
+
+  virtual bool Release(const geo::GeoRectangle& area, std::uint32_t min_level,
+                       std::uint32_t max_level);
+
+  /// Resolves the latest catalog version with the request fetch option,
+  /// bypassing the version of the client and of the catalog context.
+  virtual client::CancellationToken GetLatestVersion(
+      CatalogVersionRequest request, CatalogVersionCallback callback);
+
  private:
   CatalogVersionResponse GetVersion(boost::optional<std::string> billing_tag,
                                     const FetchOptions& fetch_options,
                                     const client::CancellationContext& context);
 
+  /// Resolves the version of the request, or the cached one if the request
+  /// missed its deadline.
+  template <typename Request>
+  CatalogVersionResponse GetVersionBeforeDeadline(
+      const Request& request, const client::CancellationContext& context);
+
+  /// Schedules the speculative prefetch of the neighbors of the served tile.
+  void PrefetchNeighbors(const geo::TileKey& tile);
+
+  std::shared_ptr<CatalogContext> context_;
   client::HRN catalog_;
   std::string layer_id_;
   client::OlpClientSettings settings_;
   std::atomic<int64_t> catalog_version_;
   client::ApiLookupClient lookup_client_;
+  std::mutex speculative_prefetch_mutex_;
+  SpeculativePrefetchSettings speculative_prefetch_settings_;
+  boost::optional<geo::TileKey> speculative_prefetch_tile_;
+  client::CancellationContext speculative_prefetch_context_;
   TaskSink task_sink_;
 };
 
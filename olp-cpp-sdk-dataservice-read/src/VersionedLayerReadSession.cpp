@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/dataservice/read/VersionedLayerReadSession.h"
+
+#include <utility>
+
+#include <olp/dataservice/read/CatalogVersionRequest.h>
+#include "VersionedLayerClientImpl.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+VersionedLayerReadSession::VersionedLayerReadSession(
+    std::shared_ptr<VersionedLayerClientImpl> impl, int64_t version)
+    : impl_(std::move(impl)), version_(version) {}
+
+VersionedLayerReadSession::VersionedLayerReadSession(
+    VersionedLayerReadSession&& other) noexcept = default;
+
+VersionedLayerReadSession& VersionedLayerReadSession::operator=(
+    VersionedLayerReadSession&& other) noexcept = default;
+
+VersionedLayerReadSession::~VersionedLayerReadSession() = default;
+
+int64_t VersionedLayerReadSession::GetVersion() const { return version_; }
+
+bool VersionedLayerReadSession::CancelPendingRequests() {
+  return impl_->CancelPendingRequests();
+}
+
+client::CancellationToken VersionedLayerReadSession::GetData(
+    DataRequest data_request, DataResponseCallback callback) {
+  return impl_->GetData(std::move(data_request), std::move(callback));
+}
+
+client::CancellableFuture<DataResponse> VersionedLayerReadSession::GetData(
+    DataRequest data_request) {
+  return impl_->GetData(std::move(data_request));
+}
+
+client::CancellationToken VersionedLayerReadSession::GetData(
+    TileRequest request, DataResponseCallback callback) {
+  return impl_->GetData(std::move(request), std::move(callback));
+}
+
+client::CancellableFuture<DataResponse> VersionedLayerReadSession::GetData(
+    TileRequest request) {
+  return impl_->GetData(std::move(request));
+}
+
+client::CancellationToken VersionedLayerReadSession::GetPartitions(
+    PartitionsRequest partitions_request, PartitionsResponseCallback callback) {
+  return impl_->GetPartitions(std::move(partitions_request),
+                              std::move(callback));
+}
+
+client::CancellableFuture<PartitionsResponse>
+VersionedLayerReadSession::GetPartitions(PartitionsRequest partitions_request) {
+  return impl_->GetPartitions(std::move(partitions_request));
+}
+
+client::CancellationToken VersionedLayerReadSession::PrefetchTiles(
+    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+    PrefetchStatusCallback status_callback) {
+  return impl_->PrefetchTiles(std::move(request), std::move(callback),
+                              std::move(status_callback));
+}
+
+client::CancellableFuture<PrefetchTilesResponse>
+VersionedLayerReadSession::PrefetchTiles(
+    PrefetchTilesRequest request, PrefetchStatusCallback status_callback) {
+  return impl_->PrefetchTiles(std::move(request), std::move(status_callback));
+}
+
+client::CancellationToken VersionedLayerReadSession::CheckForNewerVersion(
+    CatalogVersionCallback callback) {
+  return impl_->GetLatestVersion(
+      CatalogVersionRequest().WithFetchOption(OnlineOnly), std::move(callback));
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -18,8 +18,10 @@
  */
 
 #include <olp/core/porting/make_unique.h>
+#include <olp/dataservice/read/CatalogClient.h>
 #include <olp/dataservice/read/VolatileLayerClient.h>
 
+#include "CatalogClientImpl.h"
 #include "VolatileLayerClientImpl.h"
 
 namespace olp {
@@ -32,6 +34,11 @@ VolatileLayerClient::VolatileLayerClient(client::HRN catalog,
     : impl_(std::make_unique<VolatileLayerClientImpl>(
           std::move(catalog), std::move(layer_id), std::move(settings))) {}
 
+VolatileLayerClient::VolatileLayerClient(
+    const CatalogClient& catalog_client, std::string layer_id)
+    : impl_(std::make_unique<VolatileLayerClientImpl>(
+          catalog_client.impl_->GetContext(), std::move(layer_id))) {}
+
 VolatileLayerClient::VolatileLayerClient(VolatileLayerClient&& other) noexcept =
     default;
 
@@ -54,6 +61,19 @@ VolatileLayerClient::GetPartitions(PartitionsRequest request) {
   return impl_->GetPartitions(std::move(request));
 }
 
+client::CancellationToken VolatileLayerClient::GetCompactPartitions(
+    PartitionsRequest request, uint32_t fields,
+    CompactPartitionsResponseCallback callback) {
+  return impl_->GetCompactPartitions(std::move(request), fields,
+                                     std::move(callback));
+}
+
+olp::client::CancellableFuture<CompactPartitionsResponse>
+VolatileLayerClient::GetCompactPartitions(PartitionsRequest request,
+                                          uint32_t fields) {
+  return impl_->GetCompactPartitions(std::move(request), fields);
+}
+
 client::CancellationToken VolatileLayerClient::GetData(
     DataRequest request, DataResponseCallback callback) {
   return impl_->GetData(std::move(request), std::move(callback));
@@ -77,6 +97,13 @@ client::CancellationToken VolatileLayerClient::PrefetchTiles(
   return impl_->PrefetchTiles(std::move(request), std::move(callback));
 }
 
+client::CancellationToken VolatileLayerClient::PrefetchTiles(
+    PrefetchTilesRequest request, PrefetchTileResultCallback tile_callback,
+    PrefetchTilesResponseCallback callback) {
+  return impl_->PrefetchTiles(std::move(request), std::move(callback),
+                              std::move(tile_callback));
+}
+
 client::CancellableFuture<PrefetchTilesResponse>
 VolatileLayerClient::PrefetchTiles(PrefetchTilesRequest request) {
   return impl_->PrefetchTiles(std::move(request));
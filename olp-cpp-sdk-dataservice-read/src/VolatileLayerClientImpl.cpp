@@ -23,7 +23,6 @@
 
 #include <olp/core/cache/DefaultCache.h>
 #include <olp/core/client/CancellationContext.h>
-#include <olp/core/client/OlpClientSettingsFactory.h>
 #include <olp/core/client/PendingRequests.h>
 #include <olp/core/client/TaskContext.h>
 #include <olp/core/logging/Log.h>
@@ -36,8 +35,10 @@
 #include "repositories/DataRepository.h"
 #include "repositories/PartitionsCacheRepository.h"
 #include "repositories/PartitionsRepository.h"
+#include "repositories/PrefetchCheckpointRepository.h"
 #include "repositories/PrefetchTilesRepository.h"
 
+#include "PrefetchTilesArea.h"
 #include "PrefetchTilesHelper.h"
 
 namespace olp {
@@ -58,15 +59,19 @@ bool IsOnlyInputTiles(const PrefetchTilesRequest& request) {
 VolatileLayerClientImpl::VolatileLayerClientImpl(
     client::HRN catalog, std::string layer_id,
     client::OlpClientSettings settings)
-    : catalog_(std::move(catalog)),
+    : VolatileLayerClientImpl(
+          std::make_shared<CatalogContext>(std::move(catalog),
+                                           std::move(settings)),
+          std::move(layer_id)) {}
+
+VolatileLayerClientImpl::VolatileLayerClientImpl(
+    std::shared_ptr<CatalogContext> context, std::string layer_id)
+    : context_(std::move(context)),
+      catalog_(context_->GetCatalog()),
       layer_id_(std::move(layer_id)),
-      settings_(std::move(settings)),
-      lookup_client_(catalog_, settings_),
-      task_sink_(settings_.task_scheduler) {
-  if (!settings_.cache) {
-    settings_.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
-  }
-}
+      settings_(context_->GetSettings()),
+      lookup_client_(context_->GetLookupClient()),
+      task_sink_(settings_.task_scheduler) {}
 
 bool VolatileLayerClientImpl::CancelPendingRequests() {
   OLP_SDK_LOG_TRACE(kLogTag, "CancelPendingRequests");
@@ -108,6 +113,27 @@ VolatileLayerClientImpl::GetPartitions(PartitionsRequest request) {
   return olp::client::CancellableFuture<PartitionsResponse>(token, promise);
 }
 
+client::CancellationToken VolatileLayerClientImpl::GetCompactPartitions(
+    PartitionsRequest request, uint32_t fields,
+    CompactPartitionsResponseCallback callback) {
+  auto partitions_callback =
+      ToCompactPartitionsCallback(fields, std::move(callback));
+  return GetPartitions(std::move(request), std::move(partitions_callback));
+}
+
+client::CancellableFuture<CompactPartitionsResponse>
+VolatileLayerClientImpl::GetCompactPartitions(PartitionsRequest request,
+                                              uint32_t fields) {
+  auto promise = std::make_shared<std::promise<CompactPartitionsResponse>>();
+  auto cancel_token =
+      GetCompactPartitions(std::move(request), fields,
+                           [promise](CompactPartitionsResponse response) {
+                             promise->set_value(std::move(response));
+                           });
+  return client::CancellableFuture<CompactPartitionsResponse>(
+      std::move(cancel_token), std::move(promise));
+}
+
 client::CancellationToken VolatileLayerClientImpl::GetData(
     DataRequest request, DataResponseCallback callback) {
   auto catalog = catalog_;
@@ -159,7 +185,8 @@ bool VolatileLayerClientImpl::RemoveFromCache(const geo::TileKey& tile) {
 }
 
 client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
-    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback) {
+    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+    PrefetchTileResultCallback tile_callback) {
   using client::ApiError;
   using client::ErrorCode;
 
@@ -172,8 +199,8 @@ client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
           return;
         }
 
-        const auto& tile_keys = request.GetTileKeys();
-        if (tile_keys.empty()) {
+        if (request.GetTileKeys().empty() &&
+            PrefetchTilesArea(request).IsEmpty()) {
           OLP_SDK_LOG_WARNING_F(kLogTag,
                                 "PrefetchTiles : invalid request, layer=%s",
                                 layer_id_.c_str());
@@ -200,7 +227,7 @@ client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
         repository::PrefetchTilesRepository repository(
             catalog_, layer_id_, settings_, lookup_client_);
         auto sliced_tiles =
-            repository.GetSlicedTiles(tile_keys, min_level, max_level);
+            repository.GetSlicedTiles(request, min_level, max_level);
 
         if (sliced_tiles.empty()) {
           OLP_SDK_LOG_WARNING_F(kLogTag,
@@ -211,6 +238,30 @@ client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
           return;
         }
 
+        std::shared_ptr<repository::PrefetchCheckpointRepository> checkpoint;
+        if (request.GetResumeId()) {
+          checkpoint =
+              std::make_shared<repository::PrefetchCheckpointRepository>(
+                  catalog_, layer_id_, *request.GetResumeId(), boost::none,
+                  settings_.cache);
+
+          // Skip the quad trees downloaded by the interrupted prefetch.
+          for (const auto& root : checkpoint->Load()) {
+            sliced_tiles.erase(root);
+          }
+
+          if (sliced_tiles.empty()) {
+            OLP_SDK_LOG_DEBUG_F(kLogTag,
+                                "PrefetchTiles: already completed, key=%s",
+                                key.c_str());
+            checkpoint->Clear();
+            callback(PrefetchTilesResult());
+            return;
+          }
+
+          checkpoint->SetRootsLeft(sliced_tiles.size());
+        }
+
         OLP_SDK_LOG_DEBUG_F(kLogTag, "PrefetchTiles, subquads=%zu, key=%s",
                             sliced_tiles.size(), key.c_str());
 
@@ -235,9 +286,8 @@ client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
             return BlobApi::DataResponse(
                 client::ApiError(client::ErrorCode::NotFound, "Not found"));
           }
-          repository::DataCacheRepository data_cache_repository(
-              catalog_, settings_.cache);
-          if (data_cache_repository.IsCached(layer_id_, data_handle)) {
+          // The filter checked the cache for all of the tiles at once.
+          if (repository.IsDataCached(data_handle)) {
             return BlobApi::DataResponse(nullptr);
           }
 
@@ -260,21 +310,53 @@ client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
               return root.first;
             });
 
-        auto append_result = [](ExtendedDataResponse response,
-                                geo::TileKey item,
-                                PrefetchTilesResult& prefetch_result) {
-          if (response.IsSuccessful()) {
-            prefetch_result.push_back(std::make_shared<PrefetchTileResult>(
-                item, PrefetchTileNoError()));
+        // The streamed results are not kept until the prefetch completes.
+        auto append_result = [=](ExtendedDataResponse response,
+                                 geo::TileKey item,
+                                 PrefetchTilesResult& prefetch_result) {
+          auto result = response.IsSuccessful()
+                            ? PrefetchTileResult(item, PrefetchTileNoError())
+                            : PrefetchTileResult(item, response.GetError());
+          if (tile_callback) {
+            tile_callback(result);
           } else {
-            prefetch_result.push_back(std::make_shared<PrefetchTileResult>(
-                item, response.GetError()));
+            prefetch_result.push_back(
+                std::make_shared<PrefetchTileResult>(std::move(result)));
           }
         };
 
         auto download_job = std::make_shared<PrefetchTilesHelper::DownloadJob>(
             std::move(download), std::move(append_result), std::move(callback),
             nullptr);
+
+        // The pipeline tracks the tiles of each quad tree, which the resumable
+        // prefetch needs.
+        if (request.GetFocusPoint() || request.GetMaxInFlightDownloads() > 0 ||
+            request.GetAdaptiveDownloads() || checkpoint ||
+            settings_.memory_budget) {
+          PrefetchTilesPipeline::Settings pipeline_settings;
+          pipeline_settings.focus_point = request.GetFocusPoint();
+          // Without a task scheduler the tasks run one by one on this thread,
+          // so there is nothing to limit.
+          pipeline_settings.max_in_flight_downloads =
+              settings_.task_scheduler ? request.GetMaxInFlightDownloads() : 0;
+          pipeline_settings.adaptive_downloads =
+              settings_.task_scheduler && request.GetAdaptiveDownloads();
+          pipeline_settings.filter_after_all_queries = request_only_input_tiles;
+          if (settings_.task_scheduler) {
+            pipeline_settings.memory_budget = settings_.memory_budget;
+          }
+          if (checkpoint) {
+            pipeline_settings.on_root_completed =
+                [=](const geo::TileKey& root) { checkpoint->Complete(root); };
+          }
+
+          return PrefetchTilesHelper::PrefetchPipelined(
+              std::move(download_job), std::move(roots), std::move(query),
+              std::move(filter), std::move(pipeline_settings), task_sink_,
+              request.GetPriority(), context);
+        }
+
         return PrefetchTilesHelper::Prefetch(
             std::move(download_job), std::move(roots), std::move(query),
             std::move(filter), task_sink_, request.GetPriority(), context);
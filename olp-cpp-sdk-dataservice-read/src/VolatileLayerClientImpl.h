@@ -29,6 +29,7 @@
 #include <olp/dataservice/read/PrefetchTilesRequest.h>
 #include <olp/dataservice/read/Types.h>
 
+#include "CatalogContext.h"
 #include "TaskSink.h"
 
 namespace olp {
@@ -49,6 +50,9 @@ class VolatileLayerClientImpl {
   VolatileLayerClientImpl(client::HRN catalog, std::string layer_id,
                           client::OlpClientSettings settings);
 
+  VolatileLayerClientImpl(std::shared_ptr<CatalogContext> context,
+                          std::string layer_id);
+
   virtual ~VolatileLayerClientImpl() = default;
 
   virtual bool CancelPendingRequests();
@@ -59,6 +63,13 @@ class VolatileLayerClientImpl {
   virtual client::CancellableFuture<PartitionsResponse> GetPartitions(
       PartitionsRequest request);
 
+  virtual client::CancellationToken GetCompactPartitions(
+      PartitionsRequest request, uint32_t fields,
+      CompactPartitionsResponseCallback callback);
+
+  virtual client::CancellableFuture<CompactPartitionsResponse>
+  GetCompactPartitions(PartitionsRequest request, uint32_t fields);
+
   virtual client::CancellationToken GetData(DataRequest request,
                                             DataResponseCallback callback);
 
@@ -69,12 +80,14 @@ class VolatileLayerClientImpl {
   virtual bool RemoveFromCache(const geo::TileKey& tile);
 
   virtual client::CancellationToken PrefetchTiles(
-      PrefetchTilesRequest request, PrefetchTilesResponseCallback callback);
+      PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+      PrefetchTileResultCallback tile_callback = nullptr);
 
   virtual client::CancellableFuture<PrefetchTilesResponse> PrefetchTiles(
       PrefetchTilesRequest request);
 
  private:
+  std::shared_ptr<CatalogContext> context_;
   client::HRN catalog_;
   std::string layer_id_;
   client::OlpClientSettings settings_;
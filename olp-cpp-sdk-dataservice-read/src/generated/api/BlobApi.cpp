@@ -22,6 +22,7 @@
 #include <map>
 #include <memory>
 #include <sstream>
+#include <utility>
 
 #include <olp/core/client/HttpResponse.h>
 #include <olp/core/client/OlpClient.h>
@@ -49,17 +50,46 @@ BlobApi::DataResponse BlobApi::GetBlob(
   }
 
   std::string metadata_uri = "/layers/" + layer_id + "/data/" + data_handle;
-  auto api_response = client.CallApi(metadata_uri, "GET", query_params,
-                                     header_params, {}, nullptr, "", context);
+  auto api_response =
+      client.CallApi(metadata_uri, "GET", query_params, header_params, {},
+                     nullptr, "", context, true);
 
   if (api_response.status != http::HttpStatusCode::OK) {
-    return {{api_response.status, api_response.response.str()},
+    std::string error;
+    api_response.GetResponse(error);
+    return {{api_response.status, std::move(error)},
             api_response.GetNetworkStatistics()};
   }
 
-  auto result = std::make_shared<std::vector<unsigned char>>();
-  api_response.GetResponse(*result);
-  return {result, api_response.GetNetworkStatistics()};
+  return {api_response.GetResponseBuffer(),
+          api_response.GetNetworkStatistics()};
+}
+
+BlobApi::StreamResponse BlobApi::StreamBlob(
+    const client::OlpClient& client, const std::string& layer_id,
+    const std::string& data_handle, boost::optional<std::string> billing_tag,
+    http::Network::DataCallback data_callback,
+    const client::CancellationContext& context) {
+  std::multimap<std::string, std::string> header_params;
+  header_params.emplace("Accept", "application/json");
+
+  std::multimap<std::string, std::string> query_params;
+  if (billing_tag) {
+    query_params.emplace("billingTag", *billing_tag);
+  }
+
+  std::string metadata_uri = "/layers/" + layer_id + "/data/" + data_handle;
+  auto api_response =
+      client.CallApi(metadata_uri, "GET", query_params, header_params, {},
+                     nullptr, "", context, std::move(data_callback));
+
+  if (api_response.status != http::HttpStatusCode::OK) {
+    // The error body is passed to the data callback as well.
+    return {{api_response.status, "Failed to stream the blob"},
+            api_response.GetNetworkStatistics()};
+  }
+
+  return {client::ApiNoResult{}, api_response.GetNetworkStatistics()};
 }
 }  // namespace read
 }  // namespace dataservice
@@ -22,8 +22,10 @@
 #include <string>
 
 #include <olp/core/client/ApiError.h>
+#include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/HttpResponse.h>
+#include <olp/core/http/Network.h>
 #include <boost/optional.hpp>
 #include "ExtendedApiResponse.h"
 #include "olp/dataservice/read/model/Data.h"
@@ -43,6 +45,9 @@ class BlobApi {
  public:
   using DataResponse = ExtendedApiResponse<model::Data, client::ApiError,
                                            client::NetworkStatistics>;
+  using StreamResponse =
+      ExtendedApiResponse<client::ApiNoResult, client::ApiError,
+                          client::NetworkStatistics>;
 
   /**
    * @brief Retrieves a data blob for specified handle.
@@ -70,6 +75,27 @@ class BlobApi {
                               boost::optional<std::string> billing_tag,
                               boost::optional<std::string> range,
                               const client::CancellationContext& context);
+
+  /**
+   * @brief Retrieves a data blob for specified handle in chunks.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id Layer id.
+   * @param data_handle Indentifies a specific blob.
+   * @param billing_tag An optional free-form tag which is used for grouping
+   * billing records together.
+   * @param data_callback Receives the chunks of the blob as they arrive. When
+   * the request is retried, the blob is passed again from offset 0.
+   * @param context A CancellationContext, which can be used to cancel the
+   * pending request.
+   *
+   * @return Stream response, the blob is not kept.
+   */
+  static StreamResponse StreamBlob(const client::OlpClient& client,
+                                   const std::string& layer_id,
+                                   const std::string& data_handle,
+                                   boost::optional<std::string> billing_tag,
+                                   http::Network::DataCallback data_callback,
+                                   const client::CancellationContext& context);
 };
 
 }  // namespace read
@@ -47,11 +47,12 @@ ConfigApi::CatalogResponse ConfigApi::GetCatalog(
 
   client::HttpResponse response = client.CallApi(
       std::move(catalog_uri), "GET", std::move(query_params),
-      std::move(header_params), {}, nullptr, std::string{}, std::move(context));
+      std::move(header_params), {}, nullptr, std::string{}, std::move(context),
+      true);
   if (response.status != olp::http::HttpStatusCode::OK) {
     return client::ApiError(response.status, response.response.str());
   }
-  return parser::parse_result<ConfigApi::CatalogResponse>(response.response);
+  return parser::parse_result<ConfigApi::CatalogResponse>(response);
 }
 
 }  // namespace read
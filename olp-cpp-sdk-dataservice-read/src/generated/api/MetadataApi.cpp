@@ -20,11 +20,13 @@
 #include "MetadataApi.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <map>
 #include <sstream>
 
 #include <olp/core/client/HttpResponse.h>
 #include <olp/core/client/OlpClient.h>
+#include <olp/core/http/NetworkUtils.h>
 
 // clang-format off
 #include "generated/parser/LayerVersionsParser.h"
@@ -49,6 +51,24 @@ std::string concatStringArray(const std::vector<std::string>& strings,
   return buffer.str();
 }
 
+/// Returns the total size from the `Content-Range` header, or 0 if the header
+/// is missing or the size is unknown.
+uint64_t GetTotalSize(const olp::http::Headers& headers) {
+  for (const auto& header : headers) {
+    if (!olp::http::NetworkUtils::CaseInsensitiveCompare(header.first,
+                                                         "Content-Range")) {
+      continue;
+    }
+
+    const auto slash = header.second.find('/');
+    if (slash == std::string::npos) {
+      return 0u;
+    }
+    return std::strtoull(header.second.c_str() + slash + 1, nullptr, 10);
+  }
+  return 0u;
+}
+
 }  // namespace
 
 namespace olp {
@@ -70,14 +90,15 @@ MetadataApi::LayerVersionsResponse MetadataApi::GetLayerVersions(
 
   std::string metadataUri = "/layerVersions";
 
-  auto api_response = client.CallApi(metadataUri, "GET", query_params,
-                                     header_params, {}, nullptr, "", context);
+  auto api_response =
+      client.CallApi(metadataUri, "GET", query_params, header_params, {},
+                     nullptr, "", context, true);
 
   if (api_response.status != http::HttpStatusCode::OK) {
     return client::ApiError(api_response.status, api_response.response.str());
   }
 
-  return parser::parse_result<LayerVersionsResponse>(api_response.response);
+  return parser::parse_result<LayerVersionsResponse>(api_response);
 }
 
 MetadataApi::PartitionsExtendedResponse MetadataApi::GetPartitions(
@@ -107,9 +128,110 @@ MetadataApi::PartitionsExtendedResponse MetadataApi::GetPartitions(
 
   std::string metadataUri = "/layers/" + layer_id + "/partitions";
 
+  auto http_response =
+      client.CallApi(metadataUri, "GET", query_params, header_params, {},
+                     nullptr, "", context, true);
+
+  if (http_response.status != olp::http::HttpStatusCode::OK) {
+    return {{http_response.status, http_response.response.str()},
+            http_response.GetNetworkStatistics()};
+  }
+
+  using PartitionsResponse =
+      client::ApiResponse<model::Partitions, client::ApiError>;
+
+  auto partitions_response =
+      parser::parse_result<PartitionsResponse>(http_response);
+
+  if (!partitions_response.IsSuccessful()) {
+    return {{partitions_response.GetError()},
+            http_response.GetNetworkStatistics()};
+  }
+
+  return {partitions_response.MoveResult(),
+          http_response.GetNetworkStatistics()};
+}
+
+MetadataApi::PartitionsPageResponse MetadataApi::GetPartitionsPage(
+    const client::OlpClient& client, const std::string& layer_id,
+    boost::optional<std::int64_t> version,
+    const std::vector<std::string>& additional_fields, std::uint64_t offset,
+    std::uint64_t size, boost::optional<std::string> billing_tag,
+    const client::CancellationContext& context) {
+  std::multimap<std::string, std::string> header_params;
+  header_params.emplace("Accept", "application/json");
+  header_params.emplace("Range", "bytes=" + std::to_string(offset) + "-" +
+                                     std::to_string(offset + size - 1u));
+
+  std::multimap<std::string, std::string> query_params;
+  if (!additional_fields.empty()) {
+    query_params.emplace("additionalFields",
+                         concatStringArray(additional_fields, ","));
+  }
+  if (billing_tag) {
+    query_params.emplace("billingTag", *billing_tag);
+  }
+  if (version) {
+    query_params.emplace("version", std::to_string(*version));
+  }
+
+  std::string metadataUri = "/layers/" + layer_id + "/partitions";
+
   auto http_response = client.CallApi(metadataUri, "GET", query_params,
                                       header_params, {}, nullptr, "", context);
 
+  PartitionsPage page;
+  if (http_response.status == http::HttpStatusCode::OK) {
+    // The server ignored the range and sent the whole list.
+    http_response.GetResponse(page.data);
+    page.total_size = page.data.size();
+    if (offset > 0u) {
+      page.data.erase(0, std::min<size_t>(offset, page.data.size()));
+    }
+    return page;
+  }
+
+  if (http_response.status == http::HttpStatusCode::PARTIAL_CONTENT) {
+    http_response.GetResponse(page.data);
+    page.total_size = GetTotalSize(http_response.GetHeaders());
+    return page;
+  }
+
+  if (http_response.status ==
+      http::HttpStatusCode::REQUESTED_RANGE_NOT_SATISFIABLE) {
+    page.total_size = offset;
+    return page;
+  }
+
+  return client::ApiError(http_response.status, http_response.response.str());
+}
+
+MetadataApi::PartitionsExtendedResponse MetadataApi::GetPartitionChanges(
+    const client::OlpClient& client, const std::string& layer_id,
+    std::int64_t start_version, std::int64_t end_version,
+    const std::vector<std::string>& additional_fields,
+    boost::optional<std::string> billing_tag,
+    const client::CancellationContext& context) {
+  std::multimap<std::string, std::string> header_params;
+  header_params.emplace("Accept", "application/json");
+
+  std::multimap<std::string, std::string> query_params;
+  if (!additional_fields.empty()) {
+    query_params.emplace("additionalFields",
+                         concatStringArray(additional_fields, ","));
+  }
+  if (billing_tag) {
+    query_params.emplace("billingTag", *billing_tag);
+  }
+  query_params.emplace("startVersion", std::to_string(start_version));
+  query_params.emplace("endVersion", std::to_string(end_version));
+
+  std::string metadataUri = "/layers/" + layer_id + "/changes";
+
+  auto http_response =
+      client.CallApi(metadataUri, "GET", query_params, header_params, {},
+                     nullptr, "", context, true);
+
   if (http_response.status != olp::http::HttpStatusCode::OK) {
     return {{http_response.status, http_response.response.str()},
             http_response.GetNetworkStatistics()};
@@ -119,7 +241,7 @@ MetadataApi::PartitionsExtendedResponse MetadataApi::GetPartitions(
       client::ApiResponse<model::Partitions, client::ApiError>;
 
   auto partitions_response =
-      parser::parse_result<PartitionsResponse>(http_response.response);
+      parser::parse_result<PartitionsResponse>(http_response);
 
   if (!partitions_response.IsSuccessful()) {
     return {{partitions_response.GetError()},
@@ -145,14 +267,15 @@ MetadataApi::CatalogVersionResponse MetadataApi::GetLatestCatalogVersion(
 
   std::string metadata_uri = "/versions/latest";
 
-  auto api_response = client.CallApi(metadata_uri, "GET", query_params,
-                                     header_params, {}, nullptr, "", context);
+  auto api_response =
+      client.CallApi(metadata_uri, "GET", query_params, header_params, {},
+                     nullptr, "", context, true);
 
   if (api_response.status != http::HttpStatusCode::OK) {
     return {{api_response.status, api_response.response.str()}};
   }
 
-  return parser::parse_result<CatalogVersionResponse>(api_response.response);
+  return parser::parse_result<CatalogVersionResponse>(api_response);
 }
 
 MetadataApi::VersionsResponse MetadataApi::ListVersions(
@@ -171,13 +294,14 @@ MetadataApi::VersionsResponse MetadataApi::ListVersions(
 
   std::string metadata_uri = "/versions";
 
-  auto api_response = client.CallApi(metadata_uri, "GET", query_params,
-                                     header_params, {}, nullptr, "", context);
+  auto api_response =
+      client.CallApi(metadata_uri, "GET", query_params, header_params, {},
+                     nullptr, "", context, true);
 
   if (api_response.status != http::HttpStatusCode::OK) {
     return {{api_response.status, api_response.response.str()}};
   }
-  return parser::parse_result<VersionsResponse>(api_response.response);
+  return parser::parse_result<VersionsResponse>(api_response);
 }
 
 }  // namespace read
@@ -57,6 +57,17 @@ class MetadataApi {
       ExtendedApiResponse<model::Partitions, client::ApiError,
                           client::NetworkStatistics>;
 
+  /// A byte range of the partitions list.
+  struct PartitionsPage {
+    /// The received part of the body.
+    std::string data;
+    /// The size of the whole body, or 0 if it is unknown.
+    uint64_t total_size{0u};
+  };
+
+  using PartitionsPageResponse =
+      client::ApiResponse<PartitionsPage, client::ApiError>;
+
   /**
    * @brief Retrieves the latest metadata version for each layer of a specified
    * catalog metadata version.
@@ -105,6 +116,61 @@ class MetadataApi {
       boost::optional<std::string> billing_tag,
       const client::CancellationContext& context);
 
+  /**
+   * @brief Retrieves a byte range of the partitions list of a layer.
+   *
+   * The list is returned as is, without parsing, so that large lists can be
+   * downloaded and parsed in parts.
+   *
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id Layer id.
+   * @param version Specify the version for a versioned layer.
+   * @param additional_fields Additional fields - dataSize, checksum,
+   * compressedDataSize.
+   * @param offset The first byte of the range.
+   * @param size The number of bytes to request.
+   * @param billing_tag An optional free-form tag which is used for grouping
+   * billing records together. If supplied, it must be between 4 - 16
+   * characters, contain only alpha/numeric ASCII characters  [A-Za-z0-9].
+   * @param context A CancellationContext, which can be used to cancel request.
+   *
+   * @return The received bytes, which are empty if the offset is past the end
+   * of the list, or an error.
+   */
+  static PartitionsPageResponse GetPartitionsPage(
+      const client::OlpClient& client, const std::string& layer_id,
+      boost::optional<int64_t> version,
+      const std::vector<std::string>& additional_fields, uint64_t offset,
+      uint64_t size, boost::optional<std::string> billing_tag,
+      const client::CancellationContext& context);
+
+  /**
+   * @brief Retrieves metadata for the partitions of a versioned layer that
+   * changed between two catalog versions.
+   *
+   * The partitions removed within the range have an empty data handle.
+   *
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id Layer id.
+   * @param start_version The beginning of the version range (exclusive).
+   * @param end_version The end of the version range (inclusive).
+   * @param additional_fields Additional fields - dataSize, checksum,
+   * compressedDataSize.
+   * @param billing_tag An optional free-form tag which is used for grouping
+   * billing records together. If supplied, it must be between 4 - 16
+   * characters, contain only alpha/numeric ASCII characters  [A-Za-z0-9].
+   * @param context A CancellationContext, which can be used to cancel request.
+   *
+   * @return  The result of this operation as an extended client::ApiResponse
+   * object with \c model::Partitions as a result.
+   */
+  static PartitionsExtendedResponse GetPartitionChanges(
+      const client::OlpClient& client, const std::string& layer_id,
+      int64_t start_version, int64_t end_version,
+      const std::vector<std::string>& additional_fields,
+      boost::optional<std::string> billing_tag,
+      const client::CancellationContext& context);
+
   /**
    * @brief Retrieves the latest metadata version for the catalog.
    * @param client Instance of OlpClient used to make REST request.
@@ -88,7 +88,7 @@ QueryApi::PartitionsExtendedResponse QueryApi::GetPartitionsbyId(
 
   client::HttpResponse http_response = client.CallApi(
       metadata_uri, "GET", std::move(query_params), std::move(header_params),
-      {}, nullptr, std::string{}, std::move(context));
+      {}, nullptr, std::string{}, std::move(context), true);
 
   OLP_SDK_LOG_TRACE_F(kLogTag, "GetPartitionsbyId, layer_id=%s, status=%d",
                       layer_id.c_str(), http_response.status);
@@ -101,7 +101,7 @@ QueryApi::PartitionsExtendedResponse QueryApi::GetPartitionsbyId(
       client::ApiResponse<model::Partitions, client::ApiError>;
 
   auto partitions_response =
-      parser::parse_result<PartitionsResponse>(http_response.response);
+      parser::parse_result<PartitionsResponse>(http_response);
 
   if (!partitions_response.IsSuccessful()) {
     return {{partitions_response.GetError()},
@@ -137,7 +137,7 @@ olp::client::HttpResponse QueryApi::QuadTreeIndex(
 
   return client.CallApi(metadata_uri, "GET", std::move(query_params),
                         std::move(header_params), {}, nullptr, std::string{},
-                        std::move(context));
+                        std::move(context), true);
 }
 
 QueryApi::QuadTreeIndexResponse QueryApi::QuadTreeIndexVolatile(
@@ -163,7 +163,7 @@ QueryApi::QuadTreeIndexResponse QueryApi::QuadTreeIndexVolatile(
 
   client::HttpResponse response = client.CallApi(
       metadata_uri, "GET", std::move(query_params), std::move(header_params),
-      {}, nullptr, std::string{}, std::move(context));
+      {}, nullptr, std::string{}, std::move(context), true);
 
   OLP_SDK_LOG_DEBUG_F(kLogTag, "QuadTreeIndex, uri=%s, status=%d",
                       metadata_uri.c_str(), response.status);
@@ -171,7 +171,7 @@ QueryApi::QuadTreeIndexResponse QueryApi::QuadTreeIndexVolatile(
     return client::ApiError(response.status, response.response.str());
   }
 
-  return parser::parse_result<QuadTreeIndexResponse>(response.response);
+  return parser::parse_result<QuadTreeIndexResponse>(response);
 }
 
 }  // namespace read
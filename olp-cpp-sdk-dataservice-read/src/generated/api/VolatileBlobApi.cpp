@@ -25,6 +25,22 @@
 
 #include <olp/core/client/HttpResponse.h>
 #include <olp/core/client/OlpClient.h>
+#include <olp/core/http/NetworkUtils.h>
+
+namespace {
+constexpr auto kETagHeader = "ETag";
+constexpr auto kIfNoneMatchHeader = "If-None-Match";
+
+std::string GetETag(const olp::http::Headers& headers) {
+  for (const auto& header : headers) {
+    if (olp::http::NetworkUtils::CaseInsensitiveCompare(header.first,
+                                                        kETagHeader)) {
+      return header.second;
+    }
+  }
+  return {};
+}
+}  // namespace
 
 namespace olp {
 namespace dataservice {
@@ -46,16 +62,60 @@ VolatileBlobApi::DataResponse VolatileBlobApi::GetVolatileBlob(
   std::string metadata_uri = "/layers/" + layer_id + "/data/" + data_handle;
   auto api_response =
       client.CallApi(metadata_uri, "GET", query_params, header_params,
-                     form_params, nullptr, "", context);
+                     form_params, nullptr, "", context, true);
+
+  if (api_response.status != http::HttpStatusCode::OK) {
+    std::string error;
+    api_response.GetResponse(error);
+    return {{api_response.status, std::move(error)},
+            api_response.GetNetworkStatistics()};
+  }
+
+  return {api_response.GetResponseBuffer(),
+          api_response.GetNetworkStatistics()};
+}
+
+VolatileBlobApi::VolatileBlobResponse VolatileBlobApi::GetVolatileBlob(
+    const client::OlpClient& client, const std::string& layer_id,
+    const std::string& data_handle, boost::optional<std::string> billing_tag,
+    const boost::optional<std::string>& if_none_match,
+    const client::CancellationContext& context) {
+  std::multimap<std::string, std::string> header_params;
+  header_params.insert(std::make_pair("Accept", "application/json"));
+  if (if_none_match) {
+    header_params.insert(std::make_pair(kIfNoneMatchHeader, *if_none_match));
+  }
+  std::multimap<std::string, std::string> query_params;
+  if (billing_tag) {
+    query_params.insert(std::make_pair("billingTag", *billing_tag));
+  }
+
+  std::multimap<std::string, std::string> form_params;
+  std::string metadata_uri = "/layers/" + layer_id + "/data/" + data_handle;
+  auto api_response =
+      client.CallApi(metadata_uri, "GET", query_params, header_params,
+                     form_params, nullptr, "", context, true);
+
+  VolatileBlob blob;
+  blob.etag = GetETag(api_response.GetHeaders());
+  if (if_none_match &&
+      api_response.status == http::HttpStatusCode::NOT_MODIFIED) {
+    blob.not_modified = true;
+    if (blob.etag.empty()) {
+      blob.etag = *if_none_match;
+    }
+    return {std::move(blob), api_response.GetNetworkStatistics()};
+  }
 
   if (api_response.status != http::HttpStatusCode::OK) {
-    return {{api_response.status, api_response.response.str()},
+    std::string error;
+    api_response.GetResponse(error);
+    return {{api_response.status, std::move(error)},
             api_response.GetNetworkStatistics()};
   }
 
-  auto result = std::make_shared<std::vector<unsigned char>>();
-  api_response.GetResponse(*result);
-  return {result, api_response.GetNetworkStatistics()};
+  blob.data = api_response.GetResponseBuffer();
+  return {std::move(blob), api_response.GetNetworkStatistics()};
 }
 }  // namespace read
 }  // namespace dataservice
@@ -60,6 +60,39 @@ class VolatileBlobApi {
       const client::OlpClient& client, const std::string& layer_id,
       const std::string& data_handle, boost::optional<std::string> billing_tag,
       const client::CancellationContext& context);
+
+  /// The volatile blob and its validator.
+  struct VolatileBlob {
+    /// The data of the blob, not set if the blob is not modified.
+    model::Data data;
+    /// The `ETag` of the blob, empty if the service does not return it.
+    std::string etag;
+    /// Set if the blob still matches the `ETag` sent with the request.
+    bool not_modified{false};
+  };
+
+  using VolatileBlobResponse =
+      ExtendedApiResponse<VolatileBlob, client::ApiError,
+                          client::NetworkStatistics>;
+
+  /**
+   * @brief Retrieves a volatile data blob for specified handle, unless it still
+   * matches the `ETag` of the cached blob.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id Layer id.
+   * @param data_handle Identifies a specific blob.
+   * @param billing_tag An optional free-form tag which is used for grouping
+   * billing records together.
+   * @param if_none_match The `ETag` of the cached blob, if any.
+   * @param context A CancellationContext, which can be used to cancel request.
+   *
+   * @return The blob with its `ETag`, or the not modified blob.
+   */
+  static VolatileBlobResponse GetVolatileBlob(
+      const client::OlpClient& client, const std::string& layer_id,
+      const std::string& data_handle, boost::optional<std::string> billing_tag,
+      const boost::optional<std::string>& if_none_match,
+      const client::CancellationContext& context);
 };
 
 }  // namespace read
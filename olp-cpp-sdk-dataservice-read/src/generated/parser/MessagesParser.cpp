@@ -19,15 +19,211 @@
 
 #include "MessagesParser.h"
 
+#include <limits>
+#include <memory>
+#include <utility>
+
 // clang-format off
+#include "generated/parser/SaxHandler.h"
 #include "generated/parser/StreamOffsetParser.h"
 #include <olp/core/generated/parser/ParserWrapper.h>
+#include <rapidjson/reader.h>
 // clang-format on
 
 namespace olp {
 namespace parser {
 using namespace olp::dataservice::read;
 
+namespace {
+
+class MessagesHandler : public SaxHandler<MessagesHandler> {
+ public:
+  explicit MessagesHandler(std::vector<model::Message>& messages)
+      : messages_(messages) {}
+
+  bool StartObject() {
+    const int depth = depth_++;
+    if (depth == kArrayDepth && in_messages_) {
+      messages_.emplace_back();
+      item_ = &messages_.back();
+      next_object_ = Object::kNone;
+    } else if (depth == kItemDepth && item_ != nullptr) {
+      object_ = next_object_;
+      field_ = Field::kNone;
+    }
+    return true;
+  }
+
+  bool EndObject(rapidjson::SizeType) {
+    const int depth = --depth_;
+    if (depth == kItemDepth && object_ != Object::kNone) {
+      if (object_ == Object::kMetaData) {
+        item_->SetMetaData(std::move(meta_data_));
+        meta_data_ = model::Metadata();
+      } else {
+        item_->SetOffset(offset_);
+        offset_ = model::StreamOffset();
+      }
+      object_ = Object::kNone;
+    } else if (depth == kArrayDepth) {
+      item_ = nullptr;
+    }
+    return true;
+  }
+
+  bool StartArray() {
+    if (depth_++ == kRootDepth) {
+      in_messages_ = next_is_messages_;
+    }
+    return true;
+  }
+
+  bool EndArray(rapidjson::SizeType) {
+    if (--depth_ == kRootDepth) {
+      in_messages_ = false;
+    }
+    return true;
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    if (depth_ == kRootDepth) {
+      next_is_messages_ = IsKey("messages", str, length);
+    } else if (depth_ == kItemDepth && item_ != nullptr) {
+      next_object_ = IsKey("metaData", str, length)
+                         ? Object::kMetaData
+                         : IsKey("offset", str, length) ? Object::kOffset
+                                                        : Object::kNone;
+    } else if (IsObjectField()) {
+      field_ = ToField(str, length);
+    }
+    return true;
+  }
+
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    if (!IsObjectField() || object_ != Object::kMetaData) {
+      return IsDocument();
+    }
+
+    switch (field_) {
+      case Field::kPartition:
+        meta_data_.SetPartition(std::string(str, length));
+        break;
+      case Field::kChecksum:
+        meta_data_.SetChecksum(std::string(str, length));
+        break;
+      case Field::kData:
+        meta_data_.SetData(
+            std::make_shared<std::vector<unsigned char>>(str, str + length));
+        break;
+      case Field::kDataHandle:
+        meta_data_.SetDataHandle(std::string(str, length));
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  bool Int(int value) { return Int64(value); }
+  bool Uint(unsigned value) { return Int64(value); }
+
+  bool Int64(int64_t value) {
+    if (!IsObjectField()) {
+      return IsDocument();
+    }
+
+    if (object_ == Object::kOffset) {
+      if (field_ == Field::kOffset) {
+        offset_.SetOffset(value);
+      } else if (field_ == Field::kPartition &&
+                 value >= std::numeric_limits<int32_t>::min() &&
+                 value <= std::numeric_limits<int32_t>::max()) {
+        offset_.SetPartition(static_cast<int32_t>(value));
+      }
+      return true;
+    }
+
+    switch (field_) {
+      case Field::kCompressedDataSize:
+        meta_data_.SetCompressedDataSize(value);
+        break;
+      case Field::kDataSize:
+        meta_data_.SetDataSize(value);
+        break;
+      case Field::kTimestamp:
+        meta_data_.SetTimestamp(value);
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  bool Uint64(uint64_t value) {
+    if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+      return IsDocument();
+    }
+    return Int64(static_cast<int64_t>(value));
+  }
+
+ private:
+  static constexpr int kRootDepth = 1;
+  static constexpr int kArrayDepth = 2;
+  static constexpr int kItemDepth = 3;
+  static constexpr int kObjectDepth = 4;
+
+  enum class Object { kNone, kMetaData, kOffset };
+
+  enum class Field {
+    kNone,
+    kChecksum,
+    kCompressedDataSize,
+    kData,
+    kDataHandle,
+    kDataSize,
+    kOffset,
+    kPartition,
+    kTimestamp
+  };
+
+  static Field ToField(const char* str, rapidjson::SizeType length) {
+    if (IsKey("checksum", str, length)) {
+      return Field::kChecksum;
+    } else if (IsKey("compressedDataSize", str, length)) {
+      return Field::kCompressedDataSize;
+    } else if (IsKey("data", str, length)) {
+      return Field::kData;
+    } else if (IsKey("dataHandle", str, length)) {
+      return Field::kDataHandle;
+    } else if (IsKey("dataSize", str, length)) {
+      return Field::kDataSize;
+    } else if (IsKey("offset", str, length)) {
+      return Field::kOffset;
+    } else if (IsKey("partition", str, length)) {
+      return Field::kPartition;
+    } else if (IsKey("timestamp", str, length)) {
+      return Field::kTimestamp;
+    }
+    return Field::kNone;
+  }
+
+  bool IsObjectField() const {
+    return object_ != Object::kNone && depth_ == kObjectDepth;
+  }
+
+  std::vector<model::Message>& messages_;
+  model::Message* item_ = nullptr;
+  model::Metadata meta_data_;
+  model::StreamOffset offset_;
+  Object next_object_ = Object::kNone;
+  Object object_ = Object::kNone;
+  Field field_ = Field::kNone;
+  bool next_is_messages_ = false;
+  bool in_messages_ = false;
+};
+
+}  // namespace
+
 void from_json(const rapidjson::Value& value, model::Metadata& x) {
   x.SetPartition(parse<std::string>(value, "partition"));
   x.SetChecksum(parse<boost::optional<std::string>>(value, "checksum"));
@@ -48,5 +244,17 @@ void from_json(const rapidjson::Value& value, model::Messages& x) {
   x.SetMessages(parse<std::vector<model::Message>>(value, "messages"));
 }
 
+template <>
+model::Messages parse<model::Messages>(std::stringstream& json_stream,
+                                       bool& res) {
+  model::Messages result;
+  MessagesHandler handler(result.GetMutableMessages());
+  res = parse_sax(json_stream, handler);
+  if (!res) {
+    return model::Messages{};
+  }
+  return result;
+}
+
 }  // namespace parser
 }  // namespace olp
@@ -19,7 +19,10 @@
 
 #pragma once
 
+#include <sstream>
+
 #include <rapidjson/document.h>
+#include <olp/core/generated/parser/JsonParser.h>
 #include <olp/dataservice/read/model/Messages.h>
 
 namespace olp {
@@ -34,5 +37,16 @@ void from_json(const rapidjson::Value& value,
 void from_json(const rapidjson::Value& value,
                olp::dataservice::read::model::Messages& x);
 
+/**
+ * @brief Parses the messages response with the SAX reader.
+ *
+ * The messages are filled while reading, so the response is never held as
+ * a DOM. Include this header before parsing the messages from a stream.
+ */
+template <>
+olp::dataservice::read::model::Messages
+parse<olp::dataservice::read::model::Messages>(std::stringstream& json_stream,
+                                               bool& res);
+
 }  // namespace parser
 }  // namespace olp
@@ -19,12 +19,163 @@
 
 #include "PartitionsParser.h"
 
+#include <limits>
+
 #include <olp/core/generated/parser/ParserWrapper.h>
+#include <rapidjson/reader.h>
+#include "generated/parser/SaxHandler.h"
 
 namespace olp {
 namespace parser {
 using namespace olp::dataservice::read;
 
+namespace {
+
+class PartitionsHandler : public SaxHandler<PartitionsHandler> {
+ public:
+  explicit PartitionsHandler(std::vector<model::Partition>& partitions)
+      : partitions_(partitions) {}
+
+  bool StartObject() {
+    if (depth_++ == kArrayDepth && in_partitions_) {
+      partitions_.emplace_back();
+      item_ = &partitions_.back();
+      field_ = Field::kNone;
+    }
+    return true;
+  }
+
+  bool EndObject(rapidjson::SizeType) {
+    if (--depth_ == kArrayDepth) {
+      item_ = nullptr;
+    }
+    return true;
+  }
+
+  bool StartArray() {
+    if (depth_++ == kRootDepth) {
+      in_partitions_ = next_is_partitions_;
+    }
+    return true;
+  }
+
+  bool EndArray(rapidjson::SizeType) {
+    if (--depth_ == kRootDepth) {
+      in_partitions_ = false;
+    }
+    return true;
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    if (depth_ == kRootDepth) {
+      next_is_partitions_ = IsKey("partitions", str, length);
+    } else if (IsItemField()) {
+      field_ = ToField(str, length);
+    }
+    return true;
+  }
+
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    if (!IsItemField()) {
+      return IsDocument();
+    }
+
+    switch (field_) {
+      case Field::kChecksum:
+        item_->GetMutableChecksum() = std::string(str, length);
+        break;
+      case Field::kCrc:
+        item_->GetMutableCrc() = std::string(str, length);
+        break;
+      case Field::kDataHandle:
+        item_->GetMutableDataHandle().assign(str, length);
+        break;
+      case Field::kPartition:
+        item_->GetMutablePartition().assign(str, length);
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  bool Int(int value) { return Int64(value); }
+  bool Uint(unsigned value) { return Int64(value); }
+
+  bool Int64(int64_t value) {
+    if (!IsItemField()) {
+      return IsDocument();
+    }
+
+    switch (field_) {
+      case Field::kCompressedDataSize:
+        item_->GetMutableCompressedDataSize() = value;
+        break;
+      case Field::kDataSize:
+        item_->GetMutableDataSize() = value;
+        break;
+      case Field::kVersion:
+        item_->GetMutableVersion() = value;
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  bool Uint64(uint64_t value) {
+    if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+      return IsDocument();
+    }
+    return Int64(static_cast<int64_t>(value));
+  }
+
+ private:
+  static constexpr int kRootDepth = 1;
+  static constexpr int kArrayDepth = 2;
+  static constexpr int kItemDepth = 3;
+
+  enum class Field {
+    kNone,
+    kChecksum,
+    kCompressedDataSize,
+    kCrc,
+    kDataHandle,
+    kDataSize,
+    kPartition,
+    kVersion
+  };
+
+  static Field ToField(const char* str, rapidjson::SizeType length) {
+    if (IsKey("checksum", str, length)) {
+      return Field::kChecksum;
+    } else if (IsKey("compressedDataSize", str, length)) {
+      return Field::kCompressedDataSize;
+    } else if (IsKey("crc", str, length)) {
+      return Field::kCrc;
+    } else if (IsKey("dataHandle", str, length)) {
+      return Field::kDataHandle;
+    } else if (IsKey("dataSize", str, length)) {
+      return Field::kDataSize;
+    } else if (IsKey("partition", str, length)) {
+      return Field::kPartition;
+    } else if (IsKey("version", str, length)) {
+      return Field::kVersion;
+    }
+    return Field::kNone;
+  }
+
+  bool IsItemField() const { return item_ != nullptr && depth_ == kItemDepth; }
+
+  std::vector<model::Partition>& partitions_;
+  model::Partition* item_ = nullptr;
+  Field field_ = Field::kNone;
+  bool next_is_partitions_ = false;
+  bool in_partitions_ = false;
+};
+
+}  // namespace
+
 void from_json(const rapidjson::Value& value, model::Partition& x) {
   x.SetChecksum(parse<boost::optional<std::string>>(value, "checksum"));
   x.SetCompressedDataSize(
@@ -40,6 +191,31 @@ void from_json(const rapidjson::Value& value, model::Partitions& x) {
   x.SetPartitions(parse<std::vector<model::Partition>>(value, "partitions"));
 }
 
+namespace {
+template <typename Input>
+model::Partitions ParsePartitions(Input& json, bool& res) {
+  model::Partitions result;
+  PartitionsHandler handler(result.GetMutablePartitions());
+  res = parse_sax(json, handler);
+  if (!res) {
+    return model::Partitions{};
+  }
+  return result;
+}
+}  // namespace
+
+template <>
+model::Partitions parse<model::Partitions>(std::stringstream& json_stream,
+                                           bool& res) {
+  return ParsePartitions(json_stream, res);
+}
+
+template <>
+model::Partitions parse<model::Partitions>(
+    const std::vector<unsigned char>& json, bool& res) {
+  return ParsePartitions(json, res);
+}
+
 }  // namespace parser
 
 }  // namespace olp
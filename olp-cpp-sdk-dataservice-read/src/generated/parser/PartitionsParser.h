@@ -20,9 +20,12 @@
 #pragma once
 
 #include <rapidjson/document.h>
+#include <olp/core/generated/parser/JsonParser.h>
 #include "olp/dataservice/read/model/Partitions.h"
 
+#include <sstream>
 #include <string>
+#include <vector>
 
 namespace olp {
 namespace parser {
@@ -32,5 +35,25 @@ void from_json(const rapidjson::Value& value,
 void from_json(const rapidjson::Value& value,
                olp::dataservice::read::model::Partitions& x);
 
+/**
+ * @brief Parses the partitions response with the SAX reader.
+ *
+ * The partitions are filled while reading, so the response is never held as
+ * a DOM. Include this header before parsing the partitions from a stream.
+ */
+template <>
+olp::dataservice::read::model::Partitions
+parse<olp::dataservice::read::model::Partitions>(std::stringstream& json_stream,
+                                                 bool& res);
+
+/**
+ * @brief Parses the partitions response from a byte buffer with the SAX
+ * reader, the buffer is read in place.
+ */
+template <>
+olp::dataservice::read::model::Partitions
+parse<olp::dataservice::read::model::Partitions>(
+    const std::vector<unsigned char>& json, bool& res);
+
 }  // namespace parser
 }  // namespace olp
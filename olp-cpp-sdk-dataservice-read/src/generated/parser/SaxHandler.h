@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstring>
+
+#include <rapidjson/reader.h>
+
+namespace olp {
+namespace parser {
+
+/**
+ * @brief The base of the SAX handlers that read the responses.
+ *
+ * The handler updates `depth_` when it enters or leaves an object or array.
+ */
+template <typename Handler>
+class SaxHandler
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler> {
+ public:
+  /// Skips the values that the handler does not read.
+  bool Default() { return IsDocument(); }
+
+ protected:
+  static bool IsKey(const char* expected, const char* str,
+                    rapidjson::SizeType length) {
+    return std::strlen(expected) == length &&
+           std::memcmp(expected, str, length) == 0;
+  }
+
+  // A scalar at the top of the document is not a valid response, the other
+  // values are just skipped.
+  bool IsDocument() const { return depth_ > 0; }
+
+  int depth_ = 0;
+};
+
+}  // namespace parser
+}  // namespace olp
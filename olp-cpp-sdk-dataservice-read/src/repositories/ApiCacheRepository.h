@@ -24,6 +24,7 @@
 #include <olp/core/client/HRN.h>
 #include <boost/optional.hpp>
 #include <string>
+#include "CacheKeyBuilder.h"
 
 namespace olp {
 namespace cache {
@@ -47,7 +48,7 @@ class ApiCacheRepository final {
                                    const std::string& version);
 
  private:
-  client::HRN hrn_;
+  const CacheKeyBuilder catalog_keys_;
   std::shared_ptr<cache::KeyValueCache> cache_;
 };
 }  // namespace repository
@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "BinaryCacheFormat.h"
+
+#include <cstdint>
+#include <utility>
+
+// clang-format off
+#include "generated/parser/PartitionsParser.h"
+#include "generated/parser/LayerVersionsParser.h"
+#include "generated/parser/VersionResponseParser.h"
+#include "JsonResultParser.h"
+#include <olp/core/generated/parser/JsonParser.h>
+// clang-format on
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+namespace binary {
+
+namespace {
+// Neither a JSON value nor the whitespace before it starts with this byte.
+constexpr unsigned char kMarker = 0xb1;
+constexpr unsigned char kFormatVersion = 1;
+
+// The presence bits of the optional partition fields.
+enum PartitionFields : std::uint8_t {
+  kChecksum = 1 << 0,
+  kCompressedDataSize = 1 << 1,
+  kDataSize = 1 << 2,
+  kCrc = 1 << 3,
+  kVersion = 1 << 4,
+};
+
+class Writer {
+ public:
+  Writer() {
+    buffer_.push_back(static_cast<char>(kMarker));
+    buffer_.push_back(static_cast<char>(kFormatVersion));
+  }
+
+  void WriteByte(std::uint8_t value) {
+    buffer_.push_back(static_cast<char>(value));
+  }
+
+  void WriteUnsigned(std::uint64_t value) {
+    while (value >= 0x80u) {
+      WriteByte(static_cast<std::uint8_t>(value | 0x80u));
+      value >>= 7;
+    }
+    WriteByte(static_cast<std::uint8_t>(value));
+  }
+
+  void WriteSigned(std::int64_t value) {
+    // Zigzag encoding keeps the small negative values short.
+    const auto unsigned_value = static_cast<std::uint64_t>(value);
+    WriteUnsigned((unsigned_value << 1) ^
+                  static_cast<std::uint64_t>(value >> 63));
+  }
+
+  void WriteString(const std::string& value) {
+    WriteUnsigned(value.size());
+    buffer_.append(value);
+  }
+
+  std::string Finish() { return std::move(buffer_); }
+
+ private:
+  std::string buffer_;
+};
+
+class Reader {
+ public:
+  explicit Reader(const std::string& value)
+      : it_(value.data()), end_(value.data() + value.size()) {
+    // Skips the marker and the version checked by `IsBinary`.
+    it_ += 2;
+  }
+
+  bool ReadByte(std::uint8_t& value) {
+    if (it_ == end_) {
+      return false;
+    }
+    value = static_cast<std::uint8_t>(*it_++);
+    return true;
+  }
+
+  bool ReadUnsigned(std::uint64_t& value) {
+    value = 0u;
+    for (auto shift = 0u; shift < 64u; shift += 7u) {
+      std::uint8_t byte = 0u;
+      if (!ReadByte(byte)) {
+        return false;
+      }
+      value |= static_cast<std::uint64_t>(byte & 0x7fu) << shift;
+      if ((byte & 0x80u) == 0u) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadSigned(std::int64_t& value) {
+    std::uint64_t unsigned_value = 0u;
+    if (!ReadUnsigned(unsigned_value)) {
+      return false;
+    }
+    value = static_cast<std::int64_t>((unsigned_value >> 1) ^
+                                      (~(unsigned_value & 1u) + 1u));
+    return true;
+  }
+
+  bool ReadString(std::string& value) {
+    std::uint64_t size = 0u;
+    if (!ReadUnsigned(size) || size > static_cast<std::uint64_t>(end_ - it_)) {
+      return false;
+    }
+    value.assign(it_, static_cast<size_t>(size));
+    it_ += size;
+    return true;
+  }
+
+  bool ReadOptionalSigned(bool present, boost::optional<std::int64_t>& value) {
+    if (!present) {
+      return true;
+    }
+    std::int64_t result = 0;
+    if (!ReadSigned(result)) {
+      return false;
+    }
+    value = result;
+    return true;
+  }
+
+  bool ReadOptionalString(bool present, boost::optional<std::string>& value) {
+    if (!present) {
+      return true;
+    }
+    std::string result;
+    if (!ReadString(result)) {
+      return false;
+    }
+    value = std::move(result);
+    return true;
+  }
+
+  bool AtEnd() const { return it_ == end_; }
+
+ private:
+  const char* it_;
+  const char* end_;
+};
+
+bool ReadPartition(Reader& reader, model::Partition& partition) {
+  std::uint8_t fields = 0u;
+  boost::optional<std::string> checksum;
+  boost::optional<std::int64_t> compressed_data_size;
+  std::string data_handle;
+  boost::optional<std::int64_t> data_size;
+  boost::optional<std::string> crc;
+  std::string partition_id;
+  boost::optional<std::int64_t> version;
+
+  if (!reader.ReadByte(fields) ||
+      !reader.ReadOptionalString(fields & kChecksum, checksum) ||
+      !reader.ReadOptionalSigned(fields & kCompressedDataSize,
+                                 compressed_data_size) ||
+      !reader.ReadString(data_handle) ||
+      !reader.ReadOptionalSigned(fields & kDataSize, data_size) ||
+      !reader.ReadOptionalString(fields & kCrc, crc) ||
+      !reader.ReadString(partition_id) ||
+      !reader.ReadOptionalSigned(fields & kVersion, version)) {
+    return false;
+  }
+
+  partition.SetChecksum(std::move(checksum));
+  partition.SetCompressedDataSize(compressed_data_size);
+  partition.SetDataHandle(std::move(data_handle));
+  partition.SetDataSize(data_size);
+  partition.SetCrc(std::move(crc));
+  partition.SetPartition(std::move(partition_id));
+  partition.SetVersion(version);
+  return true;
+}
+}  // namespace
+
+std::string Serialize(const model::Partition& partition) {
+  const auto& checksum = partition.GetChecksum();
+  const auto& compressed_data_size = partition.GetCompressedDataSize();
+  const auto& data_size = partition.GetDataSize();
+  const auto& crc = partition.GetCrc();
+  const auto& version = partition.GetVersion();
+
+  std::uint8_t fields = 0u;
+  fields |= checksum ? kChecksum : 0u;
+  fields |= compressed_data_size ? kCompressedDataSize : 0u;
+  fields |= data_size ? kDataSize : 0u;
+  fields |= crc ? kCrc : 0u;
+  fields |= version ? kVersion : 0u;
+
+  Writer writer;
+  writer.WriteByte(fields);
+  if (checksum) {
+    writer.WriteString(*checksum);
+  }
+  if (compressed_data_size) {
+    writer.WriteSigned(*compressed_data_size);
+  }
+  writer.WriteString(partition.GetDataHandle());
+  if (data_size) {
+    writer.WriteSigned(*data_size);
+  }
+  if (crc) {
+    writer.WriteString(*crc);
+  }
+  writer.WriteString(partition.GetPartition());
+  if (version) {
+    writer.WriteSigned(*version);
+  }
+  return writer.Finish();
+}
+
+std::string Serialize(const std::vector<std::string>& strings) {
+  Writer writer;
+  writer.WriteUnsigned(strings.size());
+  for (const auto& value : strings) {
+    writer.WriteString(value);
+  }
+  return writer.Finish();
+}
+
+std::string Serialize(const model::LayerVersions& layer_versions) {
+  const auto& versions = layer_versions.GetLayerVersions();
+
+  Writer writer;
+  writer.WriteSigned(layer_versions.GetVersion());
+  writer.WriteUnsigned(versions.size());
+  for (const auto& version : versions) {
+    writer.WriteString(version.GetLayer());
+    writer.WriteSigned(version.GetVersion());
+    writer.WriteSigned(version.GetTimestamp());
+  }
+  return writer.Finish();
+}
+
+std::string Serialize(const model::VersionResponse& version) {
+  Writer writer;
+  writer.WriteSigned(version.GetVersion());
+  return writer.Finish();
+}
+
+bool IsBinary(const std::string& value) {
+  return value.size() >= 2u &&
+         static_cast<unsigned char>(value[0]) == kMarker &&
+         static_cast<unsigned char>(value[1]) == kFormatVersion;
+}
+
+template <>
+model::Partition Parse<model::Partition>(const std::string& value) {
+  if (!IsBinary(value)) {
+    return parser::parse<model::Partition>(value);
+  }
+
+  Reader reader(value);
+  model::Partition partition;
+  if (!ReadPartition(reader, partition) || !reader.AtEnd()) {
+    return model::Partition();
+  }
+  return partition;
+}
+
+template <>
+std::vector<std::string> Parse<std::vector<std::string>>(
+    const std::string& value) {
+  if (!IsBinary(value)) {
+    return parser::parse<std::vector<std::string>>(value);
+  }
+
+  Reader reader(value);
+  std::uint64_t count = 0u;
+  if (!reader.ReadUnsigned(count)) {
+    return {};
+  }
+
+  std::vector<std::string> strings;
+  // Every string takes at least one byte, a larger count is malformed.
+  if (count > value.size()) {
+    return {};
+  }
+  strings.resize(static_cast<size_t>(count));
+  for (auto& string : strings) {
+    if (!reader.ReadString(string)) {
+      return {};
+    }
+  }
+  return reader.AtEnd() ? strings : std::vector<std::string>();
+}
+
+template <>
+model::LayerVersions Parse<model::LayerVersions>(const std::string& value) {
+  if (!IsBinary(value)) {
+    return parser::parse<model::LayerVersions>(value);
+  }
+
+  Reader reader(value);
+  std::int64_t catalog_version = 0;
+  std::uint64_t count = 0u;
+  if (!reader.ReadSigned(catalog_version) || !reader.ReadUnsigned(count) ||
+      count > value.size()) {
+    return model::LayerVersions();
+  }
+
+  std::vector<model::LayerVersion> versions(static_cast<size_t>(count));
+  for (auto& version : versions) {
+    if (!reader.ReadString(version.GetMutableLayer()) ||
+        !reader.ReadSigned(version.GetMutableVersion()) ||
+        !reader.ReadSigned(version.GetMutableTimestamp())) {
+      return model::LayerVersions();
+    }
+  }
+
+  if (!reader.AtEnd()) {
+    return model::LayerVersions();
+  }
+
+  model::LayerVersions layer_versions;
+  layer_versions.SetVersion(catalog_version);
+  layer_versions.GetMutableLayerVersions() = std::move(versions);
+  return layer_versions;
+}
+
+template <>
+model::VersionResponse Parse<model::VersionResponse>(
+    const std::string& value) {
+  if (!IsBinary(value)) {
+    return parser::parse<model::VersionResponse>(value);
+  }
+
+  Reader reader(value);
+  model::VersionResponse version;
+  if (!reader.ReadSigned(version.GetMutableVersion()) || !reader.AtEnd()) {
+    return model::VersionResponse();
+  }
+  return version;
+}
+
+}  // namespace binary
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <olp/dataservice/read/model/Partitions.h>
+#include <olp/dataservice/read/model/VersionResponse.h>
+#include "generated/model/LayerVersions.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/*
+ * @brief A compact binary encoding of the metadata models stored in the cache.
+ *
+ * The integers are stored as varints, and the strings are prefixed with their
+ * length. The encoded value starts with a marker byte and the format version.
+ * JSON never starts with the marker, so `Parse` also reads the JSON values
+ * written by the previous SDK versions, and the cache keys stay the same.
+ *
+ * Like `parser::parse`, the parsing returns a default constructed model when
+ * the value is malformed.
+ */
+namespace binary {
+
+std::string Serialize(const model::Partition& partition);
+std::string Serialize(const std::vector<std::string>& strings);
+std::string Serialize(const model::LayerVersions& layer_versions);
+std::string Serialize(const model::VersionResponse& version);
+
+/// Checks whether the value is in the binary format.
+bool IsBinary(const std::string& value);
+
+template <typename T>
+T Parse(const std::string& value);
+
+template <>
+model::Partition Parse<model::Partition>(const std::string& value);
+
+template <>
+std::vector<std::string> Parse<std::vector<std::string>>(
+    const std::string& value);
+
+template <>
+model::LayerVersions Parse<model::LayerVersions>(const std::string& value);
+
+template <>
+model::VersionResponse Parse<model::VersionResponse>(const std::string& value);
+
+}  // namespace binary
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
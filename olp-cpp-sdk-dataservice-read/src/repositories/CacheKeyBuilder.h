@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/// A part of a cache key, refers to the string it is created from.
+class CacheKeyPart {
+ public:
+  CacheKeyPart(const std::string& value)  // NOLINT
+      : data_(value.data()), size_(value.size()) {}
+
+  CacheKeyPart(const char* value)  // NOLINT
+      : data_(value), size_(std::strlen(value)) {}
+
+  CacheKeyPart(int64_t value) : data_(nullptr) {  // NOLINT
+    const auto length =
+        std::snprintf(number_, sizeof(number_), "%" PRId64, value);
+    size_ = length > 0 ? static_cast<size_t>(length) : 0u;
+  }
+
+  /// The empty version is left out of the key with its separator.
+  CacheKeyPart(const boost::optional<int64_t>& value)  // NOLINT
+      : CacheKeyPart(value.get_value_or(0)) {
+    skipped_ = !value;
+  }
+
+  const char* Data() const { return data_ ? data_ : number_; }
+
+  size_t Size() const { return size_; }
+
+  bool Skipped() const { return skipped_; }
+
+ private:
+  const char* data_;
+  size_t size_;
+  bool skipped_ = false;
+  char number_[24];
+};
+
+/**
+ * @brief Builds the cache keys that start with the same prefix.
+ *
+ * The prefix, usually the catalog HRN string and the layer ID, is computed
+ * once per repository, and each key is built with a single allocation.
+ */
+class CacheKeyBuilder {
+ public:
+  explicit CacheKeyBuilder(std::string prefix) : prefix_(std::move(prefix)) {}
+
+  const std::string& Prefix() const { return prefix_; }
+
+  /// Returns the prefix and the parts joined with `::`.
+  std::string Key(std::initializer_list<CacheKeyPart> parts) const {
+    size_t size = prefix_.size();
+    for (const auto& part : parts) {
+      size += part.Skipped() ? 0u : kSeparatorSize + part.Size();
+    }
+
+    std::string key;
+    key.reserve(size);
+    key.append(prefix_);
+    for (const auto& part : parts) {
+      if (!part.Skipped()) {
+        key.append("::", kSeparatorSize).append(part.Data(), part.Size());
+      }
+    }
+    return key;
+  }
+
+ private:
+  static constexpr size_t kSeparatorSize = 2u;
+
+  std::string prefix_;
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
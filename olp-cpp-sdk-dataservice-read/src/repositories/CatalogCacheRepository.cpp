@@ -26,12 +26,11 @@
 
 // clang-format off
 #include "generated/parser/CatalogParser.h"
-#include "generated/parser/VersionResponseParser.h"
 #include "JsonResultParser.h"
 #include "generated/serializer/CatalogSerializer.h"
-#include "generated/serializer/VersionResponseSerializer.h"
 #include "generated/serializer/JsonSerializer.h"
 // clang-format on
+#include "BinaryCacheFormat.h"
 
 namespace {
 constexpr auto kLogTag = "CatalogCacheRepository";
@@ -39,11 +38,6 @@ constexpr auto kLogTag = "CatalogCacheRepository";
 constexpr auto kChronoSecondsMax = std::chrono::seconds::max();
 constexpr auto kTimetMax = std::numeric_limits<time_t>::max();
 
-std::string CreateKey(const std::string& hrn) { return hrn + "::catalog"; }
-std::string VersionKey(const std::string& hrn) {
-  return hrn + "::latestVersion";
-}
-
 time_t ConvertTime(std::chrono::seconds time) {
   return time == kChronoSecondsMax ? kTimetMax : time.count();
 }
@@ -56,62 +50,116 @@ namespace repository {
 CatalogCacheRepository::CatalogCacheRepository(
     const client::HRN& hrn, std::shared_ptr<cache::KeyValueCache> cache,
     std::chrono::seconds default_expiry)
-    : hrn_(hrn), cache_(cache), default_expiry_(ConvertTime(default_expiry)) {}
+    : catalog_keys_(hrn.ToCatalogHRNString()),
+      cache_(cache),
+      default_expiry_(ConvertTime(default_expiry)) {}
 
 void CatalogCacheRepository::Put(const model::Catalog& catalog) {
-  std::string hrn(hrn_.ToCatalogHRNString());
-  auto key = CreateKey(hrn);
+  Put(std::make_shared<const model::Catalog>(catalog));
+}
+
+void CatalogCacheRepository::Put(CatalogSnapshot::CatalogPtr catalog) {
+  const auto& hrn = catalog_keys_.Prefix();
+  auto key = catalog_keys_.Key({"catalog"});
   OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
 
-  cache_->Put(key, catalog,
-              [&]() { return olp::serializer::serialize(catalog); },
-              default_expiry_);
+  if (cache_->Put(key, *catalog,
+                  [&]() { return olp::serializer::serialize(*catalog); },
+                  default_expiry_)) {
+    CatalogSnapshotCache::Instance().PutCatalog(cache_, hrn,
+                                                std::move(catalog));
+  }
 }
 
 boost::optional<model::Catalog> CatalogCacheRepository::Get() {
-  std::string hrn(hrn_.ToCatalogHRNString());
-  auto key = CreateKey(hrn);
+  auto snapshot = GetSnapshot();
+  if (!snapshot) {
+    return boost::none;
+  }
+  return *snapshot->GetCatalog();
+}
+
+CatalogSnapshotCache::SnapshotPtr CatalogCacheRepository::GetSnapshot() {
+  const auto& hrn = catalog_keys_.Prefix();
+  auto key = catalog_keys_.Key({"catalog"});
   OLP_SDK_LOG_DEBUG_F(kLogTag, "Get -> '%s'", key.c_str());
 
+  // The snapshot is used while the cache has the catalog, so the removed and
+  // the expired catalogs are not returned.
+  auto& snapshots = CatalogSnapshotCache::Instance();
+  auto snapshot = snapshots.Find(cache_, hrn);
+  if (snapshot && snapshot->GetCatalog() && cache_->Contains(key)) {
+    snapshot->MarkValidated();
+    return snapshot;
+  }
+
   auto cached_catalog = cache_->Get(key, [](const std::string& value) {
     return parser::parse<model::Catalog>(value);
   });
 
   if (cached_catalog.empty()) {
-    return boost::none;
+    return nullptr;
   }
 
-  return boost::any_cast<model::Catalog>(cached_catalog);
+  return snapshots.PutCatalog(
+      cache_, hrn,
+      std::make_shared<const model::Catalog>(
+          boost::any_cast<model::Catalog>(std::move(cached_catalog))));
+}
+
+CatalogSnapshotCache::SnapshotPtr CatalogCacheRepository::GetStaleSnapshot(
+    std::chrono::seconds max_staleness) {
+  auto snapshot =
+      CatalogSnapshotCache::Instance().Find(cache_, catalog_keys_.Prefix());
+  if (!snapshot || !snapshot->GetCatalog() ||
+      snapshot->GetValidatedAt() + max_staleness <
+          CatalogSnapshot::Clock::now()) {
+    return nullptr;
+  }
+  return snapshot;
 }
 
 void CatalogCacheRepository::PutVersion(const model::VersionResponse& version) {
-  std::string hrn(hrn_.ToCatalogHRNString());
+  const auto& hrn = catalog_keys_.Prefix();
   OLP_SDK_LOG_DEBUG_F(kLogTag, "PutVersion -> '%s'", hrn.c_str());
 
-  cache_->Put(VersionKey(hrn), version,
-              [&]() { return olp::serializer::serialize(version); },
-              default_expiry_);
+  if (cache_->Put(catalog_keys_.Key({"latestVersion"}), version,
+                  [&]() { return binary::Serialize(version); },
+                  default_expiry_)) {
+    CatalogSnapshotCache::Instance().PutVersion(cache_, hrn, version);
+  }
 }
 
 boost::optional<model::VersionResponse> CatalogCacheRepository::GetVersion() {
-  std::string hrn(hrn_.ToCatalogHRNString());
-  auto key = VersionKey(hrn);
+  const auto& hrn = catalog_keys_.Prefix();
+  auto key = catalog_keys_.Key({"latestVersion"});
   OLP_SDK_LOG_DEBUG_F(kLogTag, "GetVersion -> '%s'", key.c_str());
 
+  auto& snapshots = CatalogSnapshotCache::Instance();
+  auto snapshot = snapshots.Find(cache_, hrn);
+  if (snapshot && snapshot->GetVersion() && cache_->Contains(key)) {
+    return snapshot->GetVersion();
+  }
+
   auto cached_version = cache_->Get(key, [](const std::string& value) {
-    return parser::parse<model::VersionResponse>(value);
+    return binary::Parse<model::VersionResponse>(value);
   });
 
   if (cached_version.empty()) {
     return boost::none;
   }
-  return boost::any_cast<model::VersionResponse>(cached_version);
+
+  auto version = boost::any_cast<model::VersionResponse>(cached_version);
+  snapshots.PutVersion(cache_, hrn, version);
+  return version;
 }
 
 void CatalogCacheRepository::Clear() {
-  std::string hrn(hrn_.ToCatalogHRNString());
-  OLP_SDK_LOG_INFO_F(kLogTag, "Clear -> '%s'", CreateKey(hrn).c_str());
+  const auto& hrn = catalog_keys_.Prefix();
+  OLP_SDK_LOG_INFO_F(kLogTag, "Clear -> '%s'",
+                     catalog_keys_.Key({"catalog"}).c_str());
 
+  CatalogSnapshotCache::Instance().Erase(cache_, hrn);
   cache_->RemoveKeysWithPrefix(hrn);
 }
 
@@ -26,6 +26,8 @@
 #include <olp/dataservice/read/model/Catalog.h>
 #include <olp/dataservice/read/model/VersionResponse.h>
 #include <boost/optional.hpp>
+#include "CacheKeyBuilder.h"
+#include "CatalogSnapshotCache.h"
 
 namespace olp {
 namespace cache {
@@ -45,8 +47,29 @@ class CatalogCacheRepository final {
 
   void Put(const model::Catalog& catalog);
 
+  void Put(CatalogSnapshot::CatalogPtr catalog);
+
   boost::optional<model::Catalog> Get();
 
+  /**
+   * @brief Gets the cached catalog without decoding or copying it again.
+   *
+   * The snapshot of the catalog is kept in memory, and it is used while the
+   * cache has the catalog.
+   *
+   * @return The snapshot with the catalog, or null if it is not cached.
+   */
+  CatalogSnapshotCache::SnapshotPtr GetSnapshot();
+
+  /**
+   * @brief Gets the catalog that is not in the cache anymore, but was there
+   * less than `max_staleness` ago.
+   *
+   * @return The snapshot with the stale catalog, or null if there is none.
+   */
+  CatalogSnapshotCache::SnapshotPtr GetStaleSnapshot(
+      std::chrono::seconds max_staleness);
+
   void PutVersion(const model::VersionResponse& version);
 
   boost::optional<model::VersionResponse> GetVersion();
@@ -54,7 +77,7 @@ class CatalogCacheRepository final {
   void Clear();
 
  private:
-  client::HRN hrn_;
+  const CacheKeyBuilder catalog_keys_;
   std::shared_ptr<cache::KeyValueCache> cache_;
   time_t default_expiry_;
 };
@@ -19,12 +19,17 @@
 
 #include "CatalogRepository.h"
 
+#include <chrono>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <utility>
 
+#include <olp/core/cache/RefetchCostScope.h>
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/Condition.h>
 #include <olp/core/logging/Log.h>
+#include <olp/core/thread/TaskScheduler.h>
 
 #include "CatalogCacheRepository.h"
 #include "generated/api/ConfigApi.h"
@@ -35,6 +40,22 @@
 
 namespace {
 constexpr auto kLogTag = "CatalogRepository";
+
+using RefreshKey = std::pair<std::string, const void*>;
+
+std::mutex refresh_mutex;
+std::set<RefreshKey> pending_refreshes;
+
+/// Returns false if the catalog of the cache is already being refreshed.
+bool StartRefresh(const RefreshKey& key) {
+  std::lock_guard<std::mutex> lock(refresh_mutex);
+  return pending_refreshes.insert(key).second;
+}
+
+void FinishRefresh(const RefreshKey& key) {
+  std::lock_guard<std::mutex> lock(refresh_mutex);
+  pending_refreshes.erase(key);
+}
 }  // namespace
 
 namespace olp {
@@ -51,6 +72,16 @@ CatalogRepository::CatalogRepository(client::HRN catalog,
 
 CatalogResponse CatalogRepository::GetCatalog(
     const CatalogRequest& request, client::CancellationContext context) {
+  auto response = GetCatalogSnapshot(request, std::move(context));
+  if (!response.IsSuccessful()) {
+    return response.GetError();
+  }
+  return *response.GetResult()->GetCatalog();
+}
+
+CatalogRepository::CatalogSnapshotResponse
+CatalogRepository::GetCatalogSnapshot(const CatalogRequest& request,
+                                      client::CancellationContext context) {
   const auto request_key = request.CreateKey();
   const auto fetch_options = request.GetFetchOption();
   const auto catalog_str = catalog_.ToCatalogHRNString();
@@ -59,13 +90,13 @@ CatalogResponse CatalogRepository::GetCatalog(
       catalog_, settings_.cache, settings_.default_cache_expiration);
 
   if (fetch_options != OnlineOnly && fetch_options != CacheWithUpdate) {
-    auto cached = repository.Get();
+    auto cached = repository.GetSnapshot();
     if (cached) {
       OLP_SDK_LOG_DEBUG_F(kLogTag,
                           "GetCatalog found in cache, hrn='%s', key='%s'",
                           catalog_str.c_str(), request_key.c_str());
 
-      return *cached;
+      return cached;
     } else if (fetch_options == CacheOnly) {
       OLP_SDK_LOG_INFO_F(kLogTag,
                          "GetCatalog not found in cache, hrn='%s', key='%s'",
@@ -73,8 +104,21 @@ CatalogResponse CatalogRepository::GetCatalog(
       return {{client::ErrorCode::NotFound,
                "CacheOnly: resource not found in cache"}};
     }
+
+    if (settings_.max_staleness.count() > 0 && settings_.task_scheduler) {
+      auto stale = repository.GetStaleSnapshot(settings_.max_staleness);
+      if (stale) {
+        OLP_SDK_LOG_DEBUG_F(kLogTag,
+                            "GetCatalog found expired catalog, refreshing, "
+                            "hrn='%s', key='%s'",
+                            catalog_str.c_str(), request_key.c_str());
+        RefreshInBackground(request);
+        return stale;
+      }
+    }
   }
 
+  const auto download_start = std::chrono::steady_clock::now();
   auto config_api = lookup_client_.LookupApi(
       "config", "v1", static_cast<client::FetchOptions>(fetch_options),
       context);
@@ -87,9 +131,6 @@ CatalogResponse CatalogRepository::GetCatalog(
   auto catalog_response = ConfigApi::GetCatalog(
       config_client, catalog_str, request.GetBillingTag(), context);
 
-  if (catalog_response.IsSuccessful() && fetch_options != OnlineOnly) {
-    repository.Put(catalog_response.GetResult());
-  }
   if (!catalog_response.IsSuccessful()) {
     const auto& error = catalog_response.GetError();
     if (error.GetHttpStatusCode() == http::HttpStatusCode::FORBIDDEN) {
@@ -99,9 +140,50 @@ CatalogResponse CatalogRepository::GetCatalog(
                             catalog_str.c_str(), request_key.c_str());
       repository.Clear();
     }
+    return catalog_response.GetError();
+  }
+
+  auto catalog =
+      std::make_shared<const model::Catalog>(catalog_response.MoveResult());
+  if (fetch_options != OnlineOnly) {
+    cache::RefetchCostScope cost_scope(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - download_start));
+    repository.Put(catalog);
+  }
+
+  return CatalogSnapshotCache::SnapshotPtr(
+      std::make_shared<const CatalogSnapshot>(std::move(catalog),
+                                              boost::none));
+}
+
+void CatalogRepository::RefreshInBackground(const CatalogRequest& request) {
+  const RefreshKey key(catalog_.ToCatalogHRNString(), settings_.cache.get());
+  if (!StartRefresh(key)) {
+    return;
   }
 
-  return catalog_response;
+  // The task owns the settings and the lookup client, so it does not depend
+  // on the client that started it.
+  auto catalog = catalog_;
+  auto settings = settings_;
+  auto refresh_request = request;
+  refresh_request.WithFetchOption(CacheWithUpdate);
+
+  settings_.task_scheduler->ScheduleTask(
+      [=]() {
+        client::ApiLookupClient lookup_client(catalog, settings);
+        CatalogRepository repository(catalog, settings, lookup_client);
+        auto response = repository.GetCatalogSnapshot(
+            refresh_request, client::CancellationContext());
+        if (!response.IsSuccessful()) {
+          OLP_SDK_LOG_WARNING_F(
+              kLogTag, "Background refresh unsuccessful, hrn='%s', error='%s'",
+              key.first.c_str(), response.GetError().GetMessage().c_str());
+        }
+        FinishRefresh(key);
+      },
+      thread::LOW);
 }
 
 CatalogVersionResponse CatalogRepository::GetLatestVersion(
@@ -25,6 +25,7 @@
 #include <olp/core/client/CancellationToken.h>
 #include <olp/core/client/HRN.h>
 #include <olp/core/client/OlpClientSettings.h>
+#include "CatalogSnapshotCache.h"
 #include "olp/dataservice/read/Types.h"
 
 namespace olp {
@@ -39,12 +40,20 @@ namespace repository {
 
 class CatalogRepository final {
  public:
+  using CatalogSnapshotResponse =
+      client::ApiResponse<CatalogSnapshotCache::SnapshotPtr, client::ApiError>;
+
   CatalogRepository(client::HRN catalog, client::OlpClientSettings settings,
                     client::ApiLookupClient client);
 
   CatalogResponse GetCatalog(const CatalogRequest& request,
                              client::CancellationContext context);
 
+  /// Gets the catalog like `GetCatalog`, but with the layers indexed by ID
+  /// and without copying the cached catalog.
+  CatalogSnapshotResponse GetCatalogSnapshot(
+      const CatalogRequest& request, client::CancellationContext context);
+
   CatalogVersionResponse GetLatestVersion(const CatalogVersionRequest& request,
                                           client::CancellationContext context);
 
@@ -56,6 +65,10 @@ class CatalogRepository final {
       const boost::optional<std::string>& billing_tag,
       client::CancellationContext context);
 
+  /// Fetches the catalog configuration on the task scheduler and stores it,
+  /// unless the catalog is already being refreshed.
+  void RefreshInBackground(const CatalogRequest& request);
+
   client::HRN catalog_;
   client::OlpClientSettings settings_;
   client::ApiLookupClient lookup_client_;
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "CatalogSnapshotCache.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+#include <olp/core/porting/make_unique.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+namespace {
+using CachePtr = std::shared_ptr<cache::KeyValueCache>;
+using SnapshotPtr = CatalogSnapshotCache::SnapshotPtr;
+
+struct Entry {
+  std::weak_ptr<cache::KeyValueCache> cache;
+  SnapshotPtr snapshot;
+};
+
+using Registry = std::unordered_multimap<std::string, Entry>;
+
+// Compares the control blocks, so a new cache allocated at the address of a
+// destroyed one does not match its entries.
+bool IsSameCache(const std::weak_ptr<cache::KeyValueCache>& lhs,
+                 const CachePtr& rhs) {
+  return !lhs.owner_before(rhs) && !rhs.owner_before(lhs);
+}
+}  // namespace
+
+CatalogSnapshot::CatalogSnapshot(
+    CatalogPtr catalog, boost::optional<model::VersionResponse> version,
+    Clock::time_point validated_at)
+    : catalog_(std::move(catalog)),
+      version_(std::move(version)),
+      validated_at_(validated_at.time_since_epoch().count()) {
+  if (!catalog_) {
+    return;
+  }
+
+  const auto& layers = catalog_->GetLayers();
+  layers_.reserve(layers.size());
+  for (const auto& layer : layers) {
+    layers_.emplace(layer.GetId(), &layer);
+  }
+}
+
+const model::Layer* CatalogSnapshot::FindLayer(
+    const std::string& layer_id) const {
+  auto it = layers_.find(layer_id);
+  return it != layers_.end() ? it->second : nullptr;
+}
+
+class CatalogSnapshotCache::Impl {
+ public:
+  using UpdateFunc = std::function<SnapshotPtr(const SnapshotPtr&)>;
+
+  Impl() : registry_(std::make_shared<const Registry>()) {}
+
+  SnapshotPtr Find(const CachePtr& cache, const std::string& catalog) const {
+    auto registry = std::atomic_load(&registry_);
+    auto range = registry->equal_range(catalog);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (IsSameCache(it->second.cache, cache)) {
+        return it->second.snapshot;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Replaces the snapshot with the result of `update`, or removes it if the
+  /// result is null.
+  void Update(const CachePtr& cache, const std::string& catalog,
+              const UpdateFunc& update) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto registry = std::make_shared<Registry>();
+    registry->reserve(registry_->size() + 1u);
+
+    SnapshotPtr current;
+    for (const auto& entry : *registry_) {
+      if (entry.first == catalog && IsSameCache(entry.second.cache, cache)) {
+        current = entry.second.snapshot;
+      } else if (!entry.second.cache.expired()) {
+        registry->emplace(entry);
+      }
+    }
+
+    auto snapshot = update(current);
+    if (snapshot) {
+      registry->emplace(catalog, Entry{cache, std::move(snapshot)});
+    }
+
+    std::atomic_store(&registry_,
+                      std::shared_ptr<const Registry>(std::move(registry)));
+  }
+
+ private:
+  std::mutex mutex_;
+  std::shared_ptr<const Registry> registry_;
+};
+
+CatalogSnapshotCache& CatalogSnapshotCache::Instance() {
+  static CatalogSnapshotCache instance;
+  return instance;
+}
+
+CatalogSnapshotCache::CatalogSnapshotCache()
+    : impl_(std::make_unique<Impl>()) {}
+
+SnapshotPtr CatalogSnapshotCache::Find(const CachePtr& cache,
+                                       const std::string& catalog) const {
+  return impl_->Find(cache, catalog);
+}
+
+SnapshotPtr CatalogSnapshotCache::PutCatalog(
+    const CachePtr& cache, const std::string& catalog,
+    CatalogSnapshot::CatalogPtr value) {
+  SnapshotPtr result;
+  impl_->Update(cache, catalog, [&](const SnapshotPtr& current) {
+    auto version = current ? current->GetVersion()
+                           : boost::optional<model::VersionResponse>();
+    result = std::make_shared<const CatalogSnapshot>(std::move(value),
+                                                     std::move(version));
+    return result;
+  });
+  return result;
+}
+
+SnapshotPtr CatalogSnapshotCache::PutVersion(const CachePtr& cache,
+                                             const std::string& catalog,
+                                             model::VersionResponse value) {
+  SnapshotPtr result;
+  impl_->Update(cache, catalog, [&](const SnapshotPtr& current) {
+    auto decoded =
+        current ? current->GetCatalog() : CatalogSnapshot::CatalogPtr();
+    auto validated_at = current ? current->GetValidatedAt()
+                                : CatalogSnapshot::Clock::now();
+    result = std::make_shared<const CatalogSnapshot>(
+        std::move(decoded), std::move(value), validated_at);
+    return result;
+  });
+  return result;
+}
+
+void CatalogSnapshotCache::Erase(const CachePtr& cache,
+                                 const std::string& catalog) {
+  impl_->Update(cache, catalog,
+                [](const SnapshotPtr&) { return SnapshotPtr(); });
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
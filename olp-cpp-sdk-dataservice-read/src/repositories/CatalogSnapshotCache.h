@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+#include <olp/dataservice/read/model/Catalog.h>
+#include <olp/dataservice/read/model/VersionResponse.h>
+
+namespace olp {
+namespace cache {
+class KeyValueCache;
+}  // namespace cache
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/*
+ * @brief An immutable decoded catalog and its latest version, with the layers
+ * indexed by ID.
+ *
+ * An update creates a new snapshot that shares the unchanged parts.
+ */
+class CatalogSnapshot final {
+ public:
+  using CatalogPtr = std::shared_ptr<const model::Catalog>;
+  using Clock = std::chrono::steady_clock;
+
+  CatalogSnapshot(CatalogPtr catalog,
+                  boost::optional<model::VersionResponse> version,
+                  Clock::time_point validated_at = Clock::now());
+
+  /// The catalog, or null if only the version is known.
+  const CatalogPtr& GetCatalog() const { return catalog_; }
+
+  const boost::optional<model::VersionResponse>& GetVersion() const {
+    return version_;
+  }
+
+  /// Finds the layer configuration, or returns null if there is none.
+  const model::Layer* FindLayer(const std::string& layer_id) const;
+
+  /// The last time the cache was known to have the catalog. It bounds how
+  /// long the catalog is used after it expires.
+  Clock::time_point GetValidatedAt() const {
+    return Clock::time_point(Clock::duration(validated_at_.load()));
+  }
+
+  /// Records that the cache still has the catalog.
+  void MarkValidated() const {
+    validated_at_.store(Clock::now().time_since_epoch().count());
+  }
+
+ private:
+  CatalogPtr catalog_;
+  std::unordered_map<std::string, const model::Layer*> layers_;
+  boost::optional<model::VersionResponse> version_;
+  mutable std::atomic<Clock::rep> validated_at_;
+};
+
+/*
+ * @brief A process-wide registry of the catalog snapshots, keyed by the
+ * catalog and the `KeyValueCache` instance that holds the catalog.
+ *
+ * The lookups atomically load the current registry and the snapshot, so they
+ * do not take a lock. The updates copy the registry under a lock and swap it.
+ * The entries of the destroyed caches are dropped on the next update.
+ */
+class CatalogSnapshotCache final {
+ public:
+  using SnapshotPtr = std::shared_ptr<const CatalogSnapshot>;
+
+  static CatalogSnapshotCache& Instance();
+
+  SnapshotPtr Find(const std::shared_ptr<cache::KeyValueCache>& cache,
+                   const std::string& catalog) const;
+
+  /// Replaces the catalog of the snapshot and returns the new snapshot.
+  SnapshotPtr PutCatalog(const std::shared_ptr<cache::KeyValueCache>& cache,
+                         const std::string& catalog,
+                         CatalogSnapshot::CatalogPtr value);
+
+  /// Replaces the version of the snapshot and returns the new snapshot.
+  SnapshotPtr PutVersion(const std::shared_ptr<cache::KeyValueCache>& cache,
+                         const std::string& catalog,
+                         model::VersionResponse value);
+
+  void Erase(const std::shared_ptr<cache::KeyValueCache>& cache,
+             const std::string& catalog);
+
+ private:
+  CatalogSnapshotCache();
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
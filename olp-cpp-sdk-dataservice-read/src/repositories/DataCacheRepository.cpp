@@ -19,6 +19,8 @@
 
 #include "DataCacheRepository.h"
 
+#include <cstdlib>
+#include <ctime>
 #include <limits>
 #include <string>
 
@@ -42,7 +44,9 @@ namespace repository {
 DataCacheRepository::DataCacheRepository(
     const client::HRN& hrn, std::shared_ptr<cache::KeyValueCache> cache,
     std::chrono::seconds default_expiry)
-    : hrn_(hrn), cache_(cache), default_expiry_(ConvertTime(default_expiry)) {}
+    : catalog_keys_(hrn.ToCatalogHRNString()),
+      cache_(cache),
+      default_expiry_(ConvertTime(default_expiry)) {}
 
 void DataCacheRepository::Put(const model::Data& data,
                               const std::string& layer_id,
@@ -53,6 +57,62 @@ void DataCacheRepository::Put(const model::Data& data,
   cache_->Put(key, data, default_expiry_);
 }
 
+void DataCacheRepository::Put(const model::Data& data,
+                              const std::string& layer_id,
+                              const std::string& data_handle,
+                              const std::string& etag) {
+  // The data that never expires needs no revalidation.
+  if (etag.empty() || default_expiry_ == kTimetMax) {
+    cache_->Remove(CreateETagKey(layer_id, data_handle));
+    Put(data, layer_id, data_handle);
+    return;
+  }
+
+  auto key = CreateKey(layer_id, data_handle);
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s', etag='%s'", key.c_str(),
+                      etag.c_str());
+
+  cache_->Put(key, data, kTimetMax);
+  Revalidate(layer_id, data_handle, etag);
+}
+
+void DataCacheRepository::Revalidate(const std::string& layer_id,
+                                     const std::string& data_handle,
+                                     const std::string& etag) {
+  // The validator holds the expiry of the data and its `ETag`.
+  const auto expiry = std::time(nullptr) + default_expiry_;
+  const auto validator = std::to_string(expiry) + " " + etag;
+  cache_->Put(CreateETagKey(layer_id, data_handle), validator,
+              [&]() { return validator; }, kTimetMax);
+}
+
+boost::optional<std::string> DataCacheRepository::GetExpiredETag(
+    const std::string& layer_id, const std::string& data_handle) const {
+  auto value = cache_->Get(CreateETagKey(layer_id, data_handle),
+                           [](const std::string& value) { return value; });
+  if (value.empty()) {
+    return boost::none;
+  }
+
+  const auto validator = boost::any_cast<std::string>(value);
+  char* end = nullptr;
+  const auto expiry =
+      static_cast<time_t>(std::strtoll(validator.c_str(), &end, 10));
+  if (*end != ' ' || std::time(nullptr) < expiry) {
+    return boost::none;
+  }
+  return std::string(end + 1);
+}
+
+std::unique_ptr<cache::KeyValueCache::ValueWriter>
+DataCacheRepository::OpenWriter(const std::string& layer_id,
+                                const std::string& data_handle) {
+  auto key = CreateKey(layer_id, data_handle);
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "OpenWriter -> '%s'", key.c_str());
+
+  return cache_->OpenWriter(key, default_expiry_);
+}
+
 boost::optional<model::Data> DataCacheRepository::Get(
     const std::string& layer_id, const std::string& data_handle) {
   auto key = CreateKey(layer_id, data_handle);
@@ -66,11 +126,19 @@ boost::optional<model::Data> DataCacheRepository::Get(
   return cached_data;
 }
 
+cache::KeyValueCache::ValueView DataCacheRepository::GetView(
+    const std::string& layer_id, const std::string& data_handle) {
+  auto key = CreateKey(layer_id, data_handle);
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "GetView '%s'", key.c_str());
+
+  return cache_->GetView(key);
+}
+
 bool DataCacheRepository::IsCached(const std::string& layer_id,
                                    const std::string& data_handle) const {
   auto data_key = CreateKey(layer_id, data_handle);
   OLP_SDK_LOG_DEBUG_F(kLogTag, "IsCached key -> '%s'", data_key.c_str());
-  return cache_->Contains(data_key);
+  return cache_->Contains(data_key) && !GetExpiredETag(layer_id, data_handle);
 }
 
 bool DataCacheRepository::Clear(const std::string& layer_id,
@@ -83,8 +151,13 @@ bool DataCacheRepository::Clear(const std::string& layer_id,
 
 std::string DataCacheRepository::CreateKey(
     const std::string& layer_id, const std::string& datahandle) const {
-  std::string hrn(hrn_.ToCatalogHRNString());
-  return hrn + "::" + layer_id + "::" + datahandle + "::Data";
+  return catalog_keys_.Key({layer_id, datahandle, "Data"});
+}
+
+std::string DataCacheRepository::CreateETagKey(
+    const std::string& layer_id, const std::string& data_handle) const {
+  // Starts with the data key, so the validator is cleared with the data.
+  return catalog_keys_.Key({layer_id, data_handle, "Data", "ETag"});
 }
 
 }  // namespace repository
@@ -22,14 +22,13 @@
 #include <chrono>
 #include <memory>
 
+#include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/client/HRN.h>
 #include <olp/dataservice/read/model/Data.h>
 #include <boost/optional.hpp>
+#include "CacheKeyBuilder.h"
 
 namespace olp {
-namespace cache {
-class KeyValueCache;
-}
 namespace dataservice {
 namespace read {
 namespace repository {
@@ -45,8 +44,32 @@ class DataCacheRepository final {
   void Put(const model::Data& data, const std::string& layer_id,
            const std::string& data_handle);
 
+  /// Stores the data with its `ETag`. The data is kept past its expiry, so
+  /// it is revalidated with the service instead of downloaded again.
+  void Put(const model::Data& data, const std::string& layer_id,
+           const std::string& data_handle, const std::string& etag);
+
+  /// Extends the expiry of the data that the service reports as not modified.
+  void Revalidate(const std::string& layer_id, const std::string& data_handle,
+                  const std::string& etag);
+
+  /// Returns the `ETag` of the data past its expiry, such data is only used
+  /// after it is revalidated.
+  boost::optional<std::string> GetExpiredETag(
+      const std::string& layer_id, const std::string& data_handle) const;
+
+  /// Creates a writer that stores the data in chunks on commit.
+  std::unique_ptr<cache::KeyValueCache::ValueWriter> OpenWriter(
+      const std::string& layer_id, const std::string& data_handle);
+
   boost::optional<model::Data> Get(const std::string& layer_id,
                                    const std::string& data_handle);
+
+  /// Gets the data without copying it out of the buffer the cache read it
+  /// into, for the callers that do not need a `model::Data` instance.
+  cache::KeyValueCache::ValueView GetView(const std::string& layer_id,
+                                          const std::string& data_handle);
+
   bool IsCached(const std::string& layer_id,
                 const std::string& data_handle) const;
 
@@ -56,7 +79,10 @@ class DataCacheRepository final {
                         const std::string& datahandle) const;
 
  private:
-  client::HRN hrn_;
+  std::string CreateETagKey(const std::string& layer_id,
+                            const std::string& data_handle) const;
+
+  const CacheKeyBuilder catalog_keys_;
   std::shared_ptr<cache::KeyValueCache> cache_;
   time_t default_expiry_;
 };
@@ -20,17 +20,24 @@
 #include "DataRepository.h"
 
 #include <algorithm>
+#include <chrono>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
 
+#include <olp/core/cache/RefetchCostScope.h>
 #include <olp/core/client/Condition.h>
+#include <olp/core/client/Tracer.h>
+#include <olp/core/http/RequestPriorityScope.h>
 #include <olp/core/logging/Log.h>
+#include <olp/core/porting/make_unique.h>
 #include "CatalogRepository.h"
 #include "DataCacheRepository.h"
-#include "NamedMutex.h"
+#include "InflightBlobRequest.h"
 #include "PartitionsCacheRepository.h"
 #include "PartitionsRepository.h"
+#include "Sha1.h"
 #include "generated/api/BlobApi.h"
 #include "generated/api/VolatileBlobApi.h"
 #include "olp/dataservice/read/CatalogRequest.h"
@@ -78,109 +85,270 @@ DataResponse DataRepository::GetVersionedTile(
                                 .WithDataHandle(partition.GetDataHandle())
                                 .WithFetchOption(request.GetFetchOption());
 
-  return GetBlobData(layer_id, kBlobService, data_request, context);
+  return GetBlobData(layer_id, kBlobService, data_request, context,
+                     request.GetChecksumVerification()
+                         ? partition.GetChecksum()
+                         : boost::none);
 }
 
 BlobApi::DataResponse DataRepository::GetVersionedData(
     const std::string& layer_id, const DataRequest& request, int64_t version,
     client::CancellationContext context) {
+  return std::move(
+      *GetVersionedBlob(layer_id, request, version, context, nullptr));
+}
+
+boost::optional<BlobApi::DataResponse> DataRepository::GetVersionedDataOrShare(
+    const std::string& layer_id, const DataRequest& request, int64_t version,
+    client::CancellationContext context, SharedBlobCallback shared_callback) {
+  return GetVersionedBlob(layer_id, request, version, context,
+                          &shared_callback);
+}
+
+boost::optional<BlobApi::DataResponse> DataRepository::GetVersionedBlob(
+    const std::string& layer_id, const DataRequest& request, int64_t version,
+    client::CancellationContext context,
+    const SharedBlobCallback* shared_callback) {
   if (request.GetDataHandle() && request.GetPartitionId()) {
-    return {{client::ErrorCode::PreconditionFailed,
-             "Both data handle and partition id specified"}};
+    return BlobApi::DataResponse(
+        client::ApiError(client::ErrorCode::PreconditionFailed,
+                         "Both data handle and partition id specified"));
   }
 
   auto blob_request = request;
+  boost::optional<std::string> checksum;
   if (!request.GetDataHandle()) {
     // get data handle for a partition to be queried
-    PartitionsRepository repository(catalog_, layer_id, settings_,
-                                    lookup_client_);
-    auto partitions_response =
-        repository.GetPartitionById(request, version, context);
+    auto partition_response =
+        GetVersionedPartition(layer_id, request, version, context);
+    if (!partition_response.IsSuccessful()) {
+      return BlobApi::DataResponse(partition_response.GetError());
+    }
 
-    if (!partitions_response.IsSuccessful()) {
-      return partitions_response.GetError();
+    const auto& partition = partition_response.GetResult();
+    blob_request.WithDataHandle(partition.GetDataHandle());
+    if (request.GetChecksumVerification()) {
+      checksum = partition.GetChecksum();
     }
+  }
 
-    const auto& partitions = partitions_response.GetResult().GetPartitions();
-    if (partitions.empty()) {
-      OLP_SDK_LOG_INFO_F(
-          kLogTag,
-          "GetVersionedData partition %s not found, hrn='%s', key='%s'",
-          request.GetPartitionId() ? request.GetPartitionId().get().c_str()
-                                   : "<none>",
-          catalog_.ToCatalogHRNString().c_str(),
-          request.CreateKey(layer_id, version).c_str());
+  // finally get the data using a data handle
+  return GetBlob(layer_id, kBlobService, blob_request, context, checksum,
+                 shared_callback);
+}
 
-      return {{client::ErrorCode::NotFound, "Partition not found"}};
+DataStreamResponse DataRepository::StreamVersionedData(
+    const std::string& layer_id, const DataRequest& request, int64_t version,
+    const DataChunkCallback& chunk_callback,
+    client::CancellationContext context) {
+  if (request.GetDataHandle() && request.GetPartitionId()) {
+    return {{client::ErrorCode::PreconditionFailed,
+             "Both data handle and partition id specified"}};
+  }
+
+  if (request.GetDecompression()) {
+    return {{client::ErrorCode::InvalidArgument,
+             "Decompression is not supported for the data streams"}};
+  }
+
+  auto blob_request = request;
+  boost::optional<std::string> checksum;
+  if (!request.GetDataHandle()) {
+    auto partition_response =
+        GetVersionedPartition(layer_id, request, version, context);
+    if (!partition_response.IsSuccessful()) {
+      return partition_response.GetError();
     }
 
-    blob_request.WithDataHandle(partitions.front().GetDataHandle());
+    const auto& partition = partition_response.GetResult();
+    blob_request.WithDataHandle(partition.GetDataHandle());
+    if (request.GetChecksumVerification()) {
+      checksum = partition.GetChecksum();
+    }
   }
 
-  // finally get the data using a data handle
-  return repository::DataRepository::GetBlobData(layer_id, kBlobService,
-                                                 blob_request, context);
+  return StreamBlobData(layer_id, blob_request, chunk_callback, context,
+                        checksum);
+}
+
+Response<model::Partition> DataRepository::GetVersionedPartition(
+    const std::string& layer_id, const DataRequest& request, int64_t version,
+    client::CancellationContext context) {
+  PartitionsRepository repository(catalog_, layer_id, settings_,
+                                  lookup_client_);
+  auto partitions_response =
+      repository.GetPartitionById(request, version, context);
+
+  if (!partitions_response.IsSuccessful()) {
+    return partitions_response.GetError();
+  }
+
+  const auto& partitions = partitions_response.GetResult().GetPartitions();
+  if (partitions.empty()) {
+    OLP_SDK_LOG_INFO_F(
+        kLogTag, "GetVersionedData partition %s not found, hrn='%s', key='%s'",
+        request.GetPartitionId() ? request.GetPartitionId().get().c_str()
+                                 : "<none>",
+        catalog_.ToCatalogHRNString().c_str(),
+        request.CreateKey(layer_id, version).c_str());
+
+    return {{client::ErrorCode::NotFound, "Partition not found"}};
+  }
+
+  return partitions.front();
 }
 
 BlobApi::DataResponse DataRepository::GetBlobData(
     const std::string& layer, const std::string& service,
-    const DataRequest& request, client::CancellationContext context) {
+    const DataRequest& request, client::CancellationContext context,
+    const boost::optional<std::string>& checksum) {
+  return std::move(
+      *GetBlob(layer, service, request, context, checksum, nullptr));
+}
+
+boost::optional<BlobApi::DataResponse> DataRepository::GetBlob(
+    const std::string& layer, const std::string& service,
+    const DataRequest& request, client::CancellationContext context,
+    const boost::optional<std::string>& checksum,
+    const SharedBlobCallback* shared_callback) {
   auto fetch_option = request.GetFetchOption();
   const auto& data_handle = request.GetDataHandle();
 
   if (!data_handle) {
-    return {{client::ErrorCode::PreconditionFailed, "Data handle is missing"}};
+    return BlobApi::DataResponse(client::ApiError(
+        client::ErrorCode::PreconditionFailed, "Data handle is missing"));
   }
 
-  NamedMutex mutex(catalog_.ToString() + layer + *data_handle);
-  std::unique_lock<NamedMutex> lock(mutex, std::defer_lock);
-
-  // If we are not planning to go online or access the cache, do not lock.
-  if (fetch_option != CacheOnly && fetch_option != OnlineOnly) {
-    lock.lock();
+  client::ScopedSpan span(settings_.tracer, "olp.read.GetBlob");
+  if (span.IsTraced()) {
+    span.SetAttribute("olp.data_handle", data_handle.value());
   }
 
   repository::DataCacheRepository repository(
       catalog_, settings_.cache, settings_.default_cache_expiration);
 
+  // The volatile data past its expiry is kept with its ETag, and is returned
+  // only when the service confirms that it is not modified.
+  const bool is_volatile = service == kVolatileBlobService;
+  boost::optional<std::string> etag;
+  model::Data expired_data;
+
   if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate) {
     auto cached_data = repository.Get(layer, data_handle.value());
+    if (cached_data && is_volatile) {
+      etag = repository.GetExpiredETag(layer, data_handle.value());
+      if (etag) {
+        expired_data = std::move(cached_data.value());
+        cached_data = boost::none;
+      }
+    }
+    span.SetAttribute("olp.cache.hit", cached_data ? "true" : "false");
     if (cached_data) {
       OLP_SDK_LOG_DEBUG_F(
           kLogTag, "GetBlobData found in cache, hrn='%s', key='%s'",
           catalog_.ToCatalogHRNString().c_str(), data_handle->c_str());
-      return cached_data.value();
+      return BlobApi::DataResponse(cached_data.value());
     } else if (fetch_option == CacheOnly) {
       OLP_SDK_LOG_INFO_F(
           kLogTag, "GetBlobData not found in cache, hrn='%s', key='%s'",
           catalog_.ToCatalogHRNString().c_str(), data_handle->c_str());
-      return {{client::ErrorCode::NotFound,
-               "CacheOnly: resource not found in cache"}};
+      return BlobApi::DataResponse(
+          client::ApiError(client::ErrorCode::NotFound,
+                           "CacheOnly: resource not found in cache"));
+    }
+  }
+
+  // The concurrent requests of the same blob share one download, the other
+  // requests wait for its response instead of downloading the blob again.
+  // The requests share the download only with the requests that use the
+  // same cache, so the blob is written to the cache of every request.
+  std::unique_ptr<InflightBlobRequest> inflight;
+  if (fetch_option != OnlineOnly && settings_.cache) {
+    inflight = std::make_unique<InflightBlobRequest>(
+        settings_.cache.get(), catalog_, layer, data_handle.value());
+    if (!inflight->IsLeader()) {
+      span.SetAttribute("olp.coalesced", "true");
+      if (shared_callback) {
+        inflight->OnComplete(context, *shared_callback);
+        return boost::none;
+      }
+
+      auto response = inflight->Wait(context);
+      if (response) {
+        return std::move(response.value());
+      }
+      inflight.reset();
     }
   }
 
+  // The requests waiting for the blob may raise the priority of the download.
+  http::RequestPriorityScope priority_scope(
+      inflight ? inflight->GetPriorityHandle() : nullptr);
+
+  const auto download_start = std::chrono::steady_clock::now();
   auto storage_api_lookup = lookup_client_.LookupApi(
       service, "v1", static_cast<client::FetchOptions>(fetch_option), context);
 
   if (!storage_api_lookup.IsSuccessful()) {
-    return storage_api_lookup.GetError();
+    BlobApi::DataResponse response(storage_api_lookup.GetError());
+    if (inflight) {
+      inflight->Complete(response);
+    }
+    return response;
   }
 
   BlobApi::DataResponse storage_response;
+  std::string response_etag;
+  bool not_modified = false;
 
-  if (service == kBlobService) {
+  if (!is_volatile) {
     storage_response = BlobApi::GetBlob(
         storage_api_lookup.GetResult(), layer, data_handle.value(),
         request.GetBillingTag(), boost::none, context);
   } else {
     auto volatile_blob = VolatileBlobApi::GetVolatileBlob(
         storage_api_lookup.GetResult(), layer, data_handle.value(),
-        request.GetBillingTag(), context);
-    storage_response = BlobApi::DataResponse(volatile_blob.MoveResult());
+        request.GetBillingTag(), etag, context);
+    if (!volatile_blob.IsSuccessful()) {
+      storage_response = BlobApi::DataResponse(volatile_blob.GetError(),
+                                               volatile_blob.GetPayload());
+    } else {
+      auto blob = volatile_blob.MoveResult();
+      response_etag = std::move(blob.etag);
+      not_modified = blob.not_modified;
+      storage_response = BlobApi::DataResponse(
+          not_modified ? std::move(expired_data) : std::move(blob.data),
+          volatile_blob.GetPayload());
+    }
   }
 
-  if (storage_response.IsSuccessful() && fetch_option != OnlineOnly) {
-    repository.Put(storage_response.GetResult(), layer, data_handle.value());
+  // Only the verified data is cached, so the cache hits are not verified.
+  if (storage_response.IsSuccessful() && checksum &&
+      IsSha1Checksum(checksum.value()) &&
+      !MatchesSha1Checksum(storage_response.GetResult(), checksum.value())) {
+    OLP_SDK_LOG_WARNING_F(
+        kLogTag, "GetBlobData checksum mismatch, hrn='%s', key='%s'",
+        catalog_.ToCatalogHRNString().c_str(), data_handle->c_str());
+    storage_response = BlobApi::DataResponse(
+        client::ApiError(client::ErrorCode::Unknown, "Checksum mismatch"));
+  }
+
+  if (not_modified) {
+    OLP_SDK_LOG_DEBUG_F(
+        kLogTag, "GetBlobData not modified, hrn='%s', key='%s'",
+        catalog_.ToCatalogHRNString().c_str(), data_handle->c_str());
+    repository.Revalidate(layer, data_handle.value(), response_etag);
+  } else if (storage_response.IsSuccessful() && fetch_option != OnlineOnly) {
+    // The cost-aware cache eviction keeps the blobs that are slow to fetch.
+    cache::RefetchCostScope cost_scope(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - download_start));
+    if (is_volatile) {
+      repository.Put(storage_response.GetResult(), layer, data_handle.value(),
+                     response_etag);
+    } else {
+      repository.Put(storage_response.GetResult(), layer, data_handle.value());
+    }
   }
 
   if (!storage_response.IsSuccessful()) {
@@ -194,9 +362,118 @@ BlobApi::DataResponse DataRepository::GetBlobData(
     }
   }
 
+  if (inflight) {
+    inflight->Complete(storage_response);
+  }
+
   return storage_response;
 }
 
+DataStreamResponse DataRepository::StreamBlobData(
+    const std::string& layer, const DataRequest& request,
+    const DataChunkCallback& chunk_callback,
+    client::CancellationContext context,
+    const boost::optional<std::string>& checksum) {
+  const auto fetch_option = request.GetFetchOption();
+  const auto& data_handle = request.GetDataHandle();
+
+  if (!data_handle) {
+    return {{client::ErrorCode::PreconditionFailed, "Data handle is missing"}};
+  }
+
+  repository::DataCacheRepository repository(
+      catalog_, settings_.cache, settings_.default_cache_expiration);
+
+  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate) {
+    // The chunk callback only reads the data, so it is not copied out of the
+    // cache.
+    auto cached_data = repository.GetView(layer, data_handle.value());
+    if (cached_data) {
+      if (!cached_data.empty()) {
+        chunk_callback(cached_data.data(), 0u, cached_data.size());
+      }
+      return client::ApiNoResult{};
+    } else if (fetch_option == CacheOnly) {
+      OLP_SDK_LOG_INFO_F(
+          kLogTag, "StreamBlobData not found in cache, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle->c_str());
+      return {{client::ErrorCode::NotFound,
+               "CacheOnly: resource not found in cache"}};
+    }
+  }
+
+  auto storage_api_lookup = lookup_client_.LookupApi(
+      kBlobService, "v1", static_cast<client::FetchOptions>(fetch_option),
+      context);
+  if (!storage_api_lookup.IsSuccessful()) {
+    return storage_api_lookup.GetError();
+  }
+
+  // Only the verified data is collected. The data stored in the cache is
+  // written as it comes, so the cache does not need the whole blob in memory
+  // if it stores large values in separate files.
+  const bool store = fetch_option != OnlineOnly;
+  const bool verify = checksum && IsSha1Checksum(checksum.value());
+  model::Data collected;
+  if (verify) {
+    collected = std::make_shared<model::Data::element_type>();
+  }
+
+  std::unique_ptr<cache::KeyValueCache::ValueWriter> writer;
+  std::uint64_t written = 0u;
+
+  auto storage_response = BlobApi::StreamBlob(
+      storage_api_lookup.GetResult(), layer, data_handle.value(),
+      request.GetBillingTag(),
+      [&](const std::uint8_t* data, std::uint64_t offset, std::size_t length) {
+        // A retried request passes the blob again from the start.
+        if (collected) {
+          collected->resize(static_cast<size_t>(offset));
+          collected->insert(collected->end(), data, data + length);
+        } else if (store) {
+          if (offset == 0u) {
+            writer = repository.OpenWriter(layer, data_handle.value());
+            written = 0u;
+          }
+
+          if (writer && offset == written && writer->Append(data, length)) {
+            written += length;
+          } else {
+            writer.reset();
+          }
+        }
+        chunk_callback(data, offset, length);
+      },
+      context);
+
+  if (!storage_response.IsSuccessful()) {
+    const auto& error = storage_response.GetError();
+    if (error.GetHttpStatusCode() == http::HttpStatusCode::FORBIDDEN) {
+      OLP_SDK_LOG_WARNING_F(
+          kLogTag,
+          "StreamBlobData 403 received, remove from cache, hrn='%s', key='%s'",
+          catalog_.ToCatalogHRNString().c_str(), data_handle->c_str());
+      repository.Clear(layer, data_handle.value());
+    }
+    return error;
+  }
+
+  if (verify && !MatchesSha1Checksum(collected, checksum.value())) {
+    OLP_SDK_LOG_WARNING_F(
+        kLogTag, "StreamBlobData checksum mismatch, hrn='%s', key='%s'",
+        catalog_.ToCatalogHRNString().c_str(), data_handle->c_str());
+    return {{client::ErrorCode::Unknown, "Checksum mismatch"}};
+  }
+
+  if (store && collected) {
+    repository.Put(collected, layer, data_handle.value());
+  } else if (writer) {
+    writer->Commit();
+  }
+
+  return client::ApiNoResult{};
+}
+
 BlobApi::DataResponse DataRepository::GetVolatileData(
     const std::string& layer_id, const DataRequest& request,
     client::CancellationContext context) {
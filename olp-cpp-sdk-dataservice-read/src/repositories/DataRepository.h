@@ -19,6 +19,10 @@
 
 #pragma once
 
+#include <functional>
+#include <string>
+
+#include <boost/optional.hpp>
 #include <olp/core/client/ApiLookupClient.h>
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/CancellationToken.h>
@@ -37,6 +41,11 @@ namespace repository {
 
 class DataRepository final {
  public:
+  /// Gets the response of the download of another request, or `boost::none`
+  /// if the blob has to be downloaded again.
+  using SharedBlobCallback =
+      std::function<void(boost::optional<BlobApi::DataResponse>)>;
+
   DataRepository(client::HRN catalog, client::OlpClientSettings settings,
                  client::ApiLookupClient client);
 
@@ -49,16 +58,62 @@ class DataRepository final {
                                          int64_t version,
                                          client::CancellationContext context);
 
+  /// Gets the data like `GetVersionedData`, but does not block the thread
+  /// while another request downloads the same blob: returns `boost::none`
+  /// and reports the response of that download to `shared_callback` instead.
+  boost::optional<BlobApi::DataResponse> GetVersionedDataOrShare(
+      const std::string& layer_id, const DataRequest& request, int64_t version,
+      client::CancellationContext context,
+      SharedBlobCallback shared_callback);
+
   BlobApi::DataResponse GetVolatileData(const std::string& layer_id,
                                         const DataRequest& request,
                                         client::CancellationContext context);
 
-  BlobApi::DataResponse GetBlobData(const std::string& layer,
-                                    const std::string& service,
-                                    const DataRequest& request,
-                                    client::CancellationContext context);
+  /// Gets the blob from the cache or downloads it. The downloaded blob is
+  /// verified with the SHA-1 `checksum` when it is set.
+  BlobApi::DataResponse GetBlobData(
+      const std::string& layer, const std::string& service,
+      const DataRequest& request, client::CancellationContext context,
+      const boost::optional<std::string>& checksum = boost::none);
+
+  /// Passes the data of the version to `chunk_callback` as it is downloaded.
+  /// The data is collected for the cache only if it is stored there.
+  DataStreamResponse StreamVersionedData(
+      const std::string& layer_id, const DataRequest& request, int64_t version,
+      const DataChunkCallback& chunk_callback,
+      client::CancellationContext context);
 
  private:
+  /// Gets the data of the version, shares the download of another request as
+  /// `GetBlob` does.
+  boost::optional<BlobApi::DataResponse> GetVersionedBlob(
+      const std::string& layer_id, const DataRequest& request, int64_t version,
+      client::CancellationContext context,
+      const SharedBlobCallback* shared_callback);
+
+  /// Gets the blob like `GetBlobData`. If another request downloads the same
+  /// blob and `shared_callback` is set, registers it for the response of that
+  /// download and returns `boost::none`; otherwise, waits for that download.
+  boost::optional<BlobApi::DataResponse> GetBlob(
+      const std::string& layer, const std::string& service,
+      const DataRequest& request, client::CancellationContext context,
+      const boost::optional<std::string>& checksum,
+      const SharedBlobCallback* shared_callback);
+
+  /// Looks up the partition of the request in the version.
+  Response<model::Partition> GetVersionedPartition(
+      const std::string& layer_id, const DataRequest& request, int64_t version,
+      client::CancellationContext context);
+
+  /// Passes the blob to `chunk_callback` from the cache or as it is
+  /// downloaded.
+  DataStreamResponse StreamBlobData(
+      const std::string& layer, const DataRequest& request,
+      const DataChunkCallback& chunk_callback,
+      client::CancellationContext context,
+      const boost::optional<std::string>& checksum);
+
   client::HRN catalog_;
   client::OlpClientSettings settings_;
   client::ApiLookupClient lookup_client_;
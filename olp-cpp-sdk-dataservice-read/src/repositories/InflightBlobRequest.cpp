@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "InflightBlobRequest.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <olp/core/client/TaskContinuation.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+struct BlobFlight {
+  BlobFlight(const cache::KeyValueCache* cache, const client::HRN& catalog,
+             const std::string& layer, const std::string& data_handle)
+      : cache(cache),
+        catalog(catalog),
+        layer(layer),
+        data_handle(data_handle),
+        priority(std::make_shared<http::RequestPriorityHandle>(
+            http::RequestPriorityScope::GetCurrentPriority())) {}
+
+  const cache::KeyValueCache* const cache;
+  const client::HRN catalog;
+  const std::string layer;
+  const std::string data_handle;
+  const std::shared_ptr<http::RequestPriorityHandle> priority;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool done{false};
+  boost::optional<BlobApi::DataResponse> response;
+  /// The callbacks of the instances that do not block in `Wait`.
+  std::vector<InflightBlobRequest::CompletionCallback> callbacks;
+};
+
+namespace {
+
+using FlightPtr = std::shared_ptr<BlobFlight>;
+
+std::mutex gFlightsMutex;
+std::unordered_multimap<size_t, FlightPtr> gFlights;
+
+size_t Hash(const cache::KeyValueCache* cache, const std::string& layer,
+            const std::string& data_handle) {
+  size_t seed = std::hash<std::string>()(data_handle);
+  boost::hash_combine(seed, layer);
+  boost::hash_combine(seed, cache);
+  return seed;
+}
+
+}  // namespace
+
+InflightBlobRequest::InflightBlobRequest(const cache::KeyValueCache* cache,
+                                         const client::HRN& catalog,
+                                         const std::string& layer,
+                                         const std::string& data_handle)
+    : leader_{false} {
+  const auto hash = Hash(cache, layer, data_handle);
+
+  std::lock_guard<std::mutex> lock(gFlightsMutex);
+  auto range = gFlights.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const auto& flight = *it->second;
+    if (flight.data_handle == data_handle && flight.layer == layer &&
+        flight.cache == cache && flight.catalog == catalog) {
+      flight_ = it->second;
+      return;
+    }
+  }
+
+  flight_ = std::make_shared<BlobFlight>(cache, catalog, layer, data_handle);
+  leader_ = true;
+  gFlights.emplace(hash, flight_);
+}
+
+InflightBlobRequest::~InflightBlobRequest() {
+  if (leader_) {
+    Finish(boost::none);
+  }
+}
+
+bool InflightBlobRequest::IsLeader() const { return leader_; }
+
+std::shared_ptr<http::RequestPriorityHandle>
+InflightBlobRequest::GetPriorityHandle() const {
+  return flight_->priority;
+}
+
+boost::optional<BlobApi::DataResponse> InflightBlobRequest::Wait(
+    client::CancellationContext context) {
+  flight_->priority->Promote(http::RequestPriorityScope::GetCurrentPriority());
+
+  // The context cancels its token under its own lock, so the waiting
+  // predicate checks a flag instead of the context.
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+  auto flight = flight_;
+  if (!context.ExecuteOrCancelled([&]() {
+        return client::CancellationToken([cancelled, flight]() {
+          std::lock_guard<std::mutex> lock(flight->mutex);
+          cancelled->store(true);
+          flight->condition.notify_all();
+        });
+      })) {
+    return BlobApi::DataResponse(client::ApiError::Cancelled());
+  }
+
+  std::unique_lock<std::mutex> lock(flight_->mutex);
+  flight_->condition.wait(
+      lock, [&]() { return flight_->done || cancelled->load(); });
+
+  if (!flight_->done) {
+    return BlobApi::DataResponse(client::ApiError::Cancelled());
+  }
+  return flight_->response;
+}
+
+void InflightBlobRequest::OnComplete(client::CancellationContext context,
+                                     CompletionCallback callback) {
+  flight_->priority->Promote(http::RequestPriorityScope::GetCurrentPriority());
+
+  // Either the completion or the cancellation invokes the callback.
+  auto invoked = std::make_shared<std::atomic<bool>>(false);
+  CompletionCallback once =
+      [invoked, callback](boost::optional<BlobApi::DataResponse> response) {
+        if (!invoked->exchange(true)) {
+          callback(std::move(response));
+        }
+      };
+
+  {
+    std::unique_lock<std::mutex> lock(flight_->mutex);
+    if (!flight_->done) {
+      flight_->callbacks.push_back(once);
+      lock.unlock();
+
+      if (!context.ExecuteOrCancelled([&]() {
+            return client::CancellationToken([once]() {
+              once(BlobApi::DataResponse(client::ApiError::Cancelled()));
+            });
+          })) {
+        once(BlobApi::DataResponse(client::ApiError::Cancelled()));
+      }
+      return;
+    }
+  }
+
+  once(flight_->response);
+}
+
+void InflightBlobRequest::Complete(const BlobApi::DataResponse& response) {
+  if (!leader_) {
+    return;
+  }
+
+  // The errors may depend on the request, e.g. on the credentials or the
+  // cancellation, so the waiting instances download the blob themselves.
+  if (!response.IsSuccessful()) {
+    Finish(boost::none);
+  } else {
+    Finish(response);
+  }
+}
+
+void InflightBlobRequest::Finish(
+    boost::optional<BlobApi::DataResponse> response) {
+  leader_ = false;
+
+  {
+    std::lock_guard<std::mutex> lock(gFlightsMutex);
+    auto range =
+        gFlights.equal_range(
+            Hash(flight_->cache, flight_->layer, flight_->data_handle));
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == flight_) {
+        gFlights.erase(it);
+        break;
+      }
+    }
+  }
+
+  std::vector<CompletionCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(flight_->mutex);
+    flight_->response = std::move(response);
+    flight_->done = true;
+    callbacks.swap(flight_->callbacks);
+    flight_->condition.notify_all();
+  }
+
+  // The leader completes the flight from its own stage, the stages of the
+  // waiting requests are scheduled instead of running inline after it.
+  client::detail::TaskStageScope outside_stage(false);
+  for (const auto& callback : callbacks) {
+    callback(flight_->response);
+  }
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/http/RequestPriorityScope.h>
+#include "generated/api/BlobApi.h"
+
+namespace olp {
+namespace cache {
+class KeyValueCache;
+}
+namespace dataservice {
+namespace read {
+namespace repository {
+
+struct BlobFlight;
+
+/**
+ * @brief Shares a blob download with the concurrent requests of the same blob.
+ *
+ * The first instance created for a blob is the leader: it downloads the blob
+ * and completes the flight with the response. The instances created while the
+ * flight is in progress attach to it and wait for that response instead of
+ * downloading the blob again. The flights are looked up by a hash of the layer
+ * and the data handle, so no key string is built per request.
+ *
+ * Only the requests that use the same cache share a flight: the leader writes
+ * the blob to that cache, and the clients with other caches may use other
+ * credentials. Only the successful responses are shared, the waiting
+ * instances retry the failed downloads themselves.
+ *
+ * The waiting instances promote the download to their own priority, so an
+ * interactive request does not wait behind the queued request of a prefetch.
+ *
+ * `OnComplete` attaches to the flight without blocking the thread, `Wait`
+ * blocks it and is left to the synchronous callers.
+ */
+class InflightBlobRequest final {
+ public:
+  /// Gets the response of the leader, or `boost::none` if the leader
+  /// completed without a response and the blob has to be downloaded again.
+  using CompletionCallback =
+      std::function<void(boost::optional<BlobApi::DataResponse>)>;
+
+  InflightBlobRequest(const cache::KeyValueCache* cache,
+                      const client::HRN& catalog, const std::string& layer,
+                      const std::string& data_handle);
+
+  InflightBlobRequest(const InflightBlobRequest&) = delete;
+  InflightBlobRequest(InflightBlobRequest&&) = delete;
+  InflightBlobRequest& operator=(const InflightBlobRequest&) = delete;
+  InflightBlobRequest& operator=(InflightBlobRequest&&) = delete;
+
+  /// Completes the flight without a response if the leader did not.
+  ~InflightBlobRequest();
+
+  /// Checks whether this instance has to download the blob.
+  bool IsLeader() const;
+
+  /// Gets the priority handle the leader downloads the blob with.
+  std::shared_ptr<http::RequestPriorityHandle> GetPriorityHandle() const;
+
+  /**
+   * @brief Waits for the response of the leader.
+   *
+   * Raises the priority of the download to the priority of the current
+   * thread.
+   *
+   * @param context The `CancellationContext` of the waiting request.
+   *
+   * @return The response of the leader, the cancellation error if the
+   * context is cancelled, or `boost::none` if the leader completed without a
+   * response and the blob has to be downloaded by the caller.
+   */
+  boost::optional<BlobApi::DataResponse> Wait(
+      client::CancellationContext context);
+
+  /**
+   * @brief Registers the callback for the response of the leader.
+   *
+   * Unlike `Wait`, does not block the thread. The callback is invoked once:
+   * inline if the flight is already completed, from the thread of the leader
+   * that completes it, or with the cancellation error from the thread that
+   * cancels the context. Raises the priority of the download to the priority
+   * of the current thread.
+   *
+   * @param context The `CancellationContext` of the waiting request.
+   * @param callback Gets the response of the leader.
+   */
+  void OnComplete(client::CancellationContext context,
+                  CompletionCallback callback);
+
+  /**
+   * @brief Shares the response with the waiting instances.
+   *
+   * The failed and cancelled responses are not shared, the waiting instances
+   * download the blob themselves.
+   *
+   * @param response The response of the blob download.
+   */
+  void Complete(const BlobApi::DataResponse& response);
+
+ private:
+  void Finish(boost::optional<BlobApi::DataResponse> response);
+
+  std::shared_ptr<BlobFlight> flight_;
+  bool leader_;
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
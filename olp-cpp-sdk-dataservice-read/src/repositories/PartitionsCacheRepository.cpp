@@ -20,23 +20,19 @@
 #include "PartitionsCacheRepository.h"
 
 #include <algorithm>
+#include <cstdlib>
+#include <ctime>
 #include <limits>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/logging/Log.h>
-// clang-format off
-#include "generated/parser/PartitionsParser.h"
-#include "generated/parser/LayerVersionsParser.h"
-#include "JsonResultParser.h"
-#include <olp/core/generated/parser/JsonParser.h>
-#include <olp/core/generated/serializer/SerializerWrapper.h>
-#include "generated/serializer/PartitionsSerializer.h"
-#include "generated/serializer/LayerVersionsSerializer.h"
-#include "generated/serializer/JsonSerializer.h"
-// clang-format on
+#include "BinaryCacheFormat.h"
+#include "QuadTreeIndexCache.h"
 
 namespace {
 constexpr auto kLogTag = "PartitionsCacheRepository";
@@ -44,19 +40,28 @@ constexpr auto kChronoSecondsMax = std::chrono::seconds::max();
 constexpr auto kTimetMax = std::numeric_limits<time_t>::max();
 constexpr auto kMaxQuadTreeIndexDepth = 4u;
 
-std::string CreateKey(const std::string& hrn, const std::string& layer_id,
-                      const std::string& partitionId,
+using olp::dataservice::read::repository::CacheKeyBuilder;
+
+std::string CreateKey(const CacheKeyBuilder& layer,
+                      const std::string& partition_id,
                       const boost::optional<int64_t>& version) {
-  return hrn + "::" + layer_id + "::" + partitionId +
-         "::" + (version ? std::to_string(*version) + "::" : "") + "partition";
+  return layer.Key({partition_id, version, "partition"});
 }
-std::string CreateKey(const std::string& hrn, const std::string& layer_id,
+std::string CreateKey(const CacheKeyBuilder& layer,
                       const boost::optional<int64_t>& version) {
-  return hrn + "::" + layer_id +
-         "::" + (version ? std::to_string(*version) + "::" : "") + "partitions";
+  return layer.Key({version, "partitions"});
+}
+std::string CreatePageKey(const CacheKeyBuilder& layer,
+                          const boost::optional<int64_t>& version,
+                          const std::string& page) {
+  return layer.Key({version, "partitions", "page", page});
+}
+std::string CreateVolatileSyncKey(const CacheKeyBuilder& layer) {
+  return layer.Key({"partitions", "sync"});
 }
-std::string CreateKey(const std::string& hrn, const int64_t catalogVersion) {
-  return hrn + "::" + std::to_string(catalogVersion) + "::layerVersions";
+std::string CreateKey(const CacheKeyBuilder& catalog,
+                      const int64_t catalog_version) {
+  return catalog.Key({catalog_version, "layerVersions"});
 }
 
 time_t ConvertTime(std::chrono::seconds time) {
@@ -74,6 +79,8 @@ PartitionsCacheRepository::PartitionsCacheRepository(
     std::chrono::seconds default_expiry)
     : catalog_(catalog.ToCatalogHRNString()),
       layer_id_(layer_id),
+      catalog_keys_(catalog_),
+      layer_keys_(catalog_ + "::" + layer_id_),
       cache_(cache),
       default_expiry_(ConvertTime(default_expiry)) {}
 
@@ -81,18 +88,32 @@ void PartitionsCacheRepository::Put(const model::Partitions& partitions,
                                     const boost::optional<int64_t>& version,
                                     const boost::optional<time_t>& expiry,
                                     bool layer_metadata) {
+  PutPartitions(partitions, version, expiry,
+                layer_metadata ? CreateKey(layer_keys_, version)
+                               : std::string());
+}
+
+void PartitionsCacheRepository::PutPartitions(
+    const model::Partitions& partitions,
+    const boost::optional<int64_t>& version,
+    const boost::optional<time_t>& expiry, const std::string& list_key) {
+  const bool layer_metadata = !list_key.empty();
   const auto& partitions_list = partitions.GetPartitions();
   std::vector<std::string> partition_ids;
   partition_ids.reserve(partitions_list.size());
 
+  cache::KeyValueCache::KeyEncodedValueListType items;
+  items.reserve(partitions_list.size() + 1);
+
   for (const auto& partition : partitions_list) {
     auto key =
-        CreateKey(catalog_, layer_id_, partition.GetPartition(), version);
+        CreateKey(layer_keys_, partition.GetPartition(), version);
     OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
 
-    cache_->Put(key, partition,
-                [&]() { return serializer::serialize(partition); },
-                expiry.get_value_or(default_expiry_));
+    items.emplace_back(
+        std::move(key),
+        cache::KeyValueCache::EncodedValue{
+            partition, [&]() { return binary::Serialize(partition); }});
 
     if (layer_metadata) {
       partition_ids.push_back(partition.GetPartition());
@@ -100,34 +121,48 @@ void PartitionsCacheRepository::Put(const model::Partitions& partitions,
   }
 
   if (layer_metadata) {
-    auto key = CreateKey(catalog_, layer_id_, version);
-    OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
+    OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", list_key.c_str());
 
-    cache_->Put(key, partition_ids,
-                [&]() { return serializer::serialize(partition_ids); },
-                expiry.get_value_or(default_expiry_));
+    items.emplace_back(
+        list_key,
+        cache::KeyValueCache::EncodedValue{
+            partition_ids,
+            [&]() { return binary::Serialize(partition_ids); }});
   }
+
+  // All partitions are written with a single cache operation.
+  cache_->PutBatch(items, expiry.get_value_or(default_expiry_));
 }
 
 model::Partitions PartitionsCacheRepository::Get(
     const std::vector<std::string>& partition_ids,
-    const boost::optional<int64_t>& version) {
+    const boost::optional<int64_t>& version,
+    std::vector<std::string>* missing_ids) {
   model::Partitions cached_partitions_model;
   auto& cached_partitions = cached_partitions_model.GetMutablePartitions();
   cached_partitions.reserve(partition_ids.size());
 
+  cache::KeyValueCache::KeyListType keys;
+  keys.reserve(partition_ids.size());
   for (const auto& partition_id : partition_ids) {
-    auto key = CreateKey(catalog_, layer_id_, partition_id, version);
-    OLP_SDK_LOG_DEBUG_F(kLogTag, "Get '%s'", key.c_str());
+    keys.push_back(CreateKey(layer_keys_, partition_id, version));
+  }
 
-    auto cached_partition =
-        cache_->Get(key, [](const std::string& serialized_object) {
-          return parser::parse<model::Partition>(serialized_object);
-        });
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "GetBatch, hrn='%s', layer='%s', keys=%zu",
+                      catalog_.c_str(), layer_id_.c_str(), keys.size());
 
+  auto cached_values =
+      cache_->GetBatch(keys, [](const std::string& serialized_object) {
+        return binary::Parse<model::Partition>(serialized_object);
+      });
+
+  for (size_t index = 0; index < cached_values.size(); ++index) {
+    auto& cached_partition = cached_values[index];
     if (!cached_partition.empty()) {
       cached_partitions.emplace_back(
-          boost::any_cast<model::Partition>(cached_partition));
+          std::move(boost::any_cast<model::Partition&>(cached_partition)));
+    } else if (missing_ids && index < partition_ids.size()) {
+      missing_ids->push_back(partition_ids[index]);
     }
   }
 
@@ -137,22 +172,12 @@ model::Partitions PartitionsCacheRepository::Get(
 
 boost::optional<model::Partitions> PartitionsCacheRepository::Get(
     const PartitionsRequest& request, const boost::optional<int64_t>& version) {
-  auto key = CreateKey(catalog_, layer_id_, version);
+  auto key = CreateKey(layer_keys_, version);
   boost::optional<model::Partitions> partitions;
   const auto& partition_ids = request.GetPartitionIds();
 
   if (partition_ids.empty()) {
-    auto cached_ids = cache_->Get(key, [](const std::string& serialized_ids) {
-      return parser::parse<std::vector<std::string>>(serialized_ids);
-    });
-
-    partitions =
-        cached_ids.empty()
-            ? boost::none
-            : boost::optional<model::Partitions>(
-                  Get(boost::any_cast<std::vector<std::string>>(cached_ids),
-                      version));
-
+    partitions = GetList(key, version);
   } else {
     auto available_partitions = Get(partition_ids, version);
     // In the case when not all partitions are available, we fail the cache
@@ -167,24 +192,199 @@ boost::optional<model::Partitions> PartitionsCacheRepository::Get(
   return partitions;
 }
 
+void PartitionsCacheRepository::PutPage(
+    const model::Partitions& partitions, size_t page,
+    const boost::optional<int64_t>& version,
+    const boost::optional<time_t>& expiry) {
+  PutPartitions(partitions, version, expiry,
+                CreatePageKey(layer_keys_, version, std::to_string(page)));
+}
+
+void PartitionsCacheRepository::PutPagesCount(
+    size_t count, const boost::optional<int64_t>& version,
+    const boost::optional<time_t>& expiry) {
+  const auto key = CreatePageKey(layer_keys_, version, "count");
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
+
+  cache_->Put(key, count, [&]() { return std::to_string(count); },
+              expiry.get_value_or(default_expiry_));
+}
+
+boost::optional<size_t> PartitionsCacheRepository::GetPagesCount(
+    const boost::optional<int64_t>& version) {
+  const auto key = CreatePageKey(layer_keys_, version, "count");
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Get -> '%s'", key.c_str());
+
+  auto cached_count = cache_->Get(key, [](const std::string& value) {
+    return static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+  });
+
+  if (cached_count.empty()) {
+    return boost::none;
+  }
+
+  return boost::any_cast<size_t>(cached_count);
+}
+
+bool PartitionsCacheRepository::ContainsPages(
+    size_t count, const boost::optional<int64_t>& version) {
+  for (size_t page = 0; page < count; ++page) {
+    if (!cache_->Contains(
+            CreatePageKey(layer_keys_, version, std::to_string(page)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+boost::optional<model::Partitions> PartitionsCacheRepository::GetPage(
+    size_t page, const boost::optional<int64_t>& version) {
+  const auto key = CreatePageKey(layer_keys_, version, std::to_string(page));
+  auto cached_ids = cache_->Get(key, [](const std::string& serialized_ids) {
+    return binary::Parse<std::vector<std::string>>(serialized_ids);
+  });
+
+  if (cached_ids.empty()) {
+    return boost::none;
+  }
+
+  // A page with an evicted partition is incomplete.
+  std::vector<std::string> missing_ids;
+  auto partitions =
+      Get(boost::any_cast<std::vector<std::string>>(cached_ids), version,
+          &missing_ids);
+  if (!missing_ids.empty()) {
+    return boost::none;
+  }
+
+  return partitions;
+}
+
+boost::optional<model::Partitions> PartitionsCacheRepository::GetList(
+    const std::string& list_key, const boost::optional<int64_t>& version) {
+  auto cached_ids =
+      cache_->Get(list_key, [](const std::string& serialized_ids) {
+        return binary::Parse<std::vector<std::string>>(serialized_ids);
+      });
+
+  if (cached_ids.empty()) {
+    return boost::none;
+  }
+
+  return Get(boost::any_cast<std::vector<std::string>>(cached_ids), version);
+}
+
+void PartitionsCacheRepository::PutVolatileSync(int64_t version,
+                                                time_t expiry) {
+  const auto key = CreateVolatileSyncKey(layer_keys_);
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
+
+  // Holds the expiry of the list and the metadata version, the list itself
+  // is kept past the expiry to be updated with the changes.
+  const auto value =
+      std::to_string(std::time(nullptr) + expiry) + " " +
+      std::to_string(version);
+  cache_->Put(key, value, [&]() { return value; }, kTimetMax);
+}
+
+boost::optional<PartitionsCacheRepository::VolatileSync>
+PartitionsCacheRepository::GetVolatileSync() {
+  auto value = cache_->Get(CreateVolatileSyncKey(layer_keys_),
+                           [](const std::string& value) { return value; });
+  if (value.empty()) {
+    return boost::none;
+  }
+
+  const auto sync = boost::any_cast<std::string>(value);
+  char* end = nullptr;
+  const auto expiry = static_cast<time_t>(std::strtoll(sync.c_str(), &end, 10));
+  if (*end != ' ') {
+    return boost::none;
+  }
+
+  return VolatileSync{std::strtoll(end + 1, nullptr, 10),
+                      std::time(nullptr) >= expiry};
+}
+
+boost::optional<model::Partitions>
+PartitionsCacheRepository::ApplyVolatileChanges(
+    const model::Partitions& changes) {
+  const auto list_key = CreateKey(layer_keys_, boost::none);
+  auto cached = GetList(list_key, boost::none);
+  if (!cached) {
+    return boost::none;
+  }
+
+  auto& partitions = cached->GetMutablePartitions();
+  std::unordered_map<std::string, size_t> indices;
+  indices.reserve(partitions.size());
+  for (size_t index = 0; index < partitions.size(); ++index) {
+    indices.emplace(partitions[index].GetPartition(), index);
+  }
+
+  // Only the changed partitions and the list are written.
+  model::Partitions changed;
+  std::unordered_set<std::string> removed;
+  for (const auto& partition : changes.GetPartitions()) {
+    const auto& id = partition.GetPartition();
+    auto it = indices.find(id);
+    if (partition.GetDataHandle().empty()) {
+      if (it != indices.end()) {
+        removed.insert(id);
+        cache_->Remove(CreateKey(layer_keys_, id, boost::none));
+      }
+      continue;
+    }
+
+    if (it != indices.end()) {
+      partitions[it->second] = partition;
+    } else {
+      indices.emplace(id, partitions.size());
+      partitions.push_back(partition);
+    }
+    changed.GetMutablePartitions().push_back(partition);
+  }
+
+  if (!removed.empty()) {
+    partitions.erase(
+        std::remove_if(partitions.begin(), partitions.end(),
+                       [&](const model::Partition& partition) {
+                         return removed.count(partition.GetPartition()) > 0u;
+                       }),
+        partitions.end());
+  }
+
+  std::vector<std::string> partition_ids;
+  partition_ids.reserve(partitions.size());
+  for (const auto& partition : partitions) {
+    partition_ids.push_back(partition.GetPartition());
+  }
+
+  PutPartitions(changed, boost::none, kTimetMax, std::string());
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", list_key.c_str());
+  cache_->Put(list_key, partition_ids,
+              [&]() { return binary::Serialize(partition_ids); }, kTimetMax);
+  return cached;
+}
+
 void PartitionsCacheRepository::Put(
     int64_t catalog_version, const model::LayerVersions& layer_versions) {
-  const auto key = CreateKey(catalog_, catalog_version);
+  const auto key = CreateKey(catalog_keys_, catalog_version);
   OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
 
   cache_->Put(key, layer_versions,
-              [&]() { return serializer::serialize(layer_versions); },
+              [&]() { return binary::Serialize(layer_versions); },
               default_expiry_);
 }
 
 boost::optional<model::LayerVersions> PartitionsCacheRepository::Get(
     int64_t catalog_version) {
-  auto key = CreateKey(catalog_, catalog_version);
+  auto key = CreateKey(catalog_keys_, catalog_version);
   OLP_SDK_LOG_DEBUG_F(kLogTag, "Get -> '%s'", key.c_str());
 
   auto cached_layer_versions =
       cache_->Get(key, [](const std::string& serialized_object) {
-        return parser::parse<model::LayerVersions>(serialized_object);
+        return binary::Parse<model::LayerVersions>(serialized_object);
       });
 
   if (cached_layer_versions.empty()) {
@@ -224,8 +424,11 @@ bool PartitionsCacheRepository::Get(geo::TileKey tile_key, int32_t depth,
 }
 
 void PartitionsCacheRepository::Clear() {
-  auto key = catalog_ + "::" + layer_id_ + "::";
+  auto key = layer_keys_.Prefix() + "::";
   OLP_SDK_LOG_INFO_F(kLogTag, "Clear -> '%s'", key.c_str());
+  if (auto memory_cache = QuadTreeIndexCache::Lookup(cache_.get())) {
+    memory_cache->Erase(catalog_, layer_id_);
+  }
   cache_->RemoveKeysWithPrefix(key);
 }
 
@@ -237,10 +440,8 @@ void PartitionsCacheRepository::ClearPartitions(
 
   // Partitions not processed here are not cached to begin with.
   for (auto partition : cached_partitions.GetPartitions()) {
-    cache_->RemoveKeysWithPrefix(catalog_ + "::" + layer_id_ +
-                                 "::" + partition.GetDataHandle());
-    cache_->RemoveKeysWithPrefix(catalog_ + "::" + layer_id_ +
-                                 "::" + partition.GetPartition());
+    cache_->RemoveKeysWithPrefix(layer_keys_.Key({partition.GetDataHandle()}));
+    cache_->RemoveKeysWithPrefix(layer_keys_.Key({partition.GetPartition()}));
   }
 }
 
@@ -249,6 +450,12 @@ bool PartitionsCacheRepository::ClearQuadTree(
     const boost::optional<int64_t>& version) {
   const auto key = CreateQuadKey(tile_key, depth, version);
   OLP_SDK_LOG_INFO_F(kLogTag, "ClearQuadTree -> '%s'", key.c_str());
+  auto memory_cache = QuadTreeIndexCache::Lookup(cache_.get());
+  if (memory_cache && version) {
+    memory_cache->Erase(catalog_, layer_id_, *version, tile_key);
+  } else if (memory_cache) {
+    memory_cache->Erase(catalog_, layer_id_);
+  }
   return cache_->RemoveKeysWithPrefix(key);
 }
 
@@ -256,12 +463,12 @@ bool PartitionsCacheRepository::ClearPartitionMetadata(
     const std::string& partition_id,
     const boost::optional<int64_t>& catalog_version,
     boost::optional<model::Partition>& out_partition) {
-  auto key = CreateKey(catalog_, layer_id_, partition_id, catalog_version);
+  auto key = CreateKey(layer_keys_, partition_id, catalog_version);
   OLP_SDK_LOG_INFO_F(kLogTag, "ClearPartitionMetadata -> '%s'", key.c_str());
 
   auto cached_partition =
       cache_->Get(key, [](const std::string& serialized_object) {
-        return parser::parse<model::Partition>(serialized_object);
+        return binary::Parse<model::Partition>(serialized_object);
       });
 
   if (cached_partition.empty()) {
@@ -275,11 +482,11 @@ bool PartitionsCacheRepository::ClearPartitionMetadata(
 bool PartitionsCacheRepository::GetPartitionHandle(
     const std::string& partition_id,
     const boost::optional<int64_t>& catalog_version, std::string& data_handle) {
-  auto key = CreateKey(catalog_, layer_id_, partition_id, catalog_version);
+  auto key = CreateKey(layer_keys_, partition_id, catalog_version);
   OLP_SDK_LOG_DEBUG_F(kLogTag, "IsPartitionCached -> '%s'", key.c_str());
   auto cached_partition =
       cache_->Get(key, [](const std::string& serialized_object) {
-        return parser::parse<model::Partition>(serialized_object);
+        return binary::Parse<model::Partition>(serialized_object);
       });
 
   if (cached_partition.empty()) {
@@ -293,9 +500,8 @@ bool PartitionsCacheRepository::GetPartitionHandle(
 std::string PartitionsCacheRepository::CreateQuadKey(
     geo::TileKey key, int32_t depth,
     const boost::optional<int64_t>& version) const {
-  return catalog_ + "::" + layer_id_ + "::" + key.ToHereTile() +
-         "::" + (version ? std::to_string(*version) + "::" : "") +
-         std::to_string(depth) + "::quadtree";
+  return layer_keys_.Key(
+      {key.ToHereTile(), version, static_cast<int64_t>(depth), "quadtree"});
 }
 
 bool PartitionsCacheRepository::FindQuadTree(geo::TileKey key,
@@ -26,6 +26,7 @@
 #include <olp/dataservice/read/PartitionsRequest.h>
 #include <olp/dataservice/read/model/Partitions.h>
 #include <boost/optional.hpp>
+#include "CacheKeyBuilder.h"
 #include "QuadTreeIndex.h"
 #include "generated/model/LayerVersions.h"
 
@@ -50,13 +51,55 @@ class PartitionsCacheRepository final {
            const boost::optional<int64_t>& version,
            const boost::optional<time_t>& expiry, bool layer_metadata = false);
 
+  /// Gets the cached partitions with a single cache operation, and adds the
+  /// IDs that are not cached to `missing_ids` if it is set.
   model::Partitions Get(const std::vector<std::string>& partition_ids,
-                        const boost::optional<int64_t>& version);
+                        const boost::optional<int64_t>& version,
+                        std::vector<std::string>* missing_ids = nullptr);
 
   boost::optional<model::Partitions> Get(
       const PartitionsRequest& request,
       const boost::optional<int64_t>& version);
 
+  /// Puts one page of a streamed partitions list. The pages are numbered
+  /// from 0, and `PutPagesCount` completes the list.
+  void PutPage(const model::Partitions& partitions, size_t page,
+               const boost::optional<int64_t>& version,
+               const boost::optional<time_t>& expiry);
+
+  void PutPagesCount(size_t count, const boost::optional<int64_t>& version,
+                     const boost::optional<time_t>& expiry);
+
+  boost::optional<size_t> GetPagesCount(
+      const boost::optional<int64_t>& version);
+
+  /// Checks whether the first `count` pages are cached.
+  bool ContainsPages(size_t count, const boost::optional<int64_t>& version);
+
+  /// Gets a page, or `boost::none` if the page or one of its partitions is
+  /// not cached.
+  boost::optional<model::Partitions> GetPage(
+      size_t page, const boost::optional<int64_t>& version);
+
+  /// The metadata version the cached volatile partitions are synchronized
+  /// with.
+  struct VolatileSync {
+    int64_t version;
+    bool expired;
+  };
+
+  /// Puts the metadata version of the cached volatile partitions, they are
+  /// refreshed with the changes since this version after `expiry`.
+  void PutVolatileSync(int64_t version, time_t expiry);
+
+  boost::optional<VolatileSync> GetVolatileSync();
+
+  /// Updates the cached volatile partitions list with the changed partitions,
+  /// the partitions with an empty data handle are removed. Returns the updated
+  /// list, or `boost::none` if the list is not cached.
+  boost::optional<model::Partitions> ApplyVolatileChanges(
+      const model::Partitions& changes);
+
   void Put(int64_t catalog_version, const model::LayerVersions& layer_versions);
 
   boost::optional<model::LayerVersions> Get(int64_t catalog_version);
@@ -93,8 +136,19 @@ class PartitionsCacheRepository final {
                     const boost::optional<int64_t>& version) const;
 
  private:
+  /// Puts the partitions, and their IDs under `list_key` if it is not empty.
+  void PutPartitions(const model::Partitions& partitions,
+                     const boost::optional<int64_t>& version,
+                     const boost::optional<time_t>& expiry,
+                     const std::string& list_key);
+
+  boost::optional<model::Partitions> GetList(
+      const std::string& list_key, const boost::optional<int64_t>& version);
+
   const std::string catalog_;
   const std::string layer_id_;
+  const CacheKeyBuilder catalog_keys_;
+  const CacheKeyBuilder layer_keys_;
   std::shared_ptr<cache::KeyValueCache> cache_;
   time_t default_expiry_;
 };
@@ -20,14 +20,21 @@
 #include "PartitionsRepository.h"
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 
 #include <boost/functional/hash.hpp>
 
 #include <olp/core/client/Condition.h>
+#include <olp/core/client/Tracer.h>
 #include <olp/core/logging/Log.h>
 #include "CatalogRepository.h"
 #include "NamedMutex.h"
+#include "PartitionsStreamParser.h"
 #include "generated/api/MetadataApi.h"
 #include "generated/api/QueryApi.h"
 #include "olp/dataservice/read/CatalogRequest.h"
@@ -36,6 +43,11 @@
 #include "olp/dataservice/read/PartitionsRequest.h"
 #include "olp/dataservice/read/TileRequest.h"
 
+// clang-format off
+#include "generated/parser/PartitionsParser.h"
+#include "JsonResultParser.h"
+// clang-format on
+
 namespace {
 namespace client = olp::client;
 namespace read = olp::dataservice::read;
@@ -44,28 +56,32 @@ namespace repository = olp::dataservice::read::repository;
 
 constexpr auto kLogTag = "PartitionsRepository";
 constexpr auto kAggregateQuadTreeDepth = 4;
+constexpr uint64_t kDefaultPartitionsPageSize = 4u * 1024u * 1024u;
+// The query service accepts up to 100 partition IDs in one request.
+constexpr size_t kMaxPartitionsPerQuery = 100u;
+constexpr size_t kMaxParallelQueries = 4u;
+constexpr auto kTimetMax = std::numeric_limits<time_t>::max();
+constexpr int64_t kUnknownMetadataVersion = -1;
 
 using LayerVersionReponse = client::ApiResponse<int64_t, client::ApiError>;
 using LayerVersionCallback = std::function<void(LayerVersionReponse)>;
 
 client::ApiResponse<boost::optional<time_t>, client::ApiError> TtlForLayer(
-    const std::vector<model::Layer>& layers, const std::string& layer_id) {
-  auto layer_it = std::find_if(
-      std::begin(layers), std::end(layers),
-      [&](const model::Layer& layer) { return layer.GetId() == layer_id; });
-
-  if (layer_it == std::end(layers)) {
+    const repository::CatalogSnapshot& catalog, const std::string& layer_id) {
+  const auto* layer = catalog.FindLayer(layer_id);
+  if (!layer) {
     return client::ApiError(client::ErrorCode::NotFound,
                             "Layer specified doesn't exist");
   }
 
-  auto ttl = layer_it->GetTtl();
+  auto ttl = layer->GetTtl();
 
   return ttl ? boost::make_optional<time_t>(ttl.value() / 1000) : boost::none;
 }
 
 repository::PartitionResponse FindPartition(
-    const read::QuadTreeIndex& quad_tree, const read::TileRequest& request,
+    const repository::DecodedQuadTreeIndex& quad_tree,
+    const read::TileRequest& request,
     bool aggregated) {
   const auto& tile_key = request.GetTileKey();
 
@@ -94,6 +110,34 @@ repository::PartitionResponse FindPartition(
   return std::move(aggregated_partition);
 }
 
+/// Merges the partitions found in the cache and online in the order of the
+/// requested IDs.
+model::Partitions MergePartitions(const std::vector<std::string>& ids,
+                                  model::Partitions cached,
+                                  model::Partitions fetched) {
+  std::unordered_map<std::string, model::Partition> index;
+  index.reserve(cached.GetPartitions().size() +
+                fetched.GetPartitions().size());
+  for (auto* partitions : {&cached, &fetched}) {
+    for (auto& partition : partitions->GetMutablePartitions()) {
+      auto id = partition.GetPartition();
+      index.emplace(std::move(id), std::move(partition));
+    }
+  }
+
+  model::Partitions result;
+  auto& merged = result.GetMutablePartitions();
+  merged.reserve(index.size());
+  for (const auto& id : ids) {
+    auto it = index.find(id);
+    if (it != index.end()) {
+      merged.emplace_back(std::move(it->second));
+      index.erase(it);
+    }
+  }
+  return result;
+}
+
 std::string HashPartitions(
     const read::PartitionsRequest::PartitionIds& partitions) {
   size_t seed = 0;
@@ -128,6 +172,140 @@ PartitionsRepository::GetVersionedPartitionsExtendedResponse(
   return GetPartitionsExtendedResponse(request, version, std::move(context));
 }
 
+PartitionsStreamResponse PartitionsRepository::StreamVersionedPartitions(
+    const PartitionsRequest& request, std::int64_t version,
+    const PartitionsChunkCallback& chunk_callback,
+    client::CancellationContext context) {
+  const auto fetch_option = request.GetFetchOption();
+  const auto catalog_str = catalog_.ToCatalogHRNString();
+
+  if (!request.GetPartitionIds().empty()) {
+    // The partitions requested by ID are few, so they are sent as one chunk.
+    auto response = GetPartitions(request, version, std::move(context));
+    if (!response.IsSuccessful()) {
+      return response.GetError();
+    }
+    chunk_callback(response.MoveResult());
+    return client::ApiNoResult();
+  }
+
+  // The number of partitions already passed to the callback from the cache.
+  // The list of a version does not change, so the download skips them.
+  size_t delivered = 0u;
+
+  if (fetch_option != OnlineOnly) {
+    auto pages_count = cache_.GetPagesCount(version);
+    if (pages_count && !cache_.ContainsPages(*pages_count, version)) {
+      // The evicted pages are downloaded again, and the count is updated
+      // when the download completes.
+      pages_count = boost::none;
+    }
+
+    if (pages_count) {
+      OLP_SDK_LOG_DEBUG_F(kLogTag,
+                          "StreamPartitions found in cache, hrn='%s', "
+                          "layer='%s', pages=%zu",
+                          catalog_str.c_str(), layer_id_.c_str(),
+                          *pages_count);
+      size_t page = 0u;
+      for (; page < *pages_count; ++page) {
+        if (context.IsCancelled()) {
+          return client::ApiError::Cancelled();
+        }
+
+        auto partitions = cache_.GetPage(page, version);
+        if (!partitions) {
+          break;
+        }
+        delivered += partitions->GetPartitions().size();
+        chunk_callback(std::move(*partitions));
+      }
+
+      if (page == *pages_count) {
+        return client::ApiNoResult();
+      }
+
+      OLP_SDK_LOG_DEBUG_F(kLogTag,
+                          "StreamPartitions page is evicted, hrn='%s', "
+                          "layer='%s', page=%zu",
+                          catalog_str.c_str(), layer_id_.c_str(), page);
+    }
+
+    if (fetch_option == CacheOnly) {
+      return {{client::ErrorCode::NotFound,
+               "CacheOnly: resource not found in cache"}};
+    }
+  }
+
+  auto metadata_api = lookup_client_.LookupApi(
+      "metadata", "v1", static_cast<client::FetchOptions>(fetch_option),
+      context);
+  if (!metadata_api.IsSuccessful()) {
+    return metadata_api.GetError();
+  }
+
+  const auto page_size = settings_.download_chunk_size > 0u
+                             ? settings_.download_chunk_size
+                             : kDefaultPartitionsPageSize;
+
+  model::Partitions chunk;
+  PartitionsStreamParser stream_parser([&](const std::string& json) {
+    chunk.GetMutablePartitions().emplace_back(
+        parser::parse<model::Partition>(json));
+  });
+
+  uint64_t offset = 0u;
+  size_t pages_count = 0u;
+  while (!stream_parser.IsComplete()) {
+    auto response = MetadataApi::GetPartitionsPage(
+        metadata_api.GetResult(), layer_id_, version,
+        request.GetAdditionalFields(), offset, page_size,
+        request.GetBillingTag(), context);
+
+    if (!response.IsSuccessful()) {
+      const auto& error = response.GetError();
+      if (error.GetHttpStatusCode() == http::HttpStatusCode::FORBIDDEN) {
+        OLP_SDK_LOG_WARNING_F(kLogTag,
+                              "StreamPartitions 403 received, remove from "
+                              "cache, hrn='%s', layer='%s'",
+                              catalog_str.c_str(), layer_id_.c_str());
+        cache_.Clear();
+      }
+      return error;
+    }
+
+    const auto& data = response.GetResult().data;
+    if (data.empty() || !stream_parser.Feed(data.data(), data.size())) {
+      return {{client::ErrorCode::Unknown, "Fail parsing response."}};
+    }
+    offset += data.size();
+
+    if (chunk.GetPartitions().empty()) {
+      continue;
+    }
+
+    if (fetch_option != OnlineOnly) {
+      cache_.PutPage(chunk, pages_count, version, boost::none);
+    }
+    ++pages_count;
+
+    auto& partitions = chunk.GetMutablePartitions();
+    const auto skipped = std::min(delivered, partitions.size());
+    partitions.erase(partitions.begin(), partitions.begin() + skipped);
+    delivered -= skipped;
+    if (!partitions.empty()) {
+      chunk_callback(std::move(chunk));
+    }
+    chunk = model::Partitions();
+  }
+
+  if (fetch_option != OnlineOnly) {
+    cache_.PutPagesCount(pages_count, version, boost::none);
+  }
+
+  return client::ApiNoResult();
+}
+
 PartitionsResponse PartitionsRepository::GetVersionedPartitions(
     const PartitionsRequest& request, int64_t version,
     client::CancellationContext context) {
@@ -141,14 +319,14 @@ PartitionsResponse PartitionsRepository::GetVolatilePartitions(
                              .WithFetchOption(request.GetFetchOption());
 
   CatalogRepository repository(catalog_, settings_, lookup_client_);
-  auto catalog_response = repository.GetCatalog(catalog_request, context);
+  auto catalog_response =
+      repository.GetCatalogSnapshot(catalog_request, context);
 
   if (!catalog_response.IsSuccessful()) {
     return catalog_response.GetError();
   }
 
-  auto expiry_response =
-      TtlForLayer(catalog_response.GetResult().GetLayers(), layer_id_);
+  auto expiry_response = TtlForLayer(*catalog_response.GetResult(), layer_id_);
   if (!expiry_response.IsSuccessful()) {
     return expiry_response.GetError();
   }
@@ -180,8 +358,38 @@ PartitionsRepository::GetPartitionsExtendedResponse(
     lock.lock();
   }
 
-  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate) {
-    auto cached_partitions = cache_.Get(request, version);
+  // The volatile partitions are kept past their expiry with the metadata
+  // version they are synchronized with, and are only used after the changes
+  // since this version are applied.
+  const bool is_volatile = !version && expiry;
+  boost::optional<PartitionsCacheRepository::VolatileSync> volatile_sync;
+  if (is_volatile && fetch_option != OnlineOnly) {
+    volatile_sync = cache_.GetVolatileSync();
+  }
+  const bool expired = volatile_sync && volatile_sync->expired;
+
+  // The partitions requested by ID that are found in the cache, only the
+  // missing ones are queried online.
+  model::Partitions cached_by_id;
+  std::vector<std::string> missing_ids;
+
+  if (expired && fetch_option == CacheOnly) {
+    return {{client::ErrorCode::NotFound,
+             "CacheOnly: resource not found in cache"}};
+  }
+
+  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate &&
+      !expired) {
+    boost::optional<model::Partitions> cached_partitions;
+    if (partition_ids.empty()) {
+      cached_partitions = cache_.Get(request, version);
+    } else {
+      cached_by_id = cache_.Get(partition_ids, version, &missing_ids);
+      if (missing_ids.empty()) {
+        cached_partitions = std::move(cached_by_id);
+      }
+    }
+
     if (cached_partitions) {
       OLP_SDK_LOG_DEBUG_F(kLogTag,
                           "GetPartitions found in cache, hrn='%s', key='%s'",
@@ -207,10 +415,40 @@ PartitionsRepository::GetPartitionsExtendedResponse(
       return metadata_api.GetError();
     }
 
+    if (expired && volatile_sync->version >= 0) {
+      auto refreshed = RefreshVolatilePartitions(
+          metadata_api.GetResult(), request, volatile_sync->version,
+          expiry.get(), context);
+      if (refreshed) {
+        return std::move(refreshed.get());
+      }
+    }
+
+    // The version is only resolved once the list expires, before the list is
+    // requested again, so no changes are missed. The first list is kept with
+    // an unknown version to not add a request to it.
+    boost::optional<int64_t> metadata_version;
+    if (is_volatile && fetch_option != OnlineOnly) {
+      metadata_version = kUnknownMetadataVersion;
+      if (expired) {
+        auto version_response = MetadataApi::GetLatestCatalogVersion(
+            metadata_api.GetResult(), -1, request.GetBillingTag(), context);
+        if (version_response.IsSuccessful()) {
+          metadata_version = version_response.GetResult().GetVersion();
+        }
+      }
+    }
+
     response =
         MetadataApi::GetPartitions(metadata_api.GetResult(), layer_id_, version,
                                    request.GetAdditionalFields(), boost::none,
                                    request.GetBillingTag(), context);
+
+    if (response.IsSuccessful() && metadata_version) {
+      cache_.Put(response.GetResult(), version, kTimetMax, true);
+      cache_.PutVolatileSync(*metadata_version, expiry.get());
+      return response;
+    }
   } else {
     auto query_api = lookup_client_.LookupApi(
         "query", "v1", static_cast<client::FetchOptions>(fetch_option),
@@ -220,9 +458,11 @@ PartitionsRepository::GetPartitionsExtendedResponse(
       return query_api.GetError();
     }
 
-    response = QueryApi::GetPartitionsbyId(
-        query_api.GetResult(), layer_id_, partition_ids, version,
-        request.GetAdditionalFields(), request.GetBillingTag(), context);
+    // The missing IDs are empty when the cache was not checked.
+    response = QueryPartitionsById(
+        query_api.GetResult(),
+        missing_ids.empty() ? partition_ids : missing_ids, request, version,
+        context);
   }
   // Save all partitions only when downloaded via metadata API
   const bool is_layer_metadata = partition_ids.empty();
@@ -230,7 +470,14 @@ PartitionsRepository::GetPartitionsExtendedResponse(
     OLP_SDK_LOG_DEBUG_F(kLogTag,
                         "GetPartitions put to cache, hrn='%s', key='%s'",
                         catalog_str.c_str(), key.c_str());
-    cache_.Put(response.GetResult(), version, expiry, is_layer_metadata);
+    // The partitions of a synchronized list do not expire on their own.
+    cache_.Put(response.GetResult(), version,
+               volatile_sync ? kTimetMax : expiry, is_layer_metadata);
+  }
+  if (response.IsSuccessful() && !cached_by_id.GetPartitions().empty()) {
+    response = {MergePartitions(partition_ids, std::move(cached_by_id),
+                                response.MoveResult()),
+                response.GetPayload()};
   }
   if (!response.IsSuccessful()) {
     const auto& error = response.GetError();
@@ -246,6 +493,85 @@ PartitionsRepository::GetPartitionsExtendedResponse(
   return response;
 }
 
+QueryApi::PartitionsExtendedResponse PartitionsRepository::QueryPartitionsById(
+    const client::OlpClient& query_api,
+    const std::vector<std::string>& partition_ids,
+    const PartitionsRequest& request, boost::optional<std::int64_t> version,
+    client::CancellationContext context) {
+  if (partition_ids.size() <= kMaxPartitionsPerQuery) {
+    return QueryApi::GetPartitionsbyId(query_api, layer_id_, partition_ids,
+                                       version, request.GetAdditionalFields(),
+                                       request.GetBillingTag(), context);
+  }
+
+  // Splits the IDs into the largest requests the query service accepts, and
+  // sends them in parallel.
+  const auto batches_count =
+      (partition_ids.size() + kMaxPartitionsPerQuery - 1u) /
+      kMaxPartitionsPerQuery;
+  std::vector<QueryApi::PartitionsExtendedResponse> responses(batches_count);
+  std::vector<client::CancellationContext> contexts(batches_count);
+
+  const bool started = context.ExecuteOrCancelled([&]() {
+    return client::CancellationToken([contexts]() mutable {
+      for (auto& batch_context : contexts) {
+        batch_context.CancelOperation();
+      }
+    });
+  });
+  if (!started) {
+    return client::ApiError::Cancelled();
+  }
+
+  std::atomic<size_t> next_batch{0u};
+  auto query = [&]() {
+    for (auto index = next_batch++; index < batches_count;
+         index = next_batch++) {
+      const auto begin =
+          partition_ids.begin() + index * kMaxPartitionsPerQuery;
+      const auto end = partition_ids.begin() +
+                       std::min(partition_ids.size(),
+                                (index + 1u) * kMaxPartitionsPerQuery);
+      responses[index] = QueryApi::GetPartitionsbyId(
+          query_api, layer_id_, std::vector<std::string>(begin, end), version,
+          request.GetAdditionalFields(), request.GetBillingTag(),
+          contexts[index]);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  const auto workers_count = std::min(kMaxParallelQueries, batches_count);
+  for (size_t worker = 1u; worker < workers_count; ++worker) {
+    workers.emplace_back(query);
+  }
+  query();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  if (context.IsCancelled()) {
+    return client::ApiError::Cancelled();
+  }
+
+  model::Partitions result;
+  auto& partitions = result.GetMutablePartitions();
+  partitions.reserve(partition_ids.size());
+  client::NetworkStatistics statistics;
+  for (auto& response : responses) {
+    statistics += response.GetPayload();
+    if (!response.IsSuccessful()) {
+      return {response.GetError(), statistics};
+    }
+
+    auto batch = response.MoveResult();
+    auto& batch_partitions = batch.GetMutablePartitions();
+    std::move(batch_partitions.begin(), batch_partitions.end(),
+              std::back_inserter(partitions));
+  }
+
+  return {std::move(result), statistics};
+}
+
 PartitionsResponse PartitionsRepository::GetPartitions(
     const PartitionsRequest& request, boost::optional<std::int64_t> version,
     client::CancellationContext context, boost::optional<time_t> expiry) {
@@ -253,6 +579,53 @@ PartitionsResponse PartitionsRepository::GetPartitions(
                                        std::move(context), std::move(expiry));
 }
 
+boost::optional<QueryApi::PartitionsExtendedResponse>
+PartitionsRepository::RefreshVolatilePartitions(
+    const client::OlpClient& metadata_api, const PartitionsRequest& request,
+    int64_t since_version, time_t expiry,
+    client::CancellationContext context) {
+  auto version_response = MetadataApi::GetLatestCatalogVersion(
+      metadata_api, since_version, request.GetBillingTag(), context);
+  if (!version_response.IsSuccessful()) {
+    return boost::none;
+  }
+
+  const auto latest_version = version_response.GetResult().GetVersion();
+  model::Partitions changes;
+  client::NetworkStatistics statistics;
+  if (latest_version > since_version) {
+    auto changes_response = MetadataApi::GetPartitionChanges(
+        metadata_api, layer_id_, since_version, latest_version,
+        request.GetAdditionalFields(), request.GetBillingTag(), context);
+    if (!changes_response.IsSuccessful()) {
+      OLP_SDK_LOG_WARNING_F(
+          kLogTag,
+          "RefreshVolatilePartitions failed, hrn='%s', layer='%s', "
+          "version='%" PRId64 "'",
+          catalog_.ToCatalogHRNString().c_str(), layer_id_.c_str(),
+          since_version);
+      return boost::none;
+    }
+
+    statistics = changes_response.GetPayload();
+    changes = changes_response.MoveResult();
+  }
+
+  auto partitions = cache_.ApplyVolatileChanges(changes);
+  if (!partitions) {
+    return boost::none;
+  }
+
+  OLP_SDK_LOG_DEBUG_F(
+      kLogTag,
+      "RefreshVolatilePartitions applied %zu changes, hrn='%s', layer='%s'",
+      changes.GetPartitions().size(), catalog_.ToCatalogHRNString().c_str(),
+      layer_id_.c_str());
+  cache_.PutVolatileSync(latest_version, expiry);
+  return QueryApi::PartitionsExtendedResponse(std::move(partitions.get()),
+                                              statistics);
+}
+
 PartitionsResponse PartitionsRepository::GetPartitionById(
     const DataRequest& request, boost::optional<int64_t> version,
     client::CancellationContext context) {
@@ -279,7 +652,20 @@ PartitionsResponse PartitionsRepository::GetPartitionById(
 
   const std::vector<std::string> partitions{partition_id.value()};
 
-  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate) {
+  // The partitions of an expired volatile list are not used.
+  boost::optional<PartitionsCacheRepository::VolatileSync> volatile_sync;
+  if (!version && fetch_option != OnlineOnly) {
+    volatile_sync = cache_.GetVolatileSync();
+  }
+  const bool expired = volatile_sync && volatile_sync->expired;
+
+  if (expired && fetch_option == CacheOnly) {
+    return {{client::ErrorCode::NotFound,
+             "CacheOnly: resource not found in cache"}};
+  }
+
+  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate &&
+      !expired) {
     auto cached_partitions = cache_.Get(partitions, version);
     if (cached_partitions.GetPartitions().size() == partitions.size()) {
       OLP_SDK_LOG_DEBUG_F(kLogTag,
@@ -304,15 +690,22 @@ PartitionsResponse PartitionsRepository::GetPartitionById(
 
   const client::OlpClient& client = query_api.GetResult();
 
-  PartitionsResponse query_response =
-      QueryApi::GetPartitionsbyId(client, layer_id_, partitions, version, {},
-                                  request.GetBillingTag(), context);
+  // The checksum is only requested when the data is verified with it.
+  std::vector<std::string> additional_fields;
+  if (request.GetChecksumVerification()) {
+    additional_fields.emplace_back(PartitionsRequest::kChecksum);
+  }
+
+  PartitionsResponse query_response = QueryApi::GetPartitionsbyId(
+      client, layer_id_, partitions, version, additional_fields,
+      request.GetBillingTag(), context);
 
   if (query_response.IsSuccessful() && fetch_option != OnlineOnly) {
     OLP_SDK_LOG_DEBUG_F(kLogTag,
                         "GetPartitionById put to cache, hrn='%s', key='%s'",
                         catalog_.ToCatalogHRNString().c_str(), key.c_str());
-    cache_.Put(query_response.GetResult(), version, boost::none);
+    cache_.Put(query_response.GetResult(), version,
+               volatile_sync ? boost::make_optional(kTimetMax) : boost::none);
   } else if (!query_response.IsSuccessful()) {
     const auto& error = query_response.GetError();
     if (error.GetHttpStatusCode() == http::HttpStatusCode::FORBIDDEN) {
@@ -405,7 +798,7 @@ QuadTreeIndexResponse PartitionsRepository::GetQuadTreeIndexForTile(
   }
 
   QuadTreeIndex tree(root_tile_key, kAggregateQuadTreeDepth,
-                     quadtree_response.response);
+                     *quadtree_response.GetResponseBuffer());
   if (tree.IsNull()) {
     OLP_SDK_LOG_WARNING_F(
         kLogTag,
@@ -422,46 +815,84 @@ QuadTreeIndexResponse PartitionsRepository::GetQuadTreeIndexForTile(
   return {std::move(tree)};
 }
 
+DecodedQuadTreeIndexResponse
+PartitionsRepository::GetDecodedQuadTreeIndexForTile(
+    const TileRequest& request, boost::optional<int64_t> version,
+    client::CancellationContext context) {
+  const auto fetch_option = request.GetFetchOption();
+  const auto& tile_key = request.GetTileKey();
+  const auto catalog = catalog_.ToCatalogHRNString();
+
+  // Without a version the quad tree may change, so it is not kept decoded.
+  auto memory_cache =
+      version && fetch_option != OnlineOnly
+          ? QuadTreeIndexCache::Acquire(settings_.cache,
+                                        settings_.quad_tree_memory_cache_size)
+          : nullptr;
+
+  if (memory_cache && fetch_option != CacheWithUpdate) {
+    auto tree = memory_cache->Find(catalog, layer_id_, *version, tile_key,
+                                   kAggregateQuadTreeDepth);
+    if (tree) {
+      return tree;
+    }
+  }
+
+  auto quad_tree_response = GetQuadTreeIndexForTile(request, version, context);
+  if (!quad_tree_response.IsSuccessful()) {
+    return quad_tree_response.GetError();
+  }
+
+  auto tree =
+      std::make_shared<DecodedQuadTreeIndex>(quad_tree_response.GetResult());
+  if (memory_cache) {
+    memory_cache->Put(catalog, layer_id_, *version, tree);
+  }
+  return QuadTreeIndexCache::DecodedTreePtr(std::move(tree));
+}
+
 PartitionResponse PartitionsRepository::GetAggregatedTile(
     TileRequest request, boost::optional<int64_t> version,
     client::CancellationContext context) {
-  auto quad_tree_response = GetQuadTreeIndexForTile(request, version, context);
+  auto quad_tree_response =
+      GetDecodedQuadTreeIndexForTile(request, version, context);
   if (!quad_tree_response.IsSuccessful()) {
     return quad_tree_response.GetError();
   }
 
-  // When the parent tile is too far away, we iterate up and download metadata
-  // for parent tiles until we cover aggregated tile root as a subquad. This
-  // is needed for the users who need to access the aggregated tile root
-  // directly. Else, we can't find it in cache.
+  // When the parent tile is above the root, we download the metadata of the
+  // quad tree that has the aggregated tile root as a subquad. This is needed
+  // for the users who need to access the aggregated tile root directly. Else,
+  // we can't find it in cache. One quad tree covers it, so the ones in between
+  // are not downloaded.
   if (request.GetFetchOption() != FetchOptions::CacheOnly) {
     const auto& result = quad_tree_response.GetResult();
-    auto index_data = result.Find(request.GetTileKey(), true);
+    auto index_data = result->Find(request.GetTileKey(), true);
     if (index_data) {
       const auto& aggregated_tile_key = index_data.value().tile_key;
-      auto root = result.GetRootTile();
-      while (root.Level() > aggregated_tile_key.Level()) {
-        auto parent = root.Parent();
-        request.WithTileKey(parent);
+      if (result->GetRootTile().Level() > aggregated_tile_key.Level()) {
+        auto parent_request = request;
+        parent_request.WithTileKey(aggregated_tile_key);
         // Ignore result for now
-        GetQuadTreeIndexForTile(request, version, context);
-        root = parent.ChangedLevelBy(-kAggregateQuadTreeDepth);
+        GetDecodedQuadTreeIndexForTile(parent_request, version, context);
       }
     }
   }
 
-  return FindPartition(quad_tree_response.GetResult(), request, true);
+  return FindPartition(*quad_tree_response.GetResult(), request, true);
 }
 
 PartitionResponse PartitionsRepository::GetTile(
     const TileRequest& request, boost::optional<int64_t> version,
     client::CancellationContext context) {
-  auto quad_tree_response = GetQuadTreeIndexForTile(request, version, context);
+  client::ScopedSpan span(settings_.tracer, "olp.read.QueryQuadTree");
+  auto quad_tree_response =
+      GetDecodedQuadTreeIndexForTile(request, version, context);
   if (!quad_tree_response.IsSuccessful()) {
     return quad_tree_response.GetError();
   }
 
-  return FindPartition(quad_tree_response.GetResult(), request, false);
+  return FindPartition(*quad_tree_response.GetResult(), request, false);
 }
 
 }  // namespace repository
@@ -29,6 +29,7 @@
 #include <olp/core/client/OlpClientSettings.h>
 #include "ExtendedApiResponse.h"
 #include "QuadTreeIndex.h"
+#include "QuadTreeIndexCache.h"
 #include "generated/api/QueryApi.h"
 #include "generated/model/Index.h"
 #include "olp/dataservice/read/DataRequest.h"
@@ -48,6 +49,8 @@ namespace repository {
 /// The partition metadata response type.
 using PartitionResponse = Response<model::Partition>;
 using QuadTreeIndexResponse = Response<QuadTreeIndex>;
+using DecodedQuadTreeIndexResponse =
+    Response<QuadTreeIndexCache::DecodedTreePtr>;
 
 class PartitionsRepository {
  public:
@@ -67,6 +70,14 @@ class PartitionsRepository {
       const read::PartitionsRequest& request, std::int64_t version,
       client::CancellationContext context);
 
+  /// Downloads the partitions list of the version in byte ranges and passes
+  /// the partitions of each range to `chunk_callback`, so the whole list is
+  /// never kept in memory. Each chunk is cached as a separate page.
+  PartitionsStreamResponse StreamVersionedPartitions(
+      const read::PartitionsRequest& request, std::int64_t version,
+      const PartitionsChunkCallback& chunk_callback,
+      client::CancellationContext context);
+
   PartitionsResponse GetPartitionById(const DataRequest& request,
                                       boost::optional<int64_t> version,
                                       client::CancellationContext context);
@@ -87,6 +98,29 @@ class PartitionsRepository {
       const TileRequest& request, boost::optional<int64_t> version,
       client::CancellationContext context);
 
+  /// Looks up the quad tree in the `QuadTreeIndexCache` first and puts the
+  /// decoded tree there when it is found in the cache or online.
+  DecodedQuadTreeIndexResponse GetDecodedQuadTreeIndexForTile(
+      const TileRequest& request, boost::optional<int64_t> version,
+      client::CancellationContext context);
+
+  /// Queries the partitions by ID, in parallel batches if there are more IDs
+  /// than the query service accepts in one request.
+  QueryApi::PartitionsExtendedResponse QueryPartitionsById(
+      const client::OlpClient& query_api,
+      const std::vector<std::string>& partition_ids,
+      const read::PartitionsRequest& request,
+      boost::optional<std::int64_t> version,
+      client::CancellationContext context);
+
+  /// Applies the changes since `since_version` to the cached volatile
+  /// partitions list. Returns `boost::none` if the list is downloaded again.
+  boost::optional<QueryApi::PartitionsExtendedResponse>
+  RefreshVolatilePartitions(const client::OlpClient& metadata_api,
+                            const read::PartitionsRequest& request,
+                            int64_t since_version, time_t expiry,
+                            client::CancellationContext context);
+
   PartitionsResponse GetPartitions(
       const read::PartitionsRequest& request,
       boost::optional<std::int64_t> version,
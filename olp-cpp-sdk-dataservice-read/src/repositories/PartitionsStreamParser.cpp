@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "PartitionsStreamParser.h"
+
+#include <cctype>
+#include <utility>
+
+namespace {
+constexpr auto kPartitionsKey = "partitions";
+}  // namespace
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+PartitionsStreamParser::PartitionsStreamParser(PartitionCallback callback)
+    : callback_(std::move(callback)),
+      depth_(0u),
+      in_string_(false),
+      escaped_(false),
+      in_partitions_(false),
+      failed_(false),
+      completed_(false) {}
+
+bool PartitionsStreamParser::Feed(const char* data, size_t size) {
+  for (size_t i = 0; i < size && !failed_; ++i) {
+    failed_ = !Consume(data[i]);
+  }
+  return !failed_;
+}
+
+bool PartitionsStreamParser::IsComplete() const {
+  return !failed_ && completed_;
+}
+
+bool PartitionsStreamParser::Consume(char c) {
+  // Depth 1 is the response object, depth 2 is the partitions array, and the
+  // partition objects start at depth 3.
+  const bool in_object = in_partitions_ && depth_ >= 3u;
+  if (in_object) {
+    object_.push_back(c);
+  }
+
+  if (in_string_) {
+    if (escaped_) {
+      escaped_ = false;
+    } else if (c == '\\') {
+      escaped_ = true;
+    } else if (c == '"') {
+      in_string_ = false;
+    } else if (depth_ == 1u) {
+      last_string_.push_back(c);
+    }
+    return true;
+  }
+
+  if (in_partitions_ && depth_ == 2u && c != '{' && c != ',' && c != ']' &&
+      !std::isspace(static_cast<unsigned char>(c))) {
+    // The partitions array has objects only.
+    return false;
+  }
+
+  switch (c) {
+    case '"':
+      in_string_ = true;
+      if (depth_ == 1u) {
+        last_string_.clear();
+      }
+      return true;
+
+    case ':':
+      if (depth_ == 1u) {
+        key_ = std::move(last_string_);
+        last_string_.clear();
+      }
+      return true;
+
+    case '{':
+    case '[':
+      if (completed_) {
+        return false;
+      }
+      if (depth_ == 1u && c == '[' && key_ == kPartitionsKey) {
+        in_partitions_ = true;
+      } else if (in_partitions_ && depth_ == 2u) {
+        object_.assign(1u, c);
+      }
+      ++depth_;
+      return true;
+
+    case '}':
+    case ']':
+      if (depth_ == 0u) {
+        return false;
+      }
+      --depth_;
+      if (in_partitions_ && depth_ == 2u) {
+        callback_(object_);
+        object_.clear();
+      } else if (in_partitions_ && depth_ == 1u) {
+        in_partitions_ = false;
+      }
+      completed_ = depth_ == 0u;
+      return true;
+
+    default:
+      return true;
+  }
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/*
+ * @brief Splits a partitions list response into the JSON objects of the
+ * single partitions while the response arrives in parts.
+ *
+ * Only the object that is being received is kept in memory, so the memory
+ * does not grow with the size of the list. The objects are passed to the
+ * callback as text and are parsed by the caller.
+ */
+class PartitionsStreamParser final {
+ public:
+  using PartitionCallback = std::function<void(const std::string& json)>;
+
+  explicit PartitionsStreamParser(PartitionCallback callback);
+
+  /// Consumes the next part of the response. Returns false if the response
+  /// is not a valid partitions list.
+  bool Feed(const char* data, size_t size);
+
+  /// Checks whether the whole response was consumed.
+  bool IsComplete() const;
+
+ private:
+  bool Consume(char c);
+
+  PartitionCallback callback_;
+  size_t depth_;
+  bool in_string_;
+  bool escaped_;
+  bool in_partitions_;
+  bool failed_;
+  bool completed_;
+  std::string key_;
+  std::string last_string_;
+  std::string object_;
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "PrefetchCheckpointRepository.h"
+
+#include <sstream>
+#include <utility>
+
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/logging/Log.h>
+
+namespace {
+constexpr auto kLogTag = "PrefetchCheckpointRepository";
+constexpr auto kSeparator = ',';
+}  // namespace
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+PrefetchCheckpointRepository::PrefetchCheckpointRepository(
+    const client::HRN& hrn, std::string layer_id, const std::string& resume_id,
+    boost::optional<int64_t> version,
+    std::shared_ptr<cache::KeyValueCache> cache)
+    : key_(hrn.ToCatalogHRNString() + "::" + layer_id + "::" + resume_id +
+           "::" + (version ? std::to_string(*version) : std::string()) +
+           "::prefetchCheckpoint"),
+      cache_(std::move(cache)) {}
+
+std::set<geo::TileKey> PrefetchCheckpointRepository::Load() {
+  auto value = cache_->Get(key_);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  completed_.clear();
+
+  if (value) {
+    std::istringstream stream(std::string(value->begin(), value->end()));
+    std::string here_tile;
+    while (std::getline(stream, here_tile, kSeparator)) {
+      auto root = geo::TileKey::FromHereTile(here_tile);
+      if (root.IsValid()) {
+        completed_.insert(root);
+      }
+    }
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Load '%s', completed=%zu", key_.c_str(),
+                      completed_.size());
+  return completed_;
+}
+
+void PrefetchCheckpointRepository::SetRootsLeft(size_t count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  roots_left_ = count;
+}
+
+void PrefetchCheckpointRepository::Complete(const geo::TileKey& root) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (cleared_ || !completed_.insert(root).second) {
+    return;
+  }
+
+  if (roots_left_ > 0 && --roots_left_ == 0) {
+    // The prefetch is complete, so there is nothing to resume.
+    OLP_SDK_LOG_DEBUG_F(kLogTag, "Complete: remove '%s'", key_.c_str());
+    cleared_ = true;
+    completed_.clear();
+    cache_->Remove(key_);
+    return;
+  }
+
+  std::string value;
+  for (const auto& tile : completed_) {
+    if (!value.empty()) {
+      value += kSeparator;
+    }
+    value += tile.ToHereTile();
+  }
+
+  // The lock keeps the cache entry in the order of the completed roots.
+  if (!cache_->Put(key_, std::make_shared<cache::KeyValueCache::ValueType>(
+                             value.begin(), value.end()))) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Complete: failed to save '%s'",
+                          key_.c_str());
+  }
+}
+
+void PrefetchCheckpointRepository::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cleared_ = true;
+  completed_.clear();
+  cache_->Remove(key_);
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <olp/core/client/HRN.h>
+#include <olp/core/geo/tiling/TileKey.h>
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace cache {
+class KeyValueCache;
+}
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/**
+ * @brief Saves the quad trees of a resumable prefetch whose tiles are all
+ * downloaded.
+ *
+ * The roots of the quad trees are kept in one cache entry. It is rewritten
+ * each time a quad tree completes, and removed once all the roots left do.
+ */
+class PrefetchCheckpointRepository final {
+ public:
+  PrefetchCheckpointRepository(const client::HRN& hrn, std::string layer_id,
+                               const std::string& resume_id,
+                               boost::optional<int64_t> version,
+                               std::shared_ptr<cache::KeyValueCache> cache);
+
+  /// Loads the roots completed by the previous runs.
+  std::set<geo::TileKey> Load();
+
+  /// Sets the number of the roots that the prefetch still has to complete.
+  void SetRootsLeft(size_t count);
+
+  /// Adds the root to the completed ones and saves them.
+  void Complete(const geo::TileKey& root);
+
+  /// Removes the saved roots, and ignores the roots completed afterwards.
+  void Clear();
+
+ private:
+  std::string key_;
+  std::shared_ptr<cache::KeyValueCache> cache_;
+
+  std::mutex mutex_;
+  std::set<geo::TileKey> completed_;
+  size_t roots_left_{0};
+  bool cleared_{false};
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -23,17 +23,24 @@
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/geo/tiling/TileKey.h>
 #include <olp/core/logging/Log.h>
 #include <olp/core/thread/Atomic.h>
 #include <olp/core/thread/TaskScheduler.h>
+#include <olp/dataservice/read/PartitionsRequest.h>
+#include "DataCacheRepository.h"
 #include "ExtendedApiResponseHelpers.h"
 #include "PartitionsRepository.h"
+#include "PrefetchTilesArea.h"
 #include "QuadTreeIndex.h"
+#include "generated/api/MetadataApi.h"
 #include "generated/api/QueryApi.h"
 
 namespace olp {
@@ -45,9 +52,30 @@ namespace {
 constexpr auto kLogTag = "PrefetchTilesRepository";
 constexpr std::uint32_t kMaxQuadTreeIndexDepth = 4u;
 
+// Adjusts the min level, if the distance between the min and max levels could
+// not be split with depth 4.
+std::uint32_t AlignMinLevel(std::uint32_t min_level, std::uint32_t max_level) {
+  auto extra_levels =
+      (max_level + 1u - min_level) % (kMaxQuadTreeIndexDepth + 1);
+  if (extra_levels != 0) {
+    // calculate how many levels up we should change min level
+    auto levels_up = kMaxQuadTreeIndexDepth + 1 - extra_levels;
+    if (min_level > levels_up) {
+      min_level = min_level - levels_up;
+    } else {
+      // if min_level is less than steps we need to go up, set min level to
+      // zero. Some quads will overlap, but we will minimize quad tree
+      // requests
+      min_level = 0u;
+    }
+  }
+  return min_level;
+}
+
 SubQuadsResult FlattenTree(const QuadTreeIndex& tree) {
   SubQuadsResult result;
   auto index_data = tree.GetIndexData();
+  result.reserve(index_data.size());
   std::transform(index_data.begin(), index_data.end(),
                  std::inserter(result, result.end()),
                  [](const QuadTreeIndex::IndexData& data) {
@@ -56,8 +84,33 @@ SubQuadsResult FlattenTree(const QuadTreeIndex& tree) {
   return result;
 }
 
+QuadTreeIndex::IndexData IndexDataFromPartition(
+    const geo::TileKey& tile_key, const model::Partition& partition) {
+  QuadTreeIndex::IndexData data;
+  data.tile_key = tile_key;
+  data.data_handle = partition.GetDataHandle();
+  data.checksum = partition.GetChecksum().get_value_or(std::string());
+  data.version = static_cast<uint64_t>(partition.GetVersion().get_value_or(-1));
+  data.data_size = partition.GetDataSize().get_value_or(-1);
+  data.compressed_data_size =
+      partition.GetCompressedDataSize().get_value_or(-1);
+  return data;
+}
+
 }  // namespace
 
+struct PrefetchTilesRepository::VersionChanges {
+  std::mutex mutex;
+  std::int64_t version{-1};
+  bool downloaded{false};
+  ChangedTilesPtr tiles;
+};
+
+struct PrefetchTilesRepository::CachedData {
+  mutable std::mutex mutex;
+  std::unordered_set<std::string> data_handles;
+};
+
 PrefetchTilesRepository::PrefetchTilesRepository(
     client::HRN catalog, const std::string& layer_id,
     client::OlpClientSettings settings, client::ApiLookupClient client,
@@ -68,7 +121,9 @@ PrefetchTilesRepository::PrefetchTilesRepository(
       lookup_client_(std::move(client)),
       cache_repository_(catalog_, layer_id_, settings_.cache,
                         settings_.default_cache_expiration),
-      billing_tag_(billing_tag) {}
+      billing_tag_(billing_tag),
+      changes_(std::make_shared<VersionChanges>()),
+      cached_data_(std::make_shared<CachedData>()) {}
 
 void PrefetchTilesRepository::SplitSubtree(
     RootTilesForRequest& root_tiles_depth,
@@ -129,22 +184,7 @@ RootTilesForRequest PrefetchTilesRepository::GetSlicedTiles(
       max_level = std::max(max_level, min_level);
     }
 
-    // adjust min/max levels, if distance between min/max could not be splitted
-    // with depth 4
-    auto extra_levels =
-        (max_level + 1u - min_level) % (kMaxQuadTreeIndexDepth + 1);
-    if (extra_levels != 0) {
-      // calculate how many levels up we should change min level
-      auto levels_up = kMaxQuadTreeIndexDepth + 1 - extra_levels;
-      if (min_level > levels_up) {
-        min_level = min_level - levels_up;
-      } else {
-        // if min_level is less than steps we need to go up, set min level to
-        // zero. Some quads will overlap, but we will minimize quad tree
-        // requests
-        min_level = 0u;
-      }
-    }
+    min_level = AlignMinLevel(min_level, max_level);
 
     OLP_SDK_LOG_DEBUG_F(
         kLogTag, "GetSlicedTiles for tile %s use min='%d', max='%d' levels",
@@ -169,6 +209,62 @@ RootTilesForRequest PrefetchTilesRepository::GetSlicedTiles(
   return root_tiles_depth;
 }
 
+RootTilesForRequest PrefetchTilesRepository::GetSlicedTiles(
+    const PrefetchTilesRequest& request, std::uint32_t min, std::uint32_t max) {
+  auto root_tiles_depth = GetSlicedTiles(request.GetTileKeys(), min, max);
+
+  const PrefetchTilesArea area(request);
+  if (area.IsEmpty() || max >= geo::TileKey::LevelCount || min > max) {
+    return root_tiles_depth;
+  }
+
+  const auto min_level = AlignMinLevel(min, max);
+
+  // Descend from the level 0 and keep only the tiles that intersect the area,
+  // so that the roots are found without the tiles of the bounding box.
+  std::vector<geo::TileKey> tiles = {geo::TileKey::FromRowColumnLevel(0, 0, 0)};
+  for (std::uint32_t level = 0; !tiles.empty(); ++level) {
+    if (level >= min_level &&
+        (level - min_level) % (kMaxQuadTreeIndexDepth + 1) == 0) {
+      const auto depth = std::min(kMaxQuadTreeIndexDepth, max - level);
+      for (const auto& tile : tiles) {
+        auto it = root_tiles_depth.insert({tile, depth});
+        if (!it.second) {
+          it.first->second = std::max(it.first->second, depth);
+        }
+      }
+
+      if (level + depth >= max) {
+        break;
+      }
+    }
+
+    // The level 1 has only one row of the tiles.
+    const auto rows = 1u << level;
+    std::vector<geo::TileKey> children;
+    for (const auto& tile : tiles) {
+      for (std::uint32_t child = 0; child < 4u; ++child) {
+        const auto row = tile.Row() * 2u + child / 2u;
+        if (row >= rows) {
+          continue;
+        }
+
+        const auto child_tile = geo::TileKey::FromRowColumnLevel(
+            row, tile.Column() * 2u + child % 2u, level + 1u);
+        if (area.Intersects(child_tile)) {
+          children.push_back(child_tile);
+        }
+      }
+    }
+    tiles.swap(children);
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "GetSlicedTiles for area, roots=%zu",
+                      root_tiles_depth.size());
+
+  return root_tiles_depth;
+}
+
 client::NetworkStatistics PrefetchTilesRepository::LoadAggregatedSubQuads(
     geo::TileKey root, const SubQuadsResult& tiles, std::int64_t version,
     client::CancellationContext context) {
@@ -297,6 +393,7 @@ SubQuadsResponse PrefetchTilesRepository::GetVolatileSubQuads(
 SubQuadsResult PrefetchTilesRepository::FilterTilesByLevel(
     const PrefetchTilesRequest& request, SubQuadsResult tiles) {
   const auto& tile_keys = request.GetTileKeys();
+  const PrefetchTilesArea area(request);
 
   auto skip_tile = [&](const geo::TileKey& tile_key) {
     if (tile_key.Level() < request.GetMinLevel()) {
@@ -307,6 +404,10 @@ SubQuadsResult PrefetchTilesRepository::FilterTilesByLevel(
       return true;
     }
 
+    if (!area.IsEmpty() && area.Intersects(tile_key)) {
+      return false;
+    }
+
     return std::find_if(tile_keys.begin(), tile_keys.end(),
                         [&tile_key](const geo::TileKey& root_key) {
                           return (root_key.IsParentOf(tile_key) ||
@@ -323,6 +424,7 @@ SubQuadsResult PrefetchTilesRepository::FilterTilesByLevel(
     }
   }
 
+  CheckCachedData(tiles);
   return tiles;
 }
 
@@ -376,18 +478,62 @@ SubQuadsResult PrefetchTilesRepository::FilterTilesByList(
     tiles.swap(result);
   }
 
+  CheckCachedData(tiles);
   return tiles;
 }
 
+bool PrefetchTilesRepository::IsDataCached(
+    const std::string& data_handle) const {
+  std::lock_guard<std::mutex> lock(cached_data_->mutex);
+  return cached_data_->data_handles.count(data_handle) > 0;
+}
+
+void PrefetchTilesRepository::CheckCachedData(const SubQuadsResult& tiles) {
+  if (!settings_.cache) {
+    return;
+  }
+
+  DataCacheRepository data_cache_repository(catalog_, settings_.cache);
+
+  std::vector<const std::string*> data_handles;
+  cache::KeyValueCache::KeyListType keys;
+  data_handles.reserve(tiles.size());
+  keys.reserve(tiles.size());
+
+  for (const auto& tile : tiles) {
+    if (!tile.second.empty()) {
+      data_handles.push_back(&tile.second);
+      keys.push_back(data_cache_repository.CreateKey(layer_id_, tile.second));
+    }
+  }
+
+  // One lookup for all the tiles instead of one per download.
+  const auto cached = settings_.cache->ContainsBatch(keys);
+
+  std::lock_guard<std::mutex> lock(cached_data_->mutex);
+  for (size_t i = 0; i < cached.size(); ++i) {
+    if (cached[i]) {
+      cached_data_->data_handles.insert(*data_handles[i]);
+    }
+  }
+}
+
 PrefetchTilesRepository::QuadTreeResponse
 PrefetchTilesRepository::DownloadVersionedQuadTree(
     geo::TileKey tile, int32_t depth, std::int64_t version,
     client::CancellationContext context) {
+  auto updated_tree = UpdateVersionedQuadTree(tile, depth, version, context);
+  if (updated_tree.IsSuccessful()) {
+    return updated_tree;
+  }
+
+  auto network_stats = GetNetworkStatistics(updated_tree);
+
   auto query_api = lookup_client_.LookupApi("query", "v1",
                                             client::OnlineIfNotFound, context);
 
   if (!query_api.IsSuccessful()) {
-    return query_api.GetError();
+    return {query_api.GetError(), network_stats};
   }
 
   auto tile_key = tile.ToHereTile();
@@ -399,16 +545,16 @@ PrefetchTilesRepository::DownloadVersionedQuadTree(
   auto quad_tree = QueryApi::QuadTreeIndex(query_api.GetResult(), layer_id_,
                                            tile_key, version, depth,
                                            boost::none, billing_tag_, context);
+  network_stats += quad_tree.GetNetworkStatistics();
 
   if (quad_tree.status != olp::http::HttpStatusCode::OK) {
     OLP_SDK_LOG_WARNING_F(kLogTag,
                           "GetSubQuads failed(%s, %" PRId64 ", %" PRId32 ")",
                           tile_key.c_str(), version, depth);
-    return {{quad_tree.status, quad_tree.response.str()},
-            quad_tree.GetNetworkStatistics()};
+    return {{quad_tree.status, quad_tree.response.str()}, network_stats};
   }
 
-  QuadTreeIndex tree(tile, depth, quad_tree.response);
+  QuadTreeIndex tree(tile, depth, *quad_tree.GetResponseBuffer());
 
   if (tree.IsNull()) {
     OLP_SDK_LOG_WARNING_F(kLogTag,
@@ -418,13 +564,153 @@ PrefetchTilesRepository::DownloadVersionedQuadTree(
                           catalog_.ToString().c_str(), layer_id_.c_str(),
                           tile_key.c_str(), version, depth);
     return {{client::ErrorCode::Unknown, "Failed to parse quad tree response"},
-            quad_tree.GetNetworkStatistics()};
+            network_stats};
   }
 
   // add to cache
   cache_repository_.Put(tile, depth, tree, version);
 
-  return {std::move(tree), quad_tree.GetNetworkStatistics()};
+  return {std::move(tree), network_stats};
+}
+
+PrefetchTilesRepository::QuadTreeResponse
+PrefetchTilesRepository::UpdateVersionedQuadTree(
+    geo::TileKey tile, int32_t depth, std::int64_t version,
+    client::CancellationContext context) {
+  QuadTreeIndex previous_tree;
+  if (version <= 0 ||
+      !cache_repository_.Get(tile, depth, version - 1, previous_tree)) {
+    return {{client::ErrorCode::NotFound,
+             "Quad tree of the previous version is not cached"},
+            {}};
+  }
+
+  auto changes_response = GetChangedTiles(version, context);
+  if (!changes_response.IsSuccessful()) {
+    return {changes_response.GetError(),
+            GetNetworkStatistics(changes_response)};
+  }
+
+  const auto& changes = *changes_response.GetResult();
+
+  // The quads within the depth below the root, and the parents of the root.
+  auto in_tree = [&](const geo::TileKey& tile_key) {
+    if (tile_key.Level() < tile.Level()) {
+      return tile.IsChildOf(tile_key);
+    }
+    return tile_key.Level() <= tile.Level() + depth &&
+           (tile_key == tile || tile_key.IsChildOf(tile));
+  };
+
+  std::vector<QuadTreeIndex::IndexData> quads;
+  for (auto& quad : previous_tree.GetIndexData()) {
+    if (changes.find(quad.tile_key.ToQuadKey64()) == changes.end()) {
+      quads.push_back(std::move(quad));
+    }
+  }
+
+  auto add_changed_quad = [&](const QuadTreeIndex::IndexData& quad) {
+    if (!quad.data_handle.empty()) {
+      quads.push_back(quad);
+    }
+  };
+
+  // Probe the quads of the tree when there are more changes than quads.
+  const auto tree_size =
+      geo::QuadKey64Helper::ChildrenAtLevel(depth + 1) / 3 + tile.Level();
+  if (changes.size() <= tree_size) {
+    for (const auto& change : changes) {
+      if (in_tree(change.second.tile_key)) {
+        add_changed_quad(change.second);
+      }
+    }
+  } else {
+    for (auto parent = tile; parent.Level() > 0;) {
+      parent = parent.Parent();
+      auto it = changes.find(parent.ToQuadKey64());
+      if (it != changes.end()) {
+        add_changed_quad(it->second);
+      }
+    }
+
+    for (auto level = 0; level <= depth; ++level) {
+      const auto begin = tile.ChangedLevelBy(level).ToQuadKey64();
+      const auto end = begin + geo::QuadKey64Helper::ChildrenAtLevel(level);
+      for (auto key = begin; key < end; ++key) {
+        auto it = changes.find(key);
+        if (it != changes.end()) {
+          add_changed_quad(it->second);
+        }
+      }
+    }
+  }
+
+  QuadTreeIndex tree(tile, depth, quads);
+  if (tree.IsNull()) {
+    return {{client::ErrorCode::Unknown, "Failed to update quad tree"},
+            GetNetworkStatistics(changes_response)};
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag,
+                      "Updated quad tree, root='%s', version='%" PRId64
+                      "', depth='%" PRId32 "'",
+                      tile.ToHereTile().c_str(), version, depth);
+
+  cache_repository_.Put(tile, depth, tree, version);
+
+  return {std::move(tree), GetNetworkStatistics(changes_response)};
+}
+
+ExtendedApiResponse<PrefetchTilesRepository::ChangedTilesPtr, client::ApiError,
+                    client::NetworkStatistics>
+PrefetchTilesRepository::GetChangedTiles(std::int64_t version,
+                                         client::CancellationContext context) {
+  std::lock_guard<std::mutex> lock(changes_->mutex);
+  if (changes_->downloaded && changes_->version == version) {
+    if (!changes_->tiles) {
+      return {{client::ErrorCode::NotFound, "Changes are not available"}, {}};
+    }
+    return {changes_->tiles, {}};
+  }
+
+  // The roots fall back to the full quad trees when the download fails.
+  changes_->version = version;
+  changes_->downloaded = true;
+  changes_->tiles = nullptr;
+
+  auto metadata_api = lookup_client_.LookupApi(
+      "metadata", "v1", client::OnlineIfNotFound, context);
+
+  if (!metadata_api.IsSuccessful()) {
+    return {metadata_api.GetError(), {}};
+  }
+
+  auto response = MetadataApi::GetPartitionChanges(
+      metadata_api.GetResult(), layer_id_, version - 1, version,
+      {PartitionsRequest::kChecksum, PartitionsRequest::kCompressedDataSize,
+       PartitionsRequest::kDataSize},
+      billing_tag_, context);
+
+  if (!response.IsSuccessful()) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "GetPartitionChanges failed, hrn='%s', layer='%s', "
+                          "version='%" PRId64 "'",
+                          catalog_.ToString().c_str(), layer_id_.c_str(),
+                          version);
+    return {response.GetError(), GetNetworkStatistics(response)};
+  }
+
+  auto tiles = std::make_shared<ChangedTiles>();
+  for (const auto& partition : response.GetResult().GetPartitions()) {
+    const auto tile_key = geo::TileKey::FromHereTile(partition.GetPartition());
+    if (tile_key.IsValid()) {
+      (*tiles)[tile_key.ToQuadKey64()] =
+          IndexDataFromPartition(tile_key, partition);
+    }
+  }
+
+  changes_->tiles = tiles;
+  return {std::move(tiles), GetNetworkStatistics(response)};
 }
 
 }  // namespace repository
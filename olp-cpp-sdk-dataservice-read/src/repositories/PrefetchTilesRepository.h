@@ -19,8 +19,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiLookupClient.h>
@@ -42,7 +45,7 @@ namespace read {
 namespace repository {
 
 using RootTilesForRequest = std::map<geo::TileKey, uint32_t>;
-using SubQuadsResult = std::map<geo::TileKey, std::string>;
+using SubQuadsResult = std::unordered_map<geo::TileKey, std::string>;
 using SubQuadsResponse = ExtendedApiResponse<SubQuadsResult, client::ApiError,
                                              client::NetworkStatistics>;
 using SubTilesResult = SubQuadsResult;
@@ -66,14 +69,30 @@ class PrefetchTilesRepository {
    * @param minLevel Minimum level of the resultant tile keys.
    * @param maxLevel Maximum level of the resultant tile keys.
    */
-  RootTilesForRequest GetSlicedTiles(const std::vector<geo::TileKey>& tile_keys,
-                                     std::uint32_t min, std::uint32_t max);
+  static RootTilesForRequest GetSlicedTiles(
+      const std::vector<geo::TileKey>& tile_keys, std::uint32_t min,
+      std::uint32_t max);
+
+  /**
+   * @brief Gets the root tiles for the tile keys and the area of the request.
+   *
+   * The roots of the area are found level by level, skipping the tiles that
+   * do not intersect it.
+   *
+   * @param request Your request.
+   * @param min Minimum level of the resultant tile keys.
+   * @param max Maximum level of the resultant tile keys.
+   */
+  static RootTilesForRequest GetSlicedTiles(const PrefetchTilesRequest& request,
+                                            std::uint32_t min,
+                                            std::uint32_t max);
 
   /**
    * @brief Filters the input tiles according to the request.
    *
    * Removes tiles that do not belong to the minimum and maximum levels.
-   * Removes tiles that are not a child or a parent of the requested tiles.
+   * Removes tiles that are not a child or a parent of the requested tiles,
+   * and do not intersect the requested area.
    *
    * @param request Your request.
    * @param tiles The input tiles.
@@ -98,6 +117,19 @@ class PrefetchTilesRepository {
   SubQuadsResult FilterTilesByList(const PrefetchTilesRequest& request,
                                    SubQuadsResult tiles);
 
+  /**
+   * @brief Checks if the filters found the data of the tile in the cache.
+   *
+   * `FilterTilesByLevel` and `FilterTilesByList` check the cache for all of
+   * the filtered tiles at once, so the downloads of the cached tiles do not
+   * look up the cache one by one.
+   *
+   * @param data_handle The data handle of the tile.
+   *
+   * @returns True if the data was cached when the tile was filtered.
+   */
+  bool IsDataCached(const std::string& data_handle) const;
+
   client::NetworkStatistics LoadAggregatedSubQuads(
       geo::TileKey tile, const SubQuadsResult& tiles, std::int64_t version,
       client::CancellationContext context);
@@ -121,13 +153,44 @@ class PrefetchTilesRepository {
       geo::TileKey tile, int32_t depth, std::int64_t version,
       client::CancellationContext context);
 
+  /// The partitions changed since the previous catalog version keyed by
+  /// quadkey64, the removed ones have an empty data handle.
+  using ChangedTiles =
+      std::unordered_map<std::uint64_t, QuadTreeIndex::IndexData>;
+  using ChangedTilesPtr = std::shared_ptr<const ChangedTiles>;
+
+  /**
+   * @brief Derives the quad tree of the version from the cached quad tree of
+   * the previous version and the partitions changed since then.
+   *
+   * @return The quad tree, or an error if the previous quad tree is not cached
+   * or the changes can not be downloaded.
+   */
+  QuadTreeResponse UpdateVersionedQuadTree(geo::TileKey tile, int32_t depth,
+                                           std::int64_t version,
+                                           client::CancellationContext context);
+
+  /// Downloads the changes once and shares them with the copies of the
+  /// repository that handle the other roots of the prefetch.
+  ExtendedApiResponse<ChangedTilesPtr, client::ApiError,
+                      client::NetworkStatistics>
+  GetChangedTiles(std::int64_t version, client::CancellationContext context);
+
  private:
+  struct VersionChanges;
+  struct CachedData;
+
+  /// Remembers the data handles of the tiles that have the data in the cache.
+  void CheckCachedData(const SubQuadsResult& tiles);
+
   client::HRN catalog_;
   std::string layer_id_;
   client::OlpClientSettings settings_;
   client::ApiLookupClient lookup_client_;
   PartitionsCacheRepository cache_repository_;
   boost::optional<std::string> billing_tag_;
+  std::shared_ptr<VersionChanges> changes_;
+  std::shared_ptr<CachedData> cached_data_;
 };
 
 }  // namespace repository
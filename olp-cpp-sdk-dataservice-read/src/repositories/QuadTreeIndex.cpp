@@ -21,13 +21,18 @@
 
 #include <algorithm>
 #include <bitset>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <string>
 
+#include <olp/core/generated/parser/JsonParser.h>
 #include <olp/core/logging/Log.h>
-#include <rapidjson/document.h>
 #include <rapidjson/istreamwrapper.h>
+#include <rapidjson/reader.h>
 #include "BlobDataReader.h"
 #include "BlobDataWriter.h"
+#include "generated/parser/SaxHandler.h"
 
 namespace {
 constexpr auto kParentQuadsKey = "parentQuads";
@@ -42,34 +47,6 @@ constexpr auto kDataSizeKey = "dataSize";
 constexpr auto kCompressedDataSize = "compressedDataSize";
 
 constexpr auto kLogTag = "QuadTreeIndex";
-
-olp::dataservice::read::QuadTreeIndex::IndexData ParseCommonIndexData(
-    rapidjson::Value& value) {
-  olp::dataservice::read::QuadTreeIndex::IndexData data;
-  auto obj = value.GetObject();
-  if (obj.HasMember(kAdditionalMetadataKey) &&
-      obj[kAdditionalMetadataKey].IsString()) {
-    data.additional_metadata = obj[kAdditionalMetadataKey].GetString();
-  }
-
-  if (obj.HasMember(kChecksumKey) && obj[kChecksumKey].IsString()) {
-    data.checksum = obj[kChecksumKey].GetString();
-  }
-
-  if (obj.HasMember(kDataSizeKey) && obj[kDataSizeKey].IsInt64()) {
-    data.data_size = obj[kDataSizeKey].GetInt64();
-  }
-
-  if (obj.HasMember(kCompressedDataSize) &&
-      obj[kCompressedDataSize].IsInt64()) {
-    data.compressed_data_size = obj[kCompressedDataSize].GetInt64();
-  }
-
-  if (obj.HasMember(kVersionKey) && obj[kVersionKey].IsUint64()) {
-    data.version = obj[kVersionKey].GetUint64();
-  }
-  return data;
-}
 }  // namespace
 
 namespace olp {
@@ -85,63 +62,277 @@ QuadTreeIndex::QuadTreeIndex(cache::KeyValueCache::ValueTypePtr data) {
   size_ = data->size();
 }
 
-QuadTreeIndex::QuadTreeIndex(const olp::geo::TileKey& root, int depth,
-                             std::stringstream& json_stream) {
-  std::vector<IndexData> subs;
-  std::vector<IndexData> parents;
+class QuadTreeIndex::JsonHandler
+    : public olp::parser::SaxHandler<JsonHandler> {
+ public:
+  explicit JsonHandler(const geo::TileKey& root) : root_(root) {}
 
-  rapidjson::Document doc;
-  rapidjson::IStreamWrapper stream(json_stream);
-  doc.ParseStream(stream);
+  bool StartObject() {
+    if (depth_ == 0) {
+      ++depth_;
+      return true;
+    }
 
-  if (!doc.IsObject()) {
-    return;
+    if (depth_++ == kArrayDepth && section_ != Section::kNone) {
+      ResetItem();
+      in_item_ = true;
+    }
+    return true;
   }
 
-  auto parent_quads_value = doc.FindMember(kParentQuadsKey);
-  auto sub_quads_value = doc.FindMember(kSubQuadsKey);
+  bool EndObject(rapidjson::SizeType) {
+    if (--depth_ == kArrayDepth && in_item_) {
+      in_item_ = false;
+      return AddItem();
+    }
+    return true;
+  }
 
-  if (parent_quads_value == doc.MemberEnd() &&
-      sub_quads_value == doc.MemberEnd()) {
-    return;
+  bool StartArray() {
+    if (depth_ == 0) {
+      // The response must be an object.
+      return false;
+    }
+
+    if (depth_++ == kRootDepth) {
+      section_ = next_section_;
+    }
+    next_section_ = Section::kNone;
+    return true;
   }
 
-  if (parent_quads_value != doc.MemberEnd() &&
-      parent_quads_value->value.IsArray()) {
-    parents.reserve(parent_quads_value->value.Size());
-    for (auto& value : parent_quads_value->value.GetArray()) {
-      auto obj = value.GetObject();
+  bool EndArray(rapidjson::SizeType) {
+    if (--depth_ == kRootDepth) {
+      section_ = Section::kNone;
+    }
+    return true;
+  }
 
-      if (!obj.HasMember(kDataHandleKey) || !obj[kDataHandleKey].IsString() ||
-          !obj.HasMember(kPartitionKey) || !obj[kPartitionKey].IsString()) {
-        continue;
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    if (depth_ == kRootDepth) {
+      next_section_ = Section::kNone;
+      if (IsKey(kParentQuadsKey, str, length)) {
+        has_parents_ = true;
+        next_section_ = Section::kParents;
+      } else if (IsKey(kSubQuadsKey, str, length)) {
+        has_subs_ = true;
+        next_section_ = Section::kSubs;
       }
+    } else if (depth_ == kItemDepth && in_item_) {
+      field_ = ToField(str, length);
+    }
+    return true;
+  }
 
-      IndexData data = ParseCommonIndexData(value);
-      data.data_handle = obj[kDataHandleKey].GetString();
-      data.tile_key = root.FromHereTile(obj[kPartitionKey].GetString());
-      parents.push_back(std::move(data));
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    if (!IsItemField()) {
+      return IsDocument();
     }
+
+    switch (field_) {
+      case Field::kDataHandle:
+        item_.data.data_handle.assign(str, length);
+        item_.has_data_handle = true;
+        break;
+      case Field::kKey:
+        item_.key.assign(str, length);
+        item_.has_key = true;
+        break;
+      case Field::kChecksum:
+        item_.data.checksum.assign(str, length);
+        break;
+      case Field::kAdditionalMetadata:
+        item_.data.additional_metadata.assign(str, length);
+        break;
+      default:
+        break;
+    }
+    return true;
   }
 
-  if (sub_quads_value != doc.MemberEnd() && sub_quads_value->value.IsArray()) {
-    subs.reserve(sub_quads_value->value.Size());
-    for (auto& value : sub_quads_value->value.GetArray()) {
-      auto obj = value.GetObject();
+  // The numbers are taken with the same type checks as in the DOM:
+  // `IsUint64` for the version and `IsInt64` for the sizes.
+  bool Int(int value) { return Int64(value); }
+  bool Uint(unsigned value) { return Uint64(value); }
 
-      if (!obj.HasMember(kDataHandleKey) || !obj[kDataHandleKey].IsString() ||
-          !obj.HasMember(kSubQuadKeyKey) || !obj[kSubQuadKeyKey].IsString()) {
-        continue;
-      }
+  bool Int64(int64_t value) {
+    if (!IsItemField()) {
+      return IsDocument();
+    }
+
+    if (field_ == Field::kDataSize) {
+      item_.data.data_size = value;
+    } else if (field_ == Field::kCompressedDataSize) {
+      item_.data.compressed_data_size = value;
+    } else if (field_ == Field::kVersion && value >= 0) {
+      item_.data.version = static_cast<uint64_t>(value);
+    }
+    return true;
+  }
+
+  bool Uint64(uint64_t value) {
+    if (!IsItemField()) {
+      return IsDocument();
+    }
+
+    if (field_ == Field::kVersion) {
+      item_.data.version = value;
+    } else if (value <= static_cast<uint64_t>(
+                             std::numeric_limits<int64_t>::max())) {
+      return Int64(static_cast<int64_t>(value));
+    }
+    return true;
+  }
+
+  bool HasQuads() const { return has_parents_ || has_subs_; }
+
+  std::vector<SubEntry> subs;
+  std::vector<ParentEntry> parents;
+  std::vector<unsigned char> data;
+
+ private:
+  static constexpr int kRootDepth = 1;
+  static constexpr int kArrayDepth = 2;
+  static constexpr int kItemDepth = 3;
+
+  enum class Section { kNone, kParents, kSubs };
+
+  enum class Field {
+    kNone,
+    kDataHandle,
+    kKey,
+    kVersion,
+    kChecksum,
+    kAdditionalMetadata,
+    kDataSize,
+    kCompressedDataSize
+  };
+
+  struct Item {
+    IndexData data;
+    std::string key;
+    bool has_data_handle = false;
+    bool has_key = false;
+  };
+
+  Field ToField(const char* str, rapidjson::SizeType length) const {
+    if (IsKey(kDataHandleKey, str, length)) {
+      return Field::kDataHandle;
+    } else if (IsKey(section_ == Section::kParents ? kPartitionKey
+                                                   : kSubQuadKeyKey,
+                     str, length)) {
+      return Field::kKey;
+    } else if (IsKey(kVersionKey, str, length)) {
+      return Field::kVersion;
+    } else if (IsKey(kChecksumKey, str, length)) {
+      return Field::kChecksum;
+    } else if (IsKey(kAdditionalMetadataKey, str, length)) {
+      return Field::kAdditionalMetadata;
+    } else if (IsKey(kDataSizeKey, str, length)) {
+      return Field::kDataSize;
+    } else if (IsKey(kCompressedDataSize, str, length)) {
+      return Field::kCompressedDataSize;
+    }
+    return Field::kNone;
+  }
+
+  bool IsItemField() const { return in_item_ && depth_ == kItemDepth; }
+
+  // Keeps the capacity of the strings, so the items do not allocate.
+  void ResetItem() {
+    item_.data.data_handle.clear();
+    item_.data.checksum.clear();
+    item_.data.additional_metadata.clear();
+    item_.data.version = -1;
+    item_.data.data_size = -1;
+    item_.data.compressed_data_size = -1;
+    item_.key.clear();
+    item_.has_data_handle = false;
+    item_.has_key = false;
+    field_ = Field::kNone;
+  }
+
+  bool AddItem() {
+    if (!item_.has_data_handle || !item_.has_key) {
+      return true;
+    }
 
-      IndexData data = ParseCommonIndexData(value);
-      data.data_handle = obj[kDataHandleKey].GetString();
-      data.tile_key = root.AddedSubHereTile(obj[kSubQuadKeyKey].GetString());
-      subs.push_back(std::move(data));
+    const auto offset = static_cast<uint32_t>(data.size());
+    if (section_ == Section::kParents) {
+      const auto tile_key = geo::TileKey::FromHereTile(item_.key);
+      parents.push_back({tile_key.ToQuadKey64(), offset});
+    } else {
+      const auto tile_key = root_.AddedSubHereTile(item_.key);
+      const auto sub_quadkey =
+          olp::geo::QuadKey64Helper{tile_key.ToQuadKey64()}
+              .GetSubkey(tile_key.Level() - root_.Level())
+              .key;
+      subs.push_back({static_cast<std::uint16_t>(sub_quadkey), offset});
     }
+
+    return AppendIndexData(item_.data, data);
+  }
+
+  const geo::TileKey root_;
+  Section section_ = Section::kNone;
+  Section next_section_ = Section::kNone;
+  Field field_ = Field::kNone;
+  bool in_item_ = false;
+  bool has_parents_ = false;
+  bool has_subs_ = false;
+  Item item_;
+};
+
+QuadTreeIndex::QuadTreeIndex(const olp::geo::TileKey& root, int depth,
+                             std::stringstream& json_stream) {
+  JsonHandler handler(root);
+  rapidjson::IStreamWrapper stream(json_stream);
+  rapidjson::Reader reader;
+
+  if (reader.Parse(stream, handler).IsError() || !handler.HasQuads()) {
+    return;
   }
 
-  CreateBlob(root, depth, std::move(parents), std::move(subs));
+  CreateBlob(root, depth, std::move(handler.subs), std::move(handler.parents),
+             handler.data);
+}
+
+QuadTreeIndex::QuadTreeIndex(const olp::geo::TileKey& root, int depth,
+                             const std::vector<unsigned char>& json) {
+  JsonHandler handler(root);
+  if (!parser::parse_sax(json, handler) || !handler.HasQuads()) {
+    return;
+  }
+
+  CreateBlob(root, depth, std::move(handler.subs), std::move(handler.parents),
+             handler.data);
+}
+
+QuadTreeIndex::QuadTreeIndex(const olp::geo::TileKey& root, int depth,
+                             const std::vector<IndexData>& quads) {
+  std::vector<SubEntry> subs;
+  std::vector<ParentEntry> parents;
+  std::vector<unsigned char> data;
+
+  for (const IndexData& quad : quads) {
+    const auto offset = static_cast<uint32_t>(data.size());
+    const auto& tile_key = quad.tile_key;
+    if (tile_key.Level() >= root.Level()) {
+      const auto sub_quadkey =
+          olp::geo::QuadKey64Helper{tile_key.ToQuadKey64()}
+              .GetSubkey(tile_key.Level() - root.Level())
+              .key;
+      subs.push_back({static_cast<std::uint16_t>(sub_quadkey), offset});
+    } else {
+      parents.push_back({tile_key.ToQuadKey64(), offset});
+    }
+
+    if (!AppendIndexData(quad, data)) {
+      return;
+    }
+  }
+
+  CreateBlob(root, depth, std::move(subs), std::move(parents), data);
 }
 
 bool QuadTreeIndex::ReadIndexData(QuadTreeIndex::IndexData& data,
@@ -169,39 +360,35 @@ bool QuadTreeIndex::WriteIndexData(const IndexData& data,
   return success;
 }
 
-void QuadTreeIndex::CreateBlob(olp::geo::TileKey root, int depth,
-                               std::vector<IndexData> parents,
-                               std::vector<IndexData> subs) {
-  // quads must be sorted by their sub quad key, not by Quad::operator<
-  std::sort(subs.begin(), subs.end(),
-            [](const IndexData& lhs, const IndexData& rhs) {
-              return lhs.tile_key.ToQuadKey64() < rhs.tile_key.ToQuadKey64();
-            });
-
-  std::sort(parents.begin(), parents.end(),
-            [](const IndexData& lhs, const IndexData& rhs) {
-              return lhs.tile_key.ToQuadKey64() < rhs.tile_key.ToQuadKey64();
-            });
-
-  // count data size(for now it is header version and data handle)
-  size_t additional_data_size = 0;
-  for (const IndexData& data : subs) {
-    additional_data_size +=
-        data.data_handle.size() + 1 + data.checksum.size() + 1 +
-        data.additional_metadata.size() + 1 + sizeof(IndexData::data_size) +
-        sizeof(IndexData::compressed_data_size) + sizeof(IndexData::version);
-  }
-  for (const IndexData& data : parents) {
-    additional_data_size +=
-        data.data_handle.size() + 1 + data.checksum.size() + 1 +
-        data.additional_metadata.size() + 1 + sizeof(IndexData::data_size) +
-        sizeof(IndexData::compressed_data_size) + sizeof(IndexData::version);
+bool QuadTreeIndex::AppendIndexData(const IndexData& index_data,
+                                    std::vector<unsigned char>& data) {
+  const auto offset = data.size();
+  data.resize(offset + sizeof(IndexData::version) +
+              sizeof(IndexData::data_size) +
+              sizeof(IndexData::compressed_data_size) +
+              index_data.data_handle.size() + 1 + index_data.checksum.size() +
+              1 + index_data.additional_metadata.size() + 1);
+
+  BlobDataWriter writer(data);
+  writer.SetOffset(offset);
+  if (!WriteIndexData(index_data, writer)) {
+    OLP_SDK_LOG_ERROR(kLogTag, "Could not write IndexData");
+    return false;
   }
+  return true;
+}
+
+void QuadTreeIndex::CreateBlob(olp::geo::TileKey root, int depth,
+                               std::vector<SubEntry> subs,
+                               std::vector<ParentEntry> parents,
+                               const std::vector<unsigned char>& data) {
+  std::sort(subs.begin(), subs.end());
+  std::sort(parents.begin(), parents.end());
 
   // calculate and allocate size
   size_ = sizeof(DataHeader) - sizeof(SubEntry) +
           (subs.size() * sizeof(SubEntry)) +
-          (parents.size() * sizeof(ParentEntry)) + additional_data_size;
+          (parents.size() * sizeof(ParentEntry)) + data.size();
 
   raw_data_ = std::make_shared<cache::KeyValueCache::ValueType>(size_);
   data_ = reinterpret_cast<DataHeader*>(&(raw_data_->front()));
@@ -212,40 +399,22 @@ void QuadTreeIndex::CreateBlob(olp::geo::TileKey root, int depth,
   data_->subkey_count = static_cast<uint16_t>(subs.size());
   data_->parent_count = static_cast<uint8_t>(parents.size());
 
-  // write SubEntry tiles
-  SubEntry* entry_ptr = data_->entries;
+  // The index data offsets are relative to the data section.
+  const auto data_offset =
+      static_cast<uint32_t>(DataBegin() - raw_data_->data());
 
-  auto root_quad_level = root.Level();
-
-  BlobDataWriter serializer(*raw_data_);
-  serializer.SetOffset(const_cast<unsigned char*>(DataBegin()) -
-                       raw_data_->data());
-  for (const IndexData& data : subs) {
-    *entry_ptr++ = {
-        std::uint16_t(olp::geo::QuadKey64Helper{data.tile_key.ToQuadKey64()}
-                          .GetSubkey(data.tile_key.Level() - root_quad_level)
-                          .key),
-        static_cast<uint32_t>(serializer.GetOffset())};
-    if (!WriteIndexData(data, serializer)) {
-      OLP_SDK_LOG_ERROR(kLogTag, "Could not write IndexData");
-      raw_data_ = nullptr;
-      data_ = nullptr;
-      size_ = 0;
-      return;
-    }
+  SubEntry* entry_ptr = data_->entries;
+  for (const SubEntry& entry : subs) {
+    *entry_ptr++ = {entry.sub_quadkey, entry.tag_offset + data_offset};
   }
 
   ParentEntry* parent_ptr = reinterpret_cast<ParentEntry*>(entry_ptr);
-  for (const IndexData& data : parents) {
-    *parent_ptr++ = {data.tile_key.ToQuadKey64(),
-                     static_cast<uint32_t>(serializer.GetOffset())};
-    if (!WriteIndexData(data, serializer)) {
-      OLP_SDK_LOG_ERROR(kLogTag, "Could not write IndexData");
-      raw_data_ = nullptr;
-      data_ = nullptr;
-      size_ = 0;
-      return;
-    }
+  for (const ParentEntry& entry : parents) {
+    *parent_ptr++ = {entry.key, entry.tag_offset + data_offset};
+  }
+
+  if (!data.empty()) {
+    std::memcpy(raw_data_->data() + data_offset, data.data(), data.size());
   }
 }
 
@@ -294,13 +463,24 @@ boost::optional<QuadTreeIndex::IndexData> QuadTreeIndex::FindNearestParent(
   const olp::geo::TileKey& root_tile_key =
       olp::geo::TileKey::FromQuadKey64(data_->root_tilekey);
 
-  if (tile_key.Level() >= root_tile_key.Level()) {
-    for (auto it = SubEntryEnd(); it-- != SubEntryBegin();) {
-      auto key = root_tile_key.AddedSubkey64(it->sub_quadkey);
-      if (tile_key.IsChildOf(key)) {
+  if (tile_key.Level() > root_tile_key.Level()) {
+    // Looks up the ancestors within the tree by their sub quad keys, the
+    // closest one first, instead of checking every sub quad.
+    const auto root_level = root_tile_key.Level();
+    const auto max_level = std::min<std::uint32_t>(
+        tile_key.Level() - 1u, root_level + data_->depth);
+    const SubEntry* end = SubEntryEnd();
+
+    for (auto level = max_level + 1u; level-- > root_level;) {
+      const auto key = tile_key.ChangedLevelTo(level);
+      const auto sub =
+          static_cast<std::uint16_t>(key.GetSubkey64(level - root_level));
+      const SubEntry* entry =
+          std::lower_bound(SubEntryBegin(), end, SubEntry{sub, 0});
+      if (entry != end && entry->sub_quadkey == sub) {
         IndexData data;
         data.tile_key = key;
-        if (!ReadIndexData(data, it->tag_offset)) {
+        if (!ReadIndexData(data, entry->tag_offset)) {
           return boost::none;
         }
         return data;
@@ -54,6 +54,16 @@ class QuadTreeIndex {
   QuadTreeIndex(const olp::geo::TileKey& root, int depth,
                 std::stringstream& json_stream);
 
+  /// Creates the index from the JSON response body, the body is read in
+  /// place.
+  QuadTreeIndex(const olp::geo::TileKey& root, int depth,
+                const std::vector<unsigned char>& json);
+
+  /// Creates the index from the quads of the tree, the ones above the root
+  /// are the parent quads.
+  QuadTreeIndex(const olp::geo::TileKey& root, int depth,
+                const std::vector<IndexData>& quads);
+
   QuadTreeIndex(const QuadTreeIndex& other) = delete;
   QuadTreeIndex(QuadTreeIndex&& other) noexcept = default;
   QuadTreeIndex& operator=(QuadTreeIndex&& other) noexcept = default;
@@ -101,8 +111,13 @@ class QuadTreeIndex {
     SubEntry entries[1];
   };
 
-  void CreateBlob(geo::TileKey root, int depth, std::vector<IndexData> parents,
-                  std::vector<IndexData> subs);
+  /// Parses the quad tree response with the SAX reader and writes the index
+  /// data of each quad directly to the data section of the blob.
+  class JsonHandler;
+
+  void CreateBlob(geo::TileKey root, int depth, std::vector<SubEntry> subs,
+                  std::vector<ParentEntry> parents,
+                  const std::vector<unsigned char>& data);
 
   boost::optional<QuadTreeIndex::IndexData> FindNearestParent(
       geo::TileKey tile_key) const;
@@ -126,7 +141,10 @@ class QuadTreeIndex {
     return reinterpret_cast<const uint8_t*>(data_) + size_;
   }
 
-  bool WriteIndexData(const IndexData& data, BlobDataWriter& writer);
+  static bool WriteIndexData(const IndexData& data, BlobDataWriter& writer);
+  /// Appends the index data to the data section of the blob.
+  static bool AppendIndexData(const IndexData& index_data,
+                              std::vector<unsigned char>& data);
   bool ReadIndexData(IndexData& data, uint32_t offset) const;
 
   DataHeader* data_ = nullptr;
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "QuadTreeIndexCache.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <olp/core/porting/make_unique.h>
+#include <olp/core/utils/LruCache.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+namespace {
+// The map node and the `IndexData` fields besides the strings.
+constexpr size_t kEntryOverhead = 128u;
+
+std::string CreatePrefix(const std::string& catalog,
+                         const std::string& layer) {
+  return catalog + "::" + layer + "::";
+}
+
+std::string CreateKey(const std::string& catalog, const std::string& layer,
+                      std::int64_t version, const geo::TileKey& root) {
+  return CreatePrefix(catalog, layer) + std::to_string(version) +
+         "::" + root.ToHereTile();
+}
+
+struct DecodedTreeCost {
+  size_t operator()(const QuadTreeIndexCache::DecodedTreePtr& tree) const {
+    return tree->GetSize();
+  }
+};
+}  // namespace
+
+DecodedQuadTreeIndex::DecodedQuadTreeIndex(const QuadTreeIndex& tree)
+    : root_(tree.GetRootTile()), size_(sizeof(DecodedQuadTreeIndex)) {
+  auto index_data = tree.GetIndexData();
+  tiles_.reserve(index_data.size());
+  for (auto& data : index_data) {
+    size_ += kEntryOverhead + data.data_handle.size() + data.checksum.size() +
+             data.additional_metadata.size();
+    levels_ |= std::uint64_t{1} << data.tile_key.Level();
+    const auto key = data.tile_key.ToQuadKey64();
+    tiles_.emplace(key, std::move(data));
+  }
+}
+
+boost::optional<QuadTreeIndex::IndexData> DecodedQuadTreeIndex::Find(
+    const geo::TileKey& tile_key, bool aggregated) const {
+  auto it = tiles_.find(tile_key.ToQuadKey64());
+  if (it != tiles_.end()) {
+    return it->second;
+  }
+
+  if (!aggregated) {
+    return boost::none;
+  }
+
+  // The closest ancestor wins, the same as in `QuadTreeIndex`.
+  for (auto level = tile_key.Level(); level-- > 0u;) {
+    if ((levels_ & (std::uint64_t{1} << level)) == 0u) {
+      continue;
+    }
+
+    it = tiles_.find(tile_key.ChangedLevelTo(level).ToQuadKey64());
+    if (it != tiles_.end()) {
+      return it->second;
+    }
+  }
+  return boost::none;
+}
+
+class QuadTreeIndexCache::Impl {
+ public:
+  explicit Impl(size_t max_size) : trees_(max_size, DecodedTreeCost()) {}
+
+  std::mutex mutex_;
+  utils::LruCache<std::string, DecodedTreePtr, DecodedTreeCost> trees_;
+};
+
+namespace {
+using CacheInstance = std::pair<std::weak_ptr<cache::KeyValueCache>,
+                                std::shared_ptr<QuadTreeIndexCache>>;
+
+std::mutex gInstancesMutex;
+std::vector<CacheInstance> gInstances;
+}  // namespace
+
+QuadTreeIndexCache::QuadTreeIndexCache(size_t max_size)
+    : impl_(std::make_unique<Impl>(max_size)) {}
+
+QuadTreeIndexCache::~QuadTreeIndexCache() = default;
+
+std::shared_ptr<QuadTreeIndexCache> QuadTreeIndexCache::Acquire(
+    const std::shared_ptr<cache::KeyValueCache>& cache, size_t max_size) {
+  if (!cache || max_size == 0u) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(gInstancesMutex);
+  // Release the instances of the destroyed caches, their address may be
+  // reused by a new cache.
+  gInstances.erase(
+      std::remove_if(gInstances.begin(), gInstances.end(),
+                     [](const CacheInstance& instance) {
+                       return instance.first.expired();
+                     }),
+      gInstances.end());
+
+  for (const auto& instance : gInstances) {
+    if (instance.first.lock() == cache) {
+      return instance.second;
+    }
+  }
+
+  auto instance = std::make_shared<QuadTreeIndexCache>(max_size);
+  gInstances.emplace_back(cache, instance);
+  return instance;
+}
+
+std::shared_ptr<QuadTreeIndexCache> QuadTreeIndexCache::Lookup(
+    const cache::KeyValueCache* cache) {
+  if (!cache) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(gInstancesMutex);
+  for (const auto& instance : gInstances) {
+    if (instance.first.lock().get() == cache) {
+      return instance.second;
+    }
+  }
+  return nullptr;
+}
+
+QuadTreeIndexCache::DecodedTreePtr QuadTreeIndexCache::Find(
+    const std::string& catalog, const std::string& layer, std::int64_t version,
+    const geo::TileKey& tile_key, std::int32_t depth) {
+  // Build the keys before taking the lock.
+  std::vector<std::string> keys;
+  const auto max_depth = std::min<std::uint32_t>(tile_key.Level(), depth);
+  keys.reserve(max_depth + 1u);
+  for (auto level = 0u; level <= max_depth; ++level) {
+    keys.emplace_back(
+        CreateKey(catalog, layer, version, tile_key.ChangedLevelBy(-level)));
+  }
+
+  std::lock_guard<std::mutex> lock(impl_->mutex_);
+  for (const auto& key : keys) {
+    auto it = impl_->trees_.Find(key);
+    if (it != impl_->trees_.end()) {
+      return it.value();
+    }
+  }
+  return nullptr;
+}
+
+void QuadTreeIndexCache::Put(const std::string& catalog,
+                             const std::string& layer, std::int64_t version,
+                             DecodedTreePtr tree) {
+  if (!tree) {
+    return;
+  }
+
+  auto key = CreateKey(catalog, layer, version, tree->GetRootTile());
+  std::lock_guard<std::mutex> lock(impl_->mutex_);
+  impl_->trees_.InsertOrAssign(std::move(key), std::move(tree));
+}
+
+void QuadTreeIndexCache::Erase(const std::string& catalog,
+                               const std::string& layer, std::int64_t version,
+                               const geo::TileKey& root) {
+  const auto key = CreateKey(catalog, layer, version, root);
+  std::lock_guard<std::mutex> lock(impl_->mutex_);
+  impl_->trees_.Erase(key);
+}
+
+void QuadTreeIndexCache::Erase(const std::string& catalog,
+                               const std::string& layer) {
+  const auto prefix = CreatePrefix(catalog, layer);
+  std::lock_guard<std::mutex> lock(impl_->mutex_);
+  impl_->trees_.EraseRange(
+      prefix,
+      [&](const std::string& key) { return key.compare(0, prefix.size(),
+                                                       prefix) == 0; },
+      [](const std::string&, const DecodedTreePtr&) { return true; });
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
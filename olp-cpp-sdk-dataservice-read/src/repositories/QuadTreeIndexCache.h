@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/geo/tiling/TileKey.h>
+#include "QuadTreeIndex.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/*
+ * @brief The `QuadTreeIndex` decoded into a hash map, so a tile lookup is
+ * a hash probe per level instead of the binary searches and the string reads
+ * from the blob.
+ *
+ * The aggregated lookups probe only the levels that have quads, so finding the
+ * nearest ancestor takes about as many probes as the tree has levels.
+ */
+class DecodedQuadTreeIndex final {
+ public:
+  explicit DecodedQuadTreeIndex(const QuadTreeIndex& tree);
+
+  /// Finds the same index data as `QuadTreeIndex::Find`.
+  boost::optional<QuadTreeIndex::IndexData> Find(
+      const geo::TileKey& tile_key, bool aggregated) const;
+
+  geo::TileKey GetRootTile() const { return root_; }
+
+  /// The approximate number of bytes used by the decoded index.
+  size_t GetSize() const { return size_; }
+
+ private:
+  geo::TileKey root_;
+  std::unordered_map<std::uint64_t, QuadTreeIndex::IndexData> tiles_;
+  /// The bit of each level that has at least one quad.
+  std::uint64_t levels_{0};
+  size_t size_;
+};
+
+/*
+ * @brief An LRU cache of the decoded quad trees of the versioned layers,
+ * keyed by the catalog, layer, version, and root tile.
+ *
+ * The quad tree of a catalog version never changes, so the entries are shared
+ * by all the clients that use the same `KeyValueCache`. Each `KeyValueCache`
+ * has its own instance, which is released after the `KeyValueCache` is
+ * destroyed. `PartitionsCacheRepository` removes the entries when it clears
+ * the quad trees from the `KeyValueCache`.
+ */
+class QuadTreeIndexCache final {
+ public:
+  using DecodedTreePtr = std::shared_ptr<const DecodedQuadTreeIndex>;
+
+  /// Creates the cache that keeps up to `max_size` bytes of the trees.
+  explicit QuadTreeIndexCache(size_t max_size);
+  ~QuadTreeIndexCache();
+
+  /**
+   * @brief Gets the instance of the `KeyValueCache`, and creates it if there
+   * is none.
+   *
+   * The instance keeps the size that it is created with. Returns `nullptr`
+   * if the `cache` is `nullptr` or `max_size` is 0.
+   */
+  static std::shared_ptr<QuadTreeIndexCache> Acquire(
+      const std::shared_ptr<cache::KeyValueCache>& cache, size_t max_size);
+
+  /// Gets the instance of the `KeyValueCache`, or `nullptr` if there is none.
+  static std::shared_ptr<QuadTreeIndexCache> Lookup(
+      const cache::KeyValueCache* cache);
+
+  /// Finds the tree that has the tile or its ancestor within the depth.
+  DecodedTreePtr Find(const std::string& catalog, const std::string& layer,
+                      std::int64_t version, const geo::TileKey& tile_key,
+                      std::int32_t depth);
+
+  void Put(const std::string& catalog, const std::string& layer,
+           std::int64_t version, DecodedTreePtr tree);
+
+  void Erase(const std::string& catalog, const std::string& layer,
+             std::int64_t version, const geo::TileKey& root);
+
+  /// Removes all the trees of the layer.
+  void Erase(const std::string& catalog, const std::string& layer);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "StreamOffsetsRepository.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/logging/Log.h>
+
+namespace {
+constexpr auto kLogTag = "StreamOffsetsRepository";
+constexpr auto kSeparator = ',';
+constexpr auto kPartitionSeparator = ':';
+}  // namespace
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+StreamOffsetsRepository::StreamOffsetsRepository(
+    const client::HRN& hrn, std::string layer_id,
+    const std::string& checkpoint_id, std::chrono::milliseconds save_interval,
+    std::shared_ptr<cache::KeyValueCache> cache)
+    : key_(hrn.ToCatalogHRNString() + "::" + layer_id + "::" + checkpoint_id +
+           "::streamOffsets"),
+      save_interval_(save_interval),
+      cache_(std::move(cache)) {}
+
+StreamOffsetsRepository::~StreamOffsetsRepository() { Flush(); }
+
+std::vector<model::StreamOffset> StreamOffsetsRepository::Load() {
+  auto value = cache_->Get(key_);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  offsets_.clear();
+  dirty_ = false;
+
+  if (value) {
+    std::istringstream stream(std::string(value->begin(), value->end()));
+    std::string entry;
+    while (std::getline(stream, entry, kSeparator)) {
+      std::istringstream entry_stream(entry);
+      int32_t partition = 0;
+      int64_t offset = 0;
+      char separator = 0;
+      if (entry_stream >> partition >> separator >> offset &&
+          separator == kPartitionSeparator) {
+        offsets_[partition] = offset;
+      }
+    }
+  }
+
+  std::vector<model::StreamOffset> result;
+  result.reserve(offsets_.size());
+  for (const auto& partition_offset : offsets_) {
+    model::StreamOffset offset;
+    offset.SetPartition(partition_offset.first);
+    offset.SetOffset(partition_offset.second);
+    result.push_back(offset);
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Load '%s', partitions=%zu", key_.c_str(),
+                      result.size());
+  return result;
+}
+
+void StreamOffsetsRepository::Commit(
+    const std::vector<model::StreamOffset>& offsets) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& offset : offsets) {
+    auto& saved_offset = offsets_[offset.GetPartition()];
+    saved_offset = std::max(saved_offset, offset.GetOffset());
+  }
+  dirty_ = true;
+
+  const auto now = Clock::now();
+  if (now >= next_save_) {
+    next_save_ = now + save_interval_;
+    Save();
+  }
+}
+
+void StreamOffsetsRepository::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (dirty_) {
+    Save();
+  }
+}
+
+void StreamOffsetsRepository::Save() {
+  std::string value;
+  for (const auto& partition_offset : offsets_) {
+    if (!value.empty()) {
+      value += kSeparator;
+    }
+    value += std::to_string(partition_offset.first);
+    value += kPartitionSeparator;
+    value += std::to_string(partition_offset.second);
+  }
+
+  // The lock keeps the cache entry in the order of the commits.
+  if (!cache_->Put(key_, std::make_shared<cache::KeyValueCache::ValueType>(
+                             value.begin(), value.end()))) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Save: failed to save '%s'", key_.c_str());
+    return;
+  }
+  dirty_ = false;
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <olp/core/client/HRN.h>
+#include <olp/dataservice/read/model/StreamOffsets.h>
+
+namespace olp {
+namespace cache {
+class KeyValueCache;
+}
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/**
+ * @brief Saves the committed offsets of a stream layer subscription.
+ *
+ * The latest offset of each partition is kept in one cache entry. The
+ * commits are merged in memory and the entry is rewritten at most once per
+ * the save interval, so a fast consumer does not write to the cache on each
+ * poll. `Flush` and the destructor write the offsets that are not saved
+ * yet.
+ */
+class StreamOffsetsRepository final {
+ public:
+  StreamOffsetsRepository(const client::HRN& hrn, std::string layer_id,
+                          const std::string& checkpoint_id,
+                          std::chrono::milliseconds save_interval,
+                          std::shared_ptr<cache::KeyValueCache> cache);
+
+  ~StreamOffsetsRepository();
+
+  /// Loads the offsets saved by the previous runs.
+  std::vector<model::StreamOffset> Load();
+
+  /// Adds the committed offsets and saves them if the save interval passed.
+  void Commit(const std::vector<model::StreamOffset>& offsets);
+
+  /// Saves the committed offsets that are not saved yet.
+  void Flush();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /// Writes the offsets, expects the mutex to be held.
+  void Save();
+
+  std::string key_;
+  std::chrono::milliseconds save_interval_;
+  std::shared_ptr<cache::KeyValueCache> cache_;
+
+  std::mutex mutex_;
+  std::map<int32_t, int64_t> offsets_;
+  Clock::time_point next_save_;
+  bool dirty_{false};
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include "AdaptiveConcurrencyLimit.h"
+
+namespace {
+using olp::dataservice::read::AdaptiveConcurrencyLimit;
+using std::chrono::milliseconds;
+
+const auto kStart = AdaptiveConcurrencyLimit::Clock::time_point{} +
+                    std::chrono::hours(1);
+
+TEST(AdaptiveConcurrencyLimitTest, IncreasesWhileThroughputGrows) {
+  AdaptiveConcurrencyLimit limit(4, 10);
+  auto now = kStart;
+
+  // A steady throughput and latency does not stop the growth.
+  limit.OnCompleted(now, milliseconds(100), false);
+  for (size_t completed = 0; completed < 4; ++completed) {
+    now += milliseconds(10);
+    limit.OnCompleted(now, milliseconds(100), false);
+  }
+  EXPECT_EQ(limit.GetLimit(), 5);
+
+  for (size_t completed = 0; completed < 100; ++completed) {
+    now += milliseconds(10);
+    limit.OnCompleted(now, milliseconds(100), false);
+  }
+  EXPECT_EQ(limit.GetLimit(), 10);
+}
+
+TEST(AdaptiveConcurrencyLimitTest, HoldsWhenThroughputDrops) {
+  AdaptiveConcurrencyLimit limit(2, 10);
+  auto now = kStart;
+
+  limit.OnCompleted(now, milliseconds(100), false);
+  for (size_t completed = 0; completed < 2; ++completed) {
+    now += milliseconds(10);
+    limit.OnCompleted(now, milliseconds(100), false);
+  }
+  ASSERT_EQ(limit.GetLimit(), 3);
+
+  for (size_t completed = 0; completed < 3; ++completed) {
+    now += milliseconds(50);
+    limit.OnCompleted(now, milliseconds(100), false);
+  }
+  EXPECT_EQ(limit.GetLimit(), 3);
+}
+
+TEST(AdaptiveConcurrencyLimitTest, BacksOffWhenOverloaded) {
+  AdaptiveConcurrencyLimit limit(8, 10);
+  auto now = kStart;
+
+  limit.OnCompleted(now, milliseconds(100), true);
+  EXPECT_EQ(limit.GetLimit(), 4);
+
+  // The downloads sent with the old limit do not decrease it again.
+  for (size_t completed = 0; completed < 7; ++completed) {
+    now += milliseconds(10);
+    limit.OnCompleted(now, milliseconds(100), true);
+  }
+  EXPECT_EQ(limit.GetLimit(), 4);
+
+  now += milliseconds(10);
+  limit.OnCompleted(now, milliseconds(100), true);
+  EXPECT_EQ(limit.GetLimit(), 2);
+}
+
+TEST(AdaptiveConcurrencyLimitTest, BacksOffOnLatencyGrowth) {
+  AdaptiveConcurrencyLimit limit(8, 8);
+  auto now = kStart;
+
+  for (size_t completed = 0; completed < 8; ++completed) {
+    now += milliseconds(10);
+    limit.OnCompleted(now, milliseconds(100), false);
+  }
+  ASSERT_EQ(limit.GetLimit(), 8);
+
+  for (size_t completed = 0; completed < 8; ++completed) {
+    now += milliseconds(10);
+    limit.OnCompleted(now, milliseconds(400), false);
+  }
+  EXPECT_EQ(limit.GetLimit(), 4);
+}
+
+}  // namespace
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "repositories/BinaryCacheFormat.h"
+
+namespace {
+namespace model = olp::dataservice::read::model;
+namespace binary = olp::dataservice::read::repository::binary;
+
+model::Partition CreatePartition() {
+  model::Partition partition;
+  partition.SetPartition("23618364");
+  partition.SetDataHandle("4eed6ed1-0d32-43b9-ae79-043cb4256432");
+  partition.SetChecksum(std::string("291f66029c232400e3403cd6e9cfd36e"));
+  partition.SetDataSize(int64_t{100500});
+  partition.SetVersion(int64_t{-1});
+  return partition;
+}
+
+TEST(BinaryCacheFormatTest, Partition) {
+  const auto partition = CreatePartition();
+  const auto value = binary::Serialize(partition);
+  EXPECT_TRUE(binary::IsBinary(value));
+
+  const auto parsed = binary::Parse<model::Partition>(value);
+  EXPECT_EQ(parsed.GetPartition(), partition.GetPartition());
+  EXPECT_EQ(parsed.GetDataHandle(), partition.GetDataHandle());
+  EXPECT_EQ(parsed.GetChecksum().get(), partition.GetChecksum().get());
+  EXPECT_EQ(parsed.GetDataSize().get(), 100500);
+  EXPECT_EQ(parsed.GetVersion().get(), -1);
+  EXPECT_FALSE(parsed.GetCompressedDataSize());
+  EXPECT_FALSE(parsed.GetCrc());
+
+  {
+    SCOPED_TRACE("Malformed value");
+    const auto truncated = value.substr(0, value.size() - 1);
+    EXPECT_TRUE(
+        binary::Parse<model::Partition>(truncated).GetPartition().empty());
+    EXPECT_TRUE(
+        binary::Parse<model::Partition>(value + "x").GetPartition().empty());
+  }
+}
+
+TEST(BinaryCacheFormatTest, PartitionIds) {
+  const std::vector<std::string> ids = {"1", "", "23618364"};
+  const auto value = binary::Serialize(ids);
+  EXPECT_TRUE(binary::IsBinary(value));
+  EXPECT_EQ(binary::Parse<std::vector<std::string>>(value), ids);
+
+  const auto empty = binary::Serialize(std::vector<std::string>());
+  EXPECT_TRUE(binary::Parse<std::vector<std::string>>(empty).empty());
+
+  SCOPED_TRACE("Malformed value");
+  auto malformed = value;
+  malformed[2] = 100;
+  EXPECT_TRUE(binary::Parse<std::vector<std::string>>(malformed).empty());
+}
+
+TEST(BinaryCacheFormatTest, Versions) {
+  model::LayerVersion layer_version;
+  layer_version.SetLayer("testlayer");
+  layer_version.SetVersion(4);
+  layer_version.SetTimestamp(1547159598712);
+
+  model::LayerVersions layer_versions;
+  layer_versions.SetVersion(4);
+  layer_versions.SetLayerVersions({layer_version, layer_version});
+
+  const auto parsed_versions = binary::Parse<model::LayerVersions>(
+      binary::Serialize(layer_versions));
+  EXPECT_EQ(parsed_versions.GetVersion(), 4);
+  ASSERT_EQ(parsed_versions.GetLayerVersions().size(), 2u);
+  const auto& parsed_layer = parsed_versions.GetLayerVersions().back();
+  EXPECT_EQ(parsed_layer.GetLayer(), "testlayer");
+  EXPECT_EQ(parsed_layer.GetVersion(), 4);
+  EXPECT_EQ(parsed_layer.GetTimestamp(), 1547159598712);
+
+  model::VersionResponse version;
+  version.SetVersion(123456789);
+  EXPECT_EQ(binary::Parse<model::VersionResponse>(binary::Serialize(version))
+                .GetVersion(),
+            123456789);
+}
+
+TEST(BinaryCacheFormatTest, ReadsJson) {
+  const std::string partition_json =
+      R"({"version":4,"partition":"1111","dataHandle":"qwerty"})";
+  EXPECT_FALSE(binary::IsBinary(partition_json));
+
+  const auto partition = binary::Parse<model::Partition>(partition_json);
+  EXPECT_EQ(partition.GetPartition(), "1111");
+  EXPECT_EQ(partition.GetDataHandle(), "qwerty");
+  EXPECT_EQ(partition.GetVersion().get_value_or(0), 4);
+
+  const auto ids = binary::Parse<std::vector<std::string>>(R"(["1","2"])");
+  EXPECT_EQ(ids, std::vector<std::string>({"1", "2"}));
+
+  const auto version =
+      binary::Parse<model::VersionResponse>(R"({"version":42})");
+  EXPECT_EQ(version.GetVersion(), 42);
+}
+}  // namespace
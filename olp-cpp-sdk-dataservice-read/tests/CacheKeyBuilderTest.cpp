@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gmock/gmock.h>
+
+#include "repositories/CacheKeyBuilder.h"
+
+namespace {
+
+using olp::dataservice::read::repository::CacheKeyBuilder;
+
+constexpr auto kCatalog = "hrn:here:data::olp-here-test:catalog";
+
+TEST(CacheKeyBuilderTest, Key) {
+  const CacheKeyBuilder keys(std::string(kCatalog) + "::layer");
+  const std::string partition = "269";
+  const boost::optional<int64_t> no_version;
+  const boost::optional<int64_t> version = 42;
+
+  {
+    SCOPED_TRACE("Strings");
+
+    EXPECT_EQ(keys.Key({partition, "partition"}),
+              std::string(kCatalog) + "::layer::269::partition");
+  }
+  {
+    SCOPED_TRACE("Version");
+
+    EXPECT_EQ(keys.Key({partition, version, "partition"}),
+              std::string(kCatalog) + "::layer::269::42::partition");
+  }
+  {
+    SCOPED_TRACE("No version");
+
+    EXPECT_EQ(keys.Key({partition, no_version, "partition"}),
+              std::string(kCatalog) + "::layer::269::partition");
+  }
+  {
+    SCOPED_TRACE("Numbers");
+
+    EXPECT_EQ(keys.Key({int64_t{-1}, int64_t{4}, "quadtree"}),
+              std::string(kCatalog) + "::layer::-1::4::quadtree");
+  }
+  {
+    SCOPED_TRACE("Prefix");
+
+    EXPECT_EQ(keys.Prefix(), std::string(kCatalog) + "::layer");
+    EXPECT_EQ(keys.Key({}), keys.Prefix());
+  }
+}
+
+}  // namespace
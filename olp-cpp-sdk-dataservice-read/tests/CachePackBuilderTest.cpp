@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gmock/gmock.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include <olp/dataservice/read/CachePackBuilder.h>
+
+namespace {
+
+using namespace olp::dataservice::read;
+using ErrorCode = olp::client::ErrorCode;
+
+constexpr auto kCatalog = "hrn:here:data::olp-here-test:catalog";
+
+CachePackRequest ValidRequest() {
+  return CachePackRequest()
+      .WithLayerIds({"testlayer"})
+      .WithGeoRectangle(olp::geo::GeoRectangle(
+          olp::geo::GeoCoordinates::FromDegrees(52.0, 13.0),
+          olp::geo::GeoCoordinates::FromDegrees(53.0, 14.0)))
+      .WithMinLevel(10u)
+      .WithMaxLevel(12u)
+      .WithOutputPath("pack");
+}
+
+TEST(CachePackBuilderTest, InvalidRequest) {
+  olp::client::OlpClientSettings settings;
+  CachePackBuilder builder(olp::client::HRN(kCatalog), settings);
+
+  {
+    SCOPED_TRACE("No layers");
+
+    auto response = builder.Build(ValidRequest().WithLayerIds({}));
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(), ErrorCode::InvalidArgument);
+  }
+  {
+    SCOPED_TRACE("No output path");
+
+    auto response = builder.Build(ValidRequest().WithOutputPath(""));
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(), ErrorCode::InvalidArgument);
+  }
+  {
+    SCOPED_TRACE("Empty rectangle");
+
+    auto request = ValidRequest().WithGeoRectangle(olp::geo::GeoRectangle());
+    auto response = builder.Build(request);
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(), ErrorCode::InvalidArgument);
+  }
+  {
+    SCOPED_TRACE("Invalid levels");
+
+    auto response =
+        builder.Build(ValidRequest().WithMinLevel(12u).WithMaxLevel(10u));
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(), ErrorCode::InvalidArgument);
+  }
+  {
+    SCOPED_TRACE("Cancelled");
+
+    olp::client::CancellationContext context;
+    context.CancelOperation();
+    auto response = builder.Build(ValidRequest().WithVersion(3), context);
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(), ErrorCode::Cancelled);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "CatalogContext.h"
+
+#include <gtest/gtest.h>
+#include <matchers/NetworkUrlMatchers.h>
+#include <mocks/NetworkMock.h>
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/dataservice/read/CatalogVersionRequest.h>
+
+namespace {
+namespace client = olp::client;
+namespace read = olp::dataservice::read;
+using ::testing::_;
+
+constexpr auto kLookupMetadata =
+    R"(https://api-lookup.data.api.platform.here.com/lookup/v1/resources/hrn:here:data::olp-here-test:hereos-internal-test-v2/apis)";
+constexpr auto kResponseLookupMetadata =
+    R"jsonString([{"api":"metadata","version":"v1","baseURL":"https://metadata.data.api.platform.here.com/metadata/v1/catalogs/hereos-internal-test-v2","parameters":{}}])jsonString";
+constexpr auto kLatestCatalogVersion =
+    R"(https://metadata.data.api.platform.here.com/metadata/v1/catalogs/hereos-internal-test-v2/versions/latest?startVersion=-1)";
+constexpr auto kResponseLatestCatalogVersion =
+    R"jsonString({"version":4})jsonString";
+
+const auto kHrn = client::HRN::FromString(
+    "hrn:here:data::olp-here-test:hereos-internal-test-v2");
+
+client::OlpClientSettings CreateSettings(
+    std::shared_ptr<NetworkMock> network) {
+  client::OlpClientSettings settings;
+  settings.network_request_handler = std::move(network);
+  settings.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings.retry_settings.timeout = 1;
+  return settings;
+}
+
+TEST(CatalogContextTest, ReusesLatestVersion) {
+  auto network = std::make_shared<NetworkMock>();
+
+  EXPECT_CALL(*network, Send(IsGetRequest(kLookupMetadata), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kResponseLookupMetadata));
+
+  EXPECT_CALL(*network, Send(IsGetRequest(kLatestCatalogVersion), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kResponseLatestCatalogVersion));
+
+  read::CatalogContext context(kHrn, CreateSettings(network));
+
+  const auto request =
+      read::CatalogVersionRequest().WithFetchOption(read::OnlineOnly);
+
+  {
+    SCOPED_TRACE("Online request");
+    auto response =
+        context.GetLatestVersion(request, client::CancellationContext());
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().GetVersion(), 4);
+  }
+
+  {
+    SCOPED_TRACE("Reused response");
+    auto response =
+        context.GetLatestVersion(request, client::CancellationContext());
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().GetVersion(), 4);
+  }
+
+  {
+    SCOPED_TRACE("Pinned version");
+    auto response = context.GetVersion(boost::none, read::OnlineIfNotFound,
+                                       client::CancellationContext());
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().GetVersion(), 4);
+  }
+}
+
+TEST(CatalogContextTest, DoesNotReuseErrors) {
+  auto network = std::make_shared<NetworkMock>();
+
+  EXPECT_CALL(*network, Send(IsGetRequest(kLookupMetadata), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kResponseLookupMetadata));
+
+  EXPECT_CALL(*network, Send(IsGetRequest(kLatestCatalogVersion), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::BAD_REQUEST),
+          "{}"))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kResponseLatestCatalogVersion));
+
+  read::CatalogContext context(kHrn, CreateSettings(network));
+
+  const auto request =
+      read::CatalogVersionRequest().WithFetchOption(read::OnlineOnly);
+
+  auto response =
+      context.GetLatestVersion(request, client::CancellationContext());
+  EXPECT_FALSE(response.IsSuccessful());
+
+  response = context.GetLatestVersion(request, client::CancellationContext());
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().GetVersion(), 4);
+}
+}  // namespace
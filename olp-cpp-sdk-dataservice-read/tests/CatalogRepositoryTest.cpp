@@ -19,11 +19,14 @@
 
 #include "repositories/CatalogRepository.h"
 
+#include <future>
+
 #include <gtest/gtest.h>
 #include <matchers/NetworkUrlMatchers.h>
 #include <mocks/CacheMock.h>
 #include <mocks/NetworkMock.h>
 #include <olp/core/client/OlpClientFactory.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
 #include "ApiClientLookup.h"
 #include "olp/dataservice/read/CatalogRequest.h"
 #include "olp/dataservice/read/CatalogVersionRequest.h"
@@ -681,4 +684,58 @@ TEST_F(CatalogRepositoryTest, GetVersionsList) {
               response.GetError().GetErrorCode());
   }
 }
+
+TEST_F(CatalogRepositoryTest, GetCatalogStaleWhileRevalidate) {
+  olp::client::CancellationContext context;
+
+  settings_.max_staleness = std::chrono::seconds(60);
+  settings_.task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(1);
+
+  auto request = read::CatalogRequest();
+  request.WithFetchOption(read::OnlineIfNotFound);
+
+  // The cache drops the catalog right away, like an expired one.
+  ON_CALL(*cache_, Contains(_)).WillByDefault(testing::Return(false));
+  ON_CALL(*cache_, Get(_, _)).WillByDefault(testing::Return(boost::any{}));
+  ON_CALL(*cache_, Put(_, _, _, _)).WillByDefault(testing::Return(true));
+
+  std::promise<void> refreshed;
+  EXPECT_CALL(*cache_, Put(testing::Eq(kCatalogCacheKey), _, _, _))
+      .Times(2)
+      .WillOnce(testing::Return(true))
+      .WillOnce([&](const std::string&, const boost::any&,
+                    const olp::cache::Encoder&, time_t) {
+        refreshed.set_value();
+        return true;
+      });
+
+  ON_CALL(*network_, Send(IsGetRequest(kUrlLookupConfig), _, _, _, _))
+      .WillByDefault(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                            olp::http::HttpStatusCode::OK),
+                                        kResponseLookupConfig));
+
+  EXPECT_CALL(*network_, Send(IsGetRequest(kUrlConfig), _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kResponseConfig));
+
+  ApiLookupClient lookup_client(kHrn, settings_);
+  repository::CatalogRepository repository(kHrn, settings_, lookup_client);
+
+  auto response = repository.GetCatalog(request, context);
+  ASSERT_TRUE(response.IsSuccessful());
+
+  // The expired catalog is returned, and the refresh runs in the background.
+  response = repository.GetCatalog(request, context);
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().GetVersion(), 3);
+
+  EXPECT_EQ(refreshed.get_future().wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  testing::Mock::VerifyAndClearExpectations(network_.get());
+  testing::Mock::VerifyAndClearExpectations(cache_.get());
+}
 }  // namespace
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <mocks/CacheMock.h>
+#include "repositories/CatalogSnapshotCache.h"
+
+namespace {
+namespace model = olp::dataservice::read::model;
+using olp::dataservice::read::repository::CatalogSnapshot;
+using olp::dataservice::read::repository::CatalogSnapshotCache;
+
+constexpr auto kCatalog = "hrn:here:data::olp-here-test:catalog";
+
+CatalogSnapshot::CatalogPtr CreateCatalog(
+    const std::vector<std::string>& layer_ids) {
+  std::vector<model::Layer> layers;
+  for (const auto& id : layer_ids) {
+    model::Layer layer;
+    layer.SetId(id);
+    layer.SetTtl(static_cast<int64_t>(id.size()) * 1000);
+    layers.push_back(layer);
+  }
+
+  auto catalog = std::make_shared<model::Catalog>();
+  catalog->SetHrn(kCatalog);
+  catalog->SetLayers(layers);
+  return catalog;
+}
+
+model::VersionResponse CreateVersion(int64_t value) {
+  model::VersionResponse version;
+  version.SetVersion(value);
+  return version;
+}
+
+TEST(CatalogSnapshotCacheTest, FindLayer) {
+  CatalogSnapshot snapshot(CreateCatalog({"a", "bb", "ccc"}), boost::none);
+
+  const auto* layer = snapshot.FindLayer("bb");
+  ASSERT_NE(layer, nullptr);
+  EXPECT_EQ(layer->GetId(), "bb");
+  EXPECT_EQ(layer->GetTtl().get(), 2000);
+  EXPECT_EQ(snapshot.FindLayer("d"), nullptr);
+
+  CatalogSnapshot version_only(nullptr, CreateVersion(3));
+  EXPECT_EQ(version_only.FindLayer("a"), nullptr);
+}
+
+TEST(CatalogSnapshotCacheTest, UpdateSnapshot) {
+  auto& snapshots = CatalogSnapshotCache::Instance();
+  std::shared_ptr<olp::cache::KeyValueCache> cache =
+      std::make_shared<testing::NiceMock<CacheMock>>();
+
+  EXPECT_EQ(snapshots.Find(cache, kCatalog), nullptr);
+
+  auto catalog = CreateCatalog({"a"});
+  auto snapshot = snapshots.PutCatalog(cache, kCatalog, catalog);
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshots.Find(cache, kCatalog), snapshot);
+  EXPECT_EQ(snapshot->GetCatalog(), catalog);
+  EXPECT_FALSE(snapshot->GetVersion());
+
+  {
+    SCOPED_TRACE("The version keeps the catalog");
+    auto updated = snapshots.PutVersion(cache, kCatalog, CreateVersion(7));
+    EXPECT_EQ(updated->GetCatalog(), catalog);
+    ASSERT_TRUE(updated->GetVersion());
+    EXPECT_EQ(updated->GetVersion()->GetVersion(), 7);
+
+    // The previous snapshot does not change.
+    EXPECT_FALSE(snapshot->GetVersion());
+  }
+
+  {
+    SCOPED_TRACE("The catalog keeps the version");
+    auto updated =
+        snapshots.PutCatalog(cache, kCatalog, CreateCatalog({"b"}));
+    EXPECT_NE(updated->FindLayer("b"), nullptr);
+    ASSERT_TRUE(updated->GetVersion());
+    EXPECT_EQ(updated->GetVersion()->GetVersion(), 7);
+  }
+
+  snapshots.Erase(cache, kCatalog);
+  EXPECT_EQ(snapshots.Find(cache, kCatalog), nullptr);
+}
+
+TEST(CatalogSnapshotCacheTest, SnapshotPerCache) {
+  auto& snapshots = CatalogSnapshotCache::Instance();
+  std::shared_ptr<olp::cache::KeyValueCache> cache =
+      std::make_shared<testing::NiceMock<CacheMock>>();
+  std::shared_ptr<olp::cache::KeyValueCache> other_cache =
+      std::make_shared<testing::NiceMock<CacheMock>>();
+
+  snapshots.PutCatalog(cache, kCatalog, CreateCatalog({"a"}));
+  EXPECT_NE(snapshots.Find(cache, kCatalog), nullptr);
+  EXPECT_EQ(snapshots.Find(other_cache, kCatalog), nullptr);
+  EXPECT_EQ(snapshots.Find(cache, "hrn:here:data::olp-here-test:other"),
+            nullptr);
+
+  {
+    SCOPED_TRACE("A destroyed cache is not matched");
+    std::weak_ptr<olp::cache::KeyValueCache> destroyed = cache;
+    cache.reset();
+    EXPECT_TRUE(destroyed.expired());
+
+    cache = std::make_shared<testing::NiceMock<CacheMock>>();
+    EXPECT_EQ(snapshots.Find(cache, kCatalog), nullptr);
+  }
+
+  snapshots.Erase(other_cache, kCatalog);
+}
+}  // namespace
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include <olp/dataservice/read/model/CompactPartitions.h>
+
+namespace {
+namespace model = olp::dataservice::read::model;
+using model::CompactPartitions;
+
+model::Partitions CreatePartitions() {
+  model::Partition first;
+  first.SetPartition("first");
+  first.SetDataHandle("first-handle");
+  first.SetChecksum(std::string("first-checksum"));
+  first.SetDataSize(100);
+  first.SetCompressedDataSize(50);
+  first.SetCrc(std::string("first-crc"));
+  first.SetVersion(3);
+
+  model::Partition second;
+  second.SetPartition("second");
+  second.SetDataHandle("");
+
+  model::Partitions partitions;
+  partitions.SetPartitions({first, second});
+  return partitions;
+}
+
+TEST(CompactPartitionsTest, StoresAllFields) {
+  const auto partitions = CreatePartitions();
+  const CompactPartitions compact(partitions);
+
+  ASSERT_EQ(compact.GetSize(), 2u);
+  EXPECT_FALSE(compact.IsEmpty());
+
+  const auto first = compact[0];
+  EXPECT_EQ(first.GetPartition(), "first");
+  EXPECT_EQ(first.GetDataHandle(), "first-handle");
+  ASSERT_TRUE(first.GetChecksum());
+  EXPECT_EQ(first.GetChecksum().get(), "first-checksum");
+  EXPECT_EQ(first.GetDataSize().get(), 100);
+  EXPECT_EQ(first.GetCompressedDataSize().get(), 50);
+  ASSERT_TRUE(first.GetCrc());
+  EXPECT_EQ(first.GetCrc().get(), "first-crc");
+  EXPECT_EQ(first.GetVersion().get(), 3);
+
+  const auto second = compact[1];
+  EXPECT_EQ(second.GetPartition(), "second");
+  EXPECT_TRUE(second.GetDataHandle().empty());
+  EXPECT_FALSE(second.GetChecksum());
+  EXPECT_FALSE(second.GetDataSize());
+  EXPECT_FALSE(second.GetCompressedDataSize());
+  EXPECT_FALSE(second.GetCrc());
+  EXPECT_FALSE(second.GetVersion());
+}
+
+TEST(CompactPartitionsTest, StoresProjectedFields) {
+  const CompactPartitions compact(CreatePartitions(),
+                                  CompactPartitions::kDataHandle);
+
+  EXPECT_EQ(compact.GetFields(),
+            CompactPartitions::kPartition | CompactPartitions::kDataHandle);
+  ASSERT_EQ(compact.GetSize(), 2u);
+
+  const auto first = compact[0];
+  EXPECT_EQ(first.GetPartition(), "first");
+  EXPECT_EQ(first.GetDataHandle(), "first-handle");
+  EXPECT_FALSE(first.GetChecksum());
+  EXPECT_FALSE(first.GetDataSize());
+  EXPECT_FALSE(first.GetCrc());
+  EXPECT_FALSE(first.GetVersion());
+}
+
+TEST(CompactPartitionsTest, Materialize) {
+  const auto partitions = CreatePartitions();
+  const CompactPartitions compact(partitions);
+
+  for (size_t i = 0; i < compact.GetSize(); ++i) {
+    const auto& expected = partitions.GetPartitions()[i];
+    const auto partition = compact[i].Materialize();
+    EXPECT_EQ(partition.GetPartition(), expected.GetPartition());
+    EXPECT_EQ(partition.GetDataHandle(), expected.GetDataHandle());
+    EXPECT_TRUE(partition.GetChecksum() == expected.GetChecksum());
+    EXPECT_TRUE(partition.GetDataSize() == expected.GetDataSize());
+    EXPECT_TRUE(partition.GetCompressedDataSize() ==
+                expected.GetCompressedDataSize());
+    EXPECT_TRUE(partition.GetCrc() == expected.GetCrc());
+    EXPECT_TRUE(partition.GetVersion() == expected.GetVersion());
+  }
+}
+
+TEST(CompactPartitionsTest, Append) {
+  CompactPartitions compact(CompactPartitions::kVersion);
+  EXPECT_TRUE(compact.IsEmpty());
+
+  const auto partitions = CreatePartitions();
+  for (const auto& partition : partitions.GetPartitions()) {
+    compact.Append(partition);
+  }
+
+  ASSERT_EQ(compact.GetSize(), 2u);
+  EXPECT_EQ(compact[0].GetVersion().get(), 3);
+  EXPECT_FALSE(compact[1].GetVersion());
+  EXPECT_TRUE(compact[0].GetDataHandle().empty());
+}
+
+}  // namespace
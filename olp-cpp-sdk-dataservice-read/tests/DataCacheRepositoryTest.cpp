@@ -102,4 +102,46 @@ TEST(PartitionsCacheRepositoryTest, IsCached) {
   }
 }
 
+TEST(PartitionsCacheRepositoryTest, ExpiredETag) {
+  const auto hrn = client::HRN::FromString(kCatalog);
+  const auto layer = "layer";
+
+  const auto data = std::vector<unsigned char>{1, 2, 3};
+  const auto model_data = std::make_shared<std::vector<unsigned char>>(data);
+
+  std::shared_ptr<cache::KeyValueCache> cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  repository::DataCacheRepository expired(hrn, cache, std::chrono::seconds(-1));
+  repository::DataCacheRepository fresh(hrn, cache, std::chrono::seconds(60));
+
+  {
+    SCOPED_TRACE("Kept past the expiry");
+
+    expired.Put(model_data, layer, kDataHandle, "\"etag\"");
+
+    EXPECT_TRUE(expired.Get(layer, kDataHandle));
+    EXPECT_FALSE(expired.IsCached(layer, kDataHandle));
+    EXPECT_EQ(std::string("\"etag\""),
+              expired.GetExpiredETag(layer, kDataHandle).get_value_or(""));
+  }
+
+  {
+    SCOPED_TRACE("Revalidated");
+
+    fresh.Revalidate(layer, kDataHandle, "\"etag\"");
+
+    EXPECT_TRUE(fresh.IsCached(layer, kDataHandle));
+    EXPECT_FALSE(fresh.GetExpiredETag(layer, kDataHandle));
+  }
+
+  {
+    SCOPED_TRACE("Cleared with the data");
+
+    fresh.Clear(layer, kDataHandle);
+
+    EXPECT_FALSE(fresh.Get(layer, kDataHandle));
+    EXPECT_FALSE(fresh.GetExpiredETag(layer, kDataHandle));
+  }
+}
+
 }  // namespace
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DataDecompressor.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+namespace model = olp::dataservice::read::model;
+
+const std::string kText = "Hello, decompressed world!";
+// kText compressed with gzip.
+const std::vector<unsigned char> kCompressed = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xf3, 0x48,
+    0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0x48, 0x49, 0x4d, 0xce, 0xcf, 0x2d, 0x28,
+    0x4a, 0x2d, 0x2e, 0x4e, 0x4d, 0x51, 0x28, 0xcf, 0x2f, 0xca, 0x49, 0x51,
+    0x04, 0x00, 0x23, 0x95, 0x82, 0x34, 0x1a, 0x00, 0x00, 0x00};
+
+model::Data MakeData(std::vector<unsigned char> bytes) {
+  return std::make_shared<std::vector<unsigned char>>(std::move(bytes));
+}
+
+TEST(DataDecompressorTest, IsGzipCompressed) {
+  EXPECT_TRUE(read::IsGzipCompressed(MakeData(kCompressed)));
+  EXPECT_FALSE(read::IsGzipCompressed(
+      MakeData(std::vector<unsigned char>(kText.begin(), kText.end()))));
+  EXPECT_FALSE(read::IsGzipCompressed(nullptr));
+  EXPECT_FALSE(read::IsGzipCompressed(MakeData({0x1f, 0x8b})));
+}
+
+TEST(DataDecompressorTest, DecompressData) {
+  {
+    SCOPED_TRACE("Compressed data");
+    const auto response = read::DecompressData(MakeData(kCompressed));
+    if (response.IsSuccessful()) {
+      const auto& data = *response.GetResult();
+      EXPECT_EQ(std::string(data.begin(), data.end()), kText);
+    } else {
+      // The SDK is built without zlib.
+      EXPECT_EQ(response.GetError().GetErrorCode(),
+                olp::client::ErrorCode::PreconditionFailed);
+    }
+  }
+
+  {
+    SCOPED_TRACE("Not compressed data");
+    const auto data =
+        MakeData(std::vector<unsigned char>(kText.begin(), kText.end()));
+    const auto response = read::DecompressData(data);
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult(), data);
+  }
+
+  {
+    SCOPED_TRACE("Truncated data");
+    auto truncated = kCompressed;
+    truncated.resize(truncated.size() - 10u);
+    EXPECT_FALSE(read::DecompressData(MakeData(truncated)).IsSuccessful());
+  }
+
+  {
+    SCOPED_TRACE("Error response");
+    const read::DataResponse error(
+        olp::client::ApiError(olp::client::ErrorCode::NotFound, "Not found"));
+    const auto response = read::DecompressData(error);
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              olp::client::ErrorCode::NotFound);
+  }
+}
+
+}  // namespace
@@ -212,6 +212,108 @@ TEST_F(DataRepositoryTest, GetBlobDataCache) {
   ASSERT_TRUE(response.IsSuccessful());
 }
 
+TEST_F(DataRepositoryTest, GetBlobDataChecksum) {
+  // SHA-1 of "someData".
+  const std::string checksum = "aa01cd6bcf61a542ed9aab6a4f4e375d223fec63";
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseLookup));
+
+  olp::client::CancellationContext context;
+
+  olp::dataservice::read::DataRequest request;
+  request.WithDataHandle(kUrlBlobDataHandle);
+
+  olp::client::HRN hrn(GetTestCatalog());
+  ApiLookupClient lookup_client(hrn, *settings_);
+  DataRepository repository(hrn, *settings_, lookup_client);
+
+  {
+    SCOPED_TRACE("Mismatch is not cached");
+    EXPECT_CALL(*network_mock_,
+                Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     "corrupted"));
+
+    auto response = repository.GetBlobData(kLayerId, kService, request,
+                                           context, checksum);
+    ASSERT_FALSE(response.IsSuccessful());
+    testing::Mock::VerifyAndClearExpectations(network_mock_.get());
+  }
+
+  {
+    SCOPED_TRACE("Match is cached");
+    EXPECT_CALL(*network_mock_,
+                Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     "someData"));
+
+    auto response = repository.GetBlobData(kLayerId, kService, request,
+                                           context, checksum);
+    ASSERT_TRUE(response.IsSuccessful());
+
+    response = repository.GetBlobData(kLayerId, kService, request, context,
+                                      checksum);
+    ASSERT_TRUE(response.IsSuccessful());
+  }
+}
+
+TEST_F(DataRepositoryTest, StreamVersionedData) {
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseLookup));
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   "someData"));
+
+  olp::client::CancellationContext context;
+
+  olp::dataservice::read::DataRequest request;
+  request.WithDataHandle(kUrlBlobDataHandle);
+
+  olp::client::HRN hrn(GetTestCatalog());
+  ApiLookupClient lookup_client(hrn, *settings_);
+  DataRepository repository(hrn, *settings_, lookup_client);
+
+  std::string streamed;
+  auto chunk_callback = [&](const std::uint8_t* data, std::uint64_t offset,
+                            std::size_t length) {
+    streamed.resize(offset);
+    streamed.append(reinterpret_cast<const char*>(data), length);
+  };
+
+  auto response = repository.StreamVersionedData(kLayerId, request, 4,
+                                                 chunk_callback, context);
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(streamed, "someData");
+
+  {
+    SCOPED_TRACE("Streamed data is cached");
+    streamed.clear();
+    request.WithFetchOption(olp::dataservice::read::CacheOnly);
+    response = repository.StreamVersionedData(kLayerId, request, 4,
+                                              chunk_callback, context);
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(streamed, "someData");
+  }
+
+  {
+    SCOPED_TRACE("Decompression is rejected");
+    request.WithDecompression(true);
+    response = repository.StreamVersionedData(kLayerId, request, 4,
+                                              chunk_callback, context);
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              olp::client::ErrorCode::InvalidArgument);
+  }
+}
+
 TEST_F(DataRepositoryTest, GetBlobDataImmediateCancel) {
   ON_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
       .WillByDefault(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include "DependencyResolverHelpers.h"
+
+namespace {
+using olp::dataservice::read::GroupTilesByQuadTree;
+using olp::dataservice::read::ParallelFor;
+using olp::dataservice::read::TileKeys;
+using olp::geo::TileKey;
+
+TEST(DependencyResolverHelpersTest, GroupTilesByQuadTree) {
+  const auto root = TileKey::FromRowColumnLevel(10, 10, 10);
+  const auto other_root = TileKey::FromRowColumnLevel(10, 11, 10);
+
+  {
+    SCOPED_TRACE("Tiles on one level are grouped by the quad tree root");
+    const TileKeys tiles = {root.ChangedLevelBy(4),
+                            other_root.ChangedLevelBy(4),
+                            root.ChangedLevelBy(4).NextColumn()};
+    const auto groups = GroupTilesByQuadTree(tiles, 4);
+    ASSERT_EQ(groups.size(), 2u);
+    EXPECT_EQ(groups[0], TileKeys({tiles[0], tiles[2]}));
+    EXPECT_EQ(groups[1], TileKeys({tiles[1]}));
+  }
+
+  {
+    SCOPED_TRACE("The upper level tile shares the quad trees with the others");
+    const TileKeys tiles = {root.ChangedLevelBy(4),
+                            other_root.ChangedLevelBy(4),
+                            root.Parent().ChangedLevelBy(2)};
+    const auto groups = GroupTilesByQuadTree(tiles, 4);
+    ASSERT_EQ(groups.size(), 1u);
+    EXPECT_EQ(groups[0], tiles);
+  }
+
+  EXPECT_TRUE(GroupTilesByQuadTree({}, 4).empty());
+}
+
+TEST(DependencyResolverHelpersTest, ParallelFor) {
+  constexpr size_t kCount = 1000u;
+
+  {
+    SCOPED_TRACE("Without scheduler");
+    std::vector<int> calls(kCount, 0);
+    ParallelFor(kCount, nullptr, [&](size_t index) { ++calls[index]; });
+    EXPECT_EQ(calls, std::vector<int>(kCount, 1));
+  }
+
+  {
+    SCOPED_TRACE("With scheduler");
+    std::shared_ptr<olp::thread::TaskScheduler> scheduler =
+        olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(4u);
+    std::vector<std::atomic<int>> calls(kCount);
+    for (auto& call : calls) {
+      call.store(0);
+    }
+    ParallelFor(kCount, scheduler, [&](size_t index) { ++calls[index]; });
+    for (const auto& call : calls) {
+      EXPECT_EQ(call.load(), 1);
+    }
+  }
+
+  {
+    SCOPED_TRACE("With bounded workers");
+    std::shared_ptr<olp::thread::TaskScheduler> scheduler =
+        olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(4u);
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    std::atomic<int> calls{0};
+    ParallelFor(
+        kCount, scheduler,
+        [&](size_t) {
+          const auto now_running = ++running;
+          auto max = max_running.load();
+          while (now_running > max &&
+                 !max_running.compare_exchange_weak(max, now_running)) {
+          }
+          ++calls;
+          --running;
+        },
+        2u);
+    EXPECT_EQ(calls.load(), static_cast<int>(kCount));
+    EXPECT_LE(max_running.load(), 2);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <mocks/CacheMock.h>
+#include <olp/core/http/RequestPriorityScope.h>
+#include <olp/core/porting/make_unique.h>
+#include <olp/core/thread/TaskScheduler.h>
+#include "repositories/InflightBlobRequest.h"
+
+namespace {
+namespace client = olp::client;
+namespace read = olp::dataservice::read;
+using read::BlobApi;
+using read::repository::InflightBlobRequest;
+
+const auto kCatalog = client::HRN::FromString("hrn:here:data::olp-here:test");
+constexpr auto kLayer = "layer";
+constexpr auto kDataHandle = "4eed6ed1-0d32-43b9-ae79-043cb4256432";
+// Only the identity of the cache is used.
+CacheMock cache_mock;
+const olp::cache::KeyValueCache* const kCache = &cache_mock;
+
+TEST(InflightBlobRequestTest, SharesResponse) {
+  auto leader = std::make_unique<InflightBlobRequest>(kCache, kCatalog,
+                                                      kLayer, kDataHandle);
+  ASSERT_TRUE(leader->IsLeader());
+
+  InflightBlobRequest follower(kCache, kCatalog, kLayer, kDataHandle);
+  EXPECT_FALSE(follower.IsLeader());
+
+  {
+    SCOPED_TRACE("Other blobs are not shared");
+    InflightBlobRequest other_handle(kCache, kCatalog, kLayer, "other");
+    EXPECT_TRUE(other_handle.IsLeader());
+    InflightBlobRequest other_layer(kCache, kCatalog, "other", kDataHandle);
+    EXPECT_TRUE(other_layer.IsLeader());
+    CacheMock other_cache;
+    InflightBlobRequest other_cache_request(&other_cache, kCatalog, kLayer,
+                                            kDataHandle);
+    EXPECT_TRUE(other_cache_request.IsLeader());
+  }
+
+  auto data = std::make_shared<std::vector<unsigned char>>(4u, 'a');
+  auto waiting = std::async(std::launch::async, [&]() {
+    return follower.Wait(client::CancellationContext());
+  });
+  leader->Complete(BlobApi::DataResponse(data));
+  leader.reset();
+
+  auto response = waiting.get();
+  ASSERT_TRUE(response);
+  ASSERT_TRUE(response->IsSuccessful());
+  EXPECT_EQ(response->GetResult(), data);
+
+  {
+    SCOPED_TRACE("Completed flight is not joined");
+    InflightBlobRequest next(kCache, kCatalog, kLayer, kDataHandle);
+    EXPECT_TRUE(next.IsLeader());
+  }
+}
+
+TEST(InflightBlobRequestTest, CancelledLeaderIsNotShared) {
+  {
+    SCOPED_TRACE("Cancelled response");
+    InflightBlobRequest leader(kCache, kCatalog, kLayer, kDataHandle);
+    InflightBlobRequest follower(kCache, kCatalog, kLayer, kDataHandle);
+    leader.Complete(BlobApi::DataResponse(client::ApiError::Cancelled()));
+    EXPECT_FALSE(follower.Wait(client::CancellationContext()));
+  }
+  {
+    SCOPED_TRACE("Leader without response");
+    auto leader = std::make_unique<InflightBlobRequest>(kCache, kCatalog,
+                                                        kLayer, kDataHandle);
+    InflightBlobRequest follower(kCache, kCatalog, kLayer, kDataHandle);
+    leader.reset();
+    EXPECT_FALSE(follower.Wait(client::CancellationContext()));
+  }
+  {
+    SCOPED_TRACE("Errors are not shared");
+    InflightBlobRequest leader(kCache, kCatalog, kLayer, kDataHandle);
+    InflightBlobRequest follower(kCache, kCatalog, kLayer, kDataHandle);
+    leader.Complete(BlobApi::DataResponse(
+        client::ApiError(client::ErrorCode::AccessDenied, "Forbidden")));
+    EXPECT_FALSE(follower.Wait(client::CancellationContext()));
+  }
+}
+
+TEST(InflightBlobRequestTest, CancelWaiting) {
+  InflightBlobRequest leader(kCache, kCatalog, kLayer, kDataHandle);
+  InflightBlobRequest follower(kCache, kCatalog, kLayer, kDataHandle);
+
+  client::CancellationContext context;
+  auto waiting = std::async(std::launch::async,
+                            [&]() { return follower.Wait(context); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  context.CancelOperation();
+
+  auto response = waiting.get();
+  ASSERT_TRUE(response);
+  EXPECT_EQ(response->GetError().GetErrorCode(),
+            client::ErrorCode::Cancelled);
+
+  {
+    SCOPED_TRACE("Cancelled context");
+    auto cancelled = follower.Wait(context);
+    ASSERT_TRUE(cancelled);
+    EXPECT_EQ(cancelled->GetError().GetErrorCode(),
+              client::ErrorCode::Cancelled);
+  }
+}
+
+TEST(InflightBlobRequestTest, OnCompleteDoesNotBlock) {
+  using SharedResponse = boost::optional<BlobApi::DataResponse>;
+  auto data = std::make_shared<std::vector<unsigned char>>(4u, 'a');
+
+  {
+    SCOPED_TRACE("Response of the leader");
+    InflightBlobRequest leader(kCache, kCatalog, kLayer, kDataHandle);
+    InflightBlobRequest follower(kCache, kCatalog, kLayer, kDataHandle);
+
+    std::vector<SharedResponse> responses;
+    follower.OnComplete(client::CancellationContext(),
+                        [&](SharedResponse response) {
+                          responses.push_back(std::move(response));
+                        });
+    EXPECT_TRUE(responses.empty());
+
+    leader.Complete(BlobApi::DataResponse(data));
+    ASSERT_EQ(responses.size(), 1u);
+    ASSERT_TRUE(responses.front());
+    EXPECT_EQ(responses.front()->GetResult(), data);
+
+    SCOPED_TRACE("Completed flight");
+    follower.OnComplete(client::CancellationContext(),
+                        [&](SharedResponse response) {
+                          responses.push_back(std::move(response));
+                        });
+    ASSERT_EQ(responses.size(), 2u);
+    ASSERT_TRUE(responses.back());
+    EXPECT_EQ(responses.back()->GetResult(), data);
+  }
+
+  {
+    SCOPED_TRACE("Cancelled once");
+    InflightBlobRequest leader(kCache, kCatalog, kLayer, kDataHandle);
+    InflightBlobRequest follower(kCache, kCatalog, kLayer, kDataHandle);
+
+    client::CancellationContext context;
+    std::vector<SharedResponse> responses;
+    follower.OnComplete(context, [&](SharedResponse response) {
+      responses.push_back(std::move(response));
+    });
+    context.CancelOperation();
+    leader.Complete(BlobApi::DataResponse(data));
+
+    ASSERT_EQ(responses.size(), 1u);
+    ASSERT_TRUE(responses.front());
+    EXPECT_EQ(responses.front()->GetError().GetErrorCode(),
+              client::ErrorCode::Cancelled);
+  }
+}
+
+TEST(InflightBlobRequestTest, WaitingPromotesLeader) {
+  std::unique_ptr<InflightBlobRequest> leader;
+  {
+    olp::http::RequestPriorityScope scope(olp::thread::LOW);
+    leader = std::make_unique<InflightBlobRequest>(kCache, kCatalog,
+                                                   kLayer, kDataHandle);
+  }
+  auto handle = leader->GetPriorityHandle();
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(olp::thread::LOW, handle->GetPriority());
+
+  {
+    SCOPED_TRACE("Leader sends with the handle priority");
+    olp::http::RequestPriorityScope scope(handle);
+    EXPECT_EQ(olp::thread::LOW,
+              olp::http::RequestPriorityScope::GetCurrentPriority());
+    EXPECT_EQ(handle, olp::http::RequestPriorityScope::GetCurrentHandle());
+  }
+
+  InflightBlobRequest follower(kCache, kCatalog, kLayer, kDataHandle);
+  auto waiting = std::async(std::launch::async, [&]() {
+    olp::http::RequestPriorityScope scope(olp::thread::HIGH);
+    return follower.Wait(client::CancellationContext());
+  });
+
+  // The flight completes only after the follower promoted it.
+  while (handle->GetPriority() != olp::thread::HIGH) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  leader->Complete(BlobApi::DataResponse(
+      std::make_shared<std::vector<unsigned char>>(1u, 'a')));
+
+  auto response = waiting.get();
+  ASSERT_TRUE(response);
+  EXPECT_TRUE(response->IsSuccessful());
+}
+}  // namespace
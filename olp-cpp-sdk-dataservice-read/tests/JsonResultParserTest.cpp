@@ -17,7 +17,9 @@
  * License-Filename: LICENSE
  */
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 // clang-format off
@@ -84,6 +86,50 @@ TEST(JsonResultParserTest, ParseResult) {
   }
 }
 
+TEST(JsonResultParserTest, ParseResultFromResponseBuffer) {
+  auto partitions =
+      mockserver::ReadDefaultResponses::GeneratePartitionsResponse();
+  auto partitions_string = olp::serializer::serialize(partitions);
+
+  {
+    SCOPED_TRACE("Verify valid partitions response");
+    auto buffer = std::make_shared<std::vector<unsigned char>>(
+        partitions_string.begin(), partitions_string.end());
+    olp::client::HttpResponse http_response(200, buffer, {});
+
+    auto response =
+        olp::parser::parse_result<dr::PartitionsResponse>(http_response);
+    ASSERT_TRUE(response.IsSuccessful());
+    ASSERT_EQ(10u, response.GetResult().GetPartitions().size());
+
+    // The buffer is read in place and stays unchanged.
+    EXPECT_EQ(buffer, http_response.GetResponseBuffer());
+    EXPECT_EQ(partitions_string, std::string(buffer->begin(), buffer->end()));
+  }
+  {
+    SCOPED_TRACE("Verify corrupted with additional symbol");
+    const auto json = partitions_string + "_";
+    olp::client::HttpResponse http_response(
+        200,
+        std::make_shared<std::vector<unsigned char>>(json.begin(), json.end()),
+        {});
+
+    auto response =
+        olp::parser::parse_result<dr::PartitionsResponse>(http_response);
+    ASSERT_FALSE(response.IsSuccessful());
+    ASSERT_EQ(response.GetError().GetMessage(), "Fail parsing response.");
+  }
+  {
+    SCOPED_TRACE("Verify response stream");
+    olp::client::HttpResponse http_response(200, partitions_string);
+
+    auto response =
+        olp::parser::parse_result<dr::PartitionsResponse>(http_response);
+    ASSERT_TRUE(response.IsSuccessful());
+    ASSERT_EQ(10u, response.GetResult().GetPartitions().size());
+  }
+}
+
 TEST(JsonResultParserTest, ExtendedResponse) {
   auto partitions =
       mockserver::ReadDefaultResponses::GeneratePartitionsResponse();
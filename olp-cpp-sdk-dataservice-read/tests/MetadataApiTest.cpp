@@ -42,6 +42,12 @@ constexpr auto kUrlVersionsListBillingTag =
 constexpr auto kHttpVersionsListResponse =
     R"jsonString({"versions":[{"version":4,"timestamp":1547159598712,"partitionCounts":{"testlayer":5,"testlayer_res":1,"multilevel_testlayer":33, "hype-test-prefetch-2":7,"testlayer_gzip":1,"hype-test-prefetch":7},"dependencies":[ { "hrn":"hrn:here:data::olp-here-test:hereos-internal-test-v2","version":0,"direct":false},{"hrn":"hrn:here:data:::hereos-internal-test-v2","version":0,"direct":false }]}]})jsonString";
 
+constexpr auto kUrlPartitions =
+    R"(https://some.node.base.url/metadata/v1/catalogs/hrn:here:data::olp-here-test:hereos-internal-test-v2/layers/testlayer/partitions?version=4)";
+
+constexpr auto kHttpPartitionsResponse =
+    R"jsonString({"partitions":[{"version":4,"partition":"1","dataHandle":"a"}]})jsonString";
+
 using ::testing::_;
 namespace http = olp::http;
 namespace client = olp::client;
@@ -125,4 +131,84 @@ TEST_F(MetadataApiTest, GetListVersions) {
   }
 }
 
+TEST_F(MetadataApiTest, GetPartitionsPage) {
+  using olp::dataservice::read::MetadataApi;
+  const std::string body = kHttpPartitionsResponse;
+  const std::pair<std::string, std::string> range("Range", "bytes=10-19");
+
+  {
+    SCOPED_TRACE("Partial content");
+    EXPECT_CALL(*network_mock_,
+                Send(testing::AllOf(IsGetRequest(kUrlPartitions),
+                                    HeadersContain(range)),
+                     _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            http::NetworkResponse().WithStatus(
+                http::HttpStatusCode::PARTIAL_CONTENT),
+            body.substr(10u, 10u),
+            {{"Content-Range",
+              "bytes 10-19/" + std::to_string(body.size())}}));
+
+    auto response = MetadataApi::GetPartitionsPage(
+        *client_, "testlayer", kEndVersion, {}, 10u, 10u, boost::none,
+        olp::client::CancellationContext{});
+
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(body.substr(10u, 10u), response.GetResult().data);
+    EXPECT_EQ(body.size(), response.GetResult().total_size);
+  }
+
+  {
+    SCOPED_TRACE("Range is ignored");
+    EXPECT_CALL(*network_mock_,
+                Send(testing::AllOf(IsGetRequest(kUrlPartitions),
+                                    HeadersContain(range)),
+                     _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            http::NetworkResponse().WithStatus(http::HttpStatusCode::OK),
+            body));
+
+    auto response = MetadataApi::GetPartitionsPage(
+        *client_, "testlayer", kEndVersion, {}, 10u, 10u, boost::none,
+        olp::client::CancellationContext{});
+
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(body.substr(10u), response.GetResult().data);
+    EXPECT_EQ(body.size(), response.GetResult().total_size);
+  }
+
+  {
+    SCOPED_TRACE("Range is past the end");
+    EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlPartitions), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            http::NetworkResponse().WithStatus(
+                http::HttpStatusCode::REQUESTED_RANGE_NOT_SATISFIABLE),
+            ""));
+
+    auto response = MetadataApi::GetPartitionsPage(
+        *client_, "testlayer", kEndVersion, {}, body.size(), 10u,
+        boost::none, olp::client::CancellationContext{});
+
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_TRUE(response.GetResult().data.empty());
+    EXPECT_EQ(body.size(), response.GetResult().total_size);
+  }
+
+  {
+    SCOPED_TRACE("Error");
+    EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlPartitions), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            http::NetworkResponse().WithStatus(http::HttpStatusCode::FORBIDDEN),
+            "Forbidden"));
+
+    auto response = MetadataApi::GetPartitionsPage(
+        *client_, "testlayer", kEndVersion, {}, 0u, 10u, boost::none,
+        olp::client::CancellationContext{});
+
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(http::HttpStatusCode::FORBIDDEN,
+              response.GetError().GetHttpStatusCode());
+  }
+}
+
 }  // namespace
@@ -18,6 +18,7 @@
  */
 
 #include <chrono>
+#include <sstream>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -462,6 +463,97 @@ TEST(ParserTest, Index) {
   }
 }
 
+TEST(ParserTest, PartitionsStream) {
+  {
+    SCOPED_TRACE("Parse valid partitions");
+    std::stringstream json_input(
+        "{\"partitions\":[{\"checksum\":\"291f66\",\"compressedDataSize\":512,"
+        "\"dataHandle\":\"handle-1\",\"dataSize\":1024,\"crc\":\"c1\","
+        "\"partition\":\"1\",\"version\":2,\"extra\":{\"partition\":\"x\"}},"
+        "{\"partition\":\"2\",\"dataHandle\":\"handle-2\"}],"
+        "\"next\":\"url\"}");
+
+    bool res = false;
+    auto partitions =
+        olp::parser::parse<olp::dataservice::read::model::Partitions>(
+            json_input, res);
+
+    ASSERT_TRUE(res);
+    ASSERT_EQ(2u, partitions.GetPartitions().size());
+    const auto& first = partitions.GetPartitions().at(0);
+    EXPECT_EQ("1", first.GetPartition());
+    EXPECT_EQ("handle-1", first.GetDataHandle());
+    EXPECT_EQ("291f66", first.GetChecksum().get_value_or(""));
+    EXPECT_EQ("c1", first.GetCrc().get_value_or(""));
+    EXPECT_EQ(512, first.GetCompressedDataSize().get_value_or(0));
+    EXPECT_EQ(1024, first.GetDataSize().get_value_or(0));
+    EXPECT_EQ(2, first.GetVersion().get_value_or(0));
+
+    const auto& second = partitions.GetPartitions().at(1);
+    EXPECT_EQ("2", second.GetPartition());
+    EXPECT_EQ("handle-2", second.GetDataHandle());
+    EXPECT_FALSE(second.GetChecksum());
+    EXPECT_FALSE(second.GetVersion());
+  }
+
+  {
+    SCOPED_TRACE("Parse invalid partitions");
+    std::stringstream json_input(
+        "{\"partitions\":[{\"partition\":\"1\",\"dataHandle\":\"h}]}");
+
+    bool res = true;
+    auto partitions =
+        olp::parser::parse<olp::dataservice::read::model::Partitions>(
+            json_input, res);
+
+    EXPECT_FALSE(res);
+    EXPECT_TRUE(partitions.GetPartitions().empty());
+  }
+
+  {
+    SCOPED_TRACE("Parse scalar response");
+    std::stringstream json_input("\"partitions\"");
+
+    bool res = true;
+    olp::parser::parse<olp::dataservice::read::model::Partitions>(json_input,
+                                                                  res);
+    EXPECT_FALSE(res);
+  }
+}
+
+TEST(ParserTest, MessagesStream) {
+  std::stringstream json_input(
+      "{\"messages\":[{\"metaData\":{\"partition\":\"314010583\","
+      "\"checksum\":\"ff74\",\"compressedDataSize\":152417,"
+      "\"dataSize\":250110,\"data\":\"abc\",\"dataHandle\":\"bb76\","
+      "\"timestamp\":1517916706},\"offset\":{\"partition\":7,"
+      "\"offset\":38562}},{\"some_invalid_json\":\"yes\"}]}");
+
+  bool res = false;
+  auto messages = olp::parser::parse<olp::dataservice::read::model::Messages>(
+                      json_input, res)
+                      .GetMessages();
+
+  ASSERT_TRUE(res);
+  ASSERT_EQ(2u, messages.size());
+
+  const auto& metadata = messages[0].GetMetaData();
+  EXPECT_EQ("314010583", metadata.GetPartition());
+  EXPECT_EQ("ff74", metadata.GetChecksum().get_value_or(""));
+  EXPECT_EQ(152417, metadata.GetCompressedDataSize().get_value_or(0));
+  EXPECT_EQ(250110, metadata.GetDataSize().get_value_or(0));
+  EXPECT_EQ("bb76", metadata.GetDataHandle().get_value_or(""));
+  EXPECT_EQ(1517916706, metadata.GetTimestamp().get_value_or(0));
+  ASSERT_TRUE(metadata.GetData() != nullptr);
+  EXPECT_EQ(std::vector<unsigned char>({'a', 'b', 'c'}), *metadata.GetData());
+  EXPECT_EQ(7, messages[0].GetOffset().GetPartition());
+  EXPECT_EQ(38562, messages[0].GetOffset().GetOffset());
+
+  EXPECT_TRUE(messages[1].GetMetaData().GetPartition().empty());
+  EXPECT_TRUE(messages[1].GetMetaData().GetData() == nullptr);
+  EXPECT_EQ(0, messages[1].GetOffset().GetOffset());
+}
+
 TEST(ParserTest, Messages) {
   {
     const std::string kData =
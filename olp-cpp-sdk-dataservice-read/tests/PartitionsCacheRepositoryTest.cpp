@@ -19,6 +19,8 @@
 
 #include "repositories/PartitionsCacheRepository.h"
 
+#include <limits>
+
 #include <gmock/gmock.h>
 #include <mocks/CacheMock.h>
 #include <olp/core/cache/CacheSettings.h>
@@ -224,4 +226,133 @@ TEST(PartitionsCacheRepositoryTest, GetPartitionHandle) {
   }
 }
 
+TEST(PartitionsCacheRepositoryTest, Pages) {
+  const auto hrn = HRN::FromString(kCatalog);
+  const auto layer = "layer";
+  const auto version = 3;
+
+  model::Partition some_partition;
+  some_partition.SetPartition(kPartitionId);
+  some_partition.SetDataHandle(kDataHandle);
+  model::Partitions partitions;
+  partitions.GetMutablePartitions().push_back(some_partition);
+
+  std::shared_ptr<KeyValueCache> cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  repository::PartitionsCacheRepository repository(hrn, layer, cache);
+
+  {
+    SCOPED_TRACE("Incomplete list");
+
+    repository.PutPage(partitions, 0u, version, boost::none);
+    EXPECT_FALSE(repository.GetPagesCount(version));
+  }
+
+  {
+    SCOPED_TRACE("Complete list");
+
+    repository.PutPagesCount(1u, version, boost::none);
+    const auto count = repository.GetPagesCount(version);
+    ASSERT_TRUE(count);
+    EXPECT_EQ(count.get(), 1u);
+
+    const auto page = repository.GetPage(0u, version);
+    ASSERT_TRUE(page);
+    ASSERT_EQ(page->GetPartitions().size(), 1u);
+    EXPECT_EQ(page->GetPartitions().front().GetDataHandle(), kDataHandle);
+    EXPECT_FALSE(repository.GetPage(1u, version));
+    EXPECT_TRUE(repository.ContainsPages(1u, version));
+    EXPECT_FALSE(repository.ContainsPages(2u, version));
+  }
+
+  {
+    SCOPED_TRACE("Other version");
+
+    EXPECT_FALSE(repository.GetPagesCount(version + 1));
+    EXPECT_FALSE(repository.GetPage(0u, version + 1));
+    EXPECT_FALSE(repository.ContainsPages(1u, version + 1));
+  }
+
+  {
+    SCOPED_TRACE("Page with an evicted partition");
+
+    ASSERT_TRUE(cache->Remove(std::string(kCatalog) + "::" + layer + "::" +
+                              kPartitionId + "::" + std::to_string(version) +
+                              "::partition"));
+    EXPECT_FALSE(repository.GetPage(0u, version));
+  }
+}
+
+TEST(PartitionsCacheRepositoryTest, VolatileChanges) {
+  const auto hrn = HRN::FromString(kCatalog);
+  const auto layer = "layer";
+
+  auto make_partition = [](const std::string& id, const std::string& handle) {
+    model::Partition partition;
+    partition.SetPartition(id);
+    partition.SetDataHandle(handle);
+    return partition;
+  };
+
+  model::Partitions partitions;
+  partitions.GetMutablePartitions() = {make_partition("1", "a"),
+                                       make_partition("2", "b")};
+
+  std::shared_ptr<KeyValueCache> cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  repository::PartitionsCacheRepository repository(hrn, layer, cache);
+
+  {
+    SCOPED_TRACE("Not cached");
+
+    EXPECT_FALSE(repository.GetVolatileSync());
+    EXPECT_FALSE(repository.ApplyVolatileChanges(partitions));
+  }
+
+  {
+    SCOPED_TRACE("Expired");
+
+    repository.Put(partitions, boost::none,
+                   std::numeric_limits<time_t>::max(), true);
+    repository.PutVolatileSync(5, -1);
+
+    const auto sync = repository.GetVolatileSync();
+    ASSERT_TRUE(sync);
+    EXPECT_EQ(5, sync->version);
+    EXPECT_TRUE(sync->expired);
+  }
+
+  {
+    SCOPED_TRACE("Changes applied");
+
+    model::Partitions changes;
+    changes.GetMutablePartitions() = {make_partition("1", ""),
+                                      make_partition("2", "c"),
+                                      make_partition("3", "d")};
+
+    const auto result = repository.ApplyVolatileChanges(changes);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(2u, result->GetPartitions().size());
+    EXPECT_EQ("c", result->GetPartitions()[0].GetDataHandle());
+    EXPECT_EQ("d", result->GetPartitions()[1].GetDataHandle());
+
+    const auto cached =
+        repository.Get(read::PartitionsRequest(), boost::none);
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(2u, cached->GetPartitions().size());
+    EXPECT_TRUE(repository.Get({"1"}, boost::none).GetPartitions().empty());
+  }
+
+  {
+    SCOPED_TRACE("Refreshed");
+
+    repository.PutVolatileSync(6, 60);
+
+    const auto sync = repository.GetVolatileSync();
+    ASSERT_TRUE(sync);
+    EXPECT_EQ(6, sync->version);
+    EXPECT_FALSE(sync->expired);
+  }
+}
+
 }  // namespace
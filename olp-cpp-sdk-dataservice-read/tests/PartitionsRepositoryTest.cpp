@@ -911,6 +911,67 @@ TEST_F(PartitionsRepositoryTest, CheckCashedPartitions) {
   }
 }
 
+TEST_F(PartitionsRepositoryTest, GetPartitionsByIdInBatches) {
+  std::shared_ptr<cache::KeyValueCache> default_cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  auto mock_network = std::make_shared<NetworkMock>();
+  OlpClientSettings settings;
+  settings.cache = default_cache;
+  settings.network_request_handler = mock_network;
+  settings.retry_settings.timeout = 1;
+
+  const auto hrn = HRN::FromString(kCatalog);
+
+  // 250 partitions are requested, the first 50 of them are cached.
+  read::PartitionsRequest::PartitionIds partition_ids;
+  model::Partitions cached_partitions;
+  for (auto i = 0; i < 250; ++i) {
+    partition_ids.push_back(std::to_string(i));
+    if (i < 50) {
+      model::Partition partition;
+      partition.SetPartition(partition_ids.back());
+      partition.SetDataHandle("handle-" + partition_ids.back());
+      cached_partitions.GetMutablePartitions().push_back(partition);
+    }
+  }
+  repository::PartitionsCacheRepository cache_repository(
+      hrn, kVersionedLayerId, default_cache);
+  cache_repository.Put(cached_partitions, kVersion, boost::none);
+
+  EXPECT_CALL(*mock_network, Send(IsGetRequest(kUrlLookupQuery), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kHttpResponceLookupQuery));
+
+  // The 200 missing partitions are queried with two requests.
+  EXPECT_CALL(*mock_network,
+              Send(IsGetRequestPrefix(kUrlQueryApi + "/layers/" +
+                                      kVersionedLayerId + "/partitions"),
+                   _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kOlpSdkHttpResponseEmptyPartitionList));
+
+  olp::client::ApiLookupClient lookup_client(hrn, settings);
+  repository::PartitionsRepository repository(hrn, kVersionedLayerId, settings,
+                                              lookup_client);
+
+  olp::client::CancellationContext context;
+  auto request = read::PartitionsRequest().WithPartitionIds(partition_ids);
+  auto response =
+      repository.GetVersionedPartitions(request, kVersion, context);
+
+  ASSERT_TRUE(response.IsSuccessful());
+  const auto& partitions = response.GetResult().GetPartitions();
+  ASSERT_EQ(partitions.size(), 50u);
+  for (size_t i = 0; i < partitions.size(); ++i) {
+    EXPECT_EQ(partitions[i].GetPartition(), partition_ids[i]);
+  }
+  testing::Mock::VerifyAndClearExpectations(mock_network.get());
+}
+
 TEST_F(PartitionsRepositoryTest, GetAggregatedPartitionForVersionedTile) {
   using olp::cache::KeyValueCache;
   using testing::_;
@@ -1269,4 +1330,175 @@ TEST_F(PartitionsRepositoryTest, GetTile) {
   }
 }
 
+TEST_F(PartitionsRepositoryTest, StreamVersionedPartitions) {
+  using testing::Invoke;
+  using testing::Return;
+
+  const std::string list =
+      R"jsonString({"partitions":[{"version":4,"partition":"1","dataHandle":"a"},{"version":4,"partition":"2","dataHandle":"b"},{"version":4,"partition":"3","dataHandle":"c"}]})jsonString";
+
+  // Serves the requested byte range of the list.
+  auto serve_range = [&](olp::http::NetworkRequest request,
+                         olp::http::Network::Payload payload,
+                         olp::http::Network::Callback callback,
+                         olp::http::Network::HeaderCallback header_callback,
+                         olp::http::Network::DataCallback data_callback) {
+    uint64_t first = 0u;
+    uint64_t last = 0u;
+    for (const auto& header : request.GetHeaders()) {
+      if (header.first == "Range") {
+        char* end = nullptr;
+        first = std::strtoull(header.second.c_str() + 6, &end, 10);
+        last = std::strtoull(end + 1, nullptr, 10);
+      }
+    }
+
+    if (first >= list.size()) {
+      return ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::REQUESTED_RANGE_NOT_SATISFIABLE),
+          "")(request, payload, callback, header_callback, data_callback);
+    }
+
+    last = std::min<uint64_t>(last, list.size() - 1u);
+    return ReturnHttpResponse(
+        olp::http::NetworkResponse().WithStatus(
+            olp::http::HttpStatusCode::PARTIAL_CONTENT),
+        list.substr(first, last - first + 1u),
+        {{"Content-Range", "bytes " + std::to_string(first) + "-" +
+                               std::to_string(last) + "/" +
+                               std::to_string(list.size())}})(
+        request, payload, callback, header_callback, data_callback);
+  };
+
+  auto mock_network = std::make_shared<NetworkMock>();
+  std::shared_ptr<cache::KeyValueCache> cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  const auto catalog = HRN::FromString(kCatalog);
+
+  OlpClientSettings settings;
+  settings.cache = cache;
+  settings.network_request_handler = mock_network;
+  settings.retry_settings.timeout = 1;
+  // Every range holds about one partition.
+  settings.download_chunk_size = 50u;
+
+  ON_CALL(*mock_network,
+          Send(IsGetRequest(kOlpSdkUrlLookupMetadata2), _, _, _, _))
+      .WillByDefault(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kOlpSdkHttpResponseLookupMetadata2));
+  ON_CALL(*mock_network,
+          Send(IsGetRequest(kOlpSdkUrlVersionedPartitions), _, _, _, _))
+      .WillByDefault(Invoke(serve_range));
+
+  client::CancellationContext context;
+  ApiLookupClient lookup_client(catalog, settings);
+  repository::PartitionsRepository repository(catalog, kVersionedLayerId,
+                                              settings, lookup_client);
+
+  std::vector<std::string> ids;
+  size_t chunks = 0u;
+  auto stream = [&](read::FetchOptions fetch_option) {
+    ids.clear();
+    chunks = 0u;
+    return repository.StreamVersionedPartitions(
+        read::PartitionsRequest().WithFetchOption(fetch_option), kVersion,
+        [&](model::Partitions partitions) {
+          ++chunks;
+          for (const auto& partition : partitions.GetPartitions()) {
+            ids.push_back(partition.GetPartition());
+          }
+        },
+        context);
+  };
+  const std::vector<std::string> expected_ids = {"1", "2", "3"};
+
+  {
+    SCOPED_TRACE("Download in ranges");
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlLookupMetadata2), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlVersionedPartitions), _, _, _, _))
+        .Times(testing::AtLeast(3));
+
+    auto response = stream(read::OnlineIfNotFound);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(expected_ids, ids);
+    EXPECT_GT(chunks, 1u);
+    testing::Mock::VerifyAndClearExpectations(mock_network.get());
+  }
+
+  {
+    SCOPED_TRACE("Stream from cache");
+
+    EXPECT_CALL(*mock_network, Send(_, _, _, _, _)).Times(0);
+
+    auto response = stream(read::CacheOnly);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(expected_ids, ids);
+    testing::Mock::VerifyAndClearExpectations(mock_network.get());
+  }
+
+  const auto partition_key = kCatalog + "::" + kVersionedLayerId +
+                             "::3::" + std::to_string(kVersion) +
+                             "::partition";
+
+  {
+    SCOPED_TRACE("Evicted partition is not found in cache");
+
+    ASSERT_TRUE(cache->Remove(partition_key));
+    EXPECT_CALL(*mock_network, Send(_, _, _, _, _)).Times(0);
+
+    auto response = stream(read::CacheOnly);
+
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(ErrorCode::NotFound, response.GetError().GetErrorCode());
+    testing::Mock::VerifyAndClearExpectations(mock_network.get());
+  }
+
+  {
+    SCOPED_TRACE("Evicted partition is downloaded again");
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlLookupMetadata2), _, _, _, _))
+        .Times(testing::AtMost(1));
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlVersionedPartitions), _, _, _, _))
+        .Times(testing::AtLeast(1));
+
+    auto response = stream(read::OnlineIfNotFound);
+
+    // The partitions streamed from the cache are not repeated.
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(expected_ids, ids);
+    EXPECT_TRUE(cache->Contains(partition_key));
+    testing::Mock::VerifyAndClearExpectations(mock_network.get());
+  }
+
+  {
+    SCOPED_TRACE("Evicted page is downloaded again");
+
+    ASSERT_TRUE(cache->Remove(kCatalog + "::" + kVersionedLayerId + "::" +
+                              std::to_string(kVersion) +
+                              "::partitions::page::0"));
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlLookupMetadata2), _, _, _, _))
+        .Times(testing::AtMost(1));
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlVersionedPartitions), _, _, _, _))
+        .Times(testing::AtLeast(1));
+
+    auto response = stream(read::OnlineIfNotFound);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(expected_ids, ids);
+  }
+}
+
 }  // namespace
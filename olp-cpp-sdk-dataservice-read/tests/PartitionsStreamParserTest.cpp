@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "repositories/PartitionsStreamParser.h"
+
+namespace {
+using olp::dataservice::read::repository::PartitionsStreamParser;
+
+constexpr auto kPartitions =
+    R"jsonString({"next":"/uri/{x}","partitions":[{"version":4,"partition":"269","dataHandle":"4eed6ed1-0d32-43b9-ae79-043cb4256432"},{"partition":"270","dataHandle":"a7a1afdf","extra":{"nested":["}"]},"checksum":"\"}"}],"other":[1,2]})jsonString";
+
+TEST(PartitionsStreamParserTest, SplitsPartitions) {
+  const std::string response = kPartitions;
+
+  std::vector<std::string> objects;
+  PartitionsStreamParser parser(
+      [&](const std::string& json) { objects.push_back(json); });
+
+  ASSERT_TRUE(parser.Feed(response.data(), response.size()));
+  EXPECT_TRUE(parser.IsComplete());
+  ASSERT_EQ(objects.size(), 2u);
+  EXPECT_EQ(objects[0],
+            R"jsonString({"version":4,"partition":"269","dataHandle":"4eed6ed1-0d32-43b9-ae79-043cb4256432"})jsonString");
+  EXPECT_EQ(objects[1],
+            R"jsonString({"partition":"270","dataHandle":"a7a1afdf","extra":{"nested":["}"]},"checksum":"\"}"})jsonString");
+}
+
+TEST(PartitionsStreamParserTest, FeedByteByByte) {
+  const std::string response = kPartitions;
+
+  std::vector<std::string> whole;
+  PartitionsStreamParser whole_parser(
+      [&](const std::string& json) { whole.push_back(json); });
+  ASSERT_TRUE(whole_parser.Feed(response.data(), response.size()));
+
+  for (size_t split = 1; split < response.size(); ++split) {
+    std::vector<std::string> parts;
+    PartitionsStreamParser parser(
+        [&](const std::string& json) { parts.push_back(json); });
+
+    ASSERT_TRUE(parser.Feed(response.data(), split));
+    EXPECT_FALSE(parser.IsComplete());
+    ASSERT_TRUE(
+        parser.Feed(response.data() + split, response.size() - split));
+    EXPECT_TRUE(parser.IsComplete());
+    EXPECT_EQ(parts, whole) << "split=" << split;
+  }
+}
+
+TEST(PartitionsStreamParserTest, EmptyList) {
+  const std::string response = R"jsonString({ "partitions" : [ ] })jsonString";
+
+  size_t count = 0u;
+  PartitionsStreamParser parser([&](const std::string&) { ++count; });
+
+  ASSERT_TRUE(parser.Feed(response.data(), response.size()));
+  EXPECT_TRUE(parser.IsComplete());
+  EXPECT_EQ(count, 0u);
+}
+
+TEST(PartitionsStreamParserTest, InvalidResponse) {
+  {
+    SCOPED_TRACE("Not an object in the partitions array");
+    const std::string response = R"jsonString({"partitions":[1]})jsonString";
+    PartitionsStreamParser parser([](const std::string&) {});
+    EXPECT_FALSE(parser.Feed(response.data(), response.size()));
+    EXPECT_FALSE(parser.IsComplete());
+  }
+  {
+    SCOPED_TRACE("Unbalanced brackets");
+    const std::string response = R"jsonString({"partitions":[]}})jsonString";
+    PartitionsStreamParser parser([](const std::string&) {});
+    EXPECT_FALSE(parser.Feed(response.data(), response.size()));
+    EXPECT_FALSE(parser.IsComplete());
+  }
+  {
+    SCOPED_TRACE("Truncated response");
+    const std::string response = R"jsonString({"partitions":[{})jsonString";
+    PartitionsStreamParser parser([](const std::string&) {});
+    EXPECT_TRUE(parser.Feed(response.data(), response.size()));
+    EXPECT_FALSE(parser.IsComplete());
+  }
+}
+
+}  // namespace
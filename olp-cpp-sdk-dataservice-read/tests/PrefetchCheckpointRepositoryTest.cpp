@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "repositories/PrefetchCheckpointRepository.h"
+
+#include <gmock/gmock.h>
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+
+namespace {
+namespace repository = olp::dataservice::read::repository;
+namespace client = olp::client;
+namespace cache = olp::cache;
+
+using olp::geo::TileKey;
+
+constexpr auto kCatalog = "hrn:here:data::olp-here-test:catalog";
+constexpr auto kLayer = "layer";
+constexpr auto kResumeId = "region";
+
+TEST(PrefetchCheckpointRepositoryTest, ResumesCompletedRoots) {
+  const auto hrn = client::HRN::FromString(kCatalog);
+  const auto first_root = TileKey::FromRowColumnLevel(1, 2, 5);
+  const auto second_root = TileKey::FromRowColumnLevel(3, 4, 10);
+
+  std::shared_ptr<cache::KeyValueCache> cache =
+      client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  {
+    SCOPED_TRACE("Saves the completed roots");
+
+    repository::PrefetchCheckpointRepository checkpoint(hrn, kLayer, kResumeId,
+                                                        3, cache);
+    EXPECT_TRUE(checkpoint.Load().empty());
+
+    checkpoint.Complete(first_root);
+    checkpoint.Complete(second_root);
+  }
+
+  {
+    SCOPED_TRACE("Loads the completed roots");
+
+    repository::PrefetchCheckpointRepository checkpoint(hrn, kLayer, kResumeId,
+                                                        3, cache);
+    const std::set<TileKey> expected = {first_root, second_root};
+    EXPECT_EQ(checkpoint.Load(), expected);
+  }
+
+  {
+    SCOPED_TRACE("Other versions and IDs are not affected");
+
+    repository::PrefetchCheckpointRepository other_version(
+        hrn, kLayer, kResumeId, 4, cache);
+    EXPECT_TRUE(other_version.Load().empty());
+
+    repository::PrefetchCheckpointRepository other_id(hrn, kLayer, "other",
+                                                      3, cache);
+    EXPECT_TRUE(other_id.Load().empty());
+  }
+
+  {
+    SCOPED_TRACE("Clear removes the roots and ignores the later ones");
+
+    repository::PrefetchCheckpointRepository checkpoint(hrn, kLayer, kResumeId,
+                                                        3, cache);
+    checkpoint.Clear();
+    checkpoint.Complete(first_root);
+
+    EXPECT_TRUE(checkpoint.Load().empty());
+  }
+
+  {
+    SCOPED_TRACE("Removed when the roots left complete");
+
+    repository::PrefetchCheckpointRepository checkpoint(hrn, kLayer, kResumeId,
+                                                        3, cache);
+    checkpoint.Load();
+    checkpoint.SetRootsLeft(2);
+    checkpoint.Complete(first_root);
+    checkpoint.Complete(second_root);
+
+    EXPECT_TRUE(checkpoint.Load().empty());
+  }
+}
+
+}  // namespace
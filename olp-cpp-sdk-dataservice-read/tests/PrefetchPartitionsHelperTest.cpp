@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "PrefetchPartitionsHelper.h"
+#include "TaskSink.h"
+
+namespace {
+namespace client = olp::client;
+namespace read = olp::dataservice::read;
+
+using Helper = read::PrefetchPartitionsHelper;
+
+read::AppendResultFunc<std::string, read::PrefetchPartitionsResult>
+AppendResult() {
+  return [](read::ExtendedDataResponse response, std::string partition,
+            read::PrefetchPartitionsResult& result) {
+    if (response.IsSuccessful()) {
+      result.AddPartition(std::move(partition));
+    }
+  };
+}
+
+std::vector<std::string> MakePartitions(size_t count) {
+  std::vector<std::string> partitions;
+  for (size_t index = 0; index < count; ++index) {
+    partitions.push_back(std::to_string(index));
+  }
+  return partitions;
+}
+
+TEST(PrefetchPartitionsHelperTest, DownloadsEachChunkWhenQueried) {
+  std::vector<std::string> events;
+  std::vector<read::PrefetchPartitionsStatus> statuses;
+  read::PrefetchPartitionsResponse response;
+
+  auto download_job = std::make_shared<Helper::DownloadJob>(
+      [&](std::string data_handle, client::CancellationContext) {
+        events.push_back("download " + data_handle);
+        return read::ExtendedDataResponse(nullptr);
+      },
+      AppendResult(),
+      [&](read::PrefetchPartitionsResponse result) {
+        response = std::move(result);
+      },
+      [&](read::PrefetchPartitionsStatus status) {
+        statuses.push_back(status);
+      });
+
+  // The partition 4 is not found.
+  auto query = [&](std::vector<std::string> partitions,
+                   client::CancellationContext) {
+    events.push_back("query " + partitions.front());
+    read::PartitionDataHandleResult result;
+    for (const auto& partition : partitions) {
+      if (partition != "4") {
+        result.emplace_back(partition, "handle" + partition);
+      }
+    }
+    return read::PartitionsDataHandleExtendedResponse(result);
+  };
+
+  Helper::Settings settings;
+  settings.query_chunk_size = 2;
+  settings.max_parallel_queries = 1;
+
+  // Without a task scheduler, the tasks run in the scheduling order.
+  read::TaskSink task_sink(nullptr);
+  Helper::Prefetch(download_job, MakePartitions(5), query, settings,
+                   task_sink, olp::thread::NORMAL,
+                   client::CancellationContext());
+
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().GetPartitions().size(), 4u);
+
+  const std::vector<std::string> expected = {
+      "query 0", "download handle0", "download handle1", "query 2",
+      "download handle2", "download handle3", "query 4"};
+  EXPECT_EQ(events, expected);
+
+  // The status counts the requested partitions before they are queried.
+  ASSERT_EQ(statuses.size(), 4u);
+  EXPECT_EQ(statuses.front().prefetched_partitions, 1u);
+  EXPECT_EQ(statuses.front().total_partitions_to_prefetch, 5u);
+  EXPECT_EQ(statuses.back().prefetched_partitions, 4u);
+}
+
+TEST(PrefetchPartitionsHelperTest, FailsOnlyWhenAllQueriesFail) {
+  auto prefetch = [](bool fail_all) {
+    read::PrefetchPartitionsResponse response;
+    auto download_job = std::make_shared<Helper::DownloadJob>(
+        [](std::string, client::CancellationContext) {
+          return read::ExtendedDataResponse(nullptr);
+        },
+        AppendResult(),
+        [&](read::PrefetchPartitionsResponse result) {
+          response = std::move(result);
+        },
+        nullptr);
+
+    auto query = [=](std::vector<std::string> partitions,
+                     client::CancellationContext) {
+      if (fail_all || partitions.front() == "0") {
+        return read::PartitionsDataHandleExtendedResponse(
+            client::ApiError(client::ErrorCode::ServiceUnavailable, "Error"));
+      }
+      return read::PartitionsDataHandleExtendedResponse(
+          read::PartitionDataHandleResult{{partitions.front(), "handle"}});
+    };
+
+    Helper::Settings settings;
+    settings.query_chunk_size = 1;
+
+    read::TaskSink task_sink(nullptr);
+    Helper::Prefetch(download_job, MakePartitions(2), query, settings,
+                     task_sink, olp::thread::NORMAL,
+                     client::CancellationContext());
+    return response;
+  };
+
+  {
+    SCOPED_TRACE("One query fails");
+    const auto response = prefetch(false);
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().GetPartitions(),
+              std::vector<std::string>{"1"});
+  }
+
+  {
+    SCOPED_TRACE("All queries fail");
+    const auto response = prefetch(true);
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              client::ErrorCode::ServiceUnavailable);
+  }
+}
+
+TEST(PrefetchPartitionsHelperTest, CancelledContext) {
+  read::PrefetchPartitionsResponse response;
+  auto download_job = std::make_shared<Helper::DownloadJob>(
+      [](std::string, client::CancellationContext) {
+        return read::ExtendedDataResponse(nullptr);
+      },
+      AppendResult(),
+      [&](read::PrefetchPartitionsResponse result) {
+        response = std::move(result);
+      },
+      nullptr);
+
+  bool queried = false;
+  auto query = [&](std::vector<std::string>, client::CancellationContext) {
+    queried = true;
+    return read::PartitionsDataHandleExtendedResponse(
+        read::PartitionDataHandleResult{});
+  };
+
+  client::CancellationContext context;
+  context.CancelOperation();
+
+  read::TaskSink task_sink(nullptr);
+  Helper::Prefetch(download_job, MakePartitions(3), query, Helper::Settings(),
+                   task_sink, olp::thread::NORMAL, context);
+
+  EXPECT_FALSE(queried);
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetErrorCode(), client::ErrorCode::Cancelled);
+}
+}  // namespace
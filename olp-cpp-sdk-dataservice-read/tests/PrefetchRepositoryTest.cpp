@@ -17,9 +17,18 @@
  * License-Filename: LICENSE
  */
 
-#include <gtest/gtest.h>
-
+#include <sstream>
+
+#include <gmock/gmock.h>
+#include <matchers/NetworkUrlMatchers.h>
+#include <mocks/NetworkMock.h>
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/utils/Url.h>
+#include <repositories/DataCacheRepository.h>
+#include <repositories/PartitionsCacheRepository.h>
 #include <repositories/PrefetchTilesRepository.h>
+#include <repositories/QuadTreeIndex.h>
 
 namespace {
 namespace repository = olp::dataservice::read::repository;
@@ -28,6 +37,23 @@ using repository::PrefetchTilesRepository;
 const auto kCatalog =
     olp::client::HRN("hrn:here:data::olp-here-test:hereos-internal-test-v2");
 
+const std::string kUrlLookup =
+    R"(https://api-lookup.data.api.platform.here.com/lookup/v1/resources/hrn:here:data::olp-here-test:hereos-internal-test-v2/apis)";
+
+const std::string kHttpResponseLookup =
+    R"jsonString([{"api":"metadata","version":"v1","baseURL":"https://metadata.data.api.platform.here.com/metadata/v1/catalogs/hereos-internal-test-v2","parameters":{}},{"api":"query","version":"v1","baseURL":"https://query.data.api.platform.here.com/query/v1/catalogs/hereos-internal-test-v2","parameters":{}}])jsonString";
+
+const std::string kUrlChanges =
+    R"(https://metadata.data.api.platform.here.com/metadata/v1/catalogs/hereos-internal-test-v2/layers/test_layer/changes?additionalFields=)" +
+    olp::utils::Url::Encode("checksum,compressedDataSize,dataSize") +
+    "&endVersion=5&startVersion=4";
+
+const std::string kHttpResponseChanges =
+    R"jsonString({"partitions":[{"version":5,"partition":"1524","dataHandle":"changed-1524","dataSize":10},{"version":5,"partition":"1525","dataHandle":""},{"version":5,"partition":"23","dataHandle":"changed-23"},{"version":5,"partition":"7","dataHandle":"other-7"},{"version":5,"partition":"1528","dataHandle":"other-1528"}]})jsonString";
+
+const std::string kQuadTreeResponse =
+    R"jsonString({"subQuads": [{"subQuadKey": "4","version":4,"dataHandle":"1524"},{"subQuadKey":"5","version":4,"dataHandle":"1525"},{"subQuadKey": "6","version":4,"dataHandle":"1526"},{"subQuadKey":"1","version":4,"dataHandle":"381"}],"parentQuads":[{"partition":"23","version":4,"dataHandle":"23"},{"partition":"95","version":4,"dataHandle":"95"}]})jsonString";
+
 class PrefetchRepositoryTestable
     : protected repository::PrefetchTilesRepository {
  public:
@@ -291,4 +317,122 @@ TEST(PrefetchRepositoryTest, GetSlicedTilesLowLevels) {
   }
 }
 
+TEST(PrefetchRepositoryTest, GetSlicedTilesForArea) {
+  using olp::geo::GeoCoordinates;
+  const auto request =
+      olp::dataservice::read::PrefetchTilesRequest().WithGeoRectangle(
+          olp::geo::GeoRectangle(GeoCoordinates::FromDegrees(52.5, 13.3),
+                                 GeoCoordinates::FromDegrees(52.52, 13.32)));
+  {
+    SCOPED_TRACE("Single quad tree for the area");
+
+    PrefetchRepositoryTestable repository;
+    auto root_tiles_depth = repository.GetSlicedTiles(request, 10, 14);
+    ASSERT_EQ(root_tiles_depth.size(), 1);
+    EXPECT_EQ(root_tiles_depth.begin()->first.Level(), 10);
+    EXPECT_EQ(root_tiles_depth.begin()->second, 4);
+  }
+  {
+    SCOPED_TRACE("Only the quad trees intersecting the area");
+
+    PrefetchRepositoryTestable repository;
+    auto root_tiles_depth = repository.GetSlicedTiles(request, 10, 19);
+    // A full slicing of the level 10 tile would need 1 + 4^5 quad trees.
+    EXPECT_EQ(root_tiles_depth.size(), 10);
+    for (const auto& root : root_tiles_depth) {
+      EXPECT_TRUE(root.first.Level() == 10 || root.first.Level() == 15);
+      EXPECT_EQ(root.second, 4);
+    }
+  }
+}
+
+TEST(PrefetchRepositoryTest, UpdateQuadTreeFromChanges) {
+  using testing::_;
+
+  auto network = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings.network_request_handler = network;
+  settings.retry_settings.timeout = 1;
+
+  const auto root = olp::geo::TileKey::FromHereTile("381");
+  {
+    std::stringstream stream(kQuadTreeResponse);
+    olp::dataservice::read::QuadTreeIndex tree(root, 1, stream);
+    repository::PartitionsCacheRepository cache_repository(
+        kCatalog, "test_layer", settings.cache);
+    cache_repository.Put(root, 1, tree, 4);
+  }
+
+  EXPECT_CALL(*network, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kHttpResponseLookup));
+  EXPECT_CALL(*network, Send(IsGetRequest(kUrlChanges), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kHttpResponseChanges));
+
+  PrefetchTilesRepository repository(
+      kCatalog, "test_layer", settings,
+      olp::client::ApiLookupClient(kCatalog, settings));
+
+  auto response = repository.GetVersionedSubQuads(root, 1, 5, {});
+  ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+
+  const repository::SubQuadsResult expected = {
+      {olp::geo::TileKey::FromHereTile("1524"), "changed-1524"},
+      {olp::geo::TileKey::FromHereTile("1526"), "1526"},
+      {root, "381"},
+      {olp::geo::TileKey::FromHereTile("23"), "changed-23"},
+      {olp::geo::TileKey::FromHereTile("95"), "95"}};
+  EXPECT_EQ(response.GetResult(), expected);
+
+  testing::Mock::VerifyAndClearExpectations(network.get());
+
+  // The updated tree is cached for the new version.
+  auto cached = repository.GetVersionedSubQuads(root, 1, 5, {});
+  ASSERT_TRUE(cached.IsSuccessful());
+  EXPECT_EQ(cached.GetResult(), expected);
+}
+
+TEST(PrefetchRepositoryTest, FilterChecksCachedData) {
+  olp::client::OlpClientSettings settings;
+  settings.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  repository::DataCacheRepository data_cache_repository(kCatalog,
+                                                        settings.cache);
+  data_cache_repository.Put(
+      std::make_shared<std::vector<unsigned char>>(1, 'a'), "test_layer",
+      "cached");
+
+  PrefetchTilesRepository repository(
+      kCatalog, "test_layer", settings,
+      olp::client::ApiLookupClient(kCatalog, settings));
+
+  const auto request = olp::dataservice::read::PrefetchTilesRequest()
+                           .WithTileKeys({olp::geo::TileKey::FromHereTile("5")})
+                           .WithMinLevel(1)
+                           .WithMaxLevel(2);
+  const repository::SubQuadsResult tiles = {
+      {olp::geo::TileKey::FromHereTile("5"), "cached"},
+      {olp::geo::TileKey::FromHereTile("20"), "not_cached"},
+      {olp::geo::TileKey::FromHereTile("21"), ""}};
+
+  EXPECT_FALSE(repository.IsDataCached("cached"));
+
+  const auto filtered = repository.FilterTilesByLevel(request, tiles);
+  EXPECT_EQ(filtered, tiles);
+
+  EXPECT_TRUE(repository.IsDataCached("cached"));
+  EXPECT_FALSE(repository.IsDataCached("not_cached"));
+  EXPECT_FALSE(repository.IsDataCached(""));
+
+  // The copies of the repository share the checked data.
+  auto repository_copy = repository;
+  EXPECT_TRUE(repository_copy.IsDataCached("cached"));
+}
+
 }  // namespace
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+#include <olp/core/geo/tiling/TileKeyUtils.h>
+#include <olp/core/geo/tiling/TilingSchemeRegistry.h>
+#include "PrefetchTilesArea.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+
+using olp::geo::GeoCoordinates;
+using olp::geo::GeoRectangle;
+using olp::geo::TileKey;
+
+TileKey TileAt(double latitude, double longitude, uint32_t level) {
+  return olp::geo::TileKeyUtils::GeoCoordinatesToTileKey(
+      olp::geo::HalfQuadTreeIdentityTilingScheme(),
+      GeoCoordinates::FromDegrees(latitude, longitude), level);
+}
+
+TEST(PrefetchTilesAreaTest, NoArea) {
+  const read::PrefetchTilesArea area(read::PrefetchTilesRequest().WithTileKeys(
+      {TileKey::FromRowColumnLevel(0, 0, 1)}));
+  EXPECT_TRUE(area.IsEmpty());
+  EXPECT_FALSE(area.Intersects(TileKey::FromRowColumnLevel(0, 0, 1)));
+
+  // A polygon needs three vertices at least.
+  const read::PrefetchTilesArea line(read::PrefetchTilesRequest().WithPolygon(
+      {GeoCoordinates::FromDegrees(0.0, 0.0),
+       GeoCoordinates::FromDegrees(1.0, 1.0)}));
+  EXPECT_TRUE(line.IsEmpty());
+}
+
+TEST(PrefetchTilesAreaTest, GeoRectangle) {
+  const read::PrefetchTilesArea area(
+      read::PrefetchTilesRequest().WithGeoRectangle(
+          GeoRectangle(GeoCoordinates::FromDegrees(52.0, 13.0),
+                       GeoCoordinates::FromDegrees(53.0, 14.0))));
+  ASSERT_FALSE(area.IsEmpty());
+
+  EXPECT_TRUE(area.Intersects(TileKey::FromRowColumnLevel(0, 0, 0)));
+  EXPECT_TRUE(area.Intersects(TileAt(52.5, 13.5, 12)));
+  EXPECT_TRUE(area.Intersects(TileAt(52.01, 13.01, 14)));
+  EXPECT_FALSE(area.Intersects(TileAt(51.9, 13.5, 12)));
+  EXPECT_FALSE(area.Intersects(TileAt(52.5, 14.1, 12)));
+}
+
+TEST(PrefetchTilesAreaTest, GeoRectangleCrossingAntimeridian) {
+  const read::PrefetchTilesArea area(
+      read::PrefetchTilesRequest().WithGeoRectangle(
+          GeoRectangle(GeoCoordinates::FromDegrees(-20.0, 170.0),
+                       GeoCoordinates::FromDegrees(-10.0, -170.0))));
+
+  EXPECT_TRUE(area.Intersects(TileAt(-15.0, 175.0, 10)));
+  EXPECT_TRUE(area.Intersects(TileAt(-15.0, -175.0, 10)));
+  EXPECT_FALSE(area.Intersects(TileAt(-15.0, 0.0, 10)));
+}
+
+TEST(PrefetchTilesAreaTest, Polygon) {
+  // A triangle with the vertices in the west, the east, and the north.
+  const read::PrefetchTilesArea area(read::PrefetchTilesRequest().WithPolygon(
+      {GeoCoordinates::FromDegrees(0.0, 0.0),
+       GeoCoordinates::FromDegrees(0.0, 10.0),
+       GeoCoordinates::FromDegrees(10.0, 5.0)}));
+  ASSERT_FALSE(area.IsEmpty());
+
+  // Inside of the triangle, on its edge, and outside of it.
+  EXPECT_TRUE(area.Intersects(TileAt(3.0, 5.0, 12)));
+  EXPECT_TRUE(area.Intersects(TileAt(5.0, 2.5, 12)));
+  EXPECT_FALSE(area.Intersects(TileAt(8.0, 1.0, 12)));
+  EXPECT_FALSE(area.Intersects(TileAt(-1.0, 5.0, 12)));
+
+  // The triangle inside of the tile.
+  EXPECT_TRUE(area.Intersects(TileAt(5.0, 5.0, 3)));
+}
+
+TEST(PrefetchTilesAreaTest, Corridor) {
+  // About 1.1 km around a path along the equator and then to the north.
+  const read::PrefetchTilesArea area(read::PrefetchTilesRequest().WithCorridor(
+      {GeoCoordinates::FromDegrees(0.0, 0.0),
+       GeoCoordinates::FromDegrees(0.0, 1.0),
+       GeoCoordinates::FromDegrees(1.0, 1.0)},
+      1100.0));
+  ASSERT_FALSE(area.IsEmpty());
+
+  EXPECT_TRUE(area.Intersects(TileAt(0.0, 0.5, 14)));
+  EXPECT_TRUE(area.Intersects(TileAt(0.005, 0.5, 14)));
+  EXPECT_TRUE(area.Intersects(TileAt(0.5, 1.005, 14)));
+  EXPECT_FALSE(area.Intersects(TileAt(0.05, 0.5, 14)));
+  EXPECT_FALSE(area.Intersects(TileAt(0.5, 0.5, 14)));
+  EXPECT_FALSE(area.Intersects(TileAt(1.05, 1.0, 14)));
+}
+
+}  // namespace
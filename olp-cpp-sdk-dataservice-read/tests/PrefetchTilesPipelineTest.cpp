@@ -0,0 +1,332 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+#include <olp/dataservice/read/PrefetchTileResult.h>
+#include "PrefetchTilesPipeline.h"
+
+namespace {
+namespace client = olp::client;
+namespace read = olp::dataservice::read;
+namespace repository = olp::dataservice::read::repository;
+
+using olp::geo::GeoCoordinates;
+using olp::geo::TileKey;
+using Pipeline = read::PrefetchTilesPipeline;
+
+const TileKey kRoot = TileKey::FromRowColumnLevel(0, 0, 0);
+
+read::AppendResultFunc<TileKey, read::PrefetchTilesResult> AppendResult() {
+  return [](read::ExtendedDataResponse response, TileKey tile,
+            read::PrefetchTilesResult& result) {
+    if (response.IsSuccessful()) {
+      result.push_back(std::make_shared<read::PrefetchTileResult>(
+          tile, read::PrefetchTileNoError()));
+    } else {
+      result.push_back(std::make_shared<read::PrefetchTileResult>(
+          tile, response.GetError()));
+    }
+  };
+}
+
+Pipeline::QueryFunc QueryResult(repository::SubQuadsResult tiles) {
+  return [=](TileKey, client::CancellationContext) {
+    return repository::SubQuadsResponse(tiles);
+  };
+}
+
+TEST(PrefetchTilesPipelineTest, DownloadsClosestTilesFirst) {
+  // The level 2 tiles are 90 degrees wide, and the row 0 is the southern one.
+  repository::SubQuadsResult tiles = {
+      {TileKey::FromRowColumnLevel(0, 3, 2), "south-east"},
+      {TileKey::FromRowColumnLevel(1, 0, 2), "north-west"},
+      {TileKey::FromRowColumnLevel(1, 2, 2), "north"},
+      {TileKey::FromRowColumnLevel(1, 3, 2), "north-east"}};
+
+  std::vector<std::string> downloads;
+  read::PrefetchTilesResponse response;
+
+  auto download_job = std::make_shared<Pipeline::DownloadJob>(
+      [&](std::string data_handle, client::CancellationContext) {
+        downloads.push_back(data_handle);
+        return read::ExtendedDataResponse(nullptr);
+      },
+      AppendResult(),
+      [&](read::PrefetchTilesResponse result) { response = std::move(result); },
+      nullptr);
+
+  Pipeline::Settings settings;
+  settings.focus_point = GeoCoordinates::FromDegrees(45.0, 150.0);
+
+  // Without a task scheduler, the tasks run in the scheduling order.
+  read::TaskSink task_sink(nullptr);
+  auto pipeline = std::make_shared<Pipeline>(download_job, QueryResult(tiles),
+                                             nullptr, settings, task_sink,
+                                             olp::thread::NORMAL);
+  pipeline->Start({kRoot}, client::CancellationContext());
+
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().size(), tiles.size());
+
+  // The north-west tile is closer than the north one across the antimeridian.
+  const std::vector<std::string> expected = {"north-east", "north-west",
+                                             "north", "south-east"};
+  EXPECT_EQ(downloads, expected);
+}
+
+TEST(PrefetchTilesPipelineTest, LimitsDownloadsInFlight) {
+  repository::SubQuadsResult tiles;
+  for (uint32_t column = 0; column < 16; ++column) {
+    tiles[TileKey::FromRowColumnLevel(0, column, 5)] = std::to_string(column);
+  }
+
+  std::atomic<size_t> in_flight{0};
+  std::atomic<size_t> max_in_flight{0};
+  std::promise<read::PrefetchTilesResponse> promise;
+
+  auto download_job = std::make_shared<Pipeline::DownloadJob>(
+      [&](std::string, client::CancellationContext) {
+        const auto current = ++in_flight;
+        auto max = max_in_flight.load();
+        while (current > max &&
+               !max_in_flight.compare_exchange_weak(max, current)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --in_flight;
+        return read::ExtendedDataResponse(nullptr);
+      },
+      AppendResult(),
+      [&](read::PrefetchTilesResponse result) {
+        promise.set_value(std::move(result));
+      },
+      nullptr);
+
+  Pipeline::Settings settings;
+  settings.max_in_flight_downloads = 2;
+
+  auto scheduler = std::make_shared<olp::thread::ThreadPoolTaskScheduler>(4);
+  read::TaskSink task_sink(scheduler);
+  auto pipeline = std::make_shared<Pipeline>(download_job, QueryResult(tiles),
+                                             nullptr, settings, task_sink,
+                                             olp::thread::NORMAL);
+  pipeline->Start({kRoot}, client::CancellationContext());
+
+  auto future = promise.get_future();
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+
+  const auto response = future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().size(), tiles.size());
+  EXPECT_LE(max_in_flight.load(), 2u);
+}
+
+TEST(PrefetchTilesPipelineTest, MemoryPressureLimitsDownloads) {
+  repository::SubQuadsResult tiles;
+  for (uint32_t column = 0; column < 8; ++column) {
+    tiles[TileKey::FromRowColumnLevel(0, column, 5)] = std::to_string(column);
+  }
+
+  std::atomic<size_t> in_flight{0};
+  std::atomic<size_t> max_in_flight{0};
+  std::promise<read::PrefetchTilesResponse> promise;
+
+  auto download_job = std::make_shared<Pipeline::DownloadJob>(
+      [&](std::string, client::CancellationContext) {
+        const auto current = ++in_flight;
+        auto max = max_in_flight.load();
+        while (current > max &&
+               !max_in_flight.compare_exchange_weak(max, current)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --in_flight;
+        return read::ExtendedDataResponse(nullptr);
+      },
+      AppendResult(),
+      [&](read::PrefetchTilesResponse result) {
+        promise.set_value(std::move(result));
+      },
+      nullptr);
+
+  auto budget = std::make_shared<client::MemoryBudget>(100u);
+  budget->OnLowMemory();
+
+  Pipeline::Settings settings;
+  settings.max_in_flight_downloads = 4;
+  settings.memory_budget = budget;
+
+  auto scheduler = std::make_shared<olp::thread::ThreadPoolTaskScheduler>(4);
+  read::TaskSink task_sink(scheduler);
+  auto pipeline = std::make_shared<Pipeline>(download_job, QueryResult(tiles),
+                                             nullptr, settings, task_sink,
+                                             olp::thread::NORMAL);
+  pipeline->Start({kRoot}, client::CancellationContext());
+
+  auto future = promise.get_future();
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+
+  const auto response = future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().size(), tiles.size());
+  EXPECT_EQ(max_in_flight.load(), 1u);
+}
+
+TEST(PrefetchTilesPipelineTest, AdaptiveDownloadsStartLow) {
+  repository::SubQuadsResult tiles;
+  for (uint32_t column = 0; column < 16; ++column) {
+    tiles[TileKey::FromRowColumnLevel(0, column, 5)] = std::to_string(column);
+  }
+
+  std::atomic<size_t> in_flight{0};
+  std::atomic<size_t> max_in_flight{0};
+  std::promise<read::PrefetchTilesResponse> promise;
+
+  auto download_job = std::make_shared<Pipeline::DownloadJob>(
+      [&](std::string, client::CancellationContext) {
+        const auto current = ++in_flight;
+        auto max = max_in_flight.load();
+        while (current > max &&
+               !max_in_flight.compare_exchange_weak(max, current)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --in_flight;
+        return read::ExtendedDataResponse(nullptr);
+      },
+      AppendResult(),
+      [&](read::PrefetchTilesResponse result) {
+        promise.set_value(std::move(result));
+      },
+      nullptr);
+
+  // The downloads without the network traffic do not change the limit.
+  Pipeline::Settings settings;
+  settings.adaptive_downloads = true;
+
+  auto scheduler = std::make_shared<olp::thread::ThreadPoolTaskScheduler>(8);
+  read::TaskSink task_sink(scheduler);
+  auto pipeline = std::make_shared<Pipeline>(download_job, QueryResult(tiles),
+                                             nullptr, settings, task_sink,
+                                             olp::thread::NORMAL);
+  pipeline->Start({kRoot}, client::CancellationContext());
+
+  auto future = promise.get_future();
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+
+  const auto response = future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().size(), tiles.size());
+  EXPECT_LE(max_in_flight.load(), 4u);
+}
+
+TEST(PrefetchTilesPipelineTest, QueryErrorFailsPrefetch) {
+  const auto error_root = TileKey::FromRowColumnLevel(0, 1, 1);
+
+  read::PrefetchTilesResponse response;
+
+  auto download_job = std::make_shared<Pipeline::DownloadJob>(
+      [](std::string, client::CancellationContext) {
+        return read::ExtendedDataResponse(nullptr);
+      },
+      AppendResult(),
+      [&](read::PrefetchTilesResponse result) { response = std::move(result); },
+      nullptr);
+
+  auto query = [=](TileKey root, client::CancellationContext) {
+    if (root == error_root) {
+      return repository::SubQuadsResponse(
+          client::ApiError(client::ErrorCode::ServiceUnavailable, "Failed"));
+    }
+    return repository::SubQuadsResponse(
+        repository::SubQuadsResult{{root.ChangedLevelBy(1), "handle"}});
+  };
+
+  Pipeline::Settings settings;
+  settings.max_in_flight_downloads = 1;
+
+  read::TaskSink task_sink(nullptr);
+  auto pipeline =
+      std::make_shared<Pipeline>(download_job, std::move(query), nullptr,
+                                 settings, task_sink, olp::thread::NORMAL);
+  pipeline->Start({TileKey::FromRowColumnLevel(0, 0, 1), error_root},
+                  client::CancellationContext());
+
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetErrorCode(),
+            client::ErrorCode::ServiceUnavailable);
+}
+
+TEST(PrefetchTilesPipelineTest, ReportsCompletedRoots) {
+  const auto first_root = TileKey::FromRowColumnLevel(0, 0, 1);
+  const auto failed_root = TileKey::FromRowColumnLevel(0, 1, 1);
+  const auto shared_root = TileKey::FromRowColumnLevel(1, 0, 1);
+  const auto shared_tile = TileKey::FromRowColumnLevel(0, 0, 5);
+
+  auto download_job = std::make_shared<Pipeline::DownloadJob>(
+      [](std::string data_handle, client::CancellationContext) {
+        if (data_handle == "failed") {
+          return read::ExtendedDataResponse(client::ApiError(
+              client::ErrorCode::ServiceUnavailable, "Failed"));
+        }
+        return read::ExtendedDataResponse(nullptr);
+      },
+      AppendResult(), [](read::PrefetchTilesResponse) {}, nullptr);
+
+  // The roots share a tile, so the last one waits only for the shared tile.
+  auto query = [=](TileKey root, client::CancellationContext) {
+    repository::SubQuadsResult tiles = {{shared_tile, "shared"}};
+    if (root == first_root) {
+      tiles[root.ChangedLevelBy(1)] = "first";
+    } else if (root == failed_root) {
+      tiles[root.ChangedLevelBy(1)] = "failed";
+    }
+    return repository::SubQuadsResponse(std::move(tiles));
+  };
+
+  std::vector<TileKey> completed_roots;
+
+  Pipeline::Settings settings;
+  settings.on_root_completed = [&](const TileKey& root) {
+    completed_roots.push_back(root);
+  };
+
+  read::TaskSink task_sink(nullptr);
+  auto pipeline =
+      std::make_shared<Pipeline>(download_job, std::move(query), nullptr,
+                                 settings, task_sink, olp::thread::NORMAL);
+  pipeline->Start({first_root, failed_root, shared_root},
+                  client::CancellationContext());
+
+  const std::vector<TileKey> expected = {first_root, shared_root};
+  EXPECT_EQ(completed_roots, expected);
+}
+
+}  // namespace
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <memory>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <mocks/CacheMock.h>
+#include "../src/repositories/QuadTreeIndexCache.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+namespace repository = olp::dataservice::read::repository;
+
+using olp::geo::TileKey;
+
+constexpr auto kCatalog = "hrn:here:data::olp-here-test:catalog";
+constexpr auto kLayer = "layer";
+constexpr auto kVersion = 282;
+
+constexpr auto kQuadTreeResponse =
+    R"jsonString({"subQuads": [{"subQuadKey": "4","version":282,"dataHandle":"7636348E50215979A39B5F3A429EDDB4.282","dataSize":277},{"subQuadKey":"5","version":282,"dataHandle":"8C9B3E08E294ADB2CD07EBC8412062FE.282","dataSize":271},{"subQuadKey": "6","version":282,"dataHandle":"9772F5E1822DFF25F48F150294B1ECF5.282","dataSize":289},{"subQuadKey":"7","version":282,"dataHandle":"BF84D8EC8124B96DBE5C4DB68B05918F.282","dataSize":283},{"subQuadKey":"1","version":48,"dataHandle":"BD53A6D60A34C20DC42ACAB2650FE361.48","dataSize":89}],"parentQuads":[{"partition":"23","version":282,"dataHandle":"F8F4C3CB09FBA61B927256CBCB8441D1.282","dataSize":52438},{"partition":"5","version":282,"dataHandle":"13E2C624E0136C3357D092EE7F231E87.282","dataSize":99151},{"partition":"95","version":253,"dataHandle":"B6F7614316BB8B81478ED7AE370B22A6.253","dataSize":6765}]})jsonString";
+
+read::QuadTreeIndex ParseQuadTree() {
+  std::stringstream stream(kQuadTreeResponse);
+  return read::QuadTreeIndex(TileKey::FromHereTile("381"), 1, stream);
+}
+
+TEST(QuadTreeIndexCacheTest, DecodedFindMatchesQuadTreeIndex) {
+  const auto index = ParseQuadTree();
+  const repository::DecodedQuadTreeIndex decoded(index);
+  EXPECT_EQ(decoded.GetRootTile(), TileKey::FromHereTile("381"));
+
+  for (const auto* tile : {"381", "95", "1526", "1524", "1561298", "3",
+                           "5842", "4818"}) {
+    SCOPED_TRACE(tile);
+    const auto tile_key = TileKey::FromHereTile(tile);
+    for (const auto aggregated : {false, true}) {
+      const auto expected = index.Find(tile_key, aggregated);
+      const auto actual = decoded.Find(tile_key, aggregated);
+      ASSERT_EQ(expected == boost::none, actual == boost::none);
+      if (expected) {
+        EXPECT_EQ(expected->tile_key, actual->tile_key);
+        EXPECT_EQ(expected->data_handle, actual->data_handle);
+        EXPECT_EQ(expected->version, actual->version);
+        EXPECT_EQ(expected->data_size, actual->data_size);
+      }
+    }
+  }
+}
+
+TEST(QuadTreeIndexCacheTest, FindPutErase) {
+  repository::QuadTreeIndexCache cache(1024u * 1024u);
+  const auto tile_key = TileKey::FromHereTile("1561298");
+  const auto root = TileKey::FromHereTile("381");
+
+  EXPECT_FALSE(cache.Find(kCatalog, kLayer, kVersion, tile_key, 4));
+
+  auto tree = std::make_shared<repository::DecodedQuadTreeIndex>(
+      ParseQuadTree());
+  cache.Put(kCatalog, kLayer, kVersion, tree);
+
+  {
+    SCOPED_TRACE("The tree is found for the tiles within the depth");
+    EXPECT_EQ(cache.Find(kCatalog, kLayer, kVersion, tile_key, 4), tree);
+    EXPECT_EQ(cache.Find(kCatalog, kLayer, kVersion, root, 0), tree);
+    EXPECT_FALSE(cache.Find(kCatalog, kLayer, kVersion, tile_key, 3));
+  }
+
+  {
+    SCOPED_TRACE("The other versions and layers do not match");
+    EXPECT_FALSE(cache.Find(kCatalog, kLayer, kVersion + 1, tile_key, 4));
+    EXPECT_FALSE(cache.Find(kCatalog, "other", kVersion, tile_key, 4));
+  }
+
+  {
+    SCOPED_TRACE("Erase the root");
+    cache.Erase(kCatalog, kLayer, kVersion, root);
+    EXPECT_FALSE(cache.Find(kCatalog, kLayer, kVersion, tile_key, 4));
+  }
+
+  {
+    SCOPED_TRACE("Erase the layer");
+    cache.Put(kCatalog, kLayer, kVersion, tree);
+    cache.Put(kCatalog, "other", kVersion, tree);
+    cache.Erase(kCatalog, kLayer);
+    EXPECT_FALSE(cache.Find(kCatalog, kLayer, kVersion, tile_key, 4));
+    EXPECT_EQ(cache.Find(kCatalog, "other", kVersion, tile_key, 4), tree);
+  }
+}
+
+TEST(QuadTreeIndexCacheTest, AcquirePerCache) {
+  using repository::QuadTreeIndexCache;
+  auto cache = std::make_shared<testing::StrictMock<CacheMock>>();
+  auto other_cache = std::make_shared<testing::StrictMock<CacheMock>>();
+  const auto tile_key = TileKey::FromHereTile("1561298");
+
+  EXPECT_FALSE(QuadTreeIndexCache::Lookup(cache.get()));
+  EXPECT_FALSE(QuadTreeIndexCache::Acquire(nullptr, 1024u));
+  EXPECT_FALSE(QuadTreeIndexCache::Acquire(cache, 0u));
+
+  auto instance = QuadTreeIndexCache::Acquire(cache, 1024u * 1024u);
+  ASSERT_TRUE(instance);
+  EXPECT_EQ(QuadTreeIndexCache::Acquire(cache, 1024u), instance);
+  EXPECT_EQ(QuadTreeIndexCache::Lookup(cache.get()), instance);
+
+  auto other_instance = QuadTreeIndexCache::Acquire(other_cache, 1024u);
+  ASSERT_TRUE(other_instance);
+  EXPECT_NE(other_instance, instance);
+
+  {
+    SCOPED_TRACE("The trees of one cache are not found in the other");
+    auto tree = std::make_shared<repository::DecodedQuadTreeIndex>(
+        ParseQuadTree());
+    instance->Put(kCatalog, kLayer, kVersion, tree);
+    EXPECT_EQ(instance->Find(kCatalog, kLayer, kVersion, tile_key, 4), tree);
+    EXPECT_FALSE(
+        other_instance->Find(kCatalog, kLayer, kVersion, tile_key, 4));
+  }
+
+  {
+    SCOPED_TRACE("The size of the cache limits the trees");
+    auto tree = std::make_shared<repository::DecodedQuadTreeIndex>(
+        ParseQuadTree());
+    ASSERT_GT(tree->GetSize(), 1024u);
+    other_instance->Put(kCatalog, kLayer, kVersion, tree);
+    EXPECT_FALSE(
+        other_instance->Find(kCatalog, kLayer, kVersion, tile_key, 4));
+  }
+}
+
+}  // namespace
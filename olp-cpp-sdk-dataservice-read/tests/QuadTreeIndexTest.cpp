@@ -34,6 +34,8 @@ constexpr auto HTTP_RESPONSE_MAILFORMED =
     R"jsonString({"subQuads": 0}])jsonString";
 constexpr auto HTTP_RESPONSE_WRONG_FORMAT =
     R"jsonString({"parentQuads": 0,"subQuads": 0})jsonString";
+constexpr auto HTTP_RESPONSE_INVALID_QUADS =
+    R"jsonString({"unknown": [{"subQuadKey": "4","dataHandle":"unknown"}],"subQuads": [{"subQuadKey": "4","dataHandle":4},{"subQuadKey":"5","nested":{"dataHandle":"nested"}},[{"subQuadKey":"6","dataHandle":"array"}],{"subQuadKey":"7","checksum":{"a":[1]},"dataHandle":"valid","version":-1,"dataSize":1.5}],"parentQuads":[{"subQuadKey":"1","dataHandle":"no partition"}]})jsonString";
 
 TEST(QuadTreeIndexTest, ParseBlob) {
   using testing::Return;
@@ -142,4 +144,65 @@ TEST(QuadTreeIndexTest, ParseBlob) {
   }
 }
 
+TEST(QuadTreeIndexTest, ParseSkipsInvalidQuads) {
+  auto tile_key = olp::geo::TileKey::FromHereTile("381");
+  auto stream = std::stringstream(HTTP_RESPONSE_INVALID_QUADS);
+  read::QuadTreeIndex index(tile_key, 1, stream);
+  ASSERT_FALSE(index.IsNull());
+
+  const auto index_data = index.GetIndexData();
+  ASSERT_EQ(index_data.size(), 1u);
+  EXPECT_EQ(index_data[0].tile_key, tile_key.AddedSubHereTile("7"));
+  EXPECT_EQ(index_data[0].data_handle, "valid");
+  EXPECT_EQ(index_data[0].checksum, "");
+  EXPECT_EQ(index_data[0].version, static_cast<uint64_t>(-1));
+  EXPECT_EQ(index_data[0].data_size, -1);
+}
+
+TEST(QuadTreeIndexTest, FindNearestParentInDeepTree) {
+  const auto root = olp::geo::TileKey::FromRowColumnLevel(10, 20, 10);
+  const auto child = root.ChangedLevelBy(2);
+  const auto parent = root.ChangedLevelBy(-3);
+
+  std::vector<read::QuadTreeIndex::IndexData> quads(3);
+  quads[0].tile_key = root;
+  quads[0].data_handle = "root";
+  quads[1].tile_key = child;
+  quads[1].data_handle = "child";
+  quads[2].tile_key = parent;
+  quads[2].data_handle = "parent";
+
+  read::QuadTreeIndex index(root, 4, quads);
+  ASSERT_FALSE(index.IsNull());
+
+  {
+    SCOPED_TRACE("The closest ancestor in the tree");
+    auto data = index.Find(child.ChangedLevelBy(2), true);
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data->data_handle, "child");
+  }
+  {
+    SCOPED_TRACE("The root");
+    auto data = index.Find(root.GetChild(3).GetChild(0), true);
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data->data_handle, "root");
+  }
+  {
+    SCOPED_TRACE("Below the depth of the tree");
+    auto data = index.Find(child.ChangedLevelBy(8), true);
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data->data_handle, "child");
+  }
+  {
+    SCOPED_TRACE("The parent quad above the root");
+    auto data = index.Find(root.Parent(), true);
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data->data_handle, "parent");
+  }
+  {
+    SCOPED_TRACE("Not aggregated");
+    EXPECT_FALSE(index.Find(child.ChangedLevelBy(1), false));
+  }
+}
+
 }  // namespace
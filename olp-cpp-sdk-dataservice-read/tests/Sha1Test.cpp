@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Sha1.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+
+std::string ToHex(const read::Sha1Digest& digest) {
+  static const char kHex[] = "0123456789abcdef";
+  std::string result;
+  for (auto byte : digest) {
+    result += kHex[byte >> 4];
+    result += kHex[byte & 0xf];
+  }
+  return result;
+}
+
+std::string Sha1(const std::string& input) {
+  return ToHex(read::ComputeSha1(
+      reinterpret_cast<const unsigned char*>(input.data()), input.size()));
+}
+
+read::model::Data MakeData(const std::string& input) {
+  return std::make_shared<std::vector<unsigned char>>(input.begin(),
+                                                      input.end());
+}
+
+TEST(Sha1Test, ComputeSha1) {
+  EXPECT_EQ(Sha1(""), "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+  EXPECT_EQ(Sha1("abc"), "a9993e364706816aba3e25717850c26c9cd0d89d");
+  // The padding does not fit into the last chunk.
+  EXPECT_EQ(Sha1("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+            "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+  EXPECT_EQ(Sha1(std::string(1000, 'a')),
+            "291e9a6c66994949b57ba5e650361e98fc36b1ba");
+}
+
+TEST(Sha1Test, MatchesSha1Checksum) {
+  const auto data = MakeData("abc");
+  EXPECT_TRUE(read::MatchesSha1Checksum(
+      data, "a9993e364706816aba3e25717850c26c9cd0d89d"));
+  EXPECT_TRUE(read::MatchesSha1Checksum(
+      data, "A9993E364706816ABA3E25717850C26C9CD0D89D"));
+  EXPECT_FALSE(read::MatchesSha1Checksum(
+      data, "a9993e364706816aba3e25717850c26c9cd0d89e"));
+  EXPECT_FALSE(read::MatchesSha1Checksum(
+      nullptr, "a9993e364706816aba3e25717850c26c9cd0d89d"));
+  EXPECT_FALSE(read::MatchesSha1Checksum(data, "a9993e"));
+}
+
+TEST(Sha1Test, IsSha1Checksum) {
+  EXPECT_TRUE(read::IsSha1Checksum("a9993e364706816aba3e25717850c26c9cd0d89d"));
+  EXPECT_FALSE(read::IsSha1Checksum(""));
+  EXPECT_FALSE(read::IsSha1Checksum("checksum"));
+  EXPECT_FALSE(
+      read::IsSha1Checksum("x9993e364706816aba3e25717850c26c9cd0d89d"));
+}
+
+}  // namespace
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+#include <mocks/NetworkMock.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/dataservice/read/StreamConsumerGroup.h>
+
+namespace {
+using ::testing::_;
+namespace client = olp::client;
+namespace read = olp::dataservice::read;
+
+const auto kHrn = client::HRN::FromString(
+    "hrn:here:data::olp-here-test:hereos-internal-test-v2");
+constexpr auto kLayerId = "testlayer";
+const auto kTimeout = std::chrono::seconds(5);
+
+TEST(StreamConsumerGroupTest, ConsumersCount) {
+  client::OlpClientSettings settings;
+  settings.network_request_handler = std::make_shared<NetworkMock>();
+
+  read::StreamConsumerGroup group(kHrn, kLayerId, settings, 3u);
+  EXPECT_EQ(group.GetConsumersCount(), 3u);
+
+  read::StreamConsumerGroup empty_group(kHrn, kLayerId, settings, 0u);
+  EXPECT_EQ(empty_group.GetConsumersCount(), 1u);
+}
+
+TEST(StreamConsumerGroupTest, SubscribeWithoutConsumerId) {
+  auto network = std::make_shared<NetworkMock>();
+  EXPECT_CALL(*network, Send(_, _, _, _, _)).Times(0);
+
+  client::OlpClientSettings settings;
+  settings.network_request_handler = network;
+
+  read::StreamConsumerGroup group(kHrn, kLayerId, settings, 2u);
+
+  std::promise<read::ConsumerGroupResponse> promise;
+  auto future = promise.get_future();
+  group.Subscribe(read::SubscribeRequest(),
+                  [&](read::ConsumerGroupResponse response) {
+                    promise.set_value(std::move(response));
+                  });
+
+  ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+
+  const auto response = future.get();
+  EXPECT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetErrorCode(),
+            client::ErrorCode::InvalidArgument);
+}
+
+}  // namespace
@@ -687,6 +687,53 @@ TEST_F(StreamLayerClientImplTest, GetDataCancel) {
   Mock::VerifyAndClearExpectations(network_mock_.get());
 }
 
+TEST_F(StreamLayerClientImplTest, GetDataOfMessages) {
+  SetupNetworkExpectation(kUrlLookup, kHttpResponseLookup,
+                          http::HttpStatusCode::OK);
+
+  SetupNetworkExpectation(kUrlBlobGetBlob, kBlobData.c_str(),
+                          http::HttpStatusCode::OK);
+
+  read::StreamLayerClientImpl client(kHrn, kLayerId, settings_);
+
+  model::Metadata handle_metadata;
+  handle_metadata.SetDataHandle(kDataHandle);
+  model::Message handle_message;
+  handle_message.SetMetaData(handle_metadata);
+
+  const std::string embedded_data = "embedded";
+  model::Metadata embedded_metadata;
+  embedded_metadata.SetData(std::make_shared<std::vector<unsigned char>>(
+      embedded_data.begin(), embedded_data.end()));
+  model::Message embedded_message;
+  embedded_message.SetMetaData(embedded_metadata);
+
+  model::Messages messages;
+  messages.SetMessages({embedded_message, handle_message});
+
+  auto future = client.GetData(messages).GetFuture();
+
+  ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+
+  const auto response = future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+
+  const auto& results = response.GetResult();
+  ASSERT_EQ(results.size(), 2u);
+
+  ASSERT_TRUE(results[0].IsSuccessful());
+  ASSERT_TRUE(results[0].GetResult());
+  EXPECT_THAT(*results[0].GetResult(),
+              ElementsAreArray(embedded_data.begin(), embedded_data.end()));
+
+  ASSERT_TRUE(results[1].IsSuccessful());
+  ASSERT_TRUE(results[1].GetResult());
+  EXPECT_THAT(*results[1].GetResult(),
+              ElementsAreArray(kBlobData.begin(), kBlobData.end()));
+
+  Mock::VerifyAndClearExpectations(network_mock_.get());
+}
+
 TEST_F(StreamLayerClientImplTest, Poll) {
   const auto message1 = PrepareMessage("1", 1, 4);
 
@@ -938,6 +985,85 @@ TEST_F(StreamLayerClientImplTest, PollCancel) {
   Mock::VerifyAndClearExpectations(network_mock_.get());
 }
 
+TEST_F(StreamLayerClientImplTest, StartPolling) {
+  const auto message1 = PrepareMessage("1", 1, 4);
+
+  {
+    SCOPED_TRACE("Next batch is polled after the acknowledgement");
+
+    settings_.task_scheduler =
+        client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(2);
+
+    read::StreamLayerClientImpl client(kHrn, kLayerId, settings_);
+    SimulateSubscription(client);
+
+    EXPECT_CALL(*network_mock_,
+                Send(IsGetRequest(kUrlStreamConsume), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            http::NetworkResponse().WithStatus(http::HttpStatusCode::OK),
+            kHttpResponsePollOneMessage))
+        .WillOnce(ReturnHttpResponse(http::NetworkResponse().WithStatus(
+                                         http::HttpStatusCode::BAD_REQUEST),
+                                     kHttpResponsePollConsumeBadRequest));
+
+    SetupNetworkExpectation(kUrlStreamCommitOffsets, kHttpResponseEmpty,
+                            http::HttpStatusCode::OK, RequestMethod::PUT,
+                            kHttpRequestBodyOffsetsOnePartition);
+
+    std::vector<model::Message> handled_messages;
+    read::ContinuousPollSettings poll_settings;
+    poll_settings.max_pending_batches = 1u;
+
+    std::promise<read::ContinuousPollResponse> promise;
+    auto future = promise.get_future();
+    client.StartPolling(
+        poll_settings,
+        [&](read::MessagesResult messages,
+            read::PollAcknowledgement acknowledgement) {
+          handled_messages = messages.GetMessages();
+          acknowledgement();
+        },
+        [&](read::ContinuousPollResponse response) {
+          promise.set_value(std::move(response));
+        });
+
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+
+    const auto response = future.get();
+    EXPECT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetHttpStatusCode(),
+              http::HttpStatusCode::BAD_REQUEST);
+
+    ASSERT_EQ(handled_messages.size(), 1u);
+    EXPECT_THAT(handled_messages[0], EqMessage(message1));
+
+    Mock::VerifyAndClearExpectations(network_mock_.get());
+  }
+  {
+    SCOPED_TRACE("Polling fails without a task scheduler");
+
+    settings_.task_scheduler = nullptr;
+
+    read::StreamLayerClientImpl client(kHrn, kLayerId, settings_);
+
+    std::promise<read::ContinuousPollResponse> promise;
+    auto future = promise.get_future();
+    client.StartPolling(
+        read::ContinuousPollSettings(),
+        [](read::MessagesResult, read::PollAcknowledgement) {},
+        [&](read::ContinuousPollResponse response) {
+          promise.set_value(std::move(response));
+        });
+
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+
+    const auto response = future.get();
+    EXPECT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              client::ErrorCode::PreconditionFailed);
+  }
+}
+
 TEST_F(StreamLayerClientImplTest, Seek) {
   model::StreamOffsets offsets = GetStreamOffsets();
   {
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "repositories/StreamOffsetsRepository.h"
+
+#include <gmock/gmock.h>
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+
+namespace {
+namespace repository = olp::dataservice::read::repository;
+namespace client = olp::client;
+namespace cache = olp::cache;
+namespace model = olp::dataservice::read::model;
+
+constexpr auto kCatalog = "hrn:here:data::olp-here-test:catalog";
+constexpr auto kLayer = "layer";
+constexpr auto kCheckpointId = "consumer";
+
+model::StreamOffset MakeOffset(int32_t partition, int64_t offset) {
+  model::StreamOffset result;
+  result.SetPartition(partition);
+  result.SetOffset(offset);
+  return result;
+}
+
+std::vector<std::pair<int32_t, int64_t>> ToPairs(
+    const std::vector<model::StreamOffset>& offsets) {
+  std::vector<std::pair<int32_t, int64_t>> result;
+  for (const auto& offset : offsets) {
+    result.emplace_back(offset.GetPartition(), offset.GetOffset());
+  }
+  return result;
+}
+
+TEST(StreamOffsetsRepositoryTest, SavesCommittedOffsets) {
+  const auto hrn = client::HRN::FromString(kCatalog);
+
+  std::shared_ptr<cache::KeyValueCache> cache =
+      client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  {
+    SCOPED_TRACE("Saves the first commit and merges the next ones");
+
+    repository::StreamOffsetsRepository checkpoint(
+        hrn, kLayer, kCheckpointId, std::chrono::hours(1), cache);
+    EXPECT_TRUE(checkpoint.Load().empty());
+
+    checkpoint.Commit({MakeOffset(1, 10), MakeOffset(2, 20)});
+
+    repository::StreamOffsetsRepository reader(
+        hrn, kLayer, kCheckpointId, std::chrono::hours(1), cache);
+    EXPECT_THAT(ToPairs(reader.Load()),
+                testing::ElementsAre(std::make_pair(1, 10),
+                                     std::make_pair(2, 20)));
+
+    checkpoint.Commit({MakeOffset(1, 15), MakeOffset(3, 30)});
+    checkpoint.Commit({MakeOffset(1, 12)});
+    EXPECT_EQ(ToPairs(reader.Load()).size(), 2u);
+
+    checkpoint.Flush();
+    EXPECT_THAT(ToPairs(reader.Load()),
+                testing::ElementsAre(std::make_pair(1, 15),
+                                     std::make_pair(2, 20),
+                                     std::make_pair(3, 30)));
+  }
+
+  {
+    SCOPED_TRACE("Saves the pending commits when destroyed");
+
+    {
+      repository::StreamOffsetsRepository checkpoint(
+          hrn, kLayer, kCheckpointId, std::chrono::hours(1), cache);
+      checkpoint.Load();
+      checkpoint.Commit({MakeOffset(2, 25)});
+      checkpoint.Commit({MakeOffset(3, 35)});
+    }
+
+    repository::StreamOffsetsRepository reader(
+        hrn, kLayer, kCheckpointId, std::chrono::hours(1), cache);
+    EXPECT_THAT(ToPairs(reader.Load()),
+                testing::ElementsAre(std::make_pair(1, 15),
+                                     std::make_pair(2, 25),
+                                     std::make_pair(3, 35)));
+  }
+
+  {
+    SCOPED_TRACE("Other IDs are not affected");
+
+    repository::StreamOffsetsRepository other_id(
+        hrn, kLayer, "other", std::chrono::hours(1), cache);
+    EXPECT_TRUE(other_id.Load().empty());
+  }
+}
+
+}  // namespace
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <future>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <olp/core/client/ApiError.h>
+#include <olp/core/client/ApiResponse.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+#include "TaskSink.h"
+
+namespace {
+namespace client = olp::client;
+namespace read = olp::dataservice::read;
+
+using Response = client::ApiResponse<int, client::ApiError>;
+
+constexpr auto kTimeout = std::chrono::seconds(5);
+
+/// Occupies the only scheduler thread until the returned promise is set.
+std::shared_ptr<std::promise<void>> BlockScheduler(
+    olp::thread::TaskScheduler& scheduler) {
+  auto unblock = std::make_shared<std::promise<void>>();
+  auto future = unblock->get_future().share();
+  scheduler.ScheduleTask([future] { future.wait(); });
+  return unblock;
+}
+
+TEST(TaskSinkTest, CancelTasks) {
+  auto scheduler = std::make_shared<olp::thread::ThreadPoolTaskScheduler>(1);
+
+  {
+    SCOPED_TRACE("Queued tasks are cancelled when they start");
+    read::TaskSink sink(scheduler);
+    auto unblock = BlockScheduler(*scheduler);
+
+    std::promise<Response> first_promise;
+    std::promise<Response> second_promise;
+    sink.AddTask([](client::CancellationContext) { return Response(1); },
+                 [&](Response response) {
+                   first_promise.set_value(std::move(response));
+                 },
+                 0u);
+    sink.AddTask([](client::CancellationContext) { return Response(2); },
+                 [&](Response response) {
+                   second_promise.set_value(std::move(response));
+                 },
+                 0u);
+
+    sink.CancelTasks();
+    unblock->set_value();
+
+    auto first = first_promise.get_future();
+    auto second = second_promise.get_future();
+    ASSERT_EQ(first.wait_for(kTimeout), std::future_status::ready);
+    ASSERT_EQ(second.wait_for(kTimeout), std::future_status::ready);
+    const auto first_response = first.get();
+    const auto second_response = second.get();
+    ASSERT_FALSE(first_response.IsSuccessful());
+    EXPECT_EQ(first_response.GetError().GetErrorCode(),
+              client::ErrorCode::Cancelled);
+    ASSERT_FALSE(second_response.IsSuccessful());
+    EXPECT_EQ(second_response.GetError().GetErrorCode(),
+              client::ErrorCode::Cancelled);
+  }
+
+  {
+    SCOPED_TRACE("Tasks added after the cancellation run");
+    read::TaskSink sink(scheduler);
+    sink.CancelTasks();
+
+    std::promise<Response> promise;
+    sink.AddTask([](client::CancellationContext) { return Response(3); },
+                 [&](Response response) {
+                   promise.set_value(std::move(response));
+                 },
+                 0u);
+
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+    const auto response = future.get();
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult(), 3);
+  }
+
+  {
+    SCOPED_TRACE("Running tasks are cancelled right away");
+    read::TaskSink sink(scheduler);
+
+    std::promise<void> started;
+    std::promise<Response> promise;
+    sink.AddTask(
+        [&](client::CancellationContext context) {
+          started.set_value();
+          while (!context.IsCancelled()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+          return Response(4);
+        },
+        [&](Response response) { promise.set_value(std::move(response)); },
+        0u);
+
+    started.get_future().wait();
+    sink.CancelTasks();
+
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+    const auto response = future.get();
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              client::ErrorCode::Cancelled);
+  }
+}
+
+TEST(TaskSinkTest, DestructorWaitsForTasks) {
+  auto scheduler = std::make_shared<olp::thread::ThreadPoolTaskScheduler>(1);
+  auto unblock = BlockScheduler(*scheduler);
+
+  bool called = false;
+  auto response = Response(0);
+  std::thread release([=] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    unblock->set_value();
+  });
+
+  {
+    read::TaskSink sink(scheduler);
+    sink.AddTask([](client::CancellationContext) { return Response(1); },
+                 [&](Response result) {
+                   called = true;
+                   response = std::move(result);
+                 },
+                 0u);
+  }
+
+  release.join();
+  ASSERT_TRUE(called);
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetErrorCode(), client::ErrorCode::Cancelled);
+}
+
+}  // namespace
@@ -17,6 +17,10 @@
  * License-Filename: LICENSE
  */
 
+#include <atomic>
+#include <future>
+#include <memory>
+
 #include <gtest/gtest.h>
 #include <matchers/NetworkUrlMatchers.h>
 #include <mocks/CacheMock.h>
@@ -26,6 +30,8 @@
 #include <olp/core/cache/DefaultCache.h>
 #include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/geo/tiling/TileKeyUtils.h>
+#include <olp/core/geo/tiling/TilingSchemeRegistry.h>
 #include <olp/core/utils/Dir.h>
 #include <olp/dataservice/read/VersionedLayerClient.h>
 #include "ApiDefaultResponses.h"
@@ -33,6 +39,8 @@
 #include "ReadDefaultResponses.h"
 #include "ResponseGenerator.h"
 #include "VersionedLayerClientImpl.h"
+#include "repositories/PartitionsCacheRepository.h"
+#include "repositories/PrefetchTilesRepository.h"
 #include "repositories/QuadTreeIndex.h"
 // clang-format off
 #include "generated/serializer/ApiSerializer.h"
@@ -99,6 +107,69 @@ TEST(VersionedLayerClientTest, GetData) {
   Mock::VerifyAndClearExpectations(network_mock.get());
 }
 
+// Counts its copies, so the tests can check that the callback is moved.
+struct CopyCountingCallback {
+  using Promise = std::promise<read::DataResponse>;
+
+  CopyCountingCallback(std::shared_ptr<std::atomic<int>> copies,
+                       std::shared_ptr<Promise> promise)
+      : copies(std::move(copies)), promise(std::move(promise)) {}
+
+  CopyCountingCallback(const CopyCountingCallback& other)
+      : copies(other.copies), promise(other.promise) {
+    ++*copies;
+  }
+
+  CopyCountingCallback(CopyCountingCallback&&) = default;
+
+  void operator()(read::DataResponse response) const {
+    promise->set_value(std::move(response));
+  }
+
+  std::shared_ptr<std::atomic<int>> copies;
+  std::shared_ptr<Promise> promise;
+};
+
+TEST(VersionedLayerClientTest, GetDataDoesNotCopyCallback) {
+  std::shared_ptr<NetworkMock> network_mock = std::make_shared<NetworkMock>();
+  std::shared_ptr<CacheMock> cache_mock = std::make_shared<CacheMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network_mock;
+  settings.cache = cache_mock;
+
+  read::VersionedLayerClient client(kHrn, kLayerId, boost::none, settings);
+  auto copies = std::make_shared<std::atomic<int>>(0);
+  {
+    SCOPED_TRACE("Partition request");
+    auto promise = std::make_shared<std::promise<read::DataResponse>>();
+    auto future = promise->get_future();
+
+    client.GetData(read::DataRequest()
+                       .WithPartitionId(kPartitionId)
+                       .WithDataHandle(kBlobDataHandle),
+                   read::DataResponseCallback(
+                       CopyCountingCallback(copies, promise)));
+
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+    EXPECT_FALSE(future.get().IsSuccessful());
+  }
+  {
+    SCOPED_TRACE("Tile request");
+    auto promise = std::make_shared<std::promise<read::DataResponse>>();
+    auto future = promise->get_future();
+
+    client.GetData(
+        read::TileRequest(),
+        read::DataResponseCallback(CopyCountingCallback(copies, promise)));
+
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+    EXPECT_FALSE(future.get().IsSuccessful());
+  }
+
+  EXPECT_EQ(0, copies->load());
+  Mock::VerifyAndClearExpectations(network_mock.get());
+}
+
 TEST(VersionedLayerClientTest, RemoveFromCachePartition) {
   olp::client::OlpClientSettings settings;
   std::shared_ptr<CacheMock> cache_mock = std::make_shared<CacheMock>();
@@ -431,6 +502,12 @@ TEST(VersionedLayerClientTest, ProtectThanRelease) {
     std::this_thread::sleep_for(std::chrono::seconds(3));
     ASSERT_TRUE(client.IsCached(tile_key));
     ASSERT_TRUE(client.IsCached(other_tile_key));
+
+    const auto not_cached_tile_key =
+        olp::geo::TileKey::FromHereTile(kOtherHereTile2);
+    const auto cached_tiles = client.GetCachedTiles(
+        {tile_key, not_cached_tile_key, other_tile_key});
+    EXPECT_EQ(read::TileKeys({tile_key, other_tile_key}), cached_tiles);
   }
 
   {
@@ -531,6 +608,268 @@ TEST(VersionedLayerClientTest, ProtectThanRelease) {
   Mock::VerifyAndClearExpectations(network_mock.get());
 }
 
+TEST(VersionedLayerClientTest, ProtectAndReleaseArea) {
+  olp::cache::CacheSettings cache_settings;
+  cache_settings.disk_path_mutable =
+      olp::utils::Dir::TempDirectory() + "/unittest";
+  auto cache =
+      std::make_shared<olp::cache::DefaultCache>(std::move(cache_settings));
+  ASSERT_EQ(cache->Open(), olp::cache::DefaultCache::Success);
+  cache->Clear();
+  olp::client::OlpClientSettings settings;
+  settings.cache = cache;
+
+  const auto level = 12u;
+  const olp::geo::GeoCoordinates center(52.52, 13.405);
+  const olp::geo::GeoRectangle area(
+      olp::geo::GeoCoordinates(center.GetLatitude() - 0.0001,
+                               center.GetLongitude() - 0.0001),
+      olp::geo::GeoCoordinates(center.GetLatitude() + 0.0001,
+                               center.GetLongitude() + 0.0001));
+  const auto tile = olp::geo::TileKeyUtils::GeoCoordinatesToTileKey(
+      olp::geo::HalfQuadTreeIdentityTilingScheme(), center, level);
+
+  // Cache the quad trees, which the prefetch of the area would download.
+  read::repository::PartitionsCacheRepository partitions_cache(
+      kHrn, kLayerId, cache);
+  const auto roots = read::repository::PrefetchTilesRepository::GetSlicedTiles(
+      read::PrefetchTilesRequest().WithGeoRectangle(area), level, level);
+  ASSERT_FALSE(roots.empty());
+  for (const auto& root : roots) {
+    auto stream =
+        std::stringstream(ReadDefaultResponses::GenerateQuadTreeResponse(
+            root.first, root.second, {level}));
+    read::QuadTreeIndex quad_tree(root.first, root.second, stream);
+    partitions_cache.Put(root.first, root.second, quad_tree, kCatalogVersion);
+  }
+
+  auto data_key = [](const olp::geo::TileKey& key) {
+    return kHrn.ToCatalogHRNString() + "::" + kLayerId + "::" +
+           ReadDefaultResponses::GenerateDataHandle(key.ToHereTile()) +
+           "::Data";
+  };
+
+  read::VersionedLayerClient client(kHrn, kLayerId, kCatalogVersion, settings);
+  {
+    SCOPED_TRACE("Protect");
+    EXPECT_TRUE(client.Protect(area, level, level));
+    EXPECT_TRUE(cache->IsProtected(data_key(tile)));
+    EXPECT_FALSE(cache->IsProtected(data_key(tile.NextColumn().NextColumn())));
+  }
+  {
+    SCOPED_TRACE("Release");
+    EXPECT_TRUE(client.Release(area, level, level));
+    EXPECT_FALSE(cache->IsProtected(data_key(tile)));
+    EXPECT_FALSE(client.Release(area, level, level));
+  }
+  {
+    SCOPED_TRACE("Levels without tiles");
+    EXPECT_FALSE(client.Protect(area, level + 1u, level + 1u));
+  }
+}
+
+TEST(VersionedLayerClientTest, SharedCatalogContext) {
+  auto network_mock = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.cache = std::make_shared<testing::NiceMock<CacheMock>>();
+  settings.network_request_handler = network_mock;
+  const auto version = 4u;
+
+  auto apis = ApiDefaultResponses::GenerateResourceApisResponse(kCatalog);
+  PlatformUrlsGenerator generator(apis, kLayerId);
+  const auto version_path = generator.LatestVersion();
+  ASSERT_FALSE(version_path.empty());
+  const auto partitions_path = generator.PartitionsMetadata();
+  ASSERT_FALSE(partitions_path.empty());
+
+  // The lookup and the version are requested once for both clients.
+  EXPECT_CALL(*network_mock, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          ResponseGenerator::ResourceApis(apis)));
+  EXPECT_CALL(*network_mock, Send(IsGetRequest(version_path), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          olp::serializer::serialize(
+              ReadDefaultResponses::GenerateVersionResponse(version))));
+  EXPECT_CALL(*network_mock,
+              Send(IsGetRequestPrefix(partitions_path), _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          olp::serializer::serialize(
+              ReadDefaultResponses::GeneratePartitionsResponse(2))));
+
+  auto context = std::make_shared<read::CatalogContext>(kHrn, settings);
+  read::VersionedLayerClientImpl client_a(context, kLayerId, boost::none);
+  read::VersionedLayerClientImpl client_b(context, kLayerId, boost::none);
+
+  for (auto* client : {&client_a, &client_b}) {
+    auto future = client->GetPartitions(read::PartitionsRequest()).GetFuture();
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+    const auto response = future.get();
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().GetPartitions().size(), 2u);
+  }
+
+  Mock::VerifyAndClearExpectations(network_mock.get());
+}
+
+TEST(VersionedLayerClientTest, ReadSession) {
+  auto network_mock = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.cache = std::make_shared<testing::NiceMock<CacheMock>>();
+  settings.network_request_handler = network_mock;
+  const int64_t version = 4;
+
+  auto apis = ApiDefaultResponses::GenerateResourceApisResponse(kCatalog);
+  PlatformUrlsGenerator generator(apis, kLayerId);
+  const auto version_path = generator.LatestVersion();
+  ASSERT_FALSE(version_path.empty());
+  const auto partitions_path = generator.PartitionsMetadata();
+  ASSERT_FALSE(partitions_path.empty());
+
+  EXPECT_CALL(*network_mock, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          ResponseGenerator::ResourceApis(apis)));
+  // Once to open the session and once to check for a newer version.
+  EXPECT_CALL(*network_mock, Send(IsGetRequest(version_path), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          olp::serializer::serialize(
+              ReadDefaultResponses::GenerateVersionResponse(version))))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          olp::serializer::serialize(
+              ReadDefaultResponses::GenerateVersionResponse(version + 1))));
+  EXPECT_CALL(*network_mock,
+              Send(IsGetRequestPrefix(partitions_path), _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          olp::serializer::serialize(
+              ReadDefaultResponses::GeneratePartitionsResponse(2))));
+
+  read::VersionedLayerClient client(kHrn, kLayerId, boost::none, settings);
+
+  auto session_future =
+      client.OpenReadSession(read::CatalogVersionRequest()).GetFuture();
+  ASSERT_EQ(session_future.wait_for(kTimeout), std::future_status::ready);
+  auto session_response = session_future.get();
+  ASSERT_TRUE(session_response.IsSuccessful());
+  auto session = session_response.MoveResult();
+  ASSERT_TRUE(session);
+  EXPECT_EQ(session->GetVersion(), version);
+
+  for (auto i = 0; i < 2; ++i) {
+    auto future = session->GetPartitions(read::PartitionsRequest()).GetFuture();
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+    const auto response = future.get();
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().GetPartitions().size(), 2u);
+  }
+
+  std::promise<read::CatalogVersionResponse> promise;
+  session->CheckForNewerVersion([&](read::CatalogVersionResponse response) {
+    promise.set_value(std::move(response));
+  });
+  auto version_future = promise.get_future();
+  ASSERT_EQ(version_future.wait_for(kTimeout), std::future_status::ready);
+  const auto version_response = version_future.get();
+  ASSERT_TRUE(version_response.IsSuccessful());
+  EXPECT_GT(version_response.GetResult().GetVersion(), session->GetVersion());
+
+  Mock::VerifyAndClearExpectations(network_mock.get());
+}
+
+TEST(VersionedLayerClientTest, GetCachedData) {
+  std::shared_ptr<NetworkMock> network_mock = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings.network_request_handler = network_mock;
+  auto version = 4u;
+
+  auto apis = ApiDefaultResponses::GenerateResourceApisResponse(kCatalog);
+  auto api_response = ResponseGenerator::ResourceApis(apis);
+  PlatformUrlsGenerator generator(apis, kLayerId);
+
+  auto quad_path = generator.VersionedQuadTree("92259", version, 4);
+  ASSERT_FALSE(quad_path.empty());
+  auto tile_key = olp::geo::TileKey::FromHereTile(kHereTile);
+  auto response_quad = ReadDefaultResponses::GenerateQuadTreeResponse(
+      tile_key.ChangedLevelBy(-4), 4, {9, 10, 11, 12});
+  auto tile_path =
+      generator.DataBlob(ReadDefaultResponses::GenerateDataHandle(kHereTile));
+  ASSERT_FALSE(tile_path.empty());
+
+  {
+    SCOPED_TRACE("Version is not initialized");
+    read::VersionedLayerClientImpl client(kHrn, kLayerId, boost::none,
+                                          settings);
+    auto response = client.GetCachedData(tile_key);
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              olp::client::ErrorCode::PreconditionFailed);
+  }
+
+  read::VersionedLayerClientImpl client(kHrn, kLayerId, version, settings);
+  {
+    SCOPED_TRACE("Tile is not cached");
+    auto response = client.GetCachedData(tile_key);
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              olp::client::ErrorCode::NotFound);
+  }
+
+  {
+    SCOPED_TRACE("Cache tile");
+    EXPECT_CALL(*network_mock, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     api_response));
+    EXPECT_CALL(*network_mock, Send(IsGetRequest(quad_path), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     response_quad));
+    EXPECT_CALL(*network_mock, Send(IsGetRequest(tile_path), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     "data"));
+
+    auto future =
+        client.GetData(read::TileRequest().WithTileKey(tile_key)).GetFuture();
+    ASSERT_TRUE(future.get().IsSuccessful());
+    Mock::VerifyAndClearExpectations(network_mock.get());
+  }
+
+  {
+    SCOPED_TRACE("Cached tile is returned without network requests");
+    EXPECT_CALL(*network_mock, Send(_, _, _, _, _)).Times(0);
+
+    auto response = client.GetCachedData(tile_key);
+    ASSERT_TRUE(response.IsSuccessful());
+    const auto& data = response.GetResult();
+    ASSERT_TRUE(data);
+    EXPECT_EQ(std::string(data->begin(), data->end()), "data");
+
+    auto other_response =
+        client.GetCachedData(olp::geo::TileKey::FromHereTile(kOtherHereTile));
+    ASSERT_FALSE(other_response.IsSuccessful());
+    EXPECT_EQ(other_response.GetError().GetErrorCode(),
+              olp::client::ErrorCode::NotFound);
+  }
+  Mock::VerifyAndClearExpectations(network_mock.get());
+}
+
 TEST(VersionedLayerClientTest, PrefetchPartitionsSplitted) {
   std::shared_ptr<NetworkMock> network_mock = std::make_shared<NetworkMock>();
   olp::client::OlpClientSettings settings;
@@ -921,6 +921,60 @@ TEST(VolatileLayerClientImplTest, PrefetchTilesCancellableFuture) {
   }
 }
 
+TEST(VolatileLayerClientImplTest, PrefetchTilesStreamed) {
+  std::shared_ptr<NetworkMock> network_mock = std::make_shared<NetworkMock>();
+  std::shared_ptr<CacheMock> cache_mock = std::make_shared<CacheMock>();
+
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network_mock;
+  settings.cache = cache_mock;
+  olp::client::HRN catalog(kCatalog);
+  read::VolatileLayerClientImpl client(catalog, kLayerId, settings);
+
+  SetupNetworkExpectation(*network_mock, kUrlQuadTreeIndexVolatile,
+                          kHttpResponseQuadTreeIndexVolatile,
+                          olp::http::HttpStatusCode::OK);
+  SetupNetworkExpectation(*network_mock, kUrlPrefetchBlobData1, kData1,
+                          olp::http::HttpStatusCode::OK);
+  SetupNetworkExpectation(*network_mock, kUrlPrefetchBlobData2, kData2,
+                          olp::http::HttpStatusCode::OK);
+
+  EXPECT_CALL(*network_mock, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kHttpResponseLookup));
+
+  std::vector<olp::geo::TileKey> tile_keys = {
+      olp::geo::TileKey::FromHereTile(kRootTileId)};
+
+  auto request = read::PrefetchTilesRequest()
+                     .WithTileKeys(tile_keys)
+                     .WithMinLevel(8)
+                     .WithMaxLevel(12);
+
+  std::vector<olp::geo::TileKey> streamed_tiles;
+  auto promise = std::make_shared<std::promise<read::PrefetchTilesResponse>>();
+  std::future<read::PrefetchTilesResponse> future = promise->get_future();
+  auto token = client.PrefetchTiles(
+      request,
+      [promise](read::PrefetchTilesResponse response) {
+        promise->set_value(std::move(response));
+      },
+      [&](const read::PrefetchTileResult& tile_result) {
+        EXPECT_TRUE(tile_result.IsSuccessful());
+        streamed_tiles.push_back(tile_result.tile_key_);
+      });
+
+  ASSERT_NE(future.wait_for(kTimeout), std::future_status::timeout);
+  read::PrefetchTilesResponse response = future.get();
+  ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+
+  // The results are streamed instead of being kept until the end.
+  EXPECT_TRUE(response.GetResult().empty());
+  EXPECT_FALSE(streamed_tiles.empty());
+}
+
 TEST(VolatileLayerClientImplTest, PrefetchTilesCancelOnClientDestroy) {
   std::shared_ptr<NetworkMock> network_mock = std::make_shared<NetworkMock>();
   std::shared_ptr<CacheMock> cache_mock = std::make_shared<CacheMock>();
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <olp/dataservice/write/DataServiceWriteApi.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief The statistics of the data that a client compressed before the
+ * upload.
+ *
+ * The bytes saved by the compression are `uncompressed_bytes` minus
+ * `compressed_bytes`.
+ */
+struct DATASERVICE_WRITE_API CompressionStatistics {
+  /**
+   * @brief Number of the compressed data uploads.
+   */
+  uint64_t compressed_uploads{0u};
+
+  /**
+   * @brief Total size, in bytes, of the compressed data before the
+   * compression.
+   */
+  uint64_t uncompressed_bytes{0u};
+
+  /**
+   * @brief Total size, in bytes, of the compressed data.
+   */
+  uint64_t compressed_bytes{0u};
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
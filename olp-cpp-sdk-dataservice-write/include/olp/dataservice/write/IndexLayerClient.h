@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
@@ -27,6 +28,7 @@
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/porting/deprecated.h>
 #include <olp/dataservice/write/DataServiceWriteApi.h>
+#include <olp/dataservice/write/IndexLayerClientSettings.h>
 #include <olp/dataservice/write/generated/model/ResponseOkSingle.h>
 #include <olp/dataservice/write/model/DeleteIndexDataRequest.h>
 #include <olp/dataservice/write/model/PublishIndexRequest.h>
@@ -47,6 +49,12 @@ using PublishIndexResponse =
     client::ApiResponse<PublishIndexResult, client::ApiError>;
 using PublishIndexCallback = std::function<void(PublishIndexResponse response)>;
 
+using PublishIndexesResult = std::vector<model::ResponseOkSingle>;
+using PublishIndexesResponse =
+    client::ApiResponse<PublishIndexesResult, client::ApiError>;
+using PublishIndexesCallback =
+    std::function<void(PublishIndexesResponse response)>;
+
 using DeleteIndexDataResponse =
     client::ApiResponse<client::ApiNoResult, client::ApiError>;
 using DeleteIndexDataCallback =
@@ -72,6 +80,19 @@ class DATASERVICE_WRITE_API IndexLayerClient {
    */
   IndexLayerClient(client::HRN catalog, client::OlpClientSettings settings);
 
+  /**
+   * @brief Creates the `IndexLayerClient` instance.
+   * @param catalog The HRN that specifies the catalog to which this client
+   * writes.
+   * @param client_settings The `IndexLayerClient` settings used to control the
+   * bulk publishing of the indexes.
+   * @param settings Client settings used to control the behavior of the client
+   * instance.
+   */
+  IndexLayerClient(client::HRN catalog,
+                   IndexLayerClientSettings client_settings,
+                   client::OlpClientSettings settings);
+
   /**
    * @brief Cancels all the ongoing operations that this client started.
    *
@@ -106,6 +127,45 @@ class DATASERVICE_WRITE_API IndexLayerClient {
   olp::client::CancellationToken PublishIndex(
       model::PublishIndexRequest request, PublishIndexCallback callback);
 
+  /**
+   * @brief Publishes many indexes to index layers.
+   *
+   * The data blobs are uploaded in parallel, up to
+   * `IndexLayerClientSettings::parallel_uploads` at the same time. The index
+   * entries of each layer are sent to the index service in batches of
+   * `IndexLayerClientSettings::index_batch_size` entries instead of one
+   * request per index. The first error stops the publishing, the indexes sent
+   * before it stay published.
+   *
+   * @param requests PublishIndexRequest objects that represent the indexes
+   * to publish.
+   * @return CancellableFuture that contains the PublishIndexesResponse with
+   * the data handles of the indexes in the order of the requests.
+   */
+  olp::client::CancellableFuture<PublishIndexesResponse> PublishIndexes(
+      std::vector<model::PublishIndexRequest> requests);
+
+  /**
+   * @brief Publishes many indexes to index layers.
+   *
+   * The data blobs are uploaded in parallel, up to
+   * `IndexLayerClientSettings::parallel_uploads` at the same time. The index
+   * entries of each layer are sent to the index service in batches of
+   * `IndexLayerClientSettings::index_batch_size` entries instead of one
+   * request per index. The first error stops the publishing, the indexes sent
+   * before it stay published.
+   *
+   * @param requests PublishIndexRequest objects that represent the indexes
+   * to publish.
+   * @param callback PublishIndexesCallback that is called with the
+   * PublishIndexesResponse when the operation completes.
+   * @return CancellationToken that can be used to cancel the ongoing
+   * request.
+   */
+  olp::client::CancellationToken PublishIndexes(
+      std::vector<model::PublishIndexRequest> requests,
+      PublishIndexesCallback callback);
+
   /**
    * @brief Deletes a data blob that is stored under an index
    * layer.
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <olp/dataservice/write/DataServiceWriteApi.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief Settings for \c IndexLayerClient. Use this class to configure
+ * the behaviour of \c IndexLayerClient specific logic.
+ */
+struct DATASERVICE_WRITE_API IndexLayerClientSettings {
+  /**
+   * @brief The maximum number of the data blobs that \c PublishIndexes
+   * uploads at the same time. Must be positive.
+   */
+  size_t parallel_uploads = 8u;
+
+  /**
+   * @brief The number of the index entries of a layer after which
+   * \c PublishIndexes sends them to the index service in one request.
+   *
+   * The entries are sent as soon as the batch is full, while the remaining
+   * data blobs are still being uploaded. The entries left at the end are sent
+   * when all the uploads are done. Must be positive.
+   */
+  size_t index_batch_size = 1000u;
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -27,6 +27,7 @@
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/porting/deprecated.h>
+#include <olp/dataservice/write/CompressionStatistics.h>
 #include <olp/dataservice/write/DataServiceWriteApi.h>
 #include <olp/dataservice/write/StreamLayerClientSettings.h>
 #include <olp/dataservice/write/generated/model/ResponseOk.h>
@@ -86,6 +87,16 @@ class DATASERVICE_WRITE_API StreamLayerClient {
    */
   void CancelPendingRequests();
 
+  /**
+   * @brief Gets the statistics of the data that the client compressed before
+   * the upload.
+   *
+   * @see `StreamLayerClientSettings::compress_data`
+   *
+   * @return The compression statistics.
+   */
+  CompressionStatistics GetCompressionStatistics() const;
+
   /**
    * @brief Publishes data to a stream layer.
    * @note Content-Type for this request is implicitly based on the
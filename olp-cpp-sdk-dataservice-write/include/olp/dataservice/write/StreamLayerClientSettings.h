@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <limits>
 
@@ -37,6 +38,51 @@ struct DATASERVICE_WRITE_API StreamLayerClientSettings {
    * @brief The maximum number of requests that can be stored. Must be positive.
    */
   size_t maximum_requests = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief The maximum number of queued requests that \c Flush takes from the
+   * queue at once. Must be positive.
+   */
+  size_t flush_batch_size = 32u;
+
+  /**
+   * @brief The maximum total data size, in bytes, of the queued requests that
+   * \c Flush takes from the queue at once. A larger request is taken alone.
+   */
+  size_t flush_batch_bytes = 8u * 1024u * 1024u;
+
+  /**
+   * @brief The maximum number of queued requests that \c Flush publishes at
+   * the same time. Must be positive.
+   */
+  size_t flush_parallel_requests = 4u;
+
+  /**
+   * @brief The time that \c PublishData waits for more requests before it
+   * publishes the collected requests together. Zero disables the batching.
+   *
+   * The batching requires the task scheduler in the client settings, the
+   * callback of each request is still called with its own response.
+   */
+  std::chrono::milliseconds linger_ms = std::chrono::milliseconds(0);
+
+  /**
+   * @brief The total data size, in bytes, of the collected requests at which
+   * \c PublishData publishes them without waiting for \c linger_ms.
+   */
+  size_t batch_bytes = 1024u * 1024u;
+
+  /**
+   * @brief Compress the data with gzip before the upload.
+   *
+   * Only the data of the layers with the gzip content encoding is compressed,
+   * and only if it is not compressed already. The compression requires the
+   * SDK to be built with zlib.
+   *
+   * The data of the requests with a checksum is not compressed, as the
+   * checksum is verified against the uploaded data.
+   */
+  bool compress_data = false;
 };
 
 }  // namespace write
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
@@ -28,7 +29,9 @@
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/porting/deprecated.h>
 
+#include <olp/dataservice/write/CompressionStatistics.h>
 #include <olp/dataservice/write/DataServiceWriteApi.h>
+#include <olp/dataservice/write/VersionedLayerClientSettings.h>
 #include <olp/dataservice/write/generated/model/Publication.h>
 #include <olp/dataservice/write/generated/model/ResponseOk.h>
 #include <olp/dataservice/write/generated/model/ResponseOkSingle.h>
@@ -71,6 +74,12 @@ using PublishPartitionDataResponse =
 using PublishPartitionDataCallback =
     std::function<void(PublishPartitionDataResponse response)>;
 
+using PublishPartitionsDataResult = std::vector<model::ResponseOkSingle>;
+using PublishPartitionsDataResponse =
+    client::ApiResponse<PublishPartitionsDataResult, client::ApiError>;
+using PublishPartitionsDataCallback =
+    std::function<void(PublishPartitionsDataResponse response)>;
+
 using CheckDataExistsStatusCode = int;
 using CheckDataExistsResponse =
     client::ApiResponse<CheckDataExistsStatusCode, client::ApiError>;
@@ -92,6 +101,18 @@ class DATASERVICE_WRITE_API VersionedLayerClient {
    */
   VersionedLayerClient(client::HRN catalog, client::OlpClientSettings settings);
 
+  /**
+   * @brief VersionedLayerClient constructor
+   * @param catalog the catalog this versioned layer client uses
+   * @param client_settings \c VersionedLayerClient settings used to control
+   * the upload of the partition data
+   * @param settings Client settings used to control behaviour of the client
+   * instance
+   */
+  VersionedLayerClient(client::HRN catalog,
+                       VersionedLayerClientSettings client_settings,
+                       client::OlpClientSettings settings);
+
   /**
    * @brief Start a batch operation.
    * @param request details of the batch operation to start
@@ -183,6 +204,16 @@ class DATASERVICE_WRITE_API VersionedLayerClient {
    */
   void CancelPendingRequests();
 
+  /**
+   * @brief Gets the statistics of the data that the client compressed before
+   * the upload.
+   *
+   * @see `VersionedLayerClientSettings::compress_data`
+   *
+   * @return The compression statistics.
+   */
+  CompressionStatistics GetCompressionStatistics() const;
+
   /**
    * @brief Call to publish data into a versioned layer.
    * @note Content-type for this request will be set implicitly based on the
@@ -212,6 +243,49 @@ class DATASERVICE_WRITE_API VersionedLayerClient {
       const model::Publication& pub, model::PublishPartitionDataRequest request,
       PublishPartitionDataCallback callback);
 
+  /**
+   * @brief Call to publish the data of many partitions into a versioned
+   * layer.
+   *
+   * The data blobs are uploaded in parallel, then the partition metadata is
+   * uploaded in groups of at most `partitions_batch_size` partitions per
+   * layer, see \c VersionedLayerClientSettings. The operation fails with the
+   * first failed upload.
+   * @note Content-type for this request will be set implicitly based on the
+   * layer metadata for the target layer on the HERE platform.
+   * @param pub The publication to which the data is published.
+   * @param requests The requests of the partitions.
+   *
+   * @return A CancellableFuture containing the responses in the order of the
+   * requests.
+   */
+  olp::client::CancellableFuture<PublishPartitionsDataResponse> PublishToBatch(
+      const model::Publication& pub,
+      std::vector<model::PublishPartitionDataRequest> requests);
+
+  /**
+   * @brief Call to publish the data of many partitions into a versioned
+   * layer.
+   *
+   * The data blobs are uploaded in parallel, then the partition metadata is
+   * uploaded in groups of at most `partitions_batch_size` partitions per
+   * layer, see \c VersionedLayerClientSettings. The operation fails with the
+   * first failed upload.
+   * @note Content-type for this request will be set implicitly based on the
+   * layer metadata for the target layer on the HERE platform.
+   * @param pub The publication to which the data is published.
+   * @param requests The requests of the partitions.
+   * @param callback Called with the responses in the order of the requests
+   * when the operation completes.
+   *
+   * @return A CancellationToken which can be used to cancel the ongoing
+   * request.
+   */
+  olp::client::CancellationToken PublishToBatch(
+      const model::Publication& pub,
+      std::vector<model::PublishPartitionDataRequest> requests,
+      PublishPartitionsDataCallback callback);
+
   /**
    * @brief Check if a datahandle exits.
    * @param request details of the check data exists operation to start
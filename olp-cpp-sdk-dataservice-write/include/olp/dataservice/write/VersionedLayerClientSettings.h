@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <olp/dataservice/write/DataServiceWriteApi.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief Settings for \c VersionedLayerClient. Use this class to configure
+ * the behaviour of \c VersionedLayerClient specific logic.
+ */
+struct DATASERVICE_WRITE_API VersionedLayerClientSettings {
+  /**
+   * @brief The data size, in bytes, from which \c PublishToBatch uploads the
+   * data with a multipart upload instead of a single request.
+   *
+   * The parts are uploaded on the threads of the \c task_scheduler of the
+   * client settings and on the calling thread. If a part fails, the other
+   * parts are cancelled and the upload is aborted. The blob service
+   * recommends the multipart upload for the data larger than 50 MB.
+   * Set to 0, the default, to upload the data with a single request.
+   */
+  size_t multipart_threshold = 0u;
+
+  /**
+   * @brief The size, in bytes, of the parts of a multipart upload. The blob
+   * service requires at least 5 MB, smaller values are raised to it.
+   */
+  size_t multipart_part_size = 16u * 1024u * 1024u;
+
+  /**
+   * @brief The maximum number of the parts of a multipart upload that are
+   * uploaded at the same time. Must be positive.
+   */
+  size_t multipart_parallel_uploads = 4u;
+
+  /**
+   * @brief The number of times the upload of a part is retried after a
+   * retryable error, in addition to the retries of the network requests.
+   *
+   * The retries wait as the network requests do, using the
+   * \c backdown_strategy of the client retry settings.
+   */
+  size_t multipart_part_retries = 3u;
+
+  /**
+   * @brief The maximum number of the data blobs that the bulk
+   * \c PublishToBatch uploads at the same time. Must be positive.
+   */
+  size_t parallel_uploads = 8u;
+
+  /**
+   * @brief The maximum number of the partitions that the bulk
+   * \c PublishToBatch sends in one metadata upload request. Must be positive.
+   */
+  size_t partitions_batch_size = 1000u;
+
+  /**
+   * @brief Derive the data handles from the content of the data instead of
+   * generating random ones.
+   *
+   * The data handle is a name-based UUID (SHA-1) of the data, so identical
+   * data gets the same data handle. \c PublishToBatch checks whether the blob
+   * of the data handle already exists in the layer and uploads the data only
+   * when it does not.
+   */
+  bool content_addressed_data_handles = false;
+
+  /**
+   * @brief Compress the data with gzip before the upload.
+   *
+   * Only the data of the layers with the gzip content encoding is compressed,
+   * and only if it is not compressed already. The compression requires the
+   * SDK to be built with zlib.
+   *
+   * The content addressed data handles are derived from the data before the
+   * compression.
+   */
+  bool compress_data = false;
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -29,6 +29,7 @@
 #include <olp/core/porting/deprecated.h>
 
 #include <olp/dataservice/write/DataServiceWriteApi.h>
+#include <olp/dataservice/write/VolatileLayerClientSettings.h>
 #include <olp/dataservice/write/generated/model/Publication.h>
 #include <olp/dataservice/write/generated/model/ResponseOkSingle.h>
 #include <olp/dataservice/write/model/PublishPartitionDataRequest.h>
@@ -52,6 +53,12 @@ using PublishPartitionDataResponse =
 using PublishPartitionDataCallback =
     std::function<void(PublishPartitionDataResponse response)>;
 
+using PublishPartitionsDataResult = std::vector<model::ResponseOkSingle>;
+using PublishPartitionsDataResponse =
+    client::ApiResponse<PublishPartitionsDataResult, client::ApiError>;
+using PublishPartitionsDataCallback =
+    std::function<void(PublishPartitionsDataResponse response)>;
+
 using GetBaseVersionResult = model::VersionResponse;
 using GetBaseVersionResponse =
     client::ApiResponse<GetBaseVersionResult, client::ApiError>;
@@ -92,6 +99,18 @@ class DATASERVICE_WRITE_API VolatileLayerClient {
    */
   VolatileLayerClient(client::HRN catalog, client::OlpClientSettings settings);
 
+  /**
+   * @brief VolatileLayerClient Constructor.
+   * @param catalog The HRN specifying the catalog this client will write to.
+   * @param client_settings \c VolatileLayerClient settings used to control
+   * the bulk publishing of the partition data.
+   * @param settings Client settings used to control behaviour of the client
+   * instance. Volatile.
+   */
+  VolatileLayerClient(client::HRN catalog,
+                      VolatileLayerClientSettings client_settings,
+                      client::OlpClientSettings settings);
+
   /**
    * @brief Cancels all the ongoing operations that this client started.
    *
@@ -129,6 +148,52 @@ class DATASERVICE_WRITE_API VolatileLayerClient {
       model::PublishPartitionDataRequest request,
       PublishPartitionDataCallback callback);
 
+  /**
+   * @brief Call to publish the data of many partitions into volatile layers.
+   *
+   * Successive requests for the same layer and partition are coalesced, only
+   * the last one of them is published. The data handles are queried in groups
+   * of up to 100 partitions per layer, and the data blobs of a group are
+   * uploaded as soon as its data handles arrive, while the next groups are
+   * still being queried. The number of the requests sent at the same time is
+   * limited by \c VolatileLayerClientSettings::parallel_requests. The first
+   * error stops the publishing.
+   *
+   * @note The partition metadata has to exist on the HERE platform.
+   * @param requests The PublishPartitionDataRequest objects with the layer
+   * ID, the partition ID and the data of the partitions.
+   *
+   * @return A CancellableFuture containing the PublishPartitionsDataResponse
+   * with one result for each published partition.
+   */
+  olp::client::CancellableFuture<PublishPartitionsDataResponse>
+  PublishPartitionsData(
+      std::vector<model::PublishPartitionDataRequest> requests);
+
+  /**
+   * @brief Call to publish the data of many partitions into volatile layers.
+   *
+   * Successive requests for the same layer and partition are coalesced, only
+   * the last one of them is published. The data handles are queried in groups
+   * of up to 100 partitions per layer, and the data blobs of a group are
+   * uploaded as soon as its data handles arrive, while the next groups are
+   * still being queried. The number of the requests sent at the same time is
+   * limited by \c VolatileLayerClientSettings::parallel_requests. The first
+   * error stops the publishing.
+   *
+   * @note The partition metadata has to exist on the HERE platform.
+   * @param requests The PublishPartitionDataRequest objects with the layer
+   * ID, the partition ID and the data of the partitions.
+   * @param callback PublishPartitionsDataCallback which will be called with
+   * the PublishPartitionsDataResponse when the operation completes.
+   *
+   * @return A CancellationToken which can be used to cancel the ongoing
+   * request.
+   */
+  olp::client::CancellationToken PublishPartitionsData(
+      std::vector<model::PublishPartitionDataRequest> requests,
+      PublishPartitionsDataCallback callback);
+
   /**
    * @brief Get the latest version number of the catalog
    * @return future holding the response object
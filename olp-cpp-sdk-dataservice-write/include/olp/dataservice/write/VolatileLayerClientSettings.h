@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <olp/dataservice/write/DataServiceWriteApi.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief Settings for \c VolatileLayerClient. Use this class to configure
+ * the behaviour of \c VolatileLayerClient specific logic.
+ */
+struct DATASERVICE_WRITE_API VolatileLayerClientSettings {
+  /**
+   * @brief The maximum number of the requests that the bulk
+   * \c PublishPartitionsData sends at the same time. The metadata queries and
+   * the data blob uploads share this window. Must be positive.
+   */
+  size_t parallel_requests = 8u;
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
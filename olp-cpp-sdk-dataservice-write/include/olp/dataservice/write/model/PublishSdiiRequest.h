@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,6 +29,7 @@
 
 #include <boost/optional.hpp>
 
+#include <olp/core/http/NetworkRequest.h>
 #include <olp/dataservice/write/DataServiceWriteApi.h>
 
 namespace olp {
@@ -43,6 +47,13 @@ namespace model {
  */
 class DATASERVICE_WRITE_API PublishSdiiRequest {
  public:
+  /// Reads the SDII MessageList data into the network send buffer, see
+  /// `http::NetworkRequest::BodySourceCallback`.
+  using SdiiMessageListSource = http::NetworkRequest::BodySourceCallback;
+
+  /// Called once the SDK no longer reads the caller-owned data.
+  using ReleaseCallback = std::function<void()>;
+
   PublishSdiiRequest() = default;
 
   /**
@@ -61,6 +72,7 @@ class DATASERVICE_WRITE_API PublishSdiiRequest {
   inline PublishSdiiRequest& WithSdiiMessageList(
       const std::shared_ptr<std::vector<unsigned char>>& sdii_message_list) {
     sdii_message_list_ = sdii_message_list;
+    sdii_message_list_source_ = nullptr;
     return *this;
   }
 
@@ -72,9 +84,86 @@ class DATASERVICE_WRITE_API PublishSdiiRequest {
   inline PublishSdiiRequest& WithSdiiMessageList(
       std::shared_ptr<std::vector<unsigned char>>&& sdii_message_list) {
     sdii_message_list_ = std::move(sdii_message_list);
+    sdii_message_list_source_ = nullptr;
+    return *this;
+  }
+
+  /**
+   * @brief Sets the SDII MessageList data owned by the caller.
+   *
+   * The data is read directly from the caller's buffer when the request is
+   * sent, so it is neither copied into a vector nor into the request body.
+   * The buffer must not be modified or freed until `release` is called.
+   * `release` is called once, on the thread that drops the last copy of the
+   * request, which can be a network or task scheduler thread.
+   *
+   * Replaces the data set with `WithSdiiMessageList`.
+   *
+   * @param data The SDII MessageList data encoded in protobuf format.
+   * @param size The size of the data. The maximum size is 20 MB.
+   * @param release The callback that releases the data, or `nullptr`.
+   */
+  inline PublishSdiiRequest& WithSdiiMessageList(const unsigned char* data,
+                                                 std::size_t size,
+                                                 ReleaseCallback release) {
+    std::shared_ptr<const unsigned char> owner(
+        data, [release](const unsigned char*) {
+          if (release) {
+            release();
+          }
+        });
+
+    return WithSdiiMessageListSource(
+        [owner, size](std::uint64_t offset, std::uint8_t* buffer,
+                      std::size_t buffer_size) -> std::int64_t {
+          if (offset >= size) {
+            return 0;
+          }
+          const auto length = std::min<std::uint64_t>(size - offset,
+                                                      buffer_size);
+          std::copy(owner.get() + offset, owner.get() + offset + length,
+                    buffer);
+          return static_cast<std::int64_t>(length);
+        },
+        static_cast<std::int64_t>(size));
+  }
+
+  /**
+   * @brief Sets the callback that writes the SDII MessageList data directly
+   * into the network send buffer.
+   *
+   * The callback is called on the network thread and is called again from
+   * offset 0 if the request is retried. Replaces the data set with
+   * `WithSdiiMessageList`.
+   *
+   * @param source The callback that reads the SDII MessageList data.
+   * @param size The size of the data, or
+   * `http::NetworkRequest::kUnknownBodySize` if it is not known in advance.
+   */
+  inline PublishSdiiRequest& WithSdiiMessageListSource(
+      SdiiMessageListSource source,
+      std::int64_t size = http::NetworkRequest::kUnknownBodySize) {
+    sdii_message_list_.reset();
+    sdii_message_list_source_ = std::move(source);
+    sdii_message_list_size_ = size;
     return *this;
   }
 
+  /**
+   * @return The callback that reads the SDII MessageList data previously set,
+   * or `nullptr` if the data is set as a vector.
+   */
+  inline const SdiiMessageListSource& GetSdiiMessageListSource() const {
+    return sdii_message_list_source_;
+  }
+
+  /**
+   * @return The size of the data read by the SDII MessageList source.
+   */
+  inline std::int64_t GetSdiiMessageListSize() const {
+    return sdii_message_list_size_;
+  }
+
   /**
    * @return Layer ID previously set.
    */
@@ -198,6 +287,10 @@ class DATASERVICE_WRITE_API PublishSdiiRequest {
  private:
   std::shared_ptr<std::vector<unsigned char>> sdii_message_list_;
 
+  SdiiMessageListSource sdii_message_list_source_;
+
+  std::int64_t sdii_message_list_size_{http::NetworkRequest::kUnknownBodySize};
+
   std::string layer_id_;
 
   boost::optional<std::string> trace_id_;
@@ -19,15 +19,23 @@
 
 #include "AutoFlushController.h"
 
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <olp/core/logging/Log.h>
+#include <olp/core/thread/TaskScheduler.h>
 #include <olp/dataservice/write/StreamLayerClient.h>
-#include "BackgroundTaskCollection.h"
 #include "StreamLayerClientImpl.h"
-#include "TimeUtils.h"
 
 namespace olp {
 namespace dataservice {
 namespace write {
 
+namespace {
+constexpr auto kLogTag = "AutoFlushController";
+}  // namespace
+
 /**
  class DisabledAutoFlushControllerImpl
  To be used when auto-flush is disbled, prevents any automated flush events
@@ -52,6 +60,9 @@ class DisabledAutoFlushControllerImpl
 /**
  class EnabledAutoFlushControllerImpl
  To be used when auto-flush is enabled, implements the auto-flush mechanism.
+ The flushes are triggered by the queue size and by a single interval timer
+ on the client's task scheduler. At most one flush is in flight, the triggers
+ that arrive meanwhile are coalesced into one follow-up flush.
  */
 template <typename ClientImpl, typename FlushResponse>
 class EnabledAutoFlushControllerImpl
@@ -64,84 +75,58 @@ class EnabledAutoFlushControllerImpl
       std::shared_ptr<FlushEventListener<FlushResponse>> listener)
       : client_impl_(client_impl),
         flush_settings_(std::move(flush_settings)),
-        listener_(listener),
-        background_task_col_(),
-        cancel_mutex_(),
-        cancel_token_map_(),
-        is_cancelled_(false) {}
+        listener_(listener) {}
 
-  ~EnabledAutoFlushControllerImpl() override {
-    Cancel();
-    const auto kDestructTimeout{std::chrono::milliseconds(180000)};
-    WaitForBackgroundTaskCompletion(kDestructTimeout);
-  }
+  ~EnabledAutoFlushControllerImpl() override { Cancel(); }
 
   void Enable() override {
-    InitialiseAutoFlushPeriodic();
+    InitialiseAutoFlushInterval();
     AutoFlushNumEvents();
   }
 
   std::future<void> Disable() override {
     Cancel();
-    return WaitForBackgroundTaskCompletionAsync();
-  }
-
-  void NotifyQueueEventStart() override { HandleNotifyQueueEventStart(); }
 
-  void NotifyQueueEventComplete() override { HandleNotifyQueueEventComplete(); }
-
-  void NotifyFlushEvent() override { HandleNotifyFlushEvent(); }
-
-  void AddCancelToken(size_t id,
-                      const olp::client::CancellationToken& cancel_token) {
-    std::lock_guard<std::mutex> lock(cancel_mutex_);
-    cancel_token_map_.insert(
-        std::pair<size_t, olp::client::CancellationToken>(id, cancel_token));
+    // Resolved when the flush in flight completes
+    std::promise<void> promise;
+    auto future = promise.get_future();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (flush_in_flight_) {
+      idle_promises_.push_back(std::move(promise));
+    } else {
+      promise.set_value();
+    }
+    return future;
   }
 
-  void RemoveCancelToken(size_t id) {
-    std::lock_guard<std::mutex> lock(cancel_mutex_);
-    cancel_token_map_.erase(id);
-  }
+  void NotifyQueueEventStart() override {}
 
-  bool IsCancelled() {
-    std::lock_guard<std::mutex> lock(cancel_mutex_);
-    return is_cancelled_;
-  }
+  void NotifyQueueEventComplete() override { AutoFlushNumEvents(); }
+
+  void NotifyFlushEvent() override {}
 
  private:
   void AutoFlushNumEvents() {
     if (IsAutoFlushNumEventsRequired()) {
-      AddBackgroundFlushTask();
+      RequestFlush();
     }
   }
 
   bool IsAutoFlushNumEventsRequired() {
     auto impl_pointer = client_impl_.lock();
-    if (impl_pointer) {
-      return impl_pointer->QueueSize() >= flush_settings_.auto_flush_num_events;
+    if (impl_pointer && flush_settings_.auto_flush_num_events > 0) {
+      return impl_pointer->QueueSize() >=
+             static_cast<size_t>(flush_settings_.auto_flush_num_events);
     }
     return false;
   }
 
   void InitialiseAutoFlushInterval() {
     if (flush_settings_.auto_flush_interval > 0) {
-      TriggerAutoFlushInterval();
+      ScheduleAutoFlushInterval();
     }
   }
 
-  void InitialiseAutoFlushPeriodic() { InitialiseAutoFlushInterval(); }
-
-  void HandleNotifyFlushEvent() {
-    // No-op
-  }
-
-  void HandleNotifyQueueEventStart() {
-    // No-op
-  }
-
-  void HandleNotifyQueueEventComplete() { AutoFlushNumEvents(); }
-
   void NotifyFlushEventStart() const {
     if (listener_) listener_->NotifyFlushEventStarted();
   }
@@ -151,84 +136,136 @@ class EnabledAutoFlushControllerImpl
   }
 
   void Cancel() {
-    std::lock_guard<std::mutex> lock(cancel_mutex_);
-    for (auto& pair : cancel_token_map_) {
-      pair.second.Cancel();
+    client::CancellationToken flush_token;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cancelled_ = true;
+      flush_pending_ = false;
+      flush_token = flush_token_;
+      interval_context_.CancelOperation();
     }
-    is_cancelled_ = true;
+    flush_token.Cancel();
   }
 
-  bool AddBackgroundFlushTask() {
+  /// Starts a flush, or marks one as pending when a flush is in flight.
+  void RequestFlush() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (cancelled_) {
+        return;
+      }
+      if (flush_in_flight_) {
+        flush_pending_ = true;
+        return;
+      }
+      flush_in_flight_ = true;
+    }
+    StartFlush();
+  }
+
+  void StartFlush() {
     auto impl_pointer = client_impl_.lock();
     if (!impl_pointer) {
-      return false;
+      OnFlushCompleted();
+      return;
+    }
+
+    uint64_t flush_id = 0u;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flush_id = ++flush_id_;
     }
 
     auto self = this->shared_from_this();
     NotifyFlushEventStart();
-    auto flush_thread = std::thread([self, impl_pointer]() {
-      auto id = self->background_task_col_.AddTask();
-
-      const auto num_requests_to_flush =
-          self->flush_settings_.events_per_single_flush;
-      model::FlushRequest request =
-          model::FlushRequest().WithNumberOfRequestsToFlush(
-              num_requests_to_flush);
-      auto cancel_token = impl_pointer->Flush(
-          std::move(request), [self, id](FlushResponse results) {
-            self->background_task_col_.ReleaseTask(id);
-            self->RemoveCancelToken(id);
-            self->NotifyFlushEventResults(results);
-          });
-      self->AddCancelToken(id, cancel_token);
-    });
-    flush_thread.detach();
-    return true;
+    auto request = model::FlushRequest().WithNumberOfRequestsToFlush(
+        flush_settings_.events_per_single_flush);
+    auto flush_token = impl_pointer->Flush(
+        std::move(request), [self](FlushResponse results) {
+          self->NotifyFlushEventResults(results);
+          self->OnFlushCompleted();
+        });
+
+    // The flush may complete before it returns when there is no scheduler
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (flush_in_flight_ && flush_id_ == flush_id) {
+      flush_token_ = flush_token;
+    }
   }
 
-  void TriggerAutoFlushInterval() {
-    auto self = this->shared_from_this();
-    auto seconds = std::chrono::seconds(flush_settings_.auto_flush_interval);
-    auto auto_flush_interval_thread = std::thread([self, seconds]() {
-      std::this_thread::sleep_for(seconds);
-      if (self->IsCancelled()) {
-        return;
+  void OnFlushCompleted() {
+    // The queue may have grown over the limit during the flush
+    const bool flush_required = IsAutoFlushNumEventsRequired();
+
+    bool start_next = false;
+    std::vector<std::promise<void>> idle_promises;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flush_token_ = client::CancellationToken();
+      start_next = !cancelled_ && (flush_pending_ || flush_required);
+      flush_pending_ = false;
+      if (!start_next) {
+        flush_in_flight_ = false;
+        idle_promises.swap(idle_promises_);
       }
+    }
 
-      if (self->AddBackgroundFlushTask()) {
-        self->TriggerAutoFlushInterval();
-      }
-    });
-    auto_flush_interval_thread.detach();
-  }
+    for (auto& promise : idle_promises) {
+      promise.set_value();
+    }
 
-  void WaitForBackgroundTaskCompletion() {
-    background_task_col_.WaitForBackgroundTaskCompletion();
+    if (start_next) {
+      StartFlush();
+    }
   }
 
-  template <typename T>
-  void WaitForBackgroundTaskCompletion(const T& timeout) {
-    background_task_col_.WaitForBackgroundTaskCompletion(timeout);
-  }
+  void ScheduleAutoFlushInterval() {
+    auto impl_pointer = client_impl_.lock();
+    auto task_scheduler =
+        impl_pointer ? impl_pointer->GetTaskScheduler() : nullptr;
+    if (!task_scheduler) {
+      OLP_SDK_LOG_WARNING(kLogTag,
+                          "Interval based auto-flush requires a task "
+                          "scheduler, the interval is ignored");
+      return;
+    }
 
-  std::future<void> WaitForBackgroundTaskCompletionAsync() {
-    auto self = this->shared_from_this();
-    auto ret = std::make_shared<std::promise<void>>();
-    std::thread([self, ret]() {
-      self->WaitForBackgroundTaskCompletion();
-      ret->set_value();
-    }).detach();
-    return ret->get_future();
+    // The interval is waited on the scheduler timer, and the pending timer
+    // does not keep the controller alive.
+    std::weak_ptr<EnabledAutoFlushControllerImpl> weak_self =
+        this->shared_from_this();
+    auto context = task_scheduler->ScheduleTaskAfter(
+        [weak_self](const client::CancellationContext&) {
+          auto self = weak_self.lock();
+          if (!self) {
+            return;
+          }
+
+          self->RequestFlush();
+          self->ScheduleAutoFlushInterval();
+        },
+        std::chrono::seconds(flush_settings_.auto_flush_interval));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cancelled_) {
+      context.CancelOperation();
+    }
+    interval_context_ = context;
   }
 
  private:
   std::weak_ptr<ClientImpl> client_impl_;
   AutoFlushSettings flush_settings_;
   std::shared_ptr<FlushEventListener<FlushResponse>> listener_;
-  BackgroundTaskCollection<size_t> background_task_col_;
-  std::mutex cancel_mutex_;
-  std::map<size_t, olp::client::CancellationToken> cancel_token_map_;
-  bool is_cancelled_{false};
+
+  std::mutex mutex_;
+  bool cancelled_{false};
+  bool flush_in_flight_{false};
+  bool flush_pending_{false};
+  uint64_t flush_id_{0u};
+  client::CancellationToken flush_token_;
+  client::CancellationContext interval_context_;
+  std::vector<std::promise<void>> idle_promises_;
 };
 
 AutoFlushController::AutoFlushController(
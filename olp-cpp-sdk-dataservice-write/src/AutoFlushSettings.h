@@ -32,6 +32,7 @@ struct AutoFlushSettings {
   /**
    * The period (in seconds) between sequential auto flush events when using
    * interval based auto-flush. Setting 0 indicates this feature is disabled.
+   * The interval requires the task scheduler of the client.
    */
   int auto_flush_interval = 0;
 
@@ -21,6 +21,7 @@
 
 #include <olp/core/client/CancellationToken.h>
 #include <olp/core/client/PendingRequests.h>
+#include <olp/core/thread/TaskComponentScope.h>
 #include <olp/core/thread/TaskScheduler.h>
 
 namespace olp {
@@ -57,6 +58,7 @@ inline client::CancellationToken AddTask(
     // User didn't specify a TaskScheduler, execute sync
     scheduler_func();
   } else {
+    thread::TaskComponentScope component_scope("PendingRequests");
     task_scheduler->ScheduleTask(std::move(scheduler_func));
   }
 
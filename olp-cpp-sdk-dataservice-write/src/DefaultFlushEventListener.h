@@ -20,8 +20,12 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include "FlushEventListener.h"
@@ -53,22 +57,129 @@ class DefaultFlushEventListener : public FlushEventListener<FlushResponse> {
 
   void NotifyFlushMetricsHasChanged(FlushMetrics metrics) override{};
 
+  void NotifyRequestFlushed(const std::string& layer_id, size_t bytes,
+                            std::chrono::milliseconds latency,
+                            bool successful) override {
+    FlushMetrics metrics;
+    {
+      std::lock_guard<std::mutex> locker(mutex_);
+      const auto now = Clock::now();
+      if (successful) {
+        metrics_.num_flushed_bytes += bytes;
+        layer_samples_[layer_id].push_back(ThroughputSample{now, bytes});
+      }
+
+      if (latencies_.size() < kMaxLatencySamples) {
+        latencies_.push_back(latency);
+      } else {
+        latencies_[next_latency_] = latency;
+      }
+      next_latency_ = (next_latency_ + 1u) % kMaxLatencySamples;
+
+      UpdateThroughput(now);
+      UpdateLatencyPercentiles();
+      metrics = metrics_;
+    }
+    NotifyFlushMetricsHasChanged(std::move(metrics));
+  }
+
+  void NotifyRequestsRequeued(size_t count) override {
+    FlushMetrics metrics;
+    {
+      std::lock_guard<std::mutex> locker(mutex_);
+      metrics_.num_requeued_requests += count;
+      metrics = metrics_;
+    }
+    NotifyFlushMetricsHasChanged(std::move(metrics));
+  }
+
+  void NotifyQueueChanged(
+      size_t queue_size,
+      std::chrono::milliseconds oldest_request_age) override {
+    FlushMetrics metrics;
+    {
+      std::lock_guard<std::mutex> locker(mutex_);
+      metrics_.queue_size = queue_size;
+      metrics_.oldest_queued_request_age = oldest_request_age;
+      UpdateThroughput(Clock::now());
+      metrics = metrics_;
+    }
+    NotifyFlushMetricsHasChanged(std::move(metrics));
+  }
+
  protected:
   template <typename T>
   bool CollateFlushEventResults(const std::vector<T>& results) {
     metrics_.num_total_flushed_requests += results.size();
 
-    thread_local size_t flush_requests_failed =
+    const size_t flush_requests_failed =
         std::count_if(std::begin(results), std::end(results),
                       [](T result) -> bool { return !result.IsSuccessful(); });
     metrics_.num_failed_flushed_requests += flush_requests_failed;
     return flush_requests_failed > 0ull;
   }
 
+  using Clock = std::chrono::steady_clock;
+
+  struct ThroughputSample {
+    Clock::time_point time;
+    size_t bytes;
+  };
+
+  /// The throughput is measured over this window.
+  static constexpr std::chrono::seconds kThroughputWindow{60};
+  /// The percentiles are computed over this many latest uploads.
+  static constexpr size_t kMaxLatencySamples = 1024u;
+
+  void UpdateThroughput(Clock::time_point now) {
+    const double window_seconds =
+        std::chrono::duration<double>(kThroughputWindow).count();
+    for (auto& layer : layer_samples_) {
+      auto& samples = layer.second;
+      while (!samples.empty() &&
+             now - samples.front().time > kThroughputWindow) {
+        samples.pop_front();
+      }
+
+      size_t bytes = 0u;
+      for (const auto& sample : samples) {
+        bytes += sample.bytes;
+      }
+
+      auto& layer_metrics = metrics_.layers[layer.first];
+      layer_metrics.bytes_per_second = bytes / window_seconds;
+      layer_metrics.messages_per_second = samples.size() / window_seconds;
+    }
+  }
+
+  void UpdateLatencyPercentiles() {
+    auto latencies = latencies_;
+    auto percentile = [&](size_t percent) {
+      const auto index =
+          std::min(latencies.size() * percent / 100u, latencies.size() - 1u);
+      std::nth_element(latencies.begin(), latencies.begin() + index,
+                       latencies.end());
+      return latencies[index];
+    };
+    metrics_.upload_latency_p50 = percentile(50u);
+    metrics_.upload_latency_p90 = percentile(90u);
+    metrics_.upload_latency_p99 = percentile(99u);
+  }
+
   mutable std::mutex mutex_;
   FlushMetrics metrics_;
+  std::map<std::string, std::deque<ThroughputSample>> layer_samples_;
+  std::vector<std::chrono::milliseconds> latencies_;
+  size_t next_latency_{0u};
 };
 
+template <typename FlushResponse>
+constexpr std::chrono::seconds
+    DefaultFlushEventListener<FlushResponse>::kThroughputWindow;
+
+template <typename FlushResponse>
+constexpr size_t DefaultFlushEventListener<FlushResponse>::kMaxLatencySamples;
+
 }  // namespace write
 }  // namespace dataservice
 }  // namespace olp
@@ -19,6 +19,10 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <string>
+
 #include "FlushMetrics.h"
 
 namespace olp {
@@ -53,6 +57,38 @@ class FlushEventListener {
    * @param metrics Collected \c FlushMetrics.
    */
   virtual void NotifyFlushMetricsHasChanged(FlushMetrics metrics) = 0;
+
+  /**
+   * Notifies the listener that a request of a flush was uploaded.
+   *
+   * @param layer_id The ID of the layer of the request.
+   * @param bytes The size of the request data.
+   * @param latency The time that the upload took.
+   * @param successful Whether the upload succeeded.
+   */
+  virtual void NotifyRequestFlushed(const std::string& /*layer_id*/,
+                                    size_t /*bytes*/,
+                                    std::chrono::milliseconds /*latency*/,
+                                    bool /*successful*/) {}
+
+  /**
+   * Notifies the listener that requests were queued back because their flush
+   * was cancelled.
+   *
+   * @param count The number of the requests queued back.
+   */
+  virtual void NotifyRequestsRequeued(size_t /*count*/) {}
+
+  /**
+   * Notifies the listener that the queue of the requests has changed.
+   *
+   * @param queue_size The number of the requests in the queue.
+   * @param oldest_request_age How long the oldest request has been waiting
+   * in the queue.
+   */
+  virtual void NotifyQueueChanged(
+      size_t /*queue_size*/,
+      std::chrono::milliseconds /*oldest_request_age*/) {}
 };
 
 }  // namespace write
@@ -19,12 +19,31 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
+#include <map>
+#include <string>
 
 namespace olp {
 namespace dataservice {
 namespace write {
 
+/**
+ * @brief The throughput of the flushed requests of a layer, measured over the
+ * last minute.
+ */
+struct LayerFlushMetrics {
+  /**
+   * @brief Number of the data bytes flushed per second.
+   */
+  double bytes_per_second{0.0};
+
+  /**
+   * @brief Number of the requests flushed per second.
+   */
+  double messages_per_second{0.0};
+};
+
 /**
  * @brief Struct which gather the metrics of Flush events and requests queued
  * by \c StreamLayerClient.
@@ -33,28 +52,72 @@ struct FlushMetrics {
   /**
   * @brief Number of attempted flush events.
   */
-  size_t num_attempted_flush_events;
+  size_t num_attempted_flush_events{0u};
 
   /**
    * @brief Number of failed flush events
    */
-  size_t num_failed_flush_events;
+  size_t num_failed_flush_events{0u};
 
   /**
    * @brief Total number of flush events.
    */
-  size_t num_total_flush_events;
+  size_t num_total_flush_events{0u};
 
   /**
    * @brief Total number of requests queued to \c StreamLayerClient.
    */
-  size_t num_total_flushed_requests;
+  size_t num_total_flushed_requests{0u};
 
   /**
    * @brief Number of failed requests, which were queued to \c
    * StreamLayerClient.
    */
-  size_t num_failed_flushed_requests;
+  size_t num_failed_flushed_requests{0u};
+
+  /**
+   * @brief Total number of the data bytes of the successfully flushed
+   * requests.
+   */
+  size_t num_flushed_bytes{0u};
+
+  /**
+   * @brief Number of requests that were queued back after a cancelled flush
+   * and are sent again by a later flush.
+   */
+  size_t num_requeued_requests{0u};
+
+  /**
+   * @brief Number of requests waiting in the queue.
+   */
+  size_t queue_size{0u};
+
+  /**
+   * @brief How long the oldest request has been waiting in the queue.
+   */
+  std::chrono::milliseconds oldest_queued_request_age{0};
+
+  /**
+   * @brief The median upload latency of the recently flushed requests.
+   */
+  std::chrono::milliseconds upload_latency_p50{0};
+
+  /**
+   * @brief The 90th percentile of the upload latency of the recently flushed
+   * requests.
+   */
+  std::chrono::milliseconds upload_latency_p90{0};
+
+  /**
+   * @brief The 99th percentile of the upload latency of the recently flushed
+   * requests.
+   */
+  std::chrono::milliseconds upload_latency_p99{0};
+
+  /**
+   * @brief The throughput of each layer, by layer ID.
+   */
+  std::map<std::string, LayerFlushMetrics> layers;
 };
 
 }  // namespace write
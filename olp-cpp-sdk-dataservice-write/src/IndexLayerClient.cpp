@@ -28,6 +28,12 @@ IndexLayerClient::IndexLayerClient(client::HRN catalog,
                                    client::OlpClientSettings settings)
     : impl_(std::make_shared<IndexLayerClientImpl>(catalog, settings)) {}
 
+IndexLayerClient::IndexLayerClient(client::HRN catalog,
+                                   IndexLayerClientSettings client_settings,
+                                   client::OlpClientSettings settings)
+    : impl_(std::make_shared<IndexLayerClientImpl>(
+          catalog, std::move(client_settings), settings)) {}
+
 void IndexLayerClient::CancelPendingRequests() {
   impl_->CancelPendingRequests();
 }
@@ -42,6 +48,18 @@ olp::client::CancellationToken IndexLayerClient::PublishIndex(
   return impl_->PublishIndex(request, callback);
 }
 
+olp::client::CancellableFuture<PublishIndexesResponse>
+IndexLayerClient::PublishIndexes(
+    std::vector<model::PublishIndexRequest> requests) {
+  return impl_->PublishIndexes(std::move(requests));
+}
+
+olp::client::CancellationToken IndexLayerClient::PublishIndexes(
+    std::vector<model::PublishIndexRequest> requests,
+    PublishIndexesCallback callback) {
+  return impl_->PublishIndexes(std::move(requests), std::move(callback));
+}
+
 olp::client::CancellationToken IndexLayerClient::DeleteIndexData(
     model::DeleteIndexDataRequest request, DeleteIndexDataCallback callback) {
   return impl_->DeleteIndexData(request, callback);
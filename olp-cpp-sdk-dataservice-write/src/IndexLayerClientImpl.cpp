@@ -32,7 +32,11 @@
 #include "generated/ConfigApi.h"
 #include "generated/IndexApi.h"
 
+#include <algorithm>
 #include <atomic>
+#include <map>
+#include <thread>
+#include <utility>
 
 namespace {
 std::string GenerateUuid() {
@@ -47,9 +51,16 @@ namespace write {
 
 IndexLayerClientImpl::IndexLayerClientImpl(client::HRN catalog,
                                            client::OlpClientSettings settings)
+    : IndexLayerClientImpl(std::move(catalog), IndexLayerClientSettings{},
+                           std::move(settings)) {}
+
+IndexLayerClientImpl::IndexLayerClientImpl(
+    client::HRN catalog, IndexLayerClientSettings client_settings,
+    client::OlpClientSettings settings)
     : catalog_(catalog),
       catalog_settings_(catalog, settings),
       settings_(settings),
+      client_settings_(std::move(client_settings)),
       apiclient_config_(nullptr),
       apiclient_blob_(nullptr),
       apiclient_index_(nullptr),
@@ -211,6 +222,203 @@ client::CancellationToken IndexLayerClientImpl::PublishIndex(
                  std::move(publish_task), std::move(callback));
 }
 
+client::CancellableFuture<PublishIndexesResponse>
+IndexLayerClientImpl::PublishIndexes(
+    std::vector<model::PublishIndexRequest> requests) {
+  auto promise = std::make_shared<std::promise<PublishIndexesResponse> >();
+  auto cancel_token = PublishIndexes(
+      std::move(requests), [promise](PublishIndexesResponse response) {
+        promise->set_value(std::move(response));
+      });
+  return client::CancellableFuture<PublishIndexesResponse>(cancel_token,
+                                                           promise);
+}
+
+client::CancellationToken IndexLayerClientImpl::PublishIndexes(
+    std::vector<model::PublishIndexRequest> requests,
+    PublishIndexesCallback callback) {
+  auto publish_task =
+      [=](client::CancellationContext context) -> PublishIndexesResponse {
+    for (const auto& request : requests) {
+      if (!request.GetData()) {
+        return client::ApiError(client::ErrorCode::InvalidArgument,
+                                "Request data empty.");
+      }
+
+      if (request.GetLayerId().empty()) {
+        return client::ApiError(client::ErrorCode::InvalidArgument,
+                                "Request layer Id empty.");
+      }
+    }
+
+    if (requests.empty()) {
+      return PublishIndexesResult{};
+    }
+
+    auto blob_api_response = ApiClientLookup::LookupApiClient(
+        catalog_, context, "blob", "v1", settings_);
+    if (!blob_api_response.IsSuccessful()) {
+      return blob_api_response.GetError();
+    }
+    const auto blob_client = blob_api_response.MoveResult();
+
+    auto index_api_response = ApiClientLookup::LookupApiClient(
+        catalog_, context, "index", "v1", settings_);
+    if (!index_api_response.IsSuccessful()) {
+      return index_api_response.GetError();
+    }
+    const auto index_client = index_api_response.MoveResult();
+
+    std::map<std::string, CatalogSettings::LayerSettings> layers_settings;
+    std::vector<std::string> data_handles;
+    data_handles.reserve(requests.size());
+    for (const auto& request : requests) {
+      data_handles.push_back(GenerateUuid());
+
+      const auto& layer_id = request.GetLayerId();
+      if (layers_settings.count(layer_id) != 0u) {
+        continue;
+      }
+
+      auto layer_settings_response = catalog_settings_.GetLayerSettings(
+          context, request.GetBillingTag(), layer_id);
+      if (!layer_settings_response.IsSuccessful()) {
+        return layer_settings_response.GetError();
+      }
+      if (layer_settings_response.GetResult().content_type.empty()) {
+        auto errmsg = boost::format(
+                          "Unable to find the Layer ID (%1%) "
+                          "provided in the PublishIndexRequest in the "
+                          "Catalog specified when creating "
+                          "this IndexLayerClient instance.") %
+                      layer_id;
+        return client::ApiError(client::ErrorCode::InvalidArgument,
+                                errmsg.str());
+      }
+      layers_settings[layer_id] = layer_settings_response.MoveResult();
+    }
+
+    // The uploads use the first contexts, the index batches sent by the
+    // workers the remaining ones, by the request that filled the batch
+    std::vector<client::CancellationContext> contexts(2u * requests.size());
+    const bool started = context.ExecuteOrCancelled([&]() {
+      return client::CancellationToken([contexts]() mutable {
+        for (auto& request_context : contexts) {
+          request_context.CancelOperation();
+        }
+      });
+    });
+    if (!started) {
+      return {{client::ErrorCode::Cancelled, "Operation cancelled."}};
+    }
+
+    // The index entries are batched per layer and billing tag
+    using BatchKey = std::pair<std::string, boost::optional<std::string> >;
+    std::map<BatchKey, std::vector<model::Index> > batches;
+    const auto batch_size =
+        std::max<size_t>(client_settings_.index_batch_size, 1u);
+
+    std::mutex mutex;
+    boost::optional<client::ApiError> error;
+    std::atomic<size_t> next_request{0u};
+    auto publish = [&]() {
+      for (auto index = next_request++; index < requests.size();
+           index = next_request++) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (error) {
+            return;
+          }
+        }
+
+        const auto& request = requests[index];
+        const auto& layer_settings = layers_settings.at(request.GetLayerId());
+        auto blob_response = BlobApi::PutBlob(
+            blob_client, request.GetLayerId(), layer_settings.content_type,
+            layer_settings.content_encoding, data_handles[index],
+            request.GetData(), request.GetBillingTag(), contexts[index]);
+
+        std::vector<model::Index> full_batch;
+        if (blob_response.IsSuccessful()) {
+          auto entry = request.GetIndex();
+          entry.SetId(data_handles[index]);
+
+          std::lock_guard<std::mutex> lock(mutex);
+          auto& batch = batches[BatchKey(request.GetLayerId(),
+                                         request.GetBillingTag())];
+          batch.push_back(std::move(entry));
+          if (batch.size() >= batch_size) {
+            full_batch.swap(batch);
+          }
+        } else {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error) {
+            error = blob_response.GetError();
+          }
+          return;
+        }
+
+        if (full_batch.empty()) {
+          continue;
+        }
+
+        auto insert_response = IndexApi::InsertIndexes(
+            index_client, full_batch, request.GetLayerId(),
+            request.GetBillingTag(), contexts[requests.size() + index]);
+        if (!insert_response.IsSuccessful()) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error) {
+            error = insert_response.GetError();
+          }
+          return;
+        }
+      }
+    };
+
+    std::vector<std::thread> workers;
+    const auto workers_count =
+        std::min(std::max<size_t>(client_settings_.parallel_uploads, 1u),
+                 requests.size());
+    for (size_t worker = 1u; worker < workers_count; ++worker) {
+      workers.emplace_back(publish);
+    }
+    publish();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    if (error) {
+      return *error;
+    }
+
+    // Send the entries of the batches that did not fill up
+    for (const auto& batch : batches) {
+      if (batch.second.empty()) {
+        continue;
+      }
+
+      auto insert_response =
+          IndexApi::InsertIndexes(index_client, batch.second, batch.first.first,
+                                  batch.first.second, context);
+      if (!insert_response.IsSuccessful()) {
+        return insert_response.GetError();
+      }
+    }
+
+    PublishIndexesResult result;
+    result.reserve(data_handles.size());
+    for (const auto& data_handle : data_handles) {
+      model::ResponseOkSingle response;
+      response.SetTraceID(data_handle);
+      result.push_back(std::move(response));
+    }
+    return result;
+  };
+
+  return AddTask(settings_.task_scheduler, pending_requests_,
+                 std::move(publish_task), std::move(callback));
+}
+
 client::CancellableFuture<DeleteIndexDataResponse>
 IndexLayerClientImpl::DeleteIndexData(
     const model::DeleteIndexDataRequest& request) {
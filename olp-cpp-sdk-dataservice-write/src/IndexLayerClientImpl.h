@@ -50,6 +50,10 @@ class IndexLayerClientImpl
  public:
   IndexLayerClientImpl(client::HRN catalog, client::OlpClientSettings settings);
 
+  IndexLayerClientImpl(client::HRN catalog,
+                       IndexLayerClientSettings client_settings,
+                       client::OlpClientSettings settings);
+
   virtual ~IndexLayerClientImpl();
 
   void CancelAll();
@@ -62,6 +66,13 @@ class IndexLayerClientImpl
   olp::client::CancellationToken PublishIndex(
       model::PublishIndexRequest request, const PublishIndexCallback& callback);
 
+  olp::client::CancellableFuture<PublishIndexesResponse> PublishIndexes(
+      std::vector<model::PublishIndexRequest> requests);
+
+  olp::client::CancellationToken PublishIndexes(
+      std::vector<model::PublishIndexRequest> requests,
+      PublishIndexesCallback callback);
+
   olp::client::CancellationToken DeleteIndexData(
       const model::DeleteIndexDataRequest& request,
       const DeleteIndexDataCallback& callback);
@@ -86,6 +97,7 @@ class IndexLayerClientImpl
   CatalogSettings catalog_settings_;
 
   client::OlpClientSettings settings_;
+  IndexLayerClientSettings client_settings_;
 
   std::shared_ptr<client::OlpClient> apiclient_config_;
   std::shared_ptr<client::OlpClient> apiclient_blob_;
@@ -43,6 +43,10 @@ void StreamLayerClient::CancelPendingRequests() {
   impl_->CancelPendingRequests();
 }
 
+CompressionStatistics StreamLayerClient::GetCompressionStatistics() const {
+  return impl_->GetCompressionStatistics();
+}
+
 olp::client::CancellableFuture<PublishDataResponse>
 StreamLayerClient::PublishData(model::PublishDataRequest request) {
   return impl_->PublishData(request);
@@ -19,11 +19,19 @@
 
 #include "StreamLayerClientImpl.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
 #include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/OlpClient.h>
 #include <olp/core/client/PendingRequests.h>
@@ -57,6 +65,7 @@ namespace write {
 namespace {
 constexpr auto kLogTag = "StreamLayerClientImpl";
 constexpr int64_t kTwentyMib = 20971520;  // 20 MiB
+constexpr auto kStreamQueuePostfix = "-stream-queue";
 
 void ExecuteOrSchedule(const std::shared_ptr<thread::TaskScheduler>& scheduler,
                        thread::TaskScheduler::CallFuncType&& func) {
@@ -79,11 +88,27 @@ StreamLayerClientImpl::StreamLayerClientImpl(
       catalog_settings_(catalog, settings),
       cache_(settings_.cache),
       cache_mutex_(),
+      uuid_list_migrated_(false),
       stream_client_settings_(std::move(client_settings)),
+      compressor_(stream_client_settings_.compress_data),
       pending_requests_(std::make_shared<client::PendingRequests>()),
-      task_scheduler_(std::move(settings_.task_scheduler)) {}
+      task_scheduler_(std::move(settings_.task_scheduler)),
+      linger_batch_(std::make_shared<LingerBatch>()),
+      created_at_(Clock::now()) {}
 
 StreamLayerClientImpl::~StreamLayerClientImpl() {
+  std::vector<LingerRequest> lingering;
+  {
+    std::lock_guard<std::mutex> lock(linger_batch_->mutex);
+    linger_batch_->closed = true;
+    lingering.swap(linger_batch_->requests);
+  }
+
+  for (auto& lingering_request : lingering) {
+    lingering_request.callback(PublishDataResponse(client::ApiError(
+        client::ErrorCode::Cancelled, "Operation cancelled.")));
+  }
+
   pending_requests_->CancelAllAndWait();
 }
 
@@ -99,18 +124,122 @@ std::string StreamLayerClientImpl::GetUuidListKey() const {
   return uuid_list_key;
 }
 
-size_t StreamLayerClientImpl::QueueSize() const {
-  std::lock_guard<std::mutex> lock(cache_mutex_);
+std::string StreamLayerClientImpl::GetQueueItemKey(uint64_t sequence) const {
+  return catalog_.ToCatalogHRNString() + kStreamQueuePostfix + "::" +
+         std::to_string(sequence);
+}
+
+std::string StreamLayerClientImpl::GetQueueHeadKey() const {
+  return catalog_.ToCatalogHRNString() + kStreamQueuePostfix + "::head";
+}
+
+std::string StreamLayerClientImpl::GetQueueTailKey() const {
+  return catalog_.ToCatalogHRNString() + kStreamQueuePostfix + "::tail";
+}
+
+uint64_t StreamLayerClientImpl::GetQueueSequence(
+    const std::string& key) const {
+  const auto sequence_any = cache_->Get(key, [](const std::string& s) {
+    return static_cast<uint64_t>(std::strtoull(s.c_str(), nullptr, 10));
+  });
+  if (sequence_any.empty()) {
+    return 0u;
+  }
+
+  return boost::any_cast<uint64_t>(sequence_any);
+}
+
+void StreamLayerClientImpl::PutQueueSequence(const std::string& key,
+                                             uint64_t sequence) const {
+  cache_->Put(key, sequence, [=]() { return std::to_string(sequence); });
+}
+
+void StreamLayerClientImpl::MigrateUuidList() const {
+  if (uuid_list_migrated_) {
+    return;
+  }
+  uuid_list_migrated_ = true;
 
   const auto uuid_list_any =
       cache_->Get(GetUuidListKey(), [](const std::string& s) { return s; });
-  std::string uuid_list = "";
-  if (!uuid_list_any.empty()) {
-    uuid_list = boost::any_cast<std::string>(uuid_list_any);
-    return std::count(uuid_list.cbegin(), uuid_list.cend(), ',');
+  if (uuid_list_any.empty()) {
+    return;
+  }
+
+  const auto uuid_list = boost::any_cast<std::string>(uuid_list_any);
+  const auto queue_tail_key = GetQueueTailKey();
+  auto tail = GetQueueSequence(queue_tail_key);
+
+  size_t begin = 0u;
+  for (auto end = uuid_list.find(','); end != std::string::npos;
+       begin = end + 1u, end = uuid_list.find(',', begin)) {
+    const auto publish_data_key = uuid_list.substr(begin, end - begin);
+    auto publish_data_any =
+        cache_->Get(publish_data_key, [](const std::string& s) {
+          return olp::parser::parse<model::PublishDataRequest>(s);
+        });
+    cache_->Remove(publish_data_key);
+    if (publish_data_any.empty()) {
+      continue;
+    }
+
+    const auto request =
+        boost::any_cast<model::PublishDataRequest>(publish_data_any);
+    cache_->Put(GetQueueItemKey(tail++), request, [&]() {
+      return olp::serializer::serialize<model::PublishDataRequest>(request);
+    });
   }
 
-  return 0;
+  PutQueueSequence(queue_tail_key, tail);
+  cache_->Remove(GetUuidListKey());
+}
+
+size_t StreamLayerClientImpl::QueueSize() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  MigrateUuidList();
+
+  return static_cast<size_t>(GetQueueSequence(GetQueueTailKey()) -
+                             GetQueueSequence(GetQueueHeadKey()));
+}
+
+std::chrono::milliseconds StreamLayerClientImpl::OldestQueuedRequestAge()
+    const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  MigrateUuidList();
+
+  return OldestQueuedRequestAge(GetQueueSequence(GetQueueHeadKey()),
+                                GetQueueSequence(GetQueueTailKey()));
+}
+
+std::chrono::milliseconds StreamLayerClientImpl::OldestQueuedRequestAge(
+    uint64_t head, uint64_t tail) const {
+  if (head >= tail) {
+    return std::chrono::milliseconds(0);
+  }
+
+  auto queued_at = created_at_;
+  if (!queue_times_.empty() && queue_times_.front().first == head) {
+    queued_at = queue_times_.front().second;
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() -
+                                                               queued_at);
+}
+
+void StreamLayerClientImpl::SetFlushEventListener(
+    std::shared_ptr<FlushListener> listener) {
+  std::atomic_store(&flush_listener_, std::move(listener));
+}
+
+CompressionStatistics StreamLayerClientImpl::GetCompressionStatistics() const {
+  return compressor_.GetStatistics();
+}
+
+void StreamLayerClientImpl::NotifyQueueChanged(
+    size_t queue_size, std::chrono::milliseconds oldest_request_age) const {
+  auto listener = std::atomic_load(&flush_listener_);
+  if (listener) {
+    listener->NotifyQueueChanged(queue_size, oldest_request_age);
+  }
 }
 
 boost::optional<std::string> StreamLayerClientImpl::Queue(
@@ -130,71 +259,243 @@ boost::optional<std::string> StreamLayerClientImpl::Queue(
         "PublishDataRequest does not contain a Layer ID");
   }
 
-  if (!(StreamLayerClientImpl::QueueSize() <
+  std::unique_lock<std::mutex> lock(cache_mutex_);
+  MigrateUuidList();
+
+  const auto queue_tail_key = GetQueueTailKey();
+  const auto tail = GetQueueSequence(queue_tail_key);
+  if (!(tail - GetQueueSequence(GetQueueHeadKey()) <
         stream_client_settings_.maximum_requests)) {
     return boost::make_optional<std::string>(
         "Maximum number of requests has reached");
   }
 
-  {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    const auto publish_data_key = GenerateUuid();
-    cache_->Put(publish_data_key, request, [=]() {
-      return olp::serializer::serialize<model::PublishDataRequest>(request);
-    });
-
-    const auto uuid_list_any =
-        cache_->Get(GetUuidListKey(), [](const std::string& s) { return s; });
-    std::string uuid_list = "";
-    if (!uuid_list_any.empty()) {
-      uuid_list = boost::any_cast<std::string>(uuid_list_any);
-    }
-    uuid_list += publish_data_key + ",";
+  // The request is stored before the tail is moved, so the queue never
+  // refers to a missing request.
+  cache_->Put(GetQueueItemKey(tail), request, [&]() {
+    return olp::serializer::serialize<model::PublishDataRequest>(request);
+  });
+  PutQueueSequence(queue_tail_key, tail + 1u);
+  queue_times_.emplace_back(tail, Clock::now());
 
-    cache_->Put(GetUuidListKey(), uuid_list,
-                [&uuid_list]() { return uuid_list; });
-  }
+  const auto head = GetQueueSequence(GetQueueHeadKey());
+  const auto oldest_request_age = OldestQueuedRequestAge(head, tail + 1u);
+  lock.unlock();
 
+  NotifyQueueChanged(static_cast<size_t>(tail + 1u - head),
+                     oldest_request_age);
   return boost::none;
 }
 
 boost::optional<model::PublishDataRequest>
 StreamLayerClientImpl::PopFromQueue() {
-  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto requests = PopFromQueue(1u);
+  if (requests.empty()) {
+    return boost::none;
+  }
 
-  const auto uuid_list_any =
-      cache_->Get(GetUuidListKey(), [](const std::string& s) { return s; });
+  return std::move(requests.front());
+}
 
-  if (uuid_list_any.empty()) {
-    OLP_SDK_LOG_ERROR(kLogTag, "Unable to Restore UUID list from Cache");
-    return boost::none;
+std::vector<model::PublishDataRequest> StreamLayerClientImpl::PopFromQueue(
+    size_t max_count, size_t max_bytes) {
+  std::unique_lock<std::mutex> lock(cache_mutex_);
+  MigrateUuidList();
+
+  const auto queue_head_key = GetQueueHeadKey();
+  const auto head = GetQueueSequence(queue_head_key);
+  const auto tail = GetQueueSequence(GetQueueTailKey());
+
+  std::vector<model::PublishDataRequest> requests;
+  size_t bytes = 0u;
+  auto sequence = head;
+  for (; sequence < tail && requests.size() < max_count; ++sequence) {
+    auto publish_data_any =
+        cache_->Get(GetQueueItemKey(sequence), [](const std::string& s) {
+          return olp::parser::parse<model::PublishDataRequest>(s);
+        });
+    if (publish_data_any.empty()) {
+      OLP_SDK_LOG_ERROR(kLogTag,
+                        "Unable to Restore PublishData Request from Cache");
+      continue;
+    }
+
+    auto request = boost::any_cast<model::PublishDataRequest>(publish_data_any);
+    const auto size = request.GetData() ? request.GetData()->size() : 0u;
+    if (!requests.empty() && (bytes >= max_bytes || size > max_bytes - bytes)) {
+      break;
+    }
+
+    bytes += size;
+    requests.emplace_back(std::move(request));
   }
 
-  auto uuid_list = boost::any_cast<std::string>(uuid_list_any);
+  // The head is moved before the requests are removed, so a crash in between
+  // leaves only unreachable keys behind.
+  PutQueueSequence(queue_head_key, sequence);
+  for (auto popped = head; popped < sequence; ++popped) {
+    cache_->Remove(GetQueueItemKey(popped));
+  }
+  while (!queue_times_.empty() && queue_times_.front().first < sequence) {
+    queue_times_.pop_front();
+  }
 
-  auto pos = uuid_list.find(",");
-  if (pos == std::string::npos) {
-    return boost::none;
+  const auto oldest_request_age = OldestQueuedRequestAge(sequence, tail);
+  lock.unlock();
+
+  if (sequence != head) {
+    NotifyQueueChanged(static_cast<size_t>(tail - sequence),
+                       oldest_request_age);
   }
+  return requests;
+}
 
-  const auto publish_data_key = uuid_list.substr(0, pos);
-  auto publish_data_any =
-      cache_->Get(publish_data_key, [](const std::string& s) {
-        return olp::parser::parse<model::PublishDataRequest>(s);
-      });
+bool StreamLayerClientImpl::RequeueFront(
+    const std::vector<model::PublishDataRequest>& requests) {
+  std::unique_lock<std::mutex> lock(cache_mutex_);
 
-  cache_->Remove(publish_data_key);
-  uuid_list.erase(0, pos + 1);
-  cache_->Put(GetUuidListKey(), uuid_list,
-              [&uuid_list]() { return uuid_list; });
+  const auto queue_head_key = GetQueueHeadKey();
+  const auto head = GetQueueSequence(queue_head_key);
+  const auto count = static_cast<uint64_t>(requests.size());
+  // The requests were popped from the head, so there is room in front of it.
+  if (count > head) {
+    return false;
+  }
 
-  if (publish_data_any.empty()) {
-    OLP_SDK_LOG_ERROR(kLogTag,
-                      "Unable to Restore PublishData Request from Cache");
-    return boost::none;
+  // The requests are stored before the head is moved back, so the queue
+  // never refers to a missing request.
+  const auto new_head = head - count;
+  for (uint64_t index = 0u; index < count; ++index) {
+    const auto& request = requests[index];
+    const bool stored =
+        cache_->Put(GetQueueItemKey(new_head + index), request, [&]() {
+          return olp::serializer::serialize<model::PublishDataRequest>(
+              request);
+        });
+    if (!stored) {
+      for (uint64_t removed = 0u; removed < index; ++removed) {
+        cache_->Remove(GetQueueItemKey(new_head + removed));
+      }
+      return false;
+    }
   }
+  PutQueueSequence(queue_head_key, new_head);
 
-  return boost::any_cast<model::PublishDataRequest>(publish_data_any);
+  const auto tail = GetQueueSequence(GetQueueTailKey());
+  const auto oldest_request_age = OldestQueuedRequestAge(new_head, tail);
+  lock.unlock();
+
+  NotifyQueueChanged(static_cast<size_t>(tail - new_head),
+                     oldest_request_age);
+  return true;
+}
+
+size_t StreamLayerClientImpl::PublishInParallel(
+    const std::vector<model::PublishDataRequest>& requests,
+    StreamLayerClient::FlushResponse& responses,
+    client::CancellationContext context) {
+  const auto count = requests.size();
+  std::vector<PublishDataResponse> publish_responses(count);
+  // Not std::vector<bool>, the workers set the flags concurrently.
+  std::vector<char> attempted(count, 0);
+  std::vector<client::CancellationContext> contexts(count);
+
+  const bool started = context.ExecuteOrCancelled([&]() {
+    return client::CancellationToken([contexts]() mutable {
+      for (auto& publish_context : contexts) {
+        publish_context.CancelOperation();
+      }
+    });
+  });
+
+  if (started) {
+    const auto listener = std::atomic_load(&flush_listener_);
+    std::atomic<size_t> next_request{0u};
+    auto publish = [&]() {
+      for (auto index = next_request++;
+           index < count && !context.IsCancelled(); index = next_request++) {
+        const auto& request = requests[index];
+        const auto start = Clock::now();
+        auto& response = publish_responses[index];
+        response = PublishDataTask(request, contexts[index]);
+        attempted[index] = 1;
+
+        if (listener && (response.IsSuccessful() ||
+                         response.GetError().GetErrorCode() !=
+                             client::ErrorCode::Cancelled)) {
+          listener->NotifyRequestFlushed(
+              request.GetLayerId(),
+              request.GetData() ? request.GetData()->size() : 0u,
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  Clock::now() - start),
+              response.IsSuccessful());
+        }
+      }
+    };
+
+    std::vector<std::thread> workers;
+    const auto workers_count = std::min(
+        std::max<size_t>(stream_client_settings_.flush_parallel_requests, 1u),
+        count);
+    for (size_t worker = 1u; worker < workers_count; ++worker) {
+      workers.emplace_back(publish);
+    }
+    publish();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  const bool cancelled = context.IsCancelled();
+  auto is_requeued = [&](size_t index) {
+    const auto& response = publish_responses[index];
+    return cancelled &&
+           (!attempted[index] ||
+            (!response.IsSuccessful() && response.GetError().GetErrorCode() ==
+                                             client::ErrorCode::Cancelled));
+  };
+
+  // If cancelled queue back the requests that are not published, in front of
+  // the requests queued in the meantime.
+  std::vector<model::PublishDataRequest> requeue_requests;
+  for (size_t index = 0u; index < count; ++index) {
+    if (is_requeued(index)) {
+      requeue_requests.push_back(requests[index]);
+    }
+  }
+  const auto requeued = requeue_requests.size();
+  const bool requeue_failed =
+      requeued > 0u && !RequeueFront(requeue_requests);
+  if (requeue_failed) {
+    OLP_SDK_LOG_ERROR_F(kLogTag, "Unable to queue back %zu cancelled requests",
+                        requeued);
+  }
+
+  size_t published = 0u;
+  for (size_t index = 0u; index < count; ++index) {
+    if (requeue_failed && is_requeued(index)) {
+      responses.emplace_back(client::ApiError(
+          client::ErrorCode::InternalFailure,
+          "Flush cancelled, unable to queue back the request"));
+      continue;
+    }
+
+    if (!attempted[index]) {
+      continue;
+    }
+
+    if (!is_requeued(index)) {
+      ++published;
+    }
+    responses.emplace_back(std::move(publish_responses[index]));
+  }
+
+  auto listener = std::atomic_load(&flush_listener_);
+  if (listener && requeued > 0u && !requeue_failed) {
+    listener->NotifyRequestsRequeued(requeued);
+  }
+
+  return published;
 }
 
 olp::client::CancellableFuture<StreamLayerClient::FlushResponse>
@@ -233,24 +534,23 @@ olp::client::CancellationToken StreamLayerClientImpl::Flush(
           return EmptyFlushApiResponse{};
         }
 
+        const auto flush_batch_size =
+            std::max<size_t>(stream_client_settings_.flush_batch_size, 1u);
+
         int counter = 0;
         while ((!maximum_events_number || counter < maximum_events_number) &&
                (this->QueueSize() > 0) && !context.IsCancelled()) {
-          auto publish_request = this->PopFromQueue();
-          if (publish_request == boost::none) {
-            continue;
+          auto batch_size = flush_batch_size;
+          if (maximum_events_number) {
+            batch_size = std::min(
+                batch_size,
+                static_cast<size_t>(maximum_events_number - counter));
           }
 
-          auto publish_response = PublishDataTask(*publish_request, context);
-          responses.emplace_back(std::move(publish_response));
-
-          // If cancelled queue back task
-          if (context.IsCancelled()) {
-            this->Queue(*publish_request);
-            break;
-          }
-
-          counter++;
+          auto publish_requests = this->PopFromQueue(
+              batch_size, stream_client_settings_.flush_batch_bytes);
+          counter += static_cast<int>(
+              PublishInParallel(publish_requests, responses, context));
         }
 
         OLP_SDK_LOG_INFO_F(kLogTag, "Flushed %d publish requests", counter);
@@ -294,10 +594,16 @@ client::CancellationToken StreamLayerClientImpl::PublishData(
     return client::CancellationToken();
   }
 
+  if (stream_client_settings_.linger_ms.count() > 0 && task_scheduler_ &&
+      request.GetData()->size() <= static_cast<size_t>(kTwentyMib)) {
+    return LingerPublishData(std::move(request), std::move(callback));
+  }
+
   using std::placeholders::_1;
   client::TaskContext task_context = olp::client::TaskContext::Create(
-      std::bind(&StreamLayerClientImpl::PublishDataTask, this, request, _1),
-      callback);
+      std::bind(&StreamLayerClientImpl::PublishDataTask, this,
+                std::move(request), _1),
+      std::move(callback));
 
   auto pending_requests = pending_requests_;
   pending_requests->Insert(task_context);
@@ -310,8 +616,166 @@ client::CancellationToken StreamLayerClientImpl::PublishData(
   return task_context.CancelToken();
 }
 
+client::CancellationToken StreamLayerClientImpl::LingerPublishData(
+    model::PublishDataRequest request, PublishDataCallback callback) {
+  auto batch = linger_batch_;
+  const auto size = request.GetData()->size();
+  client::CancellationContext context;
+  std::vector<LingerRequest> ready;
+  uint64_t id = 0u;
+  {
+    std::lock_guard<std::mutex> lock(batch->mutex);
+    id = batch->next_id++;
+    batch->requests.push_back(
+        LingerRequest{id, std::move(request), std::move(callback), context});
+    batch->bytes += size;
+
+    if (batch->bytes >= stream_client_settings_.batch_bytes) {
+      ready.swap(batch->requests);
+      batch->bytes = 0u;
+      ++batch->generation;
+    } else if (batch->requests.size() == 1u) {
+      const auto generation = batch->generation;
+      task_scheduler_->ScheduleTaskAfter(
+          [=]() {
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            // The batch is already published because of its size
+            if (batch->closed || batch->generation != generation ||
+                batch->requests.empty()) {
+              return;
+            }
+
+            std::vector<LingerRequest> expired;
+            expired.swap(batch->requests);
+            batch->bytes = 0u;
+            ++batch->generation;
+            DispatchLingerBatch(std::move(expired));
+          },
+          stream_client_settings_.linger_ms);
+    }
+  }
+
+  if (!ready.empty()) {
+    DispatchLingerBatch(std::move(ready));
+  }
+
+  return client::CancellationToken([=]() mutable {
+    PublishDataCallback cancelled_callback;
+    {
+      std::lock_guard<std::mutex> lock(batch->mutex);
+      auto it = std::find_if(
+          batch->requests.begin(), batch->requests.end(),
+          [&](const LingerRequest& lingering) { return lingering.id == id; });
+      if (it != batch->requests.end()) {
+        cancelled_callback = std::move(it->callback);
+        batch->bytes -= it->request.GetData()->size();
+        batch->requests.erase(it);
+      }
+    }
+
+    if (cancelled_callback) {
+      cancelled_callback(PublishDataResponse(client::ApiError(
+          client::ErrorCode::Cancelled, "Operation cancelled.")));
+    } else {
+      context.CancelOperation();
+    }
+  });
+}
+
+void StreamLayerClientImpl::DispatchLingerBatch(
+    std::vector<LingerRequest> requests) {
+  OLP_SDK_LOG_TRACE_F(kLogTag, "Publishing %zu collected requests",
+                      requests.size());
+
+  using LingerResponse =
+      client::ApiResponse<client::ApiNoResult, client::ApiError>;
+  auto shared_requests =
+      std::make_shared<std::vector<LingerRequest>>(std::move(requests));
+
+  client::TaskContext task_context = client::TaskContext::Create(
+      [=](client::CancellationContext context) {
+        PublishLingerBatch(*shared_requests, std::move(context));
+        return LingerResponse(client::ApiNoResult());
+      },
+      [=](LingerResponse response) {
+        // The requests are not published if the task is cancelled before it
+        // starts
+        if (response.IsSuccessful()) {
+          return;
+        }
+        for (auto& lingering : *shared_requests) {
+          if (lingering.callback) {
+            lingering.callback(PublishDataResponse(response.GetError()));
+          }
+        }
+      });
+
+  auto pending_requests = pending_requests_;
+  pending_requests->Insert(task_context);
+
+  ExecuteOrSchedule(task_scheduler_, [=]() {
+    task_context.Execute();
+    pending_requests->Remove(task_context);
+  });
+}
+
+void StreamLayerClientImpl::PublishLingerBatch(
+    std::vector<LingerRequest>& requests, client::CancellationContext context) {
+  std::vector<client::CancellationContext> contexts;
+  contexts.reserve(requests.size());
+  for (const auto& lingering : requests) {
+    contexts.push_back(lingering.context);
+  }
+
+  const bool started = context.ExecuteOrCancelled([&]() {
+    return client::CancellationToken([contexts]() mutable {
+      for (auto& publish_context : contexts) {
+        publish_context.CancelOperation();
+      }
+    });
+  });
+
+  if (!started) {
+    return;
+  }
+
+  const auto count = requests.size();
+  std::atomic<size_t> next_request{0u};
+  auto publish = [&]() {
+    for (auto index = next_request++; index < count; index = next_request++) {
+      auto& lingering = requests[index];
+      auto callback = std::move(lingering.callback);
+      lingering.callback = nullptr;
+      callback(PublishDataTask(lingering.request, lingering.context));
+    }
+  };
+
+  std::vector<std::thread> workers;
+  const auto workers_count = std::min(
+      std::max<size_t>(stream_client_settings_.flush_parallel_requests, 1u),
+      count);
+  for (size_t worker = 1u; worker < workers_count; ++worker) {
+    workers.emplace_back(publish);
+  }
+  publish();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
 PublishDataResponse StreamLayerClientImpl::PublishDataTask(
     model::PublishDataRequest request, client::CancellationContext context) {
+  // The data is compressed before the size check, so the compressed data of
+  // a large request can be ingested directly.
+  if (stream_client_settings_.compress_data && !request.GetChecksum()) {
+    auto layer_settings = catalog_settings_.GetLayerSettings(
+        context, request.GetBillingTag(), request.GetLayerId());
+    if (layer_settings.IsSuccessful()) {
+      request.WithData(compressor_.Compress(
+          request.GetData(), layer_settings.GetResult().content_encoding));
+    }
+  }
+
   const int64_t data_size = request.GetData()->size() * sizeof(unsigned char);
   if (data_size <= kTwentyMib) {
     return PublishDataLessThanTwentyMib(std::move(request), std::move(context));
@@ -502,7 +966,7 @@ client::CancellationToken StreamLayerClientImpl::PublishSdii(
 PublishSdiiResponse StreamLayerClientImpl::PublishSdiiTask(
     model::PublishSdiiRequest request,
     olp::client::CancellationContext context) {
-  if (!request.GetSdiiMessageList()) {
+  if (!request.GetSdiiMessageList() && !request.GetSdiiMessageListSource()) {
     return {{client::ErrorCode::InvalidArgument,
              "Request sdii message list null."}};
   }
@@ -524,6 +988,14 @@ PublishSdiiResponse StreamLayerClientImpl::IngestSdii(
   }
 
   auto client = api_response.MoveResult();
+  if (request.GetSdiiMessageListSource()) {
+    // The data is read from the caller's buffer while it is sent.
+    return IngestApi::IngestSdii(
+        client, request.GetLayerId(), request.GetSdiiMessageListSource(),
+        request.GetSdiiMessageListSize(), request.GetTraceId(),
+        request.GetBillingTag(), request.GetChecksum(), context);
+  }
+
   return IngestApi::IngestSdii(client, request.GetLayerId(),
                                request.GetSdiiMessageList(),
                                request.GetTraceId(), request.GetBillingTag(),
@@ -19,20 +19,29 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <boost/optional.hpp>
 
+#include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/HRN.h>
 #include <olp/core/client/OlpClientSettings.h>
 
 #include <olp/dataservice/write/StreamLayerClient.h>
 #include "CatalogSettings.h"
+#include "FlushEventListener.h"
+#include "UploadCompressor.h"
 #include "generated/model/Catalog.h"
 
 namespace olp {
 namespace client {
-class CancellationContext;
 class PendingRequests;
 }  // namespace client
 
@@ -41,6 +50,9 @@ namespace write {
 
 class StreamLayerClientImpl {
  public:
+  using FlushListener =
+      FlushEventListener<const StreamLayerClient::FlushResponse&>;
+
   StreamLayerClientImpl(client::HRN catalog,
                         StreamLayerClientSettings client_settings,
                         client::OlpClientSettings settings);
@@ -60,7 +72,21 @@ class StreamLayerClientImpl {
   olp::client::CancellationToken Flush(
       model::FlushRequest request, StreamLayerClient::FlushCallback callback);
   size_t QueueSize() const;
+  /// How long the oldest queued request has been waiting. The requests queued
+  /// by an earlier instance count from the creation of this one.
+  std::chrono::milliseconds OldestQueuedRequestAge() const;
+  /// Sets the listener that receives the queue changes and the latencies of
+  /// the flushed requests.
+  void SetFlushEventListener(std::shared_ptr<FlushListener> listener);
+  /// Gets the statistics of the data compressed before the upload.
+  CompressionStatistics GetCompressionStatistics() const;
+  std::shared_ptr<thread::TaskScheduler> GetTaskScheduler() const {
+    return task_scheduler_;
+  }
   boost::optional<model::PublishDataRequest> PopFromQueue();
+  std::vector<model::PublishDataRequest> PopFromQueue(
+      size_t max_count,
+      size_t max_bytes = std::numeric_limits<size_t>::max());
 
   client::CancellableFuture<PublishSdiiResponse> PublishSdii(
       model::PublishSdiiRequest request);
@@ -87,8 +113,75 @@ class StreamLayerClientImpl {
   virtual std::string GenerateUuid() const;
 
  private:
+  /// A request that waits in the linger batch for more requests.
+  struct LingerRequest {
+    uint64_t id;
+    model::PublishDataRequest request;
+    PublishDataCallback callback;
+    client::CancellationContext context;
+  };
+
+  /// The requests collected by \c PublishData during the linger time. It is
+  /// shared with the delayed tasks, so they do nothing after the client is
+  /// destroyed.
+  struct LingerBatch {
+    std::mutex mutex;
+    std::vector<LingerRequest> requests;
+    size_t bytes{0u};
+    uint64_t next_id{0u};
+    uint64_t generation{0u};
+    bool closed{false};
+  };
+
   std::string GetUuidListKey() const;
 
+  /// Adds the request to the linger batch, the batch is published when it
+  /// reaches `batch_bytes` or when the linger time expires.
+  client::CancellationToken LingerPublishData(model::PublishDataRequest request,
+                                              PublishDataCallback callback);
+
+  /// Schedules the publishing of the collected requests. The delayed task
+  /// calls it with the batch mutex locked, so the destructor does not miss
+  /// the scheduled publishing.
+  void DispatchLingerBatch(std::vector<LingerRequest> requests);
+
+  /// Publishes the collected requests in parallel and calls the callback of
+  /// each request. The callbacks that are called are reset.
+  void PublishLingerBatch(std::vector<LingerRequest>& requests,
+                          client::CancellationContext context);
+
+  /// Publishes the requests in parallel and adds their responses. The
+  /// requests that are not published because of the cancellation are queued
+  /// back at the front, or get an error response if that fails. Returns the
+  /// number of the published requests.
+  size_t PublishInParallel(
+      const std::vector<model::PublishDataRequest>& requests,
+      StreamLayerClient::FlushResponse& responses,
+      client::CancellationContext context);
+
+  /// The queue is a range of the cache keys with sequence numbers, the
+  /// sequence numbers of its head and tail are stored in separate keys.
+  std::string GetQueueItemKey(uint64_t sequence) const;
+  std::string GetQueueHeadKey() const;
+  std::string GetQueueTailKey() const;
+  uint64_t GetQueueSequence(const std::string& key) const;
+  void PutQueueSequence(const std::string& key, uint64_t sequence) const;
+
+  /// Puts the popped requests back in front of the queue in the same order.
+  /// Returns false and leaves the queue unchanged if they cannot be stored.
+  bool RequeueFront(const std::vector<model::PublishDataRequest>& requests);
+
+  /// Moves the requests queued with the UUID list of the previous versions to
+  /// the queue. Must be called with `cache_mutex_` locked.
+  void MigrateUuidList() const;
+
+  /// Must be called with `cache_mutex_` locked.
+  std::chrono::milliseconds OldestQueuedRequestAge(uint64_t head,
+                                                   uint64_t tail) const;
+
+  void NotifyQueueChanged(size_t queue_size,
+                          std::chrono::milliseconds oldest_request_age) const;
+
  private:
   client::HRN catalog_;
 
@@ -97,10 +190,20 @@ class StreamLayerClientImpl {
 
   std::shared_ptr<cache::KeyValueCache> cache_;
   mutable std::mutex cache_mutex_;
+  mutable bool uuid_list_migrated_;
   StreamLayerClientSettings stream_client_settings_;
+  UploadCompressor compressor_;
 
   std::shared_ptr<client::PendingRequests> pending_requests_;
   std::shared_ptr<thread::TaskScheduler> task_scheduler_;
+  std::shared_ptr<LingerBatch> linger_batch_;
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point created_at_;
+  /// The queue times of the requests queued by this instance, by sequence.
+  /// Guarded by `cache_mutex_`.
+  std::deque<std::pair<uint64_t, Clock::time_point>> queue_times_;
+  std::shared_ptr<FlushListener> flush_listener_;
 };
 
 }  // namespace write
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "UploadCompressor.h"
+
+#include <algorithm>
+#include <utility>
+
+#ifdef OLP_SDK_WRITE_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#include <olp/core/http/NetworkUtils.h>
+#include <olp/core/logging/Log.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+namespace {
+constexpr auto kLogTag = "UploadCompressor";
+constexpr auto kGzipEncoding = "gzip";
+constexpr unsigned char kGzipMagic[] = {0x1f, 0x8b};
+
+bool IsGzipCompressed(const std::vector<unsigned char>& data) {
+  return data.size() >= sizeof(kGzipMagic) && data[0] == kGzipMagic[0] &&
+         data[1] == kGzipMagic[1];
+}
+
+#ifdef OLP_SDK_WRITE_HAS_ZLIB
+// The input is compressed in chunks, and the output grows by chunks, so no
+// buffer of the size of the input is allocated upfront.
+constexpr size_t kChunkSize = 64u * 1024u;
+
+UploadCompressor::Data Deflate(const std::vector<unsigned char>& input) {
+  z_stream stream{};
+  // 16 + MAX_WBITS writes the gzip header and trailer.
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS,
+                   8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return nullptr;
+  }
+
+  auto output = std::make_shared<std::vector<unsigned char>>();
+  size_t consumed = 0u;
+  size_t produced = 0u;
+  int result = Z_OK;
+  while (result != Z_STREAM_END) {
+    if (stream.avail_in == 0u && consumed < input.size()) {
+      const auto chunk = std::min(kChunkSize, input.size() - consumed);
+      stream.next_in = const_cast<Bytef*>(input.data() + consumed);
+      stream.avail_in = static_cast<uInt>(chunk);
+      consumed += chunk;
+    }
+
+    output->resize(produced + kChunkSize);
+    stream.next_out = output->data() + produced;
+    stream.avail_out = static_cast<uInt>(kChunkSize);
+
+    const bool last_chunk = consumed == input.size();
+    result = deflate(&stream, last_chunk ? Z_FINISH : Z_NO_FLUSH);
+    if (result == Z_STREAM_ERROR) {
+      deflateEnd(&stream);
+      return nullptr;
+    }
+    produced += kChunkSize - stream.avail_out;
+  }
+
+  deflateEnd(&stream);
+  output->resize(produced);
+  return output;
+}
+#endif
+}  // namespace
+
+UploadCompressor::UploadCompressor(bool enabled)
+    : enabled_{enabled && IsAvailable()} {
+  if (enabled && !enabled_) {
+    OLP_SDK_LOG_WARNING(kLogTag,
+                        "The data is not compressed, the SDK is built "
+                        "without zlib");
+  }
+}
+
+bool UploadCompressor::IsAvailable() {
+#ifdef OLP_SDK_WRITE_HAS_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+UploadCompressor::Data UploadCompressor::Compress(
+    Data data, const std::string& content_encoding) {
+  if (!enabled_ || !data || data->empty() ||
+      !http::NetworkUtils::CaseInsensitiveCompare(content_encoding,
+                                                  kGzipEncoding) ||
+      IsGzipCompressed(*data)) {
+    return data;
+  }
+
+#ifdef OLP_SDK_WRITE_HAS_ZLIB
+  auto compressed = Deflate(*data);
+  if (!compressed) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Failed to compress the data, size=%zu",
+                          data->size());
+    return data;
+  }
+
+  const auto order = std::memory_order_relaxed;
+  compressed_uploads_.fetch_add(1u, order);
+  uncompressed_bytes_.fetch_add(data->size(), order);
+  compressed_bytes_.fetch_add(compressed->size(), order);
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Compressed the data, size=%zu, compressed=%zu",
+                      data->size(), compressed->size());
+  return compressed;
+#else
+  return data;
+#endif
+}
+
+CompressionStatistics UploadCompressor::GetStatistics() const {
+  CompressionStatistics statistics;
+  statistics.compressed_uploads = compressed_uploads_.load();
+  statistics.uncompressed_bytes = uncompressed_bytes_.load();
+  statistics.compressed_bytes = compressed_bytes_.load();
+  return statistics;
+}
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <olp/dataservice/write/CompressionStatistics.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief Compresses the data of the uploads to the layers that expect it
+ * compressed.
+ *
+ * The data is compressed with gzip if the content encoding of the layer is
+ * gzip and the data is not compressed yet. The data of the other layers is
+ * uploaded as it is. The compression runs on the calling thread, so the
+ * clients call it from their tasks on the task scheduler.
+ */
+class UploadCompressor final {
+ public:
+  using Data = std::shared_ptr<std::vector<unsigned char>>;
+
+  explicit UploadCompressor(bool enabled);
+
+  /// Checks whether the SDK is built with the compression support.
+  static bool IsAvailable();
+
+  /**
+   * @brief Compresses the data for the layer.
+   *
+   * @param data The data to upload.
+   * @param content_encoding The content encoding of the layer.
+   *
+   * @return The compressed data, or the same data if it is not compressed.
+   */
+  Data Compress(Data data, const std::string& content_encoding);
+
+  /// Gets the statistics of the compressed data.
+  CompressionStatistics GetStatistics() const;
+
+ private:
+  const bool enabled_;
+  std::atomic<uint64_t> compressed_uploads_{0u};
+  std::atomic<uint64_t> uncompressed_bytes_{0u};
+  std::atomic<uint64_t> compressed_bytes_{0u};
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
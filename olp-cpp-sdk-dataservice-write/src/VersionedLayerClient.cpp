@@ -30,6 +30,13 @@ VersionedLayerClient::VersionedLayerClient(client::HRN catalog,
     : impl_(std::make_shared<VersionedLayerClientImpl>(std::move(catalog),
                                                        std::move(settings))) {}
 
+VersionedLayerClient::VersionedLayerClient(
+    client::HRN catalog, VersionedLayerClientSettings client_settings,
+    client::OlpClientSettings settings)
+    : impl_(std::make_shared<VersionedLayerClientImpl>(
+          std::move(catalog), std::move(client_settings),
+          std::move(settings))) {}
+
 olp::client::CancellableFuture<StartBatchResponse>
 VersionedLayerClient::StartBatch(model::StartBatchRequest request) {
   return impl_->StartBatch(request);
@@ -84,6 +91,10 @@ void VersionedLayerClient::CancelPendingRequests() {
   impl_->CancelPendingRequests();
 }
 
+CompressionStatistics VersionedLayerClient::GetCompressionStatistics() const {
+  return impl_->GetCompressionStatistics();
+}
+
 olp::client::CancellableFuture<PublishPartitionDataResponse>
 VersionedLayerClient::PublishToBatch(
     const model::Publication& pub, model::PublishPartitionDataRequest request) {
@@ -96,6 +107,20 @@ olp::client::CancellationToken VersionedLayerClient::PublishToBatch(
   return impl_->PublishToBatch(pub, request, std::move(callback));
 }
 
+olp::client::CancellableFuture<PublishPartitionsDataResponse>
+VersionedLayerClient::PublishToBatch(
+    const model::Publication& pub,
+    std::vector<model::PublishPartitionDataRequest> requests) {
+  return impl_->PublishToBatch(pub, std::move(requests));
+}
+
+olp::client::CancellationToken VersionedLayerClient::PublishToBatch(
+    const model::Publication& pub,
+    std::vector<model::PublishPartitionDataRequest> requests,
+    PublishPartitionsDataCallback callback) {
+  return impl_->PublishToBatch(pub, std::move(requests), std::move(callback));
+}
+
 olp::client::CancellableFuture<CheckDataExistsResponse>
 VersionedLayerClient::CheckDataExists(model::CheckDataExistsRequest request) {
   return impl_->CheckDataExists(request);
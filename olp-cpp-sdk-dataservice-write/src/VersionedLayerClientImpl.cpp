@@ -19,7 +19,21 @@
 
 #include "VersionedLayerClientImpl.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <olp/core/client/OlpClientFactory.h>
+#include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/thread/TaskScheduler.h>
 
 #include "ApiClientLookup.h"
 #include "Common.h"
@@ -30,15 +44,25 @@
 #include "generated/QueryApi.h"
 
 #include <boost/format.hpp>
+#include <boost/uuid/name_generator_sha1.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
 namespace {
+constexpr auto kLogTag = "VersionedLayerClientImpl";
+// The blob service rejects smaller parts, except the last one.
+constexpr size_t kMinMultipartPartSize = 5u * 1024u * 1024u;
+
 std::string GenerateUuid() {
   static boost::uuids::random_generator gen;
   return boost::uuids::to_string(gen());
 }
+
+std::string GenerateContentUuid(const std::vector<unsigned char>& data) {
+  boost::uuids::name_generator_sha1 gen(boost::uuids::ns::url());
+  return boost::uuids::to_string(gen(data.data(), data.size()));
+}
 }  // namespace
 
 namespace olp {
@@ -47,8 +71,17 @@ namespace write {
 
 VersionedLayerClientImpl::VersionedLayerClientImpl(
     client::HRN catalog, client::OlpClientSettings settings)
+    : VersionedLayerClientImpl(std::move(catalog),
+                               VersionedLayerClientSettings{},
+                               std::move(settings)) {}
+
+VersionedLayerClientImpl::VersionedLayerClientImpl(
+    client::HRN catalog, VersionedLayerClientSettings client_settings,
+    client::OlpClientSettings settings)
     : catalog_(catalog),
       settings_(settings),
+      client_settings_(std::move(client_settings)),
+      compressor_(client_settings_.compress_data),
       catalog_settings_(catalog, settings),
       apiclient_blob_(nullptr),
       apiclient_config_(nullptr),
@@ -418,6 +451,11 @@ void VersionedLayerClientImpl::CancelPendingRequests() {
   tokenList_.CancelAll();
 }
 
+CompressionStatistics VersionedLayerClientImpl::GetCompressionStatistics()
+    const {
+  return compressor_.GetStatistics();
+}
+
 olp::client::CancellableFuture<PublishPartitionDataResponse>
 VersionedLayerClientImpl::PublishToBatch(
     const model::Publication& pub,
@@ -449,7 +487,7 @@ olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
                "Invalid publication: layer ID missing", true}};
     }
 
-    const auto data_handle = GenerateUuid();
+    const auto data_handle = CreateDataHandle(request);
     model::PublishPartition partition;
     partition.SetPartition(request.GetPartitionId().value_or(""));
     partition.SetData(request.GetData());
@@ -495,6 +533,205 @@ olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
                  std::move(publish_task), std::move(callback));
 }
 
+client::CancellableFuture<PublishPartitionsDataResponse>
+VersionedLayerClientImpl::PublishToBatch(
+    const model::Publication& pub,
+    std::vector<model::PublishPartitionDataRequest> requests) {
+  auto promise =
+      std::make_shared<std::promise<PublishPartitionsDataResponse>>();
+  return client::CancellableFuture<PublishPartitionsDataResponse>(
+      PublishToBatch(pub, std::move(requests),
+                     [promise](PublishPartitionsDataResponse response) {
+                       promise->set_value(std::move(response));
+                     }),
+      promise);
+}
+
+client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
+    const model::Publication& pub,
+    std::vector<model::PublishPartitionDataRequest> requests,
+    PublishPartitionsDataCallback callback) {
+  auto publish_task = [=](client::CancellationContext context)
+      -> PublishPartitionsDataResponse {
+    if (!pub.GetId()) {
+      return {{client::ErrorCode::InvalidArgument,
+               "Invalid publication: publication ID missing", true}};
+    }
+    const auto& publication_id = pub.GetId().get();
+
+    std::vector<model::PublishPartition> partitions(requests.size());
+    std::map<std::string, CatalogSettings::LayerSettings> layers_settings;
+    for (size_t index = 0u; index < requests.size(); ++index) {
+      const auto& request = requests[index];
+      const auto& layer_id = request.GetLayerId();
+      if (layer_id.empty()) {
+        return {{client::ErrorCode::InvalidArgument,
+                 "Invalid publication: layer ID missing", true}};
+      }
+
+      if (layers_settings.count(layer_id) == 0u) {
+        auto layer_settings_response = catalog_settings_.GetLayerSettings(
+            context, request.GetBillingTag(), layer_id);
+        if (!layer_settings_response.IsSuccessful()) {
+          return layer_settings_response.GetError();
+        }
+        layers_settings[layer_id] = layer_settings_response.MoveResult();
+      }
+
+      if (layers_settings[layer_id].content_type.empty()) {
+        auto errmsg = boost::format(
+                          "Unable to find the Layer ID (%1%) "
+                          "provided in the request in the "
+                          "Catalog specified when creating "
+                          "this VersionedLayerClient instance.") %
+                      layer_id;
+        return {{client::ErrorCode::InvalidArgument, errmsg.str()}};
+      }
+
+      auto& partition = partitions[index];
+      partition.SetPartition(request.GetPartitionId().value_or(""));
+      partition.SetData(request.GetData());
+      partition.SetDataHandle(CreateDataHandle(request));
+    }
+
+    auto blob_client_response = ApiClientLookup::LookupApiClient(
+        catalog_, context, "blob", "v1", settings_);
+    if (!blob_client_response.IsSuccessful()) {
+      return blob_client_response.GetError();
+    }
+    const auto blob_client = blob_client_response.MoveResult();
+
+    // Upload the data blobs in parallel, the first error stops the uploads
+    std::vector<client::CancellationContext> contexts(requests.size());
+    const bool started = context.ExecuteOrCancelled([&]() {
+      return client::CancellationToken([contexts]() mutable {
+        for (auto& upload_context : contexts) {
+          upload_context.CancelOperation();
+        }
+      });
+    });
+    if (!started) {
+      return {{client::ErrorCode::Cancelled, "Operation cancelled."}};
+    }
+
+    std::mutex error_mutex;
+    boost::optional<client::ApiError> error;
+    // The partitions with the same data share the content addressed handle
+    std::set<std::pair<std::string, std::string>> uploaded_handles;
+    std::atomic<size_t> next_request{0u};
+    auto upload_blobs = [&]() {
+      for (auto index = next_request++; index < requests.size();
+           index = next_request++) {
+        const auto& request = requests[index];
+        const auto& partition = partitions[index];
+        {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (error) {
+            return;
+          }
+          if (client_settings_.content_addressed_data_handles &&
+              !uploaded_handles
+                   .emplace(request.GetLayerId(),
+                            partition.GetDataHandle().get())
+                   .second) {
+            continue;
+          }
+        }
+
+        const auto& layer_settings =
+            layers_settings.at(request.GetLayerId());
+        auto response = UploadBlob(
+            blob_client, partition, partition.GetDataHandle().get(),
+            layer_settings.content_type, layer_settings.content_encoding,
+            request.GetLayerId(), request.GetBillingTag(), contexts[index]);
+        if (!response.IsSuccessful()) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error) {
+            error = response.GetError();
+          }
+          return;
+        }
+      }
+    };
+
+    std::vector<std::thread> workers;
+    const auto workers_count =
+        std::min(std::max<size_t>(client_settings_.parallel_uploads, 1u),
+                 requests.size());
+    for (size_t worker = 1u; worker < workers_count; ++worker) {
+      workers.emplace_back(upload_blobs);
+    }
+    upload_blobs();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    if (error) {
+      return *error;
+    }
+
+    auto olp_client_response = ApiClientLookup::LookupApiClient(
+        catalog_, context, "publish", "v2", settings_);
+    if (!olp_client_response.IsSuccessful()) {
+      return olp_client_response.GetError();
+    }
+    auto publish_client = olp_client_response.MoveResult();
+
+    // Upload the metadata of each layer in groups
+    std::map<std::string, std::vector<model::PublishPartition>> layers;
+    for (size_t index = 0u; index < requests.size(); ++index) {
+      model::PublishPartition publish_partition;
+      publish_partition.SetPartition(
+          partitions[index].GetPartition().value_or(""));
+      publish_partition.SetDataHandle(
+          partitions[index].GetDataHandle().value_or(""));
+      layers[requests[index].GetLayerId()].push_back(
+          std::move(publish_partition));
+    }
+
+    const auto batch_size =
+        std::max<size_t>(client_settings_.partitions_batch_size, 1u);
+    for (const auto& layer : layers) {
+      const auto& layer_partitions = layer.second;
+      for (size_t begin = 0u; begin < layer_partitions.size();
+           begin += batch_size) {
+        const auto end = std::min(begin + batch_size, layer_partitions.size());
+        model::PublishPartitions partitions_batch;
+        partitions_batch.SetPartitions(
+            {layer_partitions.begin() + begin, layer_partitions.begin() + end});
+
+        auto upload_response = PublishApi::UploadPartitions(
+            publish_client, partitions_batch, publication_id, layer.first,
+            boost::none, context);
+        if (!upload_response.IsSuccessful()) {
+          return upload_response.GetError();
+        }
+      }
+    }
+
+    PublishPartitionsDataResult result;
+    result.reserve(requests.size());
+    for (const auto& request : requests) {
+      model::ResponseOkSingle response;
+      response.SetTraceID(request.GetPartitionId().value_or(""));
+      result.push_back(std::move(response));
+    }
+    return result;
+  };
+
+  return AddTask(settings_.task_scheduler, pending_requests_,
+                 std::move(publish_task), std::move(callback));
+}
+
+std::string VersionedLayerClientImpl::CreateDataHandle(
+    const model::PublishPartitionDataRequest& request) const {
+  const auto& data = request.GetData();
+  if (client_settings_.content_addressed_data_handles && data) {
+    return GenerateContentUuid(*data);
+  }
+  return GenerateUuid();
+}
+
 UploadPartitionResponse VersionedLayerClientImpl::UploadPartition(
     const std::string& publication_id, const model::PublishPartition& partition,
     const std::string& layer_id, client::CancellationContext context) {
@@ -528,10 +765,219 @@ UploadBlobResponse VersionedLayerClientImpl::UploadBlob(
     return olp_client_response.GetError();
   }
 
-  auto blob_client = olp_client_response.MoveResult();
+  return UploadBlob(olp_client_response.GetResult(), partition, data_handle,
+                    content_type, content_encoding, layer_id,
+                    std::move(billing_tag), std::move(context));
+}
+
+UploadBlobResponse VersionedLayerClientImpl::UploadBlob(
+    const client::OlpClient& blob_client,
+    const model::PublishPartition& partition, const std::string& data_handle,
+    const std::string& content_type, const std::string& content_encoding,
+    const std::string& layer_id, BillingTag billing_tag,
+    client::CancellationContext context) {
+  if (client_settings_.content_addressed_data_handles) {
+    auto exists_response = BlobApi::checkBlobExists(
+        blob_client, layer_id, data_handle, billing_tag, context);
+    if (!exists_response.IsSuccessful()) {
+      return exists_response.GetError();
+    }
+
+    if (exists_response.GetResult() == http::HttpStatusCode::OK) {
+      OLP_SDK_LOG_DEBUG_F(kLogTag, "Data already exists, data_handle=%s",
+                          data_handle.c_str());
+      return UploadBlobResult();
+    }
+  }
+
+  // The data handle is created before the compression, so the content
+  // addressed handles do not depend on it.
+  auto compressed_partition = partition;
+  compressed_partition.SetData(
+      compressor_.Compress(partition.GetData(), content_encoding));
+
+  const auto& data = compressed_partition.GetData();
+  if (client_settings_.multipart_threshold > 0u && data && data.get() &&
+      data.get()->size() >= client_settings_.multipart_threshold) {
+    return UploadBlobInParts(blob_client, compressed_partition, data_handle,
+                             content_type, content_encoding, layer_id,
+                             billing_tag, context);
+  }
+
   return BlobApi::PutBlob(blob_client, layer_id, content_type, content_encoding,
-                          data_handle, partition.GetData(), billing_tag,
-                          context);
+                          data_handle, data, billing_tag, context);
+}
+
+UploadBlobResponse VersionedLayerClientImpl::UploadBlobInParts(
+    const client::OlpClient& blob_client,
+    const model::PublishPartition& partition, const std::string& data_handle,
+    const std::string& content_type, const std::string& content_encoding,
+    const std::string& layer_id, BillingTag billing_tag,
+    client::CancellationContext context) {
+  auto start_response = BlobApi::StartMultipartUpload(
+      blob_client, layer_id, content_type, content_encoding, data_handle,
+      billing_tag, context);
+  if (!start_response.IsSuccessful()) {
+    return start_response.GetError();
+  }
+
+  // The links of the upload are absolute URLs
+  const auto upload = start_response.MoveResult();
+  const auto data = partition.GetData().get();
+  const auto part_size =
+      std::max(client_settings_.multipart_part_size, kMinMultipartPartSize);
+  const auto parts_count = (data->size() + part_size - 1u) / part_size;
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag,
+                      "Uploading data in parts, data_handle=%s, parts=%zu",
+                      data_handle.c_str(), parts_count);
+
+  // The scheduled tasks may start after the upload completes, so they share
+  // the state with it instead of referencing the client.
+  struct State {
+    State(client::OlpClient client, size_t count)
+        : upload_part_client(std::move(client)),
+          parts(count),
+          contexts(count) {}
+
+    const client::OlpClient upload_part_client;
+    std::vector<model::MultipartUploadPart> parts;
+    std::vector<client::CancellationContext> contexts;
+    std::mutex mutex;
+    std::condition_variable idle;
+    size_t next_part = 0u;
+    size_t active = 0u;
+    boost::optional<client::ApiError> error;
+  };
+  auto state = std::make_shared<State>(
+      client::OlpClient(settings_, upload.GetUploadPartUrl()), parts_count);
+
+  // Cancels the parts that are still uploading.
+  auto cancel_parts = [state]() {
+    for (auto& part_context : state->contexts) {
+      part_context.CancelOperation();
+    }
+  };
+
+  const bool started = context.ExecuteOrCancelled(
+      [&]() { return client::CancellationToken(cancel_parts); });
+
+  auto upload_parts = [state, data, part_size, parts_count, cancel_parts](
+                          const client::RetrySettings& retry_settings,
+                          size_t part_retries) {
+    while (true) {
+      size_t index = 0u;
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        index = state->next_part++;
+        if (index >= parts_count || state->error) {
+          return;
+        }
+        ++state->active;
+      }
+
+      const auto begin = data->begin() + index * part_size;
+      const auto end =
+          data->begin() + std::min(data->size(), (index + 1u) * part_size);
+      auto part_data = std::make_shared<std::vector<unsigned char>>(begin, end);
+      const auto part_number = static_cast<int32_t>(index + 1u);
+      auto& part_context = state->contexts[index];
+
+      auto part_response = BlobApi::UploadPart(
+          state->upload_part_client, part_number, part_data, part_context);
+      for (size_t retry = 0u; !part_response.IsSuccessful() &&
+                              part_response.GetError().ShouldRetry() &&
+                              retry < part_retries &&
+                              !part_context.IsCancelled();
+           ++retry) {
+        // The same backdown as the network requests, checking for the
+        // cancellation in between.
+        auto wait_time =
+            retry_settings.backdown_strategy
+                ? retry_settings.backdown_strategy(
+                      std::chrono::milliseconds(
+                          retry_settings.initial_backdown_period),
+                      retry)
+                : std::chrono::milliseconds::zero();
+        while (wait_time.count() > 0 && !part_context.IsCancelled()) {
+          const auto sleep_time =
+              std::min(std::chrono::milliseconds(100), wait_time);
+          std::this_thread::sleep_for(sleep_time);
+          wait_time -= sleep_time;
+        }
+
+        OLP_SDK_LOG_DEBUG_F(kLogTag, "Retrying part upload, part=%d, retry=%zu",
+                            part_number, retry + 1u);
+        part_response = BlobApi::UploadPart(
+            state->upload_part_client, part_number, part_data, part_context);
+      }
+
+      std::unique_lock<std::mutex> lock(state->mutex);
+      if (part_response.IsSuccessful()) {
+        state->parts[index].SetNumber(part_number);
+        state->parts[index].SetEtag(part_response.GetResult());
+      } else if (!state->error) {
+        // The first error stops the other parts.
+        state->error = part_response.GetError();
+        lock.unlock();
+        cancel_parts();
+        lock.lock();
+      }
+      if (--state->active == 0u) {
+        state->idle.notify_all();
+      }
+    }
+  };
+
+  if (started) {
+    // The calling thread uploads the parts too, so the upload completes even
+    // if the scheduler does not start the tasks.
+    const auto& retry_settings = settings_.retry_settings;
+    const auto part_retries = client_settings_.multipart_part_retries;
+    const auto workers_count = std::min(
+        std::max<size_t>(client_settings_.multipart_parallel_uploads, 1u),
+        parts_count);
+    if (settings_.task_scheduler && workers_count > 1u) {
+      std::vector<thread::TaskScheduler::CallFuncType> tasks;
+      for (size_t worker = 1u; worker < workers_count; ++worker) {
+        tasks.emplace_back(
+            [=]() { upload_parts(retry_settings, part_retries); });
+      }
+      settings_.task_scheduler->ScheduleTasks(std::move(tasks));
+    }
+    upload_parts(retry_settings, part_retries);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->idle.wait(lock, [&]() { return state->active == 0u; });
+  }
+
+  boost::optional<client::ApiError> error = state->error;
+  if (!started || context.IsCancelled()) {
+    error = client::ApiError(client::ErrorCode::Cancelled,
+                             "Operation cancelled.");
+  }
+
+  if (error) {
+    // The uploaded parts are deleted by the service, also after the
+    // cancellation of the operation.
+    if (!upload.GetDeleteUrl().empty()) {
+      const client::OlpClient delete_client(settings_, upload.GetDeleteUrl());
+      auto abort_response = BlobApi::AbortMultipartUpload(
+          delete_client, client::CancellationContext());
+      if (!abort_response.IsSuccessful()) {
+        OLP_SDK_LOG_WARNING_F(
+            kLogTag, "Failed to abort the multipart upload, data_handle=%s",
+            data_handle.c_str());
+      }
+    }
+    return *error;
+  }
+
+  model::MultipartUploadParts upload_parts_request;
+  upload_parts_request.SetParts(state->parts);
+  const client::OlpClient complete_client(settings_, upload.GetCompleteUrl());
+  return BlobApi::CompleteMultipartUpload(complete_client, upload_parts_request,
+                                          context);
 }
 
 client::CancellableFuture<CheckDataExistsResponse>
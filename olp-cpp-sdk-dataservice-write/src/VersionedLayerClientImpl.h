@@ -28,6 +28,7 @@
 #include <olp/core/client/PendingRequests.h>
 #include "CancellationTokenList.h"
 #include "CatalogSettings.h"
+#include "UploadCompressor.h"
 #include "generated/model/Catalog.h"
 
 #include <condition_variable>
@@ -60,6 +61,10 @@ class VersionedLayerClientImpl
   VersionedLayerClientImpl(client::HRN catalog,
                            client::OlpClientSettings settings);
 
+  VersionedLayerClientImpl(client::HRN catalog,
+                           VersionedLayerClientSettings client_settings,
+                           client::OlpClientSettings settings);
+
   virtual ~VersionedLayerClientImpl();
 
   client::CancellableFuture<StartBatchResponse> StartBatch(
@@ -92,6 +97,9 @@ class VersionedLayerClientImpl
 
   void CancelPendingRequests();
 
+  /// Gets the statistics of the data compressed before the upload.
+  CompressionStatistics GetCompressionStatistics() const;
+
   client::CancellableFuture<PublishPartitionDataResponse> PublishToBatch(
       const model::Publication& pub,
       const model::PublishPartitionDataRequest& request);
@@ -101,6 +109,15 @@ class VersionedLayerClientImpl
       const model::PublishPartitionDataRequest& request,
       PublishPartitionDataCallback callback);
 
+  client::CancellableFuture<PublishPartitionsDataResponse> PublishToBatch(
+      const model::Publication& pub,
+      std::vector<model::PublishPartitionDataRequest> requests);
+
+  client::CancellationToken PublishToBatch(
+      const model::Publication& pub,
+      std::vector<model::PublishPartitionDataRequest> requests,
+      PublishPartitionsDataCallback callback);
+
   client::CancellableFuture<CheckDataExistsResponse> CheckDataExists(
       const model::CheckDataExistsRequest& request);
 
@@ -115,6 +132,11 @@ class VersionedLayerClientImpl
       std::shared_ptr<client::CancellationContext> cancel_context,
       InitApiClientsCallback callback);
 
+  /// Returns a random data handle, or the content addressed one when
+  /// enabled in the settings.
+  std::string CreateDataHandle(
+      const model::PublishPartitionDataRequest& request) const;
+
   UploadBlobResponse UploadBlob(const model::PublishPartition& partition,
                                 const std::string& data_handle,
                                 const std::string& content_type,
@@ -123,6 +145,26 @@ class VersionedLayerClientImpl
                                 BillingTag billing_tag,
                                 client::CancellationContext context);
 
+  UploadBlobResponse UploadBlob(const client::OlpClient& blob_client,
+                                const model::PublishPartition& partition,
+                                const std::string& data_handle,
+                                const std::string& content_type,
+                                const std::string& content_encoding,
+                                const std::string& layer_id,
+                                BillingTag billing_tag,
+                                client::CancellationContext context);
+
+  /// Uploads the data in parts, uploading several parts at the same time
+  /// and retrying each part separately.
+  UploadBlobResponse UploadBlobInParts(const client::OlpClient& blob_client,
+                                       const model::PublishPartition& partition,
+                                       const std::string& data_handle,
+                                       const std::string& content_type,
+                                       const std::string& content_encoding,
+                                       const std::string& layer_id,
+                                       BillingTag billing_tag,
+                                       client::CancellationContext context);
+
   UploadPartitionResponse UploadPartition(
       const std::string& publication_id,
       const model::PublishPartition& partition, const std::string& layer_id,
@@ -130,6 +172,8 @@ class VersionedLayerClientImpl
 
   client::HRN catalog_;
   client::OlpClientSettings settings_;
+  VersionedLayerClientSettings client_settings_;
+  UploadCompressor compressor_;
 
   CatalogSettings catalog_settings_;
 
@@ -29,6 +29,13 @@ VolatileLayerClient::VolatileLayerClient(client::HRN catalog,
     : impl_(std::make_shared<VolatileLayerClientImpl>(std::move(catalog),
                                                       std::move(settings))) {}
 
+VolatileLayerClient::VolatileLayerClient(
+    client::HRN catalog, VolatileLayerClientSettings client_settings,
+    client::OlpClientSettings settings)
+    : impl_(std::make_shared<VolatileLayerClientImpl>(
+          std::move(catalog), std::move(client_settings),
+          std::move(settings))) {}
+
 void VolatileLayerClient::CancelPendingRequests() {
   impl_->CancelPendingRequests();
 }
@@ -45,6 +52,19 @@ olp::client::CancellationToken VolatileLayerClient::PublishPartitionData(
   return impl_->PublishPartitionData(request, std::move(callback));
 }
 
+olp::client::CancellableFuture<PublishPartitionsDataResponse>
+VolatileLayerClient::PublishPartitionsData(
+    std::vector<model::PublishPartitionDataRequest> requests) {
+  return impl_->PublishPartitionsData(std::move(requests));
+}
+
+olp::client::CancellationToken VolatileLayerClient::PublishPartitionsData(
+    std::vector<model::PublishPartitionDataRequest> requests,
+    PublishPartitionsDataCallback callback) {
+  return impl_->PublishPartitionsData(std::move(requests),
+                                      std::move(callback));
+}
+
 olp::client::CancellableFuture<GetBaseVersionResponse>
 VolatileLayerClient::GetBaseVersion() {
   return impl_->GetBaseVersion();
@@ -19,6 +19,12 @@
 
 #include "VolatileLayerClientImpl.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <utility>
+
 #include <boost/format.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -46,8 +52,16 @@ namespace dataservice {
 namespace write {
 VolatileLayerClientImpl::VolatileLayerClientImpl(
     client::HRN catalog, client::OlpClientSettings settings)
+    : VolatileLayerClientImpl(std::move(catalog),
+                              VolatileLayerClientSettings{},
+                              std::move(settings)) {}
+
+VolatileLayerClientImpl::VolatileLayerClientImpl(
+    client::HRN catalog, VolatileLayerClientSettings client_settings,
+    client::OlpClientSettings settings)
     : catalog_(catalog),
       settings_(settings),
+      client_settings_(std::move(client_settings)),
       catalog_settings_(catalog, settings),
       pending_requests_(std::make_shared<client::PendingRequests>()),
       task_scheduler_(settings.task_scheduler) {}
@@ -394,6 +408,249 @@ client::CancellationToken VolatileLayerClientImpl::PublishPartitionData(
                  std::move(callback));
 }
 
+client::CancellableFuture<PublishPartitionsDataResponse>
+VolatileLayerClientImpl::PublishPartitionsData(
+    std::vector<model::PublishPartitionDataRequest> requests) {
+  auto promise =
+      std::make_shared<std::promise<PublishPartitionsDataResponse>>();
+  auto cancel_token = PublishPartitionsData(
+      std::move(requests), [promise](PublishPartitionsDataResponse response) {
+        promise->set_value(std::move(response));
+      });
+  return client::CancellableFuture<PublishPartitionsDataResponse>(
+      cancel_token, promise);
+}
+
+client::CancellationToken VolatileLayerClientImpl::PublishPartitionsData(
+    std::vector<model::PublishPartitionDataRequest> requests,
+    PublishPartitionsDataCallback callback) {
+  for (const auto& request : requests) {
+    if (request.GetLayerId().empty() || !request.GetData() ||
+        !request.GetPartitionId()) {
+      callback(PublishPartitionsDataResponse(client::ApiError(
+          client::ErrorCode::InvalidArgument,
+          "Request layer id, data or partition id is not defined.")));
+      return client::CancellationToken();
+    }
+  }
+
+  auto publish_task = [=](client::CancellationContext context)
+      -> PublishPartitionsDataResponse {
+    // Coalesce the requests of the same partition, the last one wins
+    std::vector<model::PublishPartitionDataRequest> partitions;
+    std::map<std::pair<std::string, std::string>, size_t> partition_indexes;
+    for (const auto& request : requests) {
+      auto key =
+          std::make_pair(request.GetLayerId(), request.GetPartitionId().get());
+      auto it = partition_indexes.find(key);
+      if (it == partition_indexes.end()) {
+        partition_indexes.emplace(std::move(key), partitions.size());
+        partitions.push_back(request);
+      } else {
+        partitions[it->second] = request;
+      }
+    }
+
+    if (partitions.empty()) {
+      return PublishPartitionsDataResult{};
+    }
+
+    std::map<std::string, std::vector<size_t>> layers;
+    std::map<std::string, CatalogSettings::LayerSettings> layers_settings;
+    for (size_t index = 0u; index < partitions.size(); ++index) {
+      const auto& request = partitions[index];
+      const auto& layer_id = request.GetLayerId();
+      layers[layer_id].push_back(index);
+      if (layers_settings.count(layer_id) != 0u) {
+        continue;
+      }
+
+      auto layer_settings_response = catalog_settings_.GetLayerSettings(
+          context, request.GetBillingTag(), layer_id);
+      if (!layer_settings_response.IsSuccessful()) {
+        return layer_settings_response.GetError();
+      }
+      if (layer_settings_response.GetResult().content_type.empty()) {
+        auto errmsg = boost::format(
+                          "Unable to find the Layer ID (%1%) "
+                          "provided in the PublishPartitionDataRequest "
+                          "in the Catalog specified when creating "
+                          "this VolatileLayerClient instance.") %
+                      layer_id;
+        return client::ApiError(client::ErrorCode::InvalidArgument,
+                                errmsg.str());
+      }
+      layers_settings[layer_id] = layer_settings_response.MoveResult();
+    }
+
+    // The query service accepts up to 100 partitions per request
+    const size_t kMaxPartitionsPerQuery = 100u;
+    std::vector<std::vector<size_t>> groups;
+    for (const auto& layer : layers) {
+      const auto& indexes = layer.second;
+      for (size_t begin = 0u; begin < indexes.size();
+           begin += kMaxPartitionsPerQuery) {
+        const auto end =
+            std::min(begin + kMaxPartitionsPerQuery, indexes.size());
+        groups.emplace_back(indexes.begin() + begin, indexes.begin() + end);
+      }
+    }
+
+    auto query_client_response = ApiClientLookup::LookupApiClient(
+        catalog_, context, "query", "v1", settings_);
+    if (!query_client_response.IsSuccessful()) {
+      return query_client_response.GetError();
+    }
+    const auto query_client = query_client_response.MoveResult();
+
+    auto blob_client_response = ApiClientLookup::LookupApiClient(
+        catalog_, context, "volatile-blob", "v1", settings_);
+    if (!blob_client_response.IsSuccessful()) {
+      return blob_client_response.GetError();
+    }
+    const auto blob_client = blob_client_response.MoveResult();
+
+    // The queries of the groups use the first contexts, the uploads of the
+    // partitions the remaining ones
+    std::vector<client::CancellationContext> contexts(groups.size() +
+                                                      partitions.size());
+    const bool started = context.ExecuteOrCancelled([&]() {
+      return client::CancellationToken([contexts]() mutable {
+        for (auto& request_context : contexts) {
+          request_context.CancelOperation();
+        }
+      });
+    });
+    if (!started) {
+      return {{client::ErrorCode::Cancelled, "Operation cancelled."}};
+    }
+
+    // A work item either queries the data handles of a group, or uploads the
+    // data of a partition. The uploads of a group are queued as soon as its
+    // data handles arrive, so they overlap with the queries of the next groups.
+    struct WorkItem {
+      bool query;
+      size_t index;
+    };
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<WorkItem> items;
+    size_t active_items = 0u;
+    boost::optional<client::ApiError> error;
+    std::vector<std::string> data_handles(partitions.size());
+    for (size_t index = 0u; index < groups.size(); ++index) {
+      items.push_back(WorkItem{true, index});
+    }
+
+    auto query_group = [&](size_t index, std::vector<WorkItem>& next_items)
+        -> boost::optional<client::ApiError> {
+      const auto& group = groups[index];
+      const auto& layer_id = partitions[group.front()].GetLayerId();
+      std::vector<std::string> partition_ids;
+      partition_ids.reserve(group.size());
+      for (auto partition_index : group) {
+        partition_ids.push_back(
+            partitions[partition_index].GetPartitionId().get());
+      }
+
+      auto response =
+          GetDataHandleMap(query_client, layer_id, partition_ids, boost::none,
+                           boost::none, boost::none, contexts[index]);
+      if (!response.IsSuccessful()) {
+        return response.GetError();
+      }
+
+      const auto& data_handle_map = response.GetResult();
+      for (auto partition_index : group) {
+        auto it = data_handle_map.find(
+            partitions[partition_index].GetPartitionId().get());
+        if (it == data_handle_map.end()) {
+          return client::ApiError(
+              client::ErrorCode::InvalidArgument,
+              "Unable to find requested partition,the partition "
+              "metadata has to exist in OLP before invoking this API.");
+        }
+        data_handles[partition_index] = it->second;
+        next_items.push_back(WorkItem{false, partition_index});
+      }
+      return boost::none;
+    };
+
+    auto upload_partition =
+        [&](size_t index) -> boost::optional<client::ApiError> {
+      const auto& request = partitions[index];
+      const auto& layer_settings = layers_settings.at(request.GetLayerId());
+      auto response = BlobApi::PutBlob(
+          blob_client, request.GetLayerId(), layer_settings.content_type,
+          layer_settings.content_encoding, data_handles[index],
+          request.GetData(), request.GetBillingTag(),
+          contexts[groups.size() + index]);
+      if (!response.IsSuccessful()) {
+        return response.GetError();
+      }
+      return boost::none;
+    };
+
+    auto work = [&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        condition.wait(lock, [&]() {
+          return error || !items.empty() || active_items == 0u;
+        });
+        if (error || items.empty()) {
+          return;
+        }
+
+        const auto item = items.front();
+        items.pop_front();
+        ++active_items;
+        lock.unlock();
+
+        std::vector<WorkItem> next_items;
+        auto item_error = item.query ? query_group(item.index, next_items)
+                                     : upload_partition(item.index);
+
+        lock.lock();
+        --active_items;
+        if (item_error && !error) {
+          error = std::move(item_error);
+        }
+        items.insert(items.end(), next_items.begin(), next_items.end());
+        condition.notify_all();
+      }
+    };
+
+    std::vector<std::thread> workers;
+    const auto workers_count =
+        std::min(std::max<size_t>(client_settings_.parallel_requests, 1u),
+                 partitions.size());
+    for (size_t worker = 1u; worker < workers_count; ++worker) {
+      workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    if (error) {
+      return *error;
+    }
+
+    PublishPartitionsDataResult result;
+    result.reserve(partitions.size());
+    for (const auto& request : partitions) {
+      model::ResponseOkSingle response;
+      response.SetTraceID(request.GetPartitionId().get());
+      result.push_back(std::move(response));
+    }
+    return result;
+  };
+
+  return AddTask(task_scheduler_, pending_requests_, std::move(publish_task),
+                 std::move(callback));
+}
+
 client::CancellableFuture<GetBatchResponse> VolatileLayerClientImpl::GetBatch(
     const model::Publication& pub) {
   auto promise = std::make_shared<std::promise<GetBatchResponse>>();
@@ -484,9 +741,21 @@ DataHandleMapResponse VolatileLayerClientImpl::GetDataHandleMap(
     return api_response.GetError();
   }
 
+  return GetDataHandleMap(api_response.GetResult(), layer_id, partition_ids,
+                          std::move(version), std::move(additional_fields),
+                          std::move(billing_tag), std::move(context));
+}
+
+DataHandleMapResponse VolatileLayerClientImpl::GetDataHandleMap(
+    const client::OlpClient& query_client, const std::string& layer_id,
+    const std::vector<std::string>& partition_ids,
+    boost::optional<int64_t> version,
+    boost::optional<std::vector<std::string>> additional_fields,
+    boost::optional<std::string> billing_tag,
+    client::CancellationContext context) {
   auto partitions_response = QueryApi::GetPartitionsById(
-      api_response.GetResult(), layer_id, partition_ids, version,
-      additional_fields, billing_tag, context);
+      query_client, layer_id, partition_ids, version, additional_fields,
+      billing_tag, context);
 
   if (!partitions_response.IsSuccessful()) {
     return partitions_response.GetError();
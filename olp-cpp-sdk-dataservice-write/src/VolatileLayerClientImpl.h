@@ -55,6 +55,10 @@ class VolatileLayerClientImpl
   VolatileLayerClientImpl(client::HRN catalog,
                           client::OlpClientSettings settings);
 
+  VolatileLayerClientImpl(client::HRN catalog,
+                          VolatileLayerClientSettings client_settings,
+                          client::OlpClientSettings settings);
+
   virtual ~VolatileLayerClientImpl();
 
   olp::client::CancellableFuture<GetBaseVersionResponse> GetBaseVersion();
@@ -73,6 +77,14 @@ class VolatileLayerClientImpl
       const model::PublishPartitionDataRequest& request,
       PublishPartitionDataCallback callback);
 
+  olp::client::CancellableFuture<PublishPartitionsDataResponse>
+  PublishPartitionsData(
+      std::vector<model::PublishPartitionDataRequest> requests);
+
+  olp::client::CancellationToken PublishPartitionsData(
+      std::vector<model::PublishPartitionDataRequest> requests,
+      PublishPartitionsDataCallback callback);
+
   client::CancellableFuture<StartBatchResponse> StartBatch(
       const model::StartBatchRequest& request);
 
@@ -112,11 +124,21 @@ class VolatileLayerClientImpl
       boost::optional<std::string> billingTag,
       const client::CancellationContext context);
 
+  DataHandleMapResponse GetDataHandleMap(
+      const client::OlpClient& query_client, const std::string& layer_id,
+      const std::vector<std::string>& partition_ids,
+      boost::optional<int64_t> version,
+      boost::optional<std::vector<std::string>> additional_fields,
+      boost::optional<std::string> billing_tag,
+      client::CancellationContext context);
+
  private:
   client::HRN catalog_;
 
   client::OlpClientSettings settings_;
 
+  VolatileLayerClientSettings client_settings_;
+
   CatalogSettings catalog_settings_;
 
   std::shared_ptr<client::OlpClient> apiclient_config_;
@@ -24,11 +24,20 @@
 
 #include <olp/core/client/HttpResponse.h>
 #include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/http/NetworkUtils.h>
+// clang-format off
+// Ordering Required - Parser template specializations before #include "JsonResultParser.h"
+#include <generated/parser/MultipartUploadParser.h>
+#include "JsonResultParser.h"
+#include <generated/serializer/MultipartUploadPartsSerializer.h>
+#include <generated/serializer/JsonSerializer.h>
+// clang-format on
 
 namespace client = olp::client;
 
 namespace {
 const std::string kQueryParamBillingTag = "billingTag";
+const std::string kQueryParamPartNumber = "partNumber";
 }  // namespace
 
 namespace olp {
@@ -111,6 +120,140 @@ PutBlobResponse BlobApi::PutBlob(
   return PutBlobResponse(client::ApiNoResult());
 }
 
+StartMultipartUploadResponse BlobApi::StartMultipartUpload(
+    const client::OlpClient& client, const std::string& layer_id,
+    const std::string& content_type, const std::string& content_encoding,
+    const std::string& data_handle,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  rapidjson::Document body;
+  auto& allocator = body.GetAllocator();
+  body.SetObject();
+  body.AddMember("contentType", rapidjson::StringRef(content_type.c_str()),
+                 allocator);
+  if (!content_encoding.empty()) {
+    body.AddMember("contentEncoding",
+                   rapidjson::StringRef(content_encoding.c_str()), allocator);
+  }
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  body.Accept(writer);
+  auto data = std::make_shared<std::vector<unsigned char>>(
+      buffer.GetString(), buffer.GetString() + buffer.GetSize());
+
+  std::string start_multipart_uri =
+      "/layers/" + layer_id + "/data/" + data_handle + "/multiparts";
+
+  auto http_response = client.CallApi(
+      std::move(start_multipart_uri), "POST", std::move(query_params),
+      std::move(header_params), std::move(form_params), std::move(data),
+      "application/json", context);
+
+  if (http_response.status != olp::http::HttpStatusCode::OK) {
+    return StartMultipartUploadResponse(
+        client::ApiError(http_response.status, http_response.response.str()));
+  }
+
+  auto response = parser::parse_result<StartMultipartUploadResponse>(
+      http_response.response);
+  if (response.IsSuccessful() &&
+      (response.GetResult().GetUploadPartUrl().empty() ||
+       response.GetResult().GetCompleteUrl().empty())) {
+    return StartMultipartUploadResponse(
+        client::ApiError(client::ErrorCode::Unknown,
+                         "Multipart upload links are missing."));
+  }
+  return response;
+}
+
+UploadPartResponse BlobApi::UploadPart(
+    const client::OlpClient& client, int32_t part_number,
+    const std::shared_ptr<std::vector<unsigned char>>& data,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  query_params.insert(
+      std::make_pair(kQueryParamPartNumber, std::to_string(part_number)));
+
+  auto http_response = client.CallApi(
+      "", "POST", std::move(query_params), std::move(header_params),
+      std::move(form_params), data, "application/octet-stream", context);
+
+  if (http_response.status != olp::http::HttpStatusCode::OK &&
+      http_response.status != olp::http::HttpStatusCode::NO_CONTENT) {
+    return UploadPartResponse(
+        client::ApiError(http_response.status, http_response.response.str()));
+  }
+
+  for (const auto& header : http_response.GetHeaders()) {
+    if (http::NetworkUtils::CaseInsensitiveCompare(header.first, "ETag")) {
+      return UploadPartResponse(header.second);
+    }
+  }
+
+  return UploadPartResponse(client::ApiError(
+      client::ErrorCode::Unknown, "ETag of the uploaded part is missing."));
+}
+
+CompleteMultipartUploadResponse BlobApi::CompleteMultipartUpload(
+    const client::OlpClient& client, const model::MultipartUploadParts& parts,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  auto serialized_parts = serializer::serialize(parts);
+  auto data = std::make_shared<std::vector<unsigned char>>(
+      serialized_parts.begin(), serialized_parts.end());
+
+  auto http_response = client.CallApi(
+      "", "PUT", std::move(query_params), std::move(header_params),
+      std::move(form_params), std::move(data), "application/json", context);
+
+  if (http_response.status != olp::http::HttpStatusCode::OK &&
+      http_response.status != olp::http::HttpStatusCode::NO_CONTENT) {
+    return CompleteMultipartUploadResponse(
+        client::ApiError(http_response.status, http_response.response.str()));
+  }
+
+  return CompleteMultipartUploadResponse(client::ApiNoResult());
+}
+
+AbortMultipartUploadResponse BlobApi::AbortMultipartUpload(
+    const client::OlpClient& client, client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  auto http_response = client.CallApi(
+      "", "DELETE", std::move(query_params), std::move(header_params),
+      std::move(form_params), nullptr, "", context);
+
+  if (http_response.status != olp::http::HttpStatusCode::OK &&
+      http_response.status != olp::http::HttpStatusCode::NO_CONTENT) {
+    return AbortMultipartUploadResponse(
+        client::ApiError(http_response.status, http_response.response.str()));
+  }
+
+  return AbortMultipartUploadResponse(client::ApiNoResult());
+}
+
 client::CancellationToken BlobApi::deleteBlob(
     const client::OlpClient& client, const std::string& layer_id,
     const std::string& data_handle,
@@ -174,6 +317,36 @@ client::CancellationToken BlobApi::checkBlobExists(
   return cancel_token;
 }
 
+CheckBlobRespone BlobApi::checkBlobExists(
+    const client::OlpClient& client, const std::string& layer_id,
+    const std::string& data_handle,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  std::string check_blob_uri = "/layers/" + layer_id + "/data/" + data_handle;
+  auto http_response = client.CallApi(
+      std::move(check_blob_uri), "HEAD", std::move(query_params),
+      std::move(header_params), std::move(form_params), nullptr, "", context);
+
+  if (http_response.status == http::HttpStatusCode::OK ||
+      http_response.status == http::HttpStatusCode::NOT_FOUND) {
+    return CheckBlobRespone(http_response.status);
+  }
+
+  return CheckBlobRespone(
+      client::ApiError(http_response.status, http_response.response.str()));
+}
+
 }  // namespace write
 }  // namespace dataservice
 }  // namespace olp
@@ -21,12 +21,14 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/OlpClient.h>
+#include "generated/model/MultipartUpload.h"
 
 namespace olp {
 namespace dataservice {
@@ -40,6 +42,13 @@ using DeleteBlobRespone =
 using DeleteBlobCallback = std::function<void(DeleteBlobRespone)>;
 using CheckBlobRespone = client::ApiResponse<int, client::ApiError>;
 using CheckBlobCallback = std::function<void(CheckBlobRespone)>;
+using StartMultipartUploadResponse =
+    client::ApiResponse<model::MultipartUpload, client::ApiError>;
+using UploadPartResponse = client::ApiResponse<std::string, client::ApiError>;
+using CompleteMultipartUploadResponse =
+    client::ApiResponse<client::ApiNoResult, client::ApiError>;
+using AbortMultipartUploadResponse =
+    client::ApiResponse<client::ApiNoResult, client::ApiError>;
 
 /**
  * @brief The blob service supports the upload and retrieval of large volumes of
@@ -98,6 +107,75 @@ class BlobApi {
       const boost::optional<std::string>& billing_tag,
       client::CancellationContext cancel_contex);
 
+  /**
+   * @brief Starts a multipart upload of a data blob
+   * Use this upload mechanism for blobs larger than 50 MB. The data is then
+   * uploaded in parts with \c UploadPart, the parts can be uploaded in
+   * parallel, and the upload is finished with \c CompleteMultipartUpload.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id The ID of the layer that the data blob belongs to.
+   * @param content_type The content type configured for the target layer.
+   * @param content_encoding The content encoding configured for the target
+   * layer.
+   * @param data_handle The data handle (ID) represents an identifier for the
+   * data blob.
+   * @param billing_tag Optional. An optional free-form tag which is used for
+   * grouping billing records together. If supplied, it must be between 4 - 16
+   * characters, contain only alpha/numeric ASCII characters [A-Za-z0-9].
+   * @param context The context used to cancel the request.
+   *
+   * @return The links of the started upload or an error.
+   */
+  static StartMultipartUploadResponse StartMultipartUpload(
+      const client::OlpClient& client, const std::string& layer_id,
+      const std::string& content_type, const std::string& content_encoding,
+      const std::string& data_handle,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
+
+  /**
+   * @brief Uploads a part of a multipart upload
+   * All parts except the last one must be at least 5 MB large.
+   * @param client Instance of OlpClient used to make REST request, with the
+   * upload part link of the started upload as the base URL.
+   * @param part_number The number of the part, starting from 1.
+   * @param data The data of the part.
+   * @param context The context used to cancel the request.
+   *
+   * @return The ETag of the uploaded part or an error.
+   */
+  static UploadPartResponse UploadPart(
+      const client::OlpClient& client, int32_t part_number,
+      const std::shared_ptr<std::vector<unsigned char>>& data,
+      client::CancellationContext context);
+
+  /**
+   * @brief Completes a multipart upload
+   * The service assembles the data blob from the parts asynchronously, the
+   * progress is reported by the status link of the upload.
+   * @param client Instance of OlpClient used to make REST request, with the
+   * complete link of the started upload as the base URL.
+   * @param parts All uploaded parts in the order of their numbers.
+   * @param context The context used to cancel the request.
+   *
+   * @return An error if the upload could not be completed.
+   */
+  static CompleteMultipartUploadResponse CompleteMultipartUpload(
+      const client::OlpClient& client, const model::MultipartUploadParts& parts,
+      client::CancellationContext context);
+
+  /**
+   * @brief Aborts a multipart upload
+   * The service deletes the parts that are already uploaded.
+   * @param client Instance of OlpClient used to make REST request, with the
+   * delete link of the started upload as the base URL.
+   * @param context The context used to cancel the request.
+   *
+   * @return An error if the upload could not be aborted.
+   */
+  static AbortMultipartUploadResponse AbortMultipartUpload(
+      const client::OlpClient& client, client::CancellationContext context);
+
   /**
    * @brief Delete a data blob
    * Deletes a data blob from the underlying storage mechanism (volume). When
@@ -140,6 +218,15 @@ class BlobApi {
       const std::string& data_handle,
       const boost::optional<std::string>& billing_tag,
       const CheckBlobCallback& callback);
+
+  /**
+   * @brief Synchronous version of \c checkBlobExists method.
+   */
+  static CheckBlobRespone checkBlobExists(
+      const client::OlpClient& client, const std::string& layer_id,
+      const std::string& data_handle,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
 };
 
 }  // namespace write
@@ -92,6 +92,15 @@ InsertIndexesResponse IndexApi::InsertIndexes(
     const std::string& layer_id,
     const boost::optional<std::string>& billing_tag,
     client::CancellationContext context) {
+  return InsertIndexes(client, std::vector<model::Index>{indexes}, layer_id,
+                       billing_tag, std::move(context));
+}
+
+InsertIndexesResponse IndexApi::InsertIndexes(
+    const client::OlpClient& client, const std::vector<model::Index>& indexes,
+    const std::string& layer_id,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
   std::multimap<std::string, std::string> header_params;
   std::multimap<std::string, std::string> query_params;
   std::multimap<std::string, std::string> form_params;
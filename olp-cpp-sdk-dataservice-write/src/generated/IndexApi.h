@@ -21,6 +21,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
@@ -105,6 +106,16 @@ class IndexApi {
       const boost::optional<std::string>& billing_tag,
       client::CancellationContext context);
 
+  /**
+   * @brief Synchronous version of \c insertIndexes method that inserts the
+   * index data of many data blobs with one request.
+   */
+  static InsertIndexesResponse InsertIndexes(
+      const client::OlpClient& client, const std::vector<model::Index>& indexes,
+      const std::string& layer_id,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
+
   /**
    * @brief Updates index layer partitions
    * Modifies partitions in an index layer.
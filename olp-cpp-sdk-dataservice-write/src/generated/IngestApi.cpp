@@ -22,6 +22,7 @@
 #include <map>
 #include <memory>
 #include <sstream>
+#include <utility>
 
 #include <olp/core/client/HttpResponse.h>
 #include <olp/core/client/OlpClient.h>
@@ -44,6 +45,25 @@ const std::string kHeaderParamTraceId = "X-HERE-TraceId";
 const std::string kQueryParamBillingTag = "billingTag";
 
 constexpr auto kLogTag = "IngestApi";
+
+void AddSdiiParams(const boost::optional<std::string>& trace_id,
+                   const boost::optional<std::string>& billing_tag,
+                   const boost::optional<std::string>& checksum,
+                   std::multimap<std::string, std::string>& header_params,
+                   std::multimap<std::string, std::string>& query_params) {
+  header_params.insert(std::make_pair("Accept", "application/json"));
+  if (trace_id) {
+    header_params.insert(std::make_pair(kHeaderParamTraceId, trace_id.get()));
+  }
+  if (checksum) {
+    header_params.insert(std::make_pair(kHeaderParamChecksum, checksum.get()));
+  }
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+}
 }  // namespace
 
 namespace olp {
@@ -150,19 +170,7 @@ IngestSdiiResponse IngestApi::IngestSdii(
   std::multimap<std::string, std::string> header_params;
   std::multimap<std::string, std::string> query_params;
   std::multimap<std::string, std::string> form_params;
-
-  header_params.insert(std::make_pair("Accept", "application/json"));
-  if (trace_id) {
-    header_params.insert(std::make_pair(kHeaderParamTraceId, trace_id.get()));
-  }
-  if (checksum) {
-    header_params.insert(std::make_pair(kHeaderParamChecksum, checksum.get()));
-  }
-
-  if (billing_tag) {
-    query_params.insert(
-        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
-  }
+  AddSdiiParams(trace_id, billing_tag, checksum, header_params, query_params);
 
   std::string ingest_uri = "/layers/" + layer_id + "/sdiiMessageList";
   auto response = client.CallApi(ingest_uri, "POST", query_params,
@@ -176,6 +184,31 @@ IngestSdiiResponse IngestApi::IngestSdii(
   return parser::parse_result<IngestSdiiResponse>(response.response);
 }
 
+IngestSdiiResponse IngestApi::IngestSdii(
+    const client::OlpClient& client, const std::string& layer_id,
+    http::NetworkRequest::BodySourceCallback sdii_message_list_source,
+    std::int64_t sdii_message_list_size,
+    const boost::optional<std::string>& trace_id,
+    const boost::optional<std::string>& billing_tag,
+    const boost::optional<std::string>& checksum,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  AddSdiiParams(trace_id, billing_tag, checksum, header_params, query_params);
+
+  std::string ingest_uri = "/layers/" + layer_id + "/sdiiMessageList";
+  auto response = client.CallApi(
+      std::move(ingest_uri), "POST", std::move(query_params),
+      std::move(header_params), std::move(sdii_message_list_source),
+      sdii_message_list_size, "application/x-protobuf", std::move(context));
+
+  if (response.status != olp::http::HttpStatusCode::OK) {
+    return IngestSdiiResponse(
+        client::ApiError(response.status, response.response.str()));
+  }
+  return parser::parse_result<IngestSdiiResponse>(response.response);
+}
+
 }  // namespace write
 }  // namespace dataservice
 }  // namespace olp
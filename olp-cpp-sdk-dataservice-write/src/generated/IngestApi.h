@@ -19,12 +19,14 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include <boost/optional.hpp>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiResponse.h>
+#include <olp/core/http/NetworkRequest.h>
 
 namespace olp {
 namespace client {
@@ -156,6 +158,33 @@ class IngestApi {
       const boost::optional<std::string>& billing_tag,
       const boost::optional<std::string>& checksum,
       client::CancellationContext context);
+
+  /**
+   * @brief Send list of SDII messages to a stream layer, reading the SDII
+   * MessageList data from the callback while the request is sent.
+   *
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id Layer of the catalog where you want to store the data.
+   * @param sdii_message_list_source The callback that reads the SDII
+   * MessageList data on the network thread.
+   * @param sdii_message_list_size The size of the data, or
+   * `http::NetworkRequest::kUnknownBodySize`.
+   * @param trace_id Optional. A unique message ID, such as a UUID.
+   * @param billing_tag Optional. An optional free-form tag which is used for
+   * grouping billing records together.
+   * @param checksum Optional. A SHA-256 hash of the data.
+   * @param context A CancellationContext, which can be used to cancel request.
+   *
+   * @return A IngestSdiiResponse which contains error or ResponseOk
+   */
+  static IngestSdiiResponse IngestSdii(
+      const client::OlpClient& client, const std::string& layer_id,
+      http::NetworkRequest::BodySourceCallback sdii_message_list_source,
+      std::int64_t sdii_message_list_size,
+      const boost::optional<std::string>& trace_id,
+      const boost::optional<std::string>& billing_tag,
+      const boost::optional<std::string>& checksum,
+      client::CancellationContext context);
 };
 
 }  // namespace write
@@ -21,10 +21,10 @@
 
 namespace olp {
 namespace serializer {
-void to_json(const dataservice::write::model::Index &x, rapidjson::Value &value,
-             rapidjson::Document::AllocatorType &allocator) {
+namespace {
+rapidjson::Value IndexToJson(const dataservice::write::model::Index &x,
+                             rapidjson::Document::AllocatorType &allocator) {
   rapidjson::Value jsonValue(rapidjson::kObjectType);
-  value.SetArray();
   jsonValue.AddMember("id", rapidjson::StringRef(x.GetId().c_str()), allocator);
 
   rapidjson::Value indexFields(rapidjson::kObjectType);
@@ -78,7 +78,24 @@ void to_json(const dataservice::write::model::Index &x, rapidjson::Value &value,
   if (x.GetSize()) {
     jsonValue.AddMember("size", x.GetSize().get(), allocator);
   }
-  value.PushBack(jsonValue, allocator);
+  return jsonValue;
+}
+}  // namespace
+
+void to_json(const dataservice::write::model::Index &x, rapidjson::Value &value,
+             rapidjson::Document::AllocatorType &allocator) {
+  value.SetArray();
+  value.PushBack(IndexToJson(x, allocator), allocator);
+}
+
+void to_json(const std::vector<dataservice::write::model::Index> &x,
+             rapidjson::Value &value,
+             rapidjson::Document::AllocatorType &allocator) {
+  value.SetArray();
+  value.Reserve(static_cast<rapidjson::SizeType>(x.size()), allocator);
+  for (const auto &index : x) {
+    value.PushBack(IndexToJson(index, allocator), allocator);
+  }
 }
 
 }  // namespace serializer
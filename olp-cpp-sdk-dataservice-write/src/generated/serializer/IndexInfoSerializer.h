@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <rapidjson/document.h>
 
 #include <olp/dataservice/write/generated/model/Index.h>
@@ -27,5 +29,9 @@ namespace olp {
 namespace serializer {
 void to_json(const dataservice::write::model::Index& x, rapidjson::Value& value,
              rapidjson::Document::AllocatorType& allocator);
+
+void to_json(const std::vector<dataservice::write::model::Index>& x,
+             rapidjson::Value& value,
+             rapidjson::Document::AllocatorType& allocator);
 }  // namespace serializer
 }  // namespace olp
@@ -19,24 +19,58 @@
 
 #pragma once
 
+#include <string>
+
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
 namespace olp {
 namespace serializer {
+namespace detail {
+
+/// The buffer larger than this is released after the call instead of being
+/// kept for the next one.
+constexpr size_t kMaxRetainedBufferSize = 1024u * 1024u;
+
+// The models with a `to_json(model, writer)` overload are written directly,
+// without building a document first.
 template <typename T>
-inline std::string serialize(const T& object) {
+inline auto write_json(const T& object,
+                       rapidjson::Writer<rapidjson::StringBuffer>& writer, int)
+    -> decltype(to_json(object, writer), void()) {
+  to_json(object, writer);
+}
+
+template <typename T>
+inline void write_json(const T& object,
+                       rapidjson::Writer<rapidjson::StringBuffer>& writer,
+                       long) {
   rapidjson::Document doc;
   auto& allocator = doc.GetAllocator();
 
   doc.SetObject();
   to_json(object, doc, allocator);
+  doc.Accept(writer);
+}
+
+}  // namespace detail
+
+template <typename T>
+inline std::string serialize(const T& object) {
+  // The buffer keeps its capacity between the calls on the same thread.
+  static thread_local rapidjson::StringBuffer buffer;
+  buffer.Clear();
 
-  rapidjson::StringBuffer buffer;
   rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-  doc.Accept(writer);
-  return buffer.GetString();
+  detail::write_json(object, writer, 0);
+  std::string result(buffer.GetString(), buffer.GetSize());
+
+  if (buffer.GetSize() > detail::kMaxRetainedBufferSize) {
+    buffer.Clear();
+    buffer.ShrinkToFit();
+  }
+  return result;
 }
 
 }  // namespace serializer
@@ -53,6 +53,36 @@ void to_json(const dataservice::write::model::PublishDataRequest& x,
   }
 }
 
+void to_json(const dataservice::write::model::PublishDataRequest& x,
+             rapidjson::Writer<rapidjson::StringBuffer>& writer) {
+  writer.StartObject();
+  if (x.GetData()) {
+    const auto& data = x.GetData().get();
+    writer.Key("data");
+    writer.String(reinterpret_cast<const char*>(data->data()),
+                  static_cast<rapidjson::SizeType>(data->size()));
+  }
+
+  writer.Key("layerId");
+  writer.String(x.GetLayerId().c_str());
+
+  if (x.GetTraceId()) {
+    writer.Key("traceId");
+    writer.String(x.GetTraceId().get().c_str());
+  }
+
+  if (x.GetBillingTag()) {
+    writer.Key("billingTag");
+    writer.String(x.GetBillingTag().get().c_str());
+  }
+
+  if (x.GetChecksum()) {
+    writer.Key("checksum");
+    writer.String(x.GetChecksum().get().c_str());
+  }
+  writer.EndObject();
+}
+
 }  // namespace serializer
 
 }  // namespace olp
@@ -20,6 +20,8 @@
 #pragma once
 
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 #include <olp/dataservice/write/model/PublishDataRequest.h>
 
@@ -28,5 +30,8 @@ namespace serializer {
 void to_json(const dataservice::write::model::PublishDataRequest& x,
              rapidjson::Value& value,
              rapidjson::Document::AllocatorType& allocator);
+
+void to_json(const dataservice::write::model::PublishDataRequest& x,
+             rapidjson::Writer<rapidjson::StringBuffer>& writer);
 }  // namespace serializer
 }  // namespace olp
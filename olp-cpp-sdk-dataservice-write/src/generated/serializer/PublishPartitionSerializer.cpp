@@ -63,6 +63,48 @@ void to_json(const dataservice::write::model::PublishPartition& x,
   }
 }
 
+void to_json(const dataservice::write::model::PublishPartition& x,
+             rapidjson::Writer<rapidjson::StringBuffer>& writer) {
+  writer.StartObject();
+  if (x.GetPartition()) {
+    writer.Key("partition");
+    writer.String(x.GetPartition().get().c_str());
+  }
+
+  if (x.GetChecksum()) {
+    writer.Key("checksum");
+    writer.String(x.GetChecksum().get().c_str());
+  }
+
+  if (x.GetCompressedDataSize()) {
+    writer.Key("compressedDataSize");
+    writer.Int64(x.GetCompressedDataSize().get());
+  }
+
+  if (x.GetDataSize()) {
+    writer.Key("dataSize");
+    writer.Int64(x.GetDataSize().get());
+  }
+
+  if (x.GetData()) {
+    const auto& data = x.GetData().get();
+    writer.Key("data");
+    writer.String(reinterpret_cast<const char*>(data->data()),
+                  static_cast<rapidjson::SizeType>(data->size()));
+  }
+
+  if (x.GetDataHandle()) {
+    writer.Key("dataHandle");
+    writer.String(x.GetDataHandle().get().c_str());
+  }
+
+  if (x.GetTimestamp()) {
+    writer.Key("timestamp");
+    writer.Int64(x.GetTimestamp().get());
+  }
+  writer.EndObject();
+}
+
 }  // namespace serializer
 
 }  // namespace olp
@@ -37,6 +37,20 @@ void to_json(const dataservice::write::model::PublishPartitions& x,
   }
 }
 
+void to_json(const dataservice::write::model::PublishPartitions& x,
+             rapidjson::Writer<rapidjson::StringBuffer>& writer) {
+  writer.StartObject();
+  if (x.GetPartitions()) {
+    writer.Key("partitions");
+    writer.StartArray();
+    for (auto& partition : x.GetPartitions().get()) {
+      to_json(partition, writer);
+    }
+    writer.EndArray();
+  }
+  writer.EndObject();
+}
+
 }  // namespace serializer
 
 }  // namespace olp
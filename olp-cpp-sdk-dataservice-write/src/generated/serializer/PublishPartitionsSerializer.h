@@ -20,6 +20,8 @@
 #pragma once
 
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 #include "generated/model/PublishPartitions.h"
 
@@ -28,5 +30,8 @@ namespace serializer {
 void to_json(const dataservice::write::model::PublishPartitions& x,
              rapidjson::Value& value,
              rapidjson::Document::AllocatorType& allocator);
+
+void to_json(const dataservice::write::model::PublishPartitions& x,
+             rapidjson::Writer<rapidjson::StringBuffer>& writer);
 }  // namespace serializer
 }  // namespace olp
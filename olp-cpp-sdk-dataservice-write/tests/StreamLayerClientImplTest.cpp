@@ -23,6 +23,7 @@
 #include <mocks/NetworkMock.h>
 #include <olp/core/cache/CacheSettings.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include <future>
 #include <unordered_set>
 #include "StreamLayerClientImpl.h"
 
@@ -125,6 +126,28 @@ class MockStreamLayerClientImpl : public write::StreamLayerClientImpl {
   MOCK_METHOD(std::string, GenerateUuid, (), (const, override));
 };
 
+class MockFlushListener : public write::StreamLayerClientImpl::FlushListener {
+ public:
+  MOCK_METHOD(void, NotifyFlushEventStarted, (), (override));
+
+  MOCK_METHOD(void, NotifyFlushEventResults,
+              (const write::StreamLayerClient::FlushResponse& results),
+              (override));
+
+  MOCK_METHOD(void, NotifyFlushMetricsHasChanged,
+              (write::FlushMetrics metrics), (override));
+
+  MOCK_METHOD(void, NotifyRequestFlushed,
+              (const std::string& layer_id, size_t bytes,
+               std::chrono::milliseconds latency, bool successful),
+              (override));
+
+  MOCK_METHOD(void, NotifyQueueChanged,
+              (size_t queue_size,
+               std::chrono::milliseconds oldest_request_age),
+              (override));
+};
+
 class StreamLayerClientImplTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -189,6 +212,48 @@ TEST_F(StreamLayerClientImplTest, PublishSdii) {
   }
 }
 
+TEST_F(StreamLayerClientImplTest, PublishSdiiFromCallerBuffer) {
+  const std::string data = "sdii message list";
+  bool released = false;
+
+  auto client = std::make_shared<MockStreamLayerClientImpl>(
+      kHrn, write::StreamLayerClientSettings{}, settings_);
+
+  EXPECT_CALL(*client, IngestSdii)
+      .WillOnce([&](model::PublishSdiiRequest request,
+                    client::CancellationContext /*context*/) {
+        EXPECT_FALSE(request.GetSdiiMessageList());
+        EXPECT_EQ(static_cast<std::int64_t>(data.size()),
+                  request.GetSdiiMessageListSize());
+
+        // The data is read in parts, like the network does.
+        std::string sent(data.size(), '\0');
+        auto* buffer = reinterpret_cast<std::uint8_t*>(&sent[0]);
+        const auto& source = request.GetSdiiMessageListSource();
+        EXPECT_EQ(5, source(0u, buffer, 5u));
+        EXPECT_EQ(12, source(5u, buffer + 5, 32u));
+        EXPECT_EQ(0, source(data.size(), nullptr, 32u));
+        EXPECT_EQ(data, sent);
+        EXPECT_FALSE(released);
+        return model::ResponseOk{};
+      });
+
+  {
+    model::PublishSdiiRequest request;
+    request
+        .WithSdiiMessageList(
+            reinterpret_cast<const unsigned char*>(data.data()), data.size(),
+            [&] { released = true; })
+        .WithLayerId(kLayerName);
+
+    auto result = client->PublishSdii(request).GetFuture().get();
+    EXPECT_TRUE(result.IsSuccessful());
+  }
+
+  client.reset();
+  EXPECT_TRUE(released);
+}
+
 TEST_F(StreamLayerClientImplTest, SuccessfullyPublishDataLessThanTwentyMib) {
   auto data = std::make_shared<std::vector<unsigned char>>(1, 'a');
   auto request =
@@ -734,7 +799,6 @@ TEST_F(StreamLayerClientImplTest, QueueAndFlush) {
   auto client = std::make_shared<MockStreamLayerClientImpl>(
       kHrn, write::StreamLayerClientSettings{}, settings_);
 
-  size_t uuid_call_count = 1;
   // Forward trace ID from request to response
   ON_CALL(*client, PublishDataTask(_, _))
       .WillByDefault([](model::PublishDataRequest request,
@@ -744,13 +808,10 @@ TEST_F(StreamLayerClientImplTest, QueueAndFlush) {
         result.SetTraceID(request.GetTraceId().get());
         return write::PublishDataResponse{result};
       });
-  ON_CALL(*client, GenerateUuid)
-      .WillByDefault([&uuid_call_count]() -> std::string {
-        return std::to_string(uuid_call_count++);
-      });
 
   EXPECT_CALL(*client, PublishDataTask(_, _)).Times(kBatchSize);
-  EXPECT_CALL(*client, GenerateUuid()).Times(kBatchSize);
+  // The queued requests are stored with sequence numbers.
+  EXPECT_CALL(*client, GenerateUuid()).Times(0);
 
   // queues all  requests:
   for (size_t i = 0; i < kBatchSize; ++i) {
@@ -778,4 +839,233 @@ TEST_F(StreamLayerClientImplTest, QueueAndFlush) {
   EXPECT_EQ(kBatchSize, trace_ids.size());
 }
 
+TEST_F(StreamLayerClientImplTest, FlushEventListener) {
+  const size_t kRequestsCount = 3;
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  auto client = std::make_shared<MockStreamLayerClientImpl>(
+      kHrn, write::StreamLayerClientSettings{}, settings_);
+  auto listener = std::make_shared<testing::NiceMock<MockFlushListener>>();
+  client->SetFlushEventListener(listener);
+
+  ON_CALL(*client, PublishDataTask(_, _))
+      .WillByDefault([](model::PublishDataRequest /*request*/,
+                        client::CancellationContext /*context*/) {
+        return write::PublishDataResponse{write::PublishDataResult{}};
+      });
+
+  {
+    testing::InSequence sequence;
+    for (size_t i = 1; i <= kRequestsCount; ++i) {
+      EXPECT_CALL(*listener, NotifyQueueChanged(i, _));
+    }
+  }
+  for (size_t i = 0; i < kRequestsCount; ++i) {
+    auto error = client->Queue(
+        model::PublishDataRequest()
+            .WithData(std::make_shared<std::vector<unsigned char>>(2, 'z'))
+            .WithLayerId(kLayerName));
+    EXPECT_EQ(boost::none, error) << *error;
+  }
+  Mock::VerifyAndClearExpectations(listener.get());
+
+  EXPECT_CALL(*listener, NotifyRequestFlushed(kLayerName, 2u, _, true))
+      .Times(kRequestsCount);
+  EXPECT_CALL(*listener, NotifyQueueChanged(0u, std::chrono::milliseconds(0)))
+      .Times(1);
+
+  auto response = client->Flush(model::FlushRequest()).GetFuture().get();
+  EXPECT_EQ(response.size(), kRequestsCount);
+  Mock::VerifyAndClearExpectations(listener.get());
+}
+
+TEST_F(StreamLayerClientImplTest, QueueAndPopInBatches) {
+  const size_t kRequestsCount = 5;
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  write::StreamLayerClientSettings stream_settings;
+  stream_settings.maximum_requests = kRequestsCount;
+  auto client = std::make_shared<MockStreamLayerClientImpl>(
+      kHrn, stream_settings, settings_);
+
+  for (size_t i = 0; i < kRequestsCount; ++i) {
+    auto error = client->Queue(
+        model::PublishDataRequest()
+            .WithTraceId(std::to_string(i))
+            .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+            .WithLayerId("layer"));
+    EXPECT_EQ(boost::none, error) << *error;
+  }
+
+  auto error = client->Queue(
+      model::PublishDataRequest()
+          .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+          .WithLayerId("layer"));
+  EXPECT_TRUE(error);
+
+  auto requests = client->PopFromQueue(3u);
+  ASSERT_EQ(requests.size(), 3u);
+  for (size_t i = 0; i < requests.size(); ++i) {
+    EXPECT_EQ(requests[i].GetTraceId().get(), std::to_string(i));
+  }
+  EXPECT_EQ(client->QueueSize(), 2u);
+
+  auto request = client->PopFromQueue();
+  ASSERT_TRUE(request);
+  EXPECT_EQ(request->GetTraceId().get(), "3");
+
+  requests = client->PopFromQueue(10u);
+  ASSERT_EQ(requests.size(), 1u);
+  EXPECT_EQ(requests[0].GetTraceId().get(), "4");
+  EXPECT_EQ(client->QueueSize(), 0u);
+  EXPECT_TRUE(client->PopFromQueue(10u).empty());
+}
+
+TEST_F(StreamLayerClientImplTest, CancelledFlushRequeuesAtFront) {
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  write::StreamLayerClientSettings stream_settings;
+  stream_settings.flush_parallel_requests = 1u;
+  auto client = std::make_shared<MockStreamLayerClientImpl>(
+      kHrn, stream_settings, settings_);
+
+  auto make_request = [](const std::string& trace_id) {
+    return model::PublishDataRequest()
+        .WithTraceId(trace_id)
+        .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+        .WithLayerId("layer");
+  };
+
+  for (const auto* trace_id : {"0", "1", "2"}) {
+    EXPECT_FALSE(client->Queue(make_request(trace_id)));
+  }
+
+  // The flush is cancelled while "1" is published, after "3" is queued.
+  EXPECT_CALL(*client, PublishDataTask(_, _))
+      .WillOnce([](model::PublishDataRequest, client::CancellationContext) {
+        return write::PublishDataResponse{model::ResponseOkSingle()};
+      })
+      .WillOnce([&](model::PublishDataRequest, client::CancellationContext) {
+        EXPECT_FALSE(client->Queue(make_request("3")));
+        client->CancelPendingRequests();
+        return write::PublishDataResponse{client::ApiError::Cancelled()};
+      });
+
+  auto responses = client->Flush(model::FlushRequest()).GetFuture().get();
+  EXPECT_EQ(responses.size(), 2u);
+
+  auto requests = client->PopFromQueue(10u);
+  ASSERT_EQ(requests.size(), 3u);
+  EXPECT_EQ(requests[0].GetTraceId().get(), "1");
+  EXPECT_EQ(requests[1].GetTraceId().get(), "2");
+  EXPECT_EQ(requests[2].GetTraceId().get(), "3");
+}
+
+TEST_F(StreamLayerClientImplTest, PopFromQueueWithBytesLimit) {
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  auto client = std::make_shared<MockStreamLayerClientImpl>(
+      kHrn, write::StreamLayerClientSettings{}, settings_);
+
+  for (auto size : {4u, 4u, 10u, 4u}) {
+    auto error = client->Queue(
+        model::PublishDataRequest()
+            .WithData(std::make_shared<std::vector<unsigned char>>(size, 'z'))
+            .WithLayerId("layer"));
+    EXPECT_EQ(boost::none, error) << *error;
+  }
+
+  // The requests are taken while they fit into the limit.
+  EXPECT_EQ(client->PopFromQueue(10u, 9u).size(), 2u);
+  // A request larger than the limit is taken alone.
+  EXPECT_EQ(client->PopFromQueue(10u, 8u).size(), 1u);
+  EXPECT_EQ(client->PopFromQueue(10u, 8u).size(), 1u);
+  EXPECT_EQ(client->QueueSize(), 0u);
+}
+
+TEST_F(StreamLayerClientImplTest, LingerPublishData) {
+  const size_t kRequestsCount = 3;
+  write::StreamLayerClientSettings stream_settings;
+  stream_settings.batch_bytes = kRequestsCount;
+
+  auto make_request = [](const std::string& trace_id) {
+    return model::PublishDataRequest()
+        .WithTraceId(trace_id)
+        .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+        .WithLayerId("layer");
+  };
+
+  auto publish = [](MockStreamLayerClientImpl& client,
+                    model::PublishDataRequest request) {
+    auto promise = std::make_shared<std::promise<write::PublishDataResponse>>();
+    client.PublishData(std::move(request),
+                       [=](write::PublishDataResponse response) {
+                         promise->set_value(std::move(response));
+                       });
+    return promise->get_future();
+  };
+
+  auto forward_trace_id = [](model::PublishDataRequest request,
+                             client::CancellationContext /*context*/) {
+    write::PublishDataResult result;
+    result.SetTraceID(request.GetTraceId().get());
+    return write::PublishDataResponse{result};
+  };
+
+  {
+    SCOPED_TRACE("Publish when the batch is full");
+    stream_settings.linger_ms = std::chrono::hours(1);
+    MockStreamLayerClientImpl client(kHrn, stream_settings, settings_);
+    EXPECT_CALL(client, PublishDataTask(_, _))
+        .Times(kRequestsCount)
+        .WillRepeatedly(forward_trace_id);
+
+    std::vector<std::future<write::PublishDataResponse>> futures;
+    for (size_t i = 0; i < kRequestsCount; ++i) {
+      futures.push_back(publish(client, make_request(std::to_string(i))));
+    }
+
+    for (size_t i = 0; i < kRequestsCount; ++i) {
+      auto response = futures[i].get();
+      ASSERT_TRUE(response.IsSuccessful());
+      EXPECT_EQ(response.GetResult().GetTraceID(), std::to_string(i));
+    }
+  }
+
+  {
+    SCOPED_TRACE("Publish when the linger time expires");
+    stream_settings.linger_ms = std::chrono::milliseconds(10);
+    MockStreamLayerClientImpl client(kHrn, stream_settings, settings_);
+    EXPECT_CALL(client, PublishDataTask(_, _))
+        .WillOnce(forward_trace_id);
+
+    auto response = publish(client, make_request("single")).get();
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().GetTraceID(), "single");
+  }
+
+  {
+    SCOPED_TRACE("Cancel the collected request");
+    stream_settings.linger_ms = std::chrono::hours(1);
+    MockStreamLayerClientImpl client(kHrn, stream_settings, settings_);
+    EXPECT_CALL(client, PublishDataTask(_, _)).Times(0);
+
+    std::promise<write::PublishDataResponse> promise;
+    auto token = client.PublishData(
+        make_request("cancelled"), [&](write::PublishDataResponse response) {
+          promise.set_value(std::move(response));
+        });
+    token.Cancel();
+
+    auto response = promise.get_future().get();
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(),
+              client::ErrorCode::Cancelled);
+  }
+}
+
 }  // namespace
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "UploadCompressor.h"
+
+namespace {
+
+using olp::dataservice::write::UploadCompressor;
+
+UploadCompressor::Data MakeData() {
+  const std::string text =
+      "{\"type\":\"Feature\",\"properties\":{\"speed\":42}}";
+  auto data = std::make_shared<std::vector<unsigned char>>();
+  for (int i = 0; i < 1000; ++i) {
+    data->insert(data->end(), text.begin(), text.end());
+  }
+  return data;
+}
+
+TEST(UploadCompressorTest, CompressesForGzipLayers) {
+  UploadCompressor compressor(true);
+  const auto data = MakeData();
+
+  {
+    SCOPED_TRACE("Layers without the gzip content encoding");
+
+    EXPECT_EQ(data, compressor.Compress(data, ""));
+    EXPECT_EQ(data, compressor.Compress(data, "identity"));
+    EXPECT_EQ(0u, compressor.GetStatistics().compressed_uploads);
+  }
+
+  if (!UploadCompressor::IsAvailable()) {
+    EXPECT_EQ(data, compressor.Compress(data, "gzip"));
+    return;
+  }
+
+  {
+    SCOPED_TRACE("Layer with the gzip content encoding");
+
+    const auto compressed = compressor.Compress(data, "GZIP");
+    ASSERT_TRUE(compressed);
+    ASSERT_GE(compressed->size(), 2u);
+    EXPECT_EQ(0x1f, (*compressed)[0]);
+    EXPECT_EQ(0x8b, (*compressed)[1]);
+    EXPECT_LT(compressed->size(), data->size());
+
+    const auto statistics = compressor.GetStatistics();
+    EXPECT_EQ(1u, statistics.compressed_uploads);
+    EXPECT_EQ(data->size(), statistics.uncompressed_bytes);
+    EXPECT_EQ(compressed->size(), statistics.compressed_bytes);
+
+    SCOPED_TRACE("Compressed data is not compressed again");
+
+    EXPECT_EQ(compressed, compressor.Compress(compressed, "gzip"));
+    EXPECT_EQ(1u, compressor.GetStatistics().compressed_uploads);
+  }
+}
+
+TEST(UploadCompressorTest, Disabled) {
+  UploadCompressor compressor(false);
+  const auto data = MakeData();
+
+  EXPECT_EQ(data, compressor.Compress(data, "gzip"));
+  EXPECT_EQ(0u, compressor.GetStatistics().compressed_uploads);
+}
+
+}  // namespace
@@ -25,6 +25,9 @@
 #include <olp/authentication/TokenProvider.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
 
+#include <boost/uuid/name_generator_sha1.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
 // clang-format off
 #include "generated/serializer/ApiSerializer.h"
 #include "generated/serializer/PublicationSerializer.h"
@@ -748,4 +751,291 @@ TEST_F(VersionedLayerClientImplPublishToBatchTest, Cancel) {
   }
 }
 
+TEST_F(VersionedLayerClientImplPublishToBatchTest, PublishToBatchInParts) {
+  const std::string partition = "132";
+  const auto publication =
+      mockserver::DefaultResponses::GeneratePublicationResponse({kLayer}, {});
+  const std::string upload_part_url =
+      "https://some.blob.url/multiparts/token/parts";
+  const std::string complete_url = "https://some.blob.url/multiparts/token";
+  const std::string multipart_response =
+      R"JSON({"links":{"uploadPart":{"href":")JSON" + upload_part_url +
+      R"JSON(","method":"POST"},"complete":{"href":")JSON" + complete_url +
+      R"JSON(","method":"PUT"},"delete":{"href":")JSON" + complete_url +
+      R"JSON(","method":"DELETE"}}})JSON";
+
+  // The parts are retried by the client, not by the network requests
+  settings_.retry_settings.max_attempts = 0;
+
+  MockConfigRequest(kLayer);
+  auto blob_api = MockApiRequest("blob");
+  EXPECT_CALL(*network_,
+              Send(IsPostRequestPrefix(blob_api.GetBaseUrl() + "/layers/" +
+                                       kLayer + "/data/"),
+                   _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          multipart_response));
+  EXPECT_CALL(*network_,
+              Send(IsPostRequest(upload_part_url + "?partNumber=1"), _, _, _,
+                   _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::SERVICE_UNAVAILABLE),
+          {}))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          {}, {{"ETag", "etag-1"}}));
+  EXPECT_CALL(*network_,
+              Send(IsPostRequest(upload_part_url + "?partNumber=2"), _, _, _,
+                   _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          {}, {{"ETag", "etag-2"}}));
+  EXPECT_CALL(
+      *network_,
+      Send(testing::AllOf(
+               IsPutRequest(complete_url),
+               BodyEq(R"JSON({"parts":[{"etag":"etag-1","number":1},)JSON"
+                      R"JSON({"etag":"etag-2","number":2}]})JSON")),
+           _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::NO_CONTENT),
+                                   {}));
+  MockPublishPartitionRequest(publication, kLayer);
+
+  EXPECT_CALL(*cache_, Get(_, _)).Times(3);
+  EXPECT_CALL(*cache_, Contains(_)).Times(1);
+  EXPECT_CALL(*cache_, Put(_, _, _, _))
+      .WillRepeatedly([](const std::string& /*key*/,
+                         const boost::any& /*value*/,
+                         const olp::cache::Encoder& /*encoder*/,
+                         time_t /*expiry*/) { return true; });
+
+  // The part size is raised to the minimum of 5 MB, so the data has 2 parts
+  write::VersionedLayerClientSettings client_settings;
+  client_settings.multipart_threshold = 1024u;
+  client_settings.multipart_part_size = 1024u;
+  write::VersionedLayerClientImpl client(kHrn, client_settings, settings_);
+  auto request = model::PublishPartitionDataRequest()
+                     .WithData(std::make_shared<std::vector<unsigned char>>(
+                         6u * 1024u * 1024u, 0x30))
+                     .WithLayerId(kLayer)
+                     .WithPartitionId(partition);
+
+  const auto response = client.PublishToBatch(publication, request)
+                             .GetFuture()
+                             .get();
+
+  EXPECT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().GetTraceID(), partition);
+}
+
+TEST_F(VersionedLayerClientImplPublishToBatchTest, PublishToBatchPartitions) {
+  const auto publication =
+      mockserver::DefaultResponses::GeneratePublicationResponse({kLayer}, {});
+  const std::vector<std::string> partitions = {"1", "2", "3"};
+
+  MockConfigRequest(kLayer);
+  auto blob_api = MockApiRequest("blob");
+  EXPECT_CALL(*network_,
+              Send(IsPutRequestPrefix(blob_api.GetBaseUrl() + "/layers/" +
+                                      kLayer + "/data/"),
+                   _, _, _, _))
+      .Times(partitions.size())
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::NO_CONTENT),
+          {}));
+
+  // The metadata of the 3 partitions is uploaded with 2 requests
+  auto publish_api = MockApiRequest("publish");
+  EXPECT_CALL(*network_,
+              Send(IsPostRequest(publish_api.GetBaseUrl() + "/layers/" +
+                                 kLayer + "/publications/" +
+                                 publication.GetId().get() + "/partitions"),
+                   _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::NO_CONTENT),
+          {}));
+
+  EXPECT_CALL(*cache_, Get(_, _)).Times(3);
+  EXPECT_CALL(*cache_, Contains(_)).Times(1);
+  EXPECT_CALL(*cache_, Put(_, _, _, _))
+      .WillRepeatedly([](const std::string& /*key*/,
+                         const boost::any& /*value*/,
+                         const olp::cache::Encoder& /*encoder*/,
+                         time_t /*expiry*/) { return true; });
+
+  write::VersionedLayerClientSettings client_settings;
+  client_settings.partitions_batch_size = 2u;
+  write::VersionedLayerClientImpl client(kHrn, client_settings, settings_);
+
+  std::vector<model::PublishPartitionDataRequest> requests;
+  for (const auto& partition : partitions) {
+    requests.push_back(
+        model::PublishPartitionDataRequest()
+            .WithData(std::make_shared<std::vector<unsigned char>>(20, 0x30))
+            .WithLayerId(kLayer)
+            .WithPartitionId(partition));
+  }
+
+  const auto response =
+      client.PublishToBatch(publication, requests).GetFuture().get();
+
+  ASSERT_TRUE(response.IsSuccessful());
+  const auto& result = response.GetResult();
+  ASSERT_EQ(result.size(), partitions.size());
+  for (size_t index = 0u; index < partitions.size(); ++index) {
+    EXPECT_EQ(result[index].GetTraceID(), partitions[index]);
+  }
+}
+
+TEST_F(VersionedLayerClientImplPublishToBatchTest,
+       PublishToBatchContentAddressed) {
+  const auto publication =
+      mockserver::DefaultResponses::GeneratePublicationResponse({kLayer}, {});
+  const auto existing_data =
+      std::make_shared<std::vector<unsigned char>>(20, 0x30);
+  const auto new_data = std::make_shared<std::vector<unsigned char>>(20, 0x31);
+
+  boost::uuids::name_generator_sha1 generator(boost::uuids::ns::url());
+  const auto existing_handle = boost::uuids::to_string(
+      generator(existing_data->data(), existing_data->size()));
+  const auto new_handle = boost::uuids::to_string(
+      generator(new_data->data(), new_data->size()));
+
+  MockConfigRequest(kLayer);
+  auto blob_api = MockApiRequest("blob");
+  const auto data_url = blob_api.GetBaseUrl() + "/layers/" + kLayer + "/data/";
+
+  // The identical data of two partitions is checked and skipped once
+  EXPECT_CALL(*network_,
+              Send(IsHeadRequest(data_url + existing_handle), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   {}));
+  EXPECT_CALL(*network_, Send(IsHeadRequest(data_url + new_handle), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::NOT_FOUND),
+                                   {}));
+  EXPECT_CALL(*network_, Send(IsPutRequest(data_url + new_handle), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::NO_CONTENT),
+                                   {}));
+  MockPublishPartitionRequest(publication, kLayer);
+
+  EXPECT_CALL(*cache_, Get(_, _)).Times(3);
+  EXPECT_CALL(*cache_, Contains(_)).Times(1);
+  EXPECT_CALL(*cache_, Put(_, _, _, _))
+      .WillRepeatedly([](const std::string& /*key*/,
+                         const boost::any& /*value*/,
+                         const olp::cache::Encoder& /*encoder*/,
+                         time_t /*expiry*/) { return true; });
+
+  write::VersionedLayerClientSettings client_settings;
+  client_settings.content_addressed_data_handles = true;
+  write::VersionedLayerClientImpl client(kHrn, client_settings, settings_);
+
+  std::vector<model::PublishPartitionDataRequest> requests = {
+      model::PublishPartitionDataRequest()
+          .WithData(existing_data)
+          .WithLayerId(kLayer)
+          .WithPartitionId("1"),
+      model::PublishPartitionDataRequest()
+          .WithData(existing_data)
+          .WithLayerId(kLayer)
+          .WithPartitionId("2"),
+      model::PublishPartitionDataRequest()
+          .WithData(new_data)
+          .WithLayerId(kLayer)
+          .WithPartitionId("3")};
+
+  const auto response =
+      client.PublishToBatch(publication, requests).GetFuture().get();
+
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().size(), requests.size());
+}
+
+TEST_F(VersionedLayerClientImplPublishToBatchTest,
+       PublishToBatchInPartsAbortsUpload) {
+  const std::string partition = "132";
+  const auto publication =
+      mockserver::DefaultResponses::GeneratePublicationResponse({kLayer}, {});
+  const std::string upload_part_url =
+      "https://some.blob.url/multiparts/token/parts";
+  const std::string upload_url = "https://some.blob.url/multiparts/token";
+  const std::string multipart_response =
+      R"JSON({"links":{"uploadPart":{"href":")JSON" + upload_part_url +
+      R"JSON(","method":"POST"},"complete":{"href":")JSON" + upload_url +
+      R"JSON(","method":"PUT"},"delete":{"href":")JSON" + upload_url +
+      R"JSON(","method":"DELETE"}}})JSON";
+
+  settings_.retry_settings.max_attempts = 0;
+
+  MockConfigRequest(kLayer);
+  auto blob_api = MockApiRequest("blob");
+  EXPECT_CALL(*network_,
+              Send(IsPostRequestPrefix(blob_api.GetBaseUrl() + "/layers/" +
+                                       kLayer + "/data/"),
+                   _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          multipart_response));
+  EXPECT_CALL(*network_,
+              Send(IsPostRequest(upload_part_url + "?partNumber=1"), _, _, _,
+                   _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::FORBIDDEN),
+          {}));
+  // The other part is cancelled if it did not start yet
+  EXPECT_CALL(*network_,
+              Send(IsPostRequest(upload_part_url + "?partNumber=2"), _, _, _,
+                   _))
+      .Times(testing::AtMost(1))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          {}, {{"ETag", "etag-2"}}));
+  EXPECT_CALL(*network_, Send(IsPutRequest(upload_url), _, _, _, _)).Times(0);
+  EXPECT_CALL(*network_, Send(IsDeleteRequest(upload_url), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::NO_CONTENT),
+                                   {}));
+
+  EXPECT_CALL(*cache_, Get(_, _)).Times(testing::AnyNumber());
+  EXPECT_CALL(*cache_, Contains(_)).Times(testing::AnyNumber());
+  EXPECT_CALL(*cache_, Put(_, _, _, _))
+      .WillRepeatedly([](const std::string& /*key*/,
+                         const boost::any& /*value*/,
+                         const olp::cache::Encoder& /*encoder*/,
+                         time_t /*expiry*/) { return true; });
+
+  write::VersionedLayerClientSettings client_settings;
+  client_settings.multipart_threshold = 1024u;
+  client_settings.multipart_part_size = 1024u;
+  write::VersionedLayerClientImpl client(kHrn, client_settings, settings_);
+  auto request = model::PublishPartitionDataRequest()
+                     .WithData(std::make_shared<std::vector<unsigned char>>(
+                         6u * 1024u * 1024u, 0x30))
+                     .WithLayerId(kLayer)
+                     .WithPartitionId(partition);
+
+  const auto response = client.PublishToBatch(publication, request)
+                             .GetFuture()
+                             .get();
+
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetHttpStatusCode(),
+            olp::http::HttpStatusCode::FORBIDDEN);
+}
+
 }  // namespace
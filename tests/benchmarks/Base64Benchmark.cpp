@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <olp/core/utils/Base64.h>
+
+namespace {
+
+std::vector<std::uint8_t> GenerateBytes(size_t size) {
+  std::vector<std::uint8_t> bytes(size);
+  for (size_t i = 0u; i < size; ++i) {
+    bytes[i] = static_cast<std::uint8_t>(i * 31u);
+  }
+  return bytes;
+}
+
+void Base64Encode(benchmark::State& state) {
+  const auto bytes = GenerateBytes(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(olp::utils::Base64Encode(bytes));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void Base64Decode(benchmark::State& state) {
+  const auto encoded = olp::utils::Base64Encode(
+      GenerateBytes(static_cast<size_t>(state.range(0))));
+  std::vector<std::uint8_t> bytes;
+  for (auto _ : state) {
+    bytes.clear();
+    benchmark::DoNotOptimize(olp::utils::Base64Decode(encoded, bytes));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(Base64Encode)->Range(64, 1 << 20);
+BENCHMARK(Base64Decode)->Range(64, 1 << 20);
+
+}  // namespace
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <olp/core/cache/DefaultCache.h>
+#include <olp/core/utils/Dir.h>
+#include <olp/core/utils/LruCache.h>
+#include "cache/InMemoryCache.h"
+
+namespace {
+using olp::cache::KeyValueCache;
+
+constexpr size_t kKeys = 1024u;
+constexpr size_t kValueSize = 16u * 1024u;
+
+/// Generates the keys similar to the ones of the read module.
+std::vector<std::string> GenerateKeys(size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (size_t i = 0u; i < count; ++i) {
+    keys.push_back("hrn:here:data::olp-here-test:catalog::layer::" +
+                   std::to_string(i * 7919u) + "::Data");
+  }
+  return keys;
+}
+
+KeyValueCache::ValueTypePtr GenerateValue() {
+  return std::make_shared<KeyValueCache::ValueType>(kValueSize, 'v');
+}
+
+#ifdef OLP_SDK_ENABLE_DEFAULT_CACHE
+using olp::cache::DefaultCache;
+
+/// Opens a cache with the memory cache only, or with the disk cache only.
+std::unique_ptr<DefaultCache> OpenCache(bool disk) {
+  olp::cache::CacheSettings settings;
+  if (disk) {
+    const auto path = olp::utils::Dir::TempDirectory() + "/olp-benchmark-cache";
+    olp::utils::Dir::Remove(path);
+    settings.disk_path_mutable = path;
+    settings.max_disk_storage = kKeys * kValueSize * 4u;
+    settings.max_memory_cache_size = 0u;
+  } else {
+    settings.max_memory_cache_size = kKeys * kValueSize * 2u;
+  }
+
+  std::unique_ptr<DefaultCache> cache(new DefaultCache(settings));
+  cache->Open();
+  return cache;
+}
+
+void DefaultCachePut(benchmark::State& state) {
+  const auto keys = GenerateKeys(kKeys);
+  const auto value = GenerateValue();
+  auto cache = OpenCache(state.range(0) != 0);
+
+  size_t index = 0u;
+  for (auto _ : state) {
+    cache->Put(keys[index++ % keys.size()], value,
+               std::numeric_limits<time_t>::max());
+  }
+  state.SetBytesProcessed(state.iterations() * kValueSize);
+}
+
+void DefaultCacheGet(benchmark::State& state) {
+  const auto keys = GenerateKeys(kKeys);
+  const auto value = GenerateValue();
+  auto cache = OpenCache(state.range(0) != 0);
+  for (const auto& key : keys) {
+    cache->Put(key, value, std::numeric_limits<time_t>::max());
+  }
+
+  size_t index = 0u;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cache->Get(keys[index++ % keys.size()]));
+  }
+  state.SetBytesProcessed(state.iterations() * kValueSize);
+}
+
+// The argument selects the memory cache (0) or the disk cache (1).
+BENCHMARK(DefaultCachePut)->Arg(0)->Arg(1);
+BENCHMARK(DefaultCacheGet)->Arg(0)->Arg(1);
+#endif  // OLP_SDK_ENABLE_DEFAULT_CACHE
+
+void InMemoryCachePutGet(benchmark::State& state) {
+  const auto keys = GenerateKeys(kKeys);
+  const auto value = GenerateValue();
+  olp::cache::InMemoryCache cache(kKeys / 2u);
+
+  size_t index = 0u;
+  for (auto _ : state) {
+    const auto& key = keys[index++ % keys.size()];
+    cache.Put(key, value);
+    benchmark::DoNotOptimize(cache.Get(key));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void LruCacheInsertFind(benchmark::State& state) {
+  const auto keys = GenerateKeys(kKeys);
+  olp::utils::LruCache<std::string, size_t> cache(kKeys / 2u);
+
+  size_t index = 0u;
+  for (auto _ : state) {
+    const auto& key = keys[index++ % keys.size()];
+    cache.InsertOrAssign(key, index);
+    benchmark::DoNotOptimize(cache.Find(key));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(InMemoryCachePutGet);
+BENCHMARK(LruCacheInsertFind);
+
+}  // namespace
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <olp/core/cache/DefaultCache.h>
+#include <olp/core/utils/Dir.h>
+
+/*
+ * Measures how long the disk caches of different sizes take to open, to warm
+ * up, to recover after a dirty shutdown and to compact. The caches are built
+ * once per size and process, which takes much longer than the benchmarks for
+ * the large sizes.
+ *
+ * The sizes in MB are set with the OLP_BENCHMARK_CACHE_SIZES env. variable,
+ * like "100,1024,10240", the default is 100. To compare the releases, run the
+ * benchmarks with `--benchmark_out=<file> --benchmark_out_format=json`.
+ */
+
+#ifdef OLP_SDK_ENABLE_DEFAULT_CACHE
+namespace {
+using olp::cache::CacheSettings;
+using olp::cache::DefaultCache;
+using olp::cache::KeyValueCache;
+using olp::utils::Dir;
+
+constexpr auto kCatalog = "hrn:here:data::olp-here-test:catalog";
+constexpr auto kLayer = "layer";
+constexpr std::int64_t kVersion = 42;
+constexpr std::uint64_t kMegabyte = 1024u * 1024u;
+
+/// The partitions of a quad tree, one quad tree is stored per this count.
+constexpr std::uint32_t kPartitionsPerQuadTree = 256u;
+
+std::string CacheRoot(std::int64_t size_mb) {
+  return Dir::TempDirectory() + "/olp-cache-benchmark/" +
+         std::to_string(size_mb) + "MB";
+}
+
+std::string SourcePath(std::int64_t size_mb) {
+  return CacheRoot(size_mb) + "/source";
+}
+
+std::string SnapshotPath(std::int64_t size_mb) {
+  return CacheRoot(size_mb) + "/snapshot";
+}
+
+std::string ProtectedPath(std::int64_t size_mb) {
+  return CacheRoot(size_mb) + "/protected";
+}
+
+std::string WorkPath(std::int64_t size_mb) {
+  return CacheRoot(size_mb) + "/work";
+}
+
+CacheSettings MutableSettings(const std::string& path, std::int64_t size_mb) {
+  CacheSettings settings;
+  settings.disk_path_mutable = path;
+  // No eviction happens while the cache is built.
+  settings.max_disk_storage =
+      static_cast<std::uint64_t>(size_mb) * kMegabyte * 2u;
+  settings.max_memory_cache_size = 64u * kMegabyte;
+  return settings;
+}
+
+/// Copies the files of a flat directory, like the leveldb one.
+bool CopyDirectory(const std::string& from, const std::string& to) {
+  std::vector<std::string> files;
+  Dir::Size(from, [&](const std::string& name) {
+    files.push_back(name);
+    return false;
+  });
+
+  Dir::Remove(to);
+  if (!Dir::Create(to)) {
+    return false;
+  }
+
+  for (const auto& file : files) {
+    std::ifstream input(from + "/" + file, std::ios::binary);
+    std::ofstream output(to + "/" + file, std::ios::binary);
+    output << input.rdbuf();
+    if (!input || !output) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Generates the values that do not compress much, like the real tiles.
+class ValueGenerator {
+ public:
+  KeyValueCache::ValueTypePtr Generate(size_t size) {
+    auto value = std::make_shared<KeyValueCache::ValueType>(size);
+    for (auto& byte : *value) {
+      byte = static_cast<unsigned char>(engine_());
+    }
+    return value;
+  }
+
+  size_t Size(size_t min, size_t max) {
+    return std::uniform_int_distribution<size_t>(min, max)(engine_);
+  }
+
+ private:
+  std::minstd_rand engine_{7u};
+};
+
+/// Fills the cache with the keys of the read module: the partition metadata,
+/// the blobs and the quad trees, until it holds `size_mb` of values.
+void Fill(DefaultCache& cache, std::int64_t size_mb) {
+  const auto layer_prefix = std::string(kCatalog) + "::" + kLayer + "::";
+  const auto target = static_cast<std::uint64_t>(size_mb) * kMegabyte;
+  const auto version = std::to_string(kVersion);
+
+  ValueGenerator generator;
+  std::uint64_t stored = 0u;
+  for (std::uint32_t partition = 0u; stored < target; ++partition) {
+    const auto partition_id = std::to_string(partition);
+    const auto data_handle = "5c1a0b2e-" + partition_id + "-4e8c-9a1d";
+
+    auto metadata = generator.Generate(generator.Size(150u, 250u));
+    auto blob = generator.Generate(generator.Size(4u * 1024u, 64u * 1024u));
+    stored += metadata->size() + blob->size();
+
+    cache.Put(layer_prefix + partition_id + "::" + version + "::partition",
+              metadata, std::numeric_limits<time_t>::max());
+    cache.Put(layer_prefix + data_handle + "::Data", blob,
+              std::numeric_limits<time_t>::max());
+
+    if (partition % kPartitionsPerQuadTree == 0u) {
+      auto quad_tree =
+          generator.Generate(generator.Size(16u * 1024u, 96u * 1024u));
+      stored += quad_tree->size();
+      cache.Put(layer_prefix + "23618" + partition_id + "::" + version +
+                    "::4::quadtree",
+                quad_tree, std::numeric_limits<time_t>::max());
+    }
+  }
+}
+
+/// Builds the caches of the given size once per process. The source cache is
+/// closed properly. The snapshot is copied while the cache is open, so it has
+/// no LRU checkpoint and has to be scanned like after a crash.
+bool Prepare(std::int64_t size_mb) {
+  static std::set<std::int64_t> prepared;
+  if (prepared.count(size_mb)) {
+    return true;
+  }
+
+  Dir::Remove(CacheRoot(size_mb));
+  Dir::Create(CacheRoot(size_mb));
+
+  DefaultCache cache(MutableSettings(SourcePath(size_mb), size_mb));
+  if (cache.Open() != DefaultCache::Success) {
+    return false;
+  }
+  Fill(cache, size_mb);
+  cache.Flush();
+
+  if (!CopyDirectory(SourcePath(size_mb), SnapshotPath(size_mb)) ||
+      !cache.ExportToProtectedCache(ProtectedPath(size_mb))) {
+    return false;
+  }
+  cache.Close();
+
+  prepared.insert(size_mb);
+  return true;
+}
+
+void SetCounters(benchmark::State& state, const std::string& path) {
+  state.counters["size_mb"] = static_cast<double>(state.range(0));
+  state.counters["disk_mb"] =
+      static_cast<double>(Dir::Size(path)) / static_cast<double>(kMegabyte);
+}
+
+/// Opens and closes a cache that was closed properly, so the LRU is loaded
+/// from the checkpoint.
+void CacheOpen(benchmark::State& state) {
+  const auto size_mb = state.range(0);
+  if (!Prepare(size_mb)) {
+    state.SkipWithError("Failed to prepare the cache");
+    return;
+  }
+
+  const auto path = SourcePath(size_mb);
+  for (auto _ : state) {
+    DefaultCache cache(MutableSettings(path, size_mb));
+    benchmark::DoNotOptimize(cache.Open());
+
+    state.PauseTiming();
+    cache.Close();
+    state.ResumeTiming();
+  }
+  SetCounters(state, path);
+}
+
+/// Opens a cache and loads the first values of the layer into the memory
+/// cache.
+void CacheOpenAndWarmUp(benchmark::State& state) {
+  const auto size_mb = state.range(0);
+  if (!Prepare(size_mb)) {
+    state.SkipWithError("Failed to prepare the cache");
+    return;
+  }
+
+  const auto path = SourcePath(size_mb);
+  const auto prefix = std::string(kCatalog) + "::" + kLayer;
+  for (auto _ : state) {
+    DefaultCache cache(MutableSettings(path, size_mb));
+    cache.Open();
+    benchmark::DoNotOptimize(cache.WarmUp({prefix}, 32u * kMegabyte).get());
+
+    state.PauseTiming();
+    cache.Close();
+    state.ResumeTiming();
+  }
+  SetCounters(state, path);
+}
+
+/// Opens a copy of the cache that was not closed, so there is no LRU
+/// checkpoint and all the keys are scanned to initialize the LRU.
+void CacheRecoverAfterDirtyShutdown(benchmark::State& state) {
+  const auto size_mb = state.range(0);
+  if (!Prepare(size_mb)) {
+    state.SkipWithError("Failed to prepare the cache");
+    return;
+  }
+
+  const auto path = WorkPath(size_mb);
+  for (auto _ : state) {
+    state.PauseTiming();
+    if (!CopyDirectory(SnapshotPath(size_mb), path)) {
+      state.SkipWithError("Failed to copy the cache");
+      break;
+    }
+    state.ResumeTiming();
+
+    DefaultCache cache(MutableSettings(path, size_mb));
+    benchmark::DoNotOptimize(cache.Open());
+
+    state.PauseTiming();
+    cache.Close();
+    state.ResumeTiming();
+  }
+  SetCounters(state, path);
+  Dir::Remove(path);
+}
+
+/// Opens the protected cache exported from the mutable one.
+void ProtectedCacheOpen(benchmark::State& state) {
+  const auto size_mb = state.range(0);
+  if (!Prepare(size_mb)) {
+    state.SkipWithError("Failed to prepare the cache");
+    return;
+  }
+
+  const auto path = ProtectedPath(size_mb);
+  for (auto _ : state) {
+    CacheSettings settings;
+    settings.disk_path_protected = path;
+    DefaultCache cache(settings);
+    benchmark::DoNotOptimize(cache.Open());
+
+    state.PauseTiming();
+    cache.Close();
+    state.ResumeTiming();
+  }
+  SetCounters(state, path);
+}
+
+/// Compacts a copy of the cache that was never compacted.
+void CacheCompact(benchmark::State& state) {
+  const auto size_mb = state.range(0);
+  if (!Prepare(size_mb)) {
+    state.SkipWithError("Failed to prepare the cache");
+    return;
+  }
+
+  const auto path = WorkPath(size_mb);
+  for (auto _ : state) {
+    state.PauseTiming();
+    DefaultCache cache(MutableSettings(path, size_mb));
+    if (!CopyDirectory(SnapshotPath(size_mb), path) ||
+        cache.Open() != DefaultCache::Success) {
+      state.SkipWithError("Failed to copy the cache");
+      break;
+    }
+    state.ResumeTiming();
+
+    cache.Compact();
+
+    state.PauseTiming();
+    cache.Close();
+    state.ResumeTiming();
+  }
+  SetCounters(state, path);
+  Dir::Remove(path);
+}
+
+/// Registers the cache sizes from the OLP_BENCHMARK_CACHE_SIZES env. variable.
+void CacheSizes(benchmark::internal::Benchmark* benchmark) {
+  const char* sizes = std::getenv("OLP_BENCHMARK_CACHE_SIZES");
+  std::istringstream stream(sizes ? sizes : "100");
+  std::string size;
+  while (std::getline(stream, size, ',')) {
+    benchmark->Arg(std::strtoll(size.c_str(), nullptr, 10));
+  }
+  benchmark->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(CacheOpen)->Apply(CacheSizes);
+BENCHMARK(CacheOpenAndWarmUp)->Apply(CacheSizes);
+BENCHMARK(CacheRecoverAfterDirtyShutdown)->Apply(CacheSizes);
+BENCHMARK(ProtectedCacheOpen)->Apply(CacheSizes);
+// Every iteration compacts the whole cache.
+BENCHMARK(CacheCompact)->Apply(CacheSizes)->Iterations(1);
+
+}  // namespace
+#endif  // OLP_SDK_ENABLE_DEFAULT_CACHE
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+// clang-format off
+#include "generated/parser/CatalogParser.h"
+#include "generated/parser/PartitionsParser.h"
+#include <olp/core/generated/parser/JsonParser.h>
+// clang-format on
+
+namespace {
+namespace model = olp::dataservice::read::model;
+
+std::string GeneratePartitions(size_t count) {
+  std::string json = "{\"partitions\":[";
+  for (size_t idx = 0u; idx < count; ++idx) {
+    const auto id = std::to_string(idx);
+    json += (idx > 0u ? ",{" : "{");
+    json += "\"partition\":\"" + id + "\",";
+    json += "\"dataHandle\":\"handle-" + id + "\",";
+    json += "\"checksum\":\"4f2b0c8e" + id + "\",";
+    json += "\"dataSize\":" + std::to_string(1024u + idx) + ",";
+    json += "\"version\":" + std::to_string(idx % 7u) + "}";
+  }
+  return json + "]}";
+}
+
+std::string GenerateCatalog(size_t layers) {
+  std::string json =
+      "{\"id\":\"catalog\",\"hrn\":\"hrn:here:data::olp-here-test:catalog\","
+      "\"name\":\"Catalog\",\"summary\":\"Summary\",\"description\":\"\","
+      "\"tags\":[\"a\",\"b\"],\"created\":\"2021-01-01T00:00:00.000Z\","
+      "\"version\":42,\"layers\":[";
+  for (size_t idx = 0u; idx < layers; ++idx) {
+    const auto id = "layer-" + std::to_string(idx);
+    json += (idx > 0u ? ",{" : "{");
+    json += "\"id\":\"" + id + "\",\"name\":\"" + id + "\",";
+    json += "\"hrn\":\"hrn:here:data::olp-here-test:catalog:" + id + "\",";
+    json += "\"summary\":\"Summary\",\"description\":\"Description\",";
+    json += "\"coverage\":{\"adminAreas\":[\"DE\",\"FR\"]},";
+    json += "\"partitioning\":{\"scheme\":\"heretile\",\"tileLevels\":[12]},";
+    json += "\"contentType\":\"application/x-protobuf\",";
+    json += "\"layerType\":\"versioned\",\"tags\":[\"tag\"],";
+    json += "\"volume\":{\"volumeType\":\"durable\"}}";
+  }
+  return json + "]}";
+}
+
+void ParsePartitionsDom(benchmark::State& state) {
+  const auto json = GeneratePartitions(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(olp::parser::parse<model::Partitions>(json));
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+void ParsePartitionsStream(benchmark::State& state) {
+  const auto json = GeneratePartitions(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::stringstream stream(json);
+    bool res = false;
+    benchmark::DoNotOptimize(
+        olp::parser::parse<model::Partitions>(stream, res));
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+void ParseCatalog(benchmark::State& state) {
+  const auto json = GenerateCatalog(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(olp::parser::parse<model::Catalog>(json));
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+BENCHMARK(ParsePartitionsDom)->Range(16, 16384);
+BENCHMARK(ParsePartitionsStream)->Range(16, 16384);
+BENCHMARK(ParseCatalog)->Range(1, 256);
+
+}  // namespace
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <olp/core/geo/tiling/TileKey.h>
+#include "repositories/QuadTreeIndex.h"
+
+namespace {
+using olp::dataservice::read::QuadTreeIndex;
+using olp::geo::TileKey;
+
+constexpr auto kRootTile = "23618364";
+
+/// Generates the quad tree response of the given depth with all sub quads
+/// present, like the query service returns for a dense layer.
+std::string GenerateQuadTree(int depth) {
+  std::string json = "{\"subQuads\":[";
+  bool first = true;
+  for (int level = 0; level <= depth; ++level) {
+    const auto size = 1u << level;
+    for (std::uint32_t row = 0u; row < size; ++row) {
+      for (std::uint32_t column = 0u; column < size; ++column) {
+        const auto sub_quad =
+            TileKey::FromRowColumnLevel(row, column, level).ToHereTile();
+        json += first ? "{" : ",{";
+        json += "\"subQuadKey\":\"" + sub_quad + "\",\"version\":42,";
+        json += "\"dataHandle\":\"handle-" + sub_quad + "\",";
+        json += "\"dataSize\":1024}";
+        first = false;
+      }
+    }
+  }
+  json += "],\"parentQuads\":[";
+  auto parent = TileKey::FromHereTile(kRootTile).Parent();
+  for (first = true; parent.IsValid(); parent = parent.Parent()) {
+    json += first ? "{" : ",{";
+    json += "\"partition\":\"" + parent.ToHereTile() + "\",\"version\":42,";
+    json += "\"dataHandle\":\"handle-" + parent.ToHereTile() + "\",";
+    json += "\"dataSize\":1024}";
+    first = false;
+  }
+  return json + "]}";
+}
+
+/// Collects the tiles of the tree and the ones below it, which are found in
+/// the parents with the aggregated lookup.
+std::vector<TileKey> GenerateLookups(int depth) {
+  const auto root = TileKey::FromHereTile(kRootTile);
+  std::vector<TileKey> tiles;
+  for (const auto& level : {0, depth / 2, depth, depth + 2}) {
+    const auto first = root.ChangedLevelBy(level);
+    tiles.push_back(first);
+    tiles.push_back(first.NextColumn().NextRow());
+  }
+  return tiles;
+}
+
+void QuadTreeIndexParse(benchmark::State& state) {
+  const auto depth = static_cast<int>(state.range(0));
+  const auto json = GenerateQuadTree(depth);
+  const auto root = TileKey::FromHereTile(kRootTile);
+  for (auto _ : state) {
+    std::stringstream stream(json);
+    QuadTreeIndex index(root, depth, stream);
+    benchmark::DoNotOptimize(index.IsNull());
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+void QuadTreeIndexFromCache(benchmark::State& state) {
+  const auto depth = static_cast<int>(state.range(0));
+  std::stringstream stream(GenerateQuadTree(depth));
+  const QuadTreeIndex parsed(TileKey::FromHereTile(kRootTile), depth, stream);
+  const auto raw_data = parsed.GetRawData();
+  for (auto _ : state) {
+    QuadTreeIndex index(raw_data);
+    benchmark::DoNotOptimize(index.IsNull());
+  }
+}
+
+void QuadTreeIndexFind(benchmark::State& state) {
+  const auto depth = static_cast<int>(state.range(0));
+  const bool aggregated = state.range(1) != 0;
+  std::stringstream stream(GenerateQuadTree(depth));
+  const QuadTreeIndex index(TileKey::FromHereTile(kRootTile), depth, stream);
+  const auto tiles = GenerateLookups(depth);
+
+  size_t idx = 0u;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        index.Find(tiles[idx++ % tiles.size()], aggregated));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(QuadTreeIndexParse)->DenseRange(0, 4);
+BENCHMARK(QuadTreeIndexFromCache)->DenseRange(0, 4);
+BENCHMARK(QuadTreeIndexFind)
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({4, 0})
+    ->Args({4, 1});
+
+}  // namespace
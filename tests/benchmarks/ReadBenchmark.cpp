@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/geo/tiling/TileKey.h>
+#include <olp/core/logging/Log.h>
+#include <olp/dataservice/read/VersionedLayerClient.h>
+#include "InMemoryNetwork.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+
+constexpr auto kLevel = 12u;
+
+/// Requests the tiles online from the in-process network without a delay, so
+/// only the overhead of the SDK is measured: the lookup, the quad tree and
+/// the blob requests, the parsing and the task scheduling. The range argument
+/// is the blob size in KiB.
+void VersionedLayerGetData(benchmark::State& state) {
+  olp::logging::Log::setLevel(olp::logging::Level::Error);
+
+  auto network = std::make_shared<InMemoryNetwork>();
+  const auto blob_size = static_cast<size_t>(state.range(0)) * 1024u;
+  AddReadCatalogResponses(*network, blob_size);
+
+  olp::client::AuthenticationSettings auth_settings;
+  auth_settings.provider = []() { return "invalid"; };
+
+  olp::client::OlpClientSettings settings;
+  settings.authentication_settings = auth_settings;
+  settings.task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(2u);
+  settings.network_request_handler = network;
+
+  read::VersionedLayerClient client(
+      olp::client::HRN("hrn:here:data::olp-here-test:catalog"),
+      "versioned_test_layer", 100, settings);
+
+  const auto row_count = 1u << kLevel;
+  std::uint32_t tile = 0u;
+  for (auto _ : state) {
+    const auto key = olp::geo::TileKey::FromRowColumnLevel(
+        tile / row_count, tile % row_count, kLevel);
+    ++tile;
+    auto request =
+        read::TileRequest().WithTileKey(key).WithFetchOption(read::OnlineOnly);
+    auto response = client.GetData(std::move(request)).GetFuture().get();
+    if (!response.IsSuccessful()) {
+      state.SkipWithError(response.GetError().GetMessage().c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * blob_size);
+}
+
+BENCHMARK(VersionedLayerGetData)
+    ->Arg(1)
+    ->Arg(64)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+}  // namespace
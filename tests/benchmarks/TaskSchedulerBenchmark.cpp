@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+
+namespace {
+
+constexpr int64_t kTasks = 10000;
+
+/// Schedules a batch of empty tasks from one thread and waits until the
+/// workers run all of them, the range argument is the worker count.
+void ThreadPoolTaskSchedulerThroughput(benchmark::State& state) {
+  olp::thread::ThreadPoolTaskScheduler scheduler(
+      static_cast<size_t>(state.range(0)));
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::atomic<int64_t> pending{0};
+
+  for (auto _ : state) {
+    pending.store(kTasks);
+    for (int64_t i = 0; i < kTasks; ++i) {
+      scheduler.ScheduleTask([&]() {
+        if (pending.fetch_sub(1) == 1) {
+          std::lock_guard<std::mutex> lock(mutex);
+          condition.notify_one();
+        }
+      });
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [&]() { return pending.load() == 0; });
+  }
+  state.SetItemsProcessed(state.iterations() * kTasks);
+}
+
+/// Schedules the tasks from several threads at the same time, which measures
+/// the contention on the queue. The workers are not waited for.
+void ThreadPoolTaskSchedulerConcurrentEnqueue(benchmark::State& state) {
+  static olp::thread::ThreadPoolTaskScheduler scheduler(2u);
+
+  for (auto _ : state) {
+    scheduler.ScheduleTask([]() {});
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(ThreadPoolTaskSchedulerThroughput)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(ThreadPoolTaskSchedulerConcurrentEnqueue)->ThreadRange(1, 8);
+
+}  // namespace
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <olp/core/geo/tiling/TileKey.h>
+
+namespace {
+using olp::geo::TileKey;
+
+/// A tile at the level of the range argument, near Berlin.
+TileKey MakeTile(int64_t level) {
+  const auto tile = TileKey::FromRowColumnLevel(168876u, 140815u, 18u);
+  return tile.ChangedLevelTo(static_cast<std::uint32_t>(level));
+}
+
+void TileKeyToHereTile(benchmark::State& state) {
+  const auto tile = MakeTile(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tile.ToHereTile());
+  }
+}
+
+void TileKeyFromHereTile(benchmark::State& state) {
+  const auto here_tile = MakeTile(state.range(0)).ToHereTile();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TileKey::FromHereTile(here_tile));
+  }
+}
+
+void TileKeyToQuadKey(benchmark::State& state) {
+  const auto tile = MakeTile(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tile.ToQuadKey());
+  }
+}
+
+void TileKeyFromQuadKey(benchmark::State& state) {
+  const auto quad_key = MakeTile(state.range(0)).ToQuadKey();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TileKey::FromQuadKey(quad_key));
+  }
+}
+
+void TileKeyQuadKey64(benchmark::State& state) {
+  const auto tile = MakeTile(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TileKey::FromQuadKey64(tile.ToQuadKey64()));
+  }
+}
+
+BENCHMARK(TileKeyToHereTile)->Arg(4)->Arg(12)->Arg(18);
+BENCHMARK(TileKeyFromHereTile)->Arg(4)->Arg(12)->Arg(18);
+BENCHMARK(TileKeyToQuadKey)->Arg(4)->Arg(12)->Arg(18);
+BENCHMARK(TileKeyFromQuadKey)->Arg(4)->Arg(12)->Arg(18);
+BENCHMARK(TileKeyQuadKey64)->Arg(4)->Arg(12)->Arg(18);
+
+}  // namespace
@@ -64,6 +64,23 @@ MATCHER_P(IsPostRequest, url, "") {
          url == arg.GetUrl();
 }
 
+MATCHER_P(IsPostRequestPrefix, url, "") {
+  if (olp::http::NetworkRequest::HttpVerb::POST != arg.GetVerb()) {
+    return false;
+  }
+
+  std::string url_string(url);
+  auto res =
+      std::mismatch(url_string.begin(), url_string.end(), arg.GetUrl().begin());
+
+  return (res.first == url_string.end());
+}
+
+MATCHER_P(IsHeadRequest, url, "") {
+  return olp::http::NetworkRequest::HttpVerb::HEAD == arg.GetVerb() &&
+         url == arg.GetUrl();
+}
+
 MATCHER_P(IsDeleteRequest, url, "") {
   return olp::http::NetworkRequest::HttpVerb::DEL == arg.GetVerb() &&
          url == arg.GetUrl();
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+// The pre-resolve is implemented by the Curl network only.
+#if defined(__linux__) && !defined(ANDROID)
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/http/Network.h>
+#include <olp/core/http/NetworkSettings.h>
+
+namespace {
+using OlpClientSettingsFactory = olp::client::OlpClientSettingsFactory;
+using NetworkRequest = olp::http::NetworkRequest;
+using NetworkResponse = olp::http::NetworkResponse;
+
+/// Serves the keep-alive HTTP requests on the loopback interface and counts
+/// the accepted connections.
+class LoopbackServer {
+ public:
+  LoopbackServer() {
+    listener_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (listener_ < 0 ||
+        bind(listener_, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+        listen(listener_, 8) != 0 ||
+        getsockname(listener_, reinterpret_cast<sockaddr*>(&address),
+                    &length) != 0) {
+      return;
+    }
+    port_ = ntohs(address.sin_port);
+    thread_ = std::thread(&LoopbackServer::Run, this);
+  }
+
+  ~LoopbackServer() {
+    stop_ = true;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    for (auto fd : connections_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+    if (listener_ >= 0) {
+      close(listener_);
+    }
+  }
+
+  std::string Url() const {
+    return "http://127.0.0.1:" + std::to_string(port_);
+  }
+
+  int Port() const { return port_; }
+
+  int Connections() const { return connection_count_; }
+
+  int Requests() const { return request_count_; }
+
+ private:
+  void Run() {
+    std::vector<std::string> buffers;
+    while (!stop_) {
+      std::vector<pollfd> fds{{listener_, POLLIN, 0}};
+      for (auto fd : connections_) {
+        fds.push_back({fd, POLLIN, 0});
+      }
+      if (poll(fds.data(), fds.size(), 10) <= 0) {
+        continue;
+      }
+
+      if (fds[0].revents & POLLIN) {
+        const auto fd = accept(listener_, nullptr, nullptr);
+        if (fd >= 0) {
+          connections_.push_back(fd);
+          buffers.emplace_back();
+          ++connection_count_;
+        }
+      }
+
+      for (size_t i = 1; i < fds.size(); ++i) {
+        if ((fds[i].revents & (POLLIN | POLLHUP)) &&
+            !Read(fds[i].fd, buffers[i - 1])) {
+          // The negative descriptors are ignored by poll().
+          close(fds[i].fd);
+          connections_[i - 1] = -1;
+        }
+      }
+    }
+  }
+
+  // Answers the received requests, returns false if the connection is closed.
+  bool Read(int fd, std::string& buffer) {
+    char data[1024];
+    const auto size = recv(fd, data, sizeof(data), 0);
+    if (size <= 0) {
+      return false;
+    }
+    buffer.append(data, size);
+
+    std::string::size_type end;
+    while ((end = buffer.find("\r\n\r\n")) != std::string::npos) {
+      const bool head = buffer.compare(0, 5, "HEAD ") == 0;
+      buffer.erase(0, end + 4);
+
+      // The response to HEAD has no body, otherwise the client closes the
+      // connection.
+      std::string response =
+          "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n"
+          "Connection: keep-alive\r\n\r\n";
+      if (!head) {
+        response += "ok";
+      }
+      send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+      ++request_count_;
+    }
+    return true;
+  }
+
+  int listener_{-1};
+  int port_{0};
+  std::vector<int> connections_;
+  std::atomic<bool> stop_{false};
+  std::atomic<int> connection_count_{0};
+  std::atomic<int> request_count_{0};
+  std::thread thread_;
+};
+
+TEST(PreResolveTest, RequestReusesConnection) {
+  LoopbackServer server;
+  ASSERT_NE(server.Port(), 0);
+
+  auto network = OlpClientSettingsFactory::CreateDefaultNetworkRequestHandler();
+  network->PreResolve({server.Url() + "/some-api"});
+
+  // Waits for the pre-resolve request, and for the client to put the
+  // connection back in the connection cache.
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (server.Requests() < 1 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(server.Requests(), 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  const auto request =
+      NetworkRequest(server.Url() + "/some-api")
+          .WithVerb(NetworkRequest::HttpVerb::GET)
+          .WithSettings(olp::http::NetworkSettings());
+  auto payload = std::make_shared<std::stringstream>();
+
+  std::promise<NetworkResponse> promise;
+  const auto outcome = network->Send(
+      request, payload,
+      [&promise](NetworkResponse response) {
+        promise.set_value(std::move(response));
+      });
+  ASSERT_TRUE(outcome.IsSuccessful());
+
+  auto future = promise.get_future();
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  const auto response = future.get();
+
+  EXPECT_EQ(response.GetStatus(), 200);
+  EXPECT_EQ(payload->str(), "ok");
+  EXPECT_EQ(server.Requests(), 2);
+  EXPECT_EQ(server.Connections(), 1);
+}
+
+}  // namespace
+
+#endif  // defined(__linux__) && !defined(ANDROID)
@@ -17,6 +17,9 @@
  * License-Filename: LICENSE
  */
 
+#include <atomic>
+#include <future>
+
 #include <gmock/gmock.h>
 #include <matchers/NetworkUrlMatchers.h>
 #include <mocks/NetworkMock.h>
@@ -257,4 +260,70 @@ TEST_F(HereAccountOauth2Test, AutoRefreshingTokenCancelAsync) {
       });
 }
 
+TEST_F(HereAccountOauth2Test, AutoRefreshingTokenMinimumValidity) {
+  std::atomic<int> requests{0};
+  std::promise<void> background_request;
+  EXPECT_CALL(*network_, Send(_, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly(
+          [&](olp::http::NetworkRequest /*request*/,
+              olp::http::Network::Payload payload,
+              olp::http::Network::Callback callback,
+              olp::http::Network::HeaderCallback /*header_callback*/,
+              olp::http::Network::DataCallback data_callback) {
+            olp::http::RequestId request_id(++requests);
+            if (payload) {
+              *payload << kResponseValidJson;
+            }
+            callback(olp::http::NetworkResponse()
+                         .WithRequestId(request_id)
+                         .WithStatus(olp::http::HttpStatusCode::OK)
+                         .WithError(kErrorOk));
+            if (data_callback) {
+              auto raw = const_cast<char*>(kResponseValidJson.c_str());
+              data_callback(reinterpret_cast<uint8_t*>(raw), 0,
+                            kResponseValidJson.size());
+            }
+            if (request_id == 3) {
+              background_request.set_value();
+            }
+
+            return olp::http::SendOutcome(request_id);
+          });
+
+  auth::Settings settings({key_, secret_});
+  settings.network_request_handler = network_;
+  auth::TokenEndpoint token_endpoint(settings);
+  auto auto_token = token_endpoint.RequestAutoRefreshingToken();
+  olp::client::CancellationToken cancellation_token;
+
+  {
+    SCOPED_TRACE("The token expires within the minimum validity");
+
+    // The token expires in an hour
+    auto token = GetTokenFromSyncRequest(cancellation_token, auto_token,
+                                         std::chrono::minutes(5));
+    ASSERT_TRUE(token.IsSuccessful());
+    EXPECT_EQ(requests, 1);
+
+    // The caller waits for a new token
+    token = GetTokenFromSyncRequest(cancellation_token, auto_token,
+                                    std::chrono::hours(2));
+    ASSERT_TRUE(token.IsSuccessful());
+    EXPECT_EQ(requests, 2);
+  }
+
+  {
+    SCOPED_TRACE("The token expires within twice the minimum validity");
+
+    // The cached token is returned and a new one is requested in the
+    // background
+    auto token = GetTokenFromAsyncRequest(cancellation_token, auto_token,
+                                          std::chrono::minutes(40));
+    ASSERT_TRUE(token.IsSuccessful());
+    EXPECT_EQ(background_request.get_future().wait_for(std::chrono::seconds(5)),
+              std::future_status::ready);
+  }
+}
+
 PORTING_POP_WARNINGS()
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "VersionedLayerTestBase.h"
+
+#include <string>
+
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/cache/DefaultCache.h>
+#include <olp/core/geo/tiling/TileKeyUtils.h>
+#include <olp/core/geo/tiling/TilingSchemeRegistry.h>
+#include <olp/core/utils/Dir.h>
+#include <olp/dataservice/read/CachePackBuilder.h>
+#include <olp/dataservice/read/TileRequest.h>
+
+namespace {
+
+namespace read = olp::dataservice::read;
+using testing::_;
+
+constexpr auto kPackPath = "./tmp_cache_pack";
+constexpr auto kWaitTimeout = std::chrono::seconds(3);
+
+class CachePackBuilderTest : public VersionedLayerTestBase {
+ protected:
+  void SetUp() override {
+    VersionedLayerTestBase::SetUp();
+    olp::utils::Dir::Remove(kPackPath);
+  }
+
+  void TearDown() override {
+    olp::utils::Dir::Remove(kPackPath);
+    VersionedLayerTestBase::TearDown();
+  }
+};
+
+TEST_F(CachePackBuilderTest, BuildAndReadBack) {
+  const auto layer_version = 7;
+
+  // A rectangle inside one tile of the level 14.
+  const olp::geo::GeoRectangle rectangle(
+      olp::geo::GeoCoordinates::FromDegrees(52.5201, 13.4049),
+      olp::geo::GeoCoordinates::FromDegrees(52.5202, 13.4050));
+  const auto tile_keys = olp::geo::TileKeyUtils::GeoRectangleToTileKeys(
+      olp::geo::HalfQuadTreeIdentityTilingScheme(), rectangle, 14u);
+  ASSERT_EQ(tile_keys.size(), 1u);
+  const auto tile_key = tile_keys.front();
+
+  {
+    SCOPED_TRACE("Build the pack");
+
+    mockserver::QuadTreeBuilder tree(tile_key.ChangedLevelTo(10),
+                                     layer_version);
+    tree.WithSubQuad(tile_key, "handle-1");
+    ExpectQuadTreeRequest(layer_version, tree);
+    ExpectBlobRequest("handle-1", "tile data");
+
+    read::CachePackBuilder builder(kCatalogHrn, settings_);
+    auto response = builder.Build(read::CachePackRequest()
+                                      .WithLayerIds({kLayerName})
+                                      .WithGeoRectangle(rectangle)
+                                      .WithMinLevel(14u)
+                                      .WithMaxLevel(14u)
+                                      .WithVersion(layer_version)
+                                      .WithOutputPath(kPackPath));
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(response.GetResult().version, layer_version);
+    EXPECT_EQ(response.GetResult().tile_count, 1u);
+    testing::Mock::VerifyAndClearExpectations(network_mock_.get());
+  }
+
+  {
+    SCOPED_TRACE("Read the tile from the pack without the network");
+
+    EXPECT_CALL(*network_mock_, Send(_, _, _, _, _)).Times(0);
+
+    olp::cache::CacheSettings cache_settings;
+    cache_settings.disk_path_protected = kPackPath;
+    auto cache = std::make_shared<olp::cache::DefaultCache>(cache_settings);
+    ASSERT_EQ(cache->Open(), olp::cache::DefaultCache::Success);
+
+    auto settings = settings_;
+    settings.cache = cache;
+    read::VersionedLayerClient client(kCatalogHrn, kLayerName, layer_version,
+                                      settings);
+    EXPECT_TRUE(client.IsCached(tile_key));
+
+    auto future = client
+                      .GetData(read::TileRequest()
+                                   .WithTileKey(tile_key)
+                                   .WithFetchOption(read::CacheOnly))
+                      .GetFuture();
+    ASSERT_NE(future.wait_for(kWaitTimeout), std::future_status::timeout);
+
+    auto response = future.get();
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    ASSERT_TRUE(response.GetResult());
+    EXPECT_EQ(std::string(response.GetResult()->begin(),
+                          response.GetResult()->end()),
+              "tile data");
+    cache->Close();
+  }
+}
+
+}  // namespace
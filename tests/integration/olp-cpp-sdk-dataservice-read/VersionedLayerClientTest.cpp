@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -35,6 +36,7 @@
 #include <olp/core/client/OlpClientSettingsFactory.h>
 #include <olp/core/porting/warning_disable.h>
 #include <olp/core/utils/Dir.h>
+#include <olp/dataservice/read/CatalogClient.h>
 #include <olp/dataservice/read/VersionedLayerClient.h>
 #include <olp/dataservice/read/model/Partitions.h>
 
@@ -2904,6 +2906,68 @@ TEST_F(DataserviceReadVersionedLayerClientTest, GetTileConcurrent) {
   }
 }
 
+TEST_F(DataserviceReadVersionedLayerClientTest, GetTilesFromCatalogClient) {
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(URL_LOOKUP_API), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(GetResponse(http::HttpStatusCode::OK),
+                                   HTTP_RESPONSE_LOOKUP));
+
+  // Both tiles are in the same quad tree, so it is requested once.
+  EXPECT_CALL(*network_mock_,
+              Send(IsGetRequest(kHttpQueryTreeIndex_23064), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(GetResponse(http::HttpStatusCode::OK),
+                                   kHttpSubQuads_23064));
+
+  EXPECT_CALL(*network_mock_,
+              Send(IsGetRequest(kHttpResponseBlobData_5904591), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(GetResponse(http::HttpStatusCode::OK),
+                                   "someData"));
+  EXPECT_CALL(*network_mock_,
+              Send(IsGetRequest(kUrlBlobData_1476147), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(GetResponse(http::HttpStatusCode::OK),
+                                   "otherData"));
+
+  settings_.task_scheduler =
+      client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(4);
+  read::CatalogClient client(kCatalog, settings_);
+
+  std::map<std::string, read::DataResponse> responses;
+  auto request =
+      read::TilesRequest()
+          .WithLayerIds({kTestLayer})
+          .WithTileKeys({geo::TileKey::FromHereTile("5904591"),
+                         geo::TileKey::FromHereTile("1476147"),
+                         geo::TileKey()})
+          .WithCatalogVersion(4);
+  auto future = client.GetTiles(
+      request, [&](const std::string& layer_id, const geo::TileKey& tile,
+                   read::DataResponse response) {
+        EXPECT_EQ(layer_id, kTestLayer);
+        responses.emplace(tile.ToHereTile(), std::move(response));
+      });
+
+  const auto response = future.GetFuture().get();
+  ASSERT_TRUE(response.IsSuccessful())
+      << ApiErrorToString(response.GetError());
+  ASSERT_EQ(responses.size(), 3u);
+
+  const auto& data = responses["5904591"];
+  ASSERT_TRUE(data.IsSuccessful()) << ApiErrorToString(data.GetError());
+  EXPECT_EQ(std::string(data.GetResult()->begin(), data.GetResult()->end()),
+            "someData");
+
+  const auto& other_data = responses["1476147"];
+  ASSERT_TRUE(other_data.IsSuccessful())
+      << ApiErrorToString(other_data.GetError());
+  EXPECT_EQ(std::string(other_data.GetResult()->begin(),
+                        other_data.GetResult()->end()),
+            "otherData");
+
+  const auto& invalid = responses[geo::TileKey().ToHereTile()];
+  ASSERT_FALSE(invalid.IsSuccessful());
+  EXPECT_EQ(invalid.GetError().GetErrorCode(),
+            client::ErrorCode::InvalidArgument);
+}
+
 TEST_F(DataserviceReadVersionedLayerClientTest, GetTileCacheOnly) {
   EXPECT_CALL(*network_mock_, Send(IsGetRequest(URL_BLOB_DATA_269), _, _, _, _))
       .Times(0);
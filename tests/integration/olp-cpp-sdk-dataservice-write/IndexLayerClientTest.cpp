@@ -209,6 +209,47 @@ TEST_F(IndexLayerClientTest, PublishData) {
   ASSERT_NO_FATAL_FAILURE(PublishDataSuccessAssertions(response));
 }
 
+TEST_F(IndexLayerClientTest, PublishIndexes) {
+  {
+    EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_BLOB), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_INDEX), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_CONFIG), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*network_, Send(IsGetRequest(URL_GET_CATALOG), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*network_,
+                Send(IsPutRequestPrefix(URL_PUT_BLOB_INDEX_PREFIX), _, _, _, _))
+        .Times(5);
+    EXPECT_CALL(*network_, Send(IsPostRequest(URL_INSERT_INDEX), _, _, _, _))
+        .Times(3);
+  }
+
+  olp::client::OlpClientSettings client_settings;
+  client_settings.network_request_handler = network_;
+  client_settings.task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler();
+  write::IndexLayerClientSettings index_settings;
+  index_settings.index_batch_size = 2u;
+  write::IndexLayerClient client(olp::client::HRN{GetTestCatalog()},
+                                 index_settings, client_settings);
+
+  std::vector<model::PublishIndexRequest> requests(
+      5u, model::PublishIndexRequest()
+              .WithIndex(GetTestIndex())
+              .WithData(data_)
+              .WithLayerId(GetTestLayer()));
+  auto response = client.PublishIndexes(requests).GetFuture().get();
+
+  testing::Mock::VerifyAndClearExpectations(network_.get());
+  ASSERT_TRUE(response.IsSuccessful());
+  ASSERT_EQ(5u, response.GetResult().size());
+  EXPECT_FALSE(response.GetResult().front().GetTraceID().empty());
+  EXPECT_NE(response.GetResult().front().GetTraceID(),
+            response.GetResult().back().GetTraceID());
+}
+
 TEST_F(IndexLayerClientTest, DeleteData) {
   {
     EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_BLOB), _, _, _, _))
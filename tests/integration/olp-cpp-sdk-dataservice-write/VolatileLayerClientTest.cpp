@@ -285,4 +285,46 @@ TEST_F(VolatileLayerClientTest, PublishDataCancelCatalog) {
             response.GetError().GetErrorCode());
 }
 
+TEST_F(VolatileLayerClientTest, PublishPartitionsDataCoalesced) {
+  auto new_client = CreateVolatileLayerClient();
+  const std::string last_data = "last data";
+  {
+    EXPECT_CALL(*network_,
+                Send(IsGetRequest(URL_LOOKUP_VOLATILE_BLOB), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_QUERY), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*network_,
+                Send(IsGetRequest(URL_QUERY_PARTITION_1111), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_CONFIG), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*network_, Send(IsGetRequest(URL_GET_CATALOG), _, _, _, _))
+        .Times(1);
+    EXPECT_CALL(*network_,
+                Send(testing::AllOf(
+                         IsPutRequestPrefix(URL_PUT_VOLATILE_BLOB_PREFIX),
+                         BodyEq(last_data)),
+                     _, _, _, _))
+        .Times(1);
+  }
+
+  std::vector<model::PublishPartitionDataRequest> requests;
+  for (int i = 0; i < 3; ++i) {
+    requests.push_back(model::PublishPartitionDataRequest()
+                           .WithData(data_)
+                           .WithLayerId(GetTestLayer())
+                           .WithPartitionId("1111"));
+  }
+  requests.back().WithData(std::make_shared<std::vector<unsigned char>>(
+      last_data.begin(), last_data.end()));
+
+  auto response =
+      new_client->PublishPartitionsData(requests).GetFuture().get();
+
+  ASSERT_TRUE(response.IsSuccessful());
+  ASSERT_EQ(1u, response.GetResult().size());
+  EXPECT_EQ("1111", response.GetResult().front().GetTraceID());
+}
+
 }  // namespace
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+// windows.h must come before psapi.h.
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+std::atomic<std::uint64_t> allocation_count{0u};
+std::atomic<std::uint64_t> allocation_bytes{0u};
+std::atomic<std::uint64_t> live_bytes{0u};
+std::atomic<std::uint64_t> peak_live_bytes{0u};
+
+// The size of an allocation is stored in front of it, the header keeps the
+// alignment of the returned memory.
+constexpr std::size_t kHeaderSize =
+    alignof(std::max_align_t) > sizeof(std::size_t) ? alignof(std::max_align_t)
+                                                     : sizeof(std::size_t);
+
+void UpdatePeak(std::uint64_t live) {
+  auto peak = peak_live_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !peak_live_bytes.compare_exchange_weak(
+                            peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+void* Allocate(std::size_t size) noexcept {
+  auto* block = static_cast<char*>(std::malloc(kHeaderSize + size));
+  if (!block) {
+    return nullptr;
+  }
+
+  *reinterpret_cast<std::size_t*>(block) = size;
+  allocation_count.fetch_add(1u, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  UpdatePeak(live_bytes.fetch_add(size, std::memory_order_relaxed) + size);
+  return block + kHeaderSize;
+}
+
+void Free(void* pointer) noexcept {
+  if (!pointer) {
+    return;
+  }
+
+  auto* block = static_cast<char*>(pointer) - kHeaderSize;
+  live_bytes.fetch_sub(*reinterpret_cast<std::size_t*>(block),
+                       std::memory_order_relaxed);
+  std::free(block);
+}
+
+void* AllocateOrThrow(std::size_t size) {
+  if (void* pointer = Allocate(size == 0u ? 1u : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+}  // namespace
+
+std::uint64_t GetAllocationCount() {
+  return allocation_count.load(std::memory_order_relaxed);
+}
+
+AllocationStatistics GetAllocationStatistics() {
+  AllocationStatistics statistics;
+  statistics.count = allocation_count.load(std::memory_order_relaxed);
+  statistics.bytes = allocation_bytes.load(std::memory_order_relaxed);
+  statistics.live_bytes = live_bytes.load(std::memory_order_relaxed);
+  statistics.peak_live_bytes = peak_live_bytes.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+void ResetAllocationPeak() {
+  peak_live_bytes.store(live_bytes.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+}
+
+std::uint64_t GetPeakResidentSetSize() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.PeakWorkingSetSize;
+  }
+  return 0u;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0u;
+  }
+#if defined(__APPLE__)
+  // The size is in bytes on macOS, and in kilobytes on the other platforms.
+  return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+  return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024u;
+#endif
+#endif
+}
+
+// All the forms are replaced, as the memory of one form can be freed with
+// another one, and some standard libraries do not forward them.
+void* operator new(std::size_t size) { return AllocateOrThrow(size); }
+
+void* operator new[](std::size_t size) { return AllocateOrThrow(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size == 0u ? 1u : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size == 0u ? 1u : size);
+}
+
+void operator delete(void* pointer) noexcept { Free(pointer); }
+
+void operator delete[](void* pointer) noexcept { Free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept { Free(pointer); }
+
+void operator delete[](void* pointer, std::size_t) noexcept { Free(pointer); }
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  Free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  Free(pointer);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/*
+ * The heap usage of the process. The test runner replaces the global
+ * `operator new` and `operator delete` to count the allocations and their
+ * sizes.
+ */
+struct AllocationStatistics {
+  // The number of the allocations made so far.
+  std::uint64_t count{0u};
+  // The total size of the allocations made so far.
+  std::uint64_t bytes{0u};
+  // The size of the allocations that are not freed yet.
+  std::uint64_t live_bytes{0u};
+  // The maximum of `live_bytes` since the last `ResetAllocationPeak` call.
+  std::uint64_t peak_live_bytes{0u};
+};
+
+/*
+ * Returns the number of the heap allocations made by the process so far.
+ */
+std::uint64_t GetAllocationCount();
+
+/*
+ * Returns the heap usage of the process.
+ */
+AllocationStatistics GetAllocationStatistics();
+
+/*
+ * Resets the peak of the live bytes to the current live bytes, so the peak of
+ * the next phase can be measured.
+ */
+void ResetAllocationPeak();
+
+/*
+ * Returns the peak resident set size of the process in bytes, or 0 if it is
+ * not supported on the platform.
+ */
+std::uint64_t GetPeakResidentSetSize();
+
+/*
+ * Measures the heap usage of a test phase, like the setup of a client or the
+ * requests. The phases must not overlap, as they share the peak.
+ */
+class AllocationPhase {
+ public:
+  AllocationPhase() : start_(GetAllocationStatistics()) {
+    ResetAllocationPeak();
+  }
+
+  /*
+   * Returns the allocations made since the phase started, the live bytes
+   * added by the phase, and the peak of the live bytes above the start.
+   */
+  AllocationStatistics Get() const {
+    const auto current = GetAllocationStatistics();
+    AllocationStatistics result;
+    result.count = current.count - start_.count;
+    result.bytes = current.bytes - start_.bytes;
+    result.live_bytes = current.live_bytes > start_.live_bytes
+                            ? current.live_bytes - start_.live_bytes
+                            : 0u;
+    result.peak_live_bytes = current.peak_live_bytes > start_.live_bytes
+                                 ? current.peak_live_bytes - start_.live_bytes
+                                 : 0u;
+    return result;
+  }
+
+ private:
+  AllocationStatistics start_;
+};
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/utils/Base64.h>
+
+namespace {
+
+constexpr auto kLogTag = "Base64Test";
+constexpr size_t kRuns = 5u;
+
+struct Base64Configuration {
+  size_t bytes;
+};
+
+std::ostream& operator<<(std::ostream& os, const Base64Configuration& config) {
+  return os << "Base64Configuration(.bytes=" << config.bytes << ")";
+}
+
+std::vector<uint8_t> GenerateBytes(size_t count) {
+  std::mt19937 generator(count);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::vector<uint8_t> bytes(count);
+  std::generate(bytes.begin(), bytes.end(), [&]() {
+    return static_cast<uint8_t>(distribution(generator));
+  });
+  return bytes;
+}
+
+/// Returns the best time out of `kRuns` runs of the function.
+template <typename Function>
+std::chrono::microseconds Measure(Function function) {
+  auto best = std::chrono::microseconds::max();
+  for (size_t run = 0u; run < kRuns; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    best = std::min(best, elapsed);
+  }
+  return best;
+}
+
+class Base64Test : public ::testing::TestWithParam<Base64Configuration> {};
+
+/// Measures the encoding and the decoding of random bytes, which must produce
+/// the same bytes.
+TEST_P(Base64Test, RoundTrip) {
+  const auto bytes = GenerateBytes(GetParam().bytes);
+
+  std::string encoded;
+  const auto encode_time =
+      Measure([&]() { encoded = olp::utils::Base64Encode(bytes); });
+
+  std::vector<uint8_t> decoded;
+  bool res = false;
+  const auto decode_time =
+      Measure([&]() { res = olp::utils::Base64Decode(encoded, decoded); });
+
+  ASSERT_TRUE(res);
+  EXPECT_EQ(encoded.size(), (bytes.size() + 2u) / 3u * 4u);
+  EXPECT_TRUE(bytes == decoded);
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag, "bytes=%zu, encode=%lldus, decode=%lldus", bytes.size(),
+      static_cast<long long>(encode_time.count()),
+      static_cast<long long>(decode_time.count()));
+}
+
+INSTANTIATE_TEST_SUITE_P(Base64Throughput, Base64Test,
+                         ::testing::Values(Base64Configuration{64u},
+                                           Base64Configuration{64u * 1024u},
+                                           Base64Configuration{16u * 1024u *
+                                                               1024u}));
+}  // namespace
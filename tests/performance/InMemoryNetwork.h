@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <olp/core/geo/tiling/TileKey.h>
+#include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/http/Network.h>
+#include "NetworkWrapper.h"
+
+/*
+ * An in-process server that answers the requests with canned responses from
+ * memory, so the benchmarks measure the SDK and not a server or the loopback
+ * interface. The bodies are shared by the responses and are not copied per
+ * request: the data callback gets a pointer into the body, and the payload
+ * stream gets the only copy, like from a real network.
+ *
+ * The responses are delayed by the latency of the profile, drawn uniformly
+ * from `[latency, latency + latency_jitter]`, and by the time to transfer the
+ * body with the bandwidth. A share of the requests fails with the error status
+ * or with a timeout. The callbacks run on a separate thread.
+ */
+class InMemoryNetwork : public olp::http::Network {
+ public:
+  struct Profile {
+    std::chrono::milliseconds latency{0};
+    std::chrono::milliseconds latency_jitter{0};
+    // 0 means unlimited.
+    uint64_t bytes_per_second{0u};
+    // The share of the requests answered with the error status.
+    double error_rate{0.0};
+    int error_status{olp::http::HttpStatusCode::INTERNAL_SERVER_ERROR};
+    // The share of the requests that fail with a timeout after the latency.
+    double timeout_rate{0.0};
+  };
+
+  using Body = std::shared_ptr<const std::string>;
+
+  /*
+   * Sets the profile of the responses. Set it before sending.
+   */
+  void WithProfile(Profile profile) { profile_ = std::move(profile); }
+
+  /*
+   * Answers the requests with the URL that contains the pattern. The routes
+   * are matched in the order they are added.
+   */
+  void AddResponse(std::string pattern, int status, Body body) {
+    routes_.push_back(Route{std::move(pattern), status, std::move(body)});
+  }
+
+  void AddResponse(std::string pattern, int status, std::string body) {
+    AddResponse(std::move(pattern), status,
+                std::make_shared<const std::string>(std::move(body)));
+  }
+
+  olp::http::SendOutcome Send(olp::http::NetworkRequest request,
+                              Payload payload, Callback callback,
+                              HeaderCallback /*header_callback*/ = nullptr,
+                              DataCallback data_callback = nullptr) override {
+    const auto id = next_id_.fetch_add(1);
+    requests_.fetch_add(1);
+
+    const auto* route = FindRoute(request.GetUrl());
+    if (!route) {
+      unknown_requests_.fetch_add(1);
+    }
+
+    int status = route ? route->status : olp::http::HttpStatusCode::NOT_FOUND;
+    Body body = route ? route->body : nullptr;
+    std::string error;
+    auto delay = DrawOutcome(id, status, body, error);
+
+    const uint64_t size = body ? body->size() : 0u;
+    delay += TransferTime(size, profile_.bytes_per_second);
+    if (status > 0) {
+      bytes_downloaded_.fetch_add(size);
+    }
+
+    delayed_.Post(delay, [=]() {
+      if (!Finish(id)) {
+        callback(olp::http::NetworkResponse()
+                     .WithRequestId(id)
+                     .WithStatus(static_cast<int>(
+                         olp::http::ErrorCode::CANCELLED_ERROR))
+                     .WithError("Cancelled"));
+        return;
+      }
+
+      if (body && status > 0) {
+        const auto* data = reinterpret_cast<const uint8_t*>(body->data());
+        if (data_callback) {
+          data_callback(data, 0u, body->size());
+        }
+        if (payload) {
+          payload->write(body->data(), body->size());
+        }
+      }
+      callback(olp::http::NetworkResponse()
+                   .WithRequestId(id)
+                   .WithStatus(status)
+                   .WithError(error)
+                   .WithBytesDownloaded(status > 0 ? size : 0u));
+    });
+    return olp::http::SendOutcome(id);
+  }
+
+  /*
+   * The cancelled requests are answered with the cancellation error once
+   * their delay passes.
+   */
+  void Cancel(olp::http::RequestId id) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.erase(id);
+  }
+
+  /// The number of the received requests.
+  uint64_t GetRequests() const { return requests_.load(); }
+
+  /// The number of the requests that match no route.
+  uint64_t GetUnknownRequests() const { return unknown_requests_.load(); }
+
+  /// The total size of the response bodies.
+  uint64_t GetBytesDownloaded() const { return bytes_downloaded_.load(); }
+
+ private:
+  struct Route {
+    std::string pattern;
+    int status;
+    Body body;
+  };
+
+  const Route* FindRoute(const std::string& url) const {
+    for (const auto& route : routes_) {
+      if (url.find(route.pattern) != std::string::npos) {
+        return &route;
+      }
+    }
+    return nullptr;
+  }
+
+  /*
+   * Registers the pending request, draws the latency and replaces the
+   * response with an error or a timeout with the rates of the profile.
+   */
+  DelayedCallbacks::Clock::duration DrawOutcome(olp::http::RequestId id,
+                                                int& status, Body& body,
+                                                std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.insert(id);
+    auto latency = profile_.latency;
+    if (profile_.latency_jitter.count() > 0) {
+      std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(
+          0, profile_.latency_jitter.count());
+      latency += std::chrono::milliseconds(jitter(generator_));
+    }
+
+    const auto draw = std::uniform_real_distribution<double>()(generator_);
+    if (draw < profile_.timeout_rate) {
+      status = static_cast<int>(olp::http::ErrorCode::TIMEOUT_ERROR);
+      error = "Timeout";
+      body = nullptr;
+    } else if (draw < profile_.timeout_rate + profile_.error_rate) {
+      status = profile_.error_status;
+      body = ErrorBody();
+    }
+
+    return std::chrono::duration_cast<DelayedCallbacks::Clock::duration>(
+        latency);
+  }
+
+  static Body ErrorBody() {
+    static const Body body = std::make_shared<const std::string>(
+        "{\"title\":\"Injected error\"}");
+    return body;
+  }
+
+  /// Returns false if the request was cancelled.
+  bool Finish(olp::http::RequestId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.erase(id) > 0u;
+  }
+
+  Profile profile_;
+  std::vector<Route> routes_;
+  std::atomic<olp::http::RequestId> next_id_{
+      static_cast<olp::http::RequestId>(
+          olp::http::RequestIdConstants::RequestIdMin)};
+  std::atomic<uint64_t> requests_{0};
+  std::atomic<uint64_t> unknown_requests_{0};
+  std::atomic<uint64_t> bytes_downloaded_{0};
+  std::mutex mutex_;
+  std::mt19937 generator_{42u};
+  std::unordered_set<olp::http::RequestId> pending_;
+  // Destroyed first, runs the remaining callbacks while the members exist.
+  DelayedCallbacks delayed_;
+};
+
+/*
+ * Adds the responses of the lookup, config, metadata, query and blob services
+ * for the tile requests of the versioned and volatile layers of any catalog,
+ * like the local OLP test server returns them. Every tile has a blob of the
+ * given size, the quad trees are canned for the depth 4.
+ */
+inline void AddReadCatalogResponses(InMemoryNetwork& network,
+                                    size_t blob_size = 400u * 1024u) {
+  using olp::geo::TileKey;
+  const auto ok = olp::http::HttpStatusCode::OK;
+
+  std::string apis = "[";
+  for (const auto& api :
+       {"blob", "config", "metadata", "query", "volatile-blob"}) {
+    apis += apis.size() > 1u ? ",{" : "{";
+    apis += "\"api\":\"" + std::string(api) + "\",\"version\":\"v1\",";
+    apis += "\"baseURL\":\"https://" + std::string(api) + ".in-memory/" + api +
+            "/v1/catalogs/hrn\",\"parameters\":{}}";
+  }
+  apis += "]";
+  network.AddResponse("/lookup/v1/", ok, apis);
+
+  network.AddResponse(
+      "https://config.in-memory/", ok,
+      "{\"id\":\"catalog\",\"hrn\":\"hrn:here:data::olp-here-test:catalog\","
+      "\"name\":\"catalog\",\"layers\":["
+      "{\"id\":\"versioned_test_layer\",\"layerType\":\"versioned\"},"
+      "{\"id\":\"volatile_test_layer\",\"layerType\":\"volatile\"}],"
+      "\"version\":100}");
+  network.AddResponse("/versions/latest", ok, "{\"version\":100}");
+
+  // The sub quads are relative to the requested tile, so the tree fits any.
+  std::string tree = "{\"subQuads\":[";
+  for (int level = 0; level <= 4; ++level) {
+    const auto size = 1u << level;
+    for (std::uint32_t row = 0u; row < size; ++row) {
+      for (std::uint32_t column = 0u; column < size; ++column) {
+        const auto sub_quad =
+            TileKey::FromRowColumnLevel(row, column, level).ToHereTile();
+        tree += tree.back() == '[' ? "{" : ",{";
+        tree += "\"subQuadKey\":\"" + sub_quad + "\",\"version\":100,";
+        tree += "\"dataHandle\":\"handle-" + sub_quad + "\",";
+        tree += "\"dataSize\":" + std::to_string(blob_size) + "}";
+      }
+    }
+  }
+  tree += "],\"parentQuads\":[]}";
+  network.AddResponse("/quadkeys/", ok, std::move(tree));
+
+  network.AddResponse("/data/", ok, std::string(blob_size, 'x'));
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/utils/HashLruCache.h>
+#include <olp/core/utils/LruCache.h>
+#include <olp/core/utils/PoolAllocator.h>
+
+namespace {
+
+constexpr auto kLogTag = "LruCacheTest";
+
+struct LruCacheConfiguration {
+  size_t keys;
+};
+
+std::ostream& operator<<(std::ostream& os,
+                         const LruCacheConfiguration& config) {
+  return os << "LruCacheConfiguration(.keys=" << config.keys << ")";
+}
+
+/// Generates the keys similar to the ones of the disk cache.
+std::vector<std::string> GenerateKeys(size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (size_t i = 0u; i < count; ++i) {
+    keys.push_back("hrn:here:data::olp-here-test:catalog::layer::" +
+                   std::to_string(i * 7919u) + "::Data");
+  }
+
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(count));
+  return keys;
+}
+
+/// Fills the cache with the keys, looks each of them up, and then replaces
+/// the half of them with the new keys, which evicts the others.
+template <typename Cache>
+void Measure(const std::vector<std::string>& keys, const std::string& name) {
+  const auto start = std::chrono::steady_clock::now();
+
+  Cache cache(keys.size());
+  for (const auto& key : keys) {
+    cache.InsertOrAssign(key, key.size());
+  }
+  const auto filled = std::chrono::steady_clock::now();
+
+  size_t found = 0u;
+  for (const auto& key : keys) {
+    found += cache.Find(key) != cache.end() ? 1u : 0u;
+  }
+  const auto looked_up = std::chrono::steady_clock::now();
+
+  for (size_t i = 0u; i < keys.size() / 2u; ++i) {
+    cache.InsertOrAssign(keys[i] + "::new", i);
+  }
+  const auto replaced = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(found, keys.size());
+  EXPECT_EQ(cache.Size(), keys.size());
+
+  auto ms = [](std::chrono::steady_clock::duration duration) {
+    return static_cast<long long>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+            .count());
+  };
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag, "%s: keys=%zu, insert=%lldms, find=%lldms, replace=%lldms",
+      name.c_str(), keys.size(), ms(filled - start), ms(looked_up - filled),
+      ms(replaced - looked_up));
+}
+
+class LruCacheTest : public ::testing::TestWithParam<LruCacheConfiguration> {};
+
+/// Compares the ordered `LruCache` with the hashed one, with and without the
+/// pool allocator.
+TEST_P(LruCacheTest, InsertFindEvict) {
+  const auto keys = GenerateKeys(GetParam().keys);
+
+  Measure<olp::utils::LruCache<std::string, size_t>>(keys, "LruCache");
+  Measure<olp::utils::HashLruCache<std::string, size_t>>(keys, "HashLruCache");
+  Measure<olp::utils::HashLruCache<
+      std::string, size_t, olp::utils::CacheCost<size_t>,
+      std::hash<std::string>, std::equal_to<std::string>,
+      olp::utils::PoolAllocator>>(keys, "HashLruCache with PoolAllocator");
+}
+
+INSTANTIATE_TEST_SUITE_P(LruCacheThroughput, LruCacheTest,
+                         ::testing::Values(LruCacheConfiguration{10000u},
+                                           LruCacheConfiguration{1000000u}));
+}  // namespace
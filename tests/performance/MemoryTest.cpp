@@ -92,6 +92,7 @@ void MemoryTest::SetUp() {
   success_responses_.store(0);
   failed_responses_.store(0);
   errors_.clear();
+  StartPhase("setup");
 }
 
 void MemoryTest::TearDown() {
@@ -99,6 +100,7 @@ void MemoryTest::TearDown() {
     thread.join();
   }
   client_threads_.clear();
+  FinishPhase(total_requests_.load(), true);
 
   OLP_SDK_LOG_CRITICAL_INFO_F(kLogTag,
                               "Test finished, total requests %zu, succeed "
@@ -164,6 +166,8 @@ TEST_P(MemoryTest, ReadNPartitionsFromVersionedLayer) {
   const auto& parameter = GetParam();
 
   auto settings = CreateCatalogClientSettings();
+  FinishPhase(1u, false);
+  StartPhase("requests");
 
   StartThreads([=](uint8_t /*thread_id*/) {
     olp::dataservice::read::VersionedLayerClient service_client(
@@ -19,23 +19,113 @@
 
 #pragma once
 
+#include <algorithm>
+#include <string>
+
 #include <gtest/gtest.h>
 #include <olp/core/cache/CacheSettings.h>
 #include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/logging/Log.h>
 #include <olp/core/utils/Dir.h>
 #include <testutils/CustomParameters.hpp>
+#include "AllocationCounter.h"
+#include "InMemoryNetwork.h"
 #include "NetworkWrapper.h"
 
 using KeyValueCachePtr = std::shared_ptr<olp::cache::KeyValueCache>;
 using CacheFactory = std::function<KeyValueCachePtr()>;
 
+/*
+ * The heap usage limits of a test phase, 0 disables a limit. The limits can be
+ * overridden with the `max_allocations_per_operation`,
+ * `max_bytes_per_operation`, `max_peak_live_bytes` and `max_peak_rss` env.
+ * variables, to tighten them on a known machine.
+ */
+struct MemoryLimits {
+  std::uint64_t allocations_per_operation{0u};
+  std::uint64_t bytes_per_operation{0u};
+  std::uint64_t peak_live_bytes{0u};
+  std::uint64_t peak_resident_set_size{0u};
+};
+
+/*
+ * Returns the limits with the env. variable overrides applied.
+ */
+inline MemoryLimits ApplyCustomParameters(MemoryLimits limits) {
+  auto apply = [](const char* name, std::uint64_t& limit) {
+    const auto value = CustomParameters::getArgument(name);
+    if (!value.empty()) {
+      limit = std::stoull(value);
+    }
+  };
+
+  apply("max_allocations_per_operation", limits.allocations_per_operation);
+  apply("max_bytes_per_operation", limits.bytes_per_operation);
+  apply("max_peak_live_bytes", limits.peak_live_bytes);
+  apply("max_peak_rss", limits.peak_resident_set_size);
+  return limits;
+}
+
+/*
+ * Logs the heap usage of a test phase that made `operations` SDK calls, and
+ * fails the test when it exceeds the limits.
+ */
+inline void ReportAllocationPhase(const std::string& name,
+                                  const AllocationStatistics& statistics,
+                                  size_t operations,
+                                  const MemoryLimits& limits = {}) {
+  const auto count = std::max<size_t>(operations, 1u);
+  const auto allocations_per_operation = statistics.count / count;
+  const auto bytes_per_operation = statistics.bytes / count;
+  const auto peak_resident_set_size = GetPeakResidentSetSize();
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      "MemoryTest",
+      "Phase %s: operations=%zu, allocations=%llu (%llu per operation), "
+      "bytes=%llu (%llu per operation), retained bytes=%llu, peak live "
+      "bytes=%llu, peak RSS=%llu",
+      name.c_str(), operations,
+      static_cast<unsigned long long>(statistics.count),
+      static_cast<unsigned long long>(allocations_per_operation),
+      static_cast<unsigned long long>(statistics.bytes),
+      static_cast<unsigned long long>(bytes_per_operation),
+      static_cast<unsigned long long>(statistics.live_bytes),
+      static_cast<unsigned long long>(statistics.peak_live_bytes),
+      static_cast<unsigned long long>(peak_resident_set_size));
+
+  if (limits.allocations_per_operation > 0u) {
+    EXPECT_LE(allocations_per_operation, limits.allocations_per_operation)
+        << "Phase " << name;
+  }
+  if (limits.bytes_per_operation > 0u) {
+    EXPECT_LE(bytes_per_operation, limits.bytes_per_operation)
+        << "Phase " << name;
+  }
+  if (limits.peak_live_bytes > 0u) {
+    EXPECT_LE(statistics.peak_live_bytes, limits.peak_live_bytes)
+        << "Phase " << name;
+  }
+  // The peak RSS is not reset between the phases, so it is the peak of the
+  // process so far.
+  if (limits.peak_resident_set_size > 0u && peak_resident_set_size > 0u) {
+    EXPECT_LE(peak_resident_set_size, limits.peak_resident_set_size)
+        << "Phase " << name;
+  }
+}
+
 struct TestBaseConfiguration {
   std::uint8_t task_scheduler_capacity{5};
   CacheFactory cache_factory{nullptr};
   bool with_http_errors{false};
   bool with_network_timeouts{false};
+  std::chrono::milliseconds network_latency{0};
+  std::uint64_t network_bytes_per_second{0};
+  // Answer the requests in-process instead of with the local OLP test server.
+  bool in_memory_network{false};
+  // The limits of the phase that runs the SDK requests.
+  MemoryLimits memory_limits;
 };
 
 template <typename Param>
@@ -63,24 +153,79 @@ class MemoryTestBase : public ::testing::TestWithParam<Param> {
               parameter.task_scheduler_capacity);
     }
 
-    auto network = std::make_shared<Http2HttpNetworkWrapper>();
-    network->WithErrors(parameter.with_http_errors);
-    network->WithTimeouts(parameter.with_network_timeouts);
-
     olp::client::AuthenticationSettings auth_settings;
     auth_settings.provider = []() { return "invalid"; };
 
     olp::client::OlpClientSettings client_settings;
     client_settings.authentication_settings = auth_settings;
     client_settings.task_scheduler = task_scheduler;
-    client_settings.network_request_handler = std::move(network);
-    client_settings.proxy_settings = GetLocalhostProxySettings();
+    if (parameter.in_memory_network) {
+      client_settings.network_request_handler = CreateInMemoryNetwork();
+    } else {
+      auto network = std::make_shared<Http2HttpNetworkWrapper>();
+      network->WithErrors(parameter.with_http_errors);
+      network->WithTimeouts(parameter.with_network_timeouts);
+      network->WithLatency(parameter.network_latency,
+                           parameter.network_bytes_per_second);
+      client_settings.network_request_handler = std::move(network);
+      client_settings.proxy_settings = GetLocalhostProxySettings();
+    }
     client_settings.cache =
         parameter.cache_factory ? parameter.cache_factory() : nullptr;
     client_settings.retry_settings.timeout = 1;
 
     return client_settings;
   }
+
+  /*
+   * Creates the in-process network with the responses of the local OLP test
+   * server, its errors and timeouts are drawn with the same rates.
+   */
+  std::shared_ptr<InMemoryNetwork> CreateInMemoryNetwork() {
+    const auto& parameter = MemoryTestBase<Param>::GetParam();
+
+    InMemoryNetwork::Profile profile;
+    profile.latency = parameter.network_latency;
+    profile.bytes_per_second = parameter.network_bytes_per_second;
+    if (parameter.with_http_errors) {
+      profile.error_rate = 0.1;
+    }
+    if (parameter.with_network_timeouts) {
+      profile.latency_jitter = std::chrono::milliseconds(250);
+    }
+
+    auto network = std::make_shared<InMemoryNetwork>();
+    network->WithProfile(profile);
+    AddReadCatalogResponses(*network);
+    return network;
+  }
+
+  /*
+   * Starts measuring the heap usage of a test phase, like the setup of the
+   * clients or the requests. The phases must not overlap.
+   */
+  void StartPhase(std::string name) {
+    phase_name_ = std::move(name);
+    phase_ = AllocationPhase();
+  }
+
+  /*
+   * Reports the heap usage of the phase started last. The limits of the test
+   * configuration are checked only when `check_limits` is set.
+   */
+  void FinishPhase(size_t operations, bool check_limits) {
+    const auto statistics = phase_.Get();
+    const auto limits =
+        check_limits
+            ? ApplyCustomParameters(
+                  MemoryTestBase<Param>::GetParam().memory_limits)
+            : MemoryLimits{};
+    ReportAllocationPhase(phase_name_, statistics, operations, limits);
+  }
+
+ private:
+  std::string phase_name_;
+  AllocationPhase phase_;
 };
 
 /*
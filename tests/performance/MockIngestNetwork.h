@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/http/Network.h>
+#include "NetworkWrapper.h"
+
+/*
+ * An in-process ingest server for the write benchmarks. It answers the
+ * lookup, config, ingest, blob and publish requests of the write clients
+ * with fixed responses after the latency, so the benchmark measures the SDK
+ * and not a server. The catalog has the `stream` and `versioned` layers.
+ */
+class MockIngestNetwork : public olp::http::Network {
+ public:
+  /*
+   * Delays the responses by the latency and by the time to transfer the
+   * uploaded bytes with the bandwidth, 0 means unlimited. Set it before
+   * sending.
+   */
+  void WithLatency(std::chrono::milliseconds latency,
+                   uint64_t bytes_per_second = 0u) {
+    latency_ = latency;
+    bytes_per_second_ = bytes_per_second;
+  }
+
+  olp::http::SendOutcome Send(
+      olp::http::NetworkRequest request, Payload payload, Callback callback,
+      HeaderCallback /*header_callback*/ = nullptr,
+      DataCallback /*data_callback*/ = nullptr) override {
+    const auto id = next_id_.fetch_add(1);
+    const auto body = request.GetBody();
+    const uint64_t uploaded = body ? body->size() : 0u;
+    bytes_uploaded_.fetch_add(uploaded);
+    requests_.fetch_add(1);
+
+    int status = olp::http::HttpStatusCode::OK;
+    const auto response = Respond(request, status);
+    if (status == olp::http::HttpStatusCode::NOT_FOUND) {
+      unknown_requests_.fetch_add(1);
+    }
+
+    const auto delay =
+        std::chrono::duration_cast<DelayedCallbacks::Clock::duration>(
+            latency_) +
+        TransferTime(uploaded, bytes_per_second_);
+    delayed_.Post(delay, [=]() {
+      if (payload) {
+        payload->write(response.data(), response.size());
+      }
+      callback(olp::http::NetworkResponse()
+                   .WithRequestId(id)
+                   .WithStatus(status)
+                   .WithBytesUploaded(uploaded)
+                   .WithBytesDownloaded(response.size()));
+    });
+    return olp::http::SendOutcome(id);
+  }
+
+  void Cancel(olp::http::RequestId /*id*/) override {}
+
+  /// The number of the received requests.
+  uint64_t GetRequests() const { return requests_.load(); }
+
+  /// The number of the requests that are not known to the server.
+  uint64_t GetUnknownRequests() const { return unknown_requests_.load(); }
+
+  /// The total size of the request bodies.
+  uint64_t GetBytesUploaded() const { return bytes_uploaded_.load(); }
+
+ private:
+  static bool EndsWith(const std::string& string, const std::string& suffix) {
+    return string.size() >= suffix.size() &&
+           string.compare(string.size() - suffix.size(), suffix.size(),
+                          suffix) == 0;
+  }
+
+  static std::string LookupResponse(const std::string& url) {
+    // The lookup URLs end with `/apis/<api>/<version>`.
+    const auto version_pos = url.rfind('/');
+    const auto api_pos = url.rfind('/', version_pos - 1u);
+    const auto api = url.substr(api_pos + 1u, version_pos - api_pos - 1u);
+    const auto version = url.substr(version_pos + 1u);
+    return "[{\"api\":\"" + api + "\",\"version\":\"" + version +
+           "\",\"baseURL\":\"https://" + api + ".mock.server/" + api +
+           "\",\"parameters\":{}}]";
+  }
+
+  static std::string Respond(const olp::http::NetworkRequest& request,
+                             int& status) {
+    using olp::http::NetworkRequest;
+    const auto url = request.GetUrl().substr(0u, request.GetUrl().find('?'));
+    const auto verb = request.GetVerb();
+
+    if (url.find("/lookup/v1/") != std::string::npos) {
+      return LookupResponse(url);
+    }
+
+    if (url.find("https://config.mock.server/config/catalogs/") == 0u) {
+      return "{\"id\":\"catalog\",\"hrn\":\"hrn:here:data::mock:catalog\","
+             "\"layers\":[{\"id\":\"stream\",\"layerType\":\"stream\","
+             "\"contentType\":\"application/octet-stream\"},"
+             "{\"id\":\"versioned\",\"layerType\":\"versioned\","
+             "\"contentType\":\"application/octet-stream\"}],"
+             "\"version\":42}";
+    }
+
+    if (url.find("https://ingest.mock.server/") == 0u) {
+      if (EndsWith(url, "/sdiiMessageList")) {
+        return "{\"TraceID\":{\"ParentID\":\"parent\","
+               "\"GeneratedIDs\":[\"generated\"]}}";
+      }
+      return "{\"TraceID\":\"trace\"}";
+    }
+
+    if (url.find("https://blob.mock.server/") == 0u) {
+      status = verb == NetworkRequest::HttpVerb::HEAD
+                   ? olp::http::HttpStatusCode::NOT_FOUND
+                   : olp::http::HttpStatusCode::NO_CONTENT;
+      return {};
+    }
+
+    if (url.find("https://publish.mock.server/") == 0u) {
+      if (EndsWith(url, "/partitions") ||
+          verb == NetworkRequest::HttpVerb::PUT) {
+        status = olp::http::HttpStatusCode::NO_CONTENT;
+        return {};
+      }
+      return "{\"id\":\"publication\",\"catalogVersion\":42,"
+             "\"layerIds\":[\"stream\",\"versioned\"],"
+             "\"details\":{\"state\":\"initialized\"}}";
+    }
+
+    status = olp::http::HttpStatusCode::NOT_FOUND;
+    return {};
+  }
+
+  std::chrono::milliseconds latency_{0};
+  uint64_t bytes_per_second_ = 0u;
+  std::atomic<olp::http::RequestId> next_id_{
+      static_cast<olp::http::RequestId>(
+          olp::http::RequestIdConstants::RequestIdMin)};
+  std::atomic<uint64_t> requests_{0};
+  std::atomic<uint64_t> unknown_requests_{0};
+  std::atomic<uint64_t> bytes_uploaded_{0};
+  DelayedCallbacks delayed_;
+};
@@ -19,10 +19,96 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 #include <olp/core/http/Network.h>
 
+/*
+ * Runs the functions after a delay on a separate thread, in the deadline
+ * order, so a delayed function does not block the others. The remaining
+ * functions run without a delay on destruction.
+ */
+class DelayedCallbacks {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  DelayedCallbacks() = default;
+  DelayedCallbacks(const DelayedCallbacks &) = delete;
+  DelayedCallbacks &operator=(const DelayedCallbacks &) = delete;
+
+  ~DelayedCallbacks() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    condition_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  void Post(Clock::duration delay, std::function<void()> function) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!thread_.joinable()) {
+        thread_ = std::thread(&DelayedCallbacks::Run, this);
+      }
+      functions_.emplace(Clock::now() + delay, std::move(function));
+    }
+    condition_.notify_one();
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_ || !functions_.empty()) {
+      if (functions_.empty()) {
+        condition_.wait(lock);
+        continue;
+      }
+
+      auto next = functions_.begin();
+      if (!stopped_ && next->first > Clock::now()) {
+        condition_.wait_until(lock, next->first);
+        continue;
+      }
+
+      auto function = std::move(next->second);
+      functions_.erase(next);
+      lock.unlock();
+      function();
+      lock.lock();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::multimap<Clock::time_point, std::function<void()>> functions_;
+  bool stopped_ = false;
+  std::thread thread_;
+};
+
+/*
+ * Returns the time to transfer the bytes with the bandwidth, 0 means
+ * unlimited.
+ */
+inline DelayedCallbacks::Clock::duration TransferTime(
+    uint64_t bytes, uint64_t bytes_per_second) {
+  if (bytes_per_second == 0u) {
+    return DelayedCallbacks::Clock::duration::zero();
+  }
+  return std::chrono::duration_cast<DelayedCallbacks::Clock::duration>(
+      std::chrono::duration<double>(static_cast<double>(bytes) /
+                                    static_cast<double>(bytes_per_second)));
+}
+
 /*
  * Node test server is limited to http proxy. Wrapper alters ongoing requests
  * from https to http.
@@ -38,6 +124,10 @@ class Http2HttpNetworkWrapper : public olp::http::Network {
     ReplaceHttps2Http(request);
     InsertDebugHeaders(request);
 
+    if (latency_.count() > 0 || bytes_per_second_ > 0u) {
+      callback = DelayCallback(std::move(callback));
+    }
+
     return network_->Send(std::move(request), std::move(payload),
                           std::move(callback), std::move(header_callback),
                           std::move(data_callback));
@@ -57,7 +147,30 @@ class Http2HttpNetworkWrapper : public olp::http::Network {
    */
   void WithErrors(bool with_errors) { with_errors_ = with_errors; }
 
+  /*
+   * Delays the responses by the latency and by the time to transfer the
+   * downloaded bytes with the bandwidth, 0 means unlimited. The delayed
+   * responses do not block the other requests. Set it before sending.
+   */
+  void WithLatency(std::chrono::milliseconds latency,
+                   uint64_t bytes_per_second = 0u) {
+    latency_ = latency;
+    bytes_per_second_ = bytes_per_second;
+  }
+
  private:
+  Callback DelayCallback(Callback callback) {
+    return [=](olp::http::NetworkResponse response) {
+      const auto delay =
+          std::chrono::duration_cast<DelayedCallbacks::Clock::duration>(
+              latency_) +
+          TransferTime(response.GetBytesDownloaded(), bytes_per_second_);
+      auto shared_response =
+          std::make_shared<olp::http::NetworkResponse>(std::move(response));
+      delayed_.Post(delay, [=]() { callback(std::move(*shared_response)); });
+    };
+  }
+
   static void ReplaceHttps2Http(olp::http::NetworkRequest &request) {
     auto url = request.GetUrl();
     auto pos = url.find("https");
@@ -82,5 +195,9 @@ class Http2HttpNetworkWrapper : public olp::http::Network {
 
   bool with_timeouts_ = false;
   bool with_errors_ = false;
+  std::chrono::milliseconds latency_{0};
+  uint64_t bytes_per_second_ = 0u;
+  // Destroyed after the network, which completes the ongoing requests.
+  DelayedCallbacks delayed_;
   std::shared_ptr<olp::http::Network> network_;
 };
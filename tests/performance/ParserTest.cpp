@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <olp/core/logging/Log.h>
+// clang-format off
+#include "generated/parser/MessagesParser.h"
+#include "generated/parser/PartitionsParser.h"
+#include <olp/core/generated/parser/JsonParser.h>
+// clang-format on
+
+namespace {
+namespace model = olp::dataservice::read::model;
+
+constexpr auto kLogTag = "ParserTest";
+constexpr size_t kRuns = 5u;
+
+struct ParserConfiguration {
+  size_t items;
+};
+
+std::ostream& operator<<(std::ostream& os, const ParserConfiguration& config) {
+  return os << "ParserConfiguration(.items=" << config.items << ")";
+}
+
+std::string GeneratePartitions(size_t count) {
+  std::string json = "{\"partitions\":[";
+  for (size_t idx = 0u; idx < count; ++idx) {
+    const auto id = std::to_string(idx);
+    json += (idx > 0u ? ",{" : "{");
+    json += "\"partition\":\"" + id + "\",";
+    json += "\"dataHandle\":\"handle-" + id + "\",";
+    json += "\"checksum\":\"4f2b0c8e" + id + "\",";
+    json += "\"crc\":\"291f66\",";
+    json += "\"dataSize\":" + std::to_string(1024u + idx) + ",";
+    json += "\"compressedDataSize\":" + std::to_string(512u + idx) + ",";
+    json += "\"version\":" + std::to_string(idx % 7u) + "}";
+  }
+  return json + "]}";
+}
+
+std::string GenerateMessages(size_t count) {
+  std::string json = "{\"messages\":[";
+  for (size_t idx = 0u; idx < count; ++idx) {
+    const auto id = std::to_string(idx);
+    json += (idx > 0u ? ",{" : "{");
+    json += "\"metaData\":{\"partition\":\"" + id + "\",";
+    json += "\"dataHandle\":\"handle-" + id + "\",";
+    json += "\"data\":\"aGVsbG8gd29ybGQ=\",";
+    json += "\"dataSize\":" + std::to_string(1024u + idx) + ",";
+    json += "\"timestamp\":" + std::to_string(1517916706u + idx) + "},";
+    json += "\"offset\":{\"partition\":" + std::to_string(idx % 16u) + ",";
+    json += "\"offset\":" + id + "}}";
+  }
+  return json + "]}";
+}
+
+/// Returns the best time out of `kRuns` runs of the parse function.
+template <typename Function>
+std::chrono::microseconds Measure(Function parse) {
+  auto best = std::chrono::microseconds::max();
+  for (size_t run = 0u; run < kRuns; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    parse();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    best = std::min(best, elapsed);
+  }
+  return best;
+}
+
+void ExpectEqual(const model::Partition& expected,
+                 const model::Partition& actual) {
+  EXPECT_EQ(expected.GetPartition(), actual.GetPartition());
+  EXPECT_EQ(expected.GetDataHandle(), actual.GetDataHandle());
+  EXPECT_TRUE(expected.GetChecksum() == actual.GetChecksum());
+  EXPECT_TRUE(expected.GetCrc() == actual.GetCrc());
+  EXPECT_TRUE(expected.GetDataSize() == actual.GetDataSize());
+  EXPECT_TRUE(expected.GetCompressedDataSize() ==
+              actual.GetCompressedDataSize());
+  EXPECT_TRUE(expected.GetVersion() == actual.GetVersion());
+}
+
+void ExpectEqual(const model::Message& expected, const model::Message& actual) {
+  const auto& expected_meta = expected.GetMetaData();
+  const auto& actual_meta = actual.GetMetaData();
+  EXPECT_EQ(expected_meta.GetPartition(), actual_meta.GetPartition());
+  EXPECT_TRUE(expected_meta.GetDataHandle() == actual_meta.GetDataHandle());
+  EXPECT_TRUE(expected_meta.GetDataSize() == actual_meta.GetDataSize());
+  EXPECT_TRUE(expected_meta.GetTimestamp() == actual_meta.GetTimestamp());
+  ASSERT_TRUE(expected_meta.GetData() && actual_meta.GetData());
+  EXPECT_EQ(*expected_meta.GetData(), *actual_meta.GetData());
+  EXPECT_EQ(expected.GetOffset().GetPartition(),
+            actual.GetOffset().GetPartition());
+  EXPECT_EQ(expected.GetOffset().GetOffset(), actual.GetOffset().GetOffset());
+}
+
+class ParserTest : public ::testing::TestWithParam<ParserConfiguration> {};
+
+/// Compares the DOM parser with the stream parser used by `parse_result`,
+/// which must produce the same models.
+TEST_P(ParserTest, Partitions) {
+  const auto json = GeneratePartitions(GetParam().items);
+
+  model::Partitions dom_result;
+  const auto dom_time = Measure(
+      [&]() { dom_result = olp::parser::parse<model::Partitions>(json); });
+
+  model::Partitions stream_result;
+  bool res = false;
+  const auto stream_time = Measure([&]() {
+    std::stringstream stream(json);
+    stream_result = olp::parser::parse<model::Partitions>(stream, res);
+  });
+
+  ASSERT_TRUE(res);
+  const auto& expected = dom_result.GetPartitions();
+  const auto& actual = stream_result.GetPartitions();
+  ASSERT_EQ(GetParam().items, expected.size());
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t idx = 0u; idx < expected.size(); ++idx) {
+    ExpectEqual(expected[idx], actual[idx]);
+  }
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag, "partitions=%zu, bytes=%zu, dom=%lldus, stream=%lldus",
+      expected.size(), json.size(), static_cast<long long>(dom_time.count()),
+      static_cast<long long>(stream_time.count()));
+}
+
+TEST_P(ParserTest, Messages) {
+  const auto json = GenerateMessages(GetParam().items);
+
+  model::Messages dom_result;
+  const auto dom_time = Measure(
+      [&]() { dom_result = olp::parser::parse<model::Messages>(json); });
+
+  model::Messages stream_result;
+  bool res = false;
+  const auto stream_time = Measure([&]() {
+    std::stringstream stream(json);
+    stream_result = olp::parser::parse<model::Messages>(stream, res);
+  });
+
+  ASSERT_TRUE(res);
+  const auto& expected = dom_result.GetMessages();
+  const auto& actual = stream_result.GetMessages();
+  ASSERT_EQ(GetParam().items, expected.size());
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t idx = 0u; idx < expected.size(); ++idx) {
+    ExpectEqual(expected[idx], actual[idx]);
+  }
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag, "messages=%zu, bytes=%zu, dom=%lldus, stream=%lldus",
+      expected.size(), json.size(), static_cast<long long>(dom_time.count()),
+      static_cast<long long>(stream_time.count()));
+}
+
+INSTANTIATE_TEST_SUITE_P(ParserThroughput, ParserTest,
+                         ::testing::Values(ParserConfiguration{100u},
+                                           ParserConfiguration{10000u},
+                                           ParserConfiguration{100000u}));
+}  // namespace
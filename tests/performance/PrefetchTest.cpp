@@ -79,6 +79,7 @@ void PrefetchTest::SetUp() {
   success_responses_.store(0);
   failed_responses_.store(0);
   errors_.clear();
+  StartPhase("setup");
 }
 
 void PrefetchTest::TearDown() {
@@ -86,6 +87,7 @@ void PrefetchTest::TearDown() {
     thread.join();
   }
   client_threads_.clear();
+  FinishPhase(total_requests_.load(), true);
 
   OLP_SDK_LOG_CRITICAL_INFO_F(kLogTag,
                               "Test finished, total requests %zu, succeed "
@@ -132,6 +134,8 @@ TEST_P(PrefetchTest, PrefetchPartitionsFromVersionedLayer) {
   const auto& parameter = GetParam();
 
   auto settings = CreateCatalogClientSettings();
+  FinishPhase(1u, false);
+  StartPhase("requests");
 
   StartThreads([=](uint8_t thread_id) {
     olp::dataservice::read::VersionedLayerClient service_client(
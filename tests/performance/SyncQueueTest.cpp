@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/thread/LockFreeSyncQueue.h>
+#include <olp/core/thread/SyncQueue.h>
+
+namespace {
+using Task = std::function<void()>;
+
+constexpr auto kLogTag = "SyncQueueTest";
+constexpr size_t kConsumers = 4u;
+constexpr size_t kTasksPerProducer = 20000u;
+
+struct QueueConfiguration {
+  size_t producers;
+};
+
+std::ostream& operator<<(std::ostream& os, const QueueConfiguration& config) {
+  return os << "QueueConfiguration(.producers=" << config.producers << ")";
+}
+
+/// Pushes small tasks from the producers and runs them on the consumers, and
+/// returns the time until all tasks run.
+template <typename Queue>
+std::chrono::milliseconds RunTasks(Queue& queue, size_t producer_count) {
+  const size_t total = producer_count * kTasksPerProducer;
+  std::atomic<size_t> done(0u);
+
+  std::vector<std::thread> consumers;
+  for (size_t idx = 0u; idx < kConsumers; ++idx) {
+    consumers.emplace_back([&]() {
+      Task task;
+      while (queue.Pull(task)) {
+        task();
+      }
+    });
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (size_t idx = 0u; idx < producer_count; ++idx) {
+    producers.emplace_back([&]() {
+      for (size_t task = 0u; task < kTasksPerProducer; ++task) {
+        queue.Push([&]() { ++done; });
+      }
+    });
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  while (done.load() < total) {
+    std::this_thread::yield();
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  queue.Close();
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+
+  return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+}
+
+class SyncQueueTest : public ::testing::TestWithParam<QueueConfiguration> {};
+
+TEST_P(SyncQueueTest, MutexVersusLockFree) {
+  const auto producers = GetParam().producers;
+
+  olp::thread::SyncQueueFifo<Task> sync_queue;
+  const auto mutex_time = RunTasks(sync_queue, producers);
+
+  olp::thread::LockFreeSyncQueue<Task> lock_free_queue;
+  const auto lock_free_time = RunTasks(lock_free_queue, producers);
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag, "producers=%zu, tasks=%zu, mutex=%lldms, lock-free=%lldms",
+      producers, producers * kTasksPerProducer,
+      static_cast<long long>(mutex_time.count()),
+      static_cast<long long>(lock_free_time.count()));
+}
+
+INSTANTIATE_TEST_SUITE_P(QueueThroughput, SyncQueueTest,
+                         ::testing::Values(QueueConfiguration{1u},
+                                           QueueConfiguration{8u},
+                                           QueueConfiguration{64u}));
+}  // namespace
@@ -0,0 +1,333 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/logging/Log.h>
+#include <olp/dataservice/read/VersionedLayerClient.h>
+
+#include "MemoryTestBase.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+
+struct TestConfiguration : public TestBaseConfiguration {
+  std::string configuration_name;
+  std::uint8_t calling_thread_count = 8;
+  std::uint32_t requests_per_thread = 500;
+
+  // The tiles are ranked by popularity, the tile of rank `k` is requested
+  // with the probability proportional to `1 / k^zipf_exponent`.
+  std::uint32_t key_count = 10000;
+  double zipf_exponent = 1.0;
+
+  // The share of the requests served from the cache. The most popular tiles
+  // that make this share are cached before the measurement, the others are
+  // always downloaded.
+  double cache_hit_ratio = 0.8;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .calling_thread_count=" << int(config.calling_thread_count)
+            << ", .task_scheduler_capacity="
+            << int(config.task_scheduler_capacity)
+            << ", .requests_per_thread=" << config.requests_per_thread
+            << ", .key_count=" << config.key_count
+            << ", .zipf_exponent=" << config.zipf_exponent
+            << ", .cache_hit_ratio=" << config.cache_hit_ratio
+            << ", .network_latency=" << config.network_latency.count()
+            << ", .network_bytes_per_second="
+            << config.network_bytes_per_second
+            << ", .in_memory_network=" << config.in_memory_network << ")";
+}
+
+constexpr auto kLogTag = "ThroughputTest";
+const olp::client::HRN kCatalog("hrn:here:data::olp-here-test:testhrn");
+const std::string kVersionedLayerId("versioned_test_layer");
+constexpr auto kLevel = 12u;
+
+/// Overrides the configuration with the environment variables of the same
+/// name prefixed with `throughput_`, for example, `throughput_key_count`.
+void ApplyCustomParameters(TestConfiguration& configuration) {
+  auto get = [](const char* name) {
+    return CustomParameters::getArgument(std::string("throughput_") + name);
+  };
+
+  std::string value;
+  if (!(value = get("calling_thread_count")).empty()) {
+    configuration.calling_thread_count =
+        static_cast<std::uint8_t>(std::stoul(value));
+  }
+  if (!(value = get("task_scheduler_capacity")).empty()) {
+    configuration.task_scheduler_capacity =
+        static_cast<std::uint8_t>(std::stoul(value));
+  }
+  if (!(value = get("requests_per_thread")).empty()) {
+    configuration.requests_per_thread =
+        static_cast<std::uint32_t>(std::stoul(value));
+  }
+  if (!(value = get("key_count")).empty()) {
+    configuration.key_count = static_cast<std::uint32_t>(std::stoul(value));
+  }
+  if (!(value = get("zipf_exponent")).empty()) {
+    configuration.zipf_exponent = std::stod(value);
+  }
+  if (!(value = get("cache_hit_ratio")).empty()) {
+    configuration.cache_hit_ratio = std::stod(value);
+  }
+  if (!(value = get("network_latency_ms")).empty()) {
+    configuration.network_latency =
+        std::chrono::milliseconds(std::stoul(value));
+  }
+  if (!(value = get("network_bytes_per_second")).empty()) {
+    configuration.network_bytes_per_second = std::stoull(value);
+  }
+  if (!(value = get("in_memory_network")).empty()) {
+    configuration.in_memory_network = value != "0";
+  }
+}
+
+/// Samples the tile ranks with the Zipf distribution.
+class ZipfDistribution {
+ public:
+  ZipfDistribution(std::uint32_t count, double exponent) : cdf_(count) {
+    double sum = 0.0;
+    for (std::uint32_t rank = 0u; rank < count; ++rank) {
+      sum += 1.0 / std::pow(rank + 1.0, exponent);
+      cdf_[rank] = sum;
+    }
+    for (auto& value : cdf_) {
+      value /= sum;
+    }
+  }
+
+  template <typename Generator>
+  std::uint32_t operator()(Generator& generator) const {
+    const auto value = std::uniform_real_distribution<double>()(generator);
+    const auto it = std::lower_bound(cdf_.begin(), cdf_.end(), value);
+    return static_cast<std::uint32_t>(
+        std::min<size_t>(it - cdf_.begin(), cdf_.size() - 1u));
+  }
+
+  /// The number of the most popular ranks requested with the probability.
+  std::uint32_t RanksWithProbability(double probability) const {
+    if (probability <= 0.0) {
+      return 0u;
+    }
+    const auto it = std::lower_bound(cdf_.begin(), cdf_.end(), probability);
+    return static_cast<std::uint32_t>(
+        std::min<size_t>(it - cdf_.begin() + 1u, cdf_.size()));
+  }
+
+ private:
+  std::vector<double> cdf_;
+};
+
+olp::geo::TileKey RankToTile(std::uint32_t rank) {
+  // The tiles are spread over a square of the level, so they do not share
+  // the same quad tree.
+  const auto side = 1u << kLevel;
+  const auto index = static_cast<std::uint64_t>(rank) * 7919u;
+  return olp::geo::TileKey::FromRowColumnLevel(
+      static_cast<std::uint32_t>((index / side) % side),
+      static_cast<std::uint32_t>(index % side), kLevel);
+}
+
+std::chrono::microseconds Percentile(
+    const std::vector<std::chrono::microseconds>& sorted, double percentile) {
+  if (sorted.empty()) {
+    return std::chrono::microseconds(0);
+  }
+  const auto index = static_cast<size_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+  return sorted[std::min(std::max<size_t>(index, 1u), sorted.size()) - 1u];
+}
+
+class ThroughputTest : public MemoryTestBase<TestConfiguration> {};
+
+/*
+ * Generates the read load of several client threads, each of them requests
+ * the tiles one after another, and reports the throughput and the latency
+ * percentiles. Use it to size the task scheduler and the cache for a traffic
+ * shape. To run the test, you need to start a local OLP mock server first,
+ * unless the configuration uses the in-memory network.
+ */
+TEST_P(ThroughputTest, GetDataFromVersionedLayer) {
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto& parameter = GetParam();
+  auto settings = CreateCatalogClientSettings();
+  const ZipfDistribution distribution(parameter.key_count,
+                                      parameter.zipf_exponent);
+  const auto cached_ranks =
+      distribution.RanksWithProbability(parameter.cache_hit_ratio);
+
+  read::VersionedLayerClient client(kCatalog, kVersionedLayerId, boost::none,
+                                    settings);
+
+  // Warm up the cache with the most popular tiles.
+  for (std::uint32_t rank = 0u; rank < cached_ranks; ++rank) {
+    client.GetData(read::TileRequest().WithTileKey(RankToTile(rank)))
+        .GetFuture()
+        .get();
+  }
+
+  std::atomic_size_t failed_responses{0};
+  std::mutex latencies_mutex;
+  std::vector<std::chrono::microseconds> latencies;
+  latencies.reserve(parameter.calling_thread_count *
+                    parameter.requests_per_thread);
+
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (std::uint8_t i = 0u; i < parameter.calling_thread_count; ++i) {
+    threads.emplace_back([&, i]() {
+      std::mt19937_64 generator(i);
+      std::vector<std::chrono::microseconds> thread_latencies;
+      thread_latencies.reserve(parameter.requests_per_thread);
+
+      for (std::uint32_t n = 0u; n < parameter.requests_per_thread; ++n) {
+        const auto rank = distribution(generator);
+        // The tiles that are not warmed up are not cached either, so the
+        // cache hit ratio stays the same during the measurement.
+        auto request = read::TileRequest()
+                           .WithTileKey(RankToTile(rank))
+                           .WithFetchOption(rank < cached_ranks
+                                                ? read::OnlineIfNotFound
+                                                : read::OnlineOnly);
+
+        const auto request_start = std::chrono::steady_clock::now();
+        auto response = client.GetData(std::move(request)).GetFuture().get();
+        thread_latencies.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - request_start));
+
+        if (!response.IsSuccessful()) {
+          failed_responses.fetch_add(1);
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(latencies_mutex);
+      latencies.insert(latencies.end(), thread_latencies.begin(),
+                       thread_latencies.end());
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto throughput =
+      static_cast<double>(latencies.size()) * 1000.0 /
+      static_cast<double>(std::max<std::int64_t>(elapsed.count(), 1));
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "requests=%zu, failed=%zu, cached_tiles=%u, elapsed=%lldms, "
+      "throughput=%.1f/s",
+      latencies.size(), failed_responses.load(), cached_ranks,
+      static_cast<long long>(elapsed.count()), throughput);
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag, "latency p50=%lldus, p90=%lldus, p99=%lldus, max=%lldus",
+      static_cast<long long>(Percentile(latencies, 50.0).count()),
+      static_cast<long long>(Percentile(latencies, 90.0).count()),
+      static_cast<long long>(Percentile(latencies, 99.0).count()),
+      static_cast<long long>(Percentile(latencies, 100.0).count()));
+
+  EXPECT_EQ(latencies.size(),
+            parameter.calling_thread_count * parameter.requests_per_thread);
+}
+
+/*
+ * Memory cache only, large enough for the cached tiles, the network answers
+ * without a delay.
+ */
+TestConfiguration MemoryCacheTest() {
+  TestConfiguration configuration;
+  configuration.cache_factory = []() {
+    olp::cache::CacheSettings settings;
+    settings.max_memory_cache_size = 64u * 1024u * 1024u;
+    return olp::client::OlpClientSettingsFactory::CreateDefaultCache(settings);
+  };
+  configuration.task_scheduler_capacity = 8;
+  configuration.configuration_name = "zipf_memory_cache";
+  ApplyCustomParameters(configuration);
+  return configuration;
+}
+
+/*
+ * Disk cache and a mobile-like network with 50 ms latency and 1 MB/s.
+ */
+TestConfiguration SlowNetworkTest() {
+  TestConfiguration configuration;
+  SetDiskCacheConfiguration(configuration);
+  configuration.task_scheduler_capacity = 8;
+  configuration.network_latency = std::chrono::milliseconds(50);
+  configuration.network_bytes_per_second = 1024u * 1024u;
+  configuration.configuration_name = "zipf_slow_network";
+  ApplyCustomParameters(configuration);
+  return configuration;
+}
+
+/*
+ * Memory cache only and the in-process network without a delay, so the
+ * measurement is the overhead of the SDK alone.
+ */
+TestConfiguration InMemoryNetworkTest() {
+  auto configuration = MemoryCacheTest();
+  configuration.in_memory_network = true;
+  configuration.configuration_name = "zipf_in_memory_network";
+  ApplyCustomParameters(configuration);
+  return configuration;
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+  configurations.emplace_back(MemoryCacheTest());
+  configurations.emplace_back(SlowNetworkTest());
+  configurations.emplace_back(InMemoryNetworkTest());
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(Throughput, ThroughputTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
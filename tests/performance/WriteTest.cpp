@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2021 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/logging/Log.h>
+#include <olp/dataservice/write/StreamLayerClient.h>
+#include <olp/dataservice/write/VersionedLayerClient.h>
+
+#include "MemoryTestBase.h"
+#include "MockIngestNetwork.h"
+
+namespace {
+namespace write = olp::dataservice::write;
+namespace model = olp::dataservice::write::model;
+
+struct TestConfiguration {
+  std::string configuration_name;
+  std::uint8_t calling_thread_count = 4;
+  std::uint32_t messages_per_thread = 1000;
+  size_t message_size = 1024u;
+  std::chrono::milliseconds network_latency{0};
+  std::uint64_t network_bytes_per_second{0};
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .calling_thread_count=" << int(config.calling_thread_count)
+            << ", .messages_per_thread=" << config.messages_per_thread
+            << ", .message_size=" << config.message_size
+            << ", .network_latency=" << config.network_latency.count()
+            << ", .network_bytes_per_second="
+            << config.network_bytes_per_second << ")";
+}
+
+constexpr auto kLogTag = "WriteTest";
+const olp::client::HRN kCatalog("hrn:here:data::mock:catalog");
+constexpr auto kStreamLayer = "stream";
+constexpr auto kVersionedLayer = "versioned";
+
+using Clock = std::chrono::steady_clock;
+
+class WriteTest : public ::testing::TestWithParam<TestConfiguration> {
+ protected:
+  void SetUp() override {
+    olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+    const auto& parameter = GetParam();
+    network_ = std::make_shared<MockIngestNetwork>();
+    network_->WithLatency(parameter.network_latency,
+                          parameter.network_bytes_per_second);
+
+    olp::client::AuthenticationSettings auth_settings;
+    auth_settings.provider = []() { return "token"; };
+
+    settings_.authentication_settings = auth_settings;
+    settings_.network_request_handler = network_;
+    settings_.task_scheduler =
+        olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(
+            parameter.calling_thread_count);
+    settings_.cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+    data_ = std::make_shared<std::vector<unsigned char>>(
+        parameter.message_size, static_cast<unsigned char>('d'));
+    failed_.store(0);
+    phase_ = AllocationPhase();
+    start_ = Clock::now();
+  }
+
+  void TearDown() override {
+    settings_.task_scheduler.reset();
+    settings_.network_request_handler.reset();
+    network_.reset();
+  }
+
+  /// Runs the body on the calling threads, each of them with its index.
+  template <typename Body>
+  void RunThreads(Body body) {
+    std::vector<std::thread> threads;
+    for (std::uint8_t i = 0u; i < GetParam().calling_thread_count; ++i) {
+      threads.emplace_back(body, i);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  /// Reports the throughput and the allocations since the start.
+  void Report(const char* name, size_t messages) {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - start_);
+    const auto seconds =
+        static_cast<double>(std::max<std::int64_t>(elapsed.count(), 1)) / 1e6;
+    const auto allocations = phase_.Get();
+    messages = std::max<size_t>(messages, 1u);
+
+    OLP_SDK_LOG_CRITICAL_INFO_F(
+        kLogTag,
+        "%s: messages=%zu, failed=%zu, requests=%llu, elapsed=%.3fs, "
+        "messages/s=%.1f, uploaded MB/s=%.2f, allocations per message=%.1f",
+        name, messages, failed_.load(),
+        static_cast<unsigned long long>(network_->GetRequests()), seconds,
+        static_cast<double>(messages) / seconds,
+        static_cast<double>(network_->GetBytesUploaded()) / seconds / 1e6,
+        static_cast<double>(allocations.count) /
+            static_cast<double>(messages));
+    ReportAllocationPhase(name, allocations, messages,
+                          ApplyCustomParameters(MemoryLimits{}));
+
+    EXPECT_EQ(failed_.load(), 0u);
+    EXPECT_EQ(network_->GetUnknownRequests(), 0u);
+  }
+
+  std::shared_ptr<MockIngestNetwork> network_;
+  olp::client::OlpClientSettings settings_;
+  std::shared_ptr<std::vector<unsigned char>> data_;
+  std::atomic_size_t failed_{0};
+  AllocationPhase phase_;
+  Clock::time_point start_;
+};
+
+TEST_P(WriteTest, StreamPublishData) {
+  const auto& parameter = GetParam();
+  write::StreamLayerClient client(kCatalog, {}, settings_);
+
+  RunThreads([&](std::uint8_t) {
+    for (std::uint32_t i = 0u; i < parameter.messages_per_thread; ++i) {
+      auto response = client
+                          .PublishData(model::PublishDataRequest()
+                                           .WithData(data_)
+                                           .WithLayerId(kStreamLayer))
+                          .GetFuture()
+                          .get();
+      if (!response.IsSuccessful()) {
+        failed_.fetch_add(1);
+      }
+    }
+  });
+
+  Report("PublishData",
+         parameter.calling_thread_count * parameter.messages_per_thread);
+}
+
+/*
+ * Measures the cost of the queue operations separately from the flush,
+ * which publishes the queued requests.
+ */
+TEST_P(WriteTest, StreamQueueAndFlush) {
+  const auto& parameter = GetParam();
+  write::StreamLayerClient client(kCatalog, {}, settings_);
+
+  const auto messages =
+      parameter.calling_thread_count * parameter.messages_per_thread;
+  RunThreads([&](std::uint8_t) {
+    for (std::uint32_t i = 0u; i < parameter.messages_per_thread; ++i) {
+      auto error = client.Queue(model::PublishDataRequest()
+                                    .WithData(data_)
+                                    .WithLayerId(kStreamLayer));
+      if (error) {
+        failed_.fetch_add(1);
+      }
+    }
+  });
+
+  const auto queued = Clock::now();
+  const auto queue_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(queued - start_);
+  OLP_SDK_LOG_CRITICAL_INFO_F(kLogTag, "Queue: %.2fus per message",
+                              static_cast<double>(queue_time.count()) /
+                                  static_cast<double>(messages));
+
+  const auto responses = client.Flush(model::FlushRequest()).GetFuture().get();
+  for (const auto& response : responses) {
+    if (!response.IsSuccessful()) {
+      failed_.fetch_add(1);
+    }
+  }
+  const auto flush_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      Clock::now() - queued);
+  OLP_SDK_LOG_CRITICAL_INFO_F(kLogTag, "Flush: %zu responses in %lldms",
+                              responses.size(),
+                              static_cast<long long>(flush_time.count()));
+
+  EXPECT_EQ(responses.size(), messages);
+  Report("QueueAndFlush", messages);
+}
+
+TEST_P(WriteTest, StreamPublishSdii) {
+  const auto& parameter = GetParam();
+  write::StreamLayerClient client(kCatalog, {}, settings_);
+
+  RunThreads([&](std::uint8_t) {
+    for (std::uint32_t i = 0u; i < parameter.messages_per_thread; ++i) {
+      auto response = client
+                          .PublishSdii(model::PublishSdiiRequest()
+                                           .WithSdiiMessageList(data_)
+                                           .WithLayerId(kStreamLayer))
+                          .GetFuture()
+                          .get();
+      if (!response.IsSuccessful()) {
+        failed_.fetch_add(1);
+      }
+    }
+  });
+
+  Report("PublishSdii",
+         parameter.calling_thread_count * parameter.messages_per_thread);
+}
+
+TEST_P(WriteTest, VersionedPublishToBatch) {
+  const auto& parameter = GetParam();
+  write::VersionedLayerClient client(kCatalog, settings_);
+
+  auto publication = client
+                         .StartBatch(model::StartBatchRequest().WithLayers(
+                             {kVersionedLayer}))
+                         .GetFuture()
+                         .get();
+  ASSERT_TRUE(publication.IsSuccessful());
+  const auto& pub = publication.GetResult();
+
+  RunThreads([&](std::uint8_t thread) {
+    for (std::uint32_t i = 0u; i < parameter.messages_per_thread; ++i) {
+      const auto partition =
+          std::to_string(thread * parameter.messages_per_thread + i);
+      auto request = model::PublishPartitionDataRequest()
+                         .WithData(data_)
+                         .WithLayerId(kVersionedLayer)
+                         .WithPartitionId(partition);
+      auto response =
+          client.PublishToBatch(pub, std::move(request)).GetFuture().get();
+      if (!response.IsSuccessful()) {
+        failed_.fetch_add(1);
+      }
+    }
+  });
+
+  Report("PublishToBatch",
+         parameter.calling_thread_count * parameter.messages_per_thread);
+}
+
+/*
+ * The server answers without a delay, which measures the SDK overhead.
+ */
+TestConfiguration NoLatencyTest() {
+  TestConfiguration configuration;
+  configuration.configuration_name = "no_latency";
+  return configuration;
+}
+
+/*
+ * A constrained producer with a mobile-like uplink of 50 ms latency and
+ * 256 KB/s.
+ */
+TestConfiguration ConstrainedDeviceTest() {
+  TestConfiguration configuration;
+  configuration.configuration_name = "constrained_device";
+  configuration.calling_thread_count = 2;
+  configuration.messages_per_thread = 100;
+  configuration.message_size = 4u * 1024u;
+  configuration.network_latency = std::chrono::milliseconds(50);
+  configuration.network_bytes_per_second = 256u * 1024u;
+  return configuration;
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+  configurations.emplace_back(NoLatencyTest());
+  configurations.emplace_back(ConstrainedDeviceTest());
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(Write, WriteTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace